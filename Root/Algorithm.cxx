@@ -5,9 +5,30 @@
 
 //  for isMC()
 #include <xAODAnaHelpers/HelperFunctions.h>
+#include <xAODAnaHelpers/HistogramManager.h>
 #include "xAODEventInfo/EventInfo.h"
 
+// for the timing summary
+#include <TFile.h>
+#include <TFileCacheRead.h>
+#include <TH1D.h>
+#include <TTree.h>
+
+// for the systematic-parallel mode
+#include <TROOT.h>
+#include <algorithm>
+#include <atomic>
+#include <set>
+#include <exception>
+#include <thread>
+
 std::map<std::string, int> xAH::Algorithm::m_instanceRegistry = {};
+std::function<void()> xAH::Algorithm::s_eventScopeHook;
+xAH::Algorithm::InputFileState xAH::Algorithm::m_inputFileState;
+Long64_t xAH::Algorithm::m_rejectedEntry = -1;
+const TFile* xAH::Algorithm::m_rejectedFile = nullptr;
+std::string xAH::Algorithm::m_rejectedFileName = "";
+xAH::Algorithm::InputIOState xAH::Algorithm::m_inputIOState;
 
 // this is needed to distribute the algorithm to the workers
 ClassImp(xAH::Algorithm)
@@ -42,15 +63,303 @@ StatusCode xAH::Algorithm::algInitialize(){
       ANA_MSG_ERROR("Multiple input-type flags are set, be sure only one of m_forceData(" << m_forceData << "), m_forceFastSim(" << m_forceFastSim << "), and m_forceFullSim(" << m_forceFullSim << ") are true.");
       return StatusCode::FAILURE;
     }
+
+    if(m_profileAllocations && !AllocationProfiler::enable()){
+      ANA_MSG_WARNING("m_profileAllocations is set, but the allocations are not seen: preload libxAODAnaHelpersAllocationCounting.so (LD_PRELOAD) for its operator new to be used.");
+    }
+
+    if(m_doPerfCounters){
+      const std::string missing = PerfCounters::open();
+      if(!missing.empty()) ANA_MSG_WARNING("m_doPerfCounters is set, but these counters are not available and stay at zero: " << missing << " (check /proc/sys/kernel/perf_event_paranoid).");
+    }
+
+    if(!m_traceFile.empty()){
+      TraceWriter& trace = TraceWriter::instance();
+      if(!trace.open(m_traceFile, m_traceEveryNEvents, m_traceSlowEventMs, m_traceContainers)){
+        if(!trace.isOpen()){
+          ANA_MSG_ERROR("Cannot write the trace file " << m_traceFile);
+          return StatusCode::FAILURE;
+        }
+        ANA_MSG_WARNING("The trace of this job is already written to " << trace.fileName() << ", this algorithm is traced there instead of " << m_traceFile);
+      }
+    }
   
     return StatusCode::SUCCESS;
 }
 
 StatusCode xAH::Algorithm::algFinalize(){
     unregisterInstance();
+    if(m_doTiming) reportTiming();
+    if(m_profileAllocations) reportAllocations();
+    if(m_doPerfCounters) reportPerfCounters();
+    if(!m_traceFile.empty() && TraceWriter::instance().isOpen()){
+      TraceWriter::instance().close();
+      ANA_MSG_INFO( "Wrote " << TraceWriter::instance().eventsWritten() << " events to the trace " << TraceWriter::instance().fileName());
+    }
+    if(!m_histMemory.empty()) writeHistMemory();
     return StatusCode::SUCCESS;
 }
 
+void xAH::Algorithm::releaseContainers(){
+    xAOD::TStore* store = wk()->xaodStore();
+    if(!store) return;
+
+    // only remove what is there, TStore::remove complains about the rest
+    std::vector<std::string> names;
+    store->getNames("SG::AuxVectorBase", names);
+    std::vector<std::string> auxNames;
+    store->getNames("SG::IConstAuxStore", auxNames);
+    std::set<std::string> present(names.begin(), names.end());
+    present.insert(auxNames.begin(), auxNames.end());
+
+    auto release = [&](const std::string& key){
+      if(present.count(key) || store->contains<std::vector<std::string> >(key)){
+        if(!store->remove(key).isSuccess()) ANA_MSG_WARNING( "Cannot release " << key << " from the TStore");
+        else ANA_MSG_VERBOSE( "Released " << key);
+      }
+    };
+
+    for(const std::string& entry : m_releaseContainers){
+      const std::size_t colon = entry.find(':');
+      const std::string container = entry.substr(0, colon);
+      std::vector<std::string> systNames = {""};
+      if(colon != std::string::npos){
+        const std::string systKey = entry.substr(colon+1);
+        const std::vector<std::string>* variations(nullptr);
+        if(store->contains<std::vector<std::string> >(systKey) && store->retrieve(variations, systKey).isSuccess()) systNames.insert(systNames.end(), variations->begin(), variations->end());
+      }
+      for(const std::string& systName : std::set<std::string>(systNames.begin(), systNames.end())){
+        release(container + systName);
+        release(container + systName + "Aux.");
+      }
+    }
+}
+
+void xAH::Algorithm::checkpointEvent(){
+    // the events before this one are complete
+    if(m_checkpointCount && m_checkpointCount % m_checkpointEvents == 0 && !m_checkpoint.empty()){
+      if(m_checkpoint.file().empty()) m_checkpoint.setFile(m_checkpointFile.empty() ? "checkpoint_" + m_name + ".root" : m_checkpointFile);
+      ANA_MSG_DEBUG( "Writing a checkpoint after " << m_checkpointCount << " events to " << m_checkpoint.file());
+      if(!m_checkpoint.write(m_checkpointCount)) ANA_MSG_WARNING( "Could not write the checkpoint " << m_checkpoint.file());
+    }
+    ++m_checkpointCount;
+}
+
+StatusCode xAH::Algorithm::addHistMemory(const HistogramManager& hists){
+    m_histBytes += hists.memoryBytes();
+    ANA_MSG_DEBUG( "Histograms booked so far: " << m_histBytes/1048576. << " MB");
+
+    if(m_histMemoryBudget > 0 && m_histBytes > m_histMemoryBudget*1048576.){
+      ANA_MSG_ERROR( "The histograms of " << m_name << " take " << m_histBytes/1048576. << " MB, more than m_histMemoryBudget = " << m_histMemoryBudget << " MB. "
+                     << "Reduce the detail string, the binning or the number of systematics, or raise the budget.");
+      return StatusCode::FAILURE;
+    }
+    return StatusCode::SUCCESS;
+}
+
+void xAH::Algorithm::reportHistMemory(const std::string& stage, double bytes){
+    ANA_MSG_INFO( "Histogram memory at " << stage << ": " << bytes/1048576. << " MB");
+    m_histMemory.push_back(std::make_pair(stage, bytes));
+}
+
+void xAH::Algorithm::writeHistMemory(){
+    TFile* fileMD = wk() ? wk()->getOutputFileNull("metadata") : nullptr;
+    if(!fileMD){
+      ANA_MSG_DEBUG( "No metadata output stream available, the histogram memory is not written.");
+      return;
+    }
+    TDirectory* dirMemory = fileMD->GetDirectory("memory");
+    if(!dirMemory) dirMemory = fileMD->mkdir("memory");
+
+    TH1D* hist = new TH1D(m_name.c_str(), m_name.c_str(), m_histMemory.size(), 0, m_histMemory.size());
+    for(unsigned int i = 0; i < m_histMemory.size(); ++i){
+      hist->GetXaxis()->SetBinLabel(i+1, m_histMemory[i].first.c_str());
+      hist->SetBinContent(i+1, m_histMemory[i].second);
+    }
+    hist->SetDirectory(dirMemory);
+}
+
+void xAH::Algorithm::reportAllocations(){
+    const AllocationProfiler& p = m_executeAllocations;
+    if(p.calls() == 0) return;
+
+    const AllocationProfiler::Counts& total = p.total();
+    ANA_MSG_INFO( "Allocations in execute(): "
+                  << p.calls() << " calls, "
+                  << total.allocations << " allocations (" << static_cast<double>(total.allocations)/p.calls() << " per event), "
+                  << total.bytes/1048576. << " MB (" << static_cast<double>(total.bytes)/p.calls() << " bytes per event), "
+                  << total.deallocations << " deallocations");
+
+    TFile* fileMD = wk() ? wk()->getOutputFileNull("metadata") : nullptr;
+    if(!fileMD){
+      ANA_MSG_DEBUG( "No metadata output stream available, the allocation counts are not written.");
+      return;
+    }
+    TDirectory* dirAllocations = fileMD->GetDirectory("allocations");
+    if(!dirAllocations) dirAllocations = fileMD->mkdir("allocations");
+    p.makeHist(m_name)->SetDirectory(dirAllocations);
+}
+
+void xAH::Algorithm::reportPerfCounters(){
+    const PerfCounters& p = m_executePerfCounters;
+    if(p.calls() == 0) return;
+
+    std::stringstream perEvent;
+    for(int i = 0; i < PerfCounters::nCounters; ++i)
+      perEvent << ", " << PerfCounters::name(static_cast<PerfCounters::Counter>(i)) << " " << static_cast<double>(p.total()[i])/p.calls();
+    ANA_MSG_INFO( "Hardware counters of execute(): " << p.calls() << " calls, IPC " << p.ipc() << ", per event" << perEvent.str());
+
+    TFile* fileMD = wk() ? wk()->getOutputFileNull("metadata") : nullptr;
+    if(!fileMD){
+      ANA_MSG_DEBUG( "No metadata output stream available, the hardware counters are not written.");
+      return;
+    }
+    TDirectory* dirPerf = fileMD->GetDirectory("perf");
+    if(!dirPerf) dirPerf = fileMD->mkdir("perf");
+    p.makeHist(m_name)->SetDirectory(dirPerf);
+}
+
+void xAH::Algorithm::reportTiming(){
+    const std::vector<std::pair<std::string, const AlgorithmTimer*> > timers = {
+      {"execute", &m_executeTimer},
+      {"postExecute", &m_postExecuteTimer}
+    };
+
+    // the metadata stream is only there if someone (e.g. BasicEventSelection) declared it
+    TFile* fileMD = wk() ? wk()->getOutputFileNull("metadata") : nullptr;
+    TDirectory* dirTiming(nullptr);
+    if(fileMD){
+      dirTiming = fileMD->GetDirectory("timing");
+      if(!dirTiming) dirTiming = fileMD->mkdir("timing");
+    }
+
+    for(const auto& timer: timers){
+      const AlgorithmTimer& t = *timer.second;
+      if(t.calls() == 0) continue;
+
+      ANA_MSG_INFO( "Timing of " << timer.first << "(): "
+                    << t.calls() << " calls, "
+                    << "wall " << t.wallTime() << " s, "
+                    << "cpu " << t.cpuTime() << " s, "
+                    << "mean " << t.wallMean()*1e3 << " ms, "
+                    << "p50 " << t.wallPercentile(0.50)*1e3 << " ms, "
+                    << "p90 " << t.wallPercentile(0.90)*1e3 << " ms, "
+                    << "p99 " << t.wallPercentile(0.99)*1e3 << " ms, "
+                    << "max " << t.wallMax()*1e3 << " ms");
+
+      if(!dirTiming) continue;
+      std::string histName = m_name;
+      if(timer.first != "execute") histName += "_" + timer.first;
+      TH1D* hist = t.makeHist(histName);
+      hist->SetDirectory(dirTiming);
+    }
+
+    if(!dirTiming){
+      ANA_MSG_DEBUG( "No metadata output stream available, timing histograms are not written.");
+      return;
+    }
+
+    // the read statistics are the same for all instances, the first one to finish writes them
+    if(dirTiming->Get("io")) return;
+    const std::vector<std::pair<std::string, double> > io = {
+      {"files",                 m_inputIOState.files},
+      {"bytes_read",            static_cast<double>(TFile::GetFileBytesRead())},
+      {"read_calls",            static_cast<double>(TFile::GetFileReadCalls())},
+      {"cache_bytes_read",      m_inputIOState.done[0] + m_inputIOState.current[0]},
+      {"cache_read_calls",      m_inputIOState.done[1] + m_inputIOState.current[1]},
+      {"no_cache_bytes_read",   m_inputIOState.done[2] + m_inputIOState.current[2]},
+      {"no_cache_read_calls",   m_inputIOState.done[3] + m_inputIOState.current[3]}
+    };
+    TH1D* hist = new TH1D("io", "io", io.size(), 0, io.size());
+    for(unsigned int i = 0; i < io.size(); ++i){
+      hist->GetXaxis()->SetBinLabel(i+1, io[i].first.c_str());
+      hist->SetBinContent(i+1, io[i].second);
+    }
+    hist->SetDirectory(dirTiming);
+
+    EventArena::instance().makeHist("arena")->SetDirectory(dirTiming);
+}
+
+void xAH::Algorithm::sampleInputIO() const {
+    TFile* file = wk()->inputFile();
+    TTree* tree = wk()->tree();
+    if(!file || !tree) return;
+
+    std::array<double, 4> current = {{0, 0, 0, 0}};
+    if(const TFileCacheRead* cache = file->GetCacheRead(tree)){
+      current = {{ static_cast<double>(cache->GetBytesRead()), static_cast<double>(cache->GetReadCalls()),
+                   static_cast<double>(cache->GetNoCacheBytesRead()), static_cast<double>(cache->GetNoCacheReadCalls()) }};
+    }
+
+    // the counters of one file only grow, if they went down the file pointer was reused by the next one
+    InputIOState& state = m_inputIOState;
+    if(file != state.file || current[0] < state.current[0] || current[2] < state.current[2]){
+      for(unsigned int i = 0; i < 4; ++i) state.done[i] += state.current[i];
+      state.file = file;
+      state.files += 1;
+    }
+    state.current = current;
+}
+
+StatusCode xAH::Algorithm::forEachSystematic(unsigned int nTasks, const std::function<StatusCode(unsigned int index, unsigned int slot)>& work) const {
+
+    const unsigned int nThreads = std::min(systThreads(), nTasks);
+
+    if(nThreads <= 1){
+      for(unsigned int index = 0; index < nTasks; ++index){
+        if(!work(index, 0).isSuccess()) return StatusCode::FAILURE;
+      }
+      return StatusCode::SUCCESS;
+    }
+
+    // ROOT needs to be told once that it will be used from several threads
+    static const bool rootThreadSafety = [](){ ROOT::EnableThreadSafety(); return true; }();
+    (void)rootThreadSafety;
+
+    std::atomic<unsigned int> next(0);
+    std::atomic<bool> failed(false);
+    std::vector<std::exception_ptr> exceptions(nThreads);
+
+    auto worker = [&](unsigned int slot){
+      // histograms filled through HistogramManager::fillBuffered go to the shard of this slot
+      HistogramManager::ShardScope shard(slot);
+      try {
+        for(unsigned int index = next++; index < nTasks && !failed; index = next++){
+          if(!work(index, slot).isSuccess()) failed = true;
+        }
+      } catch(...) {
+        exceptions.at(slot) = std::current_exception();
+        failed = true;
+      }
+    };
+
+    std::vector<std::thread> threads;
+    threads.reserve(nThreads - 1);
+    for(unsigned int slot = 1; slot < nThreads; ++slot) threads.emplace_back(worker, slot);
+    worker(0);
+    for(auto& thread : threads) thread.join();
+
+    for(const auto& exception : exceptions){
+      if(exception) std::rethrow_exception(exception);
+    }
+
+    return failed ? StatusCode::FAILURE : StatusCode::SUCCESS;
+}
+
+void xAH::Algorithm::rejectEvent(){
+    wk()->skipEvent();
+    m_rejectedEntry    = wk()->treeEntry();
+    m_rejectedFile     = wk()->inputFile();
+    m_rejectedFileName = wk()->inputFileName();
+}
+
+bool xAH::Algorithm::eventRejected() const {
+    if(m_rejectedEntry < 0) return false;
+    if(wk()->treeEntry() != m_rejectedEntry || wk()->inputFile() != m_rejectedFile) return false;
+    // the pointer alone could be reused by the next input file
+    return wk()->inputFileName() == m_rejectedFileName;
+}
+
 StatusCode xAH::Algorithm::parseSystValVector(){
 
     std::stringstream ss(m_systValVectorString);
@@ -65,20 +374,33 @@ StatusCode xAH::Algorithm::parseSystValVector(){
     return StatusCode::SUCCESS;
 }
 
+xAH::Algorithm::InputFileState& xAH::Algorithm::inputFileState() const {
+    // EventLoop calls changeInput() of every algorithm on a new file, but the derived
+    // classes do not forward it here, so the file switch is detected on the first query instead
+    const TFile* file = wk()->inputFile();
+    if(file != m_inputFileState.file){
+      m_inputFileState = InputFileState();
+      m_inputFileState.file = file;
+    }
+    return m_inputFileState;
+}
+
 bool xAH::Algorithm::isMC(){
-    
-    // If decision is established, return the decision
+
+    // If decision is fixed at the algorithm level, return the decision
     if(m_isMC == 0 || m_isMC == 1) return m_isMC;
-    
+
     // If overriding decision by boolean flags
     if( m_forceData ){
-      m_isMC = 0;
-      return m_isMC;
+      return false;
     }else if ( m_forceFullSim || m_forceFastSim ){
-      m_isMC = 1;
-      return m_isMC;
+      return true;
     }
 
+    // If decision is established for this input file (by any algorithm), return the decision
+    InputFileState& state = inputFileState();
+    if(state.isMC == 0 || state.isMC == 1) return state.isMC;
+
     const xAOD::EventInfo* ei(nullptr);
     // couldn't retrieve it
     if(!HelperFunctions::retrieve(ei, m_eventInfoContainerName, m_event, m_store, msg()).isSuccess()){
@@ -91,36 +413,33 @@ bool xAH::Algorithm::isMC(){
     }
 
     // reached here, return True or False since we have all we need
-    m_isMC = (static_cast<uint32_t>(eventType(*ei)) & xAOD::EventInfo::IS_SIMULATION);
-    return m_isMC;
+    state.isMC = (static_cast<uint32_t>(eventType(*ei)) & xAOD::EventInfo::IS_SIMULATION) ? 1 : 0;
+    return state.isMC;
 }
 
 bool xAH::Algorithm::isFastSim(){
 
-    // If decision is established, return the decision
+    // If decision is fixed at the algorithm level, return the decision
     if(m_isFastSim == 0 || m_isFastSim == 1) return m_isFastSim;
-      
+
     // If overriding decision by boolean flags
     if( m_forceData || m_forceFullSim ){
-      m_isFastSim = 0;
-      return m_isFastSim;
+      return false;
     }else if ( m_forceFastSim ){
-      m_isFastSim = 1;
-      return m_isFastSim;
+      return true;
     }
-   
-    std::string SimulationFlavour; 
+
+    // If decision is established for this input file (by any algorithm), return the decision
+    InputFileState& state = inputFileState();
+    if(state.isFastSim == 0 || state.isFastSim == 1) return state.isFastSim;
+
+    std::string SimulationFlavour;
     const xAOD::FileMetaData* fmd = nullptr;
     ANA_CHECK( wk()->xaodEvent()->retrieveMetaInput(fmd, "FileMetaData") );
     fmd->value(xAOD::FileMetaData::simFlavour, SimulationFlavour);
-  
-    if( SimulationFlavour == "AtlfastII" ){
-      m_isFastSim = 1;
-    }else{
-      m_isFastSim = 0;
-    }
-  
-    return m_isFastSim;
+
+    state.isFastSim = ( SimulationFlavour == "AtlfastII" ) ? 1 : 0;
+    return state.isFastSim;
 }
 
 bool xAH::Algorithm::isPHYS(){
@@ -0,0 +1,106 @@
+#include <xAODAnaHelpers/AlgorithmTimer.h>
+
+#include <algorithm>
+#include <cmath>
+#include <ctime>
+
+#include <TH1D.h>
+
+namespace {
+  // log10 range covered by the percentile bins: [1e-7 s, 1e2 s)
+  const double s_log10Min = -7.0;
+  const double s_log10Max =  2.0;
+  const double s_binWidth = (s_log10Max - s_log10Min)/xAH::AlgorithmTimer::nBins;
+
+  // CPU time of the calling thread in seconds; std::clock() counts all threads of the process
+  double threadCpuTime()
+  {
+    timespec now;
+    if(clock_gettime(CLOCK_THREAD_CPUTIME_ID, &now) != 0) return 0.0;
+    return now.tv_sec + 1e-9*now.tv_nsec;
+  }
+}
+
+xAH::AlgorithmTimer::AlgorithmTimer()
+{
+  reset();
+}
+
+void xAH::AlgorithmTimer::reset()
+{
+  m_calls     = 0;
+  m_wallTotal = 0.0;
+  m_cpuTotal  = 0.0;
+  m_wallMax   = 0.0;
+  m_running   = false;
+  m_cpuStart  = 0.0;
+  m_wallBins.fill(0);
+}
+
+void xAH::AlgorithmTimer::start()
+{
+  m_running   = true;
+  m_cpuStart  = threadCpuTime();
+  m_wallStart = std::chrono::steady_clock::now();
+}
+
+void xAH::AlgorithmTimer::stop()
+{
+  if(!m_running) return;
+  const auto wallStop = std::chrono::steady_clock::now();
+  const double cpuStop = threadCpuTime();
+  m_running = false;
+
+  const double wall = std::chrono::duration<double>(wallStop - m_wallStart).count();
+  const double cpu  = cpuStop - m_cpuStart;
+
+  ++m_calls;
+  m_wallTotal += wall;
+  m_cpuTotal  += cpu;
+  m_wallMax    = std::max(m_wallMax, wall);
+  ++m_wallBins[findBin(wall)];
+}
+
+double xAH::AlgorithmTimer::wallPercentile(double fraction) const
+{
+  if(m_calls == 0) return 0.0;
+  fraction = std::min(std::max(fraction, 0.0), 1.0);
+
+  const double target = fraction*m_calls;
+  unsigned long long running = 0;
+  for(unsigned int bin = 0; bin < nBins; ++bin){
+    running += m_wallBins[bin];
+    if(running >= target && running > 0) return std::min(binCenter(bin), m_wallMax);
+  }
+  return m_wallMax;
+}
+
+TH1D* xAH::AlgorithmTimer::makeHist(const std::string& name) const
+{
+  TH1D* hist = new TH1D(name.c_str(), name.c_str(), 8, 0.5, 8.5);
+  hist->SetDirectory(nullptr);
+
+  const char* labels[8] = {"calls", "wall_total", "cpu_total", "wall_mean", "wall_p50", "wall_p90", "wall_p99", "wall_max"};
+  const double values[8] = {static_cast<double>(m_calls), m_wallTotal, m_cpuTotal, wallMean(),
+                            wallPercentile(0.50), wallPercentile(0.90), wallPercentile(0.99), m_wallMax};
+  for(int i = 0; i < 8; ++i){
+    hist->GetXaxis()->SetBinLabel(i+1, labels[i]);
+    hist->SetBinContent(i+1, values[i]);
+  }
+
+  return hist;
+}
+
+unsigned int xAH::AlgorithmTimer::findBin(double seconds)
+{
+  if(seconds <= 0.0) return 0;
+  const double pos = (std::log10(seconds) - s_log10Min)/s_binWidth;
+  if(pos <= 0.0) return 0;
+  if(pos >= nBins) return nBins - 1;
+  return static_cast<unsigned int>(pos);
+}
+
+double xAH::AlgorithmTimer::binCenter(unsigned int bin)
+{
+  return std::pow(10.0, s_log10Min + (bin + 0.5)*s_binWidth);
+}
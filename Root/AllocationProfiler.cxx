@@ -0,0 +1,69 @@
+#include <xAODAnaHelpers/AllocationProfiler.h>
+
+#include <dlfcn.h>
+#include <new>
+#include <utility>
+#include <vector>
+
+#include <TH1D.h>
+
+namespace {
+  // the counters of the preloaded libxAODAnaHelpersAllocationCounting.so, null until enable() found them
+  xAH::AllocationProfiler::SharedCounters* s_counters = nullptr;
+}
+
+bool xAH::AllocationProfiler::enable()
+{
+  if(!s_counters){
+    typedef SharedCounters* (*Lookup)();
+    Lookup lookup = reinterpret_cast<Lookup>(dlsym(RTLD_DEFAULT, "xAH_allocationCounters"));
+    if(!lookup) return false;
+    s_counters = lookup();
+  }
+  s_counters->enabled = true;
+
+  // call through a volatile pointer so that the allocation cannot be elided, and resolves to the operator new in use
+  void* (* volatile allocate)(std::size_t) = &::operator new;
+  void (* volatile deallocate)(void*) = &::operator delete;
+  const unsigned long long before = s_counters->allocations.load();
+  deallocate(allocate(1));
+  return s_counters->allocations.load() != before;
+}
+
+xAH::AllocationProfiler::Counts xAH::AllocationProfiler::current()
+{
+  Counts counts;
+  if(!s_counters) return counts;
+  counts.allocations   = s_counters->allocations.load(std::memory_order_relaxed);
+  counts.bytes         = s_counters->bytes.load(std::memory_order_relaxed);
+  counts.deallocations = s_counters->deallocations.load(std::memory_order_relaxed);
+  return counts;
+}
+
+void xAH::AllocationProfiler::add(const Counts& start, const Counts& stop)
+{
+  ++m_calls;
+  m_total.allocations   += stop.allocations - start.allocations;
+  m_total.bytes         += stop.bytes - start.bytes;
+  m_total.deallocations += stop.deallocations - start.deallocations;
+}
+
+TH1D* xAH::AllocationProfiler::makeHist(const std::string& name) const
+{
+  const double calls = static_cast<double>(m_calls);
+  const std::vector<std::pair<std::string, double> > values = {
+    {"calls",                calls},
+    {"allocations",          static_cast<double>(m_total.allocations)},
+    {"bytes",                static_cast<double>(m_total.bytes)},
+    {"deallocations",        static_cast<double>(m_total.deallocations)},
+    {"allocations_per_call", m_calls ? m_total.allocations/calls : 0.},
+    {"bytes_per_call",       m_calls ? m_total.bytes/calls : 0.}
+  };
+  TH1D* hist = new TH1D(name.c_str(), name.c_str(), values.size(), 0, values.size());
+  hist->SetDirectory(nullptr);
+  for(unsigned int i = 0; i < values.size(); ++i){
+    hist->GetXaxis()->SetBinLabel(i+1, values[i].first.c_str());
+    hist->SetBinContent(i+1, values[i].second);
+  }
+  return hist;
+}
@@ -9,7 +9,10 @@
  **************************************************/
 
 // c++ include(s):
+#include <cmath>
 #include <iostream>
+#include <limits>
+#include <set>
 
 // EL include(s):
 #include <EventLoop/Job.h>
@@ -27,6 +30,8 @@
 #include "xAODAnaHelpers/HelperFunctions.h"
 #include "xAODAnaHelpers/HelperClasses.h"
 #include "xAODAnaHelpers/BJetEfficiencyCorrector.h"
+#include "xAODAnaHelpers/BTagDecisions.h"
+#include "xAODAnaHelpers/SelectionFlags.h"
 
 #include <AsgTools/MessageCheck.h>
 
@@ -186,6 +191,22 @@ EL::StatusCode BJetEfficiencyCorrector :: initialize ()
   ANA_CHECK( m_BJetSelectTool_handle.retrieve());
   ANA_MSG_DEBUG("Retrieved tool: " << m_BJetSelectTool_handle);
 
+  // the discriminant is shared with the other instances running the same tagger on the same jets
+  m_btagKey = xAH::BTagDecisions::registerTagger(m_taggerName, m_jetAuthor, m_corrFileName);
+  if ( m_btagKey.empty() ) {
+    ANA_MSG_WARNING( "Tagger " << m_taggerName << " on " << m_jetAuthor << " is already used with another calibration file, its discriminant is not shared");
+  } else if ( !m_useContinuous ) {
+    m_btagBit = xAH::BTagDecisions::bit(m_btagKey, m_operatingPt);
+    if ( m_btagBit < 0 ) ANA_MSG_WARNING( "No bit left for " << m_operatingPt << " in " << xAH::BTagDecisions::bitsName(m_btagKey));
+    else ANA_MSG_INFO( m_operatingPt << " is bit " << m_btagBit << " of " << xAH::BTagDecisions::bitsName(m_btagKey));
+  }
+
+  if ( !m_useContinuous ) {
+    m_isBTagFlagBit   = xAH::SelectionFlags::bit(m_decor);
+    m_isBTagORFlagBit = xAH::SelectionFlags::bit(m_decor+"OR");
+    if ( m_isBTagFlagBit < 0 || m_isBTagORFlagBit < 0 ) ANA_MSG_WARNING( "No bit left in the selection flags for " << m_decor << ", it is only decorated");
+  }
+
   //  Configure the BJetEfficiencyCorrectionTool
   if( m_getScaleFactors ) {
 
@@ -343,6 +364,9 @@ EL::StatusCode BJetEfficiencyCorrector :: initialize ()
 
 EL::StatusCode BJetEfficiencyCorrector :: execute ()
 {
+  auto event = beginEvent();
+  auto timer = timeExecute();
+  if ( eventRejected() ) return EL::StatusCode::SUCCESS;
   ANA_MSG_DEBUG( "Applying BJetEfficiencyCorrector for " << m_taggerName << " tagger... ");
 
   //
@@ -403,43 +427,62 @@ EL::StatusCode BJetEfficiencyCorrector :: executeEfficiencyCorrection(const xAOD
   SG::AuxElement::Decorator< int > dec_Quantile( m_decorQuantile );
   SG::AuxElement::Decorator< std::vector<float> > dec_ineffsfBTag( m_decorInefficiencySF );
 
+  // the discriminant and the decisions shared by all the operating points of the tagger
+  SG::AuxElement::Decorator< float > dec_sharedWeight( xAH::BTagDecisions::weightName(m_btagKey) );
+  SG::AuxElement::Decorator< unsigned int > dec_btagBits( xAH::BTagDecisions::bitsName(m_btagKey) );
+
   //
   // run the btagging decision or get weight and quantile if running continuous
   //
   for( const xAOD::Jet* jet_itr : *(inJets)){
 
+    // the discriminant, computed once per jet for all the operating points of the tagger
+    ANA_MSG_DEBUG(" Getting TaggerWeight");
+    double tagWeight(0.);
+    if ( !m_btagKey.empty() && dec_sharedWeight.isAvailable( *jet_itr ) ) {
+      tagWeight = dec_sharedWeight( *jet_itr );
+    } else {
+      if( m_BJetSelectTool_handle->getTaggerWeight( *jet_itr, tagWeight)!=CP::CorrectionCode::Ok ){
+        // a jet without a weight is never tagged, which is what the selection tool does for it
+        tagWeight = std::numeric_limits<double>::quiet_NaN();
+      }
+      if ( !m_btagKey.empty() ) dec_sharedWeight( *jet_itr ) = tagWeight;
+    }
+    ANA_MSG_DEBUG( "tagWeight: " << tagWeight );
+
     if(!m_useContinuous){
       // get tagging decision
       ANA_MSG_DEBUG(" Getting tagging decision ");
 
       // Add decorator for decision
-      if( m_BJetSelectTool_handle->accept( *jet_itr ) )
-        dec_isBTag( *jet_itr ) = 1;
-      else
-        dec_isBTag( *jet_itr ) = 0;
+      const bool isBTag = !std::isnan(tagWeight) && m_BJetSelectTool_handle->accept( jet_itr->pt(), jet_itr->eta(), tagWeight );
+      dec_isBTag( *jet_itr ) = isBTag;
+      xAH::SelectionFlags::set( *jet_itr, m_isBTagFlagBit, isBTag );
+
+      if ( m_btagBit >= 0 ) {
+        unsigned int bits = dec_btagBits.isAvailable( *jet_itr ) ? dec_btagBits( *jet_itr ) : 0;
+        if ( isBTag ) bits |=   1u << m_btagBit;
+        else          bits &= ~(1u << m_btagBit);
+        dec_btagBits( *jet_itr ) = bits;
+      }
 
       // Add pT-dependent b-tag decision decorator (intended for use in OR)
-      if ((m_orBJetPtUpperThres < 0 || m_orBJetPtUpperThres > (*jet_itr).pt()/1000.) // passes pT criteria
-          && m_BJetSelectTool_handle->accept( *jet_itr ) )
-        dec_isBTagOR( *jet_itr ) = 1;
-      else
-        dec_isBTagOR( *jet_itr ) = 0;
+      const bool isBTagOR = (m_orBJetPtUpperThres < 0 || m_orBJetPtUpperThres > (*jet_itr).pt()/1000.) // passes pT criteria
+                            && isBTag;
+      dec_isBTagOR( *jet_itr ) = isBTagOR;
+      xAH::SelectionFlags::set( *jet_itr, m_isBTagORFlagBit, isBTagOR );
     }
     else{
       ANA_MSG_DEBUG(" Getting Quantile");
-      int quantile = m_BJetSelectTool_handle->getQuantile(*jet_itr);
+      int quantile = std::isnan(tagWeight) ? -1 : m_BJetSelectTool_handle->getQuantile( jet_itr->pt(), jet_itr->eta(), tagWeight );
       ANA_MSG_DEBUG( "quantile: " << quantile );
       dec_Quantile( *jet_itr ) = quantile;
     }
     if(m_useContinuous || m_alwaysGetTagWeight){
-      ANA_MSG_DEBUG(" Getting TaggerWeight");
-      
-      double tagWeight;
-      if( m_BJetSelectTool_handle->getTaggerWeight( *jet_itr, tagWeight)!=CP::CorrectionCode::Ok ){
+      if( std::isnan(tagWeight) ){
         ANA_MSG_ERROR(" Error retrieving b-tagger weight ");
         return EL::StatusCode::FAILURE;
       }
-      ANA_MSG_DEBUG( "tagWeight: " << tagWeight );
 	    dec_Weight( *jet_itr)    = tagWeight;
     }
   }
@@ -448,7 +491,29 @@ EL::StatusCode BJetEfficiencyCorrector :: executeEfficiencyCorrection(const xAOD
   // get the scale factors for all jets
   //
   if(m_getScaleFactors)
-    { // loop over available systematics
+    {
+      // select the efficiency maps for use in MC/MC and inefficiency scale factors, based on user specified selection of efficiency maps:
+      // the map only depends on the jet flavour and the sample, so it is set once per flavour rather than per jet and systematic
+      if(m_setMapIndex){
+        const unsigned int MCindex = getMCIndex( eventInfo->mcChannelNumber() );
+        std::set<std::string> flavLabels;
+        for( const xAOD::Jet* jet_itr : *(inJets)) flavLabels.insert( getFlavorLabel(*jet_itr) );
+        for( const std::string& FlavLabel : flavLabels) ANA_CHECK( m_BJetEffSFTool_handle->setMapIndex(FlavLabel,MCindex));
+      }
+
+      // every systematic appends one SF per jet: create the vectors once, with room for all of them
+      const std::size_t nVariations = doNominal ? m_systList.size() : 1;
+      for( const xAOD::Jet* jet_itr : *(inJets))
+        {
+          if(                   !dec_sfBTag     .isAvailable( *jet_itr ))
+            dec_sfBTag     ( *jet_itr ) = std::vector<float>();
+          if(m_useContinuous && !dec_ineffsfBTag.isAvailable( *jet_itr ))
+            dec_ineffsfBTag( *jet_itr ) = std::vector<float>();
+          dec_sfBTag( *jet_itr ).reserve( dec_sfBTag( *jet_itr ).size() + nVariations );
+          if(m_useContinuous) dec_ineffsfBTag( *jet_itr ).reserve( dec_ineffsfBTag( *jet_itr ).size() + nVariations );
+        }
+
+      // loop over available systematics
       for(const CP::SystematicSet& syst_it : m_systList)
 	{
 	  //  If not nominal input jet collection, dont calculate systematics
@@ -471,12 +536,6 @@ EL::StatusCode BJetEfficiencyCorrector :: executeEfficiencyCorrection(const xAOD
 
           for( const xAOD::Jet* jet_itr : *(inJets))
 	    {
-              if(m_setMapIndex){ // select an efficiency map for use in MC/MC and inefficiency scale factors, based on user specified selection of efficiency maps
-                auto FlavLabel = getFlavorLabel(*jet_itr);
-                auto DSID      = eventInfo->mcChannelNumber();
-                auto MCindex   = getMCIndex(DSID);
-                ANA_CHECK( m_BJetEffSFTool_handle->setMapIndex(FlavLabel,MCindex));
-              }
 	      // get the scale factor
 	      float SF(-1.0);
 	      float inefficiencySF(-1.0); // only for continuous b-tagging
@@ -509,12 +568,6 @@ EL::StatusCode BJetEfficiencyCorrector :: executeEfficiencyCorrection(const xAOD
 		}
 
 	      // Save it to the vector
-	      if(                   !dec_sfBTag     .isAvailable( *jet_itr ))
-		dec_sfBTag     ( *jet_itr ) = std::vector<float>();
-	      if(m_useContinuous && !dec_ineffsfBTag.isAvailable( *jet_itr ))
-		dec_ineffsfBTag( *jet_itr ) = std::vector<float>();
-
-
 	      dec_sfBTag( *jet_itr ).push_back(SF);
 	      if(m_useContinuous) dec_ineffsfBTag( *jet_itr ).push_back(inefficiencySF);
       }
@@ -556,6 +609,8 @@ EL::StatusCode BJetEfficiencyCorrector :: executeEfficiencyCorrection(const xAOD
 
 EL::StatusCode BJetEfficiencyCorrector :: postExecute ()
 {
+  auto timer = timePostExecute();
+  if ( eventRejected() ) return EL::StatusCode::SUCCESS;
   ANA_MSG_DEBUG("Calling postExecute");
   return EL::StatusCode::SUCCESS;
 }
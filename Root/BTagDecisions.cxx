@@ -0,0 +1,44 @@
+#include <xAODAnaHelpers/BTagDecisions.h>
+
+#include <map>
+#include <vector>
+
+namespace {
+
+  struct Tagger {
+    std::string cdiFile;
+    std::vector<std::string> operatingPoints;
+  };
+
+  std::map<std::string, Tagger>& taggers()
+  {
+    static std::map<std::string, Tagger> registered;
+    return registered;
+  }
+
+}
+
+std::string xAH::BTagDecisions::registerTagger(const std::string& tagger, const std::string& jetAuthor, const std::string& cdiFile)
+{
+  const std::string key = tagger + "_" + jetAuthor;
+  auto it = taggers().find(key);
+  if(it == taggers().end()) taggers()[key].cdiFile = cdiFile;
+  else if(it->second.cdiFile != cdiFile) return "";
+  return key;
+}
+
+int xAH::BTagDecisions::bit(const std::string& key, const std::string& operatingPoint)
+{
+  std::vector<std::string>& operatingPoints = taggers()[key].operatingPoints;
+  for(unsigned int i = 0; i < operatingPoints.size(); ++i){
+    if(operatingPoints[i] == operatingPoint) return i;
+  }
+  if(operatingPoints.size() >= 32) return -1;
+  operatingPoints.push_back(operatingPoint);
+  return operatingPoints.size() - 1;
+}
+
+const std::string& xAH::BTagDecisions::operatingPoint(const std::string& key, unsigned int bit)
+{
+  return taggers().at(key).operatingPoints.at(bit);
+}
@@ -1,3 +1,15 @@
+// c++ include(s):
+#include <cerrno>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <iostream>
+#include <fstream>
+#include <map>
+#include <mutex>
+#include <set>
+#include <utility>
+
 // EL include(s):
 #include <EventLoop/Job.h>
 #include <EventLoop/Worker.h>
@@ -12,6 +24,8 @@
 // package include(s):
 #include <xAODAnaHelpers/HelperFunctions.h>
 #include <xAODAnaHelpers/BasicEventSelection.h>
+#include <xAODAnaHelpers/RunContext.h>
+#include <xAODAnaHelpers/TriggerDictionary.h>
 
 #include "PATInterfaces/CorrectionCode.h"
 //#include "AsgTools/StatusCode.h"
@@ -27,9 +41,16 @@
 #include "TTree.h"
 #include "TTreeFormula.h"
 #include "TSystem.h"
+#include "TEntryList.h"
+#include "TEnv.h"
 #include "xAODCore/tools/IOStats.h"
 #include "xAODCore/tools/ReadStats.h"
 
+// for m_forkWorkers
+#include <sys/types.h>
+#include <sys/wait.h>
+#include <unistd.h>
+
 // this is needed to distribute the algorithm to the workers
 ClassImp(BasicEventSelection)
 
@@ -79,6 +100,25 @@ EL::StatusCode BasicEventSelection :: histInitialize ()
   ANA_MSG_INFO( "Calling histInitialize");
   ANA_CHECK( xAH::Algorithm::algInitialize());
 
+  if ( m_asyncPrefetch ) {
+    ANA_MSG_INFO( "Enabling asynchronous prefetching of the input baskets");
+    gEnv->SetValue("TFile.AsyncPrefetching", 1);
+  }
+
+  // before the tools allocate their memory, for it to be local to the node the job runs on
+  if ( m_pinToNUMANode ) {
+    m_numaNodes = xAH::CpuPinning::numaNodes();
+    m_numaNode = xAH::CpuPinning::currentNode(m_numaNodes);
+    if ( m_numaNodes.size() < 2 || m_numaNode < 0 ) {
+      ANA_MSG_INFO( "Not pinning to a NUMA node, the job can run on " << m_numaNodes.size() << " of them");
+    } else {
+      const xAH::CpuPinning::Node& node = m_numaNodes[m_numaNode];
+      const std::string error = xAH::CpuPinning::pinToNode( node );
+      if ( error.empty() ) ANA_MSG_INFO( "Pinned to the " << node.cpus.size() << " CPUs of NUMA node " << node.id);
+      else                 ANA_MSG_WARNING( "Cannot pin to NUMA node " << node.id << ": " << error);
+    }
+  }
+
   // write the metadata hist to this file so algos downstream can pick up the pointer
   TFile *fileMD = wk()->getOutputFile (m_metaDataStreamName);
   fileMD->cd();
@@ -147,6 +187,13 @@ EL::StatusCode BasicEventSelection :: histInitialize ()
   m_truth_cutflowHist_1  = new TH1D("cutflow_truths_1", "cutflow_truths_1", 1, 1, 2);
   m_truth_cutflowHist_1->SetCanExtend(TH1::kAllAxes);
 
+  // the cutflows are filled by the selectors downstream too, the checkpoints of this algorithm hold all of them
+  //
+  for ( TH1* cutflow : { m_cutflowHist, m_cutflowHistW, m_el_cutflowHist_1, m_el_cutflowHist_2, m_mu_cutflowHist_1, m_mu_cutflowHist_2,
+                               m_ph_cutflowHist_1, m_tau_cutflowHist_1, m_tau_cutflowHist_2, m_jet_cutflowHist_1, m_trk_cutflowHist_1, m_truth_cutflowHist_1 } ) {
+    addCheckpoint( cutflow );
+  }
+
   // start labelling the bins for the event cutflow
   //
   m_cutflow_all  = m_cutflowHist->GetXaxis()->FindBin("all");
@@ -168,6 +215,14 @@ EL::StatusCode BasicEventSelection :: fileExecute ()
 
   ANA_MSG_INFO( "Calling fileExecute");
 
+  if ( m_prefetchNextFile ) {
+    if ( !m_filePrefetcher ) {
+      m_filePrefetcher.reset(new xAH::FilePrefetcher());
+      m_filePrefetcher->setFiles( wk()->metaData()->castString("xAH_inputFiles", "") );
+    }
+    m_filePrefetcher->prefetchAfter( wk()->inputFileName() );
+  }
+
   // get TEvent and TStore - must be done here b/c we need to retrieve CutBookkeepers container from TEvent!
   //
   m_event = wk()->xaodEvent();
@@ -246,12 +301,19 @@ EL::StatusCode BasicEventSelection :: fileExecute ()
 	}
       }
 
+      static const std::string nonNominalPrefix("AllExecutedEvents_NonNominalMCWeight_");
+
       int maxCycle(-1);
       for ( const xAOD::CutBookkeeper* cbk: *completeCBC )
 	{
+	  // the name and stream are read from the aux store once per bookkeeper
+	  const std::string& cbkName   = cbk->name();
+	  const std::string& cbkStream = cbk->inputStream();
+	  const bool fromAOD = cbkStream == "StreamAOD";
+
 	  // Find initial book keeper
-	  ANA_MSG_INFO("Complete cbk name: " << cbk->name() << " - stream: " << cbk->inputStream() );
-	  if( cbk->cycle() > maxCycle && cbk->name() == "AllExecutedEvents" && cbk->inputStream() == "StreamAOD" )
+	  ANA_MSG_DEBUG("Complete cbk name: " << cbkName << " - stream: " << cbkStream );
+	  if( cbk->cycle() > maxCycle && fromAOD && cbkName == "AllExecutedEvents" )
 	    {
 	      allEventsCBK = cbk;
 	      maxCycle = cbk->cycle();
@@ -263,22 +325,22 @@ EL::StatusCode BasicEventSelection :: fileExecute ()
 
 	      if(m_derivationName != "")
 		{
-		  if ( cbk->name() == m_derivationName )
+		  if ( cbkName == m_derivationName )
 		    DxAODEventsCBK = cbk;
 		}
-	      else if( cbk->name().find("Kernel") != std::string::npos )
+	      else if( cbkName.find("Kernel") != std::string::npos )
 		{
-		  ANA_MSG_INFO("Auto config found DAOD made by Derivation Algorithm: " << cbk->name());
+		  ANA_MSG_INFO("Auto config found DAOD made by Derivation Algorithm: " << cbkName);
 		  DxAODEventsCBK = cbk;
 		}
 	    } // is derivation
 
 	  // Find and record AOD-level sumW information for all alternate weights
 	  //  The nominal AllExecutedEvents will be filled later, due to posibility of multiple CBK entries
-	  if(cbk->name().substr(0,37) == "AllExecutedEvents_NonNominalMCWeight_" && cbk->name().length()!=17 && cbk->inputStream() == "StreamAOD")
+	  if(fromAOD && cbkName.length() > nonNominalPrefix.length() && cbkName.compare(0, nonNominalPrefix.length(), nonNominalPrefix) == 0)
 	    {
-	      // Extract weight index from name
-	      int32_t idx=std::stoi(cbk->name().substr(37));
+	      // Extract weight index from name, without copying it
+	      int32_t idx=std::strtol(cbkName.c_str() + nonNominalPrefix.length(), nullptr, 10);
 
 	      // Fill histogram, making sure that there is space
 	      // Note will fill bin index = idx+1
@@ -319,33 +381,119 @@ EL::StatusCode BasicEventSelection :: fileExecute ()
       ANA_MSG_INFO( "Initial  sum of weights squared = " << m_MD_initialSumWSquared);
       ANA_MSG_INFO( "Selected sum of weights squared = " << m_MD_finalSumWSquared);
 
-      m_cutflowHist ->Fill(m_cutflow_all, m_MD_initialNevents);
-      m_cutflowHistW->Fill(m_cutflow_all, m_MD_initialSumW);
+      // every process of m_forkWorkers goes through all the files, the first one alone counts their metadata
+      if ( m_forkSlice == 0 ) {
+        m_cutflowHist ->Fill(m_cutflow_all, m_MD_initialNevents);
+        m_cutflowHistW->Fill(m_cutflow_all, m_MD_initialSumW);
 
-      m_histSumW->Fill(0., m_MD_initialSumW);
+        m_histSumW->Fill(0., m_MD_initialSumW);
 
-      m_histEventCount -> Fill(1, m_MD_initialNevents);
-      m_histEventCount -> Fill(2, m_MD_finalNevents);
-      m_histEventCount -> Fill(3, m_MD_initialSumW);
-      m_histEventCount -> Fill(4, m_MD_finalSumW);
-      m_histEventCount -> Fill(5, m_MD_initialSumWSquared);
-      m_histEventCount -> Fill(6, m_MD_finalSumWSquared);
+        m_histEventCount -> Fill(1, m_MD_initialNevents);
+        m_histEventCount -> Fill(2, m_MD_finalNevents);
+        m_histEventCount -> Fill(3, m_MD_initialSumW);
+        m_histEventCount -> Fill(4, m_MD_finalSumW);
+        m_histEventCount -> Fill(5, m_MD_initialSumWSquared);
+        m_histEventCount -> Fill(6, m_MD_finalSumWSquared);
+      }
   }
 
   return EL::StatusCode::SUCCESS;
 
 }
 
-EL::StatusCode BasicEventSelection :: changeInput (bool /*firstFile*/)
+EL::StatusCode BasicEventSelection :: changeInput (bool firstFile)
 {
   // Here you do everything you need to do when we change input files,
   // e.g. resetting branch addresses on trees.  If you are using
   // D3PDReader or a similar service this method is not needed.
+
+  ANA_CHECK( changeEntryLists(firstFile) );
+
+  if ( m_readBranchListInput.empty() ) return EL::StatusCode::SUCCESS;
+
+  if ( firstFile ) {
+    std::ifstream branchList( PathResolverFindCalibFile(m_readBranchListInput) );
+    if ( !branchList.good() ) {
+      ANA_MSG_ERROR( "Cannot read the branch list " << m_readBranchListInput);
+      return EL::StatusCode::FAILURE;
+    }
+    std::string branchName;
+    while ( branchList >> branchName ) m_cacheBranches.push_back(branchName);
+  }
+
+  // read (only) the branches the job is known to need, priming the read cache with them instead of learning them from the first events
+  TTree* tree = wk()->tree();
+  if ( !tree ) return EL::StatusCode::SUCCESS;
+  if ( m_disableUnlistedBranches ) {
+    tree->SetBranchStatus("*", false);
+    for ( const std::string& branchName : m_cacheBranches ) {
+      if ( tree->GetBranch(branchName.c_str()) ) tree->SetBranchStatus(branchName.c_str(), true);
+    }
+  }
+  if ( tree->GetCacheSize() <= 0 ) {
+    ANA_MSG_WARNING( "The input tree has no read cache, it is not primed with " << m_readBranchListInput);
+    return EL::StatusCode::SUCCESS;
+  }
+  unsigned int nAdded(0);
+  for ( const std::string& branchName : m_cacheBranches ) {
+    if ( !tree->GetBranch(branchName.c_str()) ) continue;
+    if ( tree->AddBranchToCache(branchName.c_str(), false) == 0 ) ++nAdded;
+  }
+  tree->StopCacheLearningPhase();
+  ANA_MSG_INFO( "Primed the read cache with " << nAdded << " of the " << m_cacheBranches.size() << " branches of " << m_readBranchListInput);
+
   return EL::StatusCode::SUCCESS;
 }
 
 
 
+EL::StatusCode BasicEventSelection :: changeEntryLists (bool firstFile)
+{
+  if ( firstFile && m_writeEntryList ) {
+    if ( m_forkWorkers > 1 ) {
+      ANA_MSG_ERROR( "m_writeEntryList is not supported with m_forkWorkers, the entries of the workers would be missing from the list");
+      return EL::StatusCode::FAILURE;
+    }
+    TFile *fileMD = wk()->getOutputFile (m_metaDataStreamName);
+    m_entryList = new TEntryList("entryList", "Entries passing BasicEventSelection");
+    m_entryList->SetDirectory( fileMD );
+  }
+
+  if ( firstFile && !m_entryListInput.empty() ) {
+    std::unique_ptr<TFile> listFile( TFile::Open( PathResolverFindCalibFile(m_entryListInput).c_str(), "READ" ) );
+    TEntryList* list = listFile ? dynamic_cast<TEntryList*>( listFile->Get("entryList") ) : nullptr;
+    if ( !list ) {
+      ANA_MSG_ERROR( "Cannot read the entryList of " << m_entryListInput);
+      return EL::StatusCode::FAILURE;
+    }
+    list->SetDirectory(nullptr);
+    m_entryListIn.reset(list);
+    ANA_MSG_INFO( "Processing only the " << m_entryListIn->GetN() << " entries of " << m_entryListInput);
+  }
+
+  TTree* tree = wk()->tree();
+  if ( m_entryList && tree ) m_entryList->SetTree(tree);
+
+  if ( m_entryListIn ) {
+    // match the sub-lists by file name, the inputs may have moved since the list was written
+    auto baseName = [](const std::string& path) { return path.substr( path.find_last_of('/') + 1 ); };
+    const std::string inputFile = baseName( wk()->inputFileName() );
+    m_entryListInFile = nullptr;
+    TList* subLists = m_entryListIn->GetLists();
+    if ( subLists ) {
+      for ( TObject* obj : *subLists ) {
+        TEntryList* subList = static_cast<TEntryList*>(obj);
+        if ( baseName(subList->GetFileName()) == inputFile ) { m_entryListInFile = subList; break; }
+      }
+    } else if ( baseName(m_entryListIn->GetFileName()) == inputFile ) {
+      m_entryListInFile = m_entryListIn.get();
+    }
+    if ( !m_entryListInFile ) ANA_MSG_WARNING( inputFile << " is not in " << m_entryListInput << ", all its entries are processed");
+  }
+
+  return EL::StatusCode::SUCCESS;
+}
+
 EL::StatusCode BasicEventSelection :: initialize ()
 {
   // Here you do everything that you need to do after the first input
@@ -451,6 +599,13 @@ EL::StatusCode BasicEventSelection :: initialize ()
     m_cutflowHistW->GetXaxis()->FindBin("SCT");
     m_cutflow_core = m_cutflowHist->GetXaxis()->FindBin("core");
     m_cutflowHistW->GetXaxis()->FindBin("core");
+
+    m_cleaningCutflowBins[0] = m_cutflow_lar;
+    m_cleaningCutflowBins[1] = m_cutflow_tile;
+    m_cleaningCutflowBins[2] = m_cutflow_SCT;
+    m_cleaningCutflowBins[3] = m_cutflow_core;
+    // bit 18 of the core flags marks incomplete events
+    m_coreFlagsRejectMask = m_applyCoreFlagsCut ? ( 1u << 18 ) : 0u;
   }
   if ( m_applyJetCleaningEventFlag ) {
     m_cutflow_jetcleaning = m_cutflowHist->GetXaxis()->FindBin("JetCleaning");
@@ -469,6 +624,12 @@ EL::StatusCode BasicEventSelection :: initialize ()
     m_cutflowHistW->GetXaxis()->FindBin("Trigger");
   }
 
+  // the per-event cutflow is counted in plain arrays and added to the histograms in finalize()
+  m_cutflowCounter .setHist( m_cutflowHist  );
+  m_cutflowCounterW.setHist( m_cutflowHistW );
+  addCheckpoint( &m_cutflowCounter );
+  addCheckpoint( &m_cutflowCounterW );
+
   ANA_MSG_INFO( "Histograms set up!");
 
   // -------------------------------------------------------------------------------------------------
@@ -506,6 +667,24 @@ EL::StatusCode BasicEventSelection :: initialize ()
     ANA_CHECK( m_grl_handle.setProperty("OutputLevel", msg().level()));
     ANA_CHECK( m_grl_handle.retrieve());
     ANA_MSG_DEBUG("Retrieved tool: " << m_grl_handle);
+
+    if ( m_useGRLIntervalIndex ) {
+      // take the lumi blocks as parsed by the tool, so that both give the same answer
+      const GoodRunsListSelectionTool* grlTool = dynamic_cast<const GoodRunsListSelectionTool*>( m_grl_handle.get() );
+      if ( !grlTool ) {
+        ANA_MSG_ERROR( "m_useGRLIntervalIndex needs a GoodRunsListSelectionTool, got " << m_grl_handle.typeAndName() );
+        return EL::StatusCode::FAILURE;
+      }
+      for ( const Root::TGoodRunsList& goodRunsList : grlTool->getGRLCollection() ) {
+        for ( const auto& goodRun : goodRunsList ) {
+          for ( const Root::TLumiBlockRange& range : goodRun.second ) {
+            m_grlIntervals.add( goodRun.first, range.Begin(), range.End() );
+          }
+        }
+      }
+      m_grlIntervals.finalize();
+      ANA_MSG_INFO( "Indexed the good lumi blocks of " << m_grlIntervals.nRuns() << " runs" );
+    }
   }
 
   // 2.
@@ -636,6 +815,24 @@ EL::StatusCode BasicEventSelection :: initialize ()
 
 EL::StatusCode BasicEventSelection :: execute ()
 {
+  auto event = beginEvent();
+  auto timer = timeExecute();
+  if ( eventRejected() ) return EL::StatusCode::SUCCESS;
+
+  // entries rejected by a previous pass: nothing is retrieved for them
+  if ( m_entryListInFile && !m_entryListInFile->Contains( wk()->treeEntry() ) ) {
+    rejectEvent();
+    return EL::StatusCode::SUCCESS;
+  }
+
+  // with m_forkWorkers the processes take the events in turn, starting from the one everything got initialised on
+  if ( m_forkWorkers > 1 ) {
+    if ( !m_forked ) ANA_CHECK( forkWorkers() );
+    if ( static_cast<unsigned int>(m_forkEvents++ % m_forkWorkers) != m_forkSlice ) {
+      rejectEvent();
+      return EL::StatusCode::SUCCESS;
+    }
+  }
   // Here you do everything that needs to be done on every single
   // events, e.g. read input variables, apply cuts, and fill
   // histograms and trees.  This is where most of your actual analysis
@@ -719,7 +916,7 @@ EL::StatusCode BasicEventSelection :: execute ()
         if( eventInfo->eventNumber() == 1652845 ) {
           ANA_MSG_INFO("Dropping huge weight event. Weight should be 352220000");
           ANA_MSG_INFO("WEIGHT : " << mcEvtWeight);
-          wk()->skipEvent();
+          rejectEvent();
           return EL::StatusCode::SUCCESS; // go to next event
         }
       }
@@ -756,8 +953,7 @@ EL::StatusCode BasicEventSelection :: execute ()
 
   if( !m_useMetaData )
     {
-      m_cutflowHist ->Fill( m_cutflow_all, 1 );
-      m_cutflowHistW->Fill( m_cutflow_all, mcEvtWeight);
+      fillCutflow( m_cutflow_all, mcEvtWeight );
 
       m_histEventCount -> Fill(1, 1);
       m_histEventCount -> Fill(2, 1);
@@ -767,19 +963,21 @@ EL::StatusCode BasicEventSelection :: execute ()
       m_histEventCount -> Fill(6, mcEvtWeight*mcEvtWeight);
     }
 
-  m_cutflowHist ->Fill( m_cutflow_init, 1 );
-  m_cutflowHistW->Fill( m_cutflow_init, mcEvtWeight);
+  fillCutflow( m_cutflow_init, mcEvtWeight );
 
   //--------------------------------------------------------------------------------------------------------
   // Check current event is not a duplicate
-  // This is done by checking against the std::set of <runNumber,eventNumber> filled for all previous events
+  // This is done by checking against the set of (runNumber, eventNumber) filled for all previous events
   //--------------------------------------------------------------------------------------------------------
 
   if ( ( !isMC() && m_checkDuplicatesData ) || ( isMC() && m_checkDuplicatesMC ) ) {
 
-    std::pair<uint32_t,uint32_t> thispair = std::make_pair(eventInfo->runNumber(),eventInfo->eventNumber());
+    if ( m_checkDuplicatesRunOrdered && eventInfo->runNumber() != m_duplicatesLastRun ) {
+      m_RunNr_VS_EvtNr.clear();
+      m_duplicatesLastRun = eventInfo->runNumber();
+    }
 
-    if ( m_RunNr_VS_EvtNr.find(thispair) != m_RunNr_VS_EvtNr.end() ) {
+    if ( !m_RunNr_VS_EvtNr.insert(eventInfo->runNumber(), eventInfo->eventNumber()) ) {
 
       ANA_MSG_WARNING("Found duplicated event! runNumber = " << static_cast<uint32_t>(eventInfo->runNumber()) << ", eventNumber = " << static_cast<uint32_t>(eventInfo->eventNumber()) << ". Skipping this event");
 
@@ -790,14 +988,11 @@ EL::StatusCode BasicEventSelection :: execute ()
 
       m_duplicatesTree->Fill();
 
-      wk()->skipEvent();
+      rejectEvent();
       return EL::StatusCode::SUCCESS; // go to next event
     }
 
-    m_RunNr_VS_EvtNr.insert(thispair);
-
-    m_cutflowHist ->Fill( m_cutflow_duplicates, 1 );
-    m_cutflowHistW->Fill( m_cutflow_duplicates, mcEvtWeight);
+    fillCutflow( m_cutflow_duplicates, mcEvtWeight );
 
   }
 
@@ -830,10 +1025,13 @@ EL::StatusCode BasicEventSelection :: execute ()
       }
   }
 
+  // the run context the efficiency correctors pick their configuration from, once the PRW decorations are there
+  xAH::RunContext::publish( *eventInfo );
+
   if ( m_actualMuMin > 0 ) {
       // apply minimum pile-up cut
       if ( eventInfo->actualInteractionsPerCrossing() < m_actualMuMin ) { // veto event
-          wk()->skipEvent();
+          rejectEvent();
           return EL::StatusCode::SUCCESS;
       }
   }
@@ -841,7 +1039,7 @@ EL::StatusCode BasicEventSelection :: execute ()
   if ( m_actualMuMax > 0 ) {
       // apply maximum pile-up cut
       if ( eventInfo->actualInteractionsPerCrossing() > m_actualMuMax ) { // veto event
-          wk()->skipEvent();
+          rejectEvent();
           return EL::StatusCode::SUCCESS;
       }
   }
@@ -861,12 +1059,13 @@ EL::StatusCode BasicEventSelection :: execute ()
 
     // GRL
     if ( m_applyGRLCut ) {
-      if ( !m_grl_handle->passRunLB( *eventInfo ) ) {
-        wk()->skipEvent();
+      const bool passGRL = m_useGRLIntervalIndex ? m_grlIntervals.contains( eventInfo->runNumber(), eventInfo->lumiBlock() )
+                                                 : m_grl_handle->passRunLB( *eventInfo );
+      if ( !passGRL ) {
+        rejectEvent();
         return EL::StatusCode::SUCCESS; // go to next event
       }
-      m_cutflowHist ->Fill( m_cutflow_grl, 1 );
-      m_cutflowHistW->Fill( m_cutflow_grl, mcEvtWeight);
+      fillCutflow( m_cutflow_grl, mcEvtWeight );
     }
 
     //------------------------------------------------------------
@@ -875,56 +1074,42 @@ EL::StatusCode BasicEventSelection :: execute ()
     // Apply to data.
     //------------------------------------------------------------
 
-    if ( m_applyEventCleaningCut && (eventInfo->errorState(xAOD::EventInfo::LAr)==xAOD::EventInfo::Error ) ) {
-      wk()->skipEvent();
-      return EL::StatusCode::SUCCESS;
-    }
-    m_cutflowHist ->Fill( m_cutflow_lar, 1 );
-    m_cutflowHistW->Fill( m_cutflow_lar, mcEvtWeight);
-
-    if ( m_applyEventCleaningCut && (eventInfo->errorState(xAOD::EventInfo::Tile)==xAOD::EventInfo::Error ) ) {
-      wk()->skipEvent();
-      return EL::StatusCode::SUCCESS;
-    }
-    m_cutflowHist ->Fill( m_cutflow_tile, 1 );
-    m_cutflowHistW->Fill( m_cutflow_tile, mcEvtWeight);
-
-    if ( m_applyEventCleaningCut && (eventInfo->errorState(xAOD::EventInfo::SCT)==xAOD::EventInfo::Error) ) {
-      wk()->skipEvent();
-      return EL::StatusCode::SUCCESS;
+    // all cleaning cuts in one go: count how many pass in cutflow order, the event is rejected at the first failing one
+    unsigned int nPassCleaning = 0;
+    if ( m_applyEventCleaningCut ) {
+      static const xAOD::EventInfo::EventFlagSubDet cleaningSubDets[] = { xAOD::EventInfo::LAr, xAOD::EventInfo::Tile, xAOD::EventInfo::SCT };
+      while ( nPassCleaning < 3 && eventInfo->errorState( cleaningSubDets[nPassCleaning] ) != xAOD::EventInfo::Error ) ++nPassCleaning;
+    } else {
+      nPassCleaning = 3;
     }
-    m_cutflowHist ->Fill( m_cutflow_SCT, 1 );
-    m_cutflowHistW->Fill( m_cutflow_SCT, mcEvtWeight);
+    if ( nPassCleaning == 3 && ( !m_coreFlagsRejectMask || !( eventInfo->eventFlags(xAOD::EventInfo::Core) & m_coreFlagsRejectMask ) ) ) ++nPassCleaning;
 
-    if ( m_applyCoreFlagsCut && (eventInfo->isEventFlagBitSet(xAOD::EventInfo::Core, 18) ) ) {
-      wk()->skipEvent();
+    for ( unsigned int iCut = 0; iCut < nPassCleaning; ++iCut ) fillCutflow( m_cleaningCutflowBins[iCut], mcEvtWeight );
+    if ( nPassCleaning < 4 ) {
+      rejectEvent();
       return EL::StatusCode::SUCCESS;
     }
-    m_cutflowHist ->Fill( m_cutflow_core, 1 );
-    m_cutflowHistW->Fill( m_cutflow_core, mcEvtWeight);
 
   }
 
   // more info: https://twiki.cern.ch/twiki/bin/viewauth/AtlasProtected/HowToCleanJets2017
   if ( m_applyJetCleaningEventFlag && eventInfo->isAvailable<char>("DFCommonJets_eventClean_LooseBad") ) {
     if(eventInfo->auxdataConst<char>("DFCommonJets_eventClean_LooseBad")<1) {
-	wk()->skipEvent();
+	rejectEvent();
 	return EL::StatusCode::SUCCESS;
       }
   }
-  m_cutflowHist ->Fill( m_cutflow_jetcleaning, 1 );
-  m_cutflowHistW->Fill( m_cutflow_jetcleaning, mcEvtWeight);
+  fillCutflow( m_cutflow_jetcleaning, mcEvtWeight );
 
   // n.b. this cut should only be applied in 2015+16 data, and not to MC!
   // details here: https://twiki.cern.ch/twiki/bin/viewauth/AtlasProtected/HowToCleanJets2017#IsBadBatMan_Event_Flag_and_EMEC
   if ( m_applyIsBadBatmanFlag && eventInfo->isAvailable<char>("DFCommonJets_isBadBatman") &&  !isMC() ) {
     if(eventInfo->auxdataConst<char>("DFCommonJets_isBadBatman")>0) {
-      wk()->skipEvent();
+      rejectEvent();
       return EL::StatusCode::SUCCESS;
     }
   }
-  m_cutflowHist ->Fill( m_cutflow_isbadbatman, 1 );
-  m_cutflowHistW->Fill( m_cutflow_isbadbatman, mcEvtWeight);
+  fillCutflow( m_cutflow_isbadbatman, mcEvtWeight );
 
   //-----------------------------
   // Primary Vertex 'quality' cut
@@ -935,12 +1120,11 @@ EL::StatusCode BasicEventSelection :: execute ()
     ANA_CHECK( HelperFunctions::retrieve(vertices, m_vertexContainerName, m_event, m_store, msg()) );
 
     if ( !HelperFunctions::passPrimaryVertexSelection( vertices, m_PVNTrack ) ) {
-      wk()->skipEvent();
+      rejectEvent();
       return EL::StatusCode::SUCCESS;
     }
   }
-  m_cutflowHist ->Fill( m_cutflow_npv, 1 );
-  m_cutflowHistW->Fill( m_cutflow_npv, mcEvtWeight);
+  fillCutflow( m_cutflow_npv, mcEvtWeight );
 
   //---------------------
   // Trigger decision cut
@@ -948,16 +1132,31 @@ EL::StatusCode BasicEventSelection :: execute ()
 
   if ( !m_triggerSelection.empty() || m_storeTrigDecisions ) {
 
-    auto triggerChainGroup = m_trigDecTool_handle->getChainGroup(m_triggerSelection);
+    m_eventSMK    = m_trigConfTool_handle->masterKey();
+    m_eventL1PSK  = m_trigConfTool_handle->lvl1PrescaleKey();
+    m_eventHLTPSK = m_trigConfTool_handle->hltPrescaleKey();
+
+    // resolving a chain group matches its pattern against the menu, so only do it when the menu changes
+    if ( !m_triggerChainGroup || m_eventSMK != m_chainGroupsSMK ) updateChainGroups();
+    const Trig::ChainGroup* triggerChainGroup = m_triggerChainGroup;
+
+    // the prescales only change with the trigger configuration keys
+    if ( m_eventSMK != m_prescaleSMK || m_eventL1PSK != m_prescaleL1PSK || m_eventHLTPSK != m_prescaleHLTPSK ) {
+      m_prescaleSMK    = m_eventSMK;
+      m_prescaleL1PSK  = m_eventL1PSK;
+      m_prescaleHLTPSK = m_eventHLTPSK;
+      for ( CachedChain& chain : m_triggerChains )      chain.hasPrescale = false;
+      for ( CachedChain& chain : m_extraTriggerChains ) chain.hasPrescale = false;
+      m_triggerSelectionChain.hasPrescale = false;
+    }
 
     if ( m_applyTriggerCut ) {
 
       if ( !triggerChainGroup->isPassed() ) {
-        wk()->skipEvent();
+        rejectEvent();
         return EL::StatusCode::SUCCESS;
       }
-      m_cutflowHist ->Fill( m_cutflow_trigger, 1 );
-      m_cutflowHistW->Fill( m_cutflow_trigger, mcEvtWeight);
+      fillCutflow( m_cutflow_trigger, mcEvtWeight );
 
     }
 
@@ -965,77 +1164,99 @@ EL::StatusCode BasicEventSelection :: execute ()
     //
     if ( m_storeTrigDecisions ) {
 
+      // Save info for the triggers used to skim events
+      //
+      // the luminosity prescales are constant within a lumi block
+      if ( eventInfo->runNumber() != m_lumiPrescaleRun || eventInfo->lumiBlock() != m_lumiPrescaleLB || eventInfo->averageInteractionsPerCrossing() != m_lumiPrescaleMu ) {
+        m_lumiPrescaleRun = eventInfo->runNumber();
+        m_lumiPrescaleLB  = eventInfo->lumiBlock();
+        m_lumiPrescaleMu  = eventInfo->averageInteractionsPerCrossing();
+        for ( CachedChain& chain : m_triggerChains )      chain.hasLumiPrescale = false;
+        for ( CachedChain& chain : m_extraTriggerChains ) chain.hasLumiPrescale = false;
+      }
+
       std::vector<std::string>  passedTriggers;
       std::vector<std::string>  disabledTriggers;
       std::vector<float>        triggerPrescales;
       std::vector<float>        triggerPrescalesLumi;
       std::vector<std::string>  isPassedBitsNames;
       std::vector<unsigned int> isPassedBits;
-
-      // Save info for the triggers used to skim events
-      //
-      for ( auto &trigName : triggerChainGroup->getListOfTriggers() ) {
-        auto trigChain = m_trigDecTool_handle->getChainGroup( trigName );
-        if ( trigChain->isPassed() ) {
-          passedTriggers.push_back( trigName );
-          triggerPrescales.push_back( trigChain->getPrescale() );
-
-          bool doLumiPrescale = std::find(m_triggerUnprescaleList.begin(), m_triggerUnprescaleList.end(), trigName) != m_triggerUnprescaleList.end();
-          if ( doLumiPrescale ) {
-            triggerPrescalesLumi.push_back( m_pileup_tool_handle->getDataWeight( *eventInfo, trigName, true ) );
-          } else {
-            triggerPrescalesLumi.push_back( -1 );
+      // packed forms, indexed by the position of the chain in m_triggerDictionaryID
+      std::vector<unsigned long long> passedTriggersBits;
+      std::vector<unsigned long long> disabledTriggersBits;
+      std::vector<float>        triggerPrescalesAll;
+      std::vector<float>        triggerPrescalesLumiAll;
+
+      unsigned int index = 0;
+      auto storeChain = [&](CachedChain& chain) {
+        const std::string& trigName = chain.name;
+        const Trig::ChainGroup* trigChain = chain.group;
+        const bool  passed   = trigChain->isPassed();
+        const float prescale = this->prescale( chain );
+        // the luminosity prescales are only read back for the chains that passed
+        const float prescaleLumi = passed && chain.doLumiPrescale ? lumiPrescale( chain, *eventInfo ) : -1;
+
+        if ( m_storeTrigDecisionsStrings ) {
+          if ( passed ) {
+            passedTriggers.push_back( trigName );
+            triggerPrescales.push_back( prescale );
+            triggerPrescalesLumi.push_back( prescaleLumi );
           }
+          isPassedBitsNames.push_back( trigName );
+          if ( prescale < 1 ) disabledTriggers.push_back( trigName );
         }
-        isPassedBitsNames.push_back( trigName );
-        isPassedBits     .push_back( m_trigDecTool_handle->isPassedBits(trigName) );
-	if(trigChain->getPrescale()<1) disabledTriggers.push_back( trigName );
-      }
+        if ( m_storeTrigDecisionsPacked ) {
+          if ( passed )       xAH::TriggerDictionary::setBit( passedTriggersBits, index );
+          if ( prescale < 1 ) xAH::TriggerDictionary::setBit( disabledTriggersBits, index );
+          triggerPrescalesAll.push_back( prescale );
+          triggerPrescalesLumiAll.push_back( prescaleLumi );
+        }
+        isPassedBits.push_back( m_trigDecTool_handle->isPassedBits(trigName) );
+        ++index;
+      };
+
+      for ( CachedChain& chain : m_triggerChains ) storeChain( chain );
 
       // Save info for extra triggers
       //
       if ( !m_extraTriggerSelection.empty() ) {
-
-	for ( const std::string &trigName : m_extraTriggerSelectionList ) {
-	  auto trigChain = m_trigDecTool_handle->getChainGroup( trigName );
-	  if ( trigChain->isPassed() ) {
-	    passedTriggers.push_back( trigName );
-	    triggerPrescales.push_back( trigChain->getPrescale() );
-
-      bool doLumiPrescale = true;
-      for ( const std::string &trigPart : trigChain->getListOfTriggers() ) {
-        if (std::find(m_triggerUnprescaleList.begin(), m_triggerUnprescaleList.end(), trigPart) == m_triggerUnprescaleList.end()) doLumiPrescale = false;
-      }
-      if ( doLumiPrescale ) {
-        triggerPrescalesLumi.push_back( m_pileup_tool_handle->getDataWeight( *eventInfo, trigName, true ) );
-      } else {
-        triggerPrescalesLumi.push_back( -1 );
-      }
-	  }
-	  isPassedBitsNames.push_back( trigName );
-	  isPassedBits     .push_back( m_trigDecTool_handle->isPassedBits(trigName) );
-	  if(trigChain->getPrescale()<1) disabledTriggers.push_back( trigName );
-	}
+        for ( CachedChain& chain : m_extraTriggerChains ) storeChain( chain );
       }
 
-      static SG::AuxElement::Decorator< std::vector< std::string > >  dec_passedTriggers("passedTriggers");
-      dec_passedTriggers  ( *eventInfo ) = passedTriggers;
-      static SG::AuxElement::Decorator< std::vector< std::string > >  dec_disabledTriggers("disabledTriggers");
-      dec_disabledTriggers( *eventInfo ) = disabledTriggers;
-      static SG::AuxElement::Decorator< std::vector< float > >        dec_triggerPrescales("triggerPrescales");
-      dec_triggerPrescales( *eventInfo ) = triggerPrescales;
-      static SG::AuxElement::Decorator< std::vector< float > >        dec_triggerPrescalesLumi("triggerPrescalesLumi");
-      dec_triggerPrescalesLumi( *eventInfo ) = triggerPrescalesLumi;
       static SG::AuxElement::Decorator< std::vector< unsigned int > > dec_isPassedBits("isPassedBits");
-      dec_isPassedBits( *eventInfo ) = isPassedBits;
-      static SG::AuxElement::Decorator< std::vector< std::string > >  dec_isPassedBitsNames("isPassedBitsNames");
-      dec_isPassedBitsNames( *eventInfo ) = isPassedBitsNames;
+      dec_isPassedBits( *eventInfo ) = std::move(isPassedBits);
+
+      if ( m_storeTrigDecisionsStrings ) {
+        static SG::AuxElement::Decorator< std::vector< std::string > >  dec_passedTriggers("passedTriggers");
+        dec_passedTriggers  ( *eventInfo ) = std::move(passedTriggers);
+        static SG::AuxElement::Decorator< std::vector< std::string > >  dec_disabledTriggers("disabledTriggers");
+        dec_disabledTriggers( *eventInfo ) = std::move(disabledTriggers);
+        static SG::AuxElement::Decorator< std::vector< float > >        dec_triggerPrescales("triggerPrescales");
+        dec_triggerPrescales( *eventInfo ) = std::move(triggerPrescales);
+        static SG::AuxElement::Decorator< std::vector< float > >        dec_triggerPrescalesLumi("triggerPrescalesLumi");
+        dec_triggerPrescalesLumi( *eventInfo ) = std::move(triggerPrescalesLumi);
+        static SG::AuxElement::Decorator< std::vector< std::string > >  dec_isPassedBitsNames("isPassedBitsNames");
+        dec_isPassedBitsNames( *eventInfo ) = std::move(isPassedBitsNames);
+      }
+
+      if ( m_storeTrigDecisionsPacked ) {
+        static SG::AuxElement::Decorator< unsigned int >                      dec_triggerDictionaryID("triggerDictionaryID");
+        dec_triggerDictionaryID( *eventInfo ) = m_triggerDictionaryID;
+        static SG::AuxElement::Decorator< std::vector< unsigned long long > > dec_passedTriggersBits("passedTriggersBits");
+        dec_passedTriggersBits( *eventInfo ) = std::move(passedTriggersBits);
+        static SG::AuxElement::Decorator< std::vector< unsigned long long > > dec_disabledTriggersBits("disabledTriggersBits");
+        dec_disabledTriggersBits( *eventInfo ) = std::move(disabledTriggersBits);
+        static SG::AuxElement::Decorator< std::vector< float > >              dec_triggerPrescalesAll("triggerPrescalesAll");
+        dec_triggerPrescalesAll( *eventInfo ) = std::move(triggerPrescalesAll);
+        static SG::AuxElement::Decorator< std::vector< float > >              dec_triggerPrescalesLumiAll("triggerPrescalesLumiAll");
+        dec_triggerPrescalesLumiAll( *eventInfo ) = std::move(triggerPrescalesLumiAll);
+      }
 
     }
 
     if ( m_storePrescaleWeight ) {
       static SG::AuxElement::Decorator< float > weight_prescale("weight_prescale");
-      weight_prescale(*eventInfo) = triggerChainGroup->getPrescale();
+      weight_prescale(*eventInfo) = prescale( m_triggerSelectionChain );
     }
 
     if ( m_storePassL1 ) {
@@ -1096,11 +1317,25 @@ EL::StatusCode BasicEventSelection :: execute ()
 
   }//if data
 
+  if ( m_entryList ) m_entryList->Enter( wk()->treeEntry() );
+
   return EL::StatusCode::SUCCESS;
 }
 
 // "Borrowed" from SUSYTools
 // https://gitlab.cern.ch/atlas/athena/blob/3be30397de7c6cfdc15de38f532fdb4b9f338297/PhysicsAnalysis/SUSYPhys/SUSYTools/Root/SUSYObjDef_xAOD.cxx#L700
+const std::string& BasicEventSelection::resolvePRWConfigFile(const std::string& fileName)
+{
+  // shared by all instances in the job, the resolution does not depend on the algorithm
+  static std::mutex mutex;
+  static std::map<std::string, std::string> resolved;
+
+  std::lock_guard<std::mutex> lock(mutex);
+  auto itr = resolved.find(fileName);
+  if ( itr == resolved.end() ) itr = resolved.emplace(fileName, PathResolverFindCalibFile(fileName)).first;
+  return itr->second;
+}
+
 StatusCode BasicEventSelection::autoconfigurePileupRWTool()
 {
 
@@ -1219,9 +1454,9 @@ StatusCode BasicEventSelection::autoconfigurePileupRWTool()
   std::vector<std::string> prwConfigFiles;
   for(const auto& mcCampaign : mcCampaignList)
     {
-      std::string prwConfigFile = PathResolverFindCalibFile("/dev/PileupReweighting/share/DSID" + std::to_string(DSID_INT/1000) +"xxx/pileup_" + mcCampaign + "_dsid" + std::to_string(DSID_INT) + "_" + SimulationFlavour + ".root");
-      TFile testF(prwConfigFile.data(),"read");
-      if(testF.IsZombie())
+      const std::string prwConfigFile = resolvePRWConfigFile("/dev/PileupReweighting/share/DSID" + std::to_string(DSID_INT/1000) +"xxx/pileup_" + mcCampaign + "_dsid" + std::to_string(DSID_INT) + "_" + SimulationFlavour + ".root");
+      // the PRW tool opens and checks the file itself, opening it here too would mean another read from CVMFS
+      if(prwConfigFile.empty())
 	{
 	  ANA_MSG_ERROR("autoconfigurePileupRWTool(): Missing PRW config file for DSID " << std::to_string(DSID_INT) << " in campaign " << mcCampaign);
 	  return StatusCode::FAILURE;
@@ -1306,8 +1541,60 @@ StatusCode BasicEventSelection::autoconfigurePileupRWTool()
 }
 
 
+float BasicEventSelection :: prescale ( CachedChain& chain )
+{
+  if ( !chain.hasPrescale ) {
+    chain.prescale    = chain.group->getPrescale();
+    chain.hasPrescale = true;
+  }
+  return chain.prescale;
+}
+
+float BasicEventSelection :: lumiPrescale ( CachedChain& chain, const xAOD::EventInfo& eventInfo )
+{
+  if ( !chain.hasLumiPrescale ) {
+    chain.lumiPrescale    = m_pileup_tool_handle->getDataWeight( eventInfo, chain.name, true );
+    chain.hasLumiPrescale = true;
+  }
+  return chain.lumiPrescale;
+}
+
+void BasicEventSelection :: updateChainGroups ()
+{
+  m_chainGroupsSMK = m_trigConfTool_handle->masterKey();
+  ANA_MSG_DEBUG( "Resolving the trigger chain groups for SMK " << m_chainGroupsSMK );
+
+  auto isUnprescaled = [this](const std::string& trigName) {
+    return std::find(m_triggerUnprescaleList.begin(), m_triggerUnprescaleList.end(), trigName) != m_triggerUnprescaleList.end();
+  };
+
+  m_triggerChainGroup = m_trigDecTool_handle->getChainGroup(m_triggerSelection);
+  m_triggerSelectionChain = CachedChain{ m_triggerSelection, m_triggerChainGroup, false };
+
+  m_triggerChains.clear();
+  for ( const std::string& trigName : m_triggerChainGroup->getListOfTriggers() ) {
+    m_triggerChains.push_back( CachedChain{ trigName, m_trigDecTool_handle->getChainGroup( trigName ), isUnprescaled( trigName ) } );
+  }
+
+  m_extraTriggerChains.clear();
+  for ( const std::string& trigName : m_extraTriggerSelectionList ) {
+    const Trig::ChainGroup* trigChain = m_trigDecTool_handle->getChainGroup( trigName );
+    const std::vector<std::string> trigParts = trigChain->getListOfTriggers();
+    m_extraTriggerChains.push_back( CachedChain{ trigName, trigChain, std::all_of( trigParts.begin(), trigParts.end(), isUnprescaled ) } );
+  }
+
+  std::vector<std::string> dictionary;
+  for ( const CachedChain& chain : m_triggerChains ) dictionary.push_back( chain.name );
+  if ( !m_extraTriggerSelection.empty() ) {
+    for ( const CachedChain& chain : m_extraTriggerChains ) dictionary.push_back( chain.name );
+  }
+  m_triggerDictionaryID = xAH::TriggerDictionary::intern( dictionary );
+}
+
 EL::StatusCode BasicEventSelection :: postExecute ()
 {
+  auto timer = timePostExecute();
+  if ( eventRejected() ) return EL::StatusCode::SUCCESS;
   // Here you do everything that needs to be done after the main event
   // processing.  This is typically very rare, particularly in user
   // code.  It is mainly used in implementing the NTupleSvc.
@@ -1329,10 +1616,22 @@ EL::StatusCode BasicEventSelection :: finalize ()
   // merged.  This is different from histFinalize() in that it only
   // gets called on worker nodes that processed input events.
 
+  // the workers hand their histograms over and exit here
+  if ( m_forked ) ANA_CHECK( joinWorkers() );
+
   ANA_MSG_INFO( "Number of processed events \t= " << m_eventCounter);
 
+  m_cutflowCounter .flush();
+  m_cutflowCounterW.flush();
+
   m_RunNr_VS_EvtNr.clear();
 
+  m_filePrefetcher.reset();
+
+  if ( m_entryList ) ANA_MSG_INFO( "Recorded " << m_entryList->GetN() << " passing entries in " << m_metaDataStreamName << "/entryList");
+  m_entryListInFile = nullptr;
+  m_entryListIn.reset();
+
   if ( m_trigDecTool_handle.isInitialized() ){
     if (asg::ToolStore::contains<Trig::TrigDecisionTool>("ToolSvc.TrigDecisionTool") ){
       m_trigDecTool_handle->finalize();
@@ -1345,10 +1644,145 @@ EL::StatusCode BasicEventSelection :: finalize ()
     xAOD::IOStats::instance().stats().printSmartSlimmingBranchList();
   }
 
+  if ( !m_readBranchListOutput.empty() ) {
+    const xAOD::ReadStats& stats = xAOD::IOStats::instance().stats();
+    std::set<std::string> branchNames;
+    for ( const auto& container : stats.containers() ) {
+      if ( container.second.readEntries() > 0 ) branchNames.insert( container.second.GetName() );
+    }
+    for ( const auto& branches : stats.branches() ) {
+      for ( const xAOD::BranchStats* branch : branches.second ) {
+        if ( branch && branch->readEntries() > 0 ) branchNames.insert( branch->GetName() );
+      }
+    }
+
+    std::ofstream branchList( m_readBranchListOutput );
+    for ( const std::string& branchName : branchNames ) branchList << branchName << "\n";
+    ANA_MSG_INFO( "Wrote the " << branchNames.size() << " branches read to " << m_readBranchListOutput);
+  }
+
+  return EL::StatusCode::SUCCESS;
+}
+
+
+
+std::string BasicEventSelection :: forkFileName (unsigned int slice) const
+{
+  return "fork_" + m_name + "_" + std::to_string(m_forkParent) + "_" + std::to_string(slice) + ".root";
+}
+
+EL::StatusCode BasicEventSelection :: forkWorkers ()
+{
+  m_forked = true;
+  m_forkParent = getpid();
+
+  // the workers only hand back the histograms registered for the checkpoints, anything else they write would be lost
+  for ( const std::string& className : {"TreeAlgo", "MinixAOD", "Writer"} ) {
+    if ( m_instanceRegistry.count(className) && m_instanceRegistry.at(className) > 0 ) {
+      ANA_MSG_ERROR( "m_forkWorkers is not supported with " << className << " in the job, the events of the workers would be missing from its output");
+      return EL::StatusCode::FAILURE;
+    }
+  }
+  for ( const std::string& what : xAH::HistCheckpoint::unregistered() ) {
+    ANA_MSG_ERROR( "m_forkWorkers is not supported with " << what << " in the job, the workers cannot hand its histograms back");
+    return EL::StatusCode::FAILURE;
+  }
+  if ( ( !isMC() && m_checkDuplicatesData ) || ( isMC() && m_checkDuplicatesMC ) ) {
+    ANA_MSG_ERROR( "m_forkWorkers is not supported with m_checkDuplicatesData/m_checkDuplicatesMC, each process only sees its own events and the duplicates tree would miss those of the workers");
+    return EL::StatusCode::FAILURE;
+  }
+
+  // no thread survives the fork, the prefetcher is started again at the next file
+  m_filePrefetcher.reset();
+  std::cout.flush();
+  std::cerr.flush();
+  std::fflush(nullptr);
+
+  for ( unsigned int slice = 1; slice < m_forkWorkers; ++slice ) {
+    const pid_t pid = fork();
+    if ( pid < 0 ) {
+      ANA_MSG_ERROR( "Cannot fork worker " << slice << ": " << std::strerror(errno));
+      return EL::StatusCode::FAILURE;
+    }
+    if ( pid > 0 ) {
+      m_forkPids.push_back(pid);
+      continue;
+    }
+
+    m_forkSlice = slice;
+    m_forkPids.clear();
+    // the inherited descriptors of m_doPerfCounters would keep counting the first process
+    xAH::PerfCounters::reopen();
+    // what was filled before the fork (e.g. the metadata of the first file) is in the histograms of the first process already
+    xAH::HistCheckpoint::resetAll();
+    msg().setName( m_className + "." + m_name + ".worker" + std::to_string(slice) );
+    xAH::HistCheckpoint::setFileTag( "_worker" + std::to_string(slice) );
+
+    // the workers are spread over the nodes in turn, starting from the one of the first process
+    if ( m_numaNodes.size() > 1 && m_numaNode >= 0 ) {
+      const xAH::CpuPinning::Node& node = m_numaNodes[(m_numaNode + slice) % m_numaNodes.size()];
+      const std::string error = xAH::CpuPinning::pinToNode( node );
+      if ( error.empty() ) ANA_MSG_INFO( "Pinned worker " << slice << " to NUMA node " << node.id);
+      else                 ANA_MSG_WARNING( "Cannot pin worker " << slice << " to NUMA node " << node.id << ": " << error);
+    }
+
+    // the descriptor of the open input file is shared with the other processes, as is its offset: read it through a file of our own
+    m_forkInputFile.reset( TFile::Open( wk()->inputFileName().c_str(), "READ" ) );
+    if ( !m_forkInputFile || m_forkInputFile->IsZombie() ) {
+      ANA_MSG_ERROR( "Cannot reopen " << wk()->inputFileName() << " in worker " << slice);
+      return EL::StatusCode::FAILURE;
+    }
+    ANA_CHECK( m_event->readFrom( m_forkInputFile.get() ));
+    if ( m_event->getEntry( wk()->treeEntry() ) < 0 ) {
+      ANA_MSG_ERROR( "Cannot read entry " << wk()->treeEntry() << " of " << wk()->inputFileName() << " in worker " << slice);
+      return EL::StatusCode::FAILURE;
+    }
+    return EL::StatusCode::SUCCESS;
+  }
+
+  ANA_MSG_INFO( "Forked " << m_forkPids.size() << " worker processes, each process takes one event in " << m_forkWorkers);
   return EL::StatusCode::SUCCESS;
 }
 
+EL::StatusCode BasicEventSelection :: joinWorkers ()
+{
+  if ( m_forkSlice > 0 ) {
+    ANA_MSG_INFO( "Processed " << m_eventCounter << " events, handing the histograms over to the first process");
+    const bool written = xAH::HistCheckpoint::writeAll( forkFileName(m_forkSlice), m_eventCounter );
+    if ( !written ) ANA_MSG_ERROR( "Cannot write " << forkFileName(m_forkSlice));
+    std::cout.flush();
+    std::cerr.flush();
+    std::fflush(nullptr);
+    // leave without writing the output of the job, which is the one of the first process
+    std::_Exit( written ? 0 : 1 );
+  }
+
+  bool failed = false;
+  for ( unsigned int i = 0; i < m_forkPids.size(); ++i ) {
+    const unsigned int slice = i + 1;
+    int status = 0;
+    if ( waitpid( m_forkPids[i], &status, 0 ) < 0 || !WIFEXITED(status) || WEXITSTATUS(status) != 0 ) {
+      ANA_MSG_ERROR( "Worker " << slice << " failed, its events are missing from the output");
+      failed = true;
+      continue;
+    }
 
+    std::vector<std::string> unmatched;
+    const int merged = xAH::HistCheckpoint::mergeAll( forkFileName(slice), unmatched );
+    if ( merged < 0 ) {
+      ANA_MSG_ERROR( "Cannot read the histograms of worker " << slice << " from " << forkFileName(slice));
+      failed = true;
+      continue;
+    }
+    for ( const std::string& name : unmatched ) ANA_MSG_WARNING( "Histogram " << name << " of worker " << slice << " has no counterpart, it is not merged");
+    ANA_MSG_INFO( "Merged " << merged << " histograms of worker " << slice);
+    std::remove( forkFileName(slice).c_str() );
+  }
+  m_forkPids.clear();
+  m_forkInputFile.reset();
+
+  return failed ? EL::StatusCode::FAILURE : EL::StatusCode::SUCCESS;
+}
 
 EL::StatusCode BasicEventSelection :: histFinalize ()
 {
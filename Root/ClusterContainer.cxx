@@ -52,3 +52,8 @@ void ClusterContainer::FillCluster( const xAOD::IParticle* particle )
   ParticleContainer::FillParticle(particle);
   return;
 }
+
+const xAOD::CaloClusterContainer* ClusterContainer::select( const xAOD::CaloClusterContainer* clusters )
+{
+  return HelperFunctions::selectLeadingPt( clusters, m_infoSwitch, m_selected );
+}
@@ -1,11 +1,13 @@
 #include "xAODAnaHelpers/ClusterHists.h"
+#include "xAODAnaHelpers/HelperFunctions.h"
 
 #include <math.h>
 
 ANA_MSG_SOURCE(msgClusterHists, "ClusterHists")
 
 ClusterHists :: ClusterHists (std::string name, std::string detailStr) :
-  HistogramManager(name, detailStr)
+  HistogramManager(name, detailStr),
+  m_infoSwitch(new HelperClasses::ClusterInfoSwitch(m_detailStr))
 {
 }
 
@@ -14,29 +16,53 @@ ClusterHists :: ~ClusterHists () {}
 StatusCode ClusterHists::initialize() {
 
   // These plots are always made
-  m_ccl_n   = book(m_name, "n", "cluster multiplicity", 80, 0, 800);
-  m_ccl_e   = book(m_name, "e", "cluster e [GeV]", 100, -5, 15);
-  m_ccl_eta = book(m_name, "eta", "cluster #eta", 80, -4, 4);
-  m_ccl_phi = book(m_name, "phi", "cluster #phi", 120, -TMath::Pi(), TMath::Pi());
+  bookHandle( kN,   book(m_name, "n", "cluster multiplicity", 80, 0, 800) );
+  bookHandle( kE,   book(m_name, "e", "cluster e [GeV]", 100, -5, 15) );
+  bookHandle( kEta, book(m_name, "eta", "cluster #eta", 80, -4, 4) );
+  bookHandle( kPhi, book(m_name, "phi", "cluster #phi", 120, -TMath::Pi(), TMath::Pi()) );
+  m_ESlot   = fillSlot( hist(kE) );
+  m_EtaSlot = fillSlot( hist(kEta) );
+  m_PhiSlot = fillSlot( hist(kPhi) );
 
   // 2D plots
-  m_ccl_eta_vs_phi = book(m_name, "eta_vs_phi", "cluster #phi", 120, -TMath::Pi(), TMath::Pi(), "cluster #eta", 80, -4, 4);
-  m_ccl_e_vs_eta   = book(m_name, "e_vs_eta", "cluster #eta", 80, -4, 4, "cluster e [GeV]", 100, -5, 15);
-  m_ccl_e_vs_phi   = book(m_name, "e_vs_phi", "cluster #phi", 120, -TMath::Pi(), TMath::Pi(), "cluster e [GeV]", 100, -5, 15);
+  bookHandle( kEtaVsPhi, book(m_name, "eta_vs_phi", "cluster #phi", 120, -TMath::Pi(), TMath::Pi(), "cluster #eta", 80, -4, 4) );
+  bookHandle( kEVsEta,   book(m_name, "e_vs_eta", "cluster #eta", 80, -4, 4, "cluster e [GeV]", 100, -5, 15) );
+  bookHandle( kEVsPhi,   book(m_name, "e_vs_phi", "cluster #phi", 120, -TMath::Pi(), TMath::Pi(), "cluster e [GeV]", 100, -5, 15) );
 
   // if worker is passed to the class add histograms to the output
   return StatusCode::SUCCESS;
 }
 
 StatusCode ClusterHists::execute( const xAOD::CaloClusterContainer* ccls, float eventWeight ) {
-  using namespace msgClusterHists;
-  xAOD::CaloClusterContainer::const_iterator ccl_itr = ccls->begin();
-  xAOD::CaloClusterContainer::const_iterator ccl_end = ccls->end();
-  for( ; ccl_itr != ccl_end; ++ccl_itr ) {
-    ANA_CHECK( this->execute( (*ccl_itr), eventWeight ));
+
+  ccls = HelperFunctions::selectLeadingPt( ccls, *m_infoSwitch, m_selected );
+
+  // read the kinematics into contiguous arrays, then fill each histogram with the whole array
+  const std::size_t nClusters = ccls->size();
+  m_cclE.resize(nClusters);
+  m_cclEta.resize(nClusters);
+  m_cclPhi.resize(nClusters);
+  m_cclWeight.assign(nClusters, eventWeight);
+  for( std::size_t i = 0; i < nClusters; ++i ) {
+    const xAOD::CaloCluster* ccl = (*ccls)[i];
+    m_cclE[i]   = ccl->e()/1e3;
+    m_cclEta[i] = ccl->eta();
+    m_cclPhi[i] = ccl->phi();
+  }
+
+  //basic
+  fillBuffered( m_ESlot,   m_cclE.data(),   nClusters, eventWeight );
+  fillBuffered( m_EtaSlot, m_cclEta.data(), nClusters, eventWeight );
+  fillBuffered( m_PhiSlot, m_cclPhi.data(), nClusters, eventWeight );
+
+  // 2D plots
+  if( nClusters > 0 ) {
+    static_cast<TH2*>(hist(kEtaVsPhi))->FillN( nClusters, m_cclPhi.data(), m_cclEta.data(), m_cclWeight.data() );
+    static_cast<TH2*>(hist(kEVsEta))  ->FillN( nClusters, m_cclEta.data(), m_cclE.data(),   m_cclWeight.data() );
+    static_cast<TH2*>(hist(kEVsPhi))  ->FillN( nClusters, m_cclPhi.data(), m_cclE.data(),   m_cclWeight.data() );
   }
 
-  m_ccl_n -> Fill( ccls->size(), eventWeight );
+  fillHist( kN, ccls->size(), eventWeight );
 
   return StatusCode::SUCCESS;
 }
@@ -48,14 +74,14 @@ StatusCode ClusterHists::execute( const xAOD::CaloCluster* ccl, float eventWeigh
   float cclEta = ccl->eta();
   float cclPhi = ccl->phi();
 
-  m_ccl_e          -> Fill( cclE,   eventWeight );
-  m_ccl_eta        -> Fill( cclEta, eventWeight );
-  m_ccl_phi        -> Fill( cclPhi, eventWeight );
+  fillHist( kE,        cclE,   eventWeight );
+  fillHist( kEta,      cclEta, eventWeight );
+  fillHist( kPhi,      cclPhi, eventWeight );
 
   // 2D plots
-  m_ccl_eta_vs_phi -> Fill( cclPhi, cclEta,  eventWeight );
-  m_ccl_e_vs_eta   -> Fill( cclEta, cclE,    eventWeight );
-  m_ccl_e_vs_phi   -> Fill( cclPhi, cclE,    eventWeight );
+  fillHist( kEtaVsPhi, cclPhi, cclEta,  eventWeight );
+  fillHist( kEVsEta,   cclEta, cclE,    eventWeight );
+  fillHist( kEVsPhi,   cclPhi, cclE,    eventWeight );
 
   return StatusCode::SUCCESS;
 
@@ -41,6 +41,9 @@ EL::StatusCode ClusterHistsAlgo :: histInitialize ()
   m_plots = new ClusterHists(m_name, m_detailStr);
   ANA_CHECK( m_plots -> initialize());
   m_plots -> record( wk() );
+  ANA_CHECK( addHistMemory( *m_plots ));
+  addCheckpoint( m_plots );
+  reportHistMemory( "initialize", m_histBytes );
 
   return EL::StatusCode::SUCCESS;
 }
@@ -58,6 +61,9 @@ EL::StatusCode ClusterHistsAlgo :: initialize ()
 
 EL::StatusCode ClusterHistsAlgo :: execute ()
 {
+  auto event = beginEvent();
+  auto timer = timeExecute();
+  if ( eventRejected() ) return EL::StatusCode::SUCCESS;
   const xAOD::EventInfo* eventInfo(nullptr);
   ANA_CHECK( HelperFunctions::retrieve(eventInfo, m_eventInfoContainerName, m_event, m_store, msg()) );
 
@@ -76,11 +82,18 @@ EL::StatusCode ClusterHistsAlgo :: execute ()
 }
 
 EL::StatusCode ClusterHistsAlgo :: postExecute () { return EL::StatusCode::SUCCESS; }
-EL::StatusCode ClusterHistsAlgo :: finalize () { return EL::StatusCode::SUCCESS; }
+EL::StatusCode ClusterHistsAlgo :: finalize () {
+  // the batched fills are only in the histograms once the buffers are flushed
+  if(m_plots) ANA_CHECK( m_plots->finalize());
+  return EL::StatusCode::SUCCESS;
+}
 EL::StatusCode ClusterHistsAlgo :: histFinalize ()
 {
   // clean up memory
-  if(m_plots) delete m_plots;
+  if(m_plots){
+    reportHistMemory( "finalize", m_plots->memoryBytes() );
+    delete m_plots;
+  }
   ANA_CHECK( xAH::Algorithm::algFinalize());
   return EL::StatusCode::SUCCESS;
 }
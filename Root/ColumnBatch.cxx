@@ -0,0 +1,144 @@
+#include <xAODAnaHelpers/ColumnBatch.h>
+
+#include <algorithm>
+
+xAH::ColumnBatch::ColumnBatch(const std::string& prefix, const std::string& suffix) :
+  m_prefix(prefix),
+  m_suffix(suffix),
+  m_offsets(1, 0)
+{}
+
+xAH::ColumnBatch::ColumnBatch(ColumnBatch&& other) :
+  m_offsets(1, 0)
+{
+  *this = std::move(other);
+}
+
+xAH::ColumnBatch& xAH::ColumnBatch::operator=(ColumnBatch&& other)
+{
+  if(this == &other) return *this;
+  m_prefix    = std::move(other.m_prefix);
+  m_suffix    = std::move(other.m_suffix);
+  m_variables = std::move(other.m_variables);
+  m_types     = std::move(other.m_types);
+  m_floats    = std::move(other.m_floats);
+  m_ints      = std::move(other.m_ints);
+  m_chars     = std::move(other.m_chars);
+  m_words     = std::move(other.m_words);
+  m_offsets   = std::move(other.m_offsets);
+
+  // a moved-from batch is an empty one, which read() refuses
+  other.m_variables.clear();
+  other.m_types.clear();
+  other.m_floats.clear();
+  other.m_ints.clear();
+  other.m_chars.clear();
+  other.m_words.clear();
+  other.m_offsets.assign(1, 0);
+  return *this;
+}
+
+std::string xAH::ColumnBatch::branchName(const std::string& variable) const
+{
+  std::string name = m_prefix.empty() ? variable : m_prefix + "_" + variable;
+  if(!m_suffix.empty()) name += "_" + m_suffix;
+  return name;
+}
+
+std::string xAH::ColumnBatch::type(const std::string& variable) const
+{
+  for(std::size_t i = 0; i < m_variables.size(); ++i){
+    if(m_variables[i] == variable) return m_types[i];
+  }
+  return "";
+}
+
+template <typename T>
+void xAH::ColumnBatch::connect(TTree* tree)
+{
+  for(auto& column : columns<T>()){
+    column->branch = tree->GetBranch(column->branchName.c_str());
+    if(!column->branch) throw std::runtime_error("xAH::ColumnBatch: no branch " + column->branchName + " in " + tree->GetName());
+    column->branch->SetStatus(1);
+    column->branch->SetAddress(&column->buffer);
+  }
+}
+
+template <typename T>
+void xAH::ColumnBatch::disconnect(bool reset)
+{
+  for(auto& column : columns<T>()){
+    if(reset && column->branch) column->branch->ResetAddress();
+    column->branch = nullptr;
+  }
+}
+
+void xAH::ColumnBatch::disconnect(bool reset)
+{
+  disconnect<float>(reset);
+  disconnect<int>(reset);
+  disconnect<char>(reset);
+  disconnect<unsigned long long>(reset);
+}
+
+template <typename T>
+Long64_t xAH::ColumnBatch::readEntry(Long64_t entry, Long64_t nObjects)
+{
+  for(auto& column : columns<T>()){
+    column->branch->GetEntry(entry);
+    const Long64_t n = column->buffer->size();
+    if(nObjects >= 0 && n != nObjects) throw std::runtime_error("xAH::ColumnBatch: " + column->branchName + " has " + std::to_string(n) + " objects instead of " + std::to_string(nObjects));
+    nObjects = n;
+    column->values.insert(column->values.end(), column->buffer->begin(), column->buffer->end());
+  }
+  return nObjects;
+}
+
+Long64_t xAH::ColumnBatch::read(TTree* tree, Long64_t first, Long64_t n)
+{
+  if(m_variables.empty()) throw std::runtime_error("xAH::ColumnBatch: no columns to read for " + m_prefix);
+
+  m_offsets.assign(1, 0);
+  for(auto& column : m_floats) column->values.clear();
+  for(auto& column : m_ints)   column->values.clear();
+  for(auto& column : m_chars)  column->values.clear();
+  for(auto& column : m_words)  column->values.clear();
+
+  // the branches of a chain change with its files
+  int treeNumber = -1;
+  bool connected = false;
+
+  // the branches point to the buffers of the columns only while reading, so that nothing is left pointing to them
+  try {
+    const Long64_t last = std::min(first + n, tree->GetEntries());
+    for(Long64_t entry = std::max(first, 0LL); entry < last; ++entry){
+      const Long64_t local = tree->LoadTree(entry);
+      if(local < 0) break;
+
+      if(!connected || tree->GetTreeNumber() != treeNumber){
+        // the branches of the previous tree of a chain are gone with it
+        disconnect(false);
+        TTree* current = tree->GetTree() ? tree->GetTree() : tree;
+        connect<float>(current);
+        connect<int>(current);
+        connect<char>(current);
+        connect<unsigned long long>(current);
+        treeNumber = tree->GetTreeNumber();
+        connected = true;
+      }
+
+      Long64_t nObjects = -1;
+      nObjects = readEntry<float>(local, nObjects);
+      nObjects = readEntry<int>(local, nObjects);
+      nObjects = readEntry<char>(local, nObjects);
+      nObjects = readEntry<unsigned long long>(local, nObjects);
+      m_offsets.push_back(m_offsets.back() + nObjects);
+    }
+  } catch(...) {
+    disconnect(true);
+    throw;
+  }
+  disconnect(true);
+
+  return entries();
+}
@@ -0,0 +1,93 @@
+#include <xAODAnaHelpers/CpuPinning.h>
+
+#include <algorithm>
+#include <cerrno>
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include <sstream>
+
+#ifdef __linux__
+#include <dirent.h>
+#include <sched.h>
+#include <unistd.h>
+#include <sys/syscall.h>
+#include <linux/mempolicy.h>
+#endif
+
+namespace {
+  // the CPUs of a "0-3,8-11" list
+  std::vector<int> parseCpuList(const std::string& list)
+  {
+    std::vector<int> cpus;
+    std::istringstream ranges(list);
+    std::string range;
+    while(std::getline(ranges, range, ',')){
+      if(range.empty()) continue;
+      const std::size_t dash = range.find('-');
+      const int first = std::atoi(range.substr(0, dash).c_str());
+      const int last  = dash == std::string::npos ? first : std::atoi(range.substr(dash + 1).c_str());
+      for(int cpu = first; cpu <= last; ++cpu) cpus.push_back(cpu);
+    }
+    return cpus;
+  }
+}
+
+std::vector<xAH::CpuPinning::Node> xAH::CpuPinning::numaNodes()
+{
+  std::vector<Node> nodes;
+#ifdef __linux__
+  cpu_set_t allowed;
+  CPU_ZERO(&allowed);
+  if(sched_getaffinity(0, sizeof(allowed), &allowed) != 0) return nodes;
+
+  DIR* nodeDir = opendir("/sys/devices/system/node");
+  if(!nodeDir) return nodes;
+  while(const dirent* entry = readdir(nodeDir)){
+    const std::string name = entry->d_name;
+    if(name.compare(0, 4, "node") != 0 || name.size() == 4 || name.find_first_not_of("0123456789", 4) != std::string::npos) continue;
+
+    std::ifstream cpuList("/sys/devices/system/node/" + name + "/cpulist");
+    std::string list;
+    std::getline(cpuList, list);
+    Node node{ std::atoi(name.c_str() + 4), {} };
+    for(int cpu : parseCpuList(list)){
+      if(cpu < CPU_SETSIZE && CPU_ISSET(cpu, &allowed)) node.cpus.push_back(cpu);
+    }
+    if(!node.cpus.empty()) nodes.push_back(node);
+  }
+  closedir(nodeDir);
+  std::sort(nodes.begin(), nodes.end(), [](const Node& a, const Node& b){ return a.id < b.id; });
+#endif
+  return nodes;
+}
+
+int xAH::CpuPinning::currentNode(const std::vector<Node>& nodes)
+{
+#ifdef __linux__
+  const int cpu = sched_getcpu();
+  for(std::size_t i = 0; i < nodes.size(); ++i){
+    if(std::find(nodes[i].cpus.begin(), nodes[i].cpus.end(), cpu) != nodes[i].cpus.end()) return i;
+  }
+#endif
+  return -1;
+}
+
+std::string xAH::CpuPinning::pinToNode(const Node& node)
+{
+#ifdef __linux__
+  cpu_set_t cpus;
+  CPU_ZERO(&cpus);
+  for(int cpu : node.cpus) CPU_SET(cpu, &cpus);
+  if(sched_setaffinity(0, sizeof(cpus), &cpus) != 0) return std::string("sched_setaffinity: ") + std::strerror(errno);
+
+  // a preference only: allocations still succeed from the other nodes once this one is full
+  if(node.id < 0 || node.id >= static_cast<int>(8*sizeof(unsigned long))) return "";
+  const unsigned long nodeMask = 1UL << node.id;
+  if(syscall(SYS_set_mempolicy, MPOL_PREFERRED, &nodeMask, 8*sizeof(nodeMask)) != 0) return std::string("set_mempolicy: ") + std::strerror(errno);
+  return "";
+#else
+  (void)node;
+  return "not supported on this platform";
+#endif
+}
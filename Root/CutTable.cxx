@@ -0,0 +1,46 @@
+#include <xAODAnaHelpers/CutTable.h>
+
+namespace {
+
+  struct CachedCut {
+    std::string key;
+    float min;
+    float max;
+  };
+
+  std::vector<CachedCut>& cachedCuts()
+  {
+    static std::vector<CachedCut> cuts;
+    return cuts;
+  }
+
+}
+
+const SG::AuxElement::Decorator<unsigned long long> xAH::CutCache::evaluatedBits("xAH_cutEvaluatedBits");
+const SG::AuxElement::Decorator<unsigned long long> xAH::CutCache::passedBits("xAH_cutPassedBits");
+
+int xAH::CutCache::bit(const std::string& key, float min, float max)
+{
+  std::vector<CachedCut>& cuts = cachedCuts();
+  for(unsigned int i = 0; i < cuts.size(); ++i){
+    if(cuts[i].key == key && cuts[i].min == min && cuts[i].max == max) return i;
+  }
+  if(cuts.size() >= 64) return -1;
+  cuts.push_back({key, min, max});
+  return cuts.size() - 1;
+}
+
+void xAH::CutCache::relations(int bit, unsigned long long& looser, unsigned long long& tighter)
+{
+  looser  = 0;
+  tighter = 0;
+  const std::vector<CachedCut>& cuts = cachedCuts();
+  if(bit < 0 || static_cast<unsigned int>(bit) >= cuts.size()) return;
+
+  const CachedCut& cut = cuts[bit];
+  for(unsigned int i = 0; i < cuts.size(); ++i){
+    if(cuts[i].key != cut.key) continue;
+    if(cuts[i].min <= cut.min && cut.max <= cuts[i].max) looser  |= 1ULL << i;
+    if(cut.min <= cuts[i].min && cuts[i].max <= cut.max) tighter |= 1ULL << i;
+  }
+}
@@ -0,0 +1,37 @@
+#include <xAODAnaHelpers/CutflowCounter.h>
+
+#include <algorithm>
+
+void xAH::CutflowCounter::flush()
+{
+  if(!m_hist || m_entries == 0.) return;
+
+  // read the statistics before touching the bins, ROOT may recompute them from the contents
+  double stats[4];
+  m_hist->GetStats(stats);
+  const double entries = m_hist->GetEntries();
+
+  // as TH1::Fill(x, w) does on its first weighted fill, from the contents of the unweighted fills made until then
+  if(m_weighted && !m_hist->GetSumw2N() && !m_hist->TestBit(TH1::kIsNotW)) m_hist->Sumw2();
+
+  const int lastBin = m_hist->GetNbinsX() + 1;
+  for(unsigned int bin = 0; bin < m_sumw.size(); ++bin){
+    if(m_sumw[bin] == 0. && m_sumw2[bin] == 0.) continue;
+    // bins beyond the axis go to the overflow, as Fill would do on an axis which cannot grow
+    const int target = std::min(static_cast<int>(bin), lastBin);
+    m_hist->AddBinContent(target, m_sumw[bin] - m_sumwC[bin]);
+    if(m_hist->GetSumw2N()) m_hist->GetSumw2()->fArray[target] += m_sumw2[bin] - m_sumw2C[bin];
+  }
+
+  for(unsigned int i = 0; i < 4; ++i) stats[i] += m_stats[i];
+  m_hist->PutStats(stats);
+  m_hist->SetEntries(entries + m_entries);
+
+  std::fill(m_sumw.begin(), m_sumw.end(), 0.);
+  std::fill(m_sumw2.begin(), m_sumw2.end(), 0.);
+  std::fill(m_sumwC.begin(), m_sumwC.end(), 0.);
+  std::fill(m_sumw2C.begin(), m_sumw2C.end(), 0.);
+  std::fill(m_stats, m_stats + 4, 0.);
+  m_entries = 0.;
+  m_weighted = false;
+}
@@ -7,6 +7,7 @@
  ************************************/
 
 // c++ include(s):
+#include <iomanip>
 #include <iostream>
 #include <typeinfo>
 #include <sstream>
@@ -22,7 +23,10 @@
 //#include "PATInterfaces/SystematicCode.h"
 
 // package include(s):
-//#include "xAODEventInfo/EventInfo.h"
+#include "xAODEventInfo/EventInfo.h"
+#include "AthContainers/AuxVectorBase.h"
+#include "AthContainers/AuxTypeRegistry.h"
+#include "AthContainersInterfaces/IConstAuxStore.h"
 #include "xAODAnaHelpers/DebugTool.h"
 #include "xAODAnaHelpers/HelperClasses.h"
 #include "xAODAnaHelpers/HelperFunctions.h"
@@ -86,6 +90,15 @@ EL::StatusCode DebugTool :: initialize ()
 
   ANA_MSG_INFO( "Number of events in file: " << m_event->getEntries() );
 
+  m_eventCounter = 0;
+  m_printEventNumberSet.clear();
+  std::stringstream ss(m_printEventNumbers);
+  std::string eventNumber;
+  while ( std::getline(ss, eventNumber, ',') ) {
+    if ( eventNumber.find_first_not_of(" ") == std::string::npos ) continue;
+    m_printEventNumberSet.insert( std::stoull(eventNumber) );
+  }
+
   return EL::StatusCode::SUCCESS;
 }
 
@@ -93,13 +106,17 @@ EL::StatusCode DebugTool :: initialize ()
 
 EL::StatusCode DebugTool :: execute ()
 {
+  auto event = beginEvent();
+  auto timer = timeExecute();
+  if ( eventRejected() ) return EL::StatusCode::SUCCESS;
   ANA_MSG_INFO( m_name);
 
   //
   // look what we have in TStore
   //
-  if ( m_printStore ) {
-    m_store->print();
+  if ( ( m_printStore || m_storeCensus ) && printThisEvent() ) {
+    if ( m_printStore )  m_store->print();
+    if ( m_storeCensus ) printStoreCensus();
   }
 
   return EL::StatusCode::SUCCESS;
@@ -107,8 +124,55 @@ EL::StatusCode DebugTool :: execute ()
 }
 
 
+bool DebugTool :: printThisEvent ()
+{
+  const unsigned long long ievent = m_eventCounter++;
+
+  if ( !m_printEventNumberSet.empty() ) {
+    const xAOD::EventInfo* eventInfo(nullptr);
+    if ( !HelperFunctions::retrieve(eventInfo, m_eventInfoContainerName, m_event, m_store, msg()).isSuccess() ) return false;
+    return m_printEventNumberSet.count( eventInfo->eventNumber() ) > 0;
+  }
+
+  return m_printEveryNEvents > 0 && ievent % m_printEveryNEvents == 0;
+}
+
+
+void DebugTool :: printStoreCensus () const
+{
+  std::vector<std::string> names;
+  m_store->getNames( "SG::AuxVectorBase", names );
+
+  const SG::AuxTypeRegistry& registry = SG::AuxTypeRegistry::instance();
+
+  std::size_t totalBytes(0);
+  ANA_MSG_INFO( "TStore census: " << names.size() << " containers" );
+  ANA_MSG_INFO( std::setw(48) << std::left << "container" << std::right << std::setw(10) << "elements" << std::setw(10) << "aux vars" << std::setw(14) << "approx. kB" );
+  for ( const std::string& name : names ) {
+    const SG::AuxVectorBase* container(nullptr);
+    if ( !m_store->retrieve( container, name ).isSuccess() || !container ) continue;
+
+    const std::size_t nElements = container->size_v();
+    std::size_t nAuxVars(0);
+    std::size_t bytes(0);
+    const SG::IConstAuxStore* auxStore = container->getConstStore();
+    if ( auxStore ) {
+      const SG::auxid_set_t& auxids = auxStore->getAuxIDs();
+      nAuxVars = auxids.size();
+      for ( SG::auxid_t auxid : auxids ) bytes += registry.getEltSize( auxid ) * auxStore->size();
+    }
+    totalBytes += bytes;
+
+    ANA_MSG_INFO( std::setw(48) << std::left << name << std::right << std::setw(10) << nElements << std::setw(10) << nAuxVars << std::setw(14) << std::fixed << std::setprecision(1) << bytes/1024. );
+  }
+  ANA_MSG_INFO( "TStore census: approx. " << std::fixed << std::setprecision(1) << totalBytes/1024. << " kB of aux data in total" );
+}
+
+
 EL::StatusCode DebugTool :: postExecute ()
 {
+  auto timer = timePostExecute();
+  if ( eventRejected() ) return EL::StatusCode::SUCCESS;
   ANA_MSG_DEBUG("Calling postExecute");
   return EL::StatusCode::SUCCESS;
 }
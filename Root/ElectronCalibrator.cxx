@@ -130,25 +130,33 @@ EL::StatusCode ElectronCalibrator :: initialize ()
   m_numEvent      = 0;
   m_numObject     = 0;
 
-  // initialize the CP::EgammaCalibrationAndSmearingTool
+  // initialize the CP::EgammaCalibrationAndSmearingTool, or reuse the one already configured by another egamma calibrator
   //
-  if ( asg::ToolStore::contains<CP::EgammaCalibrationAndSmearingTool>("EgammaCalibrationAndSmearingTool") ) {
-    m_EgammaCalibrationAndSmearingTool = asg::ToolStore::get<CP::EgammaCalibrationAndSmearingTool>("EgammaCalibrationAndSmearingTool");
+  const std::string CalibToolName = m_sharedCalibToolName.empty() ? "EgammaCalibrationAndSmearingTool" : m_sharedCalibToolName;
+  const bool reuseCalibTool = !m_sharedCalibToolName.empty() && asg::ToolStore::contains<CP::EgammaCalibrationAndSmearingTool>(CalibToolName);
+  if ( reuseCalibTool ) {
+    ANA_MSG_INFO( "Sharing the already configured " << CalibToolName );
+    m_EgammaCalibrationAndSmearingTool = asg::ToolStore::get<CP::EgammaCalibrationAndSmearingTool>(CalibToolName);
   } else {
-    m_EgammaCalibrationAndSmearingTool = new CP::EgammaCalibrationAndSmearingTool("EgammaCalibrationAndSmearingTool");
-  }
-  m_EgammaCalibrationAndSmearingTool->msg().setLevel( MSG::ERROR ); // DEBUG, VERBOSE, INFO
-  ANA_CHECK( m_EgammaCalibrationAndSmearingTool->setProperty("ESModel", m_esModel));
-  ANA_CHECK( m_EgammaCalibrationAndSmearingTool->setProperty("decorrelationModel", m_decorrelationModel));
+    if ( asg::ToolStore::contains<CP::EgammaCalibrationAndSmearingTool>(CalibToolName) ) {
+      m_EgammaCalibrationAndSmearingTool = asg::ToolStore::get<CP::EgammaCalibrationAndSmearingTool>(CalibToolName);
+    } else {
+      m_EgammaCalibrationAndSmearingTool = new CP::EgammaCalibrationAndSmearingTool(CalibToolName);
+      m_ownsCalibTool = true;
+    }
+    m_EgammaCalibrationAndSmearingTool->msg().setLevel( MSG::ERROR ); // DEBUG, VERBOSE, INFO
+    ANA_CHECK( m_EgammaCalibrationAndSmearingTool->setProperty("ESModel", m_esModel));
+    ANA_CHECK( m_EgammaCalibrationAndSmearingTool->setProperty("decorrelationModel", m_decorrelationModel));
 
-  //
-  // For AFII samples
-  //
-  if ( isFastSim() ){
-    ANA_MSG_INFO( "Setting simulation flavour to AFII");
-    ANA_CHECK( m_EgammaCalibrationAndSmearingTool->setProperty("useAFII", 1));
+    //
+    // For AFII samples
+    //
+    if ( isFastSim() ){
+      ANA_MSG_INFO( "Setting simulation flavour to AFII");
+      ANA_CHECK( m_EgammaCalibrationAndSmearingTool->setProperty("useAFII", 1));
+    }
+    ANA_CHECK( m_EgammaCalibrationAndSmearingTool->initialize());
   }
-  ANA_CHECK( m_EgammaCalibrationAndSmearingTool->initialize());
 
   // Get a list of recommended systematics for this tool
   //
@@ -207,6 +215,9 @@ EL::StatusCode ElectronCalibrator :: initialize ()
 
 EL::StatusCode ElectronCalibrator :: execute ()
 {
+  auto event = beginEvent();
+  auto timer = timeExecute();
+  if ( eventRejected() ) return EL::StatusCode::SUCCESS;
   // Here you do everything that needs to be done on every single
   // events, e.g. read input variables, apply cuts, and fill
   // histograms and trees.  This is where most of your actual analysis
@@ -228,6 +239,7 @@ EL::StatusCode ElectronCalibrator :: execute ()
   // must be a pointer to be recorded in TStore
   //
   auto vecOutContainerNames = std::make_unique< std::vector< std::string > >();
+  vecOutContainerNames->reserve( m_systList.size() );
 
   for ( const auto& syst_it : m_systList ) {
 
@@ -275,18 +287,12 @@ EL::StatusCode ElectronCalibrator :: execute ()
         ANA_MSG_DEBUG( "electron " << idx << ", raw pt = " << elSC_itr->pt() * 1e-3 << " GeV, does not have caloCluster()! " );
       }
 
-      // apply calibration (w/ syst) and leakage correction to calo based iso vars
+      // apply calibration (w/ syst)
       //
       if ( elSC_itr->caloCluster() && elSC_itr->trackParticle() ) {  // NB: derivations might remove CC and tracks for low pt electrons
         if ( m_EgammaCalibrationAndSmearingTool->applyCorrection( *elSC_itr ) != CP::CorrectionCode::Ok ) {
           ANA_MSG_WARNING( "Problem in CP::EgammaCalibrationAndSmearingTool::applyCorrection()");
         }
-
-        if ( m_applyIsolationCorrection ) {
-          if ( elSC_itr->pt() > 7e3 && m_IsolationCorrectionTool->CorrectLeakage( *elSC_itr ) != CP::CorrectionCode::Ok ) {
-            ANA_MSG_WARNING( "Problem in CP::IsolationCorrectionTool::CorrectLeakage()");
-          }
-        }
       }
 
       ANA_MSG_DEBUG( "Calibrated pt with systematic: " << syst_it.name() <<" , pt = " << elSC_itr->pt() * 1e-3 << " GeV");
@@ -295,6 +301,17 @@ EL::StatusCode ElectronCalibrator :: execute ()
 
     } // close calibration loop
 
+    // leakage correction to calo based iso vars, as a second pass over the calibrated electrons
+    //
+    if ( m_applyIsolationCorrection ) {
+      for ( auto elSC_itr : *(calibElectronsSC.first) ) {
+        if ( !(elSC_itr->caloCluster() && elSC_itr->trackParticle()) ) continue;
+        if ( elSC_itr->pt() > 7e3 && m_IsolationCorrectionTool->CorrectLeakage( *elSC_itr ) != CP::CorrectionCode::Ok ) {
+          ANA_MSG_WARNING( "Problem in CP::IsolationCorrectionTool::CorrectLeakage()");
+        }
+      }
+    }
+
     if ( !xAOD::setOriginalObjectLink(*inElectrons, *(calibElectronsSC.first)) ) {
       ANA_MSG_ERROR( "Failed to set original object links -- MET rebuilding cannot proceed.");
     }
@@ -305,7 +322,7 @@ EL::StatusCode ElectronCalibrator :: execute ()
 
     // Sort after copying to CDV.
     if ( m_sort ) {
-      std::sort( calibElectronsCDV->begin(), calibElectronsCDV->end(), HelperFunctions::sort_pt );
+      HelperFunctions::sortPt( calibElectronsCDV->begin(), calibElectronsCDV->end() );
     }
 
     // add SC container to TStore
@@ -330,6 +347,8 @@ EL::StatusCode ElectronCalibrator :: execute ()
 
 EL::StatusCode ElectronCalibrator :: postExecute ()
 {
+  auto timer = timePostExecute();
+  if ( eventRejected() ) return EL::StatusCode::SUCCESS;
   // Here you do everything that needs to be done after the main event
   // processing.  This is typically very rare, particularly in user
   // code.  It is mainly used in implementing the NTupleSvc.
@@ -355,7 +374,8 @@ EL::StatusCode ElectronCalibrator :: finalize ()
 
   ANA_MSG_INFO( "Deleting tool instances...");
 
-  if ( m_EgammaCalibrationAndSmearingTool ) { delete m_EgammaCalibrationAndSmearingTool; m_EgammaCalibrationAndSmearingTool = nullptr; }
+  if ( m_EgammaCalibrationAndSmearingTool && m_ownsCalibTool ) { delete m_EgammaCalibrationAndSmearingTool; }
+  m_EgammaCalibrationAndSmearingTool = nullptr;
   if ( m_IsolationCorrectionTool )          { delete m_IsolationCorrectionTool; m_IsolationCorrectionTool = nullptr; }
 
   return EL::StatusCode::SUCCESS;
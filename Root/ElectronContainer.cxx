@@ -1,4 +1,5 @@
 #include "xAODAnaHelpers/ElectronContainer.h"
+#include "xAODAnaHelpers/TrigMatchBits.h"
 
 #include <iostream>
 
@@ -7,7 +8,8 @@ using std::vector;
 using std::string;
 
 ElectronContainer::ElectronContainer(const std::string& name, const std::string& detailStr, float units, bool mc, bool storeSystSFs)
-  : ParticleContainer(name, detailStr, units, mc, true, storeSystSFs)
+  : ParticleContainer(name, detailStr, units, mc, true, storeSystSFs),
+    m_PID_LHLooseBL(nullptr)
 {
 
   if ( m_infoSwitch.m_kinematic ) {
@@ -19,6 +21,8 @@ ElectronContainer::ElectronContainer(const std::string& name, const std::string&
     m_isTrigMatched               = new std::vector<int>               ();
     m_isTrigMatchedToChain        = new std::vector<std::vector<int> > ();
     m_listTrigChains              = new std::vector<std::vector<std::string> > ();
+    m_trigMatchTestedBits    = new std::vector<unsigned long long>();
+    m_isTrigMatchedBits      = new std::vector<unsigned long long>();
   }
 
   if ( m_infoSwitch.m_isolation ) {
@@ -139,6 +143,8 @@ ElectronContainer::~ElectronContainer()
     delete m_isTrigMatched       ;
     delete m_isTrigMatchedToChain;
     delete m_listTrigChains      ;
+    delete m_trigMatchTestedBits;
+    delete m_isTrigMatchedBits;
   }
 
   if ( m_infoSwitch.m_isolation ) {
@@ -257,8 +263,15 @@ void ElectronContainer::setTree(TTree *tree)
 
   if ( m_infoSwitch.m_trigger ){
     connectBranch<int>         (tree,"isTrigMatched",        &m_isTrigMatched);
-    connectBranch<vector<int> >(tree,"isTrigMatchedToChain", &m_isTrigMatchedToChain);
-    connectBranch<vector<std::string> > (tree,"listTrigChains",       &m_listTrigChains);
+    if ( m_infoSwitch.m_triggerBits ) {
+      connectBranch<unsigned long long>(tree, "trigMatchTestedBits", &m_trigMatchTestedBits);
+      connectBranch<unsigned long long>(tree, "isTrigMatchedBits",   &m_isTrigMatchedBits);
+      m_trigChainNames = xAH::TrigMatchBits::readChains(tree);
+      m_trigChainOrder = xAH::TrigMatchBits::order(m_trigChainNames);
+    } else {
+      connectBranch<vector<int> >(tree,"isTrigMatchedToChain", &m_isTrigMatchedToChain);
+      connectBranch<vector<std::string> > (tree,"listTrigChains",       &m_listTrigChains);
+    }
   }
 
   if ( m_infoSwitch.m_isolation ) {
@@ -376,8 +389,19 @@ void ElectronContainer::updateParticle(uint idx, Electron& elec)
   // trigger
   if ( m_infoSwitch.m_trigger ) {
     elec.isTrigMatched         =     m_isTrigMatched         ->at(idx);
-    elec.isTrigMatchedToChain  =     m_isTrigMatchedToChain  ->at(idx);
-    elec.listTrigChains        =     m_listTrigChains        ->at(idx);
+    if ( m_infoSwitch.m_triggerBits ) {
+      elec.isTrigMatchedToChain.clear();
+      elec.listTrigChains.clear();
+      if ( m_trigMatchTestedBits->at(idx) ) {
+        xAH::TrigMatchBits::unpack( m_trigMatchTestedBits->at(idx), m_isTrigMatchedBits->at(idx), elec.isTrigMatchedToChain, elec.listTrigChains, m_trigChainNames, m_trigChainOrder );
+      } else {
+        elec.isTrigMatchedToChain.push_back( -1 );
+        elec.listTrigChains.push_back( "NONE" );
+      }
+    } else {
+      elec.isTrigMatchedToChain  =     m_isTrigMatchedToChain  ->at(idx);
+      elec.listTrigChains        =     m_listTrigChains        ->at(idx);
+    }
   }
 
   // isolation
@@ -496,14 +520,20 @@ void ElectronContainer::setBranches(TTree *tree)
 
   if ( m_infoSwitch.m_trigger ){
     setBranch<int>         (tree,"isTrigMatched",        m_isTrigMatched);
-    setBranch<vector<int> >(tree,"isTrigMatchedToChain", m_isTrigMatchedToChain);
-    setBranch<vector<std::string> > (tree,"listTrigChains",       m_listTrigChains);
+    if ( m_infoSwitch.m_triggerBits ) {
+      // the tested and the matched chains as bits, the chain of each bit is in the tree user info
+      setBranch<unsigned long long>(tree, "trigMatchTestedBits", m_trigMatchTestedBits);
+      setBranch<unsigned long long>(tree, "isTrigMatchedBits",   m_isTrigMatchedBits);
+    } else {
+      setBranch<vector<int> >(tree,"isTrigMatchedToChain", m_isTrigMatchedToChain);
+      setBranch<vector<std::string> > (tree,"listTrigChains",       m_listTrigChains);
+    }
   }
 
   if ( m_infoSwitch.m_isolation ) {
     for (auto& isol : m_infoSwitch.m_isolWPs) {
       if (!isol.empty() && isol != "NONE") {
-        setBranch<int>(tree, "isIsolated_" + isol, (*m_isIsolated)[isol]);
+        setPlannedBranch<char, int>(tree, "isIsolated_" + isol, "isIsolated_" + isol, (*m_isIsolated)[isol], -1);
       }
     }
   }
@@ -524,20 +554,26 @@ void ElectronContainer::setBranches(TTree *tree)
   if ( m_infoSwitch.m_PID ) {
     for (auto& PID : m_infoSwitch.m_PIDWPs) {
       if (!PID.empty()) {
-        setBranch<int>(tree, PID, (*m_PID)[PID]);
+        if (PID == "LHLooseBL") {
+          setBranch<int>(tree, PID, (*m_PID)[PID]);
+          m_PID_LHLooseBL = (*m_PID)[PID];
+        } else {
+          setPlannedBranch<char, int>(tree, PID, PID, (*m_PID)[PID], -1);
+        }
       }
     }
   }
 
   if ( m_infoSwitch.m_effSF && m_mc ) {
     for (auto& PID : m_infoSwitch.m_PIDSFWPs) {
-      tree->Branch( (m_name+"_PIDEff_SF_"  + PID).c_str() , (*m_PIDEff_SF)[ PID ] );
+      setPlannedSFBranch(tree, m_name+"_PIDEff_SF_"  + PID, "ElPIDEff_SF_syst_" + PID, (*m_PIDEff_SF)[ PID ] );
       for (auto& isol : m_infoSwitch.m_isolWPs) {
         if(!isol.empty())
-          tree->Branch( (m_name+"_IsoEff_SF_"  + PID + "_isol" + isol).c_str() , (*m_IsoEff_SF)[ PID+isol ] );
+          setPlannedSFBranch(tree, m_name+"_IsoEff_SF_"  + PID + "_isol" + isol, "ElIsoEff_SF_syst_" + PID + "_isol" + isol, (*m_IsoEff_SF)[ PID+isol ] );
         for (auto& trig : m_infoSwitch.m_trigWPs) {
-          tree->Branch( (m_name+"_TrigEff_SF_" + trig + "_" + PID + (!isol.empty() ? "_isol" + isol : "")).c_str() , (*m_TrigEff_SF)[ trig+PID+isol ] );
-          tree->Branch( (m_name+"_TrigMCEff_"  + trig + "_" + PID + (!isol.empty() ? "_isol" + isol : "")).c_str() , (*m_TrigMCEff) [ trig+PID+isol ] );
+          const std::string suffix = trig + "_" + PID + (!isol.empty() ? "_isol" + isol : "");
+          setPlannedSFBranch(tree, m_name+"_TrigEff_SF_" + suffix, "ElTrigEff_SF_syst_" + suffix, (*m_TrigEff_SF)[ trig+PID+isol ] );
+          setPlannedSFBranch(tree, m_name+"_TrigMCEff_"  + suffix, "ElTrigMCEff_syst_"  + suffix, (*m_TrigMCEff) [ trig+PID+isol ] );
         }
       }
     }
@@ -615,6 +651,8 @@ void ElectronContainer::clear()
     m_isTrigMatched               ->clear();
     m_isTrigMatchedToChain        ->clear();
     m_listTrigChains              ->clear();
+    m_trigMatchTestedBits->clear();
+    m_isTrigMatchedBits->clear();
   }
 
   if ( m_infoSwitch.m_isolation ) {
@@ -736,45 +774,42 @@ void ElectronContainer::FillElectron( const xAOD::IParticle* particle, const xAO
 
   if ( m_infoSwitch.m_trigger ) {
 
-    // retrieve map<string,char> w/ <chain,isMatched>
+    // retrieve the bits w/ the tested and the matched chains, see xAH::TrigMatchBits
     //
-    static SG::AuxElement::Accessor< std::map<std::string,char> > isTrigMatchedMapElAcc("isTrigMatchedMapEl");
-
-    std::vector<int> matches;
-    std::vector<string> trigChains;
-
-    if ( isTrigMatchedMapElAcc.isAvailable( *elec ) ) {
-      // loop over map and fill branches
-      //
-      for ( auto const &it : (isTrigMatchedMapElAcc( *elec )) ) {
-        matches.push_back( static_cast<int>(it.second) );
-        trigChains.push_back( static_cast<string>(it.first) );
-      }
+    static SG::AuxElement::ConstAccessor< unsigned long long > trigMatchTestedBitsElAcc("trigMatchTestedBitsEl");
+    static SG::AuxElement::ConstAccessor< unsigned long long > isTrigMatchedBitsElAcc("isTrigMatchedBitsEl");
+
+    if ( m_infoSwitch.m_triggerBits ) {
+      const unsigned long long testedBits  = trigMatchTestedBitsElAcc.isAvailable( *elec ) ? trigMatchTestedBitsElAcc( *elec ) : 0;
+      const unsigned long long matchedBits = testedBits ? isTrigMatchedBitsElAcc( *elec ) : 0;
+      m_trigMatchTestedBits->push_back( testedBits );
+      m_isTrigMatchedBits  ->push_back( matchedBits );
+      m_isTrigMatched      ->push_back( (testedBits & matchedBits) ? 1 : 0 );
     } else {
-      matches.push_back( -1 );
-      trigChains.push_back("NONE");
-    }
+      std::vector<int> matches;
+      std::vector<string> trigChains;
+
+      if ( trigMatchTestedBitsElAcc.isAvailable( *elec ) && trigMatchTestedBitsElAcc( *elec ) ) {
+        // unpack the bits and fill branches
+        //
+        xAH::TrigMatchBits::unpack( trigMatchTestedBitsElAcc( *elec ), isTrigMatchedBitsElAcc( *elec ), matches, trigChains );
+      } else {
+        matches.push_back( -1 );
+        trigChains.push_back("NONE");
+      }
 
-    m_isTrigMatchedToChain->push_back(matches);
-    m_listTrigChains->push_back(trigChains);
+      m_isTrigMatchedToChain->push_back(matches);
+      m_listTrigChains->push_back(trigChains);
 
-    // if at least one match among the chains is found, say this electron is trigger matched
-    if ( std::find(matches.begin(), matches.end(), 1) != matches.end() ) { m_isTrigMatched->push_back(1); }
-    else { m_isTrigMatched->push_back(0); }
+      // if at least one match among the chains is found, say this electron is trigger matched
+      if ( std::find(matches.begin(), matches.end(), 1) != matches.end() ) { m_isTrigMatched->push_back(1); }
+      else { m_isTrigMatched->push_back(0); }
+    }
 
   }
 
-  if ( m_infoSwitch.m_isolation ) {
-    static std::map< std::string, SG::AuxElement::Accessor<char> > accIsol;
-
-    for (auto& isol : m_infoSwitch.m_isolWPs) {
-      if (!isol.empty() && isol != "NONE") {
-        std::string isolWP = "isIsolated_" + isol;
-        accIsol.insert( std::pair<std::string, SG::AuxElement::Accessor<char> > ( isol , SG::AuxElement::Accessor<char>( isolWP ) ) );
-        safeFill<char, int, xAOD::Electron>( elec, accIsol.at( isol ), m_isIsolated->at( isol ), -1 );
-      }
-    }
-  }
+  // isolation and PID working point decisions, resolved in setBranches()
+  fillPlanned(*elec);
 
   if ( m_infoSwitch.m_isolationKinematics ) {
     m_etcone20    ->push_back( elec->isolation( xAOD::Iso::etcone20 )    /m_units );
@@ -789,24 +824,13 @@ void ElectronContainer::FillElectron( const xAOD::IParticle* particle, const xAO
     m_topoetcone40->push_back( elec->isolation( xAOD::Iso::topoetcone40 )/m_units );
   }
 
-  if ( m_infoSwitch.m_PID ) {
-    static std::map< std::string, SG::AuxElement::Accessor<char> > accPID;
-    static SG::AuxElement::Accessor<bool> accBLayer( "bLayerPass" );
-
-    for (auto& PID : m_infoSwitch.m_PIDWPs) {
-      if (!PID.empty()) {
-        if (PID == "LHLooseBL") {
-          accPID.insert( std::pair<std::string, SG::AuxElement::Accessor<char> > ( PID , SG::AuxElement::Accessor<char>( "LHLoose" ) ) );
-          if ( accPID.at( PID ).isAvailable( *elec ) && accBLayer.isAvailable( *elec ) ) {
-            m_PID->at( PID )->push_back( accBLayer( *elec ) == 1 && (accPID.at( PID ))( *elec ) == 1 );
-          } else {
-            m_PID->at( PID )->push_back( -1 );
-          }
-        } else {
-          accPID.insert( std::pair<std::string, SG::AuxElement::Accessor<char> > ( PID , SG::AuxElement::Accessor<char>( PID ) ) );
-          safeFill<char, int, xAOD::Electron>( elec, accPID.at( PID ), m_PID->at( PID ), -1 );
-        }
-      }
+  if ( m_PID_LHLooseBL ) {
+    static SG::AuxElement::ConstAccessor<char> accLHLoose( "LHLoose" );
+    static SG::AuxElement::ConstAccessor<bool> accBLayer( "bLayerPass" );
+    if ( accLHLoose.isAvailable( *elec ) && accBLayer.isAvailable( *elec ) ) {
+      m_PID_LHLooseBL->push_back( accBLayer( *elec ) == 1 && accLHLoose( *elec ) == 1 );
+    } else {
+      m_PID_LHLooseBL->push_back( -1 );
     }
   }
 
@@ -914,41 +938,10 @@ void ElectronContainer::FillElectron( const xAOD::IParticle* particle, const xAO
 
   if ( m_infoSwitch.m_effSF && m_mc ) {
 
-    std::vector<float> junkSF(1,-1.0);
-    std::vector<float> junkEff(1,-1.0);
-
-    static std::map< std::string, SG::AuxElement::Accessor< std::vector< float > > > accPIDSF;
-    static std::map< std::string, SG::AuxElement::Accessor< std::vector< float > > > accIsoSF;
-    static std::map< std::string, SG::AuxElement::Accessor< std::vector< float > > > accTrigSF;
-    static std::map< std::string, SG::AuxElement::Accessor< std::vector< float > > > accTrigEFF;
-
-    for (auto& PID : m_infoSwitch.m_PIDSFWPs) {
-      std::string PIDSF = "ElPIDEff_SF_syst_" + PID;
-      accPIDSF.insert( std::pair<std::string, SG::AuxElement::Accessor< std::vector< float > > > ( PID , SG::AuxElement::Accessor< std::vector< float > >( PIDSF ) ) );
-      safeSFVecFill<float, xAOD::Electron>( elec, accPIDSF.at( PID ), m_PIDEff_SF->at( PID ), junkSF );
-
-      for (auto& isol : m_infoSwitch.m_isolWPs) {
-
-        if(!isol.empty()) {
-          std::string IsoSF = "ElIsoEff_SF_syst_" + PID + "_isol" + isol;
-          accIsoSF.insert( std::pair<std::string, SG::AuxElement::Accessor< std::vector< float > > > ( PID+isol , SG::AuxElement::Accessor< std::vector< float > >( IsoSF ) ) );
-          safeSFVecFill<float, xAOD::Electron>( elec, accIsoSF.at( PID+isol ), m_IsoEff_SF->at( PID+isol ), junkSF );
-        }
-
-        for (auto& trig : m_infoSwitch.m_trigWPs) {
+    static const std::vector<float> junkSF(1,-1.0);
 
-          std::string TrigSF = "ElTrigEff_SF_syst_" + trig + "_" + PID + (!isol.empty() ? "_isol" + isol : "");
-          accTrigSF.insert( std::pair<std::string, SG::AuxElement::Accessor< std::vector< float > > > ( trig+PID+isol , SG::AuxElement::Accessor< std::vector< float > >( TrigSF ) ) );
-          safeSFVecFill<float, xAOD::Electron>( elec, accTrigSF.at( trig+PID+isol ), m_TrigEff_SF->at( trig+PID+isol ), junkSF );
-
-          std::string TrigEFF = "ElTrigMCEff_syst_" + trig + "_" + PID + (!isol.empty() ? "_isol" + isol : "");
-          accTrigEFF.insert( std::pair<std::string, SG::AuxElement::Accessor< std::vector< float > > > ( trig+PID+isol , SG::AuxElement::Accessor< std::vector< float > >( TrigEFF ) ) );
-          safeSFVecFill<float, xAOD::Electron>( elec, accTrigEFF.at( trig+PID+isol ), m_TrigMCEff->at( trig+PID+isol ), junkSF );
-
-        }
-
-      }
-    }
+    // PID, isolation and trigger working points, resolved in setBranches()
+    fillPlannedSFs(*elec);
 
     static SG::AuxElement::Accessor< std::vector< float > > accRecoSF("ElRecoEff_SF_syst_Reconstruction");
     safeSFVecFill<float, xAOD::Electron>( elec, accRecoSF, m_RecoEff_SF, junkSF );
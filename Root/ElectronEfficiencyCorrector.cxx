@@ -401,6 +401,9 @@ EL::StatusCode ElectronEfficiencyCorrector :: initialize ()
 
 EL::StatusCode ElectronEfficiencyCorrector :: execute ()
 {
+  auto event = beginEvent();
+  auto timer = timeExecute();
+  if ( eventRejected() ) return EL::StatusCode::SUCCESS;
   // Here you do everything that needs to be done on every single
   // events, e.g. read input variables, apply cuts, and fill
   // histograms and trees.  This is where most of your actual analysis
@@ -467,6 +470,8 @@ EL::StatusCode ElectronEfficiencyCorrector :: execute ()
 
 EL::StatusCode ElectronEfficiencyCorrector :: postExecute ()
 {
+  auto timer = timePostExecute();
+  if ( eventRejected() ) return EL::StatusCode::SUCCESS;
   // Here you do everything that needs to be done after the main event
   // processing.  This is typically very rare, particularly in user
   // code.  It is mainly used in implementing the NTupleSvc.
@@ -555,6 +560,18 @@ EL::StatusCode ElectronEfficiencyCorrector :: executeSF ( const xAOD::ElectronCo
     // Create the names of the SF weights to be recorded
     std::string sfName = "ElPIDEff_SF_syst_" + m_WorkingPointPID;
 
+    SG::AuxElement::Decorator< std::vector<float> > sfVecPID ( sfName  );
+
+    // every variation appends one SF per electron: create the vectors once, with room for all variations
+    const std::size_t nVariations = nominal ? m_systListPID.size() : 1;
+    for ( auto el_itr : *(inputElectrons) ) {
+      if ( !el_itr->caloCluster() ) continue;
+      if ( !sfVecPID.isAvailable( *el_itr ) ) {
+        sfVecPID ( *el_itr ) = std::vector<float>();
+      }
+      sfVecPID ( *el_itr ).reserve( sfVecPID ( *el_itr ).size() + nVariations );
+    }
+
     for ( const auto& syst_it : m_systListPID ) {
 
       if ( !syst_it.name().empty() && !nominal ) continue;
@@ -584,16 +601,6 @@ EL::StatusCode ElectronEfficiencyCorrector :: executeSF ( const xAOD::ElectronCo
          continue;
        }
 
-    	 //
-    	 // obtain PID efficiency SF as a float (to be stored away separately)
-    	 //
-    	 //  If SF decoration vector doesn't exist, create it (will be done only for the 1st systematic for *this* electron)
-    	 //
-    	 SG::AuxElement::Decorator< std::vector<float> > sfVecPID ( sfName  );
-    	 if ( !sfVecPID.isAvailable( *el_itr )  ) {
-    	   sfVecPID ( *el_itr ) = std::vector<float>();
-    	 }
-
     	 //
     	 // obtain efficiency SF's for PID
     	 //
@@ -648,6 +655,18 @@ EL::StatusCode ElectronEfficiencyCorrector :: executeSF ( const xAOD::ElectronCo
     // Create the names of the SF weights to be recorded
     std::string sfName = "ElIsoEff_SF_syst_" + m_WorkingPointPID + "_isol" + m_WorkingPointIso;
 
+    SG::AuxElement::Decorator< std::vector<float> > sfVecIso ( sfName  );
+
+    // every variation appends one SF per electron: create the vectors once, with room for all variations
+    const std::size_t nVariations = nominal ? m_systListIso.size() : 1;
+    for ( auto el_itr : *(inputElectrons) ) {
+      if ( !el_itr->caloCluster() ) continue;
+      if ( !sfVecIso.isAvailable( *el_itr ) ) {
+        sfVecIso ( *el_itr ) = std::vector<float>();
+      }
+      sfVecIso ( *el_itr ).reserve( sfVecIso ( *el_itr ).size() + nVariations );
+    }
+
     for ( const auto& syst_it : m_systListIso ) {
 
       if ( !syst_it.name().empty() && !nominal ) continue;
@@ -677,16 +696,6 @@ EL::StatusCode ElectronEfficiencyCorrector :: executeSF ( const xAOD::ElectronCo
          continue;
        }
 
-    	 //
-    	 // obtain Iso efficiency SF as a float (to be stored away separately)
-    	 //
-    	 //  If SF decoration vector doesn't exist, create it (will be done only for the 1st systematic for *this* electron)
-    	 //
-    	 SG::AuxElement::Decorator< std::vector<float> > sfVecIso ( sfName  );
-    	 if ( !sfVecIso.isAvailable( *el_itr )  ) {
-    	   sfVecIso ( *el_itr ) = std::vector<float>();
-    	 }
-
     	 //
     	 // obtain efficiency SF's for Iso
     	 //
@@ -741,6 +750,18 @@ EL::StatusCode ElectronEfficiencyCorrector :: executeSF ( const xAOD::ElectronCo
     // Create the names of the SF weights to be recorded
     std::string sfName = "ElRecoEff_SF_syst_" + m_WorkingPointReco;
 
+    SG::AuxElement::Decorator< std::vector<float> > sfVecReco ( sfName  );
+
+    // every variation appends one SF per electron: create the vectors once, with room for all variations
+    const std::size_t nVariations = nominal ? m_systListReco.size() : 1;
+    for ( auto el_itr : *(inputElectrons) ) {
+      if ( !el_itr->caloCluster() ) continue;
+      if ( !sfVecReco.isAvailable( *el_itr ) ) {
+        sfVecReco ( *el_itr ) = std::vector<float>();
+      }
+      sfVecReco ( *el_itr ).reserve( sfVecReco ( *el_itr ).size() + nVariations );
+    }
+
     for ( const auto& syst_it : m_systListReco ) {
 
       if ( !syst_it.name().empty() && !nominal ) continue;
@@ -769,16 +790,6 @@ EL::StatusCode ElectronEfficiencyCorrector :: executeSF ( const xAOD::ElectronCo
           continue;
         }
 
-        //
-        // obtain Reco efficiency SF as a float (to be stored away separately)
-        //
-        //  If SF decoration vector doesn't exist, create it (will be done only for the 1st systematic for *this* electron)
-        //
-        SG::AuxElement::Decorator< std::vector<float> > sfVecReco ( sfName  );
-        if ( !sfVecReco.isAvailable( *el_itr )  ) {
-          sfVecReco ( *el_itr ) = std::vector<float>();
-        }
-
         //
         // obtain efficiency SF's for Reco
         //
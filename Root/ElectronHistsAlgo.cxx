@@ -28,5 +28,8 @@ EL::StatusCode ElectronHistsAlgo::AddHists( std::string name ) {
 }
 
 EL::StatusCode ElectronHistsAlgo :: execute () {
+  auto event = beginEvent();
+  auto timer = timeExecute();
+  if ( eventRejected() ) return EL::StatusCode::SUCCESS;
   return IParticleHistsAlgo::execute<ElectronHists, xAOD::ElectronContainer>();
 }
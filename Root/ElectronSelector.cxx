@@ -1,6 +1,7 @@
 // c++ include(s):
 #include <iostream>
 #include <typeinfo>
+#include <algorithm>
 #include <sstream>
 #include <tuple>
 
@@ -21,6 +22,8 @@
 #include "xAODAnaHelpers/ElectronSelector.h"
 #include "xAODAnaHelpers/HelperClasses.h"
 #include "xAODAnaHelpers/HelperFunctions.h"
+#include "xAODAnaHelpers/SelectionFlags.h"
+#include "xAODAnaHelpers/TrigMatchBits.h"
 #include "ElectronPhotonSelectorTools/AsgElectronLikelihoodTool.h"
 #include "ElectronPhotonSelectorTools/AsgElectronIsEMSelector.h"
 
@@ -147,6 +150,8 @@ EL::StatusCode ElectronSelector :: initialize ()
     // retrieve the object cutflow
     //
     m_el_cutflowHist_1 = (TH1D*)file->Get("cutflow_electrons_1");
+    m_el_cutflowCounter_1.setHist( m_el_cutflowHist_1 );
+    addCheckpoint( &m_el_cutflowCounter_1 );
 
     m_el_cutflow_all             = m_el_cutflowHist_1->GetXaxis()->FindBin("all");
     m_el_cutflow_author_cut      = m_el_cutflowHist_1->GetXaxis()->FindBin("author_cut");
@@ -163,6 +168,8 @@ EL::StatusCode ElectronSelector :: initialize ()
 
     if ( m_isUsedBefore ) {
       m_el_cutflowHist_2 = (TH1D*)file->Get("cutflow_electrons_2");
+      m_el_cutflowCounter_2.setHist( m_el_cutflowHist_2 );
+      addCheckpoint( &m_el_cutflowCounter_2 );
 
       m_el_cutflow_all       = m_el_cutflowHist_2->GetXaxis()->FindBin("all");
       m_el_cutflow_author_cut    = m_el_cutflowHist_2->GetXaxis()->FindBin("author_cut");
@@ -217,6 +224,7 @@ EL::StatusCode ElectronSelector :: initialize ()
   while ( std::getline(ss, token, ',') ) {
     m_IsoKeys.push_back(token);
   }
+  m_isoDecisions.setWPs(m_IsoKeys, m_MinIsoWPCut);
 
   if ( m_inContainerName.empty() ) {
     ANA_MSG_ERROR( "InputContainer is empty!");
@@ -224,6 +232,13 @@ EL::StatusCode ElectronSelector :: initialize ()
   }
 
 
+  // the bit of the selection decision in the flag word of the objects
+  m_passSelBit = xAH::SelectionFlags::bit( "passSel" );
+  if ( m_passSelBit < 0 ) {
+    ANA_MSG_ERROR( "No bit left in the selection flags for passSel" );
+    return EL::StatusCode::FAILURE;
+  }
+
   m_numEvent      = 0;
   m_numObject     = 0;
   m_numEventPass  = 0;
@@ -302,38 +317,44 @@ EL::StatusCode ElectronSelector :: initialize ()
 
   // Do this only for the first WP in the list
   ANA_MSG_DEBUG( "Adding isolation WP " << m_IsoKeys.at(0) << " to IsolationSelectionTool" );
-  ANA_CHECK( m_isolationSelectionTool_handle.setProperty("ElectronWP", (m_IsoKeys.at(0)).c_str()));
-  ANA_CHECK( m_isolationSelectionTool_handle.setProperty("OutputLevel", msg().level()));
-  ANA_CHECK( m_isolationSelectionTool_handle.retrieve());
-  ANA_MSG_DEBUG("Retrieved tool: " << m_isolationSelectionTool_handle);
-  m_isolationSelectionTool = dynamic_cast<CP::IsolationSelectionTool*>(m_isolationSelectionTool_handle.get() ); // see header file for why
-
-  // Add the remaining input WPs to the tool
-  // (start from 2nd element)
-  //
-  for ( auto WP_itr = std::next(m_IsoKeys.begin()); WP_itr != m_IsoKeys.end(); ++WP_itr ) {
+  // the extra WPs are added to the tool itself below, so they are part of its configuration
+  ANA_CHECK( retrieveSharedTool(m_isolationSelectionTool_handle, toolConfig(m_IsoKeys, m_TrackBasedIsoType, m_TrackIsoEff, m_CaloBasedIsoType, m_CaloIsoEff), [&]() -> StatusCode {
+    ANA_CHECK( m_isolationSelectionTool_handle.setProperty("ElectronWP", (m_IsoKeys.at(0)).c_str()));
+    ANA_CHECK( m_isolationSelectionTool_handle.setProperty("OutputLevel", msg().level()));
+    ANA_CHECK( m_isolationSelectionTool_handle.retrieve());
+    // the member is set below, for both a new and a reused tool
+    CP::IsolationSelectionTool* isolationSelectionTool = dynamic_cast<CP::IsolationSelectionTool*>(m_isolationSelectionTool_handle.get() ); // see header file for why
+
+    // Add the remaining input WPs to the tool
+    // (start from 2nd element)
+    //
+    for ( auto WP_itr = std::next(m_IsoKeys.begin()); WP_itr != m_IsoKeys.end(); ++WP_itr ) {
 
-     ANA_MSG_DEBUG( "Adding extra isolation WP " << *WP_itr << " to IsolationSelectionTool" );
+       ANA_MSG_DEBUG( "Adding extra isolation WP " << *WP_itr << " to IsolationSelectionTool" );
 
-     if ( (*WP_itr).find("UserDefined") != std::string::npos ) {
+       if ( (*WP_itr).find("UserDefined") != std::string::npos ) {
 
-       HelperClasses::EnumParser<xAOD::Iso::IsolationType> isoParser;
+         HelperClasses::EnumParser<xAOD::Iso::IsolationType> isoParser;
 
-       std::vector< std::pair<xAOD::Iso::IsolationType, std::string> > myCuts;
-       myCuts.push_back(std::make_pair<xAOD::Iso::IsolationType, std::string>(isoParser.parseEnum(m_TrackBasedIsoType), m_TrackIsoEff.c_str() ));
-       myCuts.push_back(std::make_pair<xAOD::Iso::IsolationType, std::string>(isoParser.parseEnum(m_CaloBasedIsoType) , m_CaloIsoEff.c_str()  ));
+         std::vector< std::pair<xAOD::Iso::IsolationType, std::string> > myCuts;
+         myCuts.push_back(std::make_pair<xAOD::Iso::IsolationType, std::string>(isoParser.parseEnum(m_TrackBasedIsoType), m_TrackIsoEff.c_str() ));
+         myCuts.push_back(std::make_pair<xAOD::Iso::IsolationType, std::string>(isoParser.parseEnum(m_CaloBasedIsoType) , m_CaloIsoEff.c_str()  ));
 
-       CP::IsolationSelectionTool::IsoWPType iso_type(CP::IsolationSelectionTool::Efficiency);
-       if ( (*WP_itr).find("Cut") != std::string::npos ) { iso_type = CP::IsolationSelectionTool::Cut; }
+         CP::IsolationSelectionTool::IsoWPType iso_type(CP::IsolationSelectionTool::Efficiency);
+         if ( (*WP_itr).find("Cut") != std::string::npos ) { iso_type = CP::IsolationSelectionTool::Cut; }
 
-       ANA_CHECK(  m_isolationSelectionTool->addUserDefinedWP((*WP_itr).c_str(), xAOD::Type::Electron, myCuts, "", iso_type));
+         ANA_CHECK(  isolationSelectionTool->addUserDefinedWP((*WP_itr).c_str(), xAOD::Type::Electron, myCuts, "", iso_type));
 
-     } else {
+       } else {
 
-        ANA_CHECK( m_isolationSelectionTool->addElectronWP( (*WP_itr).c_str() ));
+          ANA_CHECK( isolationSelectionTool->addElectronWP( (*WP_itr).c_str() ));
 
-     }
-  }
+       }
+    }
+    return StatusCode::SUCCESS;
+  }));
+  ANA_MSG_DEBUG("Retrieved tool: " << m_isolationSelectionTool_handle);
+  m_isolationSelectionTool = dynamic_cast<CP::IsolationSelectionTool*>(m_isolationSelectionTool_handle.get() ); // see header file for why
 
   // ***************************************
   //
@@ -390,6 +411,9 @@ EL::StatusCode ElectronSelector :: initialize ()
 
 EL::StatusCode ElectronSelector :: execute ()
 {
+  auto event = beginEvent();
+  auto timer = timeExecute();
+  if ( eventRejected() ) return EL::StatusCode::SUCCESS;
   // Here you do everything that needs to be done on every single
   // events, e.g. read input variables, apply cuts, and fill
   // histograms and trees.  This is where most of your actual analysis
@@ -432,6 +456,25 @@ EL::StatusCode ElectronSelector :: execute ()
       m_diElTrigChainsList.push_back(diel_trig);
     }
 
+    // fix the bit of each chain in the trigger matching decorations
+    //
+    for ( auto const &chain : m_singleElTrigChainsList ) {
+      const int bit = xAH::TrigMatchBits::bit( chain );
+      if ( bit < 0 ) {
+        ANA_MSG_ERROR( "At most " << xAH::TrigMatchBits::maxChains << " trigger chains can be matched in a job, cannot add " << chain );
+        return EL::StatusCode::FAILURE;
+      }
+      m_singleElTrigChainsBits.push_back( bit );
+    }
+    for ( auto const &chain : m_diElTrigChainsList ) {
+      const int bit = xAH::TrigMatchBits::bit( chain );
+      if ( bit < 0 ) {
+        ANA_MSG_ERROR( "At most " << xAH::TrigMatchBits::maxChains << " trigger chains can be matched in a job, cannot add " << chain );
+        return EL::StatusCode::FAILURE;
+      }
+      m_diElTrigChainsBits.push_back( bit );
+    }
+
     ANA_MSG_INFO( "Input single electron trigger chains that will be considered for matching:\n");
     for ( auto const &chain : m_singleElTrigChainsList ) { ANA_MSG_INFO( "\t " << chain); }
     ANA_MSG_INFO( "\n");
@@ -459,7 +502,7 @@ EL::StatusCode ElectronSelector :: execute ()
 
     // create output container (if requested)
     ConstDataVector<xAOD::ElectronContainer>* selectedElectrons(nullptr);
-    if ( m_createSelectedContainer ) { selectedElectrons = new ConstDataVector<xAOD::ElectronContainer>(SG::VIEW_ELEMENTS); }
+    if ( m_createSelectedContainer ) { selectedElectrons = new ConstDataVector<xAOD::ElectronContainer>(SG::VIEW_ELEMENTS); selectedElectrons->reserve( inElectrons->size() ); }
 
     // find the selected electrons, and return if event passes object selection
     //
@@ -486,6 +529,7 @@ EL::StatusCode ElectronSelector :: execute ()
     // must be a pointer to be recorded in TStore
     //
     auto vecOutContainerNames = std::make_unique< std::vector< std::string > >();
+    vecOutContainerNames->reserve( systNames->size() );
     ANA_MSG_DEBUG( " input list of syst size: " << static_cast<int>(systNames->size()) );
 
     // loop over systematic sets
@@ -500,7 +544,7 @@ EL::StatusCode ElectronSelector :: execute ()
       // create output container (if requested) - one for each systematic
       //
       ConstDataVector<xAOD::ElectronContainer>* selectedElectrons(nullptr);
-      if ( m_createSelectedContainer ) { selectedElectrons = new ConstDataVector<xAOD::ElectronContainer>(SG::VIEW_ELEMENTS); }
+      if ( m_createSelectedContainer ) { selectedElectrons = new ConstDataVector<xAOD::ElectronContainer>(SG::VIEW_ELEMENTS); selectedElectrons->reserve( inElectrons->size() ); }
 
       // find the selected electrons, and return if event passes object selection
       //
@@ -544,7 +588,7 @@ EL::StatusCode ElectronSelector :: execute ()
   if(msgLvl(MSG::VERBOSE)) m_store->print();
 
   if( !eventPass ) {
-    wk()->skipEvent();
+    rejectEvent();
     return EL::StatusCode::SUCCESS;
   }
 
@@ -566,13 +610,17 @@ bool ElectronSelector :: executeSelection ( const xAOD::ElectronContainer* inEle
   bool passCrackVetoCleaning = true;
   const static SG::AuxElement::ConstAccessor<char> acc_CrackVetoCleaning("DFCommonCrackVetoCleaning");
 
+  const int nToEvaluate = m_nToProcess > 0 ? std::min( m_nToProcess, static_cast<int>(inElectrons->size()) ) : static_cast<int>(inElectrons->size());
+  bool countRejected(false);
+
   for ( auto el_itr : *inElectrons ) { // duplicated of basic loop
 
     // if only looking at a subset of electrons make sure all are decorated
     //
-    if ( m_nToProcess > 0 && nObj >= m_nToProcess ) {
+    if ( (m_nToProcess > 0 && nObj >= m_nToProcess) || countRejected ) {
       if ( m_decorateSelectedObjects ) {
         passSelDecor( *el_itr ) = -1;
+        xAH::SelectionFlags::setUndecided( *el_itr, m_passSelBit );
       } else {
         break;
       }
@@ -583,6 +631,7 @@ bool ElectronSelector :: executeSelection ( const xAOD::ElectronContainer* inEle
     bool passSel = this->passCuts( el_itr, pvx );
     if ( m_decorateSelectedObjects ) {
       passSelDecor( *el_itr ) = passSel;
+      xAH::SelectionFlags::set( *el_itr, m_passSelBit, passSel );
     }
 
     if ( passSel ) {
@@ -597,6 +646,11 @@ bool ElectronSelector :: executeSelection ( const xAOD::ElectronContainer* inEle
         selectedElectrons->push_back( el_itr );
       }
     }
+
+    // once the number of selected electrons rejects the event there is no need to look further
+    if ( m_stopWhenRejected && HelperFunctions::countRejects( nPass, nToEvaluate - nObj, m_pass_min, m_pass_max ) ) {
+      countRejected = true;
+    }
   }
 
   // Fix to EGamma Crack-Electron topocluster association bug for MET (PFlow)
@@ -641,31 +695,34 @@ bool ElectronSelector :: executeSelection ( const xAOD::ElectronContainer* inEle
 
     unsigned int nSelectedElectrons = selectedElectrons->size();
 
-    static SG::AuxElement::Decorator< std::map<std::string,char> > isTrigMatchedMapElDecor( "isTrigMatchedMapEl" );
+    static SG::AuxElement::Decorator< unsigned long long > trigMatchTestedBitsElDecor( "trigMatchTestedBitsEl" );
+    static SG::AuxElement::Decorator< unsigned long long > isTrigMatchedBitsElDecor( "isTrigMatchedBitsEl" );
+
+    //  Each electron is decorated w/ the bits of the tested chains and the bits of the matched chains,
+    //  the bit of each chain is fixed by xAH::TrigMatchBits when the chain lists are parsed
+    //
+    for ( auto const electron : *selectedElectrons ) {
+      trigMatchTestedBitsElDecor( *electron ) = 0;
+      isTrigMatchedBitsElDecor( *electron )   = 0;
+    }
 
     if ( nSelectedElectrons > 0 ) {
 
       ANA_MSG_DEBUG( "Doing single electron trigger matching...");
 
-      for ( auto const &chain : m_singleElTrigChainsList ) {
+      for ( unsigned int ichain = 0; ichain < m_singleElTrigChainsList.size(); ++ichain ) {
+
+        auto const &chain = m_singleElTrigChainsList.at(ichain);
 
         ANA_MSG_DEBUG( "\t checking trigger chain " << chain);
 
         for ( auto const electron : *selectedElectrons ) {
 
-          //  For each electron, decorate w/ a map<string,char> with the 'isMatched' info associated
-          //  to each trigger chain in the input list.
-          //  If decoration map doesn't exist for this electron yet, create it (will be done only for the 1st iteration on the chain names)
-          //
-          if ( !isTrigMatchedMapElDecor.isAvailable( *electron ) ) {
-            isTrigMatchedMapElDecor( *electron ) = std::map<std::string,char>();
-          }
-
           char matched = ( m_trigElectronMatchTool_handle->match( *electron, chain, m_minDeltaR ) );
 
           ANA_MSG_DEBUG( "\t\t is electron trigger matched? " << matched);
 
-          ( isTrigMatchedMapElDecor( *electron ) )[chain] = matched;
+          xAH::TrigMatchBits::set( trigMatchTestedBitsElDecor( *electron ), isTrigMatchedBitsElDecor( *electron ), m_singleElTrigChainsBits.at(ichain), matched );
         }
       }
     }// if nSelectedElectrons > 0
@@ -693,7 +750,9 @@ bool ElectronSelector :: executeSelection ( const xAOD::ElectronContainer* inEle
       typedef std::multimap< std::string, dielectron_trigmatch_pair >    dielectron_trigmatch_pair_map;
       static SG::AuxElement::Decorator< dielectron_trigmatch_pair_map >  diElectronTrigMatchPairMapDecor( "diElectronTrigMatchPairMap" );
 
-      for ( auto const &chain : m_diElTrigChainsList ) {
+      for ( unsigned int ichain = 0; ichain < m_diElTrigChainsList.size(); ++ichain ) {
+
+        auto const &chain = m_diElTrigChainsList.at(ichain);
 
         ANA_MSG_DEBUG( "\t checking trigger chain " << chain);
 
@@ -719,8 +778,8 @@ bool ElectronSelector :: executeSelection ( const xAOD::ElectronContainer* inEle
             ANA_MSG_DEBUG( "\t\t is the electron pair ("<<iel<<","<<jel<<") trigger matched? " << matched);
 
             // set basic matching information
-            ( isTrigMatchedMapElDecor( *myElectrons[0] ) )[chain] = matched;
-            ( isTrigMatchedMapElDecor( *myElectrons[1] ) )[chain] = matched;
+            xAH::TrigMatchBits::set( trigMatchTestedBitsElDecor( *myElectrons[0] ), isTrigMatchedBitsElDecor( *myElectrons[0] ), m_diElTrigChainsBits.at(ichain), matched );
+            xAH::TrigMatchBits::set( trigMatchTestedBitsElDecor( *myElectrons[1] ), isTrigMatchedBitsElDecor( *myElectrons[1] ), m_diElTrigChainsBits.at(ichain), matched );
 
             // set pair decision information
             std::pair <unsigned int, unsigned int>  chain_idxs = std::make_pair(iel,jel);
@@ -739,6 +798,8 @@ bool ElectronSelector :: executeSelection ( const xAOD::ElectronContainer* inEle
 
 EL::StatusCode ElectronSelector :: postExecute ()
 {
+  auto timer = timePostExecute();
+  if ( eventRejected() ) return EL::StatusCode::SUCCESS;
   // Here you do everything that needs to be done after the main event
   // processing.  This is typically very rare, particularly in user
   // code.  It is mainly used in implementing the NTupleSvc.
@@ -770,6 +831,9 @@ EL::StatusCode ElectronSelector :: finalize ()
     ANA_MSG_INFO( "Filling cutflow");
     m_cutflowHist ->SetBinContent( m_cutflow_bin, m_numEventPass        );
     m_cutflowHistW->SetBinContent( m_cutflow_bin, m_weightNumEventPass  );
+
+    m_el_cutflowCounter_1.flush();
+    m_el_cutflowCounter_2.flush();
   }
 
   return EL::StatusCode::SUCCESS;
@@ -806,8 +870,8 @@ int ElectronSelector :: passCuts( const xAOD::Electron* electron, const xAOD::Ve
   float eta   = ( electron->caloCluster() ) ? electron->caloCluster()->etaBE(2) : -999.0;
 
   // fill cutflow bin 'all' before any cut
-  if( !m_isUsedBefore && m_useCutFlow) m_el_cutflowHist_1->Fill( m_el_cutflow_all, 1 );
-  if ( m_isUsedBefore && m_useCutFlow ) { m_el_cutflowHist_2->Fill( m_el_cutflow_all, 1 ); }
+  if( !m_isUsedBefore && m_useCutFlow) m_el_cutflowCounter_1.fill( m_el_cutflow_all );
+  if ( m_isUsedBefore && m_useCutFlow ) { m_el_cutflowCounter_2.fill( m_el_cutflow_all ); }
 
   // *********************************************************************************************************************************************************************
   //
@@ -819,8 +883,8 @@ int ElectronSelector :: passCuts( const xAOD::Electron* electron, const xAOD::Ve
       return 0;
     }
   }
-  if (!m_isUsedBefore && m_useCutFlow) m_el_cutflowHist_1->Fill( m_el_cutflow_author_cut, 1 );
-  if ( m_isUsedBefore && m_useCutFlow ) { m_el_cutflowHist_2->Fill( m_el_cutflow_author_cut, 1 ); }
+  if (!m_isUsedBefore && m_useCutFlow) m_el_cutflowCounter_1.fill( m_el_cutflow_author_cut );
+  if ( m_isUsedBefore && m_useCutFlow ) { m_el_cutflowCounter_2.fill( m_el_cutflow_author_cut ); }
 
   // *********************************************************************************************************************************************************************
   //
@@ -832,8 +896,8 @@ int ElectronSelector :: passCuts( const xAOD::Electron* electron, const xAOD::Ve
       return 0;
     }
   }
-  if (!m_isUsedBefore && m_useCutFlow) m_el_cutflowHist_1->Fill( m_el_cutflow_OQ_cut, 1 );
-  if ( m_isUsedBefore && m_useCutFlow ) { m_el_cutflowHist_2->Fill( m_el_cutflow_OQ_cut, 1 ); }
+  if (!m_isUsedBefore && m_useCutFlow) m_el_cutflowCounter_1.fill( m_el_cutflow_OQ_cut );
+  if ( m_isUsedBefore && m_useCutFlow ) { m_el_cutflowCounter_2.fill( m_el_cutflow_OQ_cut ); }
 
   // *********************************************************************************************************************************************************************
   //
@@ -845,8 +909,8 @@ int ElectronSelector :: passCuts( const xAOD::Electron* electron, const xAOD::Ve
       return 0;
     }
   }
-  if (!m_isUsedBefore && m_useCutFlow) m_el_cutflowHist_1->Fill( m_el_cutflow_ptmax_cut, 1 );
-  if ( m_isUsedBefore && m_useCutFlow ) { m_el_cutflowHist_2->Fill( m_el_cutflow_ptmax_cut, 1 ); }
+  if (!m_isUsedBefore && m_useCutFlow) m_el_cutflowCounter_1.fill( m_el_cutflow_ptmax_cut );
+  if ( m_isUsedBefore && m_useCutFlow ) { m_el_cutflowCounter_2.fill( m_el_cutflow_ptmax_cut ); }
 
   // *********************************************************************************************************************************************************************
   //
@@ -858,8 +922,8 @@ int ElectronSelector :: passCuts( const xAOD::Electron* electron, const xAOD::Ve
       return 0;
     }
   }
-  if (!m_isUsedBefore && m_useCutFlow) m_el_cutflowHist_1->Fill( m_el_cutflow_ptmin_cut, 1 );
-  if ( m_isUsedBefore && m_useCutFlow ) { m_el_cutflowHist_2->Fill( m_el_cutflow_ptmin_cut, 1 ); }
+  if (!m_isUsedBefore && m_useCutFlow) m_el_cutflowCounter_1.fill( m_el_cutflow_ptmin_cut );
+  if ( m_isUsedBefore && m_useCutFlow ) { m_el_cutflowCounter_2.fill( m_el_cutflow_ptmin_cut ); }
 
   // *********************************************************************************************************************************************************************
   //
@@ -882,8 +946,8 @@ int ElectronSelector :: passCuts( const xAOD::Electron* electron, const xAOD::Ve
       return 0;
     }
   }
-  if (!m_isUsedBefore && m_useCutFlow) m_el_cutflowHist_1->Fill( m_el_cutflow_eta_cut, 1 );
-  if ( m_isUsedBefore && m_useCutFlow ) { m_el_cutflowHist_2->Fill( m_el_cutflow_eta_cut, 1 ); }
+  if (!m_isUsedBefore && m_useCutFlow) m_el_cutflowCounter_1.fill( m_el_cutflow_eta_cut );
+  if ( m_isUsedBefore && m_useCutFlow ) { m_el_cutflowCounter_2.fill( m_el_cutflow_eta_cut ); }
 
 
   // *********************************************************************************************************************************************************************
@@ -916,8 +980,8 @@ int ElectronSelector :: passCuts( const xAOD::Electron* electron, const xAOD::Ve
       return 0;
     }
   }
-  if ( !m_isUsedBefore && m_useCutFlow ) m_el_cutflowHist_1->Fill( m_el_cutflow_z0sintheta_cut, 1 );
-  if ( m_isUsedBefore && m_useCutFlow ) { m_el_cutflowHist_2->Fill( m_el_cutflow_z0sintheta_cut, 1 ); }
+  if ( !m_isUsedBefore && m_useCutFlow ) m_el_cutflowCounter_1.fill( m_el_cutflow_z0sintheta_cut );
+  if ( m_isUsedBefore && m_useCutFlow ) { m_el_cutflowCounter_2.fill( m_el_cutflow_z0sintheta_cut ); }
 
   // decorate electron w/ z0*sin(theta) info
   static SG::AuxElement::Decorator< float > z0sinthetaDecor("z0sintheta");
@@ -931,8 +995,8 @@ int ElectronSelector :: passCuts( const xAOD::Electron* electron, const xAOD::Ve
       return 0;
     }
   }
-  if ( !m_isUsedBefore && m_useCutFlow ) m_el_cutflowHist_1->Fill( m_el_cutflow_d0_cut, 1 );
-  if ( m_isUsedBefore && m_useCutFlow ) { m_el_cutflowHist_2->Fill( m_el_cutflow_d0_cut, 1 ); }
+  if ( !m_isUsedBefore && m_useCutFlow ) m_el_cutflowCounter_1.fill( m_el_cutflow_d0_cut );
+  if ( m_isUsedBefore && m_useCutFlow ) { m_el_cutflowCounter_2.fill( m_el_cutflow_d0_cut ); }
 
   // d0sig cut
   //
@@ -942,8 +1006,8 @@ int ElectronSelector :: passCuts( const xAOD::Electron* electron, const xAOD::Ve
       return 0;
     }
   }
-  if ( !m_isUsedBefore && m_useCutFlow) m_el_cutflowHist_1->Fill( m_el_cutflow_d0sig_cut, 1 );
-  if ( m_isUsedBefore && m_useCutFlow ) { m_el_cutflowHist_2->Fill( m_el_cutflow_d0sig_cut, 1 ); }
+  if ( !m_isUsedBefore && m_useCutFlow) m_el_cutflowCounter_1.fill( m_el_cutflow_d0sig_cut );
+  if ( m_isUsedBefore && m_useCutFlow ) { m_el_cutflowCounter_2.fill( m_el_cutflow_d0sig_cut ); }
 
   // decorate electron w/ d0sig info
   static SG::AuxElement::Decorator< float > d0SigDecor("d0sig");
@@ -971,8 +1035,8 @@ int ElectronSelector :: passCuts( const xAOD::Electron* electron, const xAOD::Ve
       return 0;
     }
 
-    if ( !m_isUsedBefore && m_useCutFlow ) m_el_cutflowHist_1->Fill( m_el_cutflow_BL_cut, 1 );
-    if ( m_isUsedBefore && m_useCutFlow ) { m_el_cutflowHist_2->Fill( m_el_cutflow_BL_cut, 1 ); }
+    if ( !m_isUsedBefore && m_useCutFlow ) m_el_cutflowCounter_1.fill( m_el_cutflow_BL_cut );
+    if ( m_isUsedBefore && m_useCutFlow ) { m_el_cutflowCounter_2.fill( m_el_cutflow_BL_cut ); }
   }
 
   // *********************************************************************************************************************************************************************
@@ -1018,7 +1082,7 @@ int ElectronSelector :: passCuts( const xAOD::Electron* electron, const xAOD::Ve
         }
       }
 
-      const std::set<std::string> myLHWPs = m_el_LH_PIDManager->getValidWPs();
+      const std::set<std::string>& myLHWPs = m_el_LH_PIDManager->getValidWPs();
       for ( auto it : (myLHWPs) ) {
 
         const std::string decorWP =  "LH"+it;
@@ -1050,19 +1114,25 @@ int ElectronSelector :: passCuts( const xAOD::Electron* electron, const xAOD::Ve
       // retrieve only tools with WP >= selected WP, cut electrons if not satisfying selected WP, and decorate w/ tool decision all the others
       //
       typedef std::multimap< std::string, AsgElectronLikelihoodTool* > LHToolsMap;
-      LHToolsMap myLHTools = m_el_LH_PIDManager->getValidWPTools();
+      const LHToolsMap& myLHTools = m_el_LH_PIDManager->getValidWPTools();
 
-      if ( m_doLHPIDcut && !( ( myLHTools.find( m_LHOperatingPoint )->second )->accept( electron ) ) ) {
-        ANA_MSG_DEBUG( "Electron failed likelihood PID cut w/ operating point " << m_LHOperatingPoint );
-        return 0;
+      // each tool is evaluated once: the decision of the selected WP is reused for its decoration
+      char passSelectedWP(-1);
+      if ( m_doLHPIDcut ) {
+        passSelectedWP = static_cast<bool>( ( myLHTools.find( m_LHOperatingPoint )->second )->accept( electron ) );
+        if ( !passSelectedWP ) {
+          ANA_MSG_DEBUG( "Electron failed likelihood PID cut w/ operating point " << m_LHOperatingPoint );
+          return 0;
+        }
       }
 
-      for ( auto it : (myLHTools) ) {
+      for ( const auto& it : (myLHTools) ) {
 
         const std::string decorWP =  "LH" + it.first;
+        const char passThisID = ( passSelectedWP >= 0 && it.first == m_LHOperatingPoint ) ? passSelectedWP : static_cast<bool>( it.second->accept( electron ) );
         ANA_MSG_DEBUG( "Decorating electron with decision for LH WP : " << decorWP );
-        ANA_MSG_DEBUG( "\t does electron pass " << decorWP << " ? " << static_cast<int>( it.second->accept( electron ) ) );
-        electron->auxdecor<char>(decorWP) = static_cast<char>( it.second->accept( electron ) );
+        ANA_MSG_DEBUG( "\t does electron pass " << decorWP << " ? " << static_cast<int>( passThisID ) );
+        electron->auxdecor<char>(decorWP) = passThisID;
 
       }
 
@@ -1094,7 +1164,7 @@ int ElectronSelector :: passCuts( const xAOD::Electron* electron, const xAOD::Ve
 
       }
 
-      const std::set<std::string> myCutBasedWPs = m_el_CutBased_PIDManager->getValidWPs();
+      const std::set<std::string>& myCutBasedWPs = m_el_CutBased_PIDManager->getValidWPs();
       for ( auto it : (myCutBasedWPs) ) {
 
         const std::string decorWP = "IsEM"+it;
@@ -1115,28 +1185,34 @@ int ElectronSelector :: passCuts( const xAOD::Electron* electron, const xAOD::Ve
       // retrieve only tools with WP >= selected WP, cut electrons if not satisfying selected WP, and decorate w/ tool decision all the others
       //
       typedef std::multimap< std::string, AsgElectronIsEMSelector* > CutBasedToolsMap;
-      CutBasedToolsMap myCutBasedTools = m_el_CutBased_PIDManager->getValidWPTools();
+      const CutBasedToolsMap& myCutBasedTools = m_el_CutBased_PIDManager->getValidWPTools();
 
-      if ( m_doCutBasedPIDcut && !( ( myCutBasedTools.find( m_CutBasedOperatingPoint )->second )->accept( *electron ) ) ) {
-        ANA_MSG_DEBUG( "Electron failed cut-based PID cut." );
-        return 0;
+      // each tool is evaluated once: the decision of the selected WP is reused for its decoration
+      char passSelectedWP(-1);
+      if ( m_doCutBasedPIDcut ) {
+        passSelectedWP = static_cast<bool>( ( myCutBasedTools.find( m_CutBasedOperatingPoint )->second )->accept( *electron ) );
+        if ( !passSelectedWP ) {
+          ANA_MSG_DEBUG( "Electron failed cut-based PID cut." );
+          return 0;
+        }
       }
 
-      for ( auto it : (myCutBasedTools) ) {
+      for ( const auto& it : (myCutBasedTools) ) {
 
         const std::string decorWP = "IsEM"+it.second->getOperatingPointName( );
+        const char passThisID = ( passSelectedWP >= 0 && it.first == m_CutBasedOperatingPoint ) ? passSelectedWP : static_cast<bool>( it.second->accept( *electron ) );
 
         ANA_MSG_DEBUG( "Decorating electron with decision for cut-based WP : " << decorWP );
-        ANA_MSG_DEBUG( "\t does electron pass " << decorWP << "? " << static_cast<int>( it.second->accept( *electron ) ) );
+        ANA_MSG_DEBUG( "\t does electron pass " << decorWP << "? " << static_cast<int>( passThisID ) );
 
-        electron->auxdecor<char>(decorWP) = static_cast<char>( it.second->accept( *electron ) );
+        electron->auxdecor<char>(decorWP) = passThisID;
       }
 
     }
   }// if m_doCutBasedPID
 
-  if (!m_isUsedBefore && m_useCutFlow) m_el_cutflowHist_1->Fill( m_el_cutflow_PID_cut, 1 );
-  if ( m_isUsedBefore && m_useCutFlow ) { m_el_cutflowHist_2->Fill( m_el_cutflow_PID_cut, 1 ); }
+  if (!m_isUsedBefore && m_useCutFlow) m_el_cutflowCounter_1.fill( m_el_cutflow_PID_cut );
+  if ( m_isUsedBefore && m_useCutFlow ) { m_el_cutflowCounter_2.fill( m_el_cutflow_PID_cut ); }
 
 
   // *********************************************************************************************************************************************************************
@@ -1144,30 +1220,14 @@ int ElectronSelector :: passCuts( const xAOD::Electron* electron, const xAOD::Ve
   // isolation cut
   //
 
-  // Get the "list" of input WPs with the accept() decision from the tool
-  //
-  Root::TAccept accept_list = m_isolationSelectionTool_handle->accept( *electron );
-
-  // Decorate w/ decision for all input WPs
-  //
-  std::string base_decor("isIsolated");
-  for ( auto WP_itr : m_IsoKeys ) {
-
-    std::string decorWP = base_decor + "_" + WP_itr;
-
-    ANA_MSG_DEBUG( "Decorate electron with " << decorWP << " - accept() ?" << accept_list.getCutResult( WP_itr.c_str()) );
-    electron->auxdecor<char>(decorWP) = static_cast<char>( accept_list.getCutResult( WP_itr.c_str() ) );
-
-  }
-
-  // Apply the cut if needed
+  // Decorate w/ decision for all input WPs, which the tool evaluates in a single accept() call
   //
-  if ( !m_MinIsoWPCut.empty() && !accept_list.getCutResult( m_MinIsoWPCut.c_str() ) ) {
+  if ( !m_isoDecisions.decorate( *electron, m_isolationSelectionTool_handle->accept( *electron ) ) ) {
     ANA_MSG_DEBUG( "Electron failed isolation cut " << m_MinIsoWPCut );
     return 0;
   }
-  if (!m_isUsedBefore && m_useCutFlow) m_el_cutflowHist_1->Fill( m_el_cutflow_iso_cut, 1 );
-  if ( m_isUsedBefore && m_useCutFlow ) { m_el_cutflowHist_2->Fill( m_el_cutflow_iso_cut, 1 ); }
+  if (!m_isUsedBefore && m_useCutFlow) m_el_cutflowCounter_1.fill( m_el_cutflow_iso_cut );
+  if ( m_isUsedBefore && m_useCutFlow ) { m_el_cutflowCounter_2.fill( m_el_cutflow_iso_cut ); }
 
   return 1;
 }
@@ -0,0 +1,70 @@
+#include <xAODAnaHelpers/EtaPhiGrid.h>
+
+#include <algorithm>
+#include <cmath>
+
+void xAH::EtaPhiGrid::fill(const xAOD::IParticleContainer* particles, float cellSize, bool useRapidity)
+{
+  m_particles.clear(); m_y.clear(); m_phi.clear(); m_pt.clear(); m_cells.clear();
+  m_cellSize = cellSize;
+  m_useRapidity = useRapidity;
+  m_nPhi = std::max(1, static_cast<int>(2.*M_PI / cellSize));
+  if(!particles) return;
+
+  const std::size_t n = particles->size();
+  m_particles.reserve(n); m_y.reserve(n); m_phi.reserve(n); m_pt.reserve(n); m_cells.reserve(n);
+
+  for(const xAOD::IParticle* particle : *particles){
+    const float py  = y(particle);
+    const float phi = particle->phi();
+    m_cells.emplace_back(cellKey(yCell(py), phiCell(phi)), m_particles.size());
+    m_particles.push_back(particle);
+    m_y.push_back(py);
+    m_phi.push_back(phi);
+    m_pt.push_back(particle->pt());
+  }
+  std::sort(m_cells.begin(), m_cells.end());
+}
+
+bool xAH::EtaPhiGrid::hasNeighbour(const xAOD::IParticle* particle, float dR, float minPt) const
+{
+  if(m_particles.empty()) return false;
+
+  const float py  = y(particle);
+  const float phi = particle->phi();
+  const float dR2 = dR*dR;
+  const int iy    = yCell(py);
+  const int iphi  = phiCell(phi);
+
+  // with fewer than three phi cells the neighbouring cells are the same
+  int phiCells[3] = { iphi, (iphi+1) % m_nPhi, (iphi+m_nPhi-1) % m_nPhi };
+  const int nPhiCells = std::min(3, m_nPhi);
+
+  for(int jy = iy-1; jy <= iy+1; ++jy){
+    for(int k = 0; k < nPhiCells; ++k){
+      const long long key = cellKey(jy, phiCells[k]);
+      auto range = std::equal_range(m_cells.begin(), m_cells.end(), std::make_pair(key, 0u),
+                                    [](const std::pair<long long, unsigned int>& a, const std::pair<long long, unsigned int>& b){ return a.first < b.first; });
+      for(auto it = range.first; it != range.second; ++it){
+        const unsigned int i = it->second;
+        if(m_particles[i] == particle) continue;
+        if(minPt > 0 && m_pt[i] <= minPt) continue;
+        const float dy   = m_y[i] - py;
+        const float dphi = std::remainder(m_phi[i] - phi, static_cast<float>(2.*M_PI));
+        if(dy*dy + dphi*dphi < dR2) return true;
+      }
+    }
+  }
+  return false;
+}
+
+int xAH::EtaPhiGrid::yCell(float y) const
+{
+  return static_cast<int>(std::floor(y / m_cellSize));
+}
+
+int xAH::EtaPhiGrid::phiCell(float phi) const
+{
+  const int iphi = static_cast<int>(std::floor((phi + M_PI) / (2.*M_PI) * m_nPhi));
+  return std::min(std::max(iphi, 0), m_nPhi-1);
+}
@@ -0,0 +1,76 @@
+#include <xAODAnaHelpers/EventArena.h>
+
+#include <algorithm>
+#include <cstdint>
+
+#include <TH1D.h>
+
+xAH::EventArena& xAH::EventArena::instance()
+{
+  static EventArena arena;
+  return arena;
+}
+
+void* xAH::EventArena::allocate(std::size_t bytes, std::size_t alignment)
+{
+  ++m_allocations;
+  m_bytes += bytes;
+
+  while(m_block < m_blocks.size()){
+    Block& block = m_blocks[m_block];
+    const std::uintptr_t begin = reinterpret_cast<std::uintptr_t>(block.data.get());
+    const std::size_t offset = ((begin + m_offset + alignment - 1) & ~(alignment - 1)) - begin;
+    if(offset + bytes <= block.size){
+      m_offset = offset + bytes;
+      return block.data.get() + offset;
+    }
+    // the rest of this block is lost until the reset
+    ++m_block;
+    m_offset = 0;
+  }
+
+  // twice the size of the blocks so far, and at least enough for this allocation
+  const std::size_t size = std::max(std::max(minBlockSize, 2*capacity()), bytes + alignment);
+  m_blocks.push_back( Block{ std::unique_ptr<char[]>(new char[size]), size } );
+  ++m_blockAllocations;
+  m_block = m_blocks.size() - 1;
+  m_offset = 0;
+  return allocate(bytes, alignment);
+}
+
+void xAH::EventArena::reset()
+{
+  // one block for what the event needed, so that the next ones do not have to grow it again
+  if(m_blocks.size() > 1){
+    const std::size_t size = capacity();
+    m_blocks.clear();
+    m_blocks.push_back( Block{ std::unique_ptr<char[]>(new char[size]), size } );
+    ++m_blockAllocations;
+  }
+  m_block = 0;
+  m_offset = 0;
+}
+
+std::size_t xAH::EventArena::capacity() const
+{
+  std::size_t size = 0;
+  for(const Block& block : m_blocks) size += block.size;
+  return size;
+}
+
+TH1D* xAH::EventArena::makeHist(const std::string& name) const
+{
+  const std::vector<std::pair<std::string, double> > values = {
+    {"events",      static_cast<double>(m_events)},
+    {"allocations", static_cast<double>(m_allocations)},
+    {"bytes",       static_cast<double>(m_bytes)},
+    {"heap_blocks", static_cast<double>(m_blockAllocations)},
+    {"capacity",    static_cast<double>(capacity())}
+  };
+  TH1D* hist = new TH1D(name.c_str(), name.c_str(), values.size(), 0, values.size());
+  for(unsigned int i = 0; i < values.size(); ++i){
+    hist->GetXaxis()->SetBinLabel(i+1, values[i].first.c_str());
+    hist->SetBinContent(i+1, values[i].second);
+  }
+  return hist;
+}
@@ -0,0 +1,264 @@
+#include <xAODAnaHelpers/EventFilter.h>
+
+#include <algorithm>
+#include <cctype>
+#include <cmath>
+#include <cstdlib>
+#include <limits>
+
+struct xAH::EventFilter::Node {
+  enum Type { Constant, Count, Kinematic, Compare, And, Or, Not };
+  enum Var { Pt, Eta, Phi, E, M, Y };
+  enum Op { LT, LE, GT, GE, EQ, NE };
+
+  Type type;
+  double value = 0.;
+  unsigned int collection = 0;
+  unsigned int index = 0;
+  Var var = Pt;
+  Op op = LT;
+  std::unique_ptr<Node> left;
+  std::unique_ptr<Node> right;
+
+  explicit Node(Type t) : type(t) {}
+};
+
+namespace {
+
+  typedef xAH::EventFilter::Node Node;
+
+  // recursive-descent parser of the filter expression
+  class Parser {
+    public:
+      Parser(const std::string& expression, std::vector<std::string>& collections) :
+        m_expr(expression), m_collections(collections) {}
+
+      std::unique_ptr<Node> parse(std::string& error) {
+        std::unique_ptr<Node> node = parseOr();
+        skipSpace();
+        if(node && m_pos != m_expr.size()) fail("unexpected '" + m_expr.substr(m_pos) + "'");
+        if(!m_error.empty()){
+          error = m_error;
+          return nullptr;
+        }
+        return node;
+      }
+
+    private:
+      std::unique_ptr<Node> parseOr() {
+        std::unique_ptr<Node> node = parseAnd();
+        while(node && accept("||")) node = combine(Node::Or, std::move(node), parseAnd());
+        return node;
+      }
+
+      std::unique_ptr<Node> parseAnd() {
+        std::unique_ptr<Node> node = parseUnary();
+        while(node && accept("&&")) node = combine(Node::And, std::move(node), parseUnary());
+        return node;
+      }
+
+      std::unique_ptr<Node> parseUnary() {
+        if(accept("!") ) {
+          std::unique_ptr<Node> operand = parseUnary();
+          if(!operand) return nullptr;
+          std::unique_ptr<Node> node(new Node(Node::Not));
+          node->left = std::move(operand);
+          return node;
+        }
+        if(accept("(")) {
+          std::unique_ptr<Node> node = parseOr();
+          if(node && !accept(")")) return fail("missing ')'");
+          return node;
+        }
+        return parseComparison();
+      }
+
+      std::unique_ptr<Node> parseComparison() {
+        std::unique_ptr<Node> lhs = parseOperand();
+        if(!lhs) return nullptr;
+
+        static const std::vector<std::pair<std::string, Node::Op> > ops = {
+          {"<=", Node::LE}, {">=", Node::GE}, {"==", Node::EQ}, {"!=", Node::NE}, {"<", Node::LT}, {">", Node::GT}
+        };
+        for(const auto& op : ops){
+          if(!accept(op.first)) continue;
+          std::unique_ptr<Node> node = combine(Node::Compare, std::move(lhs), parseOperand());
+          if(node) node->op = op.second;
+          return node;
+        }
+        return fail("expected a comparison after '" + m_expr.substr(0, m_pos) + "'");
+      }
+
+      std::unique_ptr<Node> parseOperand() {
+        skipSpace();
+        if(m_pos >= m_expr.size()) return fail("unexpected end of the expression");
+
+        const char c = m_expr[m_pos];
+        if(std::isdigit(c) || c == '.' || c == '-' || c == '+') {
+          const char* begin = m_expr.c_str() + m_pos;
+          char* end(nullptr);
+          const double value = std::strtod(begin, &end);
+          if(end == begin) return fail("malformed number at '" + m_expr.substr(m_pos) + "'");
+          m_pos += end - begin;
+          std::unique_ptr<Node> node(new Node(Node::Constant));
+          node->value = value;
+          return node;
+        }
+
+        if(!(std::isalpha(c) || c == '_')) return fail("unexpected '" + m_expr.substr(m_pos) + "'");
+        const std::size_t begin = m_pos;
+        while(m_pos < m_expr.size() && (std::isalnum(m_expr[m_pos]) || m_expr[m_pos] == '_')) ++m_pos;
+        const std::string name = m_expr.substr(begin, m_pos - begin);
+
+        if(accept("[")) {
+          skipSpace();
+          const std::size_t indexBegin = m_pos;
+          while(m_pos < m_expr.size() && std::isdigit(m_expr[m_pos])) ++m_pos;
+          if(indexBegin == m_pos || !accept("]")) return fail("malformed index of '" + name + "'");
+
+          static const std::vector<std::pair<std::string, Node::Var> > vars = {
+            {"pt", Node::Pt}, {"eta", Node::Eta}, {"phi", Node::Phi}, {"E", Node::E}, {"m", Node::M}, {"y", Node::Y}
+          };
+          const std::size_t sep = name.rfind('_');
+          auto var = sep == std::string::npos ? vars.end() :
+            std::find_if(vars.begin(), vars.end(), [&](const std::pair<std::string, Node::Var>& v){ return v.first == name.substr(sep+1); });
+          if(sep == 0 || var == vars.end()) return fail("unknown variable '" + name + "', expected <name>_pt/eta/phi/E/m/y[i]");
+
+          std::unique_ptr<Node> node(new Node(Node::Kinematic));
+          node->collection = collection(name.substr(0, sep));
+          node->var = var->second;
+          node->index = std::atoi(m_expr.substr(indexBegin, m_pos - indexBegin).c_str());
+          return node;
+        }
+
+        if(name.size() < 2 || name[0] != 'n') return fail("unknown variable '" + name + "', expected n<name> or <name>_<var>[i]");
+        std::unique_ptr<Node> node(new Node(Node::Count));
+        node->collection = collection(name.substr(1));
+        return node;
+      }
+
+      std::unique_ptr<Node> combine(Node::Type type, std::unique_ptr<Node> left, std::unique_ptr<Node> right) {
+        if(!left || !right) return nullptr;
+        std::unique_ptr<Node> node(new Node(type));
+        node->left = std::move(left);
+        node->right = std::move(right);
+        return node;
+      }
+
+      unsigned int collection(const std::string& name) {
+        auto it = std::find(m_collections.begin(), m_collections.end(), name);
+        if(it != m_collections.end()) return it - m_collections.begin();
+        m_collections.push_back(name);
+        return m_collections.size() - 1;
+      }
+
+      bool accept(const std::string& token) {
+        skipSpace();
+        if(m_expr.compare(m_pos, token.size(), token) != 0) return false;
+        // do not split "<=" into "<" and "=" or "!=" into "!" and "="
+        if(token.size() == 1 && (token == "<" || token == ">" || token == "!") && m_pos+1 < m_expr.size() && m_expr[m_pos+1] == '=') return false;
+        m_pos += token.size();
+        return true;
+      }
+
+      void skipSpace() {
+        while(m_pos < m_expr.size() && std::isspace(m_expr[m_pos])) ++m_pos;
+      }
+
+      std::unique_ptr<Node> fail(const std::string& message) {
+        if(m_error.empty()) m_error = message;
+        return nullptr;
+      }
+
+      const std::string& m_expr;
+      std::vector<std::string>& m_collections;
+      std::size_t m_pos = 0;
+      std::string m_error;
+  };
+
+  double evaluate(const Node& node, const std::vector<const xAOD::IParticleContainer*>& containers, float units) {
+    switch(node.type){
+      case Node::Constant:
+        return node.value;
+      case Node::Count:
+        return containers[node.collection] ? containers[node.collection]->size() : 0;
+      case Node::Kinematic: {
+        const xAOD::IParticleContainer* container = containers[node.collection];
+        if(!container || node.index >= container->size()) return std::numeric_limits<double>::quiet_NaN();
+        const xAOD::IParticle* particle = container->at(node.index);
+        switch(node.var){
+          case Node::Pt:  return particle->pt() / units;
+          case Node::Eta: return particle->eta();
+          case Node::Phi: return particle->phi();
+          case Node::E:   return particle->e() / units;
+          case Node::M:   return particle->m() / units;
+          case Node::Y:   return particle->rapidity();
+        }
+        return std::numeric_limits<double>::quiet_NaN();
+      }
+      case Node::Compare: {
+        const double lhs = evaluate(*node.left, containers, units);
+        const double rhs = evaluate(*node.right, containers, units);
+        // missing objects fail every comparison
+        if(std::isnan(lhs) || std::isnan(rhs)) return 0.;
+        switch(node.op){
+          case Node::LT: return lhs <  rhs;
+          case Node::LE: return lhs <= rhs;
+          case Node::GT: return lhs >  rhs;
+          case Node::GE: return lhs >= rhs;
+          case Node::EQ: return lhs == rhs;
+          case Node::NE: return lhs != rhs;
+        }
+        return 0.;
+      }
+      case Node::And:
+        return evaluate(*node.left, containers, units) && evaluate(*node.right, containers, units);
+      case Node::Or:
+        return evaluate(*node.left, containers, units) || evaluate(*node.right, containers, units);
+      case Node::Not:
+        return !evaluate(*node.left, containers, units);
+    }
+    return 0.;
+  }
+
+}
+
+xAH::EventFilter::EventFilter() :
+  m_units(1e3)
+{
+}
+
+xAH::EventFilter::~EventFilter()
+{
+}
+
+bool xAH::EventFilter::initialize(const std::string& expression, float units, std::string& error)
+{
+  m_root.reset();
+  m_collections.clear();
+  m_units = units;
+
+  if(expression.find_first_not_of(" \t") == std::string::npos) return true;
+
+  Parser parser(expression, m_collections);
+  m_root = parser.parse(error);
+  m_containers.assign(m_collections.size(), nullptr);
+  return static_cast<bool>(m_root);
+}
+
+void xAH::EventFilter::setCollection(const std::string& name, const xAOD::IParticleContainer* container)
+{
+  auto it = std::find(m_collections.begin(), m_collections.end(), name);
+  if(it != m_collections.end()) m_containers[it - m_collections.begin()] = container;
+}
+
+void xAH::EventFilter::clearCollections()
+{
+  std::fill(m_containers.begin(), m_containers.end(), nullptr);
+}
+
+bool xAH::EventFilter::pass() const
+{
+  if(!m_root) return true;
+  return evaluate(*m_root, m_containers, m_units);
+}
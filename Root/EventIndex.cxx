@@ -0,0 +1,85 @@
+#include <xAODAnaHelpers/EventIndex.h>
+
+#include <algorithm>
+
+#include <TDirectory.h>
+#include <TTree.h>
+
+namespace {
+  template <typename T>
+  bool lessByEvent(const T& a, const T& b)
+  {
+    return a.runNumber < b.runNumber || (a.runNumber == b.runNumber && a.eventNumber < b.eventNumber);
+  }
+}
+
+void xAH::EventIndex::add(int runNumber, Long64_t eventNumber, Long64_t entry)
+{
+  // the events of a job usually come in order already, so the final sort is cheap
+  if(m_sorted && !m_entries.empty() && lessByEvent(Entry{runNumber, eventNumber, entry}, m_entries.back())) m_sorted = false;
+  m_entries.push_back({runNumber, eventNumber, entry});
+}
+
+void xAH::EventIndex::write(TDirectory* dir, const std::string& name)
+{
+  sort();
+
+  TDirectory* oldDir = gDirectory;
+  dir->cd();
+
+  Entry current;
+  TTree* tree = new TTree(name.c_str(), "(runNumber, eventNumber) to entry index");
+  tree->Branch("runNumber",   &current.runNumber,   "runNumber/I");
+  tree->Branch("eventNumber", &current.eventNumber, "eventNumber/L");
+  tree->Branch("entry",       &current.entry,       "entry/L");
+  for(const Entry& entry : m_entries){
+    current = entry;
+    tree->Fill();
+  }
+  tree->Write("", TObject::kOverwrite);
+  delete tree;
+
+  if(oldDir) oldDir->cd();
+}
+
+bool xAH::EventIndex::read(TTree* tree)
+{
+  clear();
+  if(!tree || !tree->GetBranch("runNumber") || !tree->GetBranch("eventNumber") || !tree->GetBranch("entry")) return false;
+
+  Entry current;
+  tree->SetBranchAddress("runNumber",   &current.runNumber);
+  tree->SetBranchAddress("eventNumber", &current.eventNumber);
+  tree->SetBranchAddress("entry",       &current.entry);
+
+  m_entries.reserve(tree->GetEntries());
+  for(Long64_t i = 0; i < tree->GetEntries(); ++i){
+    tree->GetEntry(i);
+    add(current.runNumber, current.eventNumber, current.entry);
+  }
+  tree->ResetBranchAddresses();
+
+  sort();
+  return true;
+}
+
+Long64_t xAH::EventIndex::find(int runNumber, Long64_t eventNumber) const
+{
+  const Entry key{runNumber, eventNumber, -1};
+  auto it = std::lower_bound(m_entries.begin(), m_entries.end(), key, lessByEvent<Entry>);
+  if(it == m_entries.end() || it->runNumber != runNumber || it->eventNumber != eventNumber) return -1;
+  return it->entry;
+}
+
+void xAH::EventIndex::clear()
+{
+  m_entries.clear();
+  m_sorted = true;
+}
+
+void xAH::EventIndex::sort()
+{
+  if(m_sorted) return;
+  std::stable_sort(m_entries.begin(), m_entries.end(), lessByEvent<Entry>);
+  m_sorted = true;
+}
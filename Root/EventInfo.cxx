@@ -1,15 +1,21 @@
 #include "xAODAnaHelpers/EventInfo.h"
 #include <xAODAnaHelpers/HelperFunctions.h>
 #include <iostream>
+#include <algorithm>
 #include "xAODTruth/TruthEventContainer.h"
 #include "xAODEventShape/EventShape.h"
 #include "xAODCaloEvent/CaloClusterContainer.h"
+#include "xAODTruth/TruthMetaDataContainer.h"
+#include <TObjString.h>
+#include <TLeaf.h>
+#include <TChain.h>
 
 
 using namespace xAH;
 
 EventInfo::EventInfo(const std::string& detailStr, float units, bool mc, bool storeSyst)
-  : m_infoSwitch(detailStr), m_mc(mc), m_debug(false), m_storeSyst(storeSyst), m_units(units)
+  : m_infoSwitch(detailStr), m_mc(mc), m_debug(false), m_storeSyst(storeSyst), m_units(units),
+    m_nWeightsArray(0), m_weightsArrayBranch(nullptr), m_weightsArrayDictionary(nullptr)
 {
 }
 
@@ -33,7 +39,35 @@ void EventInfo::setTree(TTree *tree)
     connectBranch<int     >(tree, "mcEventNumber",              &m_mcEventNumber);
     connectBranch<int     >(tree, "mcChannelNumber",            &m_mcChannelNumber);
     connectBranch<float   >(tree, "mcEventWeight",              &m_mcEventWeight);
-    if ( m_infoSwitch.m_weightsSys ) {
+    if ( m_infoSwitch.m_weightsArray ) {
+      // a TChain has no user info or leaves of its own
+      if ( tree->GetTree() == nullptr ) tree->LoadTree(0);
+      TTree* current = tree->GetTree() ? tree->GetTree() : tree;
+
+      m_weightsArrayNames.clear();
+      if ( const TList* dictionary = dynamic_cast<const TList*>(current->GetUserInfo()->FindObject("weightsArrayDictionary")) ) {
+        for ( const TObject* name : *dictionary ) m_weightsArrayNames.push_back( name->GetName() );
+      }
+
+      // the buffer has to hold the longest array of all files of a chain, as the address is kept when the chain moves on
+      std::size_t n = m_weightsArrayNames.size();
+      if ( const TLeaf* count = current->GetLeaf("nWeightsArray") ) n = std::max<std::size_t>( n, count->GetMaximum() );
+      if ( TChain* chain = dynamic_cast<TChain*>(tree) ) {
+        const int firstTree = chain->GetTreeNumber();
+        for ( Long64_t entry = 0; chain->LoadTree(entry) >= 0; ) {
+          if ( const TLeaf* count = chain->GetTree()->GetLeaf("nWeightsArray") ) n = std::max<std::size_t>( n, count->GetMaximum() );
+          const Long64_t next = chain->GetTreeOffset()[chain->GetTreeNumber()] + chain->GetTree()->GetEntries();
+          if ( next <= entry ) break;
+          entry = next;
+        }
+        if ( firstTree >= 0 ) chain->LoadTree( chain->GetTreeOffset()[firstTree] );
+      }
+      m_weightsArray.assign( std::max<std::size_t>( n, 1 ), 0. );
+
+      connectBranch<int>(tree, "nWeightsArray", &m_nWeightsArray);
+      tree->SetBranchStatus ("weightsArray", 1);
+      tree->SetBranchAddress("weightsArray", m_weightsArray.data());
+    } else if ( m_infoSwitch.m_weightsSys ) {
       connectBranch< std::vector<float> >(tree, "mcEventWeights", &m_mcEventWeights);
     }
   }
@@ -135,7 +169,22 @@ void EventInfo::setBranches(TTree *tree)
     tree->Branch("mcEventNumber",      &m_mcEventNumber,  "mcEventNumber/I");
     tree->Branch("mcChannelNumber",    &m_mcChannelNumber,"mcChannelNumber/I");
     tree->Branch("mcEventWeight",      &m_mcEventWeight,  "mcEventWeight/F");
-    if ( m_infoSwitch.m_weightsSys ) {
+    if ( m_infoSwitch.m_weightsArray ) {
+      resizeWeightsArray( 1 );
+      tree->Branch("nWeightsArray",    &m_nWeightsArray,  "nWeightsArray/I");
+      m_weightsArrayBranch = tree->Branch("weightsArray", m_weightsArray.data(), "weightsArray[nWeightsArray]/F");
+
+      // the names of the entries, owned by the user info list of the tree
+      TList* userInfo = tree->GetUserInfo();
+      if ( TObject* previous = userInfo->FindObject("weightsArrayDictionary") ) {
+        userInfo->Remove(previous);
+        delete previous;
+      }
+      m_weightsArrayDictionary = new TList();
+      m_weightsArrayDictionary->SetName("weightsArrayDictionary");
+      m_weightsArrayDictionary->SetOwner(kTRUE);
+      userInfo->Add(m_weightsArrayDictionary);
+    } else if ( m_infoSwitch.m_weightsSys ) {
       tree->Branch("mcEventWeights",   &m_mcEventWeights);
     }
   }
@@ -256,6 +305,7 @@ void EventInfo::clear()
   if ( m_infoSwitch.m_weightsSys ) {
     m_mcEventWeights.clear();
   }
+  m_nWeightsArray = 0;
 
   // CaloCluster
   if( m_infoSwitch.m_caloClus){
@@ -282,7 +332,7 @@ void EventInfo::FillEvent( const xAOD::EventInfo* eventInfo, xAOD::TEvent* event
     m_mcEventNumber         = eventInfo->mcEventNumber();
     m_mcChannelNumber       = eventInfo->mcChannelNumber();
     m_mcEventWeight         = eventInfo->mcEventWeight();
-    if ( m_infoSwitch.m_weightsSys ) {
+    if ( m_infoSwitch.m_weightsSys && !m_infoSwitch.m_weightsArray ) {
       if ( m_storeSyst ) {
         m_mcEventWeights      = eventInfo->mcEventWeights();
       } else {
@@ -438,6 +488,60 @@ void EventInfo::FillEvent( const xAOD::EventInfo* eventInfo, xAOD::TEvent* event
 
   }
 
+  // after the pileup weights, which go in front of the generator ones
+  if ( m_mc && m_infoSwitch.m_weightsArray ) fillWeightsArray( eventInfo, event );
 
   return;
 }
+
+void EventInfo::resizeWeightsArray( std::size_t n )
+{
+  if ( n <= m_weightsArray.size() && !m_weightsArray.empty() ) return;
+  m_weightsArray.resize( std::max<std::size_t>( n, 1 ) );
+  // the leaf points to the buffer itself
+  if ( m_weightsArrayBranch ) m_weightsArrayBranch->SetAddress( m_weightsArray.data() );
+}
+
+void EventInfo::fillWeightsArray( const xAOD::EventInfo* eventInfo, xAOD::TEvent* event )
+{
+  const std::vector<float>& mcEventWeights = eventInfo->mcEventWeights();
+  const std::size_t nPileup = m_infoSwitch.m_pileup ? ( m_infoSwitch.m_pileupsys ? 3 : 1 ) : 0;
+  const std::size_t nGenerator = ( m_infoSwitch.m_weightsSys && m_storeSyst ) ? mcEventWeights.size() : 1;
+
+  resizeWeightsArray( nPileup + nGenerator );
+  float* out = m_weightsArray.data();
+  if ( nPileup > 0 ) *out++ = m_weight_pileup;
+  if ( nPileup > 1 ) {
+    *out++ = m_weight_pileup_up;
+    *out++ = m_weight_pileup_down;
+  }
+  if ( nGenerator == mcEventWeights.size() ) out = std::copy( mcEventWeights.begin(), mcEventWeights.end(), out );
+  else                                       *out++ = m_mcEventWeight;
+  m_nWeightsArray = nPileup + nGenerator;
+
+  // the dictionary is written once, from the first event
+  if ( !m_weightsArrayDictionary || m_weightsArrayDictionary->GetEntries() > 0 ) return;
+
+  if ( nPileup > 0 ) m_weightsArrayDictionary->Add( new TObjString("PileupWeight") );
+  if ( nPileup > 1 ) {
+    m_weightsArrayDictionary->Add( new TObjString("PileupWeight_UP") );
+    m_weightsArrayDictionary->Add( new TObjString("PileupWeight_DOWN") );
+  }
+
+  // the generator weights are named from the truth metadata of the sample when it has them
+  std::vector<std::string> weightNames;
+  const xAOD::TruthMetaDataContainer* truthMetaData(nullptr);
+  if ( event && event->containsMeta<xAOD::TruthMetaDataContainer>("TruthMetaData") && event->retrieveMetaInput(truthMetaData, "TruthMetaData").isSuccess() ) {
+    for ( const auto metaData : *truthMetaData ) {
+      if ( metaData->mcChannelNumber() == static_cast<uint32_t>(m_mcChannelNumber) ) weightNames = metaData->weightNames();
+    }
+  }
+  if ( weightNames.size() != nGenerator ) {
+    weightNames.clear();
+    for ( std::size_t i = 0; i < nGenerator; ++i ) weightNames.push_back( "mcEventWeight_" + std::to_string(i) );
+  }
+  for ( const auto& name : weightNames ) m_weightsArrayDictionary->Add( new TObjString(name.c_str()) );
+
+  m_weightsArrayNames.clear();
+  for ( const TObject* name : *m_weightsArrayDictionary ) m_weightsArrayNames.push_back( name->GetName() );
+}
@@ -0,0 +1,71 @@
+#include <xAODAnaHelpers/EventNumberSet.h>
+
+namespace {
+  // splitmix64 finaliser, event numbers are far from uniformly distributed in the low bits
+  inline uint64_t mix(uint64_t x)
+  {
+    x ^= x >> 30; x *= 0xbf58476d1ce4e5b9ULL;
+    x ^= x >> 27; x *= 0x94d049bb133111ebULL;
+    x ^= x >> 31;
+    return x;
+  }
+}
+
+bool xAH::EventNumberSet::insert(uint32_t runNumber, uint64_t eventNumber)
+{
+  if(!m_lastTable || runNumber != m_lastRun){
+    m_lastTable = &m_runs[runNumber];
+    m_lastRun = runNumber;
+  }
+  return insert(*m_lastTable, eventNumber);
+}
+
+void xAH::EventNumberSet::clear()
+{
+  m_runs.clear();
+  m_lastTable = nullptr;
+}
+
+std::size_t xAH::EventNumberSet::size() const
+{
+  std::size_t n = 0;
+  for(const auto& run : m_runs) n += run.second.size + run.second.hasZero;
+  return n;
+}
+
+bool xAH::EventNumberSet::insert(RunTable& table, uint64_t eventNumber)
+{
+  if(eventNumber == 0){
+    if(table.hasZero) return false;
+    table.hasZero = true;
+    return true;
+  }
+
+  // keep the load below 1/2
+  if(2*(table.size+1) > table.slots.size()) grow(table);
+
+  const std::size_t mask = table.slots.size() - 1;
+  for(std::size_t i = mix(eventNumber) & mask; ; i = (i+1) & mask){
+    if(table.slots[i] == eventNumber) return false;
+    if(table.slots[i] == 0){
+      table.slots[i] = eventNumber;
+      ++table.size;
+      return true;
+    }
+  }
+}
+
+void xAH::EventNumberSet::grow(RunTable& table)
+{
+  std::vector<uint64_t> old;
+  old.swap(table.slots);
+  table.slots.assign(old.empty() ? 1024 : 2*old.size(), 0);
+
+  const std::size_t mask = table.slots.size() - 1;
+  for(uint64_t eventNumber : old){
+    if(eventNumber == 0) continue;
+    std::size_t i = mix(eventNumber) & mask;
+    while(table.slots[i] != 0) i = (i+1) & mask;
+    table.slots[i] = eventNumber;
+  }
+}
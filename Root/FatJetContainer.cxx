@@ -63,11 +63,11 @@ FatJetContainer::FatJetContainer(const std::string& name, const std::string& det
   }
 
   if ( m_infoSwitch.m_constituentAll) {
-    m_constituentWeights  = new std::vector< std::vector<float> >();
-    m_constituent_pt      = new std::vector< std::vector<float> >();
-    m_constituent_eta     = new std::vector< std::vector<float> >();
-    m_constituent_phi     = new std::vector< std::vector<float> >();
-    m_constituent_e       = new std::vector< std::vector<float> >();
+    m_constituentWeights  = new xAH::JaggedBranch<float>(m_infoSwitch.m_flatArrays);
+    m_constituent_pt      = new xAH::JaggedBranch<float>(m_infoSwitch.m_flatArrays);
+    m_constituent_eta     = new xAH::JaggedBranch<float>(m_infoSwitch.m_flatArrays);
+    m_constituent_phi     = new xAH::JaggedBranch<float>(m_infoSwitch.m_flatArrays);
+    m_constituent_e       = new xAH::JaggedBranch<float>(m_infoSwitch.m_flatArrays);
   }
 
   
@@ -99,7 +99,7 @@ FatJetContainer::FatJetContainer(const std::string& name, const std::string& det
       trkJetName += "_"+trackJetName;
       m_trkJets[trackJetName] = new xAH::JetContainer(trkJetName, subjetDetailStr, m_units, m_mc);
 
-      m_trkJetsIdx[trackJetName] = new std::vector<std::vector<unsigned int> > ();
+      m_trkJetsIdx[trackJetName] = new xAH::JaggedBranch<unsigned int>(m_infoSwitch.m_flatArrays);
     }
 
 }
@@ -262,11 +262,11 @@ void FatJetContainer::setTree(TTree *tree)
   }
 
   if ( m_infoSwitch.m_constituentAll) {
-    connectBranch< std::vector<float> >(tree, "constituentWeights",  &m_constituentWeights);
-    connectBranch< std::vector<float> >(tree, "constituent_pt",      &m_constituent_pt);
-    connectBranch< std::vector<float> >(tree, "constituent_eta",     &m_constituent_eta);
-    connectBranch< std::vector<float> >(tree, "constituent_phi",     &m_constituent_phi);
-    connectBranch< std::vector<float> >(tree, "constituent_e",       &m_constituent_e);
+    connectBranch<float>(tree, "constituentWeights",  m_constituentWeights);
+    connectBranch<float>(tree, "constituent_pt",      m_constituent_pt);
+    connectBranch<float>(tree, "constituent_eta",     m_constituent_eta);
+    connectBranch<float>(tree, "constituent_phi",     m_constituent_phi);
+    connectBranch<float>(tree, "constituent_e",       m_constituent_e);
   }
 
   if(m_infoSwitch.m_truth)
@@ -292,16 +292,41 @@ void FatJetContainer::setTree(TTree *tree)
 	
   } 
 
-  for(const std::pair< std::string, std::vector<std::vector<unsigned int>>* >& kv : m_trkJetsIdx)
+  for(const auto& kv : m_trkJetsIdx)
     {
       m_trkJets[kv.first]->JetContainer::setTree(tree);
       if(tree->GetBranch(branchName("trkJetsIdx").c_str()))
-	connectBranch< std::vector<unsigned int> >(tree, "trkJetsIdx", &m_trkJetsIdx[kv.first]);
+	connectBranch<unsigned int>(tree, "trkJetsIdx", kv.second);
       else
-	connectBranch< std::vector<unsigned int> >(tree, "trkJetsIdx_"+kv.first, &m_trkJetsIdx[kv.first]);
+	connectBranch<unsigned int>(tree, "trkJetsIdx_"+kv.first, kv.second);
     }
 }
 
+void FatJetContainer::updateEntry()
+{
+  // the track jets are decoded on first use by the fat jets pointing to them
+  for(const auto& kv : m_trkJets) kv.second->updateEntryLazy();
+  ParticleContainer::updateEntry();
+}
+
+void FatJetContainer::updateEntryLazy()
+{
+  for(const auto& kv : m_trkJets) kv.second->updateEntryLazy();
+  ParticleContainer::updateEntryLazy();
+}
+
+xAH::JaggedBranch<unsigned int>::Span FatJetContainer::trkJetIndices(uint idx, const std::string& trackJetName) const
+{
+  return m_trkJetsIdx.at(trackJetName)->span(idx);
+}
+
+const Jet& FatJetContainer::trackJet(const std::string& trackJetName, uint iTrkJet)
+{
+  // the track jet branches are read along with those of the fat jets
+  loadLazyBranches();
+  return m_trkJets.at(trackJetName)->particle(iTrkJet);
+}
+
 void FatJetContainer::updateParticle(uint idx, FatJet& fatjet)
 {
   if(m_debug) std::cout << "in FatJetContainer::updateParticle " << std::endl;
@@ -389,15 +414,14 @@ void FatJetContainer::updateParticle(uint idx, FatJet& fatjet)
     fatjet.muonCorrected_m   = m_muonCorrected_m  ->at(idx);
   }
 
-  for(const auto& kv : m_trkJets)
+  if(m_copyTrkJets)
     {
-      fatjet.trkJets[kv.first].clear();
-      std::vector<std::vector<unsigned int>> *trkJetsIdx=m_trkJetsIdx[kv.first];
-      for(unsigned int iTrkJet : trkJetsIdx->at(idx))
+      for(const auto& kv : m_trkJets)
 	{
-	  Jet thisTrkJet;
-	  kv.second->updateParticle(iTrkJet, thisTrkJet);
-	  fatjet.trkJets[kv.first].push_back(thisTrkJet);
+	  std::vector<Jet>& trkJets = fatjet.trkJets[kv.first];
+	  trkJets.clear();
+	  for(unsigned int iTrkJet : m_trkJetsIdx[kv.first]->span(idx))
+	    trkJets.push_back(kv.second->particle(iTrkJet));
 	}
     }
 
@@ -465,11 +489,11 @@ void FatJetContainer::setBranches(TTree *tree)
   }
 
   if ( m_infoSwitch.m_constituentAll) {
-    setBranch< std::vector<float> >(tree, "constituentWeights",  m_constituentWeights);
-    setBranch< std::vector<float> >(tree, "constituent_pt",      m_constituent_pt);
-    setBranch< std::vector<float> >(tree, "constituent_eta",     m_constituent_eta);
-    setBranch< std::vector<float> >(tree, "constituent_phi",     m_constituent_phi);
-    setBranch< std::vector<float> >(tree, "constituent_e",       m_constituent_e);
+    setBranch<float>(tree, "constituentWeights",  m_constituentWeights);
+    setBranch<float>(tree, "constituent_pt",      m_constituent_pt);
+    setBranch<float>(tree, "constituent_eta",     m_constituent_eta);
+    setBranch<float>(tree, "constituent_phi",     m_constituent_phi);
+    setBranch<float>(tree, "constituent_e",       m_constituent_e);
   }
 
   if ( m_infoSwitch.m_truth && m_mc ) {
@@ -495,7 +519,7 @@ void FatJetContainer::setBranches(TTree *tree)
   for(const auto& kv : m_trkJets)
     {
       kv.second->setBranches(tree);
-      setBranch< std::vector<unsigned int> >(tree, "trkJetsIdx_"+kv.first, m_trkJetsIdx[kv.first]);
+      setBranch<unsigned int>(tree, "trkJetsIdx_"+kv.first, m_trkJetsIdx[kv.first]);
     }
 
   return;
@@ -588,15 +612,35 @@ void FatJetContainer::clear()
     m_muonCorrected_m  ->clear();
   }
   
-  for(const std::pair< std::string, std::vector<std::vector<unsigned int>>* >& kv : m_trkJetsIdx)
+  for(const auto& kv : m_trkJetsIdx)
     {
-      m_trkJets   [kv.first]->clear();
-      m_trkJetsIdx[kv.first]->clear();
+      m_trkJets[kv.first]->clear();
+      kv.second->clear();
     }
 
   return;
 }
 
+bool FatJetContainer::copyFrom(const ParticleContainer& other)
+{
+  const FatJetContainer* otherFatJets = dynamic_cast<const FatJetContainer*>(&other);
+  if ( !otherFatJets ) return false;
+
+  for(const auto& kv : m_trkJets)
+    {
+      if ( otherFatJets->m_trkJets.count(kv.first) == 0 ) return false;
+    }
+
+  if ( !ParticleContainer::copyFrom(other) ) return false;
+
+  for(const auto& kv : m_trkJets)
+    {
+      if ( !kv.second->copyFrom(*otherFatJets->m_trkJets.at(kv.first)) ) return false;
+    }
+
+  return true;
+}
+
 void FatJetContainer::FillFatJet( const xAOD::Jet* jet, int pvLocation ){
   return FillFatJet(static_cast<const xAOD::IParticle*>(jet), pvLocation);
 }
@@ -759,34 +803,33 @@ void FatJetContainer::FillFatJet( const xAOD::IParticle* particle, int pvLocatio
 
 
   if( m_infoSwitch.m_constituentAll ){
-    m_constituentWeights->push_back( fatjet->getAttribute< std::vector<float> >( "constituentWeights" ) );
-    std::vector<float> pt;
-    std::vector<float> eta;
-    std::vector<float> phi;
-    std::vector<float> e;
+    // the precision of each variable is set by the constituentBits detail
+    m_constituentWeights->newEntry();
+    for( float weight : fatjet->getAttribute< std::vector<float> >( "constituentWeights" ) )
+      m_constituentWeights->fill( HelperFunctions::reducePrecision( weight, m_infoSwitch.m_constitWeightsBits ) );
+
+    m_constituent_pt ->newEntry();
+    m_constituent_eta->newEntry();
+    m_constituent_phi->newEntry();
+    m_constituent_e  ->newEntry();
     xAOD::JetConstituentVector consVec = fatjet->getConstituents();
-
     if( consVec.isValid() ) {
-
       // use the example provided in
       // http://acode-browser.usatlas.bnl.gov/lxr/source/atlas/Event/xAOD/xAODJet/xAODJet/JetConstituentVector.h
       xAOD::JetConstituentVector::iterator constit = consVec.begin();
       xAOD::JetConstituentVector::iterator constitE = consVec.end();
       for( ; constit != constitE; constit++){
-	pt. push_back( constit->pt() / m_units );
-	eta.push_back( constit->eta() );
-	phi.push_back( constit->phi() );
-	e.  push_back( constit->e() / m_units  );
+        m_constituent_pt ->fill( HelperFunctions::reducePrecision( constit->pt() / m_units, m_infoSwitch.m_constitPtBits  ) );
+        m_constituent_eta->fill( HelperFunctions::reducePrecision( constit->eta(),          m_infoSwitch.m_constitEtaBits ) );
+        m_constituent_phi->fill( HelperFunctions::reducePrecision( constit->phi(),          m_infoSwitch.m_constitPhiBits ) );
+        m_constituent_e  ->fill( HelperFunctions::reducePrecision( constit->e() / m_units,  m_infoSwitch.m_constitEBits   ) );
       }
     }
-    m_constituent_pt ->push_back( pt  );
-    m_constituent_eta->push_back( eta );
-    m_constituent_phi->push_back( phi );
-    m_constituent_e  ->push_back( e   );
   }
 
   if ( m_infoSwitch.m_truth && m_mc ) {
-    const xAOD::Jet* truthJet = HelperFunctions::getLink<xAOD::Jet>( fatjet, "GhostTruthAssociationLink" );
+    static const SG::AuxElement::ConstAccessor< ElementLink<xAOD::JetContainer> > ghostTruthLink("GhostTruthAssociationLink");
+    const xAOD::Jet* truthJet = HelperFunctions::getLink<xAOD::Jet>( fatjet, ghostTruthLink );
     if(truthJet) {
       m_truth_pt->push_back ( truthJet->pt() / m_units );
       m_truth_eta->push_back( truthJet->eta() );
@@ -805,9 +848,10 @@ void FatJetContainer::FillFatJet( const xAOD::IParticle* particle, int pvLocatio
 
     const xAOD::Jet* fatjet_parent = fatjet; // Trimmed jet area will be used for leading calo-jet if parent link fails    
 
+    static const SG::AuxElement::ConstAccessor< ElementLink<xAOD::JetContainer> > parentLink("Parent");
     try
       {
-	auto el = fatjet->auxdata<ElementLink<xAOD::JetContainer> >("Parent");
+	auto el = parentLink(*fatjet);
 	if(el.isValid())
 	  fatjet_parent = (*el);
 	else
@@ -848,8 +892,9 @@ void FatJetContainer::FillFatJet( const xAOD::IParticle* particle, int pvLocatio
     // Find the fat jet parent
     const xAOD::Jet* fatjet_parent = fatjet; // Trimmed jet area will be used for leading calo-jet if parent link fails
 
+    static const SG::AuxElement::ConstAccessor< ElementLink<xAOD::JetContainer> > parentLink("Parent");
     try{
-      auto el = fatjet->auxdata<ElementLink<xAOD::JetContainer> >("Parent");
+      auto el = parentLink(*fatjet);
       if(el.isValid())
 	fatjet_parent = (*el);
       else
@@ -871,13 +916,14 @@ void FatJetContainer::FillFatJet( const xAOD::IParticle* particle, int pvLocatio
 	  Warning("execute()", "Unable to fetch \"%s\" link from leading calo-jet", trackJetName.data());
 	}
 
-	std::vector<unsigned int> trkJetsIdx;
+	xAH::JetContainer* trkJets = m_trkJets[trackJetName];
+	xAH::JaggedBranch<unsigned int>* trkJetsIdx = m_trkJetsIdx[trackJetName];
+	trkJetsIdx->newEntry();
 	for(auto TrackJet : assotrkjets){
 	  if(!SelectTrackJet(TrackJet)) continue;
-	  trkJetsIdx.push_back(m_trkJets[trackJetName]->m_n);
-	  m_trkJets[trackJetName]->FillJet(TrackJet, 0 , 0);
+	  trkJetsIdx->fill(trkJets->m_n);
+	  trkJets->FillJet(TrackJet, 0 , 0);
 	}
-	m_trkJetsIdx[trackJetName]->push_back(trkJetsIdx);
       }
   }
 
@@ -0,0 +1,50 @@
+#include <xAODAnaHelpers/FilePrefetcher.h>
+
+#include <TFile.h>
+#include <TROOT.h>
+
+#include <memory>
+#include <sstream>
+
+xAH::FilePrefetcher::~FilePrefetcher()
+{
+  wait();
+}
+
+void xAH::FilePrefetcher::setFiles(const std::string& files)
+{
+  m_files.clear();
+  std::stringstream ss(files);
+  std::string file;
+  while ( std::getline(ss, file, ',') ) {
+    if ( !file.empty() ) m_files.push_back(file);
+  }
+}
+
+void xAH::FilePrefetcher::prefetchAfter(const std::string& fileName)
+{
+  wait();
+
+  // the current file is matched on its name, EventLoop does not give the URL it was opened with
+  auto endsWith = [](const std::string& url, const std::string& name){
+    return url.size() >= name.size() && url.compare(url.size() - name.size(), name.size(), name) == 0;
+  };
+  for ( std::size_t i = 0; i + 1 < m_files.size(); ++i ) {
+    if ( !endsWith(m_files[i], fileName) ) continue;
+
+    // ROOT needs to be told once that it will be used from several threads
+    static const bool rootThreadSafety = [](){ ROOT::EnableThreadSafety(); return true; }();
+    (void)rootThreadSafety;
+
+    const std::string next = m_files[i+1];
+    m_thread = std::thread([next](){
+      std::unique_ptr<TFile> file( TFile::Open(next.c_str(), "READ") );
+    });
+    return;
+  }
+}
+
+void xAH::FilePrefetcher::wait()
+{
+  if ( m_thread.joinable() ) m_thread.join();
+}
@@ -0,0 +1,188 @@
+#include <xAODAnaHelpers/FillBenchmark.h>
+
+#include <chrono>
+#include <cmath>
+#include <exception>
+#include <functional>
+#include <typeinfo>
+#include <vector>
+
+#include "AthContainers/AuxTypeRegistry.h"
+#include "AthContainers/AuxVectorData.h"
+#include "AthContainers/exceptions.h"
+#include "xAODJet/JetContainer.h"
+#include "xAODJet/JetAuxContainer.h"
+#include "xAODMuon/MuonContainer.h"
+#include "xAODMuon/MuonAuxContainer.h"
+#include "xAODEgamma/ElectronContainer.h"
+#include "xAODEgamma/ElectronAuxContainer.h"
+
+#include <TRandom3.h>
+#include <TTree.h>
+
+#include <xAODAnaHelpers/AllocationProfiler.h>
+#include <xAODAnaHelpers/JetContainer.h>
+#include <xAODAnaHelpers/MuonContainer.h>
+#include <xAODAnaHelpers/ElectronContainer.h>
+
+namespace {
+
+  // add every registered aux variable missing from the container, returns whether any was added
+  bool addMissingVariables(SG::AuxVectorData& container, std::size_t n, TRandom3& rnd)
+  {
+    SG::AuxTypeRegistry& registry = SG::AuxTypeRegistry::instance();
+    bool added = false;
+    for(SG::auxid_t auxid = 0; auxid < registry.numVariables(); ++auxid){
+      if(container.isAvailable(auxid)) continue;
+      const std::type_info* type = registry.getType(auxid);
+      if(!type) continue;
+
+      void* data = container.getDataArray(auxid);
+      added = true;
+      if(*type == typeid(float)){
+        float* values = static_cast<float*>(data);
+        for(std::size_t i = 0; i < n; ++i) values[i] = rnd.Uniform();
+      } else if(*type == typeid(double)){
+        double* values = static_cast<double*>(data);
+        for(std::size_t i = 0; i < n; ++i) values[i] = rnd.Uniform();
+      } else if(*type == typeid(std::vector<float>)){
+        std::vector<float>* values = static_cast<std::vector<float>*>(data);
+        for(std::size_t i = 0; i < n; ++i) values[i].assign(1, rnd.Uniform());
+      } else if(*type == typeid(std::vector<int>)){
+        std::vector<int>* values = static_cast<std::vector<int>*>(data);
+        for(std::size_t i = 0; i < n; ++i) values[i].assign(1, rnd.Integer(10));
+      }
+    }
+    return added;
+  }
+
+  /**
+     Fill all the objects and clear, events times. The first event is repeated, adding the variables
+     the fill misses, until it goes through, and is not timed.
+   */
+  xAH::FillBenchmark::Result run(xAH::FillBenchmark::Result result, SG::AuxVectorData& container, std::size_t n, TRandom3& rnd,
+                                 const std::function<void(std::size_t)>& fill, const std::function<void()>& clear)
+  {
+    for(unsigned int attempt = 0; ; ++attempt){
+      try {
+        for(std::size_t i = 0; i < n; ++i) fill(i);
+        clear();
+        break;
+      } catch(const SG::ExcBadAuxVar& e) {
+        clear();
+        if(attempt > 100 || !addMissingVariables(container, n, rnd)){
+          result.error = e.what();
+          return result;
+        }
+      } catch(const std::exception& e) {
+        result.error = e.what();
+        return result;
+      }
+    }
+
+    const bool countAllocations = xAH::AllocationProfiler::enable();
+    xAH::AllocationProfiler allocations;
+    std::chrono::steady_clock::duration fillTime(0), clearTime(0);
+    {
+      xAH::AllocationProfiler::Scope scope(allocations, countAllocations);
+      for(unsigned int event = 0; event < result.events; ++event){
+        const auto start = std::chrono::steady_clock::now();
+        for(std::size_t i = 0; i < n; ++i) fill(i);
+        const auto filled = std::chrono::steady_clock::now();
+        clear();
+        clearTime += std::chrono::steady_clock::now() - filled;
+        fillTime  += filled - start;
+      }
+    }
+
+    const double nObjects = static_cast<double>(result.events)*n;
+    if(nObjects > 0){
+      result.fillNsPerObject = std::chrono::duration<double, std::nano>(fillTime).count()/nObjects;
+      result.clearNsPerEvent = std::chrono::duration<double, std::nano>(clearTime).count()/result.events;
+      if(countAllocations){
+        result.allocationsPerObject = allocations.total().allocations/nObjects;
+        result.bytesPerObject = allocations.total().bytes/nObjects;
+      }
+    }
+    return result;
+  }
+
+  xAH::FillBenchmark::Result makeResult(const std::string& container, const std::string& detailStr, unsigned int objects, unsigned int events)
+  {
+    xAH::FillBenchmark::Result result;
+    result.container = container;
+    result.detailStr = detailStr;
+    result.objects = objects;
+    result.events = events;
+    return result;
+  }
+
+}
+
+xAH::FillBenchmark::Result xAH::FillBenchmark::jets(const std::string& detailStr, unsigned int objects, unsigned int events, bool mc)
+{
+  TRandom3 rnd(1);
+  xAOD::JetContainer jets;
+  xAOD::JetAuxContainer aux;
+  jets.setStore(&aux);
+  for(unsigned int i = 0; i < objects; ++i){
+    xAOD::Jet* jet = new xAOD::Jet();
+    jets.push_back(jet);
+    jet->setJetP4(xAOD::JetFourMom_t(rnd.Uniform(20e3, 200e3), rnd.Uniform(-2.5, 2.5), rnd.Uniform(-M_PI, M_PI), rnd.Uniform(1e3, 20e3)));
+  }
+
+  TTree tree("benchmark", "benchmark");
+  tree.SetDirectory(nullptr);
+  xAH::JetContainer filler("jet", detailStr, 1e3, mc);
+  filler.setBranches(&tree);
+
+  return run(makeResult("jet", detailStr, objects, events), jets, objects, rnd,
+             [&](std::size_t i){ filler.FillJet(jets[i], nullptr, 0); },
+             [&](){ filler.clear(); });
+}
+
+xAH::FillBenchmark::Result xAH::FillBenchmark::muons(const std::string& detailStr, unsigned int objects, unsigned int events, bool mc)
+{
+  TRandom3 rnd(1);
+  xAOD::MuonContainer muons;
+  xAOD::MuonAuxContainer aux;
+  muons.setStore(&aux);
+  for(unsigned int i = 0; i < objects; ++i){
+    xAOD::Muon* muon = new xAOD::Muon();
+    muons.push_back(muon);
+    muon->setP4(rnd.Uniform(10e3, 100e3), rnd.Uniform(-2.5, 2.5), rnd.Uniform(-M_PI, M_PI));
+    muon->setCharge(i % 2 ? 1 : -1);
+  }
+
+  TTree tree("benchmark", "benchmark");
+  tree.SetDirectory(nullptr);
+  xAH::MuonContainer filler("muon", detailStr, 1e3, mc);
+  filler.setBranches(&tree);
+
+  return run(makeResult("muon", detailStr, objects, events), muons, objects, rnd,
+             [&](std::size_t i){ filler.FillMuon(muons[i], nullptr); },
+             [&](){ filler.clear(); });
+}
+
+xAH::FillBenchmark::Result xAH::FillBenchmark::electrons(const std::string& detailStr, unsigned int objects, unsigned int events, bool mc)
+{
+  TRandom3 rnd(1);
+  xAOD::ElectronContainer electrons;
+  xAOD::ElectronAuxContainer aux;
+  electrons.setStore(&aux);
+  for(unsigned int i = 0; i < objects; ++i){
+    xAOD::Electron* electron = new xAOD::Electron();
+    electrons.push_back(electron);
+    electron->setP4(rnd.Uniform(10e3, 100e3), rnd.Uniform(-2.47, 2.47), rnd.Uniform(-M_PI, M_PI), 0.511);
+    electron->setCharge(i % 2 ? 1 : -1);
+  }
+
+  TTree tree("benchmark", "benchmark");
+  tree.SetDirectory(nullptr);
+  xAH::ElectronContainer filler("el", detailStr, 1e3, mc);
+  filler.setBranches(&tree);
+
+  return run(makeResult("el", detailStr, objects, events), electrons, objects, rnd,
+             [&](std::size_t i){ filler.FillElectron(electrons[i], nullptr); },
+             [&](){ filler.clear(); });
+}
@@ -27,6 +27,7 @@
 // package include(s):
 #include "xAODAnaHelpers/HelperFunctions.h"
 #include "xAODAnaHelpers/HLTJetGetter.h"
+#include "xAODAnaHelpers/TrigFeatureCache.h"
 #include "TrigConfxAOD/xAODConfigTool.h"
 #include "TrigDecisionTool/TrigDecisionTool.h"
 
@@ -119,6 +120,9 @@ EL::StatusCode HLTJetGetter :: initialize ()
 
 EL::StatusCode HLTJetGetter :: execute ()
 {
+  auto event = beginEvent();
+  auto timer = timeExecute();
+  if ( eventRejected() ) return EL::StatusCode::SUCCESS;
     ANA_MSG_DEBUG( "Getting HLT jets... ");
 
     //
@@ -128,12 +132,8 @@ EL::StatusCode HLTJetGetter :: execute ()
     xAOD::JetAuxContainer*  hltJetsAux = new xAOD::JetAuxContainer();
     hltJets->setStore( hltJetsAux ); //< Connect the two
 
-    //Retrieving jets via trigger decision tool:
-    const Trig::ChainGroup * chainGroup = m_trigDecTool_handle->getChainGroup(m_triggerList); //Trigger list:
-    
-    std::vector<std::string> trigger_list = chainGroup->getListOfTriggers();
-
-    auto chainFeatures = chainGroup->features(); //Gets features associated to chain defined above
+    //Retrieving jets via trigger decision tool, shared with the other HLT algorithms asking for the same chains:
+    const Trig::FeatureContainer& chainFeatures = xAH::TrigFeatureCache::features(wk(), m_trigDecTool_handle.get(), m_triggerList); //Gets features associated to the trigger list
 
     auto JetFeatureContainers = chainFeatures.containerFeature<xAOD::JetContainer>(m_inContainerName.c_str());
 
@@ -157,6 +157,8 @@ EL::StatusCode HLTJetGetter :: execute ()
 
 EL::StatusCode HLTJetGetter :: postExecute ()
 {
+  auto timer = timePostExecute();
+  if ( eventRejected() ) return EL::StatusCode::SUCCESS;
     ANA_MSG_DEBUG( "Calling postExecute");
     return EL::StatusCode::SUCCESS;
 }
@@ -8,7 +8,11 @@
  ******************************************/
 
 // c++ include(s):
+#include <algorithm>
+#include <cmath>
 #include <iostream>
+#include <unordered_map>
+#include <unordered_set>
 #include <vector>
 
 // EL include(s):
@@ -31,10 +35,57 @@
 // package include(s):
 #include "xAODAnaHelpers/HelperFunctions.h"
 #include "xAODAnaHelpers/HLTJetRoIBuilder.h"
+#include "xAODAnaHelpers/TrigFeatureCache.h"
 
 #include "TrigConfxAOD/xAODConfigTool.h"
 #include "TrigDecisionTool/TrigDecisionTool.h"
 
+namespace {
+
+  /// the jets already in the output, bucketed in (eta, phi) cells of the overlap distance so that only the 3x3 cells around a jet need to be compared
+  class JetCellIndex {
+    public:
+      explicit JetCellIndex(double cellSize) :
+        m_cellSize(cellSize),
+        m_nPhi(std::max(1, static_cast<int>(2*M_PI/cellSize)))
+      { }
+
+      void insert(const xAOD::Jet* jet){
+        m_cells[cellKey(etaCell(jet->eta()), phiCell(jet->phi()))].push_back(jet);
+      }
+
+      /// call f(previousJet) for the jets which may be within one cell size of jet, all those which are are included
+      template <typename F>
+      void forNeighbours(const xAOD::Jet* jet, F f) const {
+        const int iEta = etaCell(jet->eta());
+        const int iPhi = phiCell(jet->phi());
+        for(int dEta = -1; dEta <= 1; ++dEta){
+          for(int dPhi = -1; dPhi <= 1; ++dPhi){
+            // with fewer than three phi cells the neighbours are the same cell again
+            if(m_nPhi < 3 && dPhi != 0) continue;
+            auto it = m_cells.find(cellKey(iEta+dEta, (iPhi+dPhi+m_nPhi) % m_nPhi));
+            if(it == m_cells.end()) continue;
+            for(const xAOD::Jet* previousJet : it->second) f(previousJet);
+          }
+        }
+      }
+
+    private:
+      long long cellKey(int iEta, int iPhi) const { return static_cast<long long>(iEta)*m_nPhi + iPhi; }
+      int etaCell(double eta) const { return static_cast<int>(std::floor(eta/m_cellSize)); }
+      int phiCell(double phi) const {
+        // the phi cells are at least as wide as the cell size, and cover [-pi, pi) exactly
+        const int iPhi = static_cast<int>(std::floor((phi + M_PI) / (2*M_PI) * m_nPhi));
+        return ((iPhi % m_nPhi) + m_nPhi) % m_nPhi;
+      }
+
+      double m_cellSize;
+      int m_nPhi;
+      std::unordered_map<long long, std::vector<const xAOD::Jet*> > m_cells;
+  };
+
+}
+
 // this is needed to distribute the algorithm to the workers
 ClassImp(HLTJetRoIBuilder)
 
@@ -123,12 +174,20 @@ EL::StatusCode HLTJetRoIBuilder :: initialize ()
   ANA_MSG_INFO("\tm_vtxName: " << m_vtxName);
   ANA_MSG_INFO("\tm_jetName: " << m_jetName);
 
+  // the output jets live here across events, each event only a view of those in use is recorded
+  m_hltJetPool.reset(new xAOD::JetContainer());
+  m_hltJetPoolAux.reset(new xAOD::JetAuxContainer());
+  m_hltJetPool->setStore( m_hltJetPoolAux.get() );
+
   return EL::StatusCode::SUCCESS;
 }
 
 
 EL::StatusCode HLTJetRoIBuilder :: execute ()
 {
+  auto event = beginEvent();
+  auto timer = timeExecute();
+  if ( eventRejected() ) return EL::StatusCode::SUCCESS;
   ANA_MSG_DEBUG( "Doing HLT JEt ROI Building... ");
 
   if(m_doHLTBJet){
@@ -187,9 +246,9 @@ EL::StatusCode HLTJetRoIBuilder :: buildHLTBJets ()
   // Create the new container and its auxiliary store.
   //
   ANA_MSG_VERBOSE("Creating the new container ");
-  xAOD::JetContainer*     hltJets    = new xAOD::JetContainer();
-  xAOD::JetAuxContainer*  hltJetsAux = new xAOD::JetAuxContainer();
-  hltJets->setStore( hltJetsAux ); //< Connect the two
+  ConstDataVector<xAOD::JetContainer>* hltJets = new ConstDataVector<xAOD::JetContainer>(SG::VIEW_ELEMENTS);
+  hltJets->reserve( m_hltJetPool->size() );
+  std::size_t nPooledJets = 0;
 
   //
   //  For Adding Tracks to the Jet
@@ -227,7 +286,11 @@ EL::StatusCode HLTJetRoIBuilder :: buildHLTBJets ()
   //
   static SG::AuxElement::Decorator< const xAOD::BTagging* > hltBTagDecor( "HLTBTag" );
 
-  Trig::FeatureContainer fc = m_trigDecTool_handle->features(m_trigItemAfterVeto, TrigDefs::Physics );
+  // the same trigger jet shows up in many feature combinations, once built it is skipped right away
+  std::unordered_set<const xAOD::Jet*> builtHLTJets;
+  JetCellIndex builtJets(0.1);
+
+  const Trig::FeatureContainer& fc = xAH::TrigFeatureCache::features(wk(), m_trigDecTool_handle.get(), m_trigItemAfterVeto, TrigDefs::Physics );
   Trig::FeatureContainer::combination_const_iterator comb   (fc.getCombinations().begin());
   Trig::FeatureContainer::combination_const_iterator combEnd(fc.getCombinations().end());
   ANA_MSG_VERBOSE( m_name << " New Event --------------- ");
@@ -338,8 +401,13 @@ EL::StatusCode HLTJetRoIBuilder :: buildHLTBJets ()
       const xAOD::Jet* hlt_jet = getTrigObject<xAOD::Jet, xAOD::JetContainer>(jetCollections.at(ifeat));
       if(!hlt_jet) continue;
 
+      if(builtHLTJets.count(hlt_jet)){
+	ANA_MSG_VERBOSE(" Jet already built " );
+	continue;
+      }
+
       bool passOverlap = true;
-      for( const xAOD::Jet* previousJet : *hltJets){
+      builtJets.forNeighbours(hlt_jet, [&](const xAOD::Jet* previousJet){
 	if(previousJet->p4().DeltaR(hlt_jet->p4()) < 0.1){
 	  const xAOD::BTagging *p_btag_info = previousJet->auxdata< const xAOD::BTagging* >("HLTBTag");
 	  double p_mv2c10 = -99;
@@ -358,7 +426,7 @@ EL::StatusCode HLTJetRoIBuilder :: buildHLTBJets ()
 	  }
 	  passOverlap = false;
 	}
-      }
+      });
 
       if(!passOverlap){
 	ANA_MSG_VERBOSE(" Jet Failed overlap " );
@@ -375,8 +443,7 @@ EL::StatusCode HLTJetRoIBuilder :: buildHLTBJets ()
 	if(!hlt_tracks) continue;
       }
 
-      xAOD::Jet* newHLTBJet = new xAOD::Jet();
-      newHLTBJet->makePrivateStore( hlt_jet );
+      xAOD::Jet* newHLTBJet = nextPooledJet( nPooledJets, hlt_jet );
 
       //
       // Add Link to BTagging Info
@@ -480,6 +547,8 @@ EL::StatusCode HLTJetRoIBuilder :: buildHLTBJets ()
       }
 
       hltJets->push_back( newHLTBJet );
+      builtJets.insert( newHLTBJet );
+      builtHLTJets.insert( hlt_jet );
       ANA_MSG_VERBOSE("pushed back ");
 
     }//feature
@@ -489,7 +558,6 @@ EL::StatusCode HLTJetRoIBuilder :: buildHLTBJets ()
   }// Combinations
 
   ANA_CHECK( m_store->record( hltJets,    m_outContainerName));
-  ANA_CHECK( m_store->record( hltJetsAux, m_outContainerName+"Aux."));
 
   return EL::StatusCode::SUCCESS;
 }
@@ -502,11 +570,11 @@ EL::StatusCode HLTJetRoIBuilder :: buildHLTJets ()
   //
   // Create the new container and its auxiliary store.
   //
-  xAOD::JetContainer*     hltJets    = new xAOD::JetContainer();
-  xAOD::JetAuxContainer*  hltJetsAux = new xAOD::JetAuxContainer();
-  hltJets->setStore( hltJetsAux ); //< Connect the two
+  ConstDataVector<xAOD::JetContainer>* hltJets = new ConstDataVector<xAOD::JetContainer>(SG::VIEW_ELEMENTS);
+  hltJets->reserve( m_hltJetPool->size() );
+  std::size_t nPooledJets = 0;
 
-  Trig::FeatureContainer fc = m_trigDecTool_handle->features(m_trigItem);
+  const Trig::FeatureContainer& fc = xAH::TrigFeatureCache::features(wk(), m_trigDecTool_handle.get(), m_trigItem);
   auto jetFeatureContainers = fc.containerFeature<xAOD::JetContainer>();
 
   ANA_MSG_VERBOSE("ncontainers  " << jetFeatureContainers.size());
@@ -516,23 +584,35 @@ EL::StatusCode HLTJetRoIBuilder :: buildHLTJets ()
   for(auto  jcont : jetFeatureContainers) {
     for (const xAOD::Jet*  hlt_jet : *jcont.cptr()) {
 
-      xAOD::Jet* newHLTJet = new xAOD::Jet();
-      newHLTJet->makePrivateStore( hlt_jet );
+      xAOD::Jet* newHLTJet = nextPooledJet( nPooledJets, hlt_jet );
 
       hltJets->push_back( newHLTJet );
     }
   }
 
   ANA_CHECK( m_store->record( hltJets,    m_outContainerName));
-  ANA_CHECK( m_store->record( hltJetsAux, m_outContainerName+"Aux."));
   ANA_MSG_VERBOSE("Left buildHLTJets  ");
   return EL::StatusCode::SUCCESS;
 }
 
 
 
+xAOD::Jet* HLTJetRoIBuilder :: nextPooledJet (std::size_t& nUsed, const xAOD::Jet* source)
+{
+  if(nUsed == m_hltJetPool->size()) m_hltJetPool->push_back( new xAOD::Jet() );
+
+  // copies all of the aux data of the trigger jet, overwriting whatever the pooled jet held in a previous event
+  xAOD::Jet* jet = m_hltJetPool->at(nUsed++);
+  *jet = *source;
+  return jet;
+}
+
+
+
 EL::StatusCode HLTJetRoIBuilder :: postExecute ()
 {
+  auto timer = timePostExecute();
+  if ( eventRejected() ) return EL::StatusCode::SUCCESS;
   ANA_MSG_DEBUG( "Calling postExecute");
   return EL::StatusCode::SUCCESS;
 }
@@ -2,6 +2,7 @@
 #include <iostream>
 #include <exception>
 #include <sstream>
+#include <algorithm>
 
 // EDM include(s):
 #include "xAODBTagging/BTagging.h"
@@ -17,11 +18,14 @@
 // package include(s):
 #include <xAODAnaHelpers/HelperFunctions.h>
 #include <xAODAnaHelpers/HelpTreeBase.h>
+#include <xAODAnaHelpers/TriggerDictionary.h>
 #include <AsgTools/MessageCheck.h>
 
 
 #include "AsgTools/StatusCode.h"
 
+#include "TObjString.h"
+
 using std::vector;
 
 // needed? should it be here?
@@ -33,6 +37,7 @@ HelpTreeBase::HelpTreeBase(xAOD::TEvent* event, TTree* tree, TFile* file, const
   m_trigInfoSwitch(nullptr),
   m_trigConfTool(nullptr),
   m_trigDecTool(nullptr),
+  m_triggerDictionary(nullptr),
   m_eventInfo(nullptr)
 {
 
@@ -44,6 +49,7 @@ HelpTreeBase::HelpTreeBase(xAOD::TEvent* event, TTree* tree, TFile* file, const
   m_nominalTree = strcmp(m_tree->GetName(), nominalTreeName.c_str()) == 0;
   m_event = event;
   m_store = store;
+  m_objectUserHooks = true;
   Info("HelpTreeBase()", "HelpTreeBase setup");
 
   // turn things off it this is data...since TStore is not a needed input
@@ -118,6 +124,22 @@ HelpTreeBase::HelpTreeBase(TTree* tree, TFile* file, xAOD::TEvent* event, xAOD::
 
 
 void HelpTreeBase::Fill() {
+  // the truth links can only be resolved once the whole truth block is filled
+  for(auto& truth : m_truth)             truth.second->resolveLinks();
+
+  // round the branches booked with reduced precision, now that the event is complete
+  for(auto& jets : m_jets)               jets.second->reducePrecision();
+  for(auto& l1Jets : m_l1Jets)           l1Jets.second->reducePrecision();
+  for(auto& truth : m_truth)             truth.second->reducePrecision();
+  for(auto& tracks : m_tracks)           tracks.second->reducePrecision();
+  for(auto& fatjets : m_fatjets)         fatjets.second->reducePrecision();
+  for(auto& fatjets : m_truth_fatjets)   fatjets.second->reducePrecision();
+  for(auto& muons : m_muons)             muons.second->reducePrecision();
+  for(auto& elecs : m_elecs)             elecs.second->reducePrecision();
+  for(auto& photons : m_photons)         photons.second->reducePrecision();
+  for(auto& clusters : m_clusters)       clusters.second->reducePrecision();
+  for(auto& taus : m_taus)               taus.second->reducePrecision();
+
   // code_or_nbytes is the number of bytes written, or -1 if an error occured
   const int code_or_nbytes = m_tree->Fill();
   if(code_or_nbytes < 0) // 0 can be OK if all branches are disabled and thus no data is written
@@ -202,6 +224,17 @@ void HelpTreeBase::AddTrigger( const std::string& detailStr ) {
     m_tree->Branch("isPassBitsNames",      &m_isPassBitsNames     );
   }
 
+  // Passed and disabled triggers as bits against a dictionary stored once with the tree
+  if ( m_trigInfoSwitch->m_passTriggersMask ) {
+    m_tree->Branch("passedTriggersMask",   &m_passedTriggersMask  );
+    m_tree->Branch("disabledTriggersMask", &m_disabledTriggersMask);
+    // owned by the user info list of the tree
+    m_triggerDictionary = new TList();
+    m_triggerDictionary->SetName("triggerDictionary");
+    m_triggerDictionary->SetOwner(kTRUE);
+    m_tree->GetUserInfo()->Add(m_triggerDictionary);
+  }
+
   this->AddTriggerUser( detailStr );
 }
 
@@ -252,18 +285,24 @@ void HelpTreeBase::FillTrigger( const xAOD::EventInfo* eventInfo ) {
   if ( m_trigInfoSwitch->m_passTriggers ) {
 
     if ( m_debug ) { Info("HelpTreeBase::FillTrigger()", "Switch: m_trigInfoSwitch->m_passTriggers"); }
-    static SG::AuxElement::ConstAccessor< std::vector< std::string > > acc_passedTriggers  ("passedTriggers");
-    if( acc_passedTriggers  .isAvailable( *eventInfo ) ) { m_passedTriggers   = acc_passedTriggers  ( *eventInfo ); }
-    static SG::AuxElement::ConstAccessor< std::vector< std::string > > acc_disabledTriggers("disabledTriggers");
-    if( acc_disabledTriggers.isAvailable( *eventInfo ) ) { m_disabledTriggers = acc_disabledTriggers( *eventInfo ); }
+    readTriggerNames( eventInfo, m_passedTriggersAcc,   m_passedTriggers   );
+    readTriggerNames( eventInfo, m_disabledTriggersAcc, m_disabledTriggers );
+  }
+
+  if ( m_trigInfoSwitch->m_passTriggersMask ) {
+
+    if ( m_debug ) { Info("HelpTreeBase::FillTrigger()", "Switch: m_trigInfoSwitch->m_passTriggersMask"); }
+    std::vector<std::string> chains;
+    if( readTriggerNames( eventInfo, m_passedTriggersAcc,   chains ) ) { fillTriggerMask( chains, m_passedTriggersMask   ); }
+    chains.clear();
+    if( readTriggerNames( eventInfo, m_disabledTriggersAcc, chains ) ) { fillTriggerMask( chains, m_disabledTriggersMask ); }
   }
 
   if ( !m_isMC && m_trigInfoSwitch->m_prescales ) {
 
     if ( m_debug ) { Info("HelpTreeBase::FillTrigger()", "Switch: m_trigInfoSwitch->m_prescales"); }
 
-    static SG::AuxElement::ConstAccessor< std::vector< float > > trigPrescales("triggerPrescales");
-    if( trigPrescales.isAvailable( *eventInfo ) ) { m_triggerPrescales = trigPrescales( *eventInfo ); }
+    readTriggerPrescales( eventInfo, m_triggerPrescalesAcc, m_triggerPrescales );
 
   }
 
@@ -271,8 +310,7 @@ void HelpTreeBase::FillTrigger( const xAOD::EventInfo* eventInfo ) {
 
     if ( m_debug ) { Info("HelpTreeBase::FillTrigger()", "Switch: m_trigInfoSwitch->m_prescalesLumi"); }
 
-    static SG::AuxElement::ConstAccessor< std::vector< float > > trigPrescalesLumi("triggerPrescalesLumi");
-    if( trigPrescalesLumi.isAvailable( *eventInfo ) ) { m_triggerPrescalesLumi = trigPrescalesLumi( *eventInfo ); }
+    readTriggerPrescales( eventInfo, m_triggerPrescalesLumiAcc, m_triggerPrescalesLumi );
 
   }
 
@@ -282,7 +320,10 @@ void HelpTreeBase::FillTrigger( const xAOD::EventInfo* eventInfo ) {
     if( isPassBits.isAvailable( *eventInfo ) ) { m_isPassBits = isPassBits( *eventInfo ); }
 
     static SG::AuxElement::ConstAccessor< std::vector< std::string > > isPassBitsNames("isPassedBitsNames");
+    static SG::AuxElement::ConstAccessor< unsigned int > triggerDictionaryID("triggerDictionaryID");
     if( isPassBitsNames.isAvailable( *eventInfo ) ) { m_isPassBitsNames = isPassBitsNames( *eventInfo ); }
+    // isPassedBits has one entry per chain of the dictionary
+    else if( triggerDictionaryID.isAvailable( *eventInfo ) ) { m_isPassBitsNames = xAH::TriggerDictionary::chains( triggerDictionaryID( *eventInfo ) ); }
 
   }
   
@@ -305,6 +346,56 @@ void HelpTreeBase::ClearTrigger() {
   m_triggerPrescalesLumi.clear();
   m_isPassBits.clear();
   m_isPassBitsNames.clear();
+  m_passedTriggersMask.clear();
+  m_disabledTriggersMask.clear();
+
+}
+
+bool HelpTreeBase::readTriggerNames( const xAOD::EventInfo* eventInfo, const TriggerNamesAccessors& acc, std::vector<std::string>& chains ) {
+
+  if ( acc.names.isAvailable( *eventInfo ) ) {
+    chains = acc.names( *eventInfo );
+    return true;
+  }
+
+  // packed form of BasicEventSelection, e.g. passedTriggersBits for passedTriggers
+  static SG::AuxElement::ConstAccessor< unsigned int > triggerDictionaryID("triggerDictionaryID");
+  if ( triggerDictionaryID.isAvailable( *eventInfo ) && acc.bits.isAvailable( *eventInfo ) ) {
+    xAH::TriggerDictionary::unpack( triggerDictionaryID( *eventInfo ), acc.bits( *eventInfo ), chains );
+    return true;
+  }
+
+  return false;
+}
+
+bool HelpTreeBase::readTriggerPrescales( const xAOD::EventInfo* eventInfo, const TriggerPrescalesAccessors& acc, std::vector<float>& prescales ) {
+
+  if ( acc.prescales.isAvailable( *eventInfo ) ) {
+    prescales = acc.prescales( *eventInfo );
+    return true;
+  }
+
+  // the packed form has the prescales of all chains, keep those of the passed ones
+  if ( m_passedTriggersAcc.bits.isAvailable( *eventInfo ) && acc.all.isAvailable( *eventInfo ) ) {
+    xAH::TriggerDictionary::select( m_passedTriggersAcc.bits( *eventInfo ), acc.all( *eventInfo ), prescales );
+    return true;
+  }
+
+  return false;
+}
+
+void HelpTreeBase::fillTriggerMask(const std::vector<std::string>& chains, std::vector<ULong64_t>& mask) {
+
+  for ( const auto& chain : chains ) {
+    auto it = m_triggerIndex.find(chain);
+    if ( it == m_triggerIndex.end() ) {
+      it = m_triggerIndex.emplace(chain, m_triggerIndex.size()).first;
+      m_triggerDictionary->Add(new TObjString(chain.c_str()));
+    }
+    const unsigned int word = it->second / 64;
+    if ( mask.size() <= word ) mask.resize(word+1, 0);
+    mask[word] |= ULong64_t(1) << (it->second % 64);
+  }
 
 }
 
@@ -419,9 +510,11 @@ void HelpTreeBase::FillMuons( const xAOD::MuonContainer* muons, const xAOD::Vert
 
   }
 
+  const std::size_t begin = m_muons[muonName]->m_n;
   for( auto muon_itr : *muons ) {
     this->FillMuon(muon_itr, primaryVertex, muonName);
   }
+  this->FillMuonsUserBatch(muons, begin, m_muons[muonName]->m_n, muonName, primaryVertex);
 
 }
 
@@ -431,7 +524,7 @@ void HelpTreeBase::FillMuon( const xAOD::Muon* muon, const xAOD::Vertex* primary
 
   thisMuon->FillMuon(muon, primaryVertex);
 
-  this->FillMuonsUser(muon, muonName, primaryVertex);
+  if ( m_objectUserHooks ) this->FillMuonsUser(muon, muonName, primaryVertex);
 
   return;
 }
@@ -498,9 +591,11 @@ void HelpTreeBase::FillElectrons( const xAOD::ElectronContainer* electrons, cons
 
   this->ClearElectrons(elecName);
 
+  const std::size_t begin = m_elecs[elecName]->m_n;
   for ( auto el_itr : *electrons ) {
     this->FillElectron(el_itr, primaryVertex, elecName);
   }
+  this->FillElectronsUserBatch(electrons, begin, m_elecs[elecName]->m_n, elecName, primaryVertex);
 }
 
 void HelpTreeBase::FillElectron ( const xAOD::Electron* elec, const xAOD::Vertex* primaryVertex, const std::string& elecName ) {
@@ -509,7 +604,7 @@ void HelpTreeBase::FillElectron ( const xAOD::Electron* elec, const xAOD::Vertex
 
   thisElec->FillElectron(elec, primaryVertex);
 
-  this->FillElectronsUser(elec, elecName, primaryVertex);
+  if ( m_objectUserHooks ) this->FillElectronsUser(elec, elecName, primaryVertex);
 
   return;
 }
@@ -546,9 +641,11 @@ void HelpTreeBase::FillPhotons( const xAOD::PhotonContainer* photons, const std:
 
   this->ClearPhotons(photonName);
 
+  const std::size_t begin = m_photons[photonName]->m_n;
   for ( auto ph_itr : *photons ) {
     this->FillPhoton(ph_itr, photonName);
   }
+  this->FillPhotonsUserBatch(photons, begin, m_photons[photonName]->m_n, photonName);
 }
 
 void HelpTreeBase::FillPhoton( const xAOD::Photon* photon, const std::string& photonName ) {
@@ -557,7 +654,7 @@ void HelpTreeBase::FillPhoton( const xAOD::Photon* photon, const std::string& ph
 
   thisPhoton->FillPhoton(photon);
 
-  this->FillPhotonsUser(photon, photonName);
+  if ( m_objectUserHooks ) this->FillPhotonsUser(photon, photonName);
 
   return;
 }
@@ -594,9 +691,14 @@ void HelpTreeBase::FillClusters( const xAOD::CaloClusterContainer* clusters, con
 
   this->ClearClusters(clusterName);
 
+  // only the clusters passing the ptMin and NLeading options of the detail string
+  clusters = m_clusters[clusterName]->select(clusters);
+
+  const std::size_t begin = m_clusters[clusterName]->m_n;
   for ( auto cl_itr : *clusters ) {
     this->FillCluster(cl_itr, clusterName);
   }
+  this->FillClustersUserBatch(clusters, begin, m_clusters[clusterName]->m_n, clusterName);
 }
 
 void HelpTreeBase::FillCluster( const xAOD::CaloCluster* cluster, const std::string& clusterName ) {
@@ -605,7 +707,7 @@ void HelpTreeBase::FillCluster( const xAOD::CaloCluster* cluster, const std::str
 
   thisCluster->FillCluster(cluster);
 
-  this->FillClustersUser(cluster, clusterName);
+  if ( m_objectUserHooks ) this->FillClustersUser(cluster, clusterName);
 
   return;
 }
@@ -688,13 +790,19 @@ void HelpTreeBase::FillJets( const xAOD::JetContainer* jets, int pvLocation, con
 
   if( thisJet->m_infoSwitch.m_trackPV || thisJet->m_infoSwitch.m_allTrack ) {
     HelperFunctions::retrieve( vertices, m_vertexContainerName, m_event, 0);
+    // cheap, the location is cached per event on the vertex container
     pvLocation = HelperFunctions::getPrimaryVertexLocation( vertices );
     if ( pvLocation >= 0 ) pv = vertices->at( pvLocation );
   }
 
+  // the plain jet moments are read column-wise if the container allows it
+  thisJet->fillPlannedBulk(jets);
+
+  const std::size_t begin = thisJet->m_n;
   for( auto jet_itr : *jets ) {
     this->FillJet(jet_itr, pv, pvLocation, jetName);
   }
+  this->FillJetsUserBatch(jets, begin, thisJet->m_n, jetName);
 
 }
 
@@ -706,7 +814,7 @@ void HelpTreeBase::FillJet( const xAOD::Jet* jet_itr, const xAOD::Vertex* pv, in
 
   thisJet->FillJet(jet_itr, pv, pvLocation);
 
-  this->FillJetsUser(jet_itr, jetName);
+  if ( m_objectUserHooks ) this->FillJetsUser(jet_itr, jetName);
 
   return;
 }
@@ -800,7 +908,12 @@ void HelpTreeBase::FillTracks( const xAOD::TrackParticleContainer* trackParts, c
   // float trackparticle_ptmin  = 1.0;
   // float trackparticle_etamax = 8.0;
 
-  for( auto track_itr : *trackParts ) {
+  std::vector<const xAOD::TrackParticle*> tracks(trackParts->begin(), trackParts->end());
+  if ( m_tracks[trackName]->m_infoSwitch.m_sortZ0 ) {
+    std::stable_sort( tracks.begin(), tracks.end(), [](const xAOD::TrackParticle* a, const xAOD::TrackParticle* b){ return a->z0() < b->z0(); } );
+  }
+
+  for( auto track_itr : tracks ) {
 
     // if((track_itr->pt() / m_units < trackparticle_ptmin) || (fabs(track_itr->eta()) > trackparticle_etamax) ){
     //  continue;
@@ -875,12 +988,17 @@ void HelpTreeBase::FillFatJets( const xAOD::JetContainer* fatJets , int pvLocati
 
   this->ClearFatJets(fatjetName, suffix);
 
+  xAH::FatJetContainer* thisFatJet = m_fatjets[FatJetCollectionName(fatjetName, suffix)];
+  const std::size_t begin = thisFatJet->m_n;
+
   for( auto fatjet_itr : *fatJets ) {
 
     this->FillFatJet(fatjet_itr, pvLocation, fatjetName, suffix);
 
   } // loop over fat jets
 
+  this->FillFatJetsUserBatch(fatJets, begin, thisFatJet->m_n, pvLocation, fatjetName, suffix);
+
 }
 
 void HelpTreeBase::FillFatJet( const xAOD::Jet* fatjet_itr, int pvLocation, const std::string& fatjetName, const std::string& suffix ) {
@@ -890,7 +1008,7 @@ void HelpTreeBase::FillFatJet( const xAOD::Jet* fatjet_itr, int pvLocation, cons
 
   thisFatJet->FillFatJet(fatjet_itr, pvLocation);
 
-  this->FillFatJetsUser(fatjet_itr, pvLocation, fatjetName, suffix);
+  if ( m_objectUserHooks ) this->FillFatJetsUser(fatjet_itr, pvLocation, fatjetName, suffix);
 
   return;
 }
@@ -964,9 +1082,11 @@ void HelpTreeBase::FillTaus( const xAOD::TauJetContainer* taus, const std::strin
 
   this->ClearTaus();
 
+  const std::size_t begin = m_taus[tauName]->m_n;
   for( auto tau_itr : *taus ) {
     this->FillTau(tau_itr, tauName);
   }
+  this->FillTausUserBatch(taus, begin, m_taus[tauName]->m_n, tauName);
 }
 
 void HelpTreeBase::FillTau( const xAOD::TauJet* tau, const std::string& tauName ) {
@@ -975,7 +1095,7 @@ void HelpTreeBase::FillTau( const xAOD::TauJet* tau, const std::string& tauName
 
   thisTau->FillTau(tau);
 
-  this->FillTausUser(tau, tauName);
+  if ( m_objectUserHooks ) this->FillTausUser(tau, tauName);
 }
 
 void HelpTreeBase::ClearTaus(const std::string& tauName) {
@@ -1027,6 +1147,35 @@ void HelpTreeBase::ClearMET( const std::string& metName ) {
   this->ClearMETUser(metName);
 }
 
+/*********************
+ *
+ *   COPY FROM ANOTHER TREE
+ *
+ ********************/
+
+bool HelpTreeBase::CopyMuons( const HelpTreeBase& nominal, const std::string& muonName ) {
+  return copyCollection( m_muons, nominal.m_muons, muonName );
+}
+
+bool HelpTreeBase::CopyElectrons( const HelpTreeBase& nominal, const std::string& elecName ) {
+  return copyCollection( m_elecs, nominal.m_elecs, elecName );
+}
+
+bool HelpTreeBase::CopyPhotons( const HelpTreeBase& nominal, const std::string& photonName ) {
+  return copyCollection( m_photons, nominal.m_photons, photonName );
+}
+
+bool HelpTreeBase::CopyJets( const HelpTreeBase& nominal, const std::string& jetName ) {
+  return copyCollection( m_jets, nominal.m_jets, jetName );
+}
+
+bool HelpTreeBase::CopyFatJets( const HelpTreeBase& nominal, const std::string& fatjetName, const std::string& suffix ) {
+  return copyCollection( m_fatjets, nominal.m_fatjets, FatJetCollectionName(fatjetName, suffix) );
+}
+
+bool HelpTreeBase::CopyTaus( const HelpTreeBase& nominal, const std::string& tauName ) {
+  return copyCollection( m_taus, nominal.m_taus, tauName );
+}
 
 bool HelpTreeBase::writeTo( TFile* file ) {
   file->cd(); // necessary?
@@ -91,9 +91,21 @@ namespace HelperClasses{
     std::string SiliconAssociatedForwardMuon("SiliconAssociatedForwardMuon");   enumMap.insert(std::make_pair(SiliconAssociatedForwardMuon , xAOD::Muon::SiliconAssociatedForwardMuon));
   }
 
+  bool InfoSwitch::has_match(const std::string flag) {
+    bool found(false);
+    for (const auto& configDetail : m_configDetails) {
+      if (configDetail.find(flag) != std::string::npos) {
+        m_usedDetails.insert(configDetail);
+        found = true;
+      }
+    }
+    return found;
+  }
+
   std::string InfoSwitch::get_working_point(const std::string flag) {
     for (auto configDetail : m_configDetails) {
       if (configDetail.compare(0, flag.size(), flag) == 0) {
+        m_usedDetails.insert(configDetail);
         return configDetail.substr(flag.size(), std::string::npos);
       }
     }
@@ -104,12 +116,50 @@ namespace HelperClasses{
     std::vector<std::string> wps;
     for (auto configDetail : m_configDetails) {
       if (configDetail.compare(0, flag.size(), flag) == 0) {
+        m_usedDetails.insert(configDetail);
         wps.push_back(configDetail.substr(flag.size(), std::string::npos));
       }
     }
     return wps;
   }
 
+  std::vector<std::string> InfoSwitch::unknownDetails() const {
+    std::vector<std::string> unknown;
+    for (const auto& configDetail : m_configDetails) {
+      if (configDetail.empty()) continue;
+      if (m_usedDetails.find(configDetail) == m_usedDetails.end()) unknown.push_back(configDetail);
+    }
+    return unknown;
+  }
+
+  void InfoSwitch::parseFloatPrecision() {
+    // Float16:var1,var2 or Float16_N:var1,var2
+    for (const auto& configDetail : m_configDetails) {
+      if (configDetail.compare(0, 7, "Float16") != 0) continue;
+      const std::size_t colon = configDetail.find(':');
+      if (colon == std::string::npos) continue;
+
+      unsigned int bits = 12;
+      if (configDetail[7] == '_') bits = std::atoi( configDetail.substr(8, colon-8).c_str() );
+      else if (colon != 7) continue;
+
+      std::string varName;
+      std::istringstream ss(configDetail.substr(colon+1));
+      while ( std::getline(ss, varName, ',') )
+        if (!varName.empty()) m_floatPrecision.emplace_back(varName, bits);
+      markUsed(configDetail);
+    }
+  }
+
+  unsigned int InfoSwitch::floatPrecision(const std::string& varName) const {
+    for (const auto& precision : m_floatPrecision) {
+      const std::string& pattern = precision.first;
+      if (pattern == varName) return precision.second;
+      if (pattern.back() == '*' && varName.compare(0, pattern.size()-1, pattern, 0, pattern.size()-1) == 0) return precision.second;
+    }
+    return 0;
+  }
+
   /*
             !!!!!!!!!!!!!WARNING!!!!!!!!!!!!!
               If you change the string here,
@@ -130,12 +180,14 @@ namespace HelperClasses{
     m_truth         = has_exact("truth");
     m_caloClus      = has_exact("caloClusters");
     m_weightsSys    = has_exact("weightsSys");
+    m_weightsArray  = has_exact("weightsArray");
   }
 
   void TriggerInfoSwitch::initialize(){
     m_basic             = has_exact("basic");
     m_menuKeys          = has_exact("menuKeys");
     m_passTriggers      = has_exact("passTriggers");
+    m_passTriggersMask  = has_exact("passTriggersMask");
     m_passTrigBits      = has_exact("passTrigBits");
     m_prescales         = has_exact("prescales");
     m_prescalesLumi     = has_exact("prescalesLumi");
@@ -150,16 +202,19 @@ namespace HelperClasses{
       {
 	if( configDetail.compare(0,8,"NLeading")==0)
 	  {
+	    markUsed(configDetail);
 	    m_numLeading = std::atoi( configDetail.substr(8, std::string::npos).c_str() );
 	    break;
 	  }
       }
 
     m_useTheS   = has_exact("useTheS");
+    m_selectionFlags = has_exact("selectionFlags");
   }
 
   void MuonInfoSwitch::initialize(){
     m_trigger       = has_exact("trigger");
+    m_triggerBits   = has_exact("triggerBits");
     m_isolation     = has_exact("isolation");
     m_isolationKinematics = has_exact("isolationKinematics");
     m_quality       = has_exact("quality");
@@ -188,6 +243,7 @@ namespace HelperClasses{
       } else if(trig_substr != std::string::npos){
         m_trigWPs.push_back(token.substr(5));
       }
+      if( reco_substr != std::string::npos || isol_substr != std::string::npos || trig_substr != std::string::npos ) markUsed(token);
     }
 
     // passSel
@@ -204,6 +260,7 @@ namespace HelperClasses{
 
   void ElectronInfoSwitch::initialize(){
     m_trigger       = has_exact("trigger");
+    m_triggerBits   = has_exact("triggerBits");
     m_isolation     = has_exact("isolation");
     m_isolationKinematics = has_exact("isolationKinematics");
     m_quality       = has_exact("quality");
@@ -241,6 +298,7 @@ namespace HelperClasses{
       } else if(trig_substr != std::string::npos){
         m_trigWPs.push_back(token.substr(5));
       }
+      if( pid_substr != std::string::npos || pidsf_substr != std::string::npos || isol_substr != std::string::npos || trig_substr != std::string::npos ) markUsed(token);
     }
 
     // passSel
@@ -259,6 +317,16 @@ namespace HelperClasses{
   }
 
   void ClusterInfoSwitch::initialize(){
+    m_ptMin = 0;
+    for(auto configDetail : m_configDetails)
+      {
+	if( configDetail.compare(0,5,"ptMin")==0)
+	  {
+	    markUsed(configDetail);
+	    m_ptMin = std::atof( configDetail.substr(5, std::string::npos).c_str() );
+	    break;
+	  }
+      }
   }
 
   void JetInfoSwitch::initialize(){
@@ -290,12 +358,32 @@ namespace HelperClasses{
     m_allTrackPVSel = has_exact("allTrackPVSel");
     m_allTrackDetail= has_exact("allTrackDetail");
     m_muonCorrection= has_exact("muonCorrection");
+    m_flatArrays    = has_exact("flatArrays");
 
     if( m_allTrackDetail ) {
       m_allTrackPVSel = m_allTrackPVSel || has_exact("allTrackDetailPVSel") ;
     }
     m_constituent       = has_exact("constituent");
     m_constituentAll    = has_exact("constituentAll");
+
+    // constituentBits_N for all the constituent variables, constituentBits_<var>_N for one of them
+    m_constitWeightsBits = m_constitPtBits = m_constitEtaBits = m_constitPhiBits = m_constitEBits = 0;
+    std::map<std::string, unsigned int> constitBits;
+    for(const auto& setting : get_working_points("constituentBits_")) {
+      const std::size_t sep = setting.rfind('_');
+      const std::string var = sep == std::string::npos ? "" : setting.substr(0, sep);
+      constitBits[var] = std::atoi( setting.substr(sep == std::string::npos ? 0 : sep+1).c_str() );
+    }
+    const auto bits = [&constitBits](const std::string& var) -> unsigned int {
+      auto it = constitBits.find(var);
+      if(it == constitBits.end()) it = constitBits.find("");
+      return it == constitBits.end() ? 0 : it->second;
+    };
+    m_constitWeightsBits = bits("weights");
+    m_constitPtBits      = bits("pt");
+    m_constitEtaBits     = bits("eta");
+    m_constitPhiBits     = bits("phi");
+    m_constitEBits       = bits("e");
     m_flavorTag         = has_exact("flavorTag");
     m_flavorTagHLT      = has_exact("flavorTagHLT");
     m_btag_jettrk       = has_exact("btag_jettrk");
@@ -358,6 +446,7 @@ namespace HelperClasses{
 
     m_jetBTag.clear();
     m_jetBTagCts.clear();
+    has_match("jetBTag");
     tmpConfigStr=std::string(m_configStr);
     while( tmpConfigStr.find("jetBTag") != std::string::npos ) { // jetBTag
       // erase everything before the interesting string
@@ -417,6 +506,7 @@ namespace HelperClasses{
     m_dressed       = has_exact("dressed");
     m_origin        = has_exact("origin");
     m_particleType  = has_exact("particleType");
+    m_links         = has_exact("links");
   }
 
   void TrackInfoSwitch::initialize(){
@@ -426,6 +516,8 @@ namespace HelperClasses{
     m_numbers	    = has_exact("numbers");
     m_vertex	    = has_exact("vertex");
     m_useTheS       = has_exact("useTheS");
+    m_packedHits    = has_exact("packedHits");
+    m_sortZ0        = has_exact("sortZ0");
   }
 
   void TauInfoSwitch::initialize(){
@@ -452,6 +544,7 @@ namespace HelperClasses{
       } else if(trig_substr != std::string::npos){
         m_trigWPs.push_back(token.substr(5));
       }
+      if( taueff_substr != std::string::npos || trig_substr != std::string::npos ) markUsed(token);
     }
 
   }
@@ -2,6 +2,7 @@
 #include <AsgTools/MessageCheck.h>
 
 #include "xAODBase/IParticleContainer.h"
+#include "AthContainersInterfaces/IConstAuxStore.h"
 
 // samples
 #include <SampleHandler/SampleGrid.h>
@@ -16,6 +17,16 @@
 #include <fastjet/tools/Filter.hh>
 #include <JetEDM/JetConstituentFiller.h>
 
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+#include <map>
+#include <memory>
+#include <set>
+#include <sstream>
+#include <tuple>
+#include <typeinfo>
+
 void xAH::addRucio(SH::SampleHandler& sh, const std::string& name, const std::string& dslist)
 {
   std::unique_ptr<SH::SampleGrid> sample(new SH::SampleGrid(name));
@@ -24,12 +35,24 @@ void xAH::addRucio(SH::SampleHandler& sh, const std::string& name, const std::st
   sh.add(sample.release());
 }
 
+namespace {
+  // one stream per thread, so that messages from helpers called in parallel do not interleave in the same buffer
+  MsgStream& threadMsgStream() {
+    static thread_local MsgStream msgStream( "HelperFunctions" );
+    return msgStream;
+  }
+}
+
 MsgStream& HelperFunctions::msg( MSG::Level lvl ) {
-  static MsgStream msgStream( "HelperFunctions" );
+  MsgStream& msgStream = threadMsgStream();
   msgStream << lvl;
   return msgStream;
 }
 
+bool HelperFunctions::msgLvl( MSG::Level lvl ) {
+  return threadMsgStream().level() <= lvl;
+}
+
 // Get Number of Vertices with at least Ntracks
 bool HelperFunctions::passPrimaryVertexSelection(const xAOD::VertexContainer* vertexContainer, int Ntracks)
 {
@@ -59,22 +82,34 @@ int HelperFunctions::countPrimaryVertices(const xAOD::VertexContainer* vertexCon
 
 int HelperFunctions::getPrimaryVertexLocation(const xAOD::VertexContainer* vertexContainer, MsgStream& msg)
 {
-  int location(0);
-
   if(vertexContainer == nullptr) {
     msg << MSG::DEBUG << "No primary vertex container was found! Returning -1" << endmsg;
     return -1;
   }
+  if(vertexContainer->empty()) {
+    msg << MSG::WARNING << "No primary vertex location was found! Returning -1" << endmsg;
+    return -1;
+  }
 
+  // the result is cached on the first vertex, so that the container is only scanned once per event
+  // no matter how many algorithms and output containers ask for it
+  static SG::AuxElement::Decorator<int> pvLocationDecor(primaryVertexLocationDecor);
+  const xAOD::Vertex* firstVertex = vertexContainer->front();
+  if(pvLocationDecor.isAvailable(*firstVertex)) return pvLocationDecor(*firstVertex);
+
+  int location(0);
   for( auto vtx_itr : *vertexContainer )
   {
-    if(vtx_itr->vertexType() == xAOD::VxType::VertexType::PriVtx) {
-      return location;
-    }
+    if(vtx_itr->vertexType() == xAOD::VxType::VertexType::PriVtx) { break; }
     location++;
   }
-  msg << MSG::WARNING << "No primary vertex location was found! Returning -1" << endmsg;
-  return -1;
+  if(location == static_cast<int>(vertexContainer->size())) {
+    msg << MSG::WARNING << "No primary vertex location was found! Returning -1" << endmsg;
+    location = -1;
+  }
+
+  pvLocationDecor(*firstVertex) = location;
+  return location;
 }
 
 bool HelperFunctions::applyPrimaryVertexSelection( const xAOD::JetContainer* jets, const xAOD::VertexContainer* vertices )
@@ -342,11 +377,9 @@ const xAOD::Vertex* HelperFunctions::getPrimaryVertex(const xAOD::VertexContaine
 
   // vertex types are listed on L328 of
   // https://svnweb.cern.ch/trac/atlasoff/browser/Event/xAOD/xAODTracking/trunk/xAODTracking/TrackingPrimitives.h
-  for( auto vtx_itr : *vertexContainer )
-  {
-    if(vtx_itr->vertexType() != xAOD::VxType::VertexType::PriVtx) { continue; }
-    return vtx_itr;
-  }
+  // the location is cached per event, see getPrimaryVertexLocation()
+  const int location = getPrimaryVertexLocation(vertexContainer, msg);
+  if(location >= 0) return vertexContainer->at(location);
 
   msg << MSG::WARNING << "No primary vertex was found! Returning nullptr" << endmsg;
 
@@ -360,6 +393,38 @@ float HelperFunctions::getPrimaryVertexZ(const xAOD::Vertex* pvx)
   return pvx_z;
 }
 
+void HelperFunctions::readAllAuxData(const SG::AuxVectorData& cont)
+{
+  const SG::IConstAuxStore* store = cont.getConstStore();
+  if( !store ) return;
+  for( SG::auxid_t auxid : store->getAuxIDs() ) store->getData( auxid );
+}
+
+void HelperFunctions::addBinsByLabel(TH1* to, const TH1* from, double scale)
+{
+  // SetBinContent and the extension of the axis change the number of entries, it is set once at the end
+  const double entries = to->GetEntries() + scale*from->GetEntries();
+  if( !from->GetXaxis()->GetLabels() ){
+    to->Add( from, scale );
+    to->SetEntries( entries );
+    return;
+  }
+
+  for( int bin = 1; bin <= from->GetNbinsX(); ++bin ){
+    const char* label = from->GetXaxis()->GetBinLabel( bin );
+    if( !label || !label[0] ) continue;
+    const double content = from->GetBinContent( bin );
+    const double error   = from->GetBinError( bin );
+    if( content == 0. && error == 0. ) continue;
+    const int target = to->GetXaxis()->FindBin( label );
+    if( target < 1 ) continue;
+    const double targetError = to->GetBinError( target );
+    to->SetBinContent( target, to->GetBinContent( target ) + scale*content );
+    if( to->GetSumw2N() ) to->SetBinError( target, std::sqrt( std::max( 0., targetError*targetError + scale*error*error ) ) );
+  }
+  to->SetEntries( entries );
+}
+
 bool HelperFunctions::sort_pt(const xAOD::IParticle* partA, const xAOD::IParticle* partB){
   return partA->pt() > partB->pt();
 }
@@ -370,7 +435,8 @@ bool HelperFunctions::sort_pt(const xAOD::IParticle* partA, const xAOD::IParticl
 // CP::make_systematics_vector(recSysts); has some similar functionality but does not
 // prune down to 1 systematic if only request that one.  It does however include the
 // nominal case as a null SystematicSet
-std::vector< CP::SystematicSet > HelperFunctions::getListofSystematics(const CP::SystematicSet inSysts, std::string systNames, float systVal, MsgStream& msg ) {
+namespace {
+std::vector< CP::SystematicSet > computeListofSystematics(const CP::SystematicSet& inSysts, const std::string& systNames, float systVal, MsgStream& msg ) {
 
   std::vector< CP::SystematicSet > outSystList;
 
@@ -481,6 +547,30 @@ std::vector< CP::SystematicSet > HelperFunctions::getListofSystematics(const CP:
   return outSystList;
 
 }
+}
+
+std::shared_ptr< const std::vector< CP::SystematicSet > > HelperFunctions::getSharedListofSystematics(const CP::SystematicSet& inSysts, const std::string& systNames, float systVal, MsgStream& msg ) {
+
+  // the recommended systematics are identified by their name, which lists all of them
+  typedef std::tuple< std::string, std::string, float > Key;
+  static std::map< Key, std::shared_ptr< const std::vector< CP::SystematicSet > > > lists;
+
+  const Key key( inSysts.name(), systNames, systVal );
+  auto found = lists.find( key );
+  if ( found != lists.end() ) {
+    msg << MSG::DEBUG << "Reusing the list of " << found->second->size() << " systematics for " << systNames << endmsg;
+    return found->second;
+  }
+
+  std::shared_ptr< const std::vector< CP::SystematicSet > > systList = std::make_shared< const std::vector< CP::SystematicSet > >( computeListofSystematics( inSysts, systNames, systVal, msg ) );
+  lists.emplace( key, systList );
+  return systList;
+
+}
+
+std::vector< CP::SystematicSet > HelperFunctions::getListofSystematics(const CP::SystematicSet inSysts, std::string systNames, float systVal, MsgStream& msg ) {
+  return *getSharedListofSystematics( inSysts, systNames, systVal, msg );
+}
 
 void HelperFunctions::writeSystematicsListHist( const std::vector< CP::SystematicSet > &systs, std::string histName, TFile *file )
 {
@@ -514,6 +604,86 @@ float HelperFunctions::dPhi(float phi1, float phi2)
   return dPhi;
 }
 
+namespace {
+  // wrap a difference of two angles in [-pi, pi] back into [-pi, pi], without branches
+  inline float wrapDeltaPhi(float dPhi)
+  {
+    const float twoPi = 2*M_PI;
+    dPhi -= twoPi * (dPhi >  static_cast<float>(M_PI));
+    dPhi += twoPi * (dPhi < -static_cast<float>(M_PI));
+    return dPhi;
+  }
+}
+
+void HelperFunctions::deltaR2(float eta0, float phi0, const float* eta, const float* phi, std::size_t n, float* dR2)
+{
+  for(std::size_t i = 0; i < n; ++i){
+    const float dEta = eta[i] - eta0;
+    const float dPhi = wrapDeltaPhi(phi[i] - phi0);
+    dR2[i] = dEta*dEta + dPhi*dPhi;
+  }
+}
+
+void HelperFunctions::deltaR2Matrix(const float* eta1, const float* phi1, std::size_t n1, const float* eta2, const float* phi2, std::size_t n2, float* dR2)
+{
+  for(std::size_t i = 0; i < n1; ++i) deltaR2(eta1[i], phi1[i], eta2, phi2, n2, dR2 + i*n2);
+}
+
+int HelperFunctions::nearestDeltaR2(float eta0, float phi0, const float* eta, const float* phi, std::size_t n, float& minDR2, float maxDR2)
+{
+  int nearest = -1;
+  minDR2 = maxDR2;
+  for(std::size_t i = 0; i < n; ++i){
+    const float dEta = eta[i] - eta0;
+    const float dPhi = wrapDeltaPhi(phi[i] - phi0);
+    const float thisDR2 = dEta*dEta + dPhi*dPhi;
+    if(thisDR2 < minDR2){
+      minDR2 = thisDR2;
+      nearest = i;
+    }
+  }
+  return nearest;
+}
+
+void HelperFunctions::matchNearestDeltaR2(const float* dR2, std::size_t n1, std::size_t n2, float maxDR2, std::vector<int>& match2)
+{
+  match2.assign(n2, -1);
+  for(std::size_t i = 0; i < n1; ++i){
+    const float* row = dR2 + i*n2;
+    int nearest = -1;
+    float minDR2 = maxDR2;
+    for(std::size_t j = 0; j < n2; ++j){
+      if(row[j] < minDR2){
+        minDR2 = row[j];
+        nearest = j;
+      }
+    }
+    if(nearest < 0) continue;
+    int& matched = match2[nearest];
+    if(matched < 0 || dR2[matched*n2 + nearest] > minDR2) matched = i;
+  }
+}
+
+void HelperFunctions::matchGreedyDeltaR2(const float* dR2, std::size_t n1, std::size_t n2, float maxDR2, std::vector<int>& match2)
+{
+  match2.assign(n2, -1);
+
+  std::vector<std::pair<float, std::size_t> > pairs;
+  for(std::size_t k = 0; k < n1*n2; ++k){
+    if(dR2[k] < maxDR2) pairs.emplace_back(dR2[k], k);
+  }
+  std::sort(pairs.begin(), pairs.end());
+
+  std::vector<char> matched1(n1, 0);
+  for(const auto& pair : pairs){
+    const std::size_t i = pair.second / n2;
+    const std::size_t j = pair.second % n2;
+    if(matched1[i] || match2[j] >= 0) continue;
+    matched1[i] = 1;
+    match2[j] = i;
+  }
+}
+
 
 std::size_t HelperFunctions::string_pos( const std::string& haystack, const std::string& needle, unsigned int N )
 {
@@ -565,3 +735,49 @@ HelperFunctions::ShowerType HelperFunctions::getMCShowerType(const std::string&
   else if(tmp_name.Contains("SHERPA")) return Sherpa22;
   else return Unknown;
 }
+
+namespace {
+  // aux variables stored as plain numbers, which can be copied as raw memory
+  bool isPlainNumber(const std::type_info* type) {
+    static const std::type_info* const types[] = { &typeid(float), &typeid(double), &typeid(char), &typeid(signed char), &typeid(unsigned char),
+                                                   &typeid(short), &typeid(unsigned short), &typeid(int), &typeid(unsigned int),
+                                                   &typeid(long), &typeid(unsigned long), &typeid(long long), &typeid(unsigned long long) };
+    if ( !type ) return false;
+    for ( const std::type_info* plain : types ) if ( *type == *plain ) return true;
+    return false;
+  }
+}
+
+void HelperFunctions::copyAuxColumns(SG::AuxVectorData& dst, const SG::AuxVectorData& src, const std::vector<std::size_t>& rows, const std::string& auxItems)
+{
+  std::set<std::string> selected;
+  std::istringstream ss(auxItems);
+  std::string item;
+  while ( std::getline(ss, item, '.') ) if ( !item.empty() ) selected.insert(item);
+
+  SG::AuxTypeRegistry& registry = SG::AuxTypeRegistry::instance();
+  const std::size_t n = rows.size();
+  if ( n == 0 ) return;
+
+  for ( SG::auxid_t auxid : src.getAuxIDs() ) {
+    if ( !selected.empty() && selected.count( registry.getName(auxid) ) == 0 ) continue;
+
+    const void* srcData = src.getDataArray(auxid);
+    void* dstData = dst.getDataArray(auxid);
+
+    if ( isPlainNumber( registry.getType(auxid) ) ) {
+      const std::size_t size = registry.getEltSize(auxid);
+      const char* from = static_cast<const char*>(srcData);
+      char* to = static_cast<char*>(dstData);
+      // one copy per run of consecutive rows, the whole column for a selection that kept everything in order
+      for ( std::size_t i = 0; i < n; ) {
+        std::size_t length = 1;
+        while ( i+length < n && rows[i+length] == rows[i]+length ) ++length;
+        std::memcpy( to + i*size, from + rows[i]*size, length*size );
+        i += length;
+      }
+    } else {
+      for ( std::size_t i = 0; i < n; ++i ) registry.copy( auxid, dstData, i, srcData, rows[i] );
+    }
+  }
+}
@@ -0,0 +1,207 @@
+#include <xAODAnaHelpers/HistCheckpoint.h>
+#include <xAODAnaHelpers/HistogramManager.h>
+#include <xAODAnaHelpers/CutflowCounter.h>
+
+#include <algorithm>
+#include <cstdio>
+#include <functional>
+
+#include <TDirectory.h>
+#include <TFile.h>
+#include <TH1.h>
+#include <TKey.h>
+#include <TParameter.h>
+
+std::vector<xAH::HistCheckpoint*>& xAH::HistCheckpoint::instances()
+{
+  static std::vector<HistCheckpoint*> instances;
+  return instances;
+}
+
+std::string& xAH::HistCheckpoint::fileTag()
+{
+  static std::string tag;
+  return tag;
+}
+
+std::vector<std::string>& xAH::HistCheckpoint::unregisteredList()
+{
+  static std::vector<std::string> unregistered;
+  return unregistered;
+}
+
+xAH::HistCheckpoint::HistCheckpoint()
+{
+  instances().push_back(this);
+}
+
+xAH::HistCheckpoint::~HistCheckpoint()
+{
+  auto& all = instances();
+  all.erase(std::remove(all.begin(), all.end(), this), all.end());
+}
+
+void xAH::HistCheckpoint::add(HistogramManager* hists)
+{
+  if(hists) m_managers.push_back(hists);
+}
+
+void xAH::HistCheckpoint::add(TH1* hist)
+{
+  if(hist) m_hists.push_back(hist);
+}
+
+void xAH::HistCheckpoint::add(CutflowCounter* counter)
+{
+  if(counter) m_counters.push_back(counter);
+}
+
+void xAH::HistCheckpoint::flushCounters()
+{
+  for(CutflowCounter* counter : m_counters) counter->flush();
+}
+
+bool xAH::HistCheckpoint::write(long long nEvents)
+{
+  if(m_fileName.empty() || empty()) return true;
+
+  flushCounters();
+  std::vector<TObject*> objects;
+  snapshot(objects);
+
+  std::string fileName = m_fileName;
+  if(!fileTag().empty()){
+    const std::size_t dot = fileName.rfind('.');
+    fileName.insert(dot == std::string::npos || dot < fileName.rfind('/')+1 ? fileName.size() : dot, fileTag());
+  }
+
+  ++m_checkpoints;
+  const bool written = writeFile(fileName, objects, nEvents);
+  for(TObject* obj : objects) delete obj;
+  return written;
+}
+
+void xAH::HistCheckpoint::snapshot(std::vector<TObject*>& objects)
+{
+  for(HistogramManager* hists : m_managers) hists->snapshot(objects);
+  for(const TH1* hist : m_hists){
+    TH1* clone = static_cast<TH1*>(hist->Clone());
+    clone->SetDirectory(nullptr);
+    objects.push_back(clone);
+  }
+}
+
+bool xAH::HistCheckpoint::merge(const TObject* obj)
+{
+  for(HistogramManager* hists : m_managers){
+    if(hists->merge(obj)) return true;
+  }
+  const TH1* other = dynamic_cast<const TH1*>(obj);
+  if(!other) return false;
+  for(TH1* hist : m_hists){
+    if(std::string(hist->GetName()) != other->GetName()) continue;
+    hist->Add(other);
+    return true;
+  }
+  return false;
+}
+
+bool xAH::HistCheckpoint::writeAll(const std::string& fileName, long long nEvents)
+{
+  // the counters may fill histograms registered to another instance
+  for(HistCheckpoint* checkpoint : instances()) checkpoint->flushCounters();
+  std::vector<TObject*> objects;
+  for(HistCheckpoint* checkpoint : instances()) checkpoint->snapshot(objects);
+  const bool written = writeFile(fileName, objects, nEvents);
+  for(TObject* obj : objects) delete obj;
+  return written;
+}
+
+void xAH::HistCheckpoint::reset()
+{
+  for(HistogramManager* hists : m_managers) hists->reset();
+  for(TH1* hist : m_hists) hist->Reset();
+}
+
+void xAH::HistCheckpoint::resetAll()
+{
+  // the counters may fill histograms registered to another instance, they are emptied by flushing them first
+  for(HistCheckpoint* checkpoint : instances()) checkpoint->flushCounters();
+  for(HistCheckpoint* checkpoint : instances()) checkpoint->reset();
+}
+
+namespace {
+  // the objects of dir and its subdirectories, named <directory>/<name> as in the histogram output
+  void mergeDirectory(TDirectory* dir, const std::string& path, int& merged, std::vector<std::string>& unmatched, const std::function<bool(TObject*)>& merge)
+  {
+    TIter next(dir->GetListOfKeys());
+    while(TKey* key = static_cast<TKey*>(next())){
+      const std::string name = path + key->GetName();
+      TObject* obj = key->ReadObj();
+      if(TDirectory* subdir = dynamic_cast<TDirectory*>(obj)){
+        mergeDirectory(subdir, name + "/", merged, unmatched, merge);
+        continue;
+      }
+      if(TNamed* named = dynamic_cast<TNamed*>(obj)) named->SetName(name.c_str());
+      if(merge(obj))                       ++merged;
+      else if(name != "checkpoint_events") unmatched.push_back(name);
+      delete obj;
+    }
+  }
+}
+
+int xAH::HistCheckpoint::mergeAll(const std::string& fileName, std::vector<std::string>& unmatched)
+{
+  TFile* file = TFile::Open(fileName.c_str(), "READ");
+  if(!file || file->IsZombie()){
+    delete file;
+    return -1;
+  }
+
+  int merged = 0;
+  mergeDirectory(file, "", merged, unmatched, [](TObject* obj){
+    for(HistCheckpoint* checkpoint : instances()){
+      if(checkpoint->merge(obj)) return true;
+    }
+    return false;
+  });
+
+  file->Close();
+  delete file;
+  return merged;
+}
+
+bool xAH::HistCheckpoint::writeFile(const std::string& fileName, const std::vector<TObject*>& snapshot, long long nEvents)
+{
+  // opening the file must not change the current directory of the job
+  TDirectory::TContext currentDirectory;
+
+  const std::string tmpName = fileName + ".tmp";
+  TFile* file = TFile::Open(tmpName.c_str(), "RECREATE");
+  if(!file || file->IsZombie()){
+    delete file;
+    return false;
+  }
+
+  for(TObject* obj : snapshot){
+    // the histograms are named <directory>/<name>, as in the histogram output
+    const std::string fullName = obj->GetName();
+    const std::size_t slash = fullName.rfind('/');
+    TDirectory* dir = file;
+    if(slash != std::string::npos){
+      const std::string path = fullName.substr(0, slash);
+      dir = file->GetDirectory(path.c_str());
+      if(!dir) dir = file->mkdir(path.c_str());
+      if(!dir) continue;
+    }
+    dir->WriteTObject(obj, fullName.substr(slash+1).c_str());
+  }
+
+  TParameter<Long64_t> events("checkpoint_events", nEvents);
+  file->WriteTObject(&events);
+  file->Close();
+  delete file;
+
+  // replace the previous checkpoint only once this one is complete
+  return std::rename(tmpName.c_str(), fileName.c_str()) == 0;
+}
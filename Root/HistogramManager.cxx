@@ -13,6 +13,11 @@
 
 #include <AsgTools/MsgStream.h>
 #include "xAODAnaHelpers/HistogramManager.h"
+#include <algorithm>
+#include <TArrayC.h>
+#include <TArrayS.h>
+#include <TClass.h>
+#include <cmath>
 
 /* constructors and destructors */
 HistogramManager::HistogramManager(std::string name, std::string detailStr):
@@ -31,7 +36,10 @@ HistogramManager::HistogramManager(std::string name, std::string detailStr):
   m_msg.setLevel(MSG::INFO);
 }
 
-HistogramManager::~HistogramManager() {}
+HistogramManager::~HistogramManager() {
+  // the worker owns the recorded histograms
+  for( auto hist : m_unrecorded ) delete hist;
+}
 
 /* Main book() functions for 1D, 2D, 3D histograms */
 TH1F* HistogramManager::book(std::string name, std::string title,
@@ -136,6 +144,125 @@ TH3F* HistogramManager::book(std::string name, std::string title,
   return tmp;
 }
 
+/////// Sparse Histograms ///////
+THnSparseF* HistogramManager::bookSparse(std::string name, std::string title,
+                                         std::string xlabel, int xbins, double xlow, double xhigh,
+                                         std::string ylabel, int ybins, double ylow, double yhigh)
+{
+  return bookSparse(name, title, { {xlabel, xbins, xlow, xhigh, nullptr}, {ylabel, ybins, ylow, yhigh, nullptr} });
+}
+
+THnSparseF* HistogramManager::bookSparse(std::string name, std::string title,
+                                         std::string xlabel, int xbins, const Double_t* xbinArr,
+                                         std::string ylabel, int ybins, double ylow, double yhigh)
+{
+  return bookSparse(name, title, { {xlabel, xbins, 0., 1., xbinArr}, {ylabel, ybins, ylow, yhigh, nullptr} });
+}
+
+THnSparseF* HistogramManager::bookSparse(std::string name, std::string title,
+                                         std::string xlabel, int xbins, double xlow, double xhigh,
+                                         std::string ylabel, int ybins, const Double_t* ybinArr)
+{
+  return bookSparse(name, title, { {xlabel, xbins, xlow, xhigh, nullptr}, {ylabel, ybins, 0., 1., ybinArr} });
+}
+
+THnSparseF* HistogramManager::bookSparse(std::string name, std::string title,
+                                         std::string xlabel, int xbins, const Double_t* xbinArr,
+                                         std::string ylabel, int ybins, const Double_t* ybinArr)
+{
+  return bookSparse(name, title, { {xlabel, xbins, 0., 1., xbinArr}, {ylabel, ybins, 0., 1., ybinArr} });
+}
+
+THnSparseF* HistogramManager::bookSparse(std::string name, std::string title,
+                                         std::string xlabel, int xbins, double xlow, double xhigh,
+                                         std::string ylabel, int ybins, double ylow, double yhigh,
+                                         std::string zlabel, int zbins, double zlow, double zhigh)
+{
+  return bookSparse(name, title, { {xlabel, xbins, xlow, xhigh, nullptr}, {ylabel, ybins, ylow, yhigh, nullptr}, {zlabel, zbins, zlow, zhigh, nullptr} });
+}
+
+THnSparseF* HistogramManager::bookSparse(std::string name, std::string title,
+                                         std::string xlabel, int xbins, const Double_t* xbinArr,
+                                         std::string ylabel, int ybins, const Double_t* ybinArr,
+                                         std::string zlabel, int zbins, const Double_t* zbinArr)
+{
+  return bookSparse(name, title, { {xlabel, xbins, 0., 1., xbinArr}, {ylabel, ybins, 0., 1., ybinArr}, {zlabel, zbins, 0., 1., zbinArr} });
+}
+
+THnSparseF* HistogramManager::bookSparse(const std::string& name, const std::string& title, const std::vector<SparseAxis>& axes)
+{
+  const int dim = axes.size();
+  std::vector<Int_t> nbins;
+  std::vector<Double_t> lows, highs;
+  for ( const SparseAxis& axis : axes ) {
+    nbins.push_back(axis.nbins);
+    lows.push_back(axis.low);
+    highs.push_back(axis.high);
+  }
+
+  THnSparseF* tmp = new THnSparseF( (name + title).c_str(), title.c_str(), dim, nbins.data(), lows.data(), highs.data() );
+  for ( int i = 0; i < dim; ++i ) {
+    if ( axes[i].edges ) tmp->SetBinEdges(i, axes[i].edges);
+    tmp->GetAxis(i)->SetTitle(axes[i].label.c_str());
+  }
+  tmp->Sumw2();
+
+  m_allSparse.push_back(tmp);
+  return tmp;
+}
+
+void HistogramManager::fillSparse(THnSparse* hist, double valueX, double valueY, double weight) const
+{
+  const Double_t values[2] = {valueX, valueY};
+  hist->Fill(values, weight);
+}
+
+void HistogramManager::fillSparse(THnSparse* hist, double valueX, double valueY, double valueZ, double weight) const
+{
+  const Double_t values[3] = {valueX, valueY, valueZ};
+  hist->Fill(values, weight);
+}
+
+void HistogramManager::recordSparse()
+{
+  if ( !m_sparseDense || !m_worker ) return;
+
+  for ( THnSparseF* sparse : m_allSparse ) {
+    // TH1::SetBins takes the edges of every axis, uniform axes included
+    std::vector< std::vector<Double_t> > edges(sparse->GetNdimensions());
+    for ( int i = 0; i < sparse->GetNdimensions(); ++i ) {
+      const TAxis* axis = sparse->GetAxis(i);
+      for ( int bin = 1; bin <= axis->GetNbins() + 1; ++bin ) edges[i].push_back(axis->GetBinLowEdge(bin));
+    }
+
+    const std::string name = sparse->GetName();
+    sparse->SetName( (name + "_sparse").c_str() );
+    TH1* dense = nullptr;
+    if ( sparse->GetNdimensions() == 2 ) {
+      dense = new TH2F( name.c_str(), sparse->GetTitle(), edges[0].size()-1, edges[0].data(), edges[1].size()-1, edges[1].data() );
+      SetLabel(dense, sparse->GetAxis(0)->GetTitle(), sparse->GetAxis(1)->GetTitle());
+    } else {
+      dense = new TH3F( name.c_str(), sparse->GetTitle(), edges[0].size()-1, edges[0].data(), edges[1].size()-1, edges[1].data(), edges[2].size()-1, edges[2].data() );
+      SetLabel(dense, sparse->GetAxis(0)->GetTitle(), sparse->GetAxis(1)->GetTitle(), sparse->GetAxis(2)->GetTitle());
+    }
+    this->Sumw2(dense);
+
+    // only the filled bins are stored, under- and overflow included
+    std::vector<Int_t> coord(sparse->GetNdimensions());
+    for ( Long64_t i = 0; i < sparse->GetNbins(); ++i ) {
+      const Double_t content = sparse->GetBinContent(i, coord.data());
+      const Int_t bin = sparse->GetNdimensions() == 2 ? dense->GetBin(coord[0], coord[1]) : dense->GetBin(coord[0], coord[1], coord[2]);
+      dense->SetBinContent(bin, content);
+      dense->SetBinError(bin, std::sqrt(sparse->GetBinError2(i)));
+    }
+    dense->SetEntries(sparse->GetEntries());
+
+    m_worker->addOutput(dense);
+    delete sparse;
+  }
+  m_allSparse.clear();
+}
+
 MsgStream& HistogramManager :: msg () const { return m_msg; }
 MsgStream& HistogramManager :: msg (int level) const {
     MsgStream& result = msg();
@@ -149,7 +276,10 @@ void HistogramManager::Sumw2(TH1* hist, bool flag /*=true*/) {
 }
 
 void HistogramManager::record(TH1* hist) {
+  m_slotIndex.emplace( hist, m_allHists.size() );
   m_allHists.push_back( hist );
+  // every histogram has its buffer in every shard, so that filling never changes the layout of the buffers
+  for( FillBuffers& shard : m_shards ) shard.resize( m_allHists.size() );
 
   // Check if this histName already exists
   std::string histName = hist->GetName();
@@ -163,10 +293,136 @@ void HistogramManager::record(TH1* hist) {
   m_histMap.insert( m_histMap.end(), std::pair< std::string, TH1* >( histName, hist ) );
 }
 
+std::size_t HistogramManager::memoryBytes() const {
+  std::size_t bytes = 0;
+
+  for( const TH1* hist : m_allHists ){
+    // the bin contents are the TArray the histogram class inherits from
+    std::size_t binBytes = 0;
+    if      ( dynamic_cast<const TArrayD*>(hist) ) binBytes = sizeof(Double_t);
+    else if ( dynamic_cast<const TArrayF*>(hist) ) binBytes = sizeof(Float_t);
+    else if ( dynamic_cast<const TArrayI*>(hist) ) binBytes = sizeof(Int_t);
+    else if ( dynamic_cast<const TArrayS*>(hist) ) binBytes = sizeof(Short_t);
+    else if ( dynamic_cast<const TArrayC*>(hist) ) binBytes = sizeof(Char_t);
+
+    bytes += hist->IsA()->Size();
+    bytes += hist->GetNcells()*binBytes;
+    bytes += hist->GetSumw2N()*sizeof(Double_t);
+    if( const TProfile* profile = dynamic_cast<const TProfile*>(hist) ){
+      bytes += (hist->GetNcells() + profile->GetBinSumw2()->GetSize())*sizeof(Double_t);
+    }
+  }
+
+  for( const THnSparseF* sparse : m_allSparse ){
+    // content, squared weight and the coordinates of every filled bin
+    bytes += sparse->GetNbins()*(sizeof(Float_t) + sizeof(Double_t) + sparse->GetNdimensions()*sizeof(Int_t));
+  }
+
+  for( const FillBuffers& shard : m_shards ){
+    bytes += shard.capacity()*sizeof(FillBuffer);
+    for( const FillBuffer& buffer : shard ){
+      bytes += (buffer.values.capacity() + buffer.weights.capacity() + buffer.sumw.capacity() + buffer.sumw2.capacity())*sizeof(double);
+    }
+  }
+
+  return bytes;
+}
+
 void HistogramManager::record(EL::IWorker* wk) {
   for( auto hist : m_allHists ){
+    if( m_packedOutput && isPackable(hist) ){
+      m_unrecorded.push_back(hist);
+      continue;
+    }
     wk->addOutput(hist);
   }
+
+  m_worker = wk;
+  if ( !m_sparseDense ) {
+    for( auto sparse : m_allSparse ) wk->addOutput(sparse);
+  }
+}
+
+void HistogramManager::snapshot(std::vector<TObject*>& objects) {
+  flushFills();
+  for( const TH1* hist : m_allHists ){
+    TH1* clone = static_cast<TH1*>(hist->Clone());
+    clone->SetDirectory(nullptr);
+    objects.push_back(clone);
+  }
+  for( const THnSparseF* sparse : m_allSparse ) objects.push_back( sparse->Clone() );
+}
+
+void HistogramManager::reset() {
+  flushFills();
+  for( TH1* hist : m_allHists ) hist->Reset();
+  for( THnSparseF* sparse : m_allSparse ) sparse->Reset();
+}
+
+bool HistogramManager::merge(const TObject* obj) {
+  if( const TH1* other = dynamic_cast<const TH1*>(obj) ){
+    HistMap_t::const_iterator it = m_histMap.find( other->GetName() );
+    if( it == m_histMap.end() ) return false;
+    it->second->Add(other);
+    return true;
+  }
+  if( const THnSparse* other = dynamic_cast<const THnSparse*>(obj) ){
+    for( THnSparseF* sparse : m_allSparse ){
+      if( std::string(sparse->GetName()) != other->GetName() ) continue;
+      sparse->Add(other);
+      return true;
+    }
+  }
+  return false;
+}
+
+bool HistogramManager::isPackable(const TH1* hist) {
+  return hist->GetDimension() == 1 && !hist->InheritsFrom(TProfile::Class());
+}
+
+std::vector< std::pair<std::string, const TH1*> > HistogramManager::packableHists() const {
+  std::vector< std::pair<std::string, const TH1*> > hists;
+  for( const TH1* hist : m_allHists ){
+    if( !isPackable(hist) ) continue;
+    std::string name = hist->GetName();
+    if( name.compare(0, m_name.size(), m_name) == 0 ) name.erase(0, m_name.size());
+    hists.push_back( std::make_pair(name, hist) );
+  }
+  return hists;
+}
+
+TH2F* HistogramManager::packVariations(const std::string& name, const std::vector<const TH1*>& variations, const std::vector<std::string>& labels) {
+  // the first variation booking the observable gives the binning
+  const auto it = std::find_if( variations.begin(), variations.end(), [](const TH1* hist){ return hist != nullptr; } );
+  if( it == variations.end() ) return nullptr;
+
+  const TH1* first = *it;
+  const TAxis* xaxis = first->GetXaxis();
+  const int nbins = xaxis->GetNbins();
+  const int nVariations = variations.size();
+  TH2F* packed = nullptr;
+  if( xaxis->GetXbins()->GetSize() > 0 ) packed = new TH2F( name.c_str(), first->GetTitle(), nbins, xaxis->GetXbins()->GetArray(), nVariations, 0, nVariations );
+  else                                   packed = new TH2F( name.c_str(), first->GetTitle(), nbins, xaxis->GetXmin(), xaxis->GetXmax(), nVariations, 0, nVariations );
+  packed->GetXaxis()->SetTitle(xaxis->GetTitle());
+  packed->GetYaxis()->SetTitle("variation");
+  packed->Sumw2();
+
+  double entries = 0;
+  for( int iVariation = 0; iVariation < nVariations; ++iVariation ){
+    if( static_cast<std::size_t>(iVariation) < labels.size() ) packed->GetYaxis()->SetBinLabel(iVariation+1, labels.at(iVariation).c_str());
+
+    const TH1* hist = variations.at(iVariation);
+    if( !hist || hist->GetNbinsX() != nbins ) continue;
+    for( int bin = 0; bin <= nbins+1; ++bin ){
+      packed->SetBinContent(bin, iVariation+1, hist->GetBinContent(bin));
+      packed->SetBinError(bin, iVariation+1, hist->GetBinError(bin));
+    }
+    entries += hist->GetEntries();
+  }
+  packed->ResetStats();
+  packed->SetEntries(entries);
+
+  return packed;
 }
 
 void HistogramManager::SetLabel(TH1* hist, std::string xlabel)
@@ -201,13 +457,13 @@ TH1* HistogramManager::findHist(const std::string& histName) {
 void HistogramManager::fillHist(const std::string& histName, double value) {
   TH1* histPointer(NULL);
   histPointer = this->findHist(histName);
-  histPointer->Fill(value);
+  if ( histPointer ) histPointer->Fill(value);
 }
 
 void HistogramManager::fillHist(const std::string& histName, double value, double weight) {
   TH1* histPointer(NULL);
   histPointer = this->findHist(histName);
-  histPointer->Fill(value, weight);
+  if ( histPointer ) histPointer->Fill(value, weight);
 }
 
 void HistogramManager::fillHist(const std::string& histName, double valueX, double valueY, double weight) {
@@ -222,3 +478,186 @@ void HistogramManager::fillHist(const std::string& histName, double valueX, doub
   }
   histPointer->Fill(valueX, valueY, weight);
 }
+
+thread_local unsigned int HistogramManager::s_currentShard = 0;
+
+HistogramManager::ShardScope::ShardScope(unsigned int shard) :
+  m_previous(s_currentShard)
+{
+  s_currentShard = shard;
+}
+
+HistogramManager::ShardScope::~ShardScope() {
+  s_currentShard = m_previous;
+}
+
+HistogramManager::FillSlot HistogramManager::fillSlot(TH1* hist) const {
+  auto it = m_slotIndex.find(hist);
+  if ( it == m_slotIndex.end() ) {
+    ANA_MSG_ERROR("Histogram " << (hist ? hist->GetName() : "(null)") << " was not booked by " << m_name << ", it will not be filled");
+    return FillSlot();
+  }
+  return FillSlot(it->second, hist);
+}
+
+HistogramManager::FillBuffer& HistogramManager::fillBuffer(FillBuffers& buffers, const FillSlot& slot) {
+  FillBuffer& buffer = buffers[slot.m_index];
+  if ( buffer.ready ) return buffer;
+
+  buffer.ready = true;
+  const TH1* hist = slot.m_hist;
+  const TAxis* axis = hist->GetXaxis();
+  buffer.uniform = hist->GetDimension() == 1 && !hist->InheritsFrom(TProfile::Class()) &&
+                   axis->GetXbins()->GetSize() == 0 && !hist->CanExtendAllAxes() && !hist->GetBuffer();
+  if ( buffer.uniform ) {
+    buffer.nbins = axis->GetNbins();
+    buffer.xlow  = axis->GetXmin();
+    buffer.xhigh = axis->GetXmax();
+    buffer.binsPerUnit = buffer.nbins / (buffer.xhigh - buffer.xlow);
+    buffer.sumw.assign(buffer.nbins + 2, 0.);
+    if ( hist->GetSumw2N() ) buffer.sumw2.assign(buffer.nbins + 2, 0.);
+  }
+  return buffer;
+}
+
+void HistogramManager::fillBuffered(TH1* hist, double value, double weight) {
+  auto it = m_slotIndex.find(hist);
+  // a histogram booked elsewhere has no buffer
+  if ( it == m_slotIndex.end() ) {
+    hist->Fill(value, weight);
+    return;
+  }
+  fillBuffered(FillSlot(it->second, hist), value, weight);
+}
+
+void HistogramManager::fillBuffered(TH1* hist, const double* values, std::size_t n, double weight) {
+  auto it = m_slotIndex.find(hist);
+  if ( it == m_slotIndex.end() ) {
+    for ( std::size_t i = 0; i < n; ++i ) hist->Fill(values[i], weight);
+    return;
+  }
+  fillBuffered(FillSlot(it->second, hist), values, n, weight);
+}
+
+void HistogramManager::fillBuffered(const FillSlot& slot, double value, double weight) {
+  if ( !slot.valid() ) return;
+  TH1* hist = slot.m_hist;
+  const bool sharded = m_shards.size() > 1;
+  if ( m_fillBufferSize == 0 && !sharded ) {
+    hist->Fill(value, weight);
+    return;
+  }
+
+  FillBuffer& buffer = fillBuffer(m_shards.at(sharded ? s_currentShard : 0), slot);
+
+  if ( buffer.uniform ) {
+    fillUniform(buffer, value, weight, weight*weight, weight*value, weight*value*value);
+    return;
+  }
+
+  buffer.values.push_back(value);
+  buffer.weights.push_back(weight);
+  // the histogram is shared between the shards, they are only merged in flushFills
+  if ( sharded || buffer.values.size() < m_fillBufferSize ) return;
+
+  hist->FillN(buffer.values.size(), buffer.values.data(), buffer.weights.data());
+  buffer.values.clear();
+  buffer.weights.clear();
+}
+
+void HistogramManager::fillBuffered(const FillSlot& slot, const double* values, std::size_t n, double weight) {
+  if ( !slot.valid() ) return;
+  const bool sharded = m_shards.size() > 1;
+  FillBuffer& buffer = fillBuffer(m_shards.at(sharded ? s_currentShard : 0), slot);
+
+  if ( !buffer.uniform ) {
+    for ( std::size_t i = 0; i < n; ++i ) fillBuffered(slot, values[i], weight);
+    return;
+  }
+
+  const double weight2 = weight*weight;
+  for ( std::size_t i = 0; i < n; ++i ) fillUniform(buffer, values[i], weight, weight2, weight*values[i], weight*values[i]*values[i]);
+}
+
+void HistogramManager::fillBuffered(const MultiBinning& binnings, double value, double weight) {
+  const bool sharded = m_shards.size() > 1;
+  FillBuffers& buffers = m_shards.at(sharded ? s_currentShard : 0);
+
+  // the same for every binning
+  const double weight2 = weight*weight;
+  const double weightValue = weight*value;
+  const double weightValue2 = weightValue*value;
+
+  for ( const FillSlot& slot : binnings.slots() ) {
+    if ( !slot.valid() ) continue;
+    FillBuffer& buffer = fillBuffer(buffers, slot);
+    if ( buffer.uniform ) fillUniform(buffer, value, weight, weight2, weightValue, weightValue2);
+    else                  fillBuffered(slot, value, weight);
+  }
+}
+
+void HistogramManager::fillUniform(FillBuffer& buffer, double value, double weight, double weight2, double weightValue, double weightValue2) {
+  // same binning as TAxis::FindFixBin, NaN goes to the overflow
+  int bin = 0;
+  if ( !(value < buffer.xhigh) )  bin = buffer.nbins + 1;
+  else if ( value >= buffer.xlow ) bin = 1 + int( (value - buffer.xlow) * buffer.binsPerUnit );
+  if ( bin > buffer.nbins ) bin = buffer.nbins + 1;
+
+  buffer.sumw[bin] += weight;
+  if ( !buffer.sumw2.empty() ) buffer.sumw2[bin] += weight2;
+  buffer.entries += 1;
+  if ( bin > 0 && bin <= buffer.nbins ) {
+    buffer.stats[0] += weight;
+    buffer.stats[1] += weight2;
+    buffer.stats[2] += weightValue;
+    buffer.stats[3] += weightValue2;
+  }
+}
+
+void HistogramManager::setFillBufferSize(unsigned int size) {
+  flushFills();
+  m_fillBufferSize = size;
+}
+
+void HistogramManager::setShards(unsigned int nShards) {
+  flushFills();
+  m_shards.clear();
+  m_shards.resize(nShards > 1 ? nShards : 1, FillBuffers(m_allHists.size()));
+}
+
+void HistogramManager::flushFills() {
+  for ( auto& shard : m_shards ) {
+    for ( std::size_t i = 0; i < shard.size(); ++i ) {
+      if ( shard[i].ready ) flush(m_allHists[i], shard[i]);
+    }
+  }
+}
+
+void HistogramManager::flush(TH1* hist, FillBuffer& buffer) {
+  if ( buffer.uniform && buffer.entries > 0 ) {
+    // read the statistics before touching the bins, ROOT may recompute them from the contents
+    double stats[4];
+    hist->GetStats(stats);
+    const double entries = hist->GetEntries();
+
+    for ( int bin = 0; bin <= buffer.nbins + 1; ++bin ) {
+      if ( buffer.sumw[bin] == 0. && (buffer.sumw2.empty() || buffer.sumw2[bin] == 0.) ) continue;
+      hist->AddBinContent(bin, buffer.sumw[bin]);
+      if ( !buffer.sumw2.empty() ) hist->GetSumw2()->fArray[bin] += buffer.sumw2[bin];
+    }
+
+    for ( unsigned int i = 0; i < 4; ++i ) stats[i] += buffer.stats[i];
+    hist->PutStats(stats);
+    hist->SetEntries(entries + buffer.entries);
+
+    std::fill(buffer.sumw.begin(), buffer.sumw.end(), 0.);
+    std::fill(buffer.sumw2.begin(), buffer.sumw2.end(), 0.);
+    std::fill(buffer.stats, buffer.stats + 4, 0.);
+    buffer.entries = 0.;
+  }
+
+  if ( buffer.values.empty() ) return;
+  hist->FillN(buffer.values.size(), buffer.values.data(), buffer.weights.data());
+  buffer.values.clear();
+  buffer.weights.clear();
+}
@@ -1,5 +1,7 @@
 #include <xAODAnaHelpers/IParticleHists.h>
 #include <sstream>
+#include <cmath>
+#include <algorithm>
 
 ANA_MSG_SOURCE(msgIParticleHists, "IParticleHists")
 
@@ -24,11 +26,17 @@ StatusCode IParticleHists::initialize() {
   m_Pt          = book(m_name, m_prefix+"Pt",       m_title+" p_{T} [GeV]", 100, 0, 1000.);
   m_Pt_m        = book(m_name, m_prefix+"Pt_m",     m_title+" p_{T} [GeV]", 100, 0,  500.);
   m_Pt_s        = book(m_name, m_prefix+"Pt_s",     m_title+" p_{T} [GeV]", 200, 0,  200.);
+  m_PtBinnings.add(fillSlot(m_Pt_l)).add(fillSlot(m_Pt)).add(fillSlot(m_Pt_m)).add(fillSlot(m_Pt_s));
   m_Eta         = book(m_name, m_prefix+"Eta",      m_title+" #eta",         98, -4.9, 4.9);
   m_Phi         = book(m_name, m_prefix+"Phi",      m_title+" Phi",         120, -TMath::Pi(), TMath::Pi() );
   m_M           = book(m_name, m_prefix+"Mass",     m_title+" Mass [GeV]",  120, 0, 400);
   m_E           = book(m_name, m_prefix+"Energy",   m_title+" Energy [GeV]",120, 0, 4000.);
   m_Rapidity    = book(m_name, m_prefix+"Rapidity", m_title+" Rapidity",    120, -10, 10);
+  m_EtaSlot      = fillSlot(m_Eta);
+  m_PhiSlot      = fillSlot(m_Phi);
+  m_MSlot        = fillSlot(m_M);
+  m_ESlot        = fillSlot(m_E);
+  m_RapiditySlot = fillSlot(m_Rapidity);
 
   if(m_debug) Info("IParticleHists::initialize()", m_name.c_str());
   // details of the particle kinematics
@@ -37,10 +45,14 @@ StatusCode IParticleHists::initialize() {
     m_Px     = book(m_name, m_prefix+"Px",     m_title+" Px [GeV]",     120, 0, 1000);
     m_Py     = book(m_name, m_prefix+"Py",     m_title+" Py [GeV]",     120, 0, 1000);
     m_Pz     = book(m_name, m_prefix+"Pz",     m_title+" Pz [GeV]",     120, 0, 4000);
+    m_PxSlot = fillSlot(m_Px);
+    m_PySlot = fillSlot(m_Py);
+    m_PzSlot = fillSlot(m_Pz);
 
     m_Et          = book(m_name, m_prefix+"Et",       m_title+" E_{T} [GeV]", 100, 0, 1000.);
     m_Et_m        = book(m_name, m_prefix+"Et_m",     m_title+" E_{T} [GeV]", 100, 0,  500.);
     m_Et_s        = book(m_name, m_prefix+"Et_s",     m_title+" E_{T} [GeV]", 100, 0,  100.);
+    m_EtBinnings.add(fillSlot(m_Et)).add(fillSlot(m_Et_m)).add(fillSlot(m_Et_s));
   }
 
   // N leading jets
@@ -71,6 +83,8 @@ StatusCode IParticleHists::initialize() {
       m_NPt .push_back(       book(m_name, (m_prefix+"Pt_"+pNum.str()),       pTitle.str()+" "+m_title+" p_{T} [GeV]" ,100,            0,       1000. ) );
       m_NPt_m.push_back(       book(m_name, (m_prefix+"Pt_m_"+pNum.str()),       pTitle.str()+" "+m_title+" p_{T} [GeV]" ,100,            0,       500. ) );
       m_NPt_s.push_back(       book(m_name, (m_prefix+"Pt_s_"+pNum.str()),       pTitle.str()+" "+m_title+" p_{T} [GeV]" ,100,            0,       100. ) );
+      m_NPtBinnings.emplace_back();
+      m_NPtBinnings.back().add(fillSlot(m_NPt_l.back())).add(fillSlot(m_NPt.back())).add(fillSlot(m_NPt_m.back())).add(fillSlot(m_NPt_s.back()));
       m_NEta.push_back(      book(m_name, (m_prefix+"Eta_"+pNum.str()),      pTitle.str()+" "+m_title+" #eta"        , 80,           -4,           4 ) );
       m_NPhi.push_back(      book(m_name, (m_prefix+"Phi_"+pNum.str()),      pTitle.str()+" "+m_title+" Phi"         ,120, -TMath::Pi(), TMath::Pi() ) );
       m_NM.push_back(        book(m_name, (m_prefix+"Mass_"+pNum.str()),     pTitle.str()+" "+m_title+" Mass [GeV]"  ,120,            0,         400 ) );
@@ -80,6 +94,8 @@ StatusCode IParticleHists::initialize() {
 	m_NEt .push_back(        book(m_name, (m_prefix+"Et_"+pNum.str()),         pTitle.str()+" "+m_title+" E_{T} [GeV]" ,100,            0,       1000. ) );
 	m_NEt_m.push_back(       book(m_name, (m_prefix+"Et_m_"+pNum.str()),       pTitle.str()+" "+m_title+" E_{T} [GeV]" ,100,            0,       500. ) );
 	m_NEt_s.push_back(       book(m_name, (m_prefix+"Et_s_"+pNum.str()),       pTitle.str()+" "+m_title+" E_{T} [GeV]" ,100,            0,       100. ) );
+	m_NEtBinnings.emplace_back();
+	m_NEtBinnings.back().add(fillSlot(m_NEt.back())).add(fillSlot(m_NEt_m.back())).add(fillSlot(m_NEt_s.back()));
       }
 
       pNum.str("");
@@ -93,31 +109,27 @@ StatusCode IParticleHists::initialize() {
 
 StatusCode IParticleHists::execute( const xAOD::IParticleContainer* particles, float eventWeight, const xAOD::EventInfo* eventInfo) {
   using namespace msgIParticleHists;
-  for( auto particle_itr : *particles ) {
-    ANA_CHECK( this->execute( particle_itr, eventWeight, eventInfo));
-  }
-
-  if( m_infoSwitch->m_numLeading > 0){
-    int numParticles = std::min( m_infoSwitch->m_numLeading, (int)particles->size() );
-    for(int iParticle=0; iParticle < numParticles; ++iParticle){
-      m_NPt_l.at(iParticle)->        Fill( particles->at(iParticle)->pt()/1e3,   eventWeight);
-      m_NPt.at(iParticle)->        Fill( particles->at(iParticle)->pt()/1e3,   eventWeight);
-      m_NPt_m.at(iParticle)->        Fill( particles->at(iParticle)->pt()/1e3,   eventWeight);
-      m_NPt_s.at(iParticle)->        Fill( particles->at(iParticle)->pt()/1e3,   eventWeight);
-      m_NEta.at(iParticle)->       Fill( particles->at(iParticle)->eta(),      eventWeight);
-      m_NPhi.at(iParticle)->       Fill( particles->at(iParticle)->phi(),      eventWeight);
-      m_NM.at(iParticle)->         Fill( particles->at(iParticle)->m()/1e3,    eventWeight);
-      m_NE.at(iParticle)->         Fill( particles->at(iParticle)->e()/1e3,    eventWeight);
-      m_NRapidity.at(iParticle)->  Fill( particles->at(iParticle)->rapidity(), eventWeight);
 
-      if(m_infoSwitch->m_kinematic){
-	float et = particles->at(iParticle)->e()/cosh(particles->at(iParticle)->eta())/1e3;
-	m_NEt  .at(iParticle)->        Fill( et,   eventWeight);
-	m_NEt_m.at(iParticle)->        Fill( et,   eventWeight);
-	m_NEt_s.at(iParticle)->        Fill( et,   eventWeight);
-      }
+  // the object execute() keeps the kinematics of the leading particles, so that they are read only once
+  const unsigned int numLeading = std::min<unsigned int>( std::max(m_infoSwitch->m_numLeading, 0), particles->size() );
+  LeadingCache cache{this, numLeading, {}};
+  cache.entries.reserve(numLeading);
+  LeadingCache* previous = leadingCache();
+  leadingCache() = &cache;
 
-    }
+  StatusCode status = StatusCode::SUCCESS;
+  for( auto particle_itr : *particles ) {
+    status = this->execute( particle_itr, eventWeight, eventInfo);
+    if( status.isFailure() ) break;
+  }
+  leadingCache() = previous;
+  ANA_CHECK( status );
+
+  for(unsigned int iParticle=0; iParticle < numLeading; ++iParticle){
+    const xAOD::IParticle* particle = particles->at(iParticle);
+    // derived classes that do not fill through IParticleHists::execute leave the cache empty
+    if( iParticle < cache.entries.size() && cache.entries[iParticle].first == particle ) fillLeading( cache.entries[iParticle].second, eventWeight, iParticle );
+    else                                                                                 fillLeading( kinematics( particle ), eventWeight, iParticle );
   }
 
   return StatusCode::SUCCESS;
@@ -127,65 +139,156 @@ StatusCode IParticleHists::execute( const xAOD::IParticle* particle, float event
 
   if(m_debug) std::cout << "IParticleHists: in execute " <<std::endl;
 
-  //basic
-  m_Pt_l ->      Fill( particle->pt()/1e3,    eventWeight );
-  m_Pt ->        Fill( particle->pt()/1e3,    eventWeight );
-  m_Pt_m ->      Fill( particle->pt()/1e3,    eventWeight );
-  m_Pt_s ->      Fill( particle->pt()/1e3,    eventWeight );
-  m_Eta->        Fill( particle->eta(),       eventWeight );
-  m_Phi->        Fill( particle->phi(),       eventWeight );
-  m_M->          Fill( particle->m()/1e3,     eventWeight );
-  m_E->          Fill( particle->e()/1e3,     eventWeight );
-  m_Rapidity->   Fill( particle->rapidity(),  eventWeight );
+  const Kinematics kin = kinematics( particle );
+  fillInclusive( kin, eventWeight );
 
-  // kinematic
-  if( m_infoSwitch->m_kinematic ) {
+  LeadingCache* cache = leadingCache();
+  if( cache && cache->owner == this && cache->entries.size() < cache->nLeading ) cache->entries.emplace_back( particle, kin );
 
+  return StatusCode::SUCCESS;
+}
 
-    m_Px->  Fill( particle->p4().Px()/1e3,  eventWeight );
-    m_Py->  Fill( particle->p4().Py()/1e3,  eventWeight );
-    m_Pz->  Fill( particle->p4().Pz()/1e3,  eventWeight );
+StatusCode IParticleHists::execute( const xAH::Particle* particle, float eventWeight, const xAH::EventInfo* /*eventInfo*/ ) {
 
+  if(m_debug) std::cout << "IParticleHists: in execute " <<std::endl;
 
-    m_Et ->        Fill( particle->p4().Et()/1e3,    eventWeight );
-    m_Et_m ->      Fill( particle->p4().Et()/1e3,    eventWeight );
-    m_Et_s ->      Fill( particle->p4().Et()/1e3,    eventWeight );
-  } // fillKinematic
+  fillInclusive( kinematics( particle->p4 ), eventWeight );
 
   return StatusCode::SUCCESS;
 }
 
+IParticleHists::LeadingCache*& IParticleHists::leadingCache() {
+  // one per thread, the histograms may be filled from several of them
+  static thread_local LeadingCache* cache = nullptr;
+  return cache;
+}
 
+IParticleHists::Kinematics IParticleHists::kinematics( const xAOD::IParticle* particle ) {
+  // the four-vector is built once, the stored quantities are taken as they are
+  const TLorentzVector p4 = particle->p4();
+
+  Kinematics kin;
+  kin.pt       = particle->pt()/1e3;
+  kin.eta      = particle->eta();
+  kin.phi      = particle->phi();
+  kin.m        = particle->m()/1e3;
+  kin.e        = p4.E()/1e3;
+  kin.rapidity = p4.Rapidity();
+  kin.px       = p4.Px()/1e3;
+  kin.py       = p4.Py()/1e3;
+  kin.pz       = p4.Pz()/1e3;
+  kin.et       = p4.Et()/1e3;
+  return kin;
+}
 
+IParticleHists::Kinematics IParticleHists::kinematics( const TLorentzVector& p4 ) {
+  Kinematics kin;
+  kin.pt       = p4.Pt();
+  kin.eta      = p4.Eta();
+  kin.phi      = p4.Phi();
+  kin.m        = p4.M();
+  kin.e        = p4.E();
+  kin.rapidity = p4.Rapidity();
+  kin.px       = p4.Px();
+  kin.py       = p4.Py();
+  kin.pz       = p4.Pz();
+  kin.et       = p4.Et();
+  return kin;
+}
 
-StatusCode IParticleHists::execute( const xAH::Particle* particle, float eventWeight, const xAH::EventInfo* /*eventInfo*/ ) {
-
-  if(m_debug) std::cout << "IParticleHists: in execute " <<std::endl;
-
-  const TLorentzVector& partP4 = particle->p4;
+void IParticleHists::fillInclusive( const Kinematics& kin, float eventWeight ) {
 
   //basic
-  m_Pt_l ->      Fill( partP4.Pt(),    eventWeight );
-  m_Pt ->        Fill( partP4.Pt(),    eventWeight );
-  m_Pt_m ->      Fill( partP4.Pt(),    eventWeight );
-  m_Pt_s ->      Fill( partP4.Pt(),    eventWeight );
-  m_Eta->        Fill( partP4.Eta(),       eventWeight );
-  m_Phi->        Fill( partP4.Phi(),       eventWeight );
-  m_M->          Fill( partP4.M(),     eventWeight );
-  m_E->          Fill( partP4.E(),     eventWeight );
-  m_Rapidity->   Fill( partP4.Rapidity(),  eventWeight );
+  fillBuffered( m_PtBinnings,   kin.pt,       eventWeight );
+  fillBuffered( m_EtaSlot,      kin.eta,      eventWeight );
+  fillBuffered( m_PhiSlot,      kin.phi,      eventWeight );
+  fillBuffered( m_MSlot,        kin.m,        eventWeight );
+  fillBuffered( m_ESlot,        kin.e,        eventWeight );
+  fillBuffered( m_RapiditySlot, kin.rapidity, eventWeight );
 
   // kinematic
   if( m_infoSwitch->m_kinematic ) {
-    m_Px->  Fill( partP4.Px(),  eventWeight );
-    m_Py->  Fill( partP4.Py(),  eventWeight );
-    m_Pz->  Fill( partP4.Pz(),  eventWeight );
+    fillBuffered( m_PxSlot, kin.px, eventWeight );
+    fillBuffered( m_PySlot, kin.py, eventWeight );
+    fillBuffered( m_PzSlot, kin.pz, eventWeight );
 
-    m_Et ->        Fill( partP4.Et(),    eventWeight );
-    m_Et_m ->      Fill( partP4.Et(),    eventWeight );
-    m_Et_s ->      Fill( partP4.Et(),    eventWeight );
+    fillBuffered( m_EtBinnings, kin.et,  eventWeight );
   } // fillKinematic
+}
+
+void IParticleHists::fillLeading( const Kinematics& kin, float eventWeight, unsigned int iLeading ) {
+
+  fillBuffered( m_NPtBinnings.at(iLeading), kin.pt, eventWeight );
+  m_NEta.at(iLeading)->        Fill( kin.eta,      eventWeight);
+  m_NPhi.at(iLeading)->        Fill( kin.phi,      eventWeight);
+  m_NM.at(iLeading)->          Fill( kin.m,        eventWeight);
+  m_NE.at(iLeading)->          Fill( kin.e,        eventWeight);
+  m_NRapidity.at(iLeading)->   Fill( kin.rapidity, eventWeight);
+
+  if(m_infoSwitch->m_kinematic){
+    fillBuffered( m_NEtBinnings.at(iLeading), kin.et, eventWeight );
+  }
+}
+
+StatusCode IParticleHists::execute( unsigned int nParticles, const float* pt, const float* eta, const float* phi, const float* mOrE, float eventWeight, bool useMass ) {
+
+  const int numLeading = std::min( m_infoSwitch->m_numLeading, static_cast<int>(nParticles) );
+  for(unsigned int i = 0; i < nParticles; ++i){
+    fillColumnar( pt[i], eta[i], phi[i], mOrE[i], useMass, eventWeight, static_cast<int>(i) < numLeading ? static_cast<int>(i) : -1 );
+  }
+
+  return StatusCode::SUCCESS;
+}
+
+StatusCode IParticleHists::execute( unsigned int nEvents, const unsigned int* offsets, const float* pt, const float* eta, const float* phi, const float* mOrE, const float* eventWeights, bool useMass ) {
+  using namespace msgIParticleHists;
+
+  for(unsigned int iEvent = 0; iEvent < nEvents; ++iEvent){
+    if( offsets[iEvent+1] < offsets[iEvent] ){
+      ANA_MSG_ERROR("Decreasing offsets for event " << iEvent << " of the batch");
+      return StatusCode::FAILURE;
+    }
+    const unsigned int first = offsets[iEvent];
+    ANA_CHECK( this->execute( offsets[iEvent+1] - first, pt + first, eta + first, phi + first, mOrE + first, eventWeights[iEvent], useMass ) );
+  }
 
   return StatusCode::SUCCESS;
 }
 
+StatusCode IParticleHists::execute( const std::vector<float>& pt, const std::vector<float>& eta, const std::vector<float>& phi, const std::vector<float>& mOrE, float eventWeight, bool useMass ) {
+  using namespace msgIParticleHists;
+
+  if( eta.size() != pt.size() || phi.size() != pt.size() || mOrE.size() != pt.size() ){
+    ANA_MSG_ERROR("Branches of different length: pt " << pt.size() << ", eta " << eta.size() << ", phi " << phi.size() << ", m/E " << mOrE.size());
+    return StatusCode::FAILURE;
+  }
+
+  return this->execute( pt.size(), pt.data(), eta.data(), phi.data(), mOrE.data(), eventWeight, useMass );
+}
+
+void IParticleHists::fillColumnar( double pt, double eta, double phi, double mOrE, bool useMass, float eventWeight, int iLeading ) {
+
+  // same conventions as TLorentzVector::SetPtEtaPhiM/E, used by xAH::ParticleContainer
+  Kinematics kin;
+  kin.pt  = pt;
+  kin.eta = eta;
+  kin.phi = phi;
+  kin.pz  = pt*std::sinh(eta);
+  const double p2 = pt*pt + kin.pz*kin.pz;
+  if(useMass){
+    kin.m = mOrE;
+    kin.e = kin.m >= 0 ? std::sqrt(p2 + kin.m*kin.m) : std::sqrt(std::max(p2 - kin.m*kin.m, 0.));
+  } else {
+    kin.e = mOrE;
+    const double m2 = kin.e*kin.e - p2;
+    kin.m = m2 < 0 ? -std::sqrt(-m2) : std::sqrt(m2);
+  }
+  kin.rapidity = 0.5*std::log( (kin.e + kin.pz) / (kin.e - kin.pz) );
+  kin.px = pt*std::cos(phi);
+  kin.py = pt*std::sin(phi);
+  // TLorentzVector::Et
+  kin.et = p2 > 0 ? kin.e*pt/std::sqrt(p2) : 0.;
+
+  fillInclusive( kin, eventWeight );
+  if( iLeading >= 0 ) fillLeading( kin, eventWeight, iLeading );
+}
@@ -31,6 +31,8 @@ EL::StatusCode IParticleHistsAlgo :: histInitialize ()
 
   ANA_MSG_INFO( m_name );
   ANA_CHECK( xAH::Algorithm::algInitialize());
+  // the blocks only become histograms in histFinalize, there is nothing the checkpoints could copy
+  if( m_systematicsBlock ) xAH::HistCheckpoint::addUnregistered( m_name + " (m_systematicsBlock)" );
   return EL::StatusCode::SUCCESS;
 }
 
@@ -39,9 +41,13 @@ EL::StatusCode IParticleHistsAlgo::AddHists( std::string name ) {
   fullname += name; // add systematic
   IParticleHists* particleHists = new IParticleHists( fullname, m_detailStr, m_histPrefix, m_histTitle ); // add systematic
   particleHists->m_debug = msgLvl(MSG::DEBUG);
+  particleHists->setFillBufferSize(m_fillBufferSize);
+  particleHists->setPackedOutput( m_packSystematics && !name.empty() );
   ANA_CHECK( particleHists->initialize());
   particleHists->record( wk() );
   m_plots[name] = particleHists;
+  ANA_CHECK( addHistMemory( *particleHists ));
+  addCheckpoint( particleHists );
 
   return EL::StatusCode::SUCCESS;
 }
@@ -61,7 +67,8 @@ EL::StatusCode IParticleHistsAlgo :: initialize ()
 
 
   // only running 1 collection
-  if(m_inputAlgo.empty()) { AddHists( "" ); }
+  if(m_inputAlgo.empty()) { ANA_CHECK( AddHists( "" )); }
+  reportHistMemory( "initialize", m_histBytes );
   m_event = wk()->xaodEvent();
   m_store = wk()->xaodStore();
   return EL::StatusCode::SUCCESS;
@@ -69,6 +76,9 @@ EL::StatusCode IParticleHistsAlgo :: initialize ()
 
 EL::StatusCode IParticleHistsAlgo :: execute ()
 {
+  auto event = beginEvent();
+  auto timer = timeExecute();
+  if ( eventRejected() ) return EL::StatusCode::SUCCESS;
   return execute<IParticleHists, xAOD::IParticleContainer>();
 }
 
@@ -76,16 +86,74 @@ EL::StatusCode IParticleHistsAlgo :: postExecute () { return EL::StatusCode::SUC
 
 EL::StatusCode IParticleHistsAlgo :: finalize () {
   ANA_MSG_DEBUG( m_name );
+  double histBytes(0);
   for( auto plots : m_plots ) {
-    if(plots.second){
-      plots.second->finalize();
-      delete plots.second;
-    }
+    if(plots.second) histBytes += plots.second->memoryBytes();
+  }
+  reportHistMemory( "finalize", histBytes );
+
+  for( auto plots : m_plots ) {
+    if(plots.second) plots.second->finalize();
   }
+  if( m_packSystematics ) packSystematics();
+
+  for( auto plots : m_plots ) delete plots.second;
   return EL::StatusCode::SUCCESS;
 }
 
+void IParticleHistsAlgo::fillSystematicBlocks( const std::string& systName, const xAOD::IParticleContainer* particles, float eventWeight ) {
+  if( m_systBlocks.empty() ){
+    m_systBlocks.emplace_back( "Pt",   "p_{T} [GeV]", 100, 0, 1000. );
+    m_systBlocks.emplace_back( "Eta",  "#eta",         98, -4.9, 4.9 );
+    m_systBlocks.emplace_back( "Phi",  "Phi",         120, -TMath::Pi(), TMath::Pi() );
+    m_systBlocks.emplace_back( "Mass", "Mass [GeV]",  120, 0, 400 );
+  }
+
+  auto it = m_systBlockIndex.find( systName );
+  if( it == m_systBlockIndex.end() ){
+    it = m_systBlockIndex.insert( std::make_pair( systName, m_systBlockNames.size() ) ).first;
+    m_systBlockNames.push_back( systName );
+    for( auto& block : m_systBlocks ) block.resize( m_systBlockNames.size() );
+  }
+  const unsigned int variation = it->second;
+
+  for( const xAOD::IParticle* particle : *particles ){
+    m_systBlocks[0].fill( variation, particle->pt()/1e3, eventWeight );
+    m_systBlocks[1].fill( variation, particle->eta(),    eventWeight );
+    m_systBlocks[2].fill( variation, particle->phi(),    eventWeight );
+    m_systBlocks[3].fill( variation, particle->m()/1e3,  eventWeight );
+  }
+}
+
+void IParticleHistsAlgo::packSystematics() {
+  if( m_plots.size() < 2 ) return;
+
+  // the map is sorted by the name of the systematic, the nominal ("") comes first
+  std::vector< std::string > labels;
+  std::vector< std::string > names;
+  std::map< std::string, std::vector<const TH1*> > variations;
+  for( auto plots : m_plots ) {
+    if( !plots.second ) continue;
+    for( const auto& hist : plots.second->packableHists() ){
+      auto& hists = variations[hist.first];
+      if( hists.empty() ) names.push_back( hist.first );
+      hists.resize( labels.size()+1, nullptr );
+      hists.back() = hist.second;
+    }
+    labels.push_back( plots.first.empty() ? "nominal" : plots.first );
+  }
+
+  for( const auto& name : names ){
+    auto& hists = variations[name];
+    hists.resize( labels.size(), nullptr );
+    wk()->addOutput( HistogramManager::packVariations( m_name + "_packed/" + name, hists, labels ) );
+  }
+}
+
 EL::StatusCode IParticleHistsAlgo :: histFinalize () {
+  for( const auto& block : m_systBlocks ){
+    wk()->addOutput( block.makeHist( m_name + "_systematics/", m_systBlockNames ) );
+  }
   ANA_CHECK( xAH::Algorithm::algFinalize());
   return EL::StatusCode::SUCCESS;
 }
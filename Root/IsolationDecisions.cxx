@@ -0,0 +1,43 @@
+#include <xAODAnaHelpers/IsolationDecisions.h>
+#include <xAODAnaHelpers/SelectionFlags.h>
+
+namespace {
+
+  /// @brief a working point unknown to the tool fails, as for ``TAccept::getCutResult(name)``
+  bool result(const Root::TAccept& accept, unsigned int position)
+  {
+    return position < accept.getNCuts() && accept.getCutResult(position);
+  }
+
+}
+
+void xAH::IsolationDecisions::setWPs(const std::vector<std::string>& wps, const std::string& cutWP)
+{
+  m_wps   = wps;
+  m_cutWP = cutWP;
+  m_decorators.clear();
+  m_flagBits.clear();
+  for(const std::string& wp : m_wps){
+    m_decorators.emplace_back("isIsolated_" + wp);
+    m_flagBits.push_back( xAH::SelectionFlags::bit("isIsolated_" + wp) );
+  }
+  m_positions.clear();
+  m_hasPositions = false;
+}
+
+bool xAH::IsolationDecisions::decorate(const SG::AuxElement& obj, const Root::TAccept& accept)
+{
+  if(!m_hasPositions){
+    for(const std::string& wp : m_wps) m_positions.push_back( accept.getCutPosition(wp) );
+    if(!m_cutWP.empty()) m_cutPosition = accept.getCutPosition(m_cutWP);
+    m_hasPositions = true;
+  }
+
+  for(unsigned int i = 0; i < m_decorators.size(); ++i){
+    const bool isIsolated = result(accept, m_positions[i]);
+    m_decorators[i](obj) = static_cast<char>( isIsolated );
+    xAH::SelectionFlags::set( obj, m_flagBits[i], isIsolated );
+  }
+
+  return m_cutWP.empty() || result(accept, m_cutPosition);
+}
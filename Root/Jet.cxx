@@ -7,64 +7,64 @@ int Jet::is_btag(BTaggerOP op) const
   switch(op)
     {
     case Jet::BTaggerOP::DL1_FixedCutBEff_60:
-      return is_DL1_FixedCutBEff_60;
+      return btag->is_DL1_FixedCutBEff_60;
       break;
     case Jet::BTaggerOP::DL1_FixedCutBEff_70:
-      return is_DL1_FixedCutBEff_70;
+      return btag->is_DL1_FixedCutBEff_70;
       break;
     case Jet::BTaggerOP::DL1_FixedCutBEff_77:
-      return is_DL1_FixedCutBEff_77;
+      return btag->is_DL1_FixedCutBEff_77;
       break;
     case Jet::BTaggerOP::DL1_FixedCutBEff_85:
-      return is_DL1_FixedCutBEff_85;
+      return btag->is_DL1_FixedCutBEff_85;
       break;      
     case Jet::BTaggerOP::DL1r_FixedCutBEff_60:
-      return is_DL1r_FixedCutBEff_60;
+      return btag->is_DL1r_FixedCutBEff_60;
       break;
     case Jet::BTaggerOP::DL1r_FixedCutBEff_70:
-      return is_DL1r_FixedCutBEff_70;
+      return btag->is_DL1r_FixedCutBEff_70;
       break;
     case Jet::BTaggerOP::DL1r_FixedCutBEff_77:
-      return is_DL1r_FixedCutBEff_77;
+      return btag->is_DL1r_FixedCutBEff_77;
       break;
     case Jet::BTaggerOP::DL1r_FixedCutBEff_85:
-      return is_DL1r_FixedCutBEff_85;
+      return btag->is_DL1r_FixedCutBEff_85;
       break;
     case Jet::BTaggerOP::DL1rmu_FixedCutBEff_60:
-      return is_DL1rmu_FixedCutBEff_60;
+      return btag->is_DL1rmu_FixedCutBEff_60;
       break;
     case Jet::BTaggerOP::DL1rmu_FixedCutBEff_70:
-      return is_DL1rmu_FixedCutBEff_70;
+      return btag->is_DL1rmu_FixedCutBEff_70;
       break;
     case Jet::BTaggerOP::DL1rmu_FixedCutBEff_77:
-      return is_DL1rmu_FixedCutBEff_77;
+      return btag->is_DL1rmu_FixedCutBEff_77;
       break;
     case Jet::BTaggerOP::DL1rmu_FixedCutBEff_85:
-      return is_DL1rmu_FixedCutBEff_85;
+      return btag->is_DL1rmu_FixedCutBEff_85;
       break;
     case Jet::BTaggerOP::MV2c10_FixedCutBEff_60:
-      return is_MV2c10_FixedCutBEff_60;
+      return btag->is_MV2c10_FixedCutBEff_60;
       break;
     case Jet::BTaggerOP::MV2c10_FixedCutBEff_70:
-      return is_MV2c10_FixedCutBEff_70;
+      return btag->is_MV2c10_FixedCutBEff_70;
       break;
     case Jet::BTaggerOP::MV2c10_FixedCutBEff_77:
-      return is_MV2c10_FixedCutBEff_77;
+      return btag->is_MV2c10_FixedCutBEff_77;
       break;
     case Jet::BTaggerOP::MV2c10_FixedCutBEff_85:
-      return is_MV2c10_FixedCutBEff_85;
+      return btag->is_MV2c10_FixedCutBEff_85;
       break;
     case Jet::BTaggerOP::DL1_Continuous:
-      return is_DL1_Continuous;
+      return btag->is_DL1_Continuous;
       break;
     case Jet::BTaggerOP::DL1r_Continuous:
-      return is_DL1r_Continuous;
+      return btag->is_DL1r_Continuous;
       break;
     case Jet::BTaggerOP::DL1rmu_Continuous:
-      return is_DL1rmu_Continuous;
+      return btag->is_DL1rmu_Continuous;
       break;
     case Jet::BTaggerOP::MV2c10_Continuous:
-      return is_MV2c10_Continuous;
+      return btag->is_MV2c10_Continuous;
       break;      
     default:
       return 0;
@@ -77,64 +77,64 @@ const std::vector<float>& Jet::SF_btag(BTaggerOP op) const
   switch(op)
     {
     case Jet::BTaggerOP::DL1_FixedCutBEff_60:
-      return SF_DL1_FixedCutBEff_60;
+      return btag->SF_DL1_FixedCutBEff_60;
       break;
     case Jet::BTaggerOP::DL1_FixedCutBEff_70:
-      return SF_DL1_FixedCutBEff_70;
+      return btag->SF_DL1_FixedCutBEff_70;
       break;
     case Jet::BTaggerOP::DL1_FixedCutBEff_77:
-      return SF_DL1_FixedCutBEff_77;
+      return btag->SF_DL1_FixedCutBEff_77;
       break;
     case Jet::BTaggerOP::DL1_FixedCutBEff_85:
-      return SF_DL1_FixedCutBEff_85;
+      return btag->SF_DL1_FixedCutBEff_85;
       break;      
     case Jet::BTaggerOP::DL1r_FixedCutBEff_60:
-      return SF_DL1r_FixedCutBEff_60;
+      return btag->SF_DL1r_FixedCutBEff_60;
       break;
     case Jet::BTaggerOP::DL1r_FixedCutBEff_70:
-      return SF_DL1r_FixedCutBEff_70;
+      return btag->SF_DL1r_FixedCutBEff_70;
       break;
     case Jet::BTaggerOP::DL1r_FixedCutBEff_77:
-      return SF_DL1r_FixedCutBEff_77;
+      return btag->SF_DL1r_FixedCutBEff_77;
       break;
     case Jet::BTaggerOP::DL1r_FixedCutBEff_85:
-      return SF_DL1r_FixedCutBEff_85;
+      return btag->SF_DL1r_FixedCutBEff_85;
       break;
     case Jet::BTaggerOP::DL1rmu_FixedCutBEff_60:
-      return SF_DL1rmu_FixedCutBEff_60;
+      return btag->SF_DL1rmu_FixedCutBEff_60;
       break;
     case Jet::BTaggerOP::DL1rmu_FixedCutBEff_70:
-      return SF_DL1rmu_FixedCutBEff_70;
+      return btag->SF_DL1rmu_FixedCutBEff_70;
       break;
     case Jet::BTaggerOP::DL1rmu_FixedCutBEff_77:
-      return SF_DL1rmu_FixedCutBEff_77;
+      return btag->SF_DL1rmu_FixedCutBEff_77;
       break;
     case Jet::BTaggerOP::DL1rmu_FixedCutBEff_85:
-      return SF_DL1rmu_FixedCutBEff_85;
+      return btag->SF_DL1rmu_FixedCutBEff_85;
       break;
     case Jet::BTaggerOP::MV2c10_FixedCutBEff_60:
-      return SF_MV2c10_FixedCutBEff_60;
+      return btag->SF_MV2c10_FixedCutBEff_60;
       break;
     case Jet::BTaggerOP::MV2c10_FixedCutBEff_70:
-      return SF_MV2c10_FixedCutBEff_70;
+      return btag->SF_MV2c10_FixedCutBEff_70;
       break;
     case Jet::BTaggerOP::MV2c10_FixedCutBEff_77:
-      return SF_MV2c10_FixedCutBEff_77;
+      return btag->SF_MV2c10_FixedCutBEff_77;
       break;
     case Jet::BTaggerOP::MV2c10_FixedCutBEff_85:
-      return SF_MV2c10_FixedCutBEff_85;
+      return btag->SF_MV2c10_FixedCutBEff_85;
       break;
     case Jet::BTaggerOP::DL1_Continuous:
-      return SF_DL1_Continuous;
+      return btag->SF_DL1_Continuous;
       break;
     case Jet::BTaggerOP::DL1r_Continuous:
-      return SF_DL1r_Continuous;
+      return btag->SF_DL1r_Continuous;
       break;
     case Jet::BTaggerOP::DL1rmu_Continuous:
-      return SF_DL1rmu_Continuous;
+      return btag->SF_DL1rmu_Continuous;
       break;
     case Jet::BTaggerOP::MV2c10_Continuous:
-      return SF_MV2c10_Continuous;
+      return btag->SF_MV2c10_Continuous;
       break;      
     default:
       static const std::vector<float> dummySF = {1.};
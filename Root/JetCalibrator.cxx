@@ -8,7 +8,9 @@
  ******************************************/
 
 // c++ include(s):
+#include <algorithm>
 #include <iostream>
+#include <sstream>
 
 // EL include(s):
 #include <EventLoop/Job.h>
@@ -29,6 +31,7 @@
 // package include(s):
 #include "xAODAnaHelpers/HelperFunctions.h"
 #include "xAODAnaHelpers/JetCalibrator.h"
+#include "xAODAnaHelpers/JetSelector.h"
 
 // ROOT includes:
 #include "TSystem.h"
@@ -260,8 +263,15 @@ EL::StatusCode JetCalibrator :: initialize ()
         ANA_CHECK( this_JetCleaningTool_handle.retrieve());
         ANA_MSG_DEBUG("Retrieved tool: " << this_JetCleaningTool_handle);
         m_AllJetCleaningTool_handles.push_back( this_JetCleaningTool_handle );
+        m_cleanPassDecorators.emplace_back( "clean_pass"+m_decisionNames.at(iD) );
       }// For each cleaning decision
     }//If save all cleaning decisions
+
+    std::stringstream ss(m_cleanRecomputeSysts);
+    std::string thisSyst;
+    while ( std::getline(ss, thisSyst, ',') ) {
+      if ( !thisSyst.empty() ) m_cleanRecomputeSystList.push_back( thisSyst );
+    }
   }// if m_doCleaning
 
   // initialize largeR jet truth labelling tool
@@ -302,6 +312,21 @@ EL::StatusCode JetCalibrator :: initialize ()
       initializeUncertaintiesTool(m_JetUncertaintiesTool_handle, !isMC());
     }
 
+    // one private copy of the tools per additional thread for the systematic-parallel mode
+    if ( systThreads() > 1 ) {
+      ANA_MSG_INFO("Evaluating jet systematics on " << systThreads() << " threads");
+      m_JetUncertaintiesTool_clones.reserve(systThreads()-1);
+      if(m_mcAndPseudoData) m_pseudodataJERTool_clones.reserve(systThreads()-1);
+      for(unsigned int slot = 1; slot < systThreads(); ++slot){
+        m_JetUncertaintiesTool_clones.emplace_back("JetUncertaintiesTool_"+std::to_string(slot), this);
+        if(m_mcAndPseudoData) m_pseudodataJERTool_clones.emplace_back("PseudodataJERTool_"+std::to_string(slot), this);
+      }
+      // same IsData choice as for m_JetUncertaintiesTool_handle above
+      const bool uncertIsData = m_mcAndPseudoData ? false : (m_pseudoData ? true : !isMC());
+      for(auto& clone : m_JetUncertaintiesTool_clones) ANA_CHECK( initializeUncertaintiesTool(clone, uncertIsData) );
+      for(auto& clone : m_pseudodataJERTool_clones) ANA_CHECK( initializeUncertaintiesTool(clone, true) );
+    }
+
     //
     // Get a list of recommended systematics for this tool
     //
@@ -316,7 +341,7 @@ EL::StatusCode JetCalibrator :: initialize ()
     }
 
     for(unsigned int iSyst=0; iSyst < m_systValVector.size(); ++iSyst){
-      std::vector<CP::SystematicSet> sysList = HelperFunctions::getListofSystematics( recSysts, m_systName, m_systValVector.at(iSyst), msg() );
+      const std::vector<CP::SystematicSet>& sysList = *HelperFunctions::getSharedListofSystematics( recSysts, m_systName, m_systValVector.at(iSyst), msg() );
 
       for(unsigned int i=0; i < sysList.size(); ++i){
         // do not add another nominal syst to the list!!
@@ -390,6 +415,9 @@ EL::StatusCode JetCalibrator :: initialize ()
 
 EL::StatusCode JetCalibrator :: execute ()
 {
+  auto event = beginEvent();
+  auto timer = timeExecute();
+  if ( eventRejected() ) return EL::StatusCode::SUCCESS;
   // Here you do everything that needs to be done on every single
   // events, e.g. read input variables, apply cuts, and fill
   // histograms and trees.  This is where most of your actual analysis
@@ -398,6 +426,15 @@ EL::StatusCode JetCalibrator :: execute ()
   ANA_MSG_DEBUG("Applying Jet Calibration and Cleaning... ");
 
   m_numEvent++;
+  m_nominalDecorated = false;
+  m_sameAsNominal.clear();
+
+  // the selectors are all initialized by now
+  if ( m_numEvent == 1 ) {
+    m_fusedSelector = JetSelector::fusedSelector( m_outContainerName, m_outputAlgo );
+    if ( m_fusedSelector ) ANA_MSG_INFO( "Running the selection of " << m_fusedSelector->m_name << " on each variation right after calibrating it");
+  }
+  if ( m_fusedSelector ) ANA_CHECK( m_fusedSelector->beginFusedEvent( m_findSameAsNominalSysts ) );
 
   // get the collection from TEvent or TStore
   const xAOD::JetContainer* inJets(nullptr);
@@ -421,52 +458,46 @@ EL::StatusCode JetCalibrator :: execute ()
   ANA_CHECK( m_store->record( calibJetsSC.first,  outSCContainerName));
   ANA_CHECK( m_store->record( calibJetsSC.second, outSCAuxContainerName));
 
-  for ( auto jet_itr : *(calibJetsSC.first) ) {
-    m_numObject++;
-
-    //
-    // truth labelling for systematics
-    if(isMC()){
-      
-      if(m_runSysts){
-
-        // b-jet truth labelling
-        int this_TruthLabel = 0;
-
-        static SG::AuxElement::ConstAccessor<int> TruthLabelID ("TruthLabelID");
-        static SG::AuxElement::ConstAccessor<int> PartonTruthLabelID ("PartonTruthLabelID");
-
-        if ( TruthLabelID.isAvailable( *jet_itr) ) {
-          this_TruthLabel = TruthLabelID( *jet_itr );
-          if (this_TruthLabel == 21 || this_TruthLabel<4) this_TruthLabel = 0;
-        } else if(PartonTruthLabelID.isAvailable( *jet_itr) ) {
-          this_TruthLabel = PartonTruthLabelID( *jet_itr );
-          if (this_TruthLabel == 21 || this_TruthLabel<4) this_TruthLabel = 0;
-        }
+  m_numObject += calibJetsSC.first->size();
 
-        bool isBjet = false; // decide whether or not the jet is a b-jet (truth-labelling + kinematic selections)
-        if (this_TruthLabel == 5) isBjet = true;
-        static SG::AuxElement::Decorator<char> accIsBjet("IsBjet"); // char due to limitations of ROOT I/O, still treat it as a bool
-        accIsBjet(*jet_itr) = isBjet;
+  // the bookkeeping and each tool run as separate passes over the container
 
-      } 
+  //
+  // truth labelling for systematics
+  if ( isMC() && m_runSysts ) {
+    static SG::AuxElement::ConstAccessor<int> TruthLabelID ("TruthLabelID");
+    static SG::AuxElement::ConstAccessor<int> PartonTruthLabelID ("PartonTruthLabelID");
+    static SG::AuxElement::Decorator<char> accIsBjet("IsBjet"); // char due to limitations of ROOT I/O, still treat it as a bool
+
+    for ( auto jet_itr : *(calibJetsSC.first) ) {
+      // b-jet truth labelling
+      int this_TruthLabel = 0;
+      if ( TruthLabelID.isAvailable( *jet_itr) ) {
+        this_TruthLabel = TruthLabelID( *jet_itr );
+      } else if(PartonTruthLabelID.isAvailable( *jet_itr) ) {
+        this_TruthLabel = PartonTruthLabelID( *jet_itr );
+      }
+      accIsBjet(*jet_itr) = (this_TruthLabel == 5);
     }
+  }
 
-    //
-    // the calibration
+  //
+  // the calibration
+  for ( auto jet_itr : *(calibJetsSC.first) ) {
     if ( m_JetCalibrationTool_handle->applyCorrection( *jet_itr ) == CP::CorrectionCode::Error ) {
       ANA_MSG_ERROR( "JetCalibration tool reported a CP::CorrectionCode::Error");
       ANA_MSG_ERROR( m_name );
       return StatusCode::FAILURE;
     }
+  }
 
-    if(m_doJetTileCorr && !isMC()){
+  if ( m_doJetTileCorr && !isMC() ) {
+    for ( auto jet_itr : *(calibJetsSC.first) ) {
       if( m_JetTileCorrectionTool_handle->applyCorrection(*jet_itr) == CP::CorrectionCode::Error ){
         ANA_MSG_ERROR( "JetTileCorrection tool reported a CP::CorrectionCode::Error");
       }
     }
-
-  }//for jets
+  }
 
   if(isMC() && m_useLargeRTruthLabelingTool && m_JetTruthLabelingTool_handle.isInitialized()){
     // largeR jet truth labelling
@@ -476,18 +507,55 @@ EL::StatusCode JetCalibrator :: execute ()
   // loop over available systematics - remember syst == "Nominal" --> baseline
   auto vecOutContainerNames = std::make_unique< std::vector< std::string > >();
 
+  // the variations to produce, in output order: (systematic, is pseudodata copy)
+  xAH::ArenaVector< std::pair<const CP::SystematicSet*, bool> > variations;
   for ( const auto& syst_it : m_systList ) {
-
-    executeSystematic(syst_it, inJets, calibJetsSC, *vecOutContainerNames, false);
+    variations.emplace_back(&syst_it, false);
 
     if(m_mcAndPseudoData && std::string(syst_it.name()).find("JER") != std::string::npos) {
       // This is a JER uncertainty that also needs a pseudodata copy done.
-      executeSystematic(syst_it, inJets, calibJetsSC, *vecOutContainerNames, true);
+      variations.emplace_back(&syst_it, true);
+    }
+  }
+  vecOutContainerNames->reserve( variations.size() );
+
+  if ( m_runSysts && systThreads() > 1 ) {
+    // Apply the uncertainties in parallel, then finish and record every variation serially in the original order.
+    // The nominal variation modifies calibJetsSC in place, which all other variations are copied from, so it is done first.
+    for ( const auto& variation : variations ) {
+      if ( !variation.first->name().empty() ) continue;
+      ANA_CHECK( applyUncertainties(*variation.first, *calibJetsSC.first, uncertaintiesTool(variation.second, 0)) );
+    }
+    // the tools may read any variable of the jets, which must not trigger reading the input file from the threads
+    HelperFunctions::readAllAuxData( *inJets );
+    // the copies are owned here until recorded, and the errors are printed from this thread only
+    xAH::ArenaVector< VariedJets_t > variedJetsSC(variations.size());
+    xAH::ArenaVector< std::vector<std::string> > errors(variations.size());
+    const StatusCode applied = forEachSystematic(variations.size(), [&](unsigned int i, unsigned int slot) -> StatusCode {
+      if ( variations.at(i).first->name().empty() ) return StatusCode::SUCCESS;
+      variedJetsSC.at(i) = copyJets( *calibJetsSC.first );
+      return applyUncertainties(*variations.at(i).first, *variedJetsSC.at(i).first, uncertaintiesTool(variations.at(i).second, slot), &errors.at(i));
+    });
+    for ( const auto& variationErrors : errors ) {
+      for ( const std::string& error : variationErrors ) ANA_MSG_ERROR( error );
+    }
+    ANA_CHECK( applied );
+    for ( unsigned int i = 0; i < variations.size(); ++i ) {
+      ANA_CHECK( executeSystematic(*variations.at(i).first, inJets, calibJetsSC, *vecOutContainerNames, variations.at(i).second, &variedJetsSC.at(i) ) );
+    }
+  } else {
+    for ( const auto& variation : variations ) {
+      ANA_CHECK( executeSystematic(*variation.first, inJets, calibJetsSC, *vecOutContainerNames, variation.second ) );
     }
   }
 
   // add vector of systematic names to TStore
   ANA_CHECK( m_store->record( std::move(vecOutContainerNames), m_outputAlgo));
+  if ( m_findSameAsNominalSysts ) {
+    ANA_CHECK( m_store->record( std::make_unique< std::vector< std::string > >(m_sameAsNominal), HelperFunctions::sameAsNominalName(m_outputAlgo)));
+  }
+
+  if ( m_fusedSelector ) ANA_CHECK( m_fusedSelector->endFusedEvent() );
 
   // look what do we have in TStore
 
@@ -500,6 +568,8 @@ EL::StatusCode JetCalibrator :: execute ()
 
 EL::StatusCode JetCalibrator :: postExecute ()
 {
+  auto timer = timePostExecute();
+  if ( eventRejected() ) return EL::StatusCode::SUCCESS;
   // Here you do everything that needs to be done after the main event
   // processing.  This is typically very rare, particularly in user
   // code.  It is mainly used in implementing the NTupleSvc.
@@ -548,12 +618,12 @@ EL::StatusCode JetCalibrator :: histFinalize ()
 
 EL::StatusCode JetCalibrator::executeSystematic(const CP::SystematicSet& thisSyst, const xAOD::JetContainer* inJets,
                                                 std::pair<xAOD::JetContainer*, xAOD::ShallowAuxContainer*>& calibJetsSC,
-                                                std::vector<std::string>& vecOutContainerNames, bool isPDCopy){
+                                                std::vector<std::string>& vecOutContainerNames, bool isPDCopy,
+                                                VariedJets_t* variedJetsSC){
 
   bool nominal = thisSyst.name().empty();
 
   std::string outSCContainerName, outSCAuxContainerName, outContainerName;
-  asg::AnaToolHandle<ICPJetUncertaintiesTool>* jetUncTool(nullptr);
 
   // always append the name of the variation, including nominal which is an empty string
   if(isPDCopy){
@@ -561,55 +631,59 @@ EL::StatusCode JetCalibrator::executeSystematic(const CP::SystematicSet& thisSys
     outSCAuxContainerName = m_outContainerName+thisSyst.name()+"_PDShallowCopyAux.";
     outContainerName      = m_outContainerName+thisSyst.name()+"_PD";
     vecOutContainerNames.push_back(thisSyst.name()+"_PD");
-    jetUncTool = &m_pseudodataJERTool_handle;
   }
   else{
     outSCContainerName    = m_outContainerName+thisSyst.name()+"ShallowCopy";
     outSCAuxContainerName = m_outContainerName+thisSyst.name()+"ShallowCopyAux.";
     outContainerName      = m_outContainerName+thisSyst.name();
     vecOutContainerNames.push_back(thisSyst.name());
-    jetUncTool = &m_JetUncertaintiesTool_handle;
   }
 
-  // create shallow copy;
-  std::pair< xAOD::JetContainer*, xAOD::ShallowAuxContainer* > uncertCalibJetsSC = nominal ? calibJetsSC : xAOD::shallowCopyContainer(*calibJetsSC.first);
-  ConstDataVector<xAOD::JetContainer>* uncertCalibJetsCDV = new ConstDataVector<xAOD::JetContainer>(SG::VIEW_ELEMENTS);
-  uncertCalibJetsCDV->reserve( uncertCalibJetsSC.first->size() );
-
-  //Apply Uncertainties
-  if ( m_runSysts ) {
-    // Jet Uncertainty Systematic
+  // create shallow copy and apply uncertainties, unless already done in the systematic-parallel mode; nominal is varied in place
+  const bool uncertaintiesApplied = variedJetsSC != nullptr;
+  VariedJets_t ownedJetsSC;
+  if ( !uncertaintiesApplied ) {
+    variedJetsSC = &ownedJetsSC;
+    if ( !nominal ) ownedJetsSC = copyJets( *calibJetsSC.first );
+  }
+  xAOD::JetContainer* uncertJets = nominal ? calibJetsSC.first : variedJetsSC->first.get();
+  if ( !uncertaintiesApplied ) {
     ANA_MSG_DEBUG("Configure for systematic variation : " << thisSyst.name());
-    if ( (*jetUncTool)->applySystematicVariation(thisSyst) != CP::SystematicCode::Ok ) {
-      ANA_MSG_ERROR( "Cannot configure JetUncertaintiesTool for systematic " << m_systName);
-      return EL::StatusCode::FAILURE;
-    }
-
-    for ( auto jet_itr : *(uncertCalibJetsSC.first) ) {
-      if (m_applyFatJetPreSel) {
-        bool validForJES = (jet_itr->pt() >= 150e3 && jet_itr->pt() < 3000e3);
-        validForJES &= (jet_itr->m()/jet_itr->pt() >= 0 && jet_itr->m()/jet_itr->pt() < 1);
-        validForJES &= (fabs(jet_itr->eta()) < 2);
-        if (!validForJES) continue;
-      }
+    ANA_CHECK( applyUncertainties(thisSyst, *uncertJets, uncertaintiesTool(isPDCopy, 0)) );
+  }
 
-      if ( (*jetUncTool)->applyCorrection( *jet_itr ) == CP::CorrectionCode::Error ) {
-        ANA_MSG_ERROR( "JetUncertaintiesTool reported a CP::CorrectionCode::Error");
-        ANA_MSG_ERROR( m_name );
-      }
-    }
+  // a variation which does not move any jet of this event gives the same selection as nominal downstream
+  bool sameAsNominal(false);
+  if ( m_findSameAsNominalSysts && !nominal && m_nominalDecorated && HelperFunctions::sameFourMomenta(*uncertJets, *calibJetsSC.first) ) {
+    m_sameAsNominal.push_back( vecOutContainerNames.back() );
+    sameAsNominal = true;
+  }
 
-  }// if m_runSysts
+  ConstDataVector<xAOD::JetContainer>* uncertCalibJetsCDV = new ConstDataVector<xAOD::JetContainer>(SG::VIEW_ELEMENTS);
+  uncertCalibJetsCDV->reserve( uncertJets->size() );
+
+  // a variation copied from the nominal jets after they were decorated reads the decorations which
+  // do not depend on the variation from them: the original object links and, when the decision is
+  // made on the parent jet, the cleaning decisions
+  const bool readFromNominal = !nominal && m_nominalDecorated && !uncertaintiesApplied;
+
+  // with m_cleanFromNominal the cleaning inputs are taken as untouched by the variation, unless it is listed in m_cleanRecomputeSysts
+  bool cleanFromNominal = readFromNominal && m_cleanParent;
+  if ( readFromNominal && m_cleanFromNominal && !cleanFromNominal ) {
+    cleanFromNominal = std::none_of( m_cleanRecomputeSystList.begin(), m_cleanRecomputeSystList.end(),
+                                     [&thisSyst](const std::string& recomputeSyst){ return thisSyst.name().find(recomputeSyst) != std::string::npos; } );
+  }
 
-  if(m_doCleaning){
+  if(m_doCleaning && !cleanFromNominal){
     // decorate with cleaning decision
-    for ( auto jet_itr : *(uncertCalibJetsSC.first) ) {
+    for ( auto jet_itr : *uncertJets ) {
 
       static SG::AuxElement::Decorator< int > isCleanDecor( "cleanJet" );
+      static const SG::AuxElement::ConstAccessor< ElementLink<xAOD::JetContainer> > parentLink( "Parent" );
       const xAOD::Jet* jetToClean = jet_itr;
 
       if(m_cleanParent){
-        ElementLink<xAOD::JetContainer> el_parent = jet_itr->auxdata<ElementLink<xAOD::JetContainer> >("Parent") ;
+        const ElementLink<xAOD::JetContainer>& el_parent = parentLink(*jet_itr);
         if(!el_parent.isValid())
           ANA_MSG_ERROR( "Could not make jet cleaning decision on the parent! It doesn't exist.");
         else
@@ -620,49 +694,98 @@ EL::StatusCode JetCalibrator::executeSystematic(const CP::SystematicSet& thisSys
 
       if( m_saveAllCleanDecisions ){
         for(unsigned int i=0; i < m_AllJetCleaningTool_handles.size() ; ++i){
-          jet_itr->auxdata< int >(("clean_pass"+m_decisionNames.at(i)).c_str()) = m_AllJetCleaningTool_handles.at(i)->keep(*jetToClean);
+          m_cleanPassDecorators.at(i)(*jet_itr) = m_AllJetCleaningTool_handles.at(i)->keep(*jetToClean);
         }
       }
     } //end cleaning decision
   }
 
-  if ( !xAOD::setOriginalObjectLink(*inJets, *(uncertCalibJetsSC.first)) ) {
+  if ( !readFromNominal && !xAOD::setOriginalObjectLink(*inJets, *uncertJets) ) {
     ANA_MSG_ERROR( "Failed to set original object links -- MET rebuilding cannot proceed.");
   }
+  if ( nominal ) m_nominalDecorated = true;
 
   // Recalculate JVT using calibrated Jets
   if(m_redoJVT){
-    for ( auto jet_itr : *(uncertCalibJetsSC.first) ) {
+    for ( auto jet_itr : *uncertJets ) {
       jet_itr->auxdata< float >("Jvt") = m_JVTUpdateTool_handle->updateJvt(*jet_itr);
     }
   }
 
   // Calculate fJVT using calibrated Jets
   if ( m_calculatefJVT ) {
-    m_fJVTTool_handle->modify(*(uncertCalibJetsSC.first));
+    m_fJVTTool_handle->modify(*uncertJets);
   }
 
   // save pointers in ConstDataVector with same order
-  for ( auto jet_itr : *(uncertCalibJetsSC.first) ) {
+  for ( auto jet_itr : *uncertJets ) {
     uncertCalibJetsCDV->push_back( jet_itr );
   }
 
   // can only sort the CDV - a bit no-no to sort the shallow copies
   if ( m_sort ) {
-    std::sort( uncertCalibJetsCDV->begin(), uncertCalibJetsCDV->end(), HelperFunctions::sort_pt );
+    HelperFunctions::sortPt( uncertCalibJetsCDV->begin(), uncertCalibJetsCDV->end() );
   }
 
   // add shallow copy to TStore
   if(!nominal){ // nominal is always saved outside of systematics loop
-    ANA_CHECK( m_store->record( uncertCalibJetsSC.first, outSCContainerName));
-    ANA_CHECK( m_store->record( uncertCalibJetsSC.second, outSCAuxContainerName));
+    ANA_CHECK( m_store->record( std::move(variedJetsSC->first), outSCContainerName));
+    ANA_CHECK( m_store->record( std::move(variedJetsSC->second), outSCAuxContainerName));
   }
   // add ConstDataVector to TStore
   ANA_CHECK( m_store->record( uncertCalibJetsCDV, outContainerName));
+
+  // select this variation while its jets are still in the cache
+  if ( m_fusedSelector ) ANA_CHECK( m_fusedSelector->selectVariation( uncertCalibJetsCDV->asDataVector(), vecOutContainerNames.back(), sameAsNominal ) );
   
   return EL::StatusCode::SUCCESS;
 }
 
+EL::StatusCode JetCalibrator::applyUncertainties(const CP::SystematicSet& thisSyst, xAOD::JetContainer& jets,
+                                                 asg::AnaToolHandle<ICPJetUncertaintiesTool>& jetUncTool,
+                                                 std::vector<std::string>* errors){
+
+  //Apply Uncertainties
+  if ( !m_runSysts ) return EL::StatusCode::SUCCESS;
+
+  auto reportError = [&](const std::string& error){
+    if ( errors ) errors->push_back( error );
+    else          ANA_MSG_ERROR( error );
+  };
+
+  // Jet Uncertainty Systematic
+  if ( jetUncTool->applySystematicVariation(thisSyst) != CP::SystematicCode::Ok ) {
+    reportError( "Cannot configure JetUncertaintiesTool for systematic " + thisSyst.name() );
+    return EL::StatusCode::FAILURE;
+  }
+
+  for ( auto jet_itr : jets ) {
+    if (m_applyFatJetPreSel) {
+      bool validForJES = (jet_itr->pt() >= 150e3 && jet_itr->pt() < 3000e3);
+      validForJES &= (jet_itr->m()/jet_itr->pt() >= 0 && jet_itr->m()/jet_itr->pt() < 1);
+      validForJES &= (fabs(jet_itr->eta()) < 2);
+      if (!validForJES) continue;
+    }
+
+    if ( jetUncTool->applyCorrection( *jet_itr ) == CP::CorrectionCode::Error ) {
+      reportError( "JetUncertaintiesTool reported a CP::CorrectionCode::Error" );
+      reportError( m_name );
+    }
+  }
+
+  return EL::StatusCode::SUCCESS;
+}
+
+JetCalibrator::VariedJets_t JetCalibrator::copyJets(const xAOD::JetContainer& jets){
+  std::pair< xAOD::JetContainer*, xAOD::ShallowAuxContainer* > copy = xAOD::shallowCopyContainer( jets );
+  return VariedJets_t( std::unique_ptr<xAOD::JetContainer>(copy.first), std::unique_ptr<xAOD::ShallowAuxContainer>(copy.second) );
+}
+
+asg::AnaToolHandle<ICPJetUncertaintiesTool>& JetCalibrator::uncertaintiesTool(bool isPDCopy, unsigned int slot){
+  if ( slot == 0 ) return isPDCopy ? m_pseudodataJERTool_handle : m_JetUncertaintiesTool_handle;
+  return isPDCopy ? m_pseudodataJERTool_clones.at(slot-1) : m_JetUncertaintiesTool_clones.at(slot-1);
+}
+
 EL::StatusCode JetCalibrator::initializeUncertaintiesTool(asg::AnaToolHandle<ICPJetUncertaintiesTool>& uncToolHandle, bool isData){
 
   ANA_MSG_INFO("Initialize Jet Uncertainties Tool with " << m_uncertConfig);
@@ -1,4 +1,5 @@
 #include "xAODAnaHelpers/JetContainer.h"
+#include "xAODAnaHelpers/TrigMatchBits.h"
 #include <xAODAnaHelpers/HelperFunctions.h>
 #include <iostream>
 #include <exception> // std::domain_error
@@ -19,7 +20,7 @@ JetContainer::JetContainer(const std::string& name, const std::string& detailStr
   // trigger
   if ( m_infoSwitch.m_trigger ) {
     m_isTrigMatched          = new     std::vector<int>               ();
-    m_isTrigMatchedToChain   = new     std::vector<std::vector<int> > ();
+    m_isTrigMatchedToChain   = new     xAH::JaggedBranch<int>         (m_infoSwitch.m_flatArrays);
     m_listTrigChains         = new     std::vector<std::string>       ();
   }
   
@@ -210,11 +211,11 @@ JetContainer::JetContainer(const std::string& name, const std::string& detailStr
   }
 
   if ( m_infoSwitch.m_constituentAll ) {
-    m_constituentWeights     = new  std::vector< std::vector<float> > ();
-    m_constituent_pt         = new  std::vector< std::vector<float> > ();
-    m_constituent_eta        = new  std::vector< std::vector<float> > ();
-    m_constituent_phi        = new  std::vector< std::vector<float> > ();
-    m_constituent_e          = new  std::vector< std::vector<float> > ();
+    m_constituentWeights     = new xAH::JaggedBranch<float>(m_infoSwitch.m_flatArrays);
+    m_constituent_pt         = new xAH::JaggedBranch<float>(m_infoSwitch.m_flatArrays);
+    m_constituent_eta        = new xAH::JaggedBranch<float>(m_infoSwitch.m_flatArrays);
+    m_constituent_phi        = new xAH::JaggedBranch<float>(m_infoSwitch.m_flatArrays);
+    m_constituent_e          = new xAH::JaggedBranch<float>(m_infoSwitch.m_flatArrays);
   }
 
   // flavorTag
@@ -307,13 +308,13 @@ JetContainer::JetContainer(const std::string& name, const std::string& detailStr
       m_IP2D_cu        = new std::vector<float>();
       m_nIP2DTracks    = new std::vector<float>();
 
-      m_IP2D_gradeOfTracks              = new std::vector<std::vector<float> >();
-      m_IP2D_flagFromV0ofTracks         = new std::vector<std::vector<float> >();
-      m_IP2D_valD0wrtPVofTracks         = new std::vector<std::vector<float> >();
-      m_IP2D_sigD0wrtPVofTracks         = new std::vector<std::vector<float> >();
-      m_IP2D_weightBofTracks            = new std::vector<std::vector<float> >();
-      m_IP2D_weightCofTracks            = new std::vector<std::vector<float> >();
-      m_IP2D_weightUofTracks            = new std::vector<std::vector<float> >();
+      m_IP2D_gradeOfTracks              = new xAH::JaggedBranch<float>(m_infoSwitch.m_flatArrays);
+      m_IP2D_flagFromV0ofTracks         = new xAH::JaggedBranch<float>(m_infoSwitch.m_flatArrays);
+      m_IP2D_valD0wrtPVofTracks         = new xAH::JaggedBranch<float>(m_infoSwitch.m_flatArrays);
+      m_IP2D_sigD0wrtPVofTracks         = new xAH::JaggedBranch<float>(m_infoSwitch.m_flatArrays);
+      m_IP2D_weightBofTracks            = new xAH::JaggedBranch<float>(m_infoSwitch.m_flatArrays);
+      m_IP2D_weightCofTracks            = new xAH::JaggedBranch<float>(m_infoSwitch.m_flatArrays);
+      m_IP2D_weightUofTracks            = new xAH::JaggedBranch<float>(m_infoSwitch.m_flatArrays);
 
       m_IP3D         = new std::vector<float>();
       m_IP3D_pu      = new std::vector<float>();
@@ -322,15 +323,15 @@ JetContainer::JetContainer(const std::string& name, const std::string& detailStr
       m_IP3D_c       = new std::vector<float>();
       m_IP3D_cu      = new std::vector<float>();
       m_nIP3DTracks  = new std::vector<float>();
-      m_IP3D_gradeOfTracks        = new  std::vector<std::vector<float> >();
-      m_IP3D_flagFromV0ofTracks   = new  std::vector<std::vector<float> >();
-      m_IP3D_valD0wrtPVofTracks   = new  std::vector<std::vector<float> >();
-      m_IP3D_sigD0wrtPVofTracks   = new  std::vector<std::vector<float> >();
-      m_IP3D_valZ0wrtPVofTracks   = new  std::vector<std::vector<float> >();
-      m_IP3D_sigZ0wrtPVofTracks   = new  std::vector<std::vector<float> >();
-      m_IP3D_weightBofTracks      = new  std::vector<std::vector<float> >();
-      m_IP3D_weightCofTracks      = new  std::vector<std::vector<float> >();
-      m_IP3D_weightUofTracks      = new  std::vector<std::vector<float> >();
+      m_IP3D_gradeOfTracks        = new  xAH::JaggedBranch<float>(m_infoSwitch.m_flatArrays);
+      m_IP3D_flagFromV0ofTracks   = new  xAH::JaggedBranch<float>(m_infoSwitch.m_flatArrays);
+      m_IP3D_valD0wrtPVofTracks   = new  xAH::JaggedBranch<float>(m_infoSwitch.m_flatArrays);
+      m_IP3D_sigD0wrtPVofTracks   = new  xAH::JaggedBranch<float>(m_infoSwitch.m_flatArrays);
+      m_IP3D_valZ0wrtPVofTracks   = new  xAH::JaggedBranch<float>(m_infoSwitch.m_flatArrays);
+      m_IP3D_sigZ0wrtPVofTracks   = new  xAH::JaggedBranch<float>(m_infoSwitch.m_flatArrays);
+      m_IP3D_weightBofTracks      = new  xAH::JaggedBranch<float>(m_infoSwitch.m_flatArrays);
+      m_IP3D_weightCofTracks      = new  xAH::JaggedBranch<float>(m_infoSwitch.m_flatArrays);
+      m_IP3D_weightUofTracks      = new  xAH::JaggedBranch<float>(m_infoSwitch.m_flatArrays);
     }
 
     if( m_infoSwitch.m_JVC ) {
@@ -447,6 +448,7 @@ JetContainer::JetContainer(const std::string& name, const std::string& detailStr
     m_passOR  =new std::vector<char>();
   }
 
+  setFillBlocks();
 }
 
 JetContainer::~JetContainer()
@@ -884,7 +886,7 @@ void JetContainer::setTree(TTree *tree)
 
   if ( m_infoSwitch.m_trigger ){
     connectBranch<int>              (tree, "isTrigMatched",        &m_isTrigMatched);
-    connectBranch<std::vector<int> >(tree, "isTrigMatchedToChain", &m_isTrigMatchedToChain );
+    connectBranch<int>              (tree, "isTrigMatchedToChain", m_isTrigMatchedToChain );
     connectBranch<std::string>      (tree, "listTrigChains",       &m_listTrigChains );
   }
 
@@ -1073,13 +1075,13 @@ void JetContainer::setTree(TTree *tree)
       connectBranch<float>         (tree,  "IP2D",                      &m_IP2D                      );
       connectBranch<float>         (tree,  "IP2D_c",                    &m_IP2D_c                    );
       connectBranch<float>         (tree,  "IP2D_cu",                   &m_IP2D_cu                   );
-      connectBranch<std::vector<float> >(tree,  "IP2D_gradeOfTracks"       , &m_IP2D_gradeOfTracks        );
-      connectBranch<std::vector<float> >(tree,  "IP2D_flagFromV0ofTracks"  , &m_IP2D_flagFromV0ofTracks   );
-      connectBranch<std::vector<float> >(tree,  "IP2D_valD0wrtPVofTracks"  , &m_IP2D_valD0wrtPVofTracks   );
-      connectBranch<std::vector<float> >(tree,  "IP2D_sigD0wrtPVofTracks"  , &m_IP2D_sigD0wrtPVofTracks   );
-      connectBranch<std::vector<float> >(tree,  "IP2D_weightBofTracks"     , &m_IP2D_weightBofTracks      );
-      connectBranch<std::vector<float> >(tree,  "IP2D_weightCofTracks"     , &m_IP2D_weightCofTracks      );
-      connectBranch<std::vector<float> >(tree,  "IP2D_weightUofTracks"     , &m_IP2D_weightUofTracks      );
+      connectBranch<float>       (tree,  "IP2D_gradeOfTracks"       ,  m_IP2D_gradeOfTracks        );
+      connectBranch<float>       (tree,  "IP2D_flagFromV0ofTracks"  ,  m_IP2D_flagFromV0ofTracks   );
+      connectBranch<float>       (tree,  "IP2D_valD0wrtPVofTracks"  ,  m_IP2D_valD0wrtPVofTracks   );
+      connectBranch<float>       (tree,  "IP2D_sigD0wrtPVofTracks"  ,  m_IP2D_sigD0wrtPVofTracks   );
+      connectBranch<float>       (tree,  "IP2D_weightBofTracks"     ,  m_IP2D_weightBofTracks      );
+      connectBranch<float>       (tree,  "IP2D_weightCofTracks"     ,  m_IP2D_weightCofTracks      );
+      connectBranch<float>       (tree,  "IP2D_weightUofTracks"     ,  m_IP2D_weightUofTracks      );
 
       connectBranch<float>         (tree,  "IP3D",                      &m_IP3D);
       connectBranch<float>         (tree,  "IP3D_pu",                   &m_IP3D_pu                   );
@@ -1087,15 +1089,15 @@ void JetContainer::setTree(TTree *tree)
       connectBranch<float>         (tree,  "IP3D_pc",                   &m_IP3D_pc                   );
       connectBranch<float>         (tree,  "IP3D_c",                    &m_IP3D_c                    );
       connectBranch<float>         (tree,  "IP3D_cu",                   &m_IP3D_cu                   );
-      connectBranch<std::vector<float> >(tree,  "IP3D_gradeOfTracks"       , &m_IP3D_gradeOfTracks        );
-      connectBranch<std::vector<float> >(tree,  "IP3D_flagFromV0ofTracks"  , &m_IP3D_flagFromV0ofTracks   );
-      connectBranch<std::vector<float> >(tree,  "IP3D_valD0wrtPVofTracks"  , &m_IP3D_valD0wrtPVofTracks   );
-      connectBranch<std::vector<float> >(tree,  "IP3D_sigD0wrtPVofTracks"  , &m_IP3D_sigD0wrtPVofTracks   );
-      connectBranch<std::vector<float> >(tree,  "IP3D_valZ0wrtPVofTracks"  , &m_IP3D_valZ0wrtPVofTracks   );
-      connectBranch<std::vector<float> >(tree,  "IP3D_sigZ0wrtPVofTracks"  , &m_IP3D_sigZ0wrtPVofTracks   );
-      connectBranch<std::vector<float> >(tree,  "IP3D_weightBofTracks"     , &m_IP3D_weightBofTracks      );
-      connectBranch<std::vector<float> >(tree,  "IP3D_weightCofTracks"     , &m_IP3D_weightCofTracks      );
-      connectBranch<std::vector<float> >(tree,  "IP3D_weightUofTracks"     , &m_IP3D_weightUofTracks      );
+      connectBranch<float>       (tree,  "IP3D_gradeOfTracks"       ,  m_IP3D_gradeOfTracks        );
+      connectBranch<float>       (tree,  "IP3D_flagFromV0ofTracks"  ,  m_IP3D_flagFromV0ofTracks   );
+      connectBranch<float>       (tree,  "IP3D_valD0wrtPVofTracks"  ,  m_IP3D_valD0wrtPVofTracks   );
+      connectBranch<float>       (tree,  "IP3D_sigD0wrtPVofTracks"  ,  m_IP3D_sigD0wrtPVofTracks   );
+      connectBranch<float>       (tree,  "IP3D_valZ0wrtPVofTracks"  ,  m_IP3D_valZ0wrtPVofTracks   );
+      connectBranch<float>       (tree,  "IP3D_sigZ0wrtPVofTracks"  ,  m_IP3D_sigZ0wrtPVofTracks   );
+      connectBranch<float>       (tree,  "IP3D_weightBofTracks"     ,  m_IP3D_weightBofTracks      );
+      connectBranch<float>       (tree,  "IP3D_weightCofTracks"     ,  m_IP3D_weightCofTracks      );
+      connectBranch<float>       (tree,  "IP3D_weightUofTracks"     ,  m_IP3D_weightUofTracks      );
 
     }
 
@@ -1233,37 +1235,37 @@ void JetContainer::updateParticle(uint idx, Jet& jet)
   if(m_infoSwitch.m_flavorTag  || m_infoSwitch.m_flavorTagHLT)
     {
       if(m_debug) std::cout << "updating flavorTag " << std::endl;
-      jet.MV2c00                    =m_MV2c00               ->at(idx);
-      jet.MV2c10                    =m_MV2c10               ->at(idx);
-      if(m_MV2c10mu)  jet.MV2c10mu  =m_MV2c10mu             ->at(idx);
-      if(m_MV2c10rnn) jet.MV2c10rnn =m_MV2c10rnn            ->at(idx);
-      if(m_MV2rmu)    jet.MV2rmu    =m_MV2rmu               ->at(idx);
-      if(m_MV2r)      jet.MV2r      =m_MV2r                 ->at(idx);
-      jet.MV2c20                    =m_MV2c20               ->at(idx);
-      jet.MV2c100                   =m_MV2c100              ->at(idx);
-      if(m_DL1)       jet.DL1       =m_DL1                  ->at(idx);
-      if(m_DL1_pu)    jet.DL1_pu    =m_DL1_pu               ->at(idx);
-      if(m_DL1_pc)    jet.DL1_pc    =m_DL1_pc               ->at(idx);
-      if(m_DL1_pb)    jet.DL1_pb    =m_DL1_pb               ->at(idx);
-      if(m_DL1mu)     jet.DL1mu     =m_DL1mu                ->at(idx);
-      if(m_DL1mu_pu)  jet.DL1mu_pu  =m_DL1mu_pu             ->at(idx);
-      if(m_DL1mu_pc)  jet.DL1mu_pc  =m_DL1mu_pc             ->at(idx);
-      if(m_DL1mu_pb)  jet.DL1mu_pb  =m_DL1mu_pb             ->at(idx);
-      if(m_DL1rnn)    jet.DL1rnn    =m_DL1rnn               ->at(idx);
-      if(m_DL1rnn_pu) jet.DL1rnn_pu =m_DL1rnn_pu            ->at(idx);
-      if(m_DL1rnn_pc) jet.DL1rnn_pc =m_DL1rnn_pc            ->at(idx);
-      if(m_DL1rnn_pb) jet.DL1rnn_pb =m_DL1rnn_pb            ->at(idx);
-      if(m_DL1rmu)    jet.DL1rmu    =m_DL1rmu               ->at(idx);
-      if(m_DL1rmu_pu) jet.DL1rmu_pu =m_DL1rmu_pu            ->at(idx);
-      if(m_DL1rmu_pc) jet.DL1rmu_pc =m_DL1rmu_pc            ->at(idx);
-      if(m_DL1rmu_pb) jet.DL1rmu_pb =m_DL1rmu_pb            ->at(idx);
-      if(m_DL1r)      jet.DL1r      =m_DL1r                 ->at(idx);
-      if(m_DL1r_pu)   jet.DL1r_pu   =m_DL1r_pu              ->at(idx);
-      if(m_DL1r_pc)   jet.DL1r_pc   =m_DL1r_pc              ->at(idx);
-      if(m_DL1r_pb)   jet.DL1r_pb   =m_DL1r_pb              ->at(idx);
+      jet.flavorTag->MV2c00                    =m_MV2c00               ->at(idx);
+      jet.flavorTag->MV2c10                    =m_MV2c10               ->at(idx);
+      if(m_MV2c10mu)  jet.flavorTag->MV2c10mu  =m_MV2c10mu             ->at(idx);
+      if(m_MV2c10rnn) jet.flavorTag->MV2c10rnn =m_MV2c10rnn            ->at(idx);
+      if(m_MV2rmu)    jet.flavorTag->MV2rmu    =m_MV2rmu               ->at(idx);
+      if(m_MV2r)      jet.flavorTag->MV2r      =m_MV2r                 ->at(idx);
+      jet.flavorTag->MV2c20                    =m_MV2c20               ->at(idx);
+      jet.flavorTag->MV2c100                   =m_MV2c100              ->at(idx);
+      if(m_DL1)       jet.flavorTag->DL1       =m_DL1                  ->at(idx);
+      if(m_DL1_pu)    jet.flavorTag->DL1_pu    =m_DL1_pu               ->at(idx);
+      if(m_DL1_pc)    jet.flavorTag->DL1_pc    =m_DL1_pc               ->at(idx);
+      if(m_DL1_pb)    jet.flavorTag->DL1_pb    =m_DL1_pb               ->at(idx);
+      if(m_DL1mu)     jet.flavorTag->DL1mu     =m_DL1mu                ->at(idx);
+      if(m_DL1mu_pu)  jet.flavorTag->DL1mu_pu  =m_DL1mu_pu             ->at(idx);
+      if(m_DL1mu_pc)  jet.flavorTag->DL1mu_pc  =m_DL1mu_pc             ->at(idx);
+      if(m_DL1mu_pb)  jet.flavorTag->DL1mu_pb  =m_DL1mu_pb             ->at(idx);
+      if(m_DL1rnn)    jet.flavorTag->DL1rnn    =m_DL1rnn               ->at(idx);
+      if(m_DL1rnn_pu) jet.flavorTag->DL1rnn_pu =m_DL1rnn_pu            ->at(idx);
+      if(m_DL1rnn_pc) jet.flavorTag->DL1rnn_pc =m_DL1rnn_pc            ->at(idx);
+      if(m_DL1rnn_pb) jet.flavorTag->DL1rnn_pb =m_DL1rnn_pb            ->at(idx);
+      if(m_DL1rmu)    jet.flavorTag->DL1rmu    =m_DL1rmu               ->at(idx);
+      if(m_DL1rmu_pu) jet.flavorTag->DL1rmu_pu =m_DL1rmu_pu            ->at(idx);
+      if(m_DL1rmu_pc) jet.flavorTag->DL1rmu_pc =m_DL1rmu_pc            ->at(idx);
+      if(m_DL1rmu_pb) jet.flavorTag->DL1rmu_pb =m_DL1rmu_pb            ->at(idx);
+      if(m_DL1r)      jet.flavorTag->DL1r      =m_DL1r                 ->at(idx);
+      if(m_DL1r_pu)   jet.flavorTag->DL1r_pu   =m_DL1r_pu              ->at(idx);
+      if(m_DL1r_pc)   jet.flavorTag->DL1r_pc   =m_DL1r_pc              ->at(idx);
+      if(m_DL1r_pb)   jet.flavorTag->DL1r_pb   =m_DL1r_pb              ->at(idx);
       //std::cout << m_HadronConeExclTruthLabelID->size() << std::endl;
-      if(m_HadronConeExclTruthLabelID)         jet.HadronConeExclTruthLabelID        =m_HadronConeExclTruthLabelID        ->at(idx);
-      if(m_HadronConeExclExtendedTruthLabelID) jet.HadronConeExclExtendedTruthLabelID=m_HadronConeExclExtendedTruthLabelID->at(idx);
+      if(m_HadronConeExclTruthLabelID)         jet.flavorTag->HadronConeExclTruthLabelID        =m_HadronConeExclTruthLabelID        ->at(idx);
+      if(m_HadronConeExclExtendedTruthLabelID) jet.flavorTag->HadronConeExclExtendedTruthLabelID=m_HadronConeExclExtendedTruthLabelID->at(idx);
       if(m_debug) std::cout << "leave flavorTag " << std::endl;
     }
 
@@ -1271,101 +1273,101 @@ void JetContainer::updateParticle(uint idx, Jet& jet)
   if(m_infoSwitch.m_flavorTagHLT)
     {
       if(m_debug) std::cout << "updating flavorTagHLT " << std::endl;
-      jet.bs_online_vx                      =m_bs_online_vx                  ->at(idx);
-      jet.bs_online_vy                      =m_bs_online_vy                  ->at(idx);
-      jet.bs_online_vz                      =m_bs_online_vz                  ->at(idx);
-      jet.vtxHadDummy                       =m_vtxHadDummy                   ->at(idx);
-      jet.vtx_offline_x0                    =m_vtx_offline_x0                  ->at(idx);
-      jet.vtx_offline_y0                    =m_vtx_offline_y0                  ->at(idx);
-      jet.vtx_offline_z0                    =m_vtx_offline_z0                  ->at(idx);
+      jet.flavorTag->bs_online_vx                      =m_bs_online_vx                  ->at(idx);
+      jet.flavorTag->bs_online_vy                      =m_bs_online_vy                  ->at(idx);
+      jet.flavorTag->bs_online_vz                      =m_bs_online_vz                  ->at(idx);
+      jet.flavorTag->vtxHadDummy                       =m_vtxHadDummy                   ->at(idx);
+      jet.flavorTag->vtx_offline_x0                    =m_vtx_offline_x0                  ->at(idx);
+      jet.flavorTag->vtx_offline_y0                    =m_vtx_offline_y0                  ->at(idx);
+      jet.flavorTag->vtx_offline_z0                    =m_vtx_offline_z0                  ->at(idx);
 
-      jet.vtx_online_x0                     =m_vtx_online_x0                  ->at(idx);
-      jet.vtx_online_y0                     =m_vtx_online_y0                  ->at(idx);
-      jet.vtx_online_z0                     =m_vtx_online_z0                  ->at(idx);
+      jet.flavorTag->vtx_online_x0                     =m_vtx_online_x0                  ->at(idx);
+      jet.flavorTag->vtx_online_y0                     =m_vtx_online_y0                  ->at(idx);
+      jet.flavorTag->vtx_online_z0                     =m_vtx_online_z0                  ->at(idx);
 
-      jet.vtx_online_bkg_x0                     =m_vtx_online_bkg_x0                  ->at(idx);
-      jet.vtx_online_bkg_y0                     =m_vtx_online_bkg_y0                  ->at(idx);
-      jet.vtx_online_bkg_z0                     =m_vtx_online_bkg_z0                  ->at(idx);
+      jet.flavorTag->vtx_online_bkg_x0                     =m_vtx_online_bkg_x0                  ->at(idx);
+      jet.flavorTag->vtx_online_bkg_y0                     =m_vtx_online_bkg_y0                  ->at(idx);
+      jet.flavorTag->vtx_online_bkg_z0                     =m_vtx_online_bkg_z0                  ->at(idx);
 
     }
 
   if(m_infoSwitch.m_jetFitterDetails)
     {
-      jet.JetFitter_nVTX                  =m_JetFitter_nVTX           ->at(idx);
-      jet.JetFitter_nSingleTracks         =m_JetFitter_nSingleTracks  ->at(idx);
-      jet.JetFitter_nTracksAtVtx          =m_JetFitter_nTracksAtVtx   ->at(idx);
-      jet.JetFitter_mass                  =m_JetFitter_mass           ->at(idx);
-      jet.JetFitter_energyFraction        =m_JetFitter_energyFraction ->at(idx);
-      jet.JetFitter_significance3d        =m_JetFitter_significance3d ->at(idx);
-      jet.JetFitter_deltaeta              =m_JetFitter_deltaeta       ->at(idx);
-      jet.JetFitter_deltaphi              =m_JetFitter_deltaphi       ->at(idx);
-      jet.JetFitter_N2Tpar                =m_JetFitter_N2Tpar         ->at(idx);
+      jet.flavorTag->JetFitter_nVTX                  =m_JetFitter_nVTX           ->at(idx);
+      jet.flavorTag->JetFitter_nSingleTracks         =m_JetFitter_nSingleTracks  ->at(idx);
+      jet.flavorTag->JetFitter_nTracksAtVtx          =m_JetFitter_nTracksAtVtx   ->at(idx);
+      jet.flavorTag->JetFitter_mass                  =m_JetFitter_mass           ->at(idx);
+      jet.flavorTag->JetFitter_energyFraction        =m_JetFitter_energyFraction ->at(idx);
+      jet.flavorTag->JetFitter_significance3d        =m_JetFitter_significance3d ->at(idx);
+      jet.flavorTag->JetFitter_deltaeta              =m_JetFitter_deltaeta       ->at(idx);
+      jet.flavorTag->JetFitter_deltaphi              =m_JetFitter_deltaphi       ->at(idx);
+      jet.flavorTag->JetFitter_N2Tpar                =m_JetFitter_N2Tpar         ->at(idx);
 
     }
 
   if(m_infoSwitch.m_svDetails){
 
-    jet.SV0            = m_SV0           ->at(idx);
-    jet.sv0_NGTinSvx   = m_sv0_NGTinSvx  ->at(idx);
-    jet.sv0_N2Tpair    = m_sv0_N2Tpair   ->at(idx);
-    jet.sv0_massvx     = m_sv0_massvx    ->at(idx);
-    jet.sv0_efracsvx   = m_sv0_efracsvx  ->at(idx);
-    jet.sv0_normdist   = m_sv0_normdist  ->at(idx);
-
-    jet.SV1            = m_SV1           ->at(idx);
-    jet.SV1IP3D        = m_SV1IP3D       ->at(idx);
-    jet.COMBx          = m_COMBx         ->at(idx);
-    jet.sv1_pu         = m_sv1_pu        ->at(idx);
-    jet.sv1_pb         = m_sv1_pb        ->at(idx);
-    jet.sv1_pc         = m_sv1_pc        ->at(idx);
-    jet.sv1_c          = m_sv1_c         ->at(idx);
-    jet.sv1_cu         = m_sv1_cu        ->at(idx);
-    jet.sv1_NGTinSvx   = m_sv1_NGTinSvx  ->at(idx);
-    jet.sv1_N2Tpair    = m_sv1_N2Tpair   ->at(idx);
-    jet.sv1_massvx     = m_sv1_massvx    ->at(idx);
-    jet.sv1_efracsvx   = m_sv1_efracsvx  ->at(idx);
-    jet.sv1_normdist   = m_sv1_normdist  ->at(idx);
-    jet.sv1_Lxy        = m_sv1_Lxy       ->at(idx);
+    jet.flavorTag->SV0            = m_SV0           ->at(idx);
+    jet.flavorTag->sv0_NGTinSvx   = m_sv0_NGTinSvx  ->at(idx);
+    jet.flavorTag->sv0_N2Tpair    = m_sv0_N2Tpair   ->at(idx);
+    jet.flavorTag->sv0_massvx     = m_sv0_massvx    ->at(idx);
+    jet.flavorTag->sv0_efracsvx   = m_sv0_efracsvx  ->at(idx);
+    jet.flavorTag->sv0_normdist   = m_sv0_normdist  ->at(idx);
+
+    jet.flavorTag->SV1            = m_SV1           ->at(idx);
+    jet.flavorTag->SV1IP3D        = m_SV1IP3D       ->at(idx);
+    jet.flavorTag->COMBx          = m_COMBx         ->at(idx);
+    jet.flavorTag->sv1_pu         = m_sv1_pu        ->at(idx);
+    jet.flavorTag->sv1_pb         = m_sv1_pb        ->at(idx);
+    jet.flavorTag->sv1_pc         = m_sv1_pc        ->at(idx);
+    jet.flavorTag->sv1_c          = m_sv1_c         ->at(idx);
+    jet.flavorTag->sv1_cu         = m_sv1_cu        ->at(idx);
+    jet.flavorTag->sv1_NGTinSvx   = m_sv1_NGTinSvx  ->at(idx);
+    jet.flavorTag->sv1_N2Tpair    = m_sv1_N2Tpair   ->at(idx);
+    jet.flavorTag->sv1_massvx     = m_sv1_massvx    ->at(idx);
+    jet.flavorTag->sv1_efracsvx   = m_sv1_efracsvx  ->at(idx);
+    jet.flavorTag->sv1_normdist   = m_sv1_normdist  ->at(idx);
+    jet.flavorTag->sv1_Lxy        = m_sv1_Lxy       ->at(idx);
     if(m_sv1_sig3d->size())
-      jet.sv1_sig3d      = m_sv1_sig3d     ->at(idx);
-    jet.sv1_L3d        = m_sv1_L3d       ->at(idx);
-    jet.sv1_distmatlay = m_sv1_distmatlay->at(idx);
-    jet.sv1_dR         = m_sv1_dR        ->at(idx);
+      jet.flavorTag->sv1_sig3d      = m_sv1_sig3d     ->at(idx);
+    jet.flavorTag->sv1_L3d        = m_sv1_L3d       ->at(idx);
+    jet.flavorTag->sv1_distmatlay = m_sv1_distmatlay->at(idx);
+    jet.flavorTag->sv1_dR         = m_sv1_dR        ->at(idx);
   }
 
   if(m_infoSwitch.m_ipDetails){
-    jet.IP2D_pu                          = m_IP2D_pu                   ->at(idx);
-    jet.IP2D_pb                          = m_IP2D_pb                   ->at(idx);
-    jet.IP2D_pc                          = m_IP2D_pc                   ->at(idx);
-    jet.IP2D                             = m_IP2D                      ->at(idx);
-    jet.IP2D_c                           = m_IP2D_c                    ->at(idx);
-    jet.IP2D_cu                          = m_IP2D_cu                   ->at(idx);
-    jet.nIP2DTracks                      = m_IP2D_gradeOfTracks        ->at(idx).size();
-
-    jet.IP2D_gradeOfTracks               = m_IP2D_gradeOfTracks        ->at(idx);
-    jet.IP2D_flagFromV0ofTracks          = m_IP2D_flagFromV0ofTracks   ->at(idx);
-    jet.IP2D_valD0wrtPVofTracks          = m_IP2D_valD0wrtPVofTracks   ->at(idx);
-    jet.IP2D_sigD0wrtPVofTracks          = m_IP2D_sigD0wrtPVofTracks   ->at(idx);
-    jet.IP2D_weightBofTracks             = m_IP2D_weightBofTracks      ->at(idx);
-    jet.IP2D_weightCofTracks             = m_IP2D_weightCofTracks      ->at(idx);
-    jet.IP2D_weightUofTracks             = m_IP2D_weightUofTracks      ->at(idx);
-
-    jet.IP3D                             = m_IP3D                      ->at(idx);
-    jet.IP3D_pu                          = m_IP3D_pu                   ->at(idx);
-    jet.IP3D_pb                          = m_IP3D_pb                   ->at(idx);
-    jet.IP3D_pc                          = m_IP3D_pc                   ->at(idx);
-    jet.IP3D_c                           = m_IP3D_c                    ->at(idx);
-    jet.IP3D_cu                          = m_IP3D_cu                   ->at(idx);
-    jet.nIP3DTracks                      = m_IP3D_gradeOfTracks        ->at(idx).size();
-    jet.IP3D_gradeOfTracks               = m_IP3D_gradeOfTracks        ->at(idx);
-    jet.IP3D_flagFromV0ofTracks          = m_IP3D_flagFromV0ofTracks   ->at(idx);
-    jet.IP3D_valD0wrtPVofTracks          = m_IP3D_valD0wrtPVofTracks   ->at(idx);
-    jet.IP3D_sigD0wrtPVofTracks          = m_IP3D_sigD0wrtPVofTracks   ->at(idx);
-    jet.IP3D_valZ0wrtPVofTracks          = m_IP3D_valZ0wrtPVofTracks   ->at(idx);
-    jet.IP3D_sigZ0wrtPVofTracks          = m_IP3D_sigZ0wrtPVofTracks   ->at(idx);
-    jet.IP3D_weightBofTracks             = m_IP3D_weightBofTracks      ->at(idx);
-    jet.IP3D_weightCofTracks             = m_IP3D_weightCofTracks      ->at(idx);
-    jet.IP3D_weightUofTracks             = m_IP3D_weightUofTracks      ->at(idx);
+    jet.flavorTag->IP2D_pu                          = m_IP2D_pu                   ->at(idx);
+    jet.flavorTag->IP2D_pb                          = m_IP2D_pb                   ->at(idx);
+    jet.flavorTag->IP2D_pc                          = m_IP2D_pc                   ->at(idx);
+    jet.flavorTag->IP2D                             = m_IP2D                      ->at(idx);
+    jet.flavorTag->IP2D_c                           = m_IP2D_c                    ->at(idx);
+    jet.flavorTag->IP2D_cu                          = m_IP2D_cu                   ->at(idx);
+    jet.flavorTag->nIP2DTracks                      = m_IP2D_gradeOfTracks        ->count(idx);
+
+    jet.flavorTag->IP2D_gradeOfTracks               = m_IP2D_gradeOfTracks        ->at(idx);
+    jet.flavorTag->IP2D_flagFromV0ofTracks          = m_IP2D_flagFromV0ofTracks   ->at(idx);
+    jet.flavorTag->IP2D_valD0wrtPVofTracks          = m_IP2D_valD0wrtPVofTracks   ->at(idx);
+    jet.flavorTag->IP2D_sigD0wrtPVofTracks          = m_IP2D_sigD0wrtPVofTracks   ->at(idx);
+    jet.flavorTag->IP2D_weightBofTracks             = m_IP2D_weightBofTracks      ->at(idx);
+    jet.flavorTag->IP2D_weightCofTracks             = m_IP2D_weightCofTracks      ->at(idx);
+    jet.flavorTag->IP2D_weightUofTracks             = m_IP2D_weightUofTracks      ->at(idx);
+
+    jet.flavorTag->IP3D                             = m_IP3D                      ->at(idx);
+    jet.flavorTag->IP3D_pu                          = m_IP3D_pu                   ->at(idx);
+    jet.flavorTag->IP3D_pb                          = m_IP3D_pb                   ->at(idx);
+    jet.flavorTag->IP3D_pc                          = m_IP3D_pc                   ->at(idx);
+    jet.flavorTag->IP3D_c                           = m_IP3D_c                    ->at(idx);
+    jet.flavorTag->IP3D_cu                          = m_IP3D_cu                   ->at(idx);
+    jet.flavorTag->nIP3DTracks                      = m_IP3D_gradeOfTracks        ->count(idx);
+    jet.flavorTag->IP3D_gradeOfTracks               = m_IP3D_gradeOfTracks        ->at(idx);
+    jet.flavorTag->IP3D_flagFromV0ofTracks          = m_IP3D_flagFromV0ofTracks   ->at(idx);
+    jet.flavorTag->IP3D_valD0wrtPVofTracks          = m_IP3D_valD0wrtPVofTracks   ->at(idx);
+    jet.flavorTag->IP3D_sigD0wrtPVofTracks          = m_IP3D_sigD0wrtPVofTracks   ->at(idx);
+    jet.flavorTag->IP3D_valZ0wrtPVofTracks          = m_IP3D_valZ0wrtPVofTracks   ->at(idx);
+    jet.flavorTag->IP3D_sigZ0wrtPVofTracks          = m_IP3D_sigZ0wrtPVofTracks   ->at(idx);
+    jet.flavorTag->IP3D_weightBofTracks             = m_IP3D_weightBofTracks      ->at(idx);
+    jet.flavorTag->IP3D_weightCofTracks             = m_IP3D_weightCofTracks      ->at(idx);
+    jet.flavorTag->IP3D_weightUofTracks             = m_IP3D_weightUofTracks      ->at(idx);
   }
 
   static const std::vector<float> dummy1 = {1.};
@@ -1374,84 +1376,84 @@ void JetContainer::updateParticle(uint idx, Jet& jet)
       switch(btag->m_op)
 	{
 	case Jet::BTaggerOP::DL1_FixedCutBEff_60:
-	  jet.is_DL1_FixedCutBEff_60=       btag->m_isTag->at(idx);
-	  jet.SF_DL1_FixedCutBEff_60=(m_mc)?btag->m_sf   ->at(idx):dummy1;
+	  jet.btag->is_DL1_FixedCutBEff_60=       btag->m_isTag->at(idx);
+	  jet.btag->SF_DL1_FixedCutBEff_60=(m_mc)?btag->m_sf   ->at(idx):dummy1;
 	  break;
 	case Jet::BTaggerOP::DL1_FixedCutBEff_70:
-	  jet.is_DL1_FixedCutBEff_70=       btag->m_isTag->at(idx);
-	  jet.SF_DL1_FixedCutBEff_70=(m_mc)?btag->m_sf   ->at(idx):dummy1;
+	  jet.btag->is_DL1_FixedCutBEff_70=       btag->m_isTag->at(idx);
+	  jet.btag->SF_DL1_FixedCutBEff_70=(m_mc)?btag->m_sf   ->at(idx):dummy1;
 	  break;
 	case Jet::BTaggerOP::DL1_FixedCutBEff_77:
-	  jet.is_DL1_FixedCutBEff_77=       btag->m_isTag->at(idx);
-	  jet.SF_DL1_FixedCutBEff_77=(m_mc)?btag->m_sf   ->at(idx):dummy1;
+	  jet.btag->is_DL1_FixedCutBEff_77=       btag->m_isTag->at(idx);
+	  jet.btag->SF_DL1_FixedCutBEff_77=(m_mc)?btag->m_sf   ->at(idx):dummy1;
 	  break;
 	case Jet::BTaggerOP::DL1_FixedCutBEff_85:
-	  jet.is_DL1_FixedCutBEff_85=       btag->m_isTag->at(idx);
-	  jet.SF_DL1_FixedCutBEff_85=(m_mc)?btag->m_sf   ->at(idx):dummy1;
+	  jet.btag->is_DL1_FixedCutBEff_85=       btag->m_isTag->at(idx);
+	  jet.btag->SF_DL1_FixedCutBEff_85=(m_mc)?btag->m_sf   ->at(idx):dummy1;
 	  break;	  
 	case Jet::BTaggerOP::DL1r_FixedCutBEff_60:
-	  jet.is_DL1r_FixedCutBEff_60=       btag->m_isTag->at(idx);
-	  jet.SF_DL1r_FixedCutBEff_60=(m_mc)?btag->m_sf   ->at(idx):dummy1;
+	  jet.btag->is_DL1r_FixedCutBEff_60=       btag->m_isTag->at(idx);
+	  jet.btag->SF_DL1r_FixedCutBEff_60=(m_mc)?btag->m_sf   ->at(idx):dummy1;
 	  break;
 	case Jet::BTaggerOP::DL1r_FixedCutBEff_70:
-	  jet.is_DL1r_FixedCutBEff_70=       btag->m_isTag->at(idx);
-	  jet.SF_DL1r_FixedCutBEff_70=(m_mc)?btag->m_sf   ->at(idx):dummy1;
+	  jet.btag->is_DL1r_FixedCutBEff_70=       btag->m_isTag->at(idx);
+	  jet.btag->SF_DL1r_FixedCutBEff_70=(m_mc)?btag->m_sf   ->at(idx):dummy1;
 	  break;
 	case Jet::BTaggerOP::DL1r_FixedCutBEff_77:
-	  jet.is_DL1r_FixedCutBEff_77=       btag->m_isTag->at(idx);
-	  jet.SF_DL1r_FixedCutBEff_77=(m_mc)?btag->m_sf   ->at(idx):dummy1;
+	  jet.btag->is_DL1r_FixedCutBEff_77=       btag->m_isTag->at(idx);
+	  jet.btag->SF_DL1r_FixedCutBEff_77=(m_mc)?btag->m_sf   ->at(idx):dummy1;
 	  break;
 	case Jet::BTaggerOP::DL1r_FixedCutBEff_85:
-	  jet.is_DL1r_FixedCutBEff_85=       btag->m_isTag->at(idx);
-	  jet.SF_DL1r_FixedCutBEff_85=(m_mc)?btag->m_sf   ->at(idx):dummy1;
+	  jet.btag->is_DL1r_FixedCutBEff_85=       btag->m_isTag->at(idx);
+	  jet.btag->SF_DL1r_FixedCutBEff_85=(m_mc)?btag->m_sf   ->at(idx):dummy1;
 	  break;	  
 	case Jet::BTaggerOP::DL1rmu_FixedCutBEff_60:
-	  jet.is_DL1rmu_FixedCutBEff_60=       btag->m_isTag->at(idx);
-	  jet.SF_DL1rmu_FixedCutBEff_60=(m_mc)?btag->m_sf   ->at(idx):dummy1;
+	  jet.btag->is_DL1rmu_FixedCutBEff_60=       btag->m_isTag->at(idx);
+	  jet.btag->SF_DL1rmu_FixedCutBEff_60=(m_mc)?btag->m_sf   ->at(idx):dummy1;
 	  break;
 	case Jet::BTaggerOP::DL1rmu_FixedCutBEff_70:
-	  jet.is_DL1rmu_FixedCutBEff_70=       btag->m_isTag->at(idx);
-	  jet.SF_DL1rmu_FixedCutBEff_70=(m_mc)?btag->m_sf   ->at(idx):dummy1;
+	  jet.btag->is_DL1rmu_FixedCutBEff_70=       btag->m_isTag->at(idx);
+	  jet.btag->SF_DL1rmu_FixedCutBEff_70=(m_mc)?btag->m_sf   ->at(idx):dummy1;
 	  break;
 	case Jet::BTaggerOP::DL1rmu_FixedCutBEff_77:
-	  jet.is_DL1rmu_FixedCutBEff_77=       btag->m_isTag->at(idx);
-	  jet.SF_DL1rmu_FixedCutBEff_77=(m_mc)?btag->m_sf   ->at(idx):dummy1;
+	  jet.btag->is_DL1rmu_FixedCutBEff_77=       btag->m_isTag->at(idx);
+	  jet.btag->SF_DL1rmu_FixedCutBEff_77=(m_mc)?btag->m_sf   ->at(idx):dummy1;
 	  break;
 	case Jet::BTaggerOP::DL1rmu_FixedCutBEff_85:
-	  jet.is_DL1rmu_FixedCutBEff_85=       btag->m_isTag->at(idx);
-	  jet.SF_DL1rmu_FixedCutBEff_85=(m_mc)?btag->m_sf   ->at(idx):dummy1;
+	  jet.btag->is_DL1rmu_FixedCutBEff_85=       btag->m_isTag->at(idx);
+	  jet.btag->SF_DL1rmu_FixedCutBEff_85=(m_mc)?btag->m_sf   ->at(idx):dummy1;
 	  break;
 	case Jet::BTaggerOP::MV2c10_FixedCutBEff_60:
-	  jet.is_MV2c10_FixedCutBEff_60=       btag->m_isTag->at(idx);
-	  jet.SF_MV2c10_FixedCutBEff_60=(m_mc)?btag->m_sf   ->at(idx):dummy1;
+	  jet.btag->is_MV2c10_FixedCutBEff_60=       btag->m_isTag->at(idx);
+	  jet.btag->SF_MV2c10_FixedCutBEff_60=(m_mc)?btag->m_sf   ->at(idx):dummy1;
 	  break;
 	case Jet::BTaggerOP::MV2c10_FixedCutBEff_70:
-	  jet.is_MV2c10_FixedCutBEff_70=       btag->m_isTag->at(idx);
-	  jet.SF_MV2c10_FixedCutBEff_70=(m_mc)?btag->m_sf   ->at(idx):dummy1;
+	  jet.btag->is_MV2c10_FixedCutBEff_70=       btag->m_isTag->at(idx);
+	  jet.btag->SF_MV2c10_FixedCutBEff_70=(m_mc)?btag->m_sf   ->at(idx):dummy1;
 	  break;
 	case Jet::BTaggerOP::MV2c10_FixedCutBEff_77:
-	  jet.is_MV2c10_FixedCutBEff_77=       btag->m_isTag->at(idx);
-	  jet.SF_MV2c10_FixedCutBEff_77=(m_mc)?btag->m_sf   ->at(idx):dummy1;
+	  jet.btag->is_MV2c10_FixedCutBEff_77=       btag->m_isTag->at(idx);
+	  jet.btag->SF_MV2c10_FixedCutBEff_77=(m_mc)?btag->m_sf   ->at(idx):dummy1;
 	  break;
 	case Jet::BTaggerOP::MV2c10_FixedCutBEff_85:
-	  jet.is_MV2c10_FixedCutBEff_85=       btag->m_isTag->at(idx);
-	  jet.SF_MV2c10_FixedCutBEff_85=(m_mc)?btag->m_sf   ->at(idx):dummy1;
+	  jet.btag->is_MV2c10_FixedCutBEff_85=       btag->m_isTag->at(idx);
+	  jet.btag->SF_MV2c10_FixedCutBEff_85=(m_mc)?btag->m_sf   ->at(idx):dummy1;
 	  break;
 	case Jet::BTaggerOP::MV2c10_Continuous:
-	  jet.is_MV2c10_Continuous=       btag->m_isTag->at(idx);
-	  jet.SF_MV2c10_Continuous=(m_mc)?btag->m_sf   ->at(idx):dummy1;
+	  jet.btag->is_MV2c10_Continuous=       btag->m_isTag->at(idx);
+	  jet.btag->SF_MV2c10_Continuous=(m_mc)?btag->m_sf   ->at(idx):dummy1;
 	  break;
 	case Jet::BTaggerOP::DL1_Continuous:
-	  jet.is_DL1_Continuous=       btag->m_isTag->at(idx);
-	  jet.SF_DL1_Continuous=(m_mc)?btag->m_sf   ->at(idx):dummy1;
+	  jet.btag->is_DL1_Continuous=       btag->m_isTag->at(idx);
+	  jet.btag->SF_DL1_Continuous=(m_mc)?btag->m_sf   ->at(idx):dummy1;
 	  break;
 	case Jet::BTaggerOP::DL1r_Continuous:
-	  jet.is_DL1r_Continuous=       btag->m_isTag->at(idx);
-	  jet.SF_DL1r_Continuous=(m_mc)?btag->m_sf   ->at(idx):dummy1;
+	  jet.btag->is_DL1r_Continuous=       btag->m_isTag->at(idx);
+	  jet.btag->SF_DL1r_Continuous=(m_mc)?btag->m_sf   ->at(idx):dummy1;
 	  break;
 	case Jet::BTaggerOP::DL1rmu_Continuous:
-	  jet.is_DL1rmu_Continuous=       btag->m_isTag->at(idx);
-	  jet.SF_DL1rmu_Continuous=(m_mc)?btag->m_sf   ->at(idx):dummy1;
+	  jet.btag->is_DL1rmu_Continuous=       btag->m_isTag->at(idx);
+	  jet.btag->SF_DL1rmu_Continuous=(m_mc)?btag->m_sf   ->at(idx):dummy1;
 	  break;
 	default:
 	  throw std::domain_error(
@@ -1507,61 +1509,62 @@ void JetContainer::setBranches(TTree *tree)
     // this is true if there's a match for at least one trigger chain
     setBranch<int>(tree,"isTrigMatched", m_isTrigMatched);
     // a vector of trigger match decision for each jet trigger chain
-    setBranch<std::vector<int> >(tree,"isTrigMatchedToChain", m_isTrigMatchedToChain );
+    setBranch<int>(tree,"isTrigMatchedToChain", m_isTrigMatchedToChain );
     // a vector of strings for each jet trigger chain - 1:1 correspondence w/ vector above
     setBranch<std::string>(tree, "listTrigChains", m_listTrigChains );
   }
 
+  // the cleaning and energy variables are plain jet moments, filled through the fill plan
   if( m_infoSwitch.m_clean || m_infoSwitch.m_cleanLight) {
     if(m_infoSwitch.m_clean){
-      setBranch<float>(tree,"Timing",                        m_Timing               );
-      setBranch<float>(tree,"LArQuality",                    m_LArQuality         );
-      setBranch<float>(tree,"HECQuality",                    m_HECQuality               );
-      setBranch<float>(tree,"NegativeE",                     m_NegativeE               );
-      setBranch<float>(tree,"AverageLArQF",                  m_AverageLArQF            );
-      setBranch<float>(tree,"BchCorrCell",                   m_BchCorrCell        );
-      setBranch<float>(tree,"N90Constituents",               m_N90Constituents           );
-      setBranch<float>(tree,"LArBadHVEnergyFrac",            m_LArBadHVEnergyFrac   );
-      setBranch<int>  (tree,"LArBadHVNCell",                 m_LArBadHVNCell  	  );
+      setPlannedBranch<float, float>(tree,"Timing",                     "Timing",                     m_Timing,                     -999);
+      setPlannedBranch<float, float>(tree,"LArQuality",                 "LArQuality",                 m_LArQuality,                 -999);
+      setPlannedBranch<float, float>(tree,"HECQuality",                 "HECQuality",                 m_HECQuality,                 -999);
+      setPlannedBranch<float, float>(tree,"NegativeE",                  "NegativeE",                  m_NegativeE,                  -999, m_units);
+      setPlannedBranch<float, float>(tree,"AverageLArQF",               "AverageLArQF",               m_AverageLArQF,               -999);
+      setPlannedBranch<float, float>(tree,"BchCorrCell",                "BchCorrCell",                m_BchCorrCell,                -999);
+      setPlannedBranch<float, float>(tree,"N90Constituents",            "N90Constituents",            m_N90Constituents,            -999);
+      setPlannedBranch<float, float>(tree,"LArBadHVEnergyFrac",         "LArBadHVEnergyFrac",         m_LArBadHVEnergyFrac,         -999);
+      setPlannedBranch<int,   int>  (tree,"LArBadHVNCell",              "LArBadHVNCell",              m_LArBadHVNCell,              -999);
       setBranch<float>(tree,"ChargedFraction",               m_ChargedFraction);
-      setBranch<float>(tree,"OotFracClusters5",              m_OotFracClusters5  	    );
-      setBranch<float>(tree,"OotFracClusters10",             m_OotFracClusters10  	  );
-      setBranch<float>(tree,"LeadingClusterPt",              m_LeadingClusterPt  	            );
-      setBranch<float>(tree,"LeadingClusterSecondLambda",    m_LeadingClusterSecondLambda  	  );
-      setBranch<float>(tree,"LeadingClusterCenterLambda",    m_LeadingClusterCenterLambda  	  );
-      setBranch<float>(tree,"LeadingClusterSecondR",         m_LeadingClusterSecondR  	      );
+      setPlannedBranch<float, float>(tree,"OotFracClusters5",           "OotFracClusters5",           m_OotFracClusters5,           -999);
+      setPlannedBranch<float, float>(tree,"OotFracClusters10",          "OotFracClusters10",          m_OotFracClusters10,          -999);
+      setPlannedBranch<float, float>(tree,"LeadingClusterPt",           "LeadingClusterPt",           m_LeadingClusterPt,           -999);
+      setPlannedBranch<float, float>(tree,"LeadingClusterSecondLambda", "LeadingClusterSecondLambda", m_LeadingClusterSecondLambda, -999);
+      setPlannedBranch<float, float>(tree,"LeadingClusterCenterLambda", "LeadingClusterCenterLambda", m_LeadingClusterCenterLambda, -999);
+      setPlannedBranch<float, float>(tree,"LeadingClusterSecondR",      "LeadingClusterSecondR",      m_LeadingClusterSecondR,      -999);
       if(m_infoSwitch.m_cleanTrig) {
-        setBranch<int>  (tree,"clean_passLooseBadTriggerUgly", m_clean_passLooseBadTriggerUgly  );
+        setPlannedBranch<int, int>(tree,"clean_passLooseBadTriggerUgly", "clean_passLooseBadTriggerUgly", m_clean_passLooseBadTriggerUgly, -999);
       }
       else {
-        setBranch<int>  (tree,"clean_passLooseBadUgly",        m_clean_passLooseBadUgly         );
-        setBranch<int>  (tree,"clean_passTightBadUgly",        m_clean_passTightBadUgly         );
+        setPlannedBranch<int, int>(tree,"clean_passLooseBadUgly",        "clean_passLooseBadUgly",        m_clean_passLooseBadUgly,        -999);
+        setPlannedBranch<int, int>(tree,"clean_passTightBadUgly",        "clean_passTightBadUgly",        m_clean_passTightBadUgly,        -999);
       }
     }
     if(m_infoSwitch.m_cleanTrig) {
-      setBranch<int>  (tree,"clean_passLooseBadTrigger",     m_clean_passLooseBadTrigger      );
+      setPlannedBranch<int, int>(tree,"clean_passLooseBadTrigger",     "clean_passLooseBadTrigger",     m_clean_passLooseBadTrigger,     -999);
     }
     else {
-      setBranch<int>  (tree,"clean_passLooseBad",            m_clean_passLooseBad             );
-      setBranch<int>  (tree,"clean_passTightBad",            m_clean_passTightBad             );
+      setPlannedBranch<int, int>(tree,"clean_passLooseBad",            "clean_passLooseBad",            m_clean_passLooseBad,            -999);
+      setPlannedBranch<int, int>(tree,"clean_passTightBad",            "clean_passTightBad",            m_clean_passTightBad,            -999);
     }
   }
   if(m_infoSwitch.m_timing && !m_infoSwitch.m_clean){
-    setBranch<float>(tree,"Timing",m_Timing);
+    setPlannedBranch<float, float>(tree,"Timing", "Timing", m_Timing, -999);
   }
 
 
   if ( m_infoSwitch.m_energy || m_infoSwitch.m_energyLight ) {
     if ( m_infoSwitch.m_energy ){
-      setBranch<float>(tree,"HECFrac",                   m_HECFrac            );
-      setBranch<float>(tree,"CentroidR",                 m_CentroidR      );
-      setBranch<float>(tree,"LowEtConstituentsFrac",     m_LowEtConstituentsFrac      );
+      setPlannedBranch<float, float>(tree,"HECFrac",               "HECFrac",               m_HECFrac,               -999);
+      setPlannedBranch<float, float>(tree,"CentroidR",             "CentroidR",             m_CentroidR,             -999);
+      setPlannedBranch<float, float>(tree,"LowEtConstituentsFrac", "LowEtConstituentsFrac", m_LowEtConstituentsFrac, -999);
     }
-    setBranch<float>(tree,"EMFrac",                    m_EMFrac     );
-    setBranch<float>(tree,"FracSamplingMax",           m_FracSamplingMax    );
-    setBranch<float>(tree,"FracSamplingMaxIndex",      m_FracSamplingMaxIndex );
-    setBranch<float>(tree,"GhostMuonSegmentCount",     m_GhostMuonSegmentCount   );
-    setBranch<float>(tree,"Width",                     m_Width          );
+    setPlannedBranch<float, float>(tree,"EMFrac",                "EMFrac",                m_EMFrac,                -999);
+    setPlannedBranch<float, float>(tree,"FracSamplingMax",       "FracSamplingMax",       m_FracSamplingMax,       -999);
+    setPlannedBranch<int,   float>(tree,"FracSamplingMaxIndex",  "FracSamplingMaxIndex",  m_FracSamplingMaxIndex,  -999);
+    setPlannedBranch<int,   float>(tree,"GhostMuonSegmentCount", "GhostMuonSegmentCount", m_GhostMuonSegmentCount, -999);
+    setPlannedBranch<float, float>(tree,"Width",                 "Width",                 m_Width,                 -999);
   }
 
   if ( m_infoSwitch.m_scales ) {
@@ -1693,11 +1696,11 @@ void JetContainer::setBranches(TTree *tree)
   }
 
   if ( m_infoSwitch.m_constituentAll ) {
-    setBranch<std::vector<float> >(tree,"constituentWeights", m_constituentWeights);
-    setBranch<std::vector<float> >(tree,"constituent_pt",     m_constituent_pt    );
-    setBranch<std::vector<float> >(tree,"constituent_eta",    m_constituent_eta   );
-    setBranch<std::vector<float> >(tree,"constituent_phi",    m_constituent_phi   );
-    setBranch<std::vector<float> >(tree,"constituent_e",      m_constituent_e     );
+    setBranch<float>(tree,"constituentWeights", m_constituentWeights);
+    setBranch<float>(tree,"constituent_pt",     m_constituent_pt    );
+    setBranch<float>(tree,"constituent_eta",    m_constituent_eta   );
+    setBranch<float>(tree,"constituent_phi",    m_constituent_phi   );
+    setBranch<float>(tree,"constituent_e",      m_constituent_e     );
   }
 
   if( m_infoSwitch.m_flavorTag  || m_infoSwitch.m_flavorTagHLT  ) {
@@ -1788,13 +1791,13 @@ void JetContainer::setBranches(TTree *tree)
       setBranch<float>(tree,  "IP2D_c",                    m_IP2D_c                    );
       setBranch<float>(tree,  "IP2D_cu",                   m_IP2D_cu                   );
       setBranch<float>(tree,  "nIP2DTracks"              , m_nIP2DTracks               );
-      setBranch<std::vector<float> >(tree,  "IP2D_gradeOfTracks"       , m_IP2D_gradeOfTracks        );
-      setBranch<std::vector<float> >(tree,  "IP2D_flagFromV0ofTracks"  , m_IP2D_flagFromV0ofTracks   );
-      setBranch<std::vector<float> >(tree,  "IP2D_valD0wrtPVofTracks"  , m_IP2D_valD0wrtPVofTracks   );
-      setBranch<std::vector<float> >(tree,  "IP2D_sigD0wrtPVofTracks"  , m_IP2D_sigD0wrtPVofTracks   );
-      setBranch<std::vector<float> >(tree,  "IP2D_weightBofTracks"     , m_IP2D_weightBofTracks      );
-      setBranch<std::vector<float> >(tree,  "IP2D_weightCofTracks"     , m_IP2D_weightCofTracks      );
-      setBranch<std::vector<float> >(tree,  "IP2D_weightUofTracks"     , m_IP2D_weightUofTracks      );
+      setBranch<float>       (tree,  "IP2D_gradeOfTracks"       , m_IP2D_gradeOfTracks        );
+      setBranch<float>       (tree,  "IP2D_flagFromV0ofTracks"  , m_IP2D_flagFromV0ofTracks   );
+      setBranch<float>       (tree,  "IP2D_valD0wrtPVofTracks"  , m_IP2D_valD0wrtPVofTracks   );
+      setBranch<float>       (tree,  "IP2D_sigD0wrtPVofTracks"  , m_IP2D_sigD0wrtPVofTracks   );
+      setBranch<float>       (tree,  "IP2D_weightBofTracks"     , m_IP2D_weightBofTracks      );
+      setBranch<float>       (tree,  "IP2D_weightCofTracks"     , m_IP2D_weightCofTracks      );
+      setBranch<float>       (tree,  "IP2D_weightUofTracks"     , m_IP2D_weightUofTracks      );
 
       setBranch<float>(tree,  "IP3D",                      m_IP3D);
       setBranch<float>(tree,  "IP3D_pu",                   m_IP3D_pu                   );
@@ -1804,15 +1807,15 @@ void JetContainer::setBranches(TTree *tree)
       setBranch<float>(tree,  "IP3D_c",                    m_IP3D_c                    );
       setBranch<float>(tree,  "IP3D_cu",                   m_IP3D_cu                   );
       setBranch<float>(tree,  "nIP3DTracks"              , m_nIP3DTracks               );
-      setBranch<std::vector<float> >(tree,  "IP3D_gradeOfTracks"       , m_IP3D_gradeOfTracks        );
-      setBranch<std::vector<float> >(tree,  "IP3D_flagFromV0ofTracks"  , m_IP3D_flagFromV0ofTracks   );
-      setBranch<std::vector<float> >(tree,  "IP3D_valD0wrtPVofTracks"  , m_IP3D_valD0wrtPVofTracks   );
-      setBranch<std::vector<float> >(tree,  "IP3D_sigD0wrtPVofTracks"  , m_IP3D_sigD0wrtPVofTracks   );
-      setBranch<std::vector<float> >(tree,  "IP3D_valZ0wrtPVofTracks"  , m_IP3D_valZ0wrtPVofTracks   );
-      setBranch<std::vector<float> >(tree,  "IP3D_sigZ0wrtPVofTracks"  , m_IP3D_sigZ0wrtPVofTracks   );
-      setBranch<std::vector<float> >(tree,  "IP3D_weightBofTracks"     , m_IP3D_weightBofTracks      );
-      setBranch<std::vector<float> >(tree,  "IP3D_weightCofTracks"     , m_IP3D_weightCofTracks      );
-      setBranch<std::vector<float> >(tree,  "IP3D_weightUofTracks"     , m_IP3D_weightUofTracks      );
+      setBranch<float>       (tree,  "IP3D_gradeOfTracks"       , m_IP3D_gradeOfTracks        );
+      setBranch<float>       (tree,  "IP3D_flagFromV0ofTracks"  , m_IP3D_flagFromV0ofTracks   );
+      setBranch<float>       (tree,  "IP3D_valD0wrtPVofTracks"  , m_IP3D_valD0wrtPVofTracks   );
+      setBranch<float>       (tree,  "IP3D_sigD0wrtPVofTracks"  , m_IP3D_sigD0wrtPVofTracks   );
+      setBranch<float>       (tree,  "IP3D_valZ0wrtPVofTracks"  , m_IP3D_valZ0wrtPVofTracks   );
+      setBranch<float>       (tree,  "IP3D_sigZ0wrtPVofTracks"  , m_IP3D_sigZ0wrtPVofTracks   );
+      setBranch<float>       (tree,  "IP3D_weightBofTracks"     , m_IP3D_weightBofTracks      );
+      setBranch<float>       (tree,  "IP3D_weightCofTracks"     , m_IP3D_weightCofTracks      );
+      setBranch<float>       (tree,  "IP3D_weightUofTracks"     , m_IP3D_weightUofTracks      );
 
     }
 
@@ -1844,8 +1847,14 @@ void JetContainer::setBranches(TTree *tree)
   }
 
   if( !m_infoSwitch.m_jetBTag.empty() || !m_infoSwitch.m_jetBTagCts.empty() ) {
-    for(auto btag : m_btags)
+    for(auto btag : m_btags) {
       btag->setBranch(tree, m_name);
+      addCopyBuffer(m_name + (btag->m_isContinuous ? "_Quantile_" : "_is_") + btag->m_accessorName, btag->m_isTag);
+      if ( m_mc ) {
+        addCopyBuffer(m_name + "_SF_" + btag->m_accessorName, btag->m_sf);
+        if ( btag->m_isContinuous ) addCopyBuffer(m_name + "_InefficiencySF_" + btag->m_accessorName, btag->m_ineffSf);
+      }
+    }
   }
 
   if( m_infoSwitch.m_area ) {
@@ -2334,393 +2343,371 @@ void JetContainer::FillJet( const xAOD::IParticle* particle, const xAOD::Vertex*
 
   const xAOD::Jet* jet=dynamic_cast<const xAOD::Jet*>(particle);
 
-  if( m_infoSwitch.m_rapidity ){
-    m_rapidity->push_back( jet->rapidity() );
-  }
-
-  if ( m_infoSwitch.m_trigger ) {
-
-    // retrieve map<string,char> w/ <chain,isMatched>
-    //
-    static SG::AuxElement::Accessor< std::map<std::string,char> > isTrigMatchedMapJetAcc("isTrigMatchedMapJet");
+  // cleaning, timing and energy moments, see setBranches()
+  fillPlanned( *jet );
 
-    std::vector<int> matches;
+  // everything else, by the blocks of the detail string (see setFillBlocks())
+  (this->*m_fillBlocksFn)(jet, pv, pvLocation);
 
-    if ( isTrigMatchedMapJetAcc.isAvailable( *jet ) ) {
-      // loop over map and fill branches
-      //
-      for ( auto const &it : (isTrigMatchedMapJetAcc( *jet )) ) {
-	matches.push_back( static_cast<int>(it.second) );
-	m_listTrigChains->push_back( it.first );
-      }
-    } else {
-      matches.push_back( -1 );
-      m_listTrigChains->push_back("NONE");
-    }
+  return;
+}
 
-    m_isTrigMatchedToChain->push_back(matches);
-    
-    // if at least one match among the chains is found, say this jet is trigger matched
-    if ( std::find(matches.begin(), matches.end(), 1) != matches.end() ) { m_isTrigMatched->push_back(1); }
-    else { m_isTrigMatched->push_back(0); }
-    
+void JetContainer::setFillBlocks(){
+
+  m_fillBlocks = 0;
+  if ( m_infoSwitch.m_rapidity ) m_fillBlocks |= Rapidity;
+  if ( m_infoSwitch.m_trigger ) m_fillBlocks |= Trigger;
+  if ( m_infoSwitch.m_scales ) m_fillBlocks |= Scales;
+  if ( m_infoSwitch.m_constscaleEta ) m_fillBlocks |= ConstScaleEta;
+  if ( m_infoSwitch.m_detectorEta ) m_fillBlocks |= DetectorEta;
+  if ( m_infoSwitch.m_layer ) m_fillBlocks |= Layer;
+  if ( m_infoSwitch.m_trackAll || m_infoSwitch.m_trackPV || m_infoSwitch.m_jvt || m_infoSwitch.m_clean ) m_fillBlocks |= Tracks;
+  if ( m_infoSwitch.m_trackPV || m_infoSwitch.m_sfJVTName == "Loose" || m_infoSwitch.m_sfJVTName == "Medium" || m_infoSwitch.m_sfJVTName == "Tight" || m_infoSwitch.m_sffJVTName == "Medium" || m_infoSwitch.m_sffJVTName == "Tight" ) m_fillBlocks |= JVTSFs;
+  if ( m_infoSwitch.m_allTrack ) m_fillBlocks |= AllTrack;
+  if ( m_infoSwitch.m_constituent ) m_fillBlocks |= Constituent;
+  if ( m_infoSwitch.m_constituentAll ) m_fillBlocks |= ConstituentAll;
+  if ( m_infoSwitch.m_flavorTag || m_infoSwitch.m_flavorTagHLT ) m_fillBlocks |= FlavorTag;
+  if ( !m_infoSwitch.m_jetBTag.empty() || !m_infoSwitch.m_jetBTagCts.empty() ) m_fillBlocks |= BTags;
+  if ( m_infoSwitch.m_area ) m_fillBlocks |= Area;
+  if ( m_infoSwitch.m_truth && m_mc ) m_fillBlocks |= Truth;
+  if ( m_infoSwitch.m_truthDetails ) m_fillBlocks |= TruthDetails;
+  if ( m_infoSwitch.m_charge ) m_fillBlocks |= Charge;
+  if ( m_infoSwitch.m_passSel ) m_fillBlocks |= PassSel;
+  if ( m_infoSwitch.m_passOR ) m_fillBlocks |= PassOR;
+
+  // the detail profiles used most often get a fill compiled for exactly their blocks
+  static const std::vector<std::pair<unsigned int, FillBlocksFn> > profiles = {
+    { 0,                                           &JetContainer::fillBlocksFixed<0> },
+    { Tracks,                                      &JetContainer::fillBlocksFixed<Tracks> },
+    { Tracks | JVTSFs,                             &JetContainer::fillBlocksFixed<Tracks | JVTSFs> },
+    { Tracks | JVTSFs | BTags,                     &JetContainer::fillBlocksFixed<Tracks | JVTSFs | BTags> },
+    { Tracks | JVTSFs | FlavorTag | BTags,         &JetContainer::fillBlocksFixed<Tracks | JVTSFs | FlavorTag | BTags> },
+    { Tracks | JVTSFs | Truth,                     &JetContainer::fillBlocksFixed<Tracks | JVTSFs | Truth> },
+    { Tracks | JVTSFs | BTags | Truth,             &JetContainer::fillBlocksFixed<Tracks | JVTSFs | BTags | Truth> },
+    { Tracks | JVTSFs | FlavorTag | BTags | Truth, &JetContainer::fillBlocksFixed<Tracks | JVTSFs | FlavorTag | BTags | Truth> },
+    { Scales | Tracks | JVTSFs,                    &JetContainer::fillBlocksFixed<Scales | Tracks | JVTSFs> },
+    { Trigger,                                     &JetContainer::fillBlocksFixed<Trigger> }
+  };
+
+  m_fillBlocksFn = &JetContainer::fillBlocks;
+  for(const auto& profile : profiles){
+    if ( profile.first == m_fillBlocks ) m_fillBlocksFn = profile.second;
   }
+}
 
-  if (m_infoSwitch.m_clean || m_infoSwitch.m_cleanLight) {
-
-    if(m_infoSwitch.m_clean){
-
-      static SG::AuxElement::ConstAccessor<float> jetTime ("Timing");
-      safeFill<float, float, xAOD::Jet>(jet, jetTime, m_Timing, -999);
-
-      static SG::AuxElement::ConstAccessor<float> LArQuality ("LArQuality");
-      safeFill<float, float, xAOD::Jet>(jet, LArQuality, m_LArQuality, -999);
-
-      static SG::AuxElement::ConstAccessor<float> hecq ("HECQuality");
-      safeFill<float, float, xAOD::Jet>(jet, hecq, m_HECQuality, -999);
-
-      static SG::AuxElement::ConstAccessor<float> negE ("NegativeE");
-      safeFill<float, float, xAOD::Jet>(jet, negE, m_NegativeE, -999, m_units);
-
-      static SG::AuxElement::ConstAccessor<float> avLArQF ("AverageLArQF");
-      safeFill<float, float, xAOD::Jet>(jet, avLArQF, m_AverageLArQF, -999);
-
-      static SG::AuxElement::ConstAccessor<float> bchCorrCell ("BchCorrCell");
-      safeFill<float, float, xAOD::Jet>(jet, bchCorrCell, m_BchCorrCell, -999);
-
-      static SG::AuxElement::ConstAccessor<float> N90Const ("N90Constituents");
-      safeFill<float, float, xAOD::Jet>(jet, N90Const, m_N90Constituents, -999);
-
-      static SG::AuxElement::ConstAccessor<float> LArBadHVEFrac ("LArBadHVEnergyFrac");
-      safeFill<float, float, xAOD::Jet>(jet, LArBadHVEFrac, m_LArBadHVEnergyFrac, -999);
-
-      static SG::AuxElement::ConstAccessor<int> LArBadHVNCell ("LArBadHVNCell");
-      safeFill<int, int, xAOD::Jet>(jet, LArBadHVNCell, m_LArBadHVNCell, -999);
-
-      static SG::AuxElement::ConstAccessor<float> OotFracClus5 ("OotFracClusters5");
-      safeFill<float, float, xAOD::Jet>(jet, OotFracClus5, m_OotFracClusters5, -999);
-
-      static SG::AuxElement::ConstAccessor<float> OotFracClus10 ("OotFracClusters10");
-      safeFill<float, float, xAOD::Jet>(jet, OotFracClus10, m_OotFracClusters10, -999);
-
-      static SG::AuxElement::ConstAccessor<float> leadClusPt ("LeadingClusterPt");
-      safeFill<float, float, xAOD::Jet>(jet, leadClusPt, m_LeadingClusterPt, -999);
-
-      static SG::AuxElement::ConstAccessor<float> leadClusSecondLambda ("LeadingClusterSecondLambda");
-      safeFill<float, float, xAOD::Jet>(jet, leadClusSecondLambda, m_LeadingClusterSecondLambda, -999);
-
-      static SG::AuxElement::ConstAccessor<float> leadClusCenterLambda ("LeadingClusterCenterLambda");
-      safeFill<float, float, xAOD::Jet>(jet, leadClusCenterLambda, m_LeadingClusterCenterLambda, -999);
+void JetContainer::fillBlocks( const xAOD::Jet* jet, const xAOD::Vertex* pv, int pvLocation ){
+  if ( m_fillBlocks & Rapidity ) fillRapidity( jet );
+  if ( m_fillBlocks & Trigger ) fillTrigger( jet );
+  if ( m_fillBlocks & Scales ) fillScales( jet );
+  if ( m_fillBlocks & ConstScaleEta ) fillConstScaleEta( jet );
+  if ( m_fillBlocks & DetectorEta ) fillDetectorEta( jet );
+  if ( m_fillBlocks & Layer ) fillLayer( jet );
+  if ( m_fillBlocks & Tracks ) fillTracks( jet, pvLocation );
+  if ( m_fillBlocks & JVTSFs ) fillJVTSFs( jet );
+  if ( m_fillBlocks & AllTrack ) fillAllTrack( jet, pv );
+  if ( m_fillBlocks & Constituent ) fillConstituent( jet );
+  if ( m_fillBlocks & ConstituentAll ) fillConstituentAll( jet );
+  if ( m_fillBlocks & FlavorTag ) fillFlavorTag( jet );
+  if ( m_fillBlocks & BTags ) fillBTags( jet );
+  if ( m_fillBlocks & Area ) fillArea( jet );
+  if ( m_fillBlocks & Truth ) fillTruth( jet );
+  if ( m_fillBlocks & TruthDetails ) fillTruthDetails( jet );
+  if ( m_fillBlocks & Charge ) fillCharge( jet );
+  if ( m_fillBlocks & PassSel ) fillPassSel( jet );
+  if ( m_fillBlocks & PassOR ) fillPassOR( jet );
+}
 
-      static SG::AuxElement::ConstAccessor<float> leadClusSecondR ("LeadingClusterSecondR");
-      safeFill<float, float, xAOD::Jet>(jet, leadClusSecondR, m_LeadingClusterSecondR, -999);
+template<unsigned int BLOCKS>
+void JetContainer::fillBlocksFixed( const xAOD::Jet* jet, const xAOD::Vertex* pv, int pvLocation ){
+  // BLOCKS is a constant, so the disabled blocks are compiled out and the enabled ones can be inlined
+  if ( BLOCKS & Rapidity ) fillRapidity( jet );
+  if ( BLOCKS & Trigger ) fillTrigger( jet );
+  if ( BLOCKS & Scales ) fillScales( jet );
+  if ( BLOCKS & ConstScaleEta ) fillConstScaleEta( jet );
+  if ( BLOCKS & DetectorEta ) fillDetectorEta( jet );
+  if ( BLOCKS & Layer ) fillLayer( jet );
+  if ( BLOCKS & Tracks ) fillTracks( jet, pvLocation );
+  if ( BLOCKS & JVTSFs ) fillJVTSFs( jet );
+  if ( BLOCKS & AllTrack ) fillAllTrack( jet, pv );
+  if ( BLOCKS & Constituent ) fillConstituent( jet );
+  if ( BLOCKS & ConstituentAll ) fillConstituentAll( jet );
+  if ( BLOCKS & FlavorTag ) fillFlavorTag( jet );
+  if ( BLOCKS & BTags ) fillBTags( jet );
+  if ( BLOCKS & Area ) fillArea( jet );
+  if ( BLOCKS & Truth ) fillTruth( jet );
+  if ( BLOCKS & TruthDetails ) fillTruthDetails( jet );
+  if ( BLOCKS & Charge ) fillCharge( jet );
+  if ( BLOCKS & PassSel ) fillPassSel( jet );
+  if ( BLOCKS & PassOR ) fillPassOR( jet );
+}
 
-      if(!m_infoSwitch.m_cleanTrig) {
-        static SG::AuxElement::ConstAccessor<int> clean_passLooseBadUgly ("clean_passLooseBadUgly");
-        safeFill<int, int, xAOD::Jet>(jet, clean_passLooseBadUgly, m_clean_passLooseBadUgly, -999);
-        
-        static SG::AuxElement::ConstAccessor<int> clean_passTightBadUgly ("clean_passTightBadUgly");
-        safeFill<int, int, xAOD::Jet>(jet, clean_passTightBadUgly, m_clean_passTightBadUgly, -999);
-      }
-      else {
-        static SG::AuxElement::ConstAccessor<int> clean_passLooseBadTriggerUgly ("clean_passLooseBadTriggerUgly");
-        safeFill<int, int, xAOD::Jet>(jet, clean_passLooseBadTriggerUgly, m_clean_passLooseBadTriggerUgly, -999);
-      }
-      
-    }
+void JetContainer::fillRapidity( const xAOD::Jet* jet ){
+  m_rapidity->push_back( jet->rapidity() );
+}
 
-    if(!m_infoSwitch.m_cleanTrig) {
-      static SG::AuxElement::ConstAccessor<int> clean_passLooseBad ("clean_passLooseBad");
-      safeFill<int, int, xAOD::Jet>(jet, clean_passLooseBad, m_clean_passLooseBad, -999);
+void JetContainer::fillTrigger( const xAOD::Jet* jet ){
+  // retrieve the bits w/ the tested and the matched chains, see xAH::TrigMatchBits
+  //
+  static SG::AuxElement::ConstAccessor< unsigned long long > trigMatchTestedBitsJetAcc("trigMatchTestedBitsJet");
+  static SG::AuxElement::ConstAccessor< unsigned long long > isTrigMatchedBitsJetAcc("isTrigMatchedBitsJet");
 
-      static SG::AuxElement::ConstAccessor<int> clean_passTightBad ("clean_passTightBad");
-      safeFill<int, int, xAOD::Jet>(jet, clean_passTightBad, m_clean_passTightBad, -999);
-    }
-    else {
-      static SG::AuxElement::ConstAccessor<int> clean_passLooseBadTrigger ("clean_passLooseBadTrigger");
-      safeFill<int, int, xAOD::Jet>(jet, clean_passLooseBadTrigger, m_clean_passLooseBadTrigger, -999);
-    }
+  std::vector<int> matches;
 
-  } // clean
-  if(m_infoSwitch.m_timing && !m_infoSwitch.m_clean){
-    static SG::AuxElement::ConstAccessor<float> jetTime ("Timing");
-    safeFill<float, float, xAOD::Jet>(jet, jetTime, m_Timing, -999);
+  if ( trigMatchTestedBitsJetAcc.isAvailable( *jet ) && trigMatchTestedBitsJetAcc( *jet ) ) {
+    // unpack the bits and fill branches
+    //
+    xAH::TrigMatchBits::unpack( trigMatchTestedBitsJetAcc( *jet ), isTrigMatchedBitsJetAcc( *jet ), matches, *m_listTrigChains );
+  } else {
+    matches.push_back( -1 );
+    m_listTrigChains->push_back("NONE");
   }
 
+  m_isTrigMatchedToChain->push_back(matches);
+  
+  // if at least one match among the chains is found, say this jet is trigger matched
+  if ( std::find(matches.begin(), matches.end(), 1) != matches.end() ) { m_isTrigMatched->push_back(1); }
+  else { m_isTrigMatched->push_back(0); }
+}
 
-  if ( m_infoSwitch.m_energy | m_infoSwitch.m_energyLight ) {
-
-    if ( m_infoSwitch.m_energy ){
-
-      static SG::AuxElement::ConstAccessor<float> HECf ("HECFrac");
-      safeFill<float, float, xAOD::Jet>(jet, HECf, m_HECFrac, -999);
-
-      static SG::AuxElement::ConstAccessor<float> centroidR ("CentroidR");
-      safeFill<float, float, xAOD::Jet>(jet, centroidR, m_CentroidR, -999);
+void JetContainer::fillScales( const xAOD::Jet* jet ){
+  xAOD::JetFourMom_t fourVec;
+  bool status(false);
+  // EM Scale
+  status = jet->getAttribute<xAOD::JetFourMom_t>( "JetEMScaleMomentum", fourVec );
+  if( status ) { 
+    m_emScalePt->push_back( fourVec.Pt() / m_units );
+    m_emScaleM->push_back( fourVec.M() / m_units );
+  }
+  else { 
+    m_emScalePt->push_back( -999 ); 
+    m_emScaleM->push_back( -999 ); 
+  }
+  // Constit Scale
+  status = jet->getAttribute<xAOD::JetFourMom_t>( "JetConstitScaleMomentum", fourVec );
+  if( status ) { 
+    m_constScalePt->push_back( fourVec.Pt() / m_units ); 
+    m_constScaleM->push_back( fourVec.M() / m_units ); 
+  }
+  else { 
+    m_constScalePt->push_back( -999 ); 
+    m_constScaleM->push_back( -999 ); 
+  }
+  // Pileup Scale
+  status = jet->getAttribute<xAOD::JetFourMom_t>( "JetPileupScaleMomentum", fourVec );
+  if( status ) { 
+    m_pileupScalePt->push_back( fourVec.Pt() / m_units ); 
+    m_pileupScaleM->push_back( fourVec.M() / m_units ); 
+  }
+  else { 
+    m_pileupScalePt->push_back( -999 ); 
+    m_pileupScaleM->push_back( -999 ); 
+  }
+  // OriginConstit Scale
+  status = jet->getAttribute<xAOD::JetFourMom_t>( "JetOriginConstitScaleMomentum", fourVec );
+  if( status ) {
+    m_originConstitScalePt->push_back( fourVec.Pt() / m_units ); 
+    m_originConstitScaleM->push_back( fourVec.M() / m_units ); 
+  }
+  else { 
+    m_originConstitScalePt->push_back( -999 ); 
+    m_originConstitScaleM->push_back( -999 ); 
+  }
+  // EtaJES Scale
+  status = jet->getAttribute<xAOD::JetFourMom_t>( "JetEtaJESScaleMomentum", fourVec );
+  if( status ) { 
+    m_etaJESScalePt->push_back( fourVec.Pt() / m_units );
+    m_etaJESScaleM->push_back( fourVec.M() / m_units );
+  }
+  else { 
+    m_etaJESScalePt->push_back( -999 ); 
+    m_etaJESScaleM->push_back( -999 ); 
+  }
+  // GSC Scale
+  status = jet->getAttribute<xAOD::JetFourMom_t>( "JetGSCScaleMomentum", fourVec );
+  if( status ) { 
+    m_gscScalePt->push_back( fourVec.Pt() / m_units ); 
+    m_gscScaleM->push_back( fourVec.M() / m_units ); 
+  }
+  else {
+    m_gscScalePt->push_back( -999 ); 
+    m_gscScaleM->push_back( -999 ); 
+  }
+  // EtaJES Scale
+  status = jet->getAttribute<xAOD::JetFourMom_t>( "JetJMSScaleMomentum", fourVec );
+  if( status ) {
+    m_jmsScalePt->push_back( fourVec.Pt() / m_units );
+    m_jmsScaleM->push_back( fourVec.M() / m_units );
+  }
+  else {
+    m_jmsScalePt->push_back( -999 );
+    m_jmsScaleM->push_back( -999 );
+  }
+  // only available in data
+  status = jet->getAttribute<xAOD::JetFourMom_t>( "JetInsituScaleMomentum", fourVec );
+  if(status) { 
+    m_insituScalePt->push_back( fourVec.Pt() / m_units ); 
+    m_insituScaleM->push_back( fourVec.M() / m_units ); 
+  }
+  else { 
+    m_insituScalePt->push_back( -999 ); 
+    m_insituScaleM->push_back( -999 ); 
+  }
+}
 
-      static SG::AuxElement::ConstAccessor<float> lowEtFrac ("LowEtConstituentsFrac");
-      safeFill<float, float, xAOD::Jet>(jet, lowEtFrac, m_LowEtConstituentsFrac, -999);
+void JetContainer::fillConstScaleEta( const xAOD::Jet* jet ){
+  xAOD::JetFourMom_t fourVec;
+  bool status(false);
+  status = jet->getAttribute<xAOD::JetFourMom_t>( "JetConstitScaleMomentum", fourVec );
+  if( status ) { m_constScaleEta->push_back( fourVec.Eta() ); }
+  else { m_constScaleEta->push_back( -999 ); }
+}
 
-    }
+void JetContainer::fillDetectorEta( const xAOD::Jet* jet ){
+  static SG::AuxElement::ConstAccessor<float> DetEta ("DetectorEta");
+  safeFill<float, float, xAOD::Jet>(jet, DetEta, m_detectorEta, -999);
+}
 
-    static SG::AuxElement::ConstAccessor<float> EMf ("EMFrac");
-    safeFill<float, float, xAOD::Jet>(jet, EMf, m_EMFrac, -999);
+void JetContainer::fillLayer( const xAOD::Jet* jet ){
+  static SG::AuxElement::ConstAccessor< std::vector<float> > ePerSamp ("EnergyPerSampling");
+  if ( ePerSamp.isAvailable( *jet ) ) {
+    m_EnergyPerSampling->push_back( ePerSamp( *jet ) );
+    m_EnergyPerSampling->back();
+    std::transform((m_EnergyPerSampling->back()).begin(),
+                   (m_EnergyPerSampling->back()).end(),
+                   (m_EnergyPerSampling->back()).begin(),
+                   std::bind2nd(std::divides<float>(), m_units));
+  } else {
+    // could push back a vector of 24...
+    // ... waste of space vs prevention of out of range down stream
+    std::vector<float> junk(1,-999);
+    m_EnergyPerSampling->push_back( junk );
+  }
+}
 
-    static SG::AuxElement::ConstAccessor<float> fracSampMax ("FracSamplingMax");
-    safeFill<float, float, xAOD::Jet>(jet, fracSampMax, m_FracSamplingMax, -999);
+void JetContainer::fillTracks( const xAOD::Jet* jet, int pvLocation ){
+  // several moments calculated from all verticies
+  // one accessor for each and just use appropiately in the following
+  static SG::AuxElement::ConstAccessor< std::vector<int> >   nTrk1000("NumTrkPt1000");
+  static SG::AuxElement::ConstAccessor< std::vector<float> > sumPt1000("SumPtTrkPt1000");
+  static SG::AuxElement::ConstAccessor< std::vector<float> > trkWidth1000("TrackWidthPt1000");
+  static SG::AuxElement::ConstAccessor< std::vector<int> >   nTrk500 ("NumTrkPt500");
+  static SG::AuxElement::ConstAccessor< std::vector<float> > sumPt500 ("SumPtTrkPt500");
+  static SG::AuxElement::ConstAccessor< std::vector<float> > trkWidth500 ("TrackWidthPt500");
+  static SG::AuxElement::ConstAccessor< std::vector<float> > jvf("JVF");
 
-    static SG::AuxElement::ConstAccessor<int> fracSampMaxIdx ("FracSamplingMaxIndex");
-    safeFill<int, float, xAOD::Jet>(jet, fracSampMaxIdx, m_FracSamplingMaxIndex, -999);
+  if ( m_infoSwitch.m_trackAll ) {
 
-    static SG::AuxElement::ConstAccessor<int> muonSegCount ("GhostMuonSegmentCount");
-    safeFill<int, float, xAOD::Jet>(jet, muonSegCount, m_GhostMuonSegmentCount, -999);
+    std::vector<int> junkInt(1,-999);
+    std::vector<float> junkFlt(1,-999);
 
-    static SG::AuxElement::ConstAccessor<float> width ("Width");
-    safeFill<float, float, xAOD::Jet>(jet, width, m_Width, -999);
+    if ( nTrk1000.isAvailable( *jet ) ) {
+      m_NumTrkPt1000->push_back( nTrk1000( *jet ) );
+    } else { m_NumTrkPt1000->push_back( junkInt ); }
 
-  } // energy
+    if ( sumPt1000.isAvailable( *jet ) ) {
+      m_SumPtTrkPt1000->push_back( sumPt1000( *jet ) );
+      std::transform((m_SumPtTrkPt1000->back()).begin(),
+                   (m_SumPtTrkPt1000->back()).end(),
+                   (m_SumPtTrkPt1000->back()).begin(),
+                   std::bind2nd(std::divides<float>(), m_units));
+    } else { m_SumPtTrkPt1000->push_back( junkFlt ); }
 
-  // each step of the calibration sequence
-  if ( m_infoSwitch.m_scales ) {
-    xAOD::JetFourMom_t fourVec;
-    bool status(false);
-    // EM Scale
-    status = jet->getAttribute<xAOD::JetFourMom_t>( "JetEMScaleMomentum", fourVec );
-    if( status ) { 
-      m_emScalePt->push_back( fourVec.Pt() / m_units );
-      m_emScaleM->push_back( fourVec.M() / m_units );
-    }
-    else { 
-      m_emScalePt->push_back( -999 ); 
-      m_emScaleM->push_back( -999 ); 
-    }
-    // Constit Scale
-    status = jet->getAttribute<xAOD::JetFourMom_t>( "JetConstitScaleMomentum", fourVec );
-    if( status ) { 
-      m_constScalePt->push_back( fourVec.Pt() / m_units ); 
-      m_constScaleM->push_back( fourVec.M() / m_units ); 
-    }
-    else { 
-      m_constScalePt->push_back( -999 ); 
-      m_constScaleM->push_back( -999 ); 
-    }
-    // Pileup Scale
-    status = jet->getAttribute<xAOD::JetFourMom_t>( "JetPileupScaleMomentum", fourVec );
-    if( status ) { 
-      m_pileupScalePt->push_back( fourVec.Pt() / m_units ); 
-      m_pileupScaleM->push_back( fourVec.M() / m_units ); 
-    }
-    else { 
-      m_pileupScalePt->push_back( -999 ); 
-      m_pileupScaleM->push_back( -999 ); 
-    }
-    // OriginConstit Scale
-    status = jet->getAttribute<xAOD::JetFourMom_t>( "JetOriginConstitScaleMomentum", fourVec );
-    if( status ) {
-      m_originConstitScalePt->push_back( fourVec.Pt() / m_units ); 
-      m_originConstitScaleM->push_back( fourVec.M() / m_units ); 
-    }
-    else { 
-      m_originConstitScalePt->push_back( -999 ); 
-      m_originConstitScaleM->push_back( -999 ); 
-    }
-    // EtaJES Scale
-    status = jet->getAttribute<xAOD::JetFourMom_t>( "JetEtaJESScaleMomentum", fourVec );
-    if( status ) { 
-      m_etaJESScalePt->push_back( fourVec.Pt() / m_units );
-      m_etaJESScaleM->push_back( fourVec.M() / m_units );
-    }
-    else { 
-      m_etaJESScalePt->push_back( -999 ); 
-      m_etaJESScaleM->push_back( -999 ); 
-    }
-    // GSC Scale
-    status = jet->getAttribute<xAOD::JetFourMom_t>( "JetGSCScaleMomentum", fourVec );
-    if( status ) { 
-      m_gscScalePt->push_back( fourVec.Pt() / m_units ); 
-      m_gscScaleM->push_back( fourVec.M() / m_units ); 
-    }
-    else {
-      m_gscScalePt->push_back( -999 ); 
-      m_gscScaleM->push_back( -999 ); 
-    }
-    // EtaJES Scale
-    status = jet->getAttribute<xAOD::JetFourMom_t>( "JetJMSScaleMomentum", fourVec );
-    if( status ) {
-      m_jmsScalePt->push_back( fourVec.Pt() / m_units );
-      m_jmsScaleM->push_back( fourVec.M() / m_units );
-    }
-    else {
-      m_jmsScalePt->push_back( -999 );
-      m_jmsScaleM->push_back( -999 );
-    }
-    // only available in data
-    status = jet->getAttribute<xAOD::JetFourMom_t>( "JetInsituScaleMomentum", fourVec );
-    if(status) { 
-      m_insituScalePt->push_back( fourVec.Pt() / m_units ); 
-      m_insituScaleM->push_back( fourVec.M() / m_units ); 
-    }
-    else { 
-      m_insituScalePt->push_back( -999 ); 
-      m_insituScaleM->push_back( -999 ); 
-    }
-  }
+    if ( trkWidth1000.isAvailable( *jet ) ) {
+      m_TrackWidthPt1000->push_back( trkWidth1000( *jet ) );
+    } else { m_TrackWidthPt1000->push_back( junkFlt ); }
 
-  if ( m_infoSwitch.m_constscaleEta ) {
-    xAOD::JetFourMom_t fourVec;
-    bool status(false);
-    status = jet->getAttribute<xAOD::JetFourMom_t>( "JetConstitScaleMomentum", fourVec );
-    if( status ) { m_constScaleEta->push_back( fourVec.Eta() ); }
-    else { m_constScaleEta->push_back( -999 ); }
-  }
+    if ( nTrk500.isAvailable( *jet ) ) {
+      m_NumTrkPt500->push_back( nTrk500( *jet ) );
+    } else { m_NumTrkPt500->push_back( junkInt ); }
 
-  if ( m_infoSwitch.m_detectorEta ) {
-    static SG::AuxElement::ConstAccessor<float> DetEta ("DetectorEta");
-    safeFill<float, float, xAOD::Jet>(jet, DetEta, m_detectorEta, -999);
-  }
+    if ( sumPt500.isAvailable( *jet ) ) {
+      m_SumPtTrkPt500->push_back( sumPt500( *jet ) );
+      std::transform((m_SumPtTrkPt500->back()).begin(),
+                   (m_SumPtTrkPt500->back()).end(),
+                   (m_SumPtTrkPt500->back()).begin(),
+                   std::bind2nd(std::divides<float>(), m_units));
+    } else { m_SumPtTrkPt500->push_back( junkFlt ); }
 
-  if ( m_infoSwitch.m_layer ) {
-    static SG::AuxElement::ConstAccessor< std::vector<float> > ePerSamp ("EnergyPerSampling");
-    if ( ePerSamp.isAvailable( *jet ) ) {
-      m_EnergyPerSampling->push_back( ePerSamp( *jet ) );
-      m_EnergyPerSampling->back();
-      std::transform((m_EnergyPerSampling->back()).begin(),
-                     (m_EnergyPerSampling->back()).end(),
-                     (m_EnergyPerSampling->back()).begin(),
-                     std::bind2nd(std::divides<float>(), m_units));
-    } else {
-      // could push back a vector of 24...
-      // ... waste of space vs prevention of out of range down stream
-      std::vector<float> junk(1,-999);
-      m_EnergyPerSampling->push_back( junk );
-    }
-  }
+    if ( trkWidth500.isAvailable( *jet ) ) {
+      m_TrackWidthPt500->push_back( trkWidth500( *jet ) );
+    } else { m_TrackWidthPt500->push_back( junkFlt ); }
 
-  if ( m_infoSwitch.m_trackAll || m_infoSwitch.m_trackPV || m_infoSwitch.m_jvt || m_infoSwitch.m_clean ) {
+    if ( jvf.isAvailable( *jet ) ) {
+      m_JVF->push_back( jvf( *jet ) );
+    } else { m_JVF->push_back( junkFlt ); }
 
-    // several moments calculated from all verticies
-    // one accessor for each and just use appropiately in the following
-    static SG::AuxElement::ConstAccessor< std::vector<int> >   nTrk1000("NumTrkPt1000");
-    static SG::AuxElement::ConstAccessor< std::vector<float> > sumPt1000("SumPtTrkPt1000");
-    static SG::AuxElement::ConstAccessor< std::vector<float> > trkWidth1000("TrackWidthPt1000");
-    static SG::AuxElement::ConstAccessor< std::vector<int> >   nTrk500 ("NumTrkPt500");
-    static SG::AuxElement::ConstAccessor< std::vector<float> > sumPt500 ("SumPtTrkPt500");
-    static SG::AuxElement::ConstAccessor< std::vector<float> > trkWidth500 ("TrackWidthPt500");
-    static SG::AuxElement::ConstAccessor< std::vector<float> > jvf("JVF");
+  } // trackAll
 
-    if ( m_infoSwitch.m_trackAll ) {
+  if ( m_infoSwitch.m_trackPV || m_infoSwitch.m_jvt ) {
 
-      std::vector<int> junkInt(1,-999);
-      std::vector<float> junkFlt(1,-999);
+    if ( m_infoSwitch.m_trackPV && pvLocation >= 0 ) {
 
       if ( nTrk1000.isAvailable( *jet ) ) {
-        m_NumTrkPt1000->push_back( nTrk1000( *jet ) );
-      } else { m_NumTrkPt1000->push_back( junkInt ); }
+        m_NumTrkPt1000PV->push_back( nTrk1000( *jet )[pvLocation] );
+      } else { m_NumTrkPt1000PV->push_back( -999 ); }
 
       if ( sumPt1000.isAvailable( *jet ) ) {
-        m_SumPtTrkPt1000->push_back( sumPt1000( *jet ) );
-        std::transform((m_SumPtTrkPt1000->back()).begin(),
-                     (m_SumPtTrkPt1000->back()).end(),
-                     (m_SumPtTrkPt1000->back()).begin(),
-                     std::bind2nd(std::divides<float>(), m_units));
-      } else { m_SumPtTrkPt1000->push_back( junkFlt ); }
+        m_SumPtTrkPt1000PV->push_back( sumPt1000( *jet )[pvLocation] / m_units );
+      } else { m_SumPtTrkPt1000PV->push_back( -999 ); }
 
       if ( trkWidth1000.isAvailable( *jet ) ) {
-        m_TrackWidthPt1000->push_back( trkWidth1000( *jet ) );
-      } else { m_TrackWidthPt1000->push_back( junkFlt ); }
+        m_TrackWidthPt1000PV->push_back( trkWidth1000( *jet )[pvLocation] );
+      } else { m_TrackWidthPt1000PV->push_back( -999 ); }
 
       if ( nTrk500.isAvailable( *jet ) ) {
-        m_NumTrkPt500->push_back( nTrk500( *jet ) );
-      } else { m_NumTrkPt500->push_back( junkInt ); }
+        m_NumTrkPt500PV->push_back( nTrk500( *jet )[pvLocation] );
+      } else { m_NumTrkPt500PV->push_back( -999 ); }
 
       if ( sumPt500.isAvailable( *jet ) ) {
-        m_SumPtTrkPt500->push_back( sumPt500( *jet ) );
-        std::transform((m_SumPtTrkPt500->back()).begin(),
-                     (m_SumPtTrkPt500->back()).end(),
-                     (m_SumPtTrkPt500->back()).begin(),
-                     std::bind2nd(std::divides<float>(), m_units));
-      } else { m_SumPtTrkPt500->push_back( junkFlt ); }
+        m_SumPtTrkPt500PV->push_back( sumPt500( *jet )[pvLocation] / m_units );
+      } else { m_SumPtTrkPt500PV->push_back( -999 ); }
 
       if ( trkWidth500.isAvailable( *jet ) ) {
-        m_TrackWidthPt500->push_back( trkWidth500( *jet ) );
-      } else { m_TrackWidthPt500->push_back( junkFlt ); }
+        m_TrackWidthPt500PV->push_back( trkWidth500( *jet )[pvLocation] );
+      } else { m_TrackWidthPt500PV->push_back( -999 ); }
 
       if ( jvf.isAvailable( *jet ) ) {
-        m_JVF->push_back( jvf( *jet ) );
-      } else { m_JVF->push_back( junkFlt ); }
-
-    } // trackAll
-
-    if ( m_infoSwitch.m_trackPV || m_infoSwitch.m_jvt ) {
-
-      if ( m_infoSwitch.m_trackPV && pvLocation >= 0 ) {
+        m_JVFPV->push_back( jvf( *jet )[pvLocation] );
+      } else { m_JVFPV->push_back( -999 ); }
 
-        if ( nTrk1000.isAvailable( *jet ) ) {
-          m_NumTrkPt1000PV->push_back( nTrk1000( *jet )[pvLocation] );
-        } else { m_NumTrkPt1000PV->push_back( -999 ); }
+      static SG::AuxElement::ConstAccessor< float > jvtJvfcorr ("JVFCorr");
+      safeFill<float, float, xAOD::Jet>(jet, jvtJvfcorr, m_JvtJvfcorr, -999);
 
-        if ( sumPt1000.isAvailable( *jet ) ) {
-          m_SumPtTrkPt1000PV->push_back( sumPt1000( *jet )[pvLocation] / m_units );
-        } else { m_SumPtTrkPt1000PV->push_back( -999 ); }
+      static SG::AuxElement::ConstAccessor< float > jvtRpt ("JvtRpt");
+      safeFill<float, float, xAOD::Jet>(jet, jvtRpt, m_JvtRpt, -999);
 
-        if ( trkWidth1000.isAvailable( *jet ) ) {
-          m_TrackWidthPt1000PV->push_back( trkWidth1000( *jet )[pvLocation] );
-        } else { m_TrackWidthPt1000PV->push_back( -999 ); }
+    } // trackPV
 
-        if ( nTrk500.isAvailable( *jet ) ) {
-          m_NumTrkPt500PV->push_back( nTrk500( *jet )[pvLocation] );
-        } else { m_NumTrkPt500PV->push_back( -999 ); }
+    static SG::AuxElement::ConstAccessor< float > jvt ("Jvt");
+    safeFill<float, float, xAOD::Jet>(jet, jvt, m_Jvt, -999);
 
-        if ( sumPt500.isAvailable( *jet ) ) {
-          m_SumPtTrkPt500PV->push_back( sumPt500( *jet )[pvLocation] / m_units );
-        } else { m_SumPtTrkPt500PV->push_back( -999 ); }
+    //      static SG::AuxElement::ConstAccessor<float> ghostTrackAssFrac("GhostTrackAssociationFraction");
+    //      if ( ghostTrackAssFrac.isAvailable( *jet) ) {
+    //        m_ghostTrackAssFrac->push_back( ghostTrackAssFrac( *jet) );
+    //      } else { m_ghostTrackAssFrac->push_back( -999 ) ; }
 
-        if ( trkWidth500.isAvailable( *jet ) ) {
-          m_TrackWidthPt500PV->push_back( trkWidth500( *jet )[pvLocation] );
-        } else { m_TrackWidthPt500PV->push_back( -999 ); }
+  } // trackPV || JVT
 
-        if ( jvf.isAvailable( *jet ) ) {
-          m_JVFPV->push_back( jvf( *jet )[pvLocation] );
-        } else { m_JVFPV->push_back( -999 ); }
+  if ( m_infoSwitch.m_clean && pvLocation >= 0 ) {
 
-        static SG::AuxElement::ConstAccessor< float > jvtJvfcorr ("JVFCorr");
-        safeFill<float, float, xAOD::Jet>(jet, jvtJvfcorr, m_JvtJvfcorr, -999);
-
-        static SG::AuxElement::ConstAccessor< float > jvtRpt ("JvtRpt");
-        safeFill<float, float, xAOD::Jet>(jet, jvtRpt, m_JvtRpt, -999);
-
-      } // trackPV
-
-      static SG::AuxElement::ConstAccessor< float > jvt ("Jvt");
-      safeFill<float, float, xAOD::Jet>(jet, jvt, m_Jvt, -999);
-
-      //      static SG::AuxElement::ConstAccessor<float> ghostTrackAssFrac("GhostTrackAssociationFraction");
-      //      if ( ghostTrackAssFrac.isAvailable( *jet) ) {
-      //        m_ghostTrackAssFrac->push_back( ghostTrackAssFrac( *jet) );
-      //      } else { m_ghostTrackAssFrac->push_back( -999 ) ; }
-
-    } // trackPV || JVT
-
-    if ( m_infoSwitch.m_clean && pvLocation >= 0 ) {
-
-      static SG::AuxElement::ConstAccessor< float > ChargedFraction("ChargedFraction");
-      static SG::AuxElement::Decorator< float > chargedFractionDecor("ChargedFraction");
-      if ( !chargedFractionDecor.isAvailable( *jet ) ) {
-        // calculate and decorate
-        if ( sumPt500.isAvailable( *jet ) ) {
-          m_ChargedFraction->push_back( sumPt500( *jet )[pvLocation] / jet->pt() ); // units cancel out
-        } else {
-          m_ChargedFraction->push_back( -999. );
-        }
-
-        chargedFractionDecor( *jet ) = m_ChargedFraction->back();
+    static SG::AuxElement::ConstAccessor< float > ChargedFraction("ChargedFraction");
+    static SG::AuxElement::Decorator< float > chargedFractionDecor("ChargedFraction");
+    if ( !chargedFractionDecor.isAvailable( *jet ) ) {
+      // calculate and decorate
+      if ( sumPt500.isAvailable( *jet ) ) {
+        m_ChargedFraction->push_back( sumPt500( *jet )[pvLocation] / jet->pt() ); // units cancel out
       } else {
-        safeFill<float, float, xAOD::Jet>(jet, ChargedFraction, m_ChargedFraction, -999);
+        m_ChargedFraction->push_back( -999. );
       }
-    } // clean
 
-  } // trackAll || trackPV || JVT
+      chargedFractionDecor( *jet ) = m_ChargedFraction->back();
+    } else {
+      safeFill<float, float, xAOD::Jet>(jet, ChargedFraction, m_ChargedFraction, -999);
+    }
+  } // clean
+}
 
+void JetContainer::fillJVTSFs( const xAOD::Jet* jet ){
   static SG::AuxElement::ConstAccessor< char > jvtPass_Loose("JetJVT_Passed_Loose");
   static SG::AuxElement::ConstAccessor< char > jvtPass_Medium("JetJVT_Passed_Medium");
   static SG::AuxElement::ConstAccessor< char > jvtPass_Tight("JetJVT_Passed_Tight");
@@ -2789,487 +2776,487 @@ void JetContainer::FillJet( const xAOD::IParticle* particle, const xAOD::Vertex*
     }
   }
 
-  if ( m_infoSwitch.m_allTrack ) {
-    static SG::AuxElement::ConstAccessor< int > ghostTrackCount("GhostTrackCount");
-    safeFill<int, int, xAOD::Jet>(jet, ghostTrackCount, m_GhostTrackCount, -999);
-
-    static SG::AuxElement::ConstAccessor< float > ghostTrackPt ("GhostTrackPt");
-    safeFill<float, float, xAOD::Jet>(jet, ghostTrackPt, m_GhostTrackPt, -999, m_units);
-
-    std::vector<float> pt;
-    std::vector<float> qOverP;
-    std::vector<float> eta;
-    std::vector<float> phi;
-    std::vector<float> e;
-    std::vector<float> d0;
-    std::vector<float> z0;
-    std::vector<int> nPixHits;
-    std::vector<int> nSCTHits;
-    std::vector<int> nTRTHits;
-    std::vector<int> nPixSharedHits;
-    std::vector<int> nPixSplitHits;
-    std::vector<int> nIMLPixHits;
-    std::vector<int> nIMLPixSharedHits;
-    std::vector<int> nIMLPixSplitHits;
-    std::vector<int> nNIMLPixHits;
-    std::vector<int> nNIMLPixSharedHits;
-    std::vector<int> nNIMLPixSplitHits;
-    static SG::AuxElement::ConstAccessor< std::vector<ElementLink<DataVector<xAOD::IParticle> > > >ghostTrack ("GhostTrack");
-    if ( ghostTrack.isAvailable( *jet ) ) {
-      std::vector<ElementLink<DataVector<xAOD::IParticle> > > trackLinks = ghostTrack( *jet );
-      //std::vector<float> pt(trackLinks.size(),-999);
-      for ( auto link_itr : trackLinks ) {
-        if( !link_itr.isValid() ) { continue; }
-        const xAOD::TrackParticle* track = dynamic_cast<const xAOD::TrackParticle*>( *link_itr );
-        // if asking for tracks passing PV selection ( i.e. JVF JVT tracks )
-        if( m_infoSwitch.m_allTrackPVSel ) {
-          // PV selection from
-          // https://twiki.cern.ch/twiki/bin/view/AtlasProtected/JvtManualRecalculation
-          if( track->pt() < 500 )                { continue; } // pT cut
-          if( !m_trkSelTool->accept(*track,pv) ) { continue; } // ID quality cut
-          if( track->vertex() != pv ) {                        // if not in PV vertex fit
-            if( track->vertex() != 0 )           { continue; } // make sure in no vertex fits
-            if( fabs((track->z0()+track->vz()-pv->z())*sin(track->theta())) > 3.0 ) { continue; } // make sure close to PV in z
-          }
-        }
-        pt. push_back( track->pt() / m_units );
-        qOverP.push_back( track->qOverP() * m_units );
-        eta.push_back( track->eta() );
-        phi.push_back( track->phi() );
-        e.  push_back( track->e()  / m_units );
-        d0. push_back( track->d0() );
-        z0. push_back( track->z0() + track->vz() - pv->z() ); // store z0 wrt PV...most useful
-        if( m_infoSwitch.m_allTrackDetail ) {
-          uint8_t getInt(0);
-          // n pix, sct, trt
-          track->summaryValue( getInt, xAOD::numberOfPixelHits );
-          nPixHits.push_back( getInt );
-          track->summaryValue( getInt, xAOD::numberOfSCTHits );
-          nSCTHits.push_back( getInt );
-          track->summaryValue( getInt, xAOD::numberOfTRTHits );
-          nTRTHits.push_back( getInt );
-          // pixel split shared
-          track->summaryValue( getInt, xAOD::numberOfPixelSharedHits );
-          nPixSharedHits.push_back( getInt );
-          track->summaryValue( getInt, xAOD::numberOfPixelSplitHits );
-          nPixSplitHits.push_back( getInt );
-          // n ibl, split, shared
-          track->summaryValue( getInt, xAOD::numberOfInnermostPixelLayerHits );
-          nIMLPixHits.push_back( getInt );
-          track->summaryValue( getInt, xAOD::numberOfInnermostPixelLayerSharedHits );
-          nIMLPixSharedHits.push_back( getInt );
-          track->summaryValue( getInt, xAOD::numberOfInnermostPixelLayerSplitHits );
-          nIMLPixSplitHits.push_back( getInt );
-          // n bl,  split, shared
-          track->summaryValue( getInt, xAOD::numberOfNextToInnermostPixelLayerHits );
-          nNIMLPixHits.push_back( getInt );
-          track->summaryValue( getInt, xAOD::numberOfNextToInnermostPixelLayerSharedHits );
-          nNIMLPixSharedHits.push_back( getInt );
-          track->summaryValue( getInt, xAOD::numberOfNextToInnermostPixelLayerSplitHits );
-          nNIMLPixSplitHits.push_back( getInt );
+}
+
+void JetContainer::fillAllTrack( const xAOD::Jet* jet, const xAOD::Vertex* pv ){
+  static SG::AuxElement::ConstAccessor< int > ghostTrackCount("GhostTrackCount");
+  safeFill<int, int, xAOD::Jet>(jet, ghostTrackCount, m_GhostTrackCount, -999);
+
+  static SG::AuxElement::ConstAccessor< float > ghostTrackPt ("GhostTrackPt");
+  safeFill<float, float, xAOD::Jet>(jet, ghostTrackPt, m_GhostTrackPt, -999, m_units);
+
+  std::vector<float> pt;
+  std::vector<float> qOverP;
+  std::vector<float> eta;
+  std::vector<float> phi;
+  std::vector<float> e;
+  std::vector<float> d0;
+  std::vector<float> z0;
+  std::vector<int> nPixHits;
+  std::vector<int> nSCTHits;
+  std::vector<int> nTRTHits;
+  std::vector<int> nPixSharedHits;
+  std::vector<int> nPixSplitHits;
+  std::vector<int> nIMLPixHits;
+  std::vector<int> nIMLPixSharedHits;
+  std::vector<int> nIMLPixSplitHits;
+  std::vector<int> nNIMLPixHits;
+  std::vector<int> nNIMLPixSharedHits;
+  std::vector<int> nNIMLPixSplitHits;
+  static SG::AuxElement::ConstAccessor< std::vector<ElementLink<DataVector<xAOD::IParticle> > > >ghostTrack ("GhostTrack");
+  if ( ghostTrack.isAvailable( *jet ) ) {
+    std::vector<ElementLink<DataVector<xAOD::IParticle> > > trackLinks = ghostTrack( *jet );
+    //std::vector<float> pt(trackLinks.size(),-999);
+    for ( auto link_itr : trackLinks ) {
+      if( !link_itr.isValid() ) { continue; }
+      const xAOD::TrackParticle* track = dynamic_cast<const xAOD::TrackParticle*>( *link_itr );
+      // if asking for tracks passing PV selection ( i.e. JVF JVT tracks )
+      if( m_infoSwitch.m_allTrackPVSel ) {
+        // PV selection from
+        // https://twiki.cern.ch/twiki/bin/view/AtlasProtected/JvtManualRecalculation
+        if( track->pt() < 500 )                { continue; } // pT cut
+        if( !m_trkSelTool->accept(*track,pv) ) { continue; } // ID quality cut
+        if( track->vertex() != pv ) {                        // if not in PV vertex fit
+          if( track->vertex() != 0 )           { continue; } // make sure in no vertex fits
+          if( fabs((track->z0()+track->vz()-pv->z())*sin(track->theta())) > 3.0 ) { continue; } // make sure close to PV in z
         }
       }
-    } // if ghostTrack available
-    m_GhostTrack_pt-> push_back( pt  );
-    m_GhostTrack_qOverP-> push_back( qOverP );
-    m_GhostTrack_eta->push_back( eta );
-    m_GhostTrack_phi->push_back( phi );
-    m_GhostTrack_e->  push_back( e   );
-    m_GhostTrack_d0-> push_back( d0  );
-    m_GhostTrack_z0-> push_back( z0  );
-    if( m_infoSwitch.m_allTrackDetail ) {
-      m_GhostTrack_nPixelHits->push_back( nPixHits );
-      m_GhostTrack_nSCTHits->push_back( nSCTHits );
-      m_GhostTrack_nTRTHits->push_back( nTRTHits );
-      m_GhostTrack_nPixelSharedHits->push_back( nPixSharedHits );
-      m_GhostTrack_nPixelSplitHits->push_back( nPixSplitHits );
-      m_GhostTrack_nInnermostPixelLayerHits->push_back( nIMLPixHits );
-      m_GhostTrack_nInnermostPixelLayerSharedHits->push_back( nIMLPixSharedHits );
-      m_GhostTrack_nInnermostPixelLayerSplitHits->push_back( nIMLPixSplitHits );
-      m_GhostTrack_nNextToInnermostPixelLayerHits->push_back( nNIMLPixHits );
-      m_GhostTrack_nNextToInnermostPixelLayerSharedHits->push_back( nNIMLPixSharedHits );
-      m_GhostTrack_nNextToInnermostPixelLayerSplitHits->push_back( nNIMLPixSplitHits );
-    }
-  } // allTrack switch
-
-  if( m_infoSwitch.m_constituent ) {
-    m_numConstituents->push_back( jet->numConstituents() );
+      pt. push_back( track->pt() / m_units );
+      qOverP.push_back( track->qOverP() * m_units );
+      eta.push_back( track->eta() );
+      phi.push_back( track->phi() );
+      e.  push_back( track->e()  / m_units );
+      d0. push_back( track->d0() );
+      z0. push_back( track->z0() + track->vz() - pv->z() ); // store z0 wrt PV...most useful
+      if( m_infoSwitch.m_allTrackDetail ) {
+        uint8_t getInt(0);
+        // n pix, sct, trt
+        track->summaryValue( getInt, xAOD::numberOfPixelHits );
+        nPixHits.push_back( getInt );
+        track->summaryValue( getInt, xAOD::numberOfSCTHits );
+        nSCTHits.push_back( getInt );
+        track->summaryValue( getInt, xAOD::numberOfTRTHits );
+        nTRTHits.push_back( getInt );
+        // pixel split shared
+        track->summaryValue( getInt, xAOD::numberOfPixelSharedHits );
+        nPixSharedHits.push_back( getInt );
+        track->summaryValue( getInt, xAOD::numberOfPixelSplitHits );
+        nPixSplitHits.push_back( getInt );
+        // n ibl, split, shared
+        track->summaryValue( getInt, xAOD::numberOfInnermostPixelLayerHits );
+        nIMLPixHits.push_back( getInt );
+        track->summaryValue( getInt, xAOD::numberOfInnermostPixelLayerSharedHits );
+        nIMLPixSharedHits.push_back( getInt );
+        track->summaryValue( getInt, xAOD::numberOfInnermostPixelLayerSplitHits );
+        nIMLPixSplitHits.push_back( getInt );
+        // n bl,  split, shared
+        track->summaryValue( getInt, xAOD::numberOfNextToInnermostPixelLayerHits );
+        nNIMLPixHits.push_back( getInt );
+        track->summaryValue( getInt, xAOD::numberOfNextToInnermostPixelLayerSharedHits );
+        nNIMLPixSharedHits.push_back( getInt );
+        track->summaryValue( getInt, xAOD::numberOfNextToInnermostPixelLayerSplitHits );
+        nNIMLPixSplitHits.push_back( getInt );
+      }
+    }
+  } // if ghostTrack available
+  m_GhostTrack_pt-> push_back( pt  );
+  m_GhostTrack_qOverP-> push_back( qOverP );
+  m_GhostTrack_eta->push_back( eta );
+  m_GhostTrack_phi->push_back( phi );
+  m_GhostTrack_e->  push_back( e   );
+  m_GhostTrack_d0-> push_back( d0  );
+  m_GhostTrack_z0-> push_back( z0  );
+  if( m_infoSwitch.m_allTrackDetail ) {
+    m_GhostTrack_nPixelHits->push_back( nPixHits );
+    m_GhostTrack_nSCTHits->push_back( nSCTHits );
+    m_GhostTrack_nTRTHits->push_back( nTRTHits );
+    m_GhostTrack_nPixelSharedHits->push_back( nPixSharedHits );
+    m_GhostTrack_nPixelSplitHits->push_back( nPixSplitHits );
+    m_GhostTrack_nInnermostPixelLayerHits->push_back( nIMLPixHits );
+    m_GhostTrack_nInnermostPixelLayerSharedHits->push_back( nIMLPixSharedHits );
+    m_GhostTrack_nInnermostPixelLayerSplitHits->push_back( nIMLPixSplitHits );
+    m_GhostTrack_nNextToInnermostPixelLayerHits->push_back( nNIMLPixHits );
+    m_GhostTrack_nNextToInnermostPixelLayerSharedHits->push_back( nNIMLPixSharedHits );
+    m_GhostTrack_nNextToInnermostPixelLayerSplitHits->push_back( nNIMLPixSplitHits );
   }
+}
 
-  if( m_infoSwitch.m_constituentAll ) {
-    m_constituentWeights->push_back( jet->getAttribute< std::vector<float> >( "constituentWeights" ) );
-    std::vector<float> pt;
-    std::vector<float> eta;
-    std::vector<float> phi;
-    std::vector<float> e;
-    xAOD::JetConstituentVector consVec = jet->getConstituents();
-    if( consVec.isValid() ) {
-      // don't use auto since iterator can also set the scale ...
-      // not sure what that does with auto - probably default but just incase
-      // use the example provided in
-      // http://acode-browser.usatlas.bnl.gov/lxr/source/atlas/Event/xAOD/xAODJet/xAODJet/JetConstituentVector.h
-      xAOD::JetConstituentVector::iterator constit = consVec.begin();
-      xAOD::JetConstituentVector::iterator constitE = consVec.end();
-      for( ; constit != constitE; constit++){
-        pt. push_back( constit->pt() / m_units );
-        eta.push_back( constit->eta() );
-        phi.push_back( constit->phi() );
-        e.  push_back( constit->e() / m_units  );
-      }
+void JetContainer::fillConstituent( const xAOD::Jet* jet ){
+  m_numConstituents->push_back( jet->numConstituents() );
+}
+
+void JetContainer::fillConstituentAll( const xAOD::Jet* jet ){
+  // the precision of each variable is set by the constituentBits detail
+  m_constituentWeights->newEntry();
+  for( float weight : jet->getAttribute< std::vector<float> >( "constituentWeights" ) )
+    m_constituentWeights->fill( HelperFunctions::reducePrecision( weight, m_infoSwitch.m_constitWeightsBits ) );
+
+  m_constituent_pt ->newEntry();
+  m_constituent_eta->newEntry();
+  m_constituent_phi->newEntry();
+  m_constituent_e  ->newEntry();
+  xAOD::JetConstituentVector consVec = jet->getConstituents();
+  if( consVec.isValid() ) {
+    // use the example provided in
+    // http://acode-browser.usatlas.bnl.gov/lxr/source/atlas/Event/xAOD/xAODJet/xAODJet/JetConstituentVector.h
+    xAOD::JetConstituentVector::iterator constit = consVec.begin();
+    xAOD::JetConstituentVector::iterator constitE = consVec.end();
+    for( ; constit != constitE; constit++){
+      m_constituent_pt ->fill( HelperFunctions::reducePrecision( constit->pt() / m_units, m_infoSwitch.m_constitPtBits  ) );
+      m_constituent_eta->fill( HelperFunctions::reducePrecision( constit->eta(),          m_infoSwitch.m_constitEtaBits ) );
+      m_constituent_phi->fill( HelperFunctions::reducePrecision( constit->phi(),          m_infoSwitch.m_constitPhiBits ) );
+      m_constituent_e  ->fill( HelperFunctions::reducePrecision( constit->e() / m_units,  m_infoSwitch.m_constitEBits   ) );
     }
-    m_constituent_pt-> push_back( pt  );
-    m_constituent_eta->push_back( eta );
-    m_constituent_phi->push_back( phi );
-    m_constituent_e->  push_back( e   );
-  }
-
-  if ( m_infoSwitch.m_flavorTag || m_infoSwitch.m_flavorTagHLT ) {
-    const xAOD::BTagging * myBTag(0);
-
-    if(m_infoSwitch.m_flavorTag){
-      myBTag = jet->btagging();
-    }else if(m_infoSwitch.m_flavorTagHLT){
-      myBTag = jet->auxdata< const xAOD::BTagging* >("HLTBTag");
-    }
-
-    if(m_infoSwitch.m_JVC ) {
-      static SG::AuxElement::ConstAccessor<double> JetVertexCharge_discriminant("JetVertexCharge_discriminant");
-      safeFill<double, double, xAOD::BTagging>(myBTag, JetVertexCharge_discriminant, m_JetVertexCharge_discriminant, -999);
-    }
-
-    // MV2c taggers
-    double val;
-
-    val=-999;
-    myBTag->variable<double>("MV2c00"   , "discriminant", val);
-    m_MV2c00   ->push_back( val );
-
-    val=-999;
-    myBTag->variable<double>("MV2c10"   , "discriminant", val);
-    m_MV2c10   ->push_back( val );
-    val=-999;
-    myBTag->variable<double>("MV2c10mu" , "discriminant", val);
-    m_MV2c10mu ->push_back( val );
-
-    val=-999;
-    myBTag->variable<double>("MV2c10rnn", "discriminant", val);
-    m_MV2c10rnn->push_back( val );
-    val=-999;
-    myBTag->variable<double>("MV2c20"   , "discriminant", val);
-    m_MV2c20   ->push_back( val );
-    
-    val=-999;
-    myBTag->variable<double>("MV2rmu" , "discriminant", val);
-    m_MV2rmu ->push_back( val );
-
-    val=-999;
-    myBTag->variable<double>("MV2r", "discriminant", val);
-    m_MV2r->push_back( val );
-
-    val=-999;
-    myBTag->variable<double>("MV2c100"  , "discriminant", val);
-    m_MV2c100  ->push_back( val );
-
-    // DL1 taggers
-    double pu, pb, pc, score;
-
-    pu=0; pb=0; pc=0;
-    myBTag->variable<double>("DL1" , "pu", pu);
-    myBTag->variable<double>("DL1" , "pc", pc);
-    myBTag->variable<double>("DL1" , "pb", pb);
-    score=log( pb / (0.08*pc+0.92*pu) );
-    m_DL1_pu->push_back(pu);
-    m_DL1_pc->push_back(pc);
-    m_DL1_pb->push_back(pb);
-    m_DL1->push_back( score );
-
-    pu=0; pb=0; pc=0;
-    myBTag->variable<double>("DL1mu" , "pu", pu);
-    myBTag->variable<double>("DL1mu" , "pc", pc);
-    myBTag->variable<double>("DL1mu" , "pb", pb);
-    score=log( pb / (0.08*pc+0.92*pu) );
-    m_DL1mu_pu->push_back(pu);
-    m_DL1mu_pc->push_back(pc);
-    m_DL1mu_pb->push_back(pb);
-    m_DL1mu->push_back( score );
-
-    pu=0; pb=0; pc=0;
-    myBTag->variable<double>("DL1rnn" , "pu", pu);
-    myBTag->variable<double>("DL1rnn" , "pc", pc);
-    myBTag->variable<double>("DL1rnn" , "pb", pb);
-    score=log( pb / (0.03*pc+0.97*pu) );
-    m_DL1rnn_pu->push_back(pu);
-    m_DL1rnn_pc->push_back(pc);
-    m_DL1rnn_pb->push_back(pb);
-    m_DL1rnn->push_back( score );
-    
-    pu=0; pb=0; pc=0;
-    myBTag->variable<double>("DL1rmu" , "pu", pu);
-    myBTag->variable<double>("DL1rmu" , "pc", pc);
-    myBTag->variable<double>("DL1rmu" , "pb", pb);
-    score=log( pb / (0.08*pc+0.92*pu) );
-    m_DL1rmu_pu->push_back(pu);
-    m_DL1rmu_pc->push_back(pc);
-    m_DL1rmu_pb->push_back(pb);
-    m_DL1rmu->push_back( score );
-
-    pu=0; pb=0; pc=0;
-    myBTag->variable<double>("DL1r" , "pu", pu);
-    myBTag->variable<double>("DL1r" , "pc", pc);
-    myBTag->variable<double>("DL1r" , "pb", pb);
-    score=log( pb / (0.03*pc+0.97*pu) );
-    m_DL1r_pu->push_back(pu);
-    m_DL1r_pc->push_back(pc);
-    m_DL1r_pb->push_back(pb);
-    m_DL1r->push_back( score );
-
-    // flavor groups truth definition
-    static SG::AuxElement::ConstAccessor<int> hadConeExclTruthLabel("HadronConeExclTruthLabelID");
-    safeFill<int, int, xAOD::Jet>(jet, hadConeExclTruthLabel, m_HadronConeExclTruthLabelID, -999);
-
-    static SG::AuxElement::ConstAccessor<int> hadConeExclExtendedTruthLabel("HadronConeExclExtendedTruthLabelID");
-    safeFill<int, int, xAOD::Jet>(jet, hadConeExclExtendedTruthLabel, m_HadronConeExclExtendedTruthLabelID, -999);
-
-    if(m_infoSwitch.m_jetFitterDetails ) {
-
-      static SG::AuxElement::ConstAccessor< int   > jf_nVTXAcc       ("JetFitter_nVTX");
-      safeFill<int, float, xAOD::BTagging>(myBTag, jf_nVTXAcc, m_JetFitter_nVTX, -999);
-
-      static SG::AuxElement::ConstAccessor< int   > jf_nSingleTracks ("JetFitter_nSingleTracks");
-      safeFill<int, float, xAOD::BTagging>(myBTag, jf_nSingleTracks, m_JetFitter_nSingleTracks, -999);
-
-      static SG::AuxElement::ConstAccessor< int   > jf_nTracksAtVtx  ("JetFitter_nTracksAtVtx");
-      safeFill<int, float, xAOD::BTagging>(myBTag, jf_nTracksAtVtx, m_JetFitter_nTracksAtVtx, -999);
-
-      static SG::AuxElement::ConstAccessor< float > jf_mass          ("JetFitter_mass");
-      safeFill<float, float, xAOD::BTagging>(myBTag, jf_mass, m_JetFitter_mass, -999);
-
-      static SG::AuxElement::ConstAccessor< float > jf_energyFraction("JetFitter_energyFraction");
-      safeFill<float, float, xAOD::BTagging>(myBTag, jf_energyFraction, m_JetFitter_energyFraction, -999);
-
-      static SG::AuxElement::ConstAccessor< float > jf_significance3d("JetFitter_significance3d");
-      safeFill<float, float, xAOD::BTagging>(myBTag, jf_significance3d, m_JetFitter_significance3d, -999);
-
-      static SG::AuxElement::ConstAccessor< float > jf_deltaeta      ("JetFitter_deltaeta");
-      safeFill<float, float, xAOD::BTagging>(myBTag, jf_deltaeta, m_JetFitter_deltaeta, -999);
-
-      static SG::AuxElement::ConstAccessor< float > jf_deltaphi      ("JetFitter_deltaphi");
-      safeFill<float, float, xAOD::BTagging>(myBTag, jf_deltaphi, m_JetFitter_deltaphi, -999);
-
-      static SG::AuxElement::ConstAccessor< int   > jf_N2Tpar        ("JetFitter_N2Tpair");
-      safeFill<int, float, xAOD::BTagging>(myBTag, jf_N2Tpar, m_JetFitter_N2Tpar, -999);
-
-      //static SG::AuxElement::ConstAccessor< double > jf_pb           ("JetFitterCombNN_pb");
-      //safeFill<double, float, xAOD::BTagging>(myBTag, jf_pb, m_JetFitter_pb, -999);
-      //
-      //static SG::AuxElement::ConstAccessor< double > jf_pc           ("JetFitterCombNN_pc");
-      //safeFill<double, float, xAOD::BTagging>(myBTag, jf_pc, m_JetFitter_pc, -999);
-      //
-      //static SG::AuxElement::ConstAccessor< double > jf_pu           ("JetFitterCombNN_pu");
-      //safeFill<double, float, xAOD::BTagging>(myBTag, jf_pu, m_JetFitter_pu, -999);
-
-    }
-
-    if(m_infoSwitch.m_svDetails ) {
-      if(m_debug) std::cout << "Filling m_svDetails " << std::endl;
-
-      /// @brief SV0 : Number of good tracks in vertex
-      static SG::AuxElement::ConstAccessor< int   >   sv0_NGTinSvxAcc     ("SV0_NGTinSvx");
-      safeFill<int, float, xAOD::BTagging>(myBTag,    sv0_NGTinSvxAcc, m_sv0_NGTinSvx, -999);
-
-      // @brief SV0 : Number of 2-track pairs
-      static SG::AuxElement::ConstAccessor< int   >   sv0_N2TpairAcc      ("SV0_N2Tpair");
-      safeFill<int, float, xAOD::BTagging>(myBTag, sv0_N2TpairAcc, m_sv0_N2Tpair, -999);
-
-      /// @brief SV0 : vertex mass
-      static SG::AuxElement::ConstAccessor< float   > sv0_masssvxAcc      ("SV0_masssvx");
-      safeFill<float, float, xAOD::BTagging>(myBTag, sv0_masssvxAcc, m_sv0_massvx, -999);
-
-      /// @brief SV0 : energy fraction
-      static SG::AuxElement::ConstAccessor< float   > sv0_efracsvxAcc     ("SV0_efracsvx");
-      safeFill<float, float, xAOD::BTagging>(myBTag, sv0_efracsvxAcc, m_sv0_efracsvx, -999);
-
-      /// @brief SV0 : 3D vertex significance
-      static SG::AuxElement::ConstAccessor< float   > sv0_normdistAcc     ("SV0_normdist");
-      safeFill<float, float, xAOD::BTagging>(myBTag, sv0_normdistAcc, m_sv0_normdist, -999);
+  }
+}
 
-      double sv0;
-      myBTag->variable<double>("SV0", "significance3D", sv0);
-      m_SV0->push_back(sv0);
+void JetContainer::fillFlavorTag( const xAOD::Jet* jet ){
+  const xAOD::BTagging * myBTag(0);
 
-      m_SV1IP3D->push_back( myBTag -> SV1plusIP3D_discriminant() );
+  if(m_infoSwitch.m_flavorTag){
+    myBTag = jet->btagging();
+  }else if(m_infoSwitch.m_flavorTagHLT){
+    myBTag = jet->auxdata< const xAOD::BTagging* >("HLTBTag");
+  }
 
-      double w=(myBTag->IP3D_pb()/myBTag->IP3D_pu()) * (myBTag->SV1_pb()/myBTag->SV1_pu());
-      double x=50;
-      if(w/(1+w)<1) x=-1.0*TMath::Log10(1-(w/(1+w)));
-      m_COMBx->push_back(x);
+  if(m_infoSwitch.m_JVC ) {
+    static SG::AuxElement::ConstAccessor<double> JetVertexCharge_discriminant("JetVertexCharge_discriminant");
+    safeFill<double, double, xAOD::BTagging>(myBTag, JetVertexCharge_discriminant, m_JetVertexCharge_discriminant, -999);
+  }
 
-      /// @brief SV1 : Number of good tracks in vertex
-      static SG::AuxElement::ConstAccessor< int   >   sv1_NGTinSvxAcc     ("SV1_NGTinSvx");
-      safeFill<int, float, xAOD::BTagging>(myBTag, sv1_NGTinSvxAcc, m_sv1_NGTinSvx, -999);
+  // MV2c taggers
+  double val;
 
-      // @brief SV1 : Number of 2-track pairs
-      static SG::AuxElement::ConstAccessor< int   >   sv1_N2TpairAcc      ("SV1_N2Tpair");
-      safeFill<int, float, xAOD::BTagging>(myBTag, sv1_N2TpairAcc, m_sv1_N2Tpair, -999);
+  val=-999;
+  myBTag->variable<double>("MV2c00"   , "discriminant", val);
+  m_MV2c00   ->push_back( val );
 
-      /// @brief SV1 : vertex mass
-      static SG::AuxElement::ConstAccessor< float   > sv1_masssvxAcc      ("SV1_masssvx");
-      safeFill<float, float, xAOD::BTagging>(myBTag, sv1_masssvxAcc, m_sv1_massvx, -999);
+  val=-999;
+  myBTag->variable<double>("MV2c10"   , "discriminant", val);
+  m_MV2c10   ->push_back( val );
+  val=-999;
+  myBTag->variable<double>("MV2c10mu" , "discriminant", val);
+  m_MV2c10mu ->push_back( val );
 
-      /// @brief SV1 : energy fraction
-      static SG::AuxElement::ConstAccessor< float   > sv1_efracsvxAcc     ("SV1_efracsvx");
-      safeFill<float, float, xAOD::BTagging>(myBTag, sv1_efracsvxAcc, m_sv1_efracsvx, -999);
+  val=-999;
+  myBTag->variable<double>("MV2c10rnn", "discriminant", val);
+  m_MV2c10rnn->push_back( val );
+  val=-999;
+  myBTag->variable<double>("MV2c20"   , "discriminant", val);
+  m_MV2c20   ->push_back( val );
+  
+  val=-999;
+  myBTag->variable<double>("MV2rmu" , "discriminant", val);
+  m_MV2rmu ->push_back( val );
+
+  val=-999;
+  myBTag->variable<double>("MV2r", "discriminant", val);
+  m_MV2r->push_back( val );
+
+  val=-999;
+  myBTag->variable<double>("MV2c100"  , "discriminant", val);
+  m_MV2c100  ->push_back( val );
+
+  // DL1 taggers
+  double pu, pb, pc, score;
+
+  pu=0; pb=0; pc=0;
+  myBTag->variable<double>("DL1" , "pu", pu);
+  myBTag->variable<double>("DL1" , "pc", pc);
+  myBTag->variable<double>("DL1" , "pb", pb);
+  score=log( pb / (0.08*pc+0.92*pu) );
+  m_DL1_pu->push_back(pu);
+  m_DL1_pc->push_back(pc);
+  m_DL1_pb->push_back(pb);
+  m_DL1->push_back( score );
+
+  pu=0; pb=0; pc=0;
+  myBTag->variable<double>("DL1mu" , "pu", pu);
+  myBTag->variable<double>("DL1mu" , "pc", pc);
+  myBTag->variable<double>("DL1mu" , "pb", pb);
+  score=log( pb / (0.08*pc+0.92*pu) );
+  m_DL1mu_pu->push_back(pu);
+  m_DL1mu_pc->push_back(pc);
+  m_DL1mu_pb->push_back(pb);
+  m_DL1mu->push_back( score );
+
+  pu=0; pb=0; pc=0;
+  myBTag->variable<double>("DL1rnn" , "pu", pu);
+  myBTag->variable<double>("DL1rnn" , "pc", pc);
+  myBTag->variable<double>("DL1rnn" , "pb", pb);
+  score=log( pb / (0.03*pc+0.97*pu) );
+  m_DL1rnn_pu->push_back(pu);
+  m_DL1rnn_pc->push_back(pc);
+  m_DL1rnn_pb->push_back(pb);
+  m_DL1rnn->push_back( score );
+  
+  pu=0; pb=0; pc=0;
+  myBTag->variable<double>("DL1rmu" , "pu", pu);
+  myBTag->variable<double>("DL1rmu" , "pc", pc);
+  myBTag->variable<double>("DL1rmu" , "pb", pb);
+  score=log( pb / (0.08*pc+0.92*pu) );
+  m_DL1rmu_pu->push_back(pu);
+  m_DL1rmu_pc->push_back(pc);
+  m_DL1rmu_pb->push_back(pb);
+  m_DL1rmu->push_back( score );
 
-      /// @brief SV1 : 3D vertex significance
-      static SG::AuxElement::ConstAccessor< float   > sv1_normdistAcc     ("SV1_normdist");
-      safeFill<float, float, xAOD::BTagging>(myBTag, sv1_normdistAcc, m_sv1_normdist, -999);
+  pu=0; pb=0; pc=0;
+  myBTag->variable<double>("DL1r" , "pu", pu);
+  myBTag->variable<double>("DL1r" , "pc", pc);
+  myBTag->variable<double>("DL1r" , "pb", pb);
+  score=log( pb / (0.03*pc+0.97*pu) );
+  m_DL1r_pu->push_back(pu);
+  m_DL1r_pc->push_back(pc);
+  m_DL1r_pb->push_back(pb);
+  m_DL1r->push_back( score );
 
-      double sv1_pu = -30;  myBTag->variable<double>("SV1", "pu", sv1_pu);
-      double sv1_pb = -30;  myBTag->variable<double>("SV1", "pb", sv1_pb);
-      double sv1_pc = -30;  myBTag->variable<double>("SV1", "pc", sv1_pc);
+  // flavor groups truth definition
+  static SG::AuxElement::ConstAccessor<int> hadConeExclTruthLabel("HadronConeExclTruthLabelID");
+  safeFill<int, int, xAOD::Jet>(jet, hadConeExclTruthLabel, m_HadronConeExclTruthLabelID, -999);
 
-      m_sv1_pu         ->push_back(sv1_pu);
-      m_sv1_pb         ->push_back(sv1_pb);
-      m_sv1_pc         ->push_back(sv1_pc);
-      m_SV1            ->push_back( myBTag->calcLLR(sv1_pb,sv1_pu)  );
-      m_sv1_c          ->push_back( myBTag->calcLLR(sv1_pb,sv1_pc)  );
-      m_sv1_cu         ->push_back( myBTag->calcLLR(sv1_pc,sv1_pu)  );
+  static SG::AuxElement::ConstAccessor<int> hadConeExclExtendedTruthLabel("HadronConeExclExtendedTruthLabelID");
+  safeFill<int, int, xAOD::Jet>(jet, hadConeExclExtendedTruthLabel, m_HadronConeExclExtendedTruthLabelID, -999);
 
-      float sv1_Lxy;        myBTag->variable<float>("SV1", "Lxy"         , sv1_Lxy);
-      float sv1_sig3d;      myBTag->variable<float>("SV1", "significance3d"         , sv1_sig3d);
-      float sv1_L3d;        myBTag->variable<float>("SV1", "L3d"         , sv1_L3d);
-      float sv1_distmatlay; myBTag->variable<float>("SV1", "dstToMatLay" , sv1_distmatlay);
-      float sv1_dR;         myBTag->variable<float>("SV1", "deltaR"      , sv1_dR );
+  if(m_infoSwitch.m_jetFitterDetails ) {
 
-      m_sv1_Lxy        ->push_back(sv1_Lxy        );
-      m_sv1_sig3d      ->push_back(sv1_sig3d      );
-      m_sv1_L3d        ->push_back(sv1_L3d        );
-      m_sv1_distmatlay ->push_back(sv1_distmatlay );
-      m_sv1_dR         ->push_back(sv1_dR         );
+    static SG::AuxElement::ConstAccessor< int   > jf_nVTXAcc       ("JetFitter_nVTX");
+    safeFill<int, float, xAOD::BTagging>(myBTag, jf_nVTXAcc, m_JetFitter_nVTX, -999);
 
+    static SG::AuxElement::ConstAccessor< int   > jf_nSingleTracks ("JetFitter_nSingleTracks");
+    safeFill<int, float, xAOD::BTagging>(myBTag, jf_nSingleTracks, m_JetFitter_nSingleTracks, -999);
 
-    }
+    static SG::AuxElement::ConstAccessor< int   > jf_nTracksAtVtx  ("JetFitter_nTracksAtVtx");
+    safeFill<int, float, xAOD::BTagging>(myBTag, jf_nTracksAtVtx, m_JetFitter_nTracksAtVtx, -999);
 
-    if(m_infoSwitch.m_ipDetails ) {
-      if(m_debug) std::cout << "Filling m_ipDetails " << std::endl;
+    static SG::AuxElement::ConstAccessor< float > jf_mass          ("JetFitter_mass");
+    safeFill<float, float, xAOD::BTagging>(myBTag, jf_mass, m_JetFitter_mass, -999);
 
-      //
-      // IP2D
-      //
+    static SG::AuxElement::ConstAccessor< float > jf_energyFraction("JetFitter_energyFraction");
+    safeFill<float, float, xAOD::BTagging>(myBTag, jf_energyFraction, m_JetFitter_energyFraction, -999);
 
-      /// @brief IP2D: track grade
-      static SG::AuxElement::ConstAccessor< std::vector<int>   >   IP2D_gradeOfTracksAcc     ("IP2D_gradeOfTracks");
-      safeVecFill<int, float, xAOD::BTagging>(myBTag, IP2D_gradeOfTracksAcc, m_IP2D_gradeOfTracks);
+    static SG::AuxElement::ConstAccessor< float > jf_significance3d("JetFitter_significance3d");
+    safeFill<float, float, xAOD::BTagging>(myBTag, jf_significance3d, m_JetFitter_significance3d, -999);
 
-      /// @brief IP2D : tracks from V0
-      static SG::AuxElement::ConstAccessor< std::vector<bool>   >  IP2D_flagFromV0ofTracksAcc("IP2D_flagFromV0ofTracks");
-      safeVecFill<bool, float, xAOD::BTagging>(myBTag, IP2D_flagFromV0ofTracksAcc, m_IP2D_flagFromV0ofTracks);
+    static SG::AuxElement::ConstAccessor< float > jf_deltaeta      ("JetFitter_deltaeta");
+    safeFill<float, float, xAOD::BTagging>(myBTag, jf_deltaeta, m_JetFitter_deltaeta, -999);
 
-      /// @brief IP2D : d0 value with respect to primary vertex
-      static SG::AuxElement::ConstAccessor< std::vector<float>   > IP2D_valD0wrtPVofTracksAcc("IP2D_valD0wrtPVofTracks");
-      safeVecFill<float, float, xAOD::BTagging>(myBTag, IP2D_valD0wrtPVofTracksAcc, m_IP2D_valD0wrtPVofTracks);
+    static SG::AuxElement::ConstAccessor< float > jf_deltaphi      ("JetFitter_deltaphi");
+    safeFill<float, float, xAOD::BTagging>(myBTag, jf_deltaphi, m_JetFitter_deltaphi, -999);
 
-      /// @brief IP2D : d0 significance with respect to primary vertex
-      static SG::AuxElement::ConstAccessor< std::vector<float>   > IP2D_sigD0wrtPVofTracksAcc("IP2D_sigD0wrtPVofTracks");
-      safeVecFill<float, float, xAOD::BTagging>(myBTag, IP2D_sigD0wrtPVofTracksAcc, m_IP2D_sigD0wrtPVofTracks);
+    static SG::AuxElement::ConstAccessor< int   > jf_N2Tpar        ("JetFitter_N2Tpair");
+    safeFill<int, float, xAOD::BTagging>(myBTag, jf_N2Tpar, m_JetFitter_N2Tpar, -999);
 
-      /// @brief IP2D : track contribution to B likelihood
-      static SG::AuxElement::ConstAccessor< std::vector<float>   > IP2D_weightBofTracksAcc   ("IP2D_weightBofTracks");
-      safeVecFill<float, float, xAOD::BTagging>(myBTag, IP2D_weightBofTracksAcc, m_IP2D_weightBofTracks);
+    //static SG::AuxElement::ConstAccessor< double > jf_pb           ("JetFitterCombNN_pb");
+    //safeFill<double, float, xAOD::BTagging>(myBTag, jf_pb, m_JetFitter_pb, -999);
+    //
+    //static SG::AuxElement::ConstAccessor< double > jf_pc           ("JetFitterCombNN_pc");
+    //safeFill<double, float, xAOD::BTagging>(myBTag, jf_pc, m_JetFitter_pc, -999);
+    //
+    //static SG::AuxElement::ConstAccessor< double > jf_pu           ("JetFitterCombNN_pu");
+    //safeFill<double, float, xAOD::BTagging>(myBTag, jf_pu, m_JetFitter_pu, -999);
 
-      /// @brief IP2D : track contribution to C likelihood
-      static SG::AuxElement::ConstAccessor< std::vector<float>   > IP2D_weightCofTracksAcc   ("IP2D_weightCofTracks");
-      safeVecFill<float, float, xAOD::BTagging>(myBTag, IP2D_weightCofTracksAcc, m_IP2D_weightCofTracks);
+  }
 
-      /// @brief IP2D : track contribution to U likelihood
-      static SG::AuxElement::ConstAccessor< std::vector<float>   > IP2D_weightUofTracksAcc   ("IP2D_weightUofTracks");
-      safeVecFill<float, float, xAOD::BTagging>(myBTag, IP2D_weightUofTracksAcc, m_IP2D_weightUofTracks);
+  if(m_infoSwitch.m_svDetails ) {
+    if(m_debug) std::cout << "Filling m_svDetails " << std::endl;
 
-      double ip2_pu = -99;  myBTag->variable<double>("IP2D", "pu", ip2_pu);
-      double ip2_pb = -99;  myBTag->variable<double>("IP2D", "pb", ip2_pb);
-      double ip2_pc = -99;  myBTag->variable<double>("IP2D", "pc", ip2_pc);
+    /// @brief SV0 : Number of good tracks in vertex
+    static SG::AuxElement::ConstAccessor< int   >   sv0_NGTinSvxAcc     ("SV0_NGTinSvx");
+    safeFill<int, float, xAOD::BTagging>(myBTag,    sv0_NGTinSvxAcc, m_sv0_NGTinSvx, -999);
 
-      m_IP2D_pu         ->push_back(ip2_pu);
-      m_IP2D_pb         ->push_back(ip2_pb);
-      m_IP2D_pc         ->push_back(ip2_pc);
+    // @brief SV0 : Number of 2-track pairs
+    static SG::AuxElement::ConstAccessor< int   >   sv0_N2TpairAcc      ("SV0_N2Tpair");
+    safeFill<int, float, xAOD::BTagging>(myBTag, sv0_N2TpairAcc, m_sv0_N2Tpair, -999);
 
-      m_IP2D            ->push_back( myBTag->calcLLR(ip2_pb,ip2_pu)  );
-      m_IP2D_c          ->push_back( myBTag->calcLLR(ip2_pb,ip2_pc)  );
-      m_IP2D_cu         ->push_back( myBTag->calcLLR(ip2_pc,ip2_pu)  );
+    /// @brief SV0 : vertex mass
+    static SG::AuxElement::ConstAccessor< float   > sv0_masssvxAcc      ("SV0_masssvx");
+    safeFill<float, float, xAOD::BTagging>(myBTag, sv0_masssvxAcc, m_sv0_massvx, -999);
 
+    /// @brief SV0 : energy fraction
+    static SG::AuxElement::ConstAccessor< float   > sv0_efracsvxAcc     ("SV0_efracsvx");
+    safeFill<float, float, xAOD::BTagging>(myBTag, sv0_efracsvxAcc, m_sv0_efracsvx, -999);
 
-      //
-      // IP3D
-      //
+    /// @brief SV0 : 3D vertex significance
+    static SG::AuxElement::ConstAccessor< float   > sv0_normdistAcc     ("SV0_normdist");
+    safeFill<float, float, xAOD::BTagging>(myBTag, sv0_normdistAcc, m_sv0_normdist, -999);
 
-      /// @brief IP3D: track grade
-      static SG::AuxElement::ConstAccessor< std::vector<int>   >   IP3D_gradeOfTracksAcc     ("IP3D_gradeOfTracks");
-      safeVecFill<int, float, xAOD::BTagging>(myBTag, IP3D_gradeOfTracksAcc, m_IP3D_gradeOfTracks);
+    double sv0;
+    myBTag->variable<double>("SV0", "significance3D", sv0);
+    m_SV0->push_back(sv0);
 
-      /// @brief IP3D : tracks from V0
-      static SG::AuxElement::ConstAccessor< std::vector<bool>   >  IP3D_flagFromV0ofTracksAcc("IP3D_flagFromV0ofTracks");
-      safeVecFill<bool, float, xAOD::BTagging>(myBTag, IP3D_flagFromV0ofTracksAcc, m_IP3D_flagFromV0ofTracks);
+    m_SV1IP3D->push_back( myBTag -> SV1plusIP3D_discriminant() );
 
-      /// @brief IP3D : d0 value with respect to primary vertex
-      static SG::AuxElement::ConstAccessor< std::vector<float>   > IP3D_valD0wrtPVofTracksAcc("IP3D_valD0wrtPVofTracks");
-      safeVecFill<float, float, xAOD::BTagging>(myBTag, IP3D_valD0wrtPVofTracksAcc, m_IP3D_valD0wrtPVofTracks);
+    double w=(myBTag->IP3D_pb()/myBTag->IP3D_pu()) * (myBTag->SV1_pb()/myBTag->SV1_pu());
+    double x=50;
+    if(w/(1+w)<1) x=-1.0*TMath::Log10(1-(w/(1+w)));
+    m_COMBx->push_back(x);
 
-      /// @brief IP3D : d0 significance with respect to primary vertex
-      static SG::AuxElement::ConstAccessor< std::vector<float>   > IP3D_sigD0wrtPVofTracksAcc("IP3D_sigD0wrtPVofTracks");
-      safeVecFill<float, float, xAOD::BTagging>(myBTag, IP3D_sigD0wrtPVofTracksAcc, m_IP3D_sigD0wrtPVofTracks);
+    /// @brief SV1 : Number of good tracks in vertex
+    static SG::AuxElement::ConstAccessor< int   >   sv1_NGTinSvxAcc     ("SV1_NGTinSvx");
+    safeFill<int, float, xAOD::BTagging>(myBTag, sv1_NGTinSvxAcc, m_sv1_NGTinSvx, -999);
 
-      /// @brief IP3D : z0 value with respect to primary vertex
-      static SG::AuxElement::ConstAccessor< std::vector<float>   > IP3D_valZ0wrtPVofTracksAcc("IP3D_valZ0wrtPVofTracks");
-      safeVecFill<float, float, xAOD::BTagging>(myBTag, IP3D_valZ0wrtPVofTracksAcc, m_IP3D_valZ0wrtPVofTracks);
+    // @brief SV1 : Number of 2-track pairs
+    static SG::AuxElement::ConstAccessor< int   >   sv1_N2TpairAcc      ("SV1_N2Tpair");
+    safeFill<int, float, xAOD::BTagging>(myBTag, sv1_N2TpairAcc, m_sv1_N2Tpair, -999);
 
-      /// @brief IP3D : z0 significance with respect to primary vertex
-      static SG::AuxElement::ConstAccessor< std::vector<float>   > IP3D_sigZ0wrtPVofTracksAcc("IP3D_sigZ0wrtPVofTracks");
-      safeVecFill<float, float, xAOD::BTagging>(myBTag, IP3D_sigZ0wrtPVofTracksAcc, m_IP3D_sigZ0wrtPVofTracks);
+    /// @brief SV1 : vertex mass
+    static SG::AuxElement::ConstAccessor< float   > sv1_masssvxAcc      ("SV1_masssvx");
+    safeFill<float, float, xAOD::BTagging>(myBTag, sv1_masssvxAcc, m_sv1_massvx, -999);
 
-      /// @brief IP3D : track contribution to B likelihood
-      static SG::AuxElement::ConstAccessor< std::vector<float>   > IP3D_weightBofTracksAcc   ("IP3D_weightBofTracks");
-      safeVecFill<float, float, xAOD::BTagging>(myBTag, IP3D_weightBofTracksAcc, m_IP3D_weightBofTracks);
+    /// @brief SV1 : energy fraction
+    static SG::AuxElement::ConstAccessor< float   > sv1_efracsvxAcc     ("SV1_efracsvx");
+    safeFill<float, float, xAOD::BTagging>(myBTag, sv1_efracsvxAcc, m_sv1_efracsvx, -999);
 
-      /// @brief IP3D : track contribution to C likelihood
-      static SG::AuxElement::ConstAccessor< std::vector<float>   > IP3D_weightCofTracksAcc   ("IP3D_weightCofTracks");
-      safeVecFill<float, float, xAOD::BTagging>(myBTag, IP3D_weightCofTracksAcc, m_IP3D_weightCofTracks);
+    /// @brief SV1 : 3D vertex significance
+    static SG::AuxElement::ConstAccessor< float   > sv1_normdistAcc     ("SV1_normdist");
+    safeFill<float, float, xAOD::BTagging>(myBTag, sv1_normdistAcc, m_sv1_normdist, -999);
 
-      /// @brief IP3D : track contribution to U likelihood
-      static SG::AuxElement::ConstAccessor< std::vector<float>   > IP3D_weightUofTracksAcc   ("IP3D_weightUofTracks");
-      safeVecFill<float, float, xAOD::BTagging>(myBTag, IP3D_weightUofTracksAcc, m_IP3D_weightUofTracks);
+    double sv1_pu = -30;  myBTag->variable<double>("SV1", "pu", sv1_pu);
+    double sv1_pb = -30;  myBTag->variable<double>("SV1", "pb", sv1_pb);
+    double sv1_pc = -30;  myBTag->variable<double>("SV1", "pc", sv1_pc);
 
-      double ip3_pu = -30;  myBTag->variable<double>("IP3D", "pu", ip3_pu);
-      double ip3_pb = -30;  myBTag->variable<double>("IP3D", "pb", ip3_pb);
-      double ip3_pc = -30;  myBTag->variable<double>("IP3D", "pc", ip3_pc);
+    m_sv1_pu         ->push_back(sv1_pu);
+    m_sv1_pb         ->push_back(sv1_pb);
+    m_sv1_pc         ->push_back(sv1_pc);
+    m_SV1            ->push_back( myBTag->calcLLR(sv1_pb,sv1_pu)  );
+    m_sv1_c          ->push_back( myBTag->calcLLR(sv1_pb,sv1_pc)  );
+    m_sv1_cu         ->push_back( myBTag->calcLLR(sv1_pc,sv1_pu)  );
 
-      m_IP3D_pu         ->push_back(ip3_pu  );
-      m_IP3D_pb         ->push_back(ip3_pb  );
-      m_IP3D_pc         ->push_back(ip3_pc  );
+    float sv1_Lxy;        myBTag->variable<float>("SV1", "Lxy"         , sv1_Lxy);
+    float sv1_sig3d;      myBTag->variable<float>("SV1", "significance3d"         , sv1_sig3d);
+    float sv1_L3d;        myBTag->variable<float>("SV1", "L3d"         , sv1_L3d);
+    float sv1_distmatlay; myBTag->variable<float>("SV1", "dstToMatLay" , sv1_distmatlay);
+    float sv1_dR;         myBTag->variable<float>("SV1", "deltaR"      , sv1_dR );
 
-      m_IP3D            ->push_back( myBTag->calcLLR(ip3_pb,ip3_pu)  );
-      m_IP3D_c          ->push_back( myBTag->calcLLR(ip3_pb,ip3_pc)  );
-      m_IP3D_cu         ->push_back( myBTag->calcLLR(ip3_pc,ip3_pu)  );
+    m_sv1_Lxy        ->push_back(sv1_Lxy        );
+    m_sv1_sig3d      ->push_back(sv1_sig3d      );
+    m_sv1_L3d        ->push_back(sv1_L3d        );
+    m_sv1_distmatlay ->push_back(sv1_distmatlay );
+    m_sv1_dR         ->push_back(sv1_dR         );
 
-    }
+
+  }
+
+  if(m_infoSwitch.m_ipDetails ) {
+    if(m_debug) std::cout << "Filling m_ipDetails " << std::endl;
+
+    //
+    // IP2D
+    //
+
+    /// @brief IP2D: track grade
+    static SG::AuxElement::ConstAccessor< std::vector<int>   >   IP2D_gradeOfTracksAcc     ("IP2D_gradeOfTracks");
+    safeVecFill<int, float, xAOD::BTagging>(myBTag, IP2D_gradeOfTracksAcc, m_IP2D_gradeOfTracks);
+
+    /// @brief IP2D : tracks from V0
+    static SG::AuxElement::ConstAccessor< std::vector<bool>   >  IP2D_flagFromV0ofTracksAcc("IP2D_flagFromV0ofTracks");
+    safeVecFill<bool, float, xAOD::BTagging>(myBTag, IP2D_flagFromV0ofTracksAcc, m_IP2D_flagFromV0ofTracks);
+
+    /// @brief IP2D : d0 value with respect to primary vertex
+    static SG::AuxElement::ConstAccessor< std::vector<float>   > IP2D_valD0wrtPVofTracksAcc("IP2D_valD0wrtPVofTracks");
+    safeVecFill<float, float, xAOD::BTagging>(myBTag, IP2D_valD0wrtPVofTracksAcc, m_IP2D_valD0wrtPVofTracks);
+
+    /// @brief IP2D : d0 significance with respect to primary vertex
+    static SG::AuxElement::ConstAccessor< std::vector<float>   > IP2D_sigD0wrtPVofTracksAcc("IP2D_sigD0wrtPVofTracks");
+    safeVecFill<float, float, xAOD::BTagging>(myBTag, IP2D_sigD0wrtPVofTracksAcc, m_IP2D_sigD0wrtPVofTracks);
+
+    /// @brief IP2D : track contribution to B likelihood
+    static SG::AuxElement::ConstAccessor< std::vector<float>   > IP2D_weightBofTracksAcc   ("IP2D_weightBofTracks");
+    safeVecFill<float, float, xAOD::BTagging>(myBTag, IP2D_weightBofTracksAcc, m_IP2D_weightBofTracks);
+
+    /// @brief IP2D : track contribution to C likelihood
+    static SG::AuxElement::ConstAccessor< std::vector<float>   > IP2D_weightCofTracksAcc   ("IP2D_weightCofTracks");
+    safeVecFill<float, float, xAOD::BTagging>(myBTag, IP2D_weightCofTracksAcc, m_IP2D_weightCofTracks);
+
+    /// @brief IP2D : track contribution to U likelihood
+    static SG::AuxElement::ConstAccessor< std::vector<float>   > IP2D_weightUofTracksAcc   ("IP2D_weightUofTracks");
+    safeVecFill<float, float, xAOD::BTagging>(myBTag, IP2D_weightUofTracksAcc, m_IP2D_weightUofTracks);
+
+    double ip2_pu = -99;  myBTag->variable<double>("IP2D", "pu", ip2_pu);
+    double ip2_pb = -99;  myBTag->variable<double>("IP2D", "pb", ip2_pb);
+    double ip2_pc = -99;  myBTag->variable<double>("IP2D", "pc", ip2_pc);
+
+    m_IP2D_pu         ->push_back(ip2_pu);
+    m_IP2D_pb         ->push_back(ip2_pb);
+    m_IP2D_pc         ->push_back(ip2_pc);
+
+    m_IP2D            ->push_back( myBTag->calcLLR(ip2_pb,ip2_pu)  );
+    m_IP2D_c          ->push_back( myBTag->calcLLR(ip2_pb,ip2_pc)  );
+    m_IP2D_cu         ->push_back( myBTag->calcLLR(ip2_pc,ip2_pu)  );
 
 
+    //
+    // IP3D
+    //
+
+    /// @brief IP3D: track grade
+    static SG::AuxElement::ConstAccessor< std::vector<int>   >   IP3D_gradeOfTracksAcc     ("IP3D_gradeOfTracks");
+    safeVecFill<int, float, xAOD::BTagging>(myBTag, IP3D_gradeOfTracksAcc, m_IP3D_gradeOfTracks);
+
+    /// @brief IP3D : tracks from V0
+    static SG::AuxElement::ConstAccessor< std::vector<bool>   >  IP3D_flagFromV0ofTracksAcc("IP3D_flagFromV0ofTracks");
+    safeVecFill<bool, float, xAOD::BTagging>(myBTag, IP3D_flagFromV0ofTracksAcc, m_IP3D_flagFromV0ofTracks);
+
+    /// @brief IP3D : d0 value with respect to primary vertex
+    static SG::AuxElement::ConstAccessor< std::vector<float>   > IP3D_valD0wrtPVofTracksAcc("IP3D_valD0wrtPVofTracks");
+    safeVecFill<float, float, xAOD::BTagging>(myBTag, IP3D_valD0wrtPVofTracksAcc, m_IP3D_valD0wrtPVofTracks);
+
+    /// @brief IP3D : d0 significance with respect to primary vertex
+    static SG::AuxElement::ConstAccessor< std::vector<float>   > IP3D_sigD0wrtPVofTracksAcc("IP3D_sigD0wrtPVofTracks");
+    safeVecFill<float, float, xAOD::BTagging>(myBTag, IP3D_sigD0wrtPVofTracksAcc, m_IP3D_sigD0wrtPVofTracks);
 
-    if(m_infoSwitch.m_flavorTagHLT ) {
-      if(m_debug) std::cout << "Filling m_flavorTagHLT " << std::endl;
-      const xAOD::Vertex *online_pvx       = jet->auxdata<const xAOD::Vertex*>("HLTBJetTracks_vtx");
-      const xAOD::Vertex *online_pvx_bkg   = jet->auxdata<const xAOD::Vertex*>("HLTBJetTracks_vtx_bkg");
-      const xAOD::Vertex *offline_pvx      = jet->auxdata<const xAOD::Vertex*>("offline_vtx");
+    /// @brief IP3D : z0 value with respect to primary vertex
+    static SG::AuxElement::ConstAccessor< std::vector<float>   > IP3D_valZ0wrtPVofTracksAcc("IP3D_valZ0wrtPVofTracks");
+    safeVecFill<float, float, xAOD::BTagging>(myBTag, IP3D_valZ0wrtPVofTracksAcc, m_IP3D_valZ0wrtPVofTracks);
 
-      if(online_pvx)  m_vtxOnlineValid->push_back(1.0);
-      else            m_vtxOnlineValid->push_back(0.0);
+    /// @brief IP3D : z0 significance with respect to primary vertex
+    static SG::AuxElement::ConstAccessor< std::vector<float>   > IP3D_sigZ0wrtPVofTracksAcc("IP3D_sigZ0wrtPVofTracks");
+    safeVecFill<float, float, xAOD::BTagging>(myBTag, IP3D_sigZ0wrtPVofTracksAcc, m_IP3D_sigZ0wrtPVofTracks);
 
-      char hadDummyPV = jet->auxdata< char >("hadDummyPV");
-      if( hadDummyPV == '0')  m_vtxHadDummy->push_back(0.0);
-      if( hadDummyPV == '1')  m_vtxHadDummy->push_back(1.0);
-      if( hadDummyPV == '2')  m_vtxHadDummy->push_back(2.0);
+    /// @brief IP3D : track contribution to B likelihood
+    static SG::AuxElement::ConstAccessor< std::vector<float>   > IP3D_weightBofTracksAcc   ("IP3D_weightBofTracks");
+    safeVecFill<float, float, xAOD::BTagging>(myBTag, IP3D_weightBofTracksAcc, m_IP3D_weightBofTracks);
+
+    /// @brief IP3D : track contribution to C likelihood
+    static SG::AuxElement::ConstAccessor< std::vector<float>   > IP3D_weightCofTracksAcc   ("IP3D_weightCofTracks");
+    safeVecFill<float, float, xAOD::BTagging>(myBTag, IP3D_weightCofTracksAcc, m_IP3D_weightCofTracks);
+
+    /// @brief IP3D : track contribution to U likelihood
+    static SG::AuxElement::ConstAccessor< std::vector<float>   > IP3D_weightUofTracksAcc   ("IP3D_weightUofTracks");
+    safeVecFill<float, float, xAOD::BTagging>(myBTag, IP3D_weightUofTracksAcc, m_IP3D_weightUofTracks);
+
+    double ip3_pu = -30;  myBTag->variable<double>("IP3D", "pu", ip3_pu);
+    double ip3_pb = -30;  myBTag->variable<double>("IP3D", "pb", ip3_pb);
+    double ip3_pc = -30;  myBTag->variable<double>("IP3D", "pc", ip3_pc);
+
+    m_IP3D_pu         ->push_back(ip3_pu  );
+    m_IP3D_pb         ->push_back(ip3_pb  );
+    m_IP3D_pc         ->push_back(ip3_pc  );
+
+    m_IP3D            ->push_back( myBTag->calcLLR(ip3_pb,ip3_pu)  );
+    m_IP3D_c          ->push_back( myBTag->calcLLR(ip3_pb,ip3_pc)  );
+    m_IP3D_cu         ->push_back( myBTag->calcLLR(ip3_pc,ip3_pu)  );
+
+  }
 
-      static SG::AuxElement::ConstAccessor< float > acc_bs_online_vs ("bs_online_vz");
-      if(acc_bs_online_vs.isAvailable( *jet) ){
+
+
+  if(m_infoSwitch.m_flavorTagHLT ) {
+    if(m_debug) std::cout << "Filling m_flavorTagHLT " << std::endl;
+    const xAOD::Vertex *online_pvx       = jet->auxdata<const xAOD::Vertex*>("HLTBJetTracks_vtx");
+    const xAOD::Vertex *online_pvx_bkg   = jet->auxdata<const xAOD::Vertex*>("HLTBJetTracks_vtx_bkg");
+    const xAOD::Vertex *offline_pvx      = jet->auxdata<const xAOD::Vertex*>("offline_vtx");
+
+    if(online_pvx)  m_vtxOnlineValid->push_back(1.0);
+    else            m_vtxOnlineValid->push_back(0.0);
+
+    char hadDummyPV = jet->auxdata< char >("hadDummyPV");
+    if( hadDummyPV == '0')  m_vtxHadDummy->push_back(0.0);
+    if( hadDummyPV == '1')  m_vtxHadDummy->push_back(1.0);
+    if( hadDummyPV == '2')  m_vtxHadDummy->push_back(2.0);
+
+    static SG::AuxElement::ConstAccessor< float > acc_bs_online_vs ("bs_online_vz");
+    if(acc_bs_online_vs.isAvailable( *jet) ){
 	if(m_debug) std::cout << "Have bs_online_vz " << std::endl;
 	float bs_online_vz = jet->auxdata< float >("bs_online_vz");
 	//std::cout << "**bs_online_vz " << bs_online_vz << std::endl;
@@ -3282,240 +3269,229 @@ void JetContainer::FillJet( const xAOD::IParticle* particle, const xAOD::Vertex*
 	float bs_online_vy = jet->auxdata< float >("bs_online_vy");
 	//std::cout << "**bs_online_vy " << bs_online_vy << std::endl;
 	m_bs_online_vy->push_back( bs_online_vy );
-      }else{
+    }else{
 	m_bs_online_vz->push_back( -999 );
 	m_bs_online_vx->push_back( -999 );
 	m_bs_online_vy->push_back( -999 );
-      }
+    }
 
-      if(m_debug) std::cout << "Filling m_vtx_offline " << std::endl;
-      if(offline_pvx){
+    if(m_debug) std::cout << "Filling m_vtx_offline " << std::endl;
+    if(offline_pvx){
 	m_vtx_offline_x0->push_back( offline_pvx->x() );
 	m_vtx_offline_y0->push_back( offline_pvx->y() );
 	m_vtx_offline_z0->push_back( offline_pvx->z() );
-      }else{
+    }else{
 	m_vtx_offline_x0->push_back( -999 );
 	m_vtx_offline_y0->push_back( -999 );
 	m_vtx_offline_z0->push_back( -999 );
-      }
+    }
 
-      if(m_debug) std::cout << "Done Filling m_vtx_offline " << std::endl;
+    if(m_debug) std::cout << "Done Filling m_vtx_offline " << std::endl;
 
-      if(m_debug) std::cout << "Filling m_vtx_online... " << std::endl;
-      if(online_pvx){
+    if(m_debug) std::cout << "Filling m_vtx_online... " << std::endl;
+    if(online_pvx){
 	if(m_debug) std::cout << " ... online_pvx valid " << std::endl;
-        m_vtx_online_x0->push_back( online_pvx->x() );
-        m_vtx_online_y0->push_back( online_pvx->y() );
-        m_vtx_online_z0->push_back( online_pvx->z() );
-      }else{
-        m_vtx_online_x0->push_back( -999 );
-        m_vtx_online_y0->push_back( -999 );
-        m_vtx_online_z0->push_back( -999 );
-      }
+      m_vtx_online_x0->push_back( online_pvx->x() );
+      m_vtx_online_y0->push_back( online_pvx->y() );
+      m_vtx_online_z0->push_back( online_pvx->z() );
+    }else{
+      m_vtx_online_x0->push_back( -999 );
+      m_vtx_online_y0->push_back( -999 );
+      m_vtx_online_z0->push_back( -999 );
+    }
 
-      if(m_debug) std::cout << "Filling m_vtx_online... " << std::endl;
-      if(online_pvx_bkg){
+    if(m_debug) std::cout << "Filling m_vtx_online... " << std::endl;
+    if(online_pvx_bkg){
 	if(m_debug) std::cout << " ...online_pvx_bkg valid " << std::endl;
-        m_vtx_online_bkg_x0->push_back( online_pvx_bkg->x() );
-        m_vtx_online_bkg_y0->push_back( online_pvx_bkg->y() );
-        m_vtx_online_bkg_z0->push_back( online_pvx_bkg->z() );
-      }else{
-        m_vtx_online_bkg_x0->push_back( -999 );
-        m_vtx_online_bkg_y0->push_back( -999 );
-        m_vtx_online_bkg_z0->push_back( -999 );
-      }
-
-    }// m_flavorTagHLT
-    if(m_debug) std::cout << "Done m_flavorTagHLT " << std::endl;
-  }
-
-
-  if( !m_infoSwitch.m_jetBTag.empty() || !m_infoSwitch.m_jetBTagCts.empty() ) {
-    for(auto btag : m_btags)
-      btag->Fill( jet );
-  } // jetBTag
-
-  if ( m_infoSwitch.m_area ) {
-
-    static SG::AuxElement::ConstAccessor<float> ghostArea("JetGhostArea");
-    safeFill<float, float, xAOD::Jet>(jet, ghostArea, m_GhostArea, -999);
+      m_vtx_online_bkg_x0->push_back( online_pvx_bkg->x() );
+      m_vtx_online_bkg_y0->push_back( online_pvx_bkg->y() );
+      m_vtx_online_bkg_z0->push_back( online_pvx_bkg->z() );
+    }else{
+      m_vtx_online_bkg_x0->push_back( -999 );
+      m_vtx_online_bkg_y0->push_back( -999 );
+      m_vtx_online_bkg_z0->push_back( -999 );
+    }
 
-    static SG::AuxElement::ConstAccessor<float> activeArea("ActiveArea");
-    safeFill<float, float, xAOD::Jet>(jet, activeArea, m_ActiveArea, -999);
+  }// m_flavorTagHLT
+  if(m_debug) std::cout << "Done m_flavorTagHLT " << std::endl;
+}
 
-    static SG::AuxElement::ConstAccessor<float> voronoiArea("VoronoiArea");
-    safeFill<float, float, xAOD::Jet>(jet, voronoiArea, m_VoronoiArea, -999);
+void JetContainer::fillBTags( const xAOD::Jet* jet ){
+  for(auto btag : m_btags)
+    btag->Fill( jet );
+}
 
-    static SG::AuxElement::ConstAccessor<float> activeArea_pt("ActiveArea4vec_pt");
-    safeFill<float, float, xAOD::Jet>(jet, activeArea_pt, m_ActiveArea4vec_pt, -999);
+void JetContainer::fillArea( const xAOD::Jet* jet ){
+  static SG::AuxElement::ConstAccessor<float> ghostArea("JetGhostArea");
+  safeFill<float, float, xAOD::Jet>(jet, ghostArea, m_GhostArea, -999);
 
-    static SG::AuxElement::ConstAccessor<float> activeArea_eta("ActiveArea4vec_eta");
-    safeFill<float, float, xAOD::Jet>(jet, activeArea_eta, m_ActiveArea4vec_eta, -999);
+  static SG::AuxElement::ConstAccessor<float> activeArea("ActiveArea");
+  safeFill<float, float, xAOD::Jet>(jet, activeArea, m_ActiveArea, -999);
 
-    static SG::AuxElement::ConstAccessor<float> activeArea_phi("ActiveArea4vec_phi");
-    safeFill<float, float, xAOD::Jet>(jet, activeArea_phi, m_ActiveArea4vec_phi, -999);
+  static SG::AuxElement::ConstAccessor<float> voronoiArea("VoronoiArea");
+  safeFill<float, float, xAOD::Jet>(jet, voronoiArea, m_VoronoiArea, -999);
 
-    static SG::AuxElement::ConstAccessor<float> activeArea_m("ActiveArea4vec_m");
-    safeFill<float, float, xAOD::Jet>(jet, activeArea_m, m_ActiveArea4vec_m, -999);
-  }
+  static SG::AuxElement::ConstAccessor<float> activeArea_pt("ActiveArea4vec_pt");
+  safeFill<float, float, xAOD::Jet>(jet, activeArea_pt, m_ActiveArea4vec_pt, -999);
 
+  static SG::AuxElement::ConstAccessor<float> activeArea_eta("ActiveArea4vec_eta");
+  safeFill<float, float, xAOD::Jet>(jet, activeArea_eta, m_ActiveArea4vec_eta, -999);
 
-  if ( m_infoSwitch.m_truth && m_mc ) {
+  static SG::AuxElement::ConstAccessor<float> activeArea_phi("ActiveArea4vec_phi");
+  safeFill<float, float, xAOD::Jet>(jet, activeArea_phi, m_ActiveArea4vec_phi, -999);
 
-    static SG::AuxElement::ConstAccessor<int> ConeTruthLabelID ("ConeTruthLabelID");
-    safeFill<int, int, xAOD::Jet>(jet, ConeTruthLabelID, m_ConeTruthLabelID, -999);
+  static SG::AuxElement::ConstAccessor<float> activeArea_m("ActiveArea4vec_m");
+  safeFill<float, float, xAOD::Jet>(jet, activeArea_m, m_ActiveArea4vec_m, -999);
+}
 
-    static SG::AuxElement::ConstAccessor<int> TruthCount ("TruthCount");
-    safeFill<int, int, xAOD::Jet>(jet, TruthCount, m_TruthCount, -999);
+void JetContainer::fillTruth( const xAOD::Jet* jet ){
+  static SG::AuxElement::ConstAccessor<int> ConeTruthLabelID ("ConeTruthLabelID");
+  safeFill<int, int, xAOD::Jet>(jet, ConeTruthLabelID, m_ConeTruthLabelID, -999);
 
-    //    seems to be empty
-    //      static SG::AuxElement::ConstAccessor<float> TruthPt ("TruthPt");
-    //      if ( TruthPt.isAvailable( *jet) ) {
-    //        m_truthPt->push_back( TruthPt( *jet)/1000 );
-    //      } else { m_truthPt->push_back( -999 ); }
+  static SG::AuxElement::ConstAccessor<int> TruthCount ("TruthCount");
+  safeFill<int, int, xAOD::Jet>(jet, TruthCount, m_TruthCount, -999);
 
-    static SG::AuxElement::ConstAccessor<float> TruthLabelDeltaR_B ("TruthLabelDeltaR_B");
-    safeFill<float, float, xAOD::Jet>(jet, TruthLabelDeltaR_B, m_TruthLabelDeltaR_B, -999);
+  //    seems to be empty
+  //      static SG::AuxElement::ConstAccessor<float> TruthPt ("TruthPt");
+  //      if ( TruthPt.isAvailable( *jet) ) {
+  //        m_truthPt->push_back( TruthPt( *jet)/1000 );
+  //      } else { m_truthPt->push_back( -999 ); }
 
-    static SG::AuxElement::ConstAccessor<float> TruthLabelDeltaR_C ("TruthLabelDeltaR_C");
-    safeFill<float, float, xAOD::Jet>(jet, TruthLabelDeltaR_C, m_TruthLabelDeltaR_C, -999);
+  static SG::AuxElement::ConstAccessor<float> TruthLabelDeltaR_B ("TruthLabelDeltaR_B");
+  safeFill<float, float, xAOD::Jet>(jet, TruthLabelDeltaR_B, m_TruthLabelDeltaR_B, -999);
 
-    static SG::AuxElement::ConstAccessor<float> TruthLabelDeltaR_T ("TruthLabelDeltaR_T");
-    safeFill<float, float, xAOD::Jet>(jet, TruthLabelDeltaR_T, m_TruthLabelDeltaR_T, -999);
+  static SG::AuxElement::ConstAccessor<float> TruthLabelDeltaR_C ("TruthLabelDeltaR_C");
+  safeFill<float, float, xAOD::Jet>(jet, TruthLabelDeltaR_C, m_TruthLabelDeltaR_C, -999);
 
-    static SG::AuxElement::ConstAccessor<int> partonLabel("PartonTruthLabelID");
-    safeFill<int, int, xAOD::Jet>(jet, partonLabel, m_PartonTruthLabelID, -999);
+  static SG::AuxElement::ConstAccessor<float> TruthLabelDeltaR_T ("TruthLabelDeltaR_T");
+  safeFill<float, float, xAOD::Jet>(jet, TruthLabelDeltaR_T, m_TruthLabelDeltaR_T, -999);
 
-    static SG::AuxElement::ConstAccessor<float> ghostTruthAssFrac("GhostTruthAssociationFraction");
-    safeFill<float, float, xAOD::Jet>(jet, ghostTruthAssFrac, m_GhostTruthAssociationFraction, -999);
+  static SG::AuxElement::ConstAccessor<int> partonLabel("PartonTruthLabelID");
+  safeFill<int, int, xAOD::Jet>(jet, partonLabel, m_PartonTruthLabelID, -999);
 
-    const xAOD::Jet* truthJet = HelperFunctions::getLink<xAOD::Jet>( jet, "GhostTruthAssociationLink" );
-    if(truthJet) {
-      m_truth_pt->push_back ( truthJet->pt() / m_units );
-      m_truth_eta->push_back( truthJet->eta() );
-      m_truth_phi->push_back( truthJet->phi() );
-      m_truth_E->push_back  ( truthJet->e() / m_units );
-    } else {
-      m_truth_pt->push_back ( -999 );
-      m_truth_eta->push_back( -999 );
-      m_truth_phi->push_back( -999 );
-      m_truth_E->push_back  ( -999 );
-    }
+  static SG::AuxElement::ConstAccessor<float> ghostTruthAssFrac("GhostTruthAssociationFraction");
+  safeFill<float, float, xAOD::Jet>(jet, ghostTruthAssFrac, m_GhostTruthAssociationFraction, -999);
 
+  static const SG::AuxElement::ConstAccessor< ElementLink<xAOD::JetContainer> > ghostTruthLink("GhostTruthAssociationLink");
+  const xAOD::Jet* truthJet = HelperFunctions::getLink<xAOD::Jet>( jet, ghostTruthLink );
+  if(truthJet) {
+    m_truth_pt->push_back ( truthJet->pt() / m_units );
+    m_truth_eta->push_back( truthJet->eta() );
+    m_truth_phi->push_back( truthJet->phi() );
+    m_truth_E->push_back  ( truthJet->e() / m_units );
+  } else {
+    m_truth_pt->push_back ( -999 );
+    m_truth_eta->push_back( -999 );
+    m_truth_phi->push_back( -999 );
+    m_truth_E->push_back  ( -999 );
   }
+}
 
-  if ( m_infoSwitch.m_truthDetails ) {
-
-    //
-    // B-Hadron Details
-    //
-    static SG::AuxElement::ConstAccessor<int> GhostBHadronsFinalCount ("GhostBHadronsFinalCount");
-    safeFill<int, int, xAOD::Jet>(jet, GhostBHadronsFinalCount, m_GhostBHadronsFinalCount, -999);
+void JetContainer::fillTruthDetails( const xAOD::Jet* jet ){
+  //
+  // B-Hadron Details
+  //
+  static SG::AuxElement::ConstAccessor<int> GhostBHadronsFinalCount ("GhostBHadronsFinalCount");
+  safeFill<int, int, xAOD::Jet>(jet, GhostBHadronsFinalCount, m_GhostBHadronsFinalCount, -999);
 
-    static SG::AuxElement::ConstAccessor<int> GhostBHadronsInitialCount ("GhostBHadronsInitialCount");
-    safeFill<int, int, xAOD::Jet>(jet, GhostBHadronsInitialCount, m_GhostBHadronsInitialCount, -999);
+  static SG::AuxElement::ConstAccessor<int> GhostBHadronsInitialCount ("GhostBHadronsInitialCount");
+  safeFill<int, int, xAOD::Jet>(jet, GhostBHadronsInitialCount, m_GhostBHadronsInitialCount, -999);
 
-    static SG::AuxElement::ConstAccessor<int> GhostBQuarksFinalCount ("GhostBQuarksFinalCount");
-    safeFill<int, int, xAOD::Jet>(jet, GhostBQuarksFinalCount, m_GhostBQuarksFinalCount, -999);
+  static SG::AuxElement::ConstAccessor<int> GhostBQuarksFinalCount ("GhostBQuarksFinalCount");
+  safeFill<int, int, xAOD::Jet>(jet, GhostBQuarksFinalCount, m_GhostBQuarksFinalCount, -999);
 
-    static SG::AuxElement::ConstAccessor<float> GhostBHadronsFinalPt ("GhostBHadronsFinalPt");
-    safeFill<float, float, xAOD::Jet>(jet, GhostBHadronsFinalPt, m_GhostBHadronsFinalPt, -999);
+  static SG::AuxElement::ConstAccessor<float> GhostBHadronsFinalPt ("GhostBHadronsFinalPt");
+  safeFill<float, float, xAOD::Jet>(jet, GhostBHadronsFinalPt, m_GhostBHadronsFinalPt, -999);
 
-    static SG::AuxElement::ConstAccessor<float> GhostBHadronsInitialPt ("GhostBHadronsInitialPt");
-    safeFill<float, float, xAOD::Jet>(jet, GhostBHadronsInitialPt, m_GhostBHadronsInitialPt, -999);
+  static SG::AuxElement::ConstAccessor<float> GhostBHadronsInitialPt ("GhostBHadronsInitialPt");
+  safeFill<float, float, xAOD::Jet>(jet, GhostBHadronsInitialPt, m_GhostBHadronsInitialPt, -999);
 
-    static SG::AuxElement::ConstAccessor<float> GhostBQuarksFinalPt ("GhostBQuarksFinalPt");
-    safeFill<float, float, xAOD::Jet>(jet, GhostBQuarksFinalPt, m_GhostBQuarksFinalPt, -999);
+  static SG::AuxElement::ConstAccessor<float> GhostBQuarksFinalPt ("GhostBQuarksFinalPt");
+  safeFill<float, float, xAOD::Jet>(jet, GhostBQuarksFinalPt, m_GhostBQuarksFinalPt, -999);
 
-    //
-    // C-Hadron Details
-    //
-    static SG::AuxElement::ConstAccessor<int> GhostCHadronsFinalCount ("GhostCHadronsFinalCount");
-    safeFill<int, int, xAOD::Jet>(jet, GhostCHadronsFinalCount, m_GhostCHadronsFinalCount, -999);
+  //
+  // C-Hadron Details
+  //
+  static SG::AuxElement::ConstAccessor<int> GhostCHadronsFinalCount ("GhostCHadronsFinalCount");
+  safeFill<int, int, xAOD::Jet>(jet, GhostCHadronsFinalCount, m_GhostCHadronsFinalCount, -999);
 
-    static SG::AuxElement::ConstAccessor<int> GhostCHadronsInitialCount ("GhostCHadronsInitialCount");
-    safeFill<int, int, xAOD::Jet>(jet, GhostCHadronsInitialCount, m_GhostCHadronsInitialCount, -999);
+  static SG::AuxElement::ConstAccessor<int> GhostCHadronsInitialCount ("GhostCHadronsInitialCount");
+  safeFill<int, int, xAOD::Jet>(jet, GhostCHadronsInitialCount, m_GhostCHadronsInitialCount, -999);
 
-    static SG::AuxElement::ConstAccessor<int> GhostCQuarksFinalCount ("GhostCQuarksFinalCount");
-    safeFill<int, int, xAOD::Jet>(jet, GhostCQuarksFinalCount, m_GhostCQuarksFinalCount, -999);
+  static SG::AuxElement::ConstAccessor<int> GhostCQuarksFinalCount ("GhostCQuarksFinalCount");
+  safeFill<int, int, xAOD::Jet>(jet, GhostCQuarksFinalCount, m_GhostCQuarksFinalCount, -999);
 
-    static SG::AuxElement::ConstAccessor<float> GhostCHadronsFinalPt ("GhostCHadronsFinalPt");
-    safeFill<float, float, xAOD::Jet>(jet, GhostCHadronsFinalPt, m_GhostCHadronsFinalPt, -999);
+  static SG::AuxElement::ConstAccessor<float> GhostCHadronsFinalPt ("GhostCHadronsFinalPt");
+  safeFill<float, float, xAOD::Jet>(jet, GhostCHadronsFinalPt, m_GhostCHadronsFinalPt, -999);
 
-    static SG::AuxElement::ConstAccessor<float> GhostCHadronsInitialPt ("GhostCHadronsInitialPt");
-    safeFill<float, float, xAOD::Jet>(jet, GhostCHadronsInitialPt, m_GhostCHadronsInitialPt, -999);
+  static SG::AuxElement::ConstAccessor<float> GhostCHadronsInitialPt ("GhostCHadronsInitialPt");
+  safeFill<float, float, xAOD::Jet>(jet, GhostCHadronsInitialPt, m_GhostCHadronsInitialPt, -999);
 
-    static SG::AuxElement::ConstAccessor<float> GhostCQuarksFinalPt ("GhostCQuarksFinalPt");
-    safeFill<float, float, xAOD::Jet>(jet, GhostCQuarksFinalPt, m_GhostCQuarksFinalPt, -999);
+  static SG::AuxElement::ConstAccessor<float> GhostCQuarksFinalPt ("GhostCQuarksFinalPt");
+  safeFill<float, float, xAOD::Jet>(jet, GhostCQuarksFinalPt, m_GhostCQuarksFinalPt, -999);
 
-    //
-    // Tau Details
-    //
-    static SG::AuxElement::ConstAccessor<int> GhostTausFinalCount ("GhostTausFinalCount");
-    safeFill<int, int, xAOD::Jet>(jet, GhostTausFinalCount, m_GhostTausFinalCount, -999);
+  //
+  // Tau Details
+  //
+  static SG::AuxElement::ConstAccessor<int> GhostTausFinalCount ("GhostTausFinalCount");
+  safeFill<int, int, xAOD::Jet>(jet, GhostTausFinalCount, m_GhostTausFinalCount, -999);
 
-    // THE ONLY UN-OFFICIAL PIECE OF CODE HERE USE WITH CAUTION
-    static SG::AuxElement::ConstAccessor<float> GhostTausFinalPt ("GhostTausFinalPt");
-    safeFill<float, float, xAOD::Jet>(jet, GhostTausFinalPt, m_GhostTausFinalPt, -999);
+  // THE ONLY UN-OFFICIAL PIECE OF CODE HERE USE WITH CAUTION
+  static SG::AuxElement::ConstAccessor<float> GhostTausFinalPt ("GhostTausFinalPt");
+  safeFill<float, float, xAOD::Jet>(jet, GhostTausFinalPt, m_GhostTausFinalPt, -999);
 
-    // light quark(1,2,3) , gluon (21 or 9), charm(4) and b(5)
-    // GhostPartons should select for these pdgIds only
-    //    static SG::AuxElement::ConstAccessor< std::vector<const xAOD::TruthParticle*> > ghostPartons("GhostPartons");
-    //    if( ghostPartons.isAvailable( *jet )) {
-    //    std::vector<const xAOD::TruthParticle*> truthPartons = ghostPartons( *jet );
+  // light quark(1,2,3) , gluon (21 or 9), charm(4) and b(5)
+  // GhostPartons should select for these pdgIds only
+  //    static SG::AuxElement::ConstAccessor< std::vector<const xAOD::TruthParticle*> > ghostPartons("GhostPartons");
+  //    if( ghostPartons.isAvailable( *jet )) {
+  //    std::vector<const xAOD::TruthParticle*> truthPartons = ghostPartons( *jet );
 
-    std::vector<const xAOD::TruthParticle*> truthPartons = jet->getAssociatedObjects<xAOD::TruthParticle>("GhostPartons");
+  std::vector<const xAOD::TruthParticle*> truthPartons = jet->getAssociatedObjects<xAOD::TruthParticle>("GhostPartons");
 
-    if( truthPartons.size() == 0){
-      m_truth_pdgId->push_back(-999);
-    } else {
-      int iParent = 0;
-      for(unsigned int i=1; i < truthPartons.size(); ++i){
-        if( (truthPartons.at(i)->pt() > 0.001) && (truthPartons.at(i)->e() > truthPartons.at(iParent)->e()) )
-          iParent = i;
-      }
-      m_truth_pdgId->push_back(truthPartons.at(iParent)->pdgId());
-      m_truth_partonPt->push_back(truthPartons.at(iParent)->pt() / m_units);
-      m_truth_partonDR->push_back(truthPartons.at(iParent)->p4().DeltaR( jet->p4() ));
+  if( truthPartons.size() == 0){
+    m_truth_pdgId->push_back(-999);
+  } else {
+    int iParent = 0;
+    for(unsigned int i=1; i < truthPartons.size(); ++i){
+      if( (truthPartons.at(i)->pt() > 0.001) && (truthPartons.at(i)->e() > truthPartons.at(iParent)->e()) )
+        iParent = i;
     }
-
+    m_truth_pdgId->push_back(truthPartons.at(iParent)->pdgId());
+    m_truth_partonPt->push_back(truthPartons.at(iParent)->pt() / m_units);
+    m_truth_partonDR->push_back(truthPartons.at(iParent)->p4().DeltaR( jet->p4() ));
   }
+}
 
+void JetContainer::fillCharge( const xAOD::Jet* jet ){
+  xAOD::JetFourMom_t p4UsedInJetCharge;
+  bool status = jet->getAttribute<xAOD::JetFourMom_t>( "JetPileupScaleMomentum", p4UsedInJetCharge );
+  static SG::AuxElement::ConstAccessor<float>              uncalibratedJetCharge ("Charge");
 
-  if ( m_infoSwitch.m_charge ) {
-    xAOD::JetFourMom_t p4UsedInJetCharge;
-    bool status = jet->getAttribute<xAOD::JetFourMom_t>( "JetPileupScaleMomentum", p4UsedInJetCharge );
-    static SG::AuxElement::ConstAccessor<float>              uncalibratedJetCharge ("Charge");
-
-    if(status){
-      float ptUsedInJetCharge   = p4UsedInJetCharge.Pt();
-      float calibratedJetCharge = jet->pt() ? (ptUsedInJetCharge * uncalibratedJetCharge(*jet) / jet->pt()) : -99;
-      m_charge->push_back(calibratedJetCharge);
-    }else{
-      m_charge->push_back(-99);
-    }
-
+  if(status){
+    float ptUsedInJetCharge   = p4UsedInJetCharge.Pt();
+    float calibratedJetCharge = jet->pt() ? (ptUsedInJetCharge * uncalibratedJetCharge(*jet) / jet->pt()) : -99;
+    m_charge->push_back(calibratedJetCharge);
+  }else{
+    m_charge->push_back(-99);
   }
+}
 
-  if ( m_infoSwitch.m_passSel ) {
-    char passSel;
-    bool status = jet->getAttribute<char>( "passSel", passSel );
-    if(status){
-      m_passSel->push_back(passSel);
-    }else{
-      m_passSel->push_back(-99);
-    }
+void JetContainer::fillPassSel( const xAOD::Jet* jet ){
+  char passSel;
+  bool status = jet->getAttribute<char>( "passSel", passSel );
+  if(status){
+    m_passSel->push_back(passSel);
+  }else{
+    m_passSel->push_back(-99);
   }
+}
 
-  if ( m_infoSwitch.m_passOR ) {
-    char passOR;
-    bool status = jet->getAttribute<char>( "passOR", passOR );
-    if(status){
-      m_passOR->push_back(passOR);
-    }else{
-      m_passOR->push_back(-99);
-    }
+void JetContainer::fillPassOR( const xAOD::Jet* jet ){
+  char passOR;
+  bool status = jet->getAttribute<char>( "passOR", passOR );
+  if(status){
+    m_passOR->push_back(passOR);
+  }else{
+    m_passOR->push_back(-99);
   }
-
-  return;
 }
@@ -1,6 +1,8 @@
 #include <xAODAnaHelpers/JetHists.h>
 #include <sstream>
+#include <algorithm>
 #include <math.h>       /* hypot */
+#include "TVector2.h"
 
 ANA_MSG_SOURCE(msgJetHists, "JetHists")
 
@@ -486,12 +488,12 @@ StatusCode JetHists::initialize() {
       Double_t runBins[]= { 297730, 298595, 298609, 298633, 298687, 298690, 298771, 298773, 298862, 298967, 299055, 299144, 299147, 299184, 299243, 299584, 300279, 300345, 300415, 300418, 300487, 300540, 300571, 300600, 300655, 300687, 300784, 300800, 300863, 300908, 301912, 301918, 301932, 301973, 302053, 302137, 302265, 302269, 302300, 302347, 302380, 302391, 302393, 302737, 302831, 302872, 302919, 302925, 302956, 303007, 303079, 303201, 303208, 303264, 303266, 303291, 303304, 303338, 303421, 303499, 303560, 303638, 303832, 303846, 303892, 303943, 304006, 304008, 304128, 304178, 304198, 304211, 304243, 304308, 304337, 304409, 304431, 304494, 305380, 305543, 305571, 305618, 305671, 305674, 305723, 305727, 305735, 305777, 305811, 305920, 306269, 306278, 306310, 306384, 306419, 306442, 306448, 306451, 307126, 307195, 307259, 307306, 307354, 307358, 307394, 307454, 307514, 307539, 307569, 307601, 307619, 307656, 307710, 307716, 307732, 307861, 307935, 308047, 308084, 309375, 309390, 309440, 309516, 309640, 309674, 309759, 310015, 310247, 310249, 310341, 310370, 310405, 310468, 310473, 310634, 310691, 310738, 310809, 310863, 310872, 310969, 311071, 311170, 311244, 311287, 311321, 311365, 311402, 311473, 311481, 311500 };
       int nRunBins=150;
 
-      m_lumiB_runN              = book(m_name, "lumiB_runN",              "Lumi Block", 2000, 0, 2000, "Run Number", nRunBins, runBins);
-      m_lumiB_runN_bs_online_vz = book(m_name, "lumiB_runN_bs_online_vz", "Lumi Block", 2000, 0, 2000, "Run Number", nRunBins, runBins);
-      m_lumiB_runN_bs_den       = book(m_name, "lumiB_runN_bs_den",       "Lumi Block", 2000, 0, 2000, "Run Number", nRunBins, runBins);
-      m_lumiB_runN_vtxClass     = book(m_name, "lumiB_runN_vtxClass",     "Lumi Block", 2000, 0, 2000, "Run Number", nRunBins, runBins);
-      //m_lumiB_runN_vtxDiffz0    = book(m_name, "lumiB_runN_vtxDiffz0",    "Lumi Block", 2000, 0, 2000, "Run Number", nRunBins, runBins);
-      m_lumiB_runN_lumiB        = book(m_name, "lumiB_runN_lumiB",        "Lumi Block", 2000, 0, 2000, "Run Number", nRunBins, runBins);
+      m_lumiB_runN              = bookSparse(m_name, "lumiB_runN",              "Lumi Block", 2000, 0, 2000, "Run Number", nRunBins, runBins);
+      m_lumiB_runN_bs_online_vz = bookSparse(m_name, "lumiB_runN_bs_online_vz", "Lumi Block", 2000, 0, 2000, "Run Number", nRunBins, runBins);
+      m_lumiB_runN_bs_den       = bookSparse(m_name, "lumiB_runN_bs_den",       "Lumi Block", 2000, 0, 2000, "Run Number", nRunBins, runBins);
+      m_lumiB_runN_vtxClass     = bookSparse(m_name, "lumiB_runN_vtxClass",     "Lumi Block", 2000, 0, 2000, "Run Number", nRunBins, runBins);
+      //m_lumiB_runN_vtxDiffz0    = bookSparse(m_name, "lumiB_runN_vtxDiffz0",    "Lumi Block", 2000, 0, 2000, "Run Number", nRunBins, runBins);
+      m_lumiB_runN_lumiB        = bookSparse(m_name, "lumiB_runN_lumiB",        "Lumi Block", 2000, 0, 2000, "Run Number", nRunBins, runBins);
     }
   }
 
@@ -541,7 +543,22 @@ StatusCode JetHists::initialize() {
 		      m_titlePrefix+"#phi", 120, -TMath::Pi(), TMath::Pi() );
     }
 
-
+  // compile the enabled details into the list of fills run for every jet
+  m_fillPlan.clear();
+  if( m_infoSwitch->m_clean ) m_fillPlan.push_back( &JetHists::fillClean );
+  if( m_infoSwitch->m_vsActualMu ) m_fillPlan.push_back( &JetHists::fillVsActualMu );
+  if( m_infoSwitch->m_byAverageMu ) m_fillPlan.push_back( &JetHists::fillByAverageMu );
+  if( m_infoSwitch->m_energy ) m_fillPlan.push_back( &JetHists::fillEnergy );
+  if( m_infoSwitch->m_layer ) m_fillPlan.push_back( &JetHists::fillLayer );
+  if( m_infoSwitch->m_truth ) m_fillPlan.push_back( &JetHists::fillTruth );
+  if( m_infoSwitch->m_truthDetails ) m_fillPlan.push_back( &JetHists::fillTruthDetails );
+  if( m_infoSwitch->m_flavorTag || m_infoSwitch->m_flavorTagHLT ) m_fillPlan.push_back( &JetHists::fillFlavorTag );
+  if( m_infoSwitch->m_resolution ) m_fillPlan.push_back( &JetHists::fillResolution );
+  if( m_infoSwitch->m_substructure ) m_fillPlan.push_back( &JetHists::fillSubstructure );
+  if( m_infoSwitch->m_tracksInJet ) m_fillPlan.push_back( &JetHists::fillTracksInJet );
+  if( m_infoSwitch->m_byEta ) m_fillPlan.push_back( &JetHists::fillByEta );
+  if( m_infoSwitch->m_onlineBS ) m_fillPlan.push_back( &JetHists::fillOnlineBS );
+  if( m_infoSwitch->m_hltVtxComp || m_infoSwitch->m_onlineBS ) m_fillPlan.push_back( &JetHists::fillHLTVertex );
 
   return StatusCode::SUCCESS;
 }
@@ -554,6 +571,21 @@ void JetHists::record(EL::IWorker* wk) {
   }
 }
 
+void JetHists::snapshot(std::vector<TObject*>& objects) {
+  HistogramManager::snapshot(objects);
+  if(m_tracksInJet) m_tracksInJet -> snapshot( objects );
+}
+
+bool JetHists::merge(const TObject* obj) {
+  if(HistogramManager::merge(obj)) return true;
+  return m_tracksInJet && m_tracksInJet -> merge( obj );
+}
+
+void JetHists::reset() {
+  HistogramManager::reset();
+  if(m_tracksInJet) m_tracksInJet -> reset();
+}
+
 StatusCode JetHists::execute( const xAOD::Jet* jet, float eventWeight, const xAOD::EventInfo* eventInfo  ) {
   return execute(static_cast<const xAOD::IParticle*>(jet), eventWeight, eventInfo);
 }
@@ -572,50 +604,60 @@ StatusCode JetHists::execute( const xAOD::IParticle* particle, float eventWeight
       return StatusCode::FAILURE;
     }
 
-  // clean
-  if( m_infoSwitch->m_clean ) {
-    if(m_debug) std::cout << "JetHists: m_clean " <<std::endl;
+  for( const auto& fill : m_fillPlan ) {
+    ANA_CHECK( (this->*fill)( jet, eventWeight, eventInfo ) );
+  }
 
-    static SG::AuxElement::ConstAccessor<float> jetTime ("Timing");
-    if( jetTime.isAvailable( *jet ) ) {
-      m_jetTime ->  Fill( jetTime( *jet ), eventWeight );
-    }
+  if(m_debug) std::cout << "JetHists: leave " <<std::endl;
+  return StatusCode::SUCCESS;
+}
 
-    static SG::AuxElement::ConstAccessor<float> LArQuality ("LArQuality");
-    if( LArQuality.isAvailable( *jet ) ) {
-      m_LArQuality ->  Fill( LArQuality( *jet ), eventWeight );
-    }
+// the fills of JetHists::m_fillPlan, see JetHists::initialize
 
-    static SG::AuxElement::ConstAccessor<float> hecq ("HECQuality");
-    if( hecq.isAvailable( *jet ) ) {
-      m_hecq ->  Fill( hecq( *jet ), eventWeight );
-    }
+// clean
+StatusCode JetHists::fillClean( const xAOD::Jet* jet, float eventWeight, const xAOD::EventInfo* /*eventInfo*/ ) {
+  if(m_debug) std::cout << "JetHists: m_clean " <<std::endl;
 
-    static SG::AuxElement::ConstAccessor<float> negE ("NegativeE");
-    if( negE.isAvailable( *jet ) ) {
-      m_negE ->  Fill( negE( *jet ), eventWeight );
-    }
+  static SG::AuxElement::ConstAccessor<float> jetTime ("Timing");
+  if( jetTime.isAvailable( *jet ) ) {
+    m_jetTime ->  Fill( jetTime( *jet ), eventWeight );
+  }
 
-    static SG::AuxElement::ConstAccessor<float> avLArQF ("AverageLArQF");
-    if( avLArQF.isAvailable( *jet ) ) {
-      m_avLArQF ->  Fill( avLArQF( *jet ), eventWeight );
-    }
+  static SG::AuxElement::ConstAccessor<float> LArQuality ("LArQuality");
+  if( LArQuality.isAvailable( *jet ) ) {
+    m_LArQuality ->  Fill( LArQuality( *jet ), eventWeight );
+  }
 
-    static SG::AuxElement::ConstAccessor<float> bchCorrCell ("BchCorrCell");
-    if( bchCorrCell.isAvailable( *jet ) ) {
-      m_bchCorrCell ->  Fill( bchCorrCell( *jet ), eventWeight );
-    }
+  static SG::AuxElement::ConstAccessor<float> hecq ("HECQuality");
+  if( hecq.isAvailable( *jet ) ) {
+    m_hecq ->  Fill( hecq( *jet ), eventWeight );
+  }
 
-    // 0062       N90Cells?
-    static SG::AuxElement::ConstAccessor<float> N90Const ("N90Constituents");
-    if( N90Const.isAvailable( *jet ) ) {
-      m_N90Const ->  Fill( N90Const( *jet ), eventWeight );
-    }
+  static SG::AuxElement::ConstAccessor<float> negE ("NegativeE");
+  if( negE.isAvailable( *jet ) ) {
+    m_negE ->  Fill( negE( *jet ), eventWeight );
+  }
 
-    static SG::AuxElement::ConstAccessor<float> ChargedFraction ("ChargedFraction");
-    if( ChargedFraction.isAvailable( *jet ) ) {
-      m_ChargedFraction ->  Fill( ChargedFraction( *jet ), eventWeight );
-    }
+  static SG::AuxElement::ConstAccessor<float> avLArQF ("AverageLArQF");
+  if( avLArQF.isAvailable( *jet ) ) {
+    m_avLArQF ->  Fill( avLArQF( *jet ), eventWeight );
+  }
+
+  static SG::AuxElement::ConstAccessor<float> bchCorrCell ("BchCorrCell");
+  if( bchCorrCell.isAvailable( *jet ) ) {
+    m_bchCorrCell ->  Fill( bchCorrCell( *jet ), eventWeight );
+  }
+
+  // 0062       N90Cells?
+  static SG::AuxElement::ConstAccessor<float> N90Const ("N90Constituents");
+  if( N90Const.isAvailable( *jet ) ) {
+    m_N90Const ->  Fill( N90Const( *jet ), eventWeight );
+  }
+
+  static SG::AuxElement::ConstAccessor<float> ChargedFraction ("ChargedFraction");
+  if( ChargedFraction.isAvailable( *jet ) ) {
+    m_ChargedFraction ->  Fill( ChargedFraction( *jet ), eventWeight );
+  }
 
 
  // 0030       LArBadHVEnergy,
@@ -630,144 +672,147 @@ StatusCode JetHists::execute( const xAOD::IParticle* particle, float eventWeight
  // 0065       OotFracCells5,
  // 0066       OotFracCells10,
 
-  } // fillClean
+  return StatusCode::SUCCESS;
+}
 
-  // Pileup
-  if(m_infoSwitch->m_vsActualMu){
-    float actualMu = eventInfo->actualInteractionsPerCrossing();
-    m_actualMu->Fill(actualMu, eventWeight);
-  }
+// Pileup
+StatusCode JetHists::fillVsActualMu( const xAOD::Jet* /*jet*/, float eventWeight, const xAOD::EventInfo* eventInfo ) {
+  float actualMu = eventInfo->actualInteractionsPerCrossing();
+  m_actualMu->Fill(actualMu, eventWeight);
+  return StatusCode::SUCCESS;
+}
 
-  if (m_infoSwitch->m_byAverageMu)
-  {
-    float averageMu = eventInfo->averageInteractionsPerCrossing();
-    m_avgMu->Fill(averageMu, eventWeight);
-  }
+StatusCode JetHists::fillByAverageMu( const xAOD::Jet* /*jet*/, float eventWeight, const xAOD::EventInfo* eventInfo ) {
+  float averageMu = eventInfo->averageInteractionsPerCrossing();
+  m_avgMu->Fill(averageMu, eventWeight);
+  return StatusCode::SUCCESS;
+}
 
-  // energy
-  if( m_infoSwitch->m_energy ) {
-    if(m_debug) std::cout << "JetHists: m_energy " <<std::endl;
+// energy
+StatusCode JetHists::fillEnergy( const xAOD::Jet* jet, float eventWeight, const xAOD::EventInfo* /*eventInfo*/ ) {
+  if(m_debug) std::cout << "JetHists: m_energy " <<std::endl;
 
-    static SG::AuxElement::ConstAccessor<float> HECf ("HECFrac");
-    if( HECf.isAvailable( *jet ) ) {
-      m_HECf ->  Fill( HECf( *jet ), eventWeight );
-    }
+  static SG::AuxElement::ConstAccessor<float> HECf ("HECFrac");
+  if( HECf.isAvailable( *jet ) ) {
+    m_HECf ->  Fill( HECf( *jet ), eventWeight );
+  }
 
-    static SG::AuxElement::ConstAccessor<float> EMf ("EMFrac");
-    if( EMf.isAvailable( *jet ) ) {
-      m_EMf ->  Fill( EMf( *jet ), eventWeight );
-    }
+  static SG::AuxElement::ConstAccessor<float> EMf ("EMFrac");
+  if( EMf.isAvailable( *jet ) ) {
+    m_EMf ->  Fill( EMf( *jet ), eventWeight );
+  }
 
-    static SG::AuxElement::ConstAccessor<float> centroidR ("CentroidR");
-    if( centroidR.isAvailable( *jet ) ) {
-      m_centroidR ->  Fill( centroidR( *jet ), eventWeight );
-    }
+  static SG::AuxElement::ConstAccessor<float> centroidR ("CentroidR");
+  if( centroidR.isAvailable( *jet ) ) {
+    m_centroidR ->  Fill( centroidR( *jet ), eventWeight );
+  }
 
-    /*
+  /*
 
-    static SG::AuxElement::ConstAccessor<float> samplingMax ("SamplingMax");
-    if( samplingMax.isAvailable( *jet ) ) {
-      m_samplingMax ->  Fill( samplingMax( *jet ), eventWeight );
-    }
+  static SG::AuxElement::ConstAccessor<float> samplingMax ("SamplingMax");
+  if( samplingMax.isAvailable( *jet ) ) {
+    m_samplingMax ->  Fill( samplingMax( *jet ), eventWeight );
+  }
 
-    static SG::AuxElement::ConstAccessor<float> ePerSamp ("EnergyPerSampling");
-    if( ePerSamp.isAvailable( *jet ) ) {
-      m_ePerSamp ->  Fill( ePerSamp( *jet ), eventWeight );
-    }
+  static SG::AuxElement::ConstAccessor<float> ePerSamp ("EnergyPerSampling");
+  if( ePerSamp.isAvailable( *jet ) ) {
+    m_ePerSamp ->  Fill( ePerSamp( *jet ), eventWeight );
+  }
 
-    static SG::AuxElement::ConstAccessor<float> fracSampMax ("FracSamplingMax");
-    if( fracSampMax.isAvailable( *jet ) ) {
-      m_fracSampMax ->  Fill( fracSampMax( *jet ), eventWeight );
-    }
+  static SG::AuxElement::ConstAccessor<float> fracSampMax ("FracSamplingMax");
+  if( fracSampMax.isAvailable( *jet ) ) {
+    m_fracSampMax ->  Fill( fracSampMax( *jet ), eventWeight );
+  }
 
-    static SG::AuxElement::ConstAccessor<float> lowEtFrac ("LowEtConstituentsFrac");
-    if( lowEtFrac.isAvailable( *jet ) ) {
-      m_lowEtFrac ->  Fill( lowEtFrac( *jet ), eventWeight );
-    }
+  static SG::AuxElement::ConstAccessor<float> lowEtFrac ("LowEtConstituentsFrac");
+  if( lowEtFrac.isAvailable( *jet ) ) {
+    m_lowEtFrac ->  Fill( lowEtFrac( *jet ), eventWeight );
+  }
 
  // 0036       Offset,
  // 0037       OriginIndex    ,
-    */
-
-  }
-
-  if( m_infoSwitch->m_layer ){
-    if(m_debug) std::cout << "JetHists: m_layer " <<std::endl;
-
-    static SG::AuxElement::ConstAccessor< vector<float> > ePerSamp ("EnergyPerSampling");
-    if( ePerSamp.isAvailable( *jet ) ) {
-      vector<float> ePerSampVals = ePerSamp( *jet );
-      float jetE = jet->e();
-      m_PreSamplerB -> Fill( ePerSampVals.at(0) / jetE );
-      m_EMB1        -> Fill( ePerSampVals.at(1) / jetE );
-      m_EMB2        -> Fill( ePerSampVals.at(2) / jetE );
-      m_EMB3        -> Fill( ePerSampVals.at(3) / jetE );
-      m_PreSamplerE -> Fill( ePerSampVals.at(4) / jetE );
-      m_EME1        -> Fill( ePerSampVals.at(5) / jetE );
-      m_EME2        -> Fill( ePerSampVals.at(6) / jetE );
-      m_EME3        -> Fill( ePerSampVals.at(7) / jetE );
-      m_HEC0        -> Fill( ePerSampVals.at(8) / jetE );
-      m_HEC1        -> Fill( ePerSampVals.at(9) / jetE );
-      m_HEC2        -> Fill( ePerSampVals.at(10) / jetE );
-      m_HEC3        -> Fill( ePerSampVals.at(11) / jetE );
-      m_TileBar0    -> Fill( ePerSampVals.at(12) / jetE );
-      m_TileBar1    -> Fill( ePerSampVals.at(13) / jetE );
-      m_TileBar2    -> Fill( ePerSampVals.at(14) / jetE );
-      m_TileGap1    -> Fill( ePerSampVals.at(15) / jetE );
-      m_TileGap2    -> Fill( ePerSampVals.at(16) / jetE );
-      m_TileGap3    -> Fill( ePerSampVals.at(17) / jetE );
-      m_TileExt0    -> Fill( ePerSampVals.at(18) / jetE );
-      m_TileExt1    -> Fill( ePerSampVals.at(19) / jetE );
-      m_TileExt2    -> Fill( ePerSampVals.at(20) / jetE );
-      m_FCAL0       -> Fill( ePerSampVals.at(21) / jetE );
-      m_FCAL1       -> Fill( ePerSampVals.at(22) / jetE );
-      m_FCAL2       -> Fill( ePerSampVals.at(23) / jetE );
-    }
-  }
+  */
 
+  return StatusCode::SUCCESS;
+}
 
+StatusCode JetHists::fillLayer( const xAOD::Jet* jet, float eventWeight, const xAOD::EventInfo* /*eventInfo*/ ) {
+  if(m_debug) std::cout << "JetHists: m_layer " <<std::endl;
+
+  static SG::AuxElement::ConstAccessor< vector<float> > ePerSamp ("EnergyPerSampling");
+  if( ePerSamp.isAvailable( *jet ) ) {
+    vector<float> ePerSampVals = ePerSamp( *jet );
+    float jetE = jet->e();
+    m_PreSamplerB -> Fill( ePerSampVals.at(0) / jetE );
+    m_EMB1        -> Fill( ePerSampVals.at(1) / jetE );
+    m_EMB2        -> Fill( ePerSampVals.at(2) / jetE );
+    m_EMB3        -> Fill( ePerSampVals.at(3) / jetE );
+    m_PreSamplerE -> Fill( ePerSampVals.at(4) / jetE );
+    m_EME1        -> Fill( ePerSampVals.at(5) / jetE );
+    m_EME2        -> Fill( ePerSampVals.at(6) / jetE );
+    m_EME3        -> Fill( ePerSampVals.at(7) / jetE );
+    m_HEC0        -> Fill( ePerSampVals.at(8) / jetE );
+    m_HEC1        -> Fill( ePerSampVals.at(9) / jetE );
+    m_HEC2        -> Fill( ePerSampVals.at(10) / jetE );
+    m_HEC3        -> Fill( ePerSampVals.at(11) / jetE );
+    m_TileBar0    -> Fill( ePerSampVals.at(12) / jetE );
+    m_TileBar1    -> Fill( ePerSampVals.at(13) / jetE );
+    m_TileBar2    -> Fill( ePerSampVals.at(14) / jetE );
+    m_TileGap1    -> Fill( ePerSampVals.at(15) / jetE );
+    m_TileGap2    -> Fill( ePerSampVals.at(16) / jetE );
+    m_TileGap3    -> Fill( ePerSampVals.at(17) / jetE );
+    m_TileExt0    -> Fill( ePerSampVals.at(18) / jetE );
+    m_TileExt1    -> Fill( ePerSampVals.at(19) / jetE );
+    m_TileExt2    -> Fill( ePerSampVals.at(20) / jetE );
+    m_FCAL0       -> Fill( ePerSampVals.at(21) / jetE );
+    m_FCAL1       -> Fill( ePerSampVals.at(22) / jetE );
+    m_FCAL2       -> Fill( ePerSampVals.at(23) / jetE );
+  }
+  return StatusCode::SUCCESS;
+}
 
-  // area
-  /*
-  if ( m_fillArea ) {
 
-    static SG::AuxElement::ConstAccessor<int> actArea ("ActiveArea");
-    if( actArea.isAvailable( *jet ) ) {
-      m_actArea ->  Fill( actArea( *jet ), eventWeight );
-    }
+// area
+/*
+if ( m_fillArea ) {
 
-    static SG::AuxElement::ConstAccessor<int> voroniA ("VoronoiArea");
-    if( voroniA.isAvailable( *jet ) ) {
-      m_voroniA ->  Fill( voroniA( *jet ), eventWeight );
-    }
+  static SG::AuxElement::ConstAccessor<int> actArea ("ActiveArea");
+  if( actArea.isAvailable( *jet ) ) {
+    m_actArea ->  Fill( actArea( *jet ), eventWeight );
+  }
 
-    static SG::AuxElement::ConstAccessor<int> voroniAE ("VoronoiAreaE");
-    if( voroniAE.isAvailable( *jet ) ) {
-      m_voroniAE ->  Fill( voroniAE( *jet ), eventWeight );
-    }
+  static SG::AuxElement::ConstAccessor<int> voroniA ("VoronoiArea");
+  if( voroniA.isAvailable( *jet ) ) {
+    m_voroniA ->  Fill( voroniA( *jet ), eventWeight );
+  }
 
-    static SG::AuxElement::ConstAccessor<int> voroniAPx ("VoronoiAreaPx");
-    if( voroniAPx.isAvailable( *jet ) ) {
-      m_voroniAPx ->  Fill( voroniAPx( *jet ), eventWeight );
-    }
+  static SG::AuxElement::ConstAccessor<int> voroniAE ("VoronoiAreaE");
+  if( voroniAE.isAvailable( *jet ) ) {
+    m_voroniAE ->  Fill( voroniAE( *jet ), eventWeight );
+  }
 
-    static SG::AuxElement::ConstAccessor<int> voroniAPy ("CentroidR");
-    if( voroniAPy.isAvailable( *jet ) ) {
-      m_voroniAPy ->  Fill( voroniAPy( *jet ), eventWeight );
-    }
+  static SG::AuxElement::ConstAccessor<int> voroniAPx ("VoronoiAreaPx");
+  if( voroniAPx.isAvailable( *jet ) ) {
+    m_voroniAPx ->  Fill( voroniAPx( *jet ), eventWeight );
+  }
 
-    static SG::AuxElement::ConstAccessor<int> voroniAPz ("CentroidR");
-    if( voroniAPz.isAvailable( *jet ) ) {
-      m_voroniAPz ->  Fill( voroniAPz( *jet ), eventWeight );
-    }
+  static SG::AuxElement::ConstAccessor<int> voroniAPy ("CentroidR");
+  if( voroniAPy.isAvailable( *jet ) ) {
+    m_voroniAPy ->  Fill( voroniAPy( *jet ), eventWeight );
+  }
 
+  static SG::AuxElement::ConstAccessor<int> voroniAPz ("CentroidR");
+  if( voroniAPz.isAvailable( *jet ) ) {
+    m_voroniAPz ->  Fill( voroniAPz( *jet ), eventWeight );
   }
-  */
 
+}
+*/
 
-  /*
-  // tracks
-  if ( m_fillTrks ) {
+
+/*
+// tracks
+if ( m_fillTrks ) {
  // 0040       TrackMF,
  // 0041       TrackMFindex,
  // 0049       WIDTH,
@@ -783,23 +828,22 @@ StatusCode JetHists::execute( const xAOD::IParticle* particle, float eventWeight
  } */
 
 
-
-  /*
-  // isolation
-  if ( m_fillIso ) {
+/*
+// isolation
+if ( m_fillIso ) {
  // 0024       IsoKR20Par,
  // 0025       IsoKR20Perp,
+}
+*/
+
+/*
+// substructure
+if( m_fillSubstructure) {
+  // 0029       KtDR,
+  static SG::AuxElement::ConstAccessor<int> ktDR ("KtDR");
+  if( ktDR.isAvailable( *jet ) ) {
+    m_ktDR ->  Fill( ktDR( *jet ), eventWeight );
   }
-  */
-
-  /*
-  // substructure
-  if( m_fillSubstructure) {
-    // 0029       KtDR,
-    static SG::AuxElement::ConstAccessor<int> ktDR ("KtDR");
-    if( ktDR.isAvailable( *jet ) ) {
-      m_ktDR ->  Fill( ktDR( *jet ), eventWeight );
-    }
  // 0050       YFlip12,
  // 0051       YFlip13,
  // 0074       Tau1,
@@ -821,194 +865,196 @@ StatusCode JetHists::execute( const xAOD::IParticle* particle, float eventWeight
  //
  // 0088       Sphericity,
  // 0089       Aplanarity,
-  }
+}
 
-  */
+*/
 
-  // truth
+// truth
  // 0073       PtTruth,
  // 0013       GhostTruthParticleCount,
  // 0028       JetLabel,
  // 0042       TruthMF,
  // 0043       TruthMFindex,
 
-  if( m_infoSwitch->m_truth ) {
-    if(m_debug) std::cout << "JetHists: m_truth " <<std::endl;
-
-    static SG::AuxElement::ConstAccessor<int> TruthLabelID ("TruthLabelID");
-    if( TruthLabelID.isAvailable( *jet ) ) {
-      m_truthLabelID ->  Fill( TruthLabelID( *jet ), eventWeight );
-    }else{
-      static SG::AuxElement::ConstAccessor<int> PartonTruthLabelID ("PartonTruthLabelID");
-      if( PartonTruthLabelID.isAvailable( *jet ) ) {
-	m_truthLabelID ->  Fill( PartonTruthLabelID( *jet ), eventWeight );
-      }
-    }
+StatusCode JetHists::fillTruth( const xAOD::Jet* jet, float eventWeight, const xAOD::EventInfo* /*eventInfo*/ ) {
+  if(m_debug) std::cout << "JetHists: m_truth " <<std::endl;
 
-    static SG::AuxElement::ConstAccessor<int> HadronConeExclTruthLabelID ("HadronConeExclTruthLabelID");
-    if( HadronConeExclTruthLabelID.isAvailable( *jet ) ) {
-      m_hadronConeExclTruthLabelID ->  Fill( HadronConeExclTruthLabelID( *jet ), eventWeight );
+  static SG::AuxElement::ConstAccessor<int> TruthLabelID ("TruthLabelID");
+  if( TruthLabelID.isAvailable( *jet ) ) {
+    m_truthLabelID ->  Fill( TruthLabelID( *jet ), eventWeight );
+  }else{
+    static SG::AuxElement::ConstAccessor<int> PartonTruthLabelID ("PartonTruthLabelID");
+    if( PartonTruthLabelID.isAvailable( *jet ) ) {
+	m_truthLabelID ->  Fill( PartonTruthLabelID( *jet ), eventWeight );
     }
+  }
 
-    static SG::AuxElement::ConstAccessor<int> TruthCount ("TruthCount");
-    if( TruthCount.isAvailable( *jet ) ) {
-      m_truthCount ->  Fill( TruthCount( *jet ), eventWeight );
-    }
+  static SG::AuxElement::ConstAccessor<int> HadronConeExclTruthLabelID ("HadronConeExclTruthLabelID");
+  if( HadronConeExclTruthLabelID.isAvailable( *jet ) ) {
+    m_hadronConeExclTruthLabelID ->  Fill( HadronConeExclTruthLabelID( *jet ), eventWeight );
+  }
 
-    static SG::AuxElement::ConstAccessor<float> TruthPt ("TruthPt");
-    if( TruthPt.isAvailable( *jet ) ) {
-      m_truthPt ->  Fill( TruthPt( *jet )/1000, eventWeight );
-    }
+  static SG::AuxElement::ConstAccessor<int> TruthCount ("TruthCount");
+  if( TruthCount.isAvailable( *jet ) ) {
+    m_truthCount ->  Fill( TruthCount( *jet ), eventWeight );
+  }
 
-    static SG::AuxElement::ConstAccessor<float> TruthLabelDeltaR_B ("TruthLabelDeltaR_B");
-    if( TruthLabelDeltaR_B.isAvailable( *jet ) ) {
-      m_truthDr_B ->  Fill( TruthLabelDeltaR_B( *jet ), eventWeight );
-    }
+  static SG::AuxElement::ConstAccessor<float> TruthPt ("TruthPt");
+  if( TruthPt.isAvailable( *jet ) ) {
+    m_truthPt ->  Fill( TruthPt( *jet )/1000, eventWeight );
+  }
 
-    static SG::AuxElement::ConstAccessor<float> TruthLabelDeltaR_C ("TruthLabelDeltaR_C");
-    if( TruthLabelDeltaR_C.isAvailable( *jet ) ) {
-      m_truthDr_C ->  Fill( TruthLabelDeltaR_C( *jet ), eventWeight );
-    }
+  static SG::AuxElement::ConstAccessor<float> TruthLabelDeltaR_B ("TruthLabelDeltaR_B");
+  if( TruthLabelDeltaR_B.isAvailable( *jet ) ) {
+    m_truthDr_B ->  Fill( TruthLabelDeltaR_B( *jet ), eventWeight );
+  }
 
-    static SG::AuxElement::ConstAccessor<float> TruthLabelDeltaR_T ("TruthLabelDeltaR_T");
-    if( TruthLabelDeltaR_T.isAvailable( *jet ) ) {
-      m_truthDr_T ->  Fill( TruthLabelDeltaR_T( *jet ), eventWeight );
-    }
+  static SG::AuxElement::ConstAccessor<float> TruthLabelDeltaR_C ("TruthLabelDeltaR_C");
+  if( TruthLabelDeltaR_C.isAvailable( *jet ) ) {
+    m_truthDr_C ->  Fill( TruthLabelDeltaR_C( *jet ), eventWeight );
+  }
 
+  static SG::AuxElement::ConstAccessor<float> TruthLabelDeltaR_T ("TruthLabelDeltaR_T");
+  if( TruthLabelDeltaR_T.isAvailable( *jet ) ) {
+    m_truthDr_T ->  Fill( TruthLabelDeltaR_T( *jet ), eventWeight );
   }
 
+  return StatusCode::SUCCESS;
+}
 
-  if( m_infoSwitch->m_truthDetails ) {
-    if(m_debug) std::cout << "JetHists: m_truthDetails " <<std::endl;
 
-    //
-    // B-Hadron Details
-    //
-    static SG::AuxElement::ConstAccessor<int> GhostBHadronsFinalCount ("GhostBHadronsFinalCount");
-    if( GhostBHadronsFinalCount.isAvailable( *jet ) ) {
-      m_truthCount_BhadFinal ->  Fill( GhostBHadronsFinalCount( *jet ), eventWeight );
-    }
-
-    static SG::AuxElement::ConstAccessor<int> GhostBHadronsInitialCount ("GhostBHadronsInitialCount");
-    if( GhostBHadronsInitialCount.isAvailable( *jet ) ) {
-      m_truthCount_BhadInit ->  Fill( GhostBHadronsInitialCount( *jet ), eventWeight );
-    }
+StatusCode JetHists::fillTruthDetails( const xAOD::Jet* jet, float eventWeight, const xAOD::EventInfo* /*eventInfo*/ ) {
+  if(m_debug) std::cout << "JetHists: m_truthDetails " <<std::endl;
 
-    static SG::AuxElement::ConstAccessor<int> GhostBQuarksFinalCount ("GhostBQuarksFinalCount");
-    if( GhostBQuarksFinalCount.isAvailable( *jet ) ) {
-      m_truthCount_BQFinal ->  Fill( GhostBQuarksFinalCount( *jet ), eventWeight );
-    }
+  //
+  // B-Hadron Details
+  //
+  static SG::AuxElement::ConstAccessor<int> GhostBHadronsFinalCount ("GhostBHadronsFinalCount");
+  if( GhostBHadronsFinalCount.isAvailable( *jet ) ) {
+    m_truthCount_BhadFinal ->  Fill( GhostBHadronsFinalCount( *jet ), eventWeight );
+  }
 
-    static SG::AuxElement::ConstAccessor<float> GhostBHadronsFinalPt ("GhostBHadronsFinalPt");
-    if( GhostBHadronsFinalPt.isAvailable( *jet ) ) {
-      m_truthPt_BhadFinal ->  Fill( GhostBHadronsFinalPt( *jet ), eventWeight );
-    }
+  static SG::AuxElement::ConstAccessor<int> GhostBHadronsInitialCount ("GhostBHadronsInitialCount");
+  if( GhostBHadronsInitialCount.isAvailable( *jet ) ) {
+    m_truthCount_BhadInit ->  Fill( GhostBHadronsInitialCount( *jet ), eventWeight );
+  }
 
-    static SG::AuxElement::ConstAccessor<float> GhostBHadronsInitialPt ("GhostBHadronsInitialPt");
-    if( GhostBHadronsInitialPt.isAvailable( *jet ) ) {
-      m_truthPt_BhadInit ->  Fill( GhostBHadronsInitialPt( *jet ), eventWeight );
-    }
+  static SG::AuxElement::ConstAccessor<int> GhostBQuarksFinalCount ("GhostBQuarksFinalCount");
+  if( GhostBQuarksFinalCount.isAvailable( *jet ) ) {
+    m_truthCount_BQFinal ->  Fill( GhostBQuarksFinalCount( *jet ), eventWeight );
+  }
 
-    static SG::AuxElement::ConstAccessor<float> GhostBQuarksFinalPt ("GhostBQuarksFinalPt");
-    if( GhostBQuarksFinalPt.isAvailable( *jet ) ) {
-      m_truthPt_BQFinal ->  Fill( GhostBQuarksFinalPt( *jet ), eventWeight );
-    }
+  static SG::AuxElement::ConstAccessor<float> GhostBHadronsFinalPt ("GhostBHadronsFinalPt");
+  if( GhostBHadronsFinalPt.isAvailable( *jet ) ) {
+    m_truthPt_BhadFinal ->  Fill( GhostBHadronsFinalPt( *jet ), eventWeight );
+  }
 
+  static SG::AuxElement::ConstAccessor<float> GhostBHadronsInitialPt ("GhostBHadronsInitialPt");
+  if( GhostBHadronsInitialPt.isAvailable( *jet ) ) {
+    m_truthPt_BhadInit ->  Fill( GhostBHadronsInitialPt( *jet ), eventWeight );
+  }
 
-    //
-    // C-Hadron Details
-    //
-    static SG::AuxElement::ConstAccessor<int> GhostCHadronsFinalCount ("GhostCHadronsFinalCount");
-    if( GhostCHadronsFinalCount.isAvailable( *jet ) ) {
-      m_truthCount_ChadFinal ->  Fill( GhostCHadronsFinalCount( *jet ), eventWeight );
-    }
+  static SG::AuxElement::ConstAccessor<float> GhostBQuarksFinalPt ("GhostBQuarksFinalPt");
+  if( GhostBQuarksFinalPt.isAvailable( *jet ) ) {
+    m_truthPt_BQFinal ->  Fill( GhostBQuarksFinalPt( *jet ), eventWeight );
+  }
 
-    static SG::AuxElement::ConstAccessor<int> GhostCHadronsInitialCount ("GhostCHadronsInitialCount");
-    if( GhostCHadronsInitialCount.isAvailable( *jet ) ) {
-      m_truthCount_ChadInit ->  Fill( GhostCHadronsInitialCount( *jet ), eventWeight );
-    }
 
-    static SG::AuxElement::ConstAccessor<int> GhostCQuarksFinalCount ("GhostCQuarksFinalCount");
-    if( GhostCQuarksFinalCount.isAvailable( *jet ) ) {
-      m_truthCount_CQFinal ->  Fill( GhostCQuarksFinalCount( *jet ), eventWeight );
-    }
+  //
+  // C-Hadron Details
+  //
+  static SG::AuxElement::ConstAccessor<int> GhostCHadronsFinalCount ("GhostCHadronsFinalCount");
+  if( GhostCHadronsFinalCount.isAvailable( *jet ) ) {
+    m_truthCount_ChadFinal ->  Fill( GhostCHadronsFinalCount( *jet ), eventWeight );
+  }
 
-    static SG::AuxElement::ConstAccessor<float> GhostCHadronsFinalPt ("GhostCHadronsFinalPt");
-    if( GhostCHadronsFinalPt.isAvailable( *jet ) ) {
-      m_truthPt_ChadFinal ->  Fill( GhostCHadronsFinalPt( *jet ), eventWeight );
-    }
+  static SG::AuxElement::ConstAccessor<int> GhostCHadronsInitialCount ("GhostCHadronsInitialCount");
+  if( GhostCHadronsInitialCount.isAvailable( *jet ) ) {
+    m_truthCount_ChadInit ->  Fill( GhostCHadronsInitialCount( *jet ), eventWeight );
+  }
 
-    static SG::AuxElement::ConstAccessor<float> GhostCHadronsInitialPt ("GhostCHadronsInitialPt");
-    if( GhostCHadronsInitialPt.isAvailable( *jet ) ) {
-      m_truthPt_ChadInit ->  Fill( GhostCHadronsInitialPt( *jet ), eventWeight );
-    }
+  static SG::AuxElement::ConstAccessor<int> GhostCQuarksFinalCount ("GhostCQuarksFinalCount");
+  if( GhostCQuarksFinalCount.isAvailable( *jet ) ) {
+    m_truthCount_CQFinal ->  Fill( GhostCQuarksFinalCount( *jet ), eventWeight );
+  }
 
-    static SG::AuxElement::ConstAccessor<float> GhostCQuarksFinalPt ("GhostCQuarksFinalPt");
-    if( GhostCQuarksFinalPt.isAvailable( *jet ) ) {
-      m_truthPt_CQFinal ->  Fill( GhostCQuarksFinalPt( *jet ), eventWeight );
-    }
+  static SG::AuxElement::ConstAccessor<float> GhostCHadronsFinalPt ("GhostCHadronsFinalPt");
+  if( GhostCHadronsFinalPt.isAvailable( *jet ) ) {
+    m_truthPt_ChadFinal ->  Fill( GhostCHadronsFinalPt( *jet ), eventWeight );
+  }
 
+  static SG::AuxElement::ConstAccessor<float> GhostCHadronsInitialPt ("GhostCHadronsInitialPt");
+  if( GhostCHadronsInitialPt.isAvailable( *jet ) ) {
+    m_truthPt_ChadInit ->  Fill( GhostCHadronsInitialPt( *jet ), eventWeight );
+  }
 
-    //
-    // Tau Details
-    //
-    static SG::AuxElement::ConstAccessor<int> GhostTausFinalCount ("GhostTausFinalCount");
-    if( GhostTausFinalCount.isAvailable( *jet ) ) {
-      m_truthCount_TausFinal ->  Fill( GhostTausFinalCount( *jet ), eventWeight );
-    }
+  static SG::AuxElement::ConstAccessor<float> GhostCQuarksFinalPt ("GhostCQuarksFinalPt");
+  if( GhostCQuarksFinalPt.isAvailable( *jet ) ) {
+    m_truthPt_CQFinal ->  Fill( GhostCQuarksFinalPt( *jet ), eventWeight );
+  }
 
 
-    static SG::AuxElement::ConstAccessor<float> GhostTausFinalPt ("GhostTausFinalPt");
-    if( GhostTausFinalPt.isAvailable( *jet ) ) {
-      m_truthPt_TausFinal ->  Fill( GhostTausFinalPt( *jet ), eventWeight );
-    }
+  //
+  // Tau Details
+  //
+  static SG::AuxElement::ConstAccessor<int> GhostTausFinalCount ("GhostTausFinalCount");
+  if( GhostTausFinalCount.isAvailable( *jet ) ) {
+    m_truthCount_TausFinal ->  Fill( GhostTausFinalCount( *jet ), eventWeight );
+  }
 
 
+  static SG::AuxElement::ConstAccessor<float> GhostTausFinalPt ("GhostTausFinalPt");
+  if( GhostTausFinalPt.isAvailable( *jet ) ) {
+    m_truthPt_TausFinal ->  Fill( GhostTausFinalPt( *jet ), eventWeight );
   }
 
-  //
-  // JVC
-  //
-  // if(m_infoSwitch->m_JVC) {
-  //   if(m_debug) std::cout << "JetHists: m_JVC " << std::endl;
-  //   m_JVC->Fill(jet->JVC, eventWeight);
-  // }
 
-  //
-  // BTagging
-  //
-  if( m_infoSwitch->m_flavorTag || m_infoSwitch->m_flavorTagHLT ) {
-    if(m_debug) std::cout << "JetHists: m_flavorTag " <<std::endl;
-    const xAOD::BTagging *btag_info(0);
-    if(m_infoSwitch->m_flavorTag){
-      btag_info = jet->btagging();
-    }else if(m_infoSwitch->m_flavorTagHLT){
-      btag_info = jet->auxdata< const xAOD::BTagging* >("HLTBTag");
-    }
+  return StatusCode::SUCCESS;
+}
 
-    double MV2c00 = -99;
-    double MV2c10 = -99;
-    double MV2c20 = -99;
-    btag_info->MVx_discriminant("MV2c00", MV2c00);
-    btag_info->MVx_discriminant("MV2c10", MV2c10);
-    btag_info->MVx_discriminant("MV2c20", MV2c20);
-    m_MV2c00   ->  Fill( MV2c00, eventWeight );
-    m_MV2c10   ->  Fill( MV2c10, eventWeight );
-    m_MV2c10_l ->  Fill( MV2c10, eventWeight );
-    m_MV2c20   ->  Fill( MV2c20, eventWeight );
+//
+// JVC
+//
+// if(m_infoSwitch->m_JVC) {
+//   if(m_debug) std::cout << "JetHists: m_JVC " << std::endl;
+//   m_JVC->Fill(jet->JVC, eventWeight);
+// }
 
-    if(m_infoSwitch->m_vsLumiBlock || m_infoSwitch->m_vsActualMu){
+//
+// BTagging
+//
+StatusCode JetHists::fillFlavorTag( const xAOD::Jet* jet, float eventWeight, const xAOD::EventInfo* eventInfo ) {
+  if(m_debug) std::cout << "JetHists: m_flavorTag " <<std::endl;
+  const xAOD::BTagging *btag_info(0);
+  if(m_infoSwitch->m_flavorTag){
+    btag_info = jet->btagging();
+  }else if(m_infoSwitch->m_flavorTagHLT){
+    btag_info = jet->auxdata< const xAOD::BTagging* >("HLTBTag");
+  }
 
+  double MV2c00 = -99;
+  double MV2c10 = -99;
+  double MV2c20 = -99;
+  btag_info->MVx_discriminant("MV2c00", MV2c00);
+  btag_info->MVx_discriminant("MV2c10", MV2c10);
+  btag_info->MVx_discriminant("MV2c20", MV2c20);
+  m_MV2c00   ->  Fill( MV2c00, eventWeight );
+  m_MV2c10   ->  Fill( MV2c10, eventWeight );
+  m_MV2c10_l ->  Fill( MV2c10, eventWeight );
+  m_MV2c20   ->  Fill( MV2c20, eventWeight );
 
-      bool passMV2c1040 = (MV2c10 > 0.975);
-      bool passMV2c1050 = (MV2c10 > 0.95);
-      bool passMV2c1060 = (MV2c10 > 0.939);
-      bool passMV2c1070 = (MV2c10 > 0.831);
-      bool passMV2c1077 = (MV2c10 > 0.645);
-      bool passMV2c1085 = (MV2c10 > 0.11);
+  if(m_infoSwitch->m_vsLumiBlock || m_infoSwitch->m_vsActualMu){
 
 
-      if(m_infoSwitch->m_flavorTagHLT){
+    bool passMV2c1040 = (MV2c10 > 0.975);
+    bool passMV2c1050 = (MV2c10 > 0.95);
+    bool passMV2c1060 = (MV2c10 > 0.939);
+    bool passMV2c1070 = (MV2c10 > 0.831);
+    bool passMV2c1077 = (MV2c10 > 0.645);
+    bool passMV2c1085 = (MV2c10 > 0.11);
+
+
+    if(m_infoSwitch->m_flavorTagHLT){
 	passMV2c1040 = (MV2c10 >  0.978);
 	passMV2c1050 = (MV2c10 >  0.948);
 	passMV2c1060 = (MV2c10 >  0.847);
@@ -1016,10 +1062,10 @@ StatusCode JetHists::execute( const xAOD::IParticle* particle, float eventWeight
 	passMV2c1077 = (MV2c10 >  0.162);
 	passMV2c1085 = (MV2c10 > -0.494);
 
-      }
+    }
 
 
-      if(m_infoSwitch->m_vsLumiBlock){
+    if(m_infoSwitch->m_vsLumiBlock){
 	uint32_t lumiBlock = eventInfo->lumiBlock();
 
 	m_frac_MV240_vs_lBlock  -> Fill(lumiBlock, passMV2c1040,  eventWeight);
@@ -1028,10 +1074,10 @@ StatusCode JetHists::execute( const xAOD::IParticle* particle, float eventWeight
 	m_frac_MV270_vs_lBlock  -> Fill(lumiBlock, passMV2c1070,  eventWeight);
 	m_frac_MV277_vs_lBlock  -> Fill(lumiBlock, passMV2c1077,  eventWeight);
 	m_frac_MV285_vs_lBlock  -> Fill(lumiBlock, passMV2c1085,  eventWeight);
-      }
+    }
 
 
-      if(m_infoSwitch->m_vsActualMu){
+    if(m_infoSwitch->m_vsActualMu){
 	float actualMu = eventInfo->actualInteractionsPerCrossing();
 
 	m_frac_MV240_vs_actMu  -> Fill(actualMu, passMV2c1040,  eventWeight);
@@ -1040,53 +1086,55 @@ StatusCode JetHists::execute( const xAOD::IParticle* particle, float eventWeight
 	m_frac_MV270_vs_actMu  -> Fill(actualMu, passMV2c1070,  eventWeight);
 	m_frac_MV277_vs_actMu  -> Fill(actualMu, passMV2c1077,  eventWeight);
 	m_frac_MV285_vs_actMu  -> Fill(actualMu, passMV2c1085,  eventWeight);
-      }
-
     }
 
-    static SG::AuxElement::ConstAccessor<double> SV0_significance3DAcc ("SV0_significance3D");
-    if ( SV0_significance3DAcc.isAvailable(*btag_info) ) {
-      m_COMB            ->  Fill( btag_info->SV1_loglikelihoodratio() + btag_info->IP3D_loglikelihoodratio() , eventWeight );
-      m_JetFitter       ->  Fill( btag_info->JetFitter_loglikelihoodratio() , eventWeight );
-    }
+  }
+
+  static SG::AuxElement::ConstAccessor<double> SV0_significance3DAcc ("SV0_significance3D");
+  if ( SV0_significance3DAcc.isAvailable(*btag_info) ) {
+    m_COMB            ->  Fill( btag_info->SV1_loglikelihoodratio() + btag_info->IP3D_loglikelihoodratio() , eventWeight );
+    m_JetFitter       ->  Fill( btag_info->JetFitter_loglikelihoodratio() , eventWeight );
+  }
 
-    if(m_infoSwitch->m_btag_jettrk){
-      if(m_debug) std::cout << "JetHists: m_btag_jettrk " <<std::endl;
-      unsigned trkSum_ntrk   = btag_info->isAvailable<unsigned>("trkSum_ntrk") ? btag_info->auxdata<unsigned>("trkSum_ntrk") : -1;
-      float    trkSum_sPt    = btag_info->isAvailable<float   >("trkSum_SPt" ) ? btag_info->auxdata<float   >("trkSum_SPt" ) : -1000;//<== -1 GeV
-      float trkSum_vPt    = 0;
-      float trkSum_vAbsEta= -10;
-      if (trkSum_ntrk>0) {
+  if(m_infoSwitch->m_btag_jettrk){
+    if(m_debug) std::cout << "JetHists: m_btag_jettrk " <<std::endl;
+    unsigned trkSum_ntrk   = btag_info->isAvailable<unsigned>("trkSum_ntrk") ? btag_info->auxdata<unsigned>("trkSum_ntrk") : -1;
+    float    trkSum_sPt    = btag_info->isAvailable<float   >("trkSum_SPt" ) ? btag_info->auxdata<float   >("trkSum_SPt" ) : -1000;//<== -1 GeV
+    float trkSum_vPt    = 0;
+    float trkSum_vAbsEta= -10;
+    if (trkSum_ntrk>0) {
 	trkSum_vPt    = btag_info->isAvailable<float>("trkSum_VPt" ) ?      btag_info->auxdata<float>("trkSum_VPt" )  : -1000;
 	trkSum_vAbsEta= btag_info->isAvailable<float>("trkSum_VEta") ? fabs(btag_info->auxdata<float>("trkSum_VEta")) : -10  ;
-      }
+    }
+
+    m_trkSum_ntrk     ->  Fill( trkSum_ntrk     , eventWeight );
+    m_trkSum_sPt      ->  Fill( trkSum_sPt/1000 , eventWeight );
+    m_trkSum_vPt      ->  Fill( trkSum_vPt/1000 , eventWeight );
+    m_trkSum_vAbsEta  ->  Fill( trkSum_vAbsEta  , eventWeight );
+
+    /*** Generating MVb variables ***/
+    std::vector< ElementLink< xAOD::TrackParticleContainer > > associationLinks;
+    bool trksOK=btag_info->variable<std::vector<ElementLink<xAOD::TrackParticleContainer> > > ("IP3D", "TrackParticleLinks", associationLinks );
 
-      m_trkSum_ntrk     ->  Fill( trkSum_ntrk     , eventWeight );
-      m_trkSum_sPt      ->  Fill( trkSum_sPt/1000 , eventWeight );
-      m_trkSum_vPt      ->  Fill( trkSum_vPt/1000 , eventWeight );
-      m_trkSum_vAbsEta  ->  Fill( trkSum_vAbsEta  , eventWeight );
-
-      /*** Generating MVb variables ***/
-      std::vector< ElementLink< xAOD::TrackParticleContainer > > associationLinks;
-      bool trksOK=btag_info->variable<std::vector<ElementLink<xAOD::TrackParticleContainer> > > ("IP3D", "TrackParticleLinks", associationLinks );
-
-      std::vector<float> vectD0, vectD0Signi, vectZ0, vectZ0Signi;    vectD0.clear(), vectD0Signi.clear(), vectZ0.clear(), vectZ0Signi.clear();
-      trksOK &= btag_info->variable< std::vector<float> > ("IP3D", "valD0wrtPVofTracks", vectD0     );
-      trksOK &= btag_info->variable< std::vector<float> > ("IP3D", "sigD0wrtPVofTracks", vectD0Signi);
-      trksOK &= btag_info->variable< std::vector<float> > ("IP3D", "valZ0wrtPVofTracks", vectZ0     );
-      trksOK &= btag_info->variable< std::vector<float> > ("IP3D", "sigZ0wrtPVofTracks", vectZ0Signi);
-      if (vectD0.size() and vectD0Signi.size() and vectZ0.size() and vectZ0Signi.size()) {
+    std::vector<float> vectD0, vectD0Signi, vectZ0, vectZ0Signi;    vectD0.clear(), vectD0Signi.clear(), vectZ0.clear(), vectZ0Signi.clear();
+    trksOK &= btag_info->variable< std::vector<float> > ("IP3D", "valD0wrtPVofTracks", vectD0     );
+    trksOK &= btag_info->variable< std::vector<float> > ("IP3D", "sigD0wrtPVofTracks", vectD0Signi);
+    trksOK &= btag_info->variable< std::vector<float> > ("IP3D", "valZ0wrtPVofTracks", vectZ0     );
+    trksOK &= btag_info->variable< std::vector<float> > ("IP3D", "sigZ0wrtPVofTracks", vectZ0Signi);
+    if (vectD0.size() and vectD0Signi.size() and vectZ0.size() and vectZ0Signi.size()) {
 	trksOK &= associationLinks.size() == vectD0.size();
 	trksOK &= associationLinks.size() == vectZ0.size();
 	trksOK &= associationLinks.size() == vectD0Signi.size();
 	trksOK &= associationLinks.size() == vectZ0Signi.size();
-      }
+    }
 
-      int ntrks = associationLinks.size();
-      int n_trk_d0cut = 0;
-      if (trksOK) {
+    int ntrks = associationLinks.size();
+    int n_trk_d0cut = 0;
+    if (trksOK) {
 
 	float sum_pt = 0., sum_pt_dr = 0.;
+	const float jetEta = jet->eta();
+	const float jetPhi = jet->phi();
 
 	std::vector<std::pair<float, float> > trk_d0_z0;
 	trk_d0_z0.reserve(associationLinks.size());
@@ -1094,8 +1142,7 @@ StatusCode JetHists::execute( const xAOD::IParticle* particle, float eventWeight
 	unsigned trkIndex=0;
 	for(auto trkIter = associationLinks.begin(); trkIter != associationLinks.end(); ++trkIter) {
 	  const xAOD::TrackParticle* aTemp = **trkIter;
-	  TLorentzVector trk;
-	  trk.SetPtEtaPhiM(aTemp->pt(), aTemp->eta(), aTemp->phi(), 0.);
+	  const float trkPt = aTemp->pt();
 	  // no need for a dedicated selection here, the tracks are already
 	  // selected by the IP3D algorithm
 	  const float d0sig = vectD0Signi.at(trkIndex);
@@ -1105,18 +1152,21 @@ StatusCode JetHists::execute( const xAOD::IParticle* particle, float eventWeight
 	  if (std::fabs(d0sig) > 1.8)
 	    n_trk_d0cut++;
 	  // track width components
-	  sum_pt += trk.Pt();
-	  const float dRtoJet = trk.DeltaR(jet->p4());
-	  sum_pt_dr += dRtoJet * trk.Pt();
+	  sum_pt += trkPt;
+	  const float dEtaToJet = aTemp->eta() - jetEta;
+	  const float dPhiToJet = TVector2::Phi_mpi_pi(aTemp->phi() - jetPhi);
+	  const float dRtoJet = sqrt(dEtaToJet*dEtaToJet + dPhiToJet*dPhiToJet);
+	  sum_pt_dr += dRtoJet * trkPt;
 
 	  // for 3rd higest d0/z0 significance
 	  trk_d0_z0.push_back(std::make_pair(d0sig, z0sig));
 	} //end of trk loop
 
-	// sort by highest signed d0 sig
-	std::sort(trk_d0_z0.begin(), trk_d0_z0.end(), [](const std::pair<float, float>& a, const std::pair<float, float>& b) {
-	    return a.first > b.first;
-	  } );
+	// only the 3rd highest signed d0 sig is needed, no full sort
+	if (trk_d0_z0.size() > 2)
+	  std::nth_element(trk_d0_z0.begin(), trk_d0_z0.begin() + 2, trk_d0_z0.end(), [](const std::pair<float, float>& a, const std::pair<float, float>& b) {
+	      return a.first > b.first;
+	    } );
 
 	//Assign MVb variables
 	float width          = sum_pt > 0 ? sum_pt_dr / sum_pt : 0;
@@ -1130,426 +1180,427 @@ StatusCode JetHists::execute( const xAOD::IParticle* particle, float eventWeight
 	m_trk3_z0sig     -> Fill(trk3_z0sig,     eventWeight);
 
 	int sv1_ntkv;   btag_info->variable<int>  ("SV1", "NGTinSvx", sv1_ntkv);
-        float sv1_efrc; btag_info->variable<float>("SV1", "efracsvx", sv1_efrc);
+      float sv1_efrc; btag_info->variable<float>("SV1", "efracsvx", sv1_efrc);
 	float sv_scaled_efc  = sv1_ntkv>0               ? sv1_efrc * (static_cast<float>(ntrks) / sv1_ntkv)  : -1;
 
-        int jf_ntrkv;  btag_info->variable<int>("JetFitter",   "nTracksAtVtx",  jf_ntrkv);
-        int jf_nvtx1t; btag_info->variable<int>("JetFitter",   "nSingleTracks", jf_nvtx1t);
+      int jf_ntrkv;  btag_info->variable<int>("JetFitter",   "nTracksAtVtx",  jf_ntrkv);
+      int jf_nvtx1t; btag_info->variable<int>("JetFitter",   "nSingleTracks", jf_nvtx1t);
 	float jf_efrc; btag_info->variable<float>("JetFitter", "energyFraction", jf_efrc);
 	float jf_scaled_efc  = (jf_ntrkv + jf_nvtx1t)>0 ? jf_efrc * (static_cast<float>(ntrks) / (jf_ntrkv + jf_nvtx1t)) : -1;
 
 	m_sv_scaled_efc->Fill(sv_scaled_efc, eventWeight);
 	m_jf_scaled_efc->Fill(jf_scaled_efc, eventWeight);
-      }//trkOK
+    }//trkOK
 
-    }
+  }
 
 
-    if(m_infoSwitch->m_jetFitterDetails){
-      if(m_debug) std::cout << "JetHists: m_jetFitterDetails " <<std::endl;
-      static SG::AuxElement::ConstAccessor< int   > jf_nVTXAcc       ("JetFitter_nVTX");
-      static SG::AuxElement::ConstAccessor< int   > jf_nSingleTracks ("JetFitter_nSingleTracks");
-      static SG::AuxElement::ConstAccessor< int   > jf_nTracksAtVtx  ("JetFitter_nTracksAtVtx");
-      static SG::AuxElement::ConstAccessor< float > jf_mass          ("JetFitter_mass");
-      static SG::AuxElement::ConstAccessor< float > jf_energyFraction("JetFitter_energyFraction");
-      static SG::AuxElement::ConstAccessor< float > jf_significance3d("JetFitter_significance3d");
-      static SG::AuxElement::ConstAccessor< float > jf_deltaeta      ("JetFitter_deltaeta");
-      static SG::AuxElement::ConstAccessor< float > jf_deltaphi      ("JetFitter_deltaphi");
-      static SG::AuxElement::ConstAccessor< int   > jf_N2Tpar        ("JetFitter_N2Tpair");
-      static SG::AuxElement::ConstAccessor< double > jf_pb           ("JetFitterCombNN_pb");
-      static SG::AuxElement::ConstAccessor< double > jf_pc           ("JetFitterCombNN_pc");
-      static SG::AuxElement::ConstAccessor< double > jf_pu           ("JetFitterCombNN_pu");
-
-      if(jf_nVTXAcc.isAvailable       (*btag_info)) m_jf_nVTX           ->Fill(jf_nVTXAcc       (*btag_info), eventWeight);
-      if(jf_nSingleTracks.isAvailable (*btag_info)) m_jf_nSingleTracks  ->Fill(jf_nSingleTracks (*btag_info), eventWeight);
-      if(jf_nTracksAtVtx.isAvailable  (*btag_info)) m_jf_nTracksAtVtx   ->Fill(jf_nTracksAtVtx  (*btag_info), eventWeight);
-      if(jf_mass.isAvailable          (*btag_info)) m_jf_mass           ->Fill(jf_mass          (*btag_info)/1000, eventWeight);
-      if(jf_energyFraction.isAvailable(*btag_info)) m_jf_energyFraction ->Fill(jf_energyFraction(*btag_info), eventWeight);
-      if(jf_significance3d.isAvailable(*btag_info)) m_jf_significance3d ->Fill(jf_significance3d(*btag_info), eventWeight);
-      if(jf_deltaeta.isAvailable      (*btag_info)){
+  if(m_infoSwitch->m_jetFitterDetails){
+    if(m_debug) std::cout << "JetHists: m_jetFitterDetails " <<std::endl;
+    static SG::AuxElement::ConstAccessor< int   > jf_nVTXAcc       ("JetFitter_nVTX");
+    static SG::AuxElement::ConstAccessor< int   > jf_nSingleTracks ("JetFitter_nSingleTracks");
+    static SG::AuxElement::ConstAccessor< int   > jf_nTracksAtVtx  ("JetFitter_nTracksAtVtx");
+    static SG::AuxElement::ConstAccessor< float > jf_mass          ("JetFitter_mass");
+    static SG::AuxElement::ConstAccessor< float > jf_energyFraction("JetFitter_energyFraction");
+    static SG::AuxElement::ConstAccessor< float > jf_significance3d("JetFitter_significance3d");
+    static SG::AuxElement::ConstAccessor< float > jf_deltaeta      ("JetFitter_deltaeta");
+    static SG::AuxElement::ConstAccessor< float > jf_deltaphi      ("JetFitter_deltaphi");
+    static SG::AuxElement::ConstAccessor< int   > jf_N2Tpar        ("JetFitter_N2Tpair");
+    static SG::AuxElement::ConstAccessor< double > jf_pb           ("JetFitterCombNN_pb");
+    static SG::AuxElement::ConstAccessor< double > jf_pc           ("JetFitterCombNN_pc");
+    static SG::AuxElement::ConstAccessor< double > jf_pu           ("JetFitterCombNN_pu");
+
+    if(jf_nVTXAcc.isAvailable       (*btag_info)) m_jf_nVTX           ->Fill(jf_nVTXAcc       (*btag_info), eventWeight);
+    if(jf_nSingleTracks.isAvailable (*btag_info)) m_jf_nSingleTracks  ->Fill(jf_nSingleTracks (*btag_info), eventWeight);
+    if(jf_nTracksAtVtx.isAvailable  (*btag_info)) m_jf_nTracksAtVtx   ->Fill(jf_nTracksAtVtx  (*btag_info), eventWeight);
+    if(jf_mass.isAvailable          (*btag_info)) m_jf_mass           ->Fill(jf_mass          (*btag_info)/1000, eventWeight);
+    if(jf_energyFraction.isAvailable(*btag_info)) m_jf_energyFraction ->Fill(jf_energyFraction(*btag_info), eventWeight);
+    if(jf_significance3d.isAvailable(*btag_info)) m_jf_significance3d ->Fill(jf_significance3d(*btag_info), eventWeight);
+    if(jf_deltaeta.isAvailable      (*btag_info)){
 	m_jf_deltaeta       ->Fill(jf_deltaeta      (*btag_info), eventWeight);
 	m_jf_deltaeta_l     ->Fill(jf_deltaeta      (*btag_info), eventWeight);
-      }
-      if(jf_deltaphi.isAvailable      (*btag_info)){
+    }
+    if(jf_deltaphi.isAvailable      (*btag_info)){
 	m_jf_deltaR         ->Fill(hypot(jf_deltaphi(*btag_info),jf_deltaeta(*btag_info)), eventWeight);
 	m_jf_deltaphi       ->Fill(jf_deltaphi      (*btag_info), eventWeight);
 	m_jf_deltaphi_l     ->Fill(jf_deltaphi      (*btag_info), eventWeight);
-      }
-      if(jf_N2Tpar.isAvailable        (*btag_info)) m_jf_N2Tpar         ->Fill(jf_N2Tpar        (*btag_info), eventWeight);
-      if(jf_pb.isAvailable            (*btag_info)) m_jf_pb             ->Fill(jf_pb            (*btag_info), eventWeight);
-      if(jf_pc.isAvailable            (*btag_info)) m_jf_pc             ->Fill(jf_pc            (*btag_info), eventWeight);
-      if(jf_pu.isAvailable            (*btag_info)) m_jf_pu             ->Fill(jf_pu            (*btag_info), eventWeight);
+    }
+    if(jf_N2Tpar.isAvailable        (*btag_info)) m_jf_N2Tpar         ->Fill(jf_N2Tpar        (*btag_info), eventWeight);
+    if(jf_pb.isAvailable            (*btag_info)) m_jf_pb             ->Fill(jf_pb            (*btag_info), eventWeight);
+    if(jf_pc.isAvailable            (*btag_info)) m_jf_pc             ->Fill(jf_pc            (*btag_info), eventWeight);
+    if(jf_pu.isAvailable            (*btag_info)) m_jf_pu             ->Fill(jf_pu            (*btag_info), eventWeight);
 
 
-      float jf_mass_unco; btag_info->variable<float>("JetFitter", "massUncorr" , jf_mass_unco);
-      float jf_dR_flight; btag_info->variable<float>("JetFitter", "dRFlightDir", jf_dR_flight);
+    float jf_mass_unco; btag_info->variable<float>("JetFitter", "massUncorr" , jf_mass_unco);
+    float jf_dR_flight; btag_info->variable<float>("JetFitter", "dRFlightDir", jf_dR_flight);
 
-      m_jf_mass_unco->Fill(jf_mass_unco/1000, eventWeight);
-      m_jf_dR_flight->Fill(jf_dR_flight, eventWeight);
+    m_jf_mass_unco->Fill(jf_mass_unco/1000, eventWeight);
+    m_jf_dR_flight->Fill(jf_dR_flight, eventWeight);
 
 
-    }
+  }
 
-    if(m_infoSwitch->m_svDetails){
-      if(m_debug) std::cout << "JetHists: m_svDetails " <<std::endl;
-      //
-      // SV0
-      //
+  if(m_infoSwitch->m_svDetails){
+    if(m_debug) std::cout << "JetHists: m_svDetails " <<std::endl;
+    //
+    // SV0
+    //
 
-      /// @brief SV0 : Number of good tracks in vertex
-      static SG::AuxElement::ConstAccessor< int   >   sv0_NGTinSvxAcc     ("SV0_NGTinSvx");
-      // @brief SV0 : Number of 2-track pairs
-      static SG::AuxElement::ConstAccessor< int   >   sv0_N2TpairAcc      ("SV0_N2Tpair");
-      /// @brief SV0 : vertex mass
-      static SG::AuxElement::ConstAccessor< float   > sv0_masssvxAcc      ("SV0_masssvx");
-      /// @brief SV0 : energy fraction
-      static SG::AuxElement::ConstAccessor< float   > sv0_efracsvxAcc     ("SV0_efracsvx");                                                                  	/// @brief SV0 : 3D vertex significance
-      static SG::AuxElement::ConstAccessor< float   > sv0_normdistAcc     ("SV0_normdist");
+    /// @brief SV0 : Number of good tracks in vertex
+    static SG::AuxElement::ConstAccessor< int   >   sv0_NGTinSvxAcc     ("SV0_NGTinSvx");
+    // @brief SV0 : Number of 2-track pairs
+    static SG::AuxElement::ConstAccessor< int   >   sv0_N2TpairAcc      ("SV0_N2Tpair");
+    /// @brief SV0 : vertex mass
+    static SG::AuxElement::ConstAccessor< float   > sv0_masssvxAcc      ("SV0_masssvx");
+    /// @brief SV0 : energy fraction
+    static SG::AuxElement::ConstAccessor< float   > sv0_efracsvxAcc     ("SV0_efracsvx");                                                                  	/// @brief SV0 : 3D vertex significance
+    static SG::AuxElement::ConstAccessor< float   > sv0_normdistAcc     ("SV0_normdist");
 
 
-      if(sv0_NGTinSvxAcc .isAvailable(*btag_info)) m_sv0_NGTinSvx -> Fill( sv0_NGTinSvxAcc (*btag_info), eventWeight);
-      if(sv0_N2TpairAcc  .isAvailable(*btag_info)) m_sv0_N2Tpair  -> Fill( sv0_N2TpairAcc  (*btag_info), eventWeight);
-      if(sv0_masssvxAcc  .isAvailable(*btag_info)) m_sv0_massvx   -> Fill( sv0_masssvxAcc  (*btag_info)/1000, eventWeight);
-      if(sv0_efracsvxAcc .isAvailable(*btag_info)) m_sv0_efracsvx -> Fill( sv0_efracsvxAcc (*btag_info), eventWeight);
-      if(sv0_normdistAcc .isAvailable(*btag_info)) m_sv0_normdist -> Fill( sv0_normdistAcc (*btag_info), eventWeight);
+    if(sv0_NGTinSvxAcc .isAvailable(*btag_info)) m_sv0_NGTinSvx -> Fill( sv0_NGTinSvxAcc (*btag_info), eventWeight);
+    if(sv0_N2TpairAcc  .isAvailable(*btag_info)) m_sv0_N2Tpair  -> Fill( sv0_N2TpairAcc  (*btag_info), eventWeight);
+    if(sv0_masssvxAcc  .isAvailable(*btag_info)) m_sv0_massvx   -> Fill( sv0_masssvxAcc  (*btag_info)/1000, eventWeight);
+    if(sv0_efracsvxAcc .isAvailable(*btag_info)) m_sv0_efracsvx -> Fill( sv0_efracsvxAcc (*btag_info), eventWeight);
+    if(sv0_normdistAcc .isAvailable(*btag_info)) m_sv0_normdist -> Fill( sv0_normdistAcc (*btag_info), eventWeight);
 
-      double sv0;
-      btag_info->variable<double>("SV0", "significance3D", sv0);
-      m_SV0             ->  Fill( sv0 , eventWeight );
+    double sv0;
+    btag_info->variable<double>("SV0", "significance3D", sv0);
+    m_SV0             ->  Fill( sv0 , eventWeight );
 
 
-      //
-      // SV1
-      //
+    //
+    // SV1
+    //
 
-      /// @brief SV1 : Number of good tracks in vertex
-      static SG::AuxElement::ConstAccessor< int   >   sv1_NGTinSvxAcc     ("SV1_NGTinSvx");
-      // @brief SV1 : Number of 2-track pairs
-      static SG::AuxElement::ConstAccessor< int   >   sv1_N2TpairAcc      ("SV1_N2Tpair");
-      /// @brief SV1 : vertex mass
-      static SG::AuxElement::ConstAccessor< float   > sv1_masssvxAcc      ("SV1_masssvx");
-      /// @brief SV1 : energy fraction
-      static SG::AuxElement::ConstAccessor< float   > sv1_efracsvxAcc     ("SV1_efracsvx");                                                                 /// @brief SV1 : 3D vertex significance
-      static SG::AuxElement::ConstAccessor< float   > sv1_normdistAcc     ("SV1_normdist");
-
-      if(sv1_NGTinSvxAcc .isAvailable(*btag_info)) m_sv1_NGTinSvx -> Fill( sv1_NGTinSvxAcc (*btag_info), eventWeight);
-      if(sv1_N2TpairAcc  .isAvailable(*btag_info)) m_sv1_N2Tpair  -> Fill( sv1_N2TpairAcc  (*btag_info), eventWeight);
-      if(sv1_masssvxAcc  .isAvailable(*btag_info)) m_sv1_massvx   -> Fill( sv1_masssvxAcc  (*btag_info)/1000, eventWeight);
-      if(sv1_efracsvxAcc .isAvailable(*btag_info)) m_sv1_efracsvx -> Fill( sv1_efracsvxAcc (*btag_info), eventWeight);
-      if(sv1_normdistAcc .isAvailable(*btag_info)) m_sv1_normdist -> Fill( sv1_normdistAcc (*btag_info), eventWeight);
-
-      double sv1_pu = -30;  btag_info->variable<double>("SV1", "pu", sv1_pu);
-      double sv1_pb = -30;  btag_info->variable<double>("SV1", "pb", sv1_pb);
-      double sv1_pc = -30;  btag_info->variable<double>("SV1", "pc", sv1_pc);
-
-      m_SV1_pu         ->  Fill(sv1_pu  , eventWeight );
-      m_SV1_pb         ->  Fill(sv1_pb  , eventWeight );
-      m_SV1_pc         ->  Fill(sv1_pc  , eventWeight );
-
-      m_SV1            ->  Fill( btag_info->calcLLR(sv1_pb,sv1_pu) , eventWeight );
-      m_SV1_c          ->  Fill( btag_info->calcLLR(sv1_pb,sv1_pc) , eventWeight );
-      m_SV1_cu         ->  Fill( btag_info->calcLLR(sv1_pc,sv1_pu) , eventWeight );
-
-      float sv1_Lxy;        btag_info->variable<float>("SV1", "Lxy"             , sv1_Lxy);
-      float sv1_sig3d;      btag_info->variable<float>("SV1", "significance3d"  , sv1_sig3d);
-      float sv1_L3d;        btag_info->variable<float>("SV1", "L3d"             , sv1_L3d);
-      float sv1_distmatlay; btag_info->variable<float>("SV1", "dstToMatLay"     , sv1_distmatlay);
-      float sv1_dR;         btag_info->variable<float>("SV1", "deltaR"          , sv1_dR );
-
-      m_SV1_Lxy        -> Fill(sv1_Lxy,         eventWeight);
-      m_SV1_sig3d      -> Fill(sv1_sig3d,       eventWeight);
-      m_SV1_L3d        -> Fill(sv1_L3d,         eventWeight);
-      m_SV1_distmatlay -> Fill(sv1_distmatlay,  eventWeight);
-      m_SV1_dR         -> Fill(sv1_dR,          eventWeight);
+    /// @brief SV1 : Number of good tracks in vertex
+    static SG::AuxElement::ConstAccessor< int   >   sv1_NGTinSvxAcc     ("SV1_NGTinSvx");
+    // @brief SV1 : Number of 2-track pairs
+    static SG::AuxElement::ConstAccessor< int   >   sv1_N2TpairAcc      ("SV1_N2Tpair");
+    /// @brief SV1 : vertex mass
+    static SG::AuxElement::ConstAccessor< float   > sv1_masssvxAcc      ("SV1_masssvx");
+    /// @brief SV1 : energy fraction
+    static SG::AuxElement::ConstAccessor< float   > sv1_efracsvxAcc     ("SV1_efracsvx");                                                                 /// @brief SV1 : 3D vertex significance
+    static SG::AuxElement::ConstAccessor< float   > sv1_normdistAcc     ("SV1_normdist");
+
+    if(sv1_NGTinSvxAcc .isAvailable(*btag_info)) m_sv1_NGTinSvx -> Fill( sv1_NGTinSvxAcc (*btag_info), eventWeight);
+    if(sv1_N2TpairAcc  .isAvailable(*btag_info)) m_sv1_N2Tpair  -> Fill( sv1_N2TpairAcc  (*btag_info), eventWeight);
+    if(sv1_masssvxAcc  .isAvailable(*btag_info)) m_sv1_massvx   -> Fill( sv1_masssvxAcc  (*btag_info)/1000, eventWeight);
+    if(sv1_efracsvxAcc .isAvailable(*btag_info)) m_sv1_efracsvx -> Fill( sv1_efracsvxAcc (*btag_info), eventWeight);
+    if(sv1_normdistAcc .isAvailable(*btag_info)) m_sv1_normdist -> Fill( sv1_normdistAcc (*btag_info), eventWeight);
+
+    double sv1_pu = -30;  btag_info->variable<double>("SV1", "pu", sv1_pu);
+    double sv1_pb = -30;  btag_info->variable<double>("SV1", "pb", sv1_pb);
+    double sv1_pc = -30;  btag_info->variable<double>("SV1", "pc", sv1_pc);
+
+    m_SV1_pu         ->  Fill(sv1_pu  , eventWeight );
+    m_SV1_pb         ->  Fill(sv1_pb  , eventWeight );
+    m_SV1_pc         ->  Fill(sv1_pc  , eventWeight );
+
+    m_SV1            ->  Fill( btag_info->calcLLR(sv1_pb,sv1_pu) , eventWeight );
+    m_SV1_c          ->  Fill( btag_info->calcLLR(sv1_pb,sv1_pc) , eventWeight );
+    m_SV1_cu         ->  Fill( btag_info->calcLLR(sv1_pc,sv1_pu) , eventWeight );
+
+    float sv1_Lxy;        btag_info->variable<float>("SV1", "Lxy"             , sv1_Lxy);
+    float sv1_sig3d;      btag_info->variable<float>("SV1", "significance3d"  , sv1_sig3d);
+    float sv1_L3d;        btag_info->variable<float>("SV1", "L3d"             , sv1_L3d);
+    float sv1_distmatlay; btag_info->variable<float>("SV1", "dstToMatLay"     , sv1_distmatlay);
+    float sv1_dR;         btag_info->variable<float>("SV1", "deltaR"          , sv1_dR );
+
+    m_SV1_Lxy        -> Fill(sv1_Lxy,         eventWeight);
+    m_SV1_sig3d      -> Fill(sv1_sig3d,       eventWeight);
+    m_SV1_L3d        -> Fill(sv1_L3d,         eventWeight);
+    m_SV1_distmatlay -> Fill(sv1_distmatlay,  eventWeight);
+    m_SV1_dR         -> Fill(sv1_dR,          eventWeight);
 
-    }
+  }
 
 
-    if(m_infoSwitch->m_ipDetails){
-      if(m_debug) std::cout << "JetHists: m_ipDetails " <<std::endl;
-      //
-      // IP2D
-      //
+  if(m_infoSwitch->m_ipDetails){
+    if(m_debug) std::cout << "JetHists: m_ipDetails " <<std::endl;
+    //
+    // IP2D
+    //
 
-      /// @brief IP2D: track grade
-      static SG::AuxElement::ConstAccessor< vector<int>   >   IP2D_gradeOfTracksAcc     ("IP2D_gradeOfTracks");
-      /// @brief IP2D : tracks from V0
-      static SG::AuxElement::ConstAccessor< vector<bool>   >  IP2D_flagFromV0ofTracksAcc("IP2D_flagFromV0ofTracks");
-      /// @brief IP2D : d0 value with respect to primary vertex
-      static SG::AuxElement::ConstAccessor< vector<float>   > IP2D_valD0wrtPVofTracksAcc("IP2D_valD0wrtPVofTracks");
-      /// @brief IP2D : d0 significance with respect to primary vertex
-      static SG::AuxElement::ConstAccessor< vector<float>   > IP2D_sigD0wrtPVofTracksAcc("IP2D_sigD0wrtPVofTracks");
-      /// @brief IP2D : track contribution to B likelihood
-      static SG::AuxElement::ConstAccessor< vector<float>   > IP2D_weightBofTracksAcc   ("IP2D_weightBofTracks");
-      /// @brief IP2D : track contribution to C likelihood
-      static SG::AuxElement::ConstAccessor< vector<float>   > IP2D_weightCofTracksAcc   ("IP2D_weightCofTracks");
-      /// @brief IP2D : track contribution to U likelihood
-      static SG::AuxElement::ConstAccessor< vector<float>   > IP2D_weightUofTracksAcc   ("IP2D_weightUofTracks");
-
-      if(IP2D_gradeOfTracksAcc .isAvailable(*btag_info)){
+    /// @brief IP2D: track grade
+    static SG::AuxElement::ConstAccessor< vector<int>   >   IP2D_gradeOfTracksAcc     ("IP2D_gradeOfTracks");
+    /// @brief IP2D : tracks from V0
+    static SG::AuxElement::ConstAccessor< vector<bool>   >  IP2D_flagFromV0ofTracksAcc("IP2D_flagFromV0ofTracks");
+    /// @brief IP2D : d0 value with respect to primary vertex
+    static SG::AuxElement::ConstAccessor< vector<float>   > IP2D_valD0wrtPVofTracksAcc("IP2D_valD0wrtPVofTracks");
+    /// @brief IP2D : d0 significance with respect to primary vertex
+    static SG::AuxElement::ConstAccessor< vector<float>   > IP2D_sigD0wrtPVofTracksAcc("IP2D_sigD0wrtPVofTracks");
+    /// @brief IP2D : track contribution to B likelihood
+    static SG::AuxElement::ConstAccessor< vector<float>   > IP2D_weightBofTracksAcc   ("IP2D_weightBofTracks");
+    /// @brief IP2D : track contribution to C likelihood
+    static SG::AuxElement::ConstAccessor< vector<float>   > IP2D_weightCofTracksAcc   ("IP2D_weightCofTracks");
+    /// @brief IP2D : track contribution to U likelihood
+    static SG::AuxElement::ConstAccessor< vector<float>   > IP2D_weightUofTracksAcc   ("IP2D_weightUofTracks");
+
+    if(IP2D_gradeOfTracksAcc .isAvailable(*btag_info)){
 	unsigned int nIP2DTracks = IP2D_gradeOfTracksAcc(*btag_info).size();
 	m_nIP2DTracks -> Fill( nIP2DTracks, eventWeight);
 	for(int grade : IP2D_gradeOfTracksAcc(*btag_info))        m_IP2D_gradeOfTracks->Fill(grade, eventWeight);
-      }
+    }
 
-      if(IP2D_flagFromV0ofTracksAcc .isAvailable(*btag_info)){
+    if(IP2D_flagFromV0ofTracksAcc .isAvailable(*btag_info)){
 	for(bool flag : IP2D_flagFromV0ofTracksAcc(*btag_info))   m_IP2D_flagFromV0ofTracks->Fill(flag, eventWeight);
-      }
+    }
 
-      if(IP2D_valD0wrtPVofTracksAcc .isAvailable(*btag_info)){
+    if(IP2D_valD0wrtPVofTracksAcc .isAvailable(*btag_info)){
 	for(float d0 : IP2D_valD0wrtPVofTracksAcc(*btag_info))    m_IP2D_valD0wrtPVofTracks->Fill(d0, eventWeight);
-      }
+    }
 
-      if(IP2D_sigD0wrtPVofTracksAcc .isAvailable(*btag_info)){
+    if(IP2D_sigD0wrtPVofTracksAcc .isAvailable(*btag_info)){
 	for(float d0Sig : IP2D_sigD0wrtPVofTracksAcc(*btag_info)) {
 	  m_IP2D_sigD0wrtPVofTracks  ->Fill(d0Sig, eventWeight);
 	  m_IP2D_sigD0wrtPVofTracks_l->Fill(d0Sig, eventWeight);
 
 
 	}
-      }
+    }
 
-      if(IP2D_weightBofTracksAcc .isAvailable(*btag_info)){
+    if(IP2D_weightBofTracksAcc .isAvailable(*btag_info)){
 	for(float weightB : IP2D_weightBofTracksAcc(*btag_info))  m_IP2D_weightBofTracks->Fill(weightB, eventWeight);
-      }
+    }
 
-      if(IP2D_weightCofTracksAcc .isAvailable(*btag_info)){
+    if(IP2D_weightCofTracksAcc .isAvailable(*btag_info)){
 	for(float weightC : IP2D_weightCofTracksAcc(*btag_info))  m_IP2D_weightCofTracks->Fill(weightC, eventWeight);
-      }
+    }
 
-      if(IP2D_weightUofTracksAcc .isAvailable(*btag_info)){
+    if(IP2D_weightUofTracksAcc .isAvailable(*btag_info)){
 	for(float weightU : IP2D_weightUofTracksAcc(*btag_info))  m_IP2D_weightUofTracks->Fill(weightU, eventWeight);
-      }
+    }
 
-      double ip2_pu = -30;  btag_info->variable<double>("IP2D", "pu", ip2_pu);
-      double ip2_pb = -30;  btag_info->variable<double>("IP2D", "pb", ip2_pb);
-      double ip2_pc = -30;  btag_info->variable<double>("IP2D", "pc", ip2_pc);
+    double ip2_pu = -30;  btag_info->variable<double>("IP2D", "pu", ip2_pu);
+    double ip2_pb = -30;  btag_info->variable<double>("IP2D", "pb", ip2_pb);
+    double ip2_pc = -30;  btag_info->variable<double>("IP2D", "pc", ip2_pc);
 
-      m_IP2D_pu         ->  Fill(ip2_pu  , eventWeight );
-      m_IP2D_pb         ->  Fill(ip2_pb  , eventWeight );
-      m_IP2D_pc         ->  Fill(ip2_pc  , eventWeight );
+    m_IP2D_pu         ->  Fill(ip2_pu  , eventWeight );
+    m_IP2D_pb         ->  Fill(ip2_pb  , eventWeight );
+    m_IP2D_pc         ->  Fill(ip2_pc  , eventWeight );
 
-      m_IP2D            ->  Fill( btag_info->calcLLR(ip2_pb,ip2_pu) , eventWeight );
-      m_IP2D_c          ->  Fill( btag_info->calcLLR(ip2_pb,ip2_pc) , eventWeight );
-      m_IP2D_cu         ->  Fill( btag_info->calcLLR(ip2_pc,ip2_pu) , eventWeight );
+    m_IP2D            ->  Fill( btag_info->calcLLR(ip2_pb,ip2_pu) , eventWeight );
+    m_IP2D_c          ->  Fill( btag_info->calcLLR(ip2_pb,ip2_pc) , eventWeight );
+    m_IP2D_cu         ->  Fill( btag_info->calcLLR(ip2_pc,ip2_pu) , eventWeight );
 
 
-      //
-      // IP3D
-      //
+    //
+    // IP3D
+    //
 
-      /// @brief IP3D: track grade
-      static SG::AuxElement::ConstAccessor< vector<int>   >   IP3D_gradeOfTracksAcc     ("IP3D_gradeOfTracks");
-      /// @brief IP3D : tracks from V0
-      static SG::AuxElement::ConstAccessor< vector<bool>   >  IP3D_flagFromV0ofTracksAcc("IP3D_flagFromV0ofTracks");
-      /// @brief IP3D : d0 value with respect to primary vertex
-      static SG::AuxElement::ConstAccessor< vector<float>   > IP3D_valD0wrtPVofTracksAcc("IP3D_valD0wrtPVofTracks");
-      /// @brief IP3D : d0 significance with respect to primary vertex
-      static SG::AuxElement::ConstAccessor< vector<float>   > IP3D_sigD0wrtPVofTracksAcc("IP3D_sigD0wrtPVofTracks");
-      /// @brief IP3D : z0 value with respect to primary vertex
-      static SG::AuxElement::ConstAccessor< vector<float>   > IP3D_valZ0wrtPVofTracksAcc("IP3D_valZ0wrtPVofTracks");
-      /// @brief IP3D : z0 significance with respect to primary vertex
-      static SG::AuxElement::ConstAccessor< vector<float>   > IP3D_sigZ0wrtPVofTracksAcc("IP3D_sigZ0wrtPVofTracks");
-      /// @brief IP3D : track contribution to B likelihood
-      static SG::AuxElement::ConstAccessor< vector<float>   > IP3D_weightBofTracksAcc   ("IP3D_weightBofTracks");
-      /// @brief IP3D : track contribution to C likelihood
-      static SG::AuxElement::ConstAccessor< vector<float>   > IP3D_weightCofTracksAcc   ("IP3D_weightCofTracks");
-      /// @brief IP3D : track contribution to U likelihood
-      static SG::AuxElement::ConstAccessor< vector<float>   > IP3D_weightUofTracksAcc   ("IP3D_weightUofTracks");
-
-      if(IP3D_gradeOfTracksAcc .isAvailable(*btag_info)){
+    /// @brief IP3D: track grade
+    static SG::AuxElement::ConstAccessor< vector<int>   >   IP3D_gradeOfTracksAcc     ("IP3D_gradeOfTracks");
+    /// @brief IP3D : tracks from V0
+    static SG::AuxElement::ConstAccessor< vector<bool>   >  IP3D_flagFromV0ofTracksAcc("IP3D_flagFromV0ofTracks");
+    /// @brief IP3D : d0 value with respect to primary vertex
+    static SG::AuxElement::ConstAccessor< vector<float>   > IP3D_valD0wrtPVofTracksAcc("IP3D_valD0wrtPVofTracks");
+    /// @brief IP3D : d0 significance with respect to primary vertex
+    static SG::AuxElement::ConstAccessor< vector<float>   > IP3D_sigD0wrtPVofTracksAcc("IP3D_sigD0wrtPVofTracks");
+    /// @brief IP3D : z0 value with respect to primary vertex
+    static SG::AuxElement::ConstAccessor< vector<float>   > IP3D_valZ0wrtPVofTracksAcc("IP3D_valZ0wrtPVofTracks");
+    /// @brief IP3D : z0 significance with respect to primary vertex
+    static SG::AuxElement::ConstAccessor< vector<float>   > IP3D_sigZ0wrtPVofTracksAcc("IP3D_sigZ0wrtPVofTracks");
+    /// @brief IP3D : track contribution to B likelihood
+    static SG::AuxElement::ConstAccessor< vector<float>   > IP3D_weightBofTracksAcc   ("IP3D_weightBofTracks");
+    /// @brief IP3D : track contribution to C likelihood
+    static SG::AuxElement::ConstAccessor< vector<float>   > IP3D_weightCofTracksAcc   ("IP3D_weightCofTracks");
+    /// @brief IP3D : track contribution to U likelihood
+    static SG::AuxElement::ConstAccessor< vector<float>   > IP3D_weightUofTracksAcc   ("IP3D_weightUofTracks");
+
+    if(IP3D_gradeOfTracksAcc .isAvailable(*btag_info)){
 	unsigned int nIP3DTracks = IP3D_gradeOfTracksAcc(*btag_info).size();
 	m_nIP3DTracks -> Fill( nIP3DTracks, eventWeight);
 	for(int grade : IP3D_gradeOfTracksAcc(*btag_info))        m_IP3D_gradeOfTracks->Fill(grade, eventWeight);
-      }
+    }
 
-      if(IP3D_flagFromV0ofTracksAcc .isAvailable(*btag_info)){
+    if(IP3D_flagFromV0ofTracksAcc .isAvailable(*btag_info)){
 	for(bool flag : IP3D_flagFromV0ofTracksAcc(*btag_info))   m_IP3D_flagFromV0ofTracks->Fill(flag, eventWeight);
-      }
+    }
 
-      if(IP3D_valD0wrtPVofTracksAcc .isAvailable(*btag_info)){
+    if(IP3D_valD0wrtPVofTracksAcc .isAvailable(*btag_info)){
 	for(float d0 : IP3D_valD0wrtPVofTracksAcc(*btag_info))    m_IP3D_valD0wrtPVofTracks->Fill(d0, eventWeight);
-      }
+    }
 
-      if(IP3D_sigD0wrtPVofTracksAcc .isAvailable(*btag_info)){
+    if(IP3D_sigD0wrtPVofTracksAcc .isAvailable(*btag_info)){
 	for(float d0Sig : IP3D_sigD0wrtPVofTracksAcc(*btag_info)){
 	  m_IP3D_sigD0wrtPVofTracks  ->Fill(d0Sig, eventWeight);
 	  m_IP3D_sigD0wrtPVofTracks_l->Fill(d0Sig, eventWeight);
 	}
-      }
+    }
 
-      if(IP3D_valZ0wrtPVofTracksAcc .isAvailable(*btag_info)){
+    if(IP3D_valZ0wrtPVofTracksAcc .isAvailable(*btag_info)){
 	for(float z0 : IP3D_valZ0wrtPVofTracksAcc(*btag_info))    m_IP3D_valZ0wrtPVofTracks->Fill(z0, eventWeight);
-      }
+    }
 
-      if(IP3D_sigZ0wrtPVofTracksAcc .isAvailable(*btag_info)){
+    if(IP3D_sigZ0wrtPVofTracksAcc .isAvailable(*btag_info)){
 	for(float z0Sig : IP3D_sigZ0wrtPVofTracksAcc(*btag_info)){
 	  m_IP3D_sigZ0wrtPVofTracks  ->Fill(z0Sig, eventWeight);
 	  m_IP3D_sigZ0wrtPVofTracks_l->Fill(z0Sig, eventWeight);
 	}
-      }
+    }
 
-      if(IP3D_weightBofTracksAcc .isAvailable(*btag_info)){
+    if(IP3D_weightBofTracksAcc .isAvailable(*btag_info)){
 	for(float weightB : IP3D_weightBofTracksAcc(*btag_info))  m_IP3D_weightBofTracks->Fill(weightB, eventWeight);
-      }
+    }
 
-      if(IP3D_weightCofTracksAcc .isAvailable(*btag_info)){
+    if(IP3D_weightCofTracksAcc .isAvailable(*btag_info)){
 	for(float weightC : IP3D_weightCofTracksAcc(*btag_info))  m_IP3D_weightCofTracks->Fill(weightC, eventWeight);
-      }
+    }
 
-      if(IP3D_weightUofTracksAcc .isAvailable(*btag_info)){
+    if(IP3D_weightUofTracksAcc .isAvailable(*btag_info)){
 	for(float weightU : IP3D_weightUofTracksAcc(*btag_info))  m_IP3D_weightUofTracks->Fill(weightU, eventWeight);
-      }
-
-      double ip3_pu = -30;  btag_info->variable<double>("IP3D", "pu", ip3_pu);
-      double ip3_pb = -30;  btag_info->variable<double>("IP3D", "pb", ip3_pb);
-      double ip3_pc = -30;  btag_info->variable<double>("IP3D", "pc", ip3_pc);
-
-      m_IP3D_pu         ->  Fill(ip3_pu  , eventWeight );
-      m_IP3D_pb         ->  Fill(ip3_pb  , eventWeight );
-      m_IP3D_pc         ->  Fill(ip3_pc  , eventWeight );
-
-      m_IP3D            ->  Fill( btag_info->calcLLR(ip3_pb,ip3_pu) , eventWeight );
-      m_IP3D_c          ->  Fill( btag_info->calcLLR(ip3_pb,ip3_pc) , eventWeight );
-      m_IP3D_cu         ->  Fill( btag_info->calcLLR(ip3_pc,ip3_pu) , eventWeight );
-
-
     }
-  }
 
+    double ip3_pu = -30;  btag_info->variable<double>("IP3D", "pu", ip3_pu);
+    double ip3_pb = -30;  btag_info->variable<double>("IP3D", "pb", ip3_pb);
+    double ip3_pc = -30;  btag_info->variable<double>("IP3D", "pc", ip3_pc);
 
+    m_IP3D_pu         ->  Fill(ip3_pu  , eventWeight );
+    m_IP3D_pb         ->  Fill(ip3_pb  , eventWeight );
+    m_IP3D_pc         ->  Fill(ip3_pc  , eventWeight );
 
+    m_IP3D            ->  Fill( btag_info->calcLLR(ip3_pb,ip3_pu) , eventWeight );
+    m_IP3D_c          ->  Fill( btag_info->calcLLR(ip3_pb,ip3_pc) , eventWeight );
+    m_IP3D_cu         ->  Fill( btag_info->calcLLR(ip3_pc,ip3_pu) , eventWeight );
 
-  /*
-  vector<float> chfs = jet->getAttribute< vector<float> >(xAOD::JetAttribute::SumPtTrkPt1000);
-  float chf(-1);
-  if( pvLoc >= 0 && pvLoc < (int)chfs.size() ) {
-    m_chf ->  Fill( chfs.at( pvLoc ) , eventWeight );
-  }
-  */
 
-
-  // testing
-  if( m_infoSwitch->m_resolution ) {
-    if(m_debug) std::cout << "JetHists: m_resolution " <<std::endl;
-    //float ghostTruthPt = jet->getAttribute( xAOD::JetAttribute::GhostTruthPt );
-    float ghostTruthPt = jet->auxdata< float >( "GhostTruthPt" );
-    m_jetGhostTruthPt -> Fill( ghostTruthPt/1e3, eventWeight );
-    float resolution = jet->pt()/ghostTruthPt - 1;
-    m_jetPt_vs_resolution -> Fill( jet->pt()/1e3, resolution, eventWeight );
-    m_jetGhostTruthPt_vs_resolution -> Fill( ghostTruthPt/1e3, resolution, eventWeight );
   }
+  return StatusCode::SUCCESS;
+}
 
-  if( m_infoSwitch->m_substructure ){
-    if(m_debug) std::cout << "JetHists: m_substructure " <<std::endl;
-    static SG::AuxElement::ConstAccessor<float> Tau1("Tau1");
-    static SG::AuxElement::ConstAccessor<float> Tau2("Tau2");
-    static SG::AuxElement::ConstAccessor<float> Tau3("Tau3");
-    static SG::AuxElement::ConstAccessor<float> Tau1_wta("Tau1_wta");
-    static SG::AuxElement::ConstAccessor<float> Tau2_wta("Tau2_wta");
-    static SG::AuxElement::ConstAccessor<float> Tau3_wta("Tau3_wta");
-
-    if(Tau1.isAvailable(*jet)) m_tau1->Fill( Tau1(*jet), eventWeight );
-    if(Tau2.isAvailable(*jet)) m_tau2->Fill( Tau2(*jet), eventWeight );
-    if(Tau3.isAvailable(*jet)) m_tau3->Fill( Tau3(*jet), eventWeight );
-    if(Tau1.isAvailable(*jet) && Tau2.isAvailable(*jet)) m_tau21->Fill( Tau2(*jet)/Tau1(*jet), eventWeight );
-    if(Tau2.isAvailable(*jet) && Tau3.isAvailable(*jet)) m_tau32->Fill( Tau3(*jet)/Tau2(*jet), eventWeight );
-    if(Tau1_wta.isAvailable(*jet)) m_tau1_wta->Fill( Tau1_wta(*jet), eventWeight );
-    if(Tau2_wta.isAvailable(*jet)) m_tau2_wta->Fill( Tau2_wta(*jet), eventWeight );
-    if(Tau3_wta.isAvailable(*jet)) m_tau3_wta->Fill( Tau3_wta(*jet), eventWeight );
-    if(Tau1_wta.isAvailable(*jet) && Tau2_wta.isAvailable(*jet)) m_tau21_wta->Fill( Tau2_wta(*jet)/Tau1_wta(*jet), eventWeight );
-    if(Tau2_wta.isAvailable(*jet) && Tau3_wta.isAvailable(*jet)) m_tau32_wta->Fill( Tau3_wta(*jet)/Tau2_wta(*jet), eventWeight );
-
-    m_numConstituents->Fill( jet->numConstituents(), eventWeight );
 
-  }
+/*
+vector<float> chfs = jet->getAttribute< vector<float> >(xAOD::JetAttribute::SumPtTrkPt1000);
+float chf(-1);
+if( pvLoc >= 0 && pvLoc < (int)chfs.size() ) {
+  m_chf ->  Fill( chfs.at( pvLoc ) , eventWeight );
+}
+*/
+
+
+// testing
+StatusCode JetHists::fillResolution( const xAOD::Jet* jet, float eventWeight, const xAOD::EventInfo* /*eventInfo*/ ) {
+  if(m_debug) std::cout << "JetHists: m_resolution " <<std::endl;
+  //float ghostTruthPt = jet->getAttribute( xAOD::JetAttribute::GhostTruthPt );
+  float ghostTruthPt = jet->auxdata< float >( "GhostTruthPt" );
+  m_jetGhostTruthPt -> Fill( ghostTruthPt/1e3, eventWeight );
+  float resolution = jet->pt()/ghostTruthPt - 1;
+  m_jetPt_vs_resolution -> Fill( jet->pt()/1e3, resolution, eventWeight );
+  m_jetGhostTruthPt_vs_resolution -> Fill( ghostTruthPt/1e3, resolution, eventWeight );
+  return StatusCode::SUCCESS;
+}
 
-  if(m_debug) std::cout << m_name << "::Matching tracks in Jet: " << m_infoSwitch->m_tracksInJet << std::endl;
+StatusCode JetHists::fillSubstructure( const xAOD::Jet* jet, float eventWeight, const xAOD::EventInfo* /*eventInfo*/ ) {
+  if(m_debug) std::cout << "JetHists: m_substructure " <<std::endl;
+  static SG::AuxElement::ConstAccessor<float> Tau1("Tau1");
+  static SG::AuxElement::ConstAccessor<float> Tau2("Tau2");
+  static SG::AuxElement::ConstAccessor<float> Tau3("Tau3");
+  static SG::AuxElement::ConstAccessor<float> Tau1_wta("Tau1_wta");
+  static SG::AuxElement::ConstAccessor<float> Tau2_wta("Tau2_wta");
+  static SG::AuxElement::ConstAccessor<float> Tau3_wta("Tau3_wta");
+
+  if(Tau1.isAvailable(*jet)) m_tau1->Fill( Tau1(*jet), eventWeight );
+  if(Tau2.isAvailable(*jet)) m_tau2->Fill( Tau2(*jet), eventWeight );
+  if(Tau3.isAvailable(*jet)) m_tau3->Fill( Tau3(*jet), eventWeight );
+  if(Tau1.isAvailable(*jet) && Tau2.isAvailable(*jet)) m_tau21->Fill( Tau2(*jet)/Tau1(*jet), eventWeight );
+  if(Tau2.isAvailable(*jet) && Tau3.isAvailable(*jet)) m_tau32->Fill( Tau3(*jet)/Tau2(*jet), eventWeight );
+  if(Tau1_wta.isAvailable(*jet)) m_tau1_wta->Fill( Tau1_wta(*jet), eventWeight );
+  if(Tau2_wta.isAvailable(*jet)) m_tau2_wta->Fill( Tau2_wta(*jet), eventWeight );
+  if(Tau3_wta.isAvailable(*jet)) m_tau3_wta->Fill( Tau3_wta(*jet), eventWeight );
+  if(Tau1_wta.isAvailable(*jet) && Tau2_wta.isAvailable(*jet)) m_tau21_wta->Fill( Tau2_wta(*jet)/Tau1_wta(*jet), eventWeight );
+  if(Tau2_wta.isAvailable(*jet) && Tau3_wta.isAvailable(*jet)) m_tau32_wta->Fill( Tau3_wta(*jet)/Tau2_wta(*jet), eventWeight );
+
+  m_numConstituents->Fill( jet->numConstituents(), eventWeight );
 
-  if( m_infoSwitch->m_tracksInJet ){
-    if(m_debug) std::cout << "JetHists: m_tracksInJet " <<std::endl;
-    const vector<const xAOD::TrackParticle*> matchedTracks = jet->auxdata< vector<const xAOD::TrackParticle*>  >(m_infoSwitch->m_trackName);
-    const xAOD::Vertex *pvx  = jet->auxdata<const xAOD::Vertex*>(m_infoSwitch->m_trackName+"_vtx");
+  return StatusCode::SUCCESS;
+}
 
-    m_nTrk->Fill(matchedTracks.size(), eventWeight);
 
-    if(m_debug) std::cout << "Track Size " << matchedTracks.size() << std::endl;
-    for(auto& trkPtr: matchedTracks){
-      ANA_CHECK( m_tracksInJet->execute(trkPtr, jet, pvx, eventWeight, eventInfo));
-    }
-  }
+StatusCode JetHists::fillTracksInJet( const xAOD::Jet* jet, float eventWeight, const xAOD::EventInfo* eventInfo ) {
+  using namespace msgJetHists;
+  if(m_debug) std::cout << "JetHists: m_tracksInJet " <<std::endl;
+  const vector<const xAOD::TrackParticle*> matchedTracks = jet->auxdata< vector<const xAOD::TrackParticle*>  >(m_infoSwitch->m_trackName);
+  const xAOD::Vertex *pvx  = jet->auxdata<const xAOD::Vertex*>(m_infoSwitch->m_trackName+"_vtx");
 
-  if(  m_infoSwitch->m_byEta ){
-    if (fabs(jet->eta()) < 1)           m_jetPt_eta_0_1   -> Fill(jet->pt()/1e3, eventWeight);
-    else if ( fabs(jet->eta()) < 2 ){   m_jetPt_eta_1_2   -> Fill(jet->pt()/1e3, eventWeight); m_jetPt_eta_1_2p5 -> Fill(jet->pt()/1e3, eventWeight);}
-    else if ( fabs(jet->eta()) < 2.5 ){ m_jetPt_eta_2_2p5 -> Fill(jet->pt()/1e3, eventWeight); m_jetPt_eta_1_2p5 -> Fill(jet->pt()/1e3, eventWeight);}
-  }
+  m_nTrk->Fill(matchedTracks.size(), eventWeight);
 
-  if(  m_infoSwitch->m_onlineBS ){
+  if(m_debug) std::cout << "Track Size " << matchedTracks.size() << std::endl;
+  ANA_CHECK( m_tracksInJet->execute(matchedTracks, jet, pvx, eventWeight, eventInfo));
+  return StatusCode::SUCCESS;
+}
 
-    float bs_online_vx = jet->auxdata< float >("bs_online_vx");
-    float bs_online_vy = jet->auxdata< float >("bs_online_vy");
-    float bs_online_vz = jet->auxdata< float >("bs_online_vz");
+StatusCode JetHists::fillByEta( const xAOD::Jet* jet, float eventWeight, const xAOD::EventInfo* /*eventInfo*/ ) {
+  if (fabs(jet->eta()) < 1)           m_jetPt_eta_0_1   -> Fill(jet->pt()/1e3, eventWeight);
+  else if ( fabs(jet->eta()) < 2 ){   m_jetPt_eta_1_2   -> Fill(jet->pt()/1e3, eventWeight); m_jetPt_eta_1_2p5 -> Fill(jet->pt()/1e3, eventWeight);}
+  else if ( fabs(jet->eta()) < 2.5 ){ m_jetPt_eta_2_2p5 -> Fill(jet->pt()/1e3, eventWeight); m_jetPt_eta_1_2p5 -> Fill(jet->pt()/1e3, eventWeight);}
+  return StatusCode::SUCCESS;
+}
 
-    if( m_infoSwitch->m_onlineBSTool ){
-      // Over-ride with onlineBSToolInfo
-      bs_online_vx = m_onlineBSTool.getOnlineBSInfo(eventInfo, xAH::OnlineBeamSpotTool::BSData::BSx);
-      bs_online_vy = m_onlineBSTool.getOnlineBSInfo(eventInfo, xAH::OnlineBeamSpotTool::BSData::BSy);
-      bs_online_vz = m_onlineBSTool.getOnlineBSInfo(eventInfo, xAH::OnlineBeamSpotTool::BSData::BSz);
-    }
+StatusCode JetHists::fillOnlineBS( const xAOD::Jet* jet, float eventWeight, const xAOD::EventInfo* eventInfo ) {
 
-    m_bs_online_vy -> Fill( bs_online_vy , eventWeight);
-    m_bs_online_vx -> Fill( bs_online_vx , eventWeight);
-    m_bs_online_vz   -> Fill( bs_online_vz , eventWeight);
-    m_bs_online_vz_l -> Fill( bs_online_vz , eventWeight);
+  float bs_online_vx = jet->auxdata< float >("bs_online_vx");
+  float bs_online_vy = jet->auxdata< float >("bs_online_vy");
+  float bs_online_vz = jet->auxdata< float >("bs_online_vz");
 
-    if (fabs(bs_online_vz) < 1)          { m_eta_bs_online_vz_0_1   -> Fill( jet->eta(), eventWeight); }
-    else if ( fabs(bs_online_vz) < 1.5 ) { m_eta_bs_online_vz_1_1p5 -> Fill( jet->eta(), eventWeight); }
-    else if ( fabs(bs_online_vz) < 2   ) { m_eta_bs_online_vz_1p5_2 -> Fill( jet->eta(), eventWeight); }
+  if( m_infoSwitch->m_onlineBSTool ){
+    // Over-ride with onlineBSToolInfo
+    bs_online_vx = m_onlineBSTool.getOnlineBSInfo(eventInfo, xAH::OnlineBeamSpotTool::BSData::BSx);
+    bs_online_vy = m_onlineBSTool.getOnlineBSInfo(eventInfo, xAH::OnlineBeamSpotTool::BSData::BSy);
+    bs_online_vz = m_onlineBSTool.getOnlineBSInfo(eventInfo, xAH::OnlineBeamSpotTool::BSData::BSz);
+  }
 
+  m_bs_online_vy -> Fill( bs_online_vy , eventWeight);
+  m_bs_online_vx -> Fill( bs_online_vx , eventWeight);
+  m_bs_online_vz   -> Fill( bs_online_vz , eventWeight);
+  m_bs_online_vz_l -> Fill( bs_online_vz , eventWeight);
 
+  if (fabs(bs_online_vz) < 1)          { m_eta_bs_online_vz_0_1   -> Fill( jet->eta(), eventWeight); }
+  else if ( fabs(bs_online_vz) < 1.5 ) { m_eta_bs_online_vz_1_1p5 -> Fill( jet->eta(), eventWeight); }
+  else if ( fabs(bs_online_vz) < 2   ) { m_eta_bs_online_vz_1p5_2 -> Fill( jet->eta(), eventWeight); }
 
-    if(m_infoSwitch->m_lumiB_runN){
-      uint32_t lumiBlock = eventInfo->lumiBlock();
-      uint32_t runNumber = eventInfo->runNumber();
 
-      if( fabs(bs_online_vz) < 900){
-	m_lumiB_runN_bs_online_vz -> Fill(lumiBlock, runNumber, eventWeight * bs_online_vz);
-	m_lumiB_runN_bs_den       -> Fill(lumiBlock, runNumber, eventWeight );
-      }
+  if(m_infoSwitch->m_lumiB_runN){
+    uint32_t lumiBlock = eventInfo->lumiBlock();
+    uint32_t runNumber = eventInfo->runNumber();
 
+    if( fabs(bs_online_vz) < 900){
+	fillSparse(m_lumiB_runN_bs_online_vz, lumiBlock, runNumber, eventWeight * bs_online_vz);
+	fillSparse(m_lumiB_runN_bs_den, lumiBlock, runNumber, eventWeight );
     }
+
   }
+  return StatusCode::SUCCESS;
+}
 
 
-  if( m_infoSwitch->m_hltVtxComp || m_infoSwitch->m_onlineBS ){
-    const xAOD::Vertex *online_pvx     = jet->auxdata<const xAOD::Vertex*>("HLTBJetTracks_vtx");
-    const xAOD::Vertex *online_pvx_bkg = jet->auxdata<const xAOD::Vertex*>("HLTBJetTracks_vtx_bkg");
-    const xAOD::Vertex *offline_pvx    = jet->auxdata<const xAOD::Vertex*>("offline_vtx");
+StatusCode JetHists::fillHLTVertex( const xAOD::Jet* jet, float eventWeight, const xAOD::EventInfo* eventInfo ) {
+  const xAOD::Vertex *online_pvx     = jet->auxdata<const xAOD::Vertex*>("HLTBJetTracks_vtx");
+  const xAOD::Vertex *online_pvx_bkg = jet->auxdata<const xAOD::Vertex*>("HLTBJetTracks_vtx_bkg");
+  const xAOD::Vertex *offline_pvx    = jet->auxdata<const xAOD::Vertex*>("offline_vtx");
 
-    // Use of vtxClass is new, hadDummyPV is old but need backward compatibility.
-    char vtxClass = jet->auxdata< char >("hadDummyPV");
-    int vtxClassInt = int(vtxClass);
+  // Use of vtxClass is new, hadDummyPV is old but need backward compatibility.
+  char vtxClass = jet->auxdata< char >("hadDummyPV");
+  int vtxClassInt = int(vtxClass);
 
-    if( vtxClass == '0')  vtxClassInt = 0;
-    if( vtxClass == '1')  vtxClassInt = 1;
-    if( vtxClass == '2')  vtxClassInt = 2;
+  if( vtxClass == '0')  vtxClassInt = 0;
+  if( vtxClass == '1')  vtxClassInt = 1;
+  if( vtxClass == '2')  vtxClassInt = 2;
 
-    m_vtxClass -> Fill(vtxClassInt, eventWeight);
+  m_vtxClass -> Fill(vtxClassInt, eventWeight);
 
-    if(m_infoSwitch->m_hltVtxComp){
+  if(m_infoSwitch->m_hltVtxComp){
 
-      if(online_pvx)  m_vtxOnlineValid ->Fill(1.0, eventWeight);
-      else            m_vtxOnlineValid ->Fill(0.0, eventWeight);
+    if(online_pvx)  m_vtxOnlineValid ->Fill(1.0, eventWeight);
+    else            m_vtxOnlineValid ->Fill(0.0, eventWeight);
 
-      if(offline_pvx) m_vtxOfflineValid->Fill(1.0, eventWeight);
-      else            m_vtxOfflineValid->Fill(0.0, eventWeight);
+    if(offline_pvx) m_vtxOfflineValid->Fill(1.0, eventWeight);
+    else            m_vtxOfflineValid->Fill(0.0, eventWeight);
 
 
-      //if(hadDummyPV)  m_vtxClass ->Fill(1.0, eventWeight);
-      //else            m_vtxClass ->Fill(0.0, eventWeight);
+    //if(hadDummyPV)  m_vtxClass ->Fill(1.0, eventWeight);
+    //else            m_vtxClass ->Fill(0.0, eventWeight);
 
-      if(offline_pvx && online_pvx && online_pvx_bkg){
+    if(offline_pvx && online_pvx && online_pvx_bkg){
 	float online_x0_raw = online_pvx->x();
 	float online_y0_raw = online_pvx->y();
 	float online_z0_raw = online_pvx->z();
@@ -1627,22 +1678,19 @@ StatusCode JetHists::execute( const xAOD::IParticle* particle, float eventWeight
 	if(m_infoSwitch->m_lumiB_runN){
 	  uint32_t lumiBlock = eventInfo->lumiBlock();
 	  uint32_t runNumber = eventInfo->runNumber();
-	  m_lumiB_runN              -> Fill(lumiBlock, runNumber, eventWeight);
-	  m_lumiB_runN_vtxClass     -> Fill(lumiBlock, runNumber, eventWeight * vtxClassInt);
-	  m_lumiB_runN_lumiB        -> Fill(lumiBlock, runNumber, eventWeight * lumiBlock);
+	  fillSparse(m_lumiB_runN, lumiBlock, runNumber, eventWeight);
+	  fillSparse(m_lumiB_runN_vtxClass, lumiBlock, runNumber, eventWeight * vtxClassInt);
+	  fillSparse(m_lumiB_runN_lumiB, lumiBlock, runNumber, eventWeight * lumiBlock);
 
 
 	//if(offline_pvx && online_pvx){
-        //  float vtxDiffz0     = online_pvx->z() - offline_pvx->z();
-	//  m_lumiB_runN_vtxDiffz0  -> Fill(lumiBlock, runNumber, eventWeight * vtxDiffz0);
+      //  float vtxDiffz0     = online_pvx->z() - offline_pvx->z();
+	//  fillSparse(m_lumiB_runN_vtxDiffz0, lumiBlock, runNumber, eventWeight * vtxDiffz0);
 	//}
 
 	}
-      }
     }
   }
-
-  if(m_debug) std::cout << "JetHists: leave " <<std::endl;
   return StatusCode::SUCCESS;
 }
 
@@ -1714,7 +1762,6 @@ StatusCode JetHists::execute( const xAH::Particle* particle, float eventWeight,
     }
 
 
-
   if(m_infoSwitch->m_trackPV || m_infoSwitch->m_trackAll)
     {
 //      m_Jvt       ->Fill(jet->Jvt        , eventWeight);
@@ -1730,16 +1777,16 @@ StatusCode JetHists::execute( const xAH::Particle* particle, float eventWeight,
 
   if(m_infoSwitch->m_flavorTag || m_infoSwitch->m_flavorTagHLT)
     {
-//      h_SV0                       ->Fill(jet->SV0                  , eventWeight);
-//      h_SV1                       ->Fill(jet->SV1                  , eventWeight);
-//      h_IP3D                      ->Fill(jet->IP3D                 , eventWeight);
+//      h_SV0                       ->Fill(jet->flavorTag->SV0                  , eventWeight);
+//      h_SV1                       ->Fill(jet->flavorTag->SV1                  , eventWeight);
+//      h_IP3D                      ->Fill(jet->flavorTag->IP3D                 , eventWeight);
 
-      float MV2c10 = jet->MV2c10;
+      float MV2c10 = jet->flavorTag->MV2c10;
 
-      m_MV2c00                    ->Fill(jet->MV2c00               , eventWeight);
-      m_MV2c10                    ->Fill(jet->MV2c10               , eventWeight);
-      m_MV2c10_l                  ->Fill(jet->MV2c10               , eventWeight);
-      m_MV2c20                    ->Fill(jet->MV2c20               , eventWeight);
+      m_MV2c00                    ->Fill(jet->flavorTag->MV2c00               , eventWeight);
+      m_MV2c10                    ->Fill(jet->flavorTag->MV2c10               , eventWeight);
+      m_MV2c10_l                  ->Fill(jet->flavorTag->MV2c10               , eventWeight);
+      m_MV2c20                    ->Fill(jet->flavorTag->MV2c20               , eventWeight);
 
       //      h_MV2                       ->Fill(jet->MV2                  , eventWeight);
 
@@ -1787,11 +1834,11 @@ StatusCode JetHists::execute( const xAH::Particle* particle, float eventWeight,
       }
 
 
-      m_COMB                      ->Fill(jet->SV1IP3D              , eventWeight);
+      m_COMB                      ->Fill(jet->flavorTag->SV1IP3D              , eventWeight);
       //m_JetFitter               ->Fill(jet->JetFitter            , eventWeight);
 
 //
-//      h_IP3DvsMV2c20->Fill(jet->MV2c20, jet->IP3D);
+//      h_IP3DvsMV2c20->Fill(jet->flavorTag->MV2c20, jet->flavorTag->IP3D);
 
     }
 
@@ -1803,9 +1850,9 @@ StatusCode JetHists::execute( const xAH::Particle* particle, float eventWeight,
 
   if(  m_infoSwitch->m_onlineBS ){
 
-      float bs_online_vx = jet->bs_online_vx;
-      float bs_online_vy = jet->bs_online_vy;
-      float bs_online_vz = jet->bs_online_vz;
+      float bs_online_vx = jet->flavorTag->bs_online_vx;
+      float bs_online_vy = jet->flavorTag->bs_online_vy;
+      float bs_online_vz = jet->flavorTag->bs_online_vz;
 
       if( m_infoSwitch->m_onlineBSTool ){
 	// Over-ride with onlineBSToolInfo
@@ -1829,8 +1876,8 @@ StatusCode JetHists::execute( const xAH::Particle* particle, float eventWeight,
 	uint32_t lumiBlock = eventInfo->m_lumiBlock;
 	uint32_t runNumber = eventInfo->m_runNumber;
 	if( fabs(bs_online_vz) < 900 ){
-	    m_lumiB_runN_bs_online_vz  -> Fill(lumiBlock, runNumber, eventWeight * bs_online_vz);
-	    m_lumiB_runN_bs_den        -> Fill(lumiBlock, runNumber, eventWeight );
+	    fillSparse(m_lumiB_runN_bs_online_vz, lumiBlock, runNumber, eventWeight * bs_online_vz);
+	    fillSparse(m_lumiB_runN_bs_den, lumiBlock, runNumber, eventWeight );
 	}
 
 
@@ -1841,15 +1888,15 @@ StatusCode JetHists::execute( const xAH::Particle* particle, float eventWeight,
     {
 
       // vtxHadDummy is an old var. I am moving to a new variable name here.
-      float vtxClass=jet->vtxHadDummy;
+      float vtxClass=jet->flavorTag->vtxHadDummy;
 
       m_vtxClass               ->Fill(vtxClass          , eventWeight);
 
       if(m_infoSwitch->m_hltVtxComp){
 
-	float online_x0_raw = jet->vtx_online_x0;
-	float online_y0_raw = jet->vtx_online_y0;
-	float online_z0_raw = jet->vtx_online_z0;
+	float online_x0_raw = jet->flavorTag->vtx_online_x0;
+	float online_y0_raw = jet->flavorTag->vtx_online_y0;
+	float online_z0_raw = jet->flavorTag->vtx_online_z0;
 	if(vtxClass){
 	  online_x0_raw = 0;
 	  online_y0_raw = 0;
@@ -1861,50 +1908,50 @@ StatusCode JetHists::execute( const xAH::Particle* particle, float eventWeight,
 	//   std::cout << " -> bs_online_vx" << bs_online_vx << "bs_online_vy" << bs_online_vy << "bs_online_vz" << bs_online_vz << std::endl;
 	//}
 
-	float vtxDiffx0      = jet->vtx_online_x0 - jet->vtx_offline_x0;
+	float vtxDiffx0      = jet->flavorTag->vtx_online_x0 - jet->flavorTag->vtx_offline_x0;
 
-	m_vtx_offline_x0             ->Fill(jet->vtx_offline_x0 , eventWeight);
-	m_vtx_online_x0             ->Fill(jet->vtx_online_x0 , eventWeight);
+	m_vtx_offline_x0             ->Fill(jet->flavorTag->vtx_offline_x0 , eventWeight);
+	m_vtx_online_x0             ->Fill(jet->flavorTag->vtx_online_x0 , eventWeight);
 	m_vtx_online_x0_raw         ->Fill(online_x0_raw      , eventWeight);
 	m_vtxDiffx0                 ->Fill(vtxDiffx0          , eventWeight);
 	m_vtxDiffx0_l               ->Fill(vtxDiffx0          , eventWeight);
 
-	m_vtx_offline_y0             ->Fill(jet->vtx_offline_y0 , eventWeight);
-	m_vtx_online_y0             ->Fill(jet->vtx_online_y0 , eventWeight);
+	m_vtx_offline_y0             ->Fill(jet->flavorTag->vtx_offline_y0 , eventWeight);
+	m_vtx_online_y0             ->Fill(jet->flavorTag->vtx_online_y0 , eventWeight);
 	m_vtx_online_y0_raw         ->Fill(online_y0_raw      , eventWeight);
-	float vtxDiffy0 = jet->vtx_online_y0 - jet->vtx_offline_y0;
+	float vtxDiffy0 = jet->flavorTag->vtx_online_y0 - jet->flavorTag->vtx_offline_y0;
 	m_vtxDiffy0                 ->Fill(vtxDiffy0          , eventWeight);
 	m_vtxDiffy0_l               ->Fill(vtxDiffy0          , eventWeight);
 
-	m_vtx_offline_z0             ->Fill(jet->vtx_offline_z0 , eventWeight);
-	m_vtx_online_z0              ->Fill(jet->vtx_online_z0 , eventWeight);
-	m_vtx_offline_z0_s           ->Fill(jet->vtx_offline_z0 , eventWeight);
-	m_vtx_online_z0_s            ->Fill(jet->vtx_online_z0 , eventWeight);
+	m_vtx_offline_z0             ->Fill(jet->flavorTag->vtx_offline_z0 , eventWeight);
+	m_vtx_online_z0              ->Fill(jet->flavorTag->vtx_online_z0 , eventWeight);
+	m_vtx_offline_z0_s           ->Fill(jet->flavorTag->vtx_offline_z0 , eventWeight);
+	m_vtx_online_z0_s            ->Fill(jet->flavorTag->vtx_online_z0 , eventWeight);
 	m_vtx_online_z0_raw          ->Fill(online_z0_raw      , eventWeight);
-	float vtxDiffz0     = jet->vtx_online_z0  - jet->vtx_offline_z0;
-	float vtxDiffz0_raw = online_z0_raw       - jet->vtx_offline_z0;
+	float vtxDiffz0     = jet->flavorTag->vtx_online_z0  - jet->flavorTag->vtx_offline_z0;
+	float vtxDiffz0_raw = online_z0_raw       - jet->flavorTag->vtx_offline_z0;
 	m_vtxDiffz0                 ->Fill(vtxDiffz0          , eventWeight);
 	m_vtxDiffz0_m               ->Fill(vtxDiffz0          , eventWeight);
 	m_vtxDiffz0_s               ->Fill(vtxDiffz0          , eventWeight);
-	//m_vtx_offline_z                 ->Fill(jet->vtx_offline_z0          , eventWeight);
-	//m_vtx_online_z                 ->Fill(jet->vtx_online_z0          , eventWeight);
+	//m_vtx_offline_z                 ->Fill(jet->flavorTag->vtx_offline_z0          , eventWeight);
+	//m_vtx_online_z                 ->Fill(jet->flavorTag->vtx_online_z0          , eventWeight);
 
 
-	float vtxBkgDiffz0     = jet->vtx_online_bkg_z0  - jet->vtx_offline_z0;
+	float vtxBkgDiffz0     = jet->flavorTag->vtx_online_bkg_z0  - jet->flavorTag->vtx_offline_z0;
 	m_vtxBkgDiffz0                 ->Fill(vtxBkgDiffz0          , eventWeight);
 	m_vtxBkgDiffz0_m               ->Fill(vtxBkgDiffz0          , eventWeight);
 	m_vtxBkgDiffz0_s               ->Fill(vtxBkgDiffz0          , eventWeight);
 
 
-	m_vtxDiffz0_s_vs_vtx_offline_z0->Fill(jet->vtx_offline_z0, vtxDiffz0, eventWeight);
-	m_vtxDiffz0_vs_vtx_offline_z0  ->Fill(jet->vtx_offline_z0, vtxDiffz0, eventWeight);
+	m_vtxDiffz0_s_vs_vtx_offline_z0->Fill(jet->flavorTag->vtx_offline_z0, vtxDiffz0, eventWeight);
+	m_vtxDiffz0_vs_vtx_offline_z0  ->Fill(jet->flavorTag->vtx_offline_z0, vtxDiffz0, eventWeight);
 	m_vtxDiffz0_s_vs_vtxDiffx0      ->Fill(vtxDiffx0, vtxDiffz0, eventWeight);
 	m_vtxDiffz0_s_vs_vtxDiffy0      ->Fill(vtxDiffy0, vtxDiffz0, eventWeight);
 
 	m_vtxClass_vs_jetPt   ->Fill(jet->p4.Pt(), vtxClass,    eventWeight);
 
-	m_vtx_online_y0_vs_vtx_online_z0 ->Fill(jet->vtx_online_z0, jet->vtx_online_y0, eventWeight);
-	m_vtx_online_x0_vs_vtx_online_z0 ->Fill(jet->vtx_online_z0, jet->vtx_online_x0, eventWeight);
+	m_vtx_online_y0_vs_vtx_online_z0 ->Fill(jet->flavorTag->vtx_online_z0, jet->flavorTag->vtx_online_y0, eventWeight);
+	m_vtx_online_x0_vs_vtx_online_z0 ->Fill(jet->flavorTag->vtx_online_z0, jet->flavorTag->vtx_online_x0, eventWeight);
 
 	if(m_infoSwitch->m_vsLumiBlock && eventInfo){
 	  uint32_t lumiBlock = eventInfo->m_lumiBlock;
@@ -1934,9 +1981,9 @@ StatusCode JetHists::execute( const xAH::Particle* particle, float eventWeight,
 	if(m_infoSwitch->m_lumiB_runN){
 	  uint32_t lumiBlock = eventInfo->m_lumiBlock;
 	  uint32_t runNumber = eventInfo->m_runNumber;
-	  m_lumiB_runN               -> Fill(lumiBlock, runNumber, eventWeight);
-	  m_lumiB_runN_vtxClass      -> Fill(lumiBlock, runNumber, eventWeight * vtxClass);
-	  m_lumiB_runN_lumiB      -> Fill(lumiBlock, runNumber, eventWeight*lumiBlock);
+	  fillSparse(m_lumiB_runN, lumiBlock, runNumber, eventWeight);
+	  fillSparse(m_lumiB_runN_vtxClass, lumiBlock, runNumber, eventWeight * vtxClass);
+	  fillSparse(m_lumiB_runN_lumiB, lumiBlock, runNumber, eventWeight*lumiBlock);
 
 	}
 
@@ -1946,52 +1993,52 @@ StatusCode JetHists::execute( const xAH::Particle* particle, float eventWeight,
 
   if(m_infoSwitch->m_jetFitterDetails){
 
-    m_jf_nVTX           ->Fill(jet->JetFitter_nVTX           ,      eventWeight);
-    m_jf_nSingleTracks  ->Fill(jet->JetFitter_nSingleTracks  ,      eventWeight);
-    m_jf_nTracksAtVtx   ->Fill(jet->JetFitter_nTracksAtVtx   ,      eventWeight);
-    m_jf_mass           ->Fill(jet->JetFitter_mass           /1000, eventWeight);
-    m_jf_energyFraction ->Fill(jet->JetFitter_energyFraction ,      eventWeight);
-    m_jf_significance3d ->Fill(jet->JetFitter_significance3d ,      eventWeight);
-    m_jf_deltaeta       ->Fill(jet->JetFitter_deltaeta       ,      eventWeight);
-    m_jf_deltaeta_l     ->Fill(jet->JetFitter_deltaeta       ,      eventWeight);
-    m_jf_deltaR         ->Fill(hypot(jet->JetFitter_deltaphi         ,jet->JetFitter_deltaeta), eventWeight);
-    m_jf_deltaphi       ->Fill(jet->JetFitter_deltaphi       ,      eventWeight);
-    m_jf_deltaphi_l     ->Fill(jet->JetFitter_deltaphi       ,      eventWeight);
-    m_jf_N2Tpar         ->Fill(jet->JetFitter_N2Tpar         ,      eventWeight);
+    m_jf_nVTX           ->Fill(jet->flavorTag->JetFitter_nVTX           ,      eventWeight);
+    m_jf_nSingleTracks  ->Fill(jet->flavorTag->JetFitter_nSingleTracks  ,      eventWeight);
+    m_jf_nTracksAtVtx   ->Fill(jet->flavorTag->JetFitter_nTracksAtVtx   ,      eventWeight);
+    m_jf_mass           ->Fill(jet->flavorTag->JetFitter_mass           /1000, eventWeight);
+    m_jf_energyFraction ->Fill(jet->flavorTag->JetFitter_energyFraction ,      eventWeight);
+    m_jf_significance3d ->Fill(jet->flavorTag->JetFitter_significance3d ,      eventWeight);
+    m_jf_deltaeta       ->Fill(jet->flavorTag->JetFitter_deltaeta       ,      eventWeight);
+    m_jf_deltaeta_l     ->Fill(jet->flavorTag->JetFitter_deltaeta       ,      eventWeight);
+    m_jf_deltaR         ->Fill(hypot(jet->flavorTag->JetFitter_deltaphi         ,jet->flavorTag->JetFitter_deltaeta), eventWeight);
+    m_jf_deltaphi       ->Fill(jet->flavorTag->JetFitter_deltaphi       ,      eventWeight);
+    m_jf_deltaphi_l     ->Fill(jet->flavorTag->JetFitter_deltaphi       ,      eventWeight);
+    m_jf_N2Tpar         ->Fill(jet->flavorTag->JetFitter_N2Tpar         ,      eventWeight);
   }
 
   if(m_infoSwitch->m_svDetails){
     //
     // SV0
     //
-    m_sv0_NGTinSvx -> Fill( jet->sv0_NGTinSvx, eventWeight);
-    m_sv0_N2Tpair  -> Fill( jet->sv0_N2Tpair , eventWeight);
-    m_sv0_massvx   -> Fill( jet->sv0_massvx  /1000, eventWeight);
-    m_sv0_efracsvx -> Fill( jet->sv0_efracsvx, eventWeight);
-    m_sv0_normdist -> Fill( jet->sv0_normdist, eventWeight);
+    m_sv0_NGTinSvx -> Fill( jet->flavorTag->sv0_NGTinSvx, eventWeight);
+    m_sv0_N2Tpair  -> Fill( jet->flavorTag->sv0_N2Tpair , eventWeight);
+    m_sv0_massvx   -> Fill( jet->flavorTag->sv0_massvx  /1000, eventWeight);
+    m_sv0_efracsvx -> Fill( jet->flavorTag->sv0_efracsvx, eventWeight);
+    m_sv0_normdist -> Fill( jet->flavorTag->sv0_normdist, eventWeight);
 
     //
     // SV1
     //
-    m_sv1_NGTinSvx -> Fill( jet->sv1_NGTinSvx, eventWeight);
-    m_sv1_N2Tpair  -> Fill( jet->sv1_N2Tpair , eventWeight);
-    m_sv1_massvx   -> Fill( jet->sv1_massvx  /1000, eventWeight);
-    m_sv1_efracsvx -> Fill( jet->sv1_efracsvx, eventWeight);
-    m_sv1_normdist -> Fill( jet->sv1_normdist, eventWeight);
+    m_sv1_NGTinSvx -> Fill( jet->flavorTag->sv1_NGTinSvx, eventWeight);
+    m_sv1_N2Tpair  -> Fill( jet->flavorTag->sv1_N2Tpair , eventWeight);
+    m_sv1_massvx   -> Fill( jet->flavorTag->sv1_massvx  /1000, eventWeight);
+    m_sv1_efracsvx -> Fill( jet->flavorTag->sv1_efracsvx, eventWeight);
+    m_sv1_normdist -> Fill( jet->flavorTag->sv1_normdist, eventWeight);
 
 
-    m_SV1_pu         ->  Fill(jet->sv1_pu  , eventWeight );
-    m_SV1_pb         ->  Fill(jet->sv1_pb  , eventWeight );
-    m_SV1_pc         ->  Fill(jet->sv1_pc  , eventWeight );
+    m_SV1_pu         ->  Fill(jet->flavorTag->sv1_pu  , eventWeight );
+    m_SV1_pb         ->  Fill(jet->flavorTag->sv1_pb  , eventWeight );
+    m_SV1_pc         ->  Fill(jet->flavorTag->sv1_pc  , eventWeight );
 
-    m_SV1_c          ->  Fill(jet->sv1_c  , eventWeight );
-    m_SV1_cu         ->  Fill(jet->sv1_cu , eventWeight );
+    m_SV1_c          ->  Fill(jet->flavorTag->sv1_c  , eventWeight );
+    m_SV1_cu         ->  Fill(jet->flavorTag->sv1_cu , eventWeight );
 
-    m_SV1_Lxy        -> Fill(jet->sv1_Lxy,         eventWeight);
-    m_SV1_sig3d      -> Fill(jet->sv1_sig3d,       eventWeight);
-    m_SV1_L3d        -> Fill(jet->sv1_L3d,         eventWeight);
-    m_SV1_distmatlay -> Fill(jet->sv1_distmatlay,  eventWeight);
-    m_SV1_dR         -> Fill(jet->sv1_dR,          eventWeight);
+    m_SV1_Lxy        -> Fill(jet->flavorTag->sv1_Lxy,         eventWeight);
+    m_SV1_sig3d      -> Fill(jet->flavorTag->sv1_sig3d,       eventWeight);
+    m_SV1_L3d        -> Fill(jet->flavorTag->sv1_L3d,         eventWeight);
+    m_SV1_distmatlay -> Fill(jet->flavorTag->sv1_distmatlay,  eventWeight);
+    m_SV1_dR         -> Fill(jet->flavorTag->sv1_dR,          eventWeight);
 
   }
 
@@ -2000,14 +2047,14 @@ StatusCode JetHists::execute( const xAH::Particle* particle, float eventWeight,
     //
     // IP2D
     //
-    m_nIP2DTracks -> Fill( jet->nIP2DTracks, eventWeight);
-    for(float grade : jet->IP2D_gradeOfTracks)        m_IP2D_gradeOfTracks->Fill(grade, eventWeight);
-    for(float flag  : jet->IP2D_flagFromV0ofTracks)   m_IP2D_flagFromV0ofTracks->Fill(flag, eventWeight);
-
-    if(jet->IP2D_sigD0wrtPVofTracks.size()  == jet->IP2D_valD0wrtPVofTracks.size()){
-      for(unsigned int i=0; i<jet->IP2D_sigD0wrtPVofTracks.size(); i++){
-	float d0Sig=jet->IP2D_sigD0wrtPVofTracks[i];
-	float d0Val=jet->IP2D_valD0wrtPVofTracks[i];
+    m_nIP2DTracks -> Fill( jet->flavorTag->nIP2DTracks, eventWeight);
+    for(float grade : jet->flavorTag->IP2D_gradeOfTracks)        m_IP2D_gradeOfTracks->Fill(grade, eventWeight);
+    for(float flag  : jet->flavorTag->IP2D_flagFromV0ofTracks)   m_IP2D_flagFromV0ofTracks->Fill(flag, eventWeight);
+
+    if(jet->flavorTag->IP2D_sigD0wrtPVofTracks.size()  == jet->flavorTag->IP2D_valD0wrtPVofTracks.size()){
+      for(unsigned int i=0; i<jet->flavorTag->IP2D_sigD0wrtPVofTracks.size(); i++){
+	float d0Sig=jet->flavorTag->IP2D_sigD0wrtPVofTracks[i];
+	float d0Val=jet->flavorTag->IP2D_valD0wrtPVofTracks[i];
 	float d0Err=d0Val/d0Sig;
 	m_IP2D_errD0wrtPVofTracks->Fill  (d0Err, eventWeight);
 	m_IP2D_sigD0wrtPVofTracks->Fill  (d0Sig, eventWeight);
@@ -2016,30 +2063,30 @@ StatusCode JetHists::execute( const xAH::Particle* particle, float eventWeight,
       }
     }
 
-    for(float weightB : jet->IP2D_weightBofTracks)  m_IP2D_weightBofTracks->Fill(weightB, eventWeight);
-    for(float weightC : jet->IP2D_weightCofTracks)  m_IP2D_weightCofTracks->Fill(weightC, eventWeight);
-    for(float weightU : jet->IP2D_weightUofTracks)  m_IP2D_weightUofTracks->Fill(weightU, eventWeight);
+    for(float weightB : jet->flavorTag->IP2D_weightBofTracks)  m_IP2D_weightBofTracks->Fill(weightB, eventWeight);
+    for(float weightC : jet->flavorTag->IP2D_weightCofTracks)  m_IP2D_weightCofTracks->Fill(weightC, eventWeight);
+    for(float weightU : jet->flavorTag->IP2D_weightUofTracks)  m_IP2D_weightUofTracks->Fill(weightU, eventWeight);
 
 
-    m_IP2D_pu         ->  Fill(jet->IP2D_pu  , eventWeight );
-    m_IP2D_pb         ->  Fill(jet->IP2D_pb  , eventWeight );
-    m_IP2D_pc         ->  Fill(jet->IP2D_pc  , eventWeight );
+    m_IP2D_pu         ->  Fill(jet->flavorTag->IP2D_pu  , eventWeight );
+    m_IP2D_pb         ->  Fill(jet->flavorTag->IP2D_pb  , eventWeight );
+    m_IP2D_pc         ->  Fill(jet->flavorTag->IP2D_pc  , eventWeight );
 
-    m_IP2D            ->  Fill( jet->IP2D    , eventWeight );
-    m_IP2D_c          ->  Fill( jet->IP2D_c  , eventWeight );
-    m_IP2D_cu         ->  Fill( jet->IP2D_cu , eventWeight );
+    m_IP2D            ->  Fill( jet->flavorTag->IP2D    , eventWeight );
+    m_IP2D_c          ->  Fill( jet->flavorTag->IP2D_c  , eventWeight );
+    m_IP2D_cu         ->  Fill( jet->flavorTag->IP2D_cu , eventWeight );
 
 
     //
     // IP3D
     //
-    m_nIP3DTracks -> Fill( jet->nIP3DTracks, eventWeight);
-    for(float grade : jet->IP3D_gradeOfTracks     )   m_IP3D_gradeOfTracks->Fill(grade, eventWeight);
-    for(float flag  : jet->IP3D_flagFromV0ofTracks)   m_IP3D_flagFromV0ofTracks->Fill(flag, eventWeight);
+    m_nIP3DTracks -> Fill( jet->flavorTag->nIP3DTracks, eventWeight);
+    for(float grade : jet->flavorTag->IP3D_gradeOfTracks     )   m_IP3D_gradeOfTracks->Fill(grade, eventWeight);
+    for(float flag  : jet->flavorTag->IP3D_flagFromV0ofTracks)   m_IP3D_flagFromV0ofTracks->Fill(flag, eventWeight);
 
-    for(unsigned int i=0; i<jet->IP3D_sigD0wrtPVofTracks.size(); i++){
-      float d0Sig=jet->IP3D_sigD0wrtPVofTracks[i];
-      float d0Val=jet->IP3D_valD0wrtPVofTracks[i];
+    for(unsigned int i=0; i<jet->flavorTag->IP3D_sigD0wrtPVofTracks.size(); i++){
+      float d0Sig=jet->flavorTag->IP3D_sigD0wrtPVofTracks[i];
+      float d0Val=jet->flavorTag->IP3D_valD0wrtPVofTracks[i];
       float d0Err=d0Val/d0Sig;
       m_IP3D_errD0wrtPVofTracks->Fill  (d0Err, eventWeight);
       m_IP3D_sigD0wrtPVofTracks->Fill  (d0Sig, eventWeight);
@@ -2047,9 +2094,9 @@ StatusCode JetHists::execute( const xAH::Particle* particle, float eventWeight,
       m_IP3D_valD0wrtPVofTracks->Fill  (d0Val, eventWeight);
     }
 
-    for(unsigned int i=0; i<jet->IP3D_sigZ0wrtPVofTracks.size(); i++){
-      float z0Sig=jet->IP3D_sigZ0wrtPVofTracks[i];
-      float z0Val=jet->IP3D_valZ0wrtPVofTracks[i];
+    for(unsigned int i=0; i<jet->flavorTag->IP3D_sigZ0wrtPVofTracks.size(); i++){
+      float z0Sig=jet->flavorTag->IP3D_sigZ0wrtPVofTracks[i];
+      float z0Val=jet->flavorTag->IP3D_valZ0wrtPVofTracks[i];
       float z0Err=z0Val/z0Sig;
       m_IP3D_errZ0wrtPVofTracks->Fill  (z0Err, eventWeight);
       m_IP3D_sigZ0wrtPVofTracks->Fill  (z0Sig, eventWeight);
@@ -2057,23 +2104,21 @@ StatusCode JetHists::execute( const xAH::Particle* particle, float eventWeight,
       m_IP3D_valZ0wrtPVofTracks->Fill  (z0Val, eventWeight);
     }
 
-    for(float weightB : jet->IP3D_weightBofTracks)  m_IP3D_weightBofTracks->Fill(weightB, eventWeight);
-    for(float weightC : jet->IP3D_weightCofTracks)  m_IP3D_weightCofTracks->Fill(weightC, eventWeight);
-    for(float weightU : jet->IP3D_weightUofTracks)  m_IP3D_weightUofTracks->Fill(weightU, eventWeight);
+    for(float weightB : jet->flavorTag->IP3D_weightBofTracks)  m_IP3D_weightBofTracks->Fill(weightB, eventWeight);
+    for(float weightC : jet->flavorTag->IP3D_weightCofTracks)  m_IP3D_weightCofTracks->Fill(weightC, eventWeight);
+    for(float weightU : jet->flavorTag->IP3D_weightUofTracks)  m_IP3D_weightUofTracks->Fill(weightU, eventWeight);
 
-    m_IP3D_pu         ->  Fill(jet->IP3D_pu  , eventWeight );
-    m_IP3D_pb         ->  Fill(jet->IP3D_pb  , eventWeight );
-    m_IP3D_pc         ->  Fill(jet->IP3D_pc  , eventWeight );
+    m_IP3D_pu         ->  Fill(jet->flavorTag->IP3D_pu  , eventWeight );
+    m_IP3D_pb         ->  Fill(jet->flavorTag->IP3D_pb  , eventWeight );
+    m_IP3D_pc         ->  Fill(jet->flavorTag->IP3D_pc  , eventWeight );
 
-    m_IP3D            ->  Fill( jet->IP3D   , eventWeight );
-    m_IP3D_c          ->  Fill( jet->IP3D_c , eventWeight );
-    m_IP3D_cu         ->  Fill( jet->IP3D_cu, eventWeight );
+    m_IP3D            ->  Fill( jet->flavorTag->IP3D   , eventWeight );
+    m_IP3D_c          ->  Fill( jet->flavorTag->IP3D_c , eventWeight );
+    m_IP3D_cu         ->  Fill( jet->flavorTag->IP3D_cu, eventWeight );
 
   }
 
 
-
-
   // truth
   if(m_infoSwitch->m_truth)
     {
@@ -2084,7 +2129,7 @@ StatusCode JetHists::execute( const xAH::Particle* particle, float eventWeight,
       m_truthDr_T->Fill(jet->TruthLabelDeltaR_T, eventWeight);
       //m_PartonTruthLabelID->Fill(jet->PartonTruthLabelID, eventWeight);
       //m_GhostTruthAssociationFraction->Fill(jet->GhostTruthAssociationFraction, eventWeight);
-      m_hadronConeExclTruthLabelID->Fill(jet->HadronConeExclTruthLabelID, eventWeight);
+      m_hadronConeExclTruthLabelID->Fill(jet->flavorTag->HadronConeExclTruthLabelID, eventWeight);
 
       m_truthPt   ->Fill(jet->truth_p4.Pt(),  eventWeight);
       //m_truth_pt_m ->Fill(jet->truth_p4.Pt(),  eventWeight);
@@ -2102,7 +2147,6 @@ StatusCode JetHists::execute( const xAH::Particle* particle, float eventWeight,
     }
 
 
-
   if(m_infoSwitch->m_byAverageMu)
     {
 
@@ -2140,6 +2184,7 @@ StatusCode JetHists::finalize() {
     if(m_tracksInJet){
         m_tracksInJet->finalize();
         delete m_tracksInJet;
+        m_tracksInJet = nullptr;
     }
     return IParticleHists::finalize();
 }
@@ -2,6 +2,7 @@
 #include <iostream>
 #include <typeinfo>
 #include <sstream>
+#include <algorithm>
 
 // EL include(s):
 #include <EventLoop/Job.h>
@@ -23,6 +24,8 @@
 #include "xAODAnaHelpers/JetSelector.h"
 #include "xAODAnaHelpers/HelperClasses.h"
 #include "xAODAnaHelpers/HelperFunctions.h"
+#include "xAODAnaHelpers/SelectionFlags.h"
+#include "xAODAnaHelpers/TrigMatchBits.h"
 
 // external tools include(s):
 #include "JetJvtEfficiency/JetJvtEfficiency.h"
@@ -39,6 +42,8 @@
 // this is needed to distribute the algorithm to the workers
 ClassImp(JetSelector)
 
+std::map< std::pair<std::string, std::string>, JetSelector* > JetSelector::s_fusedSelectors;
+
 
 JetSelector :: JetSelector () :
     Algorithm("JetSelector")
@@ -121,6 +126,11 @@ EL::StatusCode JetSelector :: initialize ()
   m_event = wk()->xaodEvent();
   m_store = wk()->xaodStore();
 
+  ANA_CHECK( m_eventInfoHandle.initialize(m_eventInfoContainerName, m_event, m_store) );
+  ANA_CHECK( m_vertexHandle.initialize(m_vertexContainerName, m_event, m_store) );
+  ANA_CHECK( m_inJetsHandle.initialize(m_inContainerName, m_event, m_store) );
+  ANA_CHECK( m_truthJetsHandle.initialize(m_truthJetContainer, m_event, m_store) );
+
   if ( m_useCutFlow ) {
 
    // retrieve the file in which the cutflow hists are stored
@@ -221,15 +231,17 @@ EL::StatusCode JetSelector :: initialize ()
     // initialize the BJetSelectionTool
     // A few which are not configurable as of yet....
     // is there a reason to have this configurable here??...I think no (GF to self)
-    ANA_CHECK( m_BJetSelectTool_handle.setProperty("MaxEta",m_b_eta_max));
-    ANA_CHECK( m_BJetSelectTool_handle.setProperty("MinPt",m_b_pt_min));
-    ANA_CHECK( m_BJetSelectTool_handle.setProperty("FlvTagCutDefinitionsFileName", m_corrFileName));
-    // configurable parameters
-    ANA_CHECK( m_BJetSelectTool_handle.setProperty("TaggerName",	      m_taggerName));
-    ANA_CHECK( m_BJetSelectTool_handle.setProperty("OperatingPoint",      m_operatingPt));
-    ANA_CHECK( m_BJetSelectTool_handle.setProperty("JetAuthor",	      m_jetAuthor));
-    ANA_CHECK( m_BJetSelectTool_handle.setProperty("OutputLevel",  msg().level()));
-    ANA_CHECK( m_BJetSelectTool_handle.retrieve());
+    ANA_CHECK( retrieveSharedTool(m_BJetSelectTool_handle, toolConfig(m_b_eta_max, m_b_pt_min, m_corrFileName, m_taggerName, m_operatingPt, m_jetAuthor), [&]() -> StatusCode {
+      ANA_CHECK( m_BJetSelectTool_handle.setProperty("MaxEta",m_b_eta_max));
+      ANA_CHECK( m_BJetSelectTool_handle.setProperty("MinPt",m_b_pt_min));
+      ANA_CHECK( m_BJetSelectTool_handle.setProperty("FlvTagCutDefinitionsFileName", m_corrFileName));
+      // configurable parameters
+      ANA_CHECK( m_BJetSelectTool_handle.setProperty("TaggerName",	      m_taggerName));
+      ANA_CHECK( m_BJetSelectTool_handle.setProperty("OperatingPoint",      m_operatingPt));
+      ANA_CHECK( m_BJetSelectTool_handle.setProperty("JetAuthor",	      m_jetAuthor));
+      ANA_CHECK( m_BJetSelectTool_handle.setProperty("OutputLevel",  msg().level()));
+      return m_BJetSelectTool_handle.retrieve();
+    }));
     ANA_MSG_DEBUG("Retrieved tool: " << m_BJetSelectTool_handle);
 
   }
@@ -238,12 +250,14 @@ EL::StatusCode JetSelector :: initialize ()
   if (m_dofJVT) {
     // initialize the CP::JetJvtEfficiency Tool for fJVT
     ANA_CHECK( ASG_MAKE_ANA_TOOL(m_fJVT_eff_tool_handle, CP::JetJvtEfficiency));
-    ANA_CHECK( m_fJVT_eff_tool_handle.setProperty("WorkingPoint", m_WorkingPointfJVT ));
-    ANA_CHECK( m_fJVT_eff_tool_handle.setProperty("SFFile",       m_SFFilefJVT ));
-    ANA_CHECK( m_fJVT_eff_tool_handle.setProperty("UseMuSFFormat",       m_UseMuSFFormatfJVT ));
-    ANA_CHECK( m_fJVT_eff_tool_handle.setProperty("ScaleFactorDecorationName", "fJVTSF"));
-    ANA_CHECK( m_fJVT_eff_tool_handle.setProperty("OutputLevel",  msg().level()));
-    ANA_CHECK( m_fJVT_eff_tool_handle.retrieve());
+    ANA_CHECK( retrieveSharedTool(m_fJVT_eff_tool_handle, toolConfig(m_WorkingPointfJVT, m_SFFilefJVT, m_UseMuSFFormatfJVT), [&]() -> StatusCode {
+      ANA_CHECK( m_fJVT_eff_tool_handle.setProperty("WorkingPoint", m_WorkingPointfJVT ));
+      ANA_CHECK( m_fJVT_eff_tool_handle.setProperty("SFFile",       m_SFFilefJVT ));
+      ANA_CHECK( m_fJVT_eff_tool_handle.setProperty("UseMuSFFormat",       m_UseMuSFFormatfJVT ));
+      ANA_CHECK( m_fJVT_eff_tool_handle.setProperty("ScaleFactorDecorationName", "fJVTSF"));
+      ANA_CHECK( m_fJVT_eff_tool_handle.setProperty("OutputLevel",  msg().level()));
+      return m_fJVT_eff_tool_handle.retrieve();
+    }));
     ANA_MSG_DEBUG("Retrieved tool: " << m_fJVT_eff_tool_handle);
 
     //  Add the chosen WP to the string labelling the vector<SF> decoration
@@ -272,10 +286,12 @@ EL::StatusCode JetSelector :: initialize ()
 
   // initialize the CP::JetJvtEfficiency Tool for JVT
   ANA_CHECK( ASG_MAKE_ANA_TOOL(m_JVT_tool_handle, CP::JetJvtEfficiency));
-  ANA_CHECK( m_JVT_tool_handle.setProperty("WorkingPoint", m_WorkingPointJVT ));
-  ANA_CHECK( m_JVT_tool_handle.setProperty("SFFile",       m_SFFileJVT ));
-  ANA_CHECK( m_JVT_tool_handle.setProperty("OutputLevel",  msg().level()));
-  ANA_CHECK( m_JVT_tool_handle.retrieve());
+  ANA_CHECK( retrieveSharedTool(m_JVT_tool_handle, toolConfig(m_WorkingPointJVT, m_SFFileJVT), [&]() -> StatusCode {
+    ANA_CHECK( m_JVT_tool_handle.setProperty("WorkingPoint", m_WorkingPointJVT ));
+    ANA_CHECK( m_JVT_tool_handle.setProperty("SFFile",       m_SFFileJVT ));
+    ANA_CHECK( m_JVT_tool_handle.setProperty("OutputLevel",  msg().level()));
+    return m_JVT_tool_handle.retrieve();
+  }));
   ANA_MSG_DEBUG("Retrieved tool: " << m_JVT_tool_handle);
 
   //  Add the chosen WP to the string labelling the vector<SF> decoration
@@ -310,6 +326,13 @@ EL::StatusCode JetSelector :: initialize ()
 
   ANA_MSG_DEBUG( "Number of events in file: " << m_event->getEntries() );
 
+  // the bit of the selection decision in the flag word of the objects
+  m_passSelBit = xAH::SelectionFlags::bit( m_decor );
+  if ( m_passSelBit < 0 ) {
+    ANA_MSG_ERROR( "No bit left in the selection flags for " << m_decor );
+    return EL::StatusCode::FAILURE;
+  }
+
   m_numEvent      = 0;
   m_numObject     = 0;
   m_numEventPass  = 0;
@@ -369,6 +392,15 @@ EL::StatusCode JetSelector :: initialize ()
     m_mcCleaningCut = 1.4;
   }
 
+  if ( m_fuseWithCalibrator ) {
+    if ( m_inputAlgo.empty() ) {
+      ANA_MSG_WARNING( "m_fuseWithCalibrator needs the systematics list of a calibrator as m_inputAlgo, this selector runs on its own" );
+    } else if ( !s_fusedSelectors.emplace( std::make_pair(m_inContainerName, m_inputAlgo), this ).second ) {
+      ANA_MSG_ERROR( "Another JetSelector is already fused with the calibrator writing " << m_inContainerName << " and " << m_inputAlgo );
+      return EL::StatusCode::FAILURE;
+    }
+  }
+
   ANA_MSG_DEBUG( "JetSelector Interface succesfully initialized!" );
 
   return EL::StatusCode::SUCCESS;
@@ -378,6 +410,13 @@ EL::StatusCode JetSelector :: initialize ()
 
 EL::StatusCode JetSelector :: execute ()
 {
+  auto event = beginEvent();
+  auto timer = timeExecute();
+  // the selection of this event was already run by the JetCalibrator fused with this selector
+  const bool fusedDone = m_fusedDone;
+  m_fusedDone = false;
+  if ( eventRejected() ) return EL::StatusCode::SUCCESS;
+  if ( fusedDone ) return EL::StatusCode::SUCCESS;
   // Here you do everything that needs to be done on every single
   // events, e.g. read input variables, apply cuts, and fill
   // histograms and trees.  This is where most of your actual analysis
@@ -385,22 +424,86 @@ EL::StatusCode JetSelector :: execute ()
 
   ANA_MSG_DEBUG( "Applying Jet Selection... " << m_name);
 
+  // if input comes from xAOD, or just running one collection,
+  // then get the one collection and be done with it
+  if ( m_inputAlgo.empty() ) {
+
+    ANA_CHECK( beginEvent( false ) );
+
+    // this will be the collection processed - no matter what!!
+    const xAOD::JetContainer* inJets(nullptr);
+    ANA_CHECK( m_inJetsHandle.retrieve(inJets, msg()) );
+
+    // decorate inJets with truth info
+    if ( isMC() && m_doJVT && m_haveTruthJets ) decorateJvtTruthLabels( inJets, true );
+
+    // Check against pile-up only jets:
+    if ( isMC() && m_doMCCleaning && m_haveTruthJets ){
+      const xAOD::JetContainer* truthJets = m_loop.truthJets;
+      float pTAvg = (inJets->size() > 0) ? inJets->at(0)->pt() : 0;
+      if ( inJets->size() > 1 ) pTAvg = ( inJets->at(0)->pt() + inJets->at(1)->pt() ) / 2.0;
+      if( truthJets->size() == 0 || ( pTAvg / truthJets->at(0)->pt() ) > m_mcCleaningCut ) {
+        ANA_MSG_DEBUG("Failed MC cleaning, skipping event");
+        rejectEvent();
+      }
+    }
+
+    m_loop.pass = executeSelection( inJets, m_loop.mcEvtWeight, m_loop.count, m_outContainerName, true );
+
+  }  else { // get the list of systematics to run over
+
+    // variations which left every jet identical to nominal
+    const std::string sameAsNominalName = HelperFunctions::sameAsNominalName(m_inputAlgo);
+    ANA_CHECK( beginEvent( m_store->contains< std::vector<std::string> >(sameAsNominalName) ) );
+    std::vector<std::string>* sameAsNominal(nullptr);
+    if ( m_loop.haveSameAsNominal ) {
+      ANA_CHECK( HelperFunctions::retrieve(sameAsNominal, sameAsNominalName, 0, m_store, msg()) );
+    }
+
+    // get vector of string giving the names
+    std::vector<std::string>* systNames(nullptr);
+    ANA_CHECK( HelperFunctions::retrieve(systNames, m_inputAlgo, 0, m_store, msg()) );
+
+    // loop over systematics
+    for ( const auto& systName : *systNames ) {
+      const xAOD::JetContainer* inJets(nullptr);
+      ANA_CHECK( HelperFunctions::retrieve(inJets, m_inContainerName+systName, m_event, m_store, msg()) );
+      const bool isSameAsNominal = sameAsNominal && std::find(sameAsNominal->begin(), sameAsNominal->end(), systName) != sameAsNominal->end();
+      ANA_CHECK( selectVariation( inJets, systName, isSameAsNominal ) );
+    }
+
+  }
+
+  return endEvent();
+
+}
+
+JetSelector* JetSelector :: fusedSelector ( const std::string& inContainerName, const std::string& inputAlgo )
+{
+  auto it = s_fusedSelectors.find( std::make_pair(inContainerName, inputAlgo) );
+  return it == s_fusedSelectors.end() ? nullptr : it->second;
+}
+
+EL::StatusCode JetSelector :: beginEvent ( bool haveSameAsNominal )
+{
   // retrieve event
   const xAOD::EventInfo* eventInfo(nullptr);
-  ANA_CHECK( HelperFunctions::retrieve(eventInfo, m_eventInfoContainerName, m_event, m_store, msg()) );
+  ANA_CHECK( m_eventInfoHandle.retrieve(eventInfo, msg()) );
 
   // MC event weight
-  float mcEvtWeight(1.0);
+  m_loop.mcEvtWeight = 1.0;
   if(eventInfo->eventType( xAOD::EventInfo::IS_SIMULATION ) ){
     static SG::AuxElement::Accessor< float > mcEvtWeightAcc("mcEventWeight");
     if ( ! mcEvtWeightAcc.isAvailable( *eventInfo ) ) {
       ANA_MSG_ERROR( "mcEventWeight is not available as decoration! Aborting" );
       return EL::StatusCode::FAILURE;
     }
-    mcEvtWeight = mcEvtWeightAcc( *eventInfo );
+    m_loop.mcEvtWeight = mcEvtWeightAcc( *eventInfo );
   }
 
   m_numEvent++;
+  m_nominalJVT.clear();
+  m_nominalfJVT.clear();
 
   // QUESTION: why this must be done in execute(), and does not work in initialize()?
   //
@@ -422,6 +525,25 @@ EL::StatusCode JetSelector :: execute ()
    	m_diJetTrigChainsList.push_back(dijet_trig);
     }
 
+    // fix the bit of each chain in the trigger matching decorations
+    //
+    for ( auto const &chain : m_singleJetTrigChainsList ) {
+      const int bit = xAH::TrigMatchBits::bit( chain );
+      if ( bit < 0 ) {
+        ANA_MSG_ERROR( "At most " << xAH::TrigMatchBits::maxChains << " trigger chains can be matched in a job, cannot add " << chain );
+        return EL::StatusCode::FAILURE;
+      }
+      m_singleJetTrigChainsBits.push_back( bit );
+    }
+    for ( auto const &chain : m_diJetTrigChainsList ) {
+      const int bit = xAH::TrigMatchBits::bit( chain );
+      if ( bit < 0 ) {
+        ANA_MSG_ERROR( "At most " << xAH::TrigMatchBits::maxChains << " trigger chains can be matched in a job, cannot add " << chain );
+        return EL::StatusCode::FAILURE;
+      }
+      m_diJetTrigChainsBits.push_back( bit );
+    }
+
     ANA_MSG_INFO( "Input single jet trigger chains that will be considered for matching:\n");
     for ( auto const &chain : m_singleJetTrigChainsList ) { ANA_MSG_INFO( "\t " << chain); }
     ANA_MSG_INFO( "\n");
@@ -433,116 +555,147 @@ EL::StatusCode JetSelector :: execute ()
   }
 
   // did any collection pass the cuts?
-  bool pass(false);
-  bool count(true); // count for the 1st collection in the container - could be better as
-                    // shoudl only count for the nominal
-  const xAOD::JetContainer* inJets(nullptr);
-
-  const xAOD::JetContainer *truthJets = nullptr;
-  if ( isMC() && (m_doJVT || m_doMCCleaning ) && m_haveTruthJets) ANA_CHECK( HelperFunctions::retrieve(truthJets, m_truthJetContainer, m_event, m_store, msg()) );
-
-  // if input comes from xAOD, or just running one collection,
-  // then get the one collection and be done with it
-  if ( m_inputAlgo.empty() ) {
+  m_loop.pass = false;
+  m_loop.count = true; // count for the 1st collection in the container - could be better as
+                       // shoudl only count for the nominal
+  m_loop.passMCcleaning = true;
+  m_loop.passNominal = false;
+  m_loop.nominalJets = nullptr;
+  m_loop.haveSameAsNominal = m_aliasSameAsNominalSysts && haveSameAsNominal;
+  m_loop.outContainerNames = std::make_unique< std::vector< std::string > >();
+  m_loop.outSameAsNominal = std::make_unique< std::vector< std::string > >();
+
+  m_loop.truthJets = nullptr;
+  if ( isMC() && (m_doJVT || m_doMCCleaning ) && m_haveTruthJets) ANA_CHECK( m_truthJetsHandle.retrieve(m_loop.truthJets, msg()) );
+  if ( isMC() && m_doJVT && m_haveTruthJets ) {
+    // the same truth jets for all the systematics, in the pseudorapidity of TLorentzVector::DeltaR
+    m_truthJetGrid.fill( m_loop.truthJets, 0.6, false );
+    m_jvtTruthLabels.clear();
+    m_jvtTruthLabelsSize = 0;
+  }
 
-    // this will be the collection processed - no matter what!!
-    ANA_CHECK( HelperFunctions::retrieve(inJets, m_inContainerName, m_event, m_store, msg()) );
+  return EL::StatusCode::SUCCESS;
+}
 
-    // decorate inJets with truth info
-    if ( isMC() && m_doJVT && m_haveTruthJets ) {
-      static SG::AuxElement::Decorator<char>  isHS("isJvtHS");
-      static SG::AuxElement::Decorator<char>  isPU("isJvtPU");
-      for(const auto& jet : *inJets) {
-        bool ishs = false;
-        bool ispu = true;
-        for(const auto& tjet : *truthJets) {
-          if (tjet->p4().DeltaR(jet->p4())<0.3 && tjet->pt()>10e3) ishs = true;
-          if (tjet->p4().DeltaR(jet->p4())<0.6) ispu = false;
-        }
-        isHS(*jet)=ishs;
-        isPU(*jet)=ispu;
+EL::StatusCode JetSelector :: selectVariation ( const xAOD::JetContainer* inJets, const std::string& systName, bool sameAsNominal )
+{
+  // same jets as nominal: reuse the nominal selection instead of repeating it
+  if ( m_loop.haveSameAsNominal && sameAsNominal && m_loop.nominalJets && !systName.empty() ) {
+    const xAOD::JetContainer* nominalJets = m_loop.nominalJets;
+    // the variation lists the same jets as nominal in the same order, so jets are matched by position
+    if ( m_decorateSelectedObjects ) {
+      SG::AuxElement::ConstAccessor< char > passSelAcc( m_decor );
+      SG::AuxElement::Decorator< char > passSelDecor( m_decor );
+      for ( std::size_t i = 0; i < inJets->size(); ++i ) {
+        passSelDecor( *inJets->at(i) ) = passSelAcc.isAvailable( *nominalJets->at(i) ) ? passSelAcc( *nominalJets->at(i) ) : -1;
+        const unsigned long long passSelMask = xAH::SelectionFlags::mask(m_passSelBit);
+        if ( xAH::SelectionFlags::isDecided( *nominalJets->at(i), passSelMask ) ) xAH::SelectionFlags::set( *inJets->at(i), m_passSelBit, xAH::SelectionFlags::test( *nominalJets->at(i), passSelMask ) );
+        else                                                                      xAH::SelectionFlags::setUndecided( *inJets->at(i), m_passSelBit );
       }
     }
-
-    // Check against pile-up only jets:
-    if ( isMC() && m_doMCCleaning && m_haveTruthJets ){
-      float pTAvg = (inJets->size() > 0) ? inJets->at(0)->pt() : 0;
-      if ( inJets->size() > 1 ) pTAvg = ( inJets->at(0)->pt() + inJets->at(1)->pt() ) / 2.0;
-      if( truthJets->size() == 0 || ( pTAvg / truthJets->at(0)->pt() ) > m_mcCleaningCut ) {
-        ANA_MSG_DEBUG("Failed MC cleaning, skipping event");
-        wk()->skipEvent();
+    if ( m_createSelectedContainer ) {
+      ConstDataVector<xAOD::JetContainer>* nominalSelected(nullptr);
+      ANA_CHECK( HelperFunctions::retrieve(nominalSelected, m_outContainerName, 0, m_store, msg()) );
+      ConstDataVector<xAOD::JetContainer>* selectedJets = new ConstDataVector<xAOD::JetContainer>(SG::VIEW_ELEMENTS);
+      selectedJets->reserve( nominalSelected->size() );
+      for ( const xAOD::Jet* jet : *nominalSelected ) {
+        const std::size_t i = std::find(nominalJets->begin(), nominalJets->end(), jet) - nominalJets->begin();
+        selectedJets->push_back( inJets->at(i) );
       }
+      ANA_CHECK( m_store->record( selectedJets, m_outContainerName+systName ));
     }
+    m_loop.outSameAsNominal->push_back( systName );
+    if ( m_loop.passNominal ) {
+      m_loop.outContainerNames->push_back( systName );
+    }
+    m_loop.pass = (m_loop.passMCcleaning) ? (m_loop.pass || m_loop.passNominal) : false;
+    return EL::StatusCode::SUCCESS;
+  }
 
-    pass = executeSelection( inJets, mcEvtWeight, count, m_outContainerName, true );
-
-  }  else { // get the list of systematics to run over
-
-    // get vector of string giving the names
-    std::vector<std::string>* systNames(nullptr);
-    ANA_CHECK( HelperFunctions::retrieve(systNames, m_inputAlgo, 0, m_store, msg()) );
-
-    // loop over systematics
-    auto vecOutContainerNames = std::make_unique< std::vector< std::string > >();
-    bool passOne(false);
-    bool passMCcleaning(true);
-    for ( auto systName : *systNames ) {
-
-      ANA_CHECK( HelperFunctions::retrieve(inJets, m_inContainerName+systName, m_event, m_store, msg()) );
+  // Check against pile-up only jets (if nominal do not pass the selection then throw the event for all systs too)
+  if ( isMC() && m_doMCCleaning && m_haveTruthJets && systName.empty() ){
+    const xAOD::JetContainer* truthJets = m_loop.truthJets;
+    float pTAvg = (inJets->size() > 0) ? inJets->at(0)->pt() : 0;
+    if ( inJets->size() > 1 ) pTAvg = ( inJets->at(0)->pt() + inJets->at(1)->pt() ) / 2.0;
+    if( truthJets->size() == 0 || ( pTAvg / truthJets->at(0)->pt() ) > m_mcCleaningCut ) {
+      m_loop.passMCcleaning = false;
+    }
+  }
 
-      // Check against pile-up only jets (if nominal do not pass the selection then throw the event for all systs too)
-      if ( isMC() && m_doMCCleaning && m_haveTruthJets && systName.empty() ){
-        float pTAvg = (inJets->size() > 0) ? inJets->at(0)->pt() : 0;
-        if ( inJets->size() > 1 ) pTAvg = ( inJets->at(0)->pt() + inJets->at(1)->pt() ) / 2.0;
-        if( truthJets->size() == 0 || ( pTAvg / truthJets->at(0)->pt() ) > m_mcCleaningCut ) {
-          passMCcleaning = false;
-        }
-      }
+  // decorate inJets with truth info, the variations reuse the labels of the nominal jets
+  if ( isMC() && m_doJVT && m_haveTruthJets ) decorateJvtTruthLabels( inJets, systName.empty() );
 
-      // decorate inJets with truth info
-      if ( isMC() && m_doJVT && m_haveTruthJets ) {
-        static SG::AuxElement::Decorator<char>  isHS("isJvtHS");
-        static SG::AuxElement::Decorator<char>  isPU("isJvtPU");
-        for(const auto& jet : *inJets) {
-          bool ishs = false;
-          bool ispu = true;
-          for(const auto& tjet : *truthJets) {
-            if (tjet->p4().DeltaR(jet->p4())<0.3 && tjet->pt()>10e3) ishs = true;
-            if (tjet->p4().DeltaR(jet->p4())<0.6) ispu = false;
-          }
-          isHS(*jet)=ishs;
-          isPU(*jet)=ispu;
-        }
-      }
+  const bool passOne = executeSelection( inJets, m_loop.mcEvtWeight, m_loop.count, m_outContainerName+systName, systName.empty() );
+  if ( m_loop.count ) { m_loop.count = false; } // only count for 1 collection
+  if ( systName.empty() ) {
+    m_loop.nominalJets = inJets;
+    m_loop.passNominal = passOne;
+  }
+  // save the string if passing the selection
+  if ( passOne ) {
+    m_loop.outContainerNames->push_back( systName );
+  }
+  // the final decision - if at least one passes keep going!
+  m_loop.pass = m_loop.pass || passOne;
+  m_loop.pass = (m_loop.passMCcleaning) ? m_loop.pass : false; // if nominal do not pass MC cleaning then event should be skip for all systs
 
-      passOne = executeSelection( inJets, mcEvtWeight, count, m_outContainerName+systName, systName.empty() );
-      if ( count ) { count = false; } // only count for 1 collection
-      // save the string if passing the selection
-      if ( passOne ) {
-        vecOutContainerNames->push_back( systName );
-      }
-      // the final decision - if at least one passes keep going!
-      pass = pass || passOne;
-      pass = (passMCcleaning) ? pass : false; // if nominal do not pass MC cleaning then event should be skip for all systs
-    }
+  return EL::StatusCode::SUCCESS;
+}
 
+EL::StatusCode JetSelector :: endEvent ()
+{
+  if ( !m_inputAlgo.empty() ) {
     // save list of systs that should be considered down stream
-    ANA_CHECK( m_store->record( std::move(vecOutContainerNames), m_outputAlgo));
-    //delete vecOutContainerNames;
-
+    ANA_CHECK( m_store->record( std::move(m_loop.outContainerNames), m_outputAlgo));
+    if ( m_loop.haveSameAsNominal ) {
+      ANA_CHECK( m_store->record( std::move(m_loop.outSameAsNominal), HelperFunctions::sameAsNominalName(m_outputAlgo)));
+    }
   }
 
   // look what we have in TStore
   if(msgLvl(MSG::VERBOSE)) m_store->print();
 
-  if ( !pass ) {
-    wk()->skipEvent();
+  if ( !m_loop.pass ) {
+    rejectEvent();
   }
 
   ANA_MSG_DEBUG( "Leave Jet Selection... ");
 
   return EL::StatusCode::SUCCESS;
+}
 
+EL::StatusCode JetSelector :: endFusedEvent ()
+{
+  m_fusedDone = true;
+  return endEvent();
+}
+
+void JetSelector :: decorateJvtTruthLabels( const xAOD::JetContainer* jets, bool isNominal ) {
+
+  static const SG::AuxElement::Decorator<char> isHS("isJvtHS");
+  static const SG::AuxElement::Decorator<char> isPU("isJvtPU");
+
+  // the systematic variations are shallow copies of the same calibrated jets as nominal, so the jets are
+  // matched by their index in there, whatever the order of the view containers
+  const std::size_t parentSize = jets->empty() ? 0 : jets->front()->container()->size_v();
+  if ( isNominal ) {
+    m_jvtTruthLabels.assign( parentSize, -1 );
+    m_jvtTruthLabelsSize = parentSize;
+  }
+  const bool reuse = !isNominal && parentSize == m_jvtTruthLabelsSize;
+
+  for ( const xAOD::Jet* jet : *jets ) {
+    const std::size_t i = jet->index();
+    signed char label = ( reuse && i < m_jvtTruthLabels.size() ) ? m_jvtTruthLabels[i] : -1;
+    if ( label < 0 ) {
+      const bool ishs = m_truthJetGrid.hasNeighbour( jet, 0.3, 10e3 );
+      const bool ispu = !m_truthJetGrid.hasNeighbour( jet, 0.6 );
+      label = ishs | ispu << 1;
+      if ( isNominal && i < m_jvtTruthLabels.size() ) m_jvtTruthLabels[i] = label;
+    }
+    isHS(*jet) = label & 1;
+    isPU(*jet) = ( label >> 1 ) & 1;
+  }
 }
 
 bool JetSelector :: executeSelection ( const xAOD::JetContainer* inJets,
@@ -558,12 +711,13 @@ bool JetSelector :: executeSelection ( const xAOD::JetContainer* inJets,
   ConstDataVector<xAOD::JetContainer>* selectedJets(nullptr);
   if ( m_createSelectedContainer ) {
     selectedJets = new ConstDataVector<xAOD::JetContainer>(SG::VIEW_ELEMENTS);
+    selectedJets->reserve( inJets->size() );
   }
 
   // if doing JVF or JVT get PV location
   if ( m_doJVF ) {
     const xAOD::VertexContainer* vertices(nullptr);
-    ANA_CHECK( HelperFunctions::retrieve(vertices, m_vertexContainerName, m_event, m_store, msg()) );
+    ANA_CHECK( m_vertexHandle.retrieve(vertices, msg()) );
     m_pvLocation = HelperFunctions::getPrimaryVertexLocation( vertices, msg() );
   }
 
@@ -579,74 +733,66 @@ bool JetSelector :: executeSelection ( const xAOD::JetContainer* inJets,
   SG::AuxElement::Decorator< char > passSelDecor( m_decor );
 
 
-  // identify duplicates
-  std::vector<int> badIndices;
-  badIndices.clear();
-  int i_jet = 0;
+  // identify duplicates: isDuplicate[i] is set for every jet with the same eta as a jet of lower index
+  xAH::ArenaVector<bool> isDuplicate;
   if(m_removeDuplicates) {
     ANA_MSG_DEBUG("removing duplicates");
 
     // fill pairs with jet eta and index
-    std::vector< std::pair<float, int> > etaPairs;
+    xAH::ArenaVector< std::pair<float, int> > etaPairs;
+    etaPairs.reserve(inJets->size());
     ANA_MSG_DEBUG("All jets:");
-    i_jet = 0;
+    int i_jet = 0;
     for ( auto jet_itr : *inJets ) {
       ANA_MSG_DEBUG( "  jet " << i_jet << ": " << jet_itr->pt() << ", " <<  jet_itr->eta() << ", " << jet_itr->phi() );
       etaPairs.push_back( std::make_pair(jet_itr->eta(), i_jet) );
       i_jet++;
     }
 
-    // sort pairs by eta
-    sort(etaPairs.begin(), etaPairs.end());
-
-    bool allChecked = false;
-    if(int(etaPairs.size())<=1) allChecked = true;
-    while(!allChecked) {
-      for(int i_etaPair=1; i_etaPair < int(etaPairs.size()); i_etaPair++) { // start with second jet
-
-        // if i and i-1 have identical etas then remove i, and add the relevant index to badIndices
-        if(etaPairs[i_etaPair].first == etaPairs[i_etaPair-1].first) {
-          badIndices.push_back(etaPairs[i_etaPair].second);
-          etaPairs.erase(etaPairs.begin()+i_etaPair);
-          break;
-        }
+    // sort pairs by eta, identical etas end up next to each other ordered by index
+    std::sort(etaPairs.begin(), etaPairs.end());
 
-        // if made it to the end with no duplicates, then we're done
-        if(i_etaPair==int(etaPairs.size())-1)
-          allChecked = true; 
+    // keep the first jet of each run of identical etas
+    isDuplicate.assign(inJets->size(), false);
+    bool foundDuplicates = false;
+    for(unsigned int i_etaPair=1; i_etaPair < etaPairs.size(); i_etaPair++) { // start with second jet
+      if(etaPairs[i_etaPair].first == etaPairs[i_etaPair-1].first) {
+        isDuplicate[etaPairs[i_etaPair].second] = true;
+        foundDuplicates = true;
       }
     }
 
     ANA_MSG_DEBUG( "duplicates removed:" );
     i_jet = 0;
     for ( auto jet_itr : *inJets ) {
-      if(std::find(badIndices.begin(), badIndices.end(), i_jet) != badIndices.end()) {
-        continue;
+      if(!isDuplicate[i_jet]) {
+        ANA_MSG_DEBUG( "  jet " << i_jet << ": " << jet_itr->pt() << ", " <<  jet_itr->eta() << ", " << jet_itr->phi() );
       }
-      ANA_MSG_DEBUG( "  jet " << i_jet << ": " << jet_itr->pt() << ", " <<  jet_itr->eta() << ", " << jet_itr->phi() );
       i_jet++;
     }
-    if(!badIndices.empty())
+    if(foundDuplicates)
       m_count_events_with_duplicates++;
   }
 
-  i_jet = 0;
+  // in a pt-ordered input, the jets from the first one below m_pT_min on fail it, whatever the other cuts
+  std::size_t ptOrderedEnd = inJets->size();
+  if ( m_ptOrderedInput && m_pT_min != 1e8 && m_jetScale4Selection == "Final" ) {
+    ptOrderedEnd = HelperFunctions::sortedPtEnd( *inJets, m_pT_min );
+  }
+
+  unsigned int i_jet = 0;
   for ( auto jet_itr : *inJets ) { // duplicated of basic loop
 
+    const unsigned int jetIndex = i_jet++;
+
     // removing of duplicates
-    if(m_removeDuplicates) {
-      if(!badIndices.empty()) {
-        if(std::find(badIndices.begin(), badIndices.end(), i_jet) != badIndices.end()) {
-          continue;
-        }
-      }
-      i_jet++;
-    }
-      
+    if(m_removeDuplicates && isDuplicate[jetIndex]) continue;
+
     // if only looking at a subset of jets make sure all are decorated
     if ( m_nToProcess > 0 && nObj >= m_nToProcess ) {
       if ( m_decorateSelectedObjects ) {
         passSelDecor( *jet_itr ) = -1;
+        xAH::SelectionFlags::setUndecided( *jet_itr, m_passSelBit );
       } else {
         break;
       }
@@ -655,17 +801,27 @@ bool JetSelector :: executeSelection ( const xAOD::JetContainer* inJets,
 
     nObj++;
     // All selections but Cleaning
-    int passSel = this->PassCuts( jet_itr );
+    int passSel = 0;
+    if ( jetIndex < ptOrderedEnd ) {
+      passSel = this->PassCuts( jet_itr );
+    } else if ( m_useCutFlow ) {
+      // what PassCuts fills for a jet failing the pT_min cut
+      m_jet_cutflowHist_1->Fill( m_jet_cutflow_all, 1 );
+      if ( m_pT_max == 1e8 || !(jet_itr->pt() > m_pT_max) ) m_jet_cutflowHist_1->Fill( m_jet_cutflow_ptmax_cut, 1 );
+    }
     if ( m_decorateSelectedObjects ) {
       passSelDecor( *jet_itr ) = passSel;
+      xAH::SelectionFlags::set( *jet_itr, m_passSelBit, passSel );
     }
 
     // Cleaning Selection must come after kinematic and JVT selections
     if ( m_cleanJets && passSel && isCleanAcc.isAvailable( *jet_itr ) ) {
       if( !isCleanAcc( *jet_itr ) ) {
         passSel = false;
-        if ( m_decorateSelectedObjects )
+        if ( m_decorateSelectedObjects ) {
           passSelDecor( *jet_itr ) = passSel;
+          xAH::SelectionFlags::set( *jet_itr, m_passSelBit, passSel );
+        }
 
         // If any of the passing jets fail the recommendation is to remove the jet (and MET is wrong)
         // If any of the N leading jets are not clean the event should be removed
@@ -704,76 +860,77 @@ bool JetSelector :: executeSelection ( const xAOD::JetContainer* inJets,
     // Do it only if a tool with *this* name hasn't already been used
     //
     if ( m_JVT_tool_handle.isInitialized() && !m_jvtUsedBefore) {
-      //
-      //  If SF decoration vector doesn't exist, create it (will be done only for the 1st systematic for *this* jet)
-      //
       static const SG::AuxElement::Decorator< std::vector<float> > dec_sfJVT( m_outputSystNamesJVT );
+      // create passed JVT decorator
+      static const SG::AuxElement::Decorator<char> passedJVT( m_outputJVTPassed );
 
       // Create the name of the SF weight to be recorded
       //   template:  SYSNAME_JVTEff_SF
-      //   Only need to do it once per call of executeSelection()
-      for ( const auto& syst_it : m_systListJVT ) {
-	std::string sfName = "JVTEff_SF_" + m_WorkingPointJVT;
-	if ( !syst_it.name().empty() ) {
-	  std::string prepend = syst_it.name() + "_";
-	  sfName.insert( 0, prepend );
-	}
-	ANA_MSG_DEBUG("JVT SF sys name (to be recorded in xAOD::TStore) is: " << sfName);
-	sysVariationNamesJVT->push_back(sfName);
+      //   Only need to do it once per event
+      if ( !m_store->contains<std::vector<std::string> >(m_outputSystNamesJVT) ) {
+        for ( const auto& syst_it : m_systListJVT ) {
+          std::string sfName = "JVTEff_SF_" + m_WorkingPointJVT;
+          if ( !syst_it.name().empty() ) {
+            std::string prepend = syst_it.name() + "_";
+            sfName.insert( 0, prepend );
+          }
+          ANA_MSG_DEBUG("JVT SF sys name (to be recorded in xAOD::TStore) is: " << sfName);
+          sysVariationNamesJVT->push_back(sfName);
+        }
       }
 
-      unsigned int idx(0);
+      // Create Scale Factor aux for all jets, one entry per systematic
+      // (we do not need all SF for non-nominal trees)
+      const std::size_t nSysts = isNominal ? m_systListJVT.size() : 1;
       for ( auto jet : *(selectedJets) ) {
-	// Create Scale Factor aux for all jets
-	std::vector<float > sfVecJVT;
-
-	for ( const auto& syst_it : m_systListJVT ) {
-	  // we do not need all SF for non-nominal trees
-	  if ( !syst_it.name().empty() && !isNominal )
-	    continue;
-
-	  // apply syst
-	  //
-	  if ( m_JVT_tool_handle->applySystematicVariation(syst_it) != CP::SystematicCode::Ok ) {
-	    ANA_MSG_ERROR( "Failed to configure CP::JetJvtEfficiency for systematic " << syst_it.name());
-	    return EL::StatusCode::FAILURE;
-	  }
-	  ANA_MSG_DEBUG("Successfully applied systematic: " << syst_it.name());
-
-	  // and now apply JVT SF!
-	  //
-          ANA_MSG_DEBUG("Applying JVT SF" );
+        dec_sfJVT( *jet ) = std::vector<float>();
+        dec_sfJVT( *jet ).reserve( nSysts );
+      }
 
-          // create passed JVT decorator
-          static const SG::AuxElement::Decorator<char> passedJVT( m_outputJVTPassed );
+      // systematics in the outer loop: the tool is configured once per systematic rather than once per jet
+      for ( const auto& syst_it : m_systListJVT ) {
+        // we do not need all SF for non-nominal trees
+        if ( !syst_it.name().empty() && !isNominal )
+          continue;
 
-          if ( syst_it.name().empty() ) {
-            passedJVT( *jet ) = 1; // passes by default
-          }
+        // apply syst
+        //
+        if ( m_JVT_tool_handle->applySystematicVariation(syst_it) != CP::SystematicCode::Ok ) {
+          ANA_MSG_ERROR( "Failed to configure CP::JetJvtEfficiency for systematic " << syst_it.name());
+          return EL::StatusCode::FAILURE;
+        }
+        ANA_MSG_DEBUG("Successfully applied systematic: " << syst_it.name());
+
+        unsigned int idx(0);
+        for ( auto jet : *(selectedJets) ) {
+          // and now apply JVT SF!
+          //
+          ANA_MSG_DEBUG("Applying JVT SF" );
 
           // obtain JVT SF as a float (to be stored away separately)
           float jvtSF(1.0);
+          char passed(1); // passes by default
           if ( m_JVT_tool_handle->isInRange(*jet) ) {
             // If we do not enforce JVT veto and the jet hasn't passed the JVT cut, we need to calculate the inefficiency scale factor for it
             if ( m_noJVTVeto && !m_JVT_tool_handle->passesJvtCut(*jet) ) {
-              if ( syst_it.name().empty() ) {
-                passedJVT( *jet ) = 0; // mark as not passed
-              }
-              if ( m_getJVTSF && m_JVT_tool_handle->getInefficiencyScaleFactor( *jet, jvtSF ) != CP::CorrectionCode::Ok ) {
-                ANA_MSG_ERROR( "Error in JVT Tool getInefficiencyScaleFactor");
-                return EL::StatusCode::FAILURE;
-              }
-            } else { // otherwise classic efficiency scale factor
-              if ( syst_it.name().empty() ) {
-                passedJVT( *jet ) = 1;
-              }
-              if ( m_getJVTSF && m_JVT_tool_handle->getEfficiencyScaleFactor( *jet, jvtSF ) != CP::CorrectionCode::Ok ) {
-                ANA_MSG_ERROR( "Error in JVT Tool getEfficiencyScaleFactor");
+              passed = 0; // mark as not passed
+            }
+            if ( m_getJVTSF && !reuseNominalJVTSF( m_nominalJVT, *jet, isNominal, syst_it.name().empty(), passed, jvtSF ) ) {
+              CP::CorrectionCode code = passed ? m_JVT_tool_handle->getEfficiencyScaleFactor( *jet, jvtSF ) : m_JVT_tool_handle->getInefficiencyScaleFactor( *jet, jvtSF );
+              if ( code != CP::CorrectionCode::Ok ) {
+                ANA_MSG_ERROR( "Error in JVT Tool " << (passed ? "getEfficiencyScaleFactor" : "getInefficiencyScaleFactor") );
                 return EL::StatusCode::FAILURE;
               }
+              if ( isNominal && syst_it.name().empty() ) storeNominalJVTSF( m_nominalJVT, *jet, passed, jvtSF );
             }
           }
-	  sfVecJVT.push_back(jvtSF);
+          if ( syst_it.name().empty() ) {
+            passedJVT( *jet ) = passed;
+          }
+          //
+          // Add it to decoration vector
+          //
+          dec_sfJVT( *jet ).push_back(jvtSF);
 
           ANA_MSG_DEBUG( "===>>>");
           ANA_MSG_DEBUG( "Jet " << idx << ", pt = " << jet->pt()*1e-3 << " GeV, |eta| = " << std::fabs(jet->eta()) );
@@ -782,12 +939,8 @@ bool JetSelector :: executeSelection ( const xAOD::JetContainer* inJets,
           ANA_MSG_DEBUG( "JVT SF:");
           ANA_MSG_DEBUG( "\t " << jvtSF << " (from getEfficiencyScaleFactor())" );
           ANA_MSG_DEBUG( "--------------------------------------");
-	}
-	++idx;
-	//
-	// Add it to decoration vector
-	//
-	dec_sfJVT( *jet ) = sfVecJVT;
+          ++idx;
+        }
       }
     }
 
@@ -825,67 +978,75 @@ bool JetSelector :: executeSelection ( const xAOD::JetContainer* inJets,
     // Do it only if a tool with *this* name hasn't already been used
     //
     if ( m_fJVT_eff_tool_handle.isInitialized() && !m_fjvtUsedBefore) {
-      //
-      //  If SF decoration vector doesn't exist, create it (will be done only for the 1st systematic for *this* jet)
-      //
       static const SG::AuxElement::Decorator< std::vector<float> > dec_sffJVT( m_outputSystNamesfJVT );
+      static const SG::AuxElement::Decorator<char> passedfJVT( m_outputfJVTPassed );
+      static const SG::AuxElement::ConstAccessor<char> passFJVTAcc( "passFJVT" );
 
       // Create the name of the SF weight to be recorded
       //   template:  SYSNAME_fJVTEff_SF
-      //   Only need to do it once per call of executeSelection()
-      for ( const auto& syst_it : m_systListfJVT ) {
-        std::string sfName = "fJVTEff_SF";
-        if ( !syst_it.name().empty() ) {
-           std::string prepend = syst_it.name() + "_";
-           sfName.insert( 0, prepend );
+      //   Only need to do it once per event
+      if ( !m_store->contains<std::vector<std::string> >(m_outputSystNamesfJVT) ) {
+        for ( const auto& syst_it : m_systListfJVT ) {
+          std::string sfName = "fJVTEff_SF";
+          if ( !syst_it.name().empty() ) {
+             std::string prepend = syst_it.name() + "_";
+             sfName.insert( 0, prepend );
+          }
+          ANA_MSG_DEBUG("fJVT SF sys name (to be recorded in xAOD::TStore) is: " << sfName);
+          sysVariationNamesfJVT->push_back(sfName);
         }
-        ANA_MSG_DEBUG("fJVT SF sys name (to be recorded in xAOD::TStore) is: " << sfName);
-        sysVariationNamesfJVT->push_back(sfName);
       }
 
-      unsigned int idx(0);
+      // Create Scale Factor aux for all jets, one entry per systematic
+      // (we do not need all SF for non-nominal trees)
+      const std::size_t nSysts = isNominal ? m_systListfJVT.size() : 1;
       for ( auto jet : *(selectedJets) ) {
-	// Create Scale Factor aux for all jets
-	std::vector<float > sfVecfJVT;
-
-	for ( const auto& syst_it : m_systListfJVT ) {
-	  // we do not need all SF for non-nominal trees
-	  if ( !syst_it.name().empty() && !isNominal )
-            continue;
-
-	  // apply syst
-	  //
-	  if ( m_fJVT_eff_tool_handle->applySystematicVariation(syst_it) != CP::SystematicCode::Ok ) {
-	    ANA_MSG_ERROR( "Failed to configure CP::JetJvtEfficiency for systematic " << syst_it.name());
-	    return EL::StatusCode::FAILURE;
-	  }
-	  ANA_MSG_DEBUG("Successfully applied systematic: " << syst_it.name());
-
-	  // and now apply fJVT SF!
-	  //
+        dec_sffJVT( *jet ) = std::vector<float>();
+        dec_sffJVT( *jet ).reserve( nSysts );
+      }
+
+      // systematics in the outer loop: the tool is configured once per systematic rather than once per jet
+      for ( const auto& syst_it : m_systListfJVT ) {
+        // we do not need all SF for non-nominal trees
+        if ( !syst_it.name().empty() && !isNominal )
+          continue;
+
+        // apply syst
+        //
+        if ( m_fJVT_eff_tool_handle->applySystematicVariation(syst_it) != CP::SystematicCode::Ok ) {
+          ANA_MSG_ERROR( "Failed to configure CP::JetJvtEfficiency for systematic " << syst_it.name());
+          return EL::StatusCode::FAILURE;
+        }
+        ANA_MSG_DEBUG("Successfully applied systematic: " << syst_it.name());
+
+        unsigned int idx(0);
+        for ( auto jet : *(selectedJets) ) {
+          // and now apply fJVT SF!
+          //
           ANA_MSG_DEBUG("Applying fJVT SF" );
 
-          static const SG::AuxElement::Decorator<char> passedfJVT( m_outputfJVTPassed );
+          const char passFJVT = passFJVTAcc( *jet );
           if ( syst_it.name().empty() ) {
-            passedfJVT( *jet ) = jet->auxdata<char>("passFJVT");
+            passedfJVT( *jet ) = passFJVT;
           }
 
           float fjvtSF(1.0);
           if ( m_fJVT_eff_tool_handle->isInRange(*jet) ) {
             // If we do not enforce JVT veto and the jet hasn't passed the JVT cut, we need to calculate the inefficiency scale factor for it
-            if ( !m_dofJVTVeto && jet->auxdata<char>("passFJVT") != 1 ) {
-              if ( m_fJVT_eff_tool_handle->getInefficiencyScaleFactor( *jet, fjvtSF ) != CP::CorrectionCode::Ok ) {
-                ANA_MSG_ERROR( "Error in fJVT Tool getInefficiencyScaleFactor");
-                return EL::StatusCode::FAILURE;
-              }
-            } else { // otherwise classic efficiency scale factor
-              if ( m_fJVT_eff_tool_handle->getEfficiencyScaleFactor( *jet, fjvtSF ) != CP::CorrectionCode::Ok ) {
-                ANA_MSG_ERROR( "Error in fJVT Tool getEfficiencyScaleFactor");
+            const char passed = ( !m_dofJVTVeto && passFJVT != 1 ) ? 0 : 1;
+            if ( !reuseNominalJVTSF( m_nominalfJVT, *jet, isNominal, syst_it.name().empty(), passed, fjvtSF ) ) {
+              CP::CorrectionCode code = passed ? m_fJVT_eff_tool_handle->getEfficiencyScaleFactor( *jet, fjvtSF ) : m_fJVT_eff_tool_handle->getInefficiencyScaleFactor( *jet, fjvtSF );
+              if ( code != CP::CorrectionCode::Ok ) {
+                ANA_MSG_ERROR( "Error in fJVT Tool " << (passed ? "getEfficiencyScaleFactor" : "getInefficiencyScaleFactor") );
                 return EL::StatusCode::FAILURE;
               }
+              if ( isNominal && syst_it.name().empty() ) storeNominalJVTSF( m_nominalfJVT, *jet, passed, fjvtSF );
             }
           }
-          sfVecfJVT.push_back( fjvtSF );
+          //
+          // Add it to decoration vector
+          //
+          dec_sffJVT( *jet ).push_back( fjvtSF );
 
           ANA_MSG_DEBUG( "===>>>");
           ANA_MSG_DEBUG( "Jet " << idx << ", pt = " << jet->pt()*1e-3 << " GeV, |eta| = " << std::fabs(jet->eta()) );
@@ -894,12 +1055,8 @@ bool JetSelector :: executeSelection ( const xAOD::JetContainer* inJets,
           ANA_MSG_DEBUG( "fJVT SF:");
           ANA_MSG_DEBUG( "\t " << fjvtSF << " (from getEfficiencyScaleFactor())" );
           ANA_MSG_DEBUG( "--------------------------------------");
-	}
-	++idx;
-	//
-	// Add it to decoration vector
-	//
-	dec_sffJVT( *jet )= sfVecfJVT;
+          ++idx;
+        }
       }
     }
 
@@ -937,7 +1094,7 @@ bool JetSelector :: executeSelection ( const xAOD::JetContainer* inJets,
     // Decorator
     SG::AuxElement::Decorator< char > isCleanEventDecor( "cleanEvent_"+m_name );
     const xAOD::EventInfo* eventInfo(nullptr);
-    ANA_CHECK( HelperFunctions::retrieve(eventInfo, m_eventInfoContainerName, m_event, m_store, msg()) );
+    ANA_CHECK( m_eventInfoHandle.retrieve(eventInfo, msg()) );
 
     isCleanEventDecor(*eventInfo) = passEventClean;
   }
@@ -968,33 +1125,36 @@ bool JetSelector :: executeSelection ( const xAOD::JetContainer* inJets,
 
     unsigned int nSelectedJets = selectedJets->size();
 
-    static SG::AuxElement::Decorator< std::map<std::string,char> > isTrigMatchedMapJetDecor( "isTrigMatchedMapJet" );
+    static SG::AuxElement::Decorator< unsigned long long > trigMatchTestedBitsJetDecor( "trigMatchTestedBitsJet" );
+    static SG::AuxElement::Decorator< unsigned long long > isTrigMatchedBitsJetDecor( "isTrigMatchedBitsJet" );
+
+    //  Each jet is decorated w/ the bits of the tested chains and the bits of the matched chains,
+    //  the bit of each chain is fixed by xAH::TrigMatchBits when the chain lists are parsed
+    //
+    for ( auto const jet : *selectedJets ) {
+      trigMatchTestedBitsJetDecor( *jet ) = 0;
+      isTrigMatchedBitsJetDecor( *jet )   = 0;
+    }
 
     if ( nSelectedJets > 0 ) {
 
       ANA_MSG_DEBUG( "Doing single jet trigger matching...");
 
-      for ( auto const &chain : m_singleJetTrigChainsList ) {
+      for ( unsigned int ichain = 0; ichain < m_singleJetTrigChainsList.size(); ++ichain ) {
+
+        auto const &chain = m_singleJetTrigChainsList.at(ichain);
 
         ANA_MSG_DEBUG( "\t checking trigger chain " << chain);
 
         for ( auto const jet : *selectedJets ) {
 
-          //  For each jet, decorate w/ a map<string,char> with the 'isMatched' info associated
-          //  to each trigger chain in the input list.
-          //  If decoration map doesn't exist for this jet yet, create it (will be done only for the 1st iteration on the chain names)
-          //
-          if ( !isTrigMatchedMapJetDecor.isAvailable( *jet ) ) {
-            isTrigMatchedMapJetDecor( *jet ) = std::map<std::string,char>();
-          }
-
           // check whether the pair is matched (NOTE: no DR is needed for jets)
           //
           char matched = ( m_trigJetMatchTool_handle->match( *jet, chain ) );
 
           ANA_MSG_DEBUG( "\t\t is jet trigger matched? " << matched);
 
-          ( isTrigMatchedMapJetDecor( *jet ) )[chain] = matched;
+          xAH::TrigMatchBits::set( trigMatchTestedBitsJetDecor( *jet ), isTrigMatchedBitsJetDecor( *jet ), m_singleJetTrigChainsBits.at(ichain), matched );
         }
       }
 
@@ -1017,13 +1177,15 @@ bool JetSelector :: executeSelection ( const xAOD::JetContainer* inJets,
       ANA_MSG_DEBUG( "Doing di-jet trigger matching...");
 
       const xAOD::EventInfo* eventInfo(nullptr);
-      ANA_CHECK( HelperFunctions::retrieve(eventInfo, m_eventInfoContainerName, m_event, m_store, msg()) );
+      ANA_CHECK( m_eventInfoHandle.retrieve(eventInfo, msg()) );
 
       typedef std::pair< std::pair<unsigned int,unsigned int>, char> dijet_trigmatch_pair;
       typedef std::multimap< std::string, dijet_trigmatch_pair >    dijet_trigmatch_pair_map;
       static SG::AuxElement::Decorator< dijet_trigmatch_pair_map >  diJetTrigMatchPairMapDecor( "diJetTrigMatchPairMap" );
 
-      for ( auto const &chain : m_diJetTrigChainsList ) {
+      for ( unsigned int ichain = 0; ichain < m_diJetTrigChainsList.size(); ++ichain ) {
+
+        auto const &chain = m_diJetTrigChainsList.at(ichain);
 
       	ANA_MSG_DEBUG( "\t checking trigger chain " << chain);
 
@@ -1052,8 +1214,8 @@ bool JetSelector :: executeSelection ( const xAOD::JetContainer* inJets,
       	    ANA_MSG_DEBUG( "\t\t is the jet pair ("<<imu<<","<<jmu<<") trigger matched? " << matched);
 
             // set basic matching information
-            ( isTrigMatchedMapJetDecor( *myJets[0] ) )[chain] = matched;
-            ( isTrigMatchedMapJetDecor( *myJets[1] ) )[chain] = matched;
+            xAH::TrigMatchBits::set( trigMatchTestedBitsJetDecor( *myJets[0] ), isTrigMatchedBitsJetDecor( *myJets[0] ), m_diJetTrigChainsBits.at(ichain), matched );
+            xAH::TrigMatchBits::set( trigMatchTestedBitsJetDecor( *myJets[1] ), isTrigMatchedBitsJetDecor( *myJets[1] ), m_diJetTrigChainsBits.at(ichain), matched );
 
             // set pair decision information
       	    std::pair <unsigned int, unsigned int>  chain_idxs = std::make_pair(imu,jmu);
@@ -1067,7 +1229,7 @@ bool JetSelector :: executeSelection ( const xAOD::JetContainer* inJets,
   } //if m_doTrigMatch && selectedJets
 
   if(m_sort) {
-    std::sort( selectedJets->begin(), selectedJets->end(), HelperFunctions::sort_pt );
+    HelperFunctions::sortPt( selectedJets->begin(), selectedJets->end() );
   }
 
   ANA_MSG_DEBUG("leave executeSelection... ");
@@ -1077,6 +1239,8 @@ bool JetSelector :: executeSelection ( const xAOD::JetContainer* inJets,
 
 EL::StatusCode JetSelector :: postExecute ()
 {
+  auto timer = timePostExecute();
+  if ( eventRejected() ) return EL::StatusCode::SUCCESS;
   // Here you do everything that needs to be done after the main event
   // processing.  This is typically very rare, particularly in user
   // code.  It is mainly used in implementing the NTupleSvc.
@@ -1102,6 +1266,9 @@ EL::StatusCode JetSelector :: finalize ()
 
   ANA_MSG_DEBUG( m_name );
 
+  auto fused = s_fusedSelectors.find( std::make_pair(m_inContainerName, m_inputAlgo) );
+  if ( fused != s_fusedSelectors.end() && fused->second == this ) s_fusedSelectors.erase( fused );
+
   if ( m_useCutFlow ) {
     ANA_MSG_DEBUG( "Filling cutflow");
     m_cutflowHist ->SetBinContent( m_cutflow_bin, m_numEventPass        );
@@ -1380,3 +1547,21 @@ int JetSelector :: PassCuts( const xAOD::Jet* jet ) {
   ANA_MSG_DEBUG("Passed Cuts");
   return 1;
 }
+
+bool JetSelector :: reuseNominalJVTSF ( const std::vector<NominalJVTSF>& cache, const xAOD::Jet& jet, bool isNominal, bool nominalSyst, char passed, float& sf ) const
+{
+  if ( isNominal || !nominalSyst ) return false;
+  const std::size_t index = jet.index();
+  if ( index >= cache.size() ) return false;
+  const NominalJVTSF& nominal = cache[index];
+  if ( nominal.pt != jet.pt() || nominal.eta != jet.eta() || nominal.passed != passed ) return false;
+  sf = nominal.sf;
+  return true;
+}
+
+void JetSelector :: storeNominalJVTSF ( std::vector<NominalJVTSF>& cache, const xAOD::Jet& jet, char passed, float sf ) const
+{
+  const std::size_t index = jet.index();
+  if ( index >= cache.size() ) cache.resize( index+1 );
+  cache[index] = NominalJVTSF{ static_cast<float>(jet.pt()), static_cast<float>(jet.eta()), passed, sf };
+}
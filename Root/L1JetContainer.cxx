@@ -1,5 +1,6 @@
 #include "xAODAnaHelpers/L1JetContainer.h"
 #include <iostream>
+#include <algorithm>
 
 using namespace xAH;
 
@@ -58,22 +59,26 @@ void L1JetContainer::FillL1Jets( const xAOD::JetRoIContainer* jets, bool sort){
       m_l1Jet_phi->push_back( jet_itr->phi() );
     }
   } else {
-    std::vector< std::vector<float> > vec;
-    for( auto jet_itr : *jets ) {
-      std::vector<float> row;
-      row.clear();
-      row.push_back(jet_itr->et8x8());
-      row.push_back(jet_itr->eta());
-      row.push_back(jet_itr->phi());
-      vec.push_back(row);
+    // sort an index over the Et's instead of copying the RoIs around, the
+    // scratch vectors keep their capacity so this does not allocate per event
+    const std::size_t nJets = jets->size();
+    m_sortEt.resize(nJets);
+    m_sortIndex.resize(nJets);
+    for( std::size_t i = 0; i < nJets; ++i ) {
+      m_sortEt[i] = jets->at(i)->et8x8();
+      m_sortIndex[i] = i;
     }
-    
-    std::sort(vec.begin(), vec.end(), [&](const std::vector<float> a, const std::vector<float> b) { return a.at(0) < b.at(0);});
-    for (int i = int(vec.size())-1; i >= 0; i--) {
-      m_l1Jet_et8x8->push_back((vec.at(i)).at(0) / m_units);
-      m_l1Jet_eta->push_back((vec.at(i)).at(1));
-      m_l1Jet_phi->push_back((vec.at(i)).at(2));
+
+    std::sort(m_sortIndex.begin(), m_sortIndex.end(), [this](std::size_t a, std::size_t b) { return m_sortEt[a] > m_sortEt[b] || (m_sortEt[a] == m_sortEt[b] && a < b); });
+
+    m_l1Jet_et8x8->reserve(nJets);
+    m_l1Jet_eta  ->reserve(nJets);
+    m_l1Jet_phi  ->reserve(nJets);
+    for( std::size_t idx : m_sortIndex ) {
+      const xAOD::JetRoI* jet = jets->at(idx);
+      m_l1Jet_et8x8->push_back( m_sortEt[idx] / m_units );
+      m_l1Jet_eta  ->push_back( jet->eta() );
+      m_l1Jet_phi  ->push_back( jet->phi() );
     }
-    vec.clear();
   }
 }
@@ -46,6 +46,7 @@
 
 /* Mini xAOD */
 #include <xAODAnaHelpers/MinixAOD.h>
+#include <xAODAnaHelpers/ObjectCacheReader.h>
 
 /* Other */
 #include <xAODAnaHelpers/HelperFunctions.h>
@@ -55,6 +56,9 @@
 #include <xAODAnaHelpers/Writer.h>
 #include <xAODAnaHelpers/MessagePrinterAlgo.h>
 #include <xAODAnaHelpers/MuonInFatJetCorrector.h>
+#include <xAODAnaHelpers/FillBenchmark.h>
+#include <xAODAnaHelpers/ParticleAssociation.h>
+#include <xAODAnaHelpers/ColumnBatch.h>
 
 #ifdef __CINT__
 
@@ -65,6 +69,13 @@
 
 #pragma link C++ namespace xAH;
 #pragma link C++ function xAH::addRucio;
+#pragma link C++ namespace xAH::FillBenchmark;
+#pragma link C++ struct xAH::FillBenchmark::Result+;
+#pragma link C++ function xAH::FillBenchmark::jets;
+#pragma link C++ function xAH::FillBenchmark::muons;
+#pragma link C++ function xAH::FillBenchmark::electrons;
+#pragma link C++ class xAH::ParticleAssociation+;
+#pragma link C++ class xAH::ColumnBatch+;
 
 #pragma link C++ class xAH::Algorithm+;
 
@@ -106,6 +117,7 @@
 #pragma link C++ class TreeAlgo+;
 
 #pragma link C++ class MinixAOD+;
+#pragma link C++ class ObjectCacheReader+;
 
 #pragma link C++ class OverlapRemover+;
 #pragma link C++ class TrigMatcher+;
@@ -0,0 +1,52 @@
+#include <xAODAnaHelpers/LumiBlockIntervals.h>
+
+#include <algorithm>
+
+void xAH::LumiBlockIntervals::add(uint32_t run, uint32_t first, uint32_t last)
+{
+  if(last < first) return;
+  m_runs[run].emplace_back(first, last);
+  m_hasLast = false;
+}
+
+void xAH::LumiBlockIntervals::finalize()
+{
+  for(auto& run : m_runs){
+    auto& intervals = run.second;
+    std::sort(intervals.begin(), intervals.end());
+
+    // merge overlapping and adjacent intervals
+    std::size_t n = 0;
+    for(const auto& interval : intervals){
+      if(n > 0 && interval.first <= intervals[n-1].second + 1){
+        intervals[n-1].second = std::max(intervals[n-1].second, interval.second);
+      } else {
+        intervals[n++] = interval;
+      }
+    }
+    intervals.resize(n);
+    intervals.shrink_to_fit();
+  }
+  m_hasLast = false;
+}
+
+bool xAH::LumiBlockIntervals::contains(uint32_t run, uint32_t lumiBlock) const
+{
+  if(m_hasLast && run == m_lastRun && lumiBlock == m_lastLumiBlock) return m_lastResult;
+
+  bool result = false;
+  auto itr = m_runs.find(run);
+  if(itr != m_runs.end()){
+    const auto& intervals = itr->second;
+    // the last interval starting at or before lumiBlock
+    auto next = std::upper_bound(intervals.begin(), intervals.end(), lumiBlock,
+                                 [](uint32_t lb, const std::pair<uint32_t, uint32_t>& interval){ return lb < interval.first; });
+    result = next != intervals.begin() && lumiBlock <= std::prev(next)->second;
+  }
+
+  m_hasLast = true;
+  m_lastRun = run;
+  m_lastLumiBlock = lumiBlock;
+  m_lastResult = result;
+  return result;
+}
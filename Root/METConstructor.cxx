@@ -25,6 +25,7 @@
 
 #include "xAODAnaHelpers/HelperClasses.h"
 #include "xAODAnaHelpers/HelperFunctions.h"
+#include "xAODAnaHelpers/SystematicNames.h"
 
 #include "TEnv.h"
 #include "TSystem.h"
@@ -168,8 +169,10 @@ EL::StatusCode METConstructor :: initialize ()
   }
 
   ANA_MSG_INFO("Will be using METSystematicsTool systematic:");
+  auto& systRegistry = xAH::SystematicNames::instance();
   for ( const auto& syst_it : m_sysList ) {
     ANA_MSG_INFO("\t " << syst_it.name());
+    m_sysListIDs.insert( systRegistry.intern(syst_it.name()) );
   }
 
   m_numEvent = 0; //just as a check
@@ -186,6 +189,9 @@ EL::StatusCode METConstructor :: initialize ()
 
 EL::StatusCode METConstructor :: execute ()
 {
+  auto event = beginEvent();
+  auto timer = timeExecute();
+  if ( eventRejected() ) return EL::StatusCode::SUCCESS;
    // Here you do everything that needs to be done on every single
    // events, e.g. read input variables, apply cuts, and fill
    // histograms and trees.  This is where most of your actual analysis
@@ -211,6 +217,8 @@ EL::StatusCode METConstructor :: execute ()
    //
    // get vector of string giving the Systematic names:
    //
+   auto& systRegistry = xAH::SystematicNames::instance();
+
    // load each object systematic. This is done at the execution level
    // as systematic containers have to exist. To avoid adding several
    // times the same systematic a check has to be performed on sysList
@@ -218,59 +226,83 @@ EL::StatusCode METConstructor :: execute ()
 
    //add the syst for jets
    std::vector<std::string>* sysJetsNames(nullptr);
+   xAH::SystematicIDSet sysJetsIDs;
    if(!m_runNominal && !m_jetSystematics.empty()){
      ANA_CHECK( HelperFunctions::retrieve(sysJetsNames, m_jetSystematics, 0, m_store, msg()));
 
-     for ( auto systName : *sysJetsNames ) {
-       if (systName != "" && !(std::find(m_sysList.begin(), m_sysList.end(), CP::SystematicSet(systName)) != m_sysList.end())) m_sysList.push_back(CP::SystematicSet(systName));
+     for ( const auto& systName : *sysJetsNames ) {
+       const auto systID = systRegistry.intern(systName);
+       sysJetsIDs.insert(systID);
+       if (systName != "" && m_sysListIDs.insert(systID)) m_sysList.push_back(CP::SystematicSet(systName));
        ANA_MSG_DEBUG("jet syst added is = "<< systName);
      }
    }
 
    //add the syst for electrons
    std::vector<std::string>* sysElectronsNames(nullptr);
+   xAH::SystematicIDSet sysElectronsIDs;
    if(!m_runNominal && !m_eleSystematics.empty()){
      ANA_CHECK( HelperFunctions::retrieve(sysElectronsNames, m_eleSystematics, 0, m_store, msg()));
 
-     for ( auto systName : *sysElectronsNames ) {
-       if (systName != "" && !(std::find(m_sysList.begin(), m_sysList.end(), CP::SystematicSet(systName)) != m_sysList.end())  ) m_sysList.push_back(CP::SystematicSet(systName));
+     for ( const auto& systName : *sysElectronsNames ) {
+       const auto systID = systRegistry.intern(systName);
+       sysElectronsIDs.insert(systID);
+       if (systName != "" && m_sysListIDs.insert(systID)) m_sysList.push_back(CP::SystematicSet(systName));
        ANA_MSG_DEBUG("ele syst added is = "<< systName);
      }
    }
 
    //add the syst for muons
    std::vector<std::string>* sysMuonsNames(nullptr);
+   xAH::SystematicIDSet sysMuonsIDs;
    if(!m_runNominal && !m_muonSystematics.empty()){
      ANA_CHECK( HelperFunctions::retrieve(sysMuonsNames, m_muonSystematics, 0, m_store, msg()));
 
-     for ( auto systName : *sysMuonsNames ) {
-       if (systName != "" && !(std::find(m_sysList.begin(), m_sysList.end(), CP::SystematicSet(systName)) != m_sysList.end())) m_sysList.push_back(CP::SystematicSet(systName));
+     for ( const auto& systName : *sysMuonsNames ) {
+       const auto systID = systRegistry.intern(systName);
+       sysMuonsIDs.insert(systID);
+       if (systName != "" && m_sysListIDs.insert(systID)) m_sysList.push_back(CP::SystematicSet(systName));
        ANA_MSG_DEBUG("muon syst added is = "<< systName);
      }
    }
 
    //add the syst for tau
    std::vector<std::string>* sysTausNames(nullptr);
+   xAH::SystematicIDSet sysTausIDs;
    if(!m_runNominal && !m_tauSystematics.empty()){
      ANA_CHECK( HelperFunctions::retrieve(sysTausNames, m_tauSystematics, 0, m_store, msg()));
 
-     for ( auto systName : *sysTausNames ) {
-       if (systName != "" && !(std::find(m_sysList.begin(), m_sysList.end(), CP::SystematicSet(systName)) != m_sysList.end())) m_sysList.push_back(CP::SystematicSet(systName));
+     for ( const auto& systName : *sysTausNames ) {
+       const auto systID = systRegistry.intern(systName);
+       sysTausIDs.insert(systID);
+       if (systName != "" && m_sysListIDs.insert(systID)) m_sysList.push_back(CP::SystematicSet(systName));
        ANA_MSG_DEBUG("tau syst added is = "<< systName);
      }
    }
 
    //add the syst for photons
    std::vector<std::string>* sysPhotonsNames(nullptr);
+   xAH::SystematicIDSet sysPhotonsIDs;
    if(!m_runNominal && !m_phoSystematics.empty()){
      ANA_CHECK( HelperFunctions::retrieve(sysPhotonsNames, m_phoSystematics, 0, m_store, msg()));
 
-     for ( auto systName : *sysPhotonsNames ) {
-       if (systName != "" && !(std::find(m_sysList.begin(), m_sysList.end(), CP::SystematicSet(systName)) != m_sysList.end())) m_sysList.push_back(CP::SystematicSet(systName));
+     for ( const auto& systName : *sysPhotonsNames ) {
+       const auto systID = systRegistry.intern(systName);
+       sysPhotonsIDs.insert(systID);
+       if (systName != "" && m_sysListIDs.insert(systID)) m_sysList.push_back(CP::SystematicSet(systName));
        ANA_MSG_DEBUG("photon syst added is = "<< systName);
      }
    }
 
+   // the objects passing the MET cuts, for the collections not varied by the current systematic.
+   // The terms themselves have to be rebuilt for every systematic, as each rebuildMET call
+   // updates the object selection flags of the association map used by the following terms.
+   m_nominalMetElectrons.clear();
+   m_nominalMetPhotons.clear();
+   m_nominalMetTaus.clear();
+   m_nominalMetMuons.clear();
+   bool nominalMetElectronsDone(false), nominalMetPhotonsDone(false), nominalMetTausDone(false), nominalMetMuonsDone(false);
+
    // now start the loop over systematics
    for (sysListItr = m_sysList.begin(); sysListItr != m_sysList.end(); ++sysListItr) {  // loop over systematics
 
@@ -285,6 +317,7 @@ EL::StatusCode METConstructor :: execute ()
 
       // just for convenience, to retrieve the containers
       std::string systName = (*sysListItr).name();
+      const auto systID = systRegistry.intern(systName);
 
       ANA_MSG_DEBUG(" loop over systematic = " << systName);
 
@@ -307,7 +340,7 @@ EL::StatusCode METConstructor :: execute ()
       if ( !m_inputElectrons.empty() ) {
          const xAOD::ElectronContainer* eleCont(0);
          std::string suffix = "";
-         if (sysElectronsNames && std::find(std::begin(*sysElectronsNames), std::end(*sysElectronsNames), systName) != std::end(*sysElectronsNames)) {
+         if (sysElectronsIDs.contains(systID)) {
            ANA_MSG_DEBUG("doing electron systematics");
            suffix = systName;
          }
@@ -322,8 +355,12 @@ EL::StatusCode METConstructor :: execute ()
 
          ANA_MSG_DEBUG("rebuilding MET term: RefEle");
          if (m_doElectronCuts) {
-           ConstDataVector<xAOD::ElectronContainer> metElectrons(SG::VIEW_ELEMENTS);
-           for (const auto& el : *eleCont) if (CutsMETMaker::accept(el)) metElectrons.push_back(el);
+           m_variedMetElectrons.clear();
+           ConstDataVector<xAOD::ElectronContainer>& metElectrons = suffix.empty() ? m_nominalMetElectrons : m_variedMetElectrons;
+           if (!suffix.empty() || !nominalMetElectronsDone) {
+             for (const auto& el : *eleCont) if (CutsMETMaker::accept(el)) metElectrons.push_back(el);
+             nominalMetElectronsDone |= suffix.empty();
+           }
            ANA_CHECK( m_metmaker_handle->rebuildMET("RefEle", xAOD::Type::Electron, newMet.get(), metElectrons.asDataVector(), metMap));
          } else {
            ANA_CHECK( m_metmaker_handle->rebuildMET("RefEle", xAOD::Type::Electron, newMet.get(), eleCont, metMap));
@@ -338,7 +375,7 @@ EL::StatusCode METConstructor :: execute ()
       if ( !m_inputPhotons.empty() ) {
          const xAOD::PhotonContainer* phoCont(0);
          std::string suffix = "";
-         if (sysPhotonsNames && std::find(std::begin(*sysPhotonsNames), std::end(*sysPhotonsNames), systName) != std::end(*sysPhotonsNames)) {
+         if (sysPhotonsIDs.contains(systID)) {
            ANA_MSG_DEBUG("doing photon systematics");
            suffix = systName;
          }
@@ -353,8 +390,9 @@ EL::StatusCode METConstructor :: execute ()
 
       ANA_MSG_DEBUG("rebuilding MET term: RefGamma");
       if (m_doPhotonCuts) {
-        ConstDataVector<xAOD::PhotonContainer> metPhotons(SG::VIEW_ELEMENTS);
-        for (const auto& ph : *phoCont) {
+        m_variedMetPhotons.clear();
+        ConstDataVector<xAOD::PhotonContainer>& metPhotons = suffix.empty() ? m_nominalMetPhotons : m_variedMetPhotons;
+        if (!suffix.empty() || !nominalMetPhotonsDone) for (const auto& ph : *phoCont) {
 
           bool testPID = 0;
           ph->passSelection(testPID, "Tight");
@@ -370,6 +408,7 @@ EL::StatusCode METConstructor :: execute ()
 
           metPhotons.push_back(ph);
         }
+        nominalMetPhotonsDone |= suffix.empty();
 
         ANA_CHECK( m_metmaker_handle->rebuildMET("RefGamma", xAOD::Type::Photon, newMet.get(), metPhotons.asDataVector(), metMap));
 
@@ -385,7 +424,7 @@ EL::StatusCode METConstructor :: execute ()
      if ( !m_inputTaus.empty() ) {
         const xAOD::TauJetContainer* tauCont(0);
         std::string suffix = "";
-        if (sysTausNames && std::find(std::begin(*sysTausNames), std::end(*sysTausNames), systName) != std::end(*sysTausNames)) {
+        if (sysTausIDs.contains(systID)) {
           ANA_MSG_DEBUG("doing tau systematics");
           suffix = systName;
         }
@@ -400,8 +439,9 @@ EL::StatusCode METConstructor :: execute ()
 
       ANA_MSG_DEBUG("rebuilding MET term: RefTau");
        if (m_doTauCuts) {
-         ConstDataVector<xAOD::TauJetContainer> metTaus(SG::VIEW_ELEMENTS);
-         for (const auto& tau : *tauCont) {
+         m_variedMetTaus.clear();
+         ConstDataVector<xAOD::TauJetContainer>& metTaus = suffix.empty() ? m_nominalMetTaus : m_variedMetTaus;
+         if (!suffix.empty() || !nominalMetTausDone) for (const auto& tau : *tauCont) {
 
            if (tau->pt() < 20e3) continue;
            if (fabs(tau->eta()) > 2.37) continue;
@@ -409,6 +449,7 @@ EL::StatusCode METConstructor :: execute ()
 
            metTaus.push_back(tau);
          }
+         nominalMetTausDone |= suffix.empty();
          ANA_CHECK( m_metmaker_handle->rebuildMET("RefTau", xAOD::Type::Tau, newMet.get(), metTaus.asDataVector(), metMap));
        } else {
          ANA_CHECK( m_metmaker_handle->rebuildMET("RefTau", xAOD::Type::Tau, newMet.get(), tauCont, metMap));
@@ -422,7 +463,7 @@ EL::StatusCode METConstructor :: execute ()
      if ( !m_inputMuons.empty() ) {
         const xAOD::MuonContainer* muonCont(0);
         std::string suffix = "";
-        if (sysMuonsNames && std::find(std::begin(*sysMuonsNames), std::end(*sysMuonsNames), systName) != std::end(*sysMuonsNames)) {
+        if (sysMuonsIDs.contains(systID)) {
           ANA_MSG_DEBUG("doing muon systematics");
           suffix = systName;
         }
@@ -437,8 +478,12 @@ EL::StatusCode METConstructor :: execute ()
 
         ANA_MSG_DEBUG("rebuilding MET term: Muons");
         if (m_doMuonCuts) {
-          ConstDataVector<xAOD::MuonContainer> metMuons(SG::VIEW_ELEMENTS);
-          for (const auto& mu : *muonCont) if (CutsMETMaker::accept(mu)) metMuons.push_back(mu);
+          m_variedMetMuons.clear();
+          ConstDataVector<xAOD::MuonContainer>& metMuons = suffix.empty() ? m_nominalMetMuons : m_variedMetMuons;
+          if (!suffix.empty() || !nominalMetMuonsDone) {
+            for (const auto& mu : *muonCont) if (CutsMETMaker::accept(mu)) metMuons.push_back(mu);
+            nominalMetMuonsDone |= suffix.empty();
+          }
           ANA_CHECK( m_metmaker_handle->rebuildMET("Muons", xAOD::Type::Muon, newMet.get(), metMuons.asDataVector(), metMap));
         } else {
           ANA_CHECK( m_metmaker_handle->rebuildMET("Muons", xAOD::Type::Muon, newMet.get(), muonCont, metMap));
@@ -456,7 +501,7 @@ EL::StatusCode METConstructor :: execute ()
 
      const xAOD::JetContainer* jetCont(0);
      std::string suffix = "";
-     if (sysJetsNames && std::find(std::begin(*sysJetsNames), std::end(*sysJetsNames), systName) != std::end(*sysJetsNames)) {
+     if (sysJetsIDs.contains(systID)) {
        ANA_MSG_DEBUG("doing muon systematics");
        suffix = systName;
      }
@@ -496,8 +541,7 @@ EL::StatusCode METConstructor :: execute ()
      //after this call, when we use applyCorrection, the given met term will be adjusted with this systematic applied
      // assert(   m_metSyst_handle->applySystematicVariation(systSet) );
      if (isMC()) {
-       CP::SystematicSet systSet({systName}); // to pass from SystematicVariation to SystematicSet
-       if( m_metSyst_handle->applySystematicVariation(systSet) != CP::SystematicCode::Ok) {
+       if( m_metSyst_handle->applySystematicVariation(*sysListItr) != CP::SystematicCode::Ok) {
          ANA_MSG_ERROR("not able to applySystematicVariation ");
        }
      }
@@ -533,7 +577,7 @@ EL::StatusCode METConstructor :: execute ()
 
      // Calculate MET significance if enabled
      if ( m_calculateSignificance ) {
-       std::vector<std::string> totalMETNames = {"FinalTrk", "FinalClus"};
+       static const std::vector<std::string> totalMETNames = {"FinalTrk", "FinalClus"};
 
        for ( const std::string &name : totalMETNames ) {
          // Calculate MET significance
@@ -608,6 +652,8 @@ EL::StatusCode METConstructor :: execute ()
 
 EL::StatusCode METConstructor :: postExecute ()
 {
+  auto timer = timePostExecute();
+  if ( eventRejected() ) return EL::StatusCode::SUCCESS;
   // Here you do everything that needs to be done after the main event
   // processing.  This is typically very rare, particularly in user
   // code.  It is mainly used in implementing the NTupleSvc.
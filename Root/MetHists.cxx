@@ -12,11 +12,15 @@
 
 #include <AsgTools/MessageCheck.h>
 
+ANA_MSG_SOURCE(msgMetHists, "MetHists")
+
 using std::vector;
 
 MetHists :: MetHists (std::string name, std::string detailStr) :
   HistogramManager(name, detailStr),
-  m_infoSwitch(new HelperClasses::METInfoSwitch(m_detailStr))
+  m_infoSwitch(new HelperClasses::METInfoSwitch(m_detailStr)),
+  m_finalClusIndex(0),
+  m_finalTrkIndex(0)
 {
   m_debug = false;
 }
@@ -25,46 +29,59 @@ MetHists :: ~MetHists () {
   if(m_infoSwitch) delete m_infoSwitch;
 }
 
-StatusCode MetHists::initialize() {
+void MetHists::addTermObservables( ObservableTable<xAOD::MissingET>& table, const std::string& prefix ) {
+  table.add( prefix,           prefix,           100,     0,    200, [](const xAOD::MissingET& term){ return term.met()   / 1e3; } )
+       .add( prefix+"Px",      prefix+"Px",      100,  -200,    200, [](const xAOD::MissingET& term){ return term.mpx()   / 1e3; } )
+       .add( prefix+"Py",      prefix+"Py",      100,  -200,    200, [](const xAOD::MissingET& term){ return term.mpy()   / 1e3; } )
+       .add( prefix+"SumEt",   prefix+"SumEt",   100,     0,   2000, [](const xAOD::MissingET& term){ return term.sumet() / 1e3; } )
+       .add( prefix+"Phi",     prefix+"Phi",     100,  -3.2,    3.2, [](const xAOD::MissingET& term){ return term.phi();         } );
+}
 
-  m_metFinalClus      = book(m_name,  "metFinalClus",      "metFinalClus",      100,     0,    200);
-  m_metFinalClusPx    = book(m_name,  "metFinalClusPx",    "metFinalClusPx",    100,  -200,    200);
-  m_metFinalClusPy    = book(m_name,  "metFinalClusPy",    "metFinalClusPy",    100,  -200,    200);
-  m_metFinalClusSumEt = book(m_name,  "metFinalClusSumEt", "metFinalClusSumEt", 100,     0,   2000);
-  m_metFinalClusPhi   = book(m_name,  "metFinalClusPhi",   "metFinalClusPhi",   100,    -3.2,    3.2);
+StatusCode MetHists::initialize() {
 
-  m_metFinalTrk       = book(m_name, "metFinalTrk",       "metFinalTrk",       100,     0,    200);
-  m_metFinalTrkPx     = book(m_name, "metFinalTrkPx",     "metFinalTrkPx",     100,  -200,    200);
-  m_metFinalTrkPy     = book(m_name, "metFinalTrkPy",     "metFinalTrkPy",     100,  -200,    200);
-  m_metFinalTrkSumEt  = book(m_name, "metFinalTrkSumEt",  "metFinalTrkSumEt",  100,     0,   2000);
-  m_metFinalTrkPhi    = book(m_name, "metFinalTrkPhi",    "metFinalTrkPhi",    100,    -3.2,    3.2);
+  addTermObservables( m_finalClus, "metFinalClus" );
+  addTermObservables( m_finalTrk,  "metFinalTrk"  );
+  bookTable( m_finalClus );
+  bookTable( m_finalTrk );
 
   return StatusCode::SUCCESS;
 }
 
+const xAOD::MissingET* MetHists::findTerm( const xAOD::MissingETContainer* met, const std::string& name, std::size_t& index ) {
+
+  // the terms are written in the same order every event, so this is almost always a hit
+  if ( index < met->size() && (*met)[index]->name() == name ) return (*met)[index];
+
+  xAOD::MissingETContainer::const_iterator term = met->find(name);
+  if ( term == met->end() ) return nullptr;
+  index = term - met->begin();
+  return *term;
+}
+
 StatusCode MetHists::execute( const xAOD::MissingETContainer* met, float eventWeight ) {
+  using namespace msgMetHists;
 
   if(m_debug) std::cout << "MetHists: in execute " <<std::endl;
 
   //
   // ("FinalClus" uses the calocluster-based soft terms, "FinalTrk" uses the track-based ones)
   //
-  const xAOD::MissingET* final_clus = *met->find("FinalClus");
-  m_metFinalClus      -> Fill( final_clus->met()   / 1e3, eventWeight);
-  m_metFinalClusPx    -> Fill( final_clus->mpx()   / 1e3, eventWeight);
-  m_metFinalClusPy    -> Fill( final_clus->mpy()   / 1e3, eventWeight);
-  m_metFinalClusSumEt -> Fill( final_clus->sumet() / 1e3, eventWeight);
-  m_metFinalClusPhi   -> Fill( final_clus->phi()        , eventWeight);
+  const xAOD::MissingET* final_clus = findTerm( met, "FinalClus", m_finalClusIndex );
+  if ( !final_clus ) {
+    ANA_MSG_ERROR( "No FinalClus term in the MissingETContainer");
+    return StatusCode::FAILURE;
+  }
+  fillTable( m_finalClus, *final_clus, eventWeight );
 
   //
   // ("FinalClus" uses the calocluster-based soft terms, "FinalTrk" uses the track-based ones)
   //
-  const xAOD::MissingET* final_trk = *met->find("FinalTrk");
-  m_metFinalTrk       -> Fill( final_trk->met()   / 1e3,  eventWeight);
-  m_metFinalTrkPx     -> Fill( final_trk->mpx()   / 1e3,  eventWeight);
-  m_metFinalTrkPy     -> Fill( final_trk->mpy()   / 1e3,  eventWeight);
-  m_metFinalTrkSumEt  -> Fill( final_trk->sumet() / 1e3,  eventWeight);
-  m_metFinalTrkPhi    -> Fill( final_trk->phi()        ,  eventWeight);
+  const xAOD::MissingET* final_trk = findTerm( met, "FinalTrk", m_finalTrkIndex );
+  if ( !final_trk ) {
+    ANA_MSG_ERROR( "No FinalTrk term in the MissingETContainer");
+    return StatusCode::FAILURE;
+  }
+  fillTable( m_finalTrk, *final_trk, eventWeight );
 
   return StatusCode::SUCCESS;
 }
@@ -39,6 +39,9 @@ EL::StatusCode MetHistsAlgo :: histInitialize ()
   m_plots = new MetHists(m_name, m_detailStr);
   ANA_CHECK( m_plots -> initialize());
   m_plots -> record( wk() );
+  ANA_CHECK( addHistMemory( *m_plots ));
+  addCheckpoint( m_plots );
+  reportHistMemory( "initialize", m_histBytes );
 
   return EL::StatusCode::SUCCESS;
 }
@@ -56,6 +59,9 @@ EL::StatusCode MetHistsAlgo :: initialize ()
 
 EL::StatusCode MetHistsAlgo :: execute ()
 {
+  auto event = beginEvent();
+  auto timer = timeExecute();
+  if ( eventRejected() ) return EL::StatusCode::SUCCESS;
   const xAOD::EventInfo* eventInfo(nullptr);
   ANA_CHECK( HelperFunctions::retrieve(eventInfo, m_eventInfoContainerName, m_event, m_store, msg()) );
 
@@ -74,11 +80,17 @@ EL::StatusCode MetHistsAlgo :: execute ()
 }
 
 EL::StatusCode MetHistsAlgo :: postExecute () { return EL::StatusCode::SUCCESS; }
-EL::StatusCode MetHistsAlgo :: finalize () { return EL::StatusCode::SUCCESS; }
+EL::StatusCode MetHistsAlgo :: finalize () {
+  if(m_plots) ANA_CHECK( m_plots->finalize());
+  return EL::StatusCode::SUCCESS;
+}
 EL::StatusCode MetHistsAlgo :: histFinalize ()
 {
   // clean up memory
-  if(m_plots) delete m_plots;
+  if(m_plots){
+    reportHistMemory( "finalize", m_plots->memoryBytes() );
+    delete m_plots;
+  }
 
   ANA_CHECK( xAH::Algorithm::algFinalize());
   return EL::StatusCode::SUCCESS;
@@ -1,8 +1,16 @@
 // c++ include(s):
+#include <algorithm>
 #include <iostream>
+#include <set>
 #include <typeinfo>
 #include <sstream>
 
+// ROOT include(s):
+#include "Compression.h"
+#include "TFile.h"
+#include "TROOT.h"
+#include "TTree.h"
+
 // EL include(s):
 #include <EventLoop/Job.h>
 #include <EventLoop/StatusCode.h>
@@ -31,12 +39,60 @@
 #include "xAODTau/TauJetContainer.h"
 #include "xAODTau/TauJetAuxContainer.h"
 #include "xAODTau/TauJet.h"
+#include "xAODTracking/TrackParticleContainer.h"
+#include "xAODTracking/TrackParticleAuxContainer.h"
+#include "xAODTruth/TruthParticleContainer.h"
+#include "xAODTruth/TruthParticleAuxContainer.h"
+#include "xAODCaloEvent/CaloClusterContainer.h"
+#include "xAODCaloEvent/CaloClusterAuxContainer.h"
 
 // package include(s):
 #include "xAODAnaHelpers/MinixAOD.h"
 #include "xAODAnaHelpers/HelperClasses.h"
 #include "xAODAnaHelpers/HelperFunctions.h"
 
+/// @brief How to deep-copy and record one concrete container type
+struct MinixAOD::ContainerType {
+  const char* name;
+  bool (*matches)(const xAOD::IParticleContainer* cont);
+  StatusCode (*deepCopy)(xAOD::TStore* store, const std::string& containerName, const xAOD::IParticleContainer* cont, const std::string& auxItems);
+  StatusCode (*recordOutput)(xAOD::TEvent* event, xAOD::TStore* store, std::string containerName);
+};
+
+namespace {
+  template <typename T1>
+  bool matchesContainer(const xAOD::IParticleContainer* cont){ return dynamic_cast<const T1*>(cont) != nullptr; }
+
+  template <typename T1, typename T2, typename T3>
+  StatusCode deepCopyContainer(xAOD::TStore* store, const std::string& containerName, const xAOD::IParticleContainer* cont, const std::string& auxItems){
+    return HelperFunctions::makeDeepCopy<T1, T2, T3>(store, containerName, dynamic_cast<const T1*>(cont), auxItems);
+  }
+
+  template <typename T1, typename T2, typename T3>
+  constexpr MinixAOD::ContainerType containerType(const char* name){
+    return { name, &matchesContainer<T1>, &deepCopyContainer<T1, T2, T3>, &HelperFunctions::recordOutput<T1, T2> };
+  }
+
+  const MinixAOD::ContainerType containerTypes[] = {
+    containerType<xAOD::ElectronContainer,      xAOD::ElectronAuxContainer,      xAOD::Electron>     ("Electron"),
+    containerType<xAOD::JetContainer,           xAOD::JetAuxContainer,           xAOD::Jet>          ("Jet"),
+    containerType<xAOD::MissingETContainer,     xAOD::MissingETAuxContainer,     xAOD::MissingET>    ("MissingET"),
+    containerType<xAOD::MuonContainer,          xAOD::MuonAuxContainer,          xAOD::Muon>         ("Muon"),
+    containerType<xAOD::PhotonContainer,        xAOD::PhotonAuxContainer,        xAOD::Photon>       ("Photon"),
+    containerType<xAOD::TauJetContainer,        xAOD::TauJetAuxContainer,        xAOD::TauJet>       ("TauJet"),
+    containerType<xAOD::TrackParticleContainer, xAOD::TrackParticleAuxContainer, xAOD::TrackParticle>("TrackParticle"),
+    containerType<xAOD::TruthParticleContainer, xAOD::TruthParticleAuxContainer, xAOD::TruthParticle>("TruthParticle"),
+    containerType<xAOD::CaloClusterContainer,   xAOD::CaloClusterAuxContainer,   xAOD::CaloCluster>  ("CaloCluster")
+  };
+}
+
+const MinixAOD::ContainerType* MinixAOD::findContainerType(const xAOD::IParticleContainer* cont){
+  for(const ContainerType& type : containerTypes){
+    if(type.matches(cont)) return &type;
+  }
+  return nullptr;
+}
+
 // this is needed to distribute the algorithm to the workers
 ClassImp(MinixAOD)
 
@@ -115,7 +171,28 @@ EL::StatusCode MinixAOD :: initialize ()
 
   // always do this, obviously
   TFile *file_xAOD = wk()->getOutputFile(m_outputFileName);
-  ANA_CHECK( m_event->writeTo(file_xAOD));
+
+  // set before the output tree is created, which picks them up from the file
+  if(!m_outputCompressionAlgorithm.empty()){
+    int algorithm(0);
+    if     (m_outputCompressionAlgorithm == "zlib") algorithm = ROOT::kZLIB;
+    else if(m_outputCompressionAlgorithm == "lzma") algorithm = ROOT::kLZMA;
+    else if(m_outputCompressionAlgorithm == "lz4")  algorithm = ROOT::kLZ4;
+    else {
+      ANA_MSG_ERROR("Unknown output compression algorithm " << m_outputCompressionAlgorithm << ", use zlib, lzma or lz4");
+      return EL::StatusCode::FAILURE;
+    }
+    file_xAOD->SetCompressionAlgorithm(algorithm);
+  }
+  if(m_outputCompressionLevel >= 0) file_xAOD->SetCompressionLevel(m_outputCompressionLevel);
+  ANA_MSG_DEBUG("Output compression settings: " << file_xAOD->GetCompressionSettings());
+
+  if(m_outputImplicitMTThreads > 0){
+    ANA_MSG_INFO("Enabling ROOT implicit multi-threading with " << m_outputImplicitMTThreads << " threads");
+    ROOT::EnableImplicitMT(m_outputImplicitMTThreads);
+  }
+
+  ANA_CHECK( m_event->writeTo(file_xAOD, m_outputAutoFlush));
 
   if(m_copyFileMetaData){
     m_fileMetaDataTool = new xAODMaker::FileMetaDataTool();
@@ -167,6 +244,7 @@ EL::StatusCode MinixAOD :: initialize ()
     int pos = token.find_first_of('|');
     m_deepCopyKeys_vec.push_back(std::pair<std::string, std::string>(token.substr(0, pos), token.substr(pos+1)));
   }
+  m_deepCopyTypes.assign(m_deepCopyKeys_vec.size(), nullptr);
 
   // A1|A2 B1|B2 C1|C2 ... Z1|Z2 -> {(A1, A2), (B1, B2), ..., (Z1, Z2)}
   ss.clear(); ss.str(m_vectorCopyKeys);
@@ -175,6 +253,72 @@ EL::StatusCode MinixAOD :: initialize ()
     m_vectorCopyKeys_vec.push_back(std::pair<std::string, std::string>(token.substr(0, pos), token.substr(pos+1)));
   }
 
+  // A B C D ... Z -> {A, B, C, D, ..., Z}
+  ss.clear(); ss.str(m_cacheSystNames);
+  while(std::getline(ss, token, ' '))
+    if(!token.empty()) m_cachedSystNames[token];
+
+  // the histograms of the streams booked so far are those of the algorithms before this one
+  ss.clear(); ss.str(m_cacheHistStreams);
+  while(std::getline(ss, token, ' ')){
+    if(token.empty()) continue;
+    TFile* file = wk()->getOutputFileNull(token);
+    if(!file){
+      ANA_MSG_ERROR("No output stream " << token << " of m_cacheHistStreams");
+      return EL::StatusCode::FAILURE;
+    }
+    for(TObject* obj: *file->GetList()){
+      TH1* hist = dynamic_cast<TH1*>(obj);
+      if(!hist) continue;
+      CacheHist cacheHist{token, hist, std::unique_ptr<TH1>(static_cast<TH1*>(hist->Clone())), std::unique_ptr<TH1>(static_cast<TH1*>(hist->Clone()))};
+      cacheHist.upstream->SetDirectory(nullptr);
+      cacheHist.upstream->Reset();
+      cacheHist.last->SetDirectory(nullptr);
+      cacheHist.last->Reset();
+      m_cacheHists.push_back(std::move(cacheHist));
+    }
+    ANA_MSG_INFO("Caching the histograms of the " << token << " stream filled up to " << m_name);
+  }
+  if(!m_cacheHists.empty()){
+    if(xAH::Algorithm::hasEventScopeHook()){
+      ANA_MSG_ERROR("Only one MinixAOD of the job can use m_cacheHistStreams");
+      return EL::StatusCode::FAILURE;
+    }
+    xAH::Algorithm::setEventScopeHook([this](){
+      if(wk()->treeEntry() == m_cacheHistEntry && wk()->inputFile() == m_cacheHistFile) snapshotCacheHists();
+    });
+  }
+
+  // A1|a.b.c B1|d.e ... Z1|z -> only write a, b and c of A1Aux., ...
+  // the per-event cache of HelperFunctions::getPrimaryVertexLocation() is never written, unless it is listed explicitly
+  const std::string noPVLocation = "-" + HelperFunctions::primaryVertexLocationDecor;
+  std::set<std::string> listedKeys;
+  ss.clear(); ss.str(m_auxItemLists);
+  while(std::getline(ss, token, ' ')){
+    if(token.empty()) continue;
+    std::size_t pos = token.find_first_of('|');
+    if(pos == std::string::npos){
+      ANA_MSG_ERROR("m_auxItemLists entry " << token << " is not of the form container|variables");
+      return EL::StatusCode::FAILURE;
+    }
+    const std::string key = token.substr(0, pos);
+    const std::string itemList = token.substr(pos+1);
+    ANA_MSG_DEBUG("Writing only " << itemList << " of " << key);
+    if(itemList == "*")                             m_event->setAuxItemList(key + "Aux.", noPVLocation);
+    else if(!itemList.empty() && itemList[0] == '-') m_event->setAuxItemList(key + "Aux.", itemList + "." + noPVLocation);
+    else                                            m_event->setAuxItemList(key + "Aux.", itemList);
+    listedKeys.insert(key);
+    // a deep copy only needs the variables that are written, unless some are excluded rather than listed,
+    // or the list has wildcards ("*" for all, or a pattern TEvent matches) that are no variable names
+    if(itemList.find_first_of("-*") == std::string::npos) m_deepCopyAuxItems[key] = itemList;
+  }
+  std::vector<std::string> writtenKeys(m_simpleCopyKeys_vec);
+  writtenKeys.insert(writtenKeys.end(), m_copyFromStoreToEventKeys_vec.begin(), m_copyFromStoreToEventKeys_vec.end());
+  for(const auto& keys: m_shallowCopyKeys_vec) writtenKeys.push_back(keys.first);
+  for(const auto& keys: m_deepCopyKeys_vec)    writtenKeys.push_back(keys.second);
+  for(const auto& key: writtenKeys)
+    if(!key.empty() && listedKeys.insert(key).second) m_event->setAuxItemList(key + "Aux.", noPVLocation);
+
   ANA_MSG_DEBUG("MinixAOD Interface succesfully initialized!" );
 
   return EL::StatusCode::SUCCESS;
@@ -182,6 +326,16 @@ EL::StatusCode MinixAOD :: initialize ()
 
 EL::StatusCode MinixAOD :: execute ()
 {
+  // everything filled since the algorithms after this one were done with the previous event was filled before it
+  if(!m_cacheHists.empty()){
+    addUpstreamCacheHists();
+    m_cacheHistEntry = wk()->treeEntry();
+    m_cacheHistFile  = wk()->inputFile();
+  }
+
+  auto event = beginEvent();
+  auto timer = timeExecute();
+  if ( eventRejected() ) return EL::StatusCode::SUCCESS;
   ANA_MSG_VERBOSE( "Dumping objects...");
 
   const xAOD::EventInfo* eventInfo(nullptr);
@@ -210,29 +364,25 @@ EL::StatusCode MinixAOD :: execute ()
   }
 
   // we need to make deep copies
-  for(const auto& keypair: m_deepCopyKeys_vec){
-    auto in_key = keypair.first;
-    auto out_key = keypair.second;
+  for(std::size_t iKey = 0; iKey < m_deepCopyKeys_vec.size(); ++iKey){
+    const std::string& in_key  = m_deepCopyKeys_vec[iKey].first;
+    const std::string& out_key = m_deepCopyKeys_vec[iKey].second;
 
     const xAOD::IParticleContainer* cont(nullptr);
     ANA_CHECK( HelperFunctions::retrieve(cont, in_key, nullptr, m_store, msg()));
 
-    if(const xAOD::ElectronContainer* t_cont = dynamic_cast<const xAOD::ElectronContainer*>(cont)){
-      ANA_CHECK( (HelperFunctions::makeDeepCopy<xAOD::ElectronContainer, xAOD::ElectronAuxContainer, xAOD::Electron>(m_store, out_key.c_str(), t_cont)));
-    } else if(const xAOD::JetContainer* t_cont = dynamic_cast<const xAOD::JetContainer*>(cont)){
-      ANA_CHECK( (HelperFunctions::makeDeepCopy<xAOD::JetContainer, xAOD::JetAuxContainer, xAOD::Jet>(m_store, out_key.c_str(), t_cont)));
-    } else if(const xAOD::MissingETContainer* t_cont = dynamic_cast<const xAOD::MissingETContainer*>(cont)){
-      ANA_CHECK( (HelperFunctions::makeDeepCopy<xAOD::MissingETContainer, xAOD::MissingETAuxContainer, xAOD::MissingET>(m_store, out_key.c_str(), t_cont)));
-    } else if(const xAOD::MuonContainer* t_cont = dynamic_cast<const xAOD::MuonContainer*>(cont)){
-      ANA_CHECK( (HelperFunctions::makeDeepCopy<xAOD::MuonContainer, xAOD::MuonAuxContainer, xAOD::Muon>(m_store, out_key.c_str(), t_cont)));
-    } else if(const xAOD::PhotonContainer* t_cont = dynamic_cast<const xAOD::PhotonContainer*>(cont)){
-      ANA_CHECK( (HelperFunctions::makeDeepCopy<xAOD::PhotonContainer, xAOD::PhotonAuxContainer, xAOD::Photon>(m_store, out_key.c_str(), t_cont)));
-    } else if(const xAOD::TauJetContainer* t_cont = dynamic_cast<const xAOD::TauJetContainer*>(cont)){
-      ANA_CHECK( (HelperFunctions::makeDeepCopy<xAOD::TauJetContainer, xAOD::TauJetAuxContainer, xAOD::TauJet>(m_store, out_key.c_str(), t_cont)));
-    } else {
-      ANA_MSG_ERROR("Could not identify what container " << in_key << " corresponds to for deep-copying.");
-      return EL::StatusCode::FAILURE;
+    // the type of a key does not change, resolve it on the first event
+    const ContainerType*& type = m_deepCopyTypes[iKey];
+    if(!type){
+      type = findContainerType(cont);
+      if(!type){
+        ANA_MSG_ERROR("Could not identify what container " << in_key << " corresponds to for deep-copying.");
+        return EL::StatusCode::FAILURE;
+      }
+      ANA_MSG_DEBUG("Deep-copying " << in_key << " as a " << type->name << " container");
     }
+    const auto auxItems = m_deepCopyAuxItems.find(out_key);
+    ANA_CHECK( type->deepCopy(m_store, out_key, cont, auxItems != m_deepCopyAuxItems.end() ? auxItems->second : ""));
     m_copyFromStoreToEventKeys_vec.push_back(out_key);
 
     ANA_MSG_DEBUG("Deep-Copied " << in_key << " to " << out_key << " to record to output file");
@@ -284,34 +434,58 @@ EL::StatusCode MinixAOD :: execute ()
     const xAOD::IParticleContainer* cont(nullptr);
     ANA_CHECK( HelperFunctions::retrieve(cont, key, nullptr, m_store, msg()));
 
-    if(dynamic_cast<const xAOD::ElectronContainer*>(cont)){
-      ANA_CHECK( (HelperFunctions::recordOutput<xAOD::ElectronContainer, xAOD::ElectronAuxContainer>(m_event, m_store, key)));
-    } else if(dynamic_cast<const xAOD::JetContainer*>(cont)){
-      ANA_CHECK( (HelperFunctions::recordOutput<xAOD::JetContainer, xAOD::JetAuxContainer>(m_event, m_store, key)));
-    } else if(dynamic_cast<const xAOD::MissingETContainer*>(cont)){
-      ANA_CHECK( (HelperFunctions::recordOutput<xAOD::MissingETContainer, xAOD::MissingETAuxContainer>(m_event, m_store, key)));
-    } else if(dynamic_cast<const xAOD::MuonContainer*>(cont)){
-      ANA_CHECK( (HelperFunctions::recordOutput<xAOD::MuonContainer, xAOD::MuonAuxContainer>(m_event, m_store, key)));
-    } else if(dynamic_cast<const xAOD::PhotonContainer*>(cont)){
-      ANA_CHECK( (HelperFunctions::recordOutput<xAOD::PhotonContainer, xAOD::PhotonAuxContainer>(m_event, m_store, key)));
-    } else if(dynamic_cast<const xAOD::TauJetContainer*>(cont)){
-      ANA_CHECK( (HelperFunctions::recordOutput<xAOD::TauJetContainer, xAOD::TauJetAuxContainer>(m_event, m_store, key)));
-    } else {
-      ANA_MSG_ERROR("Could not identify what container " << key << " corresponds to for copying from TStore to TEvent.");
-      return EL::StatusCode::FAILURE;
+    const ContainerType*& type = m_outputTypes[key];
+    if(!type){
+      type = findContainerType(cont);
+      if(!type){
+        ANA_MSG_ERROR("Could not identify what container " << key << " corresponds to for copying from TStore to TEvent.");
+        return EL::StatusCode::FAILURE;
+      }
     }
+    ANA_CHECK( type->recordOutput(m_event, m_store, key));
 
     ANA_MSG_DEBUG("Copied " << key << " and it's auxiliary container from TStore to TEvent");
   }
 
 
+  // the lists of systematics for the object cache, in the order they were first seen
+  for(auto& item: m_cachedSystNames){
+    if(!m_store->contains<std::vector<std::string> >(item.first)) continue;
+    std::vector<std::string>* systNames(nullptr);
+    ANA_CHECK( HelperFunctions::retrieve(systNames, item.first, nullptr, m_store, msg()));
+    for(const auto& systName: *systNames)
+      if(std::find(item.second.begin(), item.second.end(), systName) == item.second.end()) item.second.push_back(systName);
+  }
+
   m_event->fill();
+  if(m_writeEventIndex) m_eventIndex.add(eventInfo->runNumber(), eventInfo->eventNumber(), m_nEventsWritten);
+  ++m_nEventsWritten;
   ANA_MSG_DEBUG("Finished dumping objects...");
 
   return EL::StatusCode::SUCCESS;
 
 }
 
+void MinixAOD :: addUpstreamCacheHists()
+{
+  for(CacheHist& cacheHist: m_cacheHists){
+    HelperFunctions::addBinsByLabel(cacheHist.upstream.get(), cacheHist.hist);
+    HelperFunctions::addBinsByLabel(cacheHist.upstream.get(), cacheHist.last.get(), -1.);
+    snapshotCacheHist(cacheHist);
+  }
+}
+
+void MinixAOD :: snapshotCacheHists()
+{
+  for(CacheHist& cacheHist: m_cacheHists) snapshotCacheHist(cacheHist);
+}
+
+void MinixAOD :: snapshotCacheHist(CacheHist& cacheHist)
+{
+  cacheHist.last->Reset();
+  HelperFunctions::addBinsByLabel(cacheHist.last.get(), cacheHist.hist);
+}
+
 EL::StatusCode MinixAOD :: postExecute () { return EL::StatusCode::SUCCESS; }
 
 EL::StatusCode MinixAOD :: finalize () {
@@ -330,6 +504,44 @@ EL::StatusCode MinixAOD :: finalize () {
   //
   // Close file
   TFile *file_xAOD = wk()->getOutputFile(m_outputFileName);
+  if(!m_cacheHists.empty()){
+    // the algorithms before this one are finalized already, those after it not yet
+    addUpstreamCacheHists();
+    xAH::Algorithm::setEventScopeHook(std::function<void()>());
+
+    TDirectory* oldDir = gDirectory;
+    TDirectory* cacheDir = file_xAOD->mkdir("xAH_cacheHists");
+    for(CacheHist& cacheHist: m_cacheHists){
+      TDirectory* streamDir = cacheDir->GetDirectory(cacheHist.stream.c_str());
+      if(!streamDir) streamDir = cacheDir->mkdir(cacheHist.stream.c_str());
+      streamDir->cd();
+      cacheHist.upstream->Write(cacheHist.hist->GetName(), TObject::kOverwrite);
+    }
+    m_cacheHists.clear();
+    if(oldDir) oldDir->cd();
+  }
+  if(!m_cachedSystNames.empty()){
+    TDirectory* oldDir = gDirectory;
+    file_xAOD->cd();
+    std::string key;
+    std::vector<std::string> systNames;
+    TTree* systNamesTree = new TTree("xAH_systNames", "lists of systematics of the TStore");
+    systNamesTree->Branch("key",   &key);
+    systNamesTree->Branch("names", &systNames);
+    for(const auto& item: m_cachedSystNames){
+      key = item.first;
+      systNames = item.second;
+      systNamesTree->Fill();
+    }
+    systNamesTree->Write("", TObject::kOverwrite);
+    delete systNamesTree;
+    if(oldDir) oldDir->cd();
+  }
+  if(m_writeEventIndex){
+    ANA_MSG_INFO("Writing the index of the " << m_eventIndex.size() << " events of " << m_outputFileName);
+    m_eventIndex.write(file_xAOD);
+    m_eventIndex.clear();
+  }
   ANA_CHECK( m_event->finishWritingTo(file_xAOD));
 
   if(m_fileMetaDataTool) delete m_fileMetaDataTool;
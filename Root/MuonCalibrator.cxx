@@ -176,6 +176,9 @@ EL::StatusCode MuonCalibrator :: initialize ()
 
 EL::StatusCode MuonCalibrator :: execute ()
 {
+  auto event = beginEvent();
+  auto timer = timeExecute();
+  if ( eventRejected() ) return EL::StatusCode::SUCCESS;
   // Here you do everything that needs to be done on every single
   // events, e.g. read input variables, apply cuts, and fill
   // histograms and trees.  This is where most of your actual analysis
@@ -203,6 +206,10 @@ EL::StatusCode MuonCalibrator :: execute ()
   // must be a pointer to be recorded in TStore
   //
   auto vecOutContainerNames = std::make_unique< std::vector< std::string > >();
+  vecOutContainerNames->reserve( m_systList.size() );
+  // the variations which did not move any muon of this event
+  auto sameAsNominal = std::make_unique< std::vector< std::string > >();
+  const xAOD::MuonContainer* nominalMuons(nullptr);
 
   for ( const auto& syst_it : m_systList ) {
 
@@ -252,6 +259,12 @@ EL::StatusCode MuonCalibrator :: execute ()
       } // close calibration loop
     }
 
+    if ( syst_it.name().empty() ) {
+      nominalMuons = calibMuonsSC.first;
+    } else if ( m_findSameAsNominalSysts && nominalMuons && HelperFunctions::sameFourMomenta(*calibMuonsSC.first, *nominalMuons) ) {
+      sameAsNominal->push_back( syst_it.name() );
+    }
+
     ANA_MSG_DEBUG( "setOriginalObjectLink");
     if ( !xAOD::setOriginalObjectLink(*inMuons, *(calibMuonsSC.first)) ) {
       ANA_MSG_ERROR( "Failed to set original object links -- MET rebuilding cannot proceed.");
@@ -266,7 +279,7 @@ EL::StatusCode MuonCalibrator :: execute ()
     // sort after coping to CDV
     if ( m_sort ) {
       ANA_MSG_DEBUG( "sorting");
-      std::sort( calibMuonsCDV->begin(), calibMuonsCDV->end(), HelperFunctions::sort_pt );
+      HelperFunctions::sortPt( calibMuonsCDV->begin(), calibMuonsCDV->end() );
     }
 
     // add SC container to TStore
@@ -287,6 +300,9 @@ EL::StatusCode MuonCalibrator :: execute ()
   //
   ANA_MSG_DEBUG( "record m_outputAlgoSystNames");
   ANA_CHECK( m_store->record( std::move(vecOutContainerNames), m_outputAlgoSystNames));
+  if ( m_findSameAsNominalSysts ) {
+    ANA_CHECK( m_store->record( std::move(sameAsNominal), HelperFunctions::sameAsNominalName(m_outputAlgoSystNames)));
+  }
 
   // look what we have in TStore
   //
@@ -299,6 +315,8 @@ EL::StatusCode MuonCalibrator :: execute ()
 
 EL::StatusCode MuonCalibrator :: postExecute ()
 {
+  auto timer = timePostExecute();
+  if ( eventRejected() ) return EL::StatusCode::SUCCESS;
   // Here you do everything that needs to be done after the main event
   // processing.  This is typically very rare, particularly in user
   // code.  It is mainly used in implementing the NTupleSvc.
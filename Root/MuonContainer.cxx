@@ -1,4 +1,5 @@
 #include "xAODAnaHelpers/MuonContainer.h"
+#include "xAODAnaHelpers/TrigMatchBits.h"
 
 #include <iostream>
 
@@ -19,6 +20,8 @@ MuonContainer::MuonContainer(const std::string& name, const std::string& detailS
     m_isTrigMatched          = new     vector<int>               ();
     m_isTrigMatchedToChain   = new     vector<vector<int> >      ();
     m_listTrigChains         = new     vector<vector<std::string> >();
+    m_trigMatchTestedBits    = new std::vector<unsigned long long>();
+    m_isTrigMatchedBits      = new std::vector<unsigned long long>();
   }
     
   // isolation
@@ -150,6 +153,8 @@ MuonContainer::~MuonContainer()
     delete m_isTrigMatched         ;
     delete m_isTrigMatchedToChain  ;
     delete m_listTrigChains        ;
+    delete m_trigMatchTestedBits;
+    delete m_isTrigMatchedBits;
   }
     
   // isolation
@@ -282,8 +287,15 @@ void MuonContainer::setTree(TTree *tree)
 
   if ( m_infoSwitch.m_trigger ){
     connectBranch<int>         (tree, "isTrigMatched",        &m_isTrigMatched);
-    connectBranch<vector<int> >(tree, "isTrigMatchedToChain", &m_isTrigMatchedToChain );
-    connectBranch<vector<string> >(tree, "listTrigChains",    &m_listTrigChains );
+    if ( m_infoSwitch.m_triggerBits ) {
+      connectBranch<unsigned long long>(tree, "trigMatchTestedBits", &m_trigMatchTestedBits);
+      connectBranch<unsigned long long>(tree, "isTrigMatchedBits",   &m_isTrigMatchedBits);
+      m_trigChainNames = xAH::TrigMatchBits::readChains(tree);
+      m_trigChainOrder = xAH::TrigMatchBits::order(m_trigChainNames);
+    } else {
+      connectBranch<vector<int> >(tree, "isTrigMatchedToChain", &m_isTrigMatchedToChain );
+      connectBranch<vector<string> >(tree, "listTrigChains",    &m_listTrigChains );
+    }
   }
 
   if ( m_infoSwitch.m_isolation ) {
@@ -405,9 +417,21 @@ void MuonContainer::updateParticle(uint idx, Muon& muon)
 
   // trigger
   if ( m_infoSwitch.m_trigger ) {
-    muon.isTrigMatched         =     m_isTrigMatched         ->at(idx);
-    muon.isTrigMatchedToChain  =     m_isTrigMatchedToChain  ->at(idx);
-    muon.listTrigChains        =     m_listTrigChains        ->at(idx);
+    Muon::Trigger& trigger = muon.trigger.get();
+    trigger.isTrigMatched         =     m_isTrigMatched         ->at(idx);
+    if ( m_infoSwitch.m_triggerBits ) {
+      trigger.isTrigMatchedToChain.clear();
+      trigger.listTrigChains.clear();
+      if ( m_trigMatchTestedBits->at(idx) ) {
+        xAH::TrigMatchBits::unpack( m_trigMatchTestedBits->at(idx), m_isTrigMatchedBits->at(idx), trigger.isTrigMatchedToChain, trigger.listTrigChains, m_trigChainNames, m_trigChainOrder );
+      } else {
+        trigger.isTrigMatchedToChain.push_back( -1 );
+        trigger.listTrigChains.push_back( "NONE" );
+      }
+    } else {
+      trigger.isTrigMatchedToChain  =     m_isTrigMatchedToChain  ->at(idx);
+      trigger.listTrigChains        =     m_listTrigChains        ->at(idx);
+    }
   }
     
   // isolation
@@ -443,21 +467,22 @@ void MuonContainer::updateParticle(uint idx, Muon& muon)
   // scale factors w/ sys
   // per object
   if ( m_infoSwitch.m_effSF && m_mc ) {
-    
+    Muon::EffSF& effSF = muon.effSF.get();
+
     for (auto& reco : m_infoSwitch.m_recoWPs) {
-      muon.RecoEff_SF[ reco ] = (*m_RecoEff_SF)[ reco ]->at(idx);
+      effSF.RecoEff_SF[ reco ] = (*m_RecoEff_SF)[ reco ]->at(idx);
 
       for (auto& trig : m_infoSwitch.m_trigWPs) {
-        muon.TrigEff_SF[ trig+reco ] = (*m_TrigEff_SF)[ trig+reco ]->at(idx);
-        muon.TrigMCEff [ trig+reco ] = (*m_TrigMCEff )[ trig+reco ]->at(idx);
+        effSF.TrigEff_SF[ trig+reco ] = (*m_TrigEff_SF)[ trig+reco ]->at(idx);
+        effSF.TrigMCEff [ trig+reco ] = (*m_TrigMCEff )[ trig+reco ]->at(idx);
       }
     }
 
     for (auto& isol : m_infoSwitch.m_isolWPs) {
-      muon.IsoEff_SF[ isol ] = (*m_IsoEff_SF)[ isol ]->at(idx);
+      effSF.IsoEff_SF[ isol ] = (*m_IsoEff_SF)[ isol ]->at(idx);
     }
 
-    muon.TTVAEff_SF = m_TTVAEff_SF -> at(idx);
+    effSF.TTVAEff_SF = m_TTVAEff_SF -> at(idx);
   }
       // track parameters
   if ( m_infoSwitch.m_trackparams ) {
@@ -532,16 +557,22 @@ void MuonContainer::setBranches(TTree *tree)
   if ( m_infoSwitch.m_trigger ){
     // this is true if there's a match for at least one trigger chain
     setBranch<int>(tree,"isTrigMatched", m_isTrigMatched);
-    // a vector of trigger match decision for each muon trigger chain
-    setBranch<vector<int> >(tree,"isTrigMatchedToChain", m_isTrigMatchedToChain );
-    // a vector of strings for each muon trigger chain - 1:1 correspondence w/ vector above
-    setBranch<vector<string> >(tree, "listTrigChains", m_listTrigChains );
+    if ( m_infoSwitch.m_triggerBits ) {
+      // the tested and the matched chains as bits, the chain of each bit is in the tree user info
+      setBranch<unsigned long long>(tree, "trigMatchTestedBits", m_trigMatchTestedBits);
+      setBranch<unsigned long long>(tree, "isTrigMatchedBits",   m_isTrigMatchedBits);
+    } else {
+      // a vector of trigger match decision for each muon trigger chain
+      setBranch<vector<int> >(tree,"isTrigMatchedToChain", m_isTrigMatchedToChain );
+      // a vector of strings for each muon trigger chain - 1:1 correspondence w/ vector above
+      setBranch<vector<string> >(tree, "listTrigChains", m_listTrigChains );
+    }
   }
 
   if ( m_infoSwitch.m_isolation ) {
     for (auto& isol : m_infoSwitch.m_isolWPs) {
       if (!isol.empty()) {
-        setBranch<int>(tree, "isIsolated_" + isol, (*m_isIsolated)[isol]);
+        setPlannedBranch<char, int>(tree, "isIsolated_" + isol, "isIsolated_" + isol, (*m_isIsolated)[isol], -1);
       }
     }
   }
@@ -561,16 +592,16 @@ void MuonContainer::setBranches(TTree *tree)
   if ( m_infoSwitch.m_effSF && m_mc ) {
     
     for (auto& reco : m_infoSwitch.m_recoWPs) {
-      tree->Branch( (m_name + "_RecoEff_SF_Reco" + reco).c_str() , (*m_RecoEff_SF)[ reco ] );
+      setPlannedSFBranch(tree, m_name + "_RecoEff_SF_Reco" + reco, "MuRecoEff_SF_syst_Reco" + reco, (*m_RecoEff_SF)[ reco ] );
       
       for (auto& trig : m_infoSwitch.m_trigWPs) {
-        tree->Branch( (m_name + "_TrigEff_SF_" + trig + "_Reco" + reco).c_str() , (*m_TrigEff_SF)[ trig+reco ] );
-        tree->Branch( (m_name + "_TrigMCEff_" + trig + "_Reco" + reco).c_str() , (*m_TrigMCEff)[ trig+reco ] );
+        setPlannedSFBranch(tree, m_name + "_TrigEff_SF_" + trig + "_Reco" + reco, "MuTrigEff_SF_syst_" + trig + "_Reco" + reco, (*m_TrigEff_SF)[ trig+reco ] );
+        setPlannedSFBranch(tree, m_name + "_TrigMCEff_" + trig + "_Reco" + reco,  "MuTrigMCEff_syst_" + trig + "_Reco" + reco,  (*m_TrigMCEff)[ trig+reco ] );
       }
     }
     
     for (auto& isol : m_infoSwitch.m_isolWPs) {
-      tree->Branch( (m_name + "_IsoEff_SF_Iso" + isol).c_str() , (*m_IsoEff_SF)[ isol ] );
+      setPlannedSFBranch(tree, m_name + "_IsoEff_SF_Iso" + isol, "MuIsoEff_SF_syst_Iso" + isol, (*m_IsoEff_SF)[ isol ] );
     }
     
     setBranch<vector<float> >(tree,"TTVAEff_SF",  m_TTVAEff_SF);
@@ -580,7 +611,7 @@ void MuonContainer::setBranches(TTree *tree)
   if ( m_infoSwitch.m_quality ) {
     for (auto& quality : m_infoSwitch.m_recoWPs) {
       if (!quality.empty()) {
-        setBranch<int>(tree, "is" + quality, (*m_quality)[quality]);
+        setPlannedBranch<char, int>(tree, "is" + quality, "is" + quality + "Q", (*m_quality)[quality], -1);
       }
     }
   }
@@ -660,6 +691,8 @@ void MuonContainer::clear()
     m_isTrigMatched->clear();
     m_isTrigMatchedToChain->clear();
     m_listTrigChains->clear();
+    m_trigMatchTestedBits->clear();
+    m_isTrigMatchedBits->clear();
   }
 
   if ( m_infoSwitch.m_isolation ) {
@@ -782,46 +815,43 @@ void MuonContainer::FillMuon( const xAOD::IParticle* particle, const xAOD::Verte
 
   if ( m_infoSwitch.m_trigger ) {
 
-    // retrieve map<string,char> w/ <chain,isMatched>
+    // retrieve the bits w/ the tested and the matched chains, see xAH::TrigMatchBits
     //
-    static SG::AuxElement::Accessor< std::map<std::string,char> > isTrigMatchedMapMuAcc("isTrigMatchedMapMu");
-
-    std::vector<int> matches;
-    std::vector<string> trigChains;
-
-    if ( isTrigMatchedMapMuAcc.isAvailable( *muon ) ) {
-      // loop over map and fill branches
-      //
-      for ( auto const &it : (isTrigMatchedMapMuAcc( *muon )) ) {
-	matches.push_back( static_cast<int>(it.second) );
-	trigChains.push_back( static_cast<string>(it.first) );
-      }
+    static SG::AuxElement::ConstAccessor< unsigned long long > trigMatchTestedBitsMuAcc("trigMatchTestedBitsMu");
+    static SG::AuxElement::ConstAccessor< unsigned long long > isTrigMatchedBitsMuAcc("isTrigMatchedBitsMu");
+
+    if ( m_infoSwitch.m_triggerBits ) {
+      const unsigned long long testedBits  = trigMatchTestedBitsMuAcc.isAvailable( *muon ) ? trigMatchTestedBitsMuAcc( *muon ) : 0;
+      const unsigned long long matchedBits = testedBits ? isTrigMatchedBitsMuAcc( *muon ) : 0;
+      m_trigMatchTestedBits->push_back( testedBits );
+      m_isTrigMatchedBits  ->push_back( matchedBits );
+      m_isTrigMatched      ->push_back( (testedBits & matchedBits) ? 1 : 0 );
     } else {
-      matches.push_back( -1 );
-      trigChains.push_back("NONE");
-    }
+      std::vector<int> matches;
+      std::vector<string> trigChains;
+
+      if ( trigMatchTestedBitsMuAcc.isAvailable( *muon ) && trigMatchTestedBitsMuAcc( *muon ) ) {
+        // unpack the bits and fill branches
+        //
+        xAH::TrigMatchBits::unpack( trigMatchTestedBitsMuAcc( *muon ), isTrigMatchedBitsMuAcc( *muon ), matches, trigChains );
+      } else {
+        matches.push_back( -1 );
+        trigChains.push_back("NONE");
+      }
 
-    m_isTrigMatchedToChain->push_back(matches);
-    m_listTrigChains->push_back(trigChains);
+      m_isTrigMatchedToChain->push_back(matches);
+      m_listTrigChains->push_back(trigChains);
     
-    // if at least one match among the chains is found, say this muon is trigger matched
-    if ( std::find(matches.begin(), matches.end(), 1) != matches.end() ) { m_isTrigMatched->push_back(1); }
-    else { m_isTrigMatched->push_back(0); }
+      // if at least one match among the chains is found, say this muon is trigger matched
+      if ( std::find(matches.begin(), matches.end(), 1) != matches.end() ) { m_isTrigMatched->push_back(1); }
+      else { m_isTrigMatched->push_back(0); }
+    }
     
   }
   
   
-  if ( m_infoSwitch.m_isolation ) {
-    static std::map< std::string, SG::AuxElement::Accessor<char> > accIsol;
-
-    for (auto& isol : m_infoSwitch.m_isolWPs) {
-      if (!isol.empty()) {
-        std::string isolWP = "isIsolated_" + isol;
-        accIsol.insert( std::pair<std::string, SG::AuxElement::Accessor<char> > ( isol , SG::AuxElement::Accessor<char>( isolWP ) ) );
-        safeFill<char, int, xAOD::Muon>( muon, accIsol.at( isol ), m_isIsolated->at( isol ), -1 );
-      }
-    }
-  }
+  // isolation and quality working point decisions, resolved in setBranches()
+  fillPlanned(*muon);
 
   if ( m_infoSwitch.m_isolationKinematics ) {
     m_ptcone20    ->push_back( muon->isolation( xAOD::Iso::ptcone20 )    /m_units );
@@ -836,17 +866,6 @@ void MuonContainer::FillMuon( const xAOD::IParticle* particle, const xAOD::Verte
     
   }
 
-  if ( m_infoSwitch.m_quality ) {
-    static std::map< std::string, SG::AuxElement::Accessor<char> > accQuality;
-
-    for (auto& quality : m_infoSwitch.m_recoWPs) {
-      if (!quality.empty()) {
-        accQuality.insert( std::pair<std::string, SG::AuxElement::Accessor<char> > ( quality , SG::AuxElement::Accessor<char>( "is" + quality + "Q" ) ) );
-        safeFill<char, int, xAOD::Muon>( muon, accQuality.at( quality ), m_quality->at( quality ), -1 );
-      }
-    } 
-  }
-  
   const xAOD::TrackParticle* trk = muon->primaryTrackParticle();
 
   if ( m_infoSwitch.m_trackparams ) {
@@ -948,34 +967,10 @@ void MuonContainer::FillMuon( const xAOD::IParticle* particle, const xAOD::Verte
 
   if ( m_infoSwitch.m_effSF && m_mc ) {
 
-    std::vector<float> junkSF(1,-1.0);
-    std::vector<float> junkEff(1,-1.0);
-
-    static std::map< std::string, SG::AuxElement::Accessor< std::vector< float > > > accRecoSF;
-    static std::map< std::string, SG::AuxElement::Accessor< std::vector< float > > > accTrigSF;
-    static std::map< std::string, SG::AuxElement::Accessor< std::vector< float > > > accTrigEFF;
-    for (auto& reco : m_infoSwitch.m_recoWPs) {
-      std::string recoEffSF = "MuRecoEff_SF_syst_Reco" + reco;
-      accRecoSF.insert( std::pair<std::string, SG::AuxElement::Accessor< std::vector< float > > > ( reco , SG::AuxElement::Accessor< std::vector< float > >( recoEffSF ) ) );
-      safeSFVecFill<float, xAOD::Muon>( muon, accRecoSF.at( reco ), m_RecoEff_SF->at( reco ), junkSF );
-
-      for (auto& trig : m_infoSwitch.m_trigWPs) {
-        std::string trigEffSF = "MuTrigEff_SF_syst_" + trig + "_Reco" + reco;
-        accTrigSF.insert( std::pair<std::string, SG::AuxElement::Accessor< std::vector< float > > > ( trig+reco , SG::AuxElement::Accessor< std::vector< float > >( trigEffSF ) ) );
-        safeSFVecFill<float, xAOD::Muon>( muon, accTrigSF.at( trig+reco ), m_TrigEff_SF->at( trig+reco ), junkSF );
-
-        std::string trigMCEff = "MuTrigMCEff_syst_" + trig + "_Reco" + reco;
-        accTrigEFF.insert( std::pair<std::string, SG::AuxElement::Accessor< std::vector< float > > > ( trig+reco , SG::AuxElement::Accessor< std::vector< float > >( trigMCEff ) ) );
-        safeSFVecFill<float, xAOD::Muon>( muon, accTrigEFF.at( trig+reco ), m_TrigMCEff->at( trig+reco ), junkEff );
-      }
-    }
+    static const std::vector<float> junkSF(1,-1.0);
 
-    static std::map< std::string, SG::AuxElement::Accessor< std::vector< float > > > accIsoSF;
-    for (auto& isol : m_infoSwitch.m_isolWPs) {
-      std::string isolEffSF = "MuIsoEff_SF_syst_Iso" + isol;
-      accIsoSF.insert( std::pair<std::string, SG::AuxElement::Accessor< std::vector< float > > > ( isol , SG::AuxElement::Accessor< std::vector< float > >( isolEffSF ) ) );
-      safeSFVecFill<float, xAOD::Muon>( muon, accIsoSF.at( isol ), m_IsoEff_SF->at( isol ), junkSF );
-    }
+    // reco, trigger and isolation working points, resolved in setBranches()
+    fillPlannedSFs(*muon);
 
     static SG::AuxElement::Accessor< std::vector< float > > accTTVASF("MuTTVAEff_SF_syst_TTVA");
     safeSFVecFill<float, xAOD::Muon>( muon, accTTVASF, m_TTVAEff_SF, junkSF );
@@ -25,6 +25,7 @@
 #include "xAODAnaHelpers/HelperFunctions.h"
 #include "xAODAnaHelpers/HelperClasses.h"
 #include "xAODAnaHelpers/MuonEfficiencyCorrector.h"
+#include "xAODAnaHelpers/RunContext.h"
 #include "MuonEfficiencyCorrections/MuonEfficiencyScaleFactors.h"
 #include "MuonEfficiencyCorrections/MuonTriggerScaleFactors.h"
 
@@ -254,7 +255,11 @@ EL::StatusCode MuonEfficiencyCorrector :: initialize ()
   std::istringstream ss(m_MuTrigLegs);
   while ( std::getline(ss, token, ',') ) {
     size_t pos = token.find(":");
-    m_SingleMuTriggerMap[token.substr(0,pos)] = token.substr(pos+1);
+    const std::string years = token.substr(0,pos);
+    int year = 0;
+    if ( years.find("2015") != std::string::npos ) year = 2015;
+    else if ( years.find("2016") != std::string::npos || years.find("2017") != std::string::npos || years.find("2018") != std::string::npos ) year = 2016;
+    m_SingleMuTriggerMap[years] = { token.substr(pos+1), year };
   }
 
   if(not trigEffSFInstanceExists){
@@ -349,6 +354,9 @@ EL::StatusCode MuonEfficiencyCorrector :: initialize ()
 
 EL::StatusCode MuonEfficiencyCorrector :: execute ()
 {
+  auto event = beginEvent();
+  auto timer = timeExecute();
+  if ( eventRejected() ) return EL::StatusCode::SUCCESS;
   // Here you do everything that needs to be done on every single
   // events, e.g. read input variables, apply cuts, and fill
   // histograms and trees.  This is where most of your actual analysis
@@ -417,6 +425,8 @@ EL::StatusCode MuonEfficiencyCorrector :: execute ()
 
 EL::StatusCode MuonEfficiencyCorrector :: postExecute ()
 {
+  auto timer = timePostExecute();
+  if ( eventRejected() ) return EL::StatusCode::SUCCESS;
   // Here you do everything that needs to be done after the main event
   // processing.  This is typically very rare, particularly in user
   // code.  It is mainly used in implementing the NTupleSvc.
@@ -491,12 +501,26 @@ EL::StatusCode MuonEfficiencyCorrector :: executeSF ( const xAOD::EventInfo* eve
 
     if ( writeSystNames ) sysVariationNamesReco = std::make_unique< std::vector< std::string > >();
 
+    // Create the name of the SF weight to be recorded
+    std::string sfName = "MuRecoEff_SF_syst_Reco" + m_WorkingPointReco;
+    SG::AuxElement::Decorator< std::vector<float> > sfVecReco( sfName );
+    SG::AuxElement::Decorator< std::vector<std::string> > sfVecReco_sysNames( m_outputSystNamesReco + "_sysNames" );
+
+    // every variation appends one SF per object: create the vectors once, with room for all variations
+    const std::size_t nVariations = nominal ? m_systListReco.size() : 1;
+    for ( auto mu_itr : *(inputMuons) ) {
+      if ( !sfVecReco.isAvailable( *mu_itr ) ) {
+        sfVecReco( *mu_itr ) = std::vector<float>();
+      }
+      sfVecReco( *mu_itr ).reserve( sfVecReco( *mu_itr ).size() + nVariations );
+      if ( !sfVecReco_sysNames.isAvailable( *mu_itr ) ) {
+        sfVecReco_sysNames( *mu_itr ) = std::vector<std::string>();
+      }
+    }
+
     for ( const auto& syst_it : m_systListReco ) {
       if ( !syst_it.name().empty() && !nominal ) continue;
 
-      // Create the name of the SF weight to be recorded
-      std::string sfName = "MuRecoEff_SF_syst_Reco" + m_WorkingPointReco;
-
       ANA_MSG_DEBUG( "Muon reco efficiency SF sys name (to be recorded in xAOD::TStore) is: " << syst_it.name() );
       if( writeSystNames ) sysVariationNamesReco->push_back(syst_it.name());
 
@@ -527,15 +551,6 @@ EL::StatusCode MuonEfficiencyCorrector :: executeSF ( const xAOD::EventInfo* eve
 
     	 // b)
     	 // obtain reco efficiency SF as a float (to be stored away separately)
-    	 //
-    	 //  If SF decoration vector doesn't exist, create it (will be done only for the 1st systematic for *this* muon)
-    	 //
-
-    	 SG::AuxElement::Decorator< std::vector<float> > sfVecReco( sfName );
-    	 if ( !sfVecReco.isAvailable( *mu_itr ) ) {
-  	   sfVecReco( *mu_itr ) = std::vector<float>();
-    	 }
-
     	 float recoEffSF(-1.0);
     	 if ( m_muRecoSF_tool->getEfficiencyScaleFactor( *mu_itr, recoEffSF ) != CP::CorrectionCode::Ok ) {
          if ( m_AllowZeroSF ) {
@@ -553,10 +568,6 @@ EL::StatusCode MuonEfficiencyCorrector :: executeSF ( const xAOD::EventInfo* eve
 
          // reco sys names are saved in a vector. Entries positions are preserved!
          //
-    	 SG::AuxElement::Decorator< std::vector<std::string> > sfVecReco_sysNames( m_outputSystNamesReco + "_sysNames" );
-    	 if ( !sfVecReco_sysNames.isAvailable( *mu_itr ) ) {
-  	   sfVecReco_sysNames( *mu_itr ) = std::vector<std::string>();
-         }
     	 sfVecReco_sysNames( *mu_itr ).push_back( syst_it.name().c_str() );
 
          ANA_MSG_DEBUG( "===>>>");
@@ -573,6 +584,8 @@ EL::StatusCode MuonEfficiencyCorrector :: executeSF ( const xAOD::EventInfo* eve
 
     }  // close loop on reco efficiency SF systematics
 
+    if ( m_writeEventSFProducts && nominal ) decorateEventSFProduct( eventInfo, inputMuons, sfName, m_systListReco.size() );
+
     // Add list of systematics names to TStore
     // We only do this once per event if the list does not exist yet
     if ( writeSystNames && !m_store->contains<std::vector<std::string>>( m_outputSystNamesReco ) ) {
@@ -596,12 +609,22 @@ EL::StatusCode MuonEfficiencyCorrector :: executeSF ( const xAOD::EventInfo* eve
 
     if ( writeSystNames ) sysVariationNamesIso = std::make_unique< std::vector< std::string > >();
 
+    // Create the name of the SF weight to be recorded
+    std::string sfName = "MuIsoEff_SF_syst_Iso" + m_WorkingPointIso;
+    SG::AuxElement::Decorator< std::vector<float> > sfVecIso( sfName );
+
+    // every variation appends one SF per object: create the vectors once, with room for all variations
+    const std::size_t nVariations = nominal ? m_systListIso.size() : 1;
+    for ( auto mu_itr : *(inputMuons) ) {
+      if ( !sfVecIso.isAvailable( *mu_itr ) ) {
+        sfVecIso( *mu_itr ) = std::vector<float>();
+      }
+      sfVecIso( *mu_itr ).reserve( sfVecIso( *mu_itr ).size() + nVariations );
+    }
+
     for ( const auto& syst_it : m_systListIso ) {
       if ( !syst_it.name().empty() && !nominal ) continue;
 
-      // Create the name of the SF weight to be recorded
-      std::string sfName = "MuIsoEff_SF_syst_Iso" + m_WorkingPointIso;
-
       ANA_MSG_DEBUG( "Muon iso efficiency SF sys name (to be recorded in xAOD::TStore) is: " << syst_it.name() );
       if ( writeSystNames ) sysVariationNamesIso->push_back(syst_it.name());
 
@@ -632,14 +655,6 @@ EL::StatusCode MuonEfficiencyCorrector :: executeSF ( const xAOD::EventInfo* eve
 
     	 // b)
     	 // obtain iso efficiency SF as a float (to be stored away separately)
-    	 //
-    	 //  If SF decoration vector doesn't exist, create it (will be done only for the 1st systematic for *this* muon)
-    	 //
-    	 SG::AuxElement::Decorator< std::vector<float> > sfVecIso( sfName );
-    	 if ( !sfVecIso.isAvailable( *mu_itr ) ) {
-  	   sfVecIso( *mu_itr ) = std::vector<float>();
-    	 }
-
     	 float IsoEffSF(-1.0);
     	 if ( m_muIsoSF_tool->getEfficiencyScaleFactor( *mu_itr, IsoEffSF ) != CP::CorrectionCode::Ok ) {
          if ( m_AllowZeroSF ) {
@@ -669,6 +684,8 @@ EL::StatusCode MuonEfficiencyCorrector :: executeSF ( const xAOD::EventInfo* eve
 
     }  // close loop on isolation efficiency SF systematics
 
+    if ( m_writeEventSFProducts && nominal ) decorateEventSFProduct( eventInfo, inputMuons, sfName, m_systListIso.size() );
+
     // Add list of systematics names to TStore
     // We only do this once per event if the list does not exist yet
     if ( writeSystNames && !m_store->contains<std::vector<std::string>>( m_outputSystNamesIso ) ) {
@@ -693,17 +710,13 @@ EL::StatusCode MuonEfficiencyCorrector :: executeSF ( const xAOD::EventInfo* eve
   //
   if ( !isToolAlreadyUsed(m_trigEffSF_tool_name) ) {
 
-    static const SG::AuxElement::ConstAccessor<unsigned int> acc_rnd("RandomRunNumber");
-    unsigned int run=0;
-    if (acc_rnd.isAvailable(*eventInfo)){
-      run = acc_rnd(*eventInfo);
-    }
+    const int year = xAH::RunContext::get(*eventInfo).year;
 
     for (auto const& trig : m_SingleMuTriggerMap) {
 
-      auto trig_it = trig.second;
-      if (trig.first.find("2015")!=std::string::npos && run>284484) continue;
-      else if ((trig.first.find("2016")!=std::string::npos || trig.first.find("2017")!=std::string::npos || trig.first.find("2018")!=std::string::npos) && run<=284484) continue;
+      const std::string& trig_it = trig.second.trigger;
+      if (trig.second.year == 2015 && year > 2015) continue;
+      else if (trig.second.year > 2015 && year <= 2015) continue;
 
       std::unique_ptr< std::vector< std::string > > sysVariationNamesTrig = nullptr;
       if ( writeSystNames ) sysVariationNamesTrig = std::make_unique< std::vector< std::string > >();
@@ -897,12 +910,22 @@ EL::StatusCode MuonEfficiencyCorrector :: executeSF ( const xAOD::EventInfo* eve
 
     if ( writeSystNames ) sysVariationNamesTTVA = std::make_unique< std::vector< std::string > >();
 
+    // Create the name of the SF weight to be recorded
+    std::string sfName = "MuTTVAEff_SF_syst_" + m_WorkingPointTTVA;
+    SG::AuxElement::Decorator< std::vector<float> > sfVecTTVA( sfName );
+
+    // every variation appends one SF per object: create the vectors once, with room for all variations
+    const std::size_t nVariations = nominal ? m_systListTTVA.size() : 1;
+    for ( auto mu_itr : *(inputMuons) ) {
+      if ( !sfVecTTVA.isAvailable( *mu_itr ) ) {
+        sfVecTTVA( *mu_itr ) = std::vector<float>();
+      }
+      sfVecTTVA( *mu_itr ).reserve( sfVecTTVA( *mu_itr ).size() + nVariations );
+    }
+
     for ( const auto& syst_it : m_systListTTVA ) {
       if ( !syst_it.name().empty() && !nominal ) continue;
 
-      // Create the name of the SF weight to be recorded
-      std::string sfName = "MuTTVAEff_SF_syst_" + m_WorkingPointTTVA;
-
       ANA_MSG_DEBUG( "Muon iso efficiency SF sys name (to be recorded in xAOD::TStore) is: " << syst_it.name() );
       if ( writeSystNames ) sysVariationNamesTTVA->push_back(syst_it.name());
 
@@ -937,14 +960,6 @@ EL::StatusCode MuonEfficiencyCorrector :: executeSF ( const xAOD::EventInfo* eve
 
     	 // b)
     	 // obtain TTVA efficiency SF as a float (to be stored away separately)
-    	 //
-    	 //  If SF decoration vector doesn't exist, create it (will be done only for the 1st systematic for *this* muon)
-    	 //
-    	 SG::AuxElement::Decorator< std::vector<float> > sfVecTTVA( sfName );
-    	 if ( !sfVecTTVA.isAvailable( *mu_itr ) ) {
-  	   sfVecTTVA( *mu_itr ) = std::vector<float>();
-    	 }
-
     	 float TTVAEffSF(-1.0);
     	 if ( m_muTTVASF_tool->getEfficiencyScaleFactor( *mu_itr, TTVAEffSF ) != CP::CorrectionCode::Ok ) {
          if ( m_AllowZeroSF ) {
@@ -974,6 +989,8 @@ EL::StatusCode MuonEfficiencyCorrector :: executeSF ( const xAOD::EventInfo* eve
 
     }  // close loop on TTVA efficiency SF systematics
 
+    if ( m_writeEventSFProducts && nominal ) decorateEventSFProduct( eventInfo, inputMuons, sfName, m_systListTTVA.size() );
+
     // Add list of systematics names to TStore
     // We only do this once per event if the list does not exist yet
     if ( writeSystNames && !m_store->contains<std::vector<std::string>>( m_outputSystNamesTTVA ) ) {
@@ -983,3 +1000,16 @@ EL::StatusCode MuonEfficiencyCorrector :: executeSF ( const xAOD::EventInfo* eve
 
   return EL::StatusCode::SUCCESS;
 }
+
+void MuonEfficiencyCorrector :: decorateEventSFProduct ( const xAOD::EventInfo* eventInfo, const xAOD::MuonContainer* inputMuons, const std::string& sfName, std::size_t nVariations )
+{
+  SG::AuxElement::ConstAccessor< std::vector<float> > sfVec( sfName );
+
+  m_sfProducts.reset( nVariations );
+  for ( auto mu_itr : *(inputMuons) ) {
+    if ( sfVec.isAvailable( *mu_itr ) ) m_sfProducts.multiply( sfVec( *mu_itr ) );
+  }
+
+  SG::AuxElement::Decorator< std::vector<float> > sfVecEvent( sfName + "_product" );
+  sfVecEvent( *eventInfo ) = m_sfProducts.products();
+}
@@ -28,5 +28,8 @@ EL::StatusCode MuonHistsAlgo::AddHists( std::string name ) {
 }
 
 EL::StatusCode MuonHistsAlgo :: execute () {
+  auto event = beginEvent();
+  auto timer = timeExecute();
+  if ( eventRejected() ) return EL::StatusCode::SUCCESS;
   return IParticleHistsAlgo::execute<MuonHists, xAOD::MuonContainer>();
 }
@@ -15,6 +15,7 @@
 #include "xAODAnaHelpers/MuonInFatJetCorrector.h"
 #include "xAODAnaHelpers/HelperClasses.h"
 #include "xAODAnaHelpers/HelperFunctions.h"
+#include "xAODAnaHelpers/ParticleAssociation.h"
 
 
 // Needed to distribute the algorithm to the workers
@@ -72,6 +73,9 @@ EL::StatusCode MuonInFatJetCorrector :: initialize()
 
 EL::StatusCode MuonInFatJetCorrector :: execute()
 {
+  auto event = beginEvent();
+  auto timer = timeExecute();
+  if ( eventRejected() ) return EL::StatusCode::SUCCESS;
   //
   // Do muon matching
   ANA_CHECK(matchTrackJetsToMuons());
@@ -115,6 +119,8 @@ EL::StatusCode MuonInFatJetCorrector :: execute()
 
 EL::StatusCode MuonInFatJetCorrector :: postExecute ()
 {
+  auto timer = timePostExecute();
+  if ( eventRejected() ) return EL::StatusCode::SUCCESS;
   ANA_MSG_DEBUG("Calling postExecute");
 
   return EL::StatusCode::SUCCESS;
@@ -188,35 +194,13 @@ TLorentzVector MuonInFatJetCorrector::getHbbCorrectedVector(const xAOD::Jet& jet
   std::vector<const xAOD::Muon*> matched_muons;
   for (const xAOD::Jet* trackJet : associated_trackJets_filtered)
     {
+      // the closest muon of a track jet is the same for all fat jets and systematics
       const xAOD::Muon* closest_muon=nullptr;
-      float maxDR=m_muonDrMax;
-
-      // get muons from jet decoration
-      static const SG::AuxElement::Accessor<std::vector<ElementLink<xAOD::MuonContainer>>> acc_MuonsInTrackJet("MuonsInTrackJet");
-
-      if(!acc_MuonsInTrackJet.isAvailable(*trackJet))
-	{
-	  ANA_MSG_FATAL("No muons associated to track jet.");
-	  return TLorentzVector();
-	}
-
-      std::vector<ElementLink<xAOD::MuonContainer>> associated_muons=acc_MuonsInTrackJet(*trackJet);	    
-      for (const ElementLink<xAOD::MuonContainer>& muonEL : associated_muons)
-	{
-	  const xAOD::Muon* muon=(*muonEL);
-
-	  // muon quality selection
-	  if (muon->pt() < m_muonPtMin) continue;
-	  if (muon->quality() > xAOD::Muon::Medium) continue;
-	  if (fabs(muon->eta()) > m_muonEtaMax) continue;
-	  // find clostest muon
-	  float DR = trackJet->p4().DeltaR(muon->p4());
-	  float cutDR=std::min(0.4,0.04 + 10000.0/muon->pt());
-	  if (DR > cutDR) continue;
-	  if (DR > maxDR) continue;
-	  maxDR = DR;
-	  closest_muon = muon;
-	}
+      auto cached = m_closestMuon.find(trackJet);
+      if (cached != m_closestMuon.end())
+	closest_muon = cached->second;
+      else if (!findClosestMuon(*trackJet, closest_muon))
+	return TLorentzVector();
 
       // check if the closest muon was already selected
       if(std::find(matched_muons.begin(),matched_muons.end(),closest_muon)!=matched_muons.end())
@@ -238,7 +222,46 @@ TLorentzVector MuonInFatJetCorrector::getHbbCorrectedVector(const xAOD::Jet& jet
   return corrected_jet;
 }
 
-EL::StatusCode MuonInFatJetCorrector::matchTrackJetsToMuons() const
+bool MuonInFatJetCorrector::findClosestMuon(const xAOD::Jet& trackJet, const xAOD::Muon*& closest_muon) const
+{
+  closest_muon=nullptr;
+  float maxDR=m_muonDrMax;
+
+  // get muons from jet decoration
+  static const SG::AuxElement::Accessor<std::vector<ElementLink<xAOD::MuonContainer>>> acc_MuonsInTrackJet("MuonsInTrackJet");
+
+  if(!acc_MuonsInTrackJet.isAvailable(trackJet))
+    {
+      ANA_MSG_FATAL("No muons associated to track jet.");
+      return false;
+    }
+
+  const std::vector<ElementLink<xAOD::MuonContainer>>& associated_muons=acc_MuonsInTrackJet(trackJet);
+  for (const ElementLink<xAOD::MuonContainer>& muonEL : associated_muons)
+    {
+      const xAOD::Muon* muon=(*muonEL);
+
+      // muon quality selection
+      if (muon->pt() < m_muonPtMin) continue;
+      if (muon->quality() > xAOD::Muon::Medium) continue;
+      if (fabs(muon->eta()) > m_muonEtaMax) continue;
+      // find clostest muon
+      const float muonEta = muon->eta();
+      const float muonPhi = muon->phi();
+      float DR2 = 0;
+      HelperFunctions::deltaR2(trackJet.eta(), trackJet.phi(), &muonEta, &muonPhi, 1, &DR2);
+      float DR = std::sqrt(DR2);
+      float cutDR=std::min(0.4,0.04 + 10000.0/muon->pt());
+      if (DR > cutDR) continue;
+      if (DR > maxDR) continue;
+      maxDR = DR;
+      closest_muon = muon;
+    }
+
+  return true;
+}
+
+EL::StatusCode MuonInFatJetCorrector::matchTrackJetsToMuons()
 {
   // retrieve muons from StoreGate
   const xAOD::MuonContainer *muons(nullptr);
@@ -250,24 +273,31 @@ EL::StatusCode MuonInFatJetCorrector::matchTrackJetsToMuons() const
 
   // decorate all track jets by default, no selection, no muon overlap removal (will be done later)
   static SG::AuxElement::Decorator<std::vector<ElementLink<xAOD::MuonContainer>>> dec_MuonsInTrackJet("MuonsInTrackJet");
-  for (const xAOD::Jet* trackJet : *trackJets)
+  // the muons near each track jet, shared with the other algorithms using the same association
+  const xAH::ParticleAssociation* muonsInTrackJets(nullptr);
+  ANA_CHECK(xAH::ParticleAssociation::retrieve(muonsInTrackJets, trackJets, m_trackJetContainerName, muons, m_muonContainerName, m_muonDrMax, m_store));
+
+  m_closestMuon.clear();
+  for (uint32_t iJet=0; iJet<trackJets->size(); ++iJet)
     {
+      const xAOD::Jet* trackJet = (*trackJets)[iJet];
+
       std::vector<ElementLink<xAOD::MuonContainer>> muons_in_jet;
-      uint32_t idx=0;
-      for (const xAOD::Muon* muon : *muons)
+      muons_in_jet.reserve(muonsInTrackJets->end(iJet) - muonsInTrackJets->begin(iJet));
+      for (uint32_t k=muonsInTrackJets->begin(iJet); k<muonsInTrackJets->end(iJet); ++k)
 	{
-	  float DR=trackJet->p4().DeltaR(muon->p4());
-	  if (DR < m_muonDrMax)
-	    {
-	      ElementLink<xAOD::MuonContainer> muonEL(*muons, idx);
-	      muons_in_jet.push_back(muonEL);
-	    }
-	  ++idx;
+	  ElementLink<xAOD::MuonContainer> muonEL(*muons, muonsInTrackJets->index(k));
+	  muons_in_jet.push_back(muonEL);
 	}
 
       dec_MuonsInTrackJet(*trackJet) = muons_in_jet;
 
       ANA_MSG_DEBUG("Found " << muons_in_jet.size() << " muons within R < " << m_muonDrMax << " of associated track jet.");
+
+      // select the closest muon once per event, instead of once per fat jet and systematic
+      const xAOD::Muon* closest_muon=nullptr;
+      if (findClosestMuon(*trackJet, closest_muon))
+	m_closestMuon[trackJet] = closest_muon;
     }
 
   return StatusCode::SUCCESS;
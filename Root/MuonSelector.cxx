@@ -1,6 +1,7 @@
 // c++ include(s):
 #include <iostream>
 #include <typeinfo>
+#include <algorithm>
 #include <tuple>
 
 // EL include(s):
@@ -20,6 +21,8 @@
 #include "xAODAnaHelpers/MuonSelector.h"
 #include "xAODAnaHelpers/HelperClasses.h"
 #include "xAODAnaHelpers/HelperFunctions.h"
+#include "xAODAnaHelpers/SelectionFlags.h"
+#include "xAODAnaHelpers/TrigMatchBits.h"
 #include "PATCore/TAccept.h"
 #include "TrigConfxAOD/xAODConfigTool.h"
 // tool includes
@@ -145,6 +148,8 @@ EL::StatusCode MuonSelector :: initialize ()
     // retrieve the object cutflow
     //
     m_mu_cutflowHist_1  = (TH1D*)file->Get("cutflow_muons_1");
+    m_mu_cutflowCounter_1.setHist( m_mu_cutflowHist_1 );
+    addCheckpoint( &m_mu_cutflowCounter_1 );
 
     m_mu_cutflow_all                  = m_mu_cutflowHist_1->GetXaxis()->FindBin("all");
     m_mu_cutflow_eta_and_quaility_cut = m_mu_cutflowHist_1->GetXaxis()->FindBin("eta_and_quality_cut");
@@ -161,6 +166,8 @@ EL::StatusCode MuonSelector :: initialize ()
 
     if ( m_isUsedBefore ) {
       m_mu_cutflowHist_2 = (TH1D*)file->Get("cutflow_muons_2");
+      m_mu_cutflowCounter_2.setHist( m_mu_cutflowHist_2 );
+      addCheckpoint( &m_mu_cutflowCounter_2 );
 
       m_mu_cutflow_all 		 = m_mu_cutflowHist_2->GetXaxis()->FindBin("all");
       m_mu_cutflow_eta_and_quaility_cut = m_mu_cutflowHist_2->GetXaxis()->FindBin("eta_and_quality_cut");
@@ -224,6 +231,7 @@ EL::StatusCode MuonSelector :: initialize ()
     while ( std::getline(ss, token, ',') ) {
       m_IsoKeys.push_back(token);
     }
+    m_isoDecisions.setWPs(m_IsoKeys, m_MinIsoWPCut);
   }
 
   if ( m_inContainerName.empty() ){
@@ -231,6 +239,13 @@ EL::StatusCode MuonSelector :: initialize ()
     return EL::StatusCode::FAILURE;
   }
 
+  // the bit of the selection decision in the flag word of the objects
+  m_passSelBit = xAH::SelectionFlags::bit( "passSel" );
+  if ( m_passSelBit < 0 ) {
+    ANA_MSG_ERROR( "No bit left in the selection flags for passSel" );
+    return EL::StatusCode::FAILURE;
+  }
+
   m_numEvent      = 0;
   m_numObject     = 0;
   m_numEventPass  = 0;
@@ -246,10 +261,12 @@ EL::StatusCode MuonSelector :: initialize ()
   // Set eta and quality requirements in order to accept the muon - ID tracks required by default
   //
 
-  ANA_CHECK( m_muonSelectionTool_handle.setProperty( "MaxEta", static_cast<double>(m_eta_max) ));
-  ANA_CHECK( m_muonSelectionTool_handle.setProperty( "MuQuality", m_muonQuality ));
-  ANA_CHECK( m_muonSelectionTool_handle.setProperty( "OutputLevel", msg().level() ));
-  ANA_CHECK( m_muonSelectionTool_handle.retrieve());
+  ANA_CHECK( retrieveSharedTool(m_muonSelectionTool_handle, toolConfig(m_eta_max, m_muonQuality), [&]() -> StatusCode {
+    ANA_CHECK( m_muonSelectionTool_handle.setProperty( "MaxEta", static_cast<double>(m_eta_max) ));
+    ANA_CHECK( m_muonSelectionTool_handle.setProperty( "MuQuality", m_muonQuality ));
+    ANA_CHECK( m_muonSelectionTool_handle.setProperty( "OutputLevel", msg().level() ));
+    return m_muonSelectionTool_handle.retrieve();
+  }));
   ANA_MSG_DEBUG("Retrieved tool: " << m_muonSelectionTool_handle);
 
   if(m_doIsolation){
@@ -261,38 +278,44 @@ EL::StatusCode MuonSelector :: initialize ()
 
     // Do this only for the first WP in the list
     ANA_MSG_DEBUG( "Adding isolation WP " << m_IsoKeys.at(0) << " to IsolationSelectionTool" );
-    ANA_CHECK( m_isolationSelectionTool_handle.setProperty("MuonWP", (m_IsoKeys.at(0)).c_str()));
-    ANA_CHECK( m_isolationSelectionTool_handle.setProperty("OutputLevel", msg().level() ));
-    ANA_CHECK( m_isolationSelectionTool_handle.retrieve());
-    ANA_MSG_DEBUG("Retrieved tool: " << m_isolationSelectionTool_handle);
-    m_isolationSelectionTool = dynamic_cast<CP::IsolationSelectionTool*>(m_isolationSelectionTool_handle.get() ); // see header file for why
-
-    // Add the remaining input WPs to the tool
-    // (start from 2nd element)
-    //
-    for ( auto WP_itr = std::next(m_IsoKeys.begin()); WP_itr != m_IsoKeys.end(); ++WP_itr ) {
+    // the extra WPs are added to the tool itself below, so they are part of its configuration
+    ANA_CHECK( retrieveSharedTool(m_isolationSelectionTool_handle, toolConfig(m_IsoKeys, m_TrackBasedIsoType, m_TrackIsoEff, m_CaloBasedIsoType, m_CaloIsoEff), [&]() -> StatusCode {
+      ANA_CHECK( m_isolationSelectionTool_handle.setProperty("MuonWP", (m_IsoKeys.at(0)).c_str()));
+      ANA_CHECK( m_isolationSelectionTool_handle.setProperty("OutputLevel", msg().level() ));
+      ANA_CHECK( m_isolationSelectionTool_handle.retrieve());
+      // the member is set below, for both a new and a reused tool
+      CP::IsolationSelectionTool* isolationSelectionTool = dynamic_cast<CP::IsolationSelectionTool*>(m_isolationSelectionTool_handle.get() ); // see header file for why
+
+      // Add the remaining input WPs to the tool
+      // (start from 2nd element)
+      //
+      for ( auto WP_itr = std::next(m_IsoKeys.begin()); WP_itr != m_IsoKeys.end(); ++WP_itr ) {
 
-       ANA_MSG_DEBUG( "Adding extra isolation WP " << *WP_itr << " to IsolationSelectionTool" );
+         ANA_MSG_DEBUG( "Adding extra isolation WP " << *WP_itr << " to IsolationSelectionTool" );
 
-       if ( (*WP_itr).find("UserDefined") != std::string::npos ) {
+         if ( (*WP_itr).find("UserDefined") != std::string::npos ) {
 
-         HelperClasses::EnumParser<xAOD::Iso::IsolationType> isoParser;
+           HelperClasses::EnumParser<xAOD::Iso::IsolationType> isoParser;
 
-         std::vector< std::pair<xAOD::Iso::IsolationType, std::string> > myCuts;
-         myCuts.push_back(std::make_pair<xAOD::Iso::IsolationType, std::string>(isoParser.parseEnum(m_TrackBasedIsoType), m_TrackIsoEff.c_str() ));
-         myCuts.push_back(std::make_pair<xAOD::Iso::IsolationType, std::string>(isoParser.parseEnum(m_CaloBasedIsoType) , m_CaloIsoEff.c_str()  ));
+           std::vector< std::pair<xAOD::Iso::IsolationType, std::string> > myCuts;
+           myCuts.push_back(std::make_pair<xAOD::Iso::IsolationType, std::string>(isoParser.parseEnum(m_TrackBasedIsoType), m_TrackIsoEff.c_str() ));
+           myCuts.push_back(std::make_pair<xAOD::Iso::IsolationType, std::string>(isoParser.parseEnum(m_CaloBasedIsoType) , m_CaloIsoEff.c_str()  ));
 
-         CP::IsolationSelectionTool::IsoWPType iso_type(CP::IsolationSelectionTool::Efficiency);
-         if ( (*WP_itr).find("Cut") != std::string::npos ) { iso_type = CP::IsolationSelectionTool::Cut; }
+           CP::IsolationSelectionTool::IsoWPType iso_type(CP::IsolationSelectionTool::Efficiency);
+           if ( (*WP_itr).find("Cut") != std::string::npos ) { iso_type = CP::IsolationSelectionTool::Cut; }
 
-         ANA_CHECK(  m_isolationSelectionTool->addUserDefinedWP((*WP_itr).c_str(), xAOD::Type::Muon, myCuts, "", iso_type));
+           ANA_CHECK(  isolationSelectionTool->addUserDefinedWP((*WP_itr).c_str(), xAOD::Type::Muon, myCuts, "", iso_type));
 
-       } else {
+         } else {
 
-          ANA_CHECK( m_isolationSelectionTool->addMuonWP( (*WP_itr).c_str() ));
+            ANA_CHECK( isolationSelectionTool->addMuonWP( (*WP_itr).c_str() ));
 
-       }
-    }
+         }
+      }
+      return StatusCode::SUCCESS;
+    }));
+    ANA_MSG_DEBUG("Retrieved tool: " << m_isolationSelectionTool_handle);
+    m_isolationSelectionTool = dynamic_cast<CP::IsolationSelectionTool*>(m_isolationSelectionTool_handle.get() ); // see header file for why
   }
 
   // **************************************
@@ -343,6 +366,9 @@ EL::StatusCode MuonSelector :: initialize ()
 
 EL::StatusCode MuonSelector :: execute ()
 {
+  auto event = beginEvent();
+  auto timer = timeExecute();
+  if ( eventRejected() ) return EL::StatusCode::SUCCESS;
   // Here you do everything that needs to be done on every single
   // events, e.g. read input variables, apply cuts, and fill
   // histograms and trees.  This is where most of your actual analysis
@@ -385,6 +411,25 @@ EL::StatusCode MuonSelector :: execute ()
    	m_diMuTrigChainsList.push_back(dimu_trig);
     }
 
+    // fix the bit of each chain in the trigger matching decorations
+    //
+    for ( auto const &chain : m_singleMuTrigChainsList ) {
+      const int bit = xAH::TrigMatchBits::bit( chain );
+      if ( bit < 0 ) {
+        ANA_MSG_ERROR( "At most " << xAH::TrigMatchBits::maxChains << " trigger chains can be matched in a job, cannot add " << chain );
+        return EL::StatusCode::FAILURE;
+      }
+      m_singleMuTrigChainsBits.push_back( bit );
+    }
+    for ( auto const &chain : m_diMuTrigChainsList ) {
+      const int bit = xAH::TrigMatchBits::bit( chain );
+      if ( bit < 0 ) {
+        ANA_MSG_ERROR( "At most " << xAH::TrigMatchBits::maxChains << " trigger chains can be matched in a job, cannot add " << chain );
+        return EL::StatusCode::FAILURE;
+      }
+      m_diMuTrigChainsBits.push_back( bit );
+    }
+
     ANA_MSG_INFO( "Input single muon trigger chains that will be considered for matching:\n");
     for ( auto const &chain : m_singleMuTrigChainsList ) { ANA_MSG_INFO( "\t " << chain); }
     ANA_MSG_INFO( "\n");
@@ -413,7 +458,7 @@ EL::StatusCode MuonSelector :: execute ()
     // create output container (if requested)
     //
     ConstDataVector<xAOD::MuonContainer>* selectedMuons(nullptr);
-    if ( m_createSelectedContainer ) { selectedMuons = new ConstDataVector<xAOD::MuonContainer>(SG::VIEW_ELEMENTS); }
+    if ( m_createSelectedContainer ) { selectedMuons = new ConstDataVector<xAOD::MuonContainer>(SG::VIEW_ELEMENTS); selectedMuons->reserve( inMuons->size() ); }
 
     // find the selected muons, and return if event passes object selection
     //
@@ -442,6 +487,7 @@ EL::StatusCode MuonSelector :: execute ()
     // must be a pointer to be recorded in TStore
     //
     auto vecOutContainerNames = std::make_unique< std::vector< std::string > >();
+    vecOutContainerNames->reserve( systNames->size() );
     ANA_MSG_DEBUG( " input list of syst size: " << static_cast<int>(systNames->size()) );
 
     // loop over systematic sets
@@ -456,7 +502,7 @@ EL::StatusCode MuonSelector :: execute ()
       // create output container (if requested) - one for each systematic
       //
       ConstDataVector<xAOD::MuonContainer>* selectedMuons(nullptr);
-      if ( m_createSelectedContainer ) { selectedMuons = new ConstDataVector<xAOD::MuonContainer>(SG::VIEW_ELEMENTS); }
+      if ( m_createSelectedContainer ) { selectedMuons = new ConstDataVector<xAOD::MuonContainer>(SG::VIEW_ELEMENTS); selectedMuons->reserve( inMuons->size() ); }
 
       // find the selected muons, and return if event passes object selection
       //
@@ -502,7 +548,7 @@ EL::StatusCode MuonSelector :: execute ()
   if(msgLvl(MSG::VERBOSE)) m_store->print();
 
   if( !eventPass ) {
-    wk()->skipEvent();
+    rejectEvent();
     return EL::StatusCode::SUCCESS;
   }
 
@@ -523,13 +569,17 @@ bool MuonSelector :: executeSelection ( const xAOD::MuonContainer* inMuons, floa
   int nPass(0); int nObj(0);
   static SG::AuxElement::Decorator< char > passSelDecor( "passSel" );
 
+  const int nToEvaluate = m_nToProcess > 0 ? std::min( m_nToProcess, static_cast<int>(inMuons->size()) ) : static_cast<int>(inMuons->size());
+  bool countRejected(false);
+
   for ( auto mu_itr : *inMuons ) { // duplicated of basic loop
 
     // if only looking at a subset of muons make sure all are decorated
     //
-    if ( m_nToProcess > 0 && nObj >= m_nToProcess ) {
+    if ( (m_nToProcess > 0 && nObj >= m_nToProcess) || countRejected ) {
       if ( m_decorateSelectedObjects ) {
         passSelDecor( *mu_itr ) = -1;
+        xAH::SelectionFlags::setUndecided( *mu_itr, m_passSelBit );
       } else {
         break;
       }
@@ -540,6 +590,7 @@ bool MuonSelector :: executeSelection ( const xAOD::MuonContainer* inMuons, floa
     bool passSel = this->passCuts( mu_itr, pvx );
     if ( m_decorateSelectedObjects ) {
       passSelDecor( *mu_itr ) = passSel;
+      xAH::SelectionFlags::set( *mu_itr, m_passSelBit, passSel );
     }
 
     // Remove events with isBadMuon (poor q/p)
@@ -556,6 +607,11 @@ bool MuonSelector :: executeSelection ( const xAOD::MuonContainer* inMuons, floa
         selectedMuons->push_back( mu_itr );
       }
     }
+
+    // once the number of selected muons rejects the event there is no need to look further
+    if ( m_stopWhenRejected && HelperFunctions::countRejects( nPass, nToEvaluate - nObj, m_pass_min, m_pass_max ) ) {
+      countRejected = true;
+    }
   }
 
   // for cutflow: make sure to count passed objects only once (i.e., this flag will be true only for nominal)
@@ -596,31 +652,34 @@ bool MuonSelector :: executeSelection ( const xAOD::MuonContainer* inMuons, floa
 
     unsigned int nSelectedMuons = selectedMuons->size();
 
-    static SG::AuxElement::Decorator< std::map<std::string,char> > isTrigMatchedMapMuDecor( "isTrigMatchedMapMu" );
+    static SG::AuxElement::Decorator< unsigned long long > trigMatchTestedBitsMuDecor( "trigMatchTestedBitsMu" );
+    static SG::AuxElement::Decorator< unsigned long long > isTrigMatchedBitsMuDecor( "isTrigMatchedBitsMu" );
+
+    //  Each muon is decorated w/ the bits of the tested chains and the bits of the matched chains,
+    //  the bit of each chain is fixed by xAH::TrigMatchBits when the chain lists are parsed
+    //
+    for ( auto const muon : *selectedMuons ) {
+      trigMatchTestedBitsMuDecor( *muon ) = 0;
+      isTrigMatchedBitsMuDecor( *muon )   = 0;
+    }
 
     if ( nSelectedMuons > 0 ) {
 
       ANA_MSG_DEBUG( "Doing single muon trigger matching...");
 
-      for ( auto const &chain : m_singleMuTrigChainsList ) {
+      for ( unsigned int ichain = 0; ichain < m_singleMuTrigChainsList.size(); ++ichain ) {
+
+        auto const &chain = m_singleMuTrigChainsList.at(ichain);
 
         ANA_MSG_DEBUG( "\t checking trigger chain " << chain);
 
         for ( auto const muon : *selectedMuons ) {
 
-          //  For each muon, decorate w/ a map<string,char> with the 'isMatched' info associated
-          //  to each trigger chain in the input list.
-          //  If decoration map doesn't exist for this muon yet, create it (will be done only for the 1st iteration on the chain names)
-          //
-          if ( !isTrigMatchedMapMuDecor.isAvailable( *muon ) ) {
-            isTrigMatchedMapMuDecor( *muon ) = std::map<std::string,char>();
-          }
-
           char matched = ( m_trigMuonMatchTool_handle->match( *muon, chain, m_minDeltaR ) );
 
           ANA_MSG_DEBUG( "\t\t is muon trigger matched? " << matched);
 
-          ( isTrigMatchedMapMuDecor( *muon ) )[chain] = matched;
+          xAH::TrigMatchBits::set( trigMatchTestedBitsMuDecor( *muon ), isTrigMatchedBitsMuDecor( *muon ), m_singleMuTrigChainsBits.at(ichain), matched );
         }
       }
 
@@ -649,7 +708,9 @@ bool MuonSelector :: executeSelection ( const xAOD::MuonContainer* inMuons, floa
       typedef std::multimap< std::string, dimuon_trigmatch_pair >    dimuon_trigmatch_pair_map;
       static SG::AuxElement::Decorator< dimuon_trigmatch_pair_map >  diMuonTrigMatchPairMapDecor( "diMuonTrigMatchPairMap" );
 
-      for ( auto const &chain : m_diMuTrigChainsList ) {
+      for ( unsigned int ichain = 0; ichain < m_diMuTrigChainsList.size(); ++ichain ) {
+
+        auto const &chain = m_diMuTrigChainsList.at(ichain);
 
       	ANA_MSG_DEBUG( "\t checking trigger chain " << chain);
 
@@ -678,8 +739,8 @@ bool MuonSelector :: executeSelection ( const xAOD::MuonContainer* inMuons, floa
       	    ANA_MSG_DEBUG( "\t\t is the muon pair ("<<imu<<","<<jmu<<") trigger matched? " << matched);
 
             // set basic matching information
-            ( isTrigMatchedMapMuDecor( *myMuons[0] ) )[chain] = matched;
-            ( isTrigMatchedMapMuDecor( *myMuons[1] ) )[chain] = matched;
+            xAH::TrigMatchBits::set( trigMatchTestedBitsMuDecor( *myMuons[0] ), isTrigMatchedBitsMuDecor( *myMuons[0] ), m_diMuTrigChainsBits.at(ichain), matched );
+            xAH::TrigMatchBits::set( trigMatchTestedBitsMuDecor( *myMuons[1] ), isTrigMatchedBitsMuDecor( *myMuons[1] ), m_diMuTrigChainsBits.at(ichain), matched );
 
             // set pair decision information
       	    std::pair <unsigned int, unsigned int>  chain_idxs = std::make_pair(imu,jmu);
@@ -699,6 +760,8 @@ bool MuonSelector :: executeSelection ( const xAOD::MuonContainer* inMuons, floa
 
 EL::StatusCode MuonSelector :: postExecute ()
 {
+  auto timer = timePostExecute();
+  if ( eventRejected() ) return EL::StatusCode::SUCCESS;
   // Here you do everything that needs to be done after the main event
   // processing.  This is typically very rare, particularly in user
   // code.  It is mainly used in implementing the NTupleSvc.
@@ -728,6 +791,9 @@ EL::StatusCode MuonSelector :: finalize ()
     ANA_MSG_INFO( "Filling cutflow");
     m_cutflowHist ->SetBinContent( m_cutflow_bin, m_numEventPass        );
     m_cutflowHistW->SetBinContent( m_cutflow_bin, m_weightNumEventPass  );
+
+    m_mu_cutflowCounter_1.flush();
+    m_mu_cutflowCounter_2.flush();
   }
 
   return EL::StatusCode::SUCCESS;
@@ -757,8 +823,8 @@ int MuonSelector :: passCuts( const xAOD::Muon* muon, const xAOD::Vertex *primar
 
   ANA_MSG_DEBUG( "In  passCuts..." );
   // fill cutflow bin 'all' before any cut
-  if (!m_isUsedBefore && m_useCutFlow) m_mu_cutflowHist_1->Fill( m_mu_cutflow_all, 1 );
-  if ( m_isUsedBefore && m_useCutFlow ) { m_mu_cutflowHist_2->Fill( m_mu_cutflow_all, 1 ); }
+  if (!m_isUsedBefore && m_useCutFlow) m_mu_cutflowCounter_1.fill( m_mu_cutflow_all );
+  if ( m_isUsedBefore && m_useCutFlow ) { m_mu_cutflowCounter_2.fill( m_mu_cutflow_all ); }
   ANA_MSG_DEBUG( "In  passCuts2..." );
   // *********************************************************************************************************************************************************************
   //
@@ -786,8 +852,8 @@ int MuonSelector :: passCuts( const xAOD::Muon* muon, const xAOD::Vertex *primar
     return 0;
   }
 
-  if (!m_isUsedBefore && m_useCutFlow) m_mu_cutflowHist_1->Fill( m_mu_cutflow_eta_and_quaility_cut, 1 );
-  if ( m_isUsedBefore && m_useCutFlow ) { m_mu_cutflowHist_2->Fill( m_mu_cutflow_eta_and_quaility_cut, 1 ); }
+  if (!m_isUsedBefore && m_useCutFlow) m_mu_cutflowCounter_1.fill( m_mu_cutflow_eta_and_quaility_cut );
+  if ( m_isUsedBefore && m_useCutFlow ) { m_mu_cutflowCounter_2.fill( m_mu_cutflow_eta_and_quaility_cut ); }
 
   // *********************************************************************************************************************************************************************
   //
@@ -800,8 +866,8 @@ int MuonSelector :: passCuts( const xAOD::Muon* muon, const xAOD::Vertex *primar
       return 0;
     }
   }
-  if (!m_isUsedBefore && m_useCutFlow) m_mu_cutflowHist_1->Fill( m_mu_cutflow_ptmax_cut, 1 );
-  if ( m_isUsedBefore && m_useCutFlow ) { m_mu_cutflowHist_2->Fill( m_mu_cutflow_ptmax_cut, 1 ); }
+  if (!m_isUsedBefore && m_useCutFlow) m_mu_cutflowCounter_1.fill( m_mu_cutflow_ptmax_cut );
+  if ( m_isUsedBefore && m_useCutFlow ) { m_mu_cutflowCounter_2.fill( m_mu_cutflow_ptmax_cut ); }
 
   // *********************************************************************************************************************************************************************
   //
@@ -813,8 +879,8 @@ int MuonSelector :: passCuts( const xAOD::Muon* muon, const xAOD::Vertex *primar
       return 0;
     }
   }
-  if (!m_isUsedBefore && m_useCutFlow) m_mu_cutflowHist_1->Fill( m_mu_cutflow_ptmin_cut, 1 );
-  if ( m_isUsedBefore && m_useCutFlow ) { m_mu_cutflowHist_2->Fill( m_mu_cutflow_ptmin_cut, 1 ); }
+  if (!m_isUsedBefore && m_useCutFlow) m_mu_cutflowCounter_1.fill( m_mu_cutflow_ptmin_cut );
+  if ( m_isUsedBefore && m_useCutFlow ) { m_mu_cutflowCounter_2.fill( m_mu_cutflow_ptmin_cut ); }
 
   // *********************************************************************************************************************************************************************
   //
@@ -827,8 +893,8 @@ int MuonSelector :: passCuts( const xAOD::Muon* muon, const xAOD::Vertex *primar
   //    return 0;
   //  }
   //}
-  //if (!m_isUsedBefore && m_useCutFlow) m_mu_cutflowHist_1->Fill( m_mu_cutflow_type_cut, 1 );
-  //if ( m_isUsedBefore && m_useCutFlow ) { m_mu_cutflowHist_2->Fill( m_mu_cutflow_type_cut, 1 ); }
+  //if (!m_isUsedBefore && m_useCutFlow) m_mu_cutflowCounter_1.fill( m_mu_cutflow_type_cut );
+  //if ( m_isUsedBefore && m_useCutFlow ) { m_mu_cutflowCounter_2.fill( m_mu_cutflow_type_cut ); }
 
   // *********************************************************************************************************************************************************************
   //
@@ -868,8 +934,8 @@ int MuonSelector :: passCuts( const xAOD::Muon* muon, const xAOD::Vertex *primar
       ANA_MSG_DEBUG( "Muon failed z0*sin(theta) cut.");
       return 0;
   }
-  if (!m_isUsedBefore && m_useCutFlow) m_mu_cutflowHist_1->Fill( m_mu_cutflow_z0sintheta_cut, 1 );
-  if ( m_isUsedBefore && m_useCutFlow ) { m_mu_cutflowHist_2->Fill( m_mu_cutflow_z0sintheta_cut, 1 ); }
+  if (!m_isUsedBefore && m_useCutFlow) m_mu_cutflowCounter_1.fill( m_mu_cutflow_z0sintheta_cut );
+  if ( m_isUsedBefore && m_useCutFlow ) { m_mu_cutflowCounter_2.fill( m_mu_cutflow_z0sintheta_cut ); }
 
   // decorate muon w/ z0*sin(theta) info
   static SG::AuxElement::Decorator< float > z0sinthetaDecor("z0sintheta");
@@ -881,8 +947,8 @@ int MuonSelector :: passCuts( const xAOD::Muon* muon, const xAOD::Vertex *primar
       ANA_MSG_DEBUG( "Muon failed d0 cut.");
       return 0;
   }
-  if (!m_isUsedBefore && m_useCutFlow) m_mu_cutflowHist_1->Fill( m_mu_cutflow_d0_cut, 1 );
-  if ( m_isUsedBefore && m_useCutFlow ) { m_mu_cutflowHist_2->Fill( m_mu_cutflow_d0_cut, 1 ); }
+  if (!m_isUsedBefore && m_useCutFlow) m_mu_cutflowCounter_1.fill( m_mu_cutflow_d0_cut );
+  if ( m_isUsedBefore && m_useCutFlow ) { m_mu_cutflowCounter_2.fill( m_mu_cutflow_d0_cut ); }
 
   // d0sig cut
   //
@@ -890,8 +956,8 @@ int MuonSelector :: passCuts( const xAOD::Muon* muon, const xAOD::Vertex *primar
       ANA_MSG_DEBUG( "Muon failed d0 significance cut.");
       return 0;
   }
-  if (!m_isUsedBefore && m_useCutFlow) m_mu_cutflowHist_1->Fill( m_mu_cutflow_d0sig_cut, 1 );
-  if ( m_isUsedBefore && m_useCutFlow ) { m_mu_cutflowHist_2->Fill( m_mu_cutflow_d0sig_cut, 1 ); }
+  if (!m_isUsedBefore && m_useCutFlow) m_mu_cutflowCounter_1.fill( m_mu_cutflow_d0sig_cut );
+  if ( m_isUsedBefore && m_useCutFlow ) { m_mu_cutflowCounter_2.fill( m_mu_cutflow_d0sig_cut ); }
 
   // decorate muon w/ d0sig info
   static SG::AuxElement::Decorator< float > d0SigDecor("d0sig");
@@ -903,31 +969,15 @@ int MuonSelector :: passCuts( const xAOD::Muon* muon, const xAOD::Vertex *primar
     // isolation cut
     //
 
-    // Get the "list" of input WPs with the accept() decision from the tool
-    //
-    Root::TAccept accept_list = m_isolationSelectionTool_handle->accept( *muon );
-
-    // Decorate w/ decision for all input WPs
-    //
-    std::string base_decor("isIsolated");
-    for ( auto WP_itr : m_IsoKeys ) {
-
-      std::string decorWP = base_decor + "_" + WP_itr;
-
-      ANA_MSG_DEBUG( "Decorate muon with " << decorWP << " - accept() ? " << accept_list.getCutResult( WP_itr.c_str()) );
-      muon->auxdecor<char>(decorWP) = static_cast<char>( accept_list.getCutResult( WP_itr.c_str() ) );
-
-    }
-
-    // Apply the cut if needed
+    // Decorate w/ decision for all input WPs, which the tool evaluates in a single accept() call
     //
-    if ( !m_MinIsoWPCut.empty() && !accept_list.getCutResult( m_MinIsoWPCut.c_str() ) ) {
+    if ( !m_isoDecisions.decorate( *muon, m_isolationSelectionTool_handle->accept( *muon ) ) ) {
       ANA_MSG_DEBUG( "Muon failed isolation cut " <<  m_MinIsoWPCut );
       return 0;
     }
   }
-  if (!m_isUsedBefore && m_useCutFlow) m_mu_cutflowHist_1->Fill( m_mu_cutflow_iso_cut, 1 );
-  if ( m_isUsedBefore && m_useCutFlow ) { m_mu_cutflowHist_2->Fill( m_mu_cutflow_iso_cut, 1 ); }
+  if (!m_isUsedBefore && m_useCutFlow) m_mu_cutflowCounter_1.fill( m_mu_cutflow_iso_cut );
+  if ( m_isUsedBefore && m_useCutFlow ) { m_mu_cutflowCounter_2.fill( m_mu_cutflow_iso_cut ); }
 
   if( m_removeCosmicMuon ){
 
@@ -939,8 +989,8 @@ int MuonSelector :: passCuts( const xAOD::Muon* muon, const xAOD::Vertex *primar
       ANA_MSG_DEBUG("Muon failed cosmic cut" );
       return 0;
     }
-    if (!m_isUsedBefore && m_useCutFlow) m_mu_cutflowHist_1->Fill( m_mu_cutflow_cosmic_cut, 1 );
-    if ( m_isUsedBefore && m_useCutFlow ) { m_mu_cutflowHist_2->Fill( m_mu_cutflow_cosmic_cut, 1 ); }
+    if (!m_isUsedBefore && m_useCutFlow) m_mu_cutflowCounter_1.fill( m_mu_cutflow_cosmic_cut );
+    if ( m_isUsedBefore && m_useCutFlow ) { m_mu_cutflowCounter_2.fill( m_mu_cutflow_cosmic_cut ); }
 
   }
 
@@ -0,0 +1,127 @@
+// EL include(s):
+#include <EventLoop/Job.h>
+#include <EventLoop/Worker.h>
+
+#include <EventLoop/OutputStream.h>
+
+// ROOT include(s):
+#include "TFile.h"
+#include "TH1.h"
+#include "TKey.h"
+#include "TTree.h"
+
+// c++ include(s):
+#include <memory>
+#include <sstream>
+
+#include <xAODAnaHelpers/ObjectCacheReader.h>
+#include <xAODAnaHelpers/HelperFunctions.h>
+
+// this is needed to distribute the algorithm to the workers
+ClassImp(ObjectCacheReader)
+
+ObjectCacheReader :: ObjectCacheReader () :
+    Algorithm("ObjectCacheReader")
+{
+}
+
+
+EL::StatusCode ObjectCacheReader :: setupJob (EL::Job& job)
+{
+  job.useXAOD();
+  xAOD::Init("ObjectCacheReader").ignore(); // call before opening first file
+
+  std::stringstream ss(m_cacheHistStreams);
+  std::string stream;
+  while ( ss >> stream ) {
+    if ( !job.outputHas(stream) ) job.outputAdd( EL::OutputStream(stream) );
+  }
+  return EL::StatusCode::SUCCESS;
+}
+
+
+
+EL::StatusCode ObjectCacheReader :: histInitialize ()
+{
+  ANA_CHECK( xAH::Algorithm::algInitialize());
+  return EL::StatusCode::SUCCESS;
+}
+
+EL::StatusCode ObjectCacheReader :: fileExecute () { return EL::StatusCode::SUCCESS; }
+
+EL::StatusCode ObjectCacheReader :: changeInput (bool /*firstFile*/)
+{
+  m_systNames.clear();
+
+  TFile* inputFile = wk()->inputFile();
+
+  // the histograms filled by the cached stages, added to what the rest of this job fills
+  std::stringstream ss(m_cacheHistStreams);
+  std::string stream;
+  while ( ss >> stream ) {
+    TDirectory* cacheDir = inputFile ? inputFile->GetDirectory(("xAH_cacheHists/"+stream).c_str()) : nullptr;
+    if ( !cacheDir ) {
+      ANA_MSG_WARNING( "No cached histograms of the " << stream << " stream in the input file, they are missing from the output");
+      continue;
+    }
+    TFile* outputFile = wk()->getOutputFile(stream);
+    for ( TObject* key : *cacheDir->GetListOfKeys() ) {
+      std::unique_ptr<TH1> cached( dynamic_cast<TH1*>(static_cast<TKey*>(key)->ReadObj()) );
+      if ( !cached ) continue;
+      cached->SetDirectory(nullptr);
+      if ( TH1* hist = dynamic_cast<TH1*>(outputFile->Get(cached->GetName())) ) {
+        HelperFunctions::addBinsByLabel(hist, cached.get());
+      } else {
+        cached->SetDirectory(outputFile);
+        cached.release();
+      }
+    }
+    ANA_MSG_DEBUG( "Restored the cached histograms of the " << stream << " stream");
+  }
+
+  TTree* tree = inputFile ? dynamic_cast<TTree*>(inputFile->Get(m_systNamesTree.c_str())) : nullptr;
+  if ( !tree ) {
+    ANA_MSG_WARNING( "No " << m_systNamesTree << " tree in the input file, no list of systematics is restored");
+    return EL::StatusCode::SUCCESS;
+  }
+
+  std::string* key(nullptr);
+  std::vector<std::string>* names(nullptr);
+  tree->SetBranchAddress("key",   &key);
+  tree->SetBranchAddress("names", &names);
+  for ( Long64_t i = 0; i < tree->GetEntries(); ++i ) {
+    tree->GetEntry(i);
+    m_systNames[*key] = *names;
+    ANA_MSG_DEBUG( "Restoring " << *key << " with " << names->size() << " entries");
+  }
+  tree->ResetBranchAddresses();
+  delete key;
+  delete names;
+
+  return EL::StatusCode::SUCCESS;
+}
+
+EL::StatusCode ObjectCacheReader :: initialize () { return EL::StatusCode::SUCCESS; }
+
+EL::StatusCode ObjectCacheReader :: execute ()
+{
+  auto event = beginEvent();
+  auto timer = timeExecute();
+  if ( eventRejected() ) return EL::StatusCode::SUCCESS;
+
+  for ( const auto& item : m_systNames ) {
+    if ( m_store->contains<std::vector<std::string> >(item.first) ) continue;
+    ANA_CHECK( m_store->record( std::make_unique<std::vector<std::string> >(item.second), item.first ));
+  }
+
+  return EL::StatusCode::SUCCESS;
+}
+
+EL::StatusCode ObjectCacheReader :: postExecute () { return EL::StatusCode::SUCCESS; }
+EL::StatusCode ObjectCacheReader :: finalize () { return EL::StatusCode::SUCCESS; }
+
+EL::StatusCode ObjectCacheReader :: histFinalize ()
+{
+  ANA_CHECK( xAH::Algorithm::algFinalize());
+  return EL::StatusCode::SUCCESS;
+}
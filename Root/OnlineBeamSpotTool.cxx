@@ -1,6 +1,8 @@
 #include <xAODAnaHelpers/OnlineBeamSpotTool.h>
 #include "PathResolver/PathResolver.h"
+#include <algorithm>
 #include <iostream>
+#include <mutex>
 
 // ROOT include(s):
 #include "TSystem.h"
@@ -16,31 +18,62 @@ OnlineBeamSpotTool::OnlineBeamSpotTool() :
   m_cachedLBData(nullptr),
   m_mcLBData(nullptr)
 {
-  readFile("xAODAnaHelpers/OnlineBSInfo/OnlineBSInfo.2016.A.root");
-  readFile("xAODAnaHelpers/OnlineBSInfo/OnlineBSInfo.2016.B.root");
-  readFile("xAODAnaHelpers/OnlineBSInfo/OnlineBSInfo.2016.C.root");
-  readFile("xAODAnaHelpers/OnlineBSInfo/OnlineBSInfo.2016.D.root");
-  readFile("xAODAnaHelpers/OnlineBSInfo/OnlineBSInfo.2016.E.root");
-  readFile("xAODAnaHelpers/OnlineBSInfo/OnlineBSInfo.2016.F.root");
-  readFile("xAODAnaHelpers/OnlineBSInfo/OnlineBSInfo.2016.G.root");
-  readFile("xAODAnaHelpers/OnlineBSInfo/OnlineBSInfo.2016.H.root");
-  readFile("xAODAnaHelpers/OnlineBSInfo/OnlineBSInfo.2016.I.root");
-  readFile("xAODAnaHelpers/OnlineBSInfo/OnlineBSInfo.2016.K.root");
-  readFile("xAODAnaHelpers/OnlineBSInfo/OnlineBSInfo.2016.L.root");
-  readFile("xAODAnaHelpers/OnlineBSInfo/OnlineBSInfo.2017.A.root");
-  readFile("xAODAnaHelpers/OnlineBSInfo/OnlineBSInfo.2017.B.root");
-  readFile("xAODAnaHelpers/OnlineBSInfo/OnlineBSInfo.2017.C.root");
-  readFile("xAODAnaHelpers/OnlineBSInfo/OnlineBSInfo.2017.D.root");
-  readFile("xAODAnaHelpers/OnlineBSInfo/OnlineBSInfo.2017.E.root");
-  readFile("xAODAnaHelpers/OnlineBSInfo/OnlineBSInfo.2017.F.root");
-  readFile("xAODAnaHelpers/OnlineBSInfo/OnlineBSInfo.2017.G.root");
-  readFile("xAODAnaHelpers/OnlineBSInfo/OnlineBSInfo.2017.H.root");
-  readFile("xAODAnaHelpers/OnlineBSInfo/OnlineBSInfo.2017.I.root");
-  readFile("xAODAnaHelpers/OnlineBSInfo/OnlineBSInfo.2017.K.root");
-
   m_mcLBData = new LBData(0,999999,0,0,0);
 }
 
+const OnlineBeamSpotTool::RunIndex& OnlineBeamSpotTool::runIndex(){
+  // built on the first data lookup and shared by all the instances of the process,
+  // simulation never needs the files
+  static const RunIndex runIndex = [](){
+    static const char* const fileNames[] = {
+      "xAODAnaHelpers/OnlineBSInfo/OnlineBSInfo.2016.A.root",
+      "xAODAnaHelpers/OnlineBSInfo/OnlineBSInfo.2016.B.root",
+      "xAODAnaHelpers/OnlineBSInfo/OnlineBSInfo.2016.C.root",
+      "xAODAnaHelpers/OnlineBSInfo/OnlineBSInfo.2016.D.root",
+      "xAODAnaHelpers/OnlineBSInfo/OnlineBSInfo.2016.E.root",
+      "xAODAnaHelpers/OnlineBSInfo/OnlineBSInfo.2016.F.root",
+      "xAODAnaHelpers/OnlineBSInfo/OnlineBSInfo.2016.G.root",
+      "xAODAnaHelpers/OnlineBSInfo/OnlineBSInfo.2016.H.root",
+      "xAODAnaHelpers/OnlineBSInfo/OnlineBSInfo.2016.I.root",
+      "xAODAnaHelpers/OnlineBSInfo/OnlineBSInfo.2016.K.root",
+      "xAODAnaHelpers/OnlineBSInfo/OnlineBSInfo.2016.L.root",
+      "xAODAnaHelpers/OnlineBSInfo/OnlineBSInfo.2017.A.root",
+      "xAODAnaHelpers/OnlineBSInfo/OnlineBSInfo.2017.B.root",
+      "xAODAnaHelpers/OnlineBSInfo/OnlineBSInfo.2017.C.root",
+      "xAODAnaHelpers/OnlineBSInfo/OnlineBSInfo.2017.D.root",
+      "xAODAnaHelpers/OnlineBSInfo/OnlineBSInfo.2017.E.root",
+      "xAODAnaHelpers/OnlineBSInfo/OnlineBSInfo.2017.F.root",
+      "xAODAnaHelpers/OnlineBSInfo/OnlineBSInfo.2017.G.root",
+      "xAODAnaHelpers/OnlineBSInfo/OnlineBSInfo.2017.H.root",
+      "xAODAnaHelpers/OnlineBSInfo/OnlineBSInfo.2017.I.root",
+      "xAODAnaHelpers/OnlineBSInfo/OnlineBSInfo.2017.K.root"
+    };
+    RunIndex thisRunIndex;
+    for(const char* fileName : fileNames) indexFile(fileName, thisRunIndex);
+    return thisRunIndex;
+  }();
+  return runIndex;
+}
+
+const OnlineBeamSpotTool::RunInfo* OnlineBeamSpotTool::loadRun(int runNumber){
+  const RunIndex& index = runIndex();
+  RunIndex::const_iterator location = index.find(runNumber);
+  if(location == index.end()) return nullptr;
+
+  // the runs read so far, shared by all the instances of the process
+  static std::mutex mutex;
+  static RunToLBDataMap loadedRuns;
+
+  std::lock_guard<std::mutex> lock(mutex);
+  RunToLBDataMap::iterator it = loadedRuns.find(runNumber);
+  if(it == loadedRuns.end()){
+    it = loadedRuns.emplace(runNumber, RunInfo()).first;
+    readRun(location->second, it->second);
+  }
+  // std::map does not move its elements, the pointer stays valid
+  return &(it->second);
+}
+
 OnlineBeamSpotTool::~OnlineBeamSpotTool()
 {
   //std::cout << "In ~OnlineBeamSpotTool" << std::endl;
@@ -48,13 +81,7 @@ OnlineBeamSpotTool::~OnlineBeamSpotTool()
 
 
 void OnlineBeamSpotTool::setRunInfo(int runNumber){
-  RunToLBDataMapItr it = m_runList.find(runNumber);
-
-  if(it != m_runList.end()){
-    m_cachedRunInfo = &(it->second);
-  } else {
-    m_cachedRunInfo = nullptr;
-  }
+  m_cachedRunInfo = loadRun(runNumber);
   m_cachedRunNum = runNumber;
   return;
 }
@@ -62,12 +89,13 @@ void OnlineBeamSpotTool::setRunInfo(int runNumber){
 const OnlineBeamSpotTool::LBData* OnlineBeamSpotTool::getLBData(int lumiBlock){
   if(!m_cachedRunInfo) return nullptr;
 
-  for(const LBData& thisLBData : *m_cachedRunInfo){
-    if((lumiBlock >= thisLBData.m_LBStart) && (lumiBlock <= thisLBData.m_LBEnd)){
-      return &thisLBData;
-    }
-  }
+  // the ranges are sorted by their first lumi block in readRun, the candidate is the last one starting at or before lumiBlock
+  auto it = std::upper_bound(m_cachedRunInfo->begin(), m_cachedRunInfo->end(), lumiBlock,
+                             [](int thisLumiBlock, const LBData& thisLBData){ return thisLumiBlock < thisLBData.m_LBStart; });
+  if(it == m_cachedRunInfo->begin()) return nullptr;
+  --it;
 
+  if(lumiBlock <= it->m_LBEnd) return &(*it);
   return nullptr;
 }
 
@@ -91,7 +119,9 @@ const OnlineBeamSpotTool::LBData* OnlineBeamSpotTool::getLBData(int runNumber, i
   if(runNumber != m_cachedRunNum)
     setRunInfo(runNumber);
 
-  return getLBData(lumiBlock);
+  m_cachedLB     = lumiBlock;
+  m_cachedLBData = getLBData(lumiBlock);
+  return m_cachedLBData;
 }
 
 float OnlineBeamSpotTool::getOnlineBSInfo(const xAOD::EventInfo* eventInfo, OnlineBeamSpotTool::BSData datakey){
@@ -121,14 +151,35 @@ float OnlineBeamSpotTool::getOnlineBSInfo(int runNumber, int lumiBlock, bool isM
   return thisLBInfo->m_BSz;
 }
 
-void OnlineBeamSpotTool::readFile(std::string rootFileName){
+void OnlineBeamSpotTool::indexFile(const std::string& rootFileName, RunIndex& index){
 
   std::string fullRootFileName = PathResolverFindCalibFile( rootFileName );
 
   TFile* thisFile = new TFile(fullRootFileName.c_str(),"READ");
   TTree* tree = (TTree*)thisFile->Get("LBInfo");
 
+  // only the run numbers are read here, the lumi block ranges of a run when it is first needed
   int RunNumber;
+  tree->SetBranchStatus("*", 0);
+  tree->SetBranchStatus("RunNumber", 1);
+  tree->SetBranchAddress("RunNumber",&RunNumber);
+
+  Long64_t nentries = tree->GetEntries();
+  for (Long64_t i=0;i<nentries;i++) {
+    tree->GetEntry(i);
+    // the first file with a run wins
+    index.insert( std::make_pair(RunNumber, RunLocation{fullRootFileName, i}) );
+  }
+
+  thisFile->Close();
+  delete thisFile;
+}
+
+void OnlineBeamSpotTool::readRun(const RunLocation& location, RunInfo& thisRunInfo){
+
+  TFile* thisFile = new TFile(location.m_fileName.c_str(),"READ");
+  TTree* tree = (TTree*)thisFile->Get("LBInfo");
+
   std::vector<int>*   LBStart  = new std::vector<int>();
   std::vector<int>*   LBEnd    = new std::vector<int>();
 
@@ -136,29 +187,32 @@ void OnlineBeamSpotTool::readFile(std::string rootFileName){
   std::vector<float>* BSy      = new std::vector<float>();
   std::vector<float>* BSz      = new std::vector<float>();
 
-  tree->SetBranchAddress("RunNumber",&RunNumber);
   tree->SetBranchAddress("LBStart",  &LBStart);
   tree->SetBranchAddress("LBEnd",    &LBEnd);
   tree->SetBranchAddress("BSx",      &BSx);
   tree->SetBranchAddress("BSy",      &BSy);
   tree->SetBranchAddress("BSz",      &BSz);
 
-  Long64_t nentries = tree->GetEntries();
-  for (Long64_t i=0;i<nentries;i++) {
-    tree->GetEntry(i);
-    RunInfo thisRunInfo;
-
-    for(unsigned int LBIt = 0; LBIt < LBStart->size(); ++LBIt){
-      thisRunInfo.push_back(LBData(LBStart ->at(LBIt),
-				   LBEnd   ->at(LBIt),
-				   BSx     ->at(LBIt),
-				   BSy     ->at(LBIt),
-				   BSz     ->at(LBIt)
-				   ));
-    }
-
-    m_runList.insert( std::make_pair(RunNumber, thisRunInfo) );
+  tree->GetEntry(location.m_entry);
+
+  thisRunInfo.reserve(LBStart->size());
+  for(unsigned int LBIt = 0; LBIt < LBStart->size(); ++LBIt){
+    thisRunInfo.push_back(LBData(LBStart ->at(LBIt),
+                                 LBEnd   ->at(LBIt),
+                                 BSx     ->at(LBIt),
+                                 BSy     ->at(LBIt),
+                                 BSz     ->at(LBIt)
+                                 ));
   }
+  std::stable_sort(thisRunInfo.begin(), thisRunInfo.end(),
+                   [](const LBData& a, const LBData& b){ return a.m_LBStart < b.m_LBStart; });
 
   thisFile->Close();
+  delete thisFile;
+
+  delete LBStart;
+  delete LBEnd;
+  delete BSx;
+  delete BSy;
+  delete BSz;
 }
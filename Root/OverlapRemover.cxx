@@ -11,6 +11,7 @@
 // c++ include(s):
 #include <iostream>
 #include <sstream>
+#include <algorithm>
 
 // EL include(s):
 #include <EventLoop/Job.h>
@@ -35,6 +36,7 @@
 #include "xAODAnaHelpers/OverlapRemover.h"
 #include "xAODAnaHelpers/HelperFunctions.h"
 #include "xAODAnaHelpers/HelperClasses.h"
+#include "xAODAnaHelpers/SelectionFlags.h"
 
 using HelperClasses::ToolName;
 
@@ -119,6 +121,12 @@ EL::StatusCode OverlapRemover :: initialize ()
   m_event = wk()->xaodEvent();
   m_store = wk()->xaodStore();
 
+  ANA_CHECK( m_inElectronsHandle.initialize(m_inContainerName_Electrons, m_event, m_store) );
+  ANA_CHECK( m_inMuonsHandle.initialize(m_inContainerName_Muons, m_event, m_store) );
+  ANA_CHECK( m_inJetsHandle.initialize(m_inContainerName_Jets, m_event, m_store) );
+  ANA_CHECK( m_inPhotonsHandle.initialize(m_inContainerName_Photons, m_event, m_store) );
+  ANA_CHECK( m_inTausHandle.initialize(m_inContainerName_Taus, m_event, m_store) );
+
   ANA_MSG_INFO( "Number of events in file: " << m_event->getEntries() );
   
 
@@ -144,8 +152,21 @@ EL::StatusCode OverlapRemover :: initialize ()
     return EL::StatusCode::FAILURE;
   }
   
+  m_passORAcc = std::make_unique<SG::AuxElement::ConstAccessor<char> >(m_decor);
+  // the decision is also kept in the flag word of the objects, when selecting them
+  m_passORBit = xAH::SelectionFlags::bit(m_decor);
+  if ( m_passORBit < 0 ) {
+    ANA_MSG_ERROR( "No bit left in the selection flags for " << m_decor );
+    return EL::StatusCode::FAILURE;
+  }
+
   // initialize ASG overlap removal tool
-  const std::string selected_label = ( m_useSelected ) ? "passSel" : "";  // set with decoration flag you use for selected objects if want to consider only selected objects in OR, otherwise it will perform OR on all objects
+  std::string selected_label = ( m_useSelected ) ? "passSel" : "";  // set with decoration flag you use for selected objects if want to consider only selected objects in OR, otherwise it will perform OR on all objects
+  // the isolated objects are kept out of the tools with a dedicated input label, which also carries the preselection
+  if ( m_skipIsolatedObjects ) {
+    m_inputLabel = m_decor + "_input";
+    selected_label = m_inputLabel;
+  }
 
   //Set Flags for recommended overlap procedures
   ORUtils::ORFlags orFlags("OverlapRemovalTool", selected_label, m_decor);
@@ -175,6 +196,9 @@ EL::StatusCode OverlapRemover :: initialize ()
 
 EL::StatusCode OverlapRemover :: execute ()
 {
+  auto event = beginEvent();
+  auto timer = timeExecute();
+  if ( eventRejected() ) return EL::StatusCode::SUCCESS;
   // Here you do everything that needs to be done on every single
   // events, e.g. read input variables, apply cuts, and fill
   // histograms and trees.  This is where most of your actual analysis
@@ -183,6 +207,7 @@ EL::StatusCode OverlapRemover :: execute ()
   ANA_MSG_DEBUG("Applying Overlap Removal... ");
 
   m_numEvent++;
+  m_grids.clear();
 
   // get the collections from TEvent or TStore
   const xAOD::ElectronContainer* inElectrons (nullptr);
@@ -314,6 +339,8 @@ EL::StatusCode OverlapRemover :: execute ()
 
 EL::StatusCode OverlapRemover :: postExecute ()
 {
+  auto timer = timePostExecute();
+  if ( eventRejected() ) return EL::StatusCode::SUCCESS;
   // Here you do everything that needs to be done after the main event
   // processing.  This is typically very rare, particularly in user
   // code.  It is mainly used in implementing the NTupleSvc.
@@ -362,6 +389,100 @@ EL::StatusCode OverlapRemover :: histFinalize ()
 }
 
 
+EL::StatusCode OverlapRemover :: removeOverlaps( const xAOD::ElectronContainer* inElectrons,
+                                                 const xAOD::MuonContainer* inMuons,
+                                                 const xAOD::JetContainer* inJets,
+                                                 const xAOD::PhotonContainer* inPhotons,
+                                                 const xAOD::TauJetContainer* inTaus )
+{
+  if ( !m_skipIsolatedObjects ) {
+    ANA_CHECK( m_ORToolbox.masterTool->removeOverlaps(inElectrons, inMuons, inJets, inTaus, inPhotons));
+    return EL::StatusCode::SUCCESS;
+  }
+
+  // the intermediates of the event live in the event arena
+  //
+  xAH::ArenaVector<const xAOD::IParticleContainer*> collections;
+  for ( const xAOD::IParticleContainer* cont : std::initializer_list<const xAOD::IParticleContainer*>{inElectrons, inMuons, inJets, inPhotons, inTaus} ) {
+    if ( cont ) collections.push_back(cont);
+  }
+
+  // the unvaried containers keep their index through the systematics loop
+  //
+  xAH::ArenaVector<const xAH::EtaPhiGrid*> grids;
+  grids.reserve(collections.size());
+  for ( const xAOD::IParticleContainer* cont : collections ) {
+    auto grid = m_grids.find(cont);
+    if ( grid == m_grids.end() ) {
+      grid = m_grids.emplace(cont, xAH::EtaPhiGrid()).first;
+      grid->second.fill(cont, m_isolatedObjectsDR);
+    }
+    grids.push_back(&grid->second);
+  }
+
+  static SG::AuxElement::ConstAccessor<char> passSelAcc("passSel");
+  SG::AuxElement::Decorator<char> inputDecor(m_inputLabel);
+  xAH::ArenaVector<const xAOD::IParticle*> isolated;
+  for ( const xAOD::IParticleContainer* cont : collections ) {
+    for ( const xAOD::IParticle* obj : *cont ) {
+      const bool selected = !m_useSelected || ( passSelAcc.isAvailable(*obj) && passSelAcc(*obj) );
+      const bool hasNeighbour = std::any_of(grids.begin(), grids.end(), [&](const xAH::EtaPhiGrid* grid){ return grid->hasNeighbour(obj, m_isolatedObjectsDR); });
+      inputDecor(*obj) = selected && hasNeighbour;
+      if ( selected && !hasNeighbour ) isolated.push_back(obj);
+    }
+  }
+
+  ANA_CHECK( m_ORToolbox.masterTool->removeOverlaps(inElectrons, inMuons, inJets, inTaus, inPhotons));
+
+  // the tools reject what they did not look at
+  //
+  SG::AuxElement::Decorator<char> passORDecor(m_decor);
+  for ( const xAOD::IParticle* obj : isolated ) { passORDecor(*obj) = true; }
+
+  return EL::StatusCode::SUCCESS;
+}
+
+
+EL::StatusCode OverlapRemover :: aliasNominalOR( const xAOD::JetContainer* inJets, const xAOD::JetContainer* nominalJets, const std::string& systName )
+{
+  // the jets of the variation take the decision of the nominal jet at the same position
+  //
+  SG::AuxElement::Decorator<char> passORDecor(m_decor);
+  for ( std::size_t i = 0; i < inJets->size(); ++i ) {
+    if ( m_passORAcc->isAvailable( *nominalJets->at(i) ) ) { passORDecor( *inJets->at(i) ) = (*m_passORAcc)( *nominalJets->at(i) ); }
+  }
+
+  ConstDataVector<xAOD::JetContainer>* selectedJets = new ConstDataVector<xAOD::JetContainer>(SG::VIEW_ELEMENTS);
+  ANA_CHECK( HelperFunctions::makeSubsetCont(inJets, selectedJets, msg(), *m_passORAcc, m_passORBit));
+  ANA_CHECK( m_store->record( selectedJets, m_outContainerName_Jets + systName ));
+
+  // the other objects keep their nominal selection
+  //
+  if ( m_useElectrons ) {
+    ConstDataVector<xAOD::ElectronContainer>* nominalElectrons(nullptr);
+    ANA_CHECK( HelperFunctions::retrieve(nominalElectrons, m_outContainerName_Electrons, 0, m_store, msg()) );
+    ANA_CHECK( m_store->record( new ConstDataVector<xAOD::ElectronContainer>(*nominalElectrons), m_outContainerName_Electrons + systName ));
+  }
+  if ( m_useMuons ) {
+    ConstDataVector<xAOD::MuonContainer>* nominalMuons(nullptr);
+    ANA_CHECK( HelperFunctions::retrieve(nominalMuons, m_outContainerName_Muons, 0, m_store, msg()) );
+    ANA_CHECK( m_store->record( new ConstDataVector<xAOD::MuonContainer>(*nominalMuons), m_outContainerName_Muons + systName ));
+  }
+  if ( m_usePhotons ) {
+    ConstDataVector<xAOD::PhotonContainer>* nominalPhotons(nullptr);
+    ANA_CHECK( HelperFunctions::retrieve(nominalPhotons, m_outContainerName_Photons, 0, m_store, msg()) );
+    ANA_CHECK( m_store->record( new ConstDataVector<xAOD::PhotonContainer>(*nominalPhotons), m_outContainerName_Photons + systName ));
+  }
+  if ( m_useTaus ) {
+    ConstDataVector<xAOD::TauJetContainer>* nominalTaus(nullptr);
+    ANA_CHECK( HelperFunctions::retrieve(nominalTaus, m_outContainerName_Taus, 0, m_store, msg()) );
+    ANA_CHECK( m_store->record( new ConstDataVector<xAOD::TauJetContainer>(*nominalTaus), m_outContainerName_Taus + systName ));
+  }
+
+  return EL::StatusCode::SUCCESS;
+}
+
+
 EL::StatusCode OverlapRemover :: fillObjectCutflow (const xAOD::IParticleContainer* objCont, const std::string& overlapFlag, const std::string& selectFlag)
 {
   SG::AuxElement::ConstAccessor<char> selectAcc(selectFlag);
@@ -460,7 +581,7 @@ EL::StatusCode OverlapRemover :: executeOR(  const xAOD::ElectronContainer* inEl
 
       if( m_useElectrons ) {
         if ( m_store->contains<ConstDataVector<xAOD::ElectronContainer> >(m_inContainerName_Electrons) ) {
-          ANA_CHECK( HelperFunctions::retrieve(inElectrons, m_inContainerName_Electrons, m_event, m_store, msg()) );
+          ANA_CHECK( m_inElectronsHandle.retrieve(inElectrons, msg()) );
         } else {
           nomContainerNotFound = true;
           if ( m_numEvent == 1 ) { ANA_MSG_WARNING( "Could not find nominal container " << m_inContainerName_Electrons << " in xAOD::TStore. Overlap Removal will not be done for the 'all-nominal' case...");  }
@@ -469,7 +590,7 @@ EL::StatusCode OverlapRemover :: executeOR(  const xAOD::ElectronContainer* inEl
 
       if( m_useMuons ) {
         if ( m_store->contains<ConstDataVector<xAOD::MuonContainer> >(m_inContainerName_Muons) ) {
-          ANA_CHECK( HelperFunctions::retrieve(inMuons, m_inContainerName_Muons, m_event, m_store, msg()) );
+          ANA_CHECK( m_inMuonsHandle.retrieve(inMuons, msg()) );
         } else {
           nomContainerNotFound = true;
           if ( m_numEvent == 1 ) { ANA_MSG_WARNING( "Could not find nominal container " << m_inContainerName_Muons << " in xAOD::TStore. Overlap Removal will not be done for the 'all-nominal' case..."); }
@@ -477,7 +598,7 @@ EL::StatusCode OverlapRemover :: executeOR(  const xAOD::ElectronContainer* inEl
       }
 
       if ( m_store->contains<ConstDataVector<xAOD::JetContainer> >(m_inContainerName_Jets) ) {
-        ANA_CHECK( HelperFunctions::retrieve(inJets, m_inContainerName_Jets, m_event, m_store, msg()) );
+        ANA_CHECK( m_inJetsHandle.retrieve(inJets, msg()) );
       } else {
         nomContainerNotFound = true;
         if ( m_numEvent == 1 ) { ANA_MSG_WARNING( "Could not find nominal container " << m_inContainerName_Jets << " in xAOD::TStore. Overlap Removal will not be done for the 'all-nominal' case..."); }
@@ -485,7 +606,7 @@ EL::StatusCode OverlapRemover :: executeOR(  const xAOD::ElectronContainer* inEl
 
       if ( m_usePhotons ) {
         if ( m_store->contains<ConstDataVector<xAOD::PhotonContainer> >(m_inContainerName_Photons) ) {
-          ANA_CHECK( HelperFunctions::retrieve(inPhotons, m_inContainerName_Photons, m_event, m_store, msg()) );
+          ANA_CHECK( m_inPhotonsHandle.retrieve(inPhotons, msg()) );
         } else {
           nomContainerNotFound = true;
           if ( m_numEvent == 1 ) { ANA_MSG_WARNING( "Could not find nominal container " << m_inContainerName_Photons << " in xAOD::TStore. Overlap Removal will not be done for the 'all-nominal' case..."); }
@@ -494,7 +615,7 @@ EL::StatusCode OverlapRemover :: executeOR(  const xAOD::ElectronContainer* inEl
 
       if ( m_useTaus ) {
         if ( m_store->contains<ConstDataVector<xAOD::TauJetContainer> >(m_inContainerName_Taus) ) {
-          ANA_CHECK( HelperFunctions::retrieve(inTaus, m_inContainerName_Taus, m_event, m_store, msg()) );
+          ANA_CHECK( m_inTausHandle.retrieve(inTaus, msg()) );
         } else {
           nomContainerNotFound = true;
           if ( m_numEvent == 1 ) { ANA_MSG_WARNING( "Could not find nominal container " << m_inContainerName_Taus << " in xAOD::TStore. Overlap Removal will not be done for the 'all-nominal' case..."); }
@@ -512,10 +633,9 @@ EL::StatusCode OverlapRemover :: executeOR(  const xAOD::ElectronContainer* inEl
       // do the actual OR
       //
       ANA_MSG_DEBUG(  "Calling removeOverlaps()");
-      ANA_CHECK( m_ORToolbox.masterTool->removeOverlaps(inElectrons, inMuons, inJets, inTaus, inPhotons)); // This line raises an exception
+      ANA_CHECK( removeOverlaps(inElectrons, inMuons, inJets, inPhotons, inTaus)); // This line raises an exception
       ANA_MSG_DEBUG(  "Done Calling removeOverlaps()");
 
-      std::string ORdecor(m_decor);
       if(m_useCutFlow){
         // fill cutflow histograms
         //
@@ -543,11 +663,11 @@ EL::StatusCode OverlapRemover :: executeOR(  const xAOD::ElectronContainer* inEl
       // if an object has been flagged as 'passOR', it will be stored in the 'selected' container
       //
       ANA_MSG_DEBUG(  "Resizing");
-      if ( m_useElectrons ) { ANA_CHECK( HelperFunctions::makeSubsetCont(inElectrons, selectedElectrons, msg(), ORdecor.c_str(), ToolName::SELECTOR)); }
-      if ( m_useMuons )     { ANA_CHECK( HelperFunctions::makeSubsetCont(inMuons, selectedMuons, msg(), ORdecor.c_str(), ToolName::SELECTOR)); }
-      ANA_CHECK( HelperFunctions::makeSubsetCont(inJets, selectedJets, msg(), ORdecor.c_str(), ToolName::SELECTOR));
-      if ( m_usePhotons )   { ANA_CHECK( HelperFunctions::makeSubsetCont(inPhotons, selectedPhotons, msg(), ORdecor.c_str(), ToolName::SELECTOR)); }
-      if ( m_useTaus )      { ANA_CHECK( HelperFunctions::makeSubsetCont(inTaus, selectedTaus, msg(), ORdecor.c_str(), ToolName::SELECTOR)); }
+      if ( m_useElectrons ) { ANA_CHECK( HelperFunctions::makeSubsetCont(inElectrons, selectedElectrons, msg(), *m_passORAcc, m_passORBit)); }
+      if ( m_useMuons )     { ANA_CHECK( HelperFunctions::makeSubsetCont(inMuons, selectedMuons, msg(), *m_passORAcc, m_passORBit)); }
+      ANA_CHECK( HelperFunctions::makeSubsetCont(inJets, selectedJets, msg(), *m_passORAcc, m_passORBit));
+      if ( m_usePhotons )   { ANA_CHECK( HelperFunctions::makeSubsetCont(inPhotons, selectedPhotons, msg(), *m_passORAcc, m_passORBit)); }
+      if ( m_useTaus )      { ANA_CHECK( HelperFunctions::makeSubsetCont(inTaus, selectedTaus, msg(), *m_passORAcc, m_passORBit)); }
 
       if ( m_useElectrons) { ANA_MSG_DEBUG(  "selectedElectrons : " << selectedElectrons->size()); }
       if ( m_useMuons )    { ANA_MSG_DEBUG(  "selectedMuons : " << selectedMuons->size()); }
@@ -581,7 +701,7 @@ EL::StatusCode OverlapRemover :: executeOR(  const xAOD::ElectronContainer* inEl
       // these input containers won't change in the electron syst loop ...
       if( m_useMuons ) {
         if ( m_store->contains<ConstDataVector<xAOD::MuonContainer> >(m_inContainerName_Muons) ) {
-          ANA_CHECK( HelperFunctions::retrieve(inMuons, m_inContainerName_Muons, m_event, m_store, msg()) );
+          ANA_CHECK( m_inMuonsHandle.retrieve(inMuons, msg()) );
         } else {
           nomContainerNotFound = true;
           if ( m_numEvent == 1 ) { ANA_MSG_WARNING( "Could not find nominal container " << m_inContainerName_Muons << " in xAOD::TStore. Overlap Removal will not be done for the 'all-nominal' case...");  }
@@ -589,7 +709,7 @@ EL::StatusCode OverlapRemover :: executeOR(  const xAOD::ElectronContainer* inEl
       }
 
       if ( m_store->contains<ConstDataVector<xAOD::JetContainer> >(m_inContainerName_Jets) ) {
-        ANA_CHECK( HelperFunctions::retrieve(inJets, m_inContainerName_Jets, m_event, m_store, msg()) );
+        ANA_CHECK( m_inJetsHandle.retrieve(inJets, msg()) );
       } else {
         nomContainerNotFound = true;
         if ( m_numEvent == 1 ) { ANA_MSG_WARNING( "Could not find nominal container " << m_inContainerName_Jets << " in xAOD::TStore. Overlap Removal will not be done for the 'all-nominal' case..."); }
@@ -597,7 +717,7 @@ EL::StatusCode OverlapRemover :: executeOR(  const xAOD::ElectronContainer* inEl
 
       if ( m_usePhotons ) {
         if ( m_store->contains<ConstDataVector<xAOD::PhotonContainer> >(m_inContainerName_Photons) ) {
-          ANA_CHECK( HelperFunctions::retrieve(inPhotons, m_inContainerName_Photons, m_event, m_store, msg()) );
+          ANA_CHECK( m_inPhotonsHandle.retrieve(inPhotons, msg()) );
         } else {
           nomContainerNotFound = true;
           if ( m_numEvent == 1 ) { ANA_MSG_WARNING( "Could not find nominal container " << m_inContainerName_Photons << " in xAOD::TStore. Overlap Removal will not be done for the 'all-nominal' case..."); }
@@ -606,7 +726,7 @@ EL::StatusCode OverlapRemover :: executeOR(  const xAOD::ElectronContainer* inEl
 
       if ( m_useTaus ) {
         if ( m_store->contains<ConstDataVector<xAOD::TauJetContainer> >(m_inContainerName_Taus) ) {
-          ANA_CHECK( HelperFunctions::retrieve(inTaus, m_inContainerName_Taus, m_event, m_store, msg()) );
+          ANA_CHECK( m_inTausHandle.retrieve(inTaus, msg()) );
         } else {
           nomContainerNotFound = true;
           if ( m_numEvent == 1 ) { ANA_MSG_WARNING( "Could not find nominal container " << m_inContainerName_Taus << " in xAOD::TStore. Overlap Removal will not be done for the 'all-nominal' case..."); }
@@ -627,9 +747,8 @@ EL::StatusCode OverlapRemover :: executeOR(  const xAOD::ElectronContainer* inEl
 
         // do the actual OR
         //
-        ANA_CHECK( m_ORToolbox.masterTool->removeOverlaps(inElectrons, inMuons, inJets, inTaus, inPhotons));
+        ANA_CHECK( removeOverlaps(inElectrons, inMuons, inJets, inPhotons, inTaus));
 
-        const std::string ORdecor(m_decor);
         if(m_useCutFlow){
           // fill cutflow histograms
           //
@@ -652,11 +771,11 @@ EL::StatusCode OverlapRemover :: executeOR(  const xAOD::ElectronContainer* inEl
 
         // resize containers basd on OR decision
         //
-        ANA_CHECK( HelperFunctions::makeSubsetCont(inElectrons, selectedElectrons, msg(), ORdecor.c_str(), ToolName::SELECTOR));
-        if ( m_useMuons )  {  ANA_CHECK( HelperFunctions::makeSubsetCont(inMuons, selectedMuons, msg(), ORdecor.c_str(), ToolName::SELECTOR)); }
-        ANA_CHECK( HelperFunctions::makeSubsetCont(inJets, selectedJets, msg(), ORdecor.c_str(), ToolName::SELECTOR));
-        if ( m_usePhotons ){ ANA_CHECK( HelperFunctions::makeSubsetCont(inPhotons, selectedPhotons, msg(), ORdecor.c_str(), ToolName::SELECTOR)); }
-        if ( m_useTaus )   {  ANA_CHECK( HelperFunctions::makeSubsetCont(inTaus, selectedTaus, msg(), ORdecor.c_str(), ToolName::SELECTOR)); }
+        ANA_CHECK( HelperFunctions::makeSubsetCont(inElectrons, selectedElectrons, msg(), *m_passORAcc, m_passORBit));
+        if ( m_useMuons )  {  ANA_CHECK( HelperFunctions::makeSubsetCont(inMuons, selectedMuons, msg(), *m_passORAcc, m_passORBit)); }
+        ANA_CHECK( HelperFunctions::makeSubsetCont(inJets, selectedJets, msg(), *m_passORAcc, m_passORBit));
+        if ( m_usePhotons ){ ANA_CHECK( HelperFunctions::makeSubsetCont(inPhotons, selectedPhotons, msg(), *m_passORAcc, m_passORBit)); }
+        if ( m_useTaus )   {  ANA_CHECK( HelperFunctions::makeSubsetCont(inTaus, selectedTaus, msg(), *m_passORAcc, m_passORBit)); }
 
         // add ConstDataVector to TStore
         //
@@ -686,7 +805,7 @@ EL::StatusCode OverlapRemover :: executeOR(  const xAOD::ElectronContainer* inEl
       // these input containers won't change in the muon syst loop ...
       if( m_useElectrons ) {
         if ( m_store->contains<ConstDataVector<xAOD::ElectronContainer> >(m_inContainerName_Electrons) ) {
-          ANA_CHECK( HelperFunctions::retrieve(inElectrons, m_inContainerName_Electrons, m_event, m_store, msg()) );
+          ANA_CHECK( m_inElectronsHandle.retrieve(inElectrons, msg()) );
         } else {
           nomContainerNotFound = true;
           if ( m_numEvent == 1 ) { ANA_MSG_WARNING( "Could not find nominal container " << m_inContainerName_Electrons << " in xAOD::TStore. Overlap Removal will not be done for the 'all-nominal' case...");  }
@@ -694,7 +813,7 @@ EL::StatusCode OverlapRemover :: executeOR(  const xAOD::ElectronContainer* inEl
       }
 
       if ( m_store->contains<ConstDataVector<xAOD::JetContainer> >(m_inContainerName_Jets) ) {
-        ANA_CHECK( HelperFunctions::retrieve(inJets, m_inContainerName_Jets, m_event, m_store, msg()) );
+        ANA_CHECK( m_inJetsHandle.retrieve(inJets, msg()) );
       } else {
         nomContainerNotFound = true;
         if ( m_numEvent == 1 ) { ANA_MSG_WARNING( "Could not find nominal container " << m_inContainerName_Jets << " in xAOD::TStore. Overlap Removal will not be done for the 'all-nominal' case..."); }
@@ -702,7 +821,7 @@ EL::StatusCode OverlapRemover :: executeOR(  const xAOD::ElectronContainer* inEl
 
       if ( m_usePhotons ) {
         if ( m_store->contains<ConstDataVector<xAOD::PhotonContainer> >(m_inContainerName_Photons) ) {
-          ANA_CHECK( HelperFunctions::retrieve(inPhotons, m_inContainerName_Photons, m_event, m_store, msg()) );
+          ANA_CHECK( m_inPhotonsHandle.retrieve(inPhotons, msg()) );
         } else {
           nomContainerNotFound = true;
           if ( m_numEvent == 1 ) { ANA_MSG_WARNING( "Could not find nominal container " << m_inContainerName_Photons << " in xAOD::TStore. Overlap Removal will not be done for the 'all-nominal' case..."); }
@@ -711,7 +830,7 @@ EL::StatusCode OverlapRemover :: executeOR(  const xAOD::ElectronContainer* inEl
 
       if ( m_useTaus ) {
         if ( m_store->contains<ConstDataVector<xAOD::TauJetContainer> >(m_inContainerName_Taus) ) {
-          ANA_CHECK( HelperFunctions::retrieve(inTaus, m_inContainerName_Taus, m_event, m_store, msg()) );
+          ANA_CHECK( m_inTausHandle.retrieve(inTaus, msg()) );
         } else {
           nomContainerNotFound = true;
           if ( m_numEvent == 1 ) { ANA_MSG_WARNING( "Could not find nominal container " << m_inContainerName_Taus << " in xAOD::TStore. Overlap Removal will not be done for the 'all-nominal' case..."); }
@@ -732,9 +851,8 @@ EL::StatusCode OverlapRemover :: executeOR(  const xAOD::ElectronContainer* inEl
 
         // do the actual OR
         //
-        ANA_CHECK( m_ORToolbox.masterTool->removeOverlaps(inElectrons, inMuons, inJets, inTaus, inPhotons));
+        ANA_CHECK( removeOverlaps(inElectrons, inMuons, inJets, inPhotons, inTaus));
 
-        const std::string ORdecor(m_decor);
         if(m_useCutFlow){
           // fill cutflow histograms
           //
@@ -756,11 +874,11 @@ EL::StatusCode OverlapRemover :: executeOR(  const xAOD::ElectronContainer* inEl
 
         // resize containers based on OR decision
         //
-        if ( m_useElectrons ) { ANA_CHECK( HelperFunctions::makeSubsetCont(inElectrons, selectedElectrons, msg(), ORdecor.c_str(), ToolName::SELECTOR)); }
-        ANA_CHECK( HelperFunctions::makeSubsetCont(inMuons, selectedMuons, msg(), ORdecor.c_str(), ToolName::SELECTOR));
-        ANA_CHECK( HelperFunctions::makeSubsetCont(inJets, selectedJets, msg(), ORdecor.c_str(), ToolName::SELECTOR));
-        if ( m_usePhotons )   { ANA_CHECK( HelperFunctions::makeSubsetCont(inPhotons, selectedPhotons, msg(), ORdecor.c_str(), ToolName::SELECTOR)); }
-        if ( m_useTaus )      { ANA_CHECK( HelperFunctions::makeSubsetCont(inTaus, selectedTaus, msg(), ORdecor.c_str(), ToolName::SELECTOR)); }
+        if ( m_useElectrons ) { ANA_CHECK( HelperFunctions::makeSubsetCont(inElectrons, selectedElectrons, msg(), *m_passORAcc, m_passORBit)); }
+        ANA_CHECK( HelperFunctions::makeSubsetCont(inMuons, selectedMuons, msg(), *m_passORAcc, m_passORBit));
+        ANA_CHECK( HelperFunctions::makeSubsetCont(inJets, selectedJets, msg(), *m_passORAcc, m_passORBit));
+        if ( m_usePhotons )   { ANA_CHECK( HelperFunctions::makeSubsetCont(inPhotons, selectedPhotons, msg(), *m_passORAcc, m_passORBit)); }
+        if ( m_useTaus )      { ANA_CHECK( HelperFunctions::makeSubsetCont(inTaus, selectedTaus, msg(), *m_passORAcc, m_passORBit)); }
 
         // add ConstDataVector to TStore
         //
@@ -791,7 +909,7 @@ EL::StatusCode OverlapRemover :: executeOR(  const xAOD::ElectronContainer* inEl
       // these input containers won't change in the jet syst loop ...
       if( m_useElectrons ) {
         if ( m_store->contains<ConstDataVector<xAOD::ElectronContainer> >(m_inContainerName_Electrons) ) {
-          ANA_CHECK( HelperFunctions::retrieve(inElectrons, m_inContainerName_Electrons, m_event, m_store, msg()) );
+          ANA_CHECK( m_inElectronsHandle.retrieve(inElectrons, msg()) );
         } else {
           nomContainerNotFound = true;
           if ( m_numEvent == 1 ) { ANA_MSG_WARNING( "Could not find nominal container " << m_inContainerName_Electrons << " in xAOD::TStore. Overlap Removal will not be done for the 'all-nominal' case...");  }
@@ -800,7 +918,7 @@ EL::StatusCode OverlapRemover :: executeOR(  const xAOD::ElectronContainer* inEl
 
       if( m_useMuons ) {
         if ( m_store->contains<ConstDataVector<xAOD::MuonContainer> >(m_inContainerName_Muons) ) {
-          ANA_CHECK( HelperFunctions::retrieve(inMuons, m_inContainerName_Muons, m_event, m_store, msg()) );
+          ANA_CHECK( m_inMuonsHandle.retrieve(inMuons, msg()) );
         } else {
           nomContainerNotFound = true;
           if ( m_numEvent == 1 ) { ANA_MSG_WARNING( "Could not find nominal container " << m_inContainerName_Muons << " in xAOD::TStore. Overlap Removal will not be done for the 'all-nominal' case..."); }
@@ -809,7 +927,7 @@ EL::StatusCode OverlapRemover :: executeOR(  const xAOD::ElectronContainer* inEl
 
       if ( m_usePhotons ) {
         if ( m_store->contains<ConstDataVector<xAOD::PhotonContainer> >(m_inContainerName_Photons) ) {
-          ANA_CHECK( HelperFunctions::retrieve(inPhotons, m_inContainerName_Photons, m_event, m_store, msg()) );
+          ANA_CHECK( m_inPhotonsHandle.retrieve(inPhotons, msg()) );
         } else {
           nomContainerNotFound = true;
           if ( m_numEvent == 1 ) { ANA_MSG_WARNING( "Could not find nominal container " << m_inContainerName_Photons << " in xAOD::TStore. Overlap Removal will not be done for the 'all-nominal' case..."); }
@@ -818,7 +936,7 @@ EL::StatusCode OverlapRemover :: executeOR(  const xAOD::ElectronContainer* inEl
 
       if ( m_useTaus ) {
         if ( m_store->contains<ConstDataVector<xAOD::TauJetContainer> >(m_inContainerName_Taus) ) {
-          ANA_CHECK( HelperFunctions::retrieve(inTaus, m_inContainerName_Taus, m_event, m_store, msg()) );
+          ANA_CHECK( m_inTausHandle.retrieve(inTaus, msg()) );
         } else {
           nomContainerNotFound = true;
           if ( m_numEvent == 1 ) { ANA_MSG_WARNING( "Could not find nominal container " << m_inContainerName_Taus << " in xAOD::TStore. Overlap Removal will not be done for the 'all-nominal' case..."); }
@@ -827,6 +945,16 @@ EL::StatusCode OverlapRemover :: executeOR(  const xAOD::ElectronContainer* inEl
 
       if ( nomContainerNotFound ) {return EL::StatusCode::SUCCESS;}
 
+      // the jet variations found identical to nominal upstream (see JetCalibrator::m_findSameAsNominalSysts)
+      std::vector<std::string>* sameAsNominal(nullptr);
+      const xAOD::JetContainer* nominalJets(nullptr);
+      if ( m_aliasSameAsNominalSysts && m_createSelectedContainers &&
+           m_store->contains<std::vector<std::string> >(HelperFunctions::sameAsNominalName(m_inputAlgoJets)) &&
+           m_store->contains<ConstDataVector<xAOD::JetContainer> >(m_outContainerName_Jets) ) {
+        ANA_CHECK( HelperFunctions::retrieve(sameAsNominal, HelperFunctions::sameAsNominalName(m_inputAlgoJets), 0, m_store, msg()) );
+        ANA_CHECK( m_inJetsHandle.retrieve(nominalJets, msg()) );
+      }
+
       for( auto systName : *sysVec ) {
 
         if ( systName.empty() ) continue;
@@ -836,11 +964,20 @@ EL::StatusCode OverlapRemover :: executeOR(  const xAOD::ElectronContainer* inEl
         std::string jet_syst_cont_name = m_inContainerName_Jets + systName;
         ANA_CHECK( HelperFunctions::retrieve(inJets, jet_syst_cont_name, 0, m_store, msg()) );
 
+        // identical jets give the nominal overlap removal decisions for every object
+        //
+        if ( sameAsNominal && inJets->size() == nominalJets->size() &&
+             std::find(sameAsNominal->begin(), sameAsNominal->end(), systName) != sameAsNominal->end() ) {
+          ANA_MSG_DEBUG( "Reusing the nominal overlap removal for " << systName );
+          ANA_CHECK( aliasNominalOR(inJets, nominalJets, systName) );
+          sysVecOut->push_back(systName);
+          continue;
+        }
+
         // do the actual OR
         //
-        ANA_CHECK( m_ORToolbox.masterTool->removeOverlaps(inElectrons, inMuons, inJets, inTaus, inPhotons));
+        ANA_CHECK( removeOverlaps(inElectrons, inMuons, inJets, inPhotons, inTaus));
 
-        const std::string ORdecor(m_decor);
         if(m_useCutFlow){
           // fill cutflow histograms
           //
@@ -863,11 +1000,11 @@ EL::StatusCode OverlapRemover :: executeOR(  const xAOD::ElectronContainer* inEl
 
         // resize containers basd on OR decision
         //
-        if ( m_useElectrons ) { ANA_CHECK( HelperFunctions::makeSubsetCont(inElectrons, selectedElectrons, msg(), ORdecor.c_str(), ToolName::SELECTOR)); }
-        if ( m_useMuons )     { ANA_CHECK( HelperFunctions::makeSubsetCont(inMuons, selectedMuons, msg(), ORdecor.c_str(), ToolName::SELECTOR)); }
-        ANA_CHECK( HelperFunctions::makeSubsetCont(inJets, selectedJets, msg(), ORdecor.c_str(), ToolName::SELECTOR));
-        if ( m_usePhotons )   { ANA_CHECK( HelperFunctions::makeSubsetCont(inPhotons, selectedPhotons, msg(), ORdecor.c_str(), ToolName::SELECTOR)); }
-        if ( m_useTaus )      { ANA_CHECK( HelperFunctions::makeSubsetCont(inTaus, selectedTaus, msg(), ORdecor.c_str(), ToolName::SELECTOR)); }
+        if ( m_useElectrons ) { ANA_CHECK( HelperFunctions::makeSubsetCont(inElectrons, selectedElectrons, msg(), *m_passORAcc, m_passORBit)); }
+        if ( m_useMuons )     { ANA_CHECK( HelperFunctions::makeSubsetCont(inMuons, selectedMuons, msg(), *m_passORAcc, m_passORBit)); }
+        ANA_CHECK( HelperFunctions::makeSubsetCont(inJets, selectedJets, msg(), *m_passORAcc, m_passORBit));
+        if ( m_usePhotons )   { ANA_CHECK( HelperFunctions::makeSubsetCont(inPhotons, selectedPhotons, msg(), *m_passORAcc, m_passORBit)); }
+        if ( m_useTaus )      { ANA_CHECK( HelperFunctions::makeSubsetCont(inTaus, selectedTaus, msg(), *m_passORAcc, m_passORBit)); }
 
         // add ConstDataVector to TStore
         //
@@ -898,7 +1035,7 @@ EL::StatusCode OverlapRemover :: executeOR(  const xAOD::ElectronContainer* inEl
       // these input containers won't change in the photon syst loop ...
       if( m_useElectrons ) {
         if ( m_store->contains<ConstDataVector<xAOD::ElectronContainer> >(m_inContainerName_Electrons) ) {
-          ANA_CHECK( HelperFunctions::retrieve(inElectrons, m_inContainerName_Electrons, m_event, m_store, msg()) );
+          ANA_CHECK( m_inElectronsHandle.retrieve(inElectrons, msg()) );
         } else {
           nomContainerNotFound = true;
           if ( m_numEvent == 1 ) { ANA_MSG_WARNING( "Could not find nominal container " << m_inContainerName_Electrons << " in xAOD::TStore. Overlap Removal will not be done for the 'all-nominal' case...");  }
@@ -907,7 +1044,7 @@ EL::StatusCode OverlapRemover :: executeOR(  const xAOD::ElectronContainer* inEl
 
       if( m_useMuons ) {
         if ( m_store->contains<ConstDataVector<xAOD::MuonContainer> >(m_inContainerName_Muons) ) {
-          ANA_CHECK( HelperFunctions::retrieve(inMuons, m_inContainerName_Muons, m_event, m_store, msg()) );
+          ANA_CHECK( m_inMuonsHandle.retrieve(inMuons, msg()) );
         } else {
           nomContainerNotFound = true;
           if ( m_numEvent == 1 ) { ANA_MSG_WARNING( "Could not find nominal container " << m_inContainerName_Muons << " in xAOD::TStore. Overlap Removal will not be done for the 'all-nominal' case..."); }
@@ -915,7 +1052,7 @@ EL::StatusCode OverlapRemover :: executeOR(  const xAOD::ElectronContainer* inEl
       }
 
       if ( m_store->contains<ConstDataVector<xAOD::JetContainer> >(m_inContainerName_Jets) ) {
-        ANA_CHECK( HelperFunctions::retrieve(inJets, m_inContainerName_Jets, m_event, m_store, msg()) );
+        ANA_CHECK( m_inJetsHandle.retrieve(inJets, msg()) );
       } else {
         nomContainerNotFound = true;
         if ( m_numEvent == 1 ) { ANA_MSG_WARNING( "Could not find nominal container " << m_inContainerName_Jets << " in xAOD::TStore. Overlap Removal will not be done for the 'all-nominal' case..."); }
@@ -923,7 +1060,7 @@ EL::StatusCode OverlapRemover :: executeOR(  const xAOD::ElectronContainer* inEl
 
       if ( m_useTaus ) {
         if ( m_store->contains<ConstDataVector<xAOD::TauJetContainer> >(m_inContainerName_Taus) ) {
-          ANA_CHECK( HelperFunctions::retrieve(inTaus, m_inContainerName_Taus, m_event, m_store, msg()) );
+          ANA_CHECK( m_inTausHandle.retrieve(inTaus, msg()) );
         } else {
           nomContainerNotFound = true;
           if ( m_numEvent == 1 ) { ANA_MSG_WARNING( "Could not find nominal container " << m_inContainerName_Taus << " in xAOD::TStore. Overlap Removal will not be done for the 'all-nominal' case..."); }
@@ -943,10 +1080,9 @@ EL::StatusCode OverlapRemover :: executeOR(  const xAOD::ElectronContainer* inEl
 
         // do the actual OR
         //
-        ANA_CHECK( m_ORToolbox.masterTool->removeOverlaps(inElectrons, inMuons, inJets, inTaus, inPhotons));
+        ANA_CHECK( removeOverlaps(inElectrons, inMuons, inJets, inPhotons, inTaus));
 
 
-        const std::string ORdecor(m_decor);
         if(m_useCutFlow){
           // fill cutflow histograms
           //
@@ -969,11 +1105,11 @@ EL::StatusCode OverlapRemover :: executeOR(  const xAOD::ElectronContainer* inEl
 
         // resize containers based on OR decision
         //
-        if( m_useElectrons ) { ANA_CHECK( HelperFunctions::makeSubsetCont(inElectrons, selectedElectrons, msg(), ORdecor.c_str(), ToolName::SELECTOR)); }
-        if( m_useMuons )     { ANA_CHECK( HelperFunctions::makeSubsetCont(inMuons, selectedMuons, msg(), ORdecor.c_str(), ToolName::SELECTOR)); }
-        ANA_CHECK( HelperFunctions::makeSubsetCont(inJets, selectedJets, msg(), ORdecor.c_str(), ToolName::SELECTOR));
-        ANA_CHECK( HelperFunctions::makeSubsetCont(inPhotons, selectedPhotons, msg(), ORdecor.c_str(), ToolName::SELECTOR));
-        if ( m_useTaus )     { ANA_CHECK( HelperFunctions::makeSubsetCont(inTaus, selectedTaus, msg(), ORdecor.c_str(), ToolName::SELECTOR)); }
+        if( m_useElectrons ) { ANA_CHECK( HelperFunctions::makeSubsetCont(inElectrons, selectedElectrons, msg(), *m_passORAcc, m_passORBit)); }
+        if( m_useMuons )     { ANA_CHECK( HelperFunctions::makeSubsetCont(inMuons, selectedMuons, msg(), *m_passORAcc, m_passORBit)); }
+        ANA_CHECK( HelperFunctions::makeSubsetCont(inJets, selectedJets, msg(), *m_passORAcc, m_passORBit));
+        ANA_CHECK( HelperFunctions::makeSubsetCont(inPhotons, selectedPhotons, msg(), *m_passORAcc, m_passORBit));
+        if ( m_useTaus )     { ANA_CHECK( HelperFunctions::makeSubsetCont(inTaus, selectedTaus, msg(), *m_passORAcc, m_passORBit)); }
 
         // add ConstDataVector to TStore
         //
@@ -1004,7 +1140,7 @@ EL::StatusCode OverlapRemover :: executeOR(  const xAOD::ElectronContainer* inEl
       // these input containers won't change in the tau syst loop ...
       if( m_useElectrons ) {
         if ( m_store->contains<ConstDataVector<xAOD::ElectronContainer> >(m_inContainerName_Electrons) ) {
-          ANA_CHECK( HelperFunctions::retrieve(inElectrons, m_inContainerName_Electrons, m_event, m_store, msg()) );
+          ANA_CHECK( m_inElectronsHandle.retrieve(inElectrons, msg()) );
         } else {
           nomContainerNotFound = true;
           if ( m_numEvent == 1 ) { ANA_MSG_WARNING( "Could not find nominal container " << m_inContainerName_Electrons << " in xAOD::TStore. Overlap Removal will not be done for the 'all-nominal' case...");  }
@@ -1013,7 +1149,7 @@ EL::StatusCode OverlapRemover :: executeOR(  const xAOD::ElectronContainer* inEl
 
       if( m_useMuons ) {
         if ( m_store->contains<ConstDataVector<xAOD::MuonContainer> >(m_inContainerName_Muons) ) {
-          ANA_CHECK( HelperFunctions::retrieve(inMuons, m_inContainerName_Muons, m_event, m_store, msg()) );
+          ANA_CHECK( m_inMuonsHandle.retrieve(inMuons, msg()) );
         } else {
           nomContainerNotFound = true;
           if ( m_numEvent == 1 ) { ANA_MSG_WARNING( "Could not find nominal container " << m_inContainerName_Muons << " in xAOD::TStore. Overlap Removal will not be done for the 'all-nominal' case..."); }
@@ -1021,7 +1157,7 @@ EL::StatusCode OverlapRemover :: executeOR(  const xAOD::ElectronContainer* inEl
       }
 
       if ( m_store->contains<ConstDataVector<xAOD::JetContainer> >(m_inContainerName_Jets) ) {
-        ANA_CHECK( HelperFunctions::retrieve(inJets, m_inContainerName_Jets, m_event, m_store, msg()) );
+        ANA_CHECK( m_inJetsHandle.retrieve(inJets, msg()) );
       } else {
         nomContainerNotFound = true;
         if ( m_numEvent == 1 ) { ANA_MSG_WARNING( "Could not find nominal container " << m_inContainerName_Jets << " in xAOD::TStore. Overlap Removal will not be done for the 'all-nominal' case..."); }
@@ -1029,7 +1165,7 @@ EL::StatusCode OverlapRemover :: executeOR(  const xAOD::ElectronContainer* inEl
 
       if ( m_usePhotons ) {
         if ( m_store->contains<ConstDataVector<xAOD::PhotonContainer> >(m_inContainerName_Photons) ) {
-          ANA_CHECK( HelperFunctions::retrieve(inPhotons, m_inContainerName_Photons, m_event, m_store, msg()) );
+          ANA_CHECK( m_inPhotonsHandle.retrieve(inPhotons, msg()) );
         } else {
           nomContainerNotFound = true;
           if ( m_numEvent == 1 ) { ANA_MSG_WARNING( "Could not find nominal container " << m_inContainerName_Photons << " in xAOD::TStore. Overlap Removal will not be done for the 'all-nominal' case..."); }
@@ -1049,9 +1185,8 @@ EL::StatusCode OverlapRemover :: executeOR(  const xAOD::ElectronContainer* inEl
 
         // do the actual OR
         //
-        ANA_CHECK( m_ORToolbox.masterTool->removeOverlaps(inElectrons, inMuons, inJets, inTaus, inPhotons));
+        ANA_CHECK( removeOverlaps(inElectrons, inMuons, inJets, inPhotons, inTaus));
 
-        const std::string ORdecor(m_decor);
         if(m_useCutFlow){
           // fill cutflow histograms
           //
@@ -1074,11 +1209,11 @@ EL::StatusCode OverlapRemover :: executeOR(  const xAOD::ElectronContainer* inEl
 
         // resize containers based on OR decision
         //
-        if( m_useElectrons ) { ANA_CHECK( HelperFunctions::makeSubsetCont(inElectrons, selectedElectrons, msg(), ORdecor.c_str(), ToolName::SELECTOR)); }
-        if( m_useMuons )     { ANA_CHECK( HelperFunctions::makeSubsetCont(inMuons, selectedMuons, msg(), ORdecor.c_str(), ToolName::SELECTOR)); }
-        ANA_CHECK( HelperFunctions::makeSubsetCont(inJets, selectedJets, msg(), ORdecor.c_str(), ToolName::SELECTOR));
-        if ( m_usePhotons )  { ANA_CHECK( HelperFunctions::makeSubsetCont(inPhotons, selectedPhotons, msg(), ORdecor.c_str(), ToolName::SELECTOR)); }
-        ANA_CHECK( HelperFunctions::makeSubsetCont(inTaus, selectedTaus, msg(), ORdecor.c_str(), ToolName::SELECTOR));
+        if( m_useElectrons ) { ANA_CHECK( HelperFunctions::makeSubsetCont(inElectrons, selectedElectrons, msg(), *m_passORAcc, m_passORBit)); }
+        if( m_useMuons )     { ANA_CHECK( HelperFunctions::makeSubsetCont(inMuons, selectedMuons, msg(), *m_passORAcc, m_passORBit)); }
+        ANA_CHECK( HelperFunctions::makeSubsetCont(inJets, selectedJets, msg(), *m_passORAcc, m_passORBit));
+        if ( m_usePhotons )  { ANA_CHECK( HelperFunctions::makeSubsetCont(inPhotons, selectedPhotons, msg(), *m_passORAcc, m_passORBit)); }
+        ANA_CHECK( HelperFunctions::makeSubsetCont(inTaus, selectedTaus, msg(), *m_passORAcc, m_passORBit));
 
         // add ConstDataVector to TStore
         //
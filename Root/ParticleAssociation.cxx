@@ -0,0 +1,47 @@
+#include <xAODAnaHelpers/ParticleAssociation.h>
+#include <xAODAnaHelpers/HelperFunctions.h>
+
+#include <cstdio>
+#include <memory>
+#include <utility>
+
+void xAH::ParticleAssociation::build(const xAOD::IParticleContainer* jets, const xAOD::IParticleContainer* leptons, float maxDR)
+{
+  m_offsets.assign(1, 0);
+  m_indices.clear();
+  m_deltaR2.clear();
+  if(!jets) return;
+
+  ParticleKinematics leptonKinematics;
+  leptonKinematics.fill(leptons);
+  std::vector<float> dR2;
+  const float maxDR2 = maxDR*maxDR;
+
+  m_offsets.reserve(jets->size() + 1);
+  for(const xAOD::IParticle* jet : *jets){
+    HelperFunctions::deltaR2(jet->eta(), jet->phi(), leptonKinematics, dR2);
+    for(unsigned int i = 0; i < dR2.size(); ++i){
+      if(dR2[i] >= maxDR2) continue;
+      m_indices.push_back(i);
+      m_deltaR2.push_back(dR2[i]);
+    }
+    m_offsets.push_back(m_indices.size());
+  }
+}
+
+StatusCode xAH::ParticleAssociation::retrieve(const ParticleAssociation*& association,
+                                              const xAOD::IParticleContainer* jets, const std::string& jetName,
+                                              const xAOD::IParticleContainer* leptons, const std::string& leptonName,
+                                              float maxDR, xAOD::TStore* store)
+{
+  char dR[16];
+  std::snprintf(dR, sizeof(dR), "%g", maxDR);
+  const std::string key = "xAH_ParticleAssociation_" + jetName + "_" + leptonName + "_" + dR;
+
+  if(store->contains<ParticleAssociation>(key)) return store->retrieve(association, key);
+
+  std::unique_ptr<ParticleAssociation> built = std::make_unique<ParticleAssociation>();
+  built->build(jets, leptons, maxDR);
+  association = built.get();
+  return store->record(std::move(built), key);
+}
@@ -0,0 +1,42 @@
+#include <xAODAnaHelpers/ParticleKinematics.h>
+
+#include <cmath>
+
+void xAH::ParticleKinematics::fill(const xAOD::IParticleContainer* particles)
+{
+  clear();
+  if(!particles) return;
+
+  const std::size_t n = particles->size();
+  pt.reserve(n); eta.reserve(n); phi.reserve(n); m.reserve(n);
+  px.reserve(n); py.reserve(n); pz.reserve(n);
+  cosPhi.reserve(n); sinPhi.reserve(n);
+
+  for(const xAOD::IParticle* particle : *particles) push_back(particle);
+}
+
+void xAH::ParticleKinematics::push_back(const xAOD::IParticle* particle)
+{
+  const float thisPt  = particle->pt();
+  const float thisEta = particle->eta();
+  const float thisPhi = particle->phi();
+  const float thisCos = std::cos(thisPhi);
+  const float thisSin = std::sin(thisPhi);
+
+  pt.push_back(thisPt);
+  eta.push_back(thisEta);
+  phi.push_back(thisPhi);
+  m.push_back(particle->m());
+  px.push_back(thisPt*thisCos);
+  py.push_back(thisPt*thisSin);
+  pz.push_back(thisPt*std::sinh(thisEta));
+  cosPhi.push_back(thisCos);
+  sinPhi.push_back(thisSin);
+}
+
+void xAH::ParticleKinematics::clear()
+{
+  pt.clear(); eta.clear(); phi.clear(); m.clear();
+  px.clear(); py.clear(); pz.clear();
+  cosPhi.clear(); sinPhi.clear();
+}
@@ -0,0 +1,114 @@
+#include <xAODAnaHelpers/PerfCounters.h>
+
+#include <cstdint>
+#include <cstring>
+#include <utility>
+#include <vector>
+
+#ifdef __linux__
+#include <linux/perf_event.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#endif
+
+#include <TH1D.h>
+
+namespace {
+  // file descriptors of the counters, -1 if not available, -2 if not opened yet
+  std::array<int, xAH::PerfCounters::nCounters> s_fds = {{-2, -2, -2, -2}};
+
+#ifdef __linux__
+  int openCounter(std::uint32_t type, std::uint64_t config)
+  {
+    perf_event_attr attr;
+    std::memset(&attr, 0, sizeof(attr));
+    attr.size = sizeof(attr);
+    attr.type = type;
+    attr.config = config;
+    attr.exclude_kernel = 1;
+    attr.exclude_hv = 1;
+    attr.inherit = 1;
+    attr.read_format = PERF_FORMAT_TOTAL_TIME_ENABLED | PERF_FORMAT_TOTAL_TIME_RUNNING;
+    // this thread, any CPU
+    return static_cast<int>(syscall(__NR_perf_event_open, &attr, 0, -1, -1, 0));
+  }
+#endif
+}
+
+const char* xAH::PerfCounters::name(Counter counter)
+{
+  static const char* names[nCounters] = {"cycles", "instructions", "llc_misses", "branch_misses"};
+  return names[counter];
+}
+
+std::string xAH::PerfCounters::open()
+{
+#ifdef __linux__
+  if(s_fds[0] == -2){
+    s_fds[Cycles]       = openCounter(PERF_TYPE_HARDWARE, PERF_COUNT_HW_CPU_CYCLES);
+    s_fds[Instructions] = openCounter(PERF_TYPE_HARDWARE, PERF_COUNT_HW_INSTRUCTIONS);
+    s_fds[LLCMisses]    = openCounter(PERF_TYPE_HARDWARE, PERF_COUNT_HW_CACHE_MISSES);
+    s_fds[BranchMisses] = openCounter(PERF_TYPE_HARDWARE, PERF_COUNT_HW_BRANCH_MISSES);
+  }
+#else
+  s_fds.fill(-1);
+#endif
+
+  std::string missing;
+  for(int i = 0; i < nCounters; ++i){
+    if(s_fds[i] >= 0) continue;
+    if(!missing.empty()) missing += ", ";
+    missing += name(static_cast<Counter>(i));
+  }
+  return missing;
+}
+
+void xAH::PerfCounters::reopen()
+{
+  if(s_fds[0] == -2) return;
+#ifdef __linux__
+  for(int& fd : s_fds){
+    if(fd >= 0) close(fd);
+    fd = -2;
+  }
+#endif
+  open();
+}
+
+xAH::PerfCounters::Values xAH::PerfCounters::read()
+{
+  Values values = {{0, 0, 0, 0}};
+#ifdef __linux__
+  for(int i = 0; i < nCounters; ++i){
+    if(s_fds[i] < 0) continue;
+    // value, time enabled, time running
+    std::uint64_t buffer[3] = {0, 0, 0};
+    if(::read(s_fds[i], buffer, sizeof(buffer)) != static_cast<ssize_t>(sizeof(buffer))) continue;
+    values[i] = (buffer[2] > 0 && buffer[2] < buffer[1]) ? static_cast<unsigned long long>(static_cast<double>(buffer[0])*buffer[1]/buffer[2]) : buffer[0];
+  }
+#endif
+  return values;
+}
+
+void xAH::PerfCounters::add(const Values& start, const Values& stop)
+{
+  ++m_calls;
+  for(int i = 0; i < nCounters; ++i)
+    if(stop[i] > start[i]) m_total[i] += stop[i] - start[i];
+}
+
+TH1D* xAH::PerfCounters::makeHist(const std::string& name) const
+{
+  std::vector<std::pair<std::string, double> > values = {{"calls", static_cast<double>(m_calls)}};
+  for(int i = 0; i < nCounters; ++i)
+    values.emplace_back(PerfCounters::name(static_cast<Counter>(i)), static_cast<double>(m_total[i]));
+  values.emplace_back("ipc", ipc());
+
+  TH1D* hist = new TH1D(name.c_str(), name.c_str(), values.size(), 0, values.size());
+  hist->SetDirectory(nullptr);
+  for(unsigned int i = 0; i < values.size(); ++i){
+    hist->GetXaxis()->SetBinLabel(i+1, values[i].first.c_str());
+    hist->SetBinContent(i+1, values[i].second);
+  }
+  return hist;
+}
@@ -140,27 +140,36 @@ EL::StatusCode PhotonCalibrator :: initialize ()
   m_outSCContainerName      = m_outContainerName + "ShallowCopy";
   m_outSCAuxContainerName   = m_outSCContainerName + "Aux."; // the period is very important!
 
-  // initialize the CP::EgammaCalibrationAndSmearingTool
+  // initialize the CP::EgammaCalibrationAndSmearingTool, or reuse the one already configured by another egamma calibrator
   //
-  const std::string CalibToolName = m_name + "_EgammaCalibrationAndSmearingTool_Photons";
-  if ( asg::ToolStore::contains<CP::EgammaCalibrationAndSmearingTool>(CalibToolName.c_str()) ) {
-    m_EgammaCalibrationAndSmearingTool = asg::ToolStore::get<CP::EgammaCalibrationAndSmearingTool>(CalibToolName.c_str());
-  } else {
-    m_EgammaCalibrationAndSmearingTool = new CP::EgammaCalibrationAndSmearingTool(CalibToolName.c_str());
-  }
-
-  ANA_CHECK( m_EgammaCalibrationAndSmearingTool->setProperty("ESModel", m_esModel));
-  ANA_CHECK( m_EgammaCalibrationAndSmearingTool->setProperty("decorrelationModel", m_decorrelationModel));
-  if(m_randomRunNumber>0) ANA_CHECK( m_EgammaCalibrationAndSmearingTool->setProperty("randomRunNumber", m_randomRunNumber));
+  const std::string CalibToolName = m_sharedCalibToolName.empty() ? m_name + "_EgammaCalibrationAndSmearingTool_Photons" : m_sharedCalibToolName;
+  const bool reuseCalibTool = !m_sharedCalibToolName.empty() && asg::ToolStore::contains<CP::EgammaCalibrationAndSmearingTool>(CalibToolName.c_str());
 
   //Backwards compatibility
   if (m_useAFII)
     m_forceFastSim = true;
-  if ( isFastSim() )
-    ANA_CHECK( m_EgammaCalibrationAndSmearingTool->setProperty("useAFII", 1));
 
-  ANA_CHECK( m_EgammaCalibrationAndSmearingTool->initialize());
-  m_EgammaCalibrationAndSmearingTool->msg().setLevel( msg().level() );
+  if ( reuseCalibTool ) {
+    ANA_MSG_INFO( "Sharing the already configured " << CalibToolName );
+    m_EgammaCalibrationAndSmearingTool = asg::ToolStore::get<CP::EgammaCalibrationAndSmearingTool>(CalibToolName.c_str());
+  } else {
+    if ( asg::ToolStore::contains<CP::EgammaCalibrationAndSmearingTool>(CalibToolName.c_str()) ) {
+      m_EgammaCalibrationAndSmearingTool = asg::ToolStore::get<CP::EgammaCalibrationAndSmearingTool>(CalibToolName.c_str());
+    } else {
+      m_EgammaCalibrationAndSmearingTool = new CP::EgammaCalibrationAndSmearingTool(CalibToolName.c_str());
+      m_ownsCalibTool = true;
+    }
+
+    ANA_CHECK( m_EgammaCalibrationAndSmearingTool->setProperty("ESModel", m_esModel));
+    ANA_CHECK( m_EgammaCalibrationAndSmearingTool->setProperty("decorrelationModel", m_decorrelationModel));
+    if(m_randomRunNumber>0) ANA_CHECK( m_EgammaCalibrationAndSmearingTool->setProperty("randomRunNumber", m_randomRunNumber));
+
+    if ( isFastSim() )
+      ANA_CHECK( m_EgammaCalibrationAndSmearingTool->setProperty("useAFII", 1));
+
+    ANA_CHECK( m_EgammaCalibrationAndSmearingTool->initialize());
+    m_EgammaCalibrationAndSmearingTool->msg().setLevel( msg().level() );
+  }
 
   // Get a list of recommended systematics for this tool
   //
@@ -298,6 +307,9 @@ EL::StatusCode PhotonCalibrator :: initialize ()
 
 EL::StatusCode PhotonCalibrator :: execute ()
 {
+  auto event = beginEvent();
+  auto timer = timeExecute();
+  if ( eventRejected() ) return EL::StatusCode::SUCCESS;
   // Here you do everything that needs to be done on every single
   // events, e.g. read input variables, apply cuts, and fill
   // histograms and trees.  This is where most of your actual analysis
@@ -320,6 +332,7 @@ EL::StatusCode PhotonCalibrator :: execute ()
   // must be a pointer to be recorded in TStore
   //
   auto vecOutContainerNames = std::make_unique< std::vector< std::string > >();
+  vecOutContainerNames->reserve( m_systList.size() );
 
   for ( const auto& syst_it : m_systList ) {
     ANA_MSG_DEBUG("Systematic Loop for m_systList=" << syst_it.name() );
@@ -377,20 +390,26 @@ EL::StatusCode PhotonCalibrator :: execute ()
         if ( m_EgammaCalibrationAndSmearingTool->applyCorrection( *phSC_itr ) != CP::CorrectionCode::Ok ) {
           ANA_MSG_WARNING( "Problem in CP::EgammaCalibrationAndSmearingTool::applyCorrection()");
         }
-
-        if ( m_isolationCorrectionTool_handle->applyCorrection( *phSC_itr ) != CP::CorrectionCode::Ok ) {
-          ANA_MSG_WARNING( "Problem in CP::IsolationCorrection::applyCorrection()");
-        }
       }
 
       ANA_MSG_DEBUG("Calibrated pt with systematic: " << syst_it.name() << " , pt = " << phSC_itr->pt() * 1e-3 << " GeV");
 
-      ANA_CHECK( decorate(phSC_itr));
-
       ++idx;
 
     } // close calibration loop
 
+    // isolation correction and decorations, as further passes over the calibrated photons
+    for ( auto phSC_itr : *(calibPhotonsSC.first) ) {
+      if ( !((phSC_itr->author() & xAOD::EgammaParameters::AuthorPhoton) || (phSC_itr->author() & xAOD::EgammaParameters::AuthorAmbiguous)) ) continue;
+      if ( m_isolationCorrectionTool_handle->applyCorrection( *phSC_itr ) != CP::CorrectionCode::Ok ) {
+        ANA_MSG_WARNING( "Problem in CP::IsolationCorrection::applyCorrection()");
+      }
+    }
+
+    for ( auto phSC_itr : *(calibPhotonsSC.first) ) {
+      ANA_CHECK( decorate(phSC_itr));
+    }
+
     if ( !xAOD::setOriginalObjectLink(*inPhotons, *(calibPhotonsSC.first)) ) {
       ANA_MSG_ERROR( "Failed to set original object links -- MET rebuilding cannot proceed.");
     }
@@ -401,7 +420,7 @@ EL::StatusCode PhotonCalibrator :: execute ()
 
     // Sort after copying to CDV.
     if ( m_sort ) {
-      std::sort( calibPhotonsCDV->begin(), calibPhotonsCDV->end(), HelperFunctions::sort_pt );
+      HelperFunctions::sortPt( calibPhotonsCDV->begin(), calibPhotonsCDV->end() );
     }
 
     // add SC container to TStore
@@ -427,6 +446,8 @@ EL::StatusCode PhotonCalibrator :: execute ()
 
 EL::StatusCode PhotonCalibrator :: postExecute ()
 {
+  auto timer = timePostExecute();
+  if ( eventRejected() ) return EL::StatusCode::SUCCESS;
   // Here you do everything that needs to be done after the main event
   // processing.  This is typically very rare, particularly in user
   // code.  It is mainly used in implementing the NTupleSvc.
@@ -452,10 +473,10 @@ EL::StatusCode PhotonCalibrator :: finalize ()
 
   ANA_MSG_INFO( "Deleting tool instances...");
 
-  if ( m_EgammaCalibrationAndSmearingTool ) {
+  if ( m_EgammaCalibrationAndSmearingTool && m_ownsCalibTool ) {
     delete m_EgammaCalibrationAndSmearingTool;
-    m_EgammaCalibrationAndSmearingTool = nullptr;
   }
+  m_EgammaCalibrationAndSmearingTool = nullptr;
   if ( m_photonFudgeMCTool ) {
     delete m_photonFudgeMCTool;
     m_photonFudgeMCTool = nullptr;
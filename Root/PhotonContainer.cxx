@@ -292,12 +292,15 @@ void PhotonContainer::setBranches(TTree *tree)
   // PID
   if(m_infoSwitch.m_PID){
     tree->Branch(("n"+m_name+"_IsLoose").c_str(),      &m_n_IsLoose);
+    addCopyBuffer("n"+m_name+"_IsLoose", &m_n_IsLoose);
     setBranch<int>(tree,  "IsLoose"  , m_IsLoose );
 
     tree->Branch(("n"+m_name+"_IsMedium").c_str(),      &m_n_IsMedium);
+    addCopyBuffer("n"+m_name+"_IsMedium", &m_n_IsMedium);
     setBranch<int>(tree,  "IsMedium" , m_IsMedium);
 
     tree->Branch(("n"+m_name+"_IsTight").c_str(),      &m_n_IsTight);
+    addCopyBuffer("n"+m_name+"_IsTight", &m_n_IsTight);
     setBranch<int>(tree,  "IsTight"  , m_IsTight );
   }
 
@@ -28,5 +28,8 @@ EL::StatusCode PhotonHistsAlgo::AddHists( std::string name ) {
 }
 
 EL::StatusCode PhotonHistsAlgo :: execute () {
+  auto event = beginEvent();
+  auto timer = timeExecute();
+  if ( eventRejected() ) return EL::StatusCode::SUCCESS;
   return IParticleHistsAlgo::execute<PhotonHists, xAOD::PhotonContainer>();
 }
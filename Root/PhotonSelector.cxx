@@ -7,6 +7,7 @@
 // c++ include(s):
 #include <iostream>
 #include <typeinfo>
+#include <algorithm>
 #include <sstream>
 
 // EL include(s):
@@ -19,6 +20,7 @@
 #include <xAODAnaHelpers/HelperFunctions.h>
 
 #include <xAODAnaHelpers/PhotonSelector.h>
+#include <xAODAnaHelpers/SelectionFlags.h>
 #include <xAODEgamma/EgammaDefs.h>
 #include <xAODEgamma/EgammaxAODHelpers.h>
 
@@ -158,6 +160,7 @@ EL::StatusCode PhotonSelector :: initialize ()
   while ( std::getline(ss, token, ',') ) {
     m_IsoKeys.push_back(token);
   }
+  m_isoDecisions.setWPs(m_IsoKeys, m_MinIsoWPCut);
 
   if ( m_inContainerName.empty() ) {
     ANA_MSG_ERROR( "InputContainer is empty!");
@@ -165,6 +168,13 @@ EL::StatusCode PhotonSelector :: initialize ()
   }
 
 
+  // the bit of the selection decision in the flag word of the objects
+  m_passSelBit = xAH::SelectionFlags::bit( "passSel" );
+  if ( m_passSelBit < 0 ) {
+    ANA_MSG_ERROR( "No bit left in the selection flags for passSel" );
+    return EL::StatusCode::FAILURE;
+  }
+
   m_numEvent      = 0;
   m_numObject     = 0;
   m_numEventPass  = 0;
@@ -201,6 +211,9 @@ EL::StatusCode PhotonSelector :: initialize ()
 
 EL::StatusCode PhotonSelector :: execute ()
 {
+  auto event = beginEvent();
+  auto timer = timeExecute();
+  if ( eventRejected() ) return EL::StatusCode::SUCCESS;
   // Here you do everything that needs to be done on every single
   // events, e.g. read input variables, apply cuts, and fill
   // histograms and trees.  This is where most of your actual analysis
@@ -238,7 +251,7 @@ EL::StatusCode PhotonSelector :: execute ()
 
     // create output container (if requested)
     ConstDataVector<xAOD::PhotonContainer>* selectedPhotons(nullptr);
-    if ( m_createSelectedContainer ) { selectedPhotons = new ConstDataVector<xAOD::PhotonContainer>(SG::VIEW_ELEMENTS); }
+    if ( m_createSelectedContainer ) { selectedPhotons = new ConstDataVector<xAOD::PhotonContainer>(SG::VIEW_ELEMENTS); selectedPhotons->reserve( inPhotons->size() ); }
 
     // find the selected photons, and return if event passes object selection
     //
@@ -266,6 +279,7 @@ EL::StatusCode PhotonSelector :: execute ()
     // must be a pointer to be recorded in TStore
     //
     auto vecOutContainerNames = std::make_unique< std::vector< std::string > >();
+    vecOutContainerNames->reserve( systNames->size() );
     ANA_MSG_DEBUG( " input list of syst size: " << static_cast<int>(systNames->size()) );
 
     // loop over systematic sets
@@ -280,7 +294,7 @@ EL::StatusCode PhotonSelector :: execute ()
       // create output container (if requested) - one for each systematic
       //
       ConstDataVector<xAOD::PhotonContainer>* selectedPhotons(nullptr);
-      if ( m_createSelectedContainer ) { selectedPhotons = new ConstDataVector<xAOD::PhotonContainer>(SG::VIEW_ELEMENTS); }
+      if ( m_createSelectedContainer ) { selectedPhotons = new ConstDataVector<xAOD::PhotonContainer>(SG::VIEW_ELEMENTS); selectedPhotons->reserve( inPhotons->size() ); }
 
       // find the selected photons, and return if event passes object selection
       //
@@ -325,7 +339,7 @@ EL::StatusCode PhotonSelector :: execute ()
   if(msgLvl(MSG::VERBOSE)) m_store->print();
 
   if( !eventPass ) {
-    wk()->skipEvent();
+    rejectEvent();
     return EL::StatusCode::SUCCESS;
   }
 
@@ -339,13 +353,17 @@ bool PhotonSelector :: executeSelection ( const xAOD::PhotonContainer* inPhotons
   int nPass(0); int nObj(0);
   static SG::AuxElement::Decorator< char > passSelDecor( "passSel" );
 
+  const int nToEvaluate = m_nToProcess > 0 ? std::min( m_nToProcess, static_cast<int>(inPhotons->size()) ) : static_cast<int>(inPhotons->size());
+  bool countRejected(false);
+
   for ( auto ph_itr : *inPhotons ) { // duplicated of basic loop
 
     // if only looking at a subset of photons make sure all are decorated
     //
-    if ( m_nToProcess > 0 && nObj >= m_nToProcess ) {
+    if ( (m_nToProcess > 0 && nObj >= m_nToProcess) || countRejected ) {
       if ( m_decorateSelectedObjects ) {
         passSelDecor( *ph_itr ) = -1;
+        xAH::SelectionFlags::setUndecided( *ph_itr, m_passSelBit );
       } else {
         break;
       }
@@ -357,6 +375,7 @@ bool PhotonSelector :: executeSelection ( const xAOD::PhotonContainer* inPhotons
     bool passSel = this->passCuts( ph_itr );
     if ( m_decorateSelectedObjects ) {
       passSelDecor( *ph_itr ) = passSel;
+      xAH::SelectionFlags::set( *ph_itr, m_passSelBit, passSel );
     }
 
     if ( passSel ) {
@@ -365,6 +384,11 @@ bool PhotonSelector :: executeSelection ( const xAOD::PhotonContainer* inPhotons
         selectedPhotons->push_back( ph_itr );
       }
     }
+
+    // once the number of selected photons rejects the event there is no need to look further
+    if ( m_stopWhenRejected && HelperFunctions::countRejects( nPass, nToEvaluate - nObj, m_pass_min, m_pass_max ) ) {
+      countRejected = true;
+    }
   }
 
   // for cutflow: make sure to count passed objects only once (i.e., this flag will be true only for nominal)
@@ -508,26 +532,9 @@ bool PhotonSelector :: passCuts( const xAOD::Photon* photon )
   // isolation cut
   //
 
-  // Get the "list" of input WPs with the accept() decision from the tool
-  //
-  Root::TAccept accept_list = m_IsolationSelectionTool->accept( *photon );
-
-
-  // Decorate w/ decision for all input WPs
-  //
-  const std::string base_decor("isIsolated");
-  for ( auto WP_itr : m_IsoKeys ) {
-
-    std::string decorWP = base_decor + "_" + WP_itr;
-
-    ANA_MSG_DEBUG( "Decorate photon with " << decorWP << " - accept() ? " << accept_list.getCutResult( WP_itr.c_str()) );
-    photon->auxdecor<char>(decorWP) = static_cast<char>( accept_list.getCutResult( WP_itr.c_str() ) );
-
-  }
-
-  // Apply the cut if needed
+  // Decorate w/ decision for all input WPs, which the tool evaluates in a single accept() call
   //
-  if ( !m_MinIsoWPCut.empty() && !accept_list.getCutResult( m_MinIsoWPCut.c_str() ) ) {
+  if ( !m_isoDecisions.decorate( *photon, m_IsolationSelectionTool->accept( *photon ) ) ) {
     ANA_MSG_DEBUG( "Photon failed isolation cut " << m_MinIsoWPCut );
     return false;
   }
@@ -539,6 +546,8 @@ bool PhotonSelector :: passCuts( const xAOD::Photon* photon )
 
 EL::StatusCode PhotonSelector :: postExecute ()
 {
+  auto timer = timePostExecute();
+  if ( eventRejected() ) return EL::StatusCode::SUCCESS;
   // Here you do everything that needs to be done after the main event
   // processing.  This is typically very rare, particularly in user
   // code.  It is mainly used in implementing the NTupleSvc.
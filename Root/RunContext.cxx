@@ -0,0 +1,57 @@
+#include <xAODAnaHelpers/RunContext.h>
+
+#include <cstdint>
+
+namespace {
+  // the context of the event it was built for, identified by its EventInfo and its run and event numbers
+  struct PublishedContext {
+    xAH::RunContext context;
+    const xAOD::EventInfo* eventInfo = nullptr;
+    uint32_t runNumber = 0;
+    unsigned long long eventNumber = 0;
+  };
+
+  PublishedContext& published()
+  {
+    static PublishedContext published;
+    return published;
+  }
+}
+
+int xAH::RunContext::yearOfRun(unsigned int run)
+{
+  if(run == 0)      return 0;
+  // last run of each year of Run 2
+  if(run <= 284484) return 2015;
+  if(run <= 311481) return 2016;
+  if(run <= 341649) return 2017;
+  return 2018;
+}
+
+const xAH::RunContext& xAH::RunContext::publish(const xAOD::EventInfo& eventInfo)
+{
+  static const SG::AuxElement::ConstAccessor<unsigned int> randomRunNumber("RandomRunNumber");
+  static const SG::AuxElement::ConstAccessor<float> correctedAvgMu("corrected_averageInteractionsPerCrossing");
+
+  PublishedContext& current = published();
+  current.eventInfo   = &eventInfo;
+  current.runNumber   = eventInfo.runNumber();
+  current.eventNumber = eventInfo.eventNumber();
+
+  RunContext& context = current.context;
+  if(randomRunNumber.isAvailable(eventInfo))                          context.randomRunNumber = randomRunNumber(eventInfo);
+  else if(!eventInfo.eventType(xAOD::EventInfo::IS_SIMULATION))       context.randomRunNumber = eventInfo.runNumber();
+  else                                                                context.randomRunNumber = 0;
+  context.year        = yearOfRun(context.randomRunNumber);
+  context.periodIndex = context.year ? context.year - 2015 : -1;
+  context.mu          = correctedAvgMu.isAvailable(eventInfo) ? correctedAvgMu(eventInfo) : eventInfo.averageInteractionsPerCrossing();
+  return context;
+}
+
+const xAH::RunContext& xAH::RunContext::get(const xAOD::EventInfo& eventInfo)
+{
+  const PublishedContext& current = published();
+  if(current.eventInfo == &eventInfo && current.runNumber == eventInfo.runNumber() && current.eventNumber == eventInfo.eventNumber())
+    return current.context;
+  return publish(eventInfo);
+}
@@ -0,0 +1,14 @@
+#include <xAODAnaHelpers/SFProducts.h>
+
+#include <algorithm>
+
+void xAH::SFProducts::reset(std::size_t nVariations)
+{
+  m_products.assign(nVariations, 1.);
+}
+
+void xAH::SFProducts::multiply(const std::vector<float>& sfs)
+{
+  const std::size_t n = std::min(sfs.size(), m_products.size());
+  for(std::size_t i = 0; i < n; ++i) m_products[i] *= sfs[i];
+}
@@ -0,0 +1,114 @@
+#include <xAODAnaHelpers/SelectionFlags.h>
+
+#include <TList.h>
+#include <TObjArray.h>
+#include <TObjString.h>
+#include <TTree.h>
+
+namespace {
+
+  std::vector<std::string>& flags()
+  {
+    static std::vector<std::string> flagNames;
+    return flagNames;
+  }
+
+  const SG::AuxElement::Decorator<unsigned long long>& flagsDecor()
+  {
+    static const SG::AuxElement::Decorator<unsigned long long> decor("xAH_selectionFlags");
+    return decor;
+  }
+
+  const SG::AuxElement::Decorator<unsigned long long>& decidedDecor()
+  {
+    static const SG::AuxElement::Decorator<unsigned long long> decor("xAH_selectionFlagsDecided");
+    return decor;
+  }
+
+}
+
+int xAH::SelectionFlags::find(const std::string& flag)
+{
+  const std::vector<std::string>& flagNames = flags();
+  for(unsigned int i = 0; i < flagNames.size(); ++i){
+    if(flagNames[i] == flag) return i;
+  }
+  return -1;
+}
+
+int xAH::SelectionFlags::bit(const std::string& flag)
+{
+  const int found = find(flag);
+  if(found >= 0) return found;
+  std::vector<std::string>& flagNames = flags();
+  if(flagNames.size() >= 64) return -1;
+  flagNames.push_back(flag);
+  return flagNames.size() - 1;
+}
+
+const std::string& xAH::SelectionFlags::flag(unsigned int bit)
+{
+  return flags().at(bit);
+}
+
+bool xAH::SelectionFlags::isAvailable(const SG::AuxElement& obj)
+{
+  return flagsDecor().isAvailable(obj);
+}
+
+unsigned long long xAH::SelectionFlags::word(const SG::AuxElement& obj)
+{
+  const SG::AuxElement::Decorator<unsigned long long>& decor = flagsDecor();
+  return decor.isAvailable(obj) ? decor(obj) : 0ULL;
+}
+
+void xAH::SelectionFlags::set(const SG::AuxElement& obj, int bit, bool pass)
+{
+  if(bit < 0) return;
+  unsigned long long& flagWord = flagsDecor()(obj);
+  if(pass) flagWord |=   1ULL << bit;
+  else     flagWord &= ~(1ULL << bit);
+  decidedDecor()(obj) |= 1ULL << bit;
+}
+
+void xAH::SelectionFlags::setUndecided(const SG::AuxElement& obj, int bit)
+{
+  if(bit < 0) return;
+  flagsDecor()(obj)   &= ~(1ULL << bit);
+  decidedDecor()(obj) &= ~(1ULL << bit);
+}
+
+bool xAH::SelectionFlags::isDecided(const SG::AuxElement& obj, unsigned long long mask)
+{
+  const SG::AuxElement::Decorator<unsigned long long>& decor = decidedDecor();
+  return decor.isAvailable(obj) && (decor(obj) & mask) == mask;
+}
+
+void xAH::SelectionFlags::writeFlags(TTree* tree)
+{
+  TList* userInfo = tree->GetUserInfo();
+  if(TObject* previous = userInfo->FindObject("selectionFlags")){
+    userInfo->Remove(previous);
+    delete previous;
+  }
+
+  TObjArray* flagNames = new TObjArray();
+  flagNames->SetName("selectionFlags");
+  flagNames->SetOwner(true);
+  for(const std::string& flagName : flags()) flagNames->Add(new TObjString(flagName.c_str()));
+  userInfo->Add(flagNames);
+}
+
+std::vector<std::string> xAH::SelectionFlags::readFlags(TTree* tree)
+{
+  std::vector<std::string> flagNames;
+
+  // a TChain has no user info of its own
+  if(tree->GetTree() == nullptr) tree->LoadTree(0);
+  TTree* current = tree->GetTree() ? tree->GetTree() : tree;
+
+  const TObjArray* stored = dynamic_cast<const TObjArray*>(current->GetUserInfo()->FindObject("selectionFlags"));
+  if(!stored) return flagNames;
+  for(const TObject* flagName : *stored) flagNames.push_back( flagName->GetName() );
+  return flagNames;
+}
@@ -0,0 +1,55 @@
+#include <xAODAnaHelpers/SystematicBlock.h>
+
+#include <cmath>
+
+xAH::SystematicBlock::SystematicBlock(const std::string& name, const std::string& xlabel, int nbins, double xlow, double xhigh) :
+  m_name(name),
+  m_xlabel(xlabel),
+  m_nbins(nbins),
+  m_xlow(xlow),
+  m_xhigh(xhigh),
+  m_binsPerUnit(nbins / (xhigh - xlow)),
+  m_nVariations(0)
+{
+}
+
+void xAH::SystematicBlock::resize(unsigned int nVariations)
+{
+  if(nVariations <= m_nVariations) return;
+  m_nVariations = nVariations;
+  m_sumw.resize(m_nVariations*(m_nbins+2), 0.);
+  m_sumw2.resize(m_nVariations*(m_nbins+2), 0.);
+}
+
+void xAH::SystematicBlock::fill(unsigned int variation, double value, double weight)
+{
+  int bin = 0;
+  if(!(value < m_xhigh))   bin = m_nbins + 1;
+  else if(value >= m_xlow) bin = 1 + int( (value - m_xlow) * m_binsPerUnit );
+  if(bin > m_nbins) bin = m_nbins + 1;
+
+  const std::size_t index = variation*(m_nbins+2) + bin;
+  m_sumw.at(index)  += weight;
+  m_sumw2.at(index) += weight*weight;
+}
+
+TH2F* xAH::SystematicBlock::makeHist(const std::string& prefix, const std::vector<std::string>& variations) const
+{
+  const int nVariations = m_nVariations;
+  TH2F* hist = new TH2F( (prefix + m_name).c_str(), m_name.c_str(), m_nbins, m_xlow, m_xhigh, nVariations, 0, nVariations );
+  hist->GetXaxis()->SetTitle(m_xlabel.c_str());
+  hist->Sumw2();
+
+  for(int iVariation = 0; iVariation < nVariations; ++iVariation){
+    if(static_cast<std::size_t>(iVariation) < variations.size()) hist->GetYaxis()->SetBinLabel(iVariation+1, variations.at(iVariation).c_str());
+    for(int bin = 0; bin <= m_nbins+1; ++bin){
+      const std::size_t index = iVariation*(m_nbins+2) + bin;
+      if(m_sumw[index] == 0. && m_sumw2[index] == 0.) continue;
+      hist->SetBinContent(bin, iVariation+1, m_sumw[index]);
+      hist->SetBinError(bin, iVariation+1, std::sqrt(m_sumw2[index]));
+    }
+  }
+  hist->ResetStats();
+
+  return hist;
+}
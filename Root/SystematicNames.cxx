@@ -0,0 +1,61 @@
+#include <xAODAnaHelpers/SystematicNames.h>
+
+#include <stdexcept>
+
+const xAH::SystematicNames::ID xAH::SystematicNames::nominal;
+
+xAH::SystematicNames& xAH::SystematicNames::instance()
+{
+  static SystematicNames registry;
+  return registry;
+}
+
+xAH::SystematicNames::SystematicNames() :
+  m_size(0)
+{
+  // the nominal case is always registered first
+  m_ids.emplace("", append(""));
+}
+
+xAH::SystematicNames::ID xAH::SystematicNames::append(const std::string& name)
+{
+  const std::size_t id = m_size.load(std::memory_order_relaxed);
+  if(id >= s_chunkSize*s_maxChunks) throw std::length_error("xAH::SystematicNames::intern(): too many systematics registered");
+
+  std::unique_ptr<std::string[]>& chunk = m_chunks[id/s_chunkSize];
+  if(!chunk) chunk.reset(new std::string[s_chunkSize]);
+  chunk[id%s_chunkSize] = name;
+
+  m_size.store(id+1, std::memory_order_release);
+  return id;
+}
+
+xAH::SystematicNames::ID xAH::SystematicNames::intern(const std::string& name)
+{
+  std::lock_guard<std::mutex> lock(m_mutex);
+  auto it = m_ids.find(name);
+  if(it != m_ids.end()) return it->second;
+
+  const ID id = append(name);
+  m_ids.emplace(name, id);
+  return id;
+}
+
+std::vector<xAH::SystematicNames::ID> xAH::SystematicNames::intern(const std::vector<std::string>& names)
+{
+  std::vector<ID> ids;
+  ids.reserve(names.size());
+  for(const auto& name : names) ids.push_back(intern(name));
+  return ids;
+}
+
+const std::string& xAH::SystematicNames::name(ID id) const
+{
+  if(id >= m_size.load(std::memory_order_acquire)) throw std::out_of_range("xAH::SystematicNames::name(): unknown systematic ID " + std::to_string(id));
+  return m_chunks[id/s_chunkSize][id%s_chunkSize];
+}
+
+std::size_t xAH::SystematicNames::size() const
+{
+  return m_size.load(std::memory_order_acquire);
+}
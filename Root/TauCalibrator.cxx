@@ -172,6 +172,9 @@ EL::StatusCode TauCalibrator :: initialize ()
 
 EL::StatusCode TauCalibrator :: execute ()
 {
+  auto event = beginEvent();
+  auto timer = timeExecute();
+  if ( eventRejected() ) return EL::StatusCode::SUCCESS;
   // Here you do everything that needs to be done on every single
   // events, e.g. read input variables, apply cuts, and fill
   // histograms and trees.  This is where most of your actual analysis
@@ -196,6 +199,7 @@ EL::StatusCode TauCalibrator :: execute ()
   // must be a pointer to be recorded in TStore
   //
   auto vecOutContainerNames = std::make_unique< std::vector< std::string > >();
+  vecOutContainerNames->reserve( m_systList.size() );
 
   for ( const auto& syst_it : m_systList ) {
 
@@ -260,7 +264,7 @@ EL::StatusCode TauCalibrator :: execute ()
     // sort after coping to CDV
     if ( m_sort ) {
       ANA_MSG_DEBUG( "sorting");
-      std::sort( calibTausCDV->begin(), calibTausCDV->end(), HelperFunctions::sort_pt );
+      HelperFunctions::sortPt( calibTausCDV->begin(), calibTausCDV->end() );
     }
 
     // add SC container to TStore
@@ -293,6 +297,8 @@ EL::StatusCode TauCalibrator :: execute ()
 
 EL::StatusCode TauCalibrator :: postExecute ()
 {
+  auto timer = timePostExecute();
+  if ( eventRejected() ) return EL::StatusCode::SUCCESS;
   // Here you do everything that needs to be done after the main event
   // processing.  This is typically very rare, particularly in user
   // code.  It is mainly used in implementing the NTupleSvc.
@@ -1,4 +1,5 @@
 #include "xAODAnaHelpers/TauContainer.h"
+#include "xAODAnaHelpers/TrigMatchBits.h"
 
 #include <iostream>
 
@@ -331,10 +332,12 @@ void TauContainer::setBranches(TTree *tree)
     
     for (auto& taueff : m_infoSwitch.m_tauEffWPs) {
       tree->Branch( (m_name + "_TauEff_SF_" + taueff).c_str() , & (*m_TauEff_SF)[ taueff ] );
+      addCopyBuffer( m_name + "_TauEff_SF_" + taueff, & (*m_TauEff_SF)[ taueff ] );
     }
     
     for (auto& trig : m_infoSwitch.m_trigWPs) {
       tree->Branch( (m_name + "_TauTrigEff_SF_" + trig).c_str() , & (*m_TauTrigEff_SF)[ trig ] );
+      addCopyBuffer( m_name + "_TauTrigEff_SF_" + trig, & (*m_TauTrigEff_SF)[ trig ] );
     }
   }
 
@@ -367,17 +370,28 @@ void TauContainer::setBranches(TTree *tree)
   
   if( m_infoSwitch.m_trackAll) {
     tree->Branch( (m_name + "_tracks_pt").c_str() , &m_tau_tracks_pt );
+    addCopyBuffer( m_name + "_tracks_pt", m_tau_tracks_pt );
     tree->Branch( (m_name + "_tracks_eta").c_str() , &m_tau_tracks_eta );
+    addCopyBuffer( m_name + "_tracks_eta", m_tau_tracks_eta );
     tree->Branch( (m_name + "_tracks_phi").c_str() , &m_tau_tracks_phi );
+    addCopyBuffer( m_name + "_tracks_phi", m_tau_tracks_phi );
     
     tree->Branch( (m_name + "_tracks_isCore").c_str() , &m_tau_tracks_isCore );
+    addCopyBuffer( m_name + "_tracks_isCore", m_tau_tracks_isCore );
     tree->Branch( (m_name + "_tracks_isWide").c_str() , &m_tau_tracks_isWide );
+    addCopyBuffer( m_name + "_tracks_isWide", m_tau_tracks_isWide );
     tree->Branch( (m_name + "_tracks_failTrackFilter").c_str() , &m_tau_tracks_failTrackFilter );
+    addCopyBuffer( m_name + "_tracks_failTrackFilter", m_tau_tracks_failTrackFilter );
     tree->Branch( (m_name + "_tracks_passTrkSel").c_str() , &m_tau_tracks_passTrkSel );
+    addCopyBuffer( m_name + "_tracks_passTrkSel", m_tau_tracks_passTrkSel );
     tree->Branch( (m_name + "_tracks_isClCharged").c_str() , &m_tau_tracks_isClCharged );
+    addCopyBuffer( m_name + "_tracks_isClCharged", m_tau_tracks_isClCharged );
     tree->Branch( (m_name + "_tracks_isClIso").c_str() , &m_tau_tracks_isClIso );
+    addCopyBuffer( m_name + "_tracks_isClIso", m_tau_tracks_isClIso );
     tree->Branch( (m_name + "_tracks_isClConv").c_str() , &m_tau_tracks_isClConv );
+    addCopyBuffer( m_name + "_tracks_isClConv", m_tau_tracks_isClConv );
     tree->Branch( (m_name + "_tracks_isClFake").c_str() , &m_tau_tracks_isClFake );
+    addCopyBuffer( m_name + "_tracks_isClFake", m_tau_tracks_isClFake );
   }
 
   return;
@@ -468,19 +482,17 @@ void TauContainer::FillTau( const xAOD::IParticle* particle )
 
   if ( m_infoSwitch.m_trigger ) {
 
-    // retrieve map<string,char> w/ <chain,isMatched>
+    // retrieve the bits w/ the tested and the matched chains, see xAH::TrigMatchBits
     //
-    static SG::AuxElement::Accessor< std::map<std::string,char> > isTrigMatchedMapTauAcc("isTrigMatchedMapTau");
+    static SG::AuxElement::ConstAccessor< unsigned long long > trigMatchTestedBitsTauAcc("trigMatchTestedBitsTau");
+    static SG::AuxElement::ConstAccessor< unsigned long long > isTrigMatchedBitsTauAcc("isTrigMatchedBitsTau");
 
     std::vector<int> matches;
 
-    if ( isTrigMatchedMapTauAcc.isAvailable( *tau ) ) {
-      // loop over map and fill branches
+    if ( trigMatchTestedBitsTauAcc.isAvailable( *tau ) && trigMatchTestedBitsTauAcc( *tau ) ) {
+      // unpack the bits and fill branches
       //
-      for ( auto const &it : (isTrigMatchedMapTauAcc( *tau )) ) {
-	matches.push_back( static_cast<int>(it.second) );
-	m_listTrigChains->push_back( it.first );
-      }
+      xAH::TrigMatchBits::unpack( trigMatchTestedBitsTauAcc( *tau ), isTrigMatchedBitsTauAcc( *tau ), matches, *m_listTrigChains );
     } else {
       matches.push_back( -1 );
       m_listTrigChains->push_back("NONE");
@@ -522,20 +534,17 @@ void TauContainer::FillTau( const xAOD::IParticle* particle )
   }
 
   // might need to delete these
-  if ( m_infoSwitch.m_JetID ) {
-    
-    static SG::AuxElement::Accessor<int> isJetBDTSigVeryLooseAcc ("isJetBDTSigVeryLoose");
-    safeFill<int, int, xAOD::TauJet>(tau, isJetBDTSigVeryLooseAcc, m_isJetBDTSigVeryLoose, -1);
+  // the working point decisions are the bits of the single isTauFlags word of the tau
+  static SG::AuxElement::ConstAccessor<uint32_t> isTauFlagsAcc ("isTauFlags");
+  const bool hasTauFlags = ( m_infoSwitch.m_JetID || m_infoSwitch.m_EleVeto ) && isTauFlagsAcc.isAvailable( *tau );
 
-    static SG::AuxElement::Accessor<int> isJetBDTSigLooseAcc ("isJetBDTSigLoose");
-    safeFill<int, int, xAOD::TauJet>(tau, isJetBDTSigLooseAcc, m_isJetBDTSigLoose, -1);
+  if ( m_infoSwitch.m_JetID ) {
 
-    static SG::AuxElement::Accessor<int> isJetBDTSigMediumAcc ("isJetBDTSigMedium");
-    safeFill<int, int, xAOD::TauJet>(tau, isJetBDTSigMediumAcc, m_isJetBDTSigMedium, -1);
+    m_isJetBDTSigVeryLoose->push_back( hasTauFlags ? static_cast<int>(tau->isTau(xAOD::TauJetParameters::JetBDTSigVeryLoose)) : -1 );
+    m_isJetBDTSigLoose    ->push_back( hasTauFlags ? static_cast<int>(tau->isTau(xAOD::TauJetParameters::JetBDTSigLoose))     : -1 );
+    m_isJetBDTSigMedium   ->push_back( hasTauFlags ? static_cast<int>(tau->isTau(xAOD::TauJetParameters::JetBDTSigMedium))    : -1 );
+    m_isJetBDTSigTight    ->push_back( hasTauFlags ? static_cast<int>(tau->isTau(xAOD::TauJetParameters::JetBDTSigTight))     : -1 );
 
-    static SG::AuxElement::Accessor<int> isJetBDTSigTightAcc ("isJetBDTSigTight");
-    safeFill<int, int, xAOD::TauJet>(tau, isJetBDTSigTightAcc, m_isJetBDTSigTight, -1);
-    
     static SG::AuxElement::Accessor<float> JetBDTScoreAcc ("JetBDTScore");
     safeFill<float, float, xAOD::TauJet>(tau, JetBDTScoreAcc, m_JetBDTScore, -999.);
 
@@ -544,21 +553,15 @@ void TauContainer::FillTau( const xAOD::IParticle* particle )
   }
 
   if ( m_infoSwitch.m_EleVeto ) {
-    
-    static SG::AuxElement::Accessor<int> isEleBDTLooseAcc ("isEleBDTLoose");
-    safeFill<int, int, xAOD::TauJet>(tau, isEleBDTLooseAcc, m_isEleBDTLoose, -1);
-
-    static SG::AuxElement::Accessor<int> isEleBDTMediumAcc ("isEleBDTMedium");
-    safeFill<int, int, xAOD::TauJet>(tau, isEleBDTMediumAcc, m_isEleBDTMedium, -1);
 
-    static SG::AuxElement::Accessor<int> isEleBDTTightAcc ("isEleBDTTight");
-    safeFill<int, int, xAOD::TauJet>(tau, isEleBDTTightAcc, m_isEleBDTTight, -1);
+    m_isEleBDTLoose ->push_back( hasTauFlags ? static_cast<int>(tau->isTau(xAOD::TauJetParameters::EleBDTLoose))  : -1 );
+    m_isEleBDTMedium->push_back( hasTauFlags ? static_cast<int>(tau->isTau(xAOD::TauJetParameters::EleBDTMedium)) : -1 );
+    m_isEleBDTTight ->push_back( hasTauFlags ? static_cast<int>(tau->isTau(xAOD::TauJetParameters::EleBDTTight))  : -1 );
 
     static SG::AuxElement::Accessor<float> EleBDTScoreAcc ("EleBDTScore");
     safeFill<float, float, xAOD::TauJet>(tau, EleBDTScoreAcc, m_EleBDTScore, -999.);
 
-    static SG::AuxElement::Accessor<int> passEleOLRAcc ("passEleOLR");
-    safeFill<int, int, xAOD::TauJet>(tau, passEleOLRAcc, m_passEleOLR, -1);
+    m_passEleOLR->push_back( hasTauFlags ? static_cast<int>(tau->isTau(xAOD::TauJetParameters::PassEleOLR)) : -1 );
   }
 
   if( m_infoSwitch.m_xahTauJetMatching) {
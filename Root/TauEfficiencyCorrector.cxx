@@ -210,6 +210,22 @@ EL::StatusCode TauEfficiencyCorrector :: initialize ()
   }
 
   
+  m_systNames.clear();
+  m_nominalSystNames.clear();
+  for ( const auto& syst_it : m_systList ) {
+    m_systNames.push_back( syst_it.name() );
+    if ( syst_it.name().empty() ) m_nominalSystNames.push_back( syst_it.name() );
+  }
+
+  // Create the name of the SF weight to be recorded
+  std::string sfName = "TauEff_SF_syst" ;
+  if ( !m_WorkingPointEleOLRElectron.empty() ) { sfName += "_EleOLRElectron" + m_WorkingPointEleOLRElectron; }
+  if ( !m_WorkingPointTauID.empty() )          { sfName += "_TauID" + m_WorkingPointTauID; }
+  if ( !m_TriggerName.empty() )                { sfName += "_Trig" + m_TriggerName; }
+  ANA_MSG_DEBUG( "Tau eff. SF decoration: " << sfName );
+  m_sfDecorator         = std::make_unique< SG::AuxElement::Decorator< std::vector<float> > >( sfName );
+  m_sfSysNamesDecorator = std::make_unique< SG::AuxElement::Decorator< std::vector<std::string> > >( m_outputSystNames + "_sysNames" );
+
   // Write output sys names
   if ( m_writeSystToMetadata ) {
     TFile *fileMD = wk()->getOutputFile ("metadata");
@@ -226,6 +242,9 @@ EL::StatusCode TauEfficiencyCorrector :: initialize ()
 
 EL::StatusCode TauEfficiencyCorrector :: execute ()
 {
+  auto event = beginEvent();
+  auto timer = timeExecute();
+  if ( eventRejected() ) return EL::StatusCode::SUCCESS;
   // Here you do everything that needs to be done on every single
   // events, e.g. read input variables, apply cuts, and fill
   // histograms and trees.  This is where most of your actual analysis
@@ -293,6 +312,8 @@ EL::StatusCode TauEfficiencyCorrector :: execute ()
 
 EL::StatusCode TauEfficiencyCorrector :: postExecute ()
 {
+  auto timer = timePostExecute();
+  if ( eventRejected() ) return EL::StatusCode::SUCCESS;
   // Here you do everything that needs to be done after the main event
   // processing.  This is typically very rare, particularly in user
   // code.  It is mainly used in implementing the NTupleSvc.
@@ -362,22 +383,23 @@ EL::StatusCode TauEfficiencyCorrector :: executeSF ( const xAOD::EventInfo* /*ev
   // Every systematic will correspond to a different SF!
   //
   
+  // All the SF types are configured in the one tool, one getEfficiencyScaleFactor() per tau and variation gives their product
+  const std::vector<std::string>& systNames = nominal ? m_systNames : m_nominalSystNames;
+
   std::unique_ptr< std::vector< std::string > > sysVariationNames = nullptr;
-  
-  if ( writeSystNames ) sysVariationNames = std::make_unique< std::vector< std::string > >();
+  if ( writeSystNames ) sysVariationNames = std::make_unique< std::vector< std::string > >( systNames );
+
+  // tauEff sys names are saved in a vector. Entries positions are preserved!
+  //
+  for ( auto tau_itr : *(inputTaus) ) {
+    ( *m_sfDecorator )( *tau_itr ).reserve( ( *m_sfDecorator )( *tau_itr ).size() + systNames.size() );
+    std::vector<std::string>& sfSysNames = ( *m_sfSysNamesDecorator )( *tau_itr );
+    sfSysNames.insert( sfSysNames.end(), systNames.begin(), systNames.end() );
+  }
 
   for ( const auto& syst_it : m_systList ) {
     if ( !syst_it.name().empty() && !nominal ) continue;
 
-    // Create the name of the SF weight to be recorded
-    std::string sfName = "TauEff_SF_syst" ;
-    if ( !m_WorkingPointEleOLRElectron.empty() ) { sfName += "_EleOLRElectron" + m_WorkingPointEleOLRElectron; }
-    if ( !m_WorkingPointTauID.empty() )          { sfName += "_TauID" + m_WorkingPointTauID; }
-    if ( !m_TriggerName.empty() )                { sfName += "_Trig" + m_TriggerName; }
-
-    ANA_MSG_DEBUG( "Tau efficiency SF sys name (to be recorded in xAOD::TStore) is: " << syst_it.name() );
-    if( writeSystNames ) sysVariationNames->push_back(syst_it.name());
-
     // apply syst
     //
     if ( m_tauEffCorrTool_handle->applySystematicVariation(syst_it) != CP::SystematicCode::Ok ) {
@@ -391,18 +413,6 @@ EL::StatusCode TauEfficiencyCorrector :: executeSF ( const xAOD::EventInfo* /*ev
     unsigned int idx(0);
     for ( auto tau_itr : *(inputTaus) ) {
 
-  	ANA_MSG_DEBUG( "Applying tau efficiency SF" );
-
-  	// obtain tau efficiency SF as a float (to be stored away separately)
-  	//
-  	//  If SF decoration vector doesn't exist, create it (will be done only for the 1st systematic for *this* tau)
-  	//
-
-  	SG::AuxElement::Decorator< std::vector<float> > sfVec( sfName );
-  	if ( !sfVec.isAvailable( *tau_itr ) ) {
-          sfVec( *tau_itr ) = std::vector<float>();
-  	}
-
   	double tauEffSF(-1.0);
   	if ( m_tauEffCorrTool_handle->getEfficiencyScaleFactor( *tau_itr, tauEffSF ) != CP::CorrectionCode::Ok ) {
   	  ANA_MSG_WARNING( "Problem in getEfficiencyScaleFactor");
@@ -411,23 +421,16 @@ EL::StatusCode TauEfficiencyCorrector :: executeSF ( const xAOD::EventInfo* /*ev
   	//
   	// Add it to decoration vector
   	//
-  	sfVec( *tau_itr ).push_back( tauEffSF );
-
-        // tauEff sys names are saved in a vector. Entries positions are preserved!
-        //
-  	SG::AuxElement::Decorator< std::vector<std::string> > sfVec_sysNames( m_outputSystNames + "_sysNames" );
-  	if ( !sfVec_sysNames.isAvailable( *tau_itr ) ) {
-          sfVec_sysNames( *tau_itr ) = std::vector<std::string>();
+  	( *m_sfDecorator )( *tau_itr ).push_back( tauEffSF );
+
+        if ( msgLvl(MSG::DEBUG) ) {
+          ANA_MSG_DEBUG( "===>>>");
+          ANA_MSG_DEBUG( "Tau " << idx << ", pt = " << tau_itr->pt()*1e-3 << " GeV" );
+          ANA_MSG_DEBUG( "Systematic: " << syst_it.name() );
+          ANA_MSG_DEBUG( "Tau eff. SF:");
+          ANA_MSG_DEBUG( "\t " << tauEffSF << " (from getEfficiencyScaleFactor())" );
+          ANA_MSG_DEBUG( "--------------------------------------");
         }
-  	sfVec_sysNames( *tau_itr ).push_back( syst_it.name().c_str() );
-
-        ANA_MSG_DEBUG( "===>>>");
-        ANA_MSG_DEBUG( "Tau " << idx << ", pt = " << tau_itr->pt()*1e-3 << " GeV" );
-        ANA_MSG_DEBUG( "Tau eff. SF decoration: " << sfName );
-        ANA_MSG_DEBUG( "Systematic: " << syst_it.name() );
-        ANA_MSG_DEBUG( "Tau eff. SF:");
-        ANA_MSG_DEBUG( "\t " << tauEffSF << " (from getEfficiencyScaleFactor())" );
-        ANA_MSG_DEBUG( "--------------------------------------");
 
   	++idx;
 
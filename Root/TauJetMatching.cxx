@@ -150,6 +150,9 @@ EL::StatusCode TauJetMatching :: initialize ()
 
 EL::StatusCode TauJetMatching :: execute ()
 {
+  auto event = beginEvent();
+  auto timer = timeExecute();
+  if ( eventRejected() ) return EL::StatusCode::SUCCESS;
   // Here you do everything that needs to be done on every single
   // events, e.g. read input variables, apply cuts, and fill
   // histograms and trees.  This is where most of your actual analysis
@@ -264,6 +267,8 @@ bool TauJetMatching :: executeDecoration ( std::unordered_map<int, std::pair<con
 
 EL::StatusCode TauJetMatching :: postExecute ()
 {
+  auto timer = timePostExecute();
+  if ( eventRejected() ) return EL::StatusCode::SUCCESS;
   // Here you do everything that needs to be done after the main event
   // processing.  This is typically very rare, particularly in user
   // code.  It is mainly used in implementing the NTupleSvc.
@@ -327,52 +332,22 @@ std::unordered_map<int, std::pair<const xAOD::TauJet*, const xAOD::Jet* > > TauJ
   // is the  container index of the matched tau and the value
   // is the pair of the matched tau and the corresponding jet
   
-  float default_best_DR = best_DR;
-  int ijet = -1;
-  int best_ijet = -1;
-  const xAOD::Jet* best_jet = nullptr;
-
   std::unordered_map<int, std::pair<const xAOD::TauJet*, const xAOD::Jet*>> match_map;
-  
-  for (const auto jet : *jetCont) {
-      ++ijet;
-      
-      int itau = -1;
-      int best_itau = -1;
-      const xAOD::TauJet* best_tau = nullptr;
-      float DR = 0;
-      
-      for (const auto tau : *tauCont) {
-        ++itau;
-        
-        DR = this->getDR(tau->eta(),jet->eta(),tau->phi(),jet->phi());
-
-        if (DR < best_DR) {
-          best_DR = DR;
-          best_tau = tau;
-          best_jet = jet;
-          best_itau = itau;
-          best_ijet = ijet;
-        }
-      }
-      
-      std::unordered_map<int, std::pair<const xAOD::TauJet*, const xAOD::Jet* > >::const_iterator got = match_map.find (best_itau);
-      
-      // if a new match is found for a previous 
-      // tau keep the new match if it is better 
-      
-      if (got == match_map.end() and best_itau != -1 and best_ijet != -1) {
-        match_map[best_itau] = std::pair<const xAOD::TauJet*, const xAOD::Jet*>(best_tau, best_jet);
-      }
-      else if (got != match_map.end() and best_itau != -1 and best_ijet != -1) {
-        float old_DR = this->getDR(match_map[best_itau].first->eta(), match_map[best_itau].second->eta(),match_map[best_itau].first->phi(), match_map[best_itau].second->phi());
-        if (old_DR > best_DR) {
-          match_map[best_itau] = std::pair<const xAOD::TauJet*, const xAOD::Jet*>(best_tau, best_jet);
-        }
-      }
-      
-      // reset the best_DR to the default value
-      best_DR = default_best_DR;
+
+  // read eta and phi once, and compute all the jet-tau distances in one go
+  m_jetKinematics.fill(jetCont);
+  m_tauKinematics.fill(tauCont);
+  HelperFunctions::deltaR2Matrix(m_jetKinematics, m_tauKinematics, m_dR2);
+
+  if (m_greedyMatching) {
+    HelperFunctions::matchGreedyDeltaR2(m_dR2.data(), m_jetKinematics.size(), m_tauKinematics.size(), best_DR*best_DR, m_tauToJet);
+  } else {
+    HelperFunctions::matchNearestDeltaR2(m_dR2.data(), m_jetKinematics.size(), m_tauKinematics.size(), best_DR*best_DR, m_tauToJet);
+  }
+
+  for (std::size_t itau = 0; itau < m_tauToJet.size(); ++itau) {
+    if (m_tauToJet[itau] < 0) continue;
+    match_map[itau] = std::pair<const xAOD::TauJet*, const xAOD::Jet*>(tauCont->at(itau), jetCont->at(m_tauToJet[itau]));
   }
 
   return match_map;
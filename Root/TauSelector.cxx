@@ -10,6 +10,7 @@
 // c++ include(s):
 #include <iostream>
 #include <typeinfo>
+#include <algorithm>
 #include <map>
 
 // EL include(s):
@@ -27,6 +28,8 @@
 #include "xAODAnaHelpers/TauSelector.h"
 #include "xAODAnaHelpers/HelperClasses.h"
 #include "xAODAnaHelpers/HelperFunctions.h"
+#include "xAODAnaHelpers/SelectionFlags.h"
+#include "xAODAnaHelpers/TrigMatchBits.h"
 #include "PATCore/TAccept.h"
 // tool includes
 #include "TauAnalysisTools/TauSelectionTool.h"  
@@ -177,6 +180,13 @@ EL::StatusCode TauSelector :: initialize ()
     return EL::StatusCode::FAILURE;
   }
 
+  // the bit of the selection decision in the flag word of the objects
+  m_passSelBit = xAH::SelectionFlags::bit( m_decorationName );
+  if ( m_passSelBit < 0 ) {
+    ANA_MSG_ERROR( "No bit left in the selection flags for " << m_decorationName );
+    return EL::StatusCode::FAILURE;
+  }
+
   m_numEvent      = 0;
   m_numObject     = 0;
   m_numEventPass  = 0;
@@ -284,6 +294,9 @@ EL::StatusCode TauSelector :: initialize ()
 
 EL::StatusCode TauSelector :: execute ()
 {
+  auto event = beginEvent();
+  auto timer = timeExecute();
+  if ( eventRejected() ) return EL::StatusCode::SUCCESS;
   // Here you do everything that needs to be done on every single
   // events, e.g. read input variables, apply cuts, and fill
   // histograms and trees.  This is where most of your actual analysis
@@ -326,6 +339,17 @@ EL::StatusCode TauSelector :: execute ()
    	m_diTauTrigChainsList.push_back(ditau_trig);
     }
 
+    // fix the bit of each chain in the trigger matching decorations
+    //
+    for ( auto const &chain : m_singleTauTrigChainsList ) {
+      const int bit = xAH::TrigMatchBits::bit( chain );
+      if ( bit < 0 ) {
+        ANA_MSG_ERROR( "At most " << xAH::TrigMatchBits::maxChains << " trigger chains can be matched in a job, cannot add " << chain );
+        return EL::StatusCode::FAILURE;
+      }
+      m_singleTauTrigChainsBits.push_back( bit );
+    }
+
     ANA_MSG_INFO( "Input single tau trigger chains that will be considered for matching:\n");
     for ( auto const &chain : m_singleTauTrigChainsList ) { ANA_MSG_INFO( "\t " << chain); }
     ANA_MSG_INFO( "\n");
@@ -354,7 +378,7 @@ EL::StatusCode TauSelector :: execute ()
     // create output container (if requested)
     //
     ConstDataVector<xAOD::TauJetContainer>* selectedTaus(nullptr);
-    if ( m_createSelectedContainer ) { selectedTaus = new ConstDataVector<xAOD::TauJetContainer>(SG::VIEW_ELEMENTS); }
+    if ( m_createSelectedContainer ) { selectedTaus = new ConstDataVector<xAOD::TauJetContainer>(SG::VIEW_ELEMENTS); selectedTaus->reserve( inTaus->size() ); }
 
     // find the selected taus, and return if event passes object selection
     //
@@ -383,6 +407,7 @@ EL::StatusCode TauSelector :: execute ()
     // must be a pointer to be recorded in TStore
     //
     auto vecOutContainerNames = std::make_unique< std::vector< std::string > >();
+    vecOutContainerNames->reserve( systNames->size() );
     ANA_MSG_DEBUG( " input list of syst size: " << static_cast<int>(systNames->size()) );
 
     // loop over systematic sets
@@ -397,7 +422,7 @@ EL::StatusCode TauSelector :: execute ()
       // create output container (if requested) - one for each systematic
       //
       ConstDataVector<xAOD::TauJetContainer>* selectedTaus(nullptr);
-      if ( m_createSelectedContainer ) { selectedTaus = new ConstDataVector<xAOD::TauJetContainer>(SG::VIEW_ELEMENTS); }
+      if ( m_createSelectedContainer ) { selectedTaus = new ConstDataVector<xAOD::TauJetContainer>(SG::VIEW_ELEMENTS); selectedTaus->reserve( inTaus->size() ); }
 
       // find the selected Taus, and return if event passes object selection
       //
@@ -443,7 +468,7 @@ EL::StatusCode TauSelector :: execute ()
   if(msgLvl(MSG::VERBOSE)) m_store->print();
 
   if( !eventPass ) {
-    wk()->skipEvent();
+    rejectEvent();
     return EL::StatusCode::SUCCESS;
   }
 
@@ -460,13 +485,17 @@ bool TauSelector :: executeSelection ( const xAOD::TauJetContainer* inTaus, floa
 
   ANA_MSG_DEBUG( "Initial Taus: " << static_cast<uint32_t>(inTaus->size()) );
 
+  const int nToEvaluate = m_nToProcess > 0 ? std::min( m_nToProcess, static_cast<int>(inTaus->size()) ) : static_cast<int>(inTaus->size());
+  bool countRejected(false);
+
   for ( auto tau_itr : *inTaus ) { // duplicated of basic loop
 
     // if only looking at a subset of Taus make sure all are decorated
     //
-    if ( m_nToProcess > 0 && nObj >= m_nToProcess ) {
+    if ( (m_nToProcess > 0 && nObj >= m_nToProcess) || countRejected ) {
       if ( m_decorateSelectedObjects ) {
         passSelDecor( *tau_itr ) = -1;
+        xAH::SelectionFlags::setUndecided( *tau_itr, m_passSelBit );
       } else {
         break;
       }
@@ -477,6 +506,7 @@ bool TauSelector :: executeSelection ( const xAOD::TauJetContainer* inTaus, floa
     bool passSel = this->passCuts( tau_itr );
     if ( m_decorateSelectedObjects ) {
       passSelDecor( *tau_itr ) = passSel;
+      xAH::SelectionFlags::set( *tau_itr, m_passSelBit, passSel );
     }
 
     if ( passSel ) {
@@ -485,6 +515,11 @@ bool TauSelector :: executeSelection ( const xAOD::TauJetContainer* inTaus, floa
         selectedTaus->push_back( tau_itr );
       }
     }
+
+    // once the number of selected Taus rejects the event there is no need to look further
+    if ( m_stopWhenRejected && HelperFunctions::countRejects( nPass, nToEvaluate - nObj, m_pass_min, m_pass_max ) ) {
+      countRejected = true;
+    }
   }
 
   // for cutflow: make sure to count passed objects only once (i.e., this flag will be true only for nominal)
@@ -526,33 +561,36 @@ bool TauSelector :: executeSelection ( const xAOD::TauJetContainer* inTaus, floa
 
     unsigned int nSelectedTaus = selectedTaus->size();
 
-    static SG::AuxElement::Decorator< std::map<std::string,char> > isTrigMatchedMapTauDecor( "isTrigMatchedMapTau" );
+    static SG::AuxElement::Decorator< unsigned long long > trigMatchTestedBitsTauDecor( "trigMatchTestedBitsTau" );
+    static SG::AuxElement::Decorator< unsigned long long > isTrigMatchedBitsTauDecor( "isTrigMatchedBitsTau" );
+
+    //  Each tau is decorated w/ the bits of the tested chains and the bits of the matched chains,
+    //  the bit of each chain is fixed by xAH::TrigMatchBits when the chain lists are parsed
+    //
+    for ( auto const tau : *selectedTaus ) {
+      trigMatchTestedBitsTauDecor( *tau ) = 0;
+      isTrigMatchedBitsTauDecor( *tau )   = 0;
+    }
 
     if ( nSelectedTaus > 0 ) {
 
       ANA_MSG_DEBUG( "Doing single tau trigger matching...");
 
-      for ( auto const &chain : m_singleTauTrigChainsList ) {
+      for ( unsigned int ichain = 0; ichain < m_singleTauTrigChainsList.size(); ++ichain ) {
+
+        auto const &chain = m_singleTauTrigChainsList.at(ichain);
 
         ANA_MSG_DEBUG( "\t checking trigger chain " << chain);
 
         for ( auto const tau : *selectedTaus ) {
 
-          //  For each tau, decorate w/ a map<string,char> with the 'isMatched' info associated
-          //  to each trigger chain in the input list.
-          //  If decoration map doesn't exist for this tau yet, create it (will be done only for the 1st iteration on the chain names)
-          //
-          if ( !isTrigMatchedMapTauDecor.isAvailable( *tau ) ) {
-            isTrigMatchedMapTauDecor( *tau ) = std::map<std::string,char>();
-          }
-
           // check whether the tau is matched (NOTE: no DR is required for taus)
           //
           char matched = ( m_trigTauMatchTool_handle->match( *tau, chain ) );
 
           ANA_MSG_DEBUG( "\t\t is tau trigger matched? " << matched);
 
-          ( isTrigMatchedMapTauDecor( *tau ) )[chain] = matched;
+          xAH::TrigMatchBits::set( trigMatchTestedBitsTauDecor( *tau ), isTrigMatchedBitsTauDecor( *tau ), m_singleTauTrigChainsBits.at(ichain), matched );
         }
       }
 
@@ -627,6 +665,8 @@ bool TauSelector :: executeSelection ( const xAOD::TauJetContainer* inTaus, floa
 
 EL::StatusCode TauSelector :: postExecute ()
 {
+  auto timer = timePostExecute();
+  if ( eventRejected() ) return EL::StatusCode::SUCCESS;
   // Here you do everything that needs to be done after the main event
   // processing.  This is typically very rare, particularly in user
   // code.  It is mainly used in implementing the NTupleSvc.
@@ -692,60 +732,37 @@ int TauSelector :: passCuts( const xAOD::TauJet* tau ) {
 
   // JetBDTSigID decoration
   // ----------------------
-  static SG::AuxElement::Decorator< int > isJetBDTSigVeryLoose("isJetBDTSigVeryLoose");
-  static SG::AuxElement::Decorator< int > isJetBDTSigLoose("isJetBDTSigLoose");
-  static SG::AuxElement::Decorator< int > isJetBDTSigMedium("isJetBDTSigMedium");
-  static SG::AuxElement::Decorator< int > isJetBDTSigTight("isJetBDTSigTight");
-
+  // NB: the working point decisions (JetBDTSig*, EleBDT*, PassEleOLR) are not copied into decorations,
+  //     they are all bits of the isTauFlags word of the tau and TauContainer reads them from there
+  //
   static SG::AuxElement::Decorator< float > JetBDTScore("JetBDTScore");
   static SG::AuxElement::Decorator< float > JetBDTScoreSigTrans("JetBDTScoreSigTrans");
-  
-
-  isJetBDTSigVeryLoose( *tau ) = static_cast<int>(tau->isTau(xAOD::TauJetParameters::JetBDTSigVeryLoose));
-  isJetBDTSigLoose( *tau ) = static_cast<int>(tau->isTau(xAOD::TauJetParameters::JetBDTSigLoose));
-  isJetBDTSigMedium( *tau ) = static_cast<int>(tau->isTau(xAOD::TauJetParameters::JetBDTSigMedium));
-  isJetBDTSigTight( *tau ) = static_cast<int>(tau->isTau(xAOD::TauJetParameters::JetBDTSigTight));
 
   JetBDTScore( *tau ) = static_cast<float>(tau->discriminant(xAOD::TauJetParameters::BDTJetScore));
   JetBDTScoreSigTrans( *tau ) = static_cast<float>(tau->discriminant(xAOD::TauJetParameters::BDTJetScoreSigTrans));
 
   // EleBDT decoration
   // -----------------
-  static SG::AuxElement::Decorator< int > isEleBDTLoose("isEleBDTLoose");
-  static SG::AuxElement::Decorator< int > isEleBDTMedium("isEleBDTMedium");
-  static SG::AuxElement::Decorator< int > isEleBDTTight("isEleBDTTight");
-
   static SG::AuxElement::Decorator< float > EleBDTScore("EleBDTScore");
-  
-
-  isEleBDTLoose( *tau ) = static_cast<int>(tau->isTau(xAOD::TauJetParameters::EleBDTLoose));
-  isEleBDTMedium( *tau ) = static_cast<int>(tau->isTau(xAOD::TauJetParameters::EleBDTMedium));
-  isEleBDTTight( *tau ) = static_cast<int>(tau->isTau(xAOD::TauJetParameters::EleBDTTight));
 
   EleBDTScore( *tau ) = static_cast<float>(tau->discriminant(xAOD::TauJetParameters::BDTEleScore));
 
 
-  // EleOLR decoration
-  // -----------------
-  static SG::AuxElement::Decorator< int > passEleOLR("passEleOLR");
-  
-  passEleOLR( *tau ) = static_cast<int>(tau->isTau(xAOD::TauJetParameters::PassEleOLR));
-
   if (m_decorateWithTracks) {
 
      // TauTracks decoration
      // --------------------
-     SG::AuxElement::Decorator< std::vector<float> > tauTrackPt( "trackPt" );
-     SG::AuxElement::Decorator< std::vector<float> > tauTrackEta( "trackEta" );
-     SG::AuxElement::Decorator< std::vector<float> > tauTrackPhi( "trackPhi" );
-     SG::AuxElement::Decorator< std::vector<int> > tauTrackIsCore( "trackIsCore" );
-     SG::AuxElement::Decorator< std::vector<int> > tauTrackIsWide( "trackIsWide" );
-     SG::AuxElement::Decorator< std::vector<int> > tauTrackFailTrackFilter( "trackFailTrackFilter" );
-     SG::AuxElement::Decorator< std::vector<int> > tauTrackPassTrkSel( "trackPassTrkSel" );
-     SG::AuxElement::Decorator< std::vector<int> > tauTrackIsClCharged( "trackIsClCharged" );
-     SG::AuxElement::Decorator< std::vector<int> > tauTrackIsClIso( "trackIsClIso" );
-     SG::AuxElement::Decorator< std::vector<int> > tauTrackIsClConv( "trackIsClConv" );
-     SG::AuxElement::Decorator< std::vector<int> > tauTrackIsClFake( "trackIsClFake" );
+     static SG::AuxElement::Decorator< std::vector<float> > tauTrackPt( "trackPt" );
+     static SG::AuxElement::Decorator< std::vector<float> > tauTrackEta( "trackEta" );
+     static SG::AuxElement::Decorator< std::vector<float> > tauTrackPhi( "trackPhi" );
+     static SG::AuxElement::Decorator< std::vector<int> > tauTrackIsCore( "trackIsCore" );
+     static SG::AuxElement::Decorator< std::vector<int> > tauTrackIsWide( "trackIsWide" );
+     static SG::AuxElement::Decorator< std::vector<int> > tauTrackFailTrackFilter( "trackFailTrackFilter" );
+     static SG::AuxElement::Decorator< std::vector<int> > tauTrackPassTrkSel( "trackPassTrkSel" );
+     static SG::AuxElement::Decorator< std::vector<int> > tauTrackIsClCharged( "trackIsClCharged" );
+     static SG::AuxElement::Decorator< std::vector<int> > tauTrackIsClIso( "trackIsClIso" );
+     static SG::AuxElement::Decorator< std::vector<int> > tauTrackIsClConv( "trackIsClConv" );
+     static SG::AuxElement::Decorator< std::vector<int> > tauTrackIsClFake( "trackIsClFake" );
      
      
      for (const xAOD::TauTrack* trk : tau->allTracks()){
@@ -0,0 +1,105 @@
+#include <xAODAnaHelpers/TraceWriter.h>
+
+#include <sstream>
+#include <unistd.h>
+
+#include "xAODRootAccess/TEvent.h"
+#include "xAODRootAccess/TStore.h"
+#include "xAODBase/IParticleContainer.h"
+#include "xAODEventInfo/EventInfo.h"
+
+xAH::TraceWriter& xAH::TraceWriter::instance()
+{
+  static TraceWriter trace;
+  return trace;
+}
+
+bool xAH::TraceWriter::open(const std::string& fileName, unsigned int everyNEvents, double slowEventMs, const std::string& containers)
+{
+  if(isOpen()) return fileName == m_fileName;
+
+  m_file.open(fileName.c_str());
+  if(!m_file.is_open()) return false;
+  m_fileName = fileName;
+  m_everyNEvents = everyNEvents;
+  m_slowEventMs = slowEventMs;
+
+  m_containers.clear();
+  std::istringstream ss(containers);
+  std::string container;
+  while(ss >> container) m_containers.push_back(container);
+
+  m_origin = std::chrono::steady_clock::now();
+  m_file << "{\"displayTimeUnit\":\"ms\",\"traceEvents\":[";
+  m_firstSpan = true;
+  return true;
+}
+
+void xAH::TraceWriter::newEvent(long long entry, const void* fileId, xAOD::TEvent* event, xAOD::TStore* store)
+{
+  if(!isOpen()) return;
+  if(entry == m_entry && fileId == m_fileId) return;
+  flushEvent();
+
+  m_entry = entry;
+  m_fileId = fileId;
+  ++m_events;
+  m_event = event;
+  m_store = store;
+  m_eventMs = 0.;
+
+  m_runNumber = 0;
+  m_eventNumber = 0;
+  const xAOD::EventInfo* eventInfo(nullptr);
+  if(m_event && m_event->contains<xAOD::EventInfo>("EventInfo") && m_event->retrieve(eventInfo, "EventInfo").isSuccess()){
+    m_runNumber = eventInfo->runNumber();
+    m_eventNumber = eventInfo->eventNumber();
+  }
+}
+
+void xAH::TraceWriter::addSpan(const std::string& name, const std::string& category,
+                               std::chrono::steady_clock::time_point start, std::chrono::steady_clock::time_point stop)
+{
+  if(!isOpen()) return;
+
+  const double ts  = std::chrono::duration<double, std::micro>(start - m_origin).count();
+  const double dur = std::chrono::duration<double, std::micro>(stop - start).count();
+  m_eventMs += dur/1e3;
+
+  std::ostringstream span;
+  span << "{\"name\":\"" << name << "\",\"cat\":\"" << category << "\",\"ph\":\"X\""
+       << ",\"ts\":" << ts << ",\"dur\":" << dur << ",\"pid\":" << getpid() << ",\"tid\":0"
+       << ",\"args\":{\"runNumber\":" << m_runNumber << ",\"eventNumber\":" << m_eventNumber << ",\"entry\":" << m_entry;
+
+  // the sizes at the end of the algorithm, so they include what it produced
+  for(const auto& container: m_containers){
+    const xAOD::IParticleContainer* particles(nullptr);
+    if(m_store && m_store->contains<xAOD::IParticleContainer>(container)) m_store->retrieve(particles, container).ignore();
+    else if(m_event && m_event->contains<xAOD::IParticleContainer>(container)) m_event->retrieve(particles, container).ignore();
+    if(particles) span << ",\"" << container << "\":" << particles->size();
+  }
+  span << "}}";
+  m_spans.push_back(span.str());
+}
+
+void xAH::TraceWriter::flushEvent()
+{
+  const bool sampled = m_everyNEvents > 0 && (m_events - 1) % m_everyNEvents == 0;
+  const bool slow = m_slowEventMs > 0. && m_eventMs > m_slowEventMs;
+  if(!m_spans.empty() && (sampled || slow)){
+    for(const auto& span: m_spans){
+      m_file << (m_firstSpan ? "\n" : ",\n") << span;
+      m_firstSpan = false;
+    }
+    ++m_eventsWritten;
+  }
+  m_spans.clear();
+}
+
+void xAH::TraceWriter::close()
+{
+  if(!isOpen()) return;
+  flushEvent();
+  m_file << "\n]}\n";
+  m_file.close();
+}
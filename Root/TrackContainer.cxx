@@ -3,8 +3,38 @@
 #include <iostream>
 #include <xAODTracking/TrackParticle.h>
 
+#include <algorithm>
+
 using namespace xAH;
 
+namespace {
+  // the hit counts of the numbers detail in their order in the packedHits word, with the number of bits they get
+  struct HitCount {
+    const char* name;
+    unsigned int bits;
+    unsigned char TrackPart::* field;
+  };
+
+  const HitCount hitCounts[] = {
+    {"numberOfInnermostPixelLayerHits",       3, &TrackPart::numberOfInnermostPixelLayerHits},
+    {"numberOfNextToInnermostPixelLayerHits", 3, &TrackPart::numberOfNextToInnermostPixelLayerHits},
+    {"numberOfPhiHoleLayers",                 3, &TrackPart::numberOfPhiHoleLayers},
+    {"numberOfPhiLayers",                     4, &TrackPart::numberOfPhiLayers},
+    {"numberOfPixelDeadSensors",              3, &TrackPart::numberOfPixelDeadSensors},
+    {"numberOfPixelHits",                     4, &TrackPart::numberOfPixelHits},
+    {"numberOfPixelHoles",                    4, &TrackPart::numberOfPixelHoles},
+    {"numberOfPixelSharedHits",               4, &TrackPart::numberOfPixelSharedHits},
+    {"numberOfPrecisionHoleLayers",           3, &TrackPart::numberOfPrecisionHoleLayers},
+    {"numberOfPrecisionLayers",               4, &TrackPart::numberOfPrecisionLayers},
+    {"numberOfSCTDeadSensors",                3, &TrackPart::numberOfSCTDeadSensors},
+    {"numberOfSCTHits",                       5, &TrackPart::numberOfSCTHits},
+    {"numberOfSCTHoles",                      4, &TrackPart::numberOfSCTHoles},
+    {"numberOfSCTSharedHits",                 4, &TrackPart::numberOfSCTSharedHits},
+    {"numberOfTRTHits",                       7, &TrackPart::numberOfTRTHits},
+    {"numberOfTRTOutliers",                   5, &TrackPart::numberOfTRTOutliers},
+  };
+}
+
 TrackContainer::TrackContainer(const std::string& name, const std::string& detailStr, float units) : ParticleContainer(name,detailStr,units,true)
 
 {
@@ -17,7 +47,7 @@ TrackContainer::TrackContainer(const std::string& name, const std::string& detai
     m_numberDoF = new std::vector<float >;
   }
 
-  if(m_infoSwitch.m_numbers){
+  if(m_infoSwitch.m_numbers && !m_infoSwitch.m_packedHits){
     m_numberOfInnermostPixelLayerHits = new std::vector<unsigned char >;
     m_numberOfNextToInnermostPixelLayerHits = new std::vector<unsigned char >;
     m_numberOfPhiHoleLayers = new std::vector<unsigned char >;
@@ -36,6 +66,10 @@ TrackContainer::TrackContainer(const std::string& name, const std::string& detai
     m_numberOfTRTOutliers = new std::vector<unsigned char >;
   }
 
+  if(m_infoSwitch.m_numbers && m_infoSwitch.m_packedHits){
+    m_hitsPacked = new std::vector<ULong64_t >;
+  }
+
   m_phi = new std::vector<float >;
   m_qOverP = new std::vector<float >;
   m_theta = new std::vector<float >;
@@ -64,7 +98,7 @@ TrackContainer::~TrackContainer()
     delete m_numberDoF;
   }
 
-  if(m_infoSwitch.m_numbers){
+  if(m_infoSwitch.m_numbers && !m_infoSwitch.m_packedHits){
     delete m_numberOfInnermostPixelLayerHits;
     delete m_numberOfNextToInnermostPixelLayerHits;
     delete m_numberOfPhiHoleLayers;
@@ -83,6 +117,10 @@ TrackContainer::~TrackContainer()
     delete m_numberOfTRTOutliers;
   }
 
+  if(m_infoSwitch.m_numbers && m_infoSwitch.m_packedHits){
+    delete m_hitsPacked;
+  }
+
   delete m_phi;
   delete m_qOverP;
   delete m_theta;
@@ -111,7 +149,7 @@ void TrackContainer::setTree(TTree *tree)
     connectBranch<float>(tree, "numberDoF", &m_numberDoF);
   }
 
-  if(m_infoSwitch.m_numbers){
+  if(m_infoSwitch.m_numbers && !m_infoSwitch.m_packedHits){
     connectBranch<unsigned char>(tree, "numberOfInnermostPixelLayerHits", &m_numberOfInnermostPixelLayerHits);
     connectBranch<unsigned char>(tree, "numberOfNextToInnermostPixelLayerHits", &m_numberOfNextToInnermostPixelLayerHits);
     connectBranch<unsigned char>(tree, "numberOfPhiHoleLayers", &m_numberOfPhiHoleLayers);
@@ -130,6 +168,10 @@ void TrackContainer::setTree(TTree *tree)
     connectBranch<unsigned char>(tree, "numberOfTRTOutliers", &m_numberOfTRTOutliers);
   }
 
+  if(m_infoSwitch.m_numbers && m_infoSwitch.m_packedHits){
+    connectBranch<ULong64_t>(tree, "hitsPacked", &m_hitsPacked);
+  }
+
   connectBranch<float>(tree, "phi", &m_phi);
   connectBranch<float>(tree, "qOverP", &m_qOverP);
   connectBranch<float>(tree, "theta", &m_theta);
@@ -156,10 +198,10 @@ void TrackContainer::updateParticle(uint idx, TrackPart& track)
     track.definingParametersCovMatrix = m_definingParametersCovMatrix->at(idx);
     track.expectInnermostPixelLayerHit = m_expectInnermostPixelLayerHit->at(idx);
     track.expectNextToInnermostPixelLayerHit = m_expectNextToInnermostPixelLayerHit->at(idx);
+    track.numberDoF = m_numberDoF->at(idx);
   }
 
-  if(m_infoSwitch.m_numbers){
-    track.numberDoF = m_numberDoF->at(idx);
+  if(m_infoSwitch.m_numbers && !m_infoSwitch.m_packedHits){
     track.numberOfInnermostPixelLayerHits = m_numberOfInnermostPixelLayerHits->at(idx);
     track.numberOfNextToInnermostPixelLayerHits = m_numberOfNextToInnermostPixelLayerHits->at(idx);
     track.numberOfPhiHoleLayers = m_numberOfPhiHoleLayers->at(idx);
@@ -178,6 +220,14 @@ void TrackContainer::updateParticle(uint idx, TrackPart& track)
     track.numberOfTRTOutliers = m_numberOfTRTOutliers->at(idx);
   }
 
+  if(m_infoSwitch.m_numbers && m_infoSwitch.m_packedHits){
+    ULong64_t packed = m_hitsPacked->at(idx);
+    for(const auto& hitCount : hitCounts){
+      track.*(hitCount.field) = packed & ((1ULL << hitCount.bits) - 1);
+      packed >>= hitCount.bits;
+    }
+  }
+
   track.phi = m_phi->at(idx);
   track.qOverP = m_qOverP->at(idx);
   track.theta = m_theta->at(idx);
@@ -209,7 +259,7 @@ void TrackContainer::setBranches(TTree *tree)
   setBranch<float>(tree, "numberDoF", m_numberDoF);
   }
 
-  if(m_infoSwitch.m_numbers){
+  if(m_infoSwitch.m_numbers && !m_infoSwitch.m_packedHits){
     setBranch<unsigned char>(tree, "numberOfInnermostPixelLayerHits", m_numberOfInnermostPixelLayerHits);
     setBranch<unsigned char>(tree, "numberOfNextToInnermostPixelLayerHits", m_numberOfNextToInnermostPixelLayerHits);
     setBranch<unsigned char>(tree, "numberOfPhiHoleLayers", m_numberOfPhiHoleLayers);
@@ -228,6 +278,10 @@ void TrackContainer::setBranches(TTree *tree)
     setBranch<unsigned char>(tree, "numberOfTRTOutliers", m_numberOfTRTOutliers);
   }
 
+  if(m_infoSwitch.m_numbers && m_infoSwitch.m_packedHits){
+    setBranch<ULong64_t>(tree, "hitsPacked", m_hitsPacked);
+  }
+
   setBranch<float>(tree, "phi", m_phi);
   setBranch<float>(tree, "qOverP", m_qOverP);
   setBranch<float>(tree, "theta", m_theta);
@@ -256,7 +310,7 @@ void TrackContainer::clear()
     m_numberDoF->clear();
   }
 
-  if(m_infoSwitch.m_numbers){
+  if(m_infoSwitch.m_numbers && !m_infoSwitch.m_packedHits){
     m_numberOfInnermostPixelLayerHits->clear();
     m_numberOfNextToInnermostPixelLayerHits->clear();
     m_numberOfPhiHoleLayers->clear();
@@ -275,6 +329,10 @@ void TrackContainer::clear()
     m_numberOfTRTOutliers->clear();
   }
 
+  if(m_infoSwitch.m_numbers && m_infoSwitch.m_packedHits){
+    m_hitsPacked->clear();
+  }
+
   m_phi->clear();
   m_qOverP->clear();
   m_theta->clear();
@@ -307,7 +365,7 @@ void TrackContainer::FillTrack( const xAOD::IParticle* particle ){
     m_chiSquared->push_back( track->chiSquared() );
     m_d0->push_back( track->d0() );
     m_numberDoF->push_back( track->numberDoF() );
-    //m_definingParametersCovMatrix ->push_back(track->definingParametersCovMatrix() ); // fix this too
+    m_definingParametersCovMatrix->push_back( track->definingParametersCovMatrixVec() );
 
     static SG::AuxElement::ConstAccessor<unsigned char> expectInnermostPixelLayerHit("expectInnermostPixelLayerHit");
     //safeFill<char, int, xAOD::TrackParticle>(track, expectInnermostPixelLayerHit, m_expectInnermostPixelLayerHit, -999);
@@ -318,7 +376,7 @@ void TrackContainer::FillTrack( const xAOD::IParticle* particle ){
     m_expectNextToInnermostPixelLayerHit->push_back(expectNextToInnermostPixelLayerHit(*track));
   }
 
-  if(m_infoSwitch.m_numbers){
+  if(m_infoSwitch.m_numbers && !m_infoSwitch.m_packedHits){
     if(m_debug) std::cout << "Filling numbers" << std::endl;
 
     static SG::AuxElement::ConstAccessor<unsigned char> numberOfInnermostPixelLayerHits("numberOfInnermostPixelLayerHits");
@@ -370,6 +428,26 @@ void TrackContainer::FillTrack( const xAOD::IParticle* particle ){
     m_numberOfTRTOutliers->push_back(numberOfTRTOutliers(*track) );
   }
 
+  if(m_infoSwitch.m_numbers && m_infoSwitch.m_packedHits){
+    if(m_debug) std::cout << "Filling packed numbers" << std::endl;
+
+    static const std::vector<SG::AuxElement::ConstAccessor<unsigned char> > hitCountAccessors = [](){
+      std::vector<SG::AuxElement::ConstAccessor<unsigned char> > accessors;
+      for(const auto& hitCount : hitCounts) accessors.emplace_back(hitCount.name);
+      return accessors;
+    }();
+
+    // each count saturates at the largest value its bits can hold
+    ULong64_t packed(0);
+    unsigned int shift(0);
+    for(std::size_t i = 0; i < hitCountAccessors.size(); ++i){
+      const ULong64_t maxCount = (1ULL << hitCounts[i].bits) - 1;
+      packed |= std::min<ULong64_t>(hitCountAccessors[i](*track), maxCount) << shift;
+      shift += hitCounts[i].bits;
+    }
+    m_hitsPacked->push_back(packed);
+  }
+
   m_phi->push_back(track->phi() );
   m_qOverP->push_back(track->qOverP() );
   m_theta->push_back(track->theta() );
@@ -196,20 +196,27 @@ StatusCode TrackHists::initialize() {
 }
 
 StatusCode TrackHists::execute( const xAOD::TrackParticleContainer* trks, const xAOD::Vertex *pvx, float eventWeight,  const xAOD::EventInfo* eventInfo ) {
+  m_summary.fill(trks, pvx);
+  return this->execute( m_summary, pvx, eventWeight, eventInfo );
+}
+
+StatusCode TrackHists::execute( const xAH::TrackSummary& summary, const xAOD::Vertex *pvx, float eventWeight,  const xAOD::EventInfo* eventInfo ) {
   using namespace msgTrackHists;
-  xAOD::TrackParticleContainer::const_iterator trk_itr = trks->begin();
-  xAOD::TrackParticleContainer::const_iterator trk_end = trks->end();
-  for( ; trk_itr != trk_end; ++trk_itr ) {
-    ANA_CHECK( this->execute( (*trk_itr), pvx, eventWeight, eventInfo ));
+  for( unsigned int iTrk = 0; iTrk < summary.nContainer(); ++iTrk ) {
+    ANA_CHECK( this->execute( summary.tracks[iTrk], pvx, summary.params[iTrk], eventWeight, eventInfo ));
   }
 
-  m_trk_n -> Fill( trks->size(), eventWeight );
-  m_trk_n_l -> Fill( trks->size(), eventWeight );
+  m_trk_n -> Fill( summary.nContainer(), eventWeight );
+  m_trk_n_l -> Fill( summary.nContainer(), eventWeight );
 
   return StatusCode::SUCCESS;
 }
 
 StatusCode TrackHists::execute( const xAOD::TrackParticle* trk, const xAOD::Vertex *pvx, float eventWeight,  const xAOD::EventInfo* eventInfo ) {
+  return this->execute( trk, pvx, xAH::TrackParameters(trk, pvx), eventWeight, eventInfo );
+}
+
+StatusCode TrackHists::execute( const xAOD::TrackParticle* trk, const xAOD::Vertex *pvx, const xAH::TrackParameters& params, float eventWeight,  const xAOD::EventInfo* eventInfo ) {
 
   //basic
   float        trkPt       = trk->pt()/1e3;
@@ -217,14 +224,14 @@ StatusCode TrackHists::execute( const xAOD::TrackParticle* trk, const xAOD::Vert
   if (fabs(trk->qOverP())>0.) trkP = (1./fabs(trk->qOverP()))/1e3;
   float        trkEta      = trk->eta();
   float        trkPhi      = trk->phi();
-  float        chi2        = trk->chiSquared();
-  float        ndof        = trk->numberDoF();
-  float        chi2Prob    = TMath::Prob(chi2,ndof);
-  float        d0          = trk->d0();
+  float        chi2        = params.chi2;
+  float        ndof        = params.ndof;
+  float        chi2Prob    = params.chi2Prob;
+  float        d0          = params.d0;
   float        pvz         = HelperFunctions::getPrimaryVertexZ(pvx);
-  float        z0          = trk->z0() + trk->vz() - pvz;
+  float        z0          = params.z0;
 
-  float        sinT        = sin(trk->theta());
+  float        sinT        = params.sinT;
 
   m_trk_Pt       -> Fill( trkPt,            eventWeight );
   m_trk_Pt_l     -> Fill( trkPt,            eventWeight );
@@ -258,14 +265,14 @@ StatusCode TrackHists::execute( const xAOD::TrackParticle* trk, const xAOD::Vert
   }
 
   if(m_fillIPDetails){
-    float d0Err = sqrt((trk->definingParametersCovMatrixVec().at(0)));
+    float d0Err = params.d0Err;
     float d0Sig = (d0Err > 0) ? d0/d0Err : -1 ;
     m_trk_d0_l         -> Fill(d0    , eventWeight );
     m_trk_d0_ss        -> Fill(d0    , eventWeight );
     m_trk_d0Err        -> Fill(d0Err , eventWeight );
     m_trk_d0Sig        -> Fill(d0Sig , eventWeight );
 
-    float z0Err = sqrt((trk->definingParametersCovMatrixVec().at(2)));
+    float z0Err = params.z0Err;
     float z0Sig = (z0Err > 0) ? z0/z0Err : -1 ;
 
     m_trk_z0_l         -> Fill(z0         , eventWeight );
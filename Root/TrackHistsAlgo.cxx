@@ -42,6 +42,9 @@ EL::StatusCode TrackHistsAlgo :: histInitialize ()
   m_plots = new TrackHists(m_name, m_detailStr);
   ANA_CHECK( m_plots -> initialize());
   m_plots -> record( wk() );
+  ANA_CHECK( addHistMemory( *m_plots ));
+  addCheckpoint( m_plots );
+  reportHistMemory( "initialize", m_histBytes );
 
   return EL::StatusCode::SUCCESS;
 }
@@ -59,6 +62,9 @@ EL::StatusCode TrackHistsAlgo :: initialize ()
 
 EL::StatusCode TrackHistsAlgo :: execute ()
 {
+  auto event = beginEvent();
+  auto timer = timeExecute();
+  if ( eventRejected() ) return EL::StatusCode::SUCCESS;
   const xAOD::EventInfo* eventInfo(nullptr);
   ANA_CHECK( HelperFunctions::retrieve(eventInfo, m_eventInfoContainerName, m_event, m_store, msg()) );
 
@@ -76,7 +82,8 @@ EL::StatusCode TrackHistsAlgo :: execute ()
   ANA_CHECK( HelperFunctions::retrieve(vertices, m_vertexContainerName, m_event, m_store, msg()) );
   const xAOD::Vertex *pvx = HelperFunctions::getPrimaryVertex(vertices, msg());
 
-  ANA_CHECK( m_plots->execute( tracks, pvx, eventWeight, eventInfo ));
+  m_trackSummary.fill( tracks, pvx );
+  ANA_CHECK( m_plots->execute( m_trackSummary, pvx, eventWeight, eventInfo ));
 
   return EL::StatusCode::SUCCESS;
 }
@@ -86,7 +93,10 @@ EL::StatusCode TrackHistsAlgo :: finalize () { return EL::StatusCode::SUCCESS; }
 EL::StatusCode TrackHistsAlgo :: histFinalize ()
 {
   // clean up memory
-  if(m_plots) delete m_plots;
+  if(m_plots){
+    reportHistMemory( "finalize", m_plots->memoryBytes() );
+    delete m_plots;
+  }
   ANA_CHECK( xAH::Algorithm::algFinalize());
   return EL::StatusCode::SUCCESS;
 }
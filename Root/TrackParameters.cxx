@@ -0,0 +1,28 @@
+#include <xAODAnaHelpers/TrackParameters.h>
+#include <xAODAnaHelpers/HelperFunctions.h>
+
+#include <TMath.h>
+
+#include <cmath>
+
+xAH::TrackParameters::TrackParameters(const xAOD::TrackParticle* trk, const xAOD::Vertex* pvx) :
+  TrackParameters(trk, HelperFunctions::getPrimaryVertexZ(pvx))
+{
+}
+
+xAH::TrackParameters::TrackParameters(const xAOD::TrackParticle* trk, float pvZ) :
+  d0(trk->d0()),
+  d0Err(0),
+  z0(trk->z0() + trk->vz() - pvZ),
+  z0Err(0),
+  sinT(std::sin(trk->theta())),
+  chi2(trk->chiSquared()),
+  ndof(trk->numberDoF()),
+  chi2Prob(TMath::Prob(chi2, ndof))
+{
+  const std::vector<float>& cov = trk->definingParametersCovMatrixVec();
+  if(cov.size() > 2){
+    d0Err = std::sqrt(cov[0]);
+    z0Err = std::sqrt(cov[2]);
+  }
+}
@@ -15,6 +15,7 @@
 #include <iostream>
 #include <typeinfo>
 #include <sstream>
+#include <algorithm>
 
 using std::vector;
 
@@ -170,6 +171,30 @@ EL::StatusCode TrackSelector :: initialize ()
 
   ANA_MSG_DEBUG( "TrackSelector Interface succesfully initialized!" );
 
+  // InDetTrackSelectionTool
+  m_cutTable.add("InDetTrackSelectionTool", [this](const xAOD::TrackParticle& trk){ return static_cast<bool>(m_trkSelTool_handle->accept(trk, m_cutVertex)); }, 10.);
+
+  // Cuts not available with the InDetTrackSelectionTool
+  if( m_pT_max        != 1e8 ) m_cutTable.addMax("ptmax",        [](const xAOD::TrackParticle& trk){ return trk.pt(); },        m_pT_max);
+  if( m_eta_min       != 1e8 ) m_cutTable.addMin("etamin",       [](const xAOD::TrackParticle& trk){ return fabs(trk.eta()); }, m_eta_min);
+  if( m_etaSigned_max != 1e8 ) m_cutTable.addMax("etaSignedmax", [](const xAOD::TrackParticle& trk){ return trk.eta(); },       m_etaSigned_max);
+  if( m_etaSigned_min != 1e8 ) m_cutTable.addMin("etaSignedmin", [](const xAOD::TrackParticle& trk){ return trk.eta(); },       m_etaSigned_min);
+
+  //  xAOD::numberOfBLayerHits is deprecated, keeping it for compatibility
+  if( m_nBL_min != 1e8 ) m_cutTable.add("nBLmin", [this](const xAOD::TrackParticle& trk){
+      uint8_t nBL = -1;
+      if(!trk.summaryValue(nBL, xAOD::numberOfBLayerHits)) ANA_MSG_ERROR( "BLayer hits not filled");
+      return nBL >= m_nBL_min;
+    });
+
+  if( m_chi2Prob_max != 1e8 ) m_cutTable.addMax("chi2Probmax", [](const xAOD::TrackParticle& trk){ return TMath::Prob(trk.chiSquared(), trk.numberDoF()); }, m_chi2Prob_max, 2.);
+
+  for(auto& passKey : m_passKeys) m_cutTable.addFlag(passKey, passKey, '1');
+  for(auto& failKey : m_failKeys) m_cutTable.addFlag(failKey, failKey, '0');
+
+  m_cutTable.setAdaptive(m_adaptiveCutOrder);
+  m_cutTable.setCache(m_cacheCutResults);
+
   return EL::StatusCode::SUCCESS;
 }
 
@@ -177,6 +202,9 @@ EL::StatusCode TrackSelector :: initialize ()
 
 EL::StatusCode TrackSelector :: execute ()
 {
+  auto event = beginEvent();
+  auto timer = timeExecute();
+  if ( eventRejected() ) return EL::StatusCode::SUCCESS;
 
   ANA_MSG_DEBUG("Applying Track Selection... " << m_name);
 
@@ -219,31 +247,65 @@ EL::StatusCode TrackSelector :: executeTrackCollection (float mcEvtWeight)
     selectedTracks = new ConstDataVector<xAOD::TrackParticleContainer>(SG::VIEW_ELEMENTS);
   }
 
-  xAOD::TrackParticleContainer::const_iterator trk_itr = inTracks->begin();
-  xAOD::TrackParticleContainer::const_iterator trk_end = inTracks->end();
-  int nPass(0); int nObj(0);
-  for( ; trk_itr != trk_end; ++trk_itr ){
+  static SG::AuxElement::Decorator< char > passSelDecor( "passSel" );
+
+  // in a pt-ordered input, the tracks from the first one below m_pT_min on fail it, whatever the other cuts
+  std::size_t ptOrderedEnd = inTracks->size();
+  if( m_ptOrderedInput && m_pT_min != 1e8 ) {
+    ptOrderedEnd = HelperFunctions::sortedPtEnd( *inTracks, m_pT_min );
+  }
 
-    // if only looking at a subset of tracks make sure all are decorrated
-    if( m_nToProcess > 0 && nObj >= m_nToProcess ) {
+  int nPass(0); int nObj(0);
+  if( m_nToProcess <= 0 && !m_stopWhenRejected ) {
+    // evaluate each cut on the whole container at once, then write the decisions
+    m_cutVertex = pvx;
+    nPass = m_cutTable.passAll( inTracks->begin(), inTracks->begin() + ptOrderedEnd, m_decisions );
+    m_decisions.resize( inTracks->size(), 0 );
+    nObj  = inTracks->size();
+
+    for( unsigned int i = 0; i < inTracks->size(); ++i ){
+      const xAOD::TrackParticle* trk = inTracks->at(i);
       if(m_decorateSelectedObjects) {
-        (*trk_itr)->auxdecor< char >( "passSel" ) = -1;
-      } else {
-        break;
+        passSelDecor( *trk ) = m_decisions[i];
+      }
+      if(m_decisions[i] && m_createSelectedContainer) {
+        selectedTracks->push_back( trk );
       }
-      continue;
     }
+  } else {
+    const int nToEvaluate = m_nToProcess > 0 ? std::min( m_nToProcess, static_cast<int>(inTracks->size()) ) : static_cast<int>(inTracks->size());
+    bool countRejected(false);
+
+    xAOD::TrackParticleContainer::const_iterator trk_itr = inTracks->begin();
+    xAOD::TrackParticleContainer::const_iterator trk_end = inTracks->end();
+    for( ; trk_itr != trk_end; ++trk_itr ){
+
+      // if only looking at a subset of tracks make sure all are decorrated
+      if( (m_nToProcess > 0 && nObj >= m_nToProcess) || countRejected ) {
+        if(m_decorateSelectedObjects) {
+          passSelDecor( **trk_itr ) = -1;
+        } else {
+          break;
+        }
+        continue;
+      }
 
-    nObj++;
-    int passSel = this->PassCuts( (*trk_itr), pvx );
-    if(m_decorateSelectedObjects) {
-      (*trk_itr)->auxdecor< char >( "passSel" ) = passSel;
-    }
+      int passSel = static_cast<std::size_t>(nObj) < ptOrderedEnd ? this->PassCuts( (*trk_itr), pvx ) : 0;
+      nObj++;
+      if(m_decorateSelectedObjects) {
+        passSelDecor( **trk_itr ) = passSel;
+      }
+
+      if(passSel) {
+        nPass++;
+        if(m_createSelectedContainer) {
+          selectedTracks->push_back( *trk_itr );
+        }
+      }
 
-    if(passSel) {
-      nPass++;
-      if(m_createSelectedContainer) {
-        selectedTracks->push_back( *trk_itr );
+      // once the number of selected tracks rejects the event there is no need to look further
+      if( m_stopWhenRejected && HelperFunctions::countRejects( nPass, nToEvaluate - nObj, m_pass_min, m_pass_max ) ) {
+        countRejected = true;
       }
     }
   }
@@ -253,11 +315,11 @@ EL::StatusCode TrackSelector :: executeTrackCollection (float mcEvtWeight)
 
   // apply event selection based on minimal/maximal requirements on the number of objects per event passing cuts
   if( m_pass_min > 0 && nPass < m_pass_min ) {
-    wk()->skipEvent();
+    rejectEvent();
     return EL::StatusCode::SUCCESS;
   }
   if( m_pass_max >= 0 && nPass > m_pass_max ) {
-    wk()->skipEvent();
+    rejectEvent();
     return EL::StatusCode::SUCCESS;
   }
 
@@ -347,6 +409,8 @@ EL::StatusCode TrackSelector :: executeTracksInJets ()
 
 EL::StatusCode TrackSelector :: postExecute ()
 {
+  auto timer = timePostExecute();
+  if ( eventRejected() ) return EL::StatusCode::SUCCESS;
   // Here you do everything that needs to be done after the main event
   // processing.  This is typically very rare, particularly in user
   // code.  It is mainly used in implementing the NTupleSvc.
@@ -395,68 +459,6 @@ EL::StatusCode TrackSelector :: histFinalize ()
 
 int TrackSelector :: PassCuts( const xAOD::TrackParticle* trk, const xAOD::Vertex *pvx ) {
 
-  // InDetTrackSelectionTool
-  if ( !m_trkSelTool_handle->accept(*trk, pvx) ) { return 0; }
-
-  // Cuts not available with the InDetTrackSelectionTool
-  //
-  // pT_max
-  //
-  if( m_pT_max != 1e8 ) {
-    if ( trk->pt() > m_pT_max ) { return 0; }
-  }
-
-  //
-  // eta 
-  //
-  if( m_eta_min != 1e8 ) {
-    if( fabs(trk->eta()) < m_eta_min ) { return 0; }
-  }
-  if( m_etaSigned_max != 1e8 ) {
-    if( trk->eta() > m_etaSigned_max ) { return 0; }
-  }
-  if( m_etaSigned_min != 1e8 ) {
-    if( trk->eta() < m_etaSigned_min ) { return 0; }
-  }
-
-
- 
-  //  
-  //  nBLayer
-  //
-  uint8_t nBL       = -1;
-  if( m_nBL_min != 1e8 ){
-    //  xAOD::numberOfBLayerHits is deprecated, keeping it for compatibility 
-    if(!trk->summaryValue(nBL, xAOD::numberOfBLayerHits)) ANA_MSG_ERROR( "BLayer hits not filled");
-    if( nBL < m_nBL_min ) {return 0; }
-  }
-
-  //
-  //  chi2Prob_max
-  //
-  float        chi2        = trk->chiSquared();
-  float        ndof        = trk->numberDoF();
-  if( m_chi2Prob_max != 1e8 ){
-    float        chi2Prob    = TMath::Prob(chi2,ndof);
-    if( chi2Prob > m_chi2Prob_max) { return 0; }
-  }
-
-  //
-  //  Pass Keys
-  //
-  for(auto& passKey : m_passKeys){
-    if(!(trk->auxdata< char >(passKey) == '1')) { return 0; }
-  }
-
-  //
-  //  Fail Keys
-  //
-  for(auto& failKey : m_failKeys){
-    if(!(trk->auxdata< char >(failKey) == '0')) { return 0; }
-  }
-
-
-  return 1;
+  m_cutVertex = pvx;
+  return m_cutTable.pass(*trk);
 }
-
-
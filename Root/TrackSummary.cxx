@@ -0,0 +1,111 @@
+#include <xAODAnaHelpers/TrackSummary.h>
+#include <xAODAnaHelpers/HelperFunctions.h>
+
+#include <algorithm>
+#include <cmath>
+
+void xAH::TrackSummary::fill(const xAOD::TrackParticleContainer* trks, const xAOD::Vertex* pvx, const xAOD::VertexContainer* vtxs)
+{
+  tracks.clear();
+  kinematics.clear();
+  params.clear();
+  m_index.clear();
+  m_nVertices = 0;
+  m_sorted = false;
+  m_iso.clear();
+
+  m_pvZ = HelperFunctions::getPrimaryVertexZ(pvx);
+  if(trks){
+    tracks.reserve(trks->size());
+    params.reserve(trks->size());
+    for(const xAOD::TrackParticle* trk : *trks) push_back(trk);
+  }
+  m_nContainer = tracks.size();
+
+  if(vtxs){
+    for(const xAOD::Vertex* vtx : *vtxs) addVertex(vtx);
+  }
+}
+
+unsigned int xAH::TrackSummary::addVertex(const xAOD::Vertex* vtx)
+{
+  // the index lists keep their capacity between events
+  if(m_vertexTracks.size() <= m_nVertices) m_vertexTracks.resize(m_nVertices + 1);
+  std::vector<unsigned int>& indices = m_vertexTracks[m_nVertices];
+  indices.clear();
+
+  const std::size_t nTrks = vtx->nTrackParticles();
+  for(std::size_t iTrk = 0; iTrk < nTrks; ++iTrk){
+    const xAOD::TrackParticle* trk = vtx->trackParticle(iTrk);
+    if(!trk) continue;
+    auto it = m_index.find(trk);
+    if(it != m_index.end()){
+      indices.push_back(it->second);
+    } else {
+      indices.push_back(tracks.size());
+      push_back(trk);
+    }
+  }
+
+  return m_nVertices++;
+}
+
+void xAH::TrackSummary::push_back(const xAOD::TrackParticle* trk)
+{
+  m_index.emplace(trk, tracks.size());
+  tracks.push_back(trk);
+  kinematics.push_back(trk);
+  params.emplace_back(trk, m_pvZ);
+}
+
+void xAH::TrackSummary::sortZ0() const
+{
+  m_z0Order.clear();
+  for(unsigned int iTrk = 0; iTrk < m_nContainer; ++iTrk) m_z0Order.push_back( std::make_pair(tracks[iTrk]->z0(), iTrk) );
+  std::sort(m_z0Order.begin(), m_z0Order.end());
+
+  m_sortedZ0.clear(); m_sortedEta.clear(); m_sortedPhi.clear(); m_sortedPt.clear();
+  for(const auto& trk : m_z0Order){
+    m_sortedZ0.push_back(trk.first);
+    m_sortedEta.push_back(kinematics.eta[trk.second]);
+    m_sortedPhi.push_back(kinematics.phi[trk.second]);
+    m_sortedPt.push_back(kinematics.pt[trk.second]);
+  }
+  m_sorted = true;
+}
+
+float xAH::TrackSummary::isolation(unsigned int iTrk, float z0Cut, float coneSize) const
+{
+  if(z0Cut != m_isoZ0Cut || coneSize != m_isoConeSize){
+    m_iso.clear();
+    m_isoZ0Cut = z0Cut;
+    m_isoConeSize = coneSize;
+  }
+  if(m_iso.size() < tracks.size()) m_iso.resize(tracks.size(), -1);
+  if(m_iso[iTrk] >= 0) return m_iso[iTrk];
+
+  if(!m_sorted) sortZ0();
+
+  float iso = 0;
+  const float inZ0  = tracks[iTrk]->z0();
+  const float coneSize2 = coneSize*coneSize;
+
+  // the tracks are sorted in z0, only the ones within z0Cut can be in the cone
+  const std::size_t begin = std::lower_bound(m_sortedZ0.begin(), m_sortedZ0.end(), inZ0 - z0Cut) - m_sortedZ0.begin();
+  const std::size_t end   = std::upper_bound(m_sortedZ0.begin() + begin, m_sortedZ0.end(), inZ0 + z0Cut) - m_sortedZ0.begin();
+  if(begin < end){
+    m_dR2.resize(end - begin);
+    HelperFunctions::deltaR2(kinematics.eta[iTrk], kinematics.phi[iTrk], m_sortedEta.data() + begin, m_sortedPhi.data() + begin, end - begin, m_dR2.data());
+
+    for(std::size_t jTrk = begin; jTrk < end; ++jTrk){
+      if(std::fabs(m_sortedZ0[jTrk] - inZ0) > z0Cut) continue;
+      const float dR2 = m_dR2[jTrk - begin];
+      if(dR2 > coneSize2) continue;
+      if(dR2 == 0) continue;
+      iso += m_sortedPt[jTrk]/1e3;
+    }
+  }
+
+  m_iso[iTrk] = iso;
+  return iso;
+}
@@ -58,20 +58,52 @@ void TracksInJetHists::record(EL::IWorker* wk) {
   m_trkPlots -> record( wk );
 }
 
+void TracksInJetHists::snapshot(std::vector<TObject*>& objects) {
+  HistogramManager::snapshot(objects);
+  m_trkPlots -> snapshot( objects );
+}
+
+bool TracksInJetHists::merge(const TObject* obj) {
+  return HistogramManager::merge(obj) || m_trkPlots -> merge( obj );
+}
+
+void TracksInJetHists::reset() {
+  HistogramManager::reset();
+  m_trkPlots -> reset();
+}
+
 
 
 StatusCode TracksInJetHists::execute( const xAOD::TrackParticle* trk, const xAOD::Jet* jet,  const xAOD::Vertex *pvx, float eventWeight,  const xAOD::EventInfo* eventInfo ) {
+  const JetAxis axis = { static_cast<float>(jet->eta()), static_cast<float>(jet->phi()), HelperFunctions::getPrimaryVertexZ(pvx) };
+  return fillTrack(trk, axis, pvx, eventWeight, eventInfo);
+}
+
+StatusCode TracksInJetHists::execute( const std::vector<const xAOD::TrackParticle*>& trks, const xAOD::Jet* jet,  const xAOD::Vertex *pvx, float eventWeight,  const xAOD::EventInfo* eventInfo ) {
+  using namespace msgTracksInJetHists;
+  const JetAxis axis = { static_cast<float>(jet->eta()), static_cast<float>(jet->phi()), HelperFunctions::getPrimaryVertexZ(pvx) };
+  for(const xAOD::TrackParticle* trk : trks){
+    ANA_CHECK( fillTrack(trk, axis, pvx, eventWeight, eventInfo));
+  }
+  return StatusCode::SUCCESS;
+}
+
+StatusCode TracksInJetHists::fillTrack( const xAOD::TrackParticle* trk, const JetAxis& axis, const xAOD::Vertex *pvx, float eventWeight,  const xAOD::EventInfo* eventInfo ) {
   using namespace msgTracksInJetHists;
   //
   //  Fill track hists
   //
-  ANA_CHECK( m_trkPlots   ->execute(trk, pvx, eventWeight, eventInfo));
+  const xAH::TrackParameters params(trk, axis.pvZ);
+  ANA_CHECK( m_trkPlots   ->execute(trk, pvx, params, eventWeight, eventInfo));
+
+  const float dEta   = trk->eta() - axis.eta;
+  const float dPhi   = HelperFunctions::dPhi(trk->phi(), axis.phi);
 
-  // d0
-  float sign         = getD0Sign(trk, jet);
-  float d0_wrtPV     = trk->d0();
+  // d0, signed as getD0Sign(): cos(trkPhi)*sin(jetPhi) - sin(trkPhi)*cos(jetPhi) = -sin(dPhi)
+  float d0_wrtPV     = params.d0;
+  float sign         = (d0_wrtPV > 0 ? 1 : -1) * (sin(dPhi) < 0 ? 1 : -1);
   float signedD0     = fabs(d0_wrtPV)*sign;
-  float d0Err_wrtPV  = sqrt((trk->definingParametersCovMatrixVec().at(0)));
+  float d0Err_wrtPV  = params.d0Err;
   float d0Sig_wrtPV  = d0Err_wrtPV ? d0_wrtPV/d0Err_wrtPV : -1;
   float d0SigSigned  = sign*fabs(d0Sig_wrtPV);
   m_trk_d0       ->Fill(signedD0,    eventWeight);
@@ -81,13 +113,12 @@ StatusCode TracksInJetHists::execute( const xAOD::TrackParticle* trk, const xAOD
   //
   // Signed Z0
   //
-  float signZ0           = getZ0Sign(trk, jet, pvx);
-
-  float z0               = trk->z0() + trk->vz() - HelperFunctions::getPrimaryVertexZ(pvx);
+  float z0               = params.z0;
+  float signZ0           = (z0*dEta) < 0 ? 1.0 : -1.0; // as getZ0Sign(), with its dEta = jet - track
 
   float z0_wrtPV_signed  = fabs(z0)*signZ0;
-  float z0Err            = sqrt((trk->definingParametersCovMatrixVec().at(2)));
-  float sinT             = sin(trk->theta());
+  float z0Err            = params.z0Err;
+  float sinT             = params.sinT;
 
   m_trk_z0_signed     ->Fill(z0_wrtPV_signed,         eventWeight);
   m_trk_z0sinT_signed ->Fill(z0_wrtPV_signed*sinT,    eventWeight);
@@ -99,13 +130,11 @@ StatusCode TracksInJetHists::execute( const xAOD::TrackParticle* trk, const xAOD
 
   m_trk_z0sinTd0->Fill(z0_wrtPV_signed*sinT, signedD0, eventWeight);
 
-  float dEta = trk->eta() - jet->p4().Eta();
-  float dPhi = HelperFunctions::dPhi(trk->phi(), jet->p4().Phi());
   float dR   = sqrt(dPhi*dPhi + dEta*dEta);
   //float dR = trk->p4().DeltaR(jet->p4());
 
-  m_trk_jetdPhi ->Fill(HelperFunctions::dPhi(trk->phi(),jet->p4().Phi()), eventWeight);
-  m_trk_jetdEta ->Fill(trk->eta() - jet->eta(),       eventWeight);
+  m_trk_jetdPhi ->Fill(dPhi, eventWeight);
+  m_trk_jetdEta ->Fill(dEta, eventWeight);
   m_trk_jetdR   ->Fill(dR,   eventWeight);
   m_trk_jetdR_l ->Fill(dR,   eventWeight);
 
@@ -11,10 +11,22 @@
 #include <xAODCaloEvent/CaloClusterContainer.h>
 
 #include <xAODAnaHelpers/TreeAlgo.h>
+#include <xAODAnaHelpers/SystematicNames.h>
+#include <xAODAnaHelpers/SelectionFlags.h>
+#include <xAODAnaHelpers/TrigMatchBits.h>
 
 #include <xAODAnaHelpers/HelperFunctions.h>
 #include <xAODAnaHelpers/HelperClasses.h>
 
+#include <TBranch.h>
+#include <TRegexp.h>
+#include <TROOT.h>
+#include <RConfigure.h>
+
+#include <algorithm>
+#include <stdexcept>
+#include <typeinfo>
+
 // this is needed to distribute the algorithm to the workers
 ClassImp(TreeAlgo)
 
@@ -200,6 +212,54 @@ EL::StatusCode TreeAlgo :: initialize ()
     return EL::StatusCode::FAILURE;
   }
 
+  if ( m_writerThreads > 0 ) {
+#ifdef R__USE_IMT
+    // implicit MT is job-wide, several TreeAlgo instances share the first setting
+    if ( !ROOT::IsImplicitMTEnabled() ) ROOT::EnableImplicitMT(m_writerThreads);
+    ANA_MSG_INFO( "Compressing the output trees with " << ROOT::GetImplicitMTPoolSize() << " threads");
+#else
+    ANA_MSG_WARNING( "m_writerThreads is set, but ROOT was built without implicit multi-threading support. The output trees are written by the event loop.");
+#endif
+  }
+
+  std::string filterError;
+  if ( !m_eventFilterExpr.initialize(m_eventFilter, m_units, filterError) ) {
+    ANA_MSG_ERROR( "Could not parse m_eventFilter \"" << m_eventFilter << "\": " << filterError << ". Exiting");
+    return EL::StatusCode::FAILURE;
+  }
+  for ( const auto& name : m_eventFilterExpr.collections() ) {
+    const bool known = ( name == "muon" && !m_muContainerName.empty() ) || ( name == "el" && !m_elContainerName.empty() ) ||
+                       ( name == "ph" && !m_photonContainerName.empty() ) || ( name == "tau" && !m_tauContainerName.empty() ) ||
+                       std::find(m_jetBranches.begin(), m_jetBranches.end(), name) != m_jetBranches.end() ||
+                       std::find(m_fatJetBranches.begin(), m_fatJetBranches.end(), name) != m_fatJetBranches.end();
+    if ( !known ) {
+      ANA_MSG_ERROR( "m_eventFilter refers to \"" << name << "\", which is not one of the collections written by this TreeAlgo. Exiting");
+      return EL::StatusCode::FAILURE;
+    }
+  }
+
+  if ( !parseBranchPatterns(m_branchCompression, m_branchCompressionPatterns) ) {
+    ANA_MSG_ERROR( "Could not parse m_branchCompression \"" << m_branchCompression << "\", expected a list of pattern:settings. Exiting");
+    return EL::StatusCode::FAILURE;
+  }
+  if ( !parseBranchPatterns(m_branchBasketSize, m_branchBasketSizePatterns) ) {
+    ANA_MSG_ERROR( "Could not parse m_branchBasketSize \"" << m_branchBasketSize << "\", expected a list of pattern:bytes. Exiting");
+    return EL::StatusCode::FAILURE;
+  }
+
+  ANA_CHECK( m_eventInfoHandle.initialize(m_eventInfoContainerName, m_event, m_store) );
+  if ( !m_vertexContainers.empty() ) ANA_CHECK( m_primaryVertexHandle.initialize(m_vertexContainers.at(0), m_event, m_store) );
+  ANA_CHECK( m_truthFatJetHandle.initialize(m_truthFatJetContainerName, m_event, m_store) );
+  ANA_CHECK( m_tauHandle.initialize(m_tauContainerName, m_event, m_store) );
+  ANA_CHECK( m_METReferenceHandle.initialize(m_METReferenceContainerName, m_event, m_store) );
+  ANA_CHECK( m_trackParticlesHandle.initialize(m_trackParticlesContainerName, m_event, m_store) );
+  ANA_CHECK( initializeHandles(m_l1JetHandles, m_l1JetContainers) );
+  ANA_CHECK( initializeHandles(m_trigJetHandles, m_trigJetContainers) );
+  ANA_CHECK( initializeHandles(m_truthJetHandles, m_truthJetContainers) );
+  ANA_CHECK( initializeHandles(m_truthParticlesHandles, m_truthParticlesContainers) );
+  ANA_CHECK( initializeHandles(m_vertexHandles, m_vertexContainers) );
+  ANA_CHECK( initializeHandles(m_clusterHandles, m_clusterContainers) );
+
   return EL::StatusCode::SUCCESS;
 }
 
@@ -216,89 +276,52 @@ EL::StatusCode TreeAlgo :: changeInput (bool /*firstFile*/) { return EL::StatusC
 
 EL::StatusCode TreeAlgo :: execute ()
 {
+  auto event = beginEvent();
+  auto timer = timeExecute();
+  if ( eventRejected() ) return EL::StatusCode::SUCCESS;
 
   // what systematics do we need to process for this event?
   // handle the nominal case (merge all) on every event, always
-  std::vector<std::string> event_systNames({""});
-  std::vector<std::string> muSystNames;
-  std::vector<std::string> elSystNames;
-  std::vector<std::string> tauSystNames;
-  std::vector<std::string> jetSystNames;
-  std::vector<std::string> photonSystNames;
-  std::vector<std::string> fatJetSystNames;
-  std::vector<std::string> metSystNames;
-
-  // this is a temporary pointer that gets switched around to check each of the systematics
-  std::vector<std::string>* systNames(nullptr);
-
-  // note that the way we set this up, none of the below ##SystNames vectors contain the nominal case
-  // TODO: do we really need to check for duplicates? Maybe, maybe not.
-  if(!m_muSystsVec.empty()){
-    ANA_CHECK( HelperFunctions::retrieve(systNames, m_muSystsVec, 0, m_store, msg()) );
+  // the names are interned once, so the merging and the lookups below are plain ID/bit operations
+  auto& systRegistry = xAH::SystematicNames::instance();
+  std::vector<xAH::SystematicNames::ID> event_systs({xAH::SystematicNames::nominal});
+  xAH::SystematicIDSet event_systSet;
+  event_systSet.insert(xAH::SystematicNames::nominal);
+  xAH::SystematicIDSet muSysts;
+  xAH::SystematicIDSet elSysts;
+  xAH::SystematicIDSet tauSysts;
+  xAH::SystematicIDSet jetSysts;
+  xAH::SystematicIDSet photonSysts;
+  xAH::SystematicIDSet fatJetSysts;
+  xAH::SystematicIDSet metSysts;
+
+  auto mergeSysts = [&](const std::string& systsVecName, xAH::SystematicIDSet& objectSysts) -> StatusCode {
+    // this is a temporary pointer that gets switched around to check each of the systematics
+    std::vector<std::string>* systNames(nullptr);
+    ANA_CHECK( HelperFunctions::retrieve(systNames, systsVecName, 0, m_store, msg()) );
     for(const auto& systName: *systNames){
-      muSystNames.push_back(systName);
-      if (std::find(event_systNames.begin(), event_systNames.end(), systName) != event_systNames.end()) continue;
-      event_systNames.push_back(systName);
+      const auto systID = systRegistry.intern(systName);
+      objectSysts.insert(systID);
+      if(event_systSet.insert(systID)) event_systs.push_back(systID);
     }
-  }
+    return StatusCode::SUCCESS;
+  };
 
-  if(!m_elSystsVec.empty()){
-    ANA_CHECK( HelperFunctions::retrieve(systNames, m_elSystsVec, 0, m_store, msg()) );
-    for(const auto& systName: *systNames){
-      elSystNames.push_back(systName);
-      if (std::find(event_systNames.begin(), event_systNames.end(), systName) != event_systNames.end()) continue;
-      event_systNames.push_back(systName);
-    }
-  }
-
-  if(!m_tauSystsVec.empty()){
-    ANA_CHECK( HelperFunctions::retrieve(systNames, m_tauSystsVec, 0, m_store, msg()) );
-    for(const auto& systName: *systNames){
-      tauSystNames.push_back(systName);
-      if (std::find(event_systNames.begin(), event_systNames.end(), systName) != event_systNames.end()) continue;
-      event_systNames.push_back(systName);
-    }
-  }
-
-  if(!m_jetSystsVec.empty()){
-    ANA_CHECK( HelperFunctions::retrieve(systNames, m_jetSystsVec, 0, m_store, msg()) );
-    for(const auto& systName: *systNames){
-      jetSystNames.push_back(systName);
-      if (std::find(event_systNames.begin(), event_systNames.end(), systName) != event_systNames.end()) continue;
-      event_systNames.push_back(systName);
-    }
-  }
-  if(!m_fatJetSystsVec.empty()){
-    ANA_CHECK( HelperFunctions::retrieve(systNames, m_fatJetSystsVec, 0, m_store, msg()) );
-    for(const auto& systName: *systNames){
-      fatJetSystNames.push_back(systName);
-      if (std::find(event_systNames.begin(), event_systNames.end(), systName) != event_systNames.end()) continue;
-      event_systNames.push_back(systName);
-    }
-  }
-  if(!m_photonSystsVec.empty()){
-    ANA_CHECK( HelperFunctions::retrieve(systNames, m_photonSystsVec, 0, m_store, msg()) );
-    for(const auto& systName: *systNames){
-      photonSystNames.push_back(systName);
-      if (std::find(event_systNames.begin(), event_systNames.end(), systName) != event_systNames.end()) continue;
-      event_systNames.push_back(systName);
-    }
-  }
-  if(!m_metSystsVec.empty()){
-    ANA_CHECK( HelperFunctions::retrieve(systNames, m_metSystsVec, 0, m_store, msg()) );
-    for(const auto& systName: *systNames){
-      metSystNames.push_back(systName);
-      if (std::find(event_systNames.begin(), event_systNames.end(), systName) != event_systNames.end()) continue;
-      event_systNames.push_back(systName);
-    }
-  }
+  if(!m_muSystsVec.empty())     ANA_CHECK( mergeSysts(m_muSystsVec, muSysts) );
+  if(!m_elSystsVec.empty())     ANA_CHECK( mergeSysts(m_elSystsVec, elSysts) );
+  if(!m_tauSystsVec.empty())    ANA_CHECK( mergeSysts(m_tauSystsVec, tauSysts) );
+  if(!m_jetSystsVec.empty())    ANA_CHECK( mergeSysts(m_jetSystsVec, jetSysts) );
+  if(!m_fatJetSystsVec.empty()) ANA_CHECK( mergeSysts(m_fatJetSystsVec, fatJetSysts) );
+  if(!m_photonSystsVec.empty()) ANA_CHECK( mergeSysts(m_photonSystsVec, photonSysts) );
+  if(!m_metSystsVec.empty())    ANA_CHECK( mergeSysts(m_metSystsVec, metSysts) );
 
   TFile* treeFile = wk()->getOutputFile ("tree");
 
   // let's make the tdirectory and ttrees
-  for(const auto& systName: event_systNames){
+  for(const auto& systID: event_systs){
+    const std::string& systName = systRegistry.name(systID);
     // check if we have already created the tree
-    if(m_trees.find(systName) != m_trees.end()) continue;
+    if(systID < m_treesByID.size() && m_treesByID[systID]) continue;
     std::string treeName = systName;
     if(systName.empty()) treeName = "nominal";
 
@@ -311,69 +334,95 @@ EL::StatusCode TreeAlgo :: execute ()
 
     m_trees[systName] = createTree( m_event, outTree, treeFile, m_units, msgLvl(MSG::DEBUG), m_store );
     const auto& helpTree = m_trees[systName];
+    if(systID >= m_treesByID.size()){
+      m_treesByID.resize(systID+1, nullptr);
+      m_treeContents.resize(systID+1);
+    }
+    m_treesByID[systID] = helpTree;
     helpTree->m_vertexContainerName = m_vertexContainers.at(0);
 
+    // the chain of each trigger matching bit, for the containers written with the triggerBits detail
+    xAH::TrigMatchBits::writeChains( outTree );
+    // and the flag of each selection flag bit, for the containers written with the selectionFlags detail
+    xAH::SelectionFlags::writeFlags( outTree );
+
     // tell the tree to go into the file
     outTree->SetDirectory( treeFile->GetDirectory(m_name.c_str()) );
     if(m_autoFlush != 0) outTree->SetAutoFlush(m_autoFlush);
+#ifdef R__USE_IMT
+    outTree->SetImplicitMT( m_writerThreads > 0 );
+#endif
     // choose if want to add tree to same directory as ouput histograms
     if ( m_outHistDir ) {
       if(m_trees.size() > 1) ANA_MSG_WARNING( "You're running systematics! You may find issues in writing all of the output TTrees to the output histogram file... Set `m_outHistDir = false` if you run into issues!");
       wk()->addOutput( outTree );
     }
 
+    // decide what goes into this tree
+    TreeContent& content = m_treeContents[systID];
+    if ( m_variedBranchesOnly && !systName.empty() ) {
+      content.full      = false;
+      content.muons     = muSysts.contains(systID);
+      content.electrons = elSysts.contains(systID);
+      content.taus      = tauSysts.contains(systID);
+      content.jets      = jetSysts.contains(systID);
+      content.photons   = photonSysts.contains(systID);
+      content.fatJets   = fatJetSysts.contains(systID);
+      content.met       = metSysts.contains(systID);
+    }
+
     // initialize all branch addresses since we just added this tree
-    helpTree->AddEvent( m_evtDetailStr );
-    if (!m_trigDetailStr.empty() )              { helpTree->AddTrigger(m_trigDetailStr);                           }
-    if (!m_muContainerName.empty() )            { helpTree->AddMuons(m_muDetailStr);                               }
-    if (!m_elContainerName.empty() )            { helpTree->AddElectrons(m_elDetailStr);                           }
-    if (!m_jetContainerName.empty() )           {
+    helpTree->AddEvent( content.full ? m_evtDetailStr : "" );
+    if (!m_trigDetailStr.empty() && content.full )        { helpTree->AddTrigger(m_trigDetailStr);                           }
+    if (!m_muContainerName.empty() && content.muons )     { helpTree->AddMuons(m_muDetailStr);                               }
+    if (!m_elContainerName.empty() && content.electrons ) { helpTree->AddElectrons(m_elDetailStr);                           }
+    if (!m_jetContainerName.empty() && content.jets )     {
       for(unsigned int ll=0; ll<m_jetContainers.size();++ll){
         if(m_jetDetails.size()==1) helpTree->AddJets       (m_jetDetailStr, m_jetBranches.at(ll).c_str());
 	else{ helpTree->AddJets       (m_jetDetails.at(ll), m_jetBranches.at(ll).c_str()); }
       }
     }
-    if (!m_l1JetContainerName.empty() )         {
+    if (!m_l1JetContainerName.empty() && content.full ) {
       for(unsigned int ll=0; ll<m_l1JetContainers.size();++ll){
         helpTree->AddL1Jets(m_l1JetBranches.at(ll).c_str());
       }
     }
-    if (!m_trigJetContainerName.empty() )      {
+    if (!m_trigJetContainerName.empty() && content.full ) {
       for(unsigned int ll=0; ll<m_trigJetContainers.size();++ll){
         if(m_trigJetDetails.size()==1) helpTree->AddJets       (m_trigJetDetailStr, m_trigJetBranches.at(ll).c_str());
 	else{ helpTree->AddJets       (m_trigJetDetails.at(ll), m_trigJetBranches.at(ll).c_str()); }
       }
     }
-    if (!m_truthJetContainerName.empty() )      {
+    if (!m_truthJetContainerName.empty() && content.full ) {
       for(unsigned int ll=0; ll<m_truthJetContainers.size();++ll){
         helpTree->AddJets       (m_truthJetDetailStr, m_truthJetBranches.at(ll).c_str());
       }
     }
-    if ( !m_fatJetContainerName.empty() ) {
+    if ( !m_fatJetContainerName.empty() && content.fatJets ) {
       for(unsigned int ll=0; ll<m_fatJetContainers.size();++ll){
         if(m_fatJetDetails.size()==1) helpTree->AddFatJets       (m_fatJetDetailStr, m_fatJetBranches.at(ll).c_str());
 	else{ helpTree->AddFatJets       (m_fatJetDetails.at(ll), m_fatJetBranches.at(ll).c_str()); }
       }
     }
-    if ( !m_vertexContainerName.empty() && !m_vertexDetailStr.empty() ) {
+    if ( !m_vertexContainerName.empty() && !m_vertexDetailStr.empty() && content.full ) {
       for(unsigned int ll=0; ll<m_vertexContainers.size();++ll){
 	if(m_vertexDetails.size()==1) helpTree->AddVertices(m_vertexDetailStr, m_vertexBranches.at(ll).c_str());
 	else{ helpTree->AddVertices(m_vertexDetails.at(ll), m_vertexBranches.at(ll).c_str()); }
       }
     }
 
-    if (!m_truthFatJetContainerName.empty() )   { helpTree->AddTruthFatJets(m_truthFatJetDetailStr, m_truthFatJetBranchName);               }
-    if (!m_tauContainerName.empty() )           { helpTree->AddTaus(m_tauDetailStr);                               }
-    if (!m_METContainerName.empty() )           { helpTree->AddMET(m_METDetailStr);                                }
-    if (!m_METReferenceContainerName.empty() )  { helpTree->AddMET(m_METReferenceDetailStr, "referenceMet");       }
-    if (!m_photonContainerName.empty() )        { helpTree->AddPhotons(m_photonDetailStr);                         }
-    if (!m_truthParticlesContainerName.empty()) {
+    if (!m_truthFatJetContainerName.empty() && content.full )   { helpTree->AddTruthFatJets(m_truthFatJetDetailStr, m_truthFatJetBranchName);               }
+    if (!m_tauContainerName.empty() && content.taus )           { helpTree->AddTaus(m_tauDetailStr);                               }
+    if (!m_METContainerName.empty() && content.met )            { helpTree->AddMET(m_METDetailStr);                                }
+    if (!m_METReferenceContainerName.empty() && content.full )  { helpTree->AddMET(m_METReferenceDetailStr, "referenceMet");       }
+    if (!m_photonContainerName.empty() && content.photons )     { helpTree->AddPhotons(m_photonDetailStr);                         }
+    if (!m_truthParticlesContainerName.empty() && content.full ) {
       for(unsigned int ll=0; ll<m_truthParticlesContainers.size();++ll){
         helpTree->AddTruthParts(m_truthParticlesDetailStr, m_truthParticlesBranches.at(ll).c_str());
       }
     }
-    if (!m_trackParticlesContainerName.empty()) { helpTree->AddTrackParts(m_trackParticlesDetailStr, m_trackParticlesContainerName); }
-    if (!m_clusterContainerName.empty() )      {
+    if (!m_trackParticlesContainerName.empty() && content.full ) { helpTree->AddTrackParts(m_trackParticlesDetailStr, m_trackParticlesContainerName); }
+    if (!m_clusterContainerName.empty() && content.full ) {
       for(unsigned int ll=0; ll<m_clusterContainers.size();++ll){
         if(m_clusterDetails.size()==1)
           helpTree->AddClusters (m_clusterDetailStr, m_clusterBranches.at(ll).c_str());
@@ -382,20 +431,32 @@ EL::StatusCode TreeAlgo :: execute ()
       }
     }
 
+    applyBranchSettings(outTree);
+    if ( m_optimizeBaskets > 0 ) m_basketsToOptimize[systName] = outTree;
+
   }
 
   /* THIS IS WHERE WE START PROCESSING THE EVENT AND PLOTTING THINGS */
 
   const xAOD::EventInfo* eventInfo(nullptr);
-  ANA_CHECK( HelperFunctions::retrieve(eventInfo, m_eventInfoContainerName, m_event, m_store, msg()) );
+  ANA_CHECK( m_eventInfoHandle.retrieve(eventInfo, msg()) );
   const xAOD::VertexContainer* vertices(nullptr);
   if (m_retrievePV) {
-    ANA_CHECK( HelperFunctions::retrieve(vertices, m_vertexContainers.at(0), m_event, m_store, msg()) );
+    ANA_CHECK( m_primaryVertexHandle.retrieve(vertices, msg()) );
   }
-  const xAOD::Vertex* primaryVertex = m_retrievePV ? HelperFunctions::getPrimaryVertex( vertices , msg() ) : nullptr;
+  // looked up once for all the systematics and collections
+  const int pvLocation = HelperFunctions::getPrimaryVertexLocation( vertices, msg() );
+  const xAOD::Vertex* primaryVertex = ( m_retrievePV && pvLocation >= 0 ) ? vertices->at( pvLocation ) : nullptr;
 
-  for(const auto& systName: event_systNames){
-    auto& helpTree = m_trees[systName];
+  // the nominal tree once it is filled for this event (it comes first), to copy the collections the systematics do not vary
+  const HelpTreeBase* nominalTree(nullptr);
+
+  for(const auto& systID: event_systs){
+    const std::string& systName = systRegistry.name(systID);
+    auto& helpTree = m_treesByID[systID];
+    const TreeContent& content = m_treeContents[systID];
+    // a tree of a derived class may fill its own branches in the Fill*User() methods, which a copy would skip
+    const HelpTreeBase* copyTree = ( m_copyNominalBranches && typeid(*helpTree) == typeid(HelpTreeBase) ) ? nominalTree : nullptr;
 
     // assume the nominal container by default
     std::string muSuffix("");
@@ -413,18 +474,43 @@ EL::StatusCode TreeAlgo :: execute ()
         -   to {""} - the nominal case. If the systName exists, we do not add it to the corresponding ##systNames vector, otherwise, we do.
         -   This precludes the nominal case in all of the ##systNames vectors, which means the default will always be to run nominal.
     */
-    if (std::find(muSystNames.begin(), muSystNames.end(), systName) != muSystNames.end()) muSuffix = systName;
-    if (std::find(elSystNames.begin(), elSystNames.end(), systName) != elSystNames.end()) elSuffix = systName;
-    if (std::find(tauSystNames.begin(), tauSystNames.end(), systName) != tauSystNames.end()) tauSuffix = systName;
-    if (std::find(jetSystNames.begin(), jetSystNames.end(), systName) != jetSystNames.end()) jetSuffix = systName;
-    if (std::find(photonSystNames.begin(), photonSystNames.end(), systName) != photonSystNames.end()) photonSuffix = systName;
-    if (std::find(fatJetSystNames.begin(), fatJetSystNames.end(), systName) != fatJetSystNames.end()) fatJetSuffix = systName;
-    if (std::find(metSystNames.begin(), metSystNames.end(), systName) != metSystNames.end()) metSuffix = systName;
+    if (muSysts.contains(systID)) muSuffix = systName;
+    if (elSysts.contains(systID)) elSuffix = systName;
+    if (tauSysts.contains(systID)) tauSuffix = systName;
+    if (jetSysts.contains(systID)) jetSuffix = systName;
+    if (photonSysts.contains(systID)) photonSuffix = systName;
+    if (fatJetSysts.contains(systID)) fatJetSuffix = systName;
+    if (metSysts.contains(systID)) metSuffix = systName;
+
+    // skim before anything is filled into the output buffers
+    if ( m_eventFilterExpr.active() ) {
+      std::vector<std::pair<std::string, std::string> > filterInputs = {
+        {"muon", m_muContainerName + muSuffix}, {"el", m_elContainerName + elSuffix},
+        {"ph", m_photonContainerName + photonSuffix}, {"tau", m_tauContainerName}
+      };
+      for ( unsigned int ll = 0; ll < m_jetContainers.size(); ++ll )    filterInputs.emplace_back(m_jetBranches.at(ll), m_jetContainers.at(ll) + jetSuffix);
+      for ( unsigned int ll = 0; ll < m_fatJetContainers.size(); ++ll ) filterInputs.emplace_back(m_fatJetBranches.at(ll), m_fatJetContainers.at(ll) + fatJetSuffix);
+
+      m_eventFilterExpr.clearCollections();
+      const auto& filterCollections = m_eventFilterExpr.collections();
+      for ( const auto& input : filterInputs ) {
+        if ( std::find(filterCollections.begin(), filterCollections.end(), input.first) == filterCollections.end() ) continue;
+        if ( !HelperFunctions::isAvailable<xAOD::IParticleContainer>(input.second, m_event, m_store, msg()) ) continue;
+        const xAOD::IParticleContainer* particles(nullptr);
+        ANA_CHECK( HelperFunctions::retrieve(particles, input.second, m_event, m_store, msg()) );
+        m_eventFilterExpr.setCollection(input.first, particles);
+      }
+
+      if ( !m_eventFilterExpr.pass() ) {
+        ANA_MSG_DEBUG( "Event fails m_eventFilter - not writing it for systematic \"" << systName << "\"" );
+        continue;
+      }
+    }
 
     helpTree->FillEvent( eventInfo, m_event, vertices );
 
     // Fill trigger information
-    if ( !m_trigDetailStr.empty() )    {
+    if ( !m_trigDetailStr.empty() && content.full ) {
       helpTree->FillTrigger( eventInfo );
     }
 
@@ -434,7 +520,7 @@ EL::StatusCode TreeAlgo :: execute ()
     }*/
 
     // for the containers the were supplied, fill the appropriate vectors
-    if ( !m_muContainerName.empty() ) {
+    if ( !m_muContainerName.empty() && content.muons && !( copyTree && muSuffix.empty() && helpTree->CopyMuons( *copyTree ) ) ) {
       if ( !HelperFunctions::isAvailable<xAOD::MuonContainer>(m_muContainerName + muSuffix, m_event, m_store, msg()) ) continue;
 
       const xAOD::MuonContainer* inMuon(nullptr);
@@ -442,7 +528,7 @@ EL::StatusCode TreeAlgo :: execute ()
       helpTree->FillMuons( inMuon, primaryVertex );
     }
 
-    if ( !m_elContainerName.empty() ) {
+    if ( !m_elContainerName.empty() && content.electrons && !( copyTree && elSuffix.empty() && helpTree->CopyElectrons( *copyTree ) ) ) {
       if ( !HelperFunctions::isAvailable<xAOD::ElectronContainer>(m_elContainerName + elSuffix, m_event, m_store, msg()) ) continue;
 
       const xAOD::ElectronContainer* inElec(nullptr);
@@ -450,9 +536,11 @@ EL::StatusCode TreeAlgo :: execute ()
       helpTree->FillElectrons( inElec, primaryVertex );
     }
 
-    if ( !m_jetContainerName.empty() ) {
+    if ( !m_jetContainerName.empty() && content.jets ) {
       bool reject = false;
       for ( unsigned int ll = 0; ll < m_jetContainers.size(); ++ll ) { // Systs for all jet containers
+        if ( copyTree && jetSuffix.empty() && helpTree->CopyJets( *copyTree, m_jetBranches.at(ll) ) ) continue;
+
         const xAOD::JetContainer* inJets(nullptr);
         if ( !HelperFunctions::isAvailable<xAOD::JetContainer>(m_jetContainers.at(ll)+jetSuffix, m_event, m_store, msg()) ) {
           ANA_MSG_DEBUG( "The jet container " + m_jetContainers.at(ll)+jetSuffix + " is not available. Skipping all remaining jet collections");
@@ -461,7 +549,7 @@ EL::StatusCode TreeAlgo :: execute ()
         }
         ANA_CHECK( HelperFunctions::retrieve(inJets, m_jetContainers.at(ll)+jetSuffix, m_event, m_store, msg()) );
 
-        helpTree->FillJets( inJets, HelperFunctions::getPrimaryVertexLocation(vertices, msg()), m_jetBranches.at(ll) );
+        helpTree->FillJets( inJets, pvLocation, m_jetBranches.at(ll) );
       }
 
       if ( reject ) {
@@ -470,15 +558,15 @@ EL::StatusCode TreeAlgo :: execute ()
       }
     }
 
-    if ( !m_l1JetContainerName.empty() ){
+    if ( !m_l1JetContainerName.empty() && content.full ){
       bool reject = false;
       for ( unsigned int ll = 0; ll < m_l1JetContainers.size(); ++ll ) {
         const xAOD::JetRoIContainer* inL1Jets(nullptr);
-        if ( !HelperFunctions::isAvailable<xAOD::JetRoIContainer>(m_l1JetContainers.at(ll), m_event, m_store, msg()) ){
+        if ( !m_l1JetHandles.at(ll).isAvailable() ){
           ANA_MSG_DEBUG( "The L1 jet container " + m_l1JetContainers.at(ll) + " is not available. Skipping all remaining L1 jet collections");
           reject = true;
 	}
-        ANA_CHECK( HelperFunctions::retrieve(inL1Jets, m_l1JetContainers.at(ll), m_event, m_store, msg()) );
+        ANA_CHECK( m_l1JetHandles.at(ll).retrieve(inL1Jets, msg()) );
         helpTree->FillL1Jets( inL1Jets, m_l1JetBranches.at(ll), m_sortL1Jets );
       }
 
@@ -488,18 +576,20 @@ EL::StatusCode TreeAlgo :: execute ()
       }
     }
 
-    if ( !m_trigJetContainerName.empty() ) {
+    if ( !m_trigJetContainerName.empty() && content.full ) {
       bool reject = false;
       for(unsigned int ll=0;ll<m_trigJetContainers.size();++ll){
-        if ( !HelperFunctions::isAvailable<xAOD::JetContainer>(m_trigJetContainers.at(ll), m_event, m_store, msg()) ) {
+        if ( copyTree && helpTree->CopyJets( *copyTree, m_trigJetBranches.at(ll) ) ) continue;
+
+        if ( !m_trigJetHandles.at(ll).isAvailable() ) {
           ANA_MSG_DEBUG( "The trigger jet container " + m_trigJetContainers.at(ll) + " is not available. Skipping all remaining trigger jet collections");
           reject = true;
           break;
         }
 
         const xAOD::JetContainer* inTrigJets(nullptr);
-        ANA_CHECK( HelperFunctions::retrieve(inTrigJets, m_trigJetContainers.at(ll), m_event, m_store, msg()) );
-        helpTree->FillJets( inTrigJets, HelperFunctions::getPrimaryVertexLocation(vertices, msg()), m_trigJetBranches.at(ll) );
+        ANA_CHECK( m_trigJetHandles.at(ll).retrieve(inTrigJets, msg()) );
+        helpTree->FillJets( inTrigJets, pvLocation, m_trigJetBranches.at(ll) );
       }
 
       if ( reject ) {
@@ -508,18 +598,20 @@ EL::StatusCode TreeAlgo :: execute ()
       }
     }
 
-    if ( !m_truthJetContainerName.empty() ) {
+    if ( !m_truthJetContainerName.empty() && content.full ) {
       bool reject = false;
       for ( unsigned int ll = 0; ll < m_truthJetContainers.size(); ++ll) {
-        if ( !HelperFunctions::isAvailable<xAOD::JetContainer>(m_truthJetContainers.at(ll), m_event, m_store, msg()) ) {
+        if ( copyTree && helpTree->CopyJets( *copyTree, m_truthJetBranches.at(ll) ) ) continue;
+
+        if ( !m_truthJetHandles.at(ll).isAvailable() ) {
           ANA_MSG_DEBUG( "The truth jet container " + m_truthJetContainers.at(ll) + " is not available. Skipping all remaining truth jet collections");
           reject = true;
           break;
         }
 
         const xAOD::JetContainer* inTruthJets(nullptr);
-        ANA_CHECK( HelperFunctions::retrieve(inTruthJets, m_truthJetContainers.at(ll), m_event, m_store, msg()) );
-        helpTree->FillJets( inTruthJets, HelperFunctions::getPrimaryVertexLocation(vertices, msg()), m_truthJetBranches.at(ll) );
+        ANA_CHECK( m_truthJetHandles.at(ll).retrieve(inTruthJets, msg()) );
+        helpTree->FillJets( inTruthJets, pvLocation, m_truthJetBranches.at(ll) );
       }
 
       if ( reject ) {
@@ -528,7 +620,7 @@ EL::StatusCode TreeAlgo :: execute ()
       }
     }
 
-    if ( !m_fatJetContainerName.empty() ) {
+    if ( !m_fatJetContainerName.empty() && content.fatJets ) {
       // bool reject = false;
       // std::string token;
       // std::istringstream ss(m_fatJetContainerName);
@@ -547,6 +639,8 @@ EL::StatusCode TreeAlgo :: execute ()
 
       bool reject = false;
       for(unsigned int ll=0;ll<m_fatJetContainers.size();++ll){
+        if ( copyTree && fatJetSuffix.empty() && helpTree->CopyFatJets( *copyTree, m_fatJetBranches.at(ll) ) ) continue;
+
         if ( !HelperFunctions::isAvailable<xAOD::JetContainer>(m_fatJetContainers.at(ll)+fatJetSuffix, m_event, m_store, msg()) ) {
           ANA_MSG_DEBUG( "The fatjet container " + m_fatJetContainers.at(ll)+fatJetSuffix + " was not retrieved. Skipping all remaining fat jet collections");
           reject = true;
@@ -555,7 +649,7 @@ EL::StatusCode TreeAlgo :: execute ()
 
         const xAOD::JetContainer* inFatJets(nullptr);
         ANA_CHECK( HelperFunctions::retrieve(inFatJets, m_fatJetContainers.at(ll)+fatJetSuffix, m_event, m_store, msg()) );
-        helpTree->FillFatJets( inFatJets, HelperFunctions::getPrimaryVertexLocation(vertices, msg()), m_fatJetBranches.at(ll) );
+        helpTree->FillFatJets( inFatJets, pvLocation, m_fatJetBranches.at(ll) );
 
       }
 
@@ -565,23 +659,23 @@ EL::StatusCode TreeAlgo :: execute ()
       }
     }
 
-    if ( !m_truthFatJetContainerName.empty() ) {
-      if ( !HelperFunctions::isAvailable<xAOD::JetContainer>(m_truthFatJetContainerName, m_event, m_store, msg()) ) continue;
+    if ( !m_truthFatJetContainerName.empty() && content.full ) {
+      if ( !m_truthFatJetHandle.isAvailable() ) continue;
 
       const xAOD::JetContainer* inTruthFatJets(nullptr);
-      ANA_CHECK( HelperFunctions::retrieve(inTruthFatJets, m_truthFatJetContainerName, m_event, m_store, msg()) );
-      helpTree->FillTruthFatJets( inTruthFatJets, HelperFunctions::getPrimaryVertexLocation(vertices, msg()), m_truthFatJetBranchName );
+      ANA_CHECK( m_truthFatJetHandle.retrieve(inTruthFatJets, msg()) );
+      helpTree->FillTruthFatJets( inTruthFatJets, pvLocation, m_truthFatJetBranchName );
     }
 
-    if ( !m_tauContainerName.empty() ) {
-      if ( !HelperFunctions::isAvailable<xAOD::TauJetContainer>(m_tauContainerName, m_event, m_store, msg()) ) continue;
+    if ( !m_tauContainerName.empty() && content.taus && !( copyTree && helpTree->CopyTaus( *copyTree ) ) ) {
+      if ( !m_tauHandle.isAvailable() ) continue;
 
       const xAOD::TauJetContainer* inTaus(nullptr);
-      ANA_CHECK( HelperFunctions::retrieve(inTaus, m_tauContainerName, m_event, m_store, msg()) );
+      ANA_CHECK( m_tauHandle.retrieve(inTaus, msg()) );
       helpTree->FillTaus( inTaus );
     }
 
-    if ( !m_METContainerName.empty() ) {
+    if ( !m_METContainerName.empty() && content.met ) {
       if ( !HelperFunctions::isAvailable<xAOD::MissingETContainer>(m_METContainerName + metSuffix, m_event, m_store, msg()) ) continue;
 
       const xAOD::MissingETContainer* inMETCont(nullptr);
@@ -589,15 +683,15 @@ EL::StatusCode TreeAlgo :: execute ()
       helpTree->FillMET( inMETCont );
     }
 
-    if ( !m_METReferenceContainerName.empty() ) {
-      if ( !HelperFunctions::isAvailable<xAOD::MissingETContainer>(m_METReferenceContainerName, m_event, m_store, msg()) ) continue;
+    if ( !m_METReferenceContainerName.empty() && content.full ) {
+      if ( !m_METReferenceHandle.isAvailable() ) continue;
 
       const xAOD::MissingETContainer* inMETCont(nullptr);
-      ANA_CHECK( HelperFunctions::retrieve(inMETCont, m_METReferenceContainerName, m_event, m_store, msg()) );
+      ANA_CHECK( m_METReferenceHandle.retrieve(inMETCont, msg()) );
       helpTree->FillMET( inMETCont, "referenceMet" );
     }
 
-    if ( !m_photonContainerName.empty() ) {
+    if ( !m_photonContainerName.empty() && content.photons && !( copyTree && photonSuffix.empty() && helpTree->CopyPhotons( *copyTree ) ) ) {
       if ( !HelperFunctions::isAvailable<xAOD::PhotonContainer>(m_photonContainerName + photonSuffix, m_event, m_store, msg()) ) continue;
 
       const xAOD::PhotonContainer* inPhotons(nullptr);
@@ -605,33 +699,33 @@ EL::StatusCode TreeAlgo :: execute ()
       helpTree->FillPhotons( inPhotons );
     }
 
-    if ( !m_truthParticlesContainerName.empty() ) {
+    if ( !m_truthParticlesContainerName.empty() && content.full ) {
       for ( unsigned int ll = 0; ll < m_truthParticlesContainers.size(); ++ll) {
-        if ( !HelperFunctions::isAvailable<xAOD::TruthParticleContainer>(m_truthParticlesContainers.at(ll), m_event, m_store, msg()) ) continue;
+        if ( !m_truthParticlesHandles.at(ll).isAvailable() ) continue;
 
         const xAOD::TruthParticleContainer* inTruthParticles(nullptr);
-        ANA_CHECK( HelperFunctions::retrieve(inTruthParticles, m_truthParticlesContainers.at(ll), m_event, m_store, msg()));
+        ANA_CHECK( m_truthParticlesHandles.at(ll).retrieve(inTruthParticles, msg()));
         helpTree->FillTruth(inTruthParticles, m_truthParticlesBranches.at(ll));
       }
     }
 
-    if ( !m_trackParticlesContainerName.empty() ) {
-      if ( !HelperFunctions::isAvailable<xAOD::TrackParticleContainer>(m_trackParticlesContainerName, m_event, m_store, msg()) ) continue;
+    if ( !m_trackParticlesContainerName.empty() && content.full ) {
+      if ( !m_trackParticlesHandle.isAvailable() ) continue;
 
       const xAOD::TrackParticleContainer* inTrackParticles(nullptr);
-      ANA_CHECK( HelperFunctions::retrieve(inTrackParticles, m_trackParticlesContainerName, m_event, m_store, msg()));
+      ANA_CHECK( m_trackParticlesHandle.retrieve(inTrackParticles, msg()));
       helpTree->FillTracks(inTrackParticles,m_trackParticlesContainerName);
     }
 
-    if ( !m_vertexContainerName.empty() && !m_vertexDetailStr.empty() ){
+    if ( !m_vertexContainerName.empty() && !m_vertexDetailStr.empty() && content.full ){
       bool reject = false;
       for ( unsigned int ll = 0; ll < m_vertexContainers.size(); ++ll ) {
         const xAOD::VertexContainer* inVertices(nullptr);
-        if ( !HelperFunctions::isAvailable<xAOD::VertexContainer>(m_vertexContainers.at(ll), m_event, m_store, msg()) ){
+        if ( !m_vertexHandles.at(ll).isAvailable() ){
           ANA_MSG_DEBUG( "The vertex container " + m_vertexContainers.at(ll) + " is not available. Skipping all remaining vertex collections");
           reject = true;
 	}
-        ANA_CHECK( HelperFunctions::retrieve(inVertices, m_vertexContainers.at(ll), m_event, m_store, msg()) );
+        ANA_CHECK( m_vertexHandles.at(ll).retrieve(inVertices, msg()) );
         helpTree->FillVertices( inVertices, m_vertexBranches.at(ll));
       }
 
@@ -641,17 +735,17 @@ EL::StatusCode TreeAlgo :: execute ()
       }
     }
 
-    if ( !m_clusterContainerName.empty() ) {
+    if ( !m_clusterContainerName.empty() && content.full ) {
       bool reject = false;
       for(unsigned int ll=0;ll<m_clusterContainers.size();++ll){
-        if ( !HelperFunctions::isAvailable<xAOD::CaloClusterContainer>(m_clusterContainers.at(ll), m_event, m_store, msg()) ) {
+        if ( !m_clusterHandles.at(ll).isAvailable() ) {
           ANA_MSG_DEBUG( "The cluster container " + m_clusterContainers.at(ll) + " is not available. Skipping all remaining cluster collections");
           reject = true;
           break;
         }
 
         const xAOD::CaloClusterContainer* inClusters(nullptr);
-        ANA_CHECK( HelperFunctions::retrieve(inClusters, m_clusterContainers.at(ll), m_event, m_store, msg()) );
+        ANA_CHECK( m_clusterHandles.at(ll).retrieve(inClusters, msg()) );
         helpTree->FillClusters( inClusters, m_clusterBranches.at(ll) );
       }
 
@@ -663,6 +757,19 @@ EL::StatusCode TreeAlgo :: execute ()
 
     // fill the tree
     helpTree->Fill();
+    if ( systID == xAH::SystematicNames::nominal ) {
+      nominalTree = helpTree;
+      if ( m_writeEventIndex ) m_eventIndex.add( eventInfo->runNumber(), eventInfo->eventNumber(), m_nominalEntries );
+      ++m_nominalEntries;
+    }
+
+    if ( !m_basketsToOptimize.empty() ) {
+      auto toOptimize = m_basketsToOptimize.find(systName);
+      if ( toOptimize != m_basketsToOptimize.end() && toOptimize->second->GetEntries() >= m_optimizeBaskets ) {
+        toOptimize->second->OptimizeBaskets();
+        m_basketsToOptimize.erase(toOptimize);
+      }
+    }
   }
 
   return EL::StatusCode::SUCCESS;
@@ -673,17 +780,81 @@ EL::StatusCode TreeAlgo :: postExecute () { return EL::StatusCode::SUCCESS; }
 
 EL::StatusCode TreeAlgo :: finalize () {
 
+  if ( m_writeEventIndex ) {
+    TDirectory* treeDir = wk()->getOutputFile ("tree")->GetDirectory(m_name.c_str());
+    if ( treeDir ) {
+      ANA_MSG_INFO( "Writing the index of the " << m_eventIndex.size() << " events of " << m_name << "/nominal");
+      m_eventIndex.write(treeDir);
+    }
+    m_eventIndex.clear();
+  }
+
+  if ( m_variedBranchesOnly ) {
+    // so that the systematic trees can be used as friends of the nominal one
+    TFile* treeFile = wk()->getOutputFile ("tree");
+    TDirectory* treeDir = treeFile->GetDirectory(m_name.c_str());
+    for(const auto& item: m_trees){
+      if(item.first.empty()) continue;
+      TTree* systTree = treeDir ? dynamic_cast<TTree*>(treeDir->Get(item.first.c_str())) : nullptr;
+      if(systTree) systTree->BuildIndex("runNumber", "eventNumber");
+    }
+  }
+
   ANA_MSG_INFO( "Deleting tree instances...");
 
   for(auto& item: m_trees){
     if(item.second) {delete item.second; item.second = nullptr; }
   }
   m_trees.clear();
+  m_treesByID.clear();
+
+  return EL::StatusCode::SUCCESS;
+}
 
+EL::StatusCode TreeAlgo :: histFinalize ()
+{
+  ANA_CHECK( xAH::Algorithm::algFinalize());
   return EL::StatusCode::SUCCESS;
 }
 
-EL::StatusCode TreeAlgo :: histFinalize () { return EL::StatusCode::SUCCESS; }
+namespace {
+  // the value of the first wildcard pattern matching the full branch name, or fallback
+  int matchBranchPattern(const TString& branchName, const std::vector<std::pair<std::string, int> >& patterns, int fallback) {
+    for ( const auto& pattern : patterns ) {
+      Ssiz_t length(0);
+      if ( branchName.Index(TRegexp(pattern.first.c_str(), kTRUE), &length) == 0 && length == branchName.Length() ) return pattern.second;
+    }
+    return fallback;
+  }
+}
+
+bool TreeAlgo :: parseBranchPatterns(const std::string& config, std::vector<std::pair<std::string, int> >& patterns) {
+  std::istringstream ss(config);
+  std::string token;
+  while ( ss >> token ){
+    const auto sep = token.rfind(':');
+    if ( sep == std::string::npos || sep == 0 || sep+1 == token.size() ) return false;
+    try {
+      patterns.emplace_back(token.substr(0, sep), std::stoi(token.substr(sep+1)));
+    } catch ( const std::logic_error& ) {
+      return false;
+    }
+  }
+  return true;
+}
+
+void TreeAlgo :: applyBranchSettings(TTree* tree) const {
+  if ( m_compressionSettings < 0 && m_branchCompressionPatterns.empty() && m_basketSize <= 0 && m_branchBasketSizePatterns.empty() ) return;
+
+  TIter next(tree->GetListOfBranches());
+  while ( TBranch* branch = static_cast<TBranch*>(next()) ) {
+    const TString branchName(branch->GetName());
+    const int settings   = matchBranchPattern(branchName, m_branchCompressionPatterns, m_compressionSettings);
+    const int basketSize = matchBranchPattern(branchName, m_branchBasketSizePatterns, m_basketSize);
+    if ( settings >= 0 ) branch->SetCompressionSettings(settings);
+    if ( basketSize > 0 ) branch->SetBasketSize(basketSize);
+  }
+}
 
 HelpTreeBase* TreeAlgo :: createTree(xAOD::TEvent *event, TTree* tree, TFile* file, const float units, bool debug, xAOD::TStore* store) {
     return new HelpTreeBase( event, tree, file, units, debug, store );
@@ -0,0 +1,29 @@
+#include <xAODAnaHelpers/TrigFeatureCache.h>
+
+#include <map>
+#include <tuple>
+
+namespace {
+  // the event the cached features belong to
+  Long64_t s_entry = -1;
+  const TFile* s_file = nullptr;
+  std::string s_fileName;
+
+  std::map<std::tuple<const Trig::TrigDecisionTool*, std::string, unsigned int>, Trig::FeatureContainer> s_features;
+}
+
+const Trig::FeatureContainer& xAH::TrigFeatureCache::features(const EL::IWorker* worker, Trig::TrigDecisionTool* tdt, const std::string& chain, unsigned int condition)
+{
+  // the file pointer alone could be reused by the next input file
+  if(worker->treeEntry() != s_entry || worker->inputFile() != s_file || worker->inputFileName() != s_fileName){
+    s_features.clear();
+    s_entry    = worker->treeEntry();
+    s_file     = worker->inputFile();
+    s_fileName = worker->inputFileName();
+  }
+
+  auto key = std::make_tuple(static_cast<const Trig::TrigDecisionTool*>(tdt), chain, condition);
+  auto it = s_features.find(key);
+  if(it == s_features.end()) it = s_features.emplace(key, tdt->features(chain, condition)).first;
+  return it->second;
+}
@@ -0,0 +1,105 @@
+#include <xAODAnaHelpers/TrigMatchBits.h>
+
+#include <TList.h>
+#include <TObjArray.h>
+#include <TObjString.h>
+#include <TTree.h>
+
+#include <algorithm>
+#include <numeric>
+
+namespace {
+
+  const std::string unknownChain = "UNKNOWN";
+
+  std::vector<std::string>& chains()
+  {
+    static std::vector<std::string> chainNames;
+    return chainNames;
+  }
+
+  // the bits of the chains registered in this job, in alphabetical order, updated whenever one is registered
+  std::vector<unsigned int>& chainOrder()
+  {
+    static std::vector<unsigned int> order = xAH::TrigMatchBits::order(chains());
+    return order;
+  }
+
+  const std::string& nameOf(const std::vector<std::string>& names, unsigned int bit)
+  {
+    return bit < names.size() ? names[bit] : unknownChain;
+  }
+
+}
+
+int xAH::TrigMatchBits::bit(const std::string& chain)
+{
+  std::vector<std::string>& chainNames = chains();
+  for(unsigned int i = 0; i < chainNames.size(); ++i){
+    if(chainNames[i] == chain) return i;
+  }
+  if(chainNames.size() >= maxChains) return -1;
+  chainNames.push_back(chain);
+  chainOrder() = order(chainNames);
+  return chainNames.size() - 1;
+}
+
+const std::string& xAH::TrigMatchBits::chain(unsigned int bit)
+{
+  return chains().at(bit);
+}
+
+std::vector<unsigned int> xAH::TrigMatchBits::order(const std::vector<std::string>& names)
+{
+  std::vector<unsigned int> bits(maxChains);
+  std::iota(bits.begin(), bits.end(), 0);
+  // the bits without a name keep their order among themselves
+  std::stable_sort(bits.begin(), bits.end(), [&names](unsigned int a, unsigned int b){ return nameOf(names, a) < nameOf(names, b); });
+  return bits;
+}
+
+void xAH::TrigMatchBits::unpack(unsigned long long tested, unsigned long long matched, std::vector<int>& matches, std::vector<std::string>& chainNames)
+{
+  unpack(tested, matched, matches, chainNames, chains(), chainOrder());
+}
+
+void xAH::TrigMatchBits::unpack(unsigned long long tested, unsigned long long matched, std::vector<int>& matches, std::vector<std::string>& chainNames,
+                                const std::vector<std::string>& names, const std::vector<unsigned int>& order)
+{
+  for(unsigned int bit : order){
+    if(!tested) break;
+    if(!((tested >> bit) & 1ULL)) continue;
+    tested &= ~(1ULL << bit);
+    matches.push_back( static_cast<int>((matched >> bit) & 1ULL) );
+    chainNames.push_back( nameOf(names, bit) );
+  }
+}
+
+void xAH::TrigMatchBits::writeChains(TTree* tree)
+{
+  TList* userInfo = tree->GetUserInfo();
+  if(TObject* previous = userInfo->FindObject("trigMatchChains")){
+    userInfo->Remove(previous);
+    delete previous;
+  }
+
+  TObjArray* chainNames = new TObjArray();
+  chainNames->SetName("trigMatchChains");
+  chainNames->SetOwner(true);
+  for(const std::string& chainName : chains()) chainNames->Add(new TObjString(chainName.c_str()));
+  userInfo->Add(chainNames);
+}
+
+std::vector<std::string> xAH::TrigMatchBits::readChains(TTree* tree)
+{
+  std::vector<std::string> chainNames;
+
+  // a TChain has no user info of its own
+  if(tree->GetTree() == nullptr) tree->LoadTree(0);
+  TTree* current = tree->GetTree() ? tree->GetTree() : tree;
+
+  const TObjArray* stored = dynamic_cast<const TObjArray*>(current->GetUserInfo()->FindObject("trigMatchChains"));
+  if(!stored) return chainNames;
+  for(const TObject* chainName : *stored) chainNames.push_back( chainName->GetName() );
+  return chainNames;
+}
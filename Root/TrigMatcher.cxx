@@ -16,7 +16,9 @@
 
 // EDM include(s):
 #include <xAODEventInfo/EventInfo.h>
+#include <xAODBase/IParticleHelpers.h>
 #include <xAODAnaHelpers/HelperFunctions.h>
+#include <xAODAnaHelpers/TrigMatchBits.h>
 
 #include <xAODAnaHelpers/TrigMatcher.h>
 
@@ -95,6 +97,21 @@ EL::StatusCode TrigMatcher :: initialize ()
     }
   }
 
+  // the chains share their bits with the selectors, so that the ntuples can name them
+  for ( const std::string& chain : m_trigChainsList ) {
+    const int bit = xAH::TrigMatchBits::bit( chain );
+    m_trigChainsBits.push_back( bit );
+    if ( bit >= 0 ) {
+      m_testedBits |= 1ull << bit;
+      continue;
+    }
+    if ( m_writeMatchBits ) {
+      ANA_MSG_ERROR( "At most " << xAH::TrigMatchBits::maxChains << " trigger chains can be matched in a job with m_writeMatchBits, cannot add " << chain );
+      return EL::StatusCode::FAILURE;
+    }
+    m_reuseMatchesForSameDirection = false;
+  }
+
   //  everything went fine, let's initialise the tool!
   //
   if( !isPHYS() ) {
@@ -114,6 +131,9 @@ EL::StatusCode TrigMatcher :: initialize ()
 
 EL::StatusCode TrigMatcher :: execute ()
 {
+  auto event = beginEvent();
+  auto timer = timeExecute();
+  if ( eventRejected() ) return EL::StatusCode::SUCCESS;
   // Here you do everything that needs to be done on every single
   // events, e.g. read input variables, apply cuts, and fill
   // histograms and trees.  This is where most of your actual analysis
@@ -121,6 +141,17 @@ EL::StatusCode TrigMatcher :: execute ()
 
   ANA_MSG_DEBUG( "Applying trigger matching... ");
 
+  m_matchCache.clear();
+
+  // chains that did not pass have no matches, for any object and systematic
+  //
+  m_chainPassed.assign( m_trigChainsList.size(), 1 );
+  if ( m_skipFailedChains && !isPHYS() ) {
+    for ( std::size_t iChain = 0; iChain < m_trigChainsList.size(); ++iChain ) {
+      m_chainPassed[iChain] = m_trigDecTool_handle->isPassed( m_trigChainsList[iChain] );
+    }
+  }
+
   const xAOD::IParticleContainer* inParticles(nullptr);
 
   // if input comes from xAOD, or just running one collection,
@@ -158,6 +189,8 @@ EL::StatusCode TrigMatcher :: execute ()
 EL::StatusCode TrigMatcher :: executeMatching ( const xAOD::IParticleContainer* inParticles )
 {
   static const SG::AuxElement::Decorator< std::vector< std::string > > isTrigMatchedDecor( "trigMatched" );
+  static const SG::AuxElement::Decorator< unsigned long long > trigMatchedBitsDecor( "trigMatchedBits" );
+  static const SG::AuxElement::Decorator< unsigned long long > trigMatchTestedBitsDecor( "trigMatchTestedBits" );
 
   for( auto particle : *inParticles )
     {
@@ -166,12 +199,43 @@ EL::StatusCode TrigMatcher :: executeMatching ( const xAOD::IParticleContainer*
       if ( !isTrigMatchedDecor.isAvailable( *particle ) )
 	isTrigMatchedDecor( *particle ) = std::vector<std::string>();
 
-      for ( auto const &chain : m_trigChainsList ) {
-	ANA_MSG_DEBUG( "\t checking trigger chain " << chain);
+      // a copy of an already matched object, pointing the same way, gets the same result
+      //
+      const xAOD::IParticle* original = xAOD::getOriginalObject( *particle );
+      if ( !original ) original = particle;
+
+      unsigned long long bits(0);
+      auto cached = m_reuseMatchesForSameDirection ? m_matchCache.find( original ) : m_matchCache.end();
+      if ( cached != m_matchCache.end() && cached->second.eta == particle->eta() && cached->second.phi == particle->phi() ) {
+        ANA_MSG_DEBUG( "\t reusing the result of another copy" );
+        bits = cached->second.bits;
+        for ( std::size_t iChain = 0; iChain < m_trigChainsList.size(); ++iChain ) {
+          if ( bits & (1ull << m_trigChainsBits[iChain]) ) isTrigMatchedDecor( *particle ).push_back( m_trigChainsList[iChain] );
+        }
+      } else {
+        for ( std::size_t iChain = 0; iChain < m_trigChainsList.size(); ++iChain ) {
+          if ( !m_chainPassed[iChain] ) continue;
+          const std::string& chain = m_trigChainsList[iChain];
+          ANA_MSG_DEBUG( "\t checking trigger chain " << chain);
+
+          bool matched = m_trigMatchTool_handle->match( *particle, chain, 0.07 );
+          ANA_MSG_DEBUG( "\t\t result = " << matched );
+          if ( !matched ) continue;
+          if ( m_trigChainsBits[iChain] >= 0 ) bits |= 1ull << m_trigChainsBits[iChain];
+          isTrigMatchedDecor( *particle ).push_back( chain );
+        }
+        if ( m_reuseMatchesForSameDirection ) m_matchCache[original] = CachedMatch{ particle->eta(), particle->phi(), bits };
+      }
 
-	bool matched = m_trigMatchTool_handle->match( *particle, chain, 0.07 );
-	ANA_MSG_DEBUG( "\t\t result = " << matched );
-	if(matched) isTrigMatchedDecor( *particle ).push_back( chain );
+      if ( m_writeMatchBits ) {
+        // another matcher of the same objects adds its own chains
+        //
+        if ( !trigMatchTestedBitsDecor.isAvailable( *particle ) ) {
+          trigMatchTestedBitsDecor( *particle ) = 0;
+          trigMatchedBitsDecor( *particle ) = 0;
+        }
+        trigMatchTestedBitsDecor( *particle ) |= m_testedBits;
+        trigMatchedBitsDecor( *particle ) = ( trigMatchedBitsDecor( *particle ) & ~m_testedBits ) | bits;
       }
     }
 
@@ -0,0 +1,55 @@
+#include <xAODAnaHelpers/TriggerDictionary.h>
+
+#include <deque>
+#include <mutex>
+
+namespace {
+  std::mutex s_mutex;
+  // a deque does not move its elements, so the references handed out stay valid
+  std::deque<std::vector<std::string> > s_dictionaries;
+}
+
+unsigned int xAH::TriggerDictionary::intern(const std::vector<std::string>& chains)
+{
+  std::lock_guard<std::mutex> lock(s_mutex);
+  for(std::size_t id = 0; id < s_dictionaries.size(); ++id){
+    if(s_dictionaries[id] == chains) return id;
+  }
+  s_dictionaries.push_back(chains);
+  return s_dictionaries.size() - 1;
+}
+
+const std::vector<std::string>& xAH::TriggerDictionary::chains(unsigned int id)
+{
+  static const std::vector<std::string> empty;
+  std::lock_guard<std::mutex> lock(s_mutex);
+  return id < s_dictionaries.size() ? s_dictionaries[id] : empty;
+}
+
+void xAH::TriggerDictionary::setBit(std::vector<unsigned long long>& bits, unsigned int index)
+{
+  const unsigned int word = index / 64;
+  if(bits.size() <= word) bits.resize(word+1, 0);
+  bits[word] |= 1ULL << (index % 64);
+}
+
+bool xAH::TriggerDictionary::testBit(const std::vector<unsigned long long>& bits, unsigned int index)
+{
+  const unsigned int word = index / 64;
+  return word < bits.size() && (bits[word] >> (index % 64)) & 1ULL;
+}
+
+void xAH::TriggerDictionary::unpack(unsigned int id, const std::vector<unsigned long long>& bits, std::vector<std::string>& names)
+{
+  const std::vector<std::string>& dictionary = chains(id);
+  for(std::size_t index = 0; index < dictionary.size(); ++index){
+    if(testBit(bits, index)) names.push_back(dictionary[index]);
+  }
+}
+
+void xAH::TriggerDictionary::select(const std::vector<unsigned long long>& bits, const std::vector<float>& values, std::vector<float>& selected)
+{
+  for(std::size_t index = 0; index < values.size(); ++index){
+    if(testBit(bits, index)) selected.push_back(values[index]);
+  }
+}
@@ -40,6 +40,11 @@ TruthContainer::TruthContainer(const std::string& name, const std::string& detai
     m_child_status   = new std::vector< std::vector<int> >();
   }
 
+  if(m_infoSwitch.m_links){
+    m_parent_index = new xAH::JaggedBranch<int>(true);
+    m_child_index  = new xAH::JaggedBranch<int>(true);
+  }
+
   if(m_infoSwitch.m_dressed){
     m_pt_dressed  = new std::vector<float>();
     m_eta_dressed = new std::vector<float>();
@@ -91,6 +96,11 @@ TruthContainer::~TruthContainer()
     delete m_child_status;
   }
 
+  if(m_infoSwitch.m_links){
+    delete m_parent_index;
+    delete m_child_index;
+  }
+
   if(m_infoSwitch.m_dressed){
     delete m_pt_dressed;
     delete m_eta_dressed;
@@ -143,6 +153,11 @@ void TruthContainer::setTree(TTree *tree)
     connectBranch<std::vector<int> >(tree,"child_status",  &m_child_status);
   }
 
+  if(m_infoSwitch.m_links){
+    connectBranch<int>(tree,"parent_index", m_parent_index);
+    connectBranch<int>(tree,"child_index",  m_child_index);
+  }
+
   if(m_infoSwitch.m_dressed){
     connectBranch<float> (tree,"pt_dressed",  &m_pt_dressed);
     connectBranch<float> (tree,"eta_dressed", &m_eta_dressed);
@@ -196,6 +211,13 @@ void TruthContainer::updateParticle(uint idx, TruthPart& truth)
     truth.child_status  = m_child_status ->at(idx);
   }
 
+  if(m_infoSwitch.m_links){
+    const auto parents  = m_parent_index->span(idx);
+    const auto children = m_child_index ->span(idx);
+    truth.parent_index.assign(parents.begin(),  parents.end());
+    truth.child_index .assign(children.begin(), children.end());
+  }
+
   if(m_infoSwitch.m_dressed){
     truth.pt_dressed  = m_pt_dressed->at(idx);
     truth.eta_dressed = m_eta_dressed->at(idx);
@@ -251,6 +273,11 @@ void TruthContainer::setBranches(TTree *tree)
     setBranch<std::vector<int> >(tree,"child_status",                 m_child_status         );
   }
 
+  if(m_infoSwitch.m_links){
+    setBranch<int>(tree,"parent_index", m_parent_index);
+    setBranch<int>(tree,"child_index",  m_child_index );
+  }
+
   if(m_infoSwitch.m_dressed){
     setBranch<float> (tree,"pt_dressed", m_pt_dressed );
     setBranch<float> (tree,"eta_dressed", m_eta_dressed );
@@ -304,6 +331,12 @@ void TruthContainer::clear()
     m_child_status->clear();
   }
 
+  if(m_infoSwitch.m_links){
+    m_parent_index->clear();
+    m_child_index ->clear();
+    m_linkParticles.clear();
+  }
+
   if(m_infoSwitch.m_dressed){
     m_pt_dressed->clear();
     m_eta_dressed->clear();
@@ -404,6 +437,11 @@ void TruthContainer::FillTruth( const xAOD::IParticle* particle ){
     }
   }
 
+  // the parents and children may be filled later in the event, see resolveLinks()
+  if(m_infoSwitch.m_links){
+    m_linkParticles.push_back(truth);
+  }
+
   if(m_infoSwitch.m_dressed){
     if( truth->isAvailable<float>("pt_dressed") ){
       float pt_dressed = truth->auxdata<float>("pt_dressed");
@@ -453,3 +491,28 @@ void TruthContainer::FillTruth( const xAOD::IParticle* particle ){
   return;
 }
 
+void TruthContainer::resolveLinks()
+{
+  if(!m_infoSwitch.m_links || m_linkParticles.empty()) return;
+
+  m_linkIndex.clear();
+  for(std::size_t i = 0; i < m_linkParticles.size(); ++i)
+    m_linkIndex.emplace(m_linkParticles[i], i);
+
+  for(const xAOD::TruthParticle* truth : m_linkParticles){
+    m_parent_index->newEntry();
+    for(std::size_t iparent = 0; iparent < truth->nParents(); ++iparent){
+      const auto it = m_linkIndex.find(truth->parent(iparent));
+      m_parent_index->fill(it != m_linkIndex.end() ? it->second : -1);
+    }
+
+    m_child_index->newEntry();
+    for(std::size_t ichild = 0; ichild < truth->nChildren(); ++ichild){
+      const auto it = m_linkIndex.find(truth->child(ichild));
+      m_child_index->fill(it != m_linkIndex.end() ? it->second : -1);
+    }
+  }
+
+  // the pointers are only valid for this event
+  m_linkParticles.clear();
+}
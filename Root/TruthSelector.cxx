@@ -9,6 +9,7 @@
 // c++ include(s):
 #include <iostream>
 #include <typeinfo>
+#include <algorithm>
 #include <sstream>
 
 // EL include(s):
@@ -117,6 +118,26 @@ EL::StatusCode TruthSelector :: initialize ()
 
   m_decor   = "passSel";
 
+  // parse the "|" separated type and origin values once, instead of for each particle
+  //
+  std::string token;
+  m_typeVec.clear();
+  if ( !m_typeOptions.empty() ) {
+    if ( m_type != 1000 ) { ANA_MSG_WARNING( "single and multiple type conditions were selected, only the former will be used" ); }
+    else {
+      std::istringstream ss(m_typeOptions);
+      while ( std::getline(ss, token, '|') ) m_typeVec.push_back(std::stoi(token));
+    }
+  }
+  m_originVec.clear();
+  if ( !m_originOptions.empty() ) {
+    if ( m_origin != 1000 ) { ANA_MSG_WARNING( "single and multiple origin conditions were selected, only the former will be used" ); }
+    else {
+      std::istringstream ss(m_originOptions);
+      while ( std::getline(ss, token, '|') ) m_originVec.push_back(std::stoi(token));
+    }
+  }
+
   if ( m_decorateSelectedObjects ) {
     ANA_MSG_INFO(" Decorate Jets with " << m_decor);
   }
@@ -142,6 +163,9 @@ EL::StatusCode TruthSelector :: initialize ()
 
 EL::StatusCode TruthSelector :: execute ()
 {
+  auto event = beginEvent();
+  auto timer = timeExecute();
+  if ( eventRejected() ) return EL::StatusCode::SUCCESS;
   ANA_MSG_DEBUG( "Applying Jet Selection... ");
 
   // retrieve event
@@ -177,7 +201,7 @@ EL::StatusCode TruthSelector :: execute ()
   if(msgLvl(MSG::VERBOSE)) m_store->print();
 
   if ( !pass ) {
-    wk()->skipEvent();
+    rejectEvent();
   }
 
   return EL::StatusCode::SUCCESS;
@@ -201,10 +225,13 @@ bool TruthSelector :: executeSelection ( const xAOD::TruthParticleContainer* inT
 
   static SG::AuxElement::Decorator< char > passSelDecor( m_decor );
 
+  const int nToEvaluate = m_nToProcess > 0 ? std::min( m_nToProcess, static_cast<int>(inTruthParts->size()) ) : static_cast<int>(inTruthParts->size());
+  bool countRejected(false);
+
   for ( auto truth_itr : *inTruthParts ) { // duplicated of basic loop
 
     // if only looking at a subset of jets make sure all are decorated
-    if ( m_nToProcess > 0 && nObj >= m_nToProcess ) {
+    if ( (m_nToProcess > 0 && nObj >= m_nToProcess) || countRejected ) {
       if ( m_decorateSelectedObjects ) {
         passSelDecor( *truth_itr ) = -1;
       } else {
@@ -225,6 +252,11 @@ bool TruthSelector :: executeSelection ( const xAOD::TruthParticleContainer* inT
         selectedTruthParts->push_back( truth_itr );
       }
     }
+
+    // once the number of selected particles rejects the event there is no need to look further
+    if ( m_stopWhenRejected && HelperFunctions::countRejects( nPass, nToEvaluate - nObj, m_pass_min, m_pass_max ) ) {
+      countRejected = true;
+    }
   }
 
   if ( count ) {
@@ -256,6 +288,8 @@ bool TruthSelector :: executeSelection ( const xAOD::TruthParticleContainer* inT
 
 EL::StatusCode TruthSelector :: postExecute ()
 {
+  auto timer = timePostExecute();
+  if ( eventRejected() ) return EL::StatusCode::SUCCESS;
   ANA_MSG_DEBUG( "Calling postExecute");
   return EL::StatusCode::SUCCESS;
 }
@@ -327,30 +361,21 @@ int TruthSelector :: PassCuts( const xAOD::TruthParticle* truthPart ) {
   }
 
   // selections for particles from MCTruthClassifier
+  static SG::AuxElement::ConstAccessor<unsigned int> classifierParticleType("classifierParticleType");
+  static SG::AuxElement::ConstAccessor<unsigned int> classifierParticleOrigin("classifierParticleOrigin");
 
   // type
-  if ( !m_typeOptions.empty() ) { // check w.r.t. multiple possible type values
-    if ( m_type != 1000 ) { ANA_MSG_WARNING( "single and multiple type conditions were selected, only the former will be used" );
+  if ( !m_typeVec.empty() ) { // check w.r.t. multiple possible type values
+    if( classifierParticleType.isAvailable( *truthPart ) ){
+      unsigned int type = classifierParticleType( *truthPart );
+      if ( std::find(m_typeVec.begin(), m_typeVec.end(), type) == m_typeVec.end() ) { return 0; }
     } else {
-      std::string token;
-      std::vector<unsigned int> typeVec;
-      std::istringstream ss(m_typeOptions);
-      while ( std::getline(ss, token, '|') ) typeVec.push_back(std::stoi(token));
-      bool found = false;
-      if( truthPart->isAvailable<unsigned int>("classifierParticleType") ){
-        unsigned int type = truthPart->auxdata<unsigned int>("classifierParticleType");
-        for (unsigned int i=0;i<typeVec.size();++i){
-          if (type == typeVec.at(i)) found = true;
-        }
-        if (!found) { return 0; }
-      } else {
-        ANA_MSG_WARNING( "classifierParticleType is not available" );
-      }
+      ANA_MSG_WARNING( "classifierParticleType is not available" );
     }
   }
   if ( m_type != 1000 ) { // single type value
-    if( truthPart->isAvailable<unsigned int>("classifierParticleType") ){
-      unsigned int type = truthPart->auxdata<unsigned int>("classifierParticleType");
+    if( classifierParticleType.isAvailable( *truthPart ) ){
+      unsigned int type = classifierParticleType( *truthPart );
       if ( type != m_type ) { return 0; }
     } else {
       ANA_MSG_WARNING( "classifierParticleType is not available" );
@@ -358,28 +383,17 @@ int TruthSelector :: PassCuts( const xAOD::TruthParticle* truthPart ) {
   }
 
   // origin
-  if ( !m_originOptions.empty() ) { // check w.r.t. multiple possible origin values
-    if ( m_origin != 1000 ) { ANA_MSG_WARNING( "single and multiple origin conditions were selected, only the former will be used" );
+  if ( !m_originVec.empty() ) { // check w.r.t. multiple possible origin values
+    if( classifierParticleOrigin.isAvailable( *truthPart ) ){
+      unsigned int origin = classifierParticleOrigin( *truthPart );
+      if ( std::find(m_originVec.begin(), m_originVec.end(), origin) == m_originVec.end() ) { return 0; }
     } else {
-      std::string token;
-      std::vector<unsigned int> originVec;
-      std::istringstream ss(m_originOptions);
-      while ( std::getline(ss, token, '|') ) originVec.push_back(std::stoi(token));
-      bool found = false;
-      if( truthPart->isAvailable<unsigned int>("classifierParticleOrigin") ){
-        unsigned int origin = truthPart->auxdata<unsigned int>("classifierParticleOrigin");
-        for (unsigned int i=0;i<originVec.size();++i){
-          if (origin == originVec.at(i)) found = true;
-        }
-        if (!found) { return 0; }
-      } else {
-        ANA_MSG_WARNING( "classifierParticleOrigin is not available" );
-      }
+      ANA_MSG_WARNING( "classifierParticleOrigin is not available" );
     }
   }
   if ( m_origin != 1000 ) { // single origin value
-    if( truthPart->isAvailable<unsigned int>("classifierParticleOrigin") ){
-      unsigned int origin = truthPart->auxdata<unsigned int>("classifierParticleOrigin");
+    if( classifierParticleOrigin.isAvailable( *truthPart ) ){
+      unsigned int origin = classifierParticleOrigin( *truthPart );
       if ( origin != m_origin ) { return 0; }
     } else {
       ANA_MSG_WARNING( "classifierParticleOrigin is not available" );
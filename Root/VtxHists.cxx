@@ -1,7 +1,9 @@
 #include "xAODAnaHelpers/VtxHists.h"
 #include <xAODTracking/TrackParticle.h>
+#include "xAODAnaHelpers/HelperFunctions.h"
 
 #include <math.h>
+#include <algorithm>
 
 ANA_MSG_SOURCE(msgVtxHists, "VtxHists")
 
@@ -43,13 +45,18 @@ StatusCode VtxHists::initialize() {
   //  Iso Trk details
   //
   m_fillIsoTrkDetails = false;
+  m_fillIsoDZ0 = false;
   if(m_detailStr.find("IsoTrkDetails") != std::string::npos ){
     m_fillIsoTrkDetails = true;
 
     h_trkIsoAll       = book(m_name, "ptCone20All",         "ptCone20All",    100,   -0.5,    9.5);
     h_trkIso          = book(m_name, "ptCone20",            "ptCone20",       100,   -0.5,    9.5);
 
-    h_dZ0Before        = book(m_name, "dZ0Before",            "dZ0Before",       100,   -0.1,    100);
+    // distance in z0 of all track pairs, which costs a loop over all tracks for every track
+    if(m_detailStr.find("IsoDZ0") != std::string::npos ){
+      m_fillIsoDZ0 = true;
+      h_dZ0Before        = book(m_name, "dZ0Before",            "dZ0Before",       100,   -0.1,    100);
+    }
 
     h_nIsoTrks       = book(m_name, "nIsoTrks",         "nIsoTrks",    100,   -0.5,    99.5);
     h_nIsoTrks_l     = book(m_name, "nIsoTrks_l",       "nIsoTrks",    100,   -0.5,   499.5);
@@ -119,30 +126,67 @@ StatusCode VtxHists::initialize() {
 }
 
 StatusCode VtxHists::execute( const xAOD::VertexContainer* vtxs, float eventWeight ) {
-  using namespace msgVtxHists;
-  for(auto vtx_itr :  *vtxs ) {
-    ANA_CHECK( this->execute( vtx_itr, eventWeight ));
+  m_summary.fill(nullptr, nullptr, vtxs);
+  for(unsigned int iVtx = 0; iVtx < vtxs->size(); ++iVtx) {
+    fillVertex( vtxs->at(iVtx), m_summary, iVtx, eventWeight );
   }
 
   return StatusCode::SUCCESS;
 }
 
 StatusCode VtxHists::execute( const xAOD::VertexContainer* vtxs, const xAOD::TrackParticleContainer* trks, float eventWeight ) {
+  m_summary.fill(trks, nullptr, vtxs);
+  return this->execute( vtxs, m_summary, eventWeight );
+}
+
+StatusCode VtxHists::execute( const xAOD::VertexContainer* vtxs, const xAH::TrackSummary& summary, float eventWeight ) {
   using namespace msgVtxHists;
-  for(auto vtx_itr :  *vtxs ) {
-    ANA_CHECK( this->execute( vtx_itr, trks, eventWeight ));
+  if(summary.nVertices() != vtxs->size()){
+    ANA_MSG_ERROR( "The track summary has " << summary.nVertices() << " vertices, the container " << vtxs->size() << ", fill it with the same vertex container");
+    return StatusCode::FAILURE;
+  }
+
+  for(unsigned int iVtx = 0; iVtx < vtxs->size(); ++iVtx) {
+    fillVertex( vtxs->at(iVtx), summary, iVtx, eventWeight );
+    fillVertexIso( summary, iVtx, eventWeight );
   }
 
   return StatusCode::SUCCESS;
 }
 
 StatusCode VtxHists::execute( const xAOD::Vertex* vtx, const xAOD::TrackParticleContainer* trks, float eventWeight ) {
-  using namespace msgVtxHists;
-  ANA_CHECK( this->execute( vtx, eventWeight));
+  m_summary.fill(trks, nullptr);
+  const unsigned int iVtx = m_summary.addVertex(vtx);
+  fillVertex( vtx, m_summary, iVtx, eventWeight );
+  fillVertexIso( m_summary, iVtx, eventWeight );
+
+  return StatusCode::SUCCESS;
+}
+
+StatusCode VtxHists::execute( const xAOD::Vertex* vtx, float eventWeight ) {
+  m_summary.fill(nullptr, nullptr);
+  fillVertex( vtx, m_summary, m_summary.addVertex(vtx), eventWeight );
+
+  return StatusCode::SUCCESS;
+}
+
+void VtxHists::fillLeading( std::vector<float>& pts, const std::vector<TH1F*>& hists, const std::vector<TH1F*>& hists_l, float eventWeight ) {
+  // only the leading ones are needed in order
+  const std::size_t nLeading = std::min(pts.size(), hists.size());
+  std::partial_sort(pts.begin(), pts.begin() + nLeading, pts.end(), std::greater<float>());
+
+  for(uint iLeadTrks = 0; iLeadTrks < hists.size(); ++iLeadTrks){
+    float this_pt = (nLeading > iLeadTrks) ? pts[iLeadTrks] : 0;
+    hists.at(iLeadTrks)      -> Fill( this_pt,       eventWeight );
+    hists_l.at(iLeadTrks)    -> Fill( this_pt,       eventWeight );
+  }
+}
+
+void VtxHists::fillVertexIso( const xAH::TrackSummary& summary, unsigned int iVtx, float eventWeight ) {
 
   if(m_fillIsoTrkDetails){
 
-    unsigned int nTrksAll = vtx->nTrackParticles();
+    const std::vector<unsigned int>& vtxTracks = summary.vertexTracks(iVtx);
 
     uint nIsoTracks1GeV  = 0;
     uint nIsoTracks2GeV  = 0;
@@ -153,22 +197,27 @@ StatusCode VtxHists::execute( const xAOD::Vertex* vtx, const xAOD::TrackParticle
     uint nIsoTracks25GeV = 0;
     uint nIsoTracks30GeV = 0;
 
-    std::vector<float> pt_iso_vec;
+    m_pts.clear();
 
     float pt_miss_iso_x = 0;
     float pt_miss_iso_y = 0;
 
-    for(uint iTrkItr = 0; iTrkItr< nTrksAll; ++iTrkItr){
-      const xAOD::TrackParticle* thisTrk = vtx->trackParticle(iTrkItr);
-      float trkPt = thisTrk->pt()/1e3;
+    for(unsigned int iTrk : vtxTracks){
+      float trkPt = summary.kinematics.pt[iTrk]/1e3;
 
 
       if(trkPt < 1) continue;
 
-      float trk_pt_cone20 = getIso(thisTrk, trks);
+      // distance in z0 to all the tracks, before any cut
+      if(m_fillIsoDZ0){
+        const float inZ0 = summary.tracks[iTrk]->z0();
+        for(unsigned int jTrk = 0; jTrk < summary.nContainer(); ++jTrk) h_dZ0Before->Fill(fabs(summary.tracks[jTrk]->z0() - inZ0), 1.0);
+      }
+
+      float trk_pt_cone20 = summary.isolation(iTrk);
 
-      pt_miss_iso_x += thisTrk->p4().Px()/1e3;
-      pt_miss_iso_y += thisTrk->p4().Py()/1e3;
+      pt_miss_iso_x += summary.kinematics.px[iTrk]/1e3;
+      pt_miss_iso_y += summary.kinematics.py[iTrk]/1e3;
 
       h_trkIsoAll      -> Fill( trk_pt_cone20,       eventWeight );
 
@@ -179,7 +228,7 @@ StatusCode VtxHists::execute( const xAOD::Vertex* vtx, const xAOD::TrackParticle
       h_IsoTrk_Pt      -> Fill( trkPt,       eventWeight );
       h_IsoTrk_Pt_l    -> Fill( trkPt,       eventWeight );
 
-      pt_iso_vec.push_back(trkPt);
+      m_pts.push_back(trkPt);
 
       if(trkPt >  1) ++nIsoTracks1GeV;
       if(trkPt >  2) ++nIsoTracks2GeV;
@@ -192,17 +241,8 @@ StatusCode VtxHists::execute( const xAOD::Vertex* vtx, const xAOD::TrackParticle
 
     }
 
-
-    // Sort track pts
-    //std::sort(numbers.begin(), numbers.end(), std::greater<int>());
-    std::sort(pt_iso_vec.begin(), pt_iso_vec.end(), std::greater<float>());
-
     // Leading track Pts
-    for(uint iLeadTrks = 0; iLeadTrks < m_nLeadIsoTrackPts; ++iLeadTrks){
-      float this_pt = (pt_iso_vec.size() > iLeadTrks) ? pt_iso_vec.at(iLeadTrks) : 0;
-      h_IsoTrk_max_Pt.at(iLeadTrks)      -> Fill( this_pt,       eventWeight );
-      h_IsoTrk_max_Pt_l.at(iLeadTrks)    -> Fill( this_pt,       eventWeight );
-    }
+    fillLeading( m_pts, h_IsoTrk_max_Pt, h_IsoTrk_max_Pt_l, eventWeight );
 
     h_nIsoTrks1GeV       -> Fill( nIsoTracks1GeV,        eventWeight );
     h_nIsoTrks2GeV       -> Fill( nIsoTracks2GeV,        eventWeight );
@@ -224,11 +264,9 @@ StatusCode VtxHists::execute( const xAOD::Vertex* vtx, const xAOD::TrackParticle
     h_pt_miss_iso_l    -> Fill(pt_miss_iso ,       eventWeight );
 
   }
-
-  return StatusCode::SUCCESS;
 }
 
-StatusCode VtxHists::execute( const xAOD::Vertex* vtx, float eventWeight ) {
+void VtxHists::fillVertex( const xAOD::Vertex* vtx, const xAH::TrackSummary& summary, unsigned int iVtx, float eventWeight ) {
 
   //basic
   h_type       -> Fill( vtx->vertexType(),            eventWeight );
@@ -248,24 +286,21 @@ StatusCode VtxHists::execute( const xAOD::Vertex* vtx, float eventWeight ) {
     uint nTracks25GeV = 0;
     uint nTracks30GeV = 0;
 
-    std::vector<float> pt_vec;
+    m_pts.clear();
 
     float pt_miss_x = 0;
     float pt_miss_y = 0;
 
-    for(uint iTrkItr = 0; iTrkItr< nTrks; ++iTrkItr){
-      const xAOD::TrackParticle* thisTrk = vtx->trackParticle(iTrkItr);
-      float trkPt = thisTrk->pt()/1e3;
+    for(unsigned int iTrk : summary.vertexTracks(iVtx)){
+      float trkPt = summary.kinematics.pt[iTrk]/1e3;
 
       h_trk_Pt      -> Fill( trkPt,       eventWeight );
       h_trk_Pt_l    -> Fill( trkPt,       eventWeight );
 
-      if(!m_fillTrkDetails) continue;
-
-      if(trkPt > 1) pt_vec.push_back(trkPt);
+      if(trkPt > 1) m_pts.push_back(trkPt);
 
-      pt_miss_x += thisTrk->p4().Px()/1e3;
-      pt_miss_y += thisTrk->p4().Py()/1e3;
+      pt_miss_x += summary.kinematics.px[iTrk]/1e3;
+      pt_miss_y += summary.kinematics.py[iTrk]/1e3;
 
       if(trkPt >  1) ++nTracks1GeV;
       if(trkPt >  2) ++nTracks2GeV;
@@ -280,16 +315,8 @@ StatusCode VtxHists::execute( const xAOD::Vertex* vtx, float eventWeight ) {
 
     if(m_fillTrkPtDetails){
 
-      // Sort track pts
-      //std::sort(numbers.begin(), numbers.end(), std::greater<int>());
-      std::sort(pt_vec.begin(), pt_vec.end(), std::greater<float>());
-
       // Leading track Pts
-      for(uint iLeadTrks = 0; iLeadTrks < m_nLeadTrackPts; ++iLeadTrks){
-	float this_pt = (pt_vec.size() > iLeadTrks) ? pt_vec.at(iLeadTrks) : 0;
-	h_trk_max_Pt.at(iLeadTrks)      -> Fill( this_pt,       eventWeight );
-	h_trk_max_Pt_l.at(iLeadTrks)    -> Fill( this_pt,       eventWeight );
-      }
+      fillLeading( m_pts, h_trk_max_Pt, h_trk_max_Pt_l, eventWeight );
 
       h_nTrks1GeV       -> Fill( nTracks1GeV,        eventWeight );
       h_nTrks2GeV       -> Fill( nTracks2GeV,        eventWeight );
@@ -312,26 +339,4 @@ StatusCode VtxHists::execute( const xAOD::Vertex* vtx, float eventWeight ) {
     }
 
   }
-
-  return StatusCode::SUCCESS;
-
-}
-
-float VtxHists::getIso( const xAOD::TrackParticle *inTrack,            const xAOD::TrackParticleContainer* trks, float z0_cut , float cone_size)
-{
-  float iso = 0;
-
-  for(auto trk_itr :  *trks ) {
-
-    float dZ0 = abs(trk_itr->z0() - inTrack->z0());
-    h_dZ0Before->Fill(dZ0, 1.0);
-    if(dZ0 > z0_cut) continue;
-
-    float dR = trk_itr->p4().DeltaR(inTrack->p4());
-    if(dR > cone_size) continue;
-    if(dR == 0) continue;
-    iso += trk_itr->pt()/1e3;
-  }
-
-  return iso;
 }
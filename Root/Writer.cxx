@@ -7,6 +7,10 @@
 #include "xAODCore/ShallowCopy.h"
 #include "xAODJet/JetContainer.h"
 #include "xAODJet/JetAuxContainer.h"
+#include "xAODEgamma/ElectronContainer.h"
+#include "xAODEgamma/ElectronAuxContainer.h"
+#include "xAODMuon/MuonContainer.h"
+#include "xAODMuon/MuonAuxContainer.h"
 
 #include <xAODAnaHelpers/HelperFunctions.h>
 
@@ -100,11 +104,18 @@ EL::StatusCode Writer :: initialize ()
   TFile * file = wk()->getOutputFile (m_outputLabel.Data());
   ANA_CHECK( m_event->writeTo(file));
 
-  //FIXME add this as well
-// Set which variables not to write out:
-// event->setAuxItemList( "AntiKt4LCTopoJetsAux.", "-NumTrkPt1000.-NumTrkPt500" );
-// // Set which variable to do write out:
-// event->setAuxItemList( "GoodJetsAux.", "JetGhostArea.TrackCount" );
+  // only write the listed aux variables of these containers
+  for( const TString& entry : HelperFunctions::SplitString( m_auxItemListsStr, ',' ) ) {
+    const Ssiz_t pos = entry.First('|');
+    if ( pos == kNPOS ) {
+      ANA_MSG_ERROR( "m_auxItemListsStr entry " << entry.Data() << " is not of the form container|variables");
+      return EL::StatusCode::FAILURE;
+    }
+    const TString contName  = entry(0, pos);
+    const TString itemList  = entry(pos+1, entry.Length());
+    ANA_MSG_INFO( "Writing only " << itemList.Data() << " of " << contName.Data() );
+    m_event->setAuxItemList( (contName + "Aux.").Data(), itemList.Data() );
+  }
 
 
   return EL::StatusCode::SUCCESS;
@@ -114,74 +125,77 @@ EL::StatusCode Writer :: initialize ()
 
 EL::StatusCode Writer :: execute ()
 {
+  auto event = beginEvent();
+  auto timer = timeExecute();
+  if ( eventRejected() ) return EL::StatusCode::SUCCESS;
   // Here you do everything that needs to be done on every single
   // events, e.g. read input variables, apply cuts, and fill
   // histograms and trees.  This is where most of your actual analysis
   // code will go.
   m_numEvent++;
 
+  for( const auto& contName : m_jetContainerNames )      ANA_CHECK( (writeContainer<xAOD::JetContainer,      xAOD::JetAuxContainer>     (contName)) );
+  for( const auto& contName : m_electronContainerNames ) ANA_CHECK( (writeContainer<xAOD::ElectronContainer, xAOD::ElectronAuxContainer>(contName)) );
+  for( const auto& contName : m_muonContainerNames )     ANA_CHECK( (writeContainer<xAOD::MuonContainer,     xAOD::MuonAuxContainer>    (contName)) );
+
+  m_event->fill();
+
+  return EL::StatusCode::SUCCESS;
+}
+
+
+
+template <typename T, typename TAux>
+EL::StatusCode Writer :: writeContainer (const TString& contName)
+{
   // try to find the containers in m_event - if there then copy entire container directly
   // if not found in m_event, look in m_store - user created - write aux store as well
-  for( auto contName : m_jetContainerNames ) {
-
-    const xAOD::JetContainer* inJetsConst(nullptr);
-    // look in event
-    if ( HelperFunctions::retrieve(inJetsConst, contName.Data(), m_event, 0, msg()).isSuccess() ) {
-      // without modifying the contents of it:
-      ANA_MSG_INFO( " Write a collection " << contName.Data() << inJetsConst->size() );
-      m_event->copy( contName.Data() );
-      ANA_MSG_INFO( " Wrote a collection " << contName.Data());
-      continue;
+  // (in both cases only the variables of m_auxItemListsStr are written, if it lists the container)
+  const T* inContConst(nullptr);
+  // look in event
+  if ( HelperFunctions::retrieve(inContConst, contName.Data(), m_event, 0, msg()).isSuccess() ) {
+    // without modifying the contents of it:
+    ANA_MSG_DEBUG( " Write a collection " << contName.Data() << " " << inContConst->size() );
+    ANA_CHECK( m_event->copy( contName.Data() ) );
+    return EL::StatusCode::SUCCESS;
+  }
+
+  // look in store
+  T* inCont(nullptr);
+  if ( HelperFunctions::retrieve(inCont, contName.Data(), 0, m_store, msg()).isSuccess() ){
+    // Record the objects into the output xAOD:
+    ANA_MSG_DEBUG( " Write a collection " << contName.Data() << " " << inCont->size() );
+    if( ! m_event->record( inCont, contName.Data() ) ) {
+      ANA_MSG_ERROR(m_name << ": Could not record " << contName.Data());
+      return EL::StatusCode::FAILURE;
     }
 
-    // look in store
-    xAOD::JetContainer* inJets(nullptr);
-    if ( HelperFunctions::retrieve(inJets, contName.Data(), 0, m_store, msg()).isSuccess() ){
-//      // FIXME add something like this
-//      jets_shallowCopy.second->setShallowIO( false ); // true = shallow copy, false = deep copy
-//      // if true should have something like this line somewhere:
-
-      // Record the objects into the output xAOD:
-      ANA_MSG_INFO( " Write a collection " << contName.Data() << inJets->size() );
-      if( ! m_event->record( inJets, contName.Data() ) ) {
-        ANA_MSG_ERROR(m_name << ": Could not record " << contName.Data());
-        return EL::StatusCode::FAILURE;
-      }
-      ANA_MSG_INFO( " Wrote a collection " << contName.Data());
-
-      // get pointer to associated aux container
-      xAOD::JetAuxContainer* inJetsAux = 0;
-      ANA_MSG_INFO( " Wrote a aux store " << contName.Data());
-      TString auxName( contName + "Aux." );
-      if ( HelperFunctions::retrieve(inJetsAux, auxName.Data(), 0, m_store, msg()).isSuccess() ){
-        ANA_MSG_ERROR(m_name << ": Could not get Aux data for " << contName.Data());
-        return EL::StatusCode::FAILURE;
-      }
-      ANA_MSG_INFO( " Wrote a aux store " << contName.Data());
-
-      if( ! m_event->record( inJetsAux, auxName.Data() ) ) {
-        ANA_MSG_ERROR( m_name << ": Could not record aux store for " << contName.Data());
-        return EL::StatusCode::FAILURE;
-      }
+    // get pointer to associated aux container
+    TAux* inContAux = 0;
+    TString auxName( contName + "Aux." );
+    if ( !HelperFunctions::retrieve(inContAux, auxName.Data(), 0, m_store, msg()).isSuccess() ){
+      ANA_MSG_ERROR(m_name << ": Could not get Aux data for " << contName.Data());
+      return EL::StatusCode::FAILURE;
     }
-    // could not find the container - problems
-    else {
-      ANA_MSG_ERROR( m_name << ": Could not find " << contName.Data());
+
+    if( ! m_event->record( inContAux, auxName.Data() ) ) {
+      ANA_MSG_ERROR( m_name << ": Could not record aux store for " << contName.Data());
       return EL::StatusCode::FAILURE;
     }
+    return EL::StatusCode::SUCCESS;
   }
 
-  // add similar loop for electron and muons
-
-  m_event->fill();
-
-  return EL::StatusCode::SUCCESS;
+  // could not find the container - problems
+  ANA_MSG_ERROR( m_name << ": Could not find " << contName.Data());
+  return EL::StatusCode::FAILURE;
 }
 
 
 
 EL::StatusCode Writer :: postExecute ()
 {
+  auto timer = timePostExecute();
+  if ( eventRejected() ) return EL::StatusCode::SUCCESS;
   // Here you do everything that needs to be done after the main event
   // processing.  This is typically very rare, particularly in user
   // code.  It is mainly used in implementing the NTupleSvc.
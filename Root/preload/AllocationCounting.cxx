@@ -0,0 +1,54 @@
+// Counting replacement of the global operator new and operator delete, built as its own library
+// (libxAODAnaHelpersAllocationCounting.so) that is only ever preloaded, see xAH::AllocationProfiler.
+// xAODAnaHelpersLib finds the counters through xAH_allocationCounters() with dlsym, it does not link to it.
+
+#include <xAODAnaHelpers/AllocationProfiler.h>
+
+#include <cstdlib>
+#include <new>
+
+namespace {
+  // constant-initialised, so usable by allocations made during the static initialisation of other libraries
+  xAH::AllocationProfiler::SharedCounters s_counters;
+
+  void* countedNew(std::size_t bytes)
+  {
+    if(s_counters.enabled.load(std::memory_order_relaxed)){
+      s_counters.allocations.fetch_add(1, std::memory_order_relaxed);
+      s_counters.bytes.fetch_add(bytes, std::memory_order_relaxed);
+    }
+    if(bytes == 0) bytes = 1;
+    for(;;){
+      if(void* p = std::malloc(bytes)) return p;
+      std::new_handler handler = std::get_new_handler();
+      if(!handler) throw std::bad_alloc();
+      handler();
+    }
+  }
+
+  void countedDelete(void* p) noexcept
+  {
+    if(!p) return;
+    if(s_counters.enabled.load(std::memory_order_relaxed)) s_counters.deallocations.fetch_add(1, std::memory_order_relaxed);
+    std::free(p);
+  }
+}
+
+extern "C" xAH::AllocationProfiler::SharedCounters* xAH_allocationCounters() { return &s_counters; }
+
+void* operator new(std::size_t bytes) { return countedNew(bytes); }
+void* operator new[](std::size_t bytes) { return countedNew(bytes); }
+void* operator new(std::size_t bytes, const std::nothrow_t&) noexcept
+{
+  try { return countedNew(bytes); } catch(...) { return nullptr; }
+}
+void* operator new[](std::size_t bytes, const std::nothrow_t&) noexcept
+{
+  try { return countedNew(bytes); } catch(...) { return nullptr; }
+}
+void operator delete(void* p) noexcept { countedDelete(p); }
+void operator delete[](void* p) noexcept { countedDelete(p); }
+void operator delete(void* p, const std::nothrow_t&) noexcept { countedDelete(p); }
+void operator delete[](void* p, const std::nothrow_t&) noexcept { countedDelete(p); }
+void operator delete(void* p, std::size_t) noexcept { countedDelete(p); }
+void operator delete[](void* p, std::size_t) noexcept { countedDelete(p); }
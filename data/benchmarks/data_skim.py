@@ -0,0 +1,22 @@
+# Reference configuration of xAH_benchmarkSuite.py: a data skim, the event selection writing a small ntuple
+from xAODAnaHelpers import Config
+c = Config()
+
+c.algorithm("BasicEventSelection", {"m_name"                  : "skim_BasicEventSelection",
+                                    "m_applyGRLCut"           : False,
+                                    "m_doPUreweighting"       : False,
+                                    "m_vertexContainerName"   : "PrimaryVertices",
+                                    "m_PVNTrack"              : 2,
+                                    "m_applyPrimaryVertexCut" : True,
+                                    "m_applyEventCleaningCut" : True,
+                                    "m_applyCoreFlagsCut"     : True,
+                                    "m_useMetaData"           : False})
+
+c.algorithm("TreeAlgo",            {"m_name"                  : "skim_TreeAlgo",
+                                    "m_evtDetailStr"          : "pileup",
+                                    "m_jetContainerName"      : "AntiKt4EMPFlowJets",
+                                    "m_jetDetailStr"          : "kinematic clean energy",
+                                    "m_muContainerName"       : "Muons",
+                                    "m_muDetailStr"           : "kinematic quality",
+                                    "m_elContainerName"       : "Electrons",
+                                    "m_elDetailStr"           : "kinematic"})
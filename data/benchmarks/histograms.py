@@ -0,0 +1,27 @@
+# Reference configuration of xAH_benchmarkSuite.py: a histogramming job, filling the *HistsAlgo of the
+# jets, muons, electrons and MET without writing a tree
+from xAODAnaHelpers import Config
+c = Config()
+
+c.algorithm("BasicEventSelection", {"m_name"                  : "hists_BasicEventSelection",
+                                    "m_applyGRLCut"           : False,
+                                    "m_doPUreweighting"       : False,
+                                    "m_vertexContainerName"   : "PrimaryVertices",
+                                    "m_PVNTrack"              : 2,
+                                    "m_useMetaData"           : False})
+
+c.algorithm("JetHistsAlgo",        {"m_name"                  : "hists_Jets",
+                                    "m_inContainerName"       : "AntiKt4EMPFlowJets",
+                                    "m_detailStr"             : "kinematic clean energy layer trackPV"})
+
+c.algorithm("MuonHistsAlgo",       {"m_name"                  : "hists_Muons",
+                                    "m_inContainerName"       : "Muons",
+                                    "m_detailStr"             : "kinematic quality isolation"})
+
+c.algorithm("ElectronHistsAlgo",   {"m_name"                  : "hists_Electrons",
+                                    "m_inContainerName"       : "Electrons",
+                                    "m_detailStr"             : "kinematic"})
+
+c.algorithm("MetHistsAlgo",        {"m_name"                  : "hists_MET",
+                                    "m_inContainerName"       : "MET_Reference_AntiKt4EMPFlow",
+                                    "m_detailStr"             : "all"})
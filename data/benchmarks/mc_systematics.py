@@ -0,0 +1,111 @@
+# Reference configuration of xAH_benchmarkSuite.py: an MC chain calibrating and selecting jets and leptons
+# with all their systematics, then building the MET and writing one tree per systematic
+from xAODAnaHelpers import Config
+c = Config()
+
+c.algorithm("BasicEventSelection", {"m_name"                  : "syst_BasicEventSelection",
+                                    "m_applyGRLCut"           : False,
+                                    "m_doPUreweighting"       : False,
+                                    "m_vertexContainerName"   : "PrimaryVertices",
+                                    "m_PVNTrack"              : 2,
+                                    "m_useMetaData"           : False})
+
+c.algorithm("JetCalibrator",       {"m_name"                  : "syst_JetCalibrator",
+                                    "m_inContainerName"       : "AntiKt4EMPFlowJets",
+                                    "m_outContainerName"      : "CalibJets",
+                                    "m_jetAlgo"               : "AntiKt4EMPFlow",
+                                    "m_outputAlgo"            : "CalibJets_Syst",
+                                    "m_calibSequence"         : "JetArea_Residual_EtaJES_GSC_Smear",
+                                    "m_uncertConfig"          : "rel21/Summer2019/R4_SR_Scenario1_SimpleJER.config",
+                                    "m_systName"              : "All",
+                                    "m_systVal"               : 1,
+                                    "m_findSameAsNominalSysts": True})
+
+c.algorithm("JetSelector",         {"m_name"                  : "syst_JetSelector",
+                                    "m_inContainerName"       : "CalibJets",
+                                    "m_outContainerName"      : "SelJets",
+                                    "m_inputAlgo"             : "CalibJets_Syst",
+                                    "m_outputAlgo"            : "SelJets_Syst",
+                                    "m_decorateSelectedObjects": True,
+                                    "m_createSelectedContainer": True,
+                                    "m_aliasSameAsNominalSysts": True,
+                                    "m_pT_min"                : 20e3,
+                                    "m_eta_max"               : 2.8})
+
+c.algorithm("MuonCalibrator",      {"m_name"                  : "syst_MuonCalibrator",
+                                    "m_inContainerName"       : "Muons",
+                                    "m_outContainerName"      : "CalibMuons",
+                                    "m_outputAlgoSystNames"   : "CalibMuons_Syst",
+                                    "m_systName"              : "All",
+                                    "m_systVal"               : 1,
+                                    "m_findSameAsNominalSysts": True})
+
+c.algorithm("MuonSelector",        {"m_name"                  : "syst_MuonSelector",
+                                    "m_inContainerName"       : "CalibMuons",
+                                    "m_outContainerName"      : "SelMuons",
+                                    "m_inputAlgoSystNames"    : "CalibMuons_Syst",
+                                    "m_outputAlgoSystNames"   : "SelMuons_Syst",
+                                    "m_createSelectedContainer": True,
+                                    "m_pT_min"                : 10e3,
+                                    "m_eta_max"               : 2.5,
+                                    "m_muonQualityStr"        : "Medium",
+                                    "m_MinIsoWPCut"           : "FCLoose_FixedRad"})
+
+c.algorithm("ElectronCalibrator",  {"m_name"                  : "syst_ElectronCalibrator",
+                                    "m_inContainerName"       : "Electrons",
+                                    "m_outContainerName"      : "CalibElectrons",
+                                    "m_outputAlgoSystNames"   : "CalibElectrons_Syst",
+                                    "m_esModel"               : "es2018_R21_v0",
+                                    "m_decorrelationModel"    : "1NP_v1",
+                                    "m_systName"              : "All",
+                                    "m_systVal"               : 1})
+
+c.algorithm("ElectronSelector",    {"m_name"                  : "syst_ElectronSelector",
+                                    "m_inContainerName"       : "CalibElectrons",
+                                    "m_outContainerName"      : "SelElectrons",
+                                    "m_inputAlgoSystNames"    : "CalibElectrons_Syst",
+                                    "m_outputAlgoSystNames"   : "SelElectrons_Syst",
+                                    "m_createSelectedContainer": True,
+                                    "m_pT_min"                : 10e3,
+                                    "m_eta_max"               : 2.47,
+                                    "m_doLHPIDcut"            : True,
+                                    "m_LHOperatingPoint"      : "Medium",
+                                    "m_MinIsoWPCut"           : "FCLoose"})
+
+c.algorithm("OverlapRemover",      {"m_name"                  : "syst_OverlapRemover",
+                                    "m_inContainerName_Jets"  : "SelJets",
+                                    "m_outContainerName_Jets" : "ORJets",
+                                    "m_inputAlgoJets"         : "SelJets_Syst",
+                                    "m_inContainerName_Muons" : "SelMuons",
+                                    "m_outContainerName_Muons": "ORMuons",
+                                    "m_inputAlgoMuons"        : "SelMuons_Syst",
+                                    "m_inContainerName_Electrons" : "SelElectrons",
+                                    "m_outContainerName_Electrons": "ORElectrons",
+                                    "m_inputAlgoElectrons"    : "SelElectrons_Syst",
+                                    "m_outputAlgoSystNames"   : "OR_Syst",
+                                    "m_aliasSameAsNominalSysts": True})
+
+c.algorithm("METConstructor",      {"m_name"                  : "syst_METConstructor",
+                                    "m_referenceMETContainer" : "MET_Reference_AntiKt4EMPFlow",
+                                    "m_mapName"               : "METAssoc_AntiKt4EMPFlow",
+                                    "m_coreName"              : "MET_Core_AntiKt4EMPFlow",
+                                    "m_outputContainer"       : "RefFinalMET",
+                                    "m_inputJets"             : "ORJets",
+                                    "m_inputMuons"            : "ORMuons",
+                                    "m_inputElectrons"        : "ORElectrons",
+                                    "m_jetSystematics"        : "OR_Syst",
+                                    "m_outputAlgoSystNames"   : "MET_Syst",
+                                    "m_systName"              : "All"})
+
+c.algorithm("TreeAlgo",            {"m_name"                  : "syst_TreeAlgo",
+                                    "m_evtDetailStr"          : "pileup",
+                                    "m_jetContainerName"      : "ORJets",
+                                    "m_jetDetailStr"          : "kinematic clean",
+                                    "m_jetSystsVec"           : "OR_Syst",
+                                    "m_muContainerName"       : "ORMuons",
+                                    "m_muDetailStr"           : "kinematic isolation",
+                                    "m_elContainerName"       : "ORElectrons",
+                                    "m_elDetailStr"           : "kinematic",
+                                    "m_METContainerName"      : "RefFinalMET",
+                                    "m_METDetailStr"          : "metClus",
+                                    "m_metSystsVec"           : "MET_Syst"})
@@ -0,0 +1,34 @@
+# Reference configuration of xAH_benchmarkSuite.py: a trigger study, with the HLT jets, the b-jet RoIs
+# and the trigger matching of the offline muons
+from xAODAnaHelpers import Config
+c = Config()
+
+c.algorithm("BasicEventSelection", {"m_name"                  : "trig_BasicEventSelection",
+                                    "m_applyGRLCut"           : False,
+                                    "m_doPUreweighting"       : False,
+                                    "m_vertexContainerName"   : "PrimaryVertices",
+                                    "m_PVNTrack"              : 2,
+                                    "m_useMetaData"           : False,
+                                    "m_triggerSelection"      : "HLT_j.*|HLT_mu.*",
+                                    "m_storeTrigDecisions"    : True,
+                                    "m_applyTriggerCut"       : False})
+
+c.algorithm("HLTJetGetter",        {"m_name"                  : "trig_HLTJetGetter",
+                                    "m_triggerList"           : "HLT_j.*",
+                                    "m_inContainerName"       : "HLT_xAOD__JetContainer_a4tcemsubjesISFS",
+                                    "m_outContainerName"      : "HLTJets"})
+
+c.algorithm("HLTJetRoIBuilder",    {"m_name"                  : "trig_HLTJetRoIBuilder",
+                                    "m_trigItem"              : "HLT_j225_gsc300_bmv2c1070_split",
+                                    "m_outContainerName"      : "BJetRoIs"})
+
+c.algorithm("TrigMatcher",         {"m_name"                  : "trig_TrigMatcher",
+                                    "m_inContainerName"       : "Muons",
+                                    "m_trigChains"            : "HLT_mu26_ivarmedium,HLT_mu50"})
+
+c.algorithm("TreeAlgo",            {"m_name"                  : "trig_TreeAlgo",
+                                    "m_trigDetailStr"         : "basic passTriggers",
+                                    "m_trigJetContainerName"  : "HLTJets",
+                                    "m_trigJetDetailStr"      : "kinematic",
+                                    "m_muContainerName"       : "Muons",
+                                    "m_muDetailStr"           : "kinematic trigger"})
@@ -13,4 +13,4 @@ except:
 from .utils import vector
 
 __version__ = "1.0.0"
-__all__ = ["utils", "config"]
+__all__ = ["utils", "config", "columnar"]
@@ -115,6 +115,194 @@ standard = {
         "default": False,
         "help": "If enabled, will variable usage statistics.",
     },
+    "cacheSize": {
+        "dest": "cache_size",
+        "metavar": "<bytes>",
+        "type": float,
+        "default": 50*1024*1024,
+        "help": "Size of the TTreeCache of the input tree (EL::Job::optCacheSize), 0 to not use one.",
+    },
+    "cacheLearnEntries": {
+        "dest": "cache_learn_entries",
+        "metavar": "<n>",
+        "type": float,
+        "default": 50,
+        "help": "Number of entries during which the TTreeCache learns which branches are read (EL::Job::optCacheLearnEntries). Not used with --readBranches or --autoCache.",
+    },
+    "xAODPerfStats": {
+        "action": "store_true",
+        "dest": "xaod_perf_stats",
+        "default": False,
+        "help": "If enabled, collect the xAOD performance statistics (EL::Job::optXAODPerfStats), which --stats also does.",
+    },
+    "xAODReadStats": {
+        "action": "store_true",
+        "dest": "xaod_read_stats",
+        "default": False,
+        "help": "If enabled, write the xAOD read statistics of every job to its histogram output (EL::Job::optXAODReadStats).",
+    },
+    "readBranches": {
+        "dest": "read_branches",
+        "metavar": "<file>",
+        "type": str,
+        "default": None,
+        "help": "File listing the input branches the job reads, one per line, as written by BasicEventSelection::m_readBranchListOutput. The TTreeCache is primed with these branches.",
+    },
+    "writeReadBranches": {
+        "dest": "write_read_branches",
+        "metavar": "<file>",
+        "type": str,
+        "default": None,
+        "help": "Write the input branches read by the job to this file, for --readBranches (BasicEventSelection::m_readBranchListOutput). Only meaningful with a single process, e.g. the direct driver.",
+    },
+    "branchProfiles": {
+        "dest": "branch_profiles",
+        "metavar": "<directory>",
+        "type": str,
+        "default": None,
+        "help": "Directory of branch-access profiles, one per configuration (named after a hash of the algorithm configuration, tree name and access mode). If the profile of this configuration exists it is used as --readBranches, otherwise it is written by this job (direct driver) or by the --autoCache run.",
+    },
+    "disableOtherBranches": {
+        "action": "store_true",
+        "dest": "disable_other_branches",
+        "default": False,
+        "help": "If enabled with --readBranches, --autoCache or --branchProfiles, the input branches not in the list are disabled (BasicEventSelection::m_disableUnlistedBranches). Variables missing from the list then read as default values.",
+    },
+    "prefetch": {
+        "action": "store_true",
+        "dest": "prefetch",
+        "default": False,
+        "help": "If enabled, hide the latency of remote (XRootD) inputs: the TTreeCache prefetches baskets asynchronously and the next input file is opened in the background while the current one is processed (BasicEventSelection::m_asyncPrefetch, m_prefetchNextFile).",
+    },
+    "pinNUMA": {
+        "action": "store_true",
+        "dest": "pin_numa",
+        "default": False,
+        "help": "If enabled, every job pins itself to the CPUs and the memory of the NUMA node (socket) it starts on, before its tools are created, and the processes of BasicEventSelection::m_forkWorkers are spread over the nodes (BasicEventSelection::m_pinToNUMANode).",
+    },
+    "configCache": {
+        "dest": "config_cache",
+        "metavar": "<directory>",
+        "type": str,
+        "default": None,
+        "help": "Directory of compiled configurations. The configured algorithms are stored there (streamed by ROOT) the first time, and later runs with the same configuration file, command line (apart from the submission directory) and release load them instead of running the configuration code again. Files imported by a python configuration are not part of the key, clear the directory when they change.",
+    },
+    "autoCache": {
+        "dest": "auto_cache",
+        "metavar": "<n>",
+        "type": int,
+        "default": 0,
+        "help": "If larger than 0, first run the same configuration over this many events with the direct driver to find the input branches read by the chain, then prime the TTreeCache of the real job with them (as --readBranches).",
+    },
+    "orderByRun": {
+        "action": "store_true",
+        "dest": "order_by_run",
+        "default": False,
+        "help": "If enabled, the files of each local sample are ordered by the run and lumi block of their first event, so that per-run state in the algorithms is built once per run. Reads the first event of every file. Ignored on the grid.",
+    },
+    "metadataCache": {
+        "dest": "metadata_cache",
+        "metavar": "<sqlite file>",
+        "type": str,
+        "nargs": "?",
+        "const": "",
+        "default": None,
+        "help": "If enabled, the cross-section, filter efficiency, number of events and sum of weights (meta data 'sumW') of each sample are taken from the metadata cache filled by getEventCounts.py and getDSInfo.py, unless already set. Without a file name, $XAH_METADATA_CACHE or ~/.xah_metadata.sqlite is used. With local-parallel, cached event counts also size the jobs without reading every file.",
+    },
+    "jobRunTime": {
+        "dest": "job_runtime",
+        "metavar": "<seconds>",
+        "type": float,
+        "default": None,
+        "help": "Target run time of each batch job. The input is split into jobs of equal numbers of events (optEventsPerWorker), from the per-file event counts and the throughput given by --eventsPerSecond or --benchmark. Only for the condor, lsf, slurm, local and local-parallel drivers.",
+    },
+    "eventsPerSecond": {
+        "dest": "events_per_second",
+        "metavar": "<rate>",
+        "type": float,
+        "default": None,
+        "help": "Expected throughput of one job, used with --jobRunTime.",
+    },
+    "benchmark": {
+        "dest": "benchmark_json",
+        "metavar": "<file>",
+        "type": str,
+        "default": None,
+        "help": "Report written by xAH_benchmark.py --json for this configuration, its events_per_second is used with --jobRunTime unless --eventsPerSecond is given.",
+    },
+    "timing": {
+        "action": "store_true",
+        "dest": "do_timing",
+        "default": False,
+        "help": "If enabled, m_doTiming is switched on for every algorithm, so that the job report has the per-algorithm timing, the number of events and the input read statistics.",
+    },
+    "profileAllocations": {
+        "action": "store_true",
+        "dest": "profile_allocations",
+        "default": False,
+        "help": "If enabled, m_profileAllocations is switched on for every algorithm, so that the job report has the heap allocations per event of each algorithm. Needs libxAODAnaHelpersAllocationCounting.so in LD_PRELOAD.",
+    },
+    "perfCounters": {
+        "action": "store_true",
+        "dest": "perf_counters",
+        "default": False,
+        "help": "If enabled, m_doPerfCounters is switched on for every algorithm, so that the job report has the instructions per cycle, and the cache and branch misses per event of each algorithm, read from the Linux perf_event counters.",
+    },
+    "trace": {
+        "dest": "trace_file",
+        "metavar": "<file>",
+        "type": str,
+        "default": None,
+        "help": "Write a Chrome/Perfetto trace (JSON) of the event loop to this file, with one span per algorithm per event for the sampled and the slow events.",
+    },
+    "traceEveryNEvents": {
+        "dest": "trace_every_n_events",
+        "metavar": "<n>",
+        "type": int,
+        "default": 100,
+        "help": "With --trace, write one event out of this many, 0 to only write the slow events.",
+    },
+    "traceSlowEventMs": {
+        "dest": "trace_slow_event_ms",
+        "metavar": "<ms>",
+        "type": float,
+        "default": 0.,
+        "help": "With --trace, also write every event taking longer than this (ms) in the algorithms, 0 for none.",
+    },
+    "traceContainers": {
+        "dest": "trace_containers",
+        "metavar": "<containers>",
+        "type": str,
+        "default": "",
+        "help": "With --trace, space-separated particle containers whose sizes are added to every span.",
+    },
+    "releaseIntermediates": {
+        "action": "store_true",
+        "dest": "release_intermediates",
+        "default": False,
+        "help": "If enabled, every TStore container produced by the chain is removed right after the last algorithm needing it, as worked out by Config.releaseIntermediates() from the container names of the configuration, instead of at the end of the event.",
+    },
+    "objectCache": {
+        "dest": "object_cache",
+        "metavar": "<directory>",
+        "type": str,
+        "default": None,
+        "help": "Directory of object caches: the output of the --objectCacheStage MinixAOD for each sample, named after a hash of the input file UUIDs and of the configuration up to that stage. If the caches of all samples exist, the job reads them instead of the input and skips the algorithms up to that stage. Otherwise they are written by this job (direct driver). The cutflows and event counts of the algorithms up to that stage are cached with them. Only used with the direct and local drivers.",
+    },
+    "objectCacheStage": {
+        "dest": "object_cache_stage",
+        "metavar": "<name>",
+        "type": str,
+        "default": None,
+        "help": "Name (m_name) of the MinixAOD algorithm whose output is the object cache of --objectCache.",
+    },
+    "report": {
+        "dest": "report",
+        "metavar": "<file>",
+        "type": str,
+        "default": "xAH_report.json",
+        "help": "JSON job report written once the job is done, relative to the submission directory. Not written for jobs that are only submitted.",
+    },
     "sample-names": {
         "help": "Specify the sample names for the input files if you need to change them from the default.",
         "type": str,
@@ -129,12 +317,10 @@ standard = {
 # .add_argument('--optXaodAccessMode', type=str, required=False, default=None)
 # .add_argument('--optXaodAccessMode_branch', type=str, required=False, default=None)
 # .add_argument('--optXaodAccessMode_class', type=str, required=False, default=None)
-
-# standard options for other drivers -- not used because they're only for performance-tuning
-# .add_argument('--optCacheLearnEntries', type=str, required=False, default=None)
-# .add_argument('--optCacheSize', type=str, required=False, default=None)
-# .add_argument('--optXAODPerfStats', type=str, required=False, default=None)
-# .add_argument('--optXAODReadStats', type=str, required=False, default=None)
+# .add_argument('--optCacheLearnEntries', ...) -> --cacheLearnEntries
+# .add_argument('--optCacheSize', ...) -> --cacheSize
+# .add_argument('--optXAODPerfStats', ...) -> --xAODPerfStats
+# .add_argument('--optXAODReadStats', ...) -> --xAODReadStats
 
 drivers_common = {
     "optSubmitFlags": {
@@ -203,6 +389,24 @@ drivers_common = {
 drivers_direct = {}
 drivers_direct.update(copy.deepcopy(drivers_common))
 
+# define arguments for local driver
+drivers_local = {}
+drivers_local.update(copy.deepcopy(drivers_common))
+
+# define arguments for local-parallel driver
+drivers_local_parallel = {}
+drivers_local_parallel.update(copy.deepcopy(drivers_common))
+drivers_local_parallel.pop("optBatchWait")
+drivers_local_parallel.update({
+    "optNumParallelProcs": {
+        "metavar": "",
+        "type": int,
+        "required": False,
+        "default": 0,
+        "help": "the number of worker processes to run at the same time. 0 uses one per CPU core. Unless optFilesPerWorker or optEventsPerWorker is given, the events of the input are split evenly across this many workers.",
+    },
+})
+
 # define arguments for prooflite driver
 drivers_prooflite = {}
 drivers_prooflite.update(copy.deepcopy(drivers_common))
@@ -0,0 +1,39 @@
+#!/usr/bin/env python
+# -*- coding: utf-8 -*-,
+from __future__ import absolute_import
+from __future__ import print_function
+import logging
+logger = logging.getLogger("xAH.columnar")
+
+import ROOT
+
+def column_batch(prefix, columns, suffix=""):
+  """ An xAH::ColumnBatch of the branches <prefix>_<variable>[_<suffix>], with the columns given as {variable: type}, e.g. {'pt': 'float', 'clean_passLooseBad': 'int'}. """
+  batch = ROOT.xAH.ColumnBatch(prefix, suffix)
+  for variable, element_type in columns.items():
+    batch.addColumn[element_type](variable)
+  return batch
+
+def arrays(batch):
+  """ The offsets and the columns of the batch as NumPy arrays, (offsets, {variable: values}).
+
+      The arrays share the memory of the batch: they are only valid until the next batch.read(), copy them to keep them.
+  """
+  import numpy
+  columns = dict((str(variable), numpy.asarray(batch.values[str(batch.type(variable))](variable))) for variable in batch.variables())
+  return numpy.asarray(batch.offsets()), columns
+
+def iterate(tree, batch, batch_size=10000, first=0, entries=None):
+  """ Yield (offsets, {variable: values}) for successive batches of batch_size entries of tree (a TTree or a TChain), see arrays().
+
+      The objects of entry i of a batch are [offsets[i], offsets[i+1]) in each column, e.g. for awkward arrays:
+
+      >>> for offsets, columns in iterate(tree, column_batch('jet', {'pt': 'float', 'eta': 'float'})):
+      >>>   pt = awkward.Array(awkward.contents.ListOffsetArray(awkward.index.Index64(offsets), awkward.contents.NumpyArray(columns['pt'])))
+  """
+  last = tree.GetEntries() if entries is None else min(tree.GetEntries(), first + entries)
+  while first < last:
+    n = batch.read(tree, first, min(batch_size, last - first))
+    if n == 0: break
+    first += n
+    yield arrays(batch)
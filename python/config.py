@@ -9,7 +9,9 @@ import ROOT
 ROOT.PyConfig.IgnoreCommandLineOptions = True
 ROOT.gROOT.SetBatch(True)
 
+import hashlib
 import inspect
+import json
 from AnaAlgorithm.AnaAlgorithmConfig import AnaAlgorithmConfig
 
 from .utils import NameGenerator, vector
@@ -125,3 +127,136 @@ class Config(object):
 
   def output(self, name):
     self._outputs.add(str(name))
+
+  # algorithms handing what they read to the output at the end of the event rather than in their execute()
+  _endOfEventConsumers = ['MinixAOD']
+
+  def releaseIntermediates(self):
+    """ Work out from the wiring of the chain (the m_out* options of the producers, and any other option naming the key) the last algorithm needing each TStore key produced by the chain, and set m_releaseContainers of that algorithm so that the key is removed right after its execute(). A key lives as long as anything produced from it (e.g. a view container of its particles), keys read by MinixAOD or never read are not released. Returns {algorithm name: [released keys]}. """
+    import re
+    def tokens(value):
+      if isinstance(value, (str, unicode)): return set(t for t in re.split(r'[\s,|;:]+', value) if t)
+      if isinstance(value, (bool, int, long, float)): return set()
+      try: return set().union(*[tokens(v) for v in value])
+      except TypeError: return set()
+
+    # the options of every algorithm, in order, from the configuration log
+    algs = []
+    for configLog in self._log:
+      if len(configLog) == 2: algs.append((configLog[0], configLog[1], {}))
+      elif algs and configLog[0] == algs[-1][1]: algs[-1][2][configLog[1]] = configLog[2]
+    if len(algs) != len(self._algorithms):
+      logger.warning("The configuration log does not match the algorithms, no intermediate container is released")
+      return {}
+
+    produced, consumed = [], []
+    for className, algName, options in algs:
+      outputs = dict((k, tokens(v)) for k, v in options.items() if k.startswith('m_out'))
+      systKeys = set().union(*[v for k, v in outputs.items() if 'Algo' in k or 'Syst' in k])
+      containers = set().union(*[v for k, v in outputs.items() if not ('Algo' in k or 'Syst' in k)]) - systKeys
+      # variations can only be told apart from the nominal name if there is one list of them
+      systKey = next(iter(systKeys)) if len(systKeys) == 1 else None
+      produced.append(dict([(c, systKey) for c in containers] + [(k, None) for k in systKeys]))
+      consumed.append(set().union(*[tokens(v) for k, v in options.items() if not k.startswith('m_out') and k not in ['m_name', 'm_msgLevel']]))
+
+    # index of the last algorithm needing each key, None if it has to stay until the end of the event
+    end = {}
+    release = {}
+    for i in reversed(range(len(algs))):
+      for key, systKey in produced[i].items():
+        consumers = [j for j in range(i+1, len(algs)) if key in consumed[j]]
+        last = max(consumers) if consumers else None
+        for j in consumers:
+          if algs[j][0] in self._endOfEventConsumers: last = None
+          for output in produced[j]:
+            if last is None: break
+            if end.get(output) is None: last = None
+            else: last = max(last, end[output])
+          if last is None: break
+        end[key] = last
+        if last is not None: release.setdefault(last, []).append(key if systKey is None else '{0:s}:{1:s}'.format(key, systKey))
+
+    released = {}
+    for j, keys in release.items():
+      alg = self._algorithms[j]
+      if not hasattr(alg, 'm_releaseContainers'): continue
+      # the containers first, their variations are found through the lists of systematics
+      keys = sorted(keys, key=lambda k: ':' not in k)
+      alg.m_releaseContainers = vector(keys)
+      released[algs[j][1]] = keys
+      logger.info("{0:s} releases {1:s}".format(algs[j][1], ', '.join(keys)))
+    return released
+
+  def _logBlocks(self):
+    """ The (name, first, last) range of the configuration log of every algorithm, in order. """
+    blocks = []
+    for i, configLog in enumerate(self._log):
+      if len(configLog) == 2: blocks.append([configLog[1], i, i+1])
+      elif blocks: blocks[-1][2] = i+1
+    if len(blocks) != len(self._algorithms):
+      raise ValueError("The configuration log does not match the algorithms")
+    return blocks
+
+  def _stageIndex(self, stage):
+    names = [block[0] for block in self._logBlocks()]
+    if stage not in names:
+      raise ValueError("No algorithm named {0:s} in the configuration".format(stage))
+    return names.index(stage)
+
+  def upstreamKey(self, stage):
+    """ Hash of the configuration of the algorithms up to and including the one named stage, which identifies the output of that stage for the same input. """
+    last = self._logBlocks()[self._stageIndex(stage)][2]
+    return hashlib.sha1(json.dumps(self.log()[:last]).encode('utf-8')).hexdigest()
+
+  def startFromCache(self, stage, **options):
+    """ Replace the algorithms up to and including the one named stage by an ObjectCacheReader, for a job reading the object cache written by that stage instead of the original input. """
+    index = self._stageIndex(stage)
+    last = self._logBlocks()[index][2]
+    self._algorithms = self._algorithms[index+1:]
+    self._log = self._log[last:]
+    # configured last, then moved to the front of the chain
+    options.setdefault('m_name', 'ObjectCacheReader')
+    nLog = len(self._log)
+    self.algorithm('ObjectCacheReader', options)
+    self._algorithms.insert(0, self._algorithms.pop())
+    self._log = self._log[nLog:] + self._log[:nLog]
+
+  def log(self):
+    """ The configuration log, with the std::vector values turned into lists so that it can be compared and stored as JSON. """
+    def plain(value):
+      if isinstance(value, (str, unicode, bool, int, long, float)): return value
+      try: return [plain(v) for v in value]
+      except TypeError: return str(value)
+    return [[plain(x) for x in configLog] for configLog in self._log]
+
+  def save(self, filename):
+    """ Store the configured algorithms, streamed by ROOT, and the rest of the configuration in a ROOT file that load() reads back without running any configuration code. """
+    f = ROOT.TFile.Open(filename, "RECREATE")
+    keys = []
+    for i, alg in enumerate(self._algorithms):
+      key = "algorithm_{0:d}".format(i)
+      className = alg.IsA().GetName() if hasattr(alg, 'IsA') else 'EL::AnaAlgorithmConfig'
+      f.WriteObjectAny(alg, className, key)
+      keys.append(key)
+    content = {'algorithms': keys, 'samples': self._samples, 'outputs': sorted(self._outputs), 'log': self.log()}
+    ROOT.TObjString(json.dumps(content)).Write("xAH_config")
+    f.Close()
+
+  @classmethod
+  def load(cls, filename):
+    """ The configuration stored by save(). """
+    f = ROOT.TFile.Open(filename)
+    if not f or f.IsZombie():
+      raise IOError("Cannot read the configuration {0:s}".format(filename))
+    content = json.loads(str(f.Get("xAH_config").GetString()))
+    config = cls()
+    for key in content['algorithms']:
+      alg = f.Get(str(key))
+      if not alg:
+        raise IOError("Cannot read {0:s} from the configuration {1:s}".format(key, filename))
+      config._algorithms.append(alg)
+    config._samples = dict((str(pattern), dict((str(k), v) for k, v in metadata.items())) for pattern, metadata in content['samples'].items())
+    config._outputs = set(str(output) for output in content['outputs'])
+    config._log = [tuple(configLog) for configLog in content['log']]
+    f.Close()
+    return config
@@ -0,0 +1,79 @@
+#!/usr/bin/env python
+# -*- coding: utf-8 -*-,
+from __future__ import absolute_import
+from __future__ import print_function
+import logging
+logger = logging.getLogger("xAH.metadata")
+
+import os
+import sqlite3
+import time
+
+# the cache shared by getEventCounts.py, getDSInfo.py and xAH_run.py
+default_path = os.environ.get('XAH_METADATA_CACHE', os.path.expanduser('~/.xah_metadata.sqlite'))
+
+# the per-dataset quantities that are cached, any of them may be unknown (NULL)
+fields = ['events', 'totalEvents', 'crossSection', 'filterEff', 'sumW', 'evntDataset']
+
+def dataset_name(name):
+  """The name a dataset is cached under: no scope, no trailing slash"""
+  return name.strip().split(':')[-1].rstrip('/')
+
+class MetadataCache(object):
+  """On-disk (sqlite) cache of dataset metadata: number of events, cross-section (pb), filter efficiency, sum of weights and the EVNT dataset it comes from"""
+  def __init__(self, path=None):
+    self.path = path or default_path
+    self._db = sqlite3.connect(self.path, timeout=60)
+    self._db.row_factory = sqlite3.Row
+    with self._db:
+      self._db.execute('CREATE TABLE IF NOT EXISTS datasets (name TEXT PRIMARY KEY, events INTEGER, totalEvents INTEGER, crossSection REAL, filterEff REAL, sumW REAL, evntDataset TEXT, updated REAL)')
+
+  def get(self, name):
+    """The cached metadata of one dataset as a dict, None if it is not cached"""
+    return self.get_many([name]).get(dataset_name(name))
+
+  def get_many(self, names):
+    """Cached metadata of the datasets, as a dict by dataset name. Datasets not cached are missing from it"""
+    names = list(set(dataset_name(name) for name in names))
+    result = {}
+    # stay below the sqlite limit on the number of host parameters
+    for i in range(0, len(names), 500):
+      chunk = names[i:i+500]
+      query = 'SELECT * FROM datasets WHERE name IN ({0:s})'.format(','.join('?'*len(chunk)))
+      for row in self._db.execute(query, chunk):
+        result[row['name']] = dict((field, row[field]) for field in fields)
+    return result
+
+  def update(self, name, **values):
+    """Set some of the fields of a dataset, leaving the others as they are"""
+    unknown = set(values) - set(fields)
+    if unknown: raise KeyError('Unknown metadata field(s): {0}'.format(', '.join(sorted(unknown))))
+    name = dataset_name(name)
+    with self._db:
+      self._db.execute('INSERT OR IGNORE INTO datasets (name) VALUES (?)', (name,))
+      if values:
+        assignments = ', '.join('{0:s} = ?'.format(field) for field in values)
+        self._db.execute('UPDATE datasets SET {0:s}, updated = ? WHERE name = ?'.format(assignments), list(values.values()) + [time.time(), name])
+
+  def missing(self, names, field):
+    """The datasets among names for which field is not cached"""
+    cached = self.get_many(names)
+    return [name for name in names if cached.get(dataset_name(name), {}).get(field) is None]
+
+def fetch_events(cache, client, names, batchSize=50):
+  """Fill the number of events of the datasets not in the cache, querying AMI for up to batchSize datasets at a time. Returns the cached metadata of all of them"""
+  import pyAMI.atlas.api as AtlasAPI
+  todo = [dataset_name(name) for name in cache.missing(names, 'events')]
+  for i in range(0, len(todo), batchSize):
+    chunk = todo[i:i+batchSize]
+    logger.info("Querying AMI for the number of events of %d datasets", len(chunk))
+    try:
+      rows = AtlasAPI.list_datasets(client, patterns=chunk, fields=['events'])
+    except Exception as e:
+      logger.warning("AMI query failed: %s", e)
+      continue
+    for row in rows:
+      name = dataset_name(row.get('ldn', ''))
+      if name in chunk and row.get('events') not in (None, ''):
+        cache.update(name, events=int(row['events']))
+  return cache.get_many(names)
@@ -0,0 +1,169 @@
+#!/usr/bin/env python
+# -*- coding: utf-8 -*-,
+from __future__ import absolute_import
+from __future__ import print_function
+import logging
+logger = logging.getLogger("xAH.report")
+
+import glob
+import os
+import resource
+import sys
+
+def _timing_histograms(submit_dir, directory='timing'):
+  """ Yield (name, {label: value}) for every histogram in the timing/ (or other) directory of the metadata stream, one per file. """
+  import ROOT
+  ROOT.gROOT.SetBatch(True)
+
+  for fname in glob.glob(os.path.join(submit_dir, 'data-metadata', '*.root')):
+    f = ROOT.TFile.Open(fname)
+    if not f or f.IsZombie(): continue
+    d = f.Get(directory)
+    if d:
+      for key in d.GetListOfKeys():
+        h = key.ReadObj()
+        yield h.GetName(), dict((h.GetXaxis().GetBinLabel(i), h.GetBinContent(i)) for i in range(1, h.GetNbinsX()+1))
+    f.Close()
+
+def read_timing(submit_dir):
+  """ Collect the timing/<algorithm> histograms written by xAH::Algorithm into the metadata stream. """
+  timing = {}
+  for name, values in _timing_histograms(submit_dir):
+    if name in ['io', 'arena']: continue
+    entry = timing.setdefault(name, {})
+    for label, value in values.items():
+      # totals and counts add up over the files, the rest is taken from the slowest file
+      if label in ['calls', 'wall_total', 'cpu_total']:
+        entry[label] = entry.get(label, 0.) + value
+      else:
+        entry[label] = max(entry.get(label, 0.), value)
+
+  for entry in timing.values():
+    if entry.get('calls', 0.) > 0: entry['wall_mean'] = entry['wall_total']/entry['calls']
+  return timing
+
+def read_io(submit_dir):
+  """ Sum the timing/io input read statistics of all the jobs, and derive the fraction of the bytes read through the TTreeCache. """
+  io = {}
+  for name, values in _timing_histograms(submit_dir):
+    if name != 'io': continue
+    for label, value in values.items():
+      io[label] = io.get(label, 0.) + value
+
+  cacheBytes = io.get('cache_bytes_read', 0.)
+  allBytes = cacheBytes + io.get('no_cache_bytes_read', 0.)
+  if allBytes > 0: io['cache_hit_rate'] = cacheBytes/allBytes
+  return io
+
+def read_arena(submit_dir):
+  """ Sum the timing/arena statistics of xAH::EventArena over all the jobs: allocations served from the arena instead of the heap, and the heap blocks it took itself. """
+  arena = {}
+  for name, values in _timing_histograms(submit_dir):
+    if name != 'arena': continue
+    for label, value in values.items():
+      if label == 'capacity': arena[label] = max(arena.get(label, 0.), value)
+      else: arena[label] = arena.get(label, 0.) + value
+
+  if arena.get('events', 0.) > 0:
+    arena['served_per_event'] = arena.get('allocations', 0.)/arena['events']
+    arena['heap_blocks_per_event'] = arena.get('heap_blocks', 0.)/arena['events']
+  return arena
+
+def read_hist_memory(submit_dir):
+  """ Histogram memory in bytes of every *HistsAlgo at initialize and finalize, the largest over the files, from the memory/<algorithm> histograms of xAH::Algorithm. """
+  memory = {}
+  for name, values in _timing_histograms(submit_dir, 'memory'):
+    entry = memory.setdefault(name, {})
+    for label, value in values.items():
+      entry[label] = max(entry.get(label, 0.), value)
+  return memory
+
+def read_allocations(submit_dir):
+  """ Sum the allocations/<algorithm> counts of xAH::AllocationProfiler over all the jobs, and derive the averages per event. """
+  allocations = {}
+  for name, values in _timing_histograms(submit_dir, 'allocations'):
+    entry = allocations.setdefault(name, {})
+    for label in ['calls', 'allocations', 'bytes', 'deallocations']:
+      entry[label] = entry.get(label, 0.) + values.get(label, 0.)
+
+  for entry in allocations.values():
+    if entry['calls'] > 0:
+      entry['allocations_per_event'] = entry['allocations']/entry['calls']
+      entry['bytes_per_event'] = entry['bytes']/entry['calls']
+  return allocations
+
+def read_perf(submit_dir):
+  """ Sum the perf/<algorithm> hardware counts of xAH::PerfCounters over all the jobs, and derive the instructions per cycle and the counts per event. """
+  counters = ['cycles', 'instructions', 'llc_misses', 'branch_misses']
+  perf = {}
+  for name, values in _timing_histograms(submit_dir, 'perf'):
+    entry = perf.setdefault(name, {})
+    for label in ['calls'] + counters:
+      entry[label] = entry.get(label, 0.) + values.get(label, 0.)
+
+  for entry in perf.values():
+    entry['ipc'] = entry['instructions']/entry['cycles'] if entry['cycles'] > 0 else 0.
+    if entry['calls'] > 0:
+      for label in counters: entry[label + '_per_event'] = entry[label]/entry['calls']
+  return perf
+
+def output_bytes(submit_dir):
+  """ Size of all the output streams and histogram files of the job. """
+  files = glob.glob(os.path.join(submit_dir, 'data-*', '*'))
+  files += glob.glob(os.path.join(submit_dir, 'hist-*.root'))
+  return sum(os.path.getsize(f) for f in files if os.path.isfile(f))
+
+def peak_rss_bytes():
+  """ Peak resident memory of this process and of its finished children, whichever is larger. """
+  peakRSS = max(resource.getrusage(resource.RUSAGE_SELF).ru_maxrss, resource.getrusage(resource.RUSAGE_CHILDREN).ru_maxrss)
+  # ru_maxrss is in kilobytes on linux, and in bytes on macOS
+  if sys.platform != 'darwin': peakRSS *= 1024
+  return peakRSS
+
+def job_report(submit_dir, wall_time, peak_rss=None, **extra):
+  """ The job report of a finished submission directory, as a dict that can be dumped to JSON. The per-algorithm timing and the input statistics are only there for algorithms run with m_doTiming. """
+  timing = read_timing(submit_dir)
+  # the first algorithm of the chain sees every event
+  nEvents = int(max([t.get('calls', 0) for t in timing.values()] + [0]))
+  nBytes = output_bytes(submit_dir)
+  eventTime = sum(t.get('wall_total', 0.) for t in timing.values())
+  # the heap allocations of the whole chain, as counted by xAH::AllocationProfiler, the figure to compare before and after a change
+  allocations = read_allocations(submit_dir)
+  nAllocations = sum(a.get('allocations', 0.) for a in allocations.values())
+
+  report = {
+    'events': nEvents,
+    'wall_time': wall_time,
+    'events_per_second': nEvents/wall_time if wall_time > 0 else 0.,
+    'algorithm_events_per_second': nEvents/eventTime if eventTime > 0 else 0.,
+    'peak_rss_bytes': peak_rss if peak_rss is not None else peak_rss_bytes(),
+    'output_bytes': nBytes,
+    'output_bytes_per_event': float(nBytes)/nEvents if nEvents > 0 else 0.,
+    'allocations_per_event': nAllocations/nEvents if nEvents > 0 else 0.,
+    'input': read_io(submit_dir),
+    'arena': read_arena(submit_dir),
+    'histogram_memory_bytes': read_hist_memory(submit_dir),
+    'allocations': allocations,
+    'perf': read_perf(submit_dir),
+    'algorithms': timing
+  }
+  report.update(extra)
+  return report
+
+# the job report figures compared between two runs of the benchmark suite, and whether larger is better
+suite_metrics = [('events_per_second', True), ('algorithm_events_per_second', True), ('peak_rss_bytes', False), ('output_bytes_per_event', False), ('allocations_per_event', False)]
+
+def compare_suites(reference, candidate, threshold=0.1):
+  """ Compare two results of xAH_benchmarkSuite.py, as loaded from their JSON files. Returns one (configuration, metric, reference value, candidate value, relative change, regression) row per figure of suite_metrics present in both, the relative change being positive for an improvement. A change worse than the threshold is a regression. """
+  rows = []
+  for name in sorted(reference.get('configs', {})):
+    if name not in candidate.get('configs', {}):
+      logger.warning("Configuration {0:s} is not in the candidate results, skipping it.".format(name))
+      continue
+    ref, new = reference['configs'][name], candidate['configs'][name]
+    for metric, higherIsBetter in suite_metrics:
+      if not ref.get(metric) or metric not in new: continue
+      change = (new[metric] - ref[metric])/float(ref[metric])
+      if not higherIsBetter: change = -change
+      rows.append((name, metric, ref[metric], new[metric], change, change < -threshold))
+  return rows
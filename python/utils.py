@@ -106,6 +106,27 @@ def parse_json(filename):
     # Return json file
     return json.loads(content)
 
+def load_config(filename, args):
+  """ Build the xAH Config of a user configuration the way xAH_run.py does: a JSON list of
+      algorithms, or a python file executed with `args` in its namespace that creates a Config.
+  """
+  from .config import Config
+  configurator = None
+  if ".json" in filename:
+    configurator = Config()
+    for algConfig in parse_json(filename):
+      configurator.algorithm(algConfig['class'], algConfig['configs'])
+  else:
+    configGlobals, configLocals = {}, {'args': args}
+    execfile(filename, configGlobals, configLocals)
+    for k,v in configLocals.items():
+      if isinstance(v, Config):
+        configurator = v
+        break
+  if configurator is None:
+    raise ValueError("{0:s} does not create an xAODAnaHelpers Config object".format(filename))
+  return configurator
+
 # this registers the provided dictionary of cli-options on an argparse.ArgumentParser object
 def register_on_parser(cli_options, parser):
     for optName, optConfig in cli_options.items():
@@ -193,3 +214,59 @@ def vector(iterable, element_type = None):
   for element in iterable:
     vector.push_back(element)
   return vector
+
+# candidate branches holding the run number and lumi block of the EventInfo, depending on how the file was written
+_run_lumiblock_branches = [("EventInfoAux.runNumber", "EventInfoAux.lumiBlock"),
+                           ("EventInfoAuxDyn.runNumber", "EventInfoAuxDyn.lumiBlock")]
+# data file and dataset names carry the (zero padded) run number, e.g. data18_13TeV.00358031.physics_Main...
+_run_in_name_re = re.compile(r'data\d+_\w+?\.0*(\d+)\.')
+
+def first_run_lumiblock(filename, treeName="CollectionTree"):
+  """ Return (runNumber, lumiBlock) of the first event of a file, or None if it cannot be found.
+
+      Only the two EventInfo branches of the first entry are read. If they are not there, the run number is taken from the file name.
+  """
+  f = ROOT.TFile.Open(filename)
+  try:
+    tree = f.Get(treeName) if f and not f.IsZombie() else None
+    if tree and tree.GetEntries() > 0:
+      for runBranch, lumiBlockBranch in _run_lumiblock_branches:
+        if not tree.GetBranch(runBranch) or not tree.GetBranch(lumiBlockBranch): continue
+        tree.SetBranchStatus("*", 0)
+        tree.SetBranchStatus(runBranch, 1)
+        tree.SetBranchStatus(lumiBlockBranch, 1)
+        tree.GetEntry(0)
+        return (int(tree.GetLeaf(runBranch).GetValue()), int(tree.GetLeaf(lumiBlockBranch).GetValue()))
+  finally:
+    if f: f.Close()
+
+  match = _run_in_name_re.search(os.path.basename(filename)) or _run_in_name_re.search(filename)
+  if match: return (int(match.group(1)), 0)
+  return None
+
+def sort_samples_by_run(sh, treeName="CollectionTree"):
+  """ Return a copy of the SampleHandler `sh` where the files of each local sample are ordered by the run and lumi block of their first event.
+
+      Data split by the grid is often interleaved across runs, ordering the files lets the per-run state of the algorithms (GRL, prescales, beam spot, duplicate checks) be built once per run.
+      Files whose run cannot be determined keep their relative order, after the others. Other sample types are kept as they are.
+  """
+  sorted_sh = ROOT.SH.SampleHandler()
+  for sample in sh:
+    if not isinstance(sample, ROOT.SH.SampleLocal) or sample.numFiles() < 2:
+      sorted_sh.add(sample)
+      continue
+
+    files = [sample.fileName(i) for i in range(sample.numFiles())]
+    unknown = (float('inf'), float('inf'))
+    keys = [first_run_lumiblock(fname, treeName) or unknown for fname in files]
+    order = sorted(range(len(files)), key=lambda i: (keys[i], i))
+    logger.info("Ordering the {0:d} files of {1:s} by run, {2:d} run(s) found".format(len(files), sample.name(), len(set(k[0] for k in keys if k != unknown))))
+
+    sorted_sample = ROOT.SH.SampleLocal(sample.name())
+    sorted_sample.meta().fetch(sample.meta())
+    for i in order: sorted_sample.add(files[i])
+    # the SampleHandler owns its samples
+    ROOT.SetOwnership(sorted_sample, False)
+    sorted_sh.add(sorted_sample)
+
+  return sorted_sh
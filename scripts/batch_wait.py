@@ -48,6 +48,7 @@ parser._optionals.title = "optional"
 # positional argument, require the first argument to be the input filename
 parser.add_argument('--submitDir', dest='submit_dir', metavar='<directory>', type=str, required=True, help='Directory with the submission.', default='submitDir')
 
+parser.add_argument('--report', dest='report', metavar='<file>', type=str, default='xAH_report.json', help='JSON job report of the merged outputs, relative to the submission directory. Empty to not write one.')
 parser.add_argument('-v', '--verbose', dest='verbose', action='count', default=0, help='Enable verbose output of various levels. Can increase verbosity by adding more ``-vv``. Default: no verbosity')
 
 # start the script
@@ -76,6 +77,16 @@ if __name__ == "__main__":
     # Wait
     if not ROOT.EL.Driver.wait(args.submit_dir):
       sys.exit(1)
+
+    # the wall time of batch jobs is not known here, the report has the time spent in the algorithms
+    if args.report:
+      try:
+        import xAODAnaHelpers.report as xAH_report
+      except ImportError:
+        import python.report as xAH_report
+      import json
+      with open(os.path.join(args.submit_dir, args.report), 'w') as f:
+        json.dump(xAH_report.job_report(args.submit_dir, 0., peak_rss=0), f, indent=2, sort_keys=True)
   except Exception, e:
     # we crashed
     xAH_logger.exception("{0}\nAn exception was caught!".format("-"*20))
@@ -15,6 +15,7 @@
 #import
 import os, sys, subprocess, glob, shutil
 import argparse
+from multiprocessing.pool import ThreadPool
 parser = argparse.ArgumentParser(description="%prog [options]", formatter_class=argparse.ArgumentDefaultsHelpFormatter)
 parser.add_argument("--container", dest='container', default="None",
      help="Name of dataset to be downloaded, may include wildcards")
@@ -31,8 +32,90 @@ parser.add_argument("--renameRawDatasets", dest='renameRawDatasets', default="Fa
      help="Rename raw datasets")
 parser.add_argument("--maxSize", dest='maxSize', default=-1,
      help="Attempted max size (in GB) of output files. Files larger than this will not be merged. -1 for no size limit ")
+parser.add_argument("--nMergeJobs", dest='nMergeJobs', default=2, type=int,
+     help="Number of datasets merged at the same time. Merging starts as soon as a dataset is downloaded, while the next ones are downloading")
+parser.add_argument("--haddJobs", dest='haddJobs', default=1, type=int,
+     help="Number of processes used by each hadd (hadd -j), 1 to merge serially")
+parser.add_argument("--haddCompression", dest='haddCompression', default="",
+     help="Compression setting of the merged files, passed as hadd -f<setting> (100*algorithm+level, e.g. 404 for LZ4 level 4 or 505 for ZSTD level 5). Empty keeps the hadd default")
 args = parser.parse_args()
 
+def hadd(outputFileName, inputFiles, cwd):
+  command = ['hadd']
+  if args.haddJobs > 1:
+    command += ['-j', str(args.haddJobs)]
+  command += ['-f'+args.haddCompression if args.haddCompression else '-f', outputFileName]
+  command += inputFiles
+  print '   '+' '.join(command)
+  return subprocess.call(command, cwd=cwd)
+
+def mergeDataset(dataset, datasetVariants, workDir):
+  """Merge (or rename) the downloaded files of one dataset, paths are relative to workDir"""
+  if '.log/' in dataset:
+    return
+  print '\n dataset: %s'%dataset
+
+  for datasetVariant in datasetVariants:
+    if datasetVariant in dataset:
+      variant = datasetVariant
+      break
+  print '  variant: %s'%variant
+
+  inputFilesNameWildCard = 'rawDownload/'+dataset.rstrip('/')+'*/*.root*'
+  outputFileName = variant+'/'+dataset.rstrip('/')
+
+  print '   outputFileName: %s'%outputFileName
+
+  inputFilesName = sorted(os.path.relpath(f, workDir) for f in glob.glob(os.path.join(workDir, inputFilesNameWildCard)))
+
+  if (args.mergeRawDatasets=="True") :
+    print '   hadding inputFilesName: %s'%inputFilesNameWildCard
+    if outputFileName.endswith('.root'):
+      outputFileName = outputFileName[:-5] #strip .root
+
+    if float(args.maxSize) <= 0:
+      hadd(outputFileName+'.root', inputFilesName, workDir)
+    else:
+      ## Get file sizes
+      fileSizes = []
+      for iFile,theFile in enumerate(inputFilesName) :
+        fileSizes.append( os.path.getsize(os.path.join(workDir, theFile))/1E9 ) #save as GB
+      ## Select combinations of files
+      filesToMerge = [ [] ]
+      fileSizesToMerge = [ [] ]
+      while len( inputFilesName ) > 0:
+        if len(fileSizesToMerge[-1])==0 or float(sum( fileSizesToMerge[-1] )+fileSizes[0]) < float(args.maxSize):
+          #If current list is empty or new size will be below threshold,
+          #Add to current merge list and stay on this list
+          filesToMerge[-1].append( inputFilesName[0] )
+          fileSizesToMerge[-1].append( fileSizes[0] )
+
+        else: #combined size is too large
+          ## Move on to next merge list then add file
+          filesToMerge.append( [] )
+          fileSizesToMerge.append( [] )
+          filesToMerge[-1].append( inputFilesName[0] )
+          fileSizesToMerge[-1].append( fileSizes[0] )
+
+
+        inputFilesName = inputFilesName[1:] #remove first element
+        fileSizes = fileSizes[1:] #remove first element
+
+      ## Combine
+      for iMerge, theseFilesToMerge in enumerate( filesToMerge ):
+        if len( filesToMerge) == 1: #Only one output file
+          hadd(outputFileName+'.root', theseFilesToMerge, workDir)
+        elif len(theseFilesToMerge) == 1:
+          shutil.move(os.path.join(workDir, theseFilesToMerge[0]), os.path.join(workDir, outputFileName+"."+str(iMerge)+".root"))
+        else:
+          hadd(outputFileName+'.'+str(iMerge)+'.root', theseFilesToMerge, workDir)
+
+
+  elif (args.renameRawDatasets=="True") :
+    print 'renaming ', inputFilesName
+    for iFile,theFile in enumerate(inputFilesName) :
+      shutil.move(os.path.join(workDir, theFile), os.path.join(workDir, outputFileName+"."+str(iFile)+".root"))
+
 def main():
   ##******************************************
   #NOTE before starting, set the variables
@@ -106,112 +189,46 @@ def main():
   numDownloads  = str(len(datasetList))
 
   #------------------------------------------
-  #prepare output directory for raw datasets
+  #prepare output directories for raw datasets and merged files
   if not os.path.exists(outputPath):
     os.mkdir(outputPath)
-  if not os.path.exists(outputPath+'/rawDownload/'):
-    os.mkdir(outputPath+'/rawDownload/')
-  try:
-    os.chdir(outputPath+'/rawDownload/')
-  except:
-    raise SystemExit('\n***EXIT*** couldn\'t change directory')
-
-  #download datasets
-  print '\n******************************************\ndownloading datasets'
+  workDir = os.path.abspath(outputPath)
+  downloadDir = os.path.join(workDir, 'rawDownload')
+  if not os.path.exists(downloadDir):
+    os.mkdir(downloadDir)
+  for variant in datasetVariants:
+    directory = os.path.join(workDir, variant)
+    if not os.path.exists(directory):
+      os.mkdir(directory)
+
+  #download datasets, each one is handed to the merging pool as soon as it is complete
+  doMerge = mergeRawDatasets == "True" or renameRawDatasets == "True"
+  mergePool = ThreadPool(max(1, args.nMergeJobs)) if doMerge else None
+  merges = []
+
+  print '\n******************************************\ndownloading and merging datasets'
   for idataset, dataset in enumerate(datasetList):
     print '\n ---------------------- downloading dataset ('+str(idataset)+'/'+numDownloads+'): %s'%dataset
 
     if args.doFax:
-      print "fax-get "+dataset
-      os.system("fax-get "+dataset)
+      command = ["fax-get", dataset]
     else:
-      print "rucio download "+dataset+" --ndownloader 5"
-      os.system("rucio download "+dataset+" --ndownloader 5")
+      command = ["rucio", "download", dataset, "--ndownloader", "5"]
+    print ' '.join(command)
+    subprocess.call(command, cwd=downloadDir)
 
     #remove scope from dataset name (i.e. user.x:)
     datasetList[idataset] = dataset.split(':')[1]
 
-  #prepare output directories for merged files
-  os.chdir('../')
-  for variant in datasetVariants:
-    directory = variant+'/'
-    if not os.path.exists(directory):
-      os.mkdir(directory)
-
-  #merge datasets
-
-  if mergeRawDatasets == "True" or renameRawDatasets == "True" :
-    print '\n******************************************\nmerging files'
-    for dataset in datasetList:
-      if '.log/' in dataset:
-        continue
-      print '\n dataset: %s'%dataset
-
-      for datasetVariant in datasetVariants:
-        if datasetVariant in dataset:
-          variant = datasetVariant
-          break
-      print '  variant: %s'%variant
+    if mergePool:
+      merges.append( mergePool.apply_async(mergeDataset, (datasetList[idataset], datasetVariants, workDir)) )
 
-      inputFilesNameWildCard = 'rawDownload/'+dataset.rstrip('/')+'*/*.root*'
-      outputFileName = variant+'/'+dataset.rstrip('/')
-
-      print '   outputFileName: %s'%outputFileName
-
-      inputFilesName = glob.glob(inputFilesNameWildCard)
-
-      if (mergeRawDatasets=="True") :
-        print '   hadding inputFilesName: %s'%inputFilesNameWildCard
-        if outputFileName.endswith('.root'):
-          outputFileName = outputFileName[:-5] #strip .root
-
-        if args.maxSize <= 0:
-          os.system('hadd '+outputFileName+'.root '+inputFilesNameWildCard)
-        else:
-          ## Get file sizes
-          fileSizes = []
-          for iFile,theFile in enumerate(inputFilesName) :
-            fileSizes.append( os.path.getsize(theFile)/1E9 ) #save as GB
-          ## Select combinations of files
-          filesToMerge = [ [] ]
-          fileSizesToMerge = [ [] ]
-          while len( inputFilesName ) > 0:
-            if len(fileSizesToMerge[-1])==0 or float(sum( fileSizesToMerge[-1] )+fileSizes[0]) < float(args.maxSize):
-              #If current list is empty or new size will be below threshold,
-              #Add to current merge list and stay on this list
-              filesToMerge[-1].append( inputFilesName[0] )
-              fileSizesToMerge[-1].append( fileSizes[0] )
-
-            else: #combined size is too large
-              ## Move on to next merge list then add file
-              filesToMerge.append( [] )
-              fileSizesToMerge.append( [] )
-              filesToMerge[-1].append( inputFilesName[0] )
-              fileSizesToMerge[-1].append( fileSizes[0] )
-
-
-            inputFilesName = inputFilesName[1:] #remove first element
-            fileSizes = fileSizes[1:] #remove first element
-
-          #for iMerge, theseFilesToMerge in enumerate( filesToMerge ):
-          #  print theseFilesToMerge
-          #  print fileSizesToMerge[iMerge]
-          #  print sum(fileSizesToMerge[iMerge])
-
-          ## Combine
-          for iMerge, theseFilesToMerge in enumerate( filesToMerge ):
-            if len( filesToMerge) == 1: #Only one output file
-              os.system('hadd '+outputFileName+'.root '+' '.join(theseFilesToMerge) )
-            elif len(theseFilesToMerge) == 1:
-              os.system("mv "+theseFilesToMerge[0]+" "+outputFileName+"."+str(iMerge)+".root")
-            else:
-              os.system('hadd '+outputFileName+'.'+str(iMerge)+'.root '+' '.join(theseFilesToMerge) )
-
-
-      elif (renameRawDatasets=="True") :
-        print 'renaming ', inputFilesName
-        for iFile,theFile in enumerate(inputFilesName) :
-          os.system("mv "+theFile+" "+outputFileName+"."+str(iFile)+".root")
+  if mergePool:
+    print '\n******************************************\nwaiting for the merging of the last datasets'
+    mergePool.close()
+    mergePool.join()
+    for merge in merges:
+      merge.get() # re-raise any exception of the merging
 
   #------------------------------------------
   #at last, go back to original directory
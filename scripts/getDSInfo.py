@@ -19,17 +19,25 @@ except:
     os.system("localSetupPyAMI")
     import pyAMI.client
 
+try:
+    import xAODAnaHelpers.metadata as xAH_metadata
+except ImportError:
+    import python.metadata as xAH_metadata
+
 import pyAMI.atlas.api as AtlasAPI
 import argparse
 
 parser = argparse.ArgumentParser(description='Generate SUSY metadata files.')
 parser.add_argument('input',metavar='dslist.txt',help='Distributions to compare')
 parser.add_argument('-o','--output',metavar='output_crosssections_13TeV.txt',type=str,default=None,help='Output file name')
+parser.add_argument('--cache',type=str,default=None,help='Metadata cache (sqlite) to read from and fill, default is $XAH_METADATA_CACHE or ~/.xah_metadata.sqlite')
 args=parser.parse_args()
 
 client = pyAMI.client.Client('atlas')
 AtlasAPI.init()
 
+cache = xAH_metadata.MetadataCache(args.cache)
+
 inputDS = []
 
 inputFile = open(args.input,"r")
@@ -44,6 +52,12 @@ for line in inputFile:
     dsID = dsName.split(".")[1]
     print dsName
 
+    cached = cache.get(dsName)
+    if cached and cached['evntDataset']:
+        print "\tUsing ",cached['evntDataset']
+        inputDS.append(cached['evntDataset'])
+        continue
+
     dsProv = AtlasAPI.get_dataset_prov(client,dataset=dsName)
     for prov in dsProv["node"]:
         if prov['dataType'] == "EVNT":
@@ -52,6 +66,7 @@ for line in inputFile:
             if thisProvDSID == dsID:
                 print "\tUsing ",thisProvDSName
                 inputDS.append(thisProvDSName)
+                cache.update(dsName, evntDataset=thisProvDSName)
 
 def getUnitSF(unit):
     if unit == "nano barn":
@@ -61,17 +76,27 @@ def getUnitSF(unit):
 
 fh_out=open(args.output,'w') if args.output!=None else None
 for ds in inputDS:
-    dsList = AtlasAPI.get_dataset_info(client,dataset=ds)
-    dsInfo = dsList[0]
-    #print dsInfo['logicalDatasetName']
-    #print "\tcross section",dsInfo["crossSection_mean"]
-    #print "\tfilter Eff.",dsInfo["GenFiltEff_mean"]
-    print "totalEvents:",dsInfo['totalEvents']
-    unit = dsInfo['crossSection_unit']
-    getSF = getUnitSF(unit)
+    # the dataset number and physics short are part of the EVNT dataset name
+    dsNumber, physicsShort = ds.split(':')[-1].split(".")[1:3]
+    cached = cache.get(ds)
+    if cached and None not in (cached['totalEvents'], cached['crossSection'], cached['filterEff']):
+        totalEvents, crossSection, filterEff = cached['totalEvents'], cached['crossSection'], cached['filterEff']
+    else:
+        dsList = AtlasAPI.get_dataset_info(client,dataset=ds)
+        dsInfo = dsList[0]
+        #print dsInfo['logicalDatasetName']
+        #print "\tcross section",dsInfo["crossSection_mean"]
+        #print "\tfilter Eff.",dsInfo["GenFiltEff_mean"]
+        unit = dsInfo['crossSection_unit']
+        getSF = getUnitSF(unit)
+        totalEvents  = int(dsInfo['totalEvents'])
+        crossSection = float(dsInfo["crossSection_mean"])*getSF
+        filterEff    = float(dsInfo["GenFiltEff_mean"])
+        cache.update(ds, totalEvents=totalEvents, crossSection=crossSection, filterEff=filterEff)
+    print "totalEvents:",totalEvents
     if fh_out==None:
-        print dsInfo['datasetNumber']," ",dsInfo['physicsShort']," ",float(dsInfo["crossSection_mean"])*getSF," 1.  ",float(dsInfo["GenFiltEff_mean"])," 1."
+        print dsNumber," ",physicsShort," ",crossSection," 1.  ",filterEff," 1."
     else:
-        fh_out.write("%s\t%s\t%e\t1.\t%e\t1.\n"%(dsInfo['datasetNumber'],dsInfo['physicsShort'],float(dsInfo["crossSection_mean"])*getSF,float(dsInfo["GenFiltEff_mean"])))
+        fh_out.write("%s\t%s\t%e\t1.\t%e\t1.\n"%(dsNumber,physicsShort,crossSection,filterEff))
 
 
@@ -1,6 +1,8 @@
 import optparse
 parser = optparse.OptionParser()
 parser.add_option('-i', '--input',           dest="inFileName",         default="", help="Input file name")
+parser.add_option('--cache',                 dest="cache",              default=None, help="Metadata cache (sqlite) to read from and fill, default is $XAH_METADATA_CACHE or ~/.xah_metadata.sqlite")
+parser.add_option('--batchSize',             dest="batchSize",          default=50, type="int", help="Number of datasets per AMI query for the datasets not in the cache")
 o, a = parser.parse_args()
 
 
@@ -13,13 +15,19 @@ except:
     import sys
     sys.exit(-1)
 
+try:
+    import xAODAnaHelpers.metadata as xAH_metadata
+except ImportError:
+    import python.metadata as xAH_metadata
+
 import pyAMI.atlas.api as AtlasAPI
 
 client = pyAMI.client.Client('atlas')
 AtlasAPI.init()
 
+cache = xAH_metadata.MetadataCache(o.cache)
+
 inputDS = []
-eventCounts = {}
 inputFile = open(o.inFileName,"r")
 
 for line in inputFile:
@@ -28,19 +36,15 @@ for line in inputFile:
     if not len(words): continue
     
     dsName = words[0].rstrip("/")
-    dsID = dsName.split(".")[1]
     print dsName
-
-    try: 
-        dsInfo = AtlasAPI.list_datasets(client, patterns = dsName, fields = ['events'])
-        nEvents = dsInfo[0]['events']
-    except: 
-        print "Skipping",dsName
-        continue
-    
-
     inputDS.append(dsName)
-    eventCounts[dsName] = nEvents
+
+# one AMI query per batch of datasets which are not cached yet
+metadata = xAH_metadata.fetch_events(cache, client, inputDS, o.batchSize)
 
 for ds in inputDS:
-    print ds,"\t",eventCounts[ds]
+    nEvents = metadata.get(xAH_metadata.dataset_name(ds), {}).get('events')
+    if nEvents is None:
+        print "Skipping",ds
+        continue
+    print ds,"\t",nEvents
@@ -0,0 +1,92 @@
+#!/usr/bin/env python
+# PYTHON_ARGCOMPLETE_OK
+# @file:    xAH_benchmark.py
+# @purpose: measure the throughput of an algorithm chain
+#
+# @example:
+# @code
+# xAH_benchmark.py --files reference.DAOD.root --config path/to/chain.py --nevents 5000 --json benchmark.json
+# @endcode
+#
+
+from __future__ import print_function
+
+import argparse
+try: import argcomplete
+except: pass
+import json
+import os
+import resource
+import shutil
+import subprocess
+import sys
+import tempfile
+import time
+
+try:
+  import xAODAnaHelpers.report as xAH_report
+except ImportError:
+  import python.report as xAH_report
+
+# the wrapper configuration handed to xAH_run.py: it loads the user configuration and
+# switches on the per-algorithm timing (xAH::Algorithm::m_doTiming) for every algorithm of the chain
+wrapperConfig = """
+import xAODAnaHelpers.utils as xAH_utils
+
+c = xAH_utils.load_config({config!r}, args)
+
+for alg in c._algorithms:
+  if hasattr(alg, 'm_doTiming'): alg.m_doTiming = True
+"""
+
+if __name__ == "__main__":
+  parser = argparse.ArgumentParser(description='Benchmark an xAH algorithm chain on a fixed input, using the direct driver.',
+                                   formatter_class=argparse.ArgumentDefaultsHelpFormatter)
+  parser.add_argument('--files', metavar='file', type=str, nargs='+', required=True, help='reference input file(s)')
+  parser.add_argument('--config', metavar='', type=str, required=True, help='configuration of the algorithm chain, as given to xAH_run.py')
+  parser.add_argument('--nevents', metavar='<n>', type=int, default=0, help='number of events to process (0 = no limit)')
+  parser.add_argument('--json', metavar='<file>', type=str, default=None, help='write the results to this file instead of stdout')
+  parser.add_argument('--submitDir', metavar='<directory>', type=str, default=None, help='output directory of the job. A temporary one is used (and removed) if not set.')
+  parser.add_argument('--isMC', action='store_true', help='passed on to xAH_run.py')
+  parser.add_argument('--label', metavar='<name>', type=str, default='', help='free-form label stored along the results, e.g. the xAH tag')
+
+  try: argcomplete.autocomplete(parser)
+  except: pass
+  args = parser.parse_args()
+
+  config = os.path.abspath(args.config)
+  if not os.path.isfile(config):
+    raise OSError('Configuration {0:s} does not exist.'.format(config))
+
+  workDir = tempfile.mkdtemp(prefix='xAH_benchmark_')
+  submitDir = os.path.abspath(args.submitDir) if args.submitDir else os.path.join(workDir, 'submitDir')
+
+  try:
+    wrapper = os.path.join(workDir, 'benchmark_config.py')
+    with open(wrapper, 'w') as f:
+      f.write(wrapperConfig.format(config=config))
+
+    cmd = ['xAH_run.py', '--files'] + args.files + ['--config', wrapper, '--submitDir', submitDir, '--nevents', str(args.nevents), '--force']
+    if args.isMC: cmd.append('--isMC')
+    cmd.append('direct')
+
+    start = time.time()
+    returncode = subprocess.call(cmd)
+    wallTime = time.time() - start
+    if returncode != 0:
+      raise RuntimeError('xAH_run.py failed with exit code {0:d}'.format(returncode))
+
+    # ru_maxrss is in kilobytes on linux, and in bytes on macOS
+    peakRSS = resource.getrusage(resource.RUSAGE_CHILDREN).ru_maxrss
+    if sys.platform != 'darwin': peakRSS *= 1024
+
+    results = xAH_report.job_report(submitDir, wallTime, peakRSS, label=args.label, config=config, files=args.files)
+
+    if args.json:
+      with open(args.json, 'w') as f:
+        json.dump(results, f, indent=2, sort_keys=True)
+    else:
+      print(json.dumps(results, indent=2, sort_keys=True))
+
+  finally:
+    shutil.rmtree(workDir, ignore_errors=True)
@@ -0,0 +1,132 @@
+#!/usr/bin/env python
+# PYTHON_ARGCOMPLETE_OK
+# @file:    xAH_benchmarkSuite.py
+# @purpose: run the reference configurations of data/benchmarks and compare their results between tags
+#
+# @example:
+# @code
+# xAH_benchmarkSuite.py run --dataFiles data.DAOD.root --mcFiles mc.DAOD.root --nevents 5000 --label xAH-1.2.3 --json suite-1.2.3.json
+# xAH_benchmarkSuite.py compare suite-1.2.2.json suite-1.2.3.json --threshold 0.05
+# @endcode
+#
+
+from __future__ import print_function
+
+import argparse
+try: import argcomplete
+except: pass
+import json
+import os
+import platform
+import subprocess
+import sys
+import tempfile
+import time
+
+try:
+  import xAODAnaHelpers.report as xAH_report
+except ImportError:
+  import python.report as xAH_report
+
+def suite_directory():
+  """ The installed data/benchmarks directory, or the one of the source tree when running from it. """
+  try:
+    import ROOT
+    path = ROOT.PathResolver.FindCalibDirectory("xAODAnaHelpers/benchmarks")
+    if path: return path
+  except Exception:
+    pass
+  return os.path.join(os.path.dirname(os.path.abspath(__file__)), os.pardir, 'data', 'benchmarks')
+
+def run(args):
+  suiteDir = os.path.abspath(args.suite or suite_directory())
+  with open(os.path.join(suiteDir, 'suite.json')) as f:
+    suite = json.load(f)
+
+  files = {'data': args.dataFiles, 'mc': args.mcFiles}
+  results = {'label': args.label,
+             'created': time.strftime('%Y-%m-%dT%H:%M:%S'),
+             'host': platform.node(),
+             'machine': platform.machine(),
+             'release': os.environ.get('AnalysisBase_VERSION', ''),
+             'nevents': args.nevents,
+             'configs': {}}
+
+  failed = []
+  for entry in suite:
+    name = entry['name']
+    if args.only and name not in args.only: continue
+    if not files[entry['sample']]:
+      print('Skipping {0:s}: no --{1:s}Files given.'.format(name, entry['sample']))
+      continue
+
+    fd, report = tempfile.mkstemp(prefix='xAH_benchmarkSuite_', suffix='.json')
+    os.close(fd)
+    try:
+      cmd = ['xAH_benchmark.py', '--files'] + files[entry['sample']] + ['--config', os.path.join(suiteDir, entry['config']),
+             '--nevents', str(args.nevents), '--json', report, '--label', args.label]
+      if entry['sample'] == 'mc': cmd.append('--isMC')
+      print('Running {0:s}'.format(name))
+      if subprocess.call(cmd) != 0:
+        failed.append(name)
+        continue
+      with open(report) as f:
+        result = json.load(f)
+      # a chain that ran but processed nothing (wrong tree, empty output) has no throughput to compare
+      if not result.get('events'):
+        print('{0:s} processed no events'.format(name))
+        failed.append(name)
+        continue
+      results['configs'][name] = result
+    finally:
+      os.remove(report)
+
+  with open(args.json, 'w') as f:
+    json.dump(results, f, indent=2, sort_keys=True)
+  print('Results of {0:d} configuration(s) written to {1:s}'.format(len(results['configs']), args.json))
+  if failed:
+    print('Failed: {0:s}'.format(', '.join(failed)))
+    return 1
+  return 0
+
+def compare(args):
+  with open(args.reference) as f: reference = json.load(f)
+  with open(args.candidate) as f: candidate = json.load(f)
+
+  rows = xAH_report.compare_suites(reference, candidate, args.threshold)
+  print('{0:s} -> {1:s}'.format(reference.get('label') or args.reference, candidate.get('label') or args.candidate))
+  print('{0:<16s} {1:<28s} {2:>14s} {3:>14s} {4:>9s}'.format('configuration', 'metric', 'reference', 'candidate', 'change'))
+  for name, metric, ref, new, change, regression in rows:
+    print('{0:<16s} {1:<28s} {2:>14.6g} {3:>14.6g} {4:>+8.1%}{5:s}'.format(name, metric, ref, new, change, '  REGRESSION' if regression else ''))
+
+  if args.json:
+    with open(args.json, 'w') as f:
+      json.dump([dict(zip(['configuration', 'metric', 'reference', 'candidate', 'change', 'regression'], row)) for row in rows], f, indent=2)
+
+  return 1 if any(row[-1] for row in rows) else 0
+
+if __name__ == "__main__":
+  parser = argparse.ArgumentParser(description='Throughput regression suite: run the reference configurations of xAODAnaHelpers/data/benchmarks with xAH_benchmark.py, and compare the results of two tags.',
+                                   formatter_class=argparse.ArgumentDefaultsHelpFormatter)
+  subparsers = parser.add_subparsers(dest='command')
+
+  runParser = subparsers.add_parser('run', help='run the suite', formatter_class=argparse.ArgumentDefaultsHelpFormatter)
+  runParser.add_argument('--dataFiles', metavar='file', type=str, nargs='+', default=[], help='reference data input file(s)')
+  runParser.add_argument('--mcFiles', metavar='file', type=str, nargs='+', default=[], help='reference MC input file(s)')
+  runParser.add_argument('--nevents', metavar='<n>', type=int, default=5000, help='number of events to process per configuration (0 = no limit)')
+  runParser.add_argument('--label', metavar='<name>', type=str, required=True, help='tag the results are for')
+  runParser.add_argument('--json', metavar='<file>', type=str, required=True, help='file to write the results to')
+  runParser.add_argument('--suite', metavar='<directory>', type=str, default=None, help='directory of suite.json and the configurations, instead of the installed data/benchmarks')
+  runParser.add_argument('--only', metavar='name', type=str, nargs='+', default=[], help='only run these configurations')
+
+  compareParser = subparsers.add_parser('compare', help='compare the results of two tags', formatter_class=argparse.ArgumentDefaultsHelpFormatter)
+  compareParser.add_argument('reference', type=str, help='results of the reference tag')
+  compareParser.add_argument('candidate', type=str, help='results of the new tag')
+  compareParser.add_argument('--threshold', metavar='<fraction>', type=float, default=0.1, help='relative change counted as a regression')
+  compareParser.add_argument('--json', metavar='<file>', type=str, default=None, help='also write the comparison to this file')
+
+  try: argcomplete.autocomplete(parser)
+  except: pass
+  args = parser.parse_args()
+
+  sys.exit(run(args) if args.command == 'run' else compare(args))
@@ -0,0 +1,60 @@
+#!/usr/bin/env python
+# PYTHON_ARGCOMPLETE_OK
+# @file:    xAH_fillBenchmark.py
+# @purpose: time the Fill*() and clear() functions of the tree containers on synthetic objects
+#
+# @example:
+# @code
+# xAH_fillBenchmark.py --jets "kinematic" "kinematic clean energy layer trackPV" --muons "kinematic isolation quality" --json fill.json
+# @endcode
+#
+
+from __future__ import print_function
+
+import argparse
+try: import argcomplete
+except: pass
+import json
+import sys
+
+if __name__ == "__main__":
+  parser = argparse.ArgumentParser(description='Micro-benchmark of the Fill*() and clear() functions of the tree containers, see xAH::FillBenchmark. Preload libxAODAnaHelpersAllocationCounting.so to also count the allocations.',
+                                   formatter_class=argparse.ArgumentDefaultsHelpFormatter)
+  parser.add_argument('--jets', metavar='detailStr', type=str, nargs='*', default=[], help='detail strings of xAH::JetContainer to benchmark')
+  parser.add_argument('--muons', metavar='detailStr', type=str, nargs='*', default=[], help='detail strings of xAH::MuonContainer to benchmark')
+  parser.add_argument('--electrons', metavar='detailStr', type=str, nargs='*', default=[], help='detail strings of xAH::ElectronContainer to benchmark')
+  parser.add_argument('--objects', metavar='<n>', type=int, default=10, help='number of objects per event')
+  parser.add_argument('--events', metavar='<n>', type=int, default=10000, help='number of events, each filling all the objects then clearing')
+  parser.add_argument('--data', action='store_true', help='configure the containers for data instead of simulation')
+  parser.add_argument('--json', metavar='<file>', type=str, default=None, help='write the results to this file instead of stdout')
+
+  try: argcomplete.autocomplete(parser)
+  except: pass
+  args = parser.parse_args()
+
+  if not (args.jets or args.muons or args.electrons):
+    parser.error('nothing to benchmark, give detail strings to --jets, --muons or --electrons')
+
+  import ROOT
+  ROOT.gROOT.SetBatch(True)
+  ROOT.xAOD.Init("xAH_fillBenchmark").ignore()
+
+  benchmarks = [(ROOT.xAH.FillBenchmark.jets, d) for d in args.jets]
+  benchmarks += [(ROOT.xAH.FillBenchmark.muons, d) for d in args.muons]
+  benchmarks += [(ROOT.xAH.FillBenchmark.electrons, d) for d in args.electrons]
+
+  results = []
+  for benchmark, detailStr in benchmarks:
+    r = benchmark(detailStr, args.objects, args.events, not args.data)
+    result = dict((key, getattr(r, key)) for key in ['objects', 'events', 'fillNsPerObject', 'clearNsPerEvent', 'allocationsPerObject', 'bytesPerObject'])
+    result.update(container=str(r.container), detailStr=str(r.detailStr), error=str(r.error))
+    if result['allocationsPerObject'] < 0: result['allocationsPerObject'] = result['bytesPerObject'] = None
+    if result['error']:
+      print('{0:s} "{1:s}" failed: {2:s}'.format(result['container'], detailStr, result['error']), file=sys.stderr)
+    results.append(result)
+
+  if args.json:
+    with open(args.json, 'w') as f:
+      json.dump(results, f, indent=2, sort_keys=True)
+  else:
+    print(json.dumps(results, indent=2, sort_keys=True))
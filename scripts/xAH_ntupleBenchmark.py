@@ -0,0 +1,240 @@
+#!/usr/bin/env python
+# PYTHON_ARGCOMPLETE_OK
+# @file:    xAH_ntupleBenchmark.py
+# @purpose: compare the write and read cost of the TreeAlgo output layouts
+#
+# @example:
+# @code
+# xAH_ntupleBenchmark.py --files reference.DAOD.root --config path/to/chain.py --nevents 5000 --json layouts.json
+# @endcode
+#
+
+from __future__ import print_function
+
+import argparse
+try: import argcomplete
+except: pass
+import glob
+import json
+import os
+import shutil
+import subprocess
+import sys
+import tempfile
+import time
+
+try:
+  import xAODAnaHelpers.report as xAH_report
+except ImportError:
+  import python.report as xAH_report
+
+# the layouts of the output, as changes of the TreeAlgo options of the user configuration
+layouts = {
+  'default': 'the TreeAlgo options of the configuration, one tree per systematic',
+  'variedBranchesOnly': 'm_variedBranchesOnly: the systematic trees only hold the varied collections, read as friends of the nominal tree',
+  'flatArrays': 'flatArrays detail for the jet containers: flat constituent branches',
+  'float16': 'Float16_10:* on every particle detail string: floats rounded to 10 mantissa bits',
+  'lz4': 'm_compressionSettings 404: LZ4 level 4',
+}
+# the layouts proposed for which the trees cannot be written by HelpTreeBase
+unsupported = {
+  'singleTree': 'all the systematics in one tree is not a HelpTreeBase output option',
+  'rntuple': 'HelpTreeBase only writes TTrees',
+}
+
+particleDetails = ['m_muDetailStr', 'm_elDetailStr', 'm_jetDetailStr', 'm_trigJetDetailStr', 'm_truthJetDetailStr', 'm_fatJetDetailStr',
+                   'm_truthFatJetDetailStr', 'm_tauDetailStr', 'm_photonDetailStr', 'm_clusterDetailStr', 'm_truthParticlesDetailStr',
+                   'm_trackParticlesDetailStr']
+
+# the wrapper configuration handed to xAH_run.py: it loads the user configuration, switches on
+# the timing and changes the TreeAlgo options of the chain for the layout
+wrapperConfig = """
+import json
+import xAODAnaHelpers.utils as xAH_utils
+
+userConfig = {config!r}
+layout = {layout!r}
+treeAlgosFile = {treeAlgosFile!r}
+c = xAH_utils.load_config(userConfig, args)
+
+treeAlgos = []
+for alg in c._algorithms:
+  if hasattr(alg, 'm_doTiming'): alg.m_doTiming = True
+  if not hasattr(alg, 'm_variedBranchesOnly'): continue
+  treeAlgos.append(str(alg.m_name))
+  if layout == 'variedBranchesOnly': alg.m_variedBranchesOnly = True
+  elif layout == 'lz4': alg.m_compressionSettings = 404
+  elif layout == 'flatArrays':
+    for option in ['m_jetDetailStr', 'm_trigJetDetailStr', 'm_truthJetDetailStr', 'm_fatJetDetailStr', 'm_truthFatJetDetailStr']:
+      if str(getattr(alg, option)): setattr(alg, option, str(getattr(alg, option)) + ' flatArrays')
+  elif layout == 'float16':
+    for option in {details!r}:
+      if str(getattr(alg, option)): setattr(alg, option, str(getattr(alg, option)) + ' Float16_10:*')
+
+with open(treeAlgosFile, 'w') as f:
+  json.dump(treeAlgos, f)
+"""
+
+# the read loops, compiled once so that the python loop does not dominate the timing
+readers = """
+#include <string>
+#include <vector>
+#include "TTree.h"
+
+double xAH_ntupleBenchmark_read(TTree* tree, const std::vector<std::string>& branches) {
+  tree->SetBranchStatus("*", branches.empty());
+  for(const auto& branch: branches) tree->SetBranchStatus(branch.c_str(), 1);
+  double bytes = 0;
+  for(Long64_t entry = 0; entry < tree->GetEntries(); ++entry) bytes += tree->GetEntry(entry);
+  tree->SetBranchStatus("*", 1);
+  return bytes;
+}
+
+template <typename CONTAINER>
+double xAH_ntupleBenchmark_readBack(TTree* tree, CONTAINER& container) {
+  container.setTree(tree);
+  double objects = 0;
+  for(Long64_t entry = 0; entry < tree->GetEntries(); ++entry) {
+    tree->GetEntry(entry);
+    container.updateEntry();
+    objects += container.particles().size();
+  }
+  tree->ResetBranchAddresses();
+  return objects;
+}
+"""
+
+def find_nominal(tfile):
+  """ The nominal tree of the TreeAlgo output, in the directory named after the TreeAlgo. """
+  for key in tfile.GetListOfKeys():
+    obj = key.ReadObj()
+    if obj.InheritsFrom('TDirectory') and obj.Get('nominal'):
+      return obj.Get('nominal')
+  return tfile.Get('nominal')
+
+def timed(fn, *args):
+  start = time.time()
+  result = fn(*args)
+  return result, time.time() - start
+
+def measure_reads(fname, branches, readBack):
+  """ Read throughput (events/s) of the nominal tree: every branch, the partial-read branches only, the same through RDataFrame, and through the xAH read-back containers. """
+  import ROOT
+  f = ROOT.TFile.Open(fname)
+  tree = find_nominal(f)
+  if not tree: raise RuntimeError('No nominal tree in {0:s}'.format(fname))
+  nEntries = tree.GetEntries()
+  rate = lambda seconds: nEntries/seconds if seconds > 0 else 0.
+  if not branches: branches = [b.GetName() for b in tree.GetListOfBranches()][:5]
+
+  reads = {'entries': nEntries, 'partial_branches': branches}
+  # the first pass warms the page cache, so that the layouts are compared on decompression and deserialisation
+  ROOT.xAH_ntupleBenchmark_read(tree, ROOT.std.vector('std::string')())
+  _, seconds = timed(ROOT.xAH_ntupleBenchmark_read, tree, ROOT.std.vector('std::string')())
+  reads['full_events_per_second'] = rate(seconds)
+
+  selected = ROOT.std.vector('std::string')()
+  for b in branches: selected.push_back(b)
+  _, seconds = timed(ROOT.xAH_ntupleBenchmark_read, tree, selected)
+  reads['partial_events_per_second'] = rate(seconds)
+
+  df = ROOT.RDataFrame(tree)
+  sums = []
+  for i, b in enumerate(branches):
+    isVector = tree.GetBranch(b).GetClassName().startswith('vector')
+    sums.append(df.Define('xah_col{0:d}'.format(i), '(double)ROOT::VecOps::Sum({0:s})'.format(b) if isVector else '(double){0:s}'.format(b)).Sum('xah_col{0:d}'.format(i)))
+  _, seconds = timed(lambda: sums[0].GetValue())
+  reads['rdataframe_partial_events_per_second'] = rate(seconds)
+
+  for name, (cls, prefix, detailStr) in readBack.items():
+    if not tree.GetBranch(prefix + '_pt') and not tree.GetBranch('n' + prefix):
+      continue
+    container = getattr(ROOT.xAH, cls)(prefix, detailStr, 1., True)
+    _, seconds = timed(ROOT.xAH_ntupleBenchmark_readBack, tree, container)
+    reads['readback_{0:s}_events_per_second'.format(name)] = rate(seconds)
+
+  f.Close()
+  return reads
+
+if __name__ == "__main__":
+  parser = argparse.ArgumentParser(description='Write the same events in each output layout of TreeAlgo, and compare the file size, the write time and the read throughput.',
+                                   formatter_class=argparse.ArgumentDefaultsHelpFormatter)
+  parser.add_argument('--files', metavar='file', type=str, nargs='+', required=True, help='reference input file(s)')
+  parser.add_argument('--config', metavar='', type=str, required=True, help='configuration of the algorithm chain with a TreeAlgo, as given to xAH_run.py')
+  parser.add_argument('--layouts', metavar='layout', type=str, nargs='+', default=sorted(layouts), choices=sorted(layouts) + sorted(unsupported), help='layouts to compare')
+  parser.add_argument('--branches', metavar='branch', type=str, nargs='*', default=[], help='branches of the partial reads, the first 5 of the nominal tree if not set')
+  parser.add_argument('--jetBranchName', metavar='<name>', type=str, default='jet', help='prefix of the jet branches, for the read-back through xAH::JetContainer')
+  parser.add_argument('--jetDetailStr', metavar='<detail>', type=str, default='kinematic', help='detail string of the read-back through xAH::JetContainer')
+  parser.add_argument('--muonDetailStr', metavar='<detail>', type=str, default='kinematic', help='detail string of the read-back through xAH::MuonContainer')
+  parser.add_argument('--electronDetailStr', metavar='<detail>', type=str, default='kinematic', help='detail string of the read-back through xAH::ElectronContainer')
+  parser.add_argument('--nevents', metavar='<n>', type=int, default=0, help='number of events to process (0 = no limit)')
+  parser.add_argument('--isMC', action='store_true', help='passed on to xAH_run.py')
+  parser.add_argument('--json', metavar='<file>', type=str, default=None, help='write the results to this file instead of stdout')
+  parser.add_argument('--keep', metavar='<directory>', type=str, default=None, help='keep the submission directories of the layouts in this directory')
+
+  try: argcomplete.autocomplete(parser)
+  except: pass
+  args = parser.parse_args()
+
+  config = os.path.abspath(args.config)
+  if not os.path.isfile(config):
+    raise OSError('Configuration {0:s} does not exist.'.format(config))
+
+  import ROOT
+  ROOT.gROOT.SetBatch(True)
+  ROOT.gInterpreter.Declare(readers)
+  readBack = {
+    'jets': ('JetContainer', args.jetBranchName, args.jetDetailStr),
+    'muons': ('MuonContainer', 'muon', args.muonDetailStr),
+    'electrons': ('ElectronContainer', 'el', args.electronDetailStr),
+  }
+
+  workDir = os.path.abspath(args.keep) if args.keep else tempfile.mkdtemp(prefix='xAH_ntupleBenchmark_')
+  results = {}
+  try:
+    for layout in args.layouts:
+      if layout in unsupported:
+        results[layout] = {'skipped': unsupported[layout]}
+        continue
+
+      submitDir = os.path.join(workDir, layout)
+      wrapper = os.path.join(workDir, 'config_{0:s}.py'.format(layout))
+      treeAlgosFile = os.path.join(workDir, 'treeAlgos_{0:s}.json'.format(layout))
+      with open(wrapper, 'w') as f:
+        f.write(wrapperConfig.format(config=config, layout=layout, details=particleDetails, treeAlgosFile=treeAlgosFile))
+
+      cmd = ['xAH_run.py', '--files'] + args.files + ['--config', wrapper, '--submitDir', submitDir, '--nevents', str(args.nevents), '--force']
+      if args.isMC: cmd.append('--isMC')
+      cmd.append('direct')
+
+      start = time.time()
+      returncode = subprocess.call(cmd)
+      wallTime = time.time() - start
+      if returncode != 0:
+        results[layout] = {'error': 'xAH_run.py failed with exit code {0:d}'.format(returncode)}
+        continue
+
+      treeFiles = sorted(glob.glob(os.path.join(submitDir, 'data-tree', '*.root')))
+      if not treeFiles:
+        results[layout] = {'error': 'no tree output, is there a TreeAlgo in the configuration?'}
+        continue
+
+      timing = xAH_report.read_timing(submitDir)
+      with open(treeAlgosFile) as f:
+        treeAlgos = json.load(f)
+      results[layout] = {
+        'description': layouts[layout],
+        'file_bytes': sum(os.path.getsize(f) for f in treeFiles),
+        'write_wall_time': wallTime,
+        'tree_algorithm_time': sum(timing.get(name, {}).get('wall_total', 0.) for name in treeAlgos),
+        'read': measure_reads(treeFiles[0], args.branches, readBack),
+      }
+
+    if args.json:
+      with open(args.json, 'w') as f:
+        json.dump(results, f, indent=2, sort_keys=True)
+    else:
+      print(json.dumps(results, indent=2, sort_keys=True))
+
+  finally:
+    if not args.keep: shutil.rmtree(workDir, ignore_errors=True)
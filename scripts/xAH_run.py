@@ -21,6 +21,10 @@ import os
 import subprocess
 import sys
 import datetime
+import hashlib
+import json
+import math
+import multiprocessing
 import time
 
 try:
@@ -32,6 +36,8 @@ try:
     import xAODAnaHelpers
     import xAODAnaHelpers.cli_options as xAH_cli_options
     import xAODAnaHelpers.utils as xAH_utils
+    import xAODAnaHelpers.metadata as xAH_metadata
+    import xAODAnaHelpers.report as xAH_report
 
 # this is the situation when you're running xAH_run.py without having installed xAODAnaHelpers
 # mostly needed to build documentation
@@ -39,6 +45,8 @@ except ImportError:
     import python as xAODAnaHelpers
     import python.cli_options as xAH_cli_options
     import python.utils as xAH_utils
+    import python.metadata as xAH_metadata
+    import python.report as xAH_report
 
 #
 # Load default options configuration
@@ -54,6 +62,8 @@ if config.has_section('prun'     ): xAH_utils.update_clioption_defaults(xAH_cli_
 if config.has_section('condor'   ): xAH_utils.update_clioption_defaults(xAH_cli_options.drivers_condor   , dict(config.items('condor'   )))
 if config.has_section('lsf'      ): xAH_utils.update_clioption_defaults(xAH_cli_options.drivers_lsf      , dict(config.items('lsf'      )))
 if config.has_section('slurm'    ): xAH_utils.update_clioption_defaults(xAH_cli_options.drivers_slurm    , dict(config.items('slurm'    )))
+if config.has_section('local'    ): xAH_utils.update_clioption_defaults(xAH_cli_options.drivers_local    , dict(config.items('local'    )))
+if config.has_section('local-parallel'): xAH_utils.update_clioption_defaults(xAH_cli_options.drivers_local_parallel, dict(config.items('local-parallel')))
 
 #
 # if we want multiple custom formatters, use inheriting
@@ -155,6 +165,13 @@ local = drivers_parser.add_parser('local',
                                   help='Run using the LocalDriver',
                                   usage=baseUsageStr.format('local'),
                                   formatter_class=lambda prog: CustomFormatter(prog, max_help_position=30))
+xAH_utils.register_on_parser(xAH_cli_options.drivers_local, local)
+
+local_parallel = drivers_parser.add_parser('local-parallel',
+                                           help='Run in several processes on this machine using the LocalDriver, splitting the input between them and merging the outputs at the end',
+                                           usage=baseUsageStr.format('local-parallel'),
+                                           formatter_class=lambda prog: CustomFormatter(prog, max_help_position=30))
+xAH_utils.register_on_parser(xAH_cli_options.drivers_local_parallel, local_parallel)
 
 
 # start the script
@@ -265,7 +282,7 @@ if __name__ == "__main__":
     elif args.driver == 'slurm':
       if getattr(ROOT.EL, 'SlurmDriver') is None:
         raise KeyError('Cannot load the SLURM driver from EventLoop. Did you not compile it?')
-    elif args.driver == 'local':
+    elif args.driver in ['local', 'local-parallel']:
       if getattr(ROOT.EL, 'LocalDriver') is None:
         raise KeyError('Cannot load the Local driver from EventLoop. Did you not compile it?')
 
@@ -373,6 +390,26 @@ if __name__ == "__main__":
           MBJ_logger.info(" - changing sample name from {0:s} to {1:s}".format(sample.meta().getString(ROOT.SH.MetaFields.sampleName), sampleName))
           sample.meta().setString(ROOT.SH.MetaFields.sampleName, sampleName)
 
+    if args.order_by_run:
+      if args.driver == 'prun':
+        xAH_logger.warning("--orderByRun has no effect on the grid, the files are split into jobs by the grid")
+      else:
+        sh_all = xAH_utils.sort_samples_by_run(sh_all, args.treeName)
+
+    if args.metadata_cache is not None:
+      cache = xAH_metadata.MetadataCache(args.metadata_cache)
+      xAH_logger.info("Reading sample metadata from {0:s}".format(cache.path))
+      for sample in sh_all:
+        metadata = cache.get(sample.name())
+        if metadata is None:
+          xAH_logger.warning(" - no cached metadata for {0:s}".format(sample.name()))
+          continue
+        nEvents = metadata['events'] if metadata['events'] is not None else metadata['totalEvents']
+        for field, value in [(ROOT.SH.MetaFields.crossSection, metadata['crossSection']), (ROOT.SH.MetaFields.filterEfficiency, metadata['filterEff']), (ROOT.SH.MetaFields.numEvents, nEvents), ('sumW', metadata['sumW'])]:
+          if value is None or sample.meta().castDouble(field, -1) >= 0: continue  # unknown, or set by the sample configuration
+          sample.meta().setDouble(field, float(value))
+          xAH_logger.info(" - {0:s}: {1:s} = {2}".format(sample.name(), field, value))
+
     # print out the samples we found
     xAH_logger.info("\t%d different dataset(s) found", len(sh_all))
         #if not args.use_scanRucio:
@@ -384,6 +421,36 @@ if __name__ == "__main__":
       xAH_logger.info("No datasets found. Exiting.")
       sys.exit(0)
 
+    if args.job_runtime is not None:
+      if args.driver not in ['condor', 'lsf', 'slurm', 'local', 'local-parallel']:
+        xAH_logger.warning("--jobRunTime has no effect with the {0:s} driver".format(args.driver))
+      else:
+        eventsPerSecond = args.events_per_second
+        if eventsPerSecond is None and args.benchmark_json is not None:
+          with open(args.benchmark_json) as f:
+            eventsPerSecond = json.load(f)['events_per_second']
+          xAH_logger.info("Throughput from {0:s}: {1:.1f} events/s".format(args.benchmark_json, eventsPerSecond))
+        if not eventsPerSecond or eventsPerSecond <= 0:
+          raise ValueError("--jobRunTime needs the expected throughput, from --eventsPerSecond or --benchmark")
+        # equal numbers of events per job, EventLoop splits the files by their event counts (SH::scanNEvents below)
+        args.optEventsPerWorker = float(max(1, int(eventsPerSecond*args.job_runtime)))
+        args.optFilesPerWorker = None
+        xAH_logger.info("Splitting into jobs of {0:.0f} s at {1:.1f} events/s: optEventsPerWorker = {2:.0f}".format(args.job_runtime, eventsPerSecond, args.optEventsPerWorker))
+
+    if args.driver == 'local-parallel':
+      if args.optNumParallelProcs <= 0:
+        args.optNumParallelProcs = multiprocessing.cpu_count()
+      if args.optEventsPerWorker is None and args.optFilesPerWorker is None and all(sample.meta().castDouble(ROOT.SH.MetaFields.numEvents, 0) > 0 for sample in sh_all):
+        # the event counts are known already, split by files rather than opening every one of them
+        nFilesTotal = sum(sample.numFiles() for sample in sh_all)
+        args.optFilesPerWorker = float(max(1, int(math.ceil(float(nFilesTotal)/args.optNumParallelProcs))))
+        xAH_logger.info("Splitting %d files over %d worker processes: optFilesPerWorker = %d", nFilesTotal, args.optNumParallelProcs, args.optFilesPerWorker)
+      elif args.optEventsPerWorker is None and args.optFilesPerWorker is None:
+        ROOT.SH.scanNEvents(sh_all)
+        nEventsTotal = sum(sample.meta().castDouble(ROOT.SH.MetaFields.numEvents, 0) for sample in sh_all)
+        args.optEventsPerWorker = float(max(1, int(math.ceil(nEventsTotal/args.optNumParallelProcs))))
+        xAH_logger.info("Splitting %d events over %d worker processes: optEventsPerWorker = %d", nEventsTotal, args.optNumParallelProcs, args.optEventsPerWorker)
+
     if args.optEventsPerWorker is not None:
       xAH_logger.info("Splitting up events onto each worker. optEventsPerWorker was set!")
       ROOT.SH.scanNEvents(sh_all)
@@ -416,15 +483,21 @@ if __name__ == "__main__":
       xAH_logger.info("\tskipping first %d events", args.skip_events)
       job.options().setDouble(ROOT.EL.Job.optSkipEvents, args.skip_events)
 
-    # should be configurable
-    job.options().setDouble(ROOT.EL.Job.optCacheSize, 50*1024*1024)
-    job.options().setDouble(ROOT.EL.Job.optCacheLearnEntries, 50)
+    xAH_logger.info("\tread cache of %d bytes, learning for %d entries", args.cache_size, args.cache_learn_entries)
+    job.options().setDouble(ROOT.EL.Job.optCacheSize, args.cache_size)
+    job.options().setDouble(ROOT.EL.Job.optCacheLearnEntries, args.cache_learn_entries)
 
     if args.variable_stats:
       xAH_logger.info("\tprinting variable statistics")
       job.options().setDouble(ROOT.EL.Job.optXAODPerfStats, 1)
       job.options().setDouble(ROOT.EL.Job.optPrintPerFileStats, 1)
 
+    if args.xaod_perf_stats:
+      job.options().setDouble(ROOT.EL.Job.optXAODPerfStats, 1)
+
+    if args.xaod_read_stats:
+      job.options().setDouble(ROOT.EL.Job.optXAODReadStats, 1)
+
     # access mode branch
     if args.access_mode == 'branch':
       xAH_logger.info("\tusing branch access mode: ROOT.EL.Job.optXaodAccessMode_branch")
@@ -442,7 +515,22 @@ if __name__ == "__main__":
     from xAODAnaHelpers import Config
     configurator = None
 
-    if ".json" in args.config:
+    # the cache is keyed by everything the configuration code can depend on
+    compiledConfig = None
+    if args.config_cache:
+      with open(args.config, 'rb') as f:
+        configKey = hashlib.sha1(f.read())
+      configKey.update(json.dumps(dict((k, v) for k, v in vars(args).items() if k not in ['submit_dir', 'force_overwrite']), sort_keys=True, default=str).encode('utf-8'))
+      configKey.update(str(ROOT.gROOT.GetVersion()).encode('utf-8'))
+      configKey.update(os.environ.get('AnalysisBase_VERSION', '').encode('utf-8'))
+      compiledConfig = os.path.join(os.path.abspath(os.path.expanduser(args.config_cache)), configKey.hexdigest()[:16] + '.root')
+      if os.path.exists(compiledConfig):
+        xAH_logger.info("Loading the compiled configuration {0:s}".format(compiledConfig))
+        configurator = Config.load(compiledConfig)
+
+    if configurator is not None:
+      pass
+    elif ".json" in args.config:
       # parse_json is json.load + stripping comments
       xAH_logger.debug("Loading json files")
       algConfigs = xAH_utils.parse_json(args.config)
@@ -462,6 +550,11 @@ if __name__ == "__main__":
           configurator = v
           break
 
+    if compiledConfig and not os.path.exists(compiledConfig):
+      if not os.path.isdir(os.path.dirname(compiledConfig)): os.makedirs(os.path.dirname(compiledConfig))
+      configurator.save(compiledConfig)
+      xAH_logger.info("Saved the compiled configuration to {0:s}".format(compiledConfig))
+
     # setting sample metadata
     for pattern, metadata in configurator._samples.items():
       found_matching_sample = False
@@ -495,6 +588,159 @@ if __name__ == "__main__":
         if isinstance(alg, ROOT.EL.NTupleSvc) and not job.outputHas(alg.GetName()):
           job.outputAdd(ROOT.EL.OutputStream(alg.GetName()))
 
+    # the forked workers of BasicEventSelection only hand their histograms back, an output stream would miss their events
+    forking = [alg.GetName() for alg in configurator._algorithms if getattr(alg, 'm_forkWorkers', 1) > 1]
+    if forking:
+      streams = sorted(configurator._outputs)
+      if hasattr(ROOT.EL, 'NTupleSvc'):
+        streams += [alg.GetName() for alg in configurator._algorithms if isinstance(alg, ROOT.EL.NTupleSvc)]
+      if streams:
+        raise ValueError("m_forkWorkers of {0:s} cannot be used with the output streams {1:s}, the events of the workers would be missing from them".format(forking[0], ', '.join(streams)))
+
+    # object caches are keyed by the input files and everything upstream of the cached stage
+    objectCaches = {}
+    if args.object_cache and args.driver not in ['direct', 'local']:
+      # the key needs every input file opened here, and the caches are local files
+      xAH_logger.warning("--objectCache is only used with the direct and local drivers, ignoring it for the {0:s} driver".format(args.driver))
+    elif args.object_cache:
+      if not args.object_cache_stage:
+        raise ValueError("--objectCache needs the name of the MinixAOD stage to cache, --objectCacheStage")
+      cacheStage = next((alg for alg in configurator._algorithms if alg.GetName() == args.object_cache_stage), None)
+      if cacheStage is None or not hasattr(cacheStage, 'm_cacheSystNames'):
+        raise ValueError("--objectCacheStage {0:s} is not a MinixAOD of the configuration".format(args.object_cache_stage))
+      # the cutflows and event counts of a BasicEventSelection up to the cached stage are cached with the objects
+      cacheHistStreams = []
+      for alg in configurator._algorithms[:configurator._algorithms.index(cacheStage)]:
+        for attr in ('m_cutFlowStreamName', 'm_metaDataStreamName'):
+          if hasattr(alg, attr) and str(getattr(alg, attr)) not in cacheHistStreams:
+            cacheHistStreams.append(str(getattr(alg, attr)))
+      upstreamKey = configurator.upstreamKey(args.object_cache_stage)
+      cacheDir = os.path.abspath(os.path.expanduser(args.object_cache))
+      for sample in sh_all:
+        cacheKey = hashlib.sha1(upstreamKey.encode('utf-8'))
+        # caches from before the histograms were cached with the objects do not match
+        cacheKey.update(' '.join(cacheHistStreams).encode('utf-8'))
+        for fname in sorted(str(f) for f in sample.makeFileList()):
+          f = ROOT.TFile.Open(fname)
+          if not f or f.IsZombie():
+            raise IOError("Cannot open {0:s} to find its UUID".format(fname))
+          cacheKey.update(f.GetUUID().AsString().encode('utf-8'))
+          f.Close()
+        objectCaches[sample.name()] = os.path.join(cacheDir, cacheKey.hexdigest()[:16] + '.root')
+
+      if all(os.path.exists(cache) for cache in objectCaches.values()):
+        xAH_logger.info("reading the object caches of {0:s} instead of running the algorithms up to it".format(args.object_cache_stage))
+        sh_cache = ROOT.SH.SampleHandler()
+        for sample in sh_all:
+          cacheSample = ROOT.SH.SampleLocal(sample.name())
+          cacheSample.meta().fetch(sample.meta())
+          cacheSample.add(objectCaches[sample.name()])
+          sh_cache.add(cacheSample)
+          xAH_logger.info(" - {0:s}: {1:s}".format(sample.name(), objectCaches[sample.name()]))
+        sh_cache.setMetaString("nc_tree", "CollectionTree")
+        sh_all = sh_cache
+        job.sampleHandler(sh_all)
+        configurator.startFromCache(args.object_cache_stage, m_cacheHistStreams=' '.join(cacheHistStreams))
+        objectCaches = {}
+      elif args.driver != 'direct':
+        xAH_logger.warning("no object cache for this input and configuration yet, run it once with the direct driver to make them")
+        objectCaches = {}
+      elif args.num_events > 0 or args.skip_events > 0:
+        xAH_logger.warning("no object cache is written for a job over part of the input (--nevents, --skip)")
+        objectCaches = {}
+      else:
+        xAH_logger.info("no object cache for this input and configuration yet, this job writes them to {0:s}".format(cacheDir))
+        objectCacheStream = str(cacheStage.m_outputFileName)
+        cacheStage.m_cacheHistStreams = ' '.join(cacheHistStreams)
+
+    if args.release_intermediates:
+      configurator.releaseIntermediates()
+
+    if args.do_timing:
+      for alg in configurator._algorithms:
+        if hasattr(alg, 'm_doTiming'): alg.m_doTiming = True
+
+    if args.profile_allocations:
+      if 'libxAODAnaHelpersAllocationCounting' not in os.environ.get('LD_PRELOAD', ''):
+        xAH_logger.warning("--profileAllocations without libxAODAnaHelpersAllocationCounting.so in LD_PRELOAD, no allocation will be counted")
+      for alg in configurator._algorithms:
+        if hasattr(alg, 'm_profileAllocations'): alg.m_profileAllocations = True
+
+    if args.perf_counters:
+      for alg in configurator._algorithms:
+        if hasattr(alg, 'm_doPerfCounters'): alg.m_doPerfCounters = True
+
+    if args.trace_file:
+      for alg in configurator._algorithms:
+        if not hasattr(alg, 'm_traceFile'): continue
+        alg.m_traceFile = os.path.abspath(args.trace_file)
+        alg.m_traceEveryNEvents = args.trace_every_n_events
+        alg.m_traceSlowEventMs = args.trace_slow_event_ms
+        alg.m_traceContainers = args.trace_containers
+
+    if args.prefetch:
+      eventSelection = next((alg for alg in configurator._algorithms if hasattr(alg, 'm_prefetchNextFile')), None)
+      if eventSelection is None:
+        raise ValueError("--prefetch needs a BasicEventSelection in the configuration")
+      if args.driver == 'prun':
+        xAH_logger.warning("--prefetch has no effect on the grid")
+      else:
+        eventSelection.m_asyncPrefetch = True
+        eventSelection.m_prefetchNextFile = True
+        # the order in which the worker will see the files, for opening the next one ahead of time
+        for sample in sh_all:
+          sample.meta().setString("xAH_inputFiles", ','.join(str(f) for f in sample.makeFileList()))
+
+    if args.pin_numa:
+      eventSelection = next((alg for alg in configurator._algorithms if hasattr(alg, 'm_pinToNUMANode')), None)
+      if eventSelection is None:
+        raise ValueError("--pinNUMA needs a BasicEventSelection in the configuration")
+      eventSelection.m_pinToNUMANode = True
+
+    # profiles are keyed by everything that changes which branches the chain reads
+    branchProfile = None
+    if args.branch_profiles:
+      profileKey = json.dumps(configurator.log() + [args.treeName, args.access_mode])
+      branchProfile = os.path.join(os.path.abspath(os.path.expanduser(args.branch_profiles)), hashlib.sha1(profileKey.encode('utf-8')).hexdigest()[:16] + '.txt')
+      if not os.path.isdir(os.path.dirname(branchProfile)): os.makedirs(os.path.dirname(branchProfile))
+      if os.path.exists(branchProfile):
+        xAH_logger.info("using the branch profile {0:s}".format(branchProfile))
+        if not args.read_branches: args.read_branches = branchProfile
+        args.auto_cache = 0
+      elif not args.write_read_branches and args.auto_cache <= 0:
+        if args.driver == 'direct':
+          xAH_logger.info("no branch profile for this configuration yet, this job writes {0:s}".format(branchProfile))
+          args.write_read_branches = branchProfile
+        else:
+          xAH_logger.warning("no branch profile for this configuration yet, run it once with the direct driver or with --autoCache to make {0:s}".format(branchProfile))
+
+    # the branch list is read and written by the first BasicEventSelection of the chain
+    if args.auto_cache > 0 or args.read_branches or args.write_read_branches:
+      eventSelection = next((alg for alg in configurator._algorithms if hasattr(alg, 'm_readBranchListInput')), None)
+      if eventSelection is None:
+        raise ValueError("--readBranches and --autoCache need a BasicEventSelection in the configuration")
+
+      if args.auto_cache > 0:
+        autoCacheDir = os.path.abspath(args.submit_dir)+'_autoCache'
+        autoCacheList = branchProfile if branchProfile else os.path.join(autoCacheDir, 'readBranches.txt')
+        # the same options up to the driver, which is replaced by a short direct run
+        topLevelArgs = sys.argv[1:sys.argv.index(args.driver)]
+        if '--autoCache' in topLevelArgs:
+          i = topLevelArgs.index('--autoCache')
+          del topLevelArgs[i:i+2]
+        topLevelArgs = [a for a in topLevelArgs if not a.startswith('--autoCache=')]
+        cmd = [sys.argv[0]] + topLevelArgs + ['--submitDir', autoCacheDir, '--nevents', str(args.auto_cache), '--force', '--writeReadBranches', autoCacheList, '--report', '', 'direct']
+        xAH_logger.info("finding the branches read by the chain: {0:s}".format(' '.join(cmd)))
+        if subprocess.call(cmd) != 0:
+          raise RuntimeError("The --autoCache run failed")
+        args.read_branches = autoCacheList
+
+      if args.read_branches:
+        eventSelection.m_readBranchListInput = os.path.abspath(args.read_branches)
+        eventSelection.m_disableUnlistedBranches = args.disable_other_branches
+      if args.write_read_branches:
+        eventSelection.m_readBranchListOutput = os.path.abspath(args.write_read_branches)
+
     # Add the algorithms to the job
     map(job.algsAdd, configurator._algorithms)
 
@@ -628,14 +874,51 @@ if __name__ == "__main__":
         getattr(driver.options(), setter)(getattr(ROOT.EL.Job, opt), getattr(args, opt))
         xAH_logger.info("\t - driver.options().{0:s}({1:s}, {2})".format(setter, getattr(ROOT.EL.Job, opt), getattr(args, opt)))
 
+    elif (args.driver == "local-parallel"):
+      # all workers are waited for, so that their outputs get merged in the submit directory
+      driver = ROOT.EL.LocalDriver()
+      for opt, t in map(lambda x: (x.dest, x.type), local_parallel._actions):
+        if getattr(args, opt) is None: continue  # skip if not set
+        if opt in ['help', 'optBatchShellInit']: continue  # skip some options
+        if t in [float]:
+          setter = 'setDouble'
+        elif t in [int]:
+          setter = 'setInteger'
+        elif t in [bool]:
+          setter = 'setBool'
+        else:
+          setter = 'setString'
+        getattr(driver.options(), setter)(getattr(ROOT.EL.Job, opt), getattr(args, opt))
+        xAH_logger.info("\t - driver.options().{0:s}({1:s}, {2})".format(setter, getattr(ROOT.EL.Job, opt), getattr(args, opt)))
+
     xAH_logger.info("\tsubmit job")
-    if args.driver in ["prun","condor","lsf","slurm","local"] and not args.optBatchWait:
+    submitOnly = args.driver in ["prun","condor","lsf","slurm","local"] and not args.optBatchWait
+    if submitOnly:
       driver.submitOnly(job, args.submit_dir)
     else:
       driver.submit(job, args.submit_dir)
 
+    if not submitOnly and objectCaches:
+      import shutil
+      for sampleName, cache in objectCaches.items():
+        output = os.path.join(args.submit_dir, 'data-{0:s}'.format(objectCacheStream), '{0:s}.root'.format(sampleName))
+        if not os.path.exists(output):
+          xAH_logger.warning("no output {0:s} to cache for {1:s}".format(output, sampleName))
+          continue
+        if not os.path.isdir(os.path.dirname(cache)): os.makedirs(os.path.dirname(cache))
+        # copied next to it first, so that a cache is either complete or missing
+        shutil.copyfile(output, cache + '.tmp')
+        os.rename(cache + '.tmp', cache)
+        xAH_logger.info("object cache of {0:s} written to {1:s}".format(sampleName, cache))
+
     SCRIPT_END_TIME = datetime.datetime.now()
 
+    if not submitOnly and args.report:
+      report = xAH_report.job_report(args.submit_dir, (SCRIPT_END_TIME - SCRIPT_START_TIME).total_seconds(), driver=args.driver, version=str(__version__))
+      with open(os.path.join(args.submit_dir, args.report), 'w') as f:
+        json.dump(report, f, indent=2, sort_keys=True)
+      xAH_logger.info("job report written to {0:s}: {1:d} events, {2:.1f} events/s".format(os.path.join(args.submit_dir, args.report), report['events'], report['events_per_second']))
+
     with open(os.path.join(args.submit_dir, 'xAH_run.log'), 'w+') as f:
       f.write(' '.join(['[{0}]'.format(__version__), os.path.basename(sys.argv[0])] + sys.argv[1:]))
       f.write('\n')
@@ -13,6 +13,12 @@
 #include <EventLoop/Worker.h>
 
 #include <string>
+#include <functional>
+#include <map>
+#include <sstream>
+#include <vector>
+
+class TFile;
 
 // for StatusCode::isSuccess
 #include "AsgTools/StatusCode.h"
@@ -27,6 +33,16 @@
 #include <AsgTools/MsgStreamMacros.h>
 #include <AsgTools/MessageCheck.h>
 
+// timing instrumentation
+#include <xAODAnaHelpers/AlgorithmTimer.h>
+#include <xAODAnaHelpers/AllocationProfiler.h>
+#include <xAODAnaHelpers/PerfCounters.h>
+#include <xAODAnaHelpers/TraceWriter.h>
+#include <xAODAnaHelpers/HistCheckpoint.h>
+#include <xAODAnaHelpers/EventArena.h>
+class HistogramManager;
+class TH1;
+#include <array>
 
 namespace xAH {
 
@@ -131,12 +147,12 @@ namespace xAH {
 
         /**
             @rst
-                This stores the isMC decision, and can also be used to override at the algorithm level to force analyzing MC or not.
+                This can be used to override the isMC decision at the algorithm level to force analyzing MC or not.
 
                 ===== ========================================================
                 Value Meaning
                 ===== ========================================================
-                -1    Default, use eventInfo object to determine if data or mc
+                -1    Default, use eventInfo object to determine if data or mc (once per input file, shared by all algorithms)
                 0     Treat the input as data
                 1     Treat the input as MC
                 ===== ========================================================
@@ -147,12 +163,12 @@ namespace xAH {
 
         /**
             @rst
-                This stores the isFastSim decision, and can also be used to override at the algorithm level to force analyzing FastSim or not.
+                This can be used to override the isFastSim decision at the algorithm level to force analyzing FastSim or not.
 
                 ===== ========================================================
                 Value Meaning
                 ===== ========================================================
-                -1    Default, use Metadata object to determine if FullSim or FastSim
+                -1    Default, use Metadata object to determine if FullSim or FastSim (once per input file, shared by all algorithms)
                 0     Treat the input as FullSim
                 1     Treat the input as FastSim
                 ===== ========================================================
@@ -169,6 +185,98 @@ namespace xAH {
         /** Backwards compatibility, same as m_forceFastSim */
         bool m_setAFII = false;
 
+        /**
+            @rst
+                Measure the wall-clock and CPU time spent in ``execute()`` and ``postExecute()`` of this algorithm.
+
+                A summary (number of calls, total, mean, approximate 50/90/99th percentiles and maximum per-event time) is printed in :cpp:func:`xAH::Algorithm::algFinalize` and written as a histogram ``timing/<m_name>`` to the ``metadata`` output stream, if available. The read statistics of the input (bytes and read calls, in total and through the ``TTreeCache``) go to ``timing/io``, and the use of the :cpp:class:`xAH::EventArena` (allocations served, heap blocks taken) to ``timing/arena``.
+
+            @endrst
+         */
+        bool m_doTiming = false;
+
+        /**
+            @rst
+                Count the heap allocations (``operator new`` calls and bytes requested) made during ``execute()`` of this algorithm, through :cpp:class:`xAH::AllocationProfiler`. The totals and the averages per event are printed in :cpp:func:`xAH::Algorithm::algFinalize` and written as a histogram ``allocations/<m_name>`` to the ``metadata`` output stream, if available.
+
+                .. note:: Only works if ``libxAODAnaHelpersAllocationCounting.so`` is preloaded, see :cpp:class:`xAH::AllocationProfiler`. A warning is printed at initialize otherwise.
+
+            @endrst
+         */
+        bool m_profileAllocations = false;
+
+        /**
+            @rst
+                Read hardware performance counters (cycles, instructions, last-level cache misses and branch misses) around ``execute()`` of this algorithm, through :cpp:class:`xAH::PerfCounters`. The instructions per cycle and the counts per event are printed in :cpp:func:`xAH::Algorithm::algFinalize` and written as a histogram ``perf/<m_name>`` to the ``metadata`` output stream, if available. The counters that cannot be opened are listed at initialize.
+
+            @endrst
+         */
+        bool m_doPerfCounters = false;
+
+        /**
+            @rst
+                Write one span per event for ``execute()`` of this algorithm to this trace file (Chrome trace event JSON, see :cpp:class:`xAH::TraceWriter`), empty for no trace. All the traced algorithms of the job share one file, the one of the first of them; :cpp:member:`xAH::Algorithm::m_traceEveryNEvents`, :cpp:member:`xAH::Algorithm::m_traceSlowEventMs` and :cpp:member:`xAH::Algorithm::m_traceContainers` are taken from that one too.
+
+            @endrst
+         */
+        std::string m_traceFile = "";
+        /// @brief Write one event out of this many to the trace, ``0`` to only write the slow events
+        unsigned int m_traceEveryNEvents = 100;
+        /// @brief Also write any event in which the traced algorithms took longer than this (ms) to the trace, ``0`` for none
+        float m_traceSlowEventMs = 0.;
+        /// @brief Space-separated particle containers whose sizes are added to every span of the trace, e.g. ``"InDetTrackParticles AntiKt4EMPFlowJets"``
+        std::string m_traceContainers = "";
+
+        /**
+            @rst
+                Number of threads used to evaluate independent systematic variations in algorithms that support it (see :cpp:func:`xAH::Algorithm::forEachSystematic`). The default of ``1`` processes all variations serially, in order.
+
+                .. warning:: Only the work that the algorithm explicitly hands over to :cpp:func:`xAH::Algorithm::forEachSystematic` runs in parallel. Output is always recorded to the ``xAOD::TStore`` serially, in the order of the systematics list, so the results are identical to the serial mode. Tools that read input variables not yet accessed in the current event would trigger reading from the input file inside the parallel section, so the algorithm reads them all beforehand with :cpp:func:`HelperFunctions::readAllAuxData`. Validate the output against the serial mode before using this in production.
+
+            @endrst
+         */
+        int m_systThreads = 1;
+
+        /**
+            @rst
+                Maximum memory in MB of the histograms booked by this algorithm, ``0`` for no limit. The total is checked every time a set of histograms is booked (see :cpp:func:`xAH::Algorithm::addHistMemory`), e.g. for every new systematic in :cpp:class:`IParticleHistsAlgo`, and the job fails with a message naming this algorithm once it is exceeded.
+
+                The histogram memory of the ``*HistsAlgo`` is printed at initialize and finalize, and written as the histogram ``memory/<m_name>`` (bytes) to the ``metadata`` output stream, if available.
+
+            @endrst
+         */
+        float m_histMemoryBudget = 0;
+
+        /**
+            @rst
+                Write a checkpoint of the histograms of this algorithm every this many events, ``0`` (the default) for none. The ``*HistsAlgo`` checkpoint all their histograms, :cpp:class:`BasicEventSelection` the event and object cutflows. The histograms are written between two events (see :cpp:class:`xAH::HistCheckpoint`) to :cpp:member:`xAH::Algorithm::m_checkpointFile`, which then holds the state after the number of events given by its ``checkpoint_events`` parameter. A checkpoint is written at the start of ``execute()``, so it never contains half an event.
+
+            @endrst
+         */
+        unsigned int m_checkpointEvents = 0;
+        /// @brief File of :cpp:member:`xAH::Algorithm::m_checkpointEvents`, ``checkpoint_<m_name>.root`` in the working directory of the job if empty
+        std::string m_checkpointFile = "";
+
+        /**
+            @rst
+                ``xAOD::TStore`` keys to remove as soon as the ``execute()`` of this algorithm is done, because no algorithm after it needs them. An entry ``<container>:<systematics>`` also removes every variation ``<container><systematic>`` listed in the systematics names stored under ``<systematics>`` (the ``m_outputAlgo`` of the producer). Each container is removed with its auxiliary store ``<container>Aux.``, keys not in the store are skipped.
+
+                This is usually filled by ``Config.releaseIntermediates()`` (``xAH_run.py --releaseIntermediates``), which works out the last algorithm needing each key from the wiring of the chain, rather than by hand.
+
+            @endrst
+         */
+        std::vector<std::string> m_releaseContainers;
+
+        /**
+            @rst
+                Share CP tools with identical configuration among all :cpp:class:`xAH::Algorithm` instances of the job (see :cpp:func:`xAH::Algorithm::retrieveSharedTool`), instead of booking a private tool per instance.
+
+                .. warning:: A shared tool is configured only once, by the first algorithm that creates it. Systematics-aware tools are safe to share as long as every user calls ``applySystematicVariation`` before using the tool, as all |xAH| algorithms do.
+
+            @endrst
+         */
+        bool m_shareTools = false;
+
 
       protected:
         /**
@@ -303,6 +411,172 @@ namespace xAH {
         template <typename T>
 	void setToolName(__attribute__((unused)) asg::AnaToolHandle<T>& handle, __attribute__((unused)) const std::string& name = "") const { }
 
+        /**
+            @rst
+                Retrieve a CP tool that may be shared with other algorithm instances.
+
+                ``setup`` must do everything needed to create the tool from scratch (``setProperty`` calls, ``retrieve()``, and any post-initialization configuration), and ``config`` must contain every configuration value ``setup`` uses, e.g. as built by :cpp:func:`xAH::Algorithm::toolConfig`.
+
+                If :cpp:member:`xAH::Algorithm::m_shareTools` is not set, this simply calls ``setup``. Otherwise the handle is turned into a public tool whose name is built out of the tool type and a hash of ``config`` (and of the output level), and ``setup`` is only called if no tool of that name exists yet in :cpp:class:`asg::ToolStore`::
+
+                    ANA_CHECK( retrieveSharedTool(m_JVT_tool_handle, toolConfig(m_WorkingPointJVT, m_SFFileJVT), [&]() -> StatusCode {
+                      ANA_CHECK( m_JVT_tool_handle.setProperty("WorkingPoint", m_WorkingPointJVT ));
+                      ANA_CHECK( m_JVT_tool_handle.setProperty("SFFile",       m_SFFileJVT ));
+                      ANA_CHECK( m_JVT_tool_handle.setProperty("OutputLevel",  msg().level()));
+                      return m_JVT_tool_handle.retrieve();
+                    }));
+
+            @endrst
+         */
+        template <typename T>
+        StatusCode retrieveSharedTool(asg::AnaToolHandle<T>& handle, const std::string& config, const std::function<StatusCode()>& setup) {
+          if(!m_shareTools) return setup();
+
+          const std::string type = handle.type();
+          std::stringstream ss;
+          ss << handle.name() << "_shared_" << std::hex << std::hash<std::string>()(type + "/" + config + ";" + std::to_string(msg().level()));
+          const std::string sharedName = ss.str();
+
+          // no parent, so that the tool is public and visible to the other instances
+          handle = asg::AnaToolHandle<T>(type + "/" + sharedName);
+
+          if(!asg::ToolStore::contains<T>(sharedName)){
+            ANA_MSG_INFO("Creating shared tool " << type << "/" << sharedName);
+            return setup();
+          }
+
+          ANA_MSG_INFO("Reusing shared tool " << type << "/" << sharedName);
+          return handle.retrieve();
+        }
+
+        /// @brief Concatenate the given configuration values into a key for :cpp:func:`xAH::Algorithm::retrieveSharedTool`
+        template <typename... Args>
+        static std::string toolConfig(const Args&... args) {
+          std::stringstream ss;
+          using expand = int[];
+          (void)expand{0, (appendToolConfig(ss, args), 0)...};
+          return ss.str();
+        }
+
+        /// @brief The scope of :cpp:func:`xAH::Algorithm::beginEvent`: adds ``execute()`` to the trace, then removes :cpp:member:`xAH::Algorithm::m_releaseContainers` from the store when it ends
+        class EventScope {
+          public:
+            EventScope(Algorithm& alg) : m_span(alg.m_traceFile.empty() ? nullptr : &alg.m_name, &alg.m_className), m_alg(alg.m_releaseContainers.empty() ? nullptr : &alg) {}
+            EventScope(EventScope&& other) : m_span(std::move(other.m_span)), m_alg(other.m_alg), m_active(other.m_active) { other.m_alg = nullptr; other.m_active = false; }
+            ~EventScope() {
+              // the span records the sizes of the traced containers, before they are released
+              m_span.end();
+              if(m_alg) m_alg->releaseContainers();
+              if(m_active && s_eventScopeHook) s_eventScopeHook();
+            }
+            EventScope(const EventScope&) = delete;
+            EventScope& operator=(const EventScope&) = delete;
+            EventScope& operator=(EventScope&&) = delete;
+          private:
+            TraceWriter::Span m_span;
+            Algorithm* m_alg;
+            bool m_active = true;
+        };
+
+        /**
+            @rst
+                Run the per-event bookkeeping of :cpp:class:`xAH::Algorithm` for the remainder of the enclosing scope. Place at the top of ``execute()``, before :cpp:func:`xAH::Algorithm::timeExecute`::
+
+                    auto event = beginEvent();
+                    auto timer = timeExecute();
+
+                It counts the events for :cpp:member:`xAH::Algorithm::m_checkpointEvents`, resets the :cpp:class:`xAH::EventArena` at the first call of an event, adds a span to the trace of :cpp:member:`xAH::Algorithm::m_traceFile`, and releases :cpp:member:`xAH::Algorithm::m_releaseContainers` at the end of the scope.
+
+            @endrst
+         */
+        EventScope beginEvent() {
+          if(m_checkpointEvents) checkpointEvent();
+          EventArena::instance().newEvent(wk()->treeEntry(), wk()->inputFile());
+          if(!m_traceFile.empty()) TraceWriter::instance().newEvent(wk()->treeEntry(), wk()->inputFile(), wk()->xaodEvent(), wk()->xaodStore());
+          return EventScope(*this);
+        }
+
+        /**
+            @rst
+                Call ``hook`` at the end of the :cpp:func:`xAH::Algorithm::beginEvent` scope of every algorithm of the job, i.e. once the algorithm is done with the event, also when it rejected it. There is a single hook per job, set it to an empty function to remove it. Used by :cpp:class:`MinixAOD` to tell the histogram fills of the algorithms after it from those of the algorithms before it.
+
+            @endrst
+         */
+        static void setEventScopeHook(const std::function<void()>& hook) { s_eventScopeHook = hook; }
+        /// @brief Whether a hook of :cpp:func:`xAH::Algorithm::setEventScopeHook` is set
+        static bool hasEventScopeHook() { return static_cast<bool>(s_eventScopeHook); }
+
+        /// @brief The scope of :cpp:func:`xAH::Algorithm::timeExecute`: times ``execute()`` and counts its allocations and hardware events
+        class ExecuteScope {
+          public:
+            ExecuteScope(Algorithm& alg) : m_timer(alg.m_executeTimer, alg.m_doTiming), m_allocations(alg.m_executeAllocations, alg.m_profileAllocations), m_perf(alg.m_executePerfCounters, alg.m_doPerfCounters) {}
+            ExecuteScope(ExecuteScope&& other) : m_timer(std::move(other.m_timer)), m_allocations(std::move(other.m_allocations)), m_perf(std::move(other.m_perf)) {}
+            ExecuteScope(const ExecuteScope&) = delete;
+            ExecuteScope& operator=(const ExecuteScope&) = delete;
+            ExecuteScope& operator=(ExecuteScope&&) = delete;
+          private:
+            AlgorithmTimer::Scope m_timer;
+            AllocationProfiler::Scope m_allocations;
+            PerfCounters::Scope m_perf;
+        };
+
+        /**
+            @rst
+                Time the remainder of the enclosing scope as part of ``execute()``. Place at the top of ``execute()``, after :cpp:func:`xAH::Algorithm::beginEvent`::
+
+                    auto timer = timeExecute();
+
+                Times nothing unless :cpp:member:`xAH::Algorithm::m_doTiming` is set, in which case the input read statistics (``timing/io``) are also sampled. The allocations and hardware counters of :cpp:member:`xAH::Algorithm::m_profileAllocations` and :cpp:member:`xAH::Algorithm::m_doPerfCounters` are counted over the same scope.
+
+            @endrst
+         */
+        ExecuteScope timeExecute() {
+          if(m_doTiming) sampleInputIO();
+          return ExecuteScope(*this);
+        }
+
+        /// @brief Same as :cpp:func:`xAH::Algorithm::timeExecute` for ``postExecute()``
+        AlgorithmTimer::Scope timePostExecute() { return AlgorithmTimer::Scope(m_postExecuteTimer, m_doTiming); }
+
+        /**
+            @rst
+                Call ``work(index, slot)`` for every ``index`` in ``[0, nTasks)``.
+
+                If :cpp:member:`xAH::Algorithm::m_systThreads` is larger than one, the calls are distributed over that many threads and ``slot`` (in ``[0, m_systThreads)``) identifies the calling thread, so that per-thread tool clones can be picked up. Otherwise the calls happen serially in order with ``slot == 0``, stopping at the first failure.
+
+                ``work`` must not touch the ``xAOD::TEvent``, the ``xAOD::TStore``, or any shared, non thread-safe tool. The typical use is to fill a vector of per-systematic results in parallel, and record them afterwards::
+
+                    std::vector<Result> results(m_systList.size());
+                    ANA_CHECK( forEachSystematic(m_systList.size(), [&](unsigned int i, unsigned int slot){
+                      return computeVariation(m_systList.at(i), m_toolClones.at(slot), results.at(i));
+                    }));
+                    for(auto& result : results) ANA_CHECK( m_store->record(...) );
+
+            @endrst
+         */
+        StatusCode forEachSystematic(unsigned int nTasks, const std::function<StatusCode(unsigned int index, unsigned int slot)>& work) const;
+
+        /// @brief Number of threads (and therefore tool clones) :cpp:func:`xAH::Algorithm::forEachSystematic` may use
+        unsigned int systThreads() const { return m_systThreads > 1 ? m_systThreads : 1; }
+
+        /**
+            @rst
+                Reject the current event: calls ``wk()->skipEvent()`` and flags the event for all the other :cpp:class:`xAH::Algorithm` instances of the job. Use this instead of calling ``wk()->skipEvent()`` directly.
+
+            @endrst
+         */
+        void rejectEvent();
+
+        /**
+            @rst
+                Return true if any :cpp:class:`xAH::Algorithm` rejected the current event through :cpp:func:`xAH::Algorithm::rejectEvent`. Check this at the top of ``execute()``, before retrieving any container::
+
+                    if ( eventRejected() ) return EL::StatusCode::SUCCESS;
+
+            @endrst
+         */
+        bool eventRejected() const;
+
         /// @brief Return a ``std::string`` representation of ``this``
         std::string getAddress() const {
           const void * address = static_cast<const void*>(this);
@@ -311,6 +585,20 @@ namespace xAH {
           return ss.str();
         }
 
+        /// @brief Add the memory of a newly booked set of histograms to the total of this algorithm, fails if that exceeds :cpp:member:`xAH::Algorithm::m_histMemoryBudget`
+        StatusCode addHistMemory(const HistogramManager& hists);
+        /// @brief Print the memory of the histograms of this algorithm at ``stage``, it is written to the ``metadata`` stream by :cpp:func:`xAH::Algorithm::algFinalize`
+        void reportHistMemory(const std::string& stage, double bytes);
+        /// @brief Memory of all the histograms passed to :cpp:func:`xAH::Algorithm::addHistMemory`
+        double m_histBytes = 0; //!
+
+        /// @brief Include all the histograms of ``hists`` in the checkpoints of :cpp:member:`xAH::Algorithm::m_checkpointEvents`, ``hists`` must live until the end of the event loop
+        void addCheckpoint(HistogramManager* hists) { m_checkpoint.add(hists); }
+        /// @brief Include a single histogram, e.g. a cutflow, in the checkpoints of :cpp:member:`xAH::Algorithm::m_checkpointEvents`
+        void addCheckpoint(TH1* hist) { m_checkpoint.add(hist); }
+        /// @brief Flush ``counter`` into its histogram before the checkpoints of :cpp:member:`xAH::Algorithm::m_checkpointEvents`
+        void addCheckpoint(CutflowCounter* counter) { m_checkpoint.add(counter); }
+
       private:
         /**
             @rst
@@ -330,6 +618,9 @@ namespace xAH {
          */
         static std::map<std::string, int> m_instanceRegistry; //!
 
+        /// @brief The hook of :cpp:func:`xAH::Algorithm::setEventScopeHook`
+        static std::function<void()> s_eventScopeHook; //!
+
         /**
             @rst
                 Map containing info about whether a CP Tool of a given name has been already used or not by this :cpp:class:`xAH::Algorithm`.
@@ -339,6 +630,76 @@ namespace xAH {
             @endrst
          */
         std::map<std::string, bool> m_toolAlreadyUsed; //!
+
+        /// @brief Accumulated timing of ``execute()``, filled if :cpp:member:`xAH::Algorithm::m_doTiming` is set
+        AlgorithmTimer m_executeTimer; //!
+        /// @brief Accumulated timing of ``postExecute()``, filled if :cpp:member:`xAH::Algorithm::m_doTiming` is set
+        AlgorithmTimer m_postExecuteTimer; //!
+
+        /// @brief Print the timing summary and write it to the ``metadata`` stream
+        void reportTiming();
+
+        /// @brief Allocations made in ``execute()``, counted if :cpp:member:`xAH::Algorithm::m_profileAllocations` is set
+        AllocationProfiler m_executeAllocations; //!
+        /// @brief Print the allocations per event and write them as ``allocations/<m_name>`` to the ``metadata`` stream
+        void reportAllocations();
+
+        /// @brief Hardware counters of ``execute()``, read if :cpp:member:`xAH::Algorithm::m_doPerfCounters` is set
+        PerfCounters m_executePerfCounters; //!
+        /// @brief Print the counters per event and write them as ``perf/<m_name>`` to the ``metadata`` stream
+        void reportPerfCounters();
+
+        /// @brief The stages and totals of :cpp:func:`xAH::Algorithm::reportHistMemory`
+        std::vector<std::pair<std::string, double> > m_histMemory; //!
+        /// @brief Write :cpp:member:`xAH::Algorithm::m_histMemory` as ``memory/<m_name>`` to the ``metadata`` stream
+        void writeHistMemory();
+
+        /// @brief The checkpoints of :cpp:member:`xAH::Algorithm::m_checkpointEvents`, and the number of events seen by :cpp:func:`xAH::Algorithm::beginEvent`
+        HistCheckpoint m_checkpoint; //!
+        long long m_checkpointCount = 0; //!
+        /// @brief Count one event, and write a checkpoint every :cpp:member:`xAH::Algorithm::m_checkpointEvents`
+        void checkpointEvent();
+
+        /// @brief Remove :cpp:member:`xAH::Algorithm::m_releaseContainers` from the ``xAOD::TStore``
+        void releaseContainers();
+
+        /// @brief Read statistics of the input files, summed over the files already done and the current one
+        struct InputIOState {
+          const TFile* file = nullptr;
+          double files = 0;
+          /// @brief ``[bytes read through the TTreeCache, read calls through it, bytes read outside of it, read calls outside of it]``
+          std::array<double, 4> done = {{0, 0, 0, 0}};
+          std::array<double, 4> current = {{0, 0, 0, 0}};
+        };
+        /// @brief Shared among all instances, sampled by :cpp:func:`xAH::Algorithm::timeExecute`
+        static InputIOState m_inputIOState; //!
+        /// @brief Update :cpp:member:`xAH::Algorithm::m_inputIOState` from the cache of the current input tree
+        void sampleInputIO() const;
+
+        /// @brief Per-input-file decisions of :cpp:func:`xAH::Algorithm::isMC` and :cpp:func:`xAH::Algorithm::isFastSim`
+        struct InputFileState {
+          const TFile* file = nullptr;
+          int isMC = -1;
+          int isFastSim = -1;
+        };
+        /// @brief The state of the current input file, shared among all instances
+        static InputFileState m_inputFileState; //!
+        /// @brief Return :cpp:member:`xAH::Algorithm::m_inputFileState`, reset first if the input file changed
+        InputFileState& inputFileState() const;
+
+        /// @brief Entry and input file of the last event rejected through :cpp:func:`xAH::Algorithm::rejectEvent`, shared among all instances
+        static Long64_t m_rejectedEntry; //!
+        static const TFile* m_rejectedFile; //!
+        static std::string m_rejectedFileName; //!
+
+        template <typename T>
+        static void appendToolConfig(std::stringstream& ss, const T& value) { ss << value << ";"; }
+        template <typename T>
+        static void appendToolConfig(std::stringstream& ss, const std::vector<T>& values) {
+          ss << "[";
+          for(const auto& value : values) appendToolConfig(ss, value);
+          ss << "];";
+        }
   };
 
 }
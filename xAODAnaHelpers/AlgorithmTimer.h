@@ -0,0 +1,100 @@
+#ifndef xAODAnaHelpers_AlgorithmTimer_H
+#define xAODAnaHelpers_AlgorithmTimer_H
+
+#include <array>
+#include <chrono>
+#include <string>
+
+class TH1D;
+
+namespace xAH {
+
+  /**
+      @rst
+          Accumulates wall-clock and CPU time for repeated calls of a single code region (e.g. :cpp:func:`xAH::Algorithm::execute`).
+
+          The individual call durations are not stored. Instead, they are binned in a fixed, logarithmically spaced set of bins between :math:`10^{-7}` and :math:`10^{2}` seconds, from which approximate percentiles are computed. This keeps the memory footprint constant regardless of the number of events processed.
+
+          The timer is usually driven through an :cpp:class:`xAH::AlgorithmTimer::Scope` object::
+
+              xAH::AlgorithmTimer timer;
+              {
+                xAH::AlgorithmTimer::Scope scope(timer);
+                // ... code to be timed
+              }
+
+      @endrst
+   */
+  class AlgorithmTimer {
+    public:
+      /// @brief number of logarithmic bins used to estimate the percentiles
+      static constexpr unsigned int nBins = 180;
+
+      /**
+          @brief RAII helper that starts the timer on construction and stops it on destruction
+
+          An inactive scope does nothing, which allows the caller to keep the instrumentation in place when timing is disabled.
+       */
+      class Scope {
+        public:
+          Scope(AlgorithmTimer& timer, bool active = true) : m_timer(active ? &timer : nullptr) { if(m_timer) m_timer->start(); }
+          Scope(Scope&& other) : m_timer(other.m_timer) { other.m_timer = nullptr; }
+          ~Scope() { if(m_timer) m_timer->stop(); }
+          Scope(const Scope&) = delete;
+          Scope& operator=(const Scope&) = delete;
+          Scope& operator=(Scope&&) = delete;
+        private:
+          AlgorithmTimer* m_timer;
+      };
+
+      AlgorithmTimer();
+
+      /// @brief Start a new measurement
+      void start();
+      /// @brief Stop the current measurement and accumulate it
+      void stop();
+      /// @brief Forget everything that was accumulated so far
+      void reset();
+
+      /// @brief Number of completed measurements
+      unsigned long long calls() const { return m_calls; }
+      /// @brief Total wall-clock time in seconds
+      double wallTime() const { return m_wallTotal; }
+      /// @brief Total CPU time in seconds, of the calling thread only (so other threads of the job are not counted in)
+      double cpuTime() const { return m_cpuTotal; }
+      /// @brief Mean wall-clock time per call in seconds
+      double wallMean() const { return m_calls ? m_wallTotal/m_calls : 0.0; }
+      /// @brief Longest single call in seconds
+      double wallMax() const { return m_wallMax; }
+      /**
+          @brief Approximate wall-clock percentile in seconds
+          @param fraction   The requested quantile, e.g. ``0.99`` for the 99th percentile
+       */
+      double wallPercentile(double fraction) const;
+
+      /**
+          @brief Build a histogram summarising this timer
+          @param name   The name (and title) of the histogram
+
+          The bins are labelled ``calls``, ``wall_total``, ``cpu_total``, ``wall_mean``, ``wall_p50``, ``wall_p90``, ``wall_p99`` and ``wall_max``. All times are in seconds. The caller owns the histogram.
+       */
+      TH1D* makeHist(const std::string& name) const;
+
+    private:
+      static unsigned int findBin(double seconds);
+      static double binCenter(unsigned int bin);
+
+      unsigned long long m_calls;
+      double m_wallTotal;
+      double m_cpuTotal;
+      double m_wallMax;
+
+      bool m_running;
+      std::chrono::steady_clock::time_point m_wallStart;
+      double m_cpuStart;
+
+      std::array<unsigned long long, nBins> m_wallBins;
+  };
+
+}
+#endif
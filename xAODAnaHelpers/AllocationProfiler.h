@@ -0,0 +1,89 @@
+#ifndef xAODAnaHelpers_AllocationProfiler_H
+#define xAODAnaHelpers_AllocationProfiler_H
+
+#include <atomic>
+#include <string>
+
+class TH1D;
+
+namespace xAH {
+
+  /**
+      @rst
+          Counts the heap allocations made through ``operator new`` while a code region runs (e.g. :cpp:func:`xAH::Algorithm::execute`), to find the algorithms that allocate the most per event.
+
+          The counting is done by a replacement of the global ``operator new`` and ``operator delete``, counting the calls and the bytes requested once :cpp:func:`xAH::AllocationProfiler::enable` was called. It is not part of ``libxAODAnaHelpersLib.so``, whose users keep the allocator of their program, but of the separate ``libxAODAnaHelpersAllocationCounting.so``, which nothing links to and which must be preloaded so that its operators take precedence over those of ``libstdc++``::
+
+              LD_PRELOAD=$(find $AnalysisBase_PLATFORM_DIR/../.. -name libxAODAnaHelpersAllocationCounting.so | head -1) xAH_run.py --profileAllocations ...
+
+          Without it, :cpp:func:`xAH::AllocationProfiler::enable` returns false and the scopes count nothing. It cannot be combined with another replacement of ``operator new`` (tcmalloc, jemalloc, the sanitizers), whichever is first in ``LD_PRELOAD`` wins.
+
+          The counters are global: an :cpp:class:`xAH::AllocationProfiler::Scope` attributes everything allocated between its construction and destruction to its profiler, including allocations of the CP tools called, and of the threads of :cpp:func:`xAH::Algorithm::forEachSystematic`. ``malloc`` called directly (e.g. by ROOT) is not counted.
+
+      @endrst
+   */
+  class AllocationProfiler {
+    public:
+      /// @brief Allocations counted since :cpp:func:`xAH::AllocationProfiler::enable`
+      struct Counts {
+        unsigned long long allocations = 0;
+        unsigned long long bytes = 0;
+        unsigned long long deallocations = 0;
+      };
+
+      /// @brief The counters of the preloaded library, found by :cpp:func:`xAH::AllocationProfiler::enable` through its ``xAH_allocationCounters()``
+      struct SharedCounters {
+        std::atomic<bool> enabled{false};
+        std::atomic<unsigned long long> allocations{0};
+        std::atomic<unsigned long long> bytes{0};
+        std::atomic<unsigned long long> deallocations{0};
+      };
+
+      /**
+          @brief RAII helper that attributes the allocations made during its lifetime to a profiler
+
+          An inactive scope does nothing, which allows the caller to keep the instrumentation in place when profiling is disabled.
+       */
+      class Scope {
+        public:
+          Scope(AllocationProfiler& profiler, bool active = true) : m_profiler(active ? &profiler : nullptr) { if(m_profiler) m_start = current(); }
+          Scope(Scope&& other) : m_profiler(other.m_profiler), m_start(other.m_start) { other.m_profiler = nullptr; }
+          ~Scope() { if(m_profiler) m_profiler->add(m_start, current()); }
+          Scope(const Scope&) = delete;
+          Scope& operator=(const Scope&) = delete;
+          Scope& operator=(Scope&&) = delete;
+        private:
+          AllocationProfiler* m_profiler;
+          Counts m_start;
+      };
+
+      /**
+          @brief Start counting the allocations of the job
+          @returns Whether the ``operator new`` of ``libxAODAnaHelpersAllocationCounting.so`` is the one in use, nothing is counted otherwise
+       */
+      static bool enable();
+      /// @brief The global counters
+      static Counts current();
+
+      /// @brief Number of completed scopes
+      unsigned long long calls() const { return m_calls; }
+      /// @brief Allocations, bytes and deallocations of all the completed scopes
+      const Counts& total() const { return m_total; }
+
+      /**
+          @brief Build a histogram summarising this profiler
+          @param name   The name (and title) of the histogram
+
+          The bins are labelled ``calls``, ``allocations``, ``bytes``, ``deallocations``, ``allocations_per_call`` and ``bytes_per_call``. The caller owns the histogram.
+       */
+      TH1D* makeHist(const std::string& name) const;
+
+    private:
+      void add(const Counts& start, const Counts& stop);
+
+      unsigned long long m_calls = 0;
+      Counts m_total;
+  };
+
+}
+#endif
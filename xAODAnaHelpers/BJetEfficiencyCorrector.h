@@ -99,6 +99,14 @@ private:
 
   std::vector<CP::SystematicSet> m_systList; //!
 
+  /// @brief key of the tagger shared with the other instances, see :cpp:func:`xAH::BTagDecisions::registerTagger`. Empty if nothing is shared.
+  std::string m_btagKey = ""; //!
+  /// @brief bit of the operating point in the ``BTagBits_<key>`` decoration, ``-1`` if it is not written
+  int m_btagBit = -1; //!
+  /// @brief bits of the decision and of the decision for the overlap removal in :cpp:any:`xAH::SelectionFlags`, ``-1`` if they are not written
+  int m_isBTagFlagBit = -1; //!
+  int m_isBTagORFlagBit = -1; //!
+
   // variables that don't get filled at submission time should be
   // protected from being send from the submission node to the worker
   // node (done by the //!)
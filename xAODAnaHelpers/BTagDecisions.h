@@ -0,0 +1,34 @@
+#ifndef xAODAnaHelpers_BTagDecisions_H
+#define xAODAnaHelpers_BTagDecisions_H
+
+#include <string>
+
+namespace xAH {
+
+  /**
+      @rst
+          The b-tagging results shared by all the :cpp:class:`BJetEfficiencyCorrector` instances of a job which use the same tagger on the same jets, so that the discriminant of a jet is computed once rather than once per operating point.
+
+          A tagger is identified by its key ``<tagger>_<jetAuthor>`` (e.g. ``DL1r_AntiKt4EMPFlowJets``). The first instance computing the discriminant of a jet decorates it as ``BTagWeight_<key>``, the others read it back and only apply their own cut. Every fixed-cut operating point of the tagger gets a bit, and the decisions of all of them are collected in the one ``BTagBits_<key>`` decoration of the jet, next to the usual per operating point decorations.
+
+      @endrst
+   */
+  namespace BTagDecisions {
+    /// @brief The key of ``tagger`` on ``jetAuthor`` jets, registering it with the calibration file ``cdiFile``. Empty if the key is already registered with another calibration file, whose discriminant may differ, in which case nothing is shared.
+    std::string registerTagger(const std::string& tagger, const std::string& jetAuthor, const std::string& cdiFile);
+
+    /// @brief The bit of operating point ``operatingPoint`` of the tagger ``key``, registering it if needed. Returns -1 if all bits are taken.
+    int bit(const std::string& key, const std::string& operatingPoint);
+
+    /// @brief The operating point of bit ``bit`` of the tagger ``key``
+    const std::string& operatingPoint(const std::string& key, unsigned int bit);
+
+    /// @brief Name of the decoration of the discriminant of the tagger ``key``
+    inline std::string weightName(const std::string& key) { return "BTagWeight_" + key; }
+
+    /// @brief Name of the decoration of the packed decisions of the tagger ``key``
+    inline std::string bitsName(const std::string& key) { return "BTagBits_" + key; }
+  }
+
+}
+#endif
@@ -13,9 +13,18 @@
 
 // ROOT include(s):
 #include "TH1D.h"
+#include "TFile.h"
+#include "TEntryList.h"
+
+#include <memory>
 
 // algorithm wrapper
 #include "xAODAnaHelpers/Algorithm.h"
+#include "xAODAnaHelpers/CpuPinning.h"
+#include "xAODAnaHelpers/CutflowCounter.h"
+#include "xAODAnaHelpers/EventNumberSet.h"
+#include "xAODAnaHelpers/FilePrefetcher.h"
+#include "xAODAnaHelpers/LumiBlockIntervals.h"
 
 // external tools include(s):
 #include "AsgTools/AnaToolHandle.h"
@@ -65,6 +74,10 @@ class BasicEventSelection : public xAH::Algorithm
     std::string m_GRLxml = "";
     /// @brief Run numbers to skip in GRL
     std::string m_GRLExcludeList = "";
+    /** @rst
+          Copy the merged good lumi blocks of the GRLs into an :cpp:class:`xAH::LumiBlockIntervals` at initialize and use it instead of asking the GRL tool for every event
+        @endrst */
+    bool m_useGRLIntervalIndex = false;
 
     /// @brief Clean Powheg huge weight
     bool m_cleanPowheg = false;
@@ -131,6 +144,78 @@ class BasicEventSelection : public xAH::Algorithm
     // Print Branch List
     bool m_printBranchList = false;
 
+    /**
+      @rst
+        Write the names of all the input branches read during the job to this file, one per line, from the ``xAOD::ReadStats`` of the job. Meant for a short run whose list is then given to :cpp:member:`BasicEventSelection::m_readBranchListInput` (see ``xAH_run.py --autoCache``).
+
+      @endrst
+     */
+    std::string m_readBranchListOutput = "";
+
+    /// @brief File with input branch names, one per line: the TTreeCache of every input file is primed with exactly these branches and its learning phase is skipped
+    std::string m_readBranchListInput = "";
+
+    /**
+      @rst
+        With :cpp:member:`BasicEventSelection::m_readBranchListInput`, also disable all the input branches that are not listed, so that none of their baskets are ever read.
+
+        .. warning:: A variable read by the chain but missing from the list (e.g. only accessed for events not in the run that made the list) silently reads as default values. Only use a list made on a representative sample.
+
+      @endrst
+     */
+    bool m_disableUnlistedBranches = false;
+
+    /**
+      @rst
+        Record the entries passing the event selection in a ``TEntryList`` named ``entryList`` in the :cpp:member:`BasicEventSelection::m_metaDataStreamName` stream, with one sub-list per input file. A later job over the same inputs gives it to :cpp:member:`BasicEventSelection::m_entryListInput` to skip straight to these entries. Not supported with :cpp:member:`BasicEventSelection::m_forkWorkers`.
+
+      @endrst
+     */
+    bool m_writeEntryList = false;
+
+    /**
+      @rst
+        ROOT file with the ``entryList`` of a :cpp:member:`BasicEventSelection::m_writeEntryList` job (e.g. its merged ``data-metadata`` output). The entries of an input file that are not in its sub-list are rejected first thing in ``execute()``, before any container is retrieved, so that no algorithm runs or reads anything for them. Input files are matched by file name, whatever their directory; all the entries of a file without a sub-list are processed.
+
+        The cutflow of the job then starts from the listed entries, while the sums of weights of the ``CutBookkeepers`` are those of the full input.
+
+      @endrst
+     */
+    std::string m_entryListInput = "";
+
+    /// @brief Let the TTreeCache fetch the next baskets in the background (``TFile.AsyncPrefetching``), set for the whole job in ``histInitialize()``
+    bool m_asyncPrefetch = false;
+
+    /**
+      @rst
+        Open the next input file in a background thread while the current one is processed, see :cpp:class:`xAH::FilePrefetcher`. The files are taken, in order, from the comma separated ``xAH_inputFiles`` meta data of the sample, which ``xAH_run.py --prefetch`` sets.
+
+      @endrst
+     */
+    bool m_prefetchNextFile = false;
+
+    /**
+      @rst
+        Number of processes sharing the events of the job, ``1`` (the default) for a single process. The job is initialised once: on the first event, when all the algorithms and their CP tools are set up, the process forks ``m_forkWorkers - 1`` workers which share the memory of the tools copy-on-write. The processes then take the events in turn, each rejecting (:cpp:func:`xAH::Algorithm::rejectEvent`) the ones of the others, and read the input through file handles of their own.
+
+        The workers empty their copy of the histograms registered for the checkpoints (see :cpp:member:`xAH::Algorithm::m_checkpointEvents`: the histograms of the ``*HistsAlgo`` and the cutflows) when they are forked, and the first process alone fills the counts of the input metadata. At the end of the job the workers write these histograms to a file and exit, without writing any output of their own. In ``finalize()`` the first process waits for them and adds their histograms to its own, so the registered histograms hold the events of all the processes, each counted once.
+
+        .. warning:: Only the registered histograms are merged. The job fails at the first event if it contains a :cpp:class:`TreeAlgo`, :cpp:class:`MinixAOD` or :cpp:class:`Writer`, checks for duplicated events or has an :cpp:class:`IParticleHistsAlgo` with :cpp:member:`IParticleHistsAlgo::m_systematicsBlock`, and ``xAH_run.py`` refuses configurations declaring output streams. Histograms booked outside of :cpp:class:`HistogramManager`, and trees or xAODs written by other algorithms, would only hold the events of the first process. Use it with the ``direct`` driver, on a node with as many cores as processes.
+
+      @endrst
+     */
+    unsigned int m_forkWorkers = 1;
+
+    /**
+      @rst
+        Pin the process to the CPUs of the NUMA node (socket) it starts on, see :cpp:class:`xAH::CpuPinning`. This is done in ``histInitialize()``, before any CP tool is created, so the memory of the tools is allocated on the node of the CPUs using it and the process does not migrate to another socket. With :cpp:member:`BasicEventSelection::m_forkWorkers` the workers are spread over the nodes in turn, each keeping the copy-on-write memory of the tools it shares with the first process. Nothing is done on a machine with a single node.
+
+        Use it when several jobs (``local-parallel``, or batch jobs sharing a node) run on a multi-socket machine, which ``xAH_run.py --pinNUMA`` enables.
+
+      @endrst
+     */
+    bool m_pinToNUMANode = false;
+
   // Trigger
     /**
       @rst
@@ -156,6 +241,20 @@ class BasicEventSelection : public xAH::Algorithm
     */
     bool m_storeTrigDecisions = false;
 
+    /**
+      @rst
+        With :cpp:member:`~BasicEventSelection::m_storeTrigDecisions`, decorate the string and float vectors ``passedTriggers``, ``disabledTriggers``, ``triggerPrescales``, ``triggerPrescalesLumi`` and ``isPassedBitsNames``. Turn it off when only the packed form of :cpp:member:`~BasicEventSelection::m_storeTrigDecisionsPacked` is read.
+      @endrst
+    */
+    bool m_storeTrigDecisionsStrings = true;
+
+    /**
+      @rst
+        With :cpp:member:`~BasicEventSelection::m_storeTrigDecisions`, also decorate the packed form of the trigger decisions: ``triggerDictionaryID`` (see :cpp:class:`xAH::TriggerDictionary`, the chain list changes only with the menu), the bit masks ``passedTriggersBits`` and ``disabledTriggersBits``, and the prescales of every chain in ``triggerPrescalesAll`` and ``triggerPrescalesLumiAll`` (``-1`` for the luminosity prescale of a chain that did not pass). :cpp:class:`HelpTreeBase` builds its trigger branches from it when the string form is not there.
+      @endrst
+    */
+    bool m_storeTrigDecisionsPacked = false;
+
     /// @brief Save if any L1 trigger fired, e.g. ``"L1_.*"``
     bool m_storePassL1 = false;
 
@@ -191,15 +290,60 @@ class BasicEventSelection : public xAH::Algorithm
     bool m_checkDuplicatesData = false;
     /** Check for duplicated events in MC */
     bool m_checkDuplicatesMC = false;
+    /** The input is ordered by run: forget the events of the previous run when a new run starts, to bound the memory of the duplicate check */
+    bool m_checkDuplicatesRunOrdered = false;
 
   private:
 
-    std::set<std::pair<uint32_t,uint32_t> > m_RunNr_VS_EvtNr; //!
+    xAH::EventNumberSet m_RunNr_VS_EvtNr; //!
+    uint32_t m_duplicatesLastRun = 0; //!
+    /// @brief the good lumi blocks, see :cpp:member:`~m_useGRLIntervalIndex`
+    xAH::LumiBlockIntervals m_grlIntervals; //!
     // trigger unprescale chains
     std::vector<std::string> m_triggerUnprescaleList; //!
     // decisions of triggers which are saved but not cut on, converted into a list
     std::vector<std::string> m_extraTriggerSelectionList; //!
 
+    /// @brief a chain group resolved by the trigger decision tool, with what is derived from its name
+    struct CachedChain {
+      std::string name;
+      const Trig::ChainGroup* group;
+      /// @brief all its chains are in ``m_triggerUnprescaleList``
+      bool doLumiPrescale;
+      /// @brief the luminosity prescale for the current lumi block, if already computed
+      float lumiPrescale = -1;
+      bool hasLumiPrescale = false;
+      /// @brief the prescale for the current trigger configuration keys, if already read
+      float prescale = -1;
+      bool hasPrescale = false;
+    };
+    /// @brief chain groups of the trigger selection, resolved again only when the trigger menu (SMK) changes
+    const Trig::ChainGroup* m_triggerChainGroup = nullptr; //!
+    std::vector<CachedChain> m_triggerChains;              //!
+    std::vector<CachedChain> m_extraTriggerChains;         //!
+    uint32_t m_chainGroupsSMK = 0;                         //!
+    /// @brief the :cpp:class:`xAH::TriggerDictionary` of the chains above
+    unsigned int m_triggerDictionaryID = 0;                //!
+    /// @brief the lumi block (and its average pileup) the cached luminosity prescales were computed for
+    uint32_t m_lumiPrescaleRun = 0;                        //!
+    uint32_t m_lumiPrescaleLB = 0;                         //!
+    float m_lumiPrescaleMu = -1;                           //!
+    /// @brief Luminosity prescale of ``chain``, computed once per lumi block
+    float lumiPrescale(CachedChain& chain, const xAOD::EventInfo& eventInfo);
+    /// @brief the trigger configuration keys (SMK, L1PSK, HLTPSK) of the event, read once per event, and those the cached prescales are for
+    uint32_t m_eventSMK = 0;                               //!
+    uint32_t m_eventL1PSK = 0;                             //!
+    uint32_t m_eventHLTPSK = 0;                            //!
+    uint32_t m_prescaleSMK = 0;                            //!
+    uint32_t m_prescaleL1PSK = 0;                          //!
+    uint32_t m_prescaleHLTPSK = 0;                         //!
+    /// @brief the prescale of ``m_triggerChainGroup`` for these keys
+    CachedChain m_triggerSelectionChain{ "", nullptr, false }; //!
+    /// @brief Prescale of ``chain``, read from the menu once per set of trigger configuration keys
+    float prescale(CachedChain& chain);
+    /// @brief Resolve the chain groups above for the current menu
+    void updateChainGroups();
+
     // tools
     asg::AnaToolHandle<IGoodRunsListSelectionTool> m_grl_handle                  {"GoodRunsListSelectionTool"                                      , this}; //!
     asg::AnaToolHandle<CP::IPileupReweightingTool> m_pileup_tool_handle          {"CP::PileupReweightingTool/Pileup"                                            }; //!
@@ -233,10 +377,51 @@ class BasicEventSelection : public xAH::Algorithm
     int m_cutflow_tile;       //!
     int m_cutflow_SCT;        //!
     int m_cutflow_core;       //!
+    /// @brief the LAr, tile, SCT and core bins above, in cutflow order
+    int m_cleaningCutflowBins[4] = {-1, -1, -1, -1}; //!
+    /// @brief events with any of these core flag bits set are rejected
+    uint32_t m_coreFlagsRejectMask = 0; //!
     int m_cutflow_jetcleaning; //!
     int m_cutflow_isbadbatman; //!
     int m_cutflow_npv;        //!
     int m_cutflow_trigger;    //!
+    /// @brief per-event fills of the cutflow histograms above, added to them in ``finalize()``. The metadata counts are filled directly.
+    xAH::CutflowCounter m_cutflowCounter;  //!
+    xAH::CutflowCounter m_cutflowCounterW; //!
+    /// @brief Count an event passing cutflow bin ``bin``, equivalent to filling ``1`` and ``weight`` in the two cutflow histograms
+    void fillCutflow(int bin, double weight) { m_cutflowCounter.fill(bin); m_cutflowCounterW.fill(bin, weight); }
+
+    /// @brief the content of :cpp:member:`BasicEventSelection::m_readBranchListInput`
+    std::vector<std::string> m_cacheBranches; //!
+
+    /// @brief the list of :cpp:member:`BasicEventSelection::m_writeEntryList`, owned by the metadata file
+    TEntryList* m_entryList = nullptr; //!
+    /// @brief the list of :cpp:member:`BasicEventSelection::m_entryListInput`, and its sub-list of the current input file (``nullptr`` to process all its entries)
+    std::unique_ptr<TEntryList> m_entryListIn; //!
+    TEntryList* m_entryListInFile = nullptr; //!
+
+    std::unique_ptr<xAH::FilePrefetcher> m_filePrefetcher; //!
+
+    /// @brief The process of :cpp:member:`BasicEventSelection::m_forkWorkers`, ``0`` for the first one, and the workers it forked
+    unsigned int m_forkSlice = 0; //!
+    std::vector<int> m_forkPids; //!
+    int m_forkParent = 0; //!
+    bool m_forked = false; //!
+    /// @brief All the events seen, the ones of the other processes included
+    long long m_forkEvents = 0; //!
+    /// @brief The input file the worker was forked on, reopened for the worker alone
+    std::unique_ptr<TFile> m_forkInputFile; //!
+    /// @brief The NUMA nodes of :cpp:member:`BasicEventSelection::m_pinToNUMANode` and the index of the one the job started on, read before pinning: once pinned the process only sees its own node
+    std::vector<xAH::CpuPinning::Node> m_numaNodes; //!
+    int m_numaNode = -1; //!
+    /// @brief Fork the workers of :cpp:member:`BasicEventSelection::m_forkWorkers`
+    EL::StatusCode forkWorkers();
+    /// @brief Hand the histograms of a worker to the first process and exit, or merge those of all the workers in the first process
+    EL::StatusCode joinWorkers();
+    /// @brief Create the lists of :cpp:member:`BasicEventSelection::m_writeEntryList` and :cpp:member:`BasicEventSelection::m_entryListInput` and point them to the current input file
+    EL::StatusCode changeEntryLists(bool firstFile);
+    /// @brief File the worker of ``slice`` writes its histograms to
+    std::string forkFileName(unsigned int slice) const;
 
     // object cutflow
     TH1D* m_el_cutflowHist_1 = nullptr;    //!
@@ -270,6 +455,8 @@ class BasicEventSelection : public xAH::Algorithm
        @endrst
     */
     StatusCode autoconfigurePileupRWTool();
+    /// @brief ``PathResolverFindCalibFile(fileName)``, looked up once per job for each file name. Empty if it is not found.
+    static const std::string& resolvePRWConfigFile(const std::string& fileName);
 
   public:
     // Tree *myTree; //!
@@ -8,8 +8,10 @@
 #include <string>
 
 #include "xAODCaloEvent/CaloClusterContainer.h"
+#include "AthContainers/ConstDataVector.h"
 
 #include <xAODAnaHelpers/HelperClasses.h>
+#include <xAODAnaHelpers/HelperFunctions.h>
 
 #include <xAODAnaHelpers/Cluster.h>
 #include <xAODAnaHelpers/ParticleContainer.h>
@@ -31,9 +33,21 @@ namespace xAH {
       virtual void FillCluster( const xAOD::IParticle* particle );
       using ParticleContainer::setTree; // make other overloaded version of execute() to show up in subclass
 
+      /**
+          @brief The clusters to write: ``clusters`` itself, or a view of the ones passing the ``ptMin`` and ``NLeading`` options of the detail string
+          @rst
+              The view is owned by the container and valid until the next call.
+          @endrst
+       */
+      const xAOD::CaloClusterContainer* select( const xAOD::CaloClusterContainer* clusters );
+
     protected:
       virtual void updateParticle(uint idx, Cluster& cluster);
 
+    private:
+      /// @brief the view returned by select()
+      ConstDataVector<xAOD::CaloClusterContainer> m_selected;
+
     };
 }
 #endif // xAODAnaHelpers_ClusterContainer_H
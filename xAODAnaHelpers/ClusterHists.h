@@ -3,6 +3,10 @@
 
 #include "xAODAnaHelpers/HistogramManager.h"
 #include "xAODCaloEvent/CaloClusterContainer.h"
+#include "AthContainers/ConstDataVector.h"
+#include "xAODAnaHelpers/HelperClasses.h"
+
+#include <memory>
 
 ANA_MSG_HEADER(msgClusterHists)
 
@@ -11,6 +15,8 @@ class ClusterHists : public HistogramManager
   public:
     ClusterHists(std::string name, std::string detailStr );
     ~ClusterHists();
+    ClusterHists(const ClusterHists&) = delete;
+    ClusterHists& operator=(const ClusterHists&) = delete;
 
     StatusCode initialize();
     StatusCode execute( const xAOD::CaloClusterContainer* ccls, float eventWeight );
@@ -22,15 +28,24 @@ class ClusterHists : public HistogramManager
     // bools to control which histograms are filled
     bool m_fillDebugging;        //!
 
+    /// @brief the ``ptMin`` and ``NLeading`` options of the detail string
+    std::unique_ptr<HelperClasses::ClusterInfoSwitch> m_infoSwitch; //!
+
   private:
     // Histograms
-    TH1F* m_ccl_n; //!
-    TH1F* m_ccl_e; //!
-    TH1F* m_ccl_eta; //!
-    TH1F* m_ccl_phi; //!
-    TH2F* m_ccl_eta_vs_phi; //!
-    TH2F* m_ccl_e_vs_eta; //!
-    TH2F* m_ccl_e_vs_phi; //!
+    enum Hist { kN, kE, kEta, kPhi, kEtaVsPhi, kEVsEta, kEVsPhi };
+    // the histograms filled through fillBuffered, resolved once
+    FillSlot m_ESlot;                 //!
+    FillSlot m_EtaSlot;               //!
+    FillSlot m_PhiSlot;               //!
+
+    // the kinematics of all the clusters of the event, filled in one go
+    std::vector<double> m_cclE;       //!
+    std::vector<double> m_cclEta;     //!
+    std::vector<double> m_cclPhi;     //!
+    std::vector<double> m_cclWeight;  //!
+    /// @brief the clusters passing ``ptMin`` and ``NLeading``
+    ConstDataVector<xAOD::CaloClusterContainer> m_selected; //!
 };
 
 
@@ -0,0 +1,139 @@
+#ifndef xAODAnaHelpers_ColumnBatch_H
+#define xAODAnaHelpers_ColumnBatch_H
+
+#include <TTree.h>
+#include <TBranch.h>
+
+#include <memory>
+#include <stdexcept>
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace xAH
+{
+
+  /**
+      @rst
+          Columnar reading of the per-object branches of one collection of an ntuple written by :cpp:class:`HelpTreeBase`, many entries at a time. The values of each branch (``<prefix>_<variable>[_<suffix>]``) over all the objects of the entries read are stored contiguously, and the objects of entry ``i`` of the batch are ``[offsets()[i], offsets()[i+1])``, the layout of a jagged array. Only the branches of the columns are read, with ``TBranch::GetEntry``, and no ``xAH::Jet``-like object is built.
+
+          The ntuple containers give a batch with the columns of their detail string with :cpp:func:`xAH::ParticleContainer::columnBatch`, more can be added with :cpp:func:`addColumn`.
+
+          .. code-block:: c++
+
+              xAH::ColumnBatch batch = jets.columnBatch();
+              batch.addColumn<float>("rapidity");
+              for(Long64_t first = 0; batch.read(tree, first, 10000) > 0; first += 10000){
+                const std::vector<float>& pt = batch.values<float>("pt");
+                ...
+              }
+
+          The columns are ``std::vector`` that PyROOT hands to NumPy without copying them, ``numpy.asarray(batch.values['float']('pt'))``. The arrays are views, only valid until the next :cpp:func:`read`; :py:func:`xAODAnaHelpers.columnar.iterate` loops over a tree that way.
+
+          .. note:: The batch sets the addresses of the branches it reads, and resets them at the end of every :cpp:func:`read` (also when it throws). Reading the tree through a container (:cpp:func:`setTree`) in between batches needs the container to set its addresses again.
+
+      @endrst
+   */
+  class ColumnBatch
+  {
+  public:
+    /// @brief Batch of the branches ``<prefix>_<variable>``, or ``<prefix>_<variable>_<suffix>`` with a suffix
+    ColumnBatch(const std::string& prefix = "", const std::string& suffix = "");
+
+    /// @brief Take over the columns of ``other``, which is left without columns and entries
+    ColumnBatch(ColumnBatch&& other);
+    ColumnBatch& operator=(ColumnBatch&& other);
+
+    /// @brief Read the branch of ``variable``, of ``std::vector<T>``, with the next :cpp:func:`read`. ``T`` is one of ``float``, ``int``, ``char`` and ``unsigned long long``.
+    template <typename T> void addColumn(const std::string& variable)
+    {
+      for(const auto& column : columns<T>()) if(column->variable == variable) return;
+      columns<T>().emplace_back(new Column<T>(variable, branchName(variable)));
+      m_variables.push_back(variable);
+      m_types.push_back(typeName<T>());
+    }
+
+    /**
+        @brief Read the entries ``[first, first+n)`` of ``tree`` (or as many of them as there are), replacing the content of the batch
+        @returns The number of entries read, 0 past the end of the tree. Throws ``std::runtime_error`` if a branch is missing or the columns of an entry have different numbers of objects.
+     */
+    Long64_t read(TTree* tree, Long64_t first, Long64_t n);
+
+    /// @brief Number of entries in the batch
+    std::size_t entries() const { return m_offsets.size() - 1; }
+
+    /// @brief Start of the objects of each entry in the columns, one more than :cpp:func:`entries` with the number of objects last
+    const std::vector<Long64_t>& offsets() const { return m_offsets; }
+
+    /// @brief The values of the column of ``variable``, for all the objects of the batch. Throws ``std::out_of_range`` if it was not added with this type.
+    template <typename T> const std::vector<T>& values(const std::string& variable) const
+    {
+      for(const auto& column : columns<T>()) if(column->variable == variable) return column->values;
+      throw std::out_of_range("xAH::ColumnBatch: no " + typeName<T>() + " column " + variable);
+    }
+
+    /// @brief The variables of the columns, in the order they were added
+    const std::vector<std::string>& variables() const { return m_variables; }
+
+    /// @brief The value type of the column of ``variable`` (``"float"``, ``"int"``...), empty if there is none
+    std::string type(const std::string& variable) const;
+
+  private:
+    template <typename T> struct Column
+    {
+      Column(const std::string& var, const std::string& br) : variable(var), branchName(br), buffer(new std::vector<T>()) {}
+      ~Column() { delete buffer; }
+      Column(const Column&) = delete;
+      Column& operator=(const Column&) = delete;
+
+      std::string variable;
+      std::string branchName;
+      // the branch of the current tree of a chain, reading into buffer during read() only
+      TBranch* branch = nullptr;
+      std::vector<T>* buffer;
+      std::vector<T> values;
+    };
+
+    template <typename T> using Columns = std::vector<std::unique_ptr<Column<T> > >;
+
+    template <typename T> static std::string typeName();
+
+    template <typename T> Columns<T>& columns();
+    template <typename T> const Columns<T>& columns() const { return const_cast<ColumnBatch*>(this)->columns<T>(); }
+
+    std::string branchName(const std::string& variable) const;
+
+    /// @brief Point the columns of type ``T`` to the branches of ``tree``
+    template <typename T> void connect(TTree* tree);
+    /// @brief Forget the branches of the columns of type ``T``, resetting their addresses if ``reset`` (i.e. if their tree still exists)
+    template <typename T> void disconnect(bool reset);
+    /// @brief Same, for the columns of all types
+    void disconnect(bool reset);
+    /// @brief Append entry ``entry`` of the current tree to the columns of type ``T``, which must all have ``nObjects`` objects (any number for -1). Returns the number of objects.
+    template <typename T> Long64_t readEntry(Long64_t entry, Long64_t nObjects);
+
+    std::string m_prefix;                 //!
+    std::string m_suffix;                 //!
+
+    std::vector<std::string> m_variables; //!
+    std::vector<std::string> m_types;     //!
+    Columns<float>              m_floats; //!
+    Columns<int>                m_ints;   //!
+    Columns<char>               m_chars;  //!
+    Columns<unsigned long long> m_words;  //!
+
+    std::vector<Long64_t> m_offsets;      //!
+  };
+
+  template <> inline std::string ColumnBatch::typeName<float>()              { return "float"; }
+  template <> inline std::string ColumnBatch::typeName<int>()                { return "int"; }
+  template <> inline std::string ColumnBatch::typeName<char>()               { return "char"; }
+  template <> inline std::string ColumnBatch::typeName<unsigned long long>() { return "unsigned long long"; }
+
+  template <> inline ColumnBatch::Columns<float>&              ColumnBatch::columns<float>()              { return m_floats; }
+  template <> inline ColumnBatch::Columns<int>&                ColumnBatch::columns<int>()                { return m_ints; }
+  template <> inline ColumnBatch::Columns<char>&               ColumnBatch::columns<char>()               { return m_chars; }
+  template <> inline ColumnBatch::Columns<unsigned long long>& ColumnBatch::columns<unsigned long long>() { return m_words; }
+
+}
+#endif // xAODAnaHelpers_ColumnBatch_H
@@ -0,0 +1,40 @@
+#ifndef xAODAnaHelpers_CpuPinning_H
+#define xAODAnaHelpers_CpuPinning_H
+
+#include <string>
+#include <vector>
+
+namespace xAH {
+
+  /**
+      @rst
+          Pinning of the process to the CPUs of one NUMA node (socket), so that it does not migrate to another socket and the memory it allocates from then on, first of all that of the CP tools, is local to the CPUs using it. The NUMA topology is read from ``/sys/devices/system/node``, and only the CPUs the process is allowed on (e.g. by the batch system) are used. Outside Linux there are no nodes.
+
+          See :cpp:member:`BasicEventSelection::m_pinToNUMANode`.
+
+      @endrst
+   */
+  namespace CpuPinning {
+
+    /// @brief A NUMA node: its number for the kernel, and the CPUs of it the process is allowed on
+    struct Node {
+      int id;
+      std::vector<int> cpus;
+    };
+
+    /// @brief The NUMA nodes with CPUs the process is allowed on
+    std::vector<Node> numaNodes();
+
+    /// @brief Index in ``nodes`` of the node of the CPU the calling thread runs on, -1 if not known
+    int currentNode(const std::vector<Node>& nodes);
+
+    /**
+        @brief Restrict the process (the calling thread and the threads it starts later) to the CPUs of ``node``, and prefer the memory of that node for its new allocations
+        @returns An empty string on success, else the reason of the failure
+     */
+    std::string pinToNode(const Node& node);
+
+  }
+
+}
+#endif
@@ -0,0 +1,341 @@
+#ifndef xAODAnaHelpers_CutTable_H
+#define xAODAnaHelpers_CutTable_H
+
+#include <AthContainers/AuxElement.h>
+
+#include <TH1D.h>
+
+#include <algorithm>
+#include <functional>
+#include <limits>
+#include <string>
+#include <typeinfo>
+#include <vector>
+
+namespace xAH {
+
+  /**
+      @rst
+          The cuts known to the cut caches of all the :cpp:class:`xAH::CutTable` in the job, shared through two decorations of each object holding one bit per cut: whether the cut was evaluated, and whether the object passed it. A cut is identified by a key (the object type and the name of the quantity) and the range it accepts, so that a cut can reuse the results of looser and tighter cuts on the same quantity.
+
+          Cuts are registered in ``initialize()``, which is not thread safe, at most 64 in a job. Further cuts are evaluated normally.
+
+      @endrst
+   */
+  namespace CutCache {
+    /// @brief The bit of the cut accepting ``[min, max]`` of quantity ``key``, registering it if needed. Returns -1 if all bits are taken.
+    int bit(const std::string& key, float min, float max);
+
+    /**
+        @brief Bits of the cuts on the same quantity which decide the cut of bit ``bit``, including itself
+        @param looser   cuts accepting a range containing the one of ``bit``: failing those means failing ``bit``
+        @param tighter  cuts accepting a range contained in the one of ``bit``: passing those means passing ``bit``
+     */
+    void relations(int bit, unsigned long long& looser, unsigned long long& tighter);
+
+    /// @brief Decorations holding the bits of the evaluated cuts and of the passed cuts
+    extern const SG::AuxElement::Decorator<unsigned long long> evaluatedBits;
+    extern const SG::AuxElement::Decorator<unsigned long long> passedBits;
+  }
+
+  /**
+      @rst
+          An ordered list of named cuts on objects of type ``T``, each with its own counters, evaluated as a logical AND.
+
+          Selectors build the table once in ``initialize()`` from their configuration, only adding the cuts which are switched on, and call :cpp:func:`xAH::CutTable::pass` for each object::
+
+              // in the class declaration
+              xAH::CutTable<xAOD::TrackParticle> m_cutTable; //!
+
+              // in initialize()
+              if( m_pT_max != 1e8 ) m_cutTable.addMax("ptmax", [](const xAOD::TrackParticle& trk){ return trk.pt(); }, m_pT_max);
+              for(auto& passKey : m_passKeys) m_cutTable.addFlag(passKey, passKey, '1');
+
+              // in execute()
+              int passSel = m_cutTable.pass(*trk);
+
+          By default the cuts are evaluated in the order they were added and the counters follow the usual cutflow convention: cut ``i`` counts the objects passing all the cuts up to and including ``i``. :cpp:func:`xAH::CutTable::fillCutflow` adds these counts to a cutflow histogram.
+
+          As the cuts are pure functions of the object, the decision does not depend on their order. With :cpp:func:`xAH::CutTable::setAdaptive` the table periodically reorders the cuts so that the ones rejecting the most objects per unit of cost (given when adding the cut) are evaluated first. The counters then count the objects passing a cut among the ones which reached it, which is what the reordering needs, but is not a cutflow anymore: do not combine adaptive ordering with a cutflow.
+
+          With :cpp:func:`xAH::CutTable::setCache` the results of the cuts on a range of a value and of the flag cuts are recorded on the objects (see :cpp:any:`xAH::CutCache`), and taken from there when a table with a cut on the same quantity already decided it, e.g. a preselection followed by a tighter selection on the same container. The range cuts are identified by their name, so two tables caching their results must only use the same name on the same object type for the same quantity. Cuts added with :cpp:func:`xAH::CutTable::add` depend on more than the object (tools, vertices, ...) and are always evaluated.
+
+      @endrst
+   */
+  template <typename T>
+  class CutTable {
+    public:
+      typedef std::function<bool(const T&)>  Predicate;
+      typedef std::function<float(const T&)> Value;
+
+      /**
+          @brief Add a cut, returns its index
+          @param name   the name of the cut, used as the cutflow bin label
+          @param pass   ``true`` if the object passes the cut
+          @param cost   relative cost of evaluating the cut, used by the adaptive ordering only
+       */
+      unsigned int add(const std::string& name, Predicate pass, float cost = 1.){
+        Cut cut;
+        cut.name   = name;
+        cut.pass   = pass;
+        cut.cost   = cost > 0 ? cost : 1.;
+        m_cuts.push_back(cut);
+        m_order.push_back(m_cuts.size()-1);
+        return m_cuts.size()-1;
+      }
+
+      /// @brief Add the cut ``value(obj) <= max``
+      unsigned int addMax(const std::string& name, Value value, float max, float cost = 1.){
+        return addRange(name, value, -std::numeric_limits<float>::infinity(), max, cost);
+      }
+
+      /// @brief Add the cut ``value(obj) >= min``
+      unsigned int addMin(const std::string& name, Value value, float min, float cost = 1.){
+        return addRange(name, value, min, std::numeric_limits<float>::infinity(), cost);
+      }
+
+      /// @brief Add the cut ``min <= value(obj) <= max``
+      unsigned int addRange(const std::string& name, Value value, float min, float max, float cost = 1.){
+        const unsigned int index = add(name, [value, min, max](const T& obj){ const float v = value(obj); return !(v < min) && !(v > max); }, cost);
+        m_cuts[index].value    = value;
+        m_cuts[index].min      = min;
+        m_cuts[index].max      = max;
+        m_cuts[index].cacheKey = std::string(typeid(T).name()) + "/" + name;
+        return index;
+      }
+
+      /// @brief Add the cut ``obj.auxdata<char>(auxName) == required``
+      unsigned int addFlag(const std::string& name, const std::string& auxName, char required, float cost = 1.){
+        SG::AuxElement::ConstAccessor<char> acc(auxName);
+        const unsigned int index = add(name, [acc, required](const T& obj){ return acc(obj) == required; }, cost);
+        m_cuts[index].min      = required;
+        m_cuts[index].max      = required;
+        m_cuts[index].cacheKey = "flag/" + auxName;
+        return index;
+      }
+
+      /// @brief Record the results of the cuts which can be cached on the objects, and reuse the ones recorded before. Call it after adding all the cuts.
+      void setCache(bool cache){
+        m_cache = cache;
+        for(Cut& cut : m_cuts){
+          cut.bit = -1;
+          if(!m_cache || cut.cacheKey.empty()) continue;
+          cut.bit = CutCache::bit(cut.cacheKey, cut.min, cut.max);
+          if(cut.bit >= 0) CutCache::relations(cut.bit, cut.looser, cut.tighter);
+        }
+      }
+
+      /**
+          @brief Reorder the cuts from their observed rejection
+          @param adaptive   switch the reordering on or off. Switching it off goes back to the order the cuts were added in.
+          @param interval   number of objects evaluated between two reorderings
+       */
+      void setAdaptive(bool adaptive, unsigned int interval = 1000){
+        m_adaptive = adaptive;
+        m_interval = interval > 0 ? interval : 1;
+        m_sinceReorder = 0;
+        if(!m_adaptive){
+          for(unsigned int i = 0; i < m_order.size(); ++i) m_order[i] = i;
+        }
+      }
+
+      /// @brief Evaluate all the cuts on ``obj``, updating the counters
+      bool pass(const T& obj){
+        ++m_nObjects;
+        if(m_cache) return passCached(obj);
+        for(unsigned int index : m_order){
+          Cut& cut = m_cuts[index];
+          ++cut.nTested;
+          if(!cut.pass(obj)) return finish(false);
+          ++cut.nPassed;
+        }
+        return finish(true);
+      }
+
+      /**
+          @brief Evaluate the cuts on all the objects of ``container`` at once
+          @param container   any range of pointers to ``T``, e.g. a DataVector
+          @param decisions   replaced by one entry per object, 1 if the object passes all the cuts
+          @returns the number of objects passing
+
+          The cuts are evaluated one after the other on the objects which passed the previous ones. The values of the cuts added with :cpp:func:`xAH::CutTable::addMin`/:cpp:func:`xAH::CutTable::addMax` are first gathered in a buffer and then compared in a loop without any call, which the compiler can vectorise. The decisions and the counters are the same as calling :cpp:func:`xAH::CutTable::pass` on every object.
+       */
+      template <typename CONTAINER>
+      unsigned int passAll(const CONTAINER& container, std::vector<char>& decisions){
+        return passAll(container.begin(), container.end(), decisions);
+      }
+
+      /// @brief Same as above for the objects in ``[begin, end)``
+      template <typename ITERATOR>
+      unsigned int passAll(ITERATOR begin, ITERATOR end, std::vector<char>& decisions){
+        if(m_cache){
+          // the cached results are per object
+          decisions.clear();
+          unsigned int nPass = 0;
+          for(ITERATOR it = begin; it != end; ++it){
+            const T* obj = *it;
+            decisions.push_back(pass(*obj));
+            nPass += decisions.back();
+          }
+          return nPass;
+        }
+
+        m_objects.clear();
+        for(ITERATOR it = begin; it != end; ++it) m_objects.push_back(*it);
+        const unsigned int nObjects = m_objects.size();
+        m_nObjects += nObjects;
+
+        decisions.assign(nObjects, 1);
+        m_alive.resize(nObjects);
+        for(unsigned int i = 0; i < nObjects; ++i) m_alive[i] = i;
+
+        unsigned int nAlive = nObjects;
+        for(unsigned int index : m_order){
+          if(nAlive == 0) break;
+          Cut& cut = m_cuts[index];
+          cut.nTested += nAlive;
+
+          m_mask.resize(nAlive);
+          if(cut.value){
+            m_column.resize(nAlive);
+            for(unsigned int k = 0; k < nAlive; ++k) m_column[k] = cut.value(*m_objects[m_alive[k]]);
+            const float min = cut.min, max = cut.max;
+            const float* column = m_column.data();
+            char* mask = m_mask.data();
+            for(unsigned int k = 0; k < nAlive; ++k) mask[k] = !(column[k] < min) & !(column[k] > max);
+          } else {
+            for(unsigned int k = 0; k < nAlive; ++k) m_mask[k] = cut.pass(*m_objects[m_alive[k]]);
+          }
+
+          // keep the objects passing, in their original order
+          unsigned int nKept = 0;
+          for(unsigned int k = 0; k < nAlive; ++k){
+            if(m_mask[k]) m_alive[nKept++] = m_alive[k];
+            else          decisions[m_alive[k]] = 0;
+          }
+          nAlive = nKept;
+          cut.nPassed += nAlive;
+        }
+
+        if(m_adaptive){
+          m_sinceReorder += nObjects;
+          if(m_sinceReorder >= m_interval){
+            m_sinceReorder = 0;
+            reorder();
+          }
+        }
+        return nAlive;
+      }
+
+      /// @brief Add the counts of each cut to the bin labelled with its name, recording only the counts since the last call
+      void fillCutflow(TH1D* hist, const std::string& allLabel = "all"){
+        if(!hist) return;
+        const int allBin = hist->GetXaxis()->FindBin(allLabel.c_str());
+        hist->AddBinContent(allBin, m_nObjects - m_nObjectsFilled);
+        m_nObjectsFilled = m_nObjects;
+        for(Cut& cut : m_cuts){
+          const int bin = hist->GetXaxis()->FindBin(cut.name.c_str());
+          hist->AddBinContent(bin, cut.nPassed - cut.nPassedFilled);
+          cut.nPassedFilled = cut.nPassed;
+        }
+      }
+
+      /// @brief Number of cuts
+      unsigned int size() const { return m_cuts.size(); }
+      /// @brief Name of cut ``index``, in the order the cuts were added in
+      const std::string& name(unsigned int index) const { return m_cuts.at(index).name; }
+      /// @brief Number of objects cut ``index`` was evaluated on
+      unsigned long nTested(unsigned int index) const { return m_cuts.at(index).nTested; }
+      /// @brief Number of objects passing cut ``index``
+      unsigned long nPassed(unsigned int index) const { return m_cuts.at(index).nPassed; }
+      /// @brief Number of objects evaluated
+      unsigned long nObjects() const { return m_nObjects; }
+      /// @brief The indices of the cuts in the order they are currently evaluated in
+      const std::vector<unsigned int>& order() const { return m_order; }
+
+    private:
+      struct Cut {
+        std::string   name;
+        Predicate     pass;
+        /// @brief set for the cuts on a range of a value, evaluated as a column by passAll
+        Value         value;
+        float         min = 0.;
+        float         max = 0.;
+        float         cost = 1.;
+        /// @brief set for the cuts which can be cached
+        std::string   cacheKey;
+        int           bit = -1;
+        unsigned long long looser = 0;
+        unsigned long long tighter = 0;
+        unsigned long nTested = 0;
+        unsigned long nPassed = 0;
+        unsigned long nPassedFilled = 0;
+      };
+
+      bool passCached(const T& obj){
+        unsigned long long evaluated = CutCache::evaluatedBits.isAvailable(obj) ? CutCache::evaluatedBits(obj) : 0;
+        unsigned long long passed    = CutCache::passedBits.isAvailable(obj)    ? CutCache::passedBits(obj)    : 0;
+
+        bool result = true;
+        for(unsigned int index : m_order){
+          Cut& cut = m_cuts[index];
+          ++cut.nTested;
+          bool passCut;
+          if(cut.bit >= 0 && (evaluated & cut.looser & ~passed)) passCut = false;
+          else if(cut.bit >= 0 && (evaluated & cut.tighter & passed)) passCut = true;
+          else {
+            passCut = cut.pass(obj);
+            if(cut.bit >= 0){
+              const unsigned long long bit = 1ULL << cut.bit;
+              evaluated |= bit;
+              if(passCut) passed |= bit;
+              else        passed &= ~bit;
+            }
+          }
+          if(!passCut){ result = false; break; }
+          ++cut.nPassed;
+        }
+
+        CutCache::evaluatedBits(obj) = evaluated;
+        CutCache::passedBits(obj)    = passed;
+        return finish(result);
+      }
+
+      bool finish(bool result){
+        if(m_adaptive && ++m_sinceReorder >= m_interval){
+          m_sinceReorder = 0;
+          reorder();
+        }
+        return result;
+      }
+
+      /// @brief Sort the cuts by decreasing rejection per unit cost, keeping the order of cuts not evaluated yet
+      void reorder(){
+        std::stable_sort(m_order.begin(), m_order.end(), [this](unsigned int a, unsigned int b){
+            return score(m_cuts[a]) > score(m_cuts[b]);
+          });
+      }
+
+      static float score(const Cut& cut){
+        if(cut.nTested == 0) return 0.;
+        return (1. - static_cast<float>(cut.nPassed)/cut.nTested)/cut.cost;
+      }
+
+      std::vector<Cut>          m_cuts;
+      std::vector<unsigned int> m_order;
+      bool                      m_adaptive = false;
+      bool                      m_cache = false;
+      unsigned int              m_interval = 1000;
+      unsigned int              m_sinceReorder = 0;
+      unsigned long             m_nObjects = 0;
+      unsigned long             m_nObjectsFilled = 0;
+
+      // buffers of passAll, kept between calls for their capacity
+      std::vector<const T*>     m_objects;
+      std::vector<unsigned int> m_alive;
+      std::vector<float>        m_column;
+      std::vector<char>         m_mask;
+  };
+
+}
+#endif
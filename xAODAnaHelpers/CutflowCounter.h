@@ -0,0 +1,81 @@
+#ifndef xAODAnaHelpers_CutflowCounter_H
+#define xAODAnaHelpers_CutflowCounter_H
+
+#include <TH1D.h>
+
+#include <vector>
+
+namespace xAH {
+
+  /**
+      @rst
+          Counts the objects passing each cut of an object cutflow in plain arrays, and adds them to the cutflow histogram in :cpp:func:`xAH::CutflowCounter::flush`.
+
+          The object cutflows (``cutflow_muons_1``, ``cutflow_electrons_1``, ...) are filled once per object per cut. This replaces each ``TH1D::Fill`` by an array increment (with compensated summation, so many small weights do not lose precision), the histogram is only touched when flushing, typically in ``finalize()``. The bin numbers are the ones returned by ``FindBin(label)`` on the histogram, exactly as used with ``Fill`` before, so the histogram ends up with the same contents, errors, entries and statistics::
+
+              // in initialize()
+              m_mu_cutflowHist_1 = (TH1D*)file->Get("cutflow_muons_1");
+              m_mu_cutflow_all   = m_mu_cutflowHist_1->GetXaxis()->FindBin("all");
+              m_mu_cutflowCounter_1.setHist(m_mu_cutflowHist_1);
+
+              // in execute()
+              m_mu_cutflowCounter_1.fill( m_mu_cutflow_all );
+
+              // in finalize()
+              m_mu_cutflowCounter_1.flush();
+
+          Several counters can flush into the same histogram, e.g. when it is shared by multiple algorithms.
+
+      @endrst
+   */
+  class CutflowCounter {
+    public:
+      /// @brief Set the histogram filled by flush. Counts not flushed yet are kept.
+      void setHist(TH1D* hist) { m_hist = hist; }
+      TH1D* hist() const { return m_hist; }
+
+      /// @brief Equivalent to ``hist()->Fill(bin, weight)`` for the integer bin numbers of a cutflow
+      void fill(int bin, double weight = 1.){
+        if(bin < 0) return;
+        if(static_cast<unsigned int>(bin) >= m_sumw.size()){
+          m_sumw.resize(bin+1, 0.);
+          m_sumw2.resize(bin+1, 0.);
+          m_sumwC.resize(bin+1, 0.);
+          m_sumw2C.resize(bin+1, 0.);
+        }
+        if(weight != 1.) m_weighted = true;
+        kahanAdd(m_sumw[bin],  m_sumwC[bin],  weight);
+        kahanAdd(m_sumw2[bin], m_sumw2C[bin], weight*weight);
+        m_stats[0] += weight;
+        m_stats[1] += weight*weight;
+        m_stats[2] += weight*bin;
+        m_stats[3] += weight*bin*bin;
+        m_entries++;
+      }
+
+      /// @brief Add the counts to the histogram and reset them
+      void flush();
+
+    private:
+      /// @brief Compensated (Kahan) summation: ``sum - compensation`` is the sum of all the added values
+      static void kahanAdd(double& sum, double& compensation, double value){
+        const double y = value - compensation;
+        const double t = sum + y;
+        compensation = (t - sum) - y;
+        sum = t;
+      }
+
+      TH1D* m_hist = nullptr;
+      std::vector<double> m_sumw;
+      std::vector<double> m_sumw2;
+      /// @brief running compensations of ``m_sumw`` and ``m_sumw2``
+      std::vector<double> m_sumwC;
+      std::vector<double> m_sumw2C;
+      double m_stats[4] = {0., 0., 0., 0.};
+      double m_entries = 0.;
+      /// @brief a weight other than 1 was counted since the last flush, the histogram then needs its sum of squared weights
+      bool m_weighted = false;
+  };
+
+}
+#endif
@@ -5,6 +5,8 @@
 // algorithm wrapper
 #include "xAODAnaHelpers/Algorithm.h"
 
+#include <set>
+
 class DebugTool : public xAH::Algorithm
 {
   // put your configuration variables here as public variables.
@@ -13,8 +15,33 @@ public:
 
   // configuration variables
 
+  /// @brief Print the content of the TStore
   bool m_printStore = false;
 
+  /**
+    @rst
+      Print a census of the containers in the TStore: one line per container with its number of elements, number of aux variables and an approximate memory footprint (aux variable element size :math:`\times` number of elements). View containers own no aux data and are reported with zero memory, shallow copies are reported with the variables of the container they copy.
+
+    @endrst
+   */
+  bool m_storeCensus = false;
+
+  /// @brief Only print on every N-th event seen by this algorithm (the first one included)
+  unsigned int m_printEveryNEvents = 1;
+
+  /// @brief Comma separated list of event numbers to print on, if set this is used instead of ``m_printEveryNEvents``
+  std::string m_printEventNumbers = "";
+
+private:
+
+  unsigned long long m_eventCounter = 0; //!
+  std::set<unsigned long long> m_printEventNumberSet; //!
+
+  /// @brief Whether the current event is one of the sampled events
+  bool printThisEvent ();
+
+  void printStoreCensus () const;
+
 public:
 
   // this is a standard constructor
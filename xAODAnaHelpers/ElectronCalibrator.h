@@ -69,6 +69,8 @@ public:
 
   std::string m_esModel = "";
   std::string m_decorrelationModel = "";
+  /// @brief Name under which the EgammaCalibrationAndSmearingTool is shared with the other egamma calibrators setting the same name. The first one to initialize configures the tool, the others reuse it as it is.
+  std::string m_sharedCalibToolName = "";
 
   /** @brief Apply isolation correction, not needed by default */
   bool m_applyIsolationCorrection = false;
@@ -85,6 +87,8 @@ private:
 
   // tools
   CP::EgammaCalibrationAndSmearingTool *m_EgammaCalibrationAndSmearingTool = nullptr; //!
+  /// @brief The calibration tool was created, and is deleted, by this algorithm
+  bool m_ownsCalibTool = false; //!
   /// @brief apply leakage correction to calo based isolation variables for electrons
   CP::IsolationCorrectionTool          *m_IsolationCorrectionTool = nullptr;          //!
 
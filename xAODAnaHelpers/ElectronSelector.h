@@ -26,6 +26,8 @@
 
 // algorithm wrapper
 #include "xAODAnaHelpers/Algorithm.h"
+#include "xAODAnaHelpers/IsolationDecisions.h"
+#include "xAODAnaHelpers/CutflowCounter.h"
 
 // forward-declare for now until IsolationSelectionTool interface is updated
 namespace CP {
@@ -83,6 +85,8 @@ public:
   int        	 m_pass_min = -1;
   /// @brief Require event to have maximum number of objects passing selection
   int        	 m_pass_max = -1;
+  /// @brief Stop evaluating electrons once the event is rejected by m_pass_min/m_pass_max, the remaining ones are decorated with -1 like for m_nToProcess
+  bool m_stopWhenRejected = false;
   /// @brief [MeV] Require objects to have maximum transverse momentum threshold
   float      	 m_pT_max = 1e8;
   /// @brief [MeV] Require objects to have minimum transverse momentum threshold
@@ -177,7 +181,8 @@ public:
 /* trigger matching */
   /**
     @brief A comma-separated string w/ alll the HLT single electron trigger chains for which you want to perform the matching.
-          This is passed by the user as input in configuration If left empty (as it is by default), no trigger matching will be attempted at all
+          This is passed by the user as input in configuration If left empty (as it is by default), no trigger matching will be attempted at all.
+          The results are stored in the ``trigMatchTestedBitsEl`` and ``isTrigMatchedBitsEl`` decorations (see xAH::TrigMatchBits), not in an ``isTrigMatchedMapEl`` map anymore.
   */
   std::string    m_singleElTrigChains = "";
   /**
@@ -235,6 +240,9 @@ private:
 
   TH1D* m_el_cutflowHist_1 = nullptr;            //!
   TH1D* m_el_cutflowHist_2 = nullptr;            //!
+  /// @brief counts for the object cutflows, flushed into the histograms in finalize
+  xAH::CutflowCounter m_el_cutflowCounter_1; //!
+  xAH::CutflowCounter m_el_cutflowCounter_2; //!
 
   int   m_el_cutflow_all;              //!
   int   m_el_cutflow_author_cut;       //!
@@ -250,6 +258,8 @@ private:
   int   m_el_cutflow_iso_cut;          //!
 
   std::vector<std::string> m_IsoKeys;  //!
+  xAH::IsolationDecisions m_isoDecisions; //!
+  int m_passSelBit = -1; //!  /* the bit of passSel in xAH::SelectionFlags */
 
   /* tools */
 
@@ -279,6 +289,14 @@ private:
     contains all the HLT trigger chains tokens extracted from :cpp:member:`~ElectronSelector::m_diElTrigChains`
   @endrst */
   std::vector<std::string>            m_diElTrigChainsList;      //!
+  /** @rst
+    the bit of each chain of :cpp:member:`~ElectronSelector::m_singleElTrigChainsList` in the trigger matching decorations, see :cpp:any:`xAH::TrigMatchBits`
+  @endrst */
+  std::vector<unsigned int>           m_singleElTrigChainsBits;  //!
+  /** @rst
+    the bit of each chain of :cpp:member:`~ElectronSelector::m_diElTrigChainsList` in the trigger matching decorations
+  @endrst */
+  std::vector<unsigned int>           m_diElTrigChainsBits;      //!
 
 public:
 
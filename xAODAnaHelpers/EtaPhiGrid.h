@@ -0,0 +1,54 @@
+#ifndef xAODAnaHelpers_EtaPhiGrid_H
+#define xAODAnaHelpers_EtaPhiGrid_H
+
+#include <xAODBase/IParticleContainer.h>
+
+#include <utility>
+#include <vector>
+
+namespace xAH {
+
+  /**
+      @rst
+          A neighbour index of the particles of one container, bucketed in cells of rapidity and :math:`\phi`.
+
+          With a cell size at least as large as the :math:`\Delta R` of the query, the neighbours of a particle are in the 3x3 cells around it, so :cpp:func:`xAH::EtaPhiGrid::hasNeighbour` looks at a handful of particles instead of the whole container. Rapidity is used by default, like the :math:`\Delta R` of the overlap removal tools, pseudorapidity on request (like ``TLorentzVector::DeltaR``).
+
+          The arrays keep their capacity between events, so a long-lived instance is best::
+
+              m_grid.fill(jets, 0.4);
+              if(!m_grid.hasNeighbour(muon, 0.4)) { ... }
+
+      @endrst
+   */
+  class EtaPhiGrid {
+    public:
+      /// @brief Index the particles of ``particles`` in cells of size ``cellSize``, replacing the previous content. A null pointer leaves it empty. With ``useRapidity`` false, the cells and distances use the pseudorapidity.
+      void fill(const xAOD::IParticleContainer* particles, float cellSize, bool useRapidity = true);
+
+      /// @brief Whether a particle other than ``particle`` itself, and above ``minPt`` if it is positive, is within ``dR`` of it. ``dR`` must not be larger than the cell size.
+      bool hasNeighbour(const xAOD::IParticle* particle, float dR, float minPt = -1.) const;
+
+      /// @brief Number of indexed particles
+      unsigned int size() const { return m_particles.size(); }
+
+    private:
+      long long cellKey(int iy, int iphi) const { return static_cast<long long>(iy)*m_nPhi + iphi; }
+      int yCell(float y) const;
+      int phiCell(float phi) const;
+
+      float y(const xAOD::IParticle* particle) const { return m_useRapidity ? particle->rapidity() : particle->eta(); }
+
+      float m_cellSize = 1.;
+      int m_nPhi = 1;
+      bool m_useRapidity = true;
+      std::vector<const xAOD::IParticle*> m_particles;
+      std::vector<float> m_y;
+      std::vector<float> m_phi;
+      std::vector<float> m_pt;
+      /// @brief ``(cell, particle index)``, sorted by cell
+      std::vector<std::pair<long long, unsigned int> > m_cells;
+  };
+
+}
+#endif
@@ -0,0 +1,107 @@
+#ifndef xAODAnaHelpers_EventArena_H
+#define xAODAnaHelpers_EventArena_H
+
+#include <cstddef>
+#include <memory>
+#include <string>
+#include <vector>
+
+class TH1D;
+
+namespace xAH {
+
+  /**
+      @rst
+          A per-event arena for the intermediate containers of the event loop: allocations are a pointer increment in a block of memory, nothing is freed individually, and the whole arena is reset at the start of the next event (by :cpp:func:`xAH::Algorithm::beginEvent`, once the ``xAOD::TStore`` of the previous event is cleared). After the first events the arena is one block large enough for an event, so these containers no longer allocate from the heap at all.
+
+          Containers use it through :cpp:class:`xAH::ArenaAllocator`::
+
+              xAH::ArenaVector<const xAOD::IParticle*> isolated;
+              isolated.reserve(jets->size());
+
+          .. warning:: Arena memory is only valid until the end of the event: only use it for containers local to ``execute()``, never for members or anything recorded to the ``xAOD::TStore`` (which deletes what it owns). It is not thread safe: do not allocate from it in the work of :cpp:func:`xAH::Algorithm::forEachSystematic`.
+
+      @endrst
+   */
+  class EventArena {
+    public:
+      /// @brief The arena of the event loop
+      static EventArena& instance();
+
+      /// @brief ``bytes`` of memory aligned to ``alignment``, valid until the next :cpp:func:`xAH::EventArena::reset`
+      void* allocate(std::size_t bytes, std::size_t alignment);
+
+      /// @brief Forget all the allocations, merging the blocks into one large enough for all of them
+      void reset();
+      /// @brief Reset if ``(entry, file)`` is not the event of the previous call
+      void newEvent(long long entry, const void* file) {
+        if(entry == m_entry && file == m_file) return;
+        m_entry = entry;
+        m_file = file;
+        ++m_events;
+        reset();
+      }
+
+      /// @brief Number of allocations served, each of them a heap allocation saved
+      unsigned long long allocations() const { return m_allocations; }
+      /// @brief Bytes served
+      unsigned long long bytes() const { return m_bytes; }
+      /// @brief Number of blocks taken from the heap
+      unsigned long long blockAllocations() const { return m_blockAllocations; }
+      /// @brief Total size of the blocks
+      std::size_t capacity() const;
+
+      /**
+          @brief Build a histogram summarising the use of the arena
+          @param name   The name (and title) of the histogram
+
+          The bins are labelled ``events``, ``allocations``, ``bytes``, ``heap_blocks`` and ``capacity``. The caller owns the histogram.
+       */
+      TH1D* makeHist(const std::string& name) const;
+
+    private:
+      EventArena() = default;
+
+      /// @brief size of the first block
+      static constexpr std::size_t minBlockSize = 64*1024;
+
+      struct Block {
+        std::unique_ptr<char[]> data;
+        std::size_t size;
+      };
+      std::vector<Block> m_blocks;
+      /// @brief the block allocations come from, and the bytes of it already used
+      std::size_t m_block = 0;
+      std::size_t m_offset = 0;
+
+      long long m_entry = -1;
+      const void* m_file = nullptr;
+
+      unsigned long long m_events = 0;
+      unsigned long long m_allocations = 0;
+      unsigned long long m_bytes = 0;
+      unsigned long long m_blockAllocations = 0;
+  };
+
+  /// @brief STL allocator taking its memory from :cpp:func:`xAH::EventArena::instance`, deallocation is a no-op
+  template <typename T>
+  class ArenaAllocator {
+    public:
+      typedef T value_type;
+
+      ArenaAllocator() noexcept {}
+      template <typename U> ArenaAllocator(const ArenaAllocator<U>&) noexcept {}
+
+      T* allocate(std::size_t n) { return static_cast<T*>(EventArena::instance().allocate(n*sizeof(T), alignof(T))); }
+      void deallocate(T*, std::size_t) noexcept {}
+
+      template <typename U> bool operator==(const ArenaAllocator<U>&) const noexcept { return true; }
+      template <typename U> bool operator!=(const ArenaAllocator<U>&) const noexcept { return false; }
+  };
+
+  /// @brief A ``std::vector`` in the :cpp:class:`xAH::EventArena`
+  template <typename T>
+  using ArenaVector = std::vector<T, ArenaAllocator<T> >;
+
+}
+#endif
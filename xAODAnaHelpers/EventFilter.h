@@ -0,0 +1,55 @@
+#ifndef xAODAnaHelpers_EventFilter_H
+#define xAODAnaHelpers_EventFilter_H
+
+#include <xAODBase/IParticleContainer.h>
+
+#include <memory>
+#include <string>
+#include <vector>
+
+namespace xAH {
+
+  /**
+      @rst
+          A small event selection expression, evaluated on the xAOD containers of the event, e.g.::
+
+              njet>=2 && jet_pt[0]>100 && (nmuon==0 || muon_pt[0]<20)
+
+          The supported variables are ``n<name>`` (number of objects) and ``<name>_<var>[i]`` (``<var>`` of object ``i``) for ``<var>`` one of ``pt``, ``eta``, ``phi``, ``E``, ``m``, ``y``, where ``<name>`` is a collection name registered by the caller, e.g. the branch name of a container. Energies and momenta are in the units given to :cpp:func:`xAH::EventFilter::initialize`. Comparisons (``< <= > >= == !=``) can be combined with ``&&``, ``||``, ``!`` and parentheses. A comparison involving an object beyond the end of its container is false.
+
+      @endrst
+   */
+  class EventFilter {
+    public:
+      EventFilter();
+      ~EventFilter();
+
+      /// @brief Parse ``expression``. Returns false and sets ``error`` if it is malformed. An empty expression accepts every event.
+      bool initialize(const std::string& expression, float units, std::string& error);
+
+      /// @brief Whether an expression was set
+      bool active() const { return static_cast<bool>(m_root); }
+
+      /// @brief The collections the expression refers to, in the order used by :cpp:func:`xAH::EventFilter::setCollection`
+      const std::vector<std::string>& collections() const { return m_collections; }
+
+      /// @brief Set the container of collection ``name`` for the current event. Unset collections count as empty.
+      void setCollection(const std::string& name, const xAOD::IParticleContainer* container);
+
+      /// @brief Forget the containers of the previous event
+      void clearCollections();
+
+      /// @brief Evaluate the expression for the current event
+      bool pass() const;
+
+      struct Node;
+
+    private:
+      std::unique_ptr<Node> m_root;
+      std::vector<std::string> m_collections;
+      std::vector<const xAOD::IParticleContainer*> m_containers;
+      float m_units;
+  };
+
+}
+#endif
@@ -0,0 +1,65 @@
+#ifndef xAODAnaHelpers_EventIndex_H
+#define xAODAnaHelpers_EventIndex_H
+
+#include <string>
+#include <vector>
+
+#include <Rtypes.h>
+
+class TDirectory;
+class TTree;
+
+namespace xAH {
+
+  /**
+      @rst
+          A ``(runNumber, eventNumber)`` to entry index of an output file, written next to the output as a small tree sorted by run and event number, so that a few events can be picked out of a large output without reading it.
+
+          The writing algorithms (:cpp:class:`TreeAlgo`, :cpp:class:`MinixAOD`) :cpp:func:`xAH::EventIndex::add` each event they write and :cpp:func:`xAH::EventIndex::write` the index at the end of the job. The index tree has the ``runNumber/I``, ``eventNumber/L`` and ``entry/L`` branches. To use it, e.g.
+
+          .. code-block:: c++
+
+              xAH::EventIndex index;
+              index.read( static_cast<TTree*>(file->Get("TreeAlgo/EventIndex")) );
+              Long64_t entry = index.find(runNumber, eventNumber);
+              if(entry >= 0) nominal->GetEntry(entry);
+
+          The entries are the ones of the file the index was written to. Merging outputs (e.g. with ``hadd``) shifts the entries of all but the first file, so the index is meant for the outputs of the grid or batch jobs as they are.
+
+      @endrst
+   */
+  class EventIndex {
+    public:
+      /// @brief Record that event ``eventNumber`` of run ``runNumber`` is entry ``entry`` of the output
+      void add(int runNumber, Long64_t eventNumber, Long64_t entry);
+
+      /// @brief Write the index as the tree ``name`` in ``dir``, sorted by run and event number
+      void write(TDirectory* dir, const std::string& name = "EventIndex");
+
+      /// @brief Replace the index by the one stored in ``tree``, returns false if it is not an index tree
+      bool read(TTree* tree);
+
+      /// @brief The entry of the event, -1 if it is not in the index. Only valid after :cpp:func:`xAH::EventIndex::read` or :cpp:func:`xAH::EventIndex::write`, which sort the index
+      Long64_t find(int runNumber, Long64_t eventNumber) const;
+
+      /// @brief Number of events in the index
+      std::size_t size() const { return m_entries.size(); }
+
+      /// @brief Forget all events
+      void clear();
+
+    private:
+      struct Entry {
+        int runNumber;
+        Long64_t eventNumber;
+        Long64_t entry;
+      };
+
+      void sort();
+
+      std::vector<Entry> m_entries;
+      bool m_sorted = true;
+  };
+
+}
+#endif
@@ -2,7 +2,9 @@
 #define xAODAnaHelpers_EventInfo_H
 
 #include <TTree.h>
+#include <TList.h>
 #include <string>
+#include <vector>
 
 #include "xAODEventInfo/EventInfo.h"
 #include "xAODTracking/VertexContainer.h"
@@ -95,6 +97,19 @@ namespace xAH {
     std::vector<float> m_caloCluster_phi;
     std::vector<float> m_caloCluster_e;
 
+    // weightsArray: m_nWeightsArray entries of m_weightsArray are valid, named by m_weightsArrayNames
+    int      m_nWeightsArray;
+    std::vector<float> m_weightsArray;
+    std::vector<std::string> m_weightsArrayNames;
+
+  private:
+
+    void fillWeightsArray( const xAOD::EventInfo* eventInfo, xAOD::TEvent* event );
+    void resizeWeightsArray( std::size_t n );
+
+    TBranch* m_weightsArrayBranch;
+    TList*   m_weightsArrayDictionary;
+
   };
 
   template <typename T_BR> void EventInfo::connectBranch(TTree *tree, std::string name, T_BR *variable)
@@ -0,0 +1,46 @@
+#ifndef xAODAnaHelpers_EventNumberSet_H
+#define xAODAnaHelpers_EventNumberSet_H
+
+#include <cstdint>
+#include <unordered_map>
+#include <vector>
+
+namespace xAH {
+
+  /**
+      @rst
+          The set of ``(runNumber, eventNumber)`` pairs seen so far, used to find duplicated events.
+
+          There is one open-addressing hash table of event numbers per run, 8 to 16 bytes per event, instead of a tree node per event. The table of the last run is cached, as consecutive events are almost always from the same run. :cpp:func:`xAH::EventNumberSet::clear` forgets everything, e.g. at a run boundary when the input is known to be ordered by run.
+
+      @endrst
+   */
+  class EventNumberSet {
+    public:
+      /// @brief Add the event, returns false if it was already there
+      bool insert(uint32_t runNumber, uint64_t eventNumber);
+
+      /// @brief Forget all events
+      void clear();
+
+      /// @brief Number of events in the set
+      std::size_t size() const;
+
+    private:
+      /// @brief Event numbers of one run. 0 marks empty slots, so event number 0 is flagged separately.
+      struct RunTable {
+        std::vector<uint64_t> slots;
+        std::size_t size = 0;
+        bool hasZero = false;
+      };
+
+      static bool insert(RunTable& table, uint64_t eventNumber);
+      static void grow(RunTable& table);
+
+      std::unordered_map<uint32_t, RunTable> m_runs;
+      uint32_t m_lastRun = 0;
+      RunTable* m_lastTable = nullptr;
+  };
+
+}
+#endif
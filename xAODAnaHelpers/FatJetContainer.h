@@ -33,8 +33,31 @@ namespace xAH {
       virtual void FillFatJet( const xAOD::IParticle* particle, int pvLocation=0 );
       using ParticleContainer::setTree; // make other overloaded version of execute() to show up in subclass
 
+      /// @brief Also copies the associated track jets, see :cpp:func:`xAH::ParticleContainer::copyFrom`
+      virtual bool copyFrom(const ParticleContainer& other);
+
+      virtual void updateEntry();
+      virtual void updateEntryLazy();
+
+      /**
+          @rst
+              Read-back access to the associated track jets that does not copy them into each :cpp:class:`xAH::FatJet`. Set :cpp:member:`~xAH::FatJetContainer::m_copyTrkJets` to false, then after loading an entry::
+
+                  for(unsigned int iTrkJet : fatjets->trkJetIndices(idx, "GhostVR30Rmax4Rmin02TrackJet"))
+                    const xAH::Jet& trkJet = fatjets->trackJet("GhostVR30Rmax4Rmin02TrackJet", iTrkJet);
+
+              The track jets are decoded once per entry, on first use. The span and the references are valid until the next entry is loaded.
+
+          @endrst
+       */
+      xAH::JaggedBranch<unsigned int>::Span trkJetIndices(uint idx, const std::string& trackJetName) const;
+
+      /// @brief Track jet ``iTrkJet`` of the ``trackJetName`` collection of the current entry, see :cpp:func:`~xAH::FatJetContainer::trkJetIndices`
+      const Jet& trackJet(const std::string& trackJetName, uint iTrkJet);
+
       float       m_trackJetPtCut  =10e3; // slimming pT cut on associated track jets
       float       m_trackJetEtaCut =2.5;  // slimmint eta cut on associated track jets
+      bool        m_copyTrkJets    =true; // fill FatJet::trkJets when reading back, see trkJetIndices()
 
     protected:
 
@@ -97,11 +120,11 @@ namespace xAH {
       std::vector< int > *m_numConstituents;
 
       // constituentAll
-      std::vector< std::vector<float> >  *m_constituentWeights;
-      std::vector< std::vector<float> >  *m_constituent_pt;
-      std::vector< std::vector<float> >  *m_constituent_eta;
-      std::vector< std::vector<float> >  *m_constituent_phi;
-      std::vector< std::vector<float> >  *m_constituent_e;
+      xAH::JaggedBranch<float> *m_constituentWeights;
+      xAH::JaggedBranch<float> *m_constituent_pt;
+      xAH::JaggedBranch<float> *m_constituent_eta;
+      xAH::JaggedBranch<float> *m_constituent_phi;
+      xAH::JaggedBranch<float> *m_constituent_e;
 
       // truth
       std::vector<float> *m_truth_m;
@@ -117,7 +140,7 @@ namespace xAH {
 
       // Assocated Track Jets
       std::unordered_map<std::string, xAH::JetContainer*> m_trkJets;
-      std::unordered_map<std::string, std::vector<std::vector<unsigned int>>* > m_trkJetsIdx;
+      std::unordered_map<std::string, xAH::JaggedBranch<unsigned int>* > m_trkJetsIdx;
 
       // muonCorrection
       std::vector<float> *m_muonCorrected_pt;
@@ -0,0 +1,70 @@
+#ifndef xAODAnaHelpers_FeatureBlock_H
+#define xAODAnaHelpers_FeatureBlock_H
+
+#include <memory>
+
+namespace xAH
+{
+
+  /**
+      @rst
+          Optional group of members of a read-back particle class (:cpp:class:`xAH::Jet`, :cpp:class:`xAH::Muon`), allocated only once it is written to. The containers only fill a block when the detail string enables it, so particles read with a small detail string do not carry, construct and copy the members they never hold.
+
+          Writing through ``->`` or :cpp:func:`get` allocates the block. Reading a block that was never filled, through a ``const`` particle, gives a value-initialised (zero) block. Copying a particle copies its blocks.
+
+          .. code-block:: c++
+
+              for(const xAH::Jet& jet : jets->particles())
+                if(jet.flavorTag) std::cout << jet.flavorTag->DL1r << std::endl;
+
+      @endrst
+   */
+  template <typename T>
+  class FeatureBlock
+  {
+  public:
+    FeatureBlock() = default;
+    FeatureBlock(FeatureBlock&&) = default;
+    FeatureBlock& operator=(FeatureBlock&&) = default;
+
+    FeatureBlock(const FeatureBlock& other) :
+      m_block(other.m_block ? new T(*other.m_block) : nullptr)
+    {}
+
+    FeatureBlock& operator=(const FeatureBlock& other)
+    {
+      if(!other.m_block)  m_block.reset();
+      else if(m_block)    *m_block = *other.m_block; // keeps the capacity of the vectors of the block
+      else                m_block.reset(new T(*other.m_block));
+      return *this;
+    }
+
+    /// @brief Whether the block was filled
+    explicit operator bool() const { return static_cast<bool>(m_block); }
+
+    /// @brief The block, allocated if it was not yet
+    T& get()
+    {
+      if(!m_block) m_block.reset(new T());
+      return *m_block;
+    }
+
+    /// @brief The block, or an empty one if it was never filled
+    const T& get() const
+    {
+      static const T empty{};
+      return m_block ? *m_block : empty;
+    }
+
+    T*       operator->()       { return &get(); }
+    const T* operator->() const { return &get(); }
+
+    /// @brief Drop the block
+    void reset() { m_block.reset(); }
+
+  private:
+    std::unique_ptr<T> m_block;
+  };
+
+}//xAH
+#endif // xAODAnaHelpers_FeatureBlock_H
@@ -0,0 +1,41 @@
+#ifndef xAODAnaHelpers_FilePrefetcher_H
+#define xAODAnaHelpers_FilePrefetcher_H
+
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace xAH {
+
+  /**
+      @rst
+          Opens the next input file of a job in a background thread while the current one is processed, so that the latency of opening a remote (e.g. XRootD) file — redirection, authentication, reading the file header — is paid before EventLoop itself opens it.
+
+          The file is closed again right away, what is gained is what the client and the storage keep from the first open (connections, redirections, server-side caches). Only one file is opened at a time.
+
+      @endrst
+   */
+  class FilePrefetcher {
+    public:
+      FilePrefetcher() = default;
+      ~FilePrefetcher();
+
+      FilePrefetcher(const FilePrefetcher&) = delete;
+      FilePrefetcher& operator=(const FilePrefetcher&) = delete;
+
+      /// @brief The input files, in the order they are processed, from a comma separated list of URLs
+      void setFiles(const std::string& files);
+
+      /// @brief Start opening the file after ``fileName`` (with or without its path, as given by ``EL::IWorker::inputFileName``), if any
+      void prefetchAfter(const std::string& fileName);
+
+      /// @brief Wait until the file being opened, if any, is done
+      void wait();
+
+    private:
+      std::vector<std::string> m_files;
+      std::thread m_thread;
+  };
+
+}
+#endif
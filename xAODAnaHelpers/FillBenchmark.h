@@ -0,0 +1,52 @@
+#ifndef xAODAnaHelpers_FillBenchmark_H
+#define xAODAnaHelpers_FillBenchmark_H
+
+#include <string>
+
+namespace xAH {
+
+  /**
+      @rst
+          Micro-benchmarks of the ``Fill*()`` and ``clear()`` functions of the tree containers (:cpp:class:`xAH::JetContainer`, :cpp:class:`xAH::MuonContainer`, :cpp:class:`xAH::ElectronContainer`), on synthetic xAOD containers, without an input file or an algorithm chain. Run them for a set of detail strings with ``xAH_fillBenchmark.py``.
+
+          The objects get random kinematics. The aux variables read by the fill functions are added to the synthetic container once the first fill misses them, with random values for the floating point ones, a single random entry for the vectors (one vertex) and default values otherwise. Element links stay invalid, so the blocks following them (tracks, truth, clusters) take their empty path.
+
+          The allocations per object are only counted if ``libxAODAnaHelpersAllocationCounting.so`` is preloaded, see :cpp:class:`xAH::AllocationProfiler`.
+
+      @endrst
+   */
+  namespace FillBenchmark {
+
+    /// @brief The results of one benchmark
+    struct Result {
+      std::string container;
+      std::string detailStr;
+      unsigned int objects = 0;
+      unsigned int events = 0;
+      /// @brief Time of ``Fill*()`` per object, and of ``clear()`` per event, in nanoseconds
+      double fillNsPerObject = 0.;
+      double clearNsPerEvent = 0.;
+      /// @brief Allocations of ``Fill*()`` and ``clear()`` per object, ``-1`` if they could not be counted
+      double allocationsPerObject = -1.;
+      double bytesPerObject = -1.;
+      /// @brief Why the benchmark could not run, empty if it did
+      std::string error;
+    };
+
+    /**
+        @brief Time :cpp:func:`xAH::JetContainer::FillJet` and :cpp:func:`xAH::JetContainer::clear`
+        @param detailStr  The detail string of the container
+        @param objects    Number of jets per event
+        @param events     Number of events, each filling all the jets then clearing
+        @param mc         Whether the container is for simulation
+     */
+    Result jets(const std::string& detailStr, unsigned int objects = 10, unsigned int events = 10000, bool mc = true);
+    /// @brief Same as :cpp:func:`xAH::FillBenchmark::jets` for :cpp:func:`xAH::MuonContainer::FillMuon`
+    Result muons(const std::string& detailStr, unsigned int objects = 4, unsigned int events = 10000, bool mc = true);
+    /// @brief Same as :cpp:func:`xAH::FillBenchmark::jets` for :cpp:func:`xAH::ElectronContainer::FillElectron`
+    Result electrons(const std::string& detailStr, unsigned int objects = 4, unsigned int events = 10000, bool mc = true);
+
+  }
+
+}
+#endif
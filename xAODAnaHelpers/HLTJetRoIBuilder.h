@@ -17,6 +17,12 @@
 #include "xAODAnaHelpers/OnlineBeamSpotTool.h"
 #include "TrigDecisionTool/TrigDecisionTool.h"
 
+// EDM include(s):
+#include "xAODJet/JetContainer.h"
+#include "xAODJet/JetAuxContainer.h"
+
+#include <memory>
+
 class HLTJetRoIBuilder : public xAH::Algorithm
 {
 
@@ -66,9 +72,16 @@ class HLTJetRoIBuilder : public xAH::Algorithm
     std::string                  m_vtxName = "EFHistoPrmVtx";       //!
     xAH::OnlineBeamSpotTool      m_onlineBSTool;  //!
 
+    /// @brief Owns the output jets, reused from event to event, the recorded output is a view of the first ones
+    std::unique_ptr<xAOD::JetContainer>    m_hltJetPool;     //!
+    std::unique_ptr<xAOD::JetAuxContainer> m_hltJetPoolAux;  //!
+
     EL::StatusCode buildHLTBJets ();
     EL::StatusCode buildHLTJets  ();
 
+    /// @brief The next unused jet of the pool (growing it if needed) set to a copy of ``source``
+    xAOD::Jet* nextPooledJet (std::size_t& nUsed, const xAOD::Jet* source);
+
   public:
 
     // this is a standard constructor
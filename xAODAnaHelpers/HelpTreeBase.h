@@ -52,6 +52,7 @@
 // root includes
 #include "TTree.h"
 #include "TFile.h"
+#include "TList.h"
 
 namespace TrigConf {
   class xAODConfigTool;
@@ -173,6 +174,24 @@ public:
   void FillTau ( const xAOD::TauJet* tau,           const std::string& tauName = "tau" );
   void FillMET( const xAOD::MissingETContainer* met, const std::string& metName = "met" );
 
+  /**
+   *  @brief  Copy an already filled collection from another tree instead of filling it again
+   *  @note   Meant for the systematic trees of :cpp:class:`TreeAlgo`: a collection the systematic
+   *          does not vary holds the same objects as in the nominal tree, so its branch buffers
+   *          are copied from ``nominal`` (filled earlier in the same event) rather than read from
+   *          the aux data again. The ``Fill*User()`` methods are not called, so the branches of a
+   *          derived class are not copied. Returns false, having copied nothing, if ``nominal``
+   *          does not have the collection with the same branches; fill it as usual then.
+   *  @param  nominal     The tree whose collection is copied.
+   *  @param  muonName    The name of the output collection, in both trees.
+   */
+  bool CopyMuons    ( const HelpTreeBase& nominal, const std::string& muonName = "muon" );
+  bool CopyElectrons( const HelpTreeBase& nominal, const std::string& elecName = "el" );
+  bool CopyPhotons  ( const HelpTreeBase& nominal, const std::string& photonName = "ph" );
+  bool CopyJets     ( const HelpTreeBase& nominal, const std::string& jetName = "jet" );
+  bool CopyFatJets  ( const HelpTreeBase& nominal, const std::string& fatjetName = "fatjet", const std::string& suffix = "" );
+  bool CopyTaus     ( const HelpTreeBase& nominal, const std::string& tauName = "tau" );
+
   void Fill();
   void ClearEvent();
   void ClearTrigger();
@@ -308,6 +327,26 @@ public:
   virtual void FillTriggerUser( const xAOD::EventInfo*  )      { return; };
   virtual void FillJetTriggerUser()                            { return; };
 
+  /**
+   *  @brief  Called once per call to `FillMuons()` (and the other collections), after all the
+   *          objects were written. Override these instead of the per-object `Fill*User()`
+   *          methods to fill additional branches for the whole collection at once, e.g. with
+   *          accessors resolved once per event or with column reads of the aux data.
+   *  @param  muons       the container that was written.
+   *  @param  begin, end  the entries of the output vectors of the collection that were just
+   *                      written: entry `begin + i` holds `muons->at(i)`.
+   *  @param  muonName    the (prefix) name of the output collection
+   *  @note   The per-object methods are still called as well, unless `m_objectUserHooks` is
+   *          set to false (e.g. in the constructor of the derived class).
+   */
+  virtual void FillMuonsUserBatch    ( const xAOD::MuonContainer* /*muons*/,            std::size_t /*begin*/, std::size_t /*end*/, const std::string& /*muonName = "muon"*/, const xAOD::Vertex* /*primaryVertex*/ ) { return; };
+  virtual void FillElectronsUserBatch( const xAOD::ElectronContainer* /*electrons*/,    std::size_t /*begin*/, std::size_t /*end*/, const std::string& /*elecName = "el"*/, const xAOD::Vertex* /*primaryVertex*/ )   { return; };
+  virtual void FillPhotonsUserBatch  ( const xAOD::PhotonContainer* /*photons*/,        std::size_t /*begin*/, std::size_t /*end*/, const std::string& /*photonName = "ph"*/ )   { return; };
+  virtual void FillClustersUserBatch ( const xAOD::CaloClusterContainer* /*clusters*/,  std::size_t /*begin*/, std::size_t /*end*/, const std::string& /*clusterName = "cl"*/ )  { return; };
+  virtual void FillJetsUserBatch     ( const xAOD::JetContainer* /*jets*/,              std::size_t /*begin*/, std::size_t /*end*/, const std::string& /*jetName = "jet"*/ )     { return; };
+  virtual void FillFatJetsUserBatch  ( const xAOD::JetContainer* /*fatJets*/,           std::size_t /*begin*/, std::size_t /*end*/, int /*pvLocation = 0*/, const std::string& /*fatjetName = "fatjet"*/, const std::string& /*suffix = ""*/ ) { return; };
+  virtual void FillTausUserBatch     ( const xAOD::TauJetContainer* /*taus*/,           std::size_t /*begin*/, std::size_t /*end*/, const std::string& /*tauName = "tau"*/ )     { return; };
+
  protected:
 
   template<typename T, typename U, typename V>
@@ -321,6 +360,9 @@ public:
 
 protected:
 
+  /// @brief Whether the per-object `Fill*User()` methods are called, see `FillMuonsUserBatch()`
+  bool m_objectUserHooks;
+
   TTree* m_tree;
 
   int m_units; //For MeV to GeV conversion in output
@@ -330,6 +372,15 @@ protected:
   std::string m_nominalTreeName;
   bool m_nominalTree;
 
+  // the copy from the collection of the same name in another tree, for the Copy*() methods
+  template<typename T> static bool copyCollection( std::map<std::string, T*>& collections, const std::map<std::string, T*>& from, const std::string& name )
+  {
+    const auto to   = collections.find(name);
+    const auto orig = from.find(name);
+    if ( to == collections.end() || orig == from.end() ) return false;
+    return to->second->copyFrom( *orig->second );
+  }
+
   // event
   xAH::EventInfo*      m_eventInfo;
 
@@ -350,6 +401,35 @@ protected:
   std::vector<float> m_triggerPrescalesLumi;
   std::vector<std::string>  m_isPassBitsNames;
   std::vector<unsigned int> m_isPassBits;
+  std::vector<ULong64_t>    m_passedTriggersMask;
+  std::vector<ULong64_t>    m_disabledTriggersMask;
+  /// @brief index of each chain in the trigger masks, the names are also kept in the triggerDictionary entry of the tree user info
+  std::map<std::string, unsigned int> m_triggerIndex;
+  TList* m_triggerDictionary;
+
+  /// @brief Set the bits of ``chains`` in ``mask``, extending the trigger dictionary with new chains
+  void fillTriggerMask(const std::vector<std::string>& chains, std::vector<ULong64_t>& mask);
+  /// @brief The accessors of a chain list decorated as ``name``, and of its packed form ``name + "Bits"``, built once
+  struct TriggerNamesAccessors {
+    TriggerNamesAccessors(const std::string& name) : names(name), bits(name + "Bits") {}
+    SG::AuxElement::ConstAccessor< std::vector< std::string > > names;
+    SG::AuxElement::ConstAccessor< std::vector< unsigned long long > > bits;
+  };
+  /// @brief The accessors of the prescales of the passed chains decorated as ``name``, and of those of all the chains ``name + "All"``, built once
+  struct TriggerPrescalesAccessors {
+    TriggerPrescalesAccessors(const std::string& name) : prescales(name), all(name + "All") {}
+    SG::AuxElement::ConstAccessor< std::vector< float > > prescales;
+    SG::AuxElement::ConstAccessor< std::vector< float > > all;
+  };
+  const TriggerNamesAccessors     m_passedTriggersAcc{"passedTriggers"};
+  const TriggerNamesAccessors     m_disabledTriggersAcc{"disabledTriggers"};
+  const TriggerPrescalesAccessors m_triggerPrescalesAcc{"triggerPrescales"};
+  const TriggerPrescalesAccessors m_triggerPrescalesLumiAcc{"triggerPrescalesLumi"};
+
+  /// @brief Read the chain list, or unpack it from the packed decorations of :cpp:class:`BasicEventSelection`. False if neither is there.
+  bool readTriggerNames(const xAOD::EventInfo* eventInfo, const TriggerNamesAccessors& acc, std::vector<std::string>& chains);
+  /// @brief Read the prescales of the passed chains, or select them from the dense packed decoration
+  bool readTriggerPrescales(const xAOD::EventInfo* eventInfo, const TriggerPrescalesAccessors& acc, std::vector<float>& prescales);
 
   //
   //  Jets
@@ -83,6 +83,14 @@ namespace HelperClasses {
         @brief The vector of tokens from which we search through for finding matches.
      */
     std::set<std::string> m_configDetails;
+    /**
+        @brief The tokens of :cpp:member:`~HelperClasses::InfoSwitch::m_configDetails` that were matched by any of the queries below while parsing.
+     */
+    std::set<std::string> m_usedDetails;
+    /**
+        @brief Mark a token as understood, for parsing code that looks at the tokens directly.
+     */
+    void markUsed(const std::string& token) { m_usedDetails.insert(token); };
   public:
     /**
         @brief Constructor. Take in input string, create vector of tokens.
@@ -94,6 +102,7 @@ namespace HelperClasses {
         std::istringstream ss(m_configStr);
         while ( std::getline(ss, token, ' ') )
             m_configDetails.insert(token);
+        parseFloatPrecision();
     };
     /**
         @rst
@@ -102,7 +111,11 @@ namespace HelperClasses {
         @endrst
         @param flag     The string we search for.
      */
-    bool has_exact(const std::string flag) { return m_configDetails.find(flag) != m_configDetails.end(); };
+    bool has_exact(const std::string flag) {
+      if(m_configDetails.find(flag) == m_configDetails.end()) return false;
+      m_usedDetails.insert(flag);
+      return true;
+    };
     /**
         @rst
             Search for a partial match in :cpp:member:`~HelperClasses::InfoSwitch::m_configStr`.
@@ -110,7 +123,7 @@ namespace HelperClasses {
         @endrst
         @param flag     The string we search for.
      */
-    bool has_match(const std::string flag) { return m_configStr.find(flag) != std::string::npos; };
+    bool has_match(const std::string flag);
     /**
         @rst
             Search for a single flag in :cpp:member:`~HelperClasses::InfoSwitch::m_configDetails` and parse out the working point.
@@ -126,6 +139,27 @@ namespace HelperClasses {
         @param flag     The string we search for.
      */
     std::vector<std::string> get_working_points(const std::string flag);
+    /**
+        @rst
+            The tokens of the configuration string that none of the queries above matched, i.e. typos or options this switch does not know about. Only meaningful on the most-derived switch, once it is constructed, as base-class switches do not know the tokens of the derived ones.
+
+        @endrst
+     */
+    std::vector<std::string> unknownDetails() const;
+    /**
+        @rst
+            The number of mantissa bits the float branch ``varName`` is stored with, as requested by a ``Float16:var1,var2,...`` token (12 bits, like ROOT's ``Float16_t``) or a ``Float16_N:var1,var2,...`` token (``N`` bits). A variable ending with ``*`` matches all the branches starting with it, e.g. ``Float16_10:RecoEff_SF*``. This applies to the flat and nested per-object vectors (e.g. the ``flatArrays`` jet branches) as well. Returns 0 (full precision) for the variables not listed.
+
+        @endrst
+        @param varName  The name of the branch, without the container prefix and suffix.
+     */
+    unsigned int floatPrecision(const std::string& varName) const;
+  private:
+    /**
+        @brief The (variable, mantissa bits) pairs of the ``Float16`` tokens, see :cpp:func:`~HelperClasses::InfoSwitch::floatPrecision`.
+     */
+    std::vector<std::pair<std::string, unsigned int> > m_floatPrecision;
+    void parseFloatPrecision();
   };
 
   /**
@@ -146,8 +180,12 @@ namespace HelperClasses {
         m_truth          truth          exact
         m_caloClus       caloClusters   exact
         m_weightsSys     weightsSys     exact
+        m_weightsArray   weightsArray   exact
         ================ ============== =======
 
+        .. note::
+            ``weightsArray`` writes the weights of the event (the pileup weights with ``pileup``/``pileupsys``, then the generator weights, all of them with ``weightsSys`` and only the nominal one otherwise) as a single ``weightsArray[nWeightsArray]`` float array branch instead of the ``mcEventWeights`` vector branch. The name of each entry is stored once with the tree, in the ``weightsArrayDictionary`` list of its user info.
+
     @endrst
    */
   class EventInfoSwitch : public InfoSwitch {
@@ -163,6 +201,7 @@ namespace HelperClasses {
     bool m_truth;
     bool m_caloClus;
     bool m_weightsSys;
+    bool m_weightsArray;
     EventInfoSwitch(const std::string configStr) : InfoSwitch(configStr) { initialize(); };
   protected:
     void initialize();
@@ -172,20 +211,23 @@ namespace HelperClasses {
     @rst
         The :cpp:class:`HelperClasses::InfoSwitch` struct for Trigger Information.
 
-        ================ ============== =======
-        Parameter        Pattern        Match
-        ================ ============== =======
-        m_basic          basic          exact
-        m_menuKeys       menuKeys       exact
-        m_passTriggers   passTriggers   exact
-        m_passTrigBits   passTrigBits   exact
-        m_prescales      prescales      exact
-        m_prescalesLumi  prescalesLumi  exact
-        ================ ============== =======
+        ================== ================ =======
+        Parameter          Pattern          Match
+        ================== ================ =======
+        m_basic            basic            exact
+        m_menuKeys         menuKeys         exact
+        m_passTriggers     passTriggers     exact
+        m_passTriggersMask passTriggersMask exact
+        m_passTrigBits     passTrigBits     exact
+        m_prescales        prescales        exact
+        m_prescalesLumi    prescalesLumi    exact
+        ================== ================ =======
 
         .. note::
             ``m_prescales`` contains information from the ``TrigDecisionTool`` for every trigger used in event selection and event trigger-matching. ``m_prescalesLumi`` contains information retrieved from the pile-up reweighting tool based on the actual luminosities of triggers.
 
+            ``m_passTriggersMask`` stores the passed and disabled triggers as bit masks (``passedTriggersMask`` and ``disabledTriggersMask``, 64 chains per word) instead of vectors of strings. Bit ``i`` refers to the ``i``-th chain of the ``triggerDictionary`` list (of ``TObjString``) in the user info of the tree, ``tree->GetUserInfo()->FindObject("triggerDictionary")``.
+
     @endrst
    */
   class TriggerInfoSwitch : public InfoSwitch {
@@ -193,6 +235,7 @@ namespace HelperClasses {
     bool m_basic;
     bool m_menuKeys;
     bool m_passTriggers;
+    bool m_passTriggersMask;
     bool m_passTrigBits;
     bool m_prescales;
     bool m_prescalesLumi;
@@ -212,6 +255,7 @@ namespace HelperClasses {
         m_kinematic      kinematic      exact
         m_numLeading     NLeading       partial
         m_useTheS        useTheS        exact
+        m_selectionFlags selectionFlags exact
         ================ ============== =======
 
         .. note::
@@ -223,6 +267,8 @@ namespace HelperClasses {
 
             will define ``int m_numLeading = 4``.
 
+            ``m_selectionFlags`` writes the ``selectionFlags`` word of :cpp:any:`xAH::SelectionFlags` of each object. The flag of each bit is stored once in the ``selectionFlags`` user info of the tree.
+
 
     @endrst
    */
@@ -232,6 +278,7 @@ namespace HelperClasses {
     bool m_kinematic;
     int  m_numLeading;
     bool m_useTheS;
+    bool m_selectionFlags;
     IParticleInfoSwitch(const std::string configStr) : InfoSwitch(configStr) { initialize(); }
     virtual ~IParticleInfoSwitch() {}
   protected:
@@ -246,6 +293,7 @@ namespace HelperClasses {
         Parameter              Pattern              Match
         ====================== ==================== =======
         m_trigger              trigger              exact
+        m_triggerBits          triggerBits          exact
         m_isolation            isolation            exact
         m_isolationKinematics  isolationKinematics  exact
         m_quality              quality              exact
@@ -277,11 +325,16 @@ namespace HelperClasses {
 
              will define the ``Loose`` isolation working point status branch, and scale factors without isolation requirements and using the ``Loose`` WP.
 
+        .. note::
+
+             With ``triggerBits`` (together with ``trigger``), the per-object ``isTrigMatchedToChain`` and ``listTrigChains`` vectors are replaced by the ``trigMatchTestedBits`` and ``isTrigMatchedBits`` words of :cpp:any:`xAH::TrigMatchBits`. The chain of each bit is stored once in the ``trigMatchChains`` user info of the tree, and reading the tree back through this class fills the per-chain vectors from it.
+
     @endrst
    */
   class MuonInfoSwitch : public IParticleInfoSwitch {
   public:
     bool m_trigger;
+    bool m_triggerBits;
     bool m_isolation;
     bool m_isolationKinematics;
     bool m_quality;
@@ -318,6 +371,7 @@ namespace HelperClasses {
         Parameter             Pattern             Match
         ===================== =================== =======
         m_trigger             trigger             exact
+        m_triggerBits         triggerBits         exact
         m_isolation           isolation           exact
         m_isolationKinematics isolationKinematics exact
         m_PID                 PID                 exact
@@ -348,11 +402,16 @@ namespace HelperClasses {
 
             will define the ``Loose`` isolation working point status branch, and scale factors without isolation requirements and using the ``Loose`` WP.
 
+        .. note::
+
+            ``triggerBits`` stores the trigger matching as bit words, as for :cpp:class:`HelperClasses::MuonInfoSwitch`.
+
     @endrst
    */
   class ElectronInfoSwitch : public IParticleInfoSwitch {
   public:
     bool m_trigger;
+    bool m_triggerBits;
     bool m_isolation;
     bool m_isolationKinematics;
     bool m_quality;
@@ -413,8 +472,30 @@ namespace HelperClasses {
     virtual void initialize();
   };
 
+  /**
+    @rst
+        The :cpp:class:`HelperClasses::IParticleInfoSwitch` class for Cluster Information.
+
+        ================ ============== =======
+        Parameter        Pattern        Match
+        ================ ============== =======
+        m_ptMin          ptMin          partial
+        ================ ============== =======
+
+        .. note::
+            ``m_ptMin`` requires a number ``XX`` to follow it, the :math:`p_T` threshold in GeV of the clusters written or plotted. With ``NLeadingYY``, only the ``YY`` leading clusters above the threshold are kept.
+
+            For example::
+
+                m_configStr = "... ptMin0.5 NLeading100 ..."
+
+            will define ``float m_ptMin = 0.5`` and ``int m_numLeading = 100``.
+
+    @endrst
+   */
   class ClusterInfoSwitch : public IParticleInfoSwitch {
   public:
+    float m_ptMin;
     ClusterInfoSwitch(const std::string configStr) : IParticleInfoSwitch(configStr) { initialize(); }
     virtual ~ClusterInfoSwitch() {}
   protected:
@@ -482,6 +563,7 @@ namespace HelperClasses {
         m_byEta          byEta          exact
         m_etaPhiMap      etaPhiMap      exact
         m_muonCorrection muonCorrection exact
+        m_flatArrays     flatArrays     exact
         ================ ============== =======
 
         .. note::
@@ -498,6 +580,14 @@ namespace HelperClasses {
 
 	    ``trackJetName`` expects one or more track jet container names separated by an underscore. For example, the string ``trackJetName_GhostAntiKt2TrackJet_GhostVR30Rmax4Rmin02TrackJet`` will set the attriubte ``m_trackJetNames``
 	    to ``{"GhostAntiKt2TrackJet", "GhostVR30Rmax4Rmin02TrackJet"}``.
+
+            ``constituentBits`` reduces the precision of the ``constituentAll`` branches, by keeping only the given number of mantissa bits (see :cpp:func:`HelperFunctions::reducePrecision`). ``constituentBits_N`` applies to all of them, ``constituentBits_<var>_N`` to one of ``weights``, ``pt``, ``eta``, ``phi`` and ``e``. For example::
+
+                m_configStr = "... constituentAll flatArrays constituentBits_10 constituentBits_phi_12 ..."
+
+            stores the constituents flat, with 10 bits of mantissa and 12 for :math:`\phi`.
+
+            ``flatArrays`` writes the per-jet vectors (the ``IP2D_*OfTracks``/``IP3D_*OfTracks`` track information, ``isTrigMatchedToChain``, the fat jet ``trkJetsIdx_*`` track jet indices and the ``constituentAll`` constituents) as flat arrays plus a ``_n`` branch with the number of entries per jet, instead of ``std::vector<std::vector<T> >``. See :cpp:class:`xAH::JaggedBranch`.
     @endrst
    */
   class JetInfoSwitch : public IParticleInfoSwitch {
@@ -529,6 +619,11 @@ namespace HelperClasses {
     bool m_allTrackPVSel;
     bool m_constituent;
     bool m_constituentAll;
+    unsigned int m_constitWeightsBits;
+    unsigned int m_constitPtBits;
+    unsigned int m_constitEtaBits;
+    unsigned int m_constitPhiBits;
+    unsigned int m_constitEBits;
     bool m_flavorTag;
     bool m_flavorTagHLT;
     bool m_btag_jettrk;
@@ -551,6 +646,7 @@ namespace HelperClasses {
     bool m_area;
     bool m_JVC;
     bool m_muonCorrection;
+    bool m_flatArrays;
     std::string              m_trackName;
     std::vector<std::string> m_trackJetNames;
     std::string              m_sfJVTName;
@@ -579,8 +675,11 @@ namespace HelperClasses {
         m_dressed        dressed        exact
         m_origin         origin         exact
         m_particleType   particleType   exact
+        m_links          links          exact
         ================ ============== =======
 
+        .. note::
+            ``links`` stores the parents and children of each particle as indices into the same truth block of the event (``-1`` for those that are not written out), in the flat ``parent_index``/``child_index`` branches. They are resolved once the block is complete, just before the tree is filled.
 
     @endrst
    */
@@ -593,6 +692,7 @@ namespace HelperClasses {
     bool m_dressed;
     bool m_origin;
     bool m_particleType;
+    bool m_links;
     TruthInfoSwitch(const std::string configStr) : IParticleInfoSwitch(configStr) { initialize(); };
   protected:
     void initialize();
@@ -611,8 +711,12 @@ namespace HelperClasses {
         m_numbers        numbers        exact
         m_vertex         vertex         exact
         m_useTheS        useTheS        exact
+        m_packedHits     packedHits     exact
+        m_sortZ0         sortZ0         exact
         ================ ============== =======
 
+        .. note::
+            With ``packedHits``, the hit counts of ``numbers`` are written as a single ``hitsPacked`` 64 bit word per track instead of one branch per count, each count saturating at the largest value of its 3 to 7 bits. ``sortZ0`` writes the tracks of :cpp:func:`HelpTreeBase::FillTracks` in increasing ``z0``, which keeps neighbouring values close and compresses better. The covariance elements can be written with reduced precision with e.g. ``Float16_10:definingParametersCovMatrix``, see :cpp:func:`~HelperClasses::InfoSwitch::floatPrecision`.
 
     @endrst
   */
@@ -624,6 +728,8 @@ namespace HelperClasses {
     bool m_numbers;
     bool m_vertex;
     bool m_useTheS;
+    bool m_packedHits;
+    bool m_sortZ0;
   TrackInfoSwitch(const std::string configStr) : InfoSwitch(configStr) { initialize(); };
   protected:
     void initialize();
@@ -4,6 +4,12 @@
 // for typing in template
 #include <typeinfo>
 #include <cxxabi.h>
+#include <limits>
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <cstring>
+#include <memory>
 // Gaudi/Athena include(s):
 #include "AthContainers/normalizedTypeinfoName.h"
 
@@ -19,7 +25,11 @@
 
 #include "xAODTracking/VertexContainer.h"
 #include "AthContainers/ConstDataVector.h"
+#include "AthContainers/AuxTypeRegistry.h"
+#include "AthContainers/AuxVectorData.h"
 #include "xAODAnaHelpers/HelperClasses.h"
+#include "xAODAnaHelpers/ParticleKinematics.h"
+#include "xAODAnaHelpers/SelectionFlags.h"
 
 // CP interface includes
 #include "PATInterfaces/SystematicRegistry.h"
@@ -54,16 +64,25 @@ namespace xAH {
 
 namespace HelperFunctions {
   /**
-    Static object that provides athena-based message logging functionality
+    Static object that provides athena-based message logging functionality.
+    Each thread gets its own stream, so this can be used from worker threads as well.
   */
   MsgStream& msg( MSG::Level lvl = MSG::INFO );
 
+  /**
+    Return true if a message of level ``lvl`` sent to :cpp:func:`HelperFunctions::msg` would be printed, without touching the stream's current level.
+    Use it to skip building expensive messages.
+  */
+  bool msgLvl( MSG::Level lvl );
+
   // primary vertex
   bool passPrimaryVertexSelection(const xAOD::VertexContainer* vertexContainer, int Ntracks = 2);
   int countPrimaryVertices(const xAOD::VertexContainer* vertexContainer, int Ntracks = 2);
   const xAOD::Vertex* getPrimaryVertex(const xAOD::VertexContainer* vertexContainer, MsgStream& msg);
   inline const xAOD::Vertex* getPrimaryVertex(const xAOD::VertexContainer* vertexContainer) { return getPrimaryVertex(vertexContainer, msg()); }
   float getPrimaryVertexZ(const xAOD::Vertex* pvx);
+  /// @brief Name of the decoration of the first vertex caching the result of :cpp:func:`HelperFunctions::getPrimaryVertexLocation` for the event, which :cpp:class:`MinixAOD` does not write out
+  const std::string primaryVertexLocationDecor = "xAH_primaryVertexLocation";
   int getPrimaryVertexLocation(const xAOD::VertexContainer* vertexContainer, MsgStream& msg);
   inline int getPrimaryVertexLocation(const xAOD::VertexContainer* vertexContainer){ return getPrimaryVertexLocation(vertexContainer, msg()); }
   bool applyPrimaryVertexSelection( const xAOD::JetContainer* jets, const xAOD::VertexContainer* vertices );
@@ -74,6 +93,102 @@ namespace HelperFunctions {
   float dPhi(float phi1, float phi2);
   bool has_exact(const std::string input, const std::string flag);
 
+  /**
+    @rst
+      :math:`\Delta R^2` kernels on flat arrays of :math:`\eta` and :math:`\phi`, e.g. the arrays of :cpp:class:`xAH::ParticleKinematics`. Angles are expected in :math:`[-\pi, \pi]`.
+
+      The loops are branch-free, so compilers vectorise them. Use these for all :math:`\Delta R` matching: they are faster than ``p4().DeltaR(...)`` and agree with it (:math:`\Delta R` in pseudorapidity) up to the float rounding of the inputs, a few :math:`10^{-7}`, also for pairs on both sides of :math:`\phi = \pm\pi`.
+
+    @endrst
+  */
+  /// @brief :math:`\Delta R^2` between (``eta0``, ``phi0``) and each of the ``n`` particles, written to ``dR2[0..n)``
+  void deltaR2(float eta0, float phi0, const float* eta, const float* phi, std::size_t n, float* dR2);
+  /// @brief :math:`\Delta R^2` between each pair of the two sets, written row-major to ``dR2[0..n1*n2)``: ``dR2[i*n2+j]`` is the distance of ``i`` in the first set to ``j`` in the second
+  void deltaR2Matrix(const float* eta1, const float* phi1, std::size_t n1, const float* eta2, const float* phi2, std::size_t n2, float* dR2);
+  /// @brief Index of the particle closest to (``eta0``, ``phi0``) in :math:`\Delta R`, the first one on ties, and its :math:`\Delta R^2` in ``minDR2``. Returns -1 if no particle is closer than ``sqrt(maxDR2)``.
+  int nearestDeltaR2(float eta0, float phi0, const float* eta, const float* phi, std::size_t n, float& minDR2, float maxDR2 = std::numeric_limits<float>::max());
+
+  inline void deltaR2(float eta0, float phi0, const xAH::ParticleKinematics& particles, std::vector<float>& dR2) {
+    dR2.resize(particles.size());
+    deltaR2(eta0, phi0, particles.eta.data(), particles.phi.data(), particles.size(), dR2.data());
+  }
+  inline void deltaR2Matrix(const xAH::ParticleKinematics& particles1, const xAH::ParticleKinematics& particles2, std::vector<float>& dR2) {
+    dR2.resize(particles1.size()*particles2.size());
+    deltaR2Matrix(particles1.eta.data(), particles1.phi.data(), particles1.size(), particles2.eta.data(), particles2.phi.data(), particles2.size(), dR2.data());
+  }
+  inline int nearestDeltaR2(float eta0, float phi0, const xAH::ParticleKinematics& particles, float& minDR2, float maxDR2 = std::numeric_limits<float>::max()) {
+    return nearestDeltaR2(eta0, phi0, particles.eta.data(), particles.phi.data(), particles.size(), minDR2, maxDR2);
+  }
+
+  /**
+    @rst
+      One-to-one matching of two sets of particles from their :math:`\Delta R^2` matrix, as filled by :cpp:func:`HelperFunctions::deltaR2Matrix`. Only pairs closer than ``sqrt(maxDR2)`` are matched. ``match2`` is resized to ``n2`` and ``match2[j]`` is set to the index in the first set matched to ``j``, or -1.
+
+      - ``matchNearestDeltaR2``: each particle of the first set picks its nearest one in the second set, and each particle of the second set keeps the closest of the particles that picked it (the first one on ties). Particles whose nearest partner went to another one stay unmatched.
+      - ``matchGreedyDeltaR2``: the pairs are taken in increasing :math:`\Delta R`, skipping those with a particle already matched, so a particle can still match its second nearest partner.
+
+      The matrix is computed once and no :math:`\Delta R` is recomputed to resolve conflicts, so these can be used for any truth, trigger or reco matching.
+
+    @endrst
+  */
+  void matchNearestDeltaR2(const float* dR2, std::size_t n1, std::size_t n2, float maxDR2, std::vector<int>& match2);
+  void matchGreedyDeltaR2(const float* dR2, std::size_t n1, std::size_t n2, float maxDR2, std::vector<int>& match2);
+
+  /**
+    @rst
+      Checks if ``particles`` is sorted by decreasing :math:`p_T` and returns the index of the first particle below ``ptMin``. All the particles from there on are below ``ptMin`` too, so a selector requiring ``ptMin`` can reject them without evaluating its other cuts. If the particles are not sorted, or none is below ``ptMin``, the size of the container is returned.
+
+      The check reads the :math:`p_T` of every particle, which is much cheaper than a selection.
+
+    @endrst
+  */
+  template <typename CONTAINER>
+  std::size_t sortedPtEnd(const CONTAINER& particles, float ptMin) {
+    const std::size_t size = particles.size();
+    std::size_t end = size;
+    float previous = std::numeric_limits<float>::infinity();
+    for(std::size_t i = 0; i < size; ++i){
+      const float pt = particles[i]->pt();
+      if(pt > previous) return size;
+      if(pt < ptMin && end == size) end = i;
+      previous = pt;
+    }
+    return end;
+  }
+
+  /**
+    @rst
+      ``true`` if an event with ``nPass`` selected objects and ``nRemaining`` objects still to be evaluated fails the ``passMin``/``passMax`` requirement of a selector whatever the remaining objects are: ``passMax`` (if not negative) is already exceeded, or ``passMin`` (if positive) cannot be reached anymore.
+
+    @endrst
+  */
+  inline bool countRejects(int nPass, int nRemaining, int passMin, int passMax) {
+    return (passMax >= 0 && nPass > passMax) || (passMin > 0 && nPass + nRemaining < passMin);
+  }
+
+  /**
+    @rst
+      ``value`` rounded to ``mantissaBits`` bits of mantissa (out of the 23 of a float), with the remaining bits zeroed so that the output branch compresses much better. ``0`` (or 23 and more) keeps the full precision. The relative precision is :math:`2^{-(\mathrm{mantissaBits}+1)}`, e.g. about 0.05% for 10 bits.
+
+    @endrst
+  */
+  inline float reducePrecision(float value, unsigned int mantissaBits) {
+    if( mantissaBits == 0 || mantissaBits >= 23 || !std::isfinite(value) ) return value;
+    std::uint32_t bits;
+    std::memcpy(&bits, &value, sizeof(bits));
+    const std::uint32_t drop = 23 - mantissaBits;
+    const std::uint32_t mask = ~((std::uint32_t(1) << drop) - 1);
+    std::uint32_t rounded = (bits + (std::uint32_t(1) << (drop - 1))) & mask;
+    float result;
+    std::memcpy(&result, &rounded, sizeof(result));
+    // do not round the largest floats up to infinity
+    if( !std::isfinite(result) ) {
+      rounded = bits & mask;
+      std::memcpy(&result, &rounded, sizeof(result));
+    }
+    return result;
+  }
+
   /**
     Function which returns the position of the n-th occurence of a character in a string searching backwards.
     Returns -1 if no occurencies are found.
@@ -151,15 +266,126 @@ namespace HelperFunctions {
   // miscellaneous
   bool sort_pt(const xAOD::IParticle* partA, const xAOD::IParticle* partB);
 
+  /**
+    @rst
+      Sorts ``[begin, end)`` by decreasing :math:`p_T` like ``std::sort(begin, end, sort_pt)``, for containers which are usually sorted already, e.g. the output of a calibrator with ``m_sort`` or a selection of such a container.
+
+      A first pass checks the order and returns if it holds. When only a few neighbours are out of order, as after a systematic variation shifting the :math:`p_T` of a few objects, they are moved to their place by insertion. Otherwise the range is sorted with ``std::sort``.
+
+    @endrst
+  */
+  template <typename ITERATOR>
+  void sortPt(ITERATOR begin, ITERATOR end) {
+    if(begin == end) return;
+
+    // number of neighbours out of order
+    unsigned int nUnordered = 0;
+    const std::size_t size = end - begin;
+    for(ITERATOR it = begin + 1; it != end; ++it){
+      if(sort_pt(*it, *(it - 1))) ++nUnordered;
+    }
+    if(nUnordered == 0) return;
+
+    if(nUnordered > 8 && nUnordered*8 > size){
+      std::sort(begin, end, sort_pt);
+      return;
+    }
+
+    for(ITERATOR it = begin + 1; it != end; ++it){
+      if(!sort_pt(*it, *(it - 1))) continue;
+      const xAOD::IParticle* particle = *it;
+      ITERATOR position = std::upper_bound(begin, it, particle, sort_pt);
+      std::rotate(position, it, it + 1);
+    }
+  }
+
+  /**
+    @rst
+      Fills ``selected`` with a view of the particles above ``ptMin`` and, if ``nLeading`` is positive, only keeps the ``nLeading`` of highest :math:`p_T`, sorted by decreasing :math:`p_T`. The leading particles are found with ``std::nth_element``, so for a few leading particles out of thousands (e.g. topo-clusters) only those few are sorted.
+
+      Without ``nLeading`` the view keeps the order of ``particles``.
+
+    @endrst
+  */
+  template <typename CONTAINER>
+  void selectLeadingPt(const CONTAINER& particles, float ptMin, int nLeading, ConstDataVector<CONTAINER>& selected) {
+    selected.clear(SG::VIEW_ELEMENTS);
+    selected.reserve(particles.size());
+    for(const auto* particle : particles){
+      if(particle->pt() > ptMin) selected.push_back(particle);
+    }
+    if(nLeading <= 0) return;
+
+    if(selected.size() > static_cast<std::size_t>(nLeading)){
+      std::nth_element(selected.begin(), selected.begin() + (nLeading - 1), selected.end(), sort_pt);
+      selected.resize(nLeading);
+    }
+    std::sort(selected.begin(), selected.end(), sort_pt);
+  }
+
+  /// @brief The particles passing the ``ptMin`` (in GeV) and ``NLeading`` options of ``infoSwitch``: ``particles`` itself if neither is set, otherwise the view ``selected`` filled by the function above
+  template <typename CONTAINER, typename INFOSWITCH>
+  const CONTAINER* selectLeadingPt(const CONTAINER* particles, const INFOSWITCH& infoSwitch, ConstDataVector<CONTAINER>& selected) {
+    if(infoSwitch.m_ptMin <= 0 && infoSwitch.m_numLeading <= 0) return particles;
+    selectLeadingPt(*particles, infoSwitch.m_ptMin*1e3, infoSwitch.m_numLeading, selected);
+    return selected.asDataVector();
+  }
+
+  /// @brief TStore name of the list of the systematics in the ``systNamesName`` list which left every object of the event identical to nominal
+  inline std::string sameAsNominalName(const std::string& systNamesName){ return systNamesName + "_sameAsNominal"; }
+
+  /// @brief ``true`` if both containers hold the same number of particles with, in order, identical four-momenta
+  template< typename CONTAINER >
+  bool sameFourMomenta(const CONTAINER& a, const CONTAINER& b) {
+    if(a.size() != b.size()) return false;
+    for(std::size_t i = 0; i < a.size(); ++i){
+      if(a[i]->pt() != b[i]->pt() || a[i]->eta() != b[i]->eta() || a[i]->phi() != b[i]->phi() || a[i]->m() != b[i]->m()) return false;
+    }
+    return true;
+  }
+
+  /**
+    @brief Read every variable of the aux store of ``cont`` from the input file now
+    @rst
+      The variables of an input container are only read from the file the first time they are accessed. Call this before handing the container (or shallow copies of it) to :cpp:func:`xAH::Algorithm::forEachSystematic`, so that the tools run in parallel never trigger a read of the input file.
+
+    @endrst
+   */
+  void readAllAuxData(const SG::AuxVectorData& cont);
+
+  /**
+    @brief Add ``scale`` times the bins of ``from`` to ``to``
+    @rst
+      Histograms with labelled bins, like the cutflows, are matched bin by bin by label, and the labels ``to`` does not have yet are added to it if its axis can be extended. Other histograms must have the same binning.
+
+    @endrst
+   */
+  void addBinsByLabel(TH1* to, const TH1* from, double scale = 1.);
+
   /**
     @brief Get a list of systematics
     @param inSysts    systematics set retrieved from the tool
     @param systNames  comma separated list of wanted systematics names, use "Nominal" for nominal and "All" for all systematics
     @param systVal    continuous systematics sigma value
     @param msg        the MsgStream object with appropriate level for debugging
+
+    @rst
+      The list is computed once per job for each set of arguments, see :cpp:func:`HelperFunctions::getSharedListofSystematics`, and copied.
+
+    @endrst
   */
   std::vector< CP::SystematicSet > getListofSystematics( const CP::SystematicSet inSysts, std::string systNames, float systVal, MsgStream& msg );
 
+  /**
+    @brief Same as :cpp:func:`HelperFunctions::getListofSystematics`, without copying the list
+
+    @rst
+      The list is computed the first time a set of recommended systematics, names and value is asked for, and the same immutable list is returned for each later call with the same arguments, e.g. by the other instances of an algorithm running the same tool.
+
+    @endrst
+  */
+  std::shared_ptr< const std::vector< CP::SystematicSet > > getSharedListofSystematics( const CP::SystematicSet& inSysts, const std::string& systNames, float systVal, MsgStream& msg );
+
   void writeSystematicsListHist( const std::vector< CP::SystematicSet > &systs, std::string histName, TFile *file );
 
   /*    type_name<T>()      The awesome type demangler!
@@ -188,6 +414,13 @@ namespace HelperFunctions {
     return tname;
   }
 
+  /** @brief Same as ``type_name<T>()``, but demangled only once per type and cached for the job */
+  template <typename T>
+  const std::string& cached_type_name() {
+    static const std::string tname = type_name<T>();
+    return tname;
+  }
+
   /**
    * @author Marco Milesi (marco.milesi@cern.ch)
    * @brief Function to copy a subset of a generic input xAOD container into a generic output xAOD container.
@@ -202,7 +435,11 @@ namespace HelperFunctions {
    */
   template< typename T1, typename T2 >
   StatusCode makeSubsetCont( T1*& intCont, T2*& outCont, MsgStream& msg, const std::string& flagSelect = "", HelperClasses::ToolName tool_name = HelperClasses::ToolName::DEFAULT){
-     std::string funcName{"in makeSubsetCont<"+type_name<T1>()+","+type_name<T2>()+">(): "};
+     // only build the message prefix when something is actually printed
+     auto funcName = [&msg]() -> MsgStream& { msg << "in makeSubsetCont<" << cached_type_name<T1>() << "," << cached_type_name<T2>() << ">(): "; return msg; };
+
+     // a view of at most all the input objects, made once instead of growing it object by object
+     outCont->reserve( outCont->size() + intCont->size() );
 
      if ( tool_name == HelperClasses::ToolName::DEFAULT ) {
 
@@ -212,17 +449,26 @@ namespace HelperFunctions {
      }
 
      if ( flagSelect.empty() ) {
-       msg << MSG::ERROR << funcName << "flagSelect is an empty string, and passing a non-DEFAULT tool (presumably a SELECTOR). Please pass a non-empty flagSelect!" << endmsg;
+       msg << MSG::ERROR;
+       funcName() << "flagSelect is an empty string, and passing a non-DEFAULT tool (presumably a SELECTOR). Please pass a non-empty flagSelect!" << endmsg;
        return StatusCode::FAILURE;
      }
 
      SG::AuxElement::ConstAccessor<char> myAccessor(flagSelect);
+     // a flag with a bit decided for the object is tested in its flag word, without looking up its decoration
+     const unsigned long long flagMask = xAH::SelectionFlags::mask( xAH::SelectionFlags::find(flagSelect) );
 
      for ( auto in_itr : *(intCont) ) {
 
+       if ( flagMask && xAH::SelectionFlags::isDecided(*(in_itr), flagMask) ) {
+         if ( xAH::SelectionFlags::test(*(in_itr), flagMask) ) { outCont->push_back( in_itr ); }
+         continue;
+       }
+
        if ( !myAccessor.isAvailable(*(in_itr)) ) {
      	 std::stringstream ss; ss << in_itr->type();
-         msg << MSG::ERROR << funcName << "flag " << flagSelect << " is missing for object of type " << ss.str() << " ! Will not make a subset of its container" << endmsg;
+         msg << MSG::ERROR;
+         funcName() << "flag " << flagSelect << " is missing for object of type " << ss.str() << " ! Will not make a subset of its container" << endmsg;
      	 return StatusCode::FAILURE;
        }
 
@@ -236,6 +482,49 @@ namespace HelperFunctions {
   template< typename T1, typename T2 >
   StatusCode makeSubsetCont( T1*& intCont, T2*& outCont, const std::string& flagSelect = "", HelperClasses::ToolName tool_name = HelperClasses::ToolName::DEFAULT) { return makeSubsetCont<T1, T2>(intCont, outCont, msg(), flagSelect, tool_name); }
 
+  /**
+   * @brief Same as the ``SELECTOR`` case of ``makeSubsetCont`` above, with an accessor built once by the caller
+   *
+   * Looking up the decoration from its name takes a lock on the aux type registry, so callers building many subsets per event
+   * (e.g. one per systematic) should keep the accessor as a member.
+   */
+  template< typename T1, typename T2 >
+  StatusCode makeSubsetCont( T1*& intCont, T2*& outCont, MsgStream& msg, const SG::AuxElement::ConstAccessor<char>& selectAcc ){
+     if ( intCont->empty() ) { return StatusCode::SUCCESS; }
+     outCont->reserve( outCont->size() + intCont->size() );
+     for ( auto in_itr : *(intCont) ) {
+       if ( !selectAcc.isAvailable(*(in_itr)) ) {
+         msg << MSG::ERROR << "in makeSubsetCont<" << cached_type_name<T1>() << "," << cached_type_name<T2>() << ">(): flag "
+             << SG::AuxTypeRegistry::instance().getName(selectAcc.auxid()) << " is missing for object of type " << in_itr->type() << " ! Will not make a subset of its container" << endmsg;
+         return StatusCode::FAILURE;
+       }
+       if ( selectAcc(*(in_itr)) ) { outCont->push_back( in_itr ); }
+     }
+     return StatusCode::SUCCESS;
+  }
+
+  /**
+   * @brief Same as above, also recording the decision of ``selectAcc`` as bit ``flagBit`` of the :cpp:any:`xAH::SelectionFlags` word of each object
+   *
+   * For decisions decorated by a tool (e.g. ``passOR``), so that the later selections test the flag word.
+   */
+  template< typename T1, typename T2 >
+  StatusCode makeSubsetCont( T1*& intCont, T2*& outCont, MsgStream& msg, const SG::AuxElement::ConstAccessor<char>& selectAcc, int flagBit ){
+     if ( intCont->empty() ) { return StatusCode::SUCCESS; }
+     outCont->reserve( outCont->size() + intCont->size() );
+     for ( auto in_itr : *(intCont) ) {
+       if ( !selectAcc.isAvailable(*(in_itr)) ) {
+         msg << MSG::ERROR << "in makeSubsetCont<" << cached_type_name<T1>() << "," << cached_type_name<T2>() << ">(): flag "
+             << SG::AuxTypeRegistry::instance().getName(selectAcc.auxid()) << " is missing for object of type " << in_itr->type() << " ! Will not make a subset of its container" << endmsg;
+         return StatusCode::FAILURE;
+       }
+       const bool pass = selectAcc(*(in_itr));
+       xAH::SelectionFlags::set(*(in_itr), flagBit, pass);
+       if ( pass ) { outCont->push_back( in_itr ); }
+     }
+     return StatusCode::SUCCESS;
+  }
+
   /** @brief Retrieve an arbitrary object from TStore / TEvent
     @param cont  pass in a pointer to the object to store the retrieved container in
     @param name  the name of the object to look up
@@ -279,35 +568,40 @@ namespace HelperFunctions {
     @endrst
   */
   template <typename T>
-  StatusCode retrieve(T*& cont, std::string name, xAOD::TEvent* event, xAOD::TStore* store, MsgStream& msg){
-    std::string funcName{"in retrieve<"+type_name<T>()+">(" + name + "): "};
+  StatusCode retrieve(T*& cont, const std::string& name, xAOD::TEvent* event, xAOD::TStore* store, MsgStream& msg){
+    // the message prefix is only built when the message is actually printed
+    const bool debug = msg.level() <= MSG::DEBUG;
+    auto funcName = [&msg, &name]() -> MsgStream& { msg << "in retrieve<" << cached_type_name<T>() << ">(" << name << "): "; return msg; };
     if((event == NULL) && (store == NULL)){
-      msg << MSG::ERROR << funcName << "Both TEvent and TStore objects are null. Cannot retrieve anything." << endmsg;
+      msg << MSG::ERROR;
+      funcName() << "Both TEvent and TStore objects are null. Cannot retrieve anything." << endmsg;
       return StatusCode::FAILURE;
     }
-    msg << MSG::DEBUG << funcName << "\tAttempting to retrieve " << name << " of type " << type_name<T>() << endmsg;
-    if((event != NULL) && (store == NULL)) msg << MSG::DEBUG << funcName << "\t\tLooking inside: xAOD::TEvent" << endmsg;
-    if((event == NULL) && (store != NULL)) msg << MSG::DEBUG << funcName << "\t\tLooking inside: xAOD::TStore" << endmsg;
-    if((event != NULL) && (store != NULL)) msg << MSG::DEBUG << funcName << "\t\tLooking inside: xAOD::TStore, xAOD::TEvent" << endmsg;
+    if(debug){
+      msg << MSG::DEBUG; funcName() << "\tAttempting to retrieve " << name << " of type " << cached_type_name<T>() << endmsg;
+      if((event != NULL) && (store == NULL)){ msg << MSG::DEBUG; funcName() << "\t\tLooking inside: xAOD::TEvent" << endmsg; }
+      if((event == NULL) && (store != NULL)){ msg << MSG::DEBUG; funcName() << "\t\tLooking inside: xAOD::TStore" << endmsg; }
+      if((event != NULL) && (store != NULL)){ msg << MSG::DEBUG; funcName() << "\t\tLooking inside: xAOD::TStore, xAOD::TEvent" << endmsg; }
+    }
     if((store != NULL) && (store->contains<T>(name))){
-      msg << MSG::DEBUG << funcName << "\t\t\tFound inside xAOD::TStore" << endmsg;
+      if(debug){ msg << MSG::DEBUG; funcName() << "\t\t\tFound inside xAOD::TStore" << endmsg; }
       if(!store->retrieve( cont, name ).isSuccess()) return StatusCode::FAILURE;
-      msg << MSG::DEBUG << funcName << "\t\t\tRetrieved from xAOD::TStore" << endmsg;
+      if(debug){ msg << MSG::DEBUG; funcName() << "\t\t\tRetrieved from xAOD::TStore" << endmsg; }
     } else if((event != NULL) && (event->contains<T>(name))){
-      msg << MSG::DEBUG << funcName << "\t\t\tFound inside xAOD::TEvent" << endmsg;
+      if(debug){ msg << MSG::DEBUG; funcName() << "\t\t\tFound inside xAOD::TEvent" << endmsg; }
       if(!event->retrieve( cont, name ).isSuccess()) return StatusCode::FAILURE;
-      msg << MSG::DEBUG << funcName << "\t\t\tRetrieved from xAOD::TEvent" << endmsg;
+      if(debug){ msg << MSG::DEBUG; funcName() << "\t\t\tRetrieved from xAOD::TEvent" << endmsg; }
     } else {
-      msg << MSG::DEBUG << funcName << "\t\tNot found at all" << endmsg;
+      if(debug){ msg << MSG::DEBUG; funcName() << "\t\tNot found at all" << endmsg; }
       return StatusCode::FAILURE;
     }
     return StatusCode::SUCCESS;
   }
   /* retrieve() overload for no msgStream object passed in */
   template <typename T>
-  StatusCode retrieve(T*& cont, std::string name, xAOD::TEvent* event, xAOD::TStore* store) { return retrieve<T>(cont, name, event, store, msg()); }
+  StatusCode retrieve(T*& cont, const std::string& name, xAOD::TEvent* event, xAOD::TStore* store) { return retrieve<T>(cont, name, event, store, msg()); }
   template <typename T>
-  StatusCode __attribute__((deprecated("retrieve<T>(..., bool) is deprecated. See https://github.com/UCATLAS/xAODAnaHelpers/pull/882"))) retrieve(T*& cont, std::string name, xAOD::TEvent* event, xAOD::TStore* store, bool debug) { return retrieve<T>(cont, name, event, store, msg()); }
+  StatusCode __attribute__((deprecated("retrieve<T>(..., bool) is deprecated. See https://github.com/UCATLAS/xAODAnaHelpers/pull/882"))) retrieve(T*& cont, const std::string& name, xAOD::TEvent* event, xAOD::TStore* store, bool debug) { return retrieve<T>(cont, name, event, store, msg()); }
 
   /** @brief Return true if an arbitrary object from TStore / TEvent is available
     @param name  the name of the object to look up
@@ -332,53 +626,71 @@ namespace HelperFunctions {
     @endrst
   */
   template <typename T>
-  bool isAvailable(std::string name, xAOD::TEvent* event, xAOD::TStore* store, MsgStream& msg){
+  bool isAvailable(const std::string& name, xAOD::TEvent* event, xAOD::TStore* store, MsgStream& msg){
     /* Checking Order:
         - check if store contains 'xAOD::JetContainer' named 'name'
         --- checkstore store
         - check if event contains 'xAOD::JetContainer' named 'name'
         --- checkstore event
     */
-    std::string funcName{"in isAvailable<"+type_name<T>()+">(" + name + "): "};
-    msg << MSG::DEBUG << funcName << "\tAttempting to retrieve " << name << " of type " << type_name<T>() << endmsg;
-    if(store == NULL)                      msg << MSG::DEBUG << funcName << "\t\tLooking inside: xAOD::TEvent" << endmsg;
-    if(event == NULL)                      msg << MSG::DEBUG << funcName << "\t\tLooking inside: xAOD::TStore" << endmsg;
-    if((event != NULL) && (store != NULL)) msg << MSG::DEBUG << funcName << "\t\tLooking inside: xAOD::TStore, xAOD::TEvent" << endmsg;
+    // the message prefix is only built when the message is actually printed
+    const bool debug = msg.level() <= MSG::DEBUG;
+    auto funcName = [&msg, &name]() -> MsgStream& { msg << "in isAvailable<" << cached_type_name<T>() << ">(" << name << "): "; return msg; };
+    if(debug){
+      msg << MSG::DEBUG; funcName() << "\tAttempting to retrieve " << name << " of type " << cached_type_name<T>() << endmsg;
+      if(store == NULL)                      { msg << MSG::DEBUG; funcName() << "\t\tLooking inside: xAOD::TEvent" << endmsg; }
+      if(event == NULL)                      { msg << MSG::DEBUG; funcName() << "\t\tLooking inside: xAOD::TStore" << endmsg; }
+      if((event != NULL) && (store != NULL)) { msg << MSG::DEBUG; funcName() << "\t\tLooking inside: xAOD::TStore, xAOD::TEvent" << endmsg; }
+    }
     if((store != NULL) && (store->contains<T>(name))){
-      msg << MSG::DEBUG << funcName << "\t\t\tFound inside xAOD::TStore" << endmsg;;
+      if(debug){ msg << MSG::DEBUG; funcName() << "\t\t\tFound inside xAOD::TStore" << endmsg; }
       return true;
     } else if((event != NULL) && (event->contains<T>(name))){
-      msg << MSG::DEBUG << funcName << "\t\t\tFound inside xAOD::TEvent" << endmsg;
+      if(debug){ msg << MSG::DEBUG; funcName() << "\t\t\tFound inside xAOD::TEvent" << endmsg; }
       return true;
     } else {
-      msg << MSG::DEBUG << funcName << "\t\tNot found at all" << endmsg;
+      if(debug){ msg << MSG::DEBUG; funcName() << "\t\tNot found at all" << endmsg; }
       return false;
     }
     return false;
   }
   /* isAvailable() overload for no msgStream object passed in */
   template <typename T>
-  bool isAvailable(std::string name, xAOD::TEvent* event, xAOD::TStore* store) { return isAvailable<T>(name, event, store, msg()); }
+  bool isAvailable(const std::string& name, xAOD::TEvent* event, xAOD::TStore* store) { return isAvailable<T>(name, event, store, msg()); }
 
   // stolen from here
   // https://svnweb.cern.ch/trac/atlasoff/browser/Event/xAOD/xAODEgamma/trunk/xAODEgamma/EgammaTruthxAODHelpers.h#L20
   // util becomes a general xAOD tool
-  /// @brief Access to element link to object of type T stored in auxdata
+  /**
+    @brief Access to element link to object of type T stored in auxdata, through an accessor constructed once
+
+    @rst
+      For loops over objects, the variable is looked up by name only once, when the accessor is made::
+
+        static const SG::AuxElement::ConstAccessor< ElementLink<xAOD::JetContainer> > truthLink("GhostTruthAssociationLink");
+        const xAOD::Jet* truthJet = HelperFunctions::getLink<xAOD::Jet>( jet, truthLink );
+
+    @endrst
+   */
   template<class T>
-    const T* getLink(const xAOD::IParticle* particle, std::string name){
+    const T* getLink(const xAOD::IParticle* particle, const SG::AuxElement::ConstAccessor< ElementLink< DataVector<T> > >& acc){
       if (!particle) return 0;
-      typedef ElementLink< DataVector<T> > Link_t;
-
-      if (!particle->isAvailable< Link_t >(name) ) {
+      if (!acc.isAvailable(*particle)) {
         return 0;
       }
-      const Link_t link = particle->auxdata<Link_t>(name);
+      const ElementLink< DataVector<T> >& link = acc(*particle);
       if (!link.isValid()) {
         return 0;
       }
       return *link;
     }
 
+  /// @brief Access to element link to object of type T stored in auxdata
+  template<class T>
+    const T* getLink(const xAOD::IParticle* particle, const std::string& name){
+      return getLink<T>(particle, SG::AuxElement::ConstAccessor< ElementLink< DataVector<T> > >(name));
+    }
+
   //
   // For Sorting
   //
@@ -434,6 +746,19 @@ namespace HelperFunctions {
     return false;
   }
 
+  /**
+    @brief Copy rows ``rows`` of every aux variable of ``src`` to rows ``0, 1, ...`` of ``dst``, one variable at a time
+    @param dst              The container to copy to, it must have at least ``rows.size()`` elements
+    @param src              The container to copy from
+    @param rows             The rows of ``src`` to copy, in order
+    @param auxItems         Dot-separated names of the variables to copy (e.g. ``"pt.eta.phi.m"``), all of them if empty
+
+    @rst
+      The columns of each variable are looked up once. Plain numbers are copied with one ``memcpy`` per run of consecutive rows, the other types (vectors, element links, ...) row by row through the aux type registry.
+    @endrst
+   */
+  void copyAuxColumns(SG::AuxVectorData& dst, const SG::AuxVectorData& src, const std::vector<std::size_t>& rows, const std::string& auxItems = "");
+
   /**
     @brief Make a deep copy of a container and put it in the TStore
     @tparam T1              The type of the container you're going to deep copy into
@@ -442,6 +767,7 @@ namespace HelperFunctions {
     @param m_store          A pointer to the TStore object
     @param containerName    The name of the container to create as output in the TStore
     @param cont             The container to deep copy, it should be a container of pointers (IParticleContainer or ConstDataVector)
+    @param auxItems         Dot-separated names of the aux variables to copy, all of them if empty
 
     @rst
       This is a very powerful templating function. The point is to remove the triviality of making deep copies by specifying all that is needed. The best way is to demonstrate via example::
@@ -450,10 +776,12 @@ namespace HelperFunctions {
         ANA_CHECK( m_event->retrieve( selected_jets, "SelectedJets" ));
         ANA_CHECK( (HelperFunctions::makeDeepCopy<xAOD::JetContainer, xAOD::JetAuxContainer, xAOD::Jet>(m_store, "BaselineJets", selected_jets)));
 
+      When all the objects belong to the same container (e.g. a view of selected objects), the aux data is copied in bulk, one variable at a time with :cpp:func:`HelperFunctions::copyAuxColumns`. Otherwise the objects are copied one by one, with all their variables.
+
     @endrst
    */
   template <typename T1, typename T2, typename T3>
-  StatusCode makeDeepCopy(xAOD::TStore* m_store, std::string containerName, const T1* cont){
+  StatusCode makeDeepCopy(xAOD::TStore* m_store, std::string containerName, const T1* cont, const std::string& auxItems = ""){
     T1* cont_new = new T1;
     T2* auxcont_new = new T2;
     cont_new->setStore(auxcont_new);
@@ -467,10 +795,22 @@ namespace HelperFunctions {
       return StatusCode::FAILURE;
     }
 
+    // the rows of the objects in the container they belong to, if they all belong to the same one
+    const SG::AuxVectorData* src = cont->empty() ? nullptr : cont->front()->container();
+    std::vector<std::size_t> rows;
+    rows.reserve(cont->size());
     for(const auto p: *cont){
-      T3* p_new = new T3;
-      cont_new->push_back(p_new);
-      *p_new = *p;
+      if(p->container() != src) { src = nullptr; break; }
+      rows.push_back(p->index());
+    }
+
+    cont_new->reserve(cont->size());
+    for(std::size_t i = 0; i < cont->size(); ++i) cont_new->push_back(new T3);
+
+    if(src){
+      copyAuxColumns(*cont_new, *src, rows, auxItems);
+    } else {
+      for(std::size_t i = 0; i < cont->size(); ++i) *cont_new->at(i) = *cont->at(i);
     }
     return StatusCode::SUCCESS;
   }
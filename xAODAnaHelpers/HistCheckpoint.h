@@ -0,0 +1,115 @@
+#ifndef xAODAnaHelpers_HistCheckpoint_H
+#define xAODAnaHelpers_HistCheckpoint_H
+
+#include <string>
+#include <vector>
+
+class TH1;
+class TObject;
+class HistogramManager;
+
+namespace xAH {
+
+  class CutflowCounter;
+
+  /**
+      @rst
+          Periodically writes a copy of a set of histograms to a side file between two events, so that the work of a long job is not lost if it dies, and its convergence can be followed.
+
+          Histograms are registered once, either as a whole :cpp:class:`HistogramManager` or one by one (e.g. cutflows)::
+
+              xAH::HistCheckpoint checkpoint;
+              checkpoint.setFile("checkpoint.root");
+              checkpoint.add(hists);
+              checkpoint.add(cutflowHist);
+
+              // between two events
+              checkpoint.write(nEvents);
+
+          :cpp:func:`xAH::HistCheckpoint::write` flushes the fill buffers of the managers and the registered :cpp:class:`xAH::CutflowCounter`, and writes a copy of all the histograms to a temporary file, which then replaces the checkpoint file, so that the file on disk always holds a complete checkpoint. The write is done in the calling thread: ROOT is not necessarily thread safe in the job, and switching its thread safety on once files and histograms exist is not safe either. Choose the checkpoint interval so that the write time stays small against the time of the events in between.
+
+          The checkpoint has the directory layout of the histogram output, plus a ``TParameter<Long64_t>`` named ``checkpoint_events`` holding the number of events it contains. It can therefore be read like the final output, or merged with ``hadd`` with the output of a job processing the remaining events.
+
+      @endrst
+   */
+  class HistCheckpoint {
+    public:
+      HistCheckpoint();
+      ~HistCheckpoint();
+      HistCheckpoint(const HistCheckpoint&) = delete;
+      HistCheckpoint& operator=(const HistCheckpoint&) = delete;
+
+      /// @brief Name of the checkpoint file, set before the first :cpp:func:`xAH::HistCheckpoint::write`
+      void setFile(const std::string& fileName) { m_fileName = fileName; }
+      const std::string& file() const { return m_fileName; }
+
+      /// @brief Include all the histograms of ``hists``, which must live as long as the checkpoints are written
+      void add(HistogramManager* hists);
+      /// @brief Include a single histogram, written under its name
+      void add(TH1* hist);
+      /// @brief Flush ``counter`` into its histogram before every snapshot, the histogram itself is included by whoever booked it
+      void add(CutflowCounter* counter);
+      /// @brief Whether any histogram was registered
+      bool empty() const { return m_managers.empty() && m_hists.empty(); }
+
+      /// @brief Write all the registered histograms, as the state after ``nEvents`` events. Returns false if the file cannot be written
+      bool write(long long nEvents);
+
+      /// @brief Number of checkpoints written so far
+      unsigned int checkpoints() const { return m_checkpoints; }
+
+      /// @brief Append a copy of all the registered histograms to ``objects``, which takes ownership of them
+      void snapshot(std::vector<TObject*>& objects);
+      /// @brief Add the contents of ``obj`` to the registered histogram of the same name. Returns false if there is none
+      bool merge(const TObject* obj);
+
+      /**
+          @rst
+              Write the histograms registered to all the :cpp:class:`xAH::HistCheckpoint` of the process to ``fileName``, right away, in the layout of :cpp:func:`xAH::HistCheckpoint::write`. Used by the worker processes of :cpp:member:`BasicEventSelection::m_forkWorkers` to hand their results back.
+
+          @endrst
+       */
+      static bool writeAll(const std::string& fileName, long long nEvents);
+      /**
+          @rst
+              Add every histogram of ``fileName``, as written by :cpp:func:`xAH::HistCheckpoint::writeAll`, to the registered histogram of the same name, whichever :cpp:class:`xAH::HistCheckpoint` of the process it belongs to. Returns the number of histograms merged, ``-1`` if the file cannot be read. Histograms without a counterpart are reported through ``unmatched``.
+
+          @endrst
+       */
+      static int mergeAll(const std::string& fileName, std::vector<std::string>& unmatched);
+      /**
+          @rst
+              Empty the histograms registered to all the :cpp:class:`xAH::HistCheckpoint` of the process, and the counts of their :cpp:class:`xAH::CutflowCounter`. Called by the worker processes of :cpp:member:`BasicEventSelection::m_forkWorkers` right after the fork, so that what :cpp:func:`xAH::HistCheckpoint::writeAll` hands back is only what the worker added, the first process keeping what was filled before.
+
+          @endrst
+       */
+      static void resetAll();
+
+      /// @brief Record that ``what`` fills results held by no :cpp:class:`xAH::HistCheckpoint`, for :cpp:member:`BasicEventSelection::m_forkWorkers` to refuse the job rather than lose the part of the workers
+      static void addUnregistered(const std::string& what) { unregisteredList().push_back(what); }
+      /// @brief Everything recorded with :cpp:func:`xAH::HistCheckpoint::addUnregistered`
+      static const std::vector<std::string>& unregistered() { return unregisteredList(); }
+
+      /// @brief Tag added to the names of all the checkpoint files of this process, before the extension, e.g. for the worker processes of :cpp:member:`BasicEventSelection::m_forkWorkers` not to overwrite the checkpoints of each other
+      static void setFileTag(const std::string& tag) { fileTag() = tag; }
+
+    private:
+      /// @brief Write ``snapshot`` to ``fileName``, replacing it once complete
+      static bool writeFile(const std::string& fileName, const std::vector<TObject*>& snapshot, long long nEvents);
+      /// @brief All the instances of the process, for :cpp:func:`xAH::HistCheckpoint::writeAll` and :cpp:func:`xAH::HistCheckpoint::mergeAll`
+      static std::vector<HistCheckpoint*>& instances();
+      static std::string& fileTag();
+      static std::vector<std::string>& unregisteredList();
+      void flushCounters();
+      void reset();
+
+      std::string m_fileName;
+      std::vector<HistogramManager*> m_managers;
+      std::vector<TH1*> m_hists;
+      std::vector<CutflowCounter*> m_counters;
+
+      unsigned int m_checkpoints = 0;
+  };
+
+}
+#endif
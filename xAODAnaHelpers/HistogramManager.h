@@ -8,11 +8,17 @@
  */
 
 #include <ctype.h>
+#include <cmath>
+#include <functional>
+#include <limits>
+#include <unordered_map>
+#include <vector>
 #include <TH1.h>
 #include <TH1F.h>
 #include <TH2F.h>
 #include <TH3F.h>
 #include <TProfile.h>
+#include <THnSparse.h>
 #include <EventLoop/IWorker.h>
 #include <xAODRootAccess/TEvent.h>
 
@@ -107,7 +113,7 @@ class HistogramManager {
 
         @endrst
     */
-    virtual StatusCode finalize(){        return StatusCode::SUCCESS; };
+    virtual StatusCode finalize(){        flushFills(); recordSparse(); return StatusCode::SUCCESS; };
 
     /**
         @brief record a histogram and call various functions
@@ -189,11 +195,138 @@ class HistogramManager {
 		   std::string ylabel, double ylow, double yhigh,
 		   std::string option = "");
 
+    /**
+        @brief Book a two-dimensional histogram that only stores the bins that were filled
+        @rst
+            For large, mostly empty histograms, e.g. ``lumiB_runN`` of :cpp:class:`JetHists`, the memory of a ``TH2F`` is allocated for every bin whether it is filled or not. The sparse histograms are ``THnSparseF`` and take the same binning arguments as :cpp:func:`HistogramManager::book`. They are filled with :cpp:func:`HistogramManager::fillSparse`::
+
+                m_lumiB_runN = bookSparse(m_name, "lumiB_runN", "Lumi Block", 2000, 0, 2000, "Run Number", nRunBins, runBins);
+                ...
+                fillSparse( m_lumiB_runN, lumiBlock, runNumber, eventWeight );
+
+            By default they are converted to a ``TH2F`` (``TH3F``) of the same name and binning in :cpp:func:`HistogramManager::finalize`, so that the output is the same as for a dense histogram and the memory is only needed at the end of the job. See :cpp:func:`HistogramManager::setSparseOutput` to write them as they are.
+
+        @endrst
+     */
+    THnSparseF* bookSparse(std::string name, std::string title,
+                           std::string xlabel, int xbins, double xlow, double xhigh,
+                           std::string ylabel, int ybins, double ylow, double yhigh);
+
+    /**
+     * @overload
+     */
+    THnSparseF* bookSparse(std::string name, std::string title,
+                           std::string xlabel, int xbins, const Double_t* xbinsArr,
+                           std::string ylabel, int ybins, double ylow, double yhigh);
+
+    /**
+     * @overload
+     */
+    THnSparseF* bookSparse(std::string name, std::string title,
+                           std::string xlabel, int xbins, double xlow, double xhigh,
+                           std::string ylabel, int ybins, const Double_t* ybinsArr);
+
+    /**
+     * @overload
+     */
+    THnSparseF* bookSparse(std::string name, std::string title,
+                           std::string xlabel, int xbins, const Double_t* xbinsArr,
+                           std::string ylabel, int ybins, const Double_t* ybinsArr);
+
+    /**
+     * @overload
+     */
+    THnSparseF* bookSparse(std::string name, std::string title,
+                           std::string xlabel, int xbins, double xlow, double xhigh,
+                           std::string ylabel, int ybins, double ylow, double yhigh,
+                           std::string zlabel, int zbins, double zlow, double zhigh);
+
+    /**
+     * @overload
+     */
+    THnSparseF* bookSparse(std::string name, std::string title,
+                           std::string xlabel, int xbins, const Double_t* xbinsArr,
+                           std::string ylabel, int ybins, const Double_t* ybinsArr,
+                           std::string zlabel, int zbins, const Double_t* zbinsArr);
+
+    /**
+     * @brief Fill a histogram booked with HistogramManager#bookSparse
+     */
+    void fillSparse(THnSparse* hist, double valueX, double valueY, double weight = 1.) const;
+    /**
+     * @overload
+     */
+    void fillSparse(THnSparse* hist, double valueX, double valueY, double valueZ, double weight) const;
+
+    /**
+     * @brief Write the histograms of HistogramManager#bookSparse as ``THnSparseF`` (``false``) or convert them to ``TH2F``/``TH3F`` at HistogramManager#finalize (``true``, the default). Must be called before HistogramManager#record
+     */
+    void setSparseOutput(bool dense) { m_sparseDense = dense; }
+
+    /**
+        @brief Memory in bytes taken by the booked histograms and the fill buffers
+        @rst
+            Counts the bin contents and squared weights of the histograms of :cpp:member:`HistogramManager::m_allHists`, the filled bins of those of :cpp:func:`HistogramManager::bookSparse` (an estimate, the bins are stored compacted), and the buffers of :cpp:func:`HistogramManager::fillBuffered`. It is used by the ``*HistsAlgo`` for :cpp:member:`xAH::Algorithm::m_histMemoryBudget`.
+
+        @endrst
+     */
+    std::size_t memoryBytes() const;
+
+    /**
+        @brief Append a copy of every booked histogram to ``objects``, which takes ownership of them
+        @rst
+            Flushes the fill buffers first (see :cpp:func:`HistogramManager::flushFills`), so it must be called between two events from the thread filling the histograms. The histograms of :cpp:func:`HistogramManager::bookSparse` are copied as they are. Used by :cpp:class:`xAH::HistCheckpoint`.
+
+            Classes holding histograms in managers of their own (e.g. :cpp:class:`JetHists` and its :cpp:class:`TracksInJetHists`) override this, :cpp:func:`HistogramManager::merge` and :cpp:func:`HistogramManager::reset` to include them, as they do for :cpp:func:`HistogramManager::record`.
+
+        @endrst
+     */
+    virtual void snapshot(std::vector<TObject*>& objects);
+
+    /**
+     * @brief Add the contents of ``obj`` to the booked histogram of the same name (including those of HistogramManager#bookSparse). Returns false if there is none
+     */
+    virtual bool merge(const TObject* obj);
+
+    /**
+     * @brief Empty all the booked histograms (including those of HistogramManager#bookSparse), dropping the pending fills. Used by the worker processes of BasicEventSelection#m_forkWorkers
+     */
+    virtual void reset();
+
     /**
      * @brief record all histograms from HistogramManager#m_allHists to the worker
      */
     void record(EL::IWorker* wk);
 
+    /**
+        @brief Leave the histograms that can be packed out of HistogramManager#record (``true``), for the caller to write them with HistogramManager#packVariations instead. Must be called before HistogramManager#record
+        @rst
+            The histograms left out are still booked and filled as usual, and deleted with the :cpp:class:`HistogramManager`. The others (multi-dimensional histograms and profiles) are recorded unchanged.
+
+        @endrst
+     */
+    void setPackedOutput(bool packed) { m_packedOutput = packed; }
+
+    /** @brief Whether HistogramManager#packVariations can take a histogram: one-dimensional and not a profile */
+    static bool isPackable(const TH1* hist);
+
+    /** @brief The histograms of HistogramManager#m_allHists that can be packed, with their name relative to HistogramManager#m_name */
+    std::vector< std::pair<std::string, const TH1*> > packableHists() const;
+
+    /**
+        @brief Pack the variations of one observable into a single ``TH2F`` named ``name``
+        @param name             Full name of the packed histogram
+        @param variations       The same observable booked for every variation, with the same binning, null for variations without it
+        @param labels           Label of the y bin of each variation
+        @rst
+            The x axis takes the (uniform or variable) binning of the first variation, and every variation is copied into one y bin, under- and overflow included. One ``TH2F`` per observable instead of one ``TH1`` per observable and variation keeps the number of keys in the output independent of the number of systematics, which is what ``hadd`` and opening the file scale with. Variations that are null or have a different number of bins are left empty.
+
+            The variation of a bin is read with ``TH2::ProjectionX(name, iVariation+1, iVariation+1)``, or by label with ``GetYaxis()->FindBin(label)``.
+
+        @endrst
+     */
+    static TH2F* packVariations(const std::string& name, const std::vector<const TH1*>& variations, const std::vector<std::string>& labels);
+
     /**
       * @brief the standard message stream for this algorithm
       */
@@ -214,7 +347,7 @@ class HistogramManager {
     HistMap_t m_histMap;
 
     /**
-     * @brief Return the pointer to the histogram
+     * @brief Return the pointer to the histogram, a hashed lookup in HistogramManager#m_histMap
      */
     TH1* findHist(const std::string& histName);
 
@@ -231,8 +364,379 @@ class HistogramManager {
     void fillHist(const std::string& histName, double value, double weight);
     void fillHist(const std::string& histName, double valueX, double valueY, double weight);
 
+    /**
+        @brief Register a booked histogram under an integer handle, typically an enumerator of the subclass
+        @rst
+            Handles replace one pointer member per histogram and give an indexed lookup instead of a lookup by name::
+
+                enum Hist { kPt, kEta };
+
+                bookHandle( kPt,  book(m_name, "pt",  "p_{T} [GeV]", 100, 0, 1000) );
+                bookHandle( kEta, book(m_name, "eta", "#eta", 80, -4, 4) );
+                ...
+                fillHist( kPt, jet->pt()/1e3, eventWeight );
+
+            Returns ``hist``.
+
+        @endrst
+     */
+    template <typename T>
+    T* bookHandle(unsigned int handle, T* hist) {
+      if ( m_handles.size() <= handle ) m_handles.resize(handle + 1, nullptr);
+      m_handles[handle] = hist;
+      return hist;
+    }
+
+    /**
+     * @brief Return the histogram registered under a handle with HistogramManager#bookHandle
+     */
+    TH1* hist(unsigned int handle) const { return m_handles[handle]; }
+
+    /**
+     * @brief Fill the histogram registered under a handle
+     */
+    void fillHist(unsigned int handle, double value, double weight) { m_handles[handle]->Fill(value, weight); }
+    /**
+     * @overload
+     */
+    void fillHist(unsigned int handle, double valueX, double valueY, double weight) { static_cast<TH2*>(m_handles[handle])->Fill(valueX, valueY, weight); }
+
+    /**
+        @brief A booked histogram resolved once for HistogramManager#fillBuffered, see HistogramManager#fillSlot
+     */
+    class FillSlot {
+      public:
+        FillSlot() = default;
+        /** @brief Whether the slot belongs to a booked histogram */
+        bool valid() const { return m_hist != nullptr; }
+      private:
+        friend class HistogramManager;
+        FillSlot(unsigned int index, TH1* hist) : m_index(index), m_hist(hist) {}
+        unsigned int m_index = 0;
+        TH1* m_hist = nullptr;
+    };
+
+    /**
+        @brief Resolve a booked histogram for HistogramManager#fillBuffered
+        @rst
+            Call it once after booking, in ``initialize()``, and fill through the slot, so that the fills index the buffers directly instead of looking the histogram up. Returns an invalid slot (and prints an error) for a histogram that was not booked through this manager.
+
+        @endrst
+     */
+    FillSlot fillSlot(TH1* hist) const;
+
+    /**
+        @brief Fill a one-dimensional histogram through a buffer
+        @rst
+            The values are collected per histogram and written with a single ``TH1::FillN`` call once :cpp:func:`HistogramManager::setFillBufferSize` values were collected, or at :cpp:func:`HistogramManager::flushFills`. This saves the axis lookup and virtual dispatch of one ``TH1::Fill`` per value. Subclasses opt in by calling this instead of ``Fill`` for their hot histograms, resolving them once after booking::
+
+                m_jetPtSlot = fillSlot( m_jetPt );
+                ...
+                fillBuffered( m_jetPtSlot, jet->pt()/1e3, eventWeight );
+
+            With the default buffer size of ``0`` the value is filled immediately.
+
+            Uniformly binned one-dimensional histograms (not profiles) skip ROOT altogether while buffering: the values are binned into a private array of bin contents with a precomputed inverse bin width, and the statistics are summed alongside. The array is added to the histogram at :cpp:func:`HistogramManager::flushFills`. The bin contents are summed in double precision, so the result can differ from ``TH1F::Fill`` in the last digits.
+
+            .. note:: The buffers are flushed in :cpp:func:`HistogramManager::finalize`. Classes overriding it must call the base class, and code reading the histograms before the end of the job must call :cpp:func:`HistogramManager::flushFills` first.
+
+        @endrst
+     */
+    void fillBuffered(const FillSlot& slot, double value, double weight = 1.);
+
+    /**
+        @brief Fill ``n`` values with the same weight into a one-dimensional histogram
+        @rst
+            The batched form of :cpp:func:`HistogramManager::fillBuffered`, for observables read into a contiguous array first, e.g. of all the clusters of an event. Uniformly binned histograms bin the values directly into their buffer whatever the buffer size, so they are only up to date after :cpp:func:`HistogramManager::flushFills`.
+
+        @endrst
+     */
+    void fillBuffered(const FillSlot& slot, const double* values, std::size_t n, double weight = 1.);
+
+    /**
+     * @brief Same as the HistogramManager::FillSlot version, resolving the histogram on every call, for histograms that are not filled often. A histogram not booked by this manager is filled right away.
+     */
+    void fillBuffered(TH1* hist, double value, double weight = 1.);
+    /**
+     * @overload
+     */
+    void fillBuffered(TH1* hist, const double* values, std::size_t n, double weight = 1.);
+
+    /**
+        @brief Several binnings of the same observable, e.g. the ``Pt``, ``Pt_l``, ``Pt_m`` and ``Pt_s`` histograms of a particle
+        @rst
+            The histograms are booked as usual and added to the group once, resolved with :cpp:func:`HistogramManager::fillSlot`::
+
+                m_ptBinnings.add(fillSlot(m_Pt)).add(fillSlot(m_Pt_l)).add(fillSlot(m_Pt_m)).add(fillSlot(m_Pt_s));
+                ...
+                fillBuffered( m_ptBinnings, jet->pt()/1e3, eventWeight );
+
+        @endrst
+     */
+    class MultiBinning {
+      public:
+        /** @brief Add a histogram of the observable, returns the group so that the calls can be chained */
+        MultiBinning& add(const FillSlot& slot) { m_slots.push_back(slot); return *this; }
+        const std::vector<FillSlot>& slots() const { return m_slots; }
+      private:
+        std::vector<FillSlot> m_slots;
+    };
+
+    /**
+        @brief Fill one value into all the binnings of a HistogramManager::MultiBinning
+        @rst
+            The weighted statistics are computed once for all the histograms, and the uniformly binned ones are binned directly into their buffers like :cpp:func:`HistogramManager::fillBuffered` does, whatever the buffer size: each binning costs one multiplication instead of a ``TH1::Fill``. The other histograms go through :cpp:func:`HistogramManager::fillBuffered`. As for sharded filling, the histograms are only up to date after :cpp:func:`HistogramManager::flushFills`, which :cpp:func:`HistogramManager::finalize` calls.
+
+        @endrst
+     */
+    void fillBuffered(const MultiBinning& binnings, double value, double weight = 1.);
+
+    /**
+        @brief A table of the observables of an object of type ``T``, each with its binning and an accessor, booked and filled in one go
+        @rst
+            Instead of one member pointer, one :cpp:func:`HistogramManager::book` call and one ``Fill`` per observable, the observables are declared once, with a flag to switch them off::
+
+                typedef ObservableTable<xAOD::Jet> JetTable;
+                auto emFrac = [](const xAOD::Jet& jet){ float f; return jet.getAttribute("EMFrac", f) ? f : JetTable::missing(); };
+
+                m_energy.add( "EMFrac", "EM Fraction", 120, 0, 2, emFrac, m_infoSwitch->m_energy )
+                        .addProfile( "EMFrac_vs_eta", "#eta", 20, -4, 4, "EM Fraction", 0, 2,
+                                     [](const xAOD::Jet& jet){ return jet.eta(); }, emFrac, m_infoSwitch->m_energy );
+                bookTable( m_energy );
+                ...
+                fillTable( m_energy, *jets, eventWeight );
+
+            An accessor returns :cpp:func:`HistogramManager::ObservableTable::missing` when the value is not available for an object, which is then not filled. The histograms are named ``m_name + name`` like the ones of :cpp:func:`HistogramManager::book`. Rows booked enabled can be switched off and on again at runtime with :cpp:func:`HistogramManager::ObservableTable::setEnabled`.
+
+            Filling a container goes observable by observable: the values of all the objects are evaluated into one contiguous array, which one-dimensional histograms take with the batched :cpp:func:`HistogramManager::fillBuffered`. They are therefore only up to date after :cpp:func:`HistogramManager::flushFills`, i.e. :cpp:func:`HistogramManager::finalize`.
+
+        @endrst
+     */
+    template <typename T>
+    class ObservableTable {
+      public:
+        typedef std::function<double(const T&)> Accessor;
+
+        /** @brief The value an accessor returns for an object without the observable */
+        static double missing() { return std::numeric_limits<double>::quiet_NaN(); }
+
+        /** @brief Add a histogram of ``x``, returns the table so that the calls can be chained */
+        ObservableTable& add(const std::string& name, const std::string& xlabel, int xbins, double xlow, double xhigh, Accessor x, bool enabled = true) {
+          Row row;
+          row.name = name; row.xlabel = xlabel; row.xbins = xbins; row.xlow = xlow; row.xhigh = xhigh;
+          row.x = x; row.enabled = enabled;
+          m_rows.push_back(row);
+          return *this;
+        }
+
+        /** @brief Add a profile of ``y`` vs ``x`` */
+        ObservableTable& addProfile(const std::string& name, const std::string& xlabel, int xbins, double xlow, double xhigh,
+                                    const std::string& ylabel, double ylow, double yhigh, Accessor x, Accessor y, bool enabled = true) {
+          add(name, xlabel, xbins, xlow, xhigh, x, enabled);
+          Row& row = m_rows.back();
+          row.ylabel = ylabel; row.ylow = ylow; row.yhigh = yhigh; row.y = y;
+          return *this;
+        }
+
+        /** @brief Switch an observable off or on, only observables that were booked can be switched on. Returns false if there is no such booked observable */
+        bool setEnabled(const std::string& name, bool enabled) {
+          for ( Row& row : m_rows ) {
+            if ( row.name != name || !row.hist ) continue;
+            row.enabled = enabled;
+            return true;
+          }
+          return false;
+        }
+
+        /** @brief The histogram of an observable, ``nullptr`` if it was not booked */
+        TH1* hist(const std::string& name) const {
+          for ( const Row& row : m_rows ) if ( row.name == name ) return row.hist;
+          return nullptr;
+        }
+
+      private:
+        friend class HistogramManager;
+        struct Row {
+          std::string name;
+          std::string xlabel;
+          int xbins = 0;
+          double xlow = 0.;
+          double xhigh = 0.;
+          std::string ylabel;
+          double ylow = 0.;
+          double yhigh = 0.;
+          Accessor x;
+          /** @brief set for profiles only */
+          Accessor y;
+          bool enabled = true;
+          TH1* hist = nullptr;
+          /** @brief the histogram resolved for HistogramManager#fillBuffered, one-dimensional histograms only */
+          FillSlot slot;
+        };
+        std::vector<Row> m_rows;
+    };
+
+    /**
+     * @brief Book the enabled observables of a HistogramManager::ObservableTable
+     */
+    template <typename T>
+    void bookTable(ObservableTable<T>& table) {
+      for ( auto& row : table.m_rows ) {
+        if ( !row.enabled ) continue;
+        if ( row.y ) row.hist = book(m_name, row.name, row.xlabel, row.xbins, row.xlow, row.xhigh, row.ylabel, row.ylow, row.yhigh);
+        else         row.slot = fillSlot( row.hist = book(m_name, row.name, row.xlabel, row.xbins, row.xlow, row.xhigh) );
+      }
+    }
+
+    /**
+     * @brief Fill the enabled observables of a HistogramManager::ObservableTable for one object
+     */
+    template <typename T>
+    void fillTable(ObservableTable<T>& table, const T& object, double weight) {
+      for ( const auto& row : table.m_rows ) {
+        if ( !row.enabled || !row.hist ) continue;
+        const double x = row.x(object);
+        if ( std::isnan(x) ) continue;
+        if ( row.y ) {
+          const double y = row.y(object);
+          if ( !std::isnan(y) ) static_cast<TProfile*>(row.hist)->Fill(x, y, weight);
+        } else {
+          fillBuffered(row.slot, x, weight);
+        }
+      }
+    }
+
+    /**
+     * @brief Fill the enabled observables of a HistogramManager::ObservableTable for all the objects of a container of ``T*``, observable by observable
+     */
+    template <typename T, typename CONTAINER>
+    void fillTable(ObservableTable<T>& table, const CONTAINER& objects, double weight) {
+      for ( const auto& row : table.m_rows ) {
+        if ( !row.enabled || !row.hist ) continue;
+        if ( row.y ) {
+          for ( const T* object : objects ) {
+            const double x = row.x(*object);
+            const double y = row.y(*object);
+            if ( !std::isnan(x) && !std::isnan(y) ) static_cast<TProfile*>(row.hist)->Fill(x, y, weight);
+          }
+          continue;
+        }
+
+        // the values of one observable for all the objects, per thread for sharded filling
+        static thread_local std::vector<double> values;
+        values.clear();
+        for ( const T* object : objects ) {
+          const double x = row.x(*object);
+          if ( !std::isnan(x) ) values.push_back(x);
+        }
+        fillBuffered(row.slot, values.data(), values.size(), weight);
+      }
+    }
+
+    /**
+     * @brief Number of values buffered per histogram by HistogramManager#fillBuffered before they are filled, ``0`` fills immediately
+     */
+    void setFillBufferSize(unsigned int size);
+
+    /**
+     * @brief Fill all values buffered by HistogramManager#fillBuffered into their histograms
+     */
+    void flushFills();
+
+    /**
+        @brief Number of shards filled by HistogramManager#fillBuffered, one per thread filling the histograms concurrently
+        @rst
+            With more than one shard, every thread fills its own set of buffers, selected with a :cpp:class:`HistogramManager::ShardScope`, and the shards are merged into the histograms of :cpp:member:`HistogramManager::m_allHists` at :cpp:func:`HistogramManager::flushFills`, i.e. in :cpp:func:`HistogramManager::finalize`. Values are then always buffered, independent of :cpp:func:`HistogramManager::setFillBufferSize`. :cpp:func:`xAH::Algorithm::forEachSystematic` selects the shard of its ``slot`` automatically, so histogram classes filled from it only need::
+
+                m_plots->setShards( systThreads() );
+
+            .. warning:: Only fills through :cpp:func:`HistogramManager::fillBuffered` are sharded. Histograms filled directly with ``Fill`` must not be filled from several threads.
+
+        @endrst
+     */
+    void setShards(unsigned int nShards);
+
+    /**
+        @brief Select the shard filled by the calling thread for the lifetime of this object
+        @rst
+            Shard ``0``, the default, belongs to the thread calling :cpp:func:`HistogramManager::flushFills`. The selection applies to all instances of :cpp:class:`HistogramManager`.
+
+        @endrst
+     */
+    class ShardScope {
+      public:
+        explicit ShardScope(unsigned int shard);
+        ~ShardScope();
+        ShardScope(const ShardScope&) = delete;
+        ShardScope& operator=(const ShardScope&) = delete;
+      private:
+        unsigned int m_previous;
+    };
+
 
   private:
+    /** @brief one axis of a histogram booked with HistogramManager#bookSparse, ``edges`` is null for uniform bins */
+    struct SparseAxis {
+      std::string label;
+      int nbins;
+      double low;
+      double high;
+      const Double_t* edges;
+    };
+    THnSparseF* bookSparse(const std::string& name, const std::string& title, const std::vector<SparseAxis>& axes);
+
+    /** @brief Add the histograms of HistogramManager#bookSparse to the worker, converted to dense ones unless HistogramManager#setSparseOutput said otherwise */
+    void recordSparse();
+
+    /** @brief the histograms booked with HistogramManager#bookSparse */
+    std::vector< THnSparseF* > m_allSparse; //!
+    bool m_sparseDense = true; //!
+    /** @brief the worker of HistogramManager#record, the dense histograms are added to it at HistogramManager#finalize */
+    EL::IWorker* m_worker = nullptr; //!
+
+    /** @brief see HistogramManager#setPackedOutput, and the histograms HistogramManager#record left out */
+    bool m_packedOutput = false; //!
+    std::vector< TH1* > m_unrecorded; //!
+
+    /** @brief histograms indexed by the handles of HistogramManager#bookHandle */
+    std::vector< TH1* > m_handles; //!
+
+    /** @brief values waiting to be filled into a histogram by HistogramManager#flushFills */
+    struct FillBuffer {
+      /** @brief whether the buffer was set up for its histogram, on its first fill */
+      bool ready = false;
+      std::vector<double> values;
+      std::vector<double> weights;
+
+      /** @brief whether the values are binned directly into HistogramManager::FillBuffer::sumw, see HistogramManager#fillBuffered */
+      bool uniform = false;
+      double xlow = 0.;
+      double xhigh = 0.;
+      double binsPerUnit = 0.;
+      int nbins = 0;
+      /** @brief bin contents and squared weights including under- and overflow, indexed like the bins of the histogram */
+      std::vector<double> sumw;
+      std::vector<double> sumw2;
+      /** @brief statistics of the values within the axis range, in the order of TH1::GetStats */
+      double stats[4] = {0., 0., 0., 0.};
+      double entries = 0.;
+    };
+    /** @brief the buffers of one shard, indexed like HistogramManager#m_allHists */
+    typedef std::vector< FillBuffer > FillBuffers;
+    /** @brief The buffer of a histogram, set up on first use, deciding whether it can use the uniform binning */
+    static FillBuffer& fillBuffer(FillBuffers& buffers, const FillSlot& slot);
+    /** @brief the position in HistogramManager#m_allHists of each booked histogram, for HistogramManager#fillSlot */
+    std::unordered_map< const TH1*, unsigned int > m_slotIndex; //!
+    /** @brief Add the content of a buffer to its histogram and empty it */
+    static void flush(TH1* hist, FillBuffer& buffer);
+    /** @brief Bin a value into a uniform buffer, with the products of the weight needed by the statistics precomputed */
+    static void fillUniform(FillBuffer& buffer, double value, double weight, double weight2, double weightValue, double weightValue2);
+    /** @brief one set of buffers per shard, see HistogramManager#setShards */
+    std::vector< FillBuffers > m_shards = std::vector< FillBuffers >(1); //!
+    unsigned int m_fillBufferSize = 0; //!
+    /** @brief the shard selected by the calling thread */
+    static thread_local unsigned int s_currentShard;
+
     /**
      * @brief Turn on Sumw2 for the histogram
      *
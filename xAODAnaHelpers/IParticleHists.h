@@ -29,6 +29,28 @@ class IParticleHists : public HistogramManager
 
     //StatusCode execute( const xAH::ParticleContainer* particles, float eventWeight, const xAH::EventInfo* eventInfo = 0 );
     virtual StatusCode execute( const xAH::Particle* particle, float eventWeight, const xAH::EventInfo* eventInfo = 0);
+
+    /**
+        @rst
+            Fill the kinematic histograms straight from the branch arrays of one event of an ntuple, without building an ``xAH::Particle`` per object. The arrays hold ``nParticles`` entries in the units of the ntuple, ordered like the container that was written. ``mOrE`` is the mass branch, or the energy branch if ``useMass`` is ``false``, matching the ``useMass`` setting of :cpp:class:`xAH::ParticleContainer`.
+
+            Only the histograms booked here (the basic, ``kinematic`` and ``NLeading`` ones) are filled, the object specific details of the derived classes need the object overloads.
+
+        @endrst
+     */
+    StatusCode execute( unsigned int nParticles, const float* pt, const float* eta, const float* phi, const float* mOrE, float eventWeight, bool useMass = true );
+
+    /**
+        @rst
+            Same as above for a batch of ``nEvents`` events stored back to back. The particles of event ``i`` are the entries ``[offsets[i], offsets[i+1])`` of the arrays, so ``offsets`` holds ``nEvents+1`` entries, and ``eventWeights[i]`` is the weight of event ``i``.
+
+        @endrst
+     */
+    StatusCode execute( unsigned int nEvents, const unsigned int* offsets, const float* pt, const float* eta, const float* phi, const float* mOrE, const float* eventWeights, bool useMass = true );
+
+    /// @brief Convenience for the ``std::vector<float>`` branches of the ntuples
+    StatusCode execute( const std::vector<float>& pt, const std::vector<float>& eta, const std::vector<float>& phi, const std::vector<float>& mOrE, float eventWeight, bool useMass = true );
+
     using HistogramManager::book; // make other overloaded version of book() to show up in subclass
     using HistogramManager::execute; // overload
 
@@ -38,6 +60,28 @@ class IParticleHists : public HistogramManager
     HelperClasses::IParticleInfoSwitch* m_infoSwitch;
 
   private:
+    /// @brief Kinematics of one particle in GeV, computed once and shared by the inclusive and the leading-N histograms
+    struct Kinematics {
+      double pt, eta, phi, m, e, rapidity;
+      double px, py, pz, et;
+    };
+    /// @brief Kinematics of the leading particles computed by the object execute() while the xAOD container execute() loops over them
+    struct LeadingCache {
+      const IParticleHists* owner;
+      unsigned int nLeading;
+      std::vector< std::pair<const xAOD::IParticle*, Kinematics> > entries;
+    };
+    /// @brief The cache of the container execute() running in this thread, if any
+    static LeadingCache*& leadingCache();
+
+    static Kinematics kinematics( const xAOD::IParticle* particle );
+    static Kinematics kinematics( const TLorentzVector& p4 );
+    void fillInclusive( const Kinematics& kin, float eventWeight );
+    void fillLeading( const Kinematics& kin, float eventWeight, unsigned int iLeading );
+
+    /// @brief Fill the basic and kinematic histograms of one particle given in ntuple units
+    void fillColumnar( double pt, double eta, double phi, double mOrE, bool useMass, float eventWeight, int iLeading );
+
     std::string m_prefix;
     std::string m_title;
 
@@ -59,6 +103,17 @@ class IParticleHists : public HistogramManager
     TH1F* m_Et;                  //!
     TH1F* m_Et_m;                //!
     TH1F* m_Et_s;                //!
+    // the histograms filled through fillBuffered, resolved once, and the binnings of pt and et, filled together
+    FillSlot m_EtaSlot;          //!
+    FillSlot m_PhiSlot;          //!
+    FillSlot m_MSlot;            //!
+    FillSlot m_ESlot;            //!
+    FillSlot m_RapiditySlot;     //!
+    FillSlot m_PxSlot;           //!
+    FillSlot m_PySlot;           //!
+    FillSlot m_PzSlot;           //!
+    MultiBinning m_PtBinnings;   //!
+    MultiBinning m_EtBinnings;   //!
 
     //NLeadingParticles
     std::vector< TH1F* > m_NPt_l;       //!
@@ -75,6 +130,8 @@ class IParticleHists : public HistogramManager
     std::vector< TH1F* > m_NEt;       //!
     std::vector< TH1F* > m_NEt_m;       //!
     std::vector< TH1F* > m_NEt_s;       //!
+    std::vector< MultiBinning > m_NPtBinnings; //!
+    std::vector< MultiBinning > m_NEtBinnings; //!
 };
 
 
@@ -90,24 +147,7 @@ StatusCode IParticleHists::execute( const xAH::ParticleContainer<T_PARTICLE, T_I
   if( m_infoSwitch->m_numLeading > 0){
     int numParticles = std::min( m_infoSwitch->m_numLeading, (int)particles->size() );
     for(int iParticle=0; iParticle < numParticles; ++iParticle){
-      const TLorentzVector& partP4 = particles->at(iParticle).p4;
-
-      m_NPt_l.at(iParticle)->        Fill( partP4.Pt(),   eventWeight);
-      m_NPt.at(iParticle)->        Fill( partP4.Pt(),   eventWeight);
-      m_NPt_m.at(iParticle)->        Fill( partP4.Pt(),   eventWeight);
-      m_NPt_s.at(iParticle)->        Fill( partP4.Pt(),   eventWeight);
-      m_NEta.at(iParticle)->       Fill( partP4.Eta(),      eventWeight);
-      m_NPhi.at(iParticle)->       Fill( partP4.Phi(),      eventWeight);
-      m_NM.at(iParticle)->         Fill( partP4.M(),    eventWeight);
-      m_NE.at(iParticle)->         Fill( partP4.E(),    eventWeight);
-      m_NRapidity.at(iParticle)->  Fill( partP4.Rapidity(), eventWeight);
-
-      if(m_infoSwitch->m_kinematic){
-	m_NEt  .at(iParticle)->        Fill( partP4.Et(),   eventWeight);
-	m_NEt_m.at(iParticle)->        Fill( partP4.Et(),   eventWeight);
-	m_NEt_s.at(iParticle)->        Fill( partP4.Et(),   eventWeight);
-      }
-
+      fillLeading( kinematics( particles->at(iParticle).p4 ), eventWeight, iParticle );
     }
   }
 
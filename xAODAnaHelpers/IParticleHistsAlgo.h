@@ -9,6 +9,7 @@
 #include <xAODAnaHelpers/IParticleHists.h>
 #include <xAODAnaHelpers/HelperFunctions.h>
 #include <xAODAnaHelpers/HelperClasses.h>
+#include <xAODAnaHelpers/SystematicBlock.h>
 
 class IParticleHistsAlgo : public xAH::Algorithm
 {
@@ -26,10 +27,39 @@ public:
   std::string m_histPrefix;
   /** Histogram xaxis title when using IParticleHistsAlgo directly */
   std::string m_histTitle;
+  /** Number of values buffered per histogram before filling, for the histograms filled through HistogramManager::fillBuffered. The default of 0 fills immediately. */
+  unsigned int m_fillBufferSize = 0;
+  /**
+      @rst
+          Do not book a full set of histograms for every systematic variation of the input. Only the nominal gets the histograms of :cpp:member:`IParticleHistsAlgo::m_detailStr`, the variations fill one dense block (variation :math:`\times` bin) per basic observable (``Pt``, ``Eta``, ``Phi``, ``Mass``), written at the end of the job as a ``TH2F`` named ``<m_name>_systematics/<observable>`` with one labelled y bin per variation. The memory then grows with bins :math:`\times` variations, without one ``TH1`` per observable and variation.
+
+      @endrst
+  */
+  bool m_systematicsBlock = false;
+  /**
+      @rst
+          Book the full set of histograms for every systematic variation as usual, but write every one-dimensional histogram of the variations packed into one ``TH2F`` per observable, named ``<m_name>_packed/<histogram>``, with one labelled y bin per variation (the first, ``nominal``, included). The nominal histograms are written unchanged, as are the multi-dimensional histograms and profiles of all the variations. The number of keys in the output then no longer grows with the number of systematics, which keeps ``hadd`` and reading the file cheap. See :cpp:func:`HistogramManager::packVariations`.
+
+          Unlike :cpp:member:`IParticleHistsAlgo::m_systematicsBlock` this keeps all the histograms of :cpp:member:`IParticleHistsAlgo::m_detailStr` for the variations, and the memory they take during the job.
+
+      @endrst
+  */
+  bool m_packSystematics = false;
 
 private:
   std::map< std::string, IParticleHists* > m_plots; //!
 
+  /// @brief blocks of :cpp:member:`IParticleHistsAlgo::m_systematicsBlock`, and the variations in the order of their y bins
+  std::vector< xAH::SystematicBlock > m_systBlocks; //!
+  std::vector< std::string > m_systBlockNames; //!
+  std::map< std::string, unsigned int > m_systBlockIndex; //!
+
+  /// @brief Fill the particles of a systematic variation into the blocks of :cpp:member:`IParticleHistsAlgo::m_systematicsBlock`
+  void fillSystematicBlocks( const std::string& systName, const xAOD::IParticleContainer* particles, float eventWeight );
+
+  /// @brief Write the histograms of all the variations as :cpp:member:`IParticleHistsAlgo::m_packSystematics` describes
+  void packSystematics();
+
   // variables that don't get filled at submission time should be
   // protected from being send from the submission node to the worker
   // node (done by the //!)
@@ -104,7 +134,11 @@ public:
       // loop over systematics
       for( auto systName : *systNames ) {
 	ANA_CHECK( HelperFunctions::retrieve(inParticles, m_inContainerName+systName, m_event, m_store, msg()) );
-	if( m_plots.find( systName ) == m_plots.end() ) { this->AddHists( systName ); }
+	if( m_systematicsBlock && !systName.empty() ) {
+	  fillSystematicBlocks( systName, inParticles, eventWeight );
+	  continue;
+	}
+	if( m_plots.find( systName ) == m_plots.end() ) { ANA_CHECK( this->AddHists( systName ) ); }
 	ANA_CHECK( static_cast<HIST_T*>(m_plots[systName])->execute( inParticles, eventWeight, eventInfo ));
       }
     }
@@ -134,9 +168,13 @@ public:
     fullname += name; // add systematic
     HIST_T* particleHists = new HIST_T( fullname, m_detailStr ); // add systematic
     particleHists->m_debug = msgLvl(MSG::DEBUG);
+    particleHists->setFillBufferSize(m_fillBufferSize);
+    particleHists->setPackedOutput( m_packSystematics && !name.empty() );
     ANA_CHECK( particleHists->initialize());
     particleHists->record( wk() );
     m_plots[name] = particleHists;
+    ANA_CHECK( addHistMemory( *particleHists ));
+    addCheckpoint( particleHists );
 
     return EL::StatusCode::SUCCESS;
   }
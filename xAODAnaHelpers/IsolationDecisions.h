@@ -0,0 +1,51 @@
+#ifndef xAODAnaHelpers_IsolationDecisions_H
+#define xAODAnaHelpers_IsolationDecisions_H
+
+#include <AthContainers/AuxElement.h>
+#include <PATCore/TAccept.h>
+
+#include <string>
+#include <vector>
+
+namespace xAH {
+
+  /**
+      @rst
+          Turns the ``TAccept`` returned by ``CP::IsolationSelectionTool::accept()``, which holds the decisions of all the configured working points, into the ``isIsolated_<WP>`` decorations of the object (and their bits of :cpp:any:`xAH::SelectionFlags`) and the decision of the working point cut on.
+
+          The decorators are created once and the position of each working point in the ``TAccept`` is looked up once, so decorating an object needs no string operations::
+
+              // in initialize()
+              m_isoDecisions.setWPs(m_IsoKeys, m_MinIsoWPCut);
+
+              // for each object
+              if ( !m_isoDecisions.decorate( *electron, m_isolationSelectionTool_handle->accept( *electron ) ) ) return 0;
+
+      @endrst
+   */
+  class IsolationDecisions {
+    public:
+      /**
+          @brief Set the working points to decorate and the one to cut on
+          @param wps    the working points configured in the tool, decorated as ``isIsolated_<WP>``
+          @param cutWP  the working point to cut on, no cut if empty
+       */
+      void setWPs(const std::vector<std::string>& wps, const std::string& cutWP);
+
+      /// @brief Decorate ``obj`` with the decision of each working point, returns the decision of the working point cut on (``true`` if there is none)
+      bool decorate(const SG::AuxElement& obj, const Root::TAccept& accept);
+
+    private:
+      std::vector<std::string> m_wps;
+      std::vector< SG::AuxElement::Decorator<char> > m_decorators;
+      std::vector<int> m_flagBits;
+      std::string m_cutWP;
+
+      /// @brief Positions in the ``TAccept``, found from the first one seen
+      std::vector<unsigned int> m_positions;
+      unsigned int m_cutPosition = 0;
+      bool m_hasPositions = false;
+  };
+
+}
+#endif
@@ -0,0 +1,226 @@
+#ifndef xAODAnaHelpers_JaggedBranch_H
+#define xAODAnaHelpers_JaggedBranch_H
+
+#include <TTree.h>
+
+#include <string>
+#include <vector>
+
+namespace xAH
+{
+
+  /**
+      @rst
+          Output buffer for a variable-length quantity per object, e.g. one value per track of each jet.
+
+          In the default (nested) layout it is written as a single ``std::vector<std::vector<T> >`` branch ``<name>``. In the flat layout it is written as two branches instead:
+
+          ============= ===================== ==============================================
+          Branch        Type                  Content
+          ============= ===================== ==============================================
+          ``<name>``    ``std::vector<T>``    values of all objects of the event, concatenated
+          ``<name>_n``  ``std::vector<int>``  number of values of each object
+          ============= ===================== ==============================================
+
+          The flat layout does not allocate an inner vector per object and event, streams faster, and is read directly as a jagged array by columnar tools. When reading, the layout is picked up from the branches present in the tree.
+
+      @endrst
+   */
+  template <typename T>
+  class JaggedBranch
+  {
+  public:
+    JaggedBranch(bool flat = false) :
+      m_flat(flat),
+      m_nested(new std::vector<std::vector<T> >()),
+      m_values(new std::vector<T>()),
+      m_counts(new std::vector<int>())
+    {}
+
+    ~JaggedBranch()
+    {
+      delete m_nested;
+      delete m_values;
+      delete m_counts;
+    }
+
+    JaggedBranch(const JaggedBranch&) = delete;
+    JaggedBranch& operator=(const JaggedBranch&) = delete;
+
+    /// @brief Whether the flat layout is used
+    bool flat() const { return m_flat; }
+
+    /// @brief Book the output branch(es) called ``name``
+    void setBranches(TTree* tree, const std::string& name)
+    {
+      if(m_flat){
+        tree->Branch(name.c_str(),          m_values);
+        tree->Branch((name+"_n").c_str(),   m_counts);
+      } else {
+        tree->Branch(name.c_str(),          m_nested);
+      }
+    }
+
+    /// @brief Connect to the branch(es) called ``name`` of an input tree, in whichever layout they were written
+    void connect(TTree* tree, const std::string& name)
+    {
+      const std::string countName = name+"_n";
+      m_flat = tree->GetBranch(countName.c_str()) != nullptr;
+
+      if(m_flat){
+        tree->SetBranchStatus  (name.c_str()     , 1);
+        tree->SetBranchAddress (name.c_str()     , &m_values);
+        tree->SetBranchStatus  (countName.c_str(), 1);
+        tree->SetBranchAddress (countName.c_str(), &m_counts);
+      } else if(tree->GetBranch(name.c_str())) {
+        tree->SetBranchStatus  (name.c_str()     , 1);
+        tree->SetBranchAddress (name.c_str()     , &m_nested);
+      }
+      m_offsetsValid = false;
+    }
+
+    /// @brief Forget the offsets of the objects in the flat layout, whenever an entry was read into the branch buffers
+    void entryLoaded() { m_offsetsValid = false; }
+
+    void clear()
+    {
+      m_offsetsValid = false;
+      if(m_flat){
+        m_values->clear();
+        m_counts->clear();
+      } else {
+        m_nested->clear();
+      }
+    }
+
+    /// @brief Copy the content of the current event of ``other``, which must use the same layout
+    void copyFrom(const JaggedBranch& other)
+    {
+      m_offsetsValid = false;
+      if(m_flat){
+        *m_values = *other.m_values;
+        *m_counts = *other.m_counts;
+      } else {
+        *m_nested = *other.m_nested;
+      }
+    }
+
+    /// @brief Make room for the entries of ``nObjects`` objects (the values of the flat layout grow to their own high-water mark, as ``clear()`` keeps the capacity)
+    void reserve(std::size_t nObjects)
+    {
+      if(m_flat) m_counts->reserve(nObjects);
+      else       m_nested->reserve(nObjects);
+    }
+
+    /// @brief Start the (empty) entry of the next object
+    void newEntry()
+    {
+      m_offsetsValid = false;
+      if(m_flat) m_counts->push_back(0);
+      else       m_nested->emplace_back();
+    }
+
+    /// @brief Append a value to the entry of the last object
+    void fill(const T& value)
+    {
+      m_offsetsValid = false;
+      if(m_flat){
+        m_values->push_back(value);
+        ++m_counts->back();
+      } else {
+        m_nested->back().push_back(value);
+      }
+    }
+
+    /// @brief Add the entry of the next object
+    void push_back(const std::vector<T>& values)
+    {
+      m_offsetsValid = false;
+      if(m_flat){
+        m_values->insert(m_values->end(), values.begin(), values.end());
+        m_counts->push_back(values.size());
+      } else {
+        m_nested->push_back(values);
+      }
+    }
+
+    /// @brief Apply ``f`` to every value of the current event in place, in either layout
+    template <typename F>
+    void transform(F f)
+    {
+      if(m_flat){
+        for(T& value : *m_values) value = f(value);
+      } else {
+        for(auto& values : *m_nested)
+          for(T& value : values) value = f(value);
+      }
+    }
+
+    /// @brief Number of objects in the current event
+    std::size_t size() const
+    { return m_flat ? m_counts->size() : m_nested->size(); }
+
+    /// @brief View of the values of one object, pointing into the branch buffers
+    struct Span
+    {
+      const T* first;
+      const T* last;
+
+      const T* begin() const { return first; }
+      const T* end() const { return last; }
+      std::size_t size() const { return last - first; }
+      const T& operator[](std::size_t i) const { return first[i]; }
+    };
+
+    /// @brief The values of object ``idx``, without copying them (valid until the next entry is read)
+    Span span(std::size_t idx) const
+    {
+      if(!m_flat){
+        const std::vector<T>& values = m_nested->at(idx);
+        return Span{values.data(), values.data() + values.size()};
+      }
+
+      const std::vector<std::size_t>& offsets = this->offsets();
+      const T* data = m_values->data();
+      return Span{data + offsets.at(idx), data + offsets.at(idx+1)};
+    }
+
+    /// @brief Number of values of object ``idx``, without copying them
+    std::size_t count(std::size_t idx) const
+    { return m_flat ? static_cast<std::size_t>(m_counts->at(idx)) : m_nested->at(idx).size(); }
+
+    /// @brief The values of object ``idx``, as a copy (prefer span() when the values are only read)
+    std::vector<T> at(std::size_t idx) const
+    {
+      if(!m_flat) return m_nested->at(idx);
+
+      const Span values = span(idx);
+      return std::vector<T>(values.begin(), values.end());
+    }
+
+  private:
+    /// @brief Where the values of each object start in the flat layout, and the total as last element, computed once per entry
+    const std::vector<std::size_t>& offsets() const
+    {
+      if(!m_offsetsValid){
+        m_offsets.resize(m_counts->size() + 1);
+        m_offsets[0] = 0;
+        for(std::size_t i = 0; i < m_counts->size(); ++i) m_offsets[i+1] = m_offsets[i] + (*m_counts)[i];
+        m_offsetsValid = true;
+      }
+      return m_offsets;
+    }
+
+    bool m_flat;
+
+    // the branch addresses, so these stay pointers
+    std::vector<std::vector<T> >* m_nested;
+    std::vector<T>*               m_values;
+    std::vector<int>*             m_counts;
+
+    mutable std::vector<std::size_t> m_offsets;
+    mutable bool                     m_offsetsValid = false;
+  };
+
+}//xAH
+#endif // xAODAnaHelpers_JaggedBranch_H
@@ -2,6 +2,7 @@
 #define xAODAnaHelpers_Jet_H
 
 #include "xAODAnaHelpers/Particle.h"
+#include "xAODAnaHelpers/FeatureBlock.h"
 #include "xAODAnaHelpers/MuonContainer.h"
 
 
@@ -77,178 +78,185 @@ namespace xAH {
       //JVC
       float JVC;
 
-      // flavTag
-      float SV0;
-      float SV1;
-      float IP3D;
-      float SV1IP3D;
-      float COMBx;
-      float MV1;
-      float MV2c00;
-      float MV2c10;
-      float MV2c10mu;
-      float MV2c10rnn;
-      float MV2rmu;
-      float MV2r;
-      float MV2c20;
-      float MV2c100;
-      float DL1;
-      float DL1_pu;
-      float DL1_pc;
-      float DL1_pb;
-      float DL1mu;
-      float DL1mu_pu;
-      float DL1mu_pc;
-      float DL1mu_pb;
-      float DL1rnn;
-      float DL1rnn_pu;
-      float DL1rnn_pc;
-      float DL1rnn_pb;
-      float DL1rmu;
-      float DL1rmu_pu;
-      float DL1rmu_pc;
-      float DL1rmu_pb;
-      float DL1r;
-      float DL1r_pu;
-      float DL1r_pc;
-      float DL1r_pb;
-      int  HadronConeExclTruthLabelID;
-      int  HadronConeExclExtendedTruthLabelID;
-
-      float vtxOnlineValid;
-      float vtxHadDummy;
-      
-      float bs_online_vx;
-      float bs_online_vy;
-      float bs_online_vz;
+      /// @brief Flavour tagging information, filled with the ``flavorTag``, ``flavorTagHLT``, ``jetFitterDetails``, ``svDetails`` and ``ipDetails`` details
+      struct FlavorTag
+      {
+        float SV0;
+        float SV1;
+        float IP3D;
+        float SV1IP3D;
+        float COMBx;
+        float MV1;
+        float MV2c00;
+        float MV2c10;
+        float MV2c10mu;
+        float MV2c10rnn;
+        float MV2rmu;
+        float MV2r;
+        float MV2c20;
+        float MV2c100;
+        float DL1;
+        float DL1_pu;
+        float DL1_pc;
+        float DL1_pb;
+        float DL1mu;
+        float DL1mu_pu;
+        float DL1mu_pc;
+        float DL1mu_pb;
+        float DL1rnn;
+        float DL1rnn_pu;
+        float DL1rnn_pc;
+        float DL1rnn_pb;
+        float DL1rmu;
+        float DL1rmu_pu;
+        float DL1rmu_pc;
+        float DL1rmu_pb;
+        float DL1r;
+        float DL1r_pu;
+        float DL1r_pc;
+        float DL1r_pb;
+        int  HadronConeExclTruthLabelID;
+        int  HadronConeExclExtendedTruthLabelID;
 
-      float vtx_offline_x0;
-      float vtx_offline_y0;
-      float vtx_offline_z0;
-    
-      float vtx_online_x0;
-      float vtx_online_y0;
-      float vtx_online_z0;
+        float vtxOnlineValid;
+        float vtxHadDummy;
 
-      float vtx_online_bkg_x0;
-      float vtx_online_bkg_y0;
-      float vtx_online_bkg_z0;
-    
-      float JetFitter_nVTX           ;
-      float JetFitter_nSingleTracks  ;
-      float JetFitter_nTracksAtVtx   ;
-      float JetFitter_mass           ;
-      float JetFitter_energyFraction ;
-      float JetFitter_significance3d ;
-      float JetFitter_deltaeta       ;
-      float JetFitter_deltaphi       ;
-      float JetFitter_N2Tpar         ;
-    
-      float sv0_NGTinSvx  ;
-      float sv0_N2Tpair   ;
-      float sv0_massvx    ;
-      float sv0_efracsvx  ;
-      float sv0_normdist  ;
-      float sv1_pu        ;
-      float sv1_pb        ;
-      float sv1_pc        ;
-      float sv1_c         ;
-      float sv1_cu        ;
-      float sv1_NGTinSvx  ;
-      float sv1_N2Tpair   ;
-      float sv1_massvx    ;
-      float sv1_efracsvx  ;
-      float sv1_normdist  ;
-      float sv1_Lxy       ;
-      float sv1_sig3d     ;
-      float sv1_L3d       ;
-      float sv1_distmatlay;
-      float sv1_dR        ;
-    
-      float IP2D_pu     ;
-      float IP2D_pb     ;
-      float IP2D_pc     ;
-      float IP2D        ;
-      float IP2D_c      ;
-      float IP2D_cu     ;
-      float nIP2DTracks ;
-    
-      std::vector<float> IP2D_gradeOfTracks         ;
-      std::vector<float> IP2D_flagFromV0ofTracks    ;
-      std::vector<float> IP2D_valD0wrtPVofTracks    ;
-      std::vector<float> IP2D_sigD0wrtPVofTracks    ;
-      std::vector<float> IP2D_weightBofTracks       ;
-      std::vector<float> IP2D_weightCofTracks       ;
-      std::vector<float> IP2D_weightUofTracks       ;
-    
-      float IP3D_pu     ;
-      float IP3D_pb     ;
-      float IP3D_pc     ;
-      float IP3D_c      ;
-      float IP3D_cu     ;
-      float nIP3DTracks ;
-    
-      std::vector<float> IP3D_gradeOfTracks      ;
-      std::vector<float> IP3D_flagFromV0ofTracks ;
-      std::vector<float> IP3D_valD0wrtPVofTracks ;
-      std::vector<float> IP3D_sigD0wrtPVofTracks ;
-      std::vector<float> IP3D_valZ0wrtPVofTracks ;
-      std::vector<float> IP3D_sigZ0wrtPVofTracks ;
-      std::vector<float> IP3D_weightBofTracks    ;
-      std::vector<float> IP3D_weightCofTracks    ;
-      std::vector<float> IP3D_weightUofTracks    ;
-
-      // jetBTag
-      int is_DL1_FixedCutBEff_60;
-      std::vector<float> SF_DL1_FixedCutBEff_60;
-      int is_DL1_FixedCutBEff_70;
-      std::vector<float> SF_DL1_FixedCutBEff_70;
-      int is_DL1_FixedCutBEff_77;
-      std::vector<float> SF_DL1_FixedCutBEff_77;
-      int is_DL1_FixedCutBEff_85;
-      std::vector<float> SF_DL1_FixedCutBEff_85;
-      
-      int is_DL1r_FixedCutBEff_60;
-      std::vector<float> SF_DL1r_FixedCutBEff_60;
-      int is_DL1r_FixedCutBEff_70;
-      std::vector<float> SF_DL1r_FixedCutBEff_70;
-      int is_DL1r_FixedCutBEff_77;
-      std::vector<float> SF_DL1r_FixedCutBEff_77;
-      int is_DL1r_FixedCutBEff_85;
-      std::vector<float> SF_DL1r_FixedCutBEff_85;
-
-      int is_DL1rmu_FixedCutBEff_60;
-      std::vector<float> SF_DL1rmu_FixedCutBEff_60;
-      int is_DL1rmu_FixedCutBEff_70;
-      std::vector<float> SF_DL1rmu_FixedCutBEff_70;
-      int is_DL1rmu_FixedCutBEff_77;
-      std::vector<float> SF_DL1rmu_FixedCutBEff_77;
-      int is_DL1rmu_FixedCutBEff_85;
-      std::vector<float> SF_DL1rmu_FixedCutBEff_85;
-
-      int is_MV2c10_FixedCutBEff_60;
-      std::vector<float> SF_MV2c10_FixedCutBEff_60;
-      int is_MV2c10_FixedCutBEff_70;
-      std::vector<float> SF_MV2c10_FixedCutBEff_70;
-      int is_MV2c10_FixedCutBEff_77;
-      std::vector<float> SF_MV2c10_FixedCutBEff_77;
-      int is_MV2c10_FixedCutBEff_85;
-      std::vector<float> SF_MV2c10_FixedCutBEff_85;
-
-      // Continuous
-      int is_MV2c10_Continuous;
-      std::vector<float> SF_MV2c10_Continuous;
-      std::vector<float> inEffSF_MV2c10_Continuous;
-      int is_DL1_Continuous;
-      std::vector<float> SF_DL1_Continuous;
-      std::vector<float> inEffSF_DL1_Continuous;
-      int is_DL1r_Continuous;
-      std::vector<float> SF_DL1r_Continuous;
-      std::vector<float> inEffSF_DL1r_Continuous;
-      int is_DL1rmu_Continuous;
-      std::vector<float> SF_DL1rmu_Continuous;
-      std::vector<float> inEffSF_DL1rmu_Continuous;
+        float bs_online_vx;
+        float bs_online_vy;
+        float bs_online_vz;
+
+        float vtx_offline_x0;
+        float vtx_offline_y0;
+        float vtx_offline_z0;
+
+        float vtx_online_x0;
+        float vtx_online_y0;
+        float vtx_online_z0;
+
+        float vtx_online_bkg_x0;
+        float vtx_online_bkg_y0;
+        float vtx_online_bkg_z0;
 
+        float JetFitter_nVTX           ;
+        float JetFitter_nSingleTracks  ;
+        float JetFitter_nTracksAtVtx   ;
+        float JetFitter_mass           ;
+        float JetFitter_energyFraction ;
+        float JetFitter_significance3d ;
+        float JetFitter_deltaeta       ;
+        float JetFitter_deltaphi       ;
+        float JetFitter_N2Tpar         ;
+
+        float sv0_NGTinSvx  ;
+        float sv0_N2Tpair   ;
+        float sv0_massvx    ;
+        float sv0_efracsvx  ;
+        float sv0_normdist  ;
+        float sv1_pu        ;
+        float sv1_pb        ;
+        float sv1_pc        ;
+        float sv1_c         ;
+        float sv1_cu        ;
+        float sv1_NGTinSvx  ;
+        float sv1_N2Tpair   ;
+        float sv1_massvx    ;
+        float sv1_efracsvx  ;
+        float sv1_normdist  ;
+        float sv1_Lxy       ;
+        float sv1_sig3d     ;
+        float sv1_L3d       ;
+        float sv1_distmatlay;
+        float sv1_dR        ;
+
+        float IP2D_pu     ;
+        float IP2D_pb     ;
+        float IP2D_pc     ;
+        float IP2D        ;
+        float IP2D_c      ;
+        float IP2D_cu     ;
+        float nIP2DTracks ;
+
+        std::vector<float> IP2D_gradeOfTracks         ;
+        std::vector<float> IP2D_flagFromV0ofTracks    ;
+        std::vector<float> IP2D_valD0wrtPVofTracks    ;
+        std::vector<float> IP2D_sigD0wrtPVofTracks    ;
+        std::vector<float> IP2D_weightBofTracks       ;
+        std::vector<float> IP2D_weightCofTracks       ;
+        std::vector<float> IP2D_weightUofTracks       ;
+
+        float IP3D_pu     ;
+        float IP3D_pb     ;
+        float IP3D_pc     ;
+        float IP3D_c      ;
+        float IP3D_cu     ;
+        float nIP3DTracks ;
+
+        std::vector<float> IP3D_gradeOfTracks      ;
+        std::vector<float> IP3D_flagFromV0ofTracks ;
+        std::vector<float> IP3D_valD0wrtPVofTracks ;
+        std::vector<float> IP3D_sigD0wrtPVofTracks ;
+        std::vector<float> IP3D_valZ0wrtPVofTracks ;
+        std::vector<float> IP3D_sigZ0wrtPVofTracks ;
+        std::vector<float> IP3D_weightBofTracks    ;
+        std::vector<float> IP3D_weightCofTracks    ;
+        std::vector<float> IP3D_weightUofTracks    ;
+      };
+      xAH::FeatureBlock<FlavorTag> flavorTag;
+
+      /// @brief Working point decisions and scale factors, filled with the ``jetBTag`` and ``jetBTagCts`` details, see :cpp:func:`is_btag` and :cpp:func:`SF_btag`
+      struct BTag
+      {
+        int is_DL1_FixedCutBEff_60;
+        std::vector<float> SF_DL1_FixedCutBEff_60;
+        int is_DL1_FixedCutBEff_70;
+        std::vector<float> SF_DL1_FixedCutBEff_70;
+        int is_DL1_FixedCutBEff_77;
+        std::vector<float> SF_DL1_FixedCutBEff_77;
+        int is_DL1_FixedCutBEff_85;
+        std::vector<float> SF_DL1_FixedCutBEff_85;
+
+        int is_DL1r_FixedCutBEff_60;
+        std::vector<float> SF_DL1r_FixedCutBEff_60;
+        int is_DL1r_FixedCutBEff_70;
+        std::vector<float> SF_DL1r_FixedCutBEff_70;
+        int is_DL1r_FixedCutBEff_77;
+        std::vector<float> SF_DL1r_FixedCutBEff_77;
+        int is_DL1r_FixedCutBEff_85;
+        std::vector<float> SF_DL1r_FixedCutBEff_85;
+
+        int is_DL1rmu_FixedCutBEff_60;
+        std::vector<float> SF_DL1rmu_FixedCutBEff_60;
+        int is_DL1rmu_FixedCutBEff_70;
+        std::vector<float> SF_DL1rmu_FixedCutBEff_70;
+        int is_DL1rmu_FixedCutBEff_77;
+        std::vector<float> SF_DL1rmu_FixedCutBEff_77;
+        int is_DL1rmu_FixedCutBEff_85;
+        std::vector<float> SF_DL1rmu_FixedCutBEff_85;
+
+        int is_MV2c10_FixedCutBEff_60;
+        std::vector<float> SF_MV2c10_FixedCutBEff_60;
+        int is_MV2c10_FixedCutBEff_70;
+        std::vector<float> SF_MV2c10_FixedCutBEff_70;
+        int is_MV2c10_FixedCutBEff_77;
+        std::vector<float> SF_MV2c10_FixedCutBEff_77;
+        int is_MV2c10_FixedCutBEff_85;
+        std::vector<float> SF_MV2c10_FixedCutBEff_85;
+
+        // Continuous
+        int is_MV2c10_Continuous;
+        std::vector<float> SF_MV2c10_Continuous;
+        std::vector<float> inEffSF_MV2c10_Continuous;
+        int is_DL1_Continuous;
+        std::vector<float> SF_DL1_Continuous;
+        std::vector<float> inEffSF_DL1_Continuous;
+        int is_DL1r_Continuous;
+        std::vector<float> SF_DL1r_Continuous;
+        std::vector<float> inEffSF_DL1r_Continuous;
+        int is_DL1rmu_Continuous;
+        std::vector<float> SF_DL1rmu_Continuous;
+        std::vector<float> inEffSF_DL1rmu_Continuous;
+      };
+      xAH::FeatureBlock<BTag> btag;
 
       // truth
       int   ConeTruthLabelID;
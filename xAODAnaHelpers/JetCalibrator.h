@@ -10,6 +10,9 @@
 #ifndef xAODAnaHelpers_JetCalibrator_H
 #define xAODAnaHelpers_JetCalibrator_H
 
+// c++ include(s):
+#include <memory>
+
 // CP interface includes
 #include "PATInterfaces/SystematicRegistry.h"
 #include "PATInterfaces/SystematicSet.h"
@@ -39,6 +42,8 @@
   When considering systematics, a new ``xAOD::JetCollection`` is created for each systematic variation. The names are then saved in a vector for downstream algorithms to use.
 
 @endrst */
+class JetSelector;
+
 class JetCalibrator : public xAH::Algorithm
 {
 public:
@@ -115,6 +120,10 @@ public:
   bool    m_sort = true;
   /// @brief Apply jet cleaning to parent jet
   bool    m_cleanParent = false;
+  /// @brief Systematic variations read the cleaning decisions of the nominal jets instead of re-running the cleaning tools, except those listed in ``m_cleanRecomputeSysts``
+  bool    m_cleanFromNominal = false;
+  /// @brief Comma-separated list of (parts of) systematic names which change the cleaning inputs, these variations are always cleaned again
+  std::string m_cleanRecomputeSysts = "";
   bool    m_applyFatJetPreSel = false;
 
   /// @brief Use large-R jet truth labeling tool (needed for systematics)
@@ -142,6 +151,9 @@ public:
   /// @brief Treat MC as usual, then run the JER uncertainties on it a second time treating it as pseudodata. Overrides m_pseudodata if true.
   bool m_mcAndPseudoData = false;
 
+  /// @brief Record in TStore, under ``HelperFunctions::sameAsNominalName(m_outputAlgo)``, the variations which left every jet of the event identical to nominal so downstream selectors can reuse the nominal result (see ``JetSelector::m_aliasSameAsNominalSysts``)
+  bool m_findSameAsNominalSysts = false;
+
 private:
   /// @brief set to true if systematics asked for and exist
   bool m_runSysts = false; //!
@@ -165,11 +177,44 @@ private:
 
   std::vector<asg::AnaToolHandle<IJetSelector>>  m_AllJetCleaningTool_handles; //!
   std::vector<std::string>  m_decisionNames;    //!
+  /// @brief ``m_cleanRecomputeSysts``, split
+  std::vector<std::string>  m_cleanRecomputeSystList; //!
+  /// @brief The ``clean_pass<decision>`` decorators, one per entry of m_decisionNames
+  std::vector< SG::AuxElement::Decorator<int> > m_cleanPassDecorators; //!
+  /// @brief The nominal jets of this event already carry the cleaning decisions and the original object links
+  bool m_nominalDecorated = false; //!
+  /// @brief The variations of this event which left every jet identical to nominal
+  std::vector<std::string> m_sameAsNominal; //!
+
+  /// @brief The selector run on each variation right after it is calibrated, see ``JetSelector::m_fuseWithCalibrator``
+  JetSelector* m_fusedSelector = nullptr; //!
+
+  /// @brief Per-thread copies of the uncertainties tools for slots ``1..m_systThreads-1``, slot 0 uses the tools above
+  std::vector<asg::AnaToolHandle<ICPJetUncertaintiesTool>> m_JetUncertaintiesTool_clones; //!
+  std::vector<asg::AnaToolHandle<ICPJetUncertaintiesTool>> m_pseudodataJERTool_clones;    //!
+
+  /// @brief A shallow copy of the calibrated jets for one variation, owned until it is recorded to the TStore
+  typedef std::pair< std::unique_ptr<xAOD::JetContainer>, std::unique_ptr<xAOD::ShallowAuxContainer> > VariedJets_t;
 
   // Helper functions
+  /// @brief Finish and record one variation. ``variedJetsSC`` holds the variation when its uncertainties were already applied in the systematic-parallel mode (empty for nominal, which is varied in place)
   EL::StatusCode executeSystematic(const CP::SystematicSet& thisSyst, const xAOD::JetContainer* inJets,
                                    std::pair<xAOD::JetContainer*, xAOD::ShallowAuxContainer*>& calibJetsSC,
-                                   std::vector<std::string>& vecOutContainerNames, bool isPDCopy);
+                                   std::vector<std::string>& vecOutContainerNames, bool isPDCopy,
+                                   VariedJets_t* variedJetsSC = nullptr);
+  /// @brief A shallow copy of ``jets`` for a variation
+  static VariedJets_t copyJets(const xAOD::JetContainer& jets);
+  /**
+      @brief Apply the uncertainty ``thisSyst`` to ``jets``. Does not touch TEvent/TStore, so it can run in parallel.
+      @rst
+          The errors go to ``errors`` when given, for the parallel mode to print them once the threads are done, else they are printed right away.
+
+      @endrst
+   */
+  EL::StatusCode applyUncertainties(const CP::SystematicSet& thisSyst, xAOD::JetContainer& jets,
+                                    asg::AnaToolHandle<ICPJetUncertaintiesTool>& jetUncTool,
+                                    std::vector<std::string>* errors = nullptr);
+  asg::AnaToolHandle<ICPJetUncertaintiesTool>& uncertaintiesTool(bool isPDCopy, unsigned int slot);
   EL::StatusCode initializeUncertaintiesTool(asg::AnaToolHandle<ICPJetUncertaintiesTool>& uncToolHandle, bool isData);
 
 public:
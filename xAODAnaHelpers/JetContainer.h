@@ -37,8 +37,70 @@ namespace xAH {
 //template<typename T>
 //  void setBranch(TTree* tree, std::string varName, std::vector<T>* localVectorPtr);
 
+      /**
+          @rst
+              The blocks of :cpp:func:`FillJet` beyond the kinematics and the planned branches (see ``setPlannedBranch()``), each enabled by one or a few flags of the detail string.
+
+              The flags are looked at once, when the container is created, and folded into a mask of these blocks. For the masks of the detail strings used most often (e.g. ``"kinematic clean energy trackPV"``, with or without ``"flavorTag"``, ``"jetBTag_..."`` and ``"truth"``) the jets are filled by a function compiled for that mask only, in which the disabled blocks are stripped and the enabled ones may be inlined. Any other detail string is filled block by block from the mask at runtime.
+
+          @endrst
+       */
+      enum FillBlock : unsigned int {
+        Rapidity        = 1u << 0,
+        Trigger         = 1u << 1,
+        Scales          = 1u << 2,
+        ConstScaleEta   = 1u << 3,
+        DetectorEta     = 1u << 4,
+        Layer           = 1u << 5,
+        Tracks          = 1u << 6,
+        JVTSFs          = 1u << 7,
+        AllTrack        = 1u << 8,
+        Constituent     = 1u << 9,
+        ConstituentAll  = 1u << 10,
+        FlavorTag       = 1u << 11,
+        BTags           = 1u << 12,
+        Area            = 1u << 13,
+        Truth           = 1u << 14,
+        TruthDetails    = 1u << 15,
+        Charge          = 1u << 16,
+        PassSel         = 1u << 17,
+        PassOR          = 1u << 18
+      };
+
     private:
 
+      typedef void (JetContainer::*FillBlocksFn)( const xAOD::Jet* jet, const xAOD::Vertex* pv, int pvLocation );
+
+      /// @brief Compute :cpp:member:`m_fillBlocks` from the detail string, and pick the fill for it
+      void setFillBlocks();
+      /// @brief Fill the blocks of :cpp:member:`m_fillBlocks`, checked at runtime
+      void fillBlocks( const xAOD::Jet* jet, const xAOD::Vertex* pv, int pvLocation );
+      /// @brief Fill the blocks of ``BLOCKS``, a compile-time :cpp:enum:`FillBlock` mask
+      template<unsigned int BLOCKS> void fillBlocksFixed( const xAOD::Jet* jet, const xAOD::Vertex* pv, int pvLocation );
+
+      void fillRapidity( const xAOD::Jet* jet );
+      void fillTrigger( const xAOD::Jet* jet );
+      void fillScales( const xAOD::Jet* jet );
+      void fillConstScaleEta( const xAOD::Jet* jet );
+      void fillDetectorEta( const xAOD::Jet* jet );
+      void fillLayer( const xAOD::Jet* jet );
+      void fillTracks( const xAOD::Jet* jet, int pvLocation );
+      void fillJVTSFs( const xAOD::Jet* jet );
+      void fillAllTrack( const xAOD::Jet* jet, const xAOD::Vertex* pv );
+      void fillConstituent( const xAOD::Jet* jet );
+      void fillConstituentAll( const xAOD::Jet* jet );
+      void fillFlavorTag( const xAOD::Jet* jet );
+      void fillBTags( const xAOD::Jet* jet );
+      void fillArea( const xAOD::Jet* jet );
+      void fillTruth( const xAOD::Jet* jet );
+      void fillTruthDetails( const xAOD::Jet* jet );
+      void fillCharge( const xAOD::Jet* jet );
+      void fillPassSel( const xAOD::Jet* jet );
+      void fillPassOR( const xAOD::Jet* jet );
+
+      unsigned int m_fillBlocks;
+      FillBlocksFn m_fillBlocksFn;
+
       InDet::InDetTrackSelectionTool * m_trkSelTool;
 
       //
@@ -49,7 +111,7 @@ namespace xAH {
 
       // trigger
       std::vector<int>               *m_isTrigMatched;
-      std::vector<std::vector<int> > *m_isTrigMatchedToChain;
+      xAH::JaggedBranch<int>         *m_isTrigMatchedToChain;
       std::vector<std::string>       *m_listTrigChains;
       
       // clean
@@ -174,11 +236,11 @@ namespace xAH {
 
       // constituent
       std::vector< int >                *m_numConstituents;
-      std::vector< std::vector<float> > *m_constituentWeights;
-      std::vector< std::vector<float> > *m_constituent_pt;
-      std::vector< std::vector<float> > *m_constituent_eta;
-      std::vector< std::vector<float> > *m_constituent_phi;
-      std::vector< std::vector<float> > *m_constituent_e;
+      xAH::JaggedBranch<float> *m_constituentWeights;
+      xAH::JaggedBranch<float> *m_constituent_pt;
+      xAH::JaggedBranch<float> *m_constituent_eta;
+      xAH::JaggedBranch<float> *m_constituent_phi;
+      xAH::JaggedBranch<float> *m_constituent_e;
 
 
       // flavTag
@@ -265,13 +327,13 @@ namespace xAH {
       std::vector<float> *m_IP2D_cu                   ;
       std::vector<float> *m_nIP2DTracks               ;
 
-      std::vector<std::vector<float> > *m_IP2D_gradeOfTracks        ;
-      std::vector<std::vector<float> > *m_IP2D_flagFromV0ofTracks   ;
-      std::vector<std::vector<float> > *m_IP2D_valD0wrtPVofTracks   ;
-      std::vector<std::vector<float> > *m_IP2D_sigD0wrtPVofTracks   ;
-      std::vector<std::vector<float> > *m_IP2D_weightBofTracks      ;
-      std::vector<std::vector<float> > *m_IP2D_weightCofTracks      ;
-      std::vector<std::vector<float> > *m_IP2D_weightUofTracks      ;
+      xAH::JaggedBranch<float>       *m_IP2D_gradeOfTracks        ;
+      xAH::JaggedBranch<float>       *m_IP2D_flagFromV0ofTracks   ;
+      xAH::JaggedBranch<float>       *m_IP2D_valD0wrtPVofTracks   ;
+      xAH::JaggedBranch<float>       *m_IP2D_sigD0wrtPVofTracks   ;
+      xAH::JaggedBranch<float>       *m_IP2D_weightBofTracks      ;
+      xAH::JaggedBranch<float>       *m_IP2D_weightCofTracks      ;
+      xAH::JaggedBranch<float>       *m_IP2D_weightUofTracks      ;
 
       std::vector<float> *m_IP3D_pu                   ;
       std::vector<float> *m_IP3D_pb                   ;
@@ -280,15 +342,15 @@ namespace xAH {
       std::vector<float> *m_IP3D_c                    ;
       std::vector<float> *m_IP3D_cu                   ;
       std::vector<float> *m_nIP3DTracks               ;
-      std::vector<std::vector<float> > *m_IP3D_gradeOfTracks        ;
-      std::vector<std::vector<float> > *m_IP3D_flagFromV0ofTracks   ;
-      std::vector<std::vector<float> > *m_IP3D_valD0wrtPVofTracks   ;
-      std::vector<std::vector<float> > *m_IP3D_sigD0wrtPVofTracks   ;
-      std::vector<std::vector<float> > *m_IP3D_valZ0wrtPVofTracks   ;
-      std::vector<std::vector<float> > *m_IP3D_sigZ0wrtPVofTracks   ;
-      std::vector<std::vector<float> > *m_IP3D_weightBofTracks      ;
-      std::vector<std::vector<float> > *m_IP3D_weightCofTracks      ;
-      std::vector<std::vector<float> > *m_IP3D_weightUofTracks      ;
+      xAH::JaggedBranch<float>       *m_IP3D_gradeOfTracks        ;
+      xAH::JaggedBranch<float>       *m_IP3D_flagFromV0ofTracks   ;
+      xAH::JaggedBranch<float>       *m_IP3D_valD0wrtPVofTracks   ;
+      xAH::JaggedBranch<float>       *m_IP3D_sigD0wrtPVofTracks   ;
+      xAH::JaggedBranch<float>       *m_IP3D_valZ0wrtPVofTracks   ;
+      xAH::JaggedBranch<float>       *m_IP3D_sigZ0wrtPVofTracks   ;
+      xAH::JaggedBranch<float>       *m_IP3D_weightBofTracks      ;
+      xAH::JaggedBranch<float>       *m_IP3D_weightCofTracks      ;
+      xAH::JaggedBranch<float>       *m_IP3D_weightUofTracks      ;
 
       std::vector<float> *m_vtxOnlineValid;
       std::vector<float> *m_vtxHadDummy;
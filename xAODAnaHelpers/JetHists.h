@@ -28,6 +28,9 @@ class JetHists : public IParticleHists
     using HistogramManager::book; // make other overloaded version of book() to show up in subclass
     using IParticleHists::execute; // overload
     virtual void record(EL::IWorker* wk);
+    virtual void snapshot(std::vector<TObject*>& objects);
+    virtual bool merge(const TObject* obj);
+    virtual void reset();
 
   protected:
 
@@ -39,6 +42,26 @@ class JetHists : public IParticleHists
 
   private:
 
+    /// @brief One fill per group of details, run by execute for every jet
+    typedef StatusCode (JetHists::*FillFunction)( const xAOD::Jet* jet, float eventWeight, const xAOD::EventInfo* eventInfo );
+    /// @brief The fills enabled by the detail string, set up in initialize
+    std::vector< FillFunction > m_fillPlan; //!
+
+    StatusCode fillClean( const xAOD::Jet* jet, float eventWeight, const xAOD::EventInfo* eventInfo );
+    StatusCode fillVsActualMu( const xAOD::Jet* jet, float eventWeight, const xAOD::EventInfo* eventInfo );
+    StatusCode fillByAverageMu( const xAOD::Jet* jet, float eventWeight, const xAOD::EventInfo* eventInfo );
+    StatusCode fillEnergy( const xAOD::Jet* jet, float eventWeight, const xAOD::EventInfo* eventInfo );
+    StatusCode fillLayer( const xAOD::Jet* jet, float eventWeight, const xAOD::EventInfo* eventInfo );
+    StatusCode fillTruth( const xAOD::Jet* jet, float eventWeight, const xAOD::EventInfo* eventInfo );
+    StatusCode fillTruthDetails( const xAOD::Jet* jet, float eventWeight, const xAOD::EventInfo* eventInfo );
+    StatusCode fillFlavorTag( const xAOD::Jet* jet, float eventWeight, const xAOD::EventInfo* eventInfo );
+    StatusCode fillResolution( const xAOD::Jet* jet, float eventWeight, const xAOD::EventInfo* eventInfo );
+    StatusCode fillSubstructure( const xAOD::Jet* jet, float eventWeight, const xAOD::EventInfo* eventInfo );
+    StatusCode fillTracksInJet( const xAOD::Jet* jet, float eventWeight, const xAOD::EventInfo* eventInfo );
+    StatusCode fillByEta( const xAOD::Jet* jet, float eventWeight, const xAOD::EventInfo* eventInfo );
+    StatusCode fillOnlineBS( const xAOD::Jet* jet, float eventWeight, const xAOD::EventInfo* eventInfo );
+    StatusCode fillHLTVertex( const xAOD::Jet* jet, float eventWeight, const xAOD::EventInfo* eventInfo );
+
     std::string m_titlePrefix;
     xAH::OnlineBeamSpotTool      m_onlineBSTool;  //!
 
@@ -344,12 +367,12 @@ class JetHists : public IParticleHists
     TProfile*   m_vtxDiffy0_vs_lBlock    ; //!
     TProfile*   m_vtxDiffz0_vs_lBlock    ; //!
 
-    TH2F* m_lumiB_runN; //!
-    TH2F* m_lumiB_runN_vtxClass     ; //!
-    TH2F* m_lumiB_runN_vtxDiffz0    ; //!
-    TH2F* m_lumiB_runN_lumiB        ; //!
-    TH2F* m_lumiB_runN_bs_online_vz ; //!
-    TH2F* m_lumiB_runN_bs_den       ; //!
+    THnSparseF* m_lumiB_runN; //!
+    THnSparseF* m_lumiB_runN_vtxClass     ; //!
+    THnSparseF* m_lumiB_runN_vtxDiffz0    ; //!
+    THnSparseF* m_lumiB_runN_lumiB        ; //!
+    THnSparseF* m_lumiB_runN_bs_online_vz ; //!
+    THnSparseF* m_lumiB_runN_bs_den       ; //!
 
     TProfile*   m_vtx_online_x0_vs_vtx_online_z0; //!
     TProfile*   m_vtx_online_y0_vs_vtx_online_z0; //!
@@ -13,15 +13,22 @@
 #ifndef xAODAnaHelpers_JetSelector_H
 #define xAODAnaHelpers_JetSelector_H
 
+#include <map>
+#include <memory>
+
 // EDM include(s):
 #include "xAODJet/Jet.h"
 #include "xAODJet/JetContainer.h"
+#include "xAODEventInfo/EventInfo.h"
+#include "xAODTracking/VertexContainer.h"
 
 // ROOT include(s):
 #include "TH1D.h"
 
 // algorithm wrapper
 #include "xAODAnaHelpers/Algorithm.h"
+#include "xAODAnaHelpers/ReadHandle.h"
+#include "xAODAnaHelpers/EtaPhiGrid.h"
 
 // external tools include(s):
 #include "AsgTools/AnaToolHandle.h"
@@ -59,6 +66,17 @@ public:
   bool m_decorateSelectedObjects = true;
   /// @brief fill using SG::VIEW_ELEMENTS to be light weight
   bool m_createSelectedContainer = false;
+  /// @brief Reuse the nominal selection for the variations the input algorithm found identical to nominal (see ``JetCalibrator::m_findSameAsNominalSysts``) instead of selecting their jets again
+  bool m_aliasSameAsNominalSysts = false;
+  /**
+    @rst
+      Let the :cpp:class:`JetCalibrator` writing :cpp:member:`JetSelector::m_inContainerName` and :cpp:member:`JetSelector::m_inputAlgo` run this selection on each variation, right after calibrating it, instead of calibrating all the variations first and selecting them all here. The jets of a variation are then selected while they are still in the cache, and the list of variations is not read back from the store. The output (containers, decorations, systematics list, event rejection) is the same as for the two separate steps, and ``execute()`` of this algorithm does nothing.
+
+      Needs :cpp:member:`JetSelector::m_inputAlgo`. The event is rejected already at the end of the calibrator, so algorithms placed between the two do not see the rejected events. The time of the selection is counted in the calibrator.
+
+    @endrst
+  */
+  bool m_fuseWithCalibrator = false;
   /// @brief look at n objects
   int m_nToProcess = -1;
   /// @brief require cleanJet decoration to not be set and false
@@ -90,6 +108,8 @@ public:
   float m_pT_max = 1e8;
   /// @brief require pT > pt_min
   float m_pT_min = 1e8;
+  /// @brief the input jets are expected to be sorted by decreasing pT: once a jet is below m_pT_min, the following ones are rejected without evaluating the other cuts. The ordering is checked on every event, and the jets are evaluated normally if it does not hold. Only used when selecting at the "Final" jet scale.
+  bool m_ptOrderedInput = false;
   /// @brief require ET < ET_max
   float m_ET_max = 1e8;
   /// @brief require ET > ET_min
@@ -247,7 +267,8 @@ public:
   std::string              m_failAuxDecorKeys = "";
 
   /* trigger matching */
-  /** A comma-separated string w/ alll the HLT single jet trigger chains for which you want to perform the matching. If left empty (as it is by default), no trigger matching will be attempted at all */
+  /** A comma-separated string w/ alll the HLT single jet trigger chains for which you want to perform the matching. If left empty (as it is by default), no trigger matching will be attempted at all.
+      The results are stored in the ``trigMatchTestedBitsJet`` and ``isTrigMatchedBitsJet`` decorations (see xAH::TrigMatchBits), not in an ``isTrigMatchedMapJet`` map anymore. */
   std::string    m_singleJetTrigChains = "";
   /** A comma-separated string w/ all the HLT dijet trigger chains for which you want to perform the matching.  If left empty (as it is by default), no trigger matching will be attempted at all */
   std::string    m_diJetTrigChains = "";
@@ -260,6 +281,21 @@ public:
   bool m_sort = false;
 
 private:
+  /// @brief Kinematics, decision and nominal JVT (fJVT) SF of one jet of the nominal input container
+  struct NominalJVTSF {
+    float pt = -1.;
+    float eta = 0.;
+    char  passed = 1;
+    float sf = 1.;
+  };
+  /// @brief The nominal SFs of this event, by jet index, reused for the unchanged jets of the systematically varied containers
+  std::vector<NominalJVTSF> m_nominalJVT;  //!
+  std::vector<NominalJVTSF> m_nominalfJVT; //!
+  /// @brief Take ``sf`` from ``cache`` for the nominal SF of a jet of a varied container which has the nominal kinematics and decision, ``false`` if it has to be computed
+  bool reuseNominalJVTSF( const std::vector<NominalJVTSF>& cache, const xAOD::Jet& jet, bool isNominal, bool nominalSyst, char passed, float& sf ) const;
+  void storeNominalJVTSF( std::vector<NominalJVTSF>& cache, const xAOD::Jet& jet, char passed, float sf ) const;
+
+  int m_passSelBit = -1;  //!  /* the bit of the selection decision in xAH::SelectionFlags */
   int m_numEvent;         //!
   int m_numObject;        //!
   int m_numEventPass;     //!
@@ -297,6 +333,8 @@ private:
 
   std::vector<std::string>            m_singleJetTrigChainsList; //!  /* contains all the HLT trigger chains tokens extracted from m_singleJetTrigChains */
   std::vector<std::string>            m_diJetTrigChainsList;     //!  /* contains all the HLT trigger chains tokens extracted from m_diJetTrigChains */
+  std::vector<unsigned int>           m_singleJetTrigChainsBits; //!  /* the bit of each chain of m_singleJetTrigChainsList in the trigger matching decorations */
+  std::vector<unsigned int>           m_diJetTrigChainsBits;     //!  /* the bit of each chain of m_diJetTrigChainsList in the trigger matching decorations */
   
   asg::AnaToolHandle<CP::IJetJvtEfficiency>  m_JVT_tool_handle{"CP::JetJvtEfficiency/JVT"}; //!
   asg::AnaToolHandle<CP::IJetJvtEfficiency>  m_fJVT_eff_tool_handle{"CP::JetJvtEfficiency/fJVT"}; //!
@@ -311,6 +349,47 @@ private:
   std::string m_outputJVTPassed = "JetJVT_Passed"; //!
   std::string m_outputfJVTPassed = "JetfJVT_Passed"; //!
 
+  /// @brief cached lookups of the containers retrieved on every event
+  xAH::ReadHandle<xAOD::EventInfo>       m_eventInfoHandle; //!
+  xAH::ReadHandle<xAOD::VertexContainer> m_vertexHandle;    //!
+  xAH::ReadHandle<xAOD::JetContainer>    m_inJetsHandle;    //!
+  xAH::ReadHandle<xAOD::JetContainer>    m_truthJetsHandle; //!
+
+  /// @brief the truth jets of the event, for the hard-scatter and pileup labels of :cpp:func:`JetSelector::decorateJvtTruthLabels`
+  xAH::EtaPhiGrid m_truthJetGrid; //!
+  /// @brief the labels of the nominal jets by their index in the calibrated container they point to: ``-1`` not labelled, else ``isJvtHS | isJvtPU << 1``
+  std::vector<signed char> m_jvtTruthLabels; //!
+  /// @brief size of the calibrated container of the nominal jets, the systematic variations with another size are labelled again
+  std::size_t m_jvtTruthLabelsSize = 0; //!
+
+  /// @brief Decorate ``isJvtHS`` and ``isJvtPU``, from the truth jets for the nominal jets and from the nominal labels of the same jets for the systematic variations
+  void decorateJvtTruthLabels( const xAOD::JetContainer* jets, bool isNominal );
+
+  /// @brief State of the loop over the variations of an event, between :cpp:func:`JetSelector::beginEvent` and :cpp:func:`JetSelector::endEvent`
+  struct VariationLoop {
+    float mcEvtWeight = 1.0;
+    /// @brief at least one variation passed
+    bool pass = false;
+    /// @brief fill the cutflow, only for the first variation
+    bool count = true;
+    bool passMCcleaning = true;
+    bool passNominal = false;
+    /// @brief the input lists the variations identical to nominal, and they are reused
+    bool haveSameAsNominal = false;
+    const xAOD::JetContainer* truthJets = nullptr;
+    const xAOD::JetContainer* nominalJets = nullptr;
+    std::unique_ptr< std::vector<std::string> > outContainerNames;
+    std::unique_ptr< std::vector<std::string> > outSameAsNominal;
+  };
+  VariationLoop m_loop; //!
+  /// @brief The selection of the current event was run by the fused calibrator
+  bool m_fusedDone = false; //!
+  /// @brief The selectors with :cpp:member:`JetSelector::m_fuseWithCalibrator`, by input container and systematics list
+  static std::map< std::pair<std::string, std::string>, JetSelector* > s_fusedSelectors; //!
+
+  EL::StatusCode beginEvent( bool haveSameAsNominal );
+  EL::StatusCode endEvent();
+
   // variables that don't get filled at submission time should be
   // protected from being send from the submission node to the worker
   // node (done by the //!)
@@ -337,6 +416,20 @@ public:
   // these are the functions not inherited from Algorithm
   virtual bool executeSelection( const xAOD::JetContainer* inJets, float mcEvtWeight, bool count, std::string outContainerName, bool isNominal );
 
+  /**
+    @rst
+      The selector with :cpp:member:`JetSelector::m_fuseWithCalibrator` reading the variations ``inputAlgo`` of ``inContainerName``, ``nullptr`` if there is none. The calibrator then calls, for every event, :cpp:func:`JetSelector::beginFusedEvent`, :cpp:func:`JetSelector::selectVariation` for each variation in the order of its systematics list, and :cpp:func:`JetSelector::endFusedEvent`.
+
+    @endrst
+  */
+  static JetSelector* fusedSelector( const std::string& inContainerName, const std::string& inputAlgo );
+  /// @brief Start the selection of an event for a fused calibrator, ``haveSameAsNominal`` if it finds the variations identical to nominal
+  EL::StatusCode beginFusedEvent( bool haveSameAsNominal ) { return beginEvent( haveSameAsNominal ); }
+  /// @brief Select the jets of the variation ``systName``, reusing the nominal selection if ``sameAsNominal``
+  EL::StatusCode selectVariation( const xAOD::JetContainer* inJets, const std::string& systName, bool sameAsNominal );
+  /// @brief Record the systematics list of the selection and reject the event if no variation passed
+  EL::StatusCode endFusedEvent();
+
   // added functions not from Algorithm
   // why does this need to be virtual?
   virtual int PassCuts( const xAOD::Jet* jet );
@@ -34,6 +34,10 @@ namespace xAH {
       std::vector<float>* m_l1Jet_et8x8;
       std::vector<float>* m_l1Jet_eta;
       std::vector<float>* m_l1Jet_phi;
+
+      // Scratch space for sorting in FillL1Jets
+      std::vector<float>       m_sortEt;
+      std::vector<std::size_t> m_sortIndex;
     };
 
 }
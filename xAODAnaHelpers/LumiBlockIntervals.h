@@ -0,0 +1,43 @@
+#ifndef xAODAnaHelpers_LumiBlockIntervals_H
+#define xAODAnaHelpers_LumiBlockIntervals_H
+
+#include <cstdint>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+namespace xAH {
+
+  /**
+      @rst
+          The good lumi blocks of a set of runs, stored as one sorted array of disjoint ``[first, last]`` intervals per run.
+
+          Fill it with :cpp:func:`xAH::LumiBlockIntervals::add`, then call :cpp:func:`xAH::LumiBlockIntervals::finalize` to sort and merge the intervals (overlapping ranges from several good run lists are merged, i.e. their union is kept). A lookup is then a hash of the run and a binary search, and the result of the last lumi block is remembered, so consecutive events of the same lumi block need no search at all.
+
+      @endrst
+   */
+  class LumiBlockIntervals {
+    public:
+      /// @brief Add the lumi blocks ``first`` to ``last`` (both included) of ``run``
+      void add(uint32_t run, uint32_t first, uint32_t last);
+
+      /// @brief Sort and merge the intervals, must be called before :cpp:func:`xAH::LumiBlockIntervals::contains`
+      void finalize();
+
+      /// @brief Whether lumi block ``lumiBlock`` of ``run`` is in one of the intervals
+      bool contains(uint32_t run, uint32_t lumiBlock) const;
+
+      /// @brief Number of runs with at least one interval
+      std::size_t nRuns() const { return m_runs.size(); }
+
+    private:
+      std::unordered_map<uint32_t, std::vector<std::pair<uint32_t, uint32_t> > > m_runs;
+
+      mutable bool m_hasLast = false;
+      mutable uint32_t m_lastRun = 0;
+      mutable uint32_t m_lastLumiBlock = 0;
+      mutable bool m_lastResult = false;
+  };
+
+}
+#endif
@@ -2,6 +2,7 @@
 #define xAODAnaHelpers_METConstructor_H
 
 #include <xAODAnaHelpers/Algorithm.h>
+#include <xAODAnaHelpers/SystematicNames.h>
 
 // Infrastructure include(s):
 #include "xAODRootAccess/Init.h"
@@ -16,6 +17,13 @@
 #include "TauAnalysisTools/ITauSelectionTool.h"
 
 #include "PATInterfaces/SystematicRegistry.h"
+
+// EDM include(s):
+#include "AthContainers/ConstDataVector.h"
+#include "xAODEgamma/ElectronContainer.h"
+#include "xAODEgamma/PhotonContainer.h"
+#include "xAODTau/TauJetContainer.h"
+#include "xAODMuon/MuonContainer.h"
 //look at https://twiki.cern.ch/twiki/bin/view/AtlasComputing/SoftwareTutorialxAODAnalysisInROOT
 
 
@@ -126,6 +134,18 @@ private:
   asg::AnaToolHandle<TauAnalysisTools::ITauSelectionTool> m_tauSelTool_handle{"TauAnalysisTools::TauSelectionTool/TauSelectionTool", this}; //!
 
   std::vector<CP::SystematicSet> m_sysList; //!
+  /// @brief interned IDs of the entries in ``m_sysList``, to avoid duplicates without comparing names
+  xAH::SystematicIDSet m_sysListIDs; //!
+
+  /// @brief the objects passing the MET cuts, members so that their memory is reused between systematics and events
+  ConstDataVector<xAOD::ElectronContainer> m_nominalMetElectrons{SG::VIEW_ELEMENTS}; //!
+  ConstDataVector<xAOD::ElectronContainer> m_variedMetElectrons{SG::VIEW_ELEMENTS};  //!
+  ConstDataVector<xAOD::PhotonContainer>   m_nominalMetPhotons{SG::VIEW_ELEMENTS};   //!
+  ConstDataVector<xAOD::PhotonContainer>   m_variedMetPhotons{SG::VIEW_ELEMENTS};    //!
+  ConstDataVector<xAOD::TauJetContainer>   m_nominalMetTaus{SG::VIEW_ELEMENTS};      //!
+  ConstDataVector<xAOD::TauJetContainer>   m_variedMetTaus{SG::VIEW_ELEMENTS};       //!
+  ConstDataVector<xAOD::MuonContainer>     m_nominalMetMuons{SG::VIEW_ELEMENTS};     //!
+  ConstDataVector<xAOD::MuonContainer>     m_variedMetMuons{SG::VIEW_ELEMENTS};      //!
 
   int m_numEvent;         //!
 
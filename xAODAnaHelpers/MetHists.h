@@ -27,17 +27,25 @@ class MetHists : public HistogramManager
 
   private:
 
-    TH1F*   m_metFinalClus      ; //!
-    TH1F*   m_metFinalClusPx    ; //!
-    TH1F*   m_metFinalClusPy    ; //!
-    TH1F*   m_metFinalClusSumEt ; //!
-    TH1F*   m_metFinalClusPhi   ; //!
-
-    TH1F*   m_metFinalTrk       ; //!
-    TH1F*   m_metFinalTrkPx     ; //!
-    TH1F*   m_metFinalTrkPy     ; //!
-    TH1F*   m_metFinalTrkSumEt  ; //!
-    TH1F*   m_metFinalTrkPhi    ; //!
+    /**
+        @brief The term called ``name`` in the container
+        @rst
+            The position of the term is cached in ``index`` and only checked against the name on the following events, the container is searched again when it moved. Returns ``nullptr`` if there is no such term.
+
+        @endrst
+     */
+    static const xAOD::MissingET* findTerm( const xAOD::MissingETContainer* met, const std::string& name, std::size_t& index );
+
+    // the positions of the terms in the container, found on the first event
+    std::size_t m_finalClusIndex; //!
+    std::size_t m_finalTrkIndex;  //!
+
+    /// @brief Declare the histograms of a term, named ``prefix``, ``prefix + "Px"``, ...
+    static void addTermObservables( ObservableTable<xAOD::MissingET>& table, const std::string& prefix );
+
+    // the histograms of the FinalClus and FinalTrk terms
+    ObservableTable<xAOD::MissingET> m_finalClus; //!
+    ObservableTable<xAOD::MissingET> m_finalTrk;  //!
 
 };
 
@@ -3,6 +3,7 @@
 
 // algorithm wrapper
 #include "xAODAnaHelpers/Algorithm.h"
+#include "xAODAnaHelpers/EventIndex.h"
 
 //MetaData
 #include <xAODMetaDataCnv/FileMetaDataTool.h>
@@ -12,6 +13,15 @@
 #include <xAODCutFlow/CutBookkeeperContainer.h>
 #include <xAODCutFlow/CutBookkeeperAuxContainer.h>
 
+#include "xAODBase/IParticleContainer.h"
+
+#include <TH1.h>
+
+#include <map>
+#include <memory>
+#include <string>
+#include <vector>
+
 /**
   @brief Produce xAOD outputs
   @rst
@@ -50,6 +60,39 @@ public:
   /// @brief enable to create the output file for xAOD dumping
   bool m_createOutputFile = true;
 
+  /**
+    @brief compression algorithm of the output file: ``zlib``, ``lzma`` or ``lz4``. Empty keeps the default of the output stream.
+
+    @rst
+      ``lz4`` compresses and decompresses several times faster than ``zlib`` for somewhat larger files, a good choice for intermediate outputs which are read again right away.
+    @endrst
+   */
+  std::string m_outputCompressionAlgorithm = "";
+
+  /// @brief compression level of the output file (1-9), ``-1`` keeps the default of the output stream
+  int m_outputCompressionLevel = -1;
+
+  /// @brief auto-flush setting of the output tree, passed to ``xAOD::TEvent::writeTo``: positive for a number of entries, negative for a number of bytes
+  int m_outputAutoFlush = 200;
+
+  /**
+    @brief number of threads for ROOT's implicit multi-threading, ``0`` leaves it as it is
+
+    @rst
+      With implicit multi-threading the baskets of the output tree are compressed in parallel when they are flushed. This is a process-wide ROOT setting: it applies to every tree of the job, including the input.
+    @endrst
+   */
+  unsigned int m_outputImplicitMTThreads = 0;
+
+  /**
+    @brief write a ``(runNumber, eventNumber)`` to entry index of the output, as the ``EventIndex`` tree of the output file
+
+    @rst
+      See :cpp:class:`xAH::EventIndex`. The entries are the ones of the ``CollectionTree`` of the output, to pick single events out of it without scanning it (e.g. with ``xAOD::TEvent::getEntry``).
+    @endrst
+   */
+  bool m_writeEventIndex = false;
+
   /// @brief copy the file metadata over
   bool m_copyFileMetaData = false;
 
@@ -126,6 +169,10 @@ public:
 
       Always specify your string in a space-delimited format where pairs are split up by ``input container name|output container name``.
 
+      Electron, jet, muon, photon, tau, track particle, truth particle and calorimeter cluster containers are supported.
+
+      If the output container is listed in :cpp:member:`MinixAOD::m_auxItemLists`, only its listed variables are copied.
+
     @endrst
    */
   std::string m_deepCopyKeys = "";
@@ -144,6 +191,47 @@ public:
    */
   std::string m_vectorCopyKeys = "";
 
+  /**
+    @brief auxiliary variables to write for some of the output containers
+
+    @rst
+
+      .. note:: This option is appropriate for trimming the output, typically together with :cpp:member:`MinixAOD::m_shallowCopyKeys` so that a selected or calibrated container is written as a shallow copy of a parent written once, holding only the variables it changes.
+
+      Only the listed variables of the auxiliary store of each container are written, instead of all of them. For a shallow copy these are the variables stored in the shallow copy itself (e.g. the calibrated kinematics and the selection decorations), the others are read through its parent::
+
+          "m_auxItemLists": "SCAntiKt4EMTopoJets|pt.eta.phi.m.passSel SCMuons|pt.passSel"
+
+      Always specify your string in a space-delimited format where pairs are split up by ``container name|dot-separated variable names``. Containers that are not listed keep all their variables. A deep-copied container (:cpp:member:`MinixAOD::m_deepCopyKeys`) only copies the listed variables, unless the list excludes variables (``-``) or has a wildcard (``*``): then all of them are copied, and ``TEvent`` picks the ones to write.
+
+      The ``xAH_primaryVertexLocation`` decoration, with which :cpp:func:`HelperFunctions::getPrimaryVertexLocation` caches its result for the event, is not written for any container, unless it is listed explicitly.
+
+    @endrst
+   */
+  std::string m_auxItemLists = "";
+
+  /**
+    @brief names of lists of systematics in the TStore to write to the output, for reading it back as an object cache
+
+    @rst
+      Space-delimited names of ``std::vector<std::string>`` in the TStore, e.g. the ``m_outputAlgo`` lists of the selectors. They hold the same names at every event, so they are written once, at the end of the job, as the ``xAH_systNames`` tree of the output. An :cpp:class:`ObjectCacheReader` at the start of a chain reading the output puts them back into the TStore, so that the output can stand in for the stages that wrote it (see :ref:`ObjectCache`)::
+
+          "m_cacheSystNames": "JetSelector_Syst MuonSelector_Syst"
+
+    @endrst
+   */
+  std::string m_cacheSystNames = "";
+
+  /**
+    @brief names of output streams of histograms, e.g. the cutflows, to write to the output as filled by the algorithms up to this one
+
+    @rst
+      Space-delimited names of output streams, usually the ``m_cutFlowStreamName`` and ``m_metaDataStreamName`` of :cpp:class:`BasicEventSelection`. Their histograms booked by the algorithms before this one are written to the ``xAH_cacheHists`` directory of the output, with one subdirectory per stream, holding only what these algorithms filled: the fills of the algorithms after this one are told apart event by event. An :cpp:class:`ObjectCacheReader` with the same streams adds them back to its own outputs, so that a job reading the object cache ends up with the same cutflows and event counts as the full chain (see :ref:`ObjectCache`).
+
+    @endrst
+   */
+  std::string m_cacheHistStreams = "";
+
 private:
   /// A vector of containers that are in TEvent that just need to be written to the output
   std::vector<std::string> m_simpleCopyKeys_vec; //!
@@ -157,6 +245,39 @@ private:
   /// A vector of containers (and aux-pairs) in TStore to record in TEvent
   std::vector<std::string> m_copyFromStoreToEventKeys_vec; //!
 
+  /// The lists of :cpp:member:`MinixAOD::m_cacheSystNames`, merged over the events
+  std::map<std::string, std::vector<std::string>> m_cachedSystNames; //!
+
+  /// A histogram of :cpp:member:`MinixAOD::m_cacheHistStreams`: what the algorithms up to this one filled, and its content when the last algorithm after this one was done with the event
+  struct CacheHist {
+    std::string stream;
+    TH1* hist;
+    std::unique_ptr<TH1> upstream;
+    std::unique_ptr<TH1> last;
+  };
+  std::vector<CacheHist> m_cacheHists; //!
+  /// The event at which this algorithm last executed, the algorithms done with it afterwards are the ones after this one
+  Long64_t m_cacheHistEntry = -1; //!
+  const TFile* m_cacheHistFile = nullptr; //!
+  /// Add what was filled since the last snapshot to the upstream histograms
+  void addUpstreamCacheHists();
+  /// Keep the current content of the histograms, called at the end of the algorithms after this one
+  void snapshotCacheHists();
+  void snapshotCacheHist(CacheHist& cacheHist);
+
+public:
+  /// How to deep-copy and record one of the supported container types
+  struct ContainerType;
+private:
+  /// The supported container type ``cont`` is, ``nullptr`` if none
+  static const ContainerType* findContainerType(const xAOD::IParticleContainer* cont);
+  /// The container type of each entry of ``m_deepCopyKeys_vec``, resolved on the first event
+  std::vector<const ContainerType*> m_deepCopyTypes; //!
+  /// The variables of :cpp:member:`MinixAOD::m_auxItemLists` by output container, the only ones deep-copied into it
+  std::map<std::string, std::string> m_deepCopyAuxItems; //!
+  /// The container type of each container recorded to TEvent, resolved on its first event
+  std::map<std::string, const ContainerType*> m_outputTypes; //!
+
   /// Pointer for the File MetaData Tool
   xAODMaker::FileMetaDataTool          *m_fileMetaDataTool = nullptr;    //!
   /// Pointer for the TriggerMenu MetaData Tool
@@ -169,6 +290,11 @@ private:
   xAOD::CutBookkeeperAuxContainer *m_outputInCBKContainer_aux = nullptr; //!
   xAOD::CutBookkeeper             *m_outputCBK = nullptr;                //!
 
+  /// @brief see :cpp:member:`MinixAOD::m_writeEventIndex`
+  xAH::EventIndex m_eventIndex; //!
+  /// @brief number of events written to the output
+  Long64_t m_nEventsWritten = 0; //!
+
 public:
   // this is a standard constructor
   MinixAOD ();
@@ -2,6 +2,7 @@
 #define xAODAnaHelpers_Muon_H
 
 #include "xAODAnaHelpers/Particle.h"
+#include "xAODAnaHelpers/FeatureBlock.h"
 
 
 namespace xAH {
@@ -16,10 +17,14 @@ namespace xAH {
     // kinematics
     float charge;
 
-    // trigger
-    int               isTrigMatched;
-    std::vector<int>  isTrigMatchedToChain;
-    std::vector<std::string> listTrigChains;
+    /// @brief Trigger matching, filled with the ``trigger`` detail
+    struct Trigger
+    {
+      int               isTrigMatched;
+      std::vector<int>  isTrigMatchedToChain;
+      std::vector<std::string> listTrigChains;
+    };
+    xAH::FeatureBlock<Trigger> trigger;
     
       // isolation
     std::map< std::string, int > isIsolated;
@@ -36,14 +41,17 @@ namespace xAH {
     // quality
     std::map< std::string, int > quality;
 
-    // scale factors w/ sys
-    // per object
-    std::map< std::string, std::vector< float > > RecoEff_SF;
-    std::map< std::string, std::vector< float > > IsoEff_SF;
-    std::map< std::string, std::vector< float > > TrigEff_SF;
-    std::map< std::string, std::vector< float > > TrigMCEff;
-    
-    std::vector< float >  TTVAEff_SF;
+    /// @brief Scale factors w/ sys per object, filled with the ``effSF`` detail in MC
+    struct EffSF
+    {
+      std::map< std::string, std::vector< float > > RecoEff_SF;
+      std::map< std::string, std::vector< float > > IsoEff_SF;
+      std::map< std::string, std::vector< float > > TrigEff_SF;
+      std::map< std::string, std::vector< float > > TrigMCEff;
+
+      std::vector< float >  TTVAEff_SF;
+    };
+    xAH::FeatureBlock<EffSF> effSF;
 
     // track parameters
     float trkd0;
@@ -49,6 +49,9 @@ public:
    */
   bool    m_forceDataCalib = false;
 
+  /// @brief Record in TStore, under ``HelperFunctions::sameAsNominalName(m_outputAlgoSystNames)``, the variations which left every muon of the event identical to nominal (see ``JetCalibrator::m_findSameAsNominalSysts``)
+  bool    m_findSameAsNominalSysts = false;
+
 private:
   int m_numEvent;         //!
   int m_numObject;        //!
@@ -41,6 +41,11 @@ namespace xAH {
       std::vector<int>               *m_isTrigMatched;
       std::vector<std::vector<int> > *m_isTrigMatchedToChain;
       std::vector<std::vector<std::string> > *m_listTrigChains;
+      std::vector<unsigned long long> *m_trigMatchTestedBits;
+      std::vector<unsigned long long> *m_isTrigMatchedBits;
+      // chain of each trigger matching bit, read back from the tree, and the bits in alphabetical order of the chains
+      std::vector<std::string> m_trigChainNames;
+      std::vector<unsigned int> m_trigChainOrder;
     
       // isolation
       std::map< std::string, std::vector< int >* >* m_isIsolated;
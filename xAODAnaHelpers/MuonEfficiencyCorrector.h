@@ -23,6 +23,7 @@
 
 // algorithm wrapper
 #include "xAODAnaHelpers/Algorithm.h"
+#include "xAODAnaHelpers/SFProducts.h"
 
 namespace CP {
   class MuonEfficiencyScaleFactors;
@@ -83,6 +84,9 @@ public:
   std::string   m_outputSystNamesTrig = "MuonEfficiencyCorrector_TrigSyst";
   std::string   m_outputSystNamesTTVA = "MuonEfficiencyCorrector_TTVASyst";
 
+  /// @brief Also decorate the event with the product over all nominal muons of the reco, iso and TTVA SFs, one entry per variation (``<SF decoration>_product``)
+  bool          m_writeEventSFProducts = false;
+
 private:
   int m_numEvent;         //!
   int m_numObject;        //!
@@ -105,7 +109,14 @@ private:
   std::string m_trigEffSF_tool_name; //!
   asg::AnaToolHandle<CP::IMuonEfficiencyScaleFactors> m_muTTVASF_tool; //!
   std::string m_TTVAEffSF_tool_name; //!
-  std::map<std::string, std::string> m_SingleMuTriggerMap; //!
+  /// @brief A leg of m_MuTrigLegs: the trigger of the tool, and 2015 or 2016 for a leg only used for the 2015 or the later runs (0 for all of them)
+  struct TriggerLeg {
+    std::string trigger;
+    int year;
+  };
+  std::map<std::string, TriggerLeg> m_SingleMuTriggerMap; //!
+  /// @brief Reused buffer for the event-level SF products
+  xAH::SFProducts m_sfProducts; //!
 
   // variables that don't get filled at submission time should be
   // protected from being send from the submission node to the worker
@@ -132,6 +143,8 @@ public:
 
   // these are the functions not inherited from Algorithm
   virtual EL::StatusCode executeSF ( const xAOD::EventInfo* eventInfo, const xAOD::MuonContainer* inputMuons, bool nominal, bool writeSystNames );
+  /// @brief Decorate ``eventInfo`` with the per-variation product over ``inputMuons`` of the SF vector ``sfName``
+  void decorateEventSFProduct ( const xAOD::EventInfo* eventInfo, const xAOD::MuonContainer* inputMuons, const std::string& sfName, std::size_t nVariations );
 
   /// @cond
   // this is needed to distribute the algorithm to the workers
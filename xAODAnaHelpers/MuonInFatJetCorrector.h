@@ -3,6 +3,8 @@
 
 #include <xAODAnaHelpers/Algorithm.h>
 
+#include <unordered_map>
+
 /** @rst
     Algorithm for correcting the momentum of largeR jets containing muon decays.
 
@@ -61,7 +63,9 @@ public:
   virtual EL::StatusCode finalize();
   virtual EL::StatusCode histFinalize();
 
-  EL::StatusCode matchTrackJetsToMuons() const;
+  EL::StatusCode matchTrackJetsToMuons();
+  /// @brief Find the closest muon passing the quality cuts among the ``MuonsInTrackJet`` of ``trackJet``, or ``nullptr``. Returns false if the decoration is missing.
+  bool findClosestMuon(const xAOD::Jet& trackJet, const xAOD::Muon*& closest_muon) const;
   TLorentzVector getHbbCorrectedVector(const xAOD::Jet &jet);
   const xAOD::JetFourMom_t getMuonCorrectedJetFourMom(const xAOD::Jet &jet, std::vector<const xAOD::Muon*> muons,
 						      Scheme scheme, bool useJMSScale = false) const;
@@ -69,6 +73,9 @@ public:
 private:
    /// @brief Name of calibrated jet mass decorator, without the TA/Calo suffix, for the given sample type
   std::string m_calibratedMassDecorator;
+
+  /// @brief The closest muon of each track jet in this event, filled by matchTrackJetsToMuons
+  std::unordered_map<const xAOD::Jet*, const xAOD::Muon*> m_closestMuon; //!
  
   ClassDef(MuonInFatJetCorrector, 1);
 };
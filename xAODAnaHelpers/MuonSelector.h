@@ -24,6 +24,8 @@
 
 // algorithm wrapper
 #include "xAODAnaHelpers/Algorithm.h"
+#include "xAODAnaHelpers/IsolationDecisions.h"
+#include "xAODAnaHelpers/CutflowCounter.h"
 
 // forward-declare for now until IsolationSelectionTool interface is updated
 namespace CP {
@@ -59,6 +61,8 @@ public:
   int            m_pass_min = -1;
   /** maximum number of objects passing cuts */
   int            m_pass_max = -1;
+  /** stop evaluating muons once the event is rejected by m_pass_min/m_pass_max, the remaining ones are decorated with -1 like for m_nToProcess */
+  bool m_stopWhenRejected = false;
   /** require pT < pt_max */
   float          m_pT_max = 1e8;
   /** require pT > pt_min */
@@ -98,7 +102,8 @@ public:
   std::string    m_TrackBasedIsoType = "ptvarcone30";
 
   /* trigger matching */
-  /** A comma-separated string w/ alll the HLT single muon trigger chains for which you want to perform the matching. If left empty (as it is by default), no trigger matching will be attempted at all */
+  /** A comma-separated string w/ alll the HLT single muon trigger chains for which you want to perform the matching. If left empty (as it is by default), no trigger matching will be attempted at all.
+      The results are stored in the ``trigMatchTestedBitsMu`` and ``isTrigMatchedBitsMu`` decorations (see xAH::TrigMatchBits), not in an ``isTrigMatchedMapMu`` map anymore. */
   std::string    m_singleMuTrigChains = "";
   /** A comma-separated string w/ all the HLT dimuon trigger chains for which you want to perform the matching.  If left empty (as it is by default), no trigger matching will be attempted at all */
   std::string    m_diMuTrigChains = "";
@@ -125,6 +130,9 @@ private:
   // object cutflow
   TH1D* m_mu_cutflowHist_1 = nullptr;                 //!
   TH1D* m_mu_cutflowHist_2 = nullptr;                 //!
+  /// @brief counts for the object cutflows, flushed into the histograms in finalize
+  xAH::CutflowCounter m_mu_cutflowCounter_1; //!
+  xAH::CutflowCounter m_mu_cutflowCounter_2; //!
 
   int   m_mu_cutflow_all;		    //!
   int   m_mu_cutflow_eta_and_quaility_cut;  //!
@@ -138,11 +146,15 @@ private:
   int   m_mu_cutflow_cosmic_cut;		    //!
 
   std::vector<std::string> m_IsoKeys;       //!
+  xAH::IsolationDecisions m_isoDecisions; //!
+  int m_passSelBit = -1; //!  /* the bit of passSel in xAH::SelectionFlags */
 
   /* other private members */
 
   std::vector<std::string>            m_singleMuTrigChainsList; //!  /* contains all the HLT trigger chains tokens extracted from m_singleMuTrigChains */
   std::vector<std::string>            m_diMuTrigChainsList;     //!  /* contains all the HLT trigger chains tokens extracted from m_diMuTrigChains */
+  std::vector<unsigned int>           m_singleMuTrigChainsBits; //!  /* the bit of each chain of m_singleMuTrigChainsList in the trigger matching decorations */
+  std::vector<unsigned int>           m_diMuTrigChainsBits;     //!  /* the bit of each chain of m_diMuTrigChainsList in the trigger matching decorations */
 
   // tools
   asg::AnaToolHandle<CP::IIsolationSelectionTool>  m_isolationSelectionTool_handle{"CP::IsolationSelectionTool/IsolationSelectionTool", this}; //!
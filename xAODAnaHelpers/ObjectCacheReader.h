@@ -0,0 +1,54 @@
+#ifndef xAODAnaHelpers_ObjectCacheReader_H
+#define xAODAnaHelpers_ObjectCacheReader_H
+
+// algorithm wrapper
+#include "xAODAnaHelpers/Algorithm.h"
+
+// std include
+#include <map>
+#include <string>
+#include <vector>
+
+/**
+  @rst
+    First algorithm of a chain that starts from an object cache instead of the original input: a mini-xAOD written by a :cpp:class:`MinixAOD` stage with :cpp:member:`MinixAOD::m_cacheSystNames`. The cached containers are read from the input as usual, this algorithm puts the lists of systematics written next to them back into the ``TStore`` under their original names at every event, so that the algorithms after the cached stage find them where they expect them. The histograms cached through :cpp:member:`MinixAOD::m_cacheHistStreams`, e.g. the cutflows and ``MetaData_EventCount`` of :cpp:class:`BasicEventSelection`, are added to the output streams of the same names when an input file is opened, before the later algorithms pick them up in their ``initialize()``.
+
+    ``xAH_run.py --objectCache`` adds it in place of the algorithms up to the cached stage, see :ref:`ObjectCache`.
+
+  @endrst
+*/
+class ObjectCacheReader : public xAH::Algorithm
+{
+  public:
+    /// @brief name of the tree of the lists of systematics in the input files
+    std::string m_systNamesTree = "xAH_systNames";
+    /// @brief space-delimited output streams of the histograms cached by :cpp:member:`MinixAOD::m_cacheHistStreams`, added to the same streams of this job
+    std::string m_cacheHistStreams = "";
+
+  private:
+
+    /// @brief lists of systematics of the current input file, by ``TStore`` name
+    std::map<std::string, std::vector<std::string> > m_systNames; //!
+
+  public:
+    // this is a standard constructor
+    ObjectCacheReader ();
+
+    // these are the functions inherited from Algorithm
+    virtual EL::StatusCode setupJob (EL::Job& job);
+    virtual EL::StatusCode fileExecute ();
+    virtual EL::StatusCode histInitialize ();
+    virtual EL::StatusCode changeInput (bool firstFile);
+    virtual EL::StatusCode initialize ();
+    virtual EL::StatusCode execute ();
+    virtual EL::StatusCode postExecute ();
+    virtual EL::StatusCode finalize ();
+    virtual EL::StatusCode histFinalize ();
+
+    /// @cond
+    // this is needed to distribute the algorithm to the workers
+    ClassDef(ObjectCacheReader, 1);
+    /// @endcond
+};
+
+#endif
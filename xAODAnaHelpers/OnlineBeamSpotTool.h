@@ -4,6 +4,7 @@
 #include "xAODEventInfo/EventInfo.h"
 #include "xAODAnaHelpers/EventInfo.h"
 
+#include <string>
 #include <vector>
 #include <map>
 
@@ -38,7 +39,14 @@ namespace xAH {
 
     typedef std::vector<LBData>    RunInfo;
     typedef std::map<int, RunInfo> RunToLBDataMap;
-    typedef std::map<int, RunInfo>::iterator RunToLBDataMapItr;
+    typedef std::map<int, RunInfo>::const_iterator RunToLBDataMapItr;
+
+    /// @brief Where the lumi block ranges of a run are stored: the file and the entry of its ``LBInfo`` tree
+    struct RunLocation {
+      std::string m_fileName;
+      long long   m_entry;
+    };
+    typedef std::map<int, RunLocation> RunIndex;
 
   public:
 
@@ -52,17 +60,23 @@ namespace xAH {
   private:
 
     const LBData*  getLBData(int runNumber, int lumiBlock, bool isMC);
+    /// @brief Binary search of the lumi block ranges of the cached run
     const LBData*  getLBData(int lumiBlock);
 
     void setRunInfo(int runNumber);
-    void readFile(std::string rootFileName);
 
-    RunToLBDataMap m_runList;
+    /// @brief Where each run is found in the calibration files, built from their run numbers only on first use and shared by all instances
+    static const RunIndex& runIndex();
+    static void indexFile(const std::string& rootFileName, RunIndex& index);
+    /// @brief The lumi block ranges of ``runNumber``, read on its first lookup and shared by all instances. ``nullptr`` if the run is unknown.
+    static const RunInfo* loadRun(int runNumber);
+    static void readRun(const RunLocation& location, RunInfo& thisRunInfo);
 
     int m_cachedRunNum;
+    /// @brief the last lumi block looked up, and its result
     int m_cachedLB;
-    RunInfo* m_cachedRunInfo;
-    LBData*  m_cachedLBData;
+    const RunInfo* m_cachedRunInfo;
+    const LBData*  m_cachedLBData;
     LBData*  m_mcLBData;
 
 
@@ -8,6 +8,10 @@
 #ifndef XAODANAHELPERS_OVERLAPREMOVER_H
 #define XAODANAHELPERS_OVERLAPREMOVER_H
 
+// c++ include(s):
+#include <map>
+#include <memory>
+
 // EDM include(s):
 #include "xAODBase/IParticleHelpers.h"
 #include "xAODBase/IParticleContainer.h"
@@ -25,6 +29,8 @@
 
 // algorithm wrapper
 #include "xAODAnaHelpers/Algorithm.h"
+#include "xAODAnaHelpers/ReadHandle.h"
+#include "xAODAnaHelpers/EtaPhiGrid.h"
 
 // ROOT include(s):
 #include "TH1D.h"
@@ -149,6 +155,25 @@ class OverlapRemover : public xAH::Algorithm
   https://twiki.cern.ch/twiki/bin/view/AtlasProtected/HowToCleanJetsR21#Muons_Reconstructed_as_Jets_in_P */
   bool m_doMuPFJetOR = false;
 
+  /**
+     @rst
+        Skip the overlap removal for the jet systematics listed as identical to nominal by the upstream algorithm (see :cpp:member:`JetCalibrator::m_findSameAsNominalSysts`).
+        The variation's jets take the decisions of the nominal jets at the same position and the other selected containers are copies of the nominal ones.
+        Requires :cpp:member:`~m_createSelectedContainers`, and the reused variations are not counted in the object cutflows.
+     @endrst
+  */
+  bool m_aliasSameAsNominalSysts = false;
+
+  /**
+     @rst
+        Keep the objects with no other object within :cpp:member:`~m_isolatedObjectsDR` out of the overlap removal tools and let them pass directly.
+        The neighbours are found with a :cpp:class:`xAH::EtaPhiGrid` per collection, built once per event and container and reused across the systematics loop.
+        :cpp:member:`~m_isolatedObjectsDR` must not be smaller than the largest cone of the configured overlap steps.
+     @endrst
+  */
+  bool m_skipIsolatedObjects = false;
+  float m_isolatedObjectsDR = 1.0;
+
  protected:
 
   /** @brief A counter for the number of processed events */
@@ -209,6 +234,22 @@ class OverlapRemover : public xAH::Algorithm
   /** @brief Pointer to the CP Tool which performs the actual OLR. */
   ORUtils::ToolBox m_ORToolbox;        //!
 
+  /** @brief Cached lookups of the nominal input containers */
+  xAH::ReadHandle<xAOD::ElectronContainer> m_inElectronsHandle; //!
+  xAH::ReadHandle<xAOD::MuonContainer>     m_inMuonsHandle;     //!
+  xAH::ReadHandle<xAOD::JetContainer>      m_inJetsHandle;      //!
+  xAH::ReadHandle<xAOD::PhotonContainer>   m_inPhotonsHandle;   //!
+  xAH::ReadHandle<xAOD::TauJetContainer>   m_inTausHandle;      //!
+
+  /** @brief The neighbour indices of the containers seen in this event, see :cpp:member:`~m_skipIsolatedObjects` */
+  std::map<const xAOD::IParticleContainer*, xAH::EtaPhiGrid> m_grids; //!
+  /** @brief Reads the overlap removal decision :cpp:member:`~m_decor` when building the selected containers */
+  std::unique_ptr<SG::AuxElement::ConstAccessor<char> > m_passORAcc; //!
+  /// @brief bit of ``m_decor`` in :cpp:any:`xAH::SelectionFlags`
+  int m_passORBit = -1; //!
+  /** @brief Input label of the overlap removal tools when :cpp:member:`~m_skipIsolatedObjects` is set */
+  std::string m_inputLabel; //!
+
   /** @brief An enum encoding systematics according to the various objects */
   enum SystType {
     NOMINAL = 0,
@@ -288,6 +329,16 @@ public:
 				    std::vector<std::string>* sysVec = nullptr,
             std::vector<std::string>* sysVecOut = nullptr);
 
+  /** @brief Run the overlap removal tools, leaving out the isolated objects if :cpp:member:`~m_skipIsolatedObjects` is set */
+  EL::StatusCode removeOverlaps( const xAOD::ElectronContainer* inElectrons,
+                                 const xAOD::MuonContainer* inMuons,
+                                 const xAOD::JetContainer* inJets,
+                                 const xAOD::PhotonContainer* inPhotons,
+                                 const xAOD::TauJetContainer* inTaus );
+
+  /** @brief Record the nominal overlap removal result under the systematic ``systName`` of the jets ``inJets``, which are identical to ``nominalJets`` */
+  EL::StatusCode aliasNominalOR( const xAOD::JetContainer* inJets, const xAOD::JetContainer* nominalJets, const std::string& systName );
+
   /** @brief Setup cutflow histograms */
   EL::StatusCode setCutFlowHist();
   /** @brief Initialise counters for events/objects */
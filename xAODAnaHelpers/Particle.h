@@ -14,6 +14,9 @@ namespace xAH {
     virtual ~Particle() {}
 
     TLorentzVector p4;
+
+    /// @brief The :cpp:any:`xAH::SelectionFlags` word, with the ``selectionFlags`` detail
+    unsigned long long selectionFlags = 0;
   };
 
 }//xAH
@@ -0,0 +1,64 @@
+#ifndef xAODAnaHelpers_ParticleAssociation_H
+#define xAODAnaHelpers_ParticleAssociation_H
+
+#include <xAODBase/IParticleContainer.h>
+#include <xAODRootAccess/TStore.h>
+#include <AsgTools/StatusCode.h>
+
+#include <string>
+#include <vector>
+
+#include <xAODAnaHelpers/ParticleKinematics.h>
+
+namespace xAH {
+
+  /**
+      @rst
+          The :math:`\Delta R` association of the particles of a collection (e.g. leptons) to those of another one (e.g. jets), built once per event for a pair of collections and a :math:`\Delta R` and shared through the ``xAOD::TStore`` by all the algorithms that need it.
+
+          It is stored as index lists: for jet ``i``, the indices of the leptons closer than ``maxDR``, in increasing order, and their :math:`\Delta R^2`::
+
+              const xAH::ParticleAssociation* muonsInJets(nullptr);
+              ANA_CHECK( xAH::ParticleAssociation::retrieve(muonsInJets, jets, "AntiKt4EMPFlowJets", muons, "Muons", 0.4, m_store) );
+              for(unsigned int k = muonsInJets->begin(i); k < muonsInJets->end(i); ++k)
+                const xAOD::Muon* muon = (*muons)[muonsInJets->index(k)];
+
+      @endrst
+   */
+  class ParticleAssociation {
+    public:
+      /// @brief Associate to every particle of ``jets`` the ``leptons`` closer than ``maxDR``, replacing the previous content
+      void build(const xAOD::IParticleContainer* jets, const xAOD::IParticleContainer* leptons, float maxDR);
+
+      /// @brief Number of jets
+      unsigned int size() const { return m_offsets.empty() ? 0 : m_offsets.size() - 1; }
+      /// @brief First and one past the last position of the associations of jet ``jet`` in :cpp:func:`index` and :cpp:func:`deltaR2`
+      unsigned int begin(unsigned int jet) const { return m_offsets[jet]; }
+      unsigned int end(unsigned int jet) const { return m_offsets[jet + 1]; }
+      /// @brief Index in the lepton container of the association at position ``k``
+      unsigned int index(unsigned int k) const { return m_indices[k]; }
+      /// @brief :math:`\Delta R^2` of the association at position ``k``
+      float deltaR2(unsigned int k) const { return m_deltaR2[k]; }
+
+      /**
+          @brief The association of the event for these collections, built and recorded in ``store`` by the first caller
+          @param association  Set to the association
+          @param jets         The collection the others are associated to, and its name
+          @param leptons      The collection associated to ``jets``, and its name
+          @param maxDR        The largest :math:`\Delta R` (excluded) of an association
+          @param store        The store of the event
+       */
+      static StatusCode retrieve(const ParticleAssociation*& association,
+                                 const xAOD::IParticleContainer* jets, const std::string& jetName,
+                                 const xAOD::IParticleContainer* leptons, const std::string& leptonName,
+                                 float maxDR, xAOD::TStore* store);
+
+    private:
+      /// @brief jet ``i`` has the associations ``m_offsets[i]`` to ``m_offsets[i+1]``
+      std::vector<unsigned int> m_offsets;
+      std::vector<unsigned int> m_indices;
+      std::vector<float> m_deltaR2;
+  };
+
+}
+#endif
@@ -2,16 +2,24 @@
 #define xAODAnaHelpers_ParticleContainer_H
 
 #include <TTree.h>
+#include <TBranch.h>
 #include <TLorentzVector.h>
 
+#include <map>
 #include <vector>
 #include <string>
+#include <functional>
+#include <utility>
 
 #include <xAODAnaHelpers/HelperClasses.h>
 #include <xAODAnaHelpers/HelperFunctions.h>
 
 #include <xAODAnaHelpers/Particle.h>
+#include <xAODAnaHelpers/ColumnBatch.h>
+#include <xAODAnaHelpers/JaggedBranch.h>
 #include <xAODBase/IParticle.h>
+#include <AthContainers/AuxVectorData.h>
+#include <AthContainers/OwnershipPolicy.h>
 
 namespace xAH
 {
@@ -34,9 +42,18 @@ namespace xAH
 	m_units(units),
 	m_storeSystSFs(storeSystSFs),
 	m_useMass(useMass),
-	m_suffix(suffix)
+	m_suffix(suffix),
+	m_copySource(nullptr),
+	m_lazyTree(nullptr),
+	m_lazyTreeNumber(-1),
+	m_lazyLoaded(false)
       {
+	for(const auto& detail : m_infoSwitch.unknownDetails())
+	  std::cerr << "WARNING! Unknown detail \"" << detail << "\" for " << m_name << " is ignored in ParticleContainer." << std::endl;
+
 	m_n = 0;
+	m_nMax = 0;
+	m_fillPlanDone = false;
 
         // kinematic
         m_pt  =new std::vector<float>();
@@ -44,6 +61,9 @@ namespace xAH
         m_phi =new std::vector<float>();
         m_E   =new std::vector<float>();
         m_M   =new std::vector<float>();
+
+        // selectionFlags
+        m_selectionFlags =new std::vector<unsigned long long>();
       }
 
       virtual ~ParticleContainer()
@@ -56,6 +76,8 @@ namespace xAH
 	  delete m_E;
 	  delete m_M;
 	}
+
+        delete m_selectionFlags;
       }
 
       virtual void setTree(TTree *tree)
@@ -82,6 +104,61 @@ namespace xAH
 	    if(m_useMass) connectBranch<float>(tree,"m"  ,&m_M);
 	    else          connectBranch<float>(tree,"E"  ,&m_E);
           }
+
+        if(m_infoSwitch.m_selectionFlags) connectBranch<unsigned long long>(tree,"selectionFlags",&m_selectionFlags);
+      }
+
+      /**
+          @rst
+              Like :cpp:func:`setTree`, but the branches it connects are not read by ``tree->GetEntry()``: they are read from the tree the first time an object of the entry is accessed through :cpp:func:`particle` (or all at once by :cpp:func:`updateEntry`). Only the object multiplicity is read for every entry, so a container that an event does not look at costs no I/O, and a detail string broader than needed does not read more than what is used.
+
+              Must be called instead of :cpp:func:`setTree`, and each entry must then be announced with :cpp:func:`updateEntryLazy` or :cpp:func:`updateEntry`.
+
+          @endrst
+       */
+      void setTreeLazy(TTree *tree)
+      {
+	setTree(tree);
+
+	// a TChain has no branches of its own
+	if(tree->GetTree() == nullptr) tree->LoadTree(0);
+	TTree* current = tree->GetTree() ? tree->GetTree() : tree;
+
+	// the branches of this container that setTree() connected
+	const std::string prefix = m_name + "_";
+	const std::string suffix = m_suffix.empty() ? "" : "_" + m_suffix;
+	m_lazyBranchNames.clear();
+	for(const TObject* obj : *current->GetListOfBranches()) {
+	  const std::string name = obj->GetName();
+	  if(name.size() < prefix.size() + suffix.size()) continue;
+	  if(name.compare(0, prefix.size(), prefix) != 0 || name.compare(name.size() - suffix.size(), suffix.size(), suffix) != 0) continue;
+	  if(!tree->GetBranchStatus(name.c_str()) || static_cast<const TBranch*>(obj)->GetAddress() == nullptr) continue;
+	  tree->SetBranchStatus(name.c_str(), 0);
+	  m_lazyBranchNames.push_back(name);
+	}
+
+	m_lazyTree = tree;
+	m_lazyTreeNumber = -1;
+	m_lazyLoaded = false;
+      }
+
+      /**
+          @rst
+              A :cpp:class:`xAH::ColumnBatch` of the branches of this container, with the columns of the kinematic variables and of the ``selectionFlags`` word when the detail string has them. Other columns are added with :cpp:func:`xAH::ColumnBatch::addColumn`, e.g. ``batch.addColumn<float>("rapidity")``. The mass or the energy is read according to the branches found by :cpp:func:`setTree`, the energy before.
+
+          @endrst
+       */
+      xAH::ColumnBatch columnBatch() const
+      {
+	xAH::ColumnBatch batch(m_name, m_suffix);
+	if(m_infoSwitch.m_kinematic){
+	  batch.addColumn<float>("pt");
+	  batch.addColumn<float>("eta");
+	  batch.addColumn<float>("phi");
+	  batch.addColumn<float>(m_useMass ? "m" : "E");
+	}
+	if(m_infoSwitch.m_selectionFlags) batch.addColumn<unsigned long long>("selectionFlags");
+	return batch;
       }
 
       virtual void setBranches(TTree *tree)
@@ -99,11 +176,23 @@ namespace xAH
 	  setBranch<float>(tree,"phi",                      m_phi              );
 	  setBranch<float>(tree,"eta",                      m_eta              );
 	}
+
+        if(m_infoSwitch.m_selectionFlags) setBranch<unsigned long long>(tree,"selectionFlags", m_selectionFlags);
       }
 
       virtual void clear()
       {
+	// keep all output buffers at the largest multiplicity seen so far, so that
+	// filling them does not reallocate once the job reached its steady state;
+	// the inner vectors of std::vector<std::vector<T> > buffers are still
+	// allocated for every object and event, the flatArrays layout avoids that
+	if(m_n > m_nMax){
+	  m_nMax = m_n;
+	  for(auto& reserve : m_reserveBuffers) reserve(m_nMax);
+	}
+
 	m_n = 0;
+	m_fillPlanDone = false;
 
         if(m_infoSwitch.m_kinematic) {
 	  if(m_useMass)  m_M->clear();
@@ -112,6 +201,43 @@ namespace xAH
 	  m_phi ->clear();
 	  m_eta ->clear();
 	}
+
+        if(m_infoSwitch.m_selectionFlags) m_selectionFlags->clear();
+      }
+
+      /**
+          @rst
+              Copy the output buffers of ``other``, the container of the same name and detail string in another tree (typically the nominal one), instead of filling them again from the same objects: an event in a systematic tree that does not vary this collection writes exactly what the nominal tree wrote. All the branches of this container must be booked by ``other`` as well (it may book more, like the nominal-only ``sysNames``), otherwise nothing is copied and false is returned.
+
+              Buffers booked with ``TTree::Branch`` directly rather than through ``setBranch()`` have to be registered with :cpp:func:`addCopyBuffer` to be copied.
+
+          @endrst
+       */
+      virtual bool copyFrom(const ParticleContainer& other)
+      {
+	// the buffers of the two containers are matched by branch name once
+	if(m_copySource != &other){
+	  m_copySource = &other;
+	  m_copyIndex.clear();
+	  for(std::size_t i = 0; i < m_copyBuffers.size(); ++i){
+	    std::size_t j = i;
+	    if(j >= other.m_copyBuffers.size() || other.m_copyBuffers[j].name != m_copyBuffers[i].name){
+	      for(j = 0; j < other.m_copyBuffers.size(); ++j)
+		if(other.m_copyBuffers[j].name == m_copyBuffers[i].name) break;
+	    }
+	    if(j == other.m_copyBuffers.size()){
+	      m_copyIndex.clear();
+	      break;
+	    }
+	    m_copyIndex.push_back(j);
+	  }
+	}
+	if(m_copyIndex.size() != m_copyBuffers.size()) return false;
+
+	clear();
+	m_n = other.m_n;
+	for(std::size_t i = 0; i < m_copyBuffers.size(); ++i) m_copyBuffers[i].copy(other.m_copyBuffers[m_copyIndex[i]].buffer);
+	return true;
       }
 
       virtual void FillParticle(const xAOD::IParticle* particle)
@@ -125,14 +251,48 @@ namespace xAH
 	  if(m_useMass) m_M->push_back  ( particle->m() / m_units );
 	  else          m_E->push_back  ( particle->e() / m_units );
 	}
+
+        if( m_infoSwitch.m_selectionFlags ) m_selectionFlags->push_back( xAH::SelectionFlags::word(*particle) );
       }
 
-      void updateEntry()
+      virtual void updateEntry()
       {
+	m_lazyLoaded = false;
+	jaggedEntryLoaded();
+	loadLazyBranches();
+
         m_particles.resize(m_n);
 
         for(int i=0;i<m_n;i++)
 	  updateParticle(i,m_particles[i]);
+	m_decoded.assign(m_n, 1);
+      }
+
+      /**
+          @rst
+              Read-back mode that only decodes the objects that are actually looked at: after loading an entry, call this instead of :cpp:func:`updateEntry` and access the objects through :cpp:func:`particle`, which builds each of them from the branch buffers on first use. The objects are kept between entries, so their vectors reuse their capacity.
+
+              Together with ``tree->SetBranchStatus("*", 0)`` before :cpp:func:`setTree`, which then only enables the branches required by the detail string, this reads and decodes just what the analysis uses.
+
+          @endrst
+       */
+      virtual void updateEntryLazy()
+      {
+        m_particles.resize(m_n);
+        m_decoded.assign(m_n, 0);
+	m_lazyLoaded = false;
+	jaggedEntryLoaded();
+      }
+
+      /// @brief Object ``idx`` of the current entry, decoded on first use after :cpp:func:`updateEntryLazy`
+      const T_PARTICLE& particle(uint idx)
+      {
+	if(!m_decoded.at(idx)) {
+	  loadLazyBranches();
+	  updateParticle(idx, m_particles[idx]);
+	  m_decoded[idx] = 1;
+	}
+	return m_particles[idx];
       }
       
       std::vector<T_PARTICLE>& particles()
@@ -152,6 +312,26 @@ namespace xAH
 
 
     protected:
+      /// @brief Read the current entry of the branches connected by :cpp:func:`setTreeLazy`, once per entry
+      void loadLazyBranches()
+      {
+	if(!m_lazyTree || m_lazyLoaded) return;
+	TTree* current = m_lazyTree->GetTree() ? m_lazyTree->GetTree() : m_lazyTree;
+
+	// the branches belong to the tree of the current file of a TChain
+	if(m_lazyTree->GetTreeNumber() != m_lazyTreeNumber) {
+	  m_lazyBranches.clear();
+	  for(const auto& name : m_lazyBranchNames)
+	    if(TBranch* branch = current->GetBranch(name.c_str())) m_lazyBranches.push_back(branch);
+	  m_lazyTreeNumber = m_lazyTree->GetTreeNumber();
+	}
+
+	const Long64_t entry = current->GetReadEntry();
+	for(TBranch* branch : m_lazyBranches) branch->GetEntry(entry, 1);
+	m_lazyLoaded = true;
+	jaggedEntryLoaded();
+      }
+
       std::string branchName(const std::string& varName)
       {
 	std::string name = m_name + "_" + varName;
@@ -171,9 +351,123 @@ namespace xAH
 	  }
       }
 
+      template <typename T_BR> void connectBranch(TTree *tree, const std::string& branch, xAH::JaggedBranch<T_BR> *variable)
+      {
+	variable->connect(tree, branchName(branch));
+	// keyed by the buffer, setTree() may be called again for the next tree
+	m_jaggedBranches[variable] = [variable](){ variable->entryLoaded(); };
+      }
+
+      /// @brief Tell the connected :cpp:class:`xAH::JaggedBranch` that a new entry was read
+      void jaggedEntryLoaded()
+      {
+	for(auto& jagged : m_jaggedBranches) jagged.second();
+      }
+
       template<typename T> void setBranch(TTree* tree, std::string varName, std::vector<T>* localVectorPtr){
 	std::string name = branchName(varName);
 	tree->Branch(name.c_str(),        localVectorPtr);
+	m_reserveBuffers.push_back( [localVectorPtr](std::size_t n){ localVectorPtr->reserve(n); } );
+	setPrecision(varName, localVectorPtr);
+	addCopyBuffer(name, localVectorPtr);
+      }
+
+      template<typename T> void setBranch(TTree* tree, std::string varName, xAH::JaggedBranch<T>* jagged){
+	jagged->setBranches(tree, branchName(varName));
+	m_reserveBuffers.push_back( [jagged](std::size_t n){ jagged->reserve(n); } );
+	setPrecision(varName, jagged);
+	addCopyBuffer(branchName(varName), jagged);
+      }
+
+      /// @brief Register an output buffer booked directly with ``TTree::Branch`` (``name`` being its branch name), so that :cpp:func:`copyFrom` copies it
+      template<typename T> void addCopyBuffer(const std::string& name, T* buffer){
+	m_copyBuffers.push_back( CopyBuffer{name, buffer, [buffer](const void* other){ *buffer = *static_cast<const T*>(other); }} );
+      }
+
+      template<typename T> void addCopyBuffer(const std::string& name, xAH::JaggedBranch<T>* buffer){
+	m_copyBuffers.push_back( CopyBuffer{name, buffer, [buffer](const void* other){ buffer->copyFrom(*static_cast<const xAH::JaggedBranch<T>*>(other)); }} );
+      }
+
+      /**
+          @rst
+              Book the branch ``varName`` and add it to the fill plan: it is filled with the aux variable ``auxName`` of each object (``defaultValue`` if it is not available) by :cpp:func:`fillPlanned`. The accessor, destination and unit scale are resolved once here, so the fill itself does not look at the detail switches again.
+
+          @endrst
+       */
+      template<typename T, typename U> void setPlannedBranch(TTree* tree, const std::string& varName, const std::string& auxName, std::vector<U>* destination, U defaultValue, int units = 1){
+	setBranch<U>(tree, varName, destination);
+	const SG::AuxElement::ConstAccessor<T> accessor(auxName);
+	m_fillPlan.emplace_back( [accessor, destination, defaultValue, units](const SG::AuxElement& obj){
+	    if ( accessor.isAvailable( obj ) ) destination->push_back( accessor( obj ) / units );
+	    else                               destination->push_back( defaultValue );
+	  } );
+	// availability is a property of the whole container, so the column is checked once and copied in one go
+	m_fillPlanBulk.emplace_back( [accessor, destination, defaultValue, units](const SG::AuxVectorData& objects, std::size_t n){
+	    const std::size_t offset = destination->size();
+	    if ( !objects.isAvailable( accessor.auxid() ) ) {
+	      destination->resize( offset + n, defaultValue );
+	      return;
+	    }
+	    const T* values = accessor.getDataArray( objects );
+	    destination->resize( offset + n );
+	    U* out = destination->data() + offset;
+	    for(std::size_t i = 0; i < n; ++i) out[i] = values[i] / units;
+	  } );
+      }
+
+      /// @brief Fill all the branches booked with :cpp:func:`setPlannedBranch` for one object, unless :cpp:func:`fillPlannedBulk` already did for this event
+      void fillPlanned(const SG::AuxElement& obj) const
+      {
+	if ( m_fillPlanDone ) return;
+	for(const auto& fill : m_fillPlan) fill(obj);
+      }
+
+      /**
+          @rst
+              Fill all the branches booked with :cpp:func:`setPlannedBranch` for all ``objects`` at once, reading each aux variable as one contiguous column. This only works for containers that hold their own aux store (not view containers, e.g. of selected objects), in which case false is returned and the objects are filled one by one by :cpp:func:`fillPlanned`. Must be called after ``clear()`` and before the objects of the event are filled.
+
+          @endrst
+       */
+      template<typename T_CONTAINER> bool fillPlannedBulk(const T_CONTAINER* objects)
+      {
+	if ( m_fillPlanBulk.empty() || objects->ownPolicy() != SG::OWN_ELEMENTS || !objects->trackIndices() ) return false;
+	for(const auto& fill : m_fillPlanBulk) fill(*objects, objects->size());
+	m_fillPlanDone = true;
+	return true;
+      }
+
+      /**
+          @rst
+              Book the scale factor branch ``branch`` (the full branch name) and add it to the scale factor fill plan: :cpp:func:`fillPlannedSFs` fills it from the aux variable ``auxName`` like :cpp:func:`safeSFVecFill` does. The working point is resolved to its accessor and output buffer once here, so the fill does not build names or look up maps.
+
+          @endrst
+       */
+      void setPlannedSFBranch(TTree* tree, const std::string& branch, const std::string& auxName, std::vector<std::vector<float> >* destination)
+      {
+	tree->Branch(branch.c_str(), destination);
+	m_reserveBuffers.push_back( [destination](std::size_t n){ destination->reserve(n); } );
+	addCopyBuffer(branch, destination);
+	const std::string prefix = m_name + "_";
+	setPrecision(branch.compare(0, prefix.size(), prefix) == 0 ? branch.substr(prefix.size()) : branch, destination);
+	m_fillPlanSFs.emplace_back( SG::AuxElement::ConstAccessor<std::vector<float> >(auxName), destination );
+      }
+
+      /// @brief Fill all the branches booked with :cpp:func:`setPlannedSFBranch` for one object
+      void fillPlannedSFs(const SG::AuxElement& obj)
+      {
+	static const std::vector<float> junkSF(1, -1.0);
+	for(auto& fill : m_fillPlanSFs) safeSFVecFill<float, SG::AuxElement>(&obj, fill.first, fill.second, junkSF);
+      }
+
+      /**
+          @rst
+              Round all the float branches the detail string asks to store with reduced precision (see :cpp:func:`HelperClasses::InfoSwitch::floatPrecision`) to their number of mantissa bits. Called by :cpp:func:`HelpTreeBase::Fill` right before the tree is filled, so the values are dropped only from what is written out.
+
+          @endrst
+       */
+      void reducePrecision()
+      {
+	for(const auto& reduce : m_reducePrecision) reduce();
       }
 
       template<typename T, typename U, typename V> void safeFill(const V* xAODObj, SG::AuxElement::ConstAccessor<T>& accessor, std::vector<U>* destination, U defaultValue, int units = 1){
@@ -194,6 +488,15 @@ namespace xAH
 	return;
       }
 
+      template<typename T, typename U, typename V> void safeVecFill(const V* xAODObj, SG::AuxElement::ConstAccessor<std::vector<T> >& accessor, xAH::JaggedBranch<U>* destination, int units = 1){
+	destination->newEntry();
+
+	if ( accessor.isAvailable( *xAODObj ) ) {
+	  for(U itemInVec : accessor(*xAODObj))        destination->fill(itemInVec / units);
+	}
+	return;
+      }
+
       template<typename T, typename V> void safeSFVecFill(const V* xAODObj, SG::AuxElement::ConstAccessor<std::vector<T> >& accessor, std::vector<std::vector<T> >* destination, const std::vector<T> &defaultValue) {
         if ( accessor.isAvailable( *xAODObj ) ) {
           if ( m_storeSystSFs ) {
@@ -224,11 +527,16 @@ namespace xAH
 				       m_E  ->at(idx));
 	    }
 	  }
+
+        // the tree may predate the selectionFlags detail
+        if(m_infoSwitch.m_selectionFlags && m_selectionFlags) particle.selectionFlags = m_selectionFlags->at(idx);
       }
 
       std::string m_name;
 
       std::vector<T_PARTICLE> m_particles;
+      // which entries of m_particles are up to date with the current tree entry
+      std::vector<char> m_decoded;
 
     public:
       T_INFOSWITCH m_infoSwitch;
@@ -241,9 +549,75 @@ namespace xAH
 
 
     private:
+      template<typename T> void setPrecision(const std::string& /*varName*/, std::vector<T>* /*buffer*/) {}
+      template<typename T> void setPrecision(const std::string& /*varName*/, xAH::JaggedBranch<T>* /*buffer*/) {}
+
+      void setPrecision(const std::string& varName, std::vector<float>* buffer)
+      {
+	const unsigned int bits = m_infoSwitch.floatPrecision(varName);
+	if(bits == 0) return;
+	m_reducePrecision.push_back( [buffer, bits](){
+	    for(float& value : *buffer) value = HelperFunctions::reducePrecision(value, bits);
+	  } );
+      }
+
+      void setPrecision(const std::string& varName, std::vector<std::vector<float> >* buffer)
+      {
+	const unsigned int bits = m_infoSwitch.floatPrecision(varName);
+	if(bits == 0) return;
+	m_reducePrecision.push_back( [buffer, bits](){
+	    for(auto& values : *buffer)
+	      for(float& value : values) value = HelperFunctions::reducePrecision(value, bits);
+	  } );
+      }
+
+      void setPrecision(const std::string& varName, xAH::JaggedBranch<float>* buffer)
+      {
+	const unsigned int bits = m_infoSwitch.floatPrecision(varName);
+	if(bits == 0) return;
+	m_reducePrecision.push_back( [buffer, bits](){
+	    buffer->transform( [bits](float value){ return HelperFunctions::reducePrecision(value, bits); } );
+	  } );
+      }
+
       bool        m_useMass;
       std::string m_suffix;
 
+      // largest number of objects written in an event so far
+      int m_nMax;
+      // reserve() of every per-object output vector booked through setBranch()
+      std::vector<std::function<void(std::size_t)> > m_reserveBuffers;
+      // entryLoaded() of every xAH::JaggedBranch connected through connectBranch()
+      std::map<const void*, std::function<void()> > m_jaggedBranches;
+      // rounding of the float branches booked with reduced precision
+      std::vector<std::function<void()> > m_reducePrecision;
+      // the branches booked through setPlannedBranch()
+      std::vector<std::function<void(const SG::AuxElement&)> > m_fillPlan;
+      std::vector<std::function<void(const SG::AuxVectorData&, std::size_t)> > m_fillPlanBulk;
+      // the branches booked through setPlannedSFBranch(), with their accessor
+      std::vector<std::pair<SG::AuxElement::ConstAccessor<std::vector<float> >, std::vector<std::vector<float> >*> > m_fillPlanSFs;
+      // whether fillPlannedBulk() filled the current event
+      bool m_fillPlanDone;
+
+      // the output buffers copied by copyFrom(), by branch name
+      struct CopyBuffer
+      {
+	std::string name;
+	const void* buffer;
+	std::function<void(const void*)> copy;
+      };
+      std::vector<CopyBuffer> m_copyBuffers;
+      // the container copyFrom() last copied, and the index of each of our buffers among its own
+      const ParticleContainer* m_copySource;
+      std::vector<std::size_t> m_copyIndex;
+
+      // the branches connected by setTreeLazy(), read on first use in each entry
+      TTree* m_lazyTree;
+      std::vector<std::string> m_lazyBranchNames;
+      std::vector<TBranch*> m_lazyBranches;
+      int m_lazyTreeNumber;
+      bool m_lazyLoaded;
+
       //
       // Vector branches
 
@@ -253,6 +627,9 @@ namespace xAH
       std::vector<float> *m_phi;
       std::vector<float> *m_E;
       std::vector<float> *m_M;
+
+      // selectionFlags
+      std::vector<unsigned long long> *m_selectionFlags;
     };
 
 }//xAH
@@ -0,0 +1,49 @@
+#ifndef xAODAnaHelpers_ParticleKinematics_H
+#define xAODAnaHelpers_ParticleKinematics_H
+
+#include <xAODBase/IParticleContainer.h>
+
+#include <vector>
+
+namespace xAH {
+
+  /**
+      @rst
+          The kinematics of a container of particles stored as a struct of arrays, read once per event from the aux store.
+
+          Code looping repeatedly over the same container, e.g. for isolation or :math:`\Delta R` matching, should fill one of these at the start of the event and use the arrays instead of calling ``p4()``. ``p4()`` builds a ``TLorentzVector`` from the aux data of the object, and the trigonometric functions it needs are recomputed on every call. The arrays are indexed like the container, and ``cosPhi``/``sinPhi`` are kept so that :math:`\Delta\phi` comparisons need no further trigonometric calls.
+
+          The arrays keep their capacity between events, so a long-lived instance is best, e.g. a member of the histogram class::
+
+              m_trkKinematics.fill(trks);
+              for(unsigned int i = 0; i < m_trkKinematics.size(); ++i) sumPx += m_trkKinematics.px[i];
+
+      @endrst
+   */
+  class ParticleKinematics {
+    public:
+      /// @brief Read the kinematics of all particles in ``particles``, replacing the previous content. A null pointer leaves it empty.
+      void fill(const xAOD::IParticleContainer* particles);
+
+      /// @brief Append the kinematics of a single particle
+      void push_back(const xAOD::IParticle* particle);
+
+      /// @brief Forget the particles, keeping the capacity of the arrays
+      void clear();
+
+      /// @brief Number of particles
+      unsigned int size() const { return pt.size(); }
+
+      std::vector<float> pt;
+      std::vector<float> eta;
+      std::vector<float> phi;
+      std::vector<float> m;
+      std::vector<float> px;
+      std::vector<float> py;
+      std::vector<float> pz;
+      std::vector<float> cosPhi;
+      std::vector<float> sinPhi;
+  };
+
+}
+#endif
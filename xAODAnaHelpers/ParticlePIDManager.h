@@ -40,13 +40,13 @@ class ElectronLHPIDManager
     const std::string getSelectedWP ();
 
     /* returns a map containing all the tools */
-    std::multimap< std::string, AsgElectronLikelihoodTool* > getAllWPTools()   { return m_allWPTools; };
+    const std::multimap< std::string, AsgElectronLikelihoodTool* >& getAllWPTools()   { return m_allWPTools; };
     /* returns a map containing only the tools w/ (WP >= selected WP) */
-    std::multimap< std::string, AsgElectronLikelihoodTool* > getValidWPTools() { return m_validWPTools; };
+    const std::multimap< std::string, AsgElectronLikelihoodTool* >& getValidWPTools() { return m_validWPTools; };
     /* returns a string containing all the WPs */
-    const std::set<std::string>  getAllWPs()   { return m_allWPAuxDecors; };
+    const std::set<std::string>& getAllWPs()   { return m_allWPAuxDecors; };
     /* returns a string containing only the WPs >= selected WP */
-    const std::set<std::string>  getValidWPs() { return m_validWPs; };
+    const std::set<std::string>& getValidWPs() { return m_validWPs; };
 
   private:
 
@@ -80,13 +80,13 @@ class ElectronCutBasedPIDManager
     const std::string getSelectedWP ( ) { return m_selectedWP; }
 
     /* returns a map containing all the tools */
-    std::multimap< std::string, AsgElectronIsEMSelector* > getAllWPTools() { return m_allWPTools; };
+    const std::multimap< std::string, AsgElectronIsEMSelector* >& getAllWPTools() { return m_allWPTools; };
     /* returns a map containing only the tools w/ (WP >= selected WP) */
-    std::multimap< std::string, AsgElectronIsEMSelector* > getValidWPTools() { return m_validWPTools; };
+    const std::multimap< std::string, AsgElectronIsEMSelector* >& getValidWPTools() { return m_validWPTools; };
     /* returns a string containing all the WPs */
-    const std::set<std::string>  getAllWPs()   { return m_allWPAuxDecors; };
+    const std::set<std::string>& getAllWPs()   { return m_allWPAuxDecors; };
     /* returns a string containing only the WPs >= selected WP */
-    const std::set<std::string>  getValidWPs() { return m_validWPs; };
+    const std::set<std::string>& getValidWPs() { return m_validWPs; };
 
   private:
 
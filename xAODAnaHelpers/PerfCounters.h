@@ -0,0 +1,83 @@
+#ifndef xAODAnaHelpers_PerfCounters_H
+#define xAODAnaHelpers_PerfCounters_H
+
+#include <array>
+#include <string>
+
+class TH1D;
+
+namespace xAH {
+
+  /**
+      @rst
+          Reads hardware performance counters (cycles, instructions, last-level cache misses and branch misses) of the Linux ``perf_event`` interface around a code region (e.g. :cpp:func:`xAH::Algorithm::execute`), and accumulates the differences.
+
+          The counters are opened once per job, for the user-space part of the main thread and of the threads it starts (those are counted once they finished), and shared by all the profilers. They need ``/proc/sys/kernel/perf_event_paranoid`` to be ``2`` or lower, and a machine exposing them (not all virtual machines do). A counter that cannot be opened stays at zero, see :cpp:func:`xAH::PerfCounters::open`. If the kernel multiplexes more counters than the hardware has, the counts are extrapolated from the fraction of the time they ran.
+
+      @endrst
+   */
+  class PerfCounters {
+    public:
+      /// @brief The counters read
+      enum Counter { Cycles = 0, Instructions, LLCMisses, BranchMisses, nCounters };
+      typedef std::array<unsigned long long, nCounters> Values;
+
+      /**
+          @brief RAII helper that adds the counts during its lifetime to a profiler
+
+          An inactive scope does nothing, which allows the caller to keep the instrumentation in place when the counters are disabled.
+       */
+      class Scope {
+        public:
+          Scope(PerfCounters& counters, bool active = true) : m_counters(active ? &counters : nullptr) { if(m_counters) m_start = read(); }
+          Scope(Scope&& other) : m_counters(other.m_counters), m_start(other.m_start) { other.m_counters = nullptr; }
+          ~Scope() { if(m_counters) m_counters->add(m_start, read()); }
+          Scope(const Scope&) = delete;
+          Scope& operator=(const Scope&) = delete;
+          Scope& operator=(Scope&&) = delete;
+        private:
+          PerfCounters* m_counters;
+          Values m_start;
+      };
+
+      /**
+          @brief Open the counters of the job, if not done yet
+          @returns The names of the counters that could not be opened, empty if all of them are available
+       */
+      static std::string open();
+      /**
+          @brief Open the counters again for this process, after a ``fork()``, if they were opened before
+
+          The descriptors inherited from the parent process keep reading the counters of the parent, so a forked process closes them and counts itself from here on. The counts of the scopes spanning the fork are dropped.
+       */
+      static void reopen();
+      /// @brief The current values of the counters, zero for those not available
+      static Values read();
+
+      /// @brief Number of completed scopes
+      unsigned long long calls() const { return m_calls; }
+      /// @brief Counts of all the completed scopes
+      const Values& total() const { return m_total; }
+      /// @brief Instructions per cycle, ``0`` if the cycles are not counted
+      double ipc() const { return m_total[Cycles] ? static_cast<double>(m_total[Instructions])/m_total[Cycles] : 0.; }
+
+      /// @brief Name of a counter, as used in the histogram labels
+      static const char* name(Counter counter);
+
+      /**
+          @brief Build a histogram summarising this profiler
+          @param name   The name (and title) of the histogram
+
+          The bins are labelled ``calls``, ``cycles``, ``instructions``, ``llc_misses``, ``branch_misses`` and ``ipc``. The caller owns the histogram.
+       */
+      TH1D* makeHist(const std::string& name) const;
+
+    private:
+      void add(const Values& start, const Values& stop);
+
+      unsigned long long m_calls = 0;
+      Values m_total = {{0, 0, 0, 0}};
+  };
+
+}
+#endif
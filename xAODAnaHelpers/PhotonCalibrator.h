@@ -62,6 +62,8 @@ public:
   std::string m_esModel = "es2017_R21_v1";
   std::string m_decorrelationModel = "";
   int m_randomRunNumber = -1;
+  /// @brief Name under which the EgammaCalibrationAndSmearingTool is shared with the other egamma calibrators setting the same name. The first one to initialize configures the tool, the others reuse it as it is.
+  std::string m_sharedCalibToolName = "";
 
   /** @brief To read PID decision from DAOD, rather than recalculate with tool */
   bool           m_readIDFlagsFromDerivation = false;
@@ -77,6 +79,8 @@ private:
 
   // tools
   CP::EgammaCalibrationAndSmearingTool* m_EgammaCalibrationAndSmearingTool = nullptr; //!
+  /// @brief The calibration tool was created, and is deleted, by this algorithm
+  bool m_ownsCalibTool = false; //!
   asg::AnaToolHandle<CP::IIsolationCorrectionTool> m_isolationCorrectionTool_handle  {"CP::IsolationCorrectionTool/IsolationCorrectionTool", this}; //!
 
   ElectronPhotonShowerShapeFudgeTool*   m_photonFudgeMCTool = nullptr; //!
@@ -3,6 +3,7 @@
 
 // algorithm wrapper
 #include <xAODAnaHelpers/Algorithm.h>
+#include <xAODAnaHelpers/IsolationDecisions.h>
 #include <xAODTracking/VertexContainer.h>
 #include <xAODEgamma/PhotonContainer.h>
 
@@ -36,6 +37,8 @@ public:
   int        	 m_pass_min = -1;
   /** maximum number of objects passing cuts */
   int        	 m_pass_max = -1;
+  /** stop evaluating photons once the event is rejected by m_pass_min/m_pass_max, the remaining ones are decorated with -1 like for m_nToProcess */
+  bool m_stopWhenRejected = false;
   /** require pT < pt_max */
   float      	 m_pT_max = 1e8;
   /** require pT > pt_min */
@@ -89,6 +92,8 @@ private:
 
 
   std::vector<std::string> m_IsoKeys;  //!
+  xAH::IsolationDecisions m_isoDecisions; //!
+  int m_passSelBit = -1; //!  /* the bit of passSel in xAH::SelectionFlags */
 
   /* tools */
   CP::IsolationSelectionTool* m_IsolationSelectionTool = nullptr; //!
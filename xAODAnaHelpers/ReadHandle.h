@@ -0,0 +1,141 @@
+#ifndef xAODAnaHelpers_ReadHandle_H
+#define xAODAnaHelpers_ReadHandle_H
+
+// Infrastructure include(s):
+#include "xAODRootAccess/TEvent.h"
+#include "xAODRootAccess/TStore.h"
+#include "xAODRootAccess/TVirtualEvent.h"
+
+#include <string>
+
+// for StatusCode::isSuccess
+#include "AsgTools/StatusCode.h"
+
+// messaging includes
+#include <AsgTools/MsgStream.h>
+
+namespace xAH {
+
+  /**
+      @rst
+          A cached, per-algorithm handle to a container living in either ``xAOD::TStore`` or ``xAOD::TEvent``.
+
+          :cpp:func:`HelperFunctions::retrieve` searches both stores by name every time it is called. For containers retrieved on every event under a fixed name (``EventInfo``, primary vertices, the nominal input collection, ...) the handle resolves the location once and afterwards fetches the object with a single lookup:
+
+          - objects in ``xAOD::TStore`` are fetched directly from the store,
+          - objects in ``xAOD::TEvent`` are fetched through their pre-computed hashed key, avoiding the string-to-key conversion. As ``xAOD::TStore`` takes precedence, it is checked first for an object of the same name.
+
+          If the cached lookup fails (e.g. because the object moved from one store to the other), a full search following the same order as :cpp:func:`HelperFunctions::retrieve` (TStore first, then TEvent) is performed and the cache is updated. An object found in neither store is reported as an error.
+
+          Example Usage::
+
+              // in the class declaration
+              xAH::ReadHandle<xAOD::EventInfo> m_eventInfoHandle; //!
+
+              // in initialize()
+              ANA_CHECK( m_eventInfoHandle.initialize(m_eventInfoContainerName, m_event, m_store) );
+
+              // in execute()
+              const xAOD::EventInfo* eventInfo(nullptr);
+              ANA_CHECK( m_eventInfoHandle.retrieve(eventInfo, msg()) );
+
+          .. note:: Only ``const`` access is provided. Use :cpp:func:`HelperFunctions::retrieve` to get a modifiable object out of the ``xAOD::TStore``.
+
+      @endrst
+   */
+  template <typename T>
+  class ReadHandle {
+    public:
+      ReadHandle() = default;
+
+      /**
+          @brief Set up the handle
+          @param name   the name of the object to look up
+          @param event  the TEvent, usually wk()->xaodEvent(). Set to 0 to not search TEvent.
+          @param store  the TStore, usually wk()->xaodStore(). Set to 0 to not search TStore.
+       */
+      StatusCode initialize(const std::string& name, xAOD::TEvent* event, xAOD::TStore* store){
+        if((event == nullptr) && (store == nullptr)) return StatusCode::FAILURE;
+        m_name     = name;
+        m_event    = event;
+        m_store    = store;
+        m_hash     = event ? event->getHash(name) : 0;
+        m_location = Location::Unknown;
+        return StatusCode::SUCCESS;
+      }
+
+      /**
+          @brief Retrieve the object for the current event
+          @param cont   pass in a pointer to the object to store the retrieved container in
+          @param msg    the MsgStream object with appropriate level for debugging
+       */
+      StatusCode retrieve(const T*& cont, MsgStream& msg){
+        cont = nullptr;
+        switch(m_location){
+          case Location::Store:
+            if(m_store->retrieve(cont, m_name).isSuccess()) return StatusCode::SUCCESS;
+            break;
+          case Location::EventHash:
+            if(inStore()) break;
+            if(static_cast<xAOD::TVirtualEvent*>(m_event)->retrieve(cont, m_hash, true) && cont) return StatusCode::SUCCESS;
+            break;
+          case Location::EventName:
+            if(inStore()) break;
+            if(m_event->retrieve(cont, m_name).isSuccess()) return StatusCode::SUCCESS;
+            break;
+          case Location::Unknown:
+            break;
+        }
+        return resolve(cont, msg);
+      }
+
+      /// @brief Return true if the object can be found for the current event
+      bool isAvailable(){
+        return (m_store && m_store->contains<T>(m_name)) || (m_event && m_event->contains<T>(m_name));
+      }
+
+      /// @brief The name of the object looked up by this handle
+      const std::string& name() const { return m_name; }
+
+    private:
+      enum class Location { Unknown, Store, EventHash, EventName };
+
+      /// @brief Whether ``xAOD::TStore`` holds the object, which then hides the one of ``xAOD::TEvent``
+      bool inStore() const { return m_store && m_store->contains<T>(m_name); }
+
+      /// @brief Full search, updating the cached location on success
+      StatusCode resolve(const T*& cont, MsgStream& msg){
+        m_location = Location::Unknown;
+        cont = nullptr;
+        if((m_event == nullptr) && (m_store == nullptr)){
+          msg << MSG::ERROR << "in ReadHandle(" << m_name << "): handle was not initialized. Cannot retrieve anything." << endmsg;
+          return StatusCode::FAILURE;
+        }
+        if(inStore()){
+          if(!m_store->retrieve(cont, m_name).isSuccess()) return StatusCode::FAILURE;
+          m_location = Location::Store;
+          msg << MSG::DEBUG << "in ReadHandle(" << m_name << "): found inside xAOD::TStore" << endmsg;
+        } else if((m_event != nullptr) && (m_event->contains<T>(m_name))){
+          if(static_cast<xAOD::TVirtualEvent*>(m_event)->retrieve(cont, m_hash, true) && cont){
+            m_location = Location::EventHash;
+          } else {
+            if(!m_event->retrieve(cont, m_name).isSuccess()) return StatusCode::FAILURE;
+            m_location = Location::EventName;
+          }
+          msg << MSG::DEBUG << "in ReadHandle(" << m_name << "): found inside xAOD::TEvent" << endmsg;
+        } else {
+          msg << MSG::ERROR << "in ReadHandle(" << m_name << "): not found in xAOD::TStore nor xAOD::TEvent" << endmsg;
+          return StatusCode::FAILURE;
+        }
+        return StatusCode::SUCCESS;
+      }
+
+      std::string m_name;
+      xAOD::TEvent* m_event = nullptr;
+      xAOD::TStore* m_store = nullptr;
+      xAOD::TVirtualEvent::sgkey_t m_hash = 0;
+      Location m_location = Location::Unknown;
+  };
+
+}
+#endif
@@ -0,0 +1,41 @@
+#ifndef xAODAnaHelpers_RunContext_H
+#define xAODAnaHelpers_RunContext_H
+
+#include "xAODEventInfo/EventInfo.h"
+
+namespace xAH {
+
+  /**
+      @rst
+          The run-dependent quantities of the event the efficiency correctors choose their configuration from, read from the ``xAOD::EventInfo`` once per event instead of once per corrector (or per object).
+
+          :cpp:class:`BasicEventSelection` publishes it right after the pile-up reweighting decorated the ``RandomRunNumber`` and the corrected :math:`\mu`. Any later algorithm gets the same context with :cpp:func:`xAH::RunContext::get`; if nothing published one for the event (no :cpp:class:`BasicEventSelection` in the job) the first call builds it.
+
+          .. code-block:: c++
+
+              const xAH::RunContext& runContext = xAH::RunContext::get(*eventInfo);
+              if(runContext.year == 2015) ...
+
+      @endrst
+   */
+  struct RunContext {
+    /// @brief ``RandomRunNumber`` of the pile-up reweighting for simulation, the run number for data, 0 if not known
+    unsigned int randomRunNumber = 0;
+    /// @brief Data-taking year of ``randomRunNumber`` (runs after 2018 count as 2018), 0 if the run is not known
+    int year = 0;
+    /// @brief Index of ``year`` among the Run 2 years, 0 for 2015 to 3 for 2018, -1 if the run is not known
+    int periodIndex = -1;
+    /// @brief ``corrected_averageInteractionsPerCrossing`` if it is decorated, else ``averageInteractionsPerCrossing``
+    float mu = -1.;
+
+    /// @brief Build the context of ``eventInfo`` and make it the one of the event
+    static const RunContext& publish(const xAOD::EventInfo& eventInfo);
+    /// @brief The context of the event of ``eventInfo``, published if it was not yet
+    static const RunContext& get(const xAOD::EventInfo& eventInfo);
+
+    /// @brief Data-taking year of a run number, 0 for run 0
+    static int yearOfRun(unsigned int run);
+  };
+
+}
+#endif
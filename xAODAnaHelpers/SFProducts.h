@@ -0,0 +1,32 @@
+#ifndef xAODAnaHelpers_SFProducts_H
+#define xAODAnaHelpers_SFProducts_H
+
+#include <vector>
+
+namespace xAH {
+
+  /**
+      @rst
+          Running products, one per variation, of the per-object scale-factor vectors written by the efficiency correctors.
+
+          The products are kept in one buffer which is reused from event to event: call :cpp:func:`xAH::SFProducts::reset` at the start of each event, then :cpp:func:`xAH::SFProducts::multiply` once per object.
+
+      @endrst
+   */
+  class SFProducts {
+    public:
+      /// @brief Start a new event with ``nVariations`` products, all at 1
+      void reset(std::size_t nVariations);
+
+      /// @brief Multiply in the SF vector of one object, one entry per variation
+      void multiply(const std::vector<float>& sfs);
+
+      /// @brief The products, in the order of the variations of the SF vectors
+      const std::vector<float>& products() const { return m_products; }
+
+    private:
+      std::vector<float> m_products;
+  };
+
+}
+#endif
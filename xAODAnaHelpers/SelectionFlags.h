@@ -0,0 +1,74 @@
+#ifndef xAODAnaHelpers_SelectionFlags_H
+#define xAODAnaHelpers_SelectionFlags_H
+
+#include <AthContainers/AuxElement.h>
+
+#include <string>
+#include <vector>
+
+class TTree;
+
+namespace xAH {
+
+  /**
+      @rst
+          The selection decisions of an object (``passSel``, ``passOR``, the ``isIsolated_<WP>`` working points, the b-tagging decisions...) packed in one 64-bit word, the ``xAH_selectionFlags`` decoration, next to the ``char`` decorations of each decision.
+
+          Each decision gets a fixed bit the first time its name is seen by :cpp:func:`xAH::SelectionFlags::bit`, in ``initialize()`` of the algorithm deciding it, so the bits are the same for all the events of the job. The same name shares the bit across object types. :cpp:func:`HelperFunctions::makeSubsetCont` tests the word instead of looking up the ``char`` decoration when the flag has a bit that was decided for the object (see :cpp:func:`xAH::SelectionFlags::isDecided`), and the ntuple containers write the word with the ``selectionFlags`` detail. The name of each bit is stored once per tree by :cpp:func:`xAH::SelectionFlags::writeFlags`.
+
+          .. code-block:: c++
+
+              // in initialize()
+              m_passSelBit = xAH::SelectionFlags::bit("passSel");
+
+              // for each object
+              xAH::SelectionFlags::set( *muon, m_passSelBit, passSel );
+              if ( xAH::SelectionFlags::test( *muon, xAH::SelectionFlags::mask(m_passSelBit) ) ) ...
+
+      @endrst
+   */
+  namespace SelectionFlags {
+    /// @brief The bit of flag ``flag``, registering it if needed. Returns -1 if all bits are taken.
+    int bit(const std::string& flag);
+
+    /// @brief The bit of flag ``flag``, -1 if it was never registered
+    int find(const std::string& flag);
+
+    /// @brief The flag of bit ``bit``
+    const std::string& flag(unsigned int bit);
+
+    /// @brief The mask of bit ``bit``, 0 for -1
+    inline unsigned long long mask(int bit){ return bit < 0 ? 0ULL : 1ULL << bit; }
+
+    /// @brief Whether ``obj`` has a flag word
+    bool isAvailable(const SG::AuxElement& obj);
+
+    /// @brief The flag word of ``obj``, 0 if it has none
+    unsigned long long word(const SG::AuxElement& obj);
+
+    /// @brief Whether all the flags of ``mask`` are set for ``obj``
+    inline bool test(const SG::AuxElement& obj, unsigned long long mask){ return (word(obj) & mask) == mask; }
+
+    /// @brief Set or clear the flag of bit ``bit`` for ``obj``, and mark it decided. Does nothing for -1
+    void set(const SG::AuxElement& obj, int bit, bool pass);
+
+    /// @brief Clear the flag of bit ``bit`` for ``obj`` and mark it undecided, for objects whose ``char`` decoration is -1 (not evaluated). Does nothing for -1
+    void setUndecided(const SG::AuxElement& obj, int bit);
+
+    /**
+        @rst
+            Whether all the flags of ``mask`` were decided for ``obj`` with :cpp:func:`xAH::SelectionFlags::set`, i.e. whether its flag word holds the same decisions as their ``char`` decorations. This is kept in a second word, the ``xAH_selectionFlagsDecided`` decoration, so flags left alone by the algorithms that saw the object, or marked with :cpp:func:`xAH::SelectionFlags::setUndecided`, are not mistaken for failed ones.
+
+        @endrst
+     */
+    bool isDecided(const SG::AuxElement& obj, unsigned long long mask);
+
+    /// @brief Store the flags registered so far, in order of their bits, in the user info of ``tree`` as the ``selectionFlags`` array of strings
+    void writeFlags(TTree* tree);
+
+    /// @brief The flags stored by :cpp:func:`xAH::SelectionFlags::writeFlags` in ``tree`` (or the first tree of a chain), empty if there are none
+    std::vector<std::string> readFlags(TTree* tree);
+  }
+
+}
+#endif
@@ -0,0 +1,46 @@
+#ifndef xAODAnaHelpers_SystematicBlock_H
+#define xAODAnaHelpers_SystematicBlock_H
+
+#include <TH2F.h>
+
+#include <string>
+#include <vector>
+
+namespace xAH {
+
+  /**
+      @rst
+          The distribution of one observable for many systematic variations, stored as one dense block of bin contents (variation :math:`\times` bin) instead of one ``TH1`` per variation.
+
+          Variations are added as they are seen with :cpp:func:`xAH::SystematicBlock::resize`, the block is converted to a ``TH2F`` (observable on x, one labelled y bin per variation) by :cpp:func:`xAH::SystematicBlock::makeHist` at the end of the job.
+
+      @endrst
+   */
+  class SystematicBlock {
+    public:
+      SystematicBlock(const std::string& name, const std::string& xlabel, int nbins, double xlow, double xhigh);
+
+      /// @brief Make room for ``nVariations`` variations
+      void resize(unsigned int nVariations);
+
+      /// @brief Fill ``value`` for variation ``variation``, using the binning conventions of ``TAxis::FindFixBin``
+      void fill(unsigned int variation, double value, double weight);
+
+      /// @brief Create the histogram holding the block, the caller owns it. ``variations`` labels the y bins.
+      TH2F* makeHist(const std::string& prefix, const std::vector<std::string>& variations) const;
+
+    private:
+      std::string m_name;
+      std::string m_xlabel;
+      int m_nbins;
+      double m_xlow;
+      double m_xhigh;
+      double m_binsPerUnit;
+      unsigned int m_nVariations;
+      /// @brief ``[variation*(nbins+2) + bin]``, including under- and overflow
+      std::vector<double> m_sumw;
+      std::vector<double> m_sumw2;
+  };
+
+}
+#endif
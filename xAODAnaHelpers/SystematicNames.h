@@ -0,0 +1,99 @@
+#ifndef xAODAnaHelpers_SystematicNames_H
+#define xAODAnaHelpers_SystematicNames_H
+
+#include <array>
+#include <atomic>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+namespace xAH {
+
+  /**
+      @rst
+          Job-wide registry that interns systematic names into small integer IDs.
+
+          Algorithms publish the systematics they ran as ``std::vector<std::string>`` in the ``xAOD::TStore``. Downstream algorithms that need to merge or look up those lists can intern the names once and work with the resulting IDs, e.g. through a :cpp:class:`xAH::SystematicIDSet`, instead of comparing strings.
+
+          The nominal case (empty name) always has ID :cpp:member:`xAH::SystematicNames::nominal`. IDs are stable for the lifetime of the job and shared by all algorithms::
+
+              auto& registry = xAH::SystematicNames::instance();
+              xAH::SystematicNames::ID id = registry.intern("JET_JER_SINGLE_NP__1up");
+              const std::string& name = registry.name(id);
+
+          Only :cpp:func:`intern` takes a lock; :cpp:func:`name` and :cpp:func:`size` do not, so they can be called once per object and event.
+
+      @endrst
+   */
+  class SystematicNames {
+    public:
+      typedef unsigned int ID;
+
+      /// @brief ID of the nominal (empty) systematic
+      static const ID nominal = 0;
+
+      /// @brief The registry shared by all algorithms in the job
+      static SystematicNames& instance();
+
+      /// @brief Return the ID of ``name``, registering it if it was not seen before
+      ID intern(const std::string& name);
+
+      /// @brief Intern all names of a list, preserving the order
+      std::vector<ID> intern(const std::vector<std::string>& names);
+
+      /// @brief Return the name registered under ``id``, without locking. The reference stays valid for the lifetime of the job.
+      const std::string& name(ID id) const;
+
+      /// @brief Number of names registered so far
+      std::size_t size() const;
+
+      SystematicNames(const SystematicNames&) = delete;
+      SystematicNames& operator=(const SystematicNames&) = delete;
+
+    private:
+      SystematicNames();
+
+      /// @brief the names are stored in chunks that are never moved, so that references handed out by name() are never invalidated
+      static const std::size_t s_chunkSize = 256;
+      static const std::size_t s_maxChunks = 4096;
+
+      /// @brief Append ``name`` as the next ID; only called under the lock
+      ID append(const std::string& name);
+
+      std::mutex m_mutex;
+      std::unordered_map<std::string, ID> m_ids;
+      std::array<std::unique_ptr<std::string[]>, s_maxChunks> m_chunks;
+      /// @brief number of names, published after the name (and its chunk) was written so that readers need no lock
+      std::atomic<std::size_t> m_size;
+  };
+
+  /**
+      @rst
+          A set of interned systematics (see :cpp:class:`xAH::SystematicNames`) with constant-time insertion and lookup.
+
+      @endrst
+   */
+  class SystematicIDSet {
+    public:
+      /// @brief Add ``id`` to the set. Returns false if it was already there.
+      bool insert(SystematicNames::ID id){
+        if(id >= m_bits.size()) m_bits.resize(id+1, false);
+        if(m_bits[id]) return false;
+        m_bits[id] = true;
+        return true;
+      }
+
+      /// @brief Return true if ``id`` is part of the set
+      bool contains(SystematicNames::ID id) const { return id < m_bits.size() && m_bits[id]; }
+
+      /// @brief Remove all entries
+      void clear(){ m_bits.clear(); }
+
+    private:
+      std::vector<bool> m_bits;
+  };
+
+}
+#endif
@@ -8,6 +8,8 @@
 #ifndef xAODAnaHelpers_TauEfficiencyCorrector_H
 #define xAODAnaHelpers_TauEfficiencyCorrector_H
 
+#include <memory>
+
 // CP interface includes
 #include "PATInterfaces/SystematicRegistry.h"
 #include "PATInterfaces/SystematicSet.h"
@@ -74,6 +76,13 @@ private:
   int m_numObject;        //!
 
   std::vector<CP::SystematicSet> m_systList;  //!
+  /// @brief The names of :cpp:member:`TauEfficiencyCorrector::m_systList`, and of its nominal entries alone (for systematically varied input taus)
+  std::vector<std::string> m_systNames;         //!
+  std::vector<std::string> m_nominalSystNames;  //!
+
+  /// @brief The per-tau SF and systematic names decorations, set up once in ``initialize()``
+  std::unique_ptr< SG::AuxElement::Decorator< std::vector<float> > >       m_sfDecorator;       //!
+  std::unique_ptr< SG::AuxElement::Decorator< std::vector<std::string> > > m_sfSysNamesDecorator; //!
 
   // tools
   asg::AnaToolHandle<CP::IPileupReweightingTool> m_pileup_tool_handle{"CP::PileupReweightingTool/Pileup"}; //!
@@ -9,6 +9,7 @@
 
 // algorithm wrapper
 #include "xAODAnaHelpers/Algorithm.h"
+#include "xAODAnaHelpers/ParticleKinematics.h"
 
 class TauJetMatching : public xAH::Algorithm
 {
@@ -29,12 +30,19 @@ public:
 
   std::string    m_inJetContainerName = "";
   float          m_DeltaR = 0.2;
+  /* match taus and jets with HelperFunctions::matchGreedyDeltaR2 instead of letting each jet pick its nearest tau */
+  bool           m_greedyMatching = false;
 
 private:
 
   int m_numEvent;           //!
   int m_numObject;          //!
 
+  xAH::ParticleKinematics m_jetKinematics; //!
+  xAH::ParticleKinematics m_tauKinematics; //!
+  std::vector<float> m_dR2;                //!
+  std::vector<int> m_tauToJet;             //!
+
   // variables that don't get filled at submission time should be
   // protected from being send from the submission node to the worker
   // node (done by the //!)
@@ -54,6 +54,8 @@ public:
   int            m_pass_min = -1;
   /* maximum number of objects passing cuts */
   int            m_pass_max = -1;
+  /* stop evaluating taus once the event is rejected by m_pass_min/m_pass_max, the remaining ones are decorated with -1 like for m_nToProcess */
+  bool m_stopWhenRejected = false;
   /* path to config file for the TauSelectionTool */
 
   // IMPORTANT: if no working point is specified the one in this configuration will be used
@@ -70,7 +72,10 @@ public:
    * A comma-separated string w/ all the HLT 
    * single muon trigger chains for which you want 
    * to perform the matching. If left empty (as it is by default), 
-   * no trigger matching will be attempted at all 
+   * no trigger matching will be attempted at all.
+   * The results are stored in the trigMatchTestedBitsTau and
+   * isTrigMatchedBitsTau decorations (see xAH::TrigMatchBits),
+   * not in an isTrigMatchedMapTau map anymore.
    */
   
   std::string    m_singleTauTrigChains = "";
@@ -86,6 +91,7 @@ public:
 
 private:
 
+  int m_passSelBit = -1;  //!  /* the bit of the selection decision in xAH::SelectionFlags */
   int m_numEvent;           //!
   int m_numObject;          //!
   int m_numEventPass;       //!
@@ -109,6 +115,7 @@ private:
   // tools
   std::vector<std::string>            m_singleTauTrigChainsList; //!  /* contains all the HLT trigger chains tokens extracted from m_singleTauTrigChains */
   std::vector<std::string>            m_diTauTrigChainsList;     //!  /* contains all the HLT trigger chains tokens extracted from m_diTauTrigChains */
+  std::vector<unsigned int>           m_singleTauTrigChainsBits; //!  /* the bit of each chain of m_singleTauTrigChainsList in the trigger matching decorations */
   asg::AnaToolHandle<TauAnalysisTools::ITauSelectionTool> m_tauSelTool_handle{"TauAnalysisTools::TauSelectionTool/TauSelectionTool",     this}; //!
   asg::AnaToolHandle<Trig::TrigDecisionTool>              m_trigDecTool_handle{"Trig::TrigDecisionTool/TrigDecisionTool"    }; //!
   asg::AnaToolHandle<Trig::IMatchingTool>                 m_trigTauMatchTool_handle; //!
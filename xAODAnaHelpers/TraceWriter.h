@@ -0,0 +1,109 @@
+#ifndef xAODAnaHelpers_TraceWriter_H
+#define xAODAnaHelpers_TraceWriter_H
+
+#include <chrono>
+#include <fstream>
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace xAOD {
+  class TEvent;
+  class TStore;
+}
+
+namespace xAH {
+
+  /**
+      @rst
+          Writes a timeline of the event loop in the Chrome trace event format, which can be opened in ``chrome://tracing`` or https://ui.perfetto.dev . Every traced algorithm gives one span per event (:cpp:class:`xAH::TraceWriter::Span`, made by :cpp:func:`xAH::Algorithm::beginEvent`), carrying the run and event numbers, the entry, and the sizes of the particle containers listed in :cpp:func:`xAH::TraceWriter::open` at the end of the algorithm.
+
+          The spans of an event are kept until the next event starts, and written only for one event every ``everyNEvents``, and for any event whose traced algorithms took longer than ``slowEventMs`` together. Summary tables average the pathological events away, the trace shows them with the inputs that triggered them.
+
+          There is one trace per job: all the algorithms with :cpp:member:`xAH::Algorithm::m_traceFile` set write to the file opened by the first of them.
+
+      @endrst
+   */
+  class TraceWriter {
+    public:
+      /// @brief The trace of the job
+      static TraceWriter& instance();
+
+      /// @brief RAII helper that adds a span lasting its lifetime to the trace of the current event
+      class Span {
+        public:
+          Span(const std::string* name = nullptr, const std::string* category = nullptr) : m_name(name), m_category(category) {
+            if(m_name) m_start = std::chrono::steady_clock::now();
+          }
+          Span(Span&& other) : m_name(other.m_name), m_category(other.m_category), m_start(other.m_start) { other.m_name = nullptr; }
+          ~Span() { end(); }
+          /// @brief Add the span to the trace now instead of at its destruction, once
+          void end() {
+            if(m_name) TraceWriter::instance().addSpan(*m_name, *m_category, m_start, std::chrono::steady_clock::now());
+            m_name = nullptr;
+          }
+          Span(const Span&) = delete;
+          Span& operator=(const Span&) = delete;
+          Span& operator=(Span&&) = delete;
+        private:
+          const std::string* m_name;
+          const std::string* m_category;
+          std::chrono::steady_clock::time_point m_start;
+      };
+
+      /**
+          @brief Open the trace file, if no trace is open yet
+          @param fileName       The JSON file to write
+          @param everyNEvents   Write one event out of this many, ``0`` to only write the slow events
+          @param slowEventMs    Also write any event longer than this, in milliseconds, ``0`` for none
+          @param containers     Space-separated names of the particle containers (in the ``xAOD::TStore`` or the input) whose sizes are added to the spans
+          @returns ``false`` if a trace to another file is already open, or the file cannot be written
+       */
+      bool open(const std::string& fileName, unsigned int everyNEvents, double slowEventMs, const std::string& containers);
+      /// @brief Whether a trace is being written
+      bool isOpen() const { return m_file.is_open(); }
+      /// @brief The file of the trace
+      const std::string& fileName() const { return m_fileName; }
+
+      /// @brief Start a new event if ``(entry, fileId)`` is not the event of the previous call, writing the spans of the previous one if it is kept
+      void newEvent(long long entry, const void* fileId, xAOD::TEvent* event, xAOD::TStore* store);
+
+      /// @brief Write the last event and close the file. Later calls do nothing
+      void close();
+
+      /// @brief Number of events written to the trace
+      unsigned long long eventsWritten() const { return m_eventsWritten; }
+
+    private:
+      TraceWriter() = default;
+      ~TraceWriter() { close(); }
+
+      void addSpan(const std::string& name, const std::string& category,
+                   std::chrono::steady_clock::time_point start, std::chrono::steady_clock::time_point stop);
+      /// @brief Write the spans of the current event if it is kept, and forget them
+      void flushEvent();
+
+      std::ofstream m_file;
+      std::string m_fileName;
+      bool m_firstSpan = true;
+      unsigned int m_everyNEvents = 0;
+      double m_slowEventMs = 0.;
+      std::vector<std::string> m_containers;
+      std::chrono::steady_clock::time_point m_origin;
+
+      // the current event
+      long long m_entry = -1;
+      const void* m_fileId = nullptr;
+      unsigned long long m_events = 0;
+      unsigned long long m_eventsWritten = 0;
+      unsigned int m_runNumber = 0;
+      unsigned long long m_eventNumber = 0;
+      xAOD::TEvent* m_event = nullptr;
+      xAOD::TStore* m_store = nullptr;
+      double m_eventMs = 0.;
+      /// @brief The spans of the current event, already formatted
+      std::vector<std::string> m_spans;
+  };
+
+}
+#endif
@@ -61,6 +61,8 @@ namespace xAH {
       std::vector<unsigned char>* m_numberOfSCTSharedHits;
       std::vector<unsigned char>* m_numberOfTRTHits;
       std::vector<unsigned char>* m_numberOfTRTOutliers;
+      // numbers with packedHits: all the hit counts of a track in one word
+      std::vector<ULong64_t>* m_hitsPacked;
       std::vector<float>* m_phi;
       std::vector<float>* m_qOverP;
       std::vector<float>* m_theta;
@@ -2,6 +2,8 @@
 #define xAODAnaHelpers_TrackHists_H
 
 #include "xAODAnaHelpers/HistogramManager.h"
+#include "xAODAnaHelpers/TrackParameters.h"
+#include "xAODAnaHelpers/TrackSummary.h"
 #include <xAODTracking/TrackParticleContainer.h>
 #include <xAODTracking/Vertex.h>
 #include <xAODEventInfo/EventInfo.h>
@@ -17,6 +19,10 @@ class TrackHists : public HistogramManager
     StatusCode initialize();
     StatusCode execute( const xAOD::TrackParticleContainer* tracks,  const xAOD::Vertex *pvx, float eventWeight,  const xAOD::EventInfo* eventInfo = 0 );
     StatusCode execute( const xAOD::TrackParticle* track,            const xAOD::Vertex *pvx, float eventWeight,  const xAOD::EventInfo* eventInfo = 0);
+    /// @brief Fill the histograms of the tracks of the container of a summary shared with other histogram classes, filled with the same ``pvx``
+    StatusCode execute( const xAH::TrackSummary& summary,            const xAOD::Vertex *pvx, float eventWeight,  const xAOD::EventInfo* eventInfo = 0);
+    /// @brief Fill the histograms of ``track`` from its already computed parameters w.r.t. the primary vertex
+    StatusCode execute( const xAOD::TrackParticle* track,            const xAOD::Vertex *pvx, const xAH::TrackParameters& params, float eventWeight,  const xAOD::EventInfo* eventInfo = 0);
     using HistogramManager::book; // make other overloaded versions of book() to show up in subclass
     using HistogramManager::execute; // overload
 
@@ -31,6 +37,9 @@ class TrackHists : public HistogramManager
     bool m_fillVsLumi; //!
 
   private:
+    /// @brief summary of the tracks for the container execute
+    xAH::TrackSummary m_summary; //!
+
     // Histograms
     TH1F* m_trk_n; //!
     TH1F* m_trk_n_l; //!
@@ -18,6 +18,8 @@ public:
 
 private:
   TrackHists* m_plots = nullptr; //!
+  /// @brief the tracks of the event, summarized once
+  xAH::TrackSummary m_trackSummary; //!
 
   // variables that don't get filled at submission time should be
   // protected from being send from the submission node to the worker
@@ -0,0 +1,39 @@
+#ifndef xAODAnaHelpers_TrackParameters_H
+#define xAODAnaHelpers_TrackParameters_H
+
+#include <xAODTracking/TrackParticle.h>
+#include <xAODTracking/Vertex.h>
+
+namespace xAH {
+
+  /**
+      @rst
+          The impact parameters and fit quality of a track w.r.t. a primary vertex, computed once per track.
+
+          :cpp:class:`TracksInJetHists` fills its own histograms and the ones of its :cpp:class:`TrackHists` from the same track. Computing these once means ``z0`` w.r.t. the vertex, the covariance matrix and ``TMath::Prob`` are no longer evaluated separately by each of them::
+
+              const xAH::TrackParameters params(trk, pvx);
+              ANA_CHECK( m_trkPlots->execute(trk, pvx, params, eventWeight, eventInfo) );
+
+      @endrst
+   */
+  struct TrackParameters {
+    TrackParameters(const xAOD::TrackParticle* trk, const xAOD::Vertex* pvx);
+    /// @brief With the z of the primary vertex, see ``HelperFunctions::getPrimaryVertexZ``, computed once for many tracks
+    TrackParameters(const xAOD::TrackParticle* trk, float pvZ);
+
+    float d0;
+    /// @brief :math:`\sqrt{\sigma^2_{d0}}`, 0 if the covariance matrix is not available
+    float d0Err;
+    /// @brief ``z0`` w.r.t. the z of the primary vertex (0 if there is none)
+    float z0;
+    /// @brief :math:`\sqrt{\sigma^2_{z0}}`, 0 if the covariance matrix is not available
+    float z0Err;
+    float sinT;
+    float chi2;
+    float ndof;
+    float chi2Prob;
+  };
+
+}
+#endif
@@ -14,6 +14,7 @@
 
 // algorithm wrapper
 #include "xAODAnaHelpers/Algorithm.h"
+#include "xAODAnaHelpers/CutTable.h"
 
 
 class TrackSelector : public xAH::Algorithm
@@ -41,6 +42,8 @@ public:
   int   m_pass_min = -1;
   /// @brief maximum number of objects passing cuts
   int   m_pass_max = -1;
+  /// @brief stop evaluating tracks once the event is rejected by m_pass_min/m_pass_max, the remaining ones are decorated with -1 like for m_nToProcess
+  bool  m_stopWhenRejected = false;
   /// @brief available: Loose LoosePrimary TightPrimary LooseMuon LooseElectron MinBias HILoose HITight 
   std::string m_cutLevelString = "";
   /// @brief require pT < pt_max
@@ -123,6 +126,15 @@ public:
   /// @brief do track selection on track within jets
   bool m_doTracksInJets = false;
 
+  /// @brief evaluate the most rejecting cuts first, reordering them from the observed rejection (see :cpp:class:`xAH::CutTable`). The selected tracks are the same.
+  bool m_adaptiveCutOrder = false;
+
+  /// @brief record the results of the cuts on the tracks and reuse the ones of a previous TrackSelector with the same or looser/tighter cuts (see :cpp:class:`xAH::CutTable`)
+  bool m_cacheCutResults = false;
+
+  /// @brief the input tracks are expected to be sorted by decreasing pT: once a track is below m_pT_min, the following ones are rejected without evaluating the other cuts. The ordering is checked on every event, and the tracks are evaluated normally if it does not hold.
+  bool m_ptOrderedInput = false;
+
 private:
 
   std::vector<std::string> m_passKeys;
@@ -130,6 +142,13 @@ private:
 
   asg::AnaToolHandle <InDet::IInDetTrackSelectionTool> m_trkSelTool_handle{"InDet::InDetTrackSelectionTool/TrackSelectionTool", this}; //!
 
+  /// @brief the cuts applied by PassCuts, built in initialize
+  xAH::CutTable<xAOD::TrackParticle> m_cutTable; //!
+  /// @brief the vertex of the track being evaluated, used by the InDetTrackSelectionTool cut
+  const xAOD::Vertex* m_cutVertex = nullptr; //!
+  /// @brief the decisions of the cut table for all tracks of the container
+  std::vector<char>   m_decisions; //!
+
   int m_numEvent;         //!
   int m_numObject;        //!
   int m_numEventPass;     //!
@@ -0,0 +1,85 @@
+#ifndef xAODAnaHelpers_TrackSummary_H
+#define xAODAnaHelpers_TrackSummary_H
+
+#include "xAODAnaHelpers/ParticleKinematics.h"
+#include "xAODAnaHelpers/TrackParameters.h"
+#include <xAODTracking/TrackParticleContainer.h>
+#include <xAODTracking/VertexContainer.h>
+
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+namespace xAH {
+
+  /**
+      @rst
+          The per-event quantities of a track container needed by :cpp:class:`TrackHists` and :cpp:class:`VtxHists`, computed once and shared by both: the kinematics, the parameters w.r.t. the primary vertex, the tracks of every vertex as indices into the summary, and the track isolation on demand::
+
+              m_trackSummary.fill(tracks, pvx, vertices);
+              ANA_CHECK( m_trkPlots->execute(m_trackSummary, pvx, eventWeight, eventInfo) );
+              ANA_CHECK( m_vtxPlots->execute(vertices, m_trackSummary, eventWeight) );
+
+          The first :cpp:func:`xAH::TrackSummary::nContainer` entries are the tracks of the container, in its order. Tracks of a vertex that are not in the container are appended after them. The arrays keep their capacity between events, so a long-lived instance is best.
+
+      @endrst
+   */
+  class TrackSummary {
+    public:
+      /// @brief Summarize ``trks`` (may be null) w.r.t. ``pvx``, and the tracks of every vertex of ``vtxs`` if given, replacing the previous content
+      void fill(const xAOD::TrackParticleContainer* trks, const xAOD::Vertex* pvx, const xAOD::VertexContainer* vtxs = nullptr);
+
+      /// @brief Add the tracks of a vertex, returns the index of the vertex for :cpp:func:`xAH::TrackSummary::vertexTracks`
+      unsigned int addVertex(const xAOD::Vertex* vtx);
+
+      /// @brief Number of tracks, the ones of the container and the ones only added through a vertex
+      unsigned int size() const { return tracks.size(); }
+      /// @brief Number of tracks of the container given to :cpp:func:`xAH::TrackSummary::fill`
+      unsigned int nContainer() const { return m_nContainer; }
+
+      /// @brief Number of vertices added
+      unsigned int nVertices() const { return m_nVertices; }
+      /// @brief Indices of the tracks of a vertex, in the order of the vertex
+      const std::vector<unsigned int>& vertexTracks(unsigned int iVtx) const { return m_vertexTracks[iVtx]; }
+
+      /**
+          @rst
+              Scalar sum of the :math:`p_T` (GeV) of the tracks of the container within ``coneSize`` in :math:`\Delta R` and ``z0Cut`` (mm) in ``z0`` of track ``iTrk``, the track itself excluded. Computed on the first call and cached for the event, for one set of cuts.
+
+          @endrst
+       */
+      float isolation(unsigned int iTrk, float z0Cut = 2, float coneSize = 0.2) const;
+
+      std::vector<const xAOD::TrackParticle*> tracks;
+      /// @brief kinematics of the tracks, in MeV like the tracks
+      ParticleKinematics kinematics;
+      /// @brief parameters of the tracks w.r.t. the primary vertex
+      std::vector<TrackParameters> params;
+
+    private:
+      void push_back(const xAOD::TrackParticle* trk);
+
+      float m_pvZ = 0;
+      unsigned int m_nContainer = 0;
+      unsigned int m_nVertices = 0;
+      std::vector<std::vector<unsigned int> > m_vertexTracks;
+      /// @brief position of every track in the summary, to find the tracks of the vertices
+      std::unordered_map<const xAOD::TrackParticle*, unsigned int> m_index;
+
+      /// @brief the container tracks sorted in raw z0, built on the first call of isolation
+      void sortZ0() const;
+      mutable bool m_sorted = false;
+      mutable std::vector<std::pair<float, unsigned int> > m_z0Order;
+      mutable std::vector<float> m_sortedZ0;
+      mutable std::vector<float> m_sortedEta;
+      mutable std::vector<float> m_sortedPhi;
+      mutable std::vector<float> m_sortedPt;
+      mutable std::vector<float> m_dR2;
+      /// @brief isolation of every track, negative until computed, for the cuts below
+      mutable std::vector<float> m_iso;
+      mutable float m_isoZ0Cut = -1;
+      mutable float m_isoConeSize = -1;
+  };
+
+}
+#endif
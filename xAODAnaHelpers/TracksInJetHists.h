@@ -18,14 +18,27 @@ class TracksInJetHists : public HistogramManager
 
     StatusCode initialize();
     StatusCode execute( const xAOD::TrackParticle* trk, const xAOD::Jet* jet,  const xAOD::Vertex *pvx, float eventWeight, const xAOD::EventInfo* eventInfo );
+    /** @brief Fill the histograms for all the tracks of a jet, the jet axis and the z of the primary vertex are computed once for all of them */
+    StatusCode execute( const std::vector<const xAOD::TrackParticle*>& trks, const xAOD::Jet* jet,  const xAOD::Vertex *pvx, float eventWeight, const xAOD::EventInfo* eventInfo );
     using HistogramManager::book; // make other overloaded versions of book() to show up in subclass
     using HistogramManager::execute; // overload
     virtual void record(EL::IWorker* wk);
+    virtual void snapshot(std::vector<TObject*>& objects);
+    virtual bool merge(const TObject* obj);
+    virtual void reset();
 
   protected:
 
   private:
 
+    /** @brief the quantities of the jet and the vertex shared by all its tracks */
+    struct JetAxis {
+      float eta;
+      float phi;
+      float pvZ;
+    };
+    StatusCode fillTrack( const xAOD::TrackParticle* trk, const JetAxis& axis, const xAOD::Vertex *pvx, float eventWeight, const xAOD::EventInfo* eventInfo );
+
     TrackHists*       m_trkPlots; //!
 
     // Histograms
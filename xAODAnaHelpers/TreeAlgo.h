@@ -7,6 +7,9 @@
 
 // algorithm wrapper
 #include "xAODAnaHelpers/Algorithm.h"
+#include "xAODAnaHelpers/ReadHandle.h"
+#include "xAODAnaHelpers/EventFilter.h"
+#include "xAODAnaHelpers/EventIndex.h"
 
 class TreeAlgo : public xAH::Algorithm
 {
@@ -78,6 +81,83 @@ public:
   /// @brief Set to a large negative number, such as -1000000, to ensure that the tree flushes memory after a reasonable amount of time. Otherwise, jobs with a lot of systematics use too much memory.
   int m_autoFlush = 0;
 
+  /**
+    @rst
+      Write only what varies to the systematic trees. The nominal tree is written as usual, each systematic tree gets the basic event information (``AddEvent("")``) plus the collections affected by that systematic: muons, electrons, taus, jets, photons, fat jets and MET, depending on which of the ``m_*SystsVec`` lists it appears in. Trigger, truth, track, vertex and cluster information, and the collections without a systematics list, are only written to the nominal tree.
+
+      The systematic trees are indexed on ``runNumber`` and ``eventNumber`` and are meant to be read as friends of the nominal tree::
+
+          nominal->AddFriend(JET_JER_SINGLE_NP__1up, "JET_JER_SINGLE_NP__1up");
+
+    @endrst
+  */
+  bool m_variedBranchesOnly = false;
+
+  /**
+    @rst
+      In the systematic trees, copy the collections that the systematic does not vary (and the trigger and truth jets, which never vary) from the nominal tree of the same event, instead of filling them again from the same objects. This saves reading the aux data of the unaffected collections once per systematic. Only done for trees of type :cpp:class:`HelpTreeBase` itself: a tree created by an overridden ``createTree`` may fill its own branches in the ``Fill*User()`` methods, which a copy would skip, so its collections are always filled. Has no effect on the collections already left out by :cpp:member:`TreeAlgo::m_variedBranchesOnly`.
+
+    @endrst
+  */
+  bool m_copyNominalBranches = true;
+
+  /**
+    @rst
+      Write a ``(runNumber, eventNumber)`` to entry index of the nominal tree, as the ``EventIndex`` tree next to it (see :cpp:class:`xAH::EventIndex`), to pick single events out of the output without scanning it. The systematic trees have the same entries as the nominal one, unless :cpp:member:`TreeAlgo::m_variedBranchesOnly` is set, in which case they carry their own ``BuildIndex`` index.
+
+    @endrst
+  */
+  bool m_writeEventIndex = false;
+
+  /**
+    @rst
+      ROOT compression settings (``100*algorithm + level``, e.g. ``404`` for LZ4 level 4, ``101`` for ZLIB level 1, ``207`` for LZMA level 7, ``505`` for ZSTD level 5 where supported by ROOT) applied to every branch of the output trees. The default of ``-1`` keeps the settings of the output file. Fast-decompressing settings such as LZ4 make the trees considerably faster to read, at the cost of larger files.
+
+    @endrst
+  */
+  int m_compressionSettings = -1;
+
+  /**
+    @rst
+      Space-separated list of ``pattern:settings`` pairs overriding :cpp:member:`TreeAlgo::m_compressionSettings` for the branches whose name matches the wildcard ``pattern``. The first matching pattern wins, e.g.::
+
+          c.algorithm("TreeAlgo", { ... , "m_branchCompression": "jet_*:404 *_SF_*:207" })
+
+      writes the jet branches with LZ4 level 4 and the scale factors with LZMA level 7.
+
+    @endrst
+  */
+  std::string m_branchCompression = "";
+
+  /// @brief Basket size in bytes for all branches of the output trees. The default of ``0`` keeps the ROOT default.
+  int m_basketSize = 0;
+
+  /// @brief Space-separated list of ``pattern:bytes`` pairs overriding :cpp:member:`TreeAlgo::m_basketSize` for the branches whose name matches the wildcard ``pattern``, e.g. ``"jet_IP3D_*:256000"``. The first matching pattern wins.
+  std::string m_branchBasketSize = "";
+
+  /// @brief Redistribute the basket sizes of each output tree (``TTree::OptimizeBaskets``) once it holds this many entries. The default of ``0`` does not optimize.
+  int m_optimizeBaskets = 0;
+
+  /**
+    @rst
+      Number of threads ROOT may use to compress and write the baskets of the output trees (ROOT implicit multi-threading). With many systematic trees, compression otherwise runs inline in the event loop. The default of ``0`` keeps the writing on the event loop thread. Requires a ROOT build with ``imt`` support, otherwise a warning is printed and the option is ignored.
+
+    @endrst
+  */
+  int m_writerThreads = 0;
+
+  /**
+    @rst
+      Event selection applied before anything is filled into the output trees, evaluated separately for each systematic tree, e.g.::
+
+          c.algorithm("TreeAlgo", { ... , "m_eventFilter": "njet>=2 && jet_pt[0]>100" })
+
+      Collections are referred to by their branch names: ``muon``, ``el``, ``ph``, ``tau`` and the names in :cpp:member:`TreeAlgo::m_jetBranchName` and :cpp:member:`TreeAlgo::m_fatJetBranchName`. See :cpp:class:`xAH::EventFilter` for the syntax. Rejected events cost no filling or compression of the trees. The default of an empty string writes every event.
+
+    @endrst
+  */
+  std::string m_eventFilter = "";
+
 protected:
   std::vector<std::string> m_jetDetails; //!
   std::vector<std::string> m_trigJetDetails; //!
@@ -106,6 +186,65 @@ protected:
   std::vector<std::string> m_vertexDetails; //!
 
   std::map<std::string, HelpTreeBase*> m_trees;            //!
+  /// @brief The trees of ``m_trees`` indexed by the interned systematic name (see :cpp:class:`xAH::SystematicNames`), ``nullptr`` if not created yet
+  std::vector<HelpTreeBase*> m_treesByID;                 //!
+
+  /// @brief The collections written to a tree, see :cpp:member:`TreeAlgo::m_variedBranchesOnly`
+  struct TreeContent {
+    bool full = true;
+    bool muons = true;
+    bool electrons = true;
+    bool taus = true;
+    bool jets = true;
+    bool photons = true;
+    bool fatJets = true;
+    bool met = true;
+  };
+  /// @brief indexed like ``m_treesByID``
+  std::vector<TreeContent> m_treeContents;                 //!
+
+  // cached lookups of the containers that do not depend on the systematic
+  xAH::ReadHandle<xAOD::EventInfo>                           m_eventInfoHandle;        //!
+  xAH::ReadHandle<xAOD::VertexContainer>                     m_primaryVertexHandle;    //!
+  xAH::ReadHandle<xAOD::JetContainer>                        m_truthFatJetHandle;      //!
+  xAH::ReadHandle<xAOD::TauJetContainer>                     m_tauHandle;              //!
+  xAH::ReadHandle<xAOD::MissingETContainer>                  m_METReferenceHandle;     //!
+  xAH::ReadHandle<xAOD::TrackParticleContainer>              m_trackParticlesHandle;   //!
+  std::vector<xAH::ReadHandle<xAOD::JetRoIContainer> >       m_l1JetHandles;           //!
+  std::vector<xAH::ReadHandle<xAOD::JetContainer> >          m_trigJetHandles;         //!
+  std::vector<xAH::ReadHandle<xAOD::JetContainer> >          m_truthJetHandles;        //!
+  std::vector<xAH::ReadHandle<xAOD::TruthParticleContainer> > m_truthParticlesHandles; //!
+  std::vector<xAH::ReadHandle<xAOD::VertexContainer> >       m_vertexHandles;          //!
+  std::vector<xAH::ReadHandle<xAOD::CaloClusterContainer> >  m_clusterHandles;         //!
+
+  /// @brief parsed :cpp:member:`TreeAlgo::m_eventFilter`
+  xAH::EventFilter m_eventFilterExpr; //!
+
+  /// @brief parsed :cpp:member:`TreeAlgo::m_branchCompression`
+  std::vector<std::pair<std::string, int> > m_branchCompressionPatterns; //!
+  /// @brief parsed :cpp:member:`TreeAlgo::m_branchBasketSize`
+  std::vector<std::pair<std::string, int> > m_branchBasketSizePatterns; //!
+  /// @brief output trees waiting for :cpp:member:`TreeAlgo::m_optimizeBaskets`
+  std::map<std::string, TTree*> m_basketsToOptimize; //!
+
+  /// @brief see :cpp:member:`TreeAlgo::m_writeEventIndex`
+  xAH::EventIndex m_eventIndex; //!
+  /// @brief number of events written to the nominal tree
+  Long64_t m_nominalEntries = 0; //!
+
+  /// @brief Apply the compression and basket size settings to all branches of a newly booked tree
+  void applyBranchSettings(TTree* tree) const;
+
+  /// @brief Parse a space-separated list of ``pattern:value`` pairs, returns false on malformed input
+  static bool parseBranchPatterns(const std::string& config, std::vector<std::pair<std::string, int> >& patterns);
+
+  /// @brief Set up one handle per container name
+  template <typename T>
+  StatusCode initializeHandles(std::vector<xAH::ReadHandle<T> >& handles, const std::vector<std::string>& names) {
+    handles.resize(names.size());
+    for(unsigned int i = 0; i < names.size(); ++i) ANA_CHECK( handles.at(i).initialize(names.at(i), m_event, m_store) );
+    return StatusCode::SUCCESS;
+  }
 
 public:
 
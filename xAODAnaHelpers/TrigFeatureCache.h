@@ -0,0 +1,31 @@
+#ifndef xAODAnaHelpers_TrigFeatureCache_H
+#define xAODAnaHelpers_TrigFeatureCache_H
+
+// EL include(s):
+#include <EventLoop/IWorker.h>
+
+// trigger include(s):
+#include "TrigDecisionTool/TrigDecisionTool.h"
+
+#include <string>
+
+namespace xAH {
+
+  /**
+      @rst
+          Per-event cache of the trigger navigation features, shared by all the HLT algorithms of the job.
+
+          Walking the navigation for the features of a chain is expensive, and several instances of :cpp:class:`HLTJetRoIBuilder` and :cpp:class:`HLTJetGetter` (e.g. one per jet collection) often ask for the same chains. The first request for a (trigger decision tool, chain, condition) in an event queries the tool, the others get the same ``Trig::FeatureContainer``. The cache is emptied when the worker moves to another event, identified like :cpp:func:`xAH::Algorithm::eventRejected` does::
+
+              const Trig::FeatureContainer& fc = xAH::TrigFeatureCache::features(wk(), m_trigDecTool_handle.get(), m_trigItem);
+
+      @endrst
+   */
+  class TrigFeatureCache {
+    public:
+      /// @brief ``tdt->features(chain, condition)`` for the current event of ``worker``. The reference is valid until the next event.
+      static const Trig::FeatureContainer& features(const EL::IWorker* worker, Trig::TrigDecisionTool* tdt, const std::string& chain, unsigned int condition = TrigDefs::Physics);
+  };
+
+}
+#endif
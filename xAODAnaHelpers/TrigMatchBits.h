@@ -0,0 +1,64 @@
+#ifndef xAODAnaHelpers_TrigMatchBits_H
+#define xAODAnaHelpers_TrigMatchBits_H
+
+#include <string>
+#include <vector>
+
+class TTree;
+
+namespace xAH {
+
+  /**
+      @rst
+          The trigger matching results of an object, stored as two 64-bit words instead of a ``std::map<std::string,char>``: the bits of the chains which were tested and the bits of the chains which were matched.
+
+          Each chain gets a fixed bit the first time it is seen by :cpp:func:`xAH::TrigMatchBits::bit`, which is shared by all the selectors of the job. At most :cpp:var:`xAH::TrigMatchBits::maxChains` (64) chains can be matched in a job, the selectors fail at initialization with more. The selectors decorate their objects with ``trigMatchTestedBits<Obj>`` and ``isTrigMatchedBits<Obj>`` (e.g. ``isTrigMatchedBitsEl``), the ntuple containers turn them back into the per-chain vectors with :cpp:func:`xAH::TrigMatchBits::unpack`, with the chains in alphabetical order as with the former map.
+
+          With the ``triggerBits`` detail, the containers write the two words themselves instead, and the chain of each bit is stored once per tree by :cpp:func:`xAH::TrigMatchBits::writeChains`.
+
+          .. warning:: The selectors no longer decorate their objects with the ``isTrigMatchedMap<Obj>`` maps (``isTrigMatchedMapEl``, ``isTrigMatchedMapMu``, ``isTrigMatchedMapJet``, ``isTrigMatchedMapTau``). Code reading them has to read the words instead::
+
+                static SG::AuxElement::ConstAccessor<unsigned long long> testedAcc("trigMatchTestedBitsEl");
+                static SG::AuxElement::ConstAccessor<unsigned long long> matchedAcc("isTrigMatchedBitsEl");
+                const int bit = xAH::TrigMatchBits::bit("HLT_e26_lhtight_nod0_ivarloose");
+                const bool tested  = bit >= 0 && ((testedAcc(*electron)  >> bit) & 1ULL);
+                const bool matched = bit >= 0 && ((matchedAcc(*electron) >> bit) & 1ULL);
+
+      @endrst
+   */
+  namespace TrigMatchBits {
+    /// @brief Number of chains which fit in the words
+    constexpr unsigned int maxChains = 64;
+
+    /// @brief The bit of trigger chain ``chain``, registering it if needed. Returns -1 if all :cpp:var:`maxChains` bits are taken.
+    int bit(const std::string& chain);
+
+    /// @brief The trigger chain of bit ``bit``
+    const std::string& chain(unsigned int bit);
+
+    /// @brief Record in ``tested`` and ``matched`` whether the chain of bit ``bit`` is matched
+    inline void set(unsigned long long& tested, unsigned long long& matched, unsigned int bit, bool isMatched){
+      tested |= 1ULL << bit;
+      if(isMatched) matched |=   1ULL << bit;
+      else          matched &= ~(1ULL << bit);
+    }
+
+    /// @brief All the bits, in alphabetical order of the chain names of the bits given by ``names`` (``UNKNOWN`` for the bits past its end). Compute it once per set of names.
+    std::vector<unsigned int> order(const std::vector<std::string>& names);
+
+    /// @brief Append the decision and the name of each tested chain to ``matches`` and ``chains``, in alphabetical order of the chains
+    void unpack(unsigned long long tested, unsigned long long matched, std::vector<int>& matches, std::vector<std::string>& chains);
+
+    /// @brief Same as above, with the chain names of the bits given by ``names`` (e.g. from :cpp:func:`xAH::TrigMatchBits::readChains`) instead of the ones registered in this job, and ``order`` the result of :cpp:func:`xAH::TrigMatchBits::order` for them
+    void unpack(unsigned long long tested, unsigned long long matched, std::vector<int>& matches, std::vector<std::string>& chains,
+                const std::vector<std::string>& names, const std::vector<unsigned int>& order);
+
+    /// @brief Store the chains registered so far, in order of their bits, in the user info of ``tree`` as the ``trigMatchChains`` array of strings
+    void writeChains(TTree* tree);
+
+    /// @brief The chains stored by :cpp:func:`xAH::TrigMatchBits::writeChains` in ``tree`` (or the first tree of a chain), empty if there are none
+    std::vector<std::string> readChains(TTree* tree);
+  }
+
+}
+#endif
@@ -16,6 +16,8 @@
 
 #include <TH1D.h>
 
+#include <unordered_map>
+
 /**
    @brief A wrapper of the trigger matching tool in the ASG [TriggerMatchingTool](https://twiki.cern.ch/twiki/bin/view/Atlas/XAODMatchingTool) package.
    @rst
@@ -72,6 +74,25 @@ public:
   */
   std::string    m_trigChains = "";
 
+  /** @brief Reuse the matching result of another systematic copy of the same object
+      @rst
+        Copies of an object made for the systematic variations, and the nominal one, share the same original object. If a copy has exactly the direction of the already matched copy, its match result (which only depends on :math:`\Delta R`) is reused instead of querying the matching tool again. The cache is cleared every event, and is only used if all the chains have a bit in :cpp:any:`xAH::TrigMatchBits`.
+      @endrst
+  */
+  bool           m_reuseMatchesForSameDirection = true;
+  /** @brief Also write the matched chains as the bitset decoration ``trigMatchedBits`` (``unsigned long long``), and the chains that were tested as ``trigMatchTestedBits``
+      @rst
+        The bit of each chain is the one it has in :cpp:any:`xAH::TrigMatchBits`, shared with the selectors of the job, so the words can be turned back into chains with :cpp:func:`xAH::TrigMatchBits::unpack`, and the ntuples of :cpp:class:`TreeAlgo` name the bits. At most 64 chains in the job.
+      @endrst
+  */
+  bool           m_writeMatchBits = false;
+  /** @brief Ask the trigger decision tool once per event which chains passed, and only query the matching tool for those
+      @rst
+        The matching tool never matches to a chain which did not pass, so this gives the same result with fewer calls. Not available for ``DAOD_PHYS``, where the matching is done from composite containers.
+      @endrst
+  */
+  bool           m_skipFailedChains = true;
+
 private:
 
   /* tools */
@@ -79,6 +100,20 @@ private:
   asg::AnaToolHandle<Trig::IMatchingTool>    m_trigMatchTool_handle; //!
 
   std::vector<std::string> m_trigChainsList; //!  /* contains all the HLT trigger chains tokens extracted from m_trigChains */
+  /* the bit of each chain of m_trigChainsList in xAH::TrigMatchBits, -1 if none was left */
+  std::vector<int> m_trigChainsBits; //!
+  /* the bits of all the chains of m_trigChainsList */
+  unsigned long long m_testedBits = 0; //!
+
+  /* the match result of an original object in this event, and the direction it was computed for */
+  struct CachedMatch {
+    float eta;
+    float phi;
+    unsigned long long bits;
+  };
+  std::unordered_map<const xAOD::IParticle*, CachedMatch> m_matchCache; //!
+  /* whether each chain of m_trigChainsList passed in this event */
+  std::vector<char> m_chainPassed; //!
 
 public:
 
@@ -0,0 +1,39 @@
+#ifndef xAODAnaHelpers_TriggerDictionary_H
+#define xAODAnaHelpers_TriggerDictionary_H
+
+#include <string>
+#include <vector>
+
+namespace xAH {
+
+  /**
+      @rst
+          Job-wide registry of the trigger chain lists used by the packed trigger decorations of :cpp:class:`BasicEventSelection`.
+
+          A chain list is registered once per trigger menu with :cpp:func:`xAH::TriggerDictionary::intern`, which returns a small identifier that is decorated on each event instead of the chain names. Per-chain quantities are then stored as bit masks (bit ``i`` of word ``i/64`` belongs to chain ``i``) or as dense arrays indexed by chain, and the names are only looked up by the consumers that need them.
+
+      @endrst
+   */
+  class TriggerDictionary {
+    public:
+      /// @brief Register ``chains`` and return its identifier, the same list always gets the same identifier
+      static unsigned int intern(const std::vector<std::string>& chains);
+
+      /// @brief The chain list registered as ``id``, empty if there is none. The reference stays valid until the end of the job.
+      static const std::vector<std::string>& chains(unsigned int id);
+
+      /// @brief Set bit ``index`` of ``bits``, extending it as needed
+      static void setBit(std::vector<unsigned long long>& bits, unsigned int index);
+
+      /// @brief Whether bit ``index`` of ``bits`` is set
+      static bool testBit(const std::vector<unsigned long long>& bits, unsigned int index);
+
+      /// @brief Append to ``names`` the chains of dictionary ``id`` whose bit is set in ``bits``
+      static void unpack(unsigned int id, const std::vector<unsigned long long>& bits, std::vector<std::string>& names);
+
+      /// @brief Append to ``selected`` the entries of the dense array ``values`` whose bit is set in ``bits``
+      static void select(const std::vector<unsigned long long>& bits, const std::vector<float>& values, std::vector<float>& selected);
+  };
+
+}
+#endif
@@ -6,6 +6,7 @@
 
 #include <vector>
 #include <string>
+#include <unordered_map>
 
 #include "xAODTruth/TruthParticle.h"
 
@@ -28,6 +29,8 @@ namespace xAH {
       virtual void clear();
       virtual void FillTruth( const xAOD::TruthParticle* truth );
       virtual void FillTruth( const xAOD::IParticle* particle );
+      /// @brief Resolve the parent/child ``links`` of the particles filled in this event into indices of the block, called by :cpp:func:`HelpTreeBase::Fill`
+      void resolveLinks();
       using ParticleContainer::setTree; // make other overloaded version of execute() to show up in subclass
 
     protected:
@@ -67,6 +70,13 @@ namespace xAH {
       std::vector< std::vector<int> >* m_child_barcode;
       std::vector< std::vector<int> >* m_child_status;
 
+      // links
+      xAH::JaggedBranch<int>* m_parent_index;
+      xAH::JaggedBranch<int>* m_child_index;
+      // the particles filled in this event, whose links resolveLinks() has not written yet
+      std::vector<const xAOD::TruthParticle*> m_linkParticles;
+      std::unordered_map<const xAOD::TruthParticle*, int> m_linkIndex;
+
       // dressed
       std::vector<float>* m_pt_dressed;
       std::vector<float>* m_eta_dressed;
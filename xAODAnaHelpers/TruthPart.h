@@ -36,6 +36,10 @@ namespace xAH {
       std::vector<int> child_barcode;
       std::vector<int> child_status;
 
+      // Links, as indices into the same truth container
+      std::vector<int> parent_index;
+      std::vector<int> child_index;
+
       // Dressed
       float pt_dressed;
       float eta_dressed;
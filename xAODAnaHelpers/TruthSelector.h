@@ -38,6 +38,8 @@ public:
   int m_pass_min = -1;
   /// @brief maximum number of objects passing cuts
   int m_pass_max = -1;
+  /// @brief stop evaluating particles once the event is rejected by m_pass_min/m_pass_max, the remaining ones are decorated with -1 like for m_nToProcess
+  bool m_stopWhenRejected = false;
   /// @brief require pT < pt_max
   float m_pT_max = 1e8;
   /// @brief require pT > pt_min
@@ -90,6 +92,10 @@ private:
   int   m_truth_cutflow_ptmin_cut;     //!
   int   m_truth_cutflow_eta_cut;       //!
 
+  /// @brief the type and origin values parsed from m_typeOptions and m_originOptions in initialize()
+  std::vector<unsigned int> m_typeVec;   //!
+  std::vector<unsigned int> m_originVec; //!
+
   // variables that don't get filled at submission time should be
   // protected from being send from the submission node to the worker
   // node (done by the //!)
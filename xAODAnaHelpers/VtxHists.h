@@ -2,6 +2,7 @@
 #define xAODAnaHelpers_VtxHists_H
 
 #include "xAODAnaHelpers/HistogramManager.h"
+#include "xAODAnaHelpers/TrackSummary.h"
 #include <xAODTracking/TrackParticleContainer.h>
 #include <xAODTracking/VertexContainer.h>
 #include <xAODTracking/Vertex.h>
@@ -22,6 +23,8 @@ class VtxHists : public HistogramManager
     // Use tracks passed in to calculate isolated track quantities
     StatusCode execute( const xAOD::VertexContainer* vtxs,  const xAOD::TrackParticleContainer* trks, float eventWeight );
     StatusCode execute( const xAOD::Vertex *vtx,            const xAOD::TrackParticleContainer* trks, float eventWeight );
+    /// @brief Fill from a summary of the tracks shared with other histogram classes, filled with the same ``vtxs``
+    StatusCode execute( const xAOD::VertexContainer* vtxs,  const xAH::TrackSummary& summary, float eventWeight );
 
 
     using HistogramManager::book; // make other overloaded versions of book() to show up in subclass
@@ -33,10 +36,21 @@ class VtxHists : public HistogramManager
     bool m_fillIsoTrkDetails;        //!
     bool m_fillDebugging;        //!
     bool m_fillTrkPtDetails;     //!
+    bool m_fillIsoDZ0;           //!
 
   private:
 
-    float getIso( const xAOD::TrackParticle *inTrack,            const xAOD::TrackParticleContainer* trks, float z0_cut = 2, float cone_size = 0.2);
+    /// @brief Fill the histograms of vertex ``iVtx`` of the summary
+    void fillVertex( const xAOD::Vertex *vtx, const xAH::TrackSummary& summary, unsigned int iVtx, float eventWeight );
+    /// @brief Fill the isolated track histograms of vertex ``iVtx`` of the summary
+    void fillVertexIso( const xAH::TrackSummary& summary, unsigned int iVtx, float eventWeight );
+    /// @brief Fill the ``n`` histograms with the leading ``n`` values of ``pts``, 0 for the missing ones, reordering ``pts``
+    static void fillLeading( std::vector<float>& pts, const std::vector<TH1F*>& hists, const std::vector<TH1F*>& hists_l, float eventWeight );
+
+    /// @brief summary of the tracks for the execute calls that are not given one
+    xAH::TrackSummary m_summary; //!
+    /// @brief buffer of the track pts of a vertex
+    std::vector<float> m_pts; //!
 
     // Histograms
     TH1F* h_type              ; //!
@@ -15,6 +15,13 @@ public:
   TString m_electronContainerNamesStr = "";
   TString m_muonContainerNamesStr = "";
 
+  /**
+    @rst
+      Comma-separated ``container|variables`` entries: only the dot-separated aux variables listed are written for these containers, e.g. ``"AntiKt4EMTopoJets|pt.eta.phi.m,Muons|pt.eta.phi"``. A ``-`` in front of a variable excludes it instead, see ``xAOD::TEvent::setAuxItemList``. Containers that are not listed are written in full.
+    @endrst
+  */
+  TString m_auxItemListsStr = "";
+
 private:
   int m_numEvent;         //!
 
@@ -22,6 +29,10 @@ private:
   std::vector<TString> m_electronContainerNames;
   std::vector<TString> m_muonContainerNames;
 
+  /// @brief Write container ``contName``, copied from the input or recorded from the TStore with its aux store
+  template <typename T, typename TAux>
+  EL::StatusCode writeContainer(const TString& contName);
+
   // variables that don't get filled at submission time should be
   // protected from being send from the submission node to the worker
   // node (done by the //!)